@@ -25,6 +25,7 @@
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/queue.h"
+#include "common/readaheadstream.h"
 #include "common/util.h"
 
 #include "audio/audiostream.h"
@@ -64,7 +65,7 @@ static const StreamFileFormat STREAM_FILEFORMATS[] = {
 	{ "MPEG-4 Audio",   ".m4a",  makeQuickTimeStream },
 };
 
-SeekableAudioStream *SeekableAudioStream::openStreamFile(const Common::String &basename) {
+SeekableAudioStream *SeekableAudioStream::openStreamFile(const Common::String &basename, bool readAhead) {
 	SeekableAudioStream *stream = NULL;
 	Common::File *fileHandle = new Common::File();
 
@@ -72,8 +73,13 @@ SeekableAudioStream *SeekableAudioStream::openStreamFile(const Common::String &b
 		Common::String filename = basename + STREAM_FILEFORMATS[i].fileExtension;
 		fileHandle->open(filename);
 		if (fileHandle->isOpen()) {
+			// Compressed audio is consumed slowly, so small buffers suffice
+			Common::SeekableReadStream *fileStream = fileHandle;
+			if (readAhead)
+				fileStream = Common::wrapReadAheadStream(fileHandle, 16 * 1024, 4, DisposeAfterUse::YES);
+
 			// Create the stream object
-			stream = STREAM_FILEFORMATS[i].openStreamFile(fileHandle, DisposeAfterUse::YES);
+			stream = STREAM_FILEFORMATS[i].openStreamFile(fileStream, DisposeAfterUse::YES);
 			fileHandle = 0;
 			break;
 		}
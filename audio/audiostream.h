@@ -188,11 +188,14 @@ public:
 	 * it is still the responsibility of the caller.
 	 *
 	 * @param basename  File name without an extension.
+	 * @param readAhead If true, the file is read ahead in the background
+	 *                  (see Common::ReadAheadStream), so that decoding in
+	 *                  the mixer thread does not block on slow storage.
 	 *
 	 * @return  A SeekableAudioStream ready to use in case of success.
 	 *          NULL in case of an error (e.g. invalid/non-existing file).
 	 */
-	static SeekableAudioStream *openStreamFile(const Common::String &basename);
+	static SeekableAudioStream *openStreamFile(const Common::String &basename, bool readAhead = false);
 
 	/**
 	 * Seek to a given offset in the stream.
@@ -0,0 +1,190 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/decodeahead.h"
+
+#include "common/threadpool.h"
+#include "common/util.h"
+
+namespace Audio {
+
+namespace {
+
+// Number of samples decoded in one go
+const uint32 kChunkSize = 2048;
+
+void decodeAheadProc(void *refCon) {
+	((DecodeAheadStream *)refCon)->decodeAhead();
+}
+
+} // End of anonymous namespace
+
+DecodeAheadStream::DecodeAheadStream(SeekableAudioStream *parent, uint32 bufferMillis, DisposeAfterUse::Flag disposeAfterUse)
+	: _parent(parent, disposeAfterUse),
+	_stereo(parent->isStereo()),
+	_rate(parent->getRate()),
+	_length(parent->getLength()),
+	_head(0),
+	_count(0),
+	_parentEnd(parent->endOfData()) {
+
+	const uint32 channels = _stereo ? 2 : 1;
+	_ringSize = MAX<uint32>((uint32)((uint64)bufferMillis * _rate / 1000) * channels, 2 * kChunkSize);
+
+	_chunk = new int16[kChunkSize];
+	_ring = new int16[_ringSize];
+
+	Common::RefillScheduler::addClient(&decodeAheadProc, this);
+}
+
+DecodeAheadStream::~DecodeAheadStream() {
+	Common::RefillScheduler::removeClient(this);
+
+	delete[] _ring;
+	delete[] _chunk;
+}
+
+bool DecodeAheadStream::decodeChunk(bool background) {
+	Common::StackLock decodeLock(_decodeMutex);
+
+	uint32 space;
+	{
+		Common::StackLock lock(_mutex);
+		if (_parentEnd)
+			return false;
+
+		// Only decode whole frames
+		space = MIN(_ringSize - _count, kChunkSize);
+		if (_stereo)
+			space &= ~1;
+	}
+
+	if (!space)
+		return false;
+
+	// Decode without holding the ring lock, so that the mixer can keep on
+	// reading the samples already decoded
+	const int decoded = _parent->readBuffer(_chunk, space);
+	const bool end = decoded <= 0 || _parent->endOfData();
+
+	Common::StackLock lock(_mutex);
+	for (int i = 0; i < decoded;) {
+		const uint32 tail = (_head + _count) % _ringSize;
+		const uint32 n = MIN<uint32>(decoded - i, _ringSize - tail);
+		memcpy(_ring + tail, _chunk + i, n * sizeof(int16));
+		_count += n;
+		i += n;
+	}
+	if (end)
+		_parentEnd = true;
+	if (background && decoded > 0)
+		_stats.decodedSamples += decoded;
+	return decoded > 0;
+}
+
+void DecodeAheadStream::decodeAhead() {
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			if (_parentEnd || _ringSize - _count < kChunkSize)
+				return;
+		}
+
+		if (!decodeChunk(true))
+			return;
+	}
+}
+
+int DecodeAheadStream::readBuffer(int16 *buffer, const int numSamples) {
+	int total = 0;
+	bool underrun = false;
+	bool refill = false;
+
+	for (;;) {
+		{
+			Common::StackLock lock(_mutex);
+			while (total < numSamples && _count > 0) {
+				const uint32 n = MIN<uint32>(MIN<uint32>(numSamples - total, _count), _ringSize - _head);
+				memcpy(buffer + total, _ring + _head, n * sizeof(int16));
+				_head = (_head + n) % _ringSize;
+				_count -= n;
+				total += n;
+			}
+
+			if (total == numSamples || _parentEnd) {
+				_stats.reads++;
+				if (underrun)
+					_stats.underruns++;
+				refill = !_parentEnd && _ringSize - _count >= kChunkSize;
+				break;
+			}
+		}
+
+		// The ring ran empty, decode here like without the wrapper
+		underrun = true;
+		if (!decodeChunk(false)) {
+			Common::StackLock lock(_mutex);
+			if (_count == 0) {
+				_stats.reads++;
+				_stats.underruns++;
+				return total;
+			}
+		}
+	}
+
+	// Taken out of the loop, so the ring lock is not held while waking
+	if (refill)
+		Common::RefillScheduler::wake();
+	return total;
+}
+
+bool DecodeAheadStream::endOfData() const {
+	Common::StackLock lock(_mutex);
+	return _count == 0 && _parentEnd;
+}
+
+bool DecodeAheadStream::seek(const Timestamp &where) {
+	Common::StackLock decodeLock(_decodeMutex);
+	Common::StackLock lock(_mutex);
+
+	_head = 0;
+	_count = 0;
+	_stats.seeks++;
+
+	const bool result = _parent->seek(where);
+	_parentEnd = _parent->endOfData();
+	Common::RefillScheduler::wake();
+	return result;
+}
+
+DecodeAheadStats DecodeAheadStream::getStats() const {
+	Common::StackLock lock(_mutex);
+	return _stats;
+}
+
+SeekableAudioStream *makeDecodeAheadStream(SeekableAudioStream *stream, uint32 bufferMillis, DisposeAfterUse::Flag disposeAfterUse) {
+	if (!stream)
+		return nullptr;
+	return new DecodeAheadStream(stream, bufferMillis, disposeAfterUse);
+}
+
+} // End of namespace Audio
@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_DECODEAHEAD_H
+#define AUDIO_DECODEAHEAD_H
+
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/types.h"
+
+#include "audio/audiostream.h"
+#include "audio/timestamp.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_decodeahead Decode-ahead stream
+ * @ingroup audio
+ *
+ * @brief API for decoding audio streams ahead in the background.
+ * @{
+ */
+
+/**
+ * Statistics collected by a DecodeAheadStream.
+ */
+struct DecodeAheadStats {
+	uint32 reads;          ///< Number of readBuffer() calls.
+	uint32 underruns;      ///< Number of readBuffer() calls which had to decode themselves.
+	uint32 seeks;          ///< Number of seeks and rewinds, which flush the decoded data.
+	uint32 decodedSamples; ///< Number of samples decoded in the background.
+
+	DecodeAheadStats() : reads(0), underruns(0), seeks(0), decodedSamples(0) {}
+};
+
+/**
+ * A stream wrapper which decodes a SeekableAudioStream ahead of the mixer.
+ *
+ * The parent stream is decoded into a bounded ring of PCM samples on a
+ * background thread, so that the mixer callback usually only copies samples
+ * instead of running the decoder. When the ring runs empty, the decoding
+ * happens in readBuffer() as without the wrapper. Seeking and rewinding
+ * flush the ring.
+ *
+ * This pays off for long compressed streams, like music and speech. Once
+ * wrapped, the parent stream must not be accessed by anything else.
+ */
+class DecodeAheadStream : public SeekableAudioStream {
+public:
+	DecodeAheadStream(SeekableAudioStream *parent, uint32 bufferMillis, DisposeAfterUse::Flag disposeAfterUse);
+	~DecodeAheadStream();
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+
+	bool endOfData() const override;
+
+	bool seek(const Timestamp &where) override;
+	Timestamp getLength() const override { return _length; }
+
+	/** Return the statistics collected since creation. */
+	DecodeAheadStats getStats() const;
+
+	/**
+	 * Decode into the free space of the ring.
+	 *
+	 * This is called from the background thread as the ring empties, but
+	 * can also be called manually.
+	 */
+	void decodeAhead();
+
+private:
+	/**
+	 * Decode one chunk into the ring. Returns false if nothing was decoded.
+	 *
+	 * @param background Whether to count the samples as decoded ahead.
+	 */
+	bool decodeChunk(bool background);
+
+	/** Protects the parent stream and the chunk buffer. Taken before _mutex. */
+	Common::Mutex _decodeMutex;
+	/** Protects the ring and the statistics. */
+	Common::Mutex _mutex;
+
+	Common::DisposablePtr<SeekableAudioStream> _parent;
+	const bool _stereo;
+	const int _rate;
+	const Timestamp _length;
+
+	int16 *_chunk;
+	int16 *_ring;
+	uint32 _ringSize;
+	uint32 _head;   ///< Index of the next sample to read
+	uint32 _count;  ///< Number of decoded samples in the ring
+	bool _parentEnd;
+
+	DecodeAheadStats _stats;
+};
+
+/**
+ * Wrap a SeekableAudioStream in a DecodeAheadStream, which keeps about
+ * @p bufferMillis milliseconds of it decoded ahead.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param stream          The stream to wrap.
+ * @param bufferMillis    How much audio to decode ahead.
+ * @param disposeAfterUse Whether to dispose of the wrapped stream.
+ */
+SeekableAudioStream *makeDecodeAheadStream(SeekableAudioStream *stream, uint32 bufferMillis = 500, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -26,7 +26,15 @@
 
 #include "audio/decoders/adpcm.h"
 #include "audio/decoders/adpcm_intern.h"
+#include "audio/pcmcache.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ADPCM_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ADPCM_USE_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Audio {
 
@@ -42,6 +50,32 @@ namespace Audio {
 //
 // XA ADPCM support is based on FFmpeg/libav
 
+namespace {
+
+// Bytes decoded at once by the decoders without blocks
+const uint32 kChunkSize = 512;
+
+/**
+ * Lookup tables for the IMA and OKI step updates: for each step index and
+ * nibble, the difference to add to the last sample, and the next step index.
+ */
+struct StepTables {
+	int32 diff[89 * 16];
+	byte next[89 * 16];
+
+	StepTables(const int16 *steps, int count) {
+		for (int index = 0; index < count; ++index) {
+			for (int code = 0; code < 16; ++code) {
+				const int32 e = (2 * (code & 0x7) + 1) * steps[index] / 8;
+				diff[index * 16 + code] = (code & 0x08) ? -e : e;
+				next[index * 16 + code] = CLIP<int32>(index + ADPCMStream::_stepAdjustTable[code], 0, count - 1);
+			}
+		}
+	}
+};
+
+} // End of anonymous namespace
+
 ADPCMStream::ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
 	: _stream(stream, disposeAfterUse),
 		_startpos(stream->pos()),
@@ -56,6 +90,68 @@ ADPCMStream::ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Fl
 void ADPCMStream::reset() {
 	memset(&_status, 0, sizeof(_status));
 	_blockPos[0] = _blockPos[1] = _blockAlign; // To make sure first header is read
+	_decodedBlockSize = 0;
+	_decodedBlockPos = 0;
+}
+
+uint32 ADPCMStream::readBlock(uint32 size) {
+	const int32 left = _endpos - _stream->pos();
+	if (left <= 0)
+		return 0;
+
+	size = MIN<uint32>(size, left);
+	if (_blockData.size() < size)
+		_blockData.resize(size);
+	return _stream->read(_blockData.data(), size);
+}
+
+void ADPCMStream::unpackNibbles(const byte *data, uint32 size, bool highFirst) {
+	if (_nibbles.size() < size * 2)
+		_nibbles.resize(size * 2);
+	byte *dst = _nibbles.data();
+	uint32 i = 0;
+
+#if defined(ADPCM_USE_SSE2)
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	for (; i + 16 <= size; i += 16) {
+		const __m128i bytes = _mm_loadu_si128((const __m128i *)(data + i));
+		const __m128i low = _mm_and_si128(bytes, mask);
+		const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+		const __m128i first = highFirst ? high : low;
+		const __m128i second = highFirst ? low : high;
+		_mm_storeu_si128((__m128i *)(dst + i * 2), _mm_unpacklo_epi8(first, second));
+		_mm_storeu_si128((__m128i *)(dst + i * 2 + 16), _mm_unpackhi_epi8(first, second));
+	}
+#elif defined(ADPCM_USE_NEON)
+	for (; i + 16 <= size; i += 16) {
+		const uint8x16_t bytes = vld1q_u8(data + i);
+		const uint8x16_t low = vandq_u8(bytes, vdupq_n_u8(0x0f));
+		const uint8x16_t high = vshrq_n_u8(bytes, 4);
+		const uint8x16x2_t zipped = highFirst ? vzipq_u8(high, low) : vzipq_u8(low, high);
+		vst1q_u8(dst + i * 2, zipped.val[0]);
+		vst1q_u8(dst + i * 2 + 16, zipped.val[1]);
+	}
+#endif
+
+	for (; i < size; ++i) {
+		dst[i * 2] = highFirst ? (data[i] >> 4) : (data[i] & 0x0f);
+		dst[i * 2 + 1] = highFirst ? (data[i] & 0x0f) : (data[i] >> 4);
+	}
+}
+
+int16 *ADPCMStream::startDecodedBlock(uint32 size) {
+	if (_decodedBlock.size() < size)
+		_decodedBlock.resize(size);
+	_decodedBlockSize = size;
+	_decodedBlockPos = 0;
+	return _decodedBlock.data();
+}
+
+int ADPCMStream::readDecodedBlock(int16 *buffer, int numSamples) {
+	const uint32 count = MIN<uint32>(numSamples, _decodedBlockSize - _decodedBlockPos);
+	memcpy(buffer, _decodedBlock.data() + _decodedBlockPos, count * sizeof(int16));
+	_decodedBlockPos += count;
+	return count;
 }
 
 bool ADPCMStream::rewind() {
@@ -69,26 +165,6 @@ bool ADPCMStream::rewind() {
 #pragma mark -
 
 
-int Oki_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
-
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeOKI((data >> 4) & 0x0f);
-			_decodedSamples[1] = decodeOKI((data >> 0) & 0x0f);
-			_decodedSampleCount = 2;
-		}
-
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
-	}
-
-	return samples;
-}
-
 static const int16 okiStepSize[49] = {
 	   16,   17,   19,   21,   23,   25,   28,   31,
 	   34,   37,   41,   45,   50,   55,   60,   66,
@@ -99,19 +175,48 @@ static const int16 okiStepSize[49] = {
 	 1552
 };
 
+static const StepTables s_okiTables(okiStepSize, ARRAYSIZE(okiStepSize));
+
+int Oki_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_decodedBlockPos == _decodedBlockSize) {
+			const uint32 size = readBlock(kChunkSize);
+			if (!size)
+				break;
+
+			unpackNibbles(_blockData.data(), size, true);
+			int16 *dst = startDecodedBlock(size * 2);
+
+			int32 last = _status.ima_ch[0].last;
+			int32 stepIndex = _status.ima_ch[0].stepIndex;
+			for (uint32 i = 0; i < size * 2; ++i) {
+				const int entry = stepIndex * 16 + _nibbles[i];
+				// Clip the values to +/- 2^11 (supposed to be 12 bits)
+				last = CLIP<int32>(last + s_okiTables.diff[entry], -2048, 2047);
+				stepIndex = s_okiTables.next[entry];
+				// * 16 effectively converts 12-bit input to 16-bit output
+				dst[i] = last * 16;
+			}
+			_status.ima_ch[0].last = last;
+			_status.ima_ch[0].stepIndex = stepIndex;
+		}
+
+		samples += readDecodedBlock(buffer + samples, numSamples - samples);
+	}
+
+	return samples;
+}
+
 // Decode Linear to ADPCM
 int16 Oki_ADPCMStream::decodeOKI(byte code) {
-	int16 diff, E, samp;
-
-	E = (2 * (code & 0x7) + 1) * okiStepSize[_status.ima_ch[0].stepIndex] / 8;
-	diff = (code & 0x08) ? -E : E;
-	samp = _status.ima_ch[0].last + diff;
+	const int entry = _status.ima_ch[0].stepIndex * 16 + code;
 	// Clip the values to +/- 2^11 (supposed to be 12 bits)
-	samp = CLIP<int16>(samp, -2048, 2047);
+	const int16 samp = CLIP<int32>(_status.ima_ch[0].last + s_okiTables.diff[entry], -2048, 2047);
 
 	_status.ima_ch[0].last = samp;
-	_status.ima_ch[0].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[0].stepIndex = CLIP<int32>(_status.ima_ch[0].stepIndex, 0, ARRAYSIZE(okiStepSize) - 1);
+	_status.ima_ch[0].stepIndex = s_okiTables.next[entry];
 
 	// * 16 effectively converts 12-bit input to 16-bit output
 	return samp * 16;
@@ -222,20 +327,26 @@ void XA_ADPCMStream::decodeXA(const byte *src) {
 
 
 int DVI_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+	int samples = 0;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeIMA((data >> 4) & 0x0f, 0);
-			_decodedSamples[1] = decodeIMA((data >> 0) & 0x0f, _channels == 2 ? 1 : 0);
-			_decodedSampleCount = 2;
+	while (samples < numSamples) {
+		if (_decodedBlockPos == _decodedBlockSize) {
+			const uint32 size = readBlock(kChunkSize);
+			if (!size)
+				break;
+
+			unpackNibbles(_blockData.data(), size, true);
+			int16 *dst = startDecodedBlock(size * 2);
+
+			if (_channels == 2) {
+				decodeIMANibbles(_nibbles.data(), 2, size, 0, dst, 2);
+				decodeIMANibbles(_nibbles.data() + 1, 2, size, 1, dst + 1, 2);
+			} else {
+				decodeIMANibbles(_nibbles.data(), 1, size * 2, 0, dst, 1);
+			}
 		}
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
-		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
-		_decodedSampleCount--;
+		samples += readDecodedBlock(buffer + samples, numSamples - samples);
 	}
 
 	return samples;
@@ -248,22 +359,28 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	// Need to write at least one samples per channel
 	assert((numSamples % _channels) == 0);
 
-	// Current sample positions
-	int samples[2] = { 0, 0};
+	int samples = 0;
 
-	// Number of samples per channel
-	int chanSamples = numSamples / _channels;
+	while (samples < numSamples) {
+		if (_decodedBlockPos == _decodedBlockSize) {
+			// The channels are interleaved block-wise
+			const uint32 size = readBlock(_blockAlign * _channels);
 
-	for (int i = 0; i < _channels; i++) {
-		_stream->seek(_streamPos[i]);
+			// Only decode the samples present for all channels
+			uint32 bytes = _blockAlign - 2;
+			for (int i = 0; i < _channels; i++) {
+				const uint32 left = (size > i * _blockAlign) ? size - i * _blockAlign : 0;
+				bytes = MIN<uint32>(bytes, (left > 2) ? left - 2 : 0);
+			}
+			if (!bytes)
+				break;
 
-		while ((samples[i] < chanSamples) &&
-		       // Last byte read and a new one needed
-		       !((_stream->eos() || (_stream->pos() >= _endpos)) && (_chunkPos[i] == 0))) {
+			int16 *dst = startDecodedBlock(bytes * 2 * _channels);
+			for (int i = 0; i < _channels; i++) {
+				const byte *block = _blockData.data() + i * _blockAlign;
 
-			if (_blockPos[i] == _blockAlign) {
 				// 2 byte header per block
-				uint16 temp = _stream->readUint16BE();
+				uint16 temp = READ_BE_UINT16(block);
 
 				// First 9 bits are the upper bits of the predictor
 				_status.ima_ch[i].last      = (int16) (temp & 0xFF80);
@@ -273,38 +390,16 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 				// Clip the step index
 				_status.ima_ch[i].stepIndex = CLIP<int32>(_status.ima_ch[i].stepIndex, 0, 88);
 
-				_blockPos[i] = 2;
-			}
-
-			if (_chunkPos[i] == 0) {
-				// Decode data
-				byte data = _stream->readByte();
-				_buffer[i][0] = decodeIMA(data &  0x0F, i);
-				_buffer[i][1] = decodeIMA(data >>    4, i);
-			}
-
-			// The original is interleaved block-wise, we want it sample-wise
-			buffer[_channels * samples[i] + i] = _buffer[i][_chunkPos[i]];
-
-			if (++_chunkPos[i] > 1) {
-				// We're about to decode the next byte, so advance the block position
-				_chunkPos[i] = 0;
-				_blockPos[i]++;
+				// The original is interleaved block-wise, we want it sample-wise
+				unpackNibbles(block + 2, bytes, false);
+				decodeIMANibbles(_nibbles.data(), 1, bytes * 2, i, dst + i, _channels);
 			}
-
-			samples[i]++;
-
-			if (_channels == 2)
-				if (_blockPos[i] == _blockAlign)
-					// We're at the end of the block.
-					// Since the channels are interleaved, skip the next block
-					_stream->skip(MIN<uint32>(_blockAlign, _endpos - _stream->pos()));
-
-			_streamPos[i] = _stream->pos();
 		}
+
+		samples += readDecodedBlock(buffer + samples, numSamples - samples);
 	}
 
-	return samples[0] + samples[1];
+	return samples;
 }
 
 
@@ -317,37 +412,32 @@ int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 
 	int samples = 0;
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
+	while (samples < numSamples) {
+		if (_decodedBlockPos == _decodedBlockSize) {
+			const uint32 headerSize = _channels * 4;
+			const uint32 size = readBlock(_blockAlign);
+			if (size < headerSize)
+				break;
+
+			const byte *data = _blockData.data();
 			for (int i = 0; i < _channels; i++) {
 				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
+				_status.ima_ch[i].last = (int16)READ_LE_UINT16(data + i * 4);
+				_status.ima_ch[i].stepIndex = CLIP<int32>((int16)READ_LE_UINT16(data + i * 4 + 2), 0, ARRAYSIZE(_imaTable) - 1);
 			}
 
-			_blockPos[0] = _channels * 4;
-		}
-
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
 			// The stream encodes four bytes per channel at a time
-			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
-			}
-		}
+			const uint32 sets = (size - headerSize) / headerSize;
+			unpackNibbles(data + headerSize, sets * headerSize, false);
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
+			int16 *dst = startDecodedBlock(sets * 8 * _channels);
+			for (uint32 set = 0; set < sets; set++) {
+				for (int i = 0; i < _channels; i++)
+					decodeIMANibbles(_nibbles.data() + (set * _channels + i) * 8, 1, 8, i, dst + set * 8 * _channels + i, _channels);
 			}
-
-			samples += _channels;
 		}
+
+		samples += readDecodedBlock(buffer + samples, numSamples - samples);
 	}
 
 	return samples;
@@ -389,45 +479,47 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 }
 
 int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
-	int i;
-
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
-
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
+	int samples = 0;
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
+	while (samples < numSamples) {
+		if (_decodedBlockPos == _decodedBlockSize) {
+			const uint32 headerSize = _channels * 7;
+			const uint32 size = readBlock(_blockAlign);
+			if (size < headerSize)
+				break;
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
+			const byte *data = _blockData.data();
+			const uint32 nibbleCount = (size - headerSize) * 2;
+			int16 *dst = startDecodedBlock(_channels * 2 + nibbleCount);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
+			// read block header
+			for (int i = 0; i < _channels; i++) {
+				ADPCMChannelStatus &c = _status.ch[i];
+				c.predictor = CLIP(data[i], (byte)0, (byte)6);
+				c.coeff1 = MSADPCMAdaptCoeff1[c.predictor];
+				c.coeff2 = MSADPCMAdaptCoeff2[c.predictor];
+				c.delta = (int16)READ_LE_UINT16(data + _channels + i * 2);
+				c.sample1 = (int16)READ_LE_UINT16(data + _channels * 3 + i * 2);
+				c.sample2 = (int16)READ_LE_UINT16(data + _channels * 5 + i * 2);
+				dst[i] = c.sample2;
+				dst[_channels + i] = c.sample1;
+			}
+			dst += _channels * 2;
 
-				_blockPos[0] = _channels * 7;
+			unpackNibbles(data + headerSize, size - headerSize, true);
+			const byte *nibbles = _nibbles.data();
+			if (_channels == 2) {
+				for (uint32 i = 0; i < nibbleCount; i += 2) {
+					dst[i] = decodeMS(&_status.ch[0], nibbles[i]);
+					dst[i + 1] = decodeMS(&_status.ch[1], nibbles[i + 1]);
+				}
 			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
+				for (uint32 i = 0; i < nibbleCount; i++)
+					dst[i] = decodeMS(&_status.ch[0], nibbles[i]);
 			}
-			_decodedSampleIndex = 0;
 		}
 
-		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
-		_decodedSampleCount--;
+		samples += readDecodedBlock(buffer + samples, numSamples - samples);
 	}
 
 	return samples;
@@ -546,18 +638,35 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 	32767
 };
 
+static const StepTables s_imaTables(Ima_ADPCMStream::_imaTable, ARRAYSIZE(Ima_ADPCMStream::_imaTable));
+
 int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
-	int32 E = (2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex] / 8;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
+	const int entry = _status.ima_ch[channel].stepIndex * 16 + code;
+	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + s_imaTables.diff[entry], -32768, 32767);
 
 	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
+	_status.ima_ch[channel].stepIndex = s_imaTables.next[entry];
 
 	return samp;
 }
 
+void Ima_ADPCMStream::decodeIMANibbles(const byte *nibbles, int nibbleStride, uint32 count, int channel, int16 *dst, int dstStride) {
+	int32 last = _status.ima_ch[channel].last;
+	int32 stepIndex = _status.ima_ch[channel].stepIndex;
+
+	for (uint32 i = 0; i < count; i++) {
+		const int entry = stepIndex * 16 + *nibbles;
+		last = CLIP<int32>(last + s_imaTables.diff[entry], -32768, 32767);
+		stepIndex = s_imaTables.next[entry];
+		*dst = last;
+		nibbles += nibbleStride;
+		dst += dstStride;
+	}
+
+	_status.ima_ch[channel].last = last;
+	_status.ima_ch[channel].stepIndex = stepIndex;
+}
+
 SeekableAudioStream *makeADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
 	// If size is 0, report the entire size of the stream
 	if (!size)
@@ -615,4 +724,17 @@ PacketizedAudioStream *makePacketizedADPCMStream(ADPCMType type, int rate, int c
 	return new PacketizedADPCMStream(type, rate, channels, blockAlign);
 }
 
+SeekableAudioStream *makeCachedADPCMStream(const Common::String &source, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
+	const PCMCache::Key key(source, stream->pos(), MKTAG('A','D','P','C'), size, type | (channels << 16), rate, blockAlign);
+
+	SeekableAudioStream *audioStream = PCMCacheMan.find(key);
+	if (audioStream) {
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete stream;
+		return audioStream;
+	}
+
+	return PCMCacheMan.cacheStream(key, makeADPCMStream(stream, disposeAfterUse, size, type, rate, channels, blockAlign));
+}
+
 } // End of namespace Audio
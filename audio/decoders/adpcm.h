@@ -40,6 +40,7 @@
 
 namespace Common {
 class SeekableReadStream;
+class String;
 }
 
 
@@ -84,6 +85,23 @@ SeekableAudioStream *makeADPCMStream(
     int channels,
     uint32 blockAlign = 0);
 
+/**
+ * Like makeADPCMStream(), but the decoded samples are kept in the PCMCache,
+ * for sounds which are played over and over again.
+ *
+ * @param source            name of the file or resource the stream belongs
+ *                          to, which together with the stream position
+ *                          identifies the sound
+ */
+SeekableAudioStream *makeCachedADPCMStream(
+    const Common::String &source,
+    Common::SeekableReadStream *stream,
+    DisposeAfterUse::Flag disposeAfterUse,
+    uint32 size, ADPCMType type,
+    int rate,
+    int channels,
+    uint32 blockAlign = 0);
+
 /**
  * Creates a PacketizedAudioStream that will automatically queue
  * packets as individual AudioStreams like returned by makeADPCMStream.
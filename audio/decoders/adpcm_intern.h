@@ -32,6 +32,7 @@
 #define AUDIO_ADPCM_INTERN_H
 
 #include "audio/audiostream.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/ptr.h"
 #include "common/stream.h"
@@ -58,6 +59,43 @@ protected:
 		} ima_ch[2];
 	} _status;
 
+	/**
+	 * Samples decoded from a whole block of the stream, which readBuffer()
+	 * hands out before decoding the next block.
+	 */
+	Common::Array<int16> _decodedBlock;
+	uint32 _decodedBlockSize;
+	uint32 _decodedBlockPos;
+
+	/** Data of the block being decoded. */
+	Common::Array<byte> _blockData;
+	/** Data of the block being decoded, split up into one nibble per byte. */
+	Common::Array<byte> _nibbles;
+
+	/**
+	 * Read up to size bytes into _blockData, without going past the end of
+	 * the sound. Returns the number of bytes read.
+	 */
+	uint32 readBlock(uint32 size);
+
+	/**
+	 * Split up size bytes into _nibbles, with either the high or the low
+	 * nibble of each byte first.
+	 */
+	void unpackNibbles(const byte *data, uint32 size, bool highFirst);
+
+	/**
+	 * Start a new decoded block of the given number of samples, and return
+	 * where to decode them to.
+	 */
+	int16 *startDecodedBlock(uint32 size);
+
+	/**
+	 * Copy samples left in the decoded block to the buffer, and return how
+	 * many were copied.
+	 */
+	int readDecodedBlock(int16 *buffer, int numSamples);
+
 	virtual void reset();
 
 public:
@@ -84,18 +122,14 @@ public:
 class Oki_ADPCMStream : public ADPCMStream {
 public:
 	Oki_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
-		: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) { _decodedSampleCount = 0; }
+		: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedBlockPos == _decodedBlockSize); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 protected:
 	int16 decodeOKI(byte);
-
-private:
-	uint8 _decodedSampleCount;
-	int16 _decodedSamples[2];
 };
 
 class XA_ADPCMStream : public ADPCMStream {
@@ -120,6 +154,12 @@ class Ima_ADPCMStream : public ADPCMStream {
 protected:
 	int16 decodeIMA(byte code, int channel = 0); // Default to using the left channel/using one channel
 
+	/**
+	 * Decode count nibbles of the given channel, taken nibbleStride bytes
+	 * apart, and write the samples dstStride samples apart.
+	 */
+	void decodeIMANibbles(const byte *nibbles, int nibbleStride, uint32 count, int channel, int16 *dst, int dstStride);
+
 public:
 	Ima_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
 		: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {}
@@ -133,43 +173,25 @@ public:
 class DVI_ADPCMStream : public Ima_ADPCMStream {
 public:
 	DVI_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
-		: Ima_ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) { _decodedSampleCount = 0; }
+		: Ima_ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedBlockPos == _decodedBlockSize); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
-
-private:
-	uint8 _decodedSampleCount;
-	int16 _decodedSamples[2];
 };
 
+// Apple QuickTime IMA ADPCM
 class Apple_ADPCMStream : public Ima_ADPCMStream {
-protected:
-	// Apple QuickTime IMA ADPCM
-	int32 _streamPos[2];
-	int16 _buffer[2][2];
-	uint8 _chunkPos[2];
-
-	void reset() {
-		Ima_ADPCMStream::reset();
-		_chunkPos[0] = 0;
-		_chunkPos[1] = 0;
-		_streamPos[0] = 0;
-		_streamPos[1] = _blockAlign;
-	}
-
 public:
 	Apple_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
 		: Ima_ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {
-		_chunkPos[0] = 0;
-		_chunkPos[1] = 0;
-		_streamPos[0] = 0;
-		_streamPos[1] = _blockAlign;
+		if (blockAlign <= 2)
+			error("Apple_ADPCMStream(): invalid blockAlign");
 	}
 
-	virtual int readBuffer(int16 *buffer, const int numSamples);
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedBlockPos == _decodedBlockSize); }
 
+	virtual int readBuffer(int16 *buffer, const int numSamples);
 };
 
 class MSIma_ADPCMStream : public Ima_ADPCMStream {
@@ -182,22 +204,11 @@ public:
 
 		if (blockAlign % (_channels * 4))
 			error("MSIma_ADPCMStream(): invalid blockAlign");
-
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
 	}
 
-	virtual int readBuffer(int16 *buffer, const int numSamples);
-
-	void reset() {
-		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
-	}
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedBlockPos == _decodedBlockSize); }
 
-private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	virtual int readBuffer(int16 *buffer, const int numSamples);
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -227,21 +238,14 @@ public:
 		if (blockAlign == 0)
 			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
 		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
-		_decodedSampleIndex = 0;
 	}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedBlockPos == _decodedBlockSize); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
-
-private:
-	uint8 _decodedSampleCount;
-	uint8 _decodedSampleIndex;
-	int16 _decodedSamples[4];
 };
 
 // Duck DK3 IMA ADPCM Decoder
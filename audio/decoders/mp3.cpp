@@ -24,7 +24,9 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
+#include "common/endian.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
 #include "common/queue.h"
@@ -67,6 +69,13 @@ protected:
 
 	int fillBuffer(Common::ReadStream &stream, int16 *buffer, const int numSamples);
 
+	/**
+	 * Called for every frame header that has been decoded, before its
+	 * duration is added to _curTime. _stream.this_frame points to the
+	 * start of the frame.
+	 */
+	virtual void frameHeaderDecoded() {}
+
 	enum State {
 		MP3_STATE_INIT,	// Need to init the decoder
 		MP3_STATE_READY,	// ready for processing data
@@ -107,8 +116,38 @@ protected:
 
 	Timestamp _length;
 
+	void frameHeaderDecoded();
+
 private:
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
+
+	enum {
+		/** Minimum playback time between two entries of the seek index */
+		kIndexIntervalMillis = 1000,
+		/** Distance from which a seek prefers the VBR table of contents over scanning */
+		kMaxScanMillis = 10000
+	};
+
+	struct IndexEntry {
+		mad_timer_t time;
+		uint32 offset;
+	};
+
+	bool readVBRHeader();
+	void restartAt(uint32 offset, const mad_timer_t &time, bool exact);
+	static int findEntry(const Common::Array<IndexEntry> &entries, const mad_timer_t &time);
+
+	/**
+	 * Frame offsets with their exact start time, filled in whenever the
+	 * frames are scanned from a known position.
+	 */
+	Common::Array<IndexEntry> _index;
+
+	/** Approximate positions from a Xing or VBRI header */
+	Common::Array<IndexEntry> _toc;
+
+	/** Whether _curTime was counted from the start of the stream */
+	bool _curTimeExact;
 };
 
 class PacketizedMP3Stream : private BaseMP3Stream, public PacketizedAudioStream {
@@ -172,6 +211,12 @@ void BaseMP3Stream::decodeMP3Data(Common::ReadStream &stream) {
 					// These are normal and expected (caused by our frame skipping (i.e. "seeking")
 					// code above).
 					debug(6, "MP3Stream: Recoverable error in mad_frame_decode (%s)", mad_stream_errorstr(&_stream));
+					// The header of such a frame is valid, so it still counts towards
+					// the playback time
+					if (_stream.error == MAD_ERROR_BADDATAPTR) {
+						frameHeaderDecoded();
+						mad_timer_add(&_curTime, _frame.header.duration);
+					}
 					continue;
 				} else {
 					warning("MP3Stream: Unrecoverable error in mad_frame_decode (%s)", mad_stream_errorstr(&_stream));
@@ -180,6 +225,7 @@ void BaseMP3Stream::decodeMP3Data(Common::ReadStream &stream) {
 			}
 
 			// Sum up the total playback time so far
+			frameHeaderDecoded();
 			mad_timer_add(&_curTime, _frame.header.duration);
 			// Synthesize PCM data
 			mad_synth_frame(&_synth, &_frame);
@@ -270,6 +316,7 @@ void BaseMP3Stream::readHeader(Common::ReadStream &stream) {
 		}
 
 		// Sum up the total playback time so far
+		frameHeaderDecoded();
 		mad_timer_add(&_curTime, _frame.header.duration);
 		break;
 	}
@@ -329,7 +376,8 @@ int BaseMP3Stream::fillBuffer(Common::ReadStream &stream, int16 *buffer, const i
 MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
 		BaseMP3Stream(),
 		_inStream(skipID3(inStream, dispose)),
-		_length(0, 1000) {
+		_length(0, 1000),
+		_curTimeExact(true) {
 
 	// Initialize the stream with some data and set the channels and rate
 	// variables
@@ -337,18 +385,22 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
-		readHeader(*_inStream);
-
-	// To rule out any invalid sample rate to be encountered here, say in case the
-	// MP3 stream is invalid, we just check the MAD error code here.
-	// We need to assure this, since else we might trigger an assertion in Timestamp
-	// (When getRate() returns 0 or a negative number to be precise).
-	// Note that we allow "MAD_ERROR_BUFLEN" as error code here, since according
-	// to mad.h it is also set on EOF.
-	if ((_stream.error == MAD_ERROR_NONE || _stream.error == MAD_ERROR_BUFLEN) && getRate() > 0)
-		_length = Timestamp(mad_timer_count(_curTime, MAD_UNITS_MILLISECONDS), getRate());
+	// A VBR header gives the length without scanning the whole stream.
+	// Otherwise calculate the length of the stream, which also fills the
+	// seek index.
+	if (!readVBRHeader()) {
+		while (_state != MP3_STATE_EOS)
+			readHeader(*_inStream);
+
+		// To rule out any invalid sample rate to be encountered here, say in case the
+		// MP3 stream is invalid, we just check the MAD error code here.
+		// We need to assure this, since else we might trigger an assertion in Timestamp
+		// (When getRate() returns 0 or a negative number to be precise).
+		// Note that we allow "MAD_ERROR_BUFLEN" as error code here, since according
+		// to mad.h it is also set on EOF.
+		if ((_stream.error == MAD_ERROR_NONE || _stream.error == MAD_ERROR_BUFLEN) && getRate() > 0)
+			_length = Timestamp(mad_timer_count(_curTime, MAD_UNITS_MILLISECONDS), getRate());
+	}
 
 	deinitStream();
 
@@ -377,11 +429,27 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
-		_inStream->seek(0);
-		initStream(*_inStream);
+	// Start scanning from the closest known position before the destination,
+	// which may be the current one
+	const int entry = findEntry(_index, destination);
+	long start = -1;
+	if (_state == MP3_STATE_READY && mad_timer_compare(destination, _curTime) >= 0)
+		start = mad_timer_count(_curTime, MAD_UNITS_MILLISECONDS);
+	if (entry >= 0 && mad_timer_count(_index[entry].time, MAD_UNITS_MILLISECONDS) > start) {
+		start = mad_timer_count(_index[entry].time, MAD_UNITS_MILLISECONDS);
+		restartAt(_index[entry].offset, _index[entry].time, true);
+	} else if (start < 0) {
+		start = 0;
+		restartAt(0, mad_timer_zero, true);
 	}
 
+	// Far away from there, jump close to the destination using the VBR table
+	// of contents instead. The time is only an estimate from then on.
+	const int tocEntry = findEntry(_toc, destination);
+	if ((long)time - start > kMaxScanMillis && tocEntry >= 0 &&
+	    mad_timer_count(_toc[tocEntry].time, MAD_UNITS_MILLISECONDS) > start)
+		restartAt(_toc[tocEntry].offset, _toc[tocEntry].time, false);
+
 	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS)
 		readHeader(*_inStream);
 
@@ -390,6 +458,129 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
+void MP3Stream::frameHeaderDecoded() {
+	if (!_curTimeExact)
+		return;
+
+	const long time = mad_timer_count(_curTime, MAD_UNITS_MILLISECONDS);
+	const long last = _index.empty() ? 0 : mad_timer_count(_index.back().time, MAD_UNITS_MILLISECONDS);
+	if (time < last + kIndexIntervalMillis)
+		return;
+
+	IndexEntry entry;
+	entry.time = _curTime;
+	entry.offset = _inStream->pos() - (_stream.bufend - _stream.this_frame);
+	_index.push_back(entry);
+}
+
+bool MP3Stream::readVBRHeader() {
+	// Xing and VBRI headers are stored in place of the audio data of the
+	// first Layer III frame
+	if (_state != MP3_STATE_READY || _frame.header.layer != MAD_LAYER_III || getRate() <= 0)
+		return false;
+
+	const byte *frame = _stream.this_frame;
+	const uint32 available = _stream.bufend - _stream.this_frame;
+
+	// The Xing header follows the side information
+	const bool mpeg1 = !(_frame.header.flags & MAD_FLAG_LSF_EXT);
+	const bool mono = _frame.header.mode == MAD_MODE_SINGLE_CHANNEL;
+	uint32 offset = 4 + (mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17));
+	if (_frame.header.flags & MAD_FLAG_PROTECTION)
+		offset += 2;
+
+	uint32 frames = 0;
+	uint32 bytes = 0;
+	if (available >= offset + 8 && (!memcmp(frame + offset, "Xing", 4) || !memcmp(frame + offset, "Info", 4))) {
+		const uint32 flags = READ_BE_UINT32(frame + offset + 4);
+		const uint32 tocOffset = offset + 8 + ((flags & 1) ? 4 : 0) + ((flags & 2) ? 4 : 0);
+		if (!(flags & 1) || available < tocOffset + ((flags & 4) ? 100 : 0))
+			return false;
+
+		frames = READ_BE_UINT32(frame + offset + 8);
+		bytes = (flags & 2) ? READ_BE_UINT32(frame + offset + 12) : _inStream->size();
+		if (frames == 0)
+			return false;
+
+		// The table maps every percent of the playback time to a position
+		// in 1/256ths of the stream
+		if (flags & 4) {
+			const long length = mad_timer_count(_frame.header.duration, MAD_UNITS_MILLISECONDS) * (frames + 1);
+			for (uint i = 1; i < 100; ++i) {
+				const long time = length * i / 100;
+				IndexEntry entry;
+				mad_timer_set(&entry.time, time / 1000, time % 1000, 1000);
+				entry.offset = (uint32)((uint64)frame[tocOffset + i] * bytes / 256);
+				_toc.push_back(entry);
+			}
+		}
+	} else if (available >= 36 + 26 && !memcmp(frame + 36, "VBRI", 4)) {
+		// The VBRI header is always 32 bytes after the frame header
+		const byte *vbri = frame + 36;
+		bytes = READ_BE_UINT32(vbri + 10);
+		frames = READ_BE_UINT32(vbri + 14);
+		const uint16 entries = READ_BE_UINT16(vbri + 18);
+		const uint16 scale = READ_BE_UINT16(vbri + 20);
+		const uint16 entrySize = READ_BE_UINT16(vbri + 22);
+		const uint16 framesPerEntry = READ_BE_UINT16(vbri + 24);
+		if (frames == 0)
+			return false;
+
+		// The table holds the size of every block of framesPerEntry frames
+		if (entrySize >= 1 && entrySize <= 4 && available >= 36 + 26 + (uint32)entries * entrySize) {
+			const byte *table = vbri + 26;
+			uint32 position = 0;
+			mad_timer_t time = mad_timer_zero;
+			mad_timer_t blockDuration = _frame.header.duration;
+			mad_timer_multiply(&blockDuration, framesPerEntry);
+			for (uint i = 0; i + 1 < entries; ++i) {
+				uint32 size = 0;
+				for (uint j = 0; j < entrySize; ++j)
+					size = (size << 8) | *table++;
+				position += size * scale;
+				mad_timer_add(&time, blockDuration);
+				if (position >= bytes)
+					break;
+
+				IndexEntry entry;
+				entry.time = time;
+				entry.offset = position;
+				_toc.push_back(entry);
+			}
+		}
+	} else {
+		return false;
+	}
+
+	// The header frame itself is not counted, but MAD decodes it as silence
+	mad_timer_t length = _frame.header.duration;
+	mad_timer_multiply(&length, frames + 1);
+	_length = Timestamp(mad_timer_count(length, MAD_UNITS_MILLISECONDS), getRate());
+	debug(3, "MP3Stream: VBR header with %u frames, %u bytes, %u seek points", frames, bytes, _toc.size());
+	return true;
+}
+
+void MP3Stream::restartAt(uint32 offset, const mad_timer_t &time, bool exact) {
+	_inStream->seek(offset);
+	initStream(*_inStream);
+	_curTime = time;
+	_curTimeExact = exact;
+}
+
+int MP3Stream::findEntry(const Common::Array<IndexEntry> &entries, const mad_timer_t &time) {
+	// Binary search for the last entry at or before the given time
+	int low = 0;
+	int high = entries.size();
+	while (low < high) {
+		const int mid = (low + high) / 2;
+		if (mad_timer_compare(entries[mid].time, time) <= 0)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low - 1;
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
@@ -381,9 +381,7 @@ AudioStream *QuickTimeAudioDecoder::QuickTimeAudioTrack::readAudioChunk(uint chu
 		// New-style audio demuxing
 
 		// Find our starting sample
-		uint32 startSample = 0;
-		for (uint32 i = 0; i < chunk; i++)
-			startSample += getAudioChunkSampleCount(i);
+		uint32 startSample = _parentTrack->chunkFirstSample[chunk];
 
 		for (uint32 i = 0; i < sampleCount; i++) {
 			uint32 size = (_parentTrack->sampleSize != 0) ? _parentTrack->sampleSize : _parentTrack->sampleSizes[i + startSample];
@@ -477,33 +475,13 @@ void QuickTimeAudioDecoder::QuickTimeAudioTrack::enterNewEdit(const Timestamp &p
 		// For MPEG-4 style demuxing, we need to track down the sample based on the time
 		// The old style demuxing doesn't require this because each "sample"'s duration
 		// is just 1
-		uint32 curSample = 0;
-		seekSample = 0;
-
-		for (int32 i = 0; i < _parentTrack->timeToSampleCount; i++) {
-			uint32 sampleCount = _parentTrack->timeToSample[i].count * _parentTrack->timeToSample[i].duration;
-
-			if (sample < curSample + sampleCount) {
-				seekSample += (sample - curSample) / _parentTrack->timeToSample[i].duration;
-				break;
-			}
-
-			seekSample += _parentTrack->timeToSample[i].count;
-			curSample += sampleCount;
-		}
+		seekSample = _parentTrack->findSampleAtTime(sample);
 	}
 
 	// Now to track down what chunk it's in
-	uint32 totalSamples = 0;
-	_curChunk = 0;
-	for (uint32 i = 0; i < _parentTrack->chunkCount; i++, _curChunk++) {
-		uint32 chunkSampleCount = getAudioChunkSampleCount(i);
-
-		if (seekSample < totalSamples + chunkSampleCount)
-			break;
-
-		totalSamples += chunkSampleCount;
-	}
+	int32 chunk = _parentTrack->findSampleChunk(seekSample);
+	_curChunk = chunk < 0 ? _parentTrack->chunkCount : chunk;
+	uint32 totalSamples = _parentTrack->chunkFirstSample[_curChunk];
 
 	// Now we get to have fun and convert *back* to an actual time
 	// We don't want the sample count to be modified at this point, though
@@ -525,13 +503,7 @@ void QuickTimeAudioDecoder::QuickTimeAudioTrack::queueStream(AudioStream *stream
 }
 
 uint32 QuickTimeAudioDecoder::QuickTimeAudioTrack::getAudioChunkSampleCount(uint chunk) const {
-	uint32 sampleCount = 0;
-
-	for (uint32 i = 0; i < _parentTrack->sampleToChunkCount; i++)
-		if (chunk >= _parentTrack->sampleToChunk[i].first)
-			sampleCount = _parentTrack->sampleToChunk[i].count;
-
-	return sampleCount;
+	return _parentTrack->getChunkSampleCount(chunk);
 }
 
 Timestamp QuickTimeAudioDecoder::QuickTimeAudioTrack::getChunkLength(uint chunk, bool skipAACPrimer) const {
@@ -545,20 +517,7 @@ Timestamp QuickTimeAudioDecoder::QuickTimeAudioTrack::getChunkLength(uint chunk,
 }
 
 uint32 QuickTimeAudioDecoder::QuickTimeAudioTrack::getAACSampleTime(uint32 totalSampleCount, bool skipAACPrimer) const{
-	uint32 curSample = 0;
-	uint32 time = 0;
-
-	for (int32 i = 0; i < _parentTrack->timeToSampleCount; i++) {
-		uint32 sampleCount = _parentTrack->timeToSample[i].count;
-
-		if (totalSampleCount < curSample + sampleCount) {
-			time += (totalSampleCount - curSample) * _parentTrack->timeToSample[i].duration;
-			break;
-		}
-
-		time += _parentTrack->timeToSample[i].count * _parentTrack->timeToSample[i].duration;
-		curSample += sampleCount;
-	}
+	uint32 time = _parentTrack->getSampleTime(totalSampleCount);
 
 	// The first chunk of AAC contains "duration" samples that are used as a primer
 	// We need to subtract that number from the duration for the first chunk. See:
@@ -30,6 +30,7 @@
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
 #include "audio/decoders/voc.h"
+#include "audio/pcmcache.h"
 
 namespace Audio {
 
@@ -567,4 +568,17 @@ SeekableAudioStream *makeVOCStream(Common::SeekableReadStream *stream, byte flag
 	}
 }
 
+SeekableAudioStream *makeCachedVOCStream(const Common::String &source, Common::SeekableReadStream *stream, byte flags, DisposeAfterUse::Flag disposeAfterUse) {
+	const PCMCache::Key key(source, stream->pos(), MKTAG('V','O','C',' '), flags & Audio::FLAG_UNSIGNED);
+
+	SeekableAudioStream *audioStream = PCMCacheMan.find(key);
+	if (audioStream) {
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete stream;
+		return audioStream;
+	}
+
+	return PCMCacheMan.cacheStream(key, makeVOCStream(stream, flags, disposeAfterUse));
+}
+
 } // End of namespace Audio
@@ -39,6 +39,7 @@
 namespace Common {
 class ReadStream;
 class SeekableReadStream;
+class String;
 }
 
 namespace Audio {
@@ -86,6 +87,15 @@ extern int getSampleRateFromVOCRate(int vocSR);
  */
 SeekableAudioStream *makeVOCStream(Common::SeekableReadStream *stream, byte flags, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::NO);
 
+/**
+ * Like makeVOCStream(), but the decoded samples are kept in the PCMCache,
+ * for sounds which are played over and over again.
+ *
+ * @param source	name of the file or resource the stream belongs to, which
+ *			together with the stream position identifies the sound
+ */
+SeekableAudioStream *makeCachedVOCStream(const Common::String &source, Common::SeekableReadStream *stream, byte flags, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::NO);
+
 } // End of namespace Audio
 
 #endif
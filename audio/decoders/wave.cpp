@@ -30,6 +30,7 @@
 #include "audio/decoders/adpcm.h"
 #include "audio/decoders/mp3.h"
 #include "audio/decoders/raw.h"
+#include "audio/pcmcache.h"
 
 namespace Audio {
 
@@ -220,4 +221,17 @@ SeekableAudioStream *makeWAVStream(Common::SeekableReadStream *stream, DisposeAf
 	return makeRawStream(data, size, rate, flags);
 }
 
+SeekableAudioStream *makeCachedWAVStream(const Common::String &source, Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	const PCMCache::Key key(source, stream->pos(), MKTAG('W','A','V','E'));
+
+	SeekableAudioStream *audioStream = PCMCacheMan.find(key);
+	if (audioStream) {
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete stream;
+		return audioStream;
+	}
+
+	return PCMCacheMan.cacheStream(key, makeWAVStream(stream, disposeAfterUse));
+}
+
 } // End of namespace Audio
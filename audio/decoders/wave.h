@@ -54,6 +54,7 @@
 
 namespace Common {
 class SeekableReadStream;
+class String;
 }
 
 namespace Audio {
@@ -90,6 +91,19 @@ SeekableAudioStream *makeWAVStream(
 	Common::SeekableReadStream *stream,
 	DisposeAfterUse::Flag disposeAfterUse);
 
+/**
+ * Like makeWAVStream(), but the decoded samples are kept in the PCMCache,
+ * for sounds which are played over and over again.
+ *
+ * @param source			name of the file or resource the stream belongs to,
+ *							which together with the stream position identifies
+ *							the sound
+ */
+SeekableAudioStream *makeCachedWAVStream(
+	const Common::String &source,
+	Common::SeekableReadStream *stream,
+	DisposeAfterUse::Flag disposeAfterUse);
+
 } // End of namespace Audio
 
 #endif
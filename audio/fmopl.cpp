@@ -58,7 +58,8 @@ enum OplEmulator {
 	kALSA = 3,
 	kNuked = 4,
 	kOPL2LPT = 5,
-	kOPL3LPT = 6
+	kOPL3LPT = 6,
+	kNukedFast = 7
 };
 
 OPL::OPL() {
@@ -75,6 +76,7 @@ const Config::EmulatorDescription Config::_drivers[] = {
 #endif
 #ifndef DISABLE_NUKED_OPL
 	{ "nuked", _s("Nuked OPL emulator"), kNuked, kFlagOpl2 | kFlagDualOpl2 | kFlagOpl3 },
+	{ "nuked_fast", _s("Nuked OPL emulator (fast)"), kNukedFast, kFlagOpl2 | kFlagDualOpl2 | kFlagOpl3 },
 #endif
 #ifdef USE_ALSA
 	{ "alsa", _s("ALSA Direct FM"), kALSA, kFlagOpl2 | kFlagDualOpl2 | kFlagOpl3 },
@@ -201,6 +203,9 @@ OPL *Config::create(DriverId driver, OplType type) {
 #ifndef DISABLE_NUKED_OPL
 	case kNuked:
 		return new NUKED::OPL(type);
+
+	case kNukedFast:
+		return new NUKED::OPL(type, true);
 #endif
 
 #ifdef USE_ALSA
@@ -346,6 +351,23 @@ int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
 	return numSamples;
 }
 
+void EmulatedOPL::renderBlock(int16 *buffer, int numFrames, const RegisterWrite *writes, uint numWrites) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int frame = 0;
+
+	for (uint i = 0; i < numWrites; ++i) {
+		const int writeFrame = MIN<uint32>(writes[i].frame, numFrames);
+		if (writeFrame > frame) {
+			generateSamples(buffer + frame * stereoFactor, (writeFrame - frame) * stereoFactor);
+			frame = writeFrame;
+		}
+		writeReg(writes[i].reg, writes[i].value);
+	}
+
+	if (numFrames > frame)
+		generateSamples(buffer + frame * stereoFactor, (numFrames - frame) * stereoFactor);
+}
+
 int EmulatedOPL::getRate() const {
 	return g_system->getMixer()->getOutputRate();
 }
@@ -258,6 +258,26 @@ public:
 	int getRate() const;
 	bool endOfData() const { return false; }
 
+	/**
+	 * A register write happening inside a rendered block.
+	 */
+	struct RegisterWrite {
+		uint32 frame; ///< Frame of the block before which the write happens.
+		uint16 reg;   ///< Register to write to, as for writeReg().
+		uint8 value;  ///< Value to write.
+	};
+
+	/**
+	 * Render a block of frames at once, with the given register writes
+	 * happening at their frames inside the block. The writes must be sorted
+	 * by frame, and writes at or past the end of the block happen after it.
+	 *
+	 * This does not run the timer callbacks, and is meant for players which
+	 * render their music ahead instead of using start(). For stereo OPLs,
+	 * the buffer gets interleaved left and right samples for each frame.
+	 */
+	void renderBlock(int16 *buffer, int numFrames, const RegisterWrite *writes, uint numWrites);
+
 protected:
 	// OPL API
 	void startCallbacks(int timerFrequency);
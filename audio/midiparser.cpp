@@ -50,9 +50,13 @@ _activeTrack(255),
 _abortParse(false),
 _jumpingToTick(false),
 _doParse(true),
-_pause(false) {
+_pause(false),
+_useKeyframeIndex(false),
+_buildingTrackIndex(false),
+_trackNotIndexable(false) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
+	memset(_trackIndex, 0, sizeof(_trackIndex));
 	_nextEvent.start = NULL;
 	_nextEvent.delta = 0;
 	_nextEvent.event = 0;
@@ -79,6 +83,11 @@ void MidiParser::property(int prop, int value) {
 	case mpDisableAutoStartPlayback:
 		_disableAutoStartPlayback = (value != 0);
 		break;
+	case mpKeyframeIndex:
+		_useKeyframeIndex = (value != 0);
+		if (!_useKeyframeIndex)
+			clearTrackIndex();
+		break;
 	default:
 		break;
 	}
@@ -465,7 +474,8 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 
 	resetTracking();
 	_position._playPos = _tracks[_activeTrack];
-	parseNextEvent(_nextEvent);
+	if (tick == 0 || !jumpToKeyframe(tick, fireEvents))
+		parseNextEvent(_nextEvent);
 	if (tick > 0) {
 		while (true) {
 			EventInfo &info = _nextEvent;
@@ -520,12 +530,256 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	return true;
 }
 
+namespace {
+
+// Number of events between two keyframes
+const uint32 kKeyframeInterval = 512;
+
+const byte kUnset = 0xFF;
+
+/**
+ * The last controller values, program, channel pressure and pitch bend of
+ * each channel, which is what the keyframes restore.
+ */
+struct ChannelState {
+	byte controllers[16][128];
+	byte programs[16];
+	byte pressures[16];
+	byte pitchBends[16][2];
+	bool resetControllers[16];
+	bool nrpnSelectedLast[16];
+
+	ChannelState() {
+		memset(controllers, kUnset, sizeof(controllers));
+		memset(programs, kUnset, sizeof(programs));
+		memset(pressures, kUnset, sizeof(pressures));
+		memset(pitchBends, kUnset, sizeof(pitchBends));
+		memset(resetControllers, 0, sizeof(resetControllers));
+		memset(nrpnSelectedLast, 0, sizeof(nrpnSelectedLast));
+	}
+
+	void update(const EventInfo &info) {
+		const byte channel = info.channel();
+		switch (info.command()) {
+		case 0xB:
+			if (info.basic.param1 == 121) {
+				// Reset All Controllers leaves the bank, volume, pan and effect depths alone
+				for (int i = 0; i < 128; ++i) {
+					if (i != 0 && i != 32 && i != 7 && i != 10 && i != 91 && i != 93)
+						controllers[channel][i] = kUnset;
+				}
+				pressures[channel] = kUnset;
+				pitchBends[channel][0] = pitchBends[channel][1] = kUnset;
+				resetControllers[channel] = true;
+			} else if (info.basic.param1 < 120) {
+				controllers[channel][info.basic.param1] = info.basic.param2;
+				if (info.basic.param1 == 98 || info.basic.param1 == 99)
+					nrpnSelectedLast[channel] = true;
+				else if (info.basic.param1 == 100 || info.basic.param1 == 101)
+					nrpnSelectedLast[channel] = false;
+			}
+			break;
+		case 0xC:
+			programs[channel] = info.basic.param1;
+			break;
+		case 0xD:
+			pressures[channel] = info.basic.param1;
+			break;
+		case 0xE:
+			pitchBends[channel][0] = info.basic.param1;
+			pitchBends[channel][1] = info.basic.param2;
+			break;
+		default:
+			break;
+		}
+	}
+
+	static void add(Common::Array<uint32> &messages, byte status, byte param1, byte param2) {
+		messages.push_back(status | ((uint32)param1 << 8) | ((uint32)param2 << 16));
+	}
+
+	void addController(Common::Array<uint32> &messages, byte channel, byte controller) const {
+		if (controllers[channel][controller] != kUnset)
+			add(messages, 0xB0 | channel, controller, controllers[channel][controller]);
+	}
+
+	// Messages in an order which ends in the same state: bank before
+	// program, parameter numbers before data entry.
+	void getMessages(Common::Array<uint32> &messages) const {
+		messages.clear();
+		for (byte channel = 0; channel < 16; ++channel) {
+			if (resetControllers[channel])
+				add(messages, 0xB0 | channel, 121, 0);
+
+			addController(messages, channel, 0);
+			addController(messages, channel, 32);
+			if (programs[channel] != kUnset)
+				add(messages, 0xC0 | channel, programs[channel], 0);
+
+			for (byte controller = 1; controller < 120; ++controller) {
+				if (controller == 6 || controller == 32 || controller == 38 || (controller >= 96 && controller <= 101))
+					continue;
+				addController(messages, channel, controller);
+			}
+
+			const byte rpn[] = { 101, 100, 99, 98 };
+			const int first = nrpnSelectedLast[channel] ? 0 : 2;
+			for (int i = 0; i < 4; ++i)
+				addController(messages, channel, rpn[(first + i) % 4]);
+			addController(messages, channel, 6);
+			addController(messages, channel, 38);
+
+			if (pressures[channel] != kUnset)
+				add(messages, 0xD0 | channel, pressures[channel], 0);
+			if (pitchBends[channel][0] != kUnset)
+				add(messages, 0xE0 | channel, pitchBends[channel][0], pitchBends[channel][1]);
+		}
+	}
+};
+
+} // End of anonymous namespace
+
+void MidiParser::clearTrackIndex() {
+	for (int i = 0; i < ARRAYSIZE(_trackIndex); ++i) {
+		delete _trackIndex[i];
+		_trackIndex[i] = nullptr;
+	}
+}
+
+void MidiParser::buildTrackIndex(TrackIndex &index) {
+	ChannelState channels;
+	uint32 tick = 0;
+	uint32 ticksAtInitialTempo = 0;
+	uint32 timeAfterTempoChange = 0;
+	uint32 psecPerTick = 0; // Unknown until the first tempo event
+	uint32 numEvents = 0;
+
+	index.usable = false;
+	_buildingTrackIndex = true;
+	_trackNotIndexable = false;
+
+	resetTracking();
+	_position._playPos = _tracks[_activeTrack];
+
+	EventInfo info;
+	while (true) {
+		if (numEvents && numEvents % kKeyframeInterval == 0) {
+			index.keyframes.push_back(Keyframe());
+			Keyframe &keyframe = index.keyframes.back();
+			keyframe.playPos = _position._playPos;
+			keyframe.runningStatus = _position._runningStatus;
+			keyframe.tick = tick;
+			keyframe.ticksAtInitialTempo = ticksAtInitialTempo;
+			keyframe.timeAfterTempoChange = timeAfterTempoChange;
+			keyframe.numSystemEvents = index.systemEvents.size();
+			channels.getMessages(keyframe.channelState);
+		}
+
+		parseNextEvent(info);
+		if (_trackNotIndexable || info.event < 0x80)
+			break;
+
+		++numEvents;
+		tick += info.delta;
+		if (psecPerTick)
+			timeAfterTempoChange += info.delta * psecPerTick;
+		else
+			ticksAtInitialTempo += info.delta;
+
+		if (info.event == 0xFF && info.ext.type == 0x2F) {
+			index.usable = true;
+			break;
+		} else if (info.event >= 0xF0) {
+			index.systemEvents.push_back(info.start);
+			if (info.event == 0xFF && info.ext.type == 0x51 && info.length >= 3) {
+				const uint32 tempo = info.ext.data[0] << 16 | info.ext.data[1] << 8 | info.ext.data[2];
+				psecPerTick = (tempo + (_ppqn >> 2)) / _ppqn;
+			}
+		} else {
+			channels.update(info);
+		}
+	}
+
+	_buildingTrackIndex = false;
+	if (!index.usable) {
+		index.systemEvents.clear();
+		index.keyframes.clear();
+	}
+
+	resetTracking();
+	_position._playPos = _tracks[_activeTrack];
+}
+
+const MidiParser::TrackIndex *MidiParser::getTrackIndex() {
+	TrackIndex *&index = _trackIndex[_activeTrack];
+	if (!index) {
+		index = new TrackIndex();
+		buildTrackIndex(*index);
+	}
+	return index->usable ? index : nullptr;
+}
+
+bool MidiParser::jumpToKeyframe(uint32 tick, bool fireEvents) {
+	if (!_useKeyframeIndex || !_ppqn || !canIndexTracks())
+		return false;
+
+	const TrackIndex *index = getTrackIndex();
+	if (!index)
+		return false;
+
+	// Find the last keyframe whose preceding events all lie before the
+	// target tick, as the fast-forward would have processed them
+	const Common::Array<Keyframe> &keyframes = index->keyframes;
+	uint begin = 0;
+	uint end = keyframes.size();
+	while (begin < end) {
+		const uint middle = (begin + end) / 2;
+		if (keyframes[middle].tick < tick)
+			begin = middle + 1;
+		else
+			end = middle;
+	}
+	if (!begin)
+		return false;
+	const Keyframe &keyframe = keyframes[begin - 1];
+
+	// The time before the first tempo event depends on the tempo at the jump
+	const uint32 lastEventTime = keyframe.ticksAtInitialTempo * _psecPerTick + keyframe.timeAfterTempoChange;
+
+	for (uint i = 0; i < keyframe.numSystemEvents; ++i) {
+		EventInfo info;
+		_position._playPos = index->systemEvents[i];
+		parseNextEvent(info);
+		processEvent(info, fireEvents);
+	}
+
+	if (fireEvents) {
+		for (uint i = 0; i < keyframe.channelState.size(); ++i) {
+			EventInfo info;
+			info.event = keyframe.channelState[i] & 0xFF;
+			info.basic.param1 = (keyframe.channelState[i] >> 8) & 0xFF;
+			info.basic.param2 = (keyframe.channelState[i] >> 16) & 0xFF;
+			processEvent(info, true);
+		}
+	}
+
+	_position._playPos = keyframe.playPos;
+	_position._runningStatus = keyframe.runningStatus;
+	_position._lastEventTick = keyframe.tick;
+	_position._lastEventTime = lastEventTime;
+	_position._playTick = _position._lastEventTick;
+	_position._playTime = _position._lastEventTime;
+	parseNextEvent(_nextEvent);
+	return true;
+}
+
 void MidiParser::unloadMusic() {
 	if (_numTracks == 0)
 		// No music data loaded
 		return;
 
 	stopPlaying();
+	clearTrackIndex();
 	_numTracks = 0;
 	_activeTrack = 255;
 	_abortParse = true;
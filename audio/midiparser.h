@@ -26,6 +26,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 
 class MidiDriver_BASE;
@@ -317,6 +318,37 @@ protected:
 	bool   _jumpingToTick; ///< True if currently inside jumpToTick
 	bool   _doParse;       ///< True if the parser should be parsing; false if it should not be active
 	bool   _pause;		   ///< True if the parser has paused parsing
+	bool   _useKeyframeIndex;    ///< True if jumpToTick may use the keyframe index
+	bool   _buildingTrackIndex;  ///< True while the keyframe index of a track is being built
+	bool   _trackNotIndexable;   ///< Set by parseNextEvent() when the track being indexed cannot use an index
+
+private:
+	/**
+	 * The parser state before an event of a track, recorded by the keyframe
+	 * index so that jumpToTick() does not need to parse the events before it.
+	 */
+	struct Keyframe {
+		byte  *playPos;              ///< Start of the next event.
+		byte   runningStatus;        ///< The running status before the next event.
+		uint32 tick;                 ///< The tick of the event before the next event.
+		uint32 ticksAtInitialTempo;  ///< The ticks before the first tempo event.
+		uint32 timeAfterTempoChange; ///< The time in microseconds since the first tempo event.
+		uint32 numSystemEvents;      ///< The number of SysEx and META events before the next event.
+		Common::Array<uint32> channelState; ///< Messages restoring the controllers, programs and pitch bends.
+	};
+
+	struct TrackIndex {
+		bool usable;
+		Common::Array<byte *> systemEvents; ///< Start of each SysEx and META event of the track.
+		Common::Array<Keyframe> keyframes;
+	};
+
+	TrackIndex *_trackIndex[MAXIMUM_TRACKS];
+
+	const TrackIndex *getTrackIndex();
+	void buildTrackIndex(TrackIndex &index);
+	void clearTrackIndex();
+	bool jumpToKeyframe(uint32 tick, bool fireEvents);
 
 protected:
 	static uint32 readVLQ(byte * &data);
@@ -336,6 +368,15 @@ protected:
 	 */
 	virtual void onTrackStart(uint8 track) { };
 
+	/**
+	 * Returns true if the keyframe index can be used with this format.
+	 * Implementations of parseNextEvent() must not have any side effects
+	 * while _buildingTrackIndex is set, other than on _position, and must set
+	 * _trackNotIndexable when they need events to be parsed in order, for
+	 * example for loops.
+	 */
+	virtual bool canIndexTracks() const { return false; }
+
 	virtual void sendToDriver(uint32 b);
 	void sendToDriver(byte status, byte firstOp, byte secondOp) {
 		sendToDriver(status | ((uint32)firstOp << 8) | ((uint32)secondOp << 16));
@@ -419,14 +460,30 @@ public:
 		  * or setting the track. Use startPlaying to start playback.
 		  * Note that not every parser implementation might support this.
 		  */
-		 mpDisableAutoStartPlayback = 7
+		 mpDisableAutoStartPlayback = 7,
+
+		 /**
+		  * Use an index of keyframes to speed up jumpToTick. The index of
+		  * a track is built on the first jump, by parsing the whole track
+		  * once. A jump then starts from the last keyframe before the
+		  * target tick, so only the events after it are parsed.
+		  * If fireEvents is set, the SysEx and META events before the
+		  * keyframe are sent again, followed by the last controller values,
+		  * programs and pitch bends of each channel. Notes are not, unlike
+		  * with the plain fast-forward. Only the last selected (N)RPN is
+		  * restored.
+		  * Not every parser implementation supports this; those which do
+		  * not ignore it. Tracks with XMIDI loops or callbacks always use
+		  * the plain fast-forward.
+		  */
+		 mpKeyframeIndex = 8
 	};
 
 public:
 	typedef void (*XMidiCallbackProc)(byte eventData, void *refCon);
 
 	MidiParser();
-	virtual ~MidiParser() { stopPlaying(); }
+	virtual ~MidiParser() { stopPlaying(); clearTrackIndex(); }
 
 	virtual bool loadMusic(byte *data, uint32 size) = 0;
 	virtual void unloadMusic();
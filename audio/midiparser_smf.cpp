@@ -47,6 +47,7 @@ protected:
 
 	void sendToDriver(uint32 b) override;
 	void sendMetaEventToDriver(byte type, byte *data, uint16 length) override;
+	bool canIndexTracks() const override { return true; }
 
 public:
 	MidiParser_SMF(int8 source = -1) : _buffer(0), _malformedPitchBends(false), _source(source) { }
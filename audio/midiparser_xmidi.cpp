@@ -91,6 +91,7 @@ protected:
 
 	void sendToDriver(uint32 b) override;
 	void sendMetaEventToDriver(byte type, byte *data, uint16 length) override;
+	bool canIndexTracks() const override { return true; }
 public:
 	MidiParser_XMIDI(XMidiCallbackProc proc, void *data, int8 source = -1) :
 			_callbackProc(proc),
@@ -211,7 +212,14 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 
 		switch (info.basic.param1) {
 		// Simplified XMIDI looping.
+		// Loops and callbacks need the events in playback order, so they
+		// rule out the keyframe index.
 		case 0x74: {	// XMIDI_CONTROLLER_FOR_LOOP
+				if (_buildingTrackIndex) {
+					_trackNotIndexable = true;
+					break;
+				}
+
 				byte *pos = _position._playPos;
 				if (_loopCount < ARRAYSIZE(_loop) - 1)
 					_loopCount++;
@@ -224,6 +232,10 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 			}
 
 		case 0x75:	// XMIDI_CONTROLLER_NEXT_BREAK
+			if (_buildingTrackIndex) {
+				_trackNotIndexable = true;
+				break;
+			}
 			if (_loopCount >= 0) {
 				if (info.basic.param2 < 64) {
 					// End the current loop.
@@ -246,7 +258,9 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 			break;
 
 		case 0x77:	// XMIDI_CONTROLLER_CALLBACK_TRIG
-			if (_callbackProc)
+			if (_buildingTrackIndex)
+				_trackNotIndexable = true;
+			else if (_callbackProc)
 				_callbackProc(info.basic.param2, _callbackData);
 			break;
 
@@ -22,6 +22,10 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/osd_message_queue.h"
+#include "common/profiler.h"
+#include "common/str.h"
+#include "common/ustr.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -30,6 +34,7 @@
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
 
+#include <atomic>
 
 namespace Audio {
 
@@ -38,6 +43,19 @@ namespace Audio {
 #pragma mark -
 
 
+/**
+ * What is needed to compute how long a channel has been playing.
+ */
+struct ChannelTiming {
+	uint32 samplesConsumed;
+	uint32 mixerTimeStamp;
+	uint32 pauseStartTime;
+	uint32 pauseTime;
+	bool paused;
+};
+
+static Timestamp computeElapsedTime(const ChannelTiming &timing, uint32 rate);
+
 /**
  * Channel used by the default Mixer implementation.
  */
@@ -79,8 +97,9 @@ public:
 	 *
 	 * @param paused true, when the channel should be paused.
 	 *               false when it should be unpaused.
+	 * @param now    time of the request, as returned by OSystem::getMillis(true)
 	 */
-	void pause(bool paused);
+	void pause(bool paused, uint32 now);
 
 	/**
 	 * Queries whether the channel is currently paused.
@@ -122,15 +141,26 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Queries what is needed to compute how long the channel has been playing.
 	 */
-	Timestamp getElapsedTime();
+	ChannelTiming getTiming() const;
 
 	/**
 	 * Queries the channel's sound type.
 	 */
 	Mixer::SoundType getType() const { return _type; }
 
+	/**
+	 * Queries the sample rate and channel count of the channel's stream.
+	 */
+	int getRate() const { return _stream->getRate(); }
+	bool isStereo() const { return _stream->isStereo(); }
+
+	/**
+	 * Queries the name of the rate converter the channel is mixed with.
+	 */
+	const char *getResamplerName() const { return _converter->getName(); }
+
 	/**
 	 * Sets the channel's sound handle.
 	 *
@@ -172,18 +202,156 @@ private:
 #pragma mark --- Mixer ---
 #pragma mark -
 
-MixerImpl::MixerImpl(uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+/**
+ * The volume and mute flag of a sound type. They are written with
+ * _commandMutex held, and read by the mixer thread when it applies
+ * kUpdateVolumes or starts a channel.
+ */
+struct MixerImpl::SoundTypeSettings {
+	SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
+
+	std::atomic<bool> mute;
+	std::atomic<int> volume;
+};
+
+/**
+ * The state of a channel as seen by the other threads.
+ *
+ * The handle, ID and type are set when a channel is added and the handle is
+ * reset when it is removed, both with _mutex held. The volume and balance
+ * are the values last requested, they are written with _commandMutex held.
+ * The timing is only written with _mutex held, as a seqlock: the sequence is
+ * odd while an update is in progress.
+ */
+struct MixerImpl::ChannelStatus {
+	enum {
+		kNoHandle = 0xFFFFFFFF
+	};
+
+	std::atomic<uint32> handle;
+	std::atomic<int> id;
+	std::atomic<int> type;
+	std::atomic<int> volume;
+	std::atomic<int> balance;
+
+	std::atomic<uint32> sequence;
+	std::atomic<uint32> samplesConsumed;
+	std::atomic<uint32> mixerTimeStamp;
+	std::atomic<uint32> pauseStartTime;
+	std::atomic<uint32> pauseTime;
+	std::atomic<bool> paused;
+
+	ChannelStatus() : handle(kNoHandle), id(-1), type(0), volume(0), balance(0), sequence(0),
+		samplesConsumed(0), mixerTimeStamp(0), pauseStartTime(0), pauseTime(0), paused(false) {}
+
+	void setTiming(const ChannelTiming &timing) {
+		const uint32 seq = sequence.load(std::memory_order_relaxed);
+		sequence.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		samplesConsumed.store(timing.samplesConsumed, std::memory_order_relaxed);
+		mixerTimeStamp.store(timing.mixerTimeStamp, std::memory_order_relaxed);
+		pauseStartTime.store(timing.pauseStartTime, std::memory_order_relaxed);
+		pauseTime.store(timing.pauseTime, std::memory_order_relaxed);
+		paused.store(timing.paused, std::memory_order_relaxed);
+
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	ChannelTiming getTiming() const {
+		ChannelTiming timing;
+		uint32 seq;
+		do {
+			seq = sequence.load(std::memory_order_acquire);
+			timing.samplesConsumed = samplesConsumed.load(std::memory_order_relaxed);
+			timing.mixerTimeStamp = mixerTimeStamp.load(std::memory_order_relaxed);
+			timing.pauseStartTime = pauseStartTime.load(std::memory_order_relaxed);
+			timing.pauseTime = pauseTime.load(std::memory_order_relaxed);
+			timing.paused = paused.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+		} while ((seq & 1) || seq != sequence.load(std::memory_order_relaxed));
+		return timing;
+	}
+};
+
+/**
+ * A change to apply to the channels from the mixer thread.
+ */
+struct MixerImpl::Command {
+	enum Type {
+		kSetVolume,     ///< Set the volume of the channel of handle
+		kSetBalance,    ///< Set the balance of the channel of handle
+		kPauseHandle,   ///< Pause the channel of handle if value is non-zero, resume it otherwise
+		kPauseID,       ///< Same for the first channel with the ID in handle
+		kPauseAll,      ///< Same for all channels
+		kUpdateVolumes  ///< Recompute the volumes of the channels with the sound type in handle
+	};
+
+	Type type;
+	uint32 handle;
+	int value;
+	uint32 time;
+};
+
+/**
+ * Ring buffer of commands with a single producer and a single consumer.
+ * The producers are serialized by _commandMutex, the consumer is the mixer
+ * thread.
+ */
+class MixerImpl::CommandQueue {
+public:
+	CommandQueue() : _head(0), _tail(0) {}
+
+	bool push(const Command &command) {
+		const uint32 tail = _tail.load(std::memory_order_relaxed);
+		if (tail - _head.load(std::memory_order_acquire) == kSize)
+			return false;
+
+		_commands[tail % kSize] = command;
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(Command &command) {
+		const uint32 head = _head.load(std::memory_order_relaxed);
+		if (head == _tail.load(std::memory_order_acquire))
+			return false;
+
+		command = _commands[head % kSize];
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	static const uint32 kSize = 256;
+
+	Command _commands[kSize];
+	std::atomic<uint32> _head;
+	std::atomic<uint32> _tail;
+};
+
+MixerImpl::MixerImpl(uint sampleRate, OutputFormat outputFormat)
+	: _mutex(), _sampleRate(sampleRate), _outputFormat(outputFormat), _mixerReady(false), _handleSeed(0),
+	  _statsOverlay(false), _overlayFrames(0) {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = 0;
+	memset(_channelCosts, 0, sizeof(_channelCosts));
+
+	_soundTypeSettings = new SoundTypeSettings[NUM_SOUND_TYPES];
+	_status = new ChannelStatus[NUM_CHANNELS];
+	_commands = new CommandQueue();
 }
 
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	delete[] _soundTypeSettings;
+	delete[] _status;
+	delete _commands;
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -211,6 +379,7 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	}
 
 	_channels[index] = chan;
+	memset(&_channelCosts[index], 0, sizeof(_channelCosts[index]));
 
 	SoundHandle chanHandle;
 	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
@@ -219,6 +388,94 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+
+	ChannelStatus &status = _status[index];
+	status.id.store(chan->getId(), std::memory_order_relaxed);
+	status.type.store(chan->getType(), std::memory_order_relaxed);
+	status.volume.store(chan->getVolume(), std::memory_order_relaxed);
+	status.balance.store(chan->getBalance(), std::memory_order_relaxed);
+	status.setTiming(chan->getTiming());
+	status.handle.store(chanHandle._val, std::memory_order_release);
+}
+
+int MixerImpl::findHandle(SoundHandle handle) const {
+	if (handle._val == ChannelStatus::kNoHandle)
+		return -1;
+
+	const int index = handle._val % NUM_CHANNELS;
+	if (_status[index].handle.load(std::memory_order_acquire) != handle._val)
+		return -1;
+	return index;
+}
+
+void MixerImpl::deleteChannel(int index) {
+	_status[index].handle.store(ChannelStatus::kNoHandle, std::memory_order_release);
+	delete _channels[index];
+	_channels[index] = 0;
+}
+
+void MixerImpl::queueCommand(const Command &command) {
+	if (_commands->push(command))
+		return;
+
+	// The mixer thread is not keeping up, or not running at all
+	Common::StackLock lock(_mutex);
+	processCommands();
+	applyCommand(command);
+}
+
+void MixerImpl::processCommands() {
+	Command command;
+	while (_commands->pop(command))
+		applyCommand(command);
+}
+
+void MixerImpl::applyCommand(const Command &command) {
+	switch (command.type) {
+	case Command::kSetVolume:
+	case Command::kSetBalance:
+	case Command::kPauseHandle: {
+		// Ignore commands for sounds which terminated in the meantime
+		const int index = command.handle % NUM_CHANNELS;
+		if (!_channels[index] || _channels[index]->getHandle()._val != command.handle)
+			return;
+
+		if (command.type == Command::kSetVolume)
+			_channels[index]->setVolume(command.value);
+		else if (command.type == Command::kSetBalance)
+			_channels[index]->setBalance(command.value);
+		else
+			_channels[index]->pause(command.value != 0, command.time);
+		break;
+	}
+
+	case Command::kPauseID:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0 && _channels[i]->getId() == (int)command.handle) {
+				_channels[i]->pause(command.value != 0, command.time);
+				break;
+			}
+		}
+		break;
+
+	case Command::kPauseAll:
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0)
+				_channels[i]->pause(command.value != 0, command.time);
+		}
+		break;
+
+	case Command::kUpdateVolumes:
+		for (int i = 0; i != NUM_CHANNELS; ++i) {
+			if (_channels[i] && _channels[i]->getType() == (SoundType)command.handle)
+				_channels[i]->notifyGlobalVolChange();
+		}
+		break;
+	}
+}
+
+void MixerImpl::publishTiming(int index) {
+	_status[index].setTiming(_channels[index]->getTiming());
 }
 
 void MixerImpl::playStream(
@@ -229,6 +486,7 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
+	Common::StackLock commandLock(_commandMutex);
 	Common::StackLock lock(_mutex);
 
 	if (stream == 0) {
@@ -259,6 +517,10 @@ void MixerImpl::playStream(
 	reverseStereo = !reverseStereo;
 #endif
 
+	// Apply the pending commands first, so that they do not affect the new
+	// channel, e.g. a queued pauseAll
+	processCommands();
+
 	// Create the channel
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
@@ -267,120 +529,242 @@ void MixerImpl::playStream(
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	PROFILE_SCOPE("audio.mixCallback");
 	assert(samples);
 
 	Common::StackLock lock(_mutex);
 
-	int16 *buf = (int16 *)samples;
-	// we store stereo, 16-bit samples
-	assert(len % 4 == 0);
-	len >>= 2;
+	processCommands();
+
+	assert(len % getOutputFrameSize() == 0);
+	len /= getOutputFrameSize();
 
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
-	//  zero the buf
-	memset(buf, 0, 2 * len * sizeof(int16));
+	if (_bus.size() < 2 * len) {
+		_bus.resize(2 * len);
+		_channelBuffer.resize(2 * len);
+	}
+	int16 *buf = _channelBuffer.begin();
+	int32 *bus = _bus.begin();
+	memset(bus, 0, 2 * len * sizeof(int32));
 
 	// mix all channels
+	const uint64 start = Common::Profiler::getMicros();
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
-			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
-
-				if (tmp > res)
-					res = tmp;
+				deleteChannel(i);
+			} else {
+				if (!_channels[i]->isPaused()) {
+					const uint64 channelStart = Common::Profiler::getMicros();
+					memset(buf, 0, 2 * len * sizeof(int16));
+					tmp = _channels[i]->mix(buf, len);
+					for (int j = 0; j < 2 * tmp; j++)
+						bus[j] += buf[j];
+
+					ChannelCost &cost = _channelCosts[i];
+					cost.micros += Common::Profiler::getMicros() - channelStart;
+					cost.mixes++;
+					if ((uint)tmp < len && !_channels[i]->isFinished())
+						cost.starved++;
+
+					if (tmp > res)
+						res = tmp;
+				}
+				publishTiming(i);
 			}
 		}
 
+	// Convert the bus to the output format
+	if (_outputFormat == kOutputFloat32) {
+		float *out = (float *)samples;
+		for (uint j = 0; j < 2 * len; j++)
+			out[j] = CLIP<int32>(bus[j], -32768, 32767) * (1.0f / 32768.0f);
+	} else {
+		int16 *out = (int16 *)samples;
+		for (uint j = 0; j < 2 * len; j++)
+			out[j] = (int16)CLIP<int32>(bus[j], -32768, 32767);
+	}
+
+	recordCallback((uint32)MIN<uint64>(Common::Profiler::getMicros() - start, 0xFFFFFFFF), len);
+
 	return res;
 }
 
+void MixerImpl::recordCallback(uint32 micros, uint frames) {
+	_stats.callbacks++;
+	_stats.bufferFrames = frames;
+	_stats.totalCallbackMicros += micros;
+	if (micros > _stats.maxCallbackMicros)
+		_stats.maxCallbackMicros = micros;
+	if ((uint64)micros * _sampleRate > (uint64)frames * 1000000)
+		_stats.lateCallbacks++;
+
+	int bucket = 0;
+	while (bucket < MixerStats::kNumCallbackBuckets - 1 && micros >= MixerStats::getBucketLimit(bucket))
+		bucket++;
+	_stats.histogram[bucket]++;
+
+	if (_statsOverlay) {
+		_overlayFrames += frames;
+		if (_overlayFrames >= 2 * _sampleRate) {
+			_overlayFrames = 0;
+			showStatsOverlay();
+		}
+	}
+}
+
+void MixerImpl::showStatsOverlay() {
+	int playing = 0;
+	uint32 starved = 0;
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channels[i]) {
+			playing++;
+			starved += _channelCosts[i].starved;
+		}
+	}
+
+	const uint32 average = _stats.callbacks ? (uint32)(_stats.totalCallbackMicros / _stats.callbacks) : 0;
+	const Common::String summary = Common::String::format("Mixer: %d sounds, %u/%u us per callback, %u late, %u underruns, %u starved",
+		playing, average, _stats.maxCallbackMicros, _stats.lateCallbacks, _stats.underruns, starved);
+	Common::OSDMessageQueue::instance().addMessage(Common::U32String(summary));
+}
+
+bool MixerImpl::getStats(MixerStats &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats = _stats;
+	stats.outputRate = _sampleRate;
+	stats.channels.clear();
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (!_channels[i])
+			continue;
+
+		MixerStats::ChannelStats channel;
+		channel.type = _channels[i]->getType();
+		channel.id = _channels[i]->getId();
+		channel.rate = _channels[i]->getRate();
+		channel.stereo = _channels[i]->isStereo();
+		channel.resampler = _channels[i]->getResamplerName();
+		channel.mixes = _channelCosts[i].mixes;
+		channel.starved = _channelCosts[i].starved;
+		channel.micros = _channelCosts[i].micros;
+		stats.channels.push_back(channel);
+	}
+	return true;
+}
+
+void MixerImpl::resetStats() {
+	Common::StackLock lock(_mutex);
+
+	_stats = MixerStats();
+	memset(_channelCosts, 0, sizeof(_channelCosts));
+}
+
+void MixerImpl::setStatsOverlay(bool enable) {
+	Common::StackLock lock(_mutex);
+
+	_statsOverlay = enable;
+	_overlayFrames = 0;
+}
+
+void MixerImpl::notifyUnderrun() {
+	Common::StackLock lock(_mutex);
+
+	_stats.underruns++;
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+		if (_channels[i] != 0 && !_channels[i]->isPermanent())
+			deleteChannel(i);
 	}
 }
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+		if (_channels[i] != 0 && _channels[i]->getId() == id)
+			deleteChannel(i);
 	}
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
+	// Simply ignore stop requests for handles of sounds that already
+	// terminated, without waiting for the mixer thread
+	if (findHandle(handle) == -1)
+		return;
+
 	Common::StackLock lock(_mutex);
 
-	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
 
-	delete _channels[index];
-	_channels[index] = 0;
+	deleteChannel(index);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
-	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
+	assert(0 <= (int)type && (int)type < NUM_SOUND_TYPES);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	Common::StackLock lock(_commandMutex);
+	_soundTypeSettings[type].mute.store(mute, std::memory_order_relaxed);
+
+	const Command command = { Command::kUpdateVolumes, (uint32)type, 0, 0 };
+	queueCommand(command);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
-	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	return _soundTypeSettings[type].mute;
+	assert(0 <= (int)type && (int)type < NUM_SOUND_TYPES);
+	return _soundTypeSettings[type].mute.load(std::memory_order_relaxed);
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_commandMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findHandle(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setVolume(volume);
+	_status[index].volume.store(volume, std::memory_order_relaxed);
+
+	const Command command = { Command::kSetVolume, handle._val, volume, 0 };
+	queueCommand(command);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findHandle(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getVolume();
+	const byte volume = _status[index].volume.load(std::memory_order_relaxed);
+	return findHandle(handle) == index ? volume : 0;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_commandMutex);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findHandle(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setBalance(balance);
+	_status[index].balance.store(balance, std::memory_order_relaxed);
+
+	const Command command = { Command::kSetBalance, handle._val, balance, 0 };
+	queueCommand(command);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findHandle(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getBalance();
+	const int8 balance = _status[index].balance.load(std::memory_order_relaxed);
+	return findHandle(handle) == index ? balance : 0;
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -388,87 +772,85 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	const int index = findHandle(handle);
+	if (index == -1)
+		return Timestamp(0, _sampleRate);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const ChannelTiming timing = _status[index].getTiming();
+	if (findHandle(handle) != index)
 		return Timestamp(0, _sampleRate);
 
-	return _channels[index]->getElapsedTime();
+	return computeElapsedTime(timing, _sampleRate);
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0) {
-			_channels[i]->pause(paused);
-		}
-	}
+	Common::StackLock lock(_commandMutex);
+
+	const Command command = { Command::kPauseAll, 0, paused, g_system->getMillis(true) };
+	queueCommand(command);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
-			return;
-		}
-	}
+	Common::StackLock lock(_commandMutex);
+
+	const Command command = { Command::kPauseID, (uint32)id, paused, g_system->getMillis(true) };
+	queueCommand(command);
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(_commandMutex);
 
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (findHandle(handle) == -1)
 		return;
 
-	_channels[index]->pause(paused);
+	const Command command = { Command::kPauseHandle, handle._val, paused, g_system->getMillis(true) };
+	queueCommand(command);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		const uint32 handle = _status[i].handle.load(std::memory_order_acquire);
+		if (handle != ChannelStatus::kNoHandle && _status[i].id.load(std::memory_order_relaxed) == id &&
+		    _status[i].handle.load(std::memory_order_acquire) == handle)
 			return true;
+	}
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
-	return 0;
+	const int index = findHandle(handle);
+	if (index == -1)
+		return 0;
+
+	const int id = _status[index].id.load(std::memory_order_relaxed);
+	return findHandle(handle) == index ? id : 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return findHandle(handle) != -1;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		const uint32 handle = _status[i].handle.load(std::memory_order_acquire);
+		if (handle != ChannelStatus::kNoHandle && _status[i].type.load(std::memory_order_relaxed) == type &&
+		    _status[i].handle.load(std::memory_order_acquire) == handle)
 			return true;
+	}
 	return false;
 }
 
 void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
-	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
+	assert(0 <= (int)type && (int)type < NUM_SOUND_TYPES);
 
 	// Check range
 	volume = CLIP<int>(volume, 0, kMaxMixerVolume);
@@ -476,19 +858,17 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
-	_soundTypeSettings[type].volume = volume;
+	Common::StackLock lock(_commandMutex);
+	_soundTypeSettings[type].volume.store(volume, std::memory_order_relaxed);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	const Command command = { Command::kUpdateVolumes, (uint32)type, 0, 0 };
+	queueCommand(command);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
-	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
+	assert(0 <= (int)type && (int)type < NUM_SOUND_TYPES);
 
-	return _soundTypeSettings[type].volume;
+	return _soundTypeSettings[type].volume.load(std::memory_order_relaxed);
 }
 
 
@@ -558,41 +938,50 @@ void Channel::updateChannelVolumes() {
 	}
 }
 
-void Channel::pause(bool paused) {
+void Channel::pause(bool paused, uint32 now) {
 	//assert((paused && _pauseLevel >= 0) || (!paused && _pauseLevel));
 
 	if (paused) {
 		_pauseLevel++;
 
 		if (_pauseLevel == 1)
-			_pauseStartTime = g_system->getMillis(true);
+			_pauseStartTime = now;
 	} else if (_pauseLevel > 0) {
 		_pauseLevel--;
 
 		if (!_pauseLevel) {
-			_pauseTime = (g_system->getMillis(true) - _pauseStartTime);
+			_pauseTime = (now - _pauseStartTime);
 			_pauseStartTime = 0;
 		}
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
+ChannelTiming Channel::getTiming() const {
+	ChannelTiming timing;
+	timing.samplesConsumed = _samplesConsumed;
+	timing.mixerTimeStamp = _mixerTimeStamp;
+	timing.pauseStartTime = _pauseStartTime;
+	timing.pauseTime = _pauseTime;
+	timing.paused = isPaused();
+	return timing;
+}
+
+static Timestamp computeElapsedTime(const ChannelTiming &timing, uint32 rate) {
 	uint32 delta = 0;
 
 	Audio::Timestamp ts(0, rate);
 
-	if (_mixerTimeStamp == 0)
+	if (timing.mixerTimeStamp == 0)
 		return ts;
 
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
+	if (timing.paused)
+		delta = timing.pauseStartTime - timing.mixerTimeStamp;
 	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
+		delta = g_system->getMillis(true) - timing.mixerTimeStamp - timing.pauseTime;
 
 	// Convert the number of samples into a time duration.
 
-	ts = ts.addFrames(_samplesConsumed);
+	ts = ts.addFrames(timing.samplesConsumed);
 	ts = ts.addMsecs(delta);
 
 	// In theory it would seem like a good idea to limit the approximation
@@ -23,6 +23,7 @@
 #ifndef AUDIO_MIXER_H
 #define AUDIO_MIXER_H
 
+#include "common/array.h"
 #include "common/types.h"
 #include "common/noncopyable.h"
 
@@ -54,6 +55,50 @@ public:
 	inline SoundHandle() : _val(0xFFFFFFFF) {}
 };
 
+/**
+ * Counters collected by the mixer while mixing, to find out why the audio
+ * output stutters on a given system.
+ */
+struct MixerStats {
+	enum {
+		/** Callback durations are counted below 125 us, 250 us, ..., 8 ms and above. */
+		kNumCallbackBuckets = 8
+	};
+
+	/** The counters of a playing sound. */
+	struct ChannelStats {
+		int type;              ///< The Mixer::SoundType of the sound.
+		int id;                ///< The ID the sound was started with.
+		uint rate;             ///< The sample rate of the sound.
+		bool stereo;           ///< Whether the sound is stereo.
+		const char *resampler; ///< The name of the rate converter the sound is mixed with.
+		uint32 mixes;          ///< The number of callbacks which mixed the sound.
+		uint32 starved;        ///< The number of mixes which got fewer samples than requested before the sound ended.
+		uint64 micros;         ///< The time spent mixing the sound, including its decoding.
+	};
+
+	uint outputRate;            ///< The output sample rate.
+	uint32 bufferFrames;        ///< The number of frames requested by the last callback.
+	uint32 callbacks;           ///< The number of mixer callbacks.
+	uint32 histogram[kNumCallbackBuckets]; ///< The number of callbacks by duration.
+	uint32 maxCallbackMicros;   ///< The duration of the longest callback.
+	uint64 totalCallbackMicros; ///< The total duration of the callbacks.
+	uint32 lateCallbacks;       ///< The number of callbacks which took longer than the audio they produced.
+	uint32 underruns;           ///< The number of times the backend ran out of audio.
+	Common::Array<ChannelStats> channels; ///< The sounds playing right now.
+
+	MixerStats() : outputRate(0), bufferFrames(0), callbacks(0), maxCallbackMicros(0),
+		totalCallbackMicros(0), lateCallbacks(0), underruns(0) {
+		for (int i = 0; i < kNumCallbackBuckets; ++i)
+			histogram[i] = 0;
+	}
+
+	/** Return the upper limit of a histogram bucket in microseconds, or 0 for the last one. */
+	static uint32 getBucketLimit(int bucket) {
+		return bucket < kNumCallbackBuckets - 1 ? 125 << bucket : 0;
+	}
+};
+
 /**
  * The main audio mixer that handles mixing of an arbitrary number of
  * audio streams (in the form of AudioStream instances).
@@ -295,6 +340,24 @@ public:
 	 * @return The output sample rate in Hz.
 	 */
 	virtual uint getOutputRate() const = 0;
+
+	/**
+	 * Get the counters collected since the mixer was created or since the
+	 * last call to resetStats(), along with those of the sounds playing.
+	 *
+	 * @return False if this mixer does not collect any.
+	 */
+	virtual bool getStats(MixerStats &stats) { return false; }
+
+	/**
+	 * Reset the counters returned by getStats().
+	 */
+	virtual void resetStats() {}
+
+	/**
+	 * Show a summary of the counters on the OSD every couple of seconds.
+	 */
+	virtual void setStatsOverlay(bool enable) {}
 };
 
 /** @} */
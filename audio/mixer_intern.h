@@ -24,6 +24,7 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
@@ -54,34 +55,73 @@ namespace Audio {
  * (partial) alternative implementations of the mixer, e.g. to make
  * better use of native sound mixing support on low-end devices.
  *
+ * Threading: the channels are owned by the thread running mixCallback().
+ * Queries are answered from a status published per channel, and volume,
+ * balance and pause changes are passed to the mixer thread through a
+ * lock-free queue, so neither ever waits for mixing to finish. Starting and
+ * stopping sounds still does, as callers may free the data a stream reads
+ * from as soon as the sound is stopped.
+ *
  * @see OSystem::getMixer()
  */
 class MixerImpl : public Mixer {
+public:
+	/** Sample format of the buffers passed to mixCallback(). */
+	enum OutputFormat {
+		kOutputS16,		///< Stereo, signed 16-bit samples in native endianness
+		kOutputFloat32	///< Stereo, 32-bit float samples in native endianness
+	};
+
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		NUM_SOUND_TYPES = 4
 	};
 
+	struct SoundTypeSettings;
+	struct ChannelStatus;
+	struct Command;
+	class CommandQueue;
+
+	/** Held by the mixer thread while mixing, and to add or remove channels. */
 	Common::Mutex _mutex;
+	/** Serializes the threads queuing commands or changing the channel status. */
+	Common::Mutex _commandMutex;
 
 	const uint _sampleRate;
+	const OutputFormat _outputFormat;
 	bool _mixerReady;
 	uint32 _handleSeed;
 
-	struct SoundTypeSettings {
-		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
+	SoundTypeSettings *_soundTypeSettings;
+	Channel *_channels[NUM_CHANNELS];
 
-		bool mute;
-		int volume;
+	ChannelStatus *_status;
+	CommandQueue *_commands;
+
+	/** The cost of the sound on each channel, reset when the channel is reused. */
+	struct ChannelCost {
+		uint32 mixes;
+		uint32 starved;
+		uint64 micros;
 	};
 
-	SoundTypeSettings _soundTypeSettings[4];
-	Channel *_channels[NUM_CHANNELS];
+	MixerStats _stats;
+	ChannelCost _channelCosts[NUM_CHANNELS];
+	bool _statsOverlay;
+	uint32 _overlayFrames;
 
+	/**
+	 * The channels are mixed one by one into _channelBuffer and summed up on
+	 * the 32-bit _bus, which is only clipped once when it is converted to the
+	 * output format.
+	 */
+	Common::Array<int16> _channelBuffer;
+	Common::Array<int32> _bus;
 
 public:
 
-	MixerImpl(uint sampleRate);
+	MixerImpl(uint sampleRate, OutputFormat outputFormat = kOutputS16);
 	~MixerImpl();
 
 	virtual bool isReady() const { Common::StackLock lock(_mutex); return _mixerReady; }
@@ -126,17 +166,53 @@ public:
 
 	virtual uint getOutputRate() const;
 
+	OutputFormat getOutputFormat() const { return _outputFormat; }
+	/** Return the size in bytes of one stereo frame in the output format. */
+	uint getOutputFrameSize() const { return _outputFormat == kOutputFloat32 ? 2 * sizeof(float) : 2 * sizeof(int16); }
+
+	virtual bool getStats(MixerStats &stats);
+	virtual void resetStats();
+	virtual void setStatsOverlay(bool enable);
+
+	/**
+	 * Count an underrun of the audio output. To be called by backends which
+	 * detect that the audio device ran out of samples.
+	 */
+	void notifyUnderrun();
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+private:
+	/** Return the index of the channel of @p handle, or -1 if it is not playing. */
+	int findHandle(SoundHandle handle) const;
+
+	/** Delete a channel. The caller must hold _mutex. */
+	void deleteChannel(int index);
+
+	/** Queue a command for the mixer thread. The caller must hold _commandMutex. */
+	void queueCommand(const Command &command);
+	/** Apply all the queued commands. The caller must hold _mutex. */
+	void processCommands();
+	void applyCommand(const Command &command);
+
+	/** Publish the timing of a channel for getElapsedTime(). */
+	void publishTiming(int index);
+
+	/** Count a mixer callback of the given duration. The caller must hold _mutex. */
+	void recordCallback(uint32 micros, uint frames);
+	/** Post the overlay summary of the counters to the OSD. */
+	void showStatsOverlay();
+
 public:
 	/**
 	 * The mixer callback function, to be called at regular intervals by
 	 * the backend (e.g. from an audio mixing thread). All the actual mixing
 	 * work is done from here.
 	 *
-	 * @param samples Sample buffer, in which stereo 16-bit samples will be stored.
-	 * @param len Length of the provided buffer to fill (in bytes, should be divisible by 4).
+	 * @param samples Sample buffer, in which stereo samples in the output format will be stored.
+	 * @param len Length of the provided buffer to fill (in bytes, should be divisible by
+	 *            getOutputFrameSize()).
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
 	int mixCallback(byte *samples, uint len);
@@ -3,6 +3,7 @@ MODULE := audio
 MODULE_OBJS := \
 	adlib.o \
 	audiostream.o \
+	decodeahead.o \
 	fmopl.o \
 	mididrv.o \
 	midiparser_qt.o \
@@ -17,6 +18,7 @@ MODULE_OBJS := \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
+	pcmcache.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -46,6 +48,7 @@ MODULE_OBJS := \
 	mods/soundfx.o \
 	mods/tfmx.o \
 	softsynth/cms.o \
+	softsynth/emumidi.o \
 	softsynth/opl/dbopl.o \
 	softsynth/opl/dosbox.o \
 	softsynth/opl/mame.o \
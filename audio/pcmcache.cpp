@@ -0,0 +1,267 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/pcmcache.h"
+
+#include "common/hash-str.h"
+#include "common/util.h"
+
+#include <atomic>
+
+namespace Common {
+DECLARE_SINGLETON(Audio::PCMCache);
+}
+
+namespace Audio {
+
+/**
+ * Decoded samples of a cached sound, shared by the cache and the streams
+ * playing them.
+ */
+struct PCMCache::Samples {
+	std::atomic<int> refCount;
+	int16 *data;
+	uint32 count;
+	int rate;
+	bool stereo;
+
+	Samples(int16 *d, uint32 c, int r, bool s) : refCount(1), data(d), count(c), rate(r), stereo(s) {}
+	~Samples() { free(data); }
+
+	void acquire() { refCount.fetch_add(1); }
+	void release() {
+		if (refCount.fetch_sub(1) == 1)
+			delete this;
+	}
+};
+
+namespace {
+
+// Default memory budget of the cache
+const uint32 kDefaultBudget = 4 * 1024 * 1024;
+
+// Number of samples decoded in one go when filling the cache
+const int kDecodeSize = 4096;
+
+/**
+ * Stream over the samples of a cached sound.
+ */
+class CachedPCMStream : public SeekableAudioStream {
+public:
+	CachedPCMStream(PCMCache::Samples *samples) : _samples(samples), _pos(0) {
+		_samples->acquire();
+	}
+
+	~CachedPCMStream() {
+		_samples->release();
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const uint32 len = MIN<uint32>(numSamples, _samples->count - _pos);
+		memcpy(buffer, _samples->data + _pos, len * sizeof(int16));
+		_pos += len;
+		return len;
+	}
+
+	bool isStereo() const override { return _samples->stereo; }
+	int getRate() const override { return _samples->rate; }
+	bool endOfData() const override { return _pos >= _samples->count; }
+
+	bool seek(const Timestamp &where) override {
+		const uint32 pos = convertTimeToStreamPos(where, _samples->rate, _samples->stereo).totalNumberOfFrames();
+		if (pos > _samples->count)
+			return false;
+		_pos = pos;
+		return true;
+	}
+
+	Timestamp getLength() const override {
+		return Timestamp(0, _samples->count / (_samples->stereo ? 2 : 1), _samples->rate);
+	}
+
+private:
+	PCMCache::Samples *_samples;
+	uint32 _pos;
+};
+
+} // End of anonymous namespace
+
+PCMCache::Key::Key(const Common::String &s, uint32 o, uint32 c, uint32 p0, uint32 p1, uint32 p2, uint32 p3)
+	: source(s), offset(o), codec(c) {
+	params[0] = p0;
+	params[1] = p1;
+	params[2] = p2;
+	params[3] = p3;
+}
+
+bool PCMCache::Key::operator==(const Key &other) const {
+	return offset == other.offset && codec == other.codec && source == other.source
+		&& !memcmp(params, other.params, sizeof(params));
+}
+
+uint PCMCache::KeyHash::operator()(const Key &key) const {
+	uint hash = Common::hashit(key.source.c_str());
+	hash = hash * 31 + key.offset;
+	hash = hash * 31 + key.codec;
+	for (int i = 0; i < ARRAYSIZE(key.params); ++i)
+		hash = hash * 31 + key.params[i];
+	return hash;
+}
+
+PCMCache::PCMCache() : _budget(kDefaultBudget) {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+PCMCache::~PCMCache() {
+	clear();
+}
+
+void PCMCache::setBudget(uint32 bytes) {
+	Common::StackLock lock(_mutex);
+	_budget = bytes;
+	trim(_budget);
+}
+
+SeekableAudioStream *PCMCache::find(const Key &key) {
+	Common::StackLock lock(_mutex);
+
+	Common::HashMap<Key, EntryList::iterator, KeyHash>::iterator i = _index.find(key);
+	if (i == _index.end()) {
+		_stats.misses++;
+		return nullptr;
+	}
+
+	_stats.hits++;
+	const Entry entry = *i->_value;
+	_entries.erase(i->_value);
+	_entries.push_front(entry);
+	i->_value = _entries.begin();
+	return new CachedPCMStream(entry.samples);
+}
+
+SeekableAudioStream *PCMCache::insert(const Key &key, SeekableAudioStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	uint32 maxSize;
+	{
+		Common::StackLock lock(_mutex);
+		maxSize = _budget / 4 / sizeof(int16);
+	}
+
+	const bool stereo = stream->isStereo();
+	const int rate = stream->getRate();
+	const uint32 length = (uint32)stream->getLength().convertToFramerate(rate).totalNumberOfFrames() * (stereo ? 2 : 1);
+	if (length > maxSize)
+		return nullptr;
+
+	// Decode outside of the lock. The length is only a hint, as it is not
+	// exact for all decoders.
+	uint32 capacity = MAX<uint32>(length, kDecodeSize);
+	uint32 count = 0;
+	int16 *data = (int16 *)malloc(capacity * sizeof(int16));
+	while (!stream->endOfData()) {
+		if (capacity - count < (uint32)kDecodeSize) {
+			capacity *= 2;
+			data = (int16 *)realloc(data, capacity * sizeof(int16));
+		}
+		const int decoded = stream->readBuffer(data + count, kDecodeSize);
+		if (decoded <= 0)
+			break;
+		count += decoded;
+
+		if (count > maxSize) {
+			free(data);
+			stream->rewind();
+			return nullptr;
+		}
+	}
+
+	if (disposeAfterUse == DisposeAfterUse::YES)
+		delete stream;
+
+	Samples *samples = new Samples((int16 *)realloc(data, MAX<uint32>(count, 1) * sizeof(int16)), count, rate, stereo);
+	SeekableAudioStream *result = new CachedPCMStream(samples);
+
+	Common::StackLock lock(_mutex);
+
+	// Another thread may have cached the same sound meanwhile
+	Common::HashMap<Key, EntryList::iterator, KeyHash>::iterator i = _index.find(key);
+	if (i != _index.end()) {
+		_stats.size -= i->_value->samples->count * sizeof(int16);
+		_stats.entries--;
+		i->_value->samples->release();
+		_entries.erase(i->_value);
+	}
+
+	_entries.push_front(Entry(key, samples));
+	_index[key] = _entries.begin();
+	_stats.size += count * sizeof(int16);
+	_stats.entries++;
+	trim(_budget);
+
+	return result;
+}
+
+SeekableAudioStream *PCMCache::cacheStream(const Key &key, SeekableAudioStream *stream) {
+	if (!stream)
+		return nullptr;
+
+	SeekableAudioStream *cached = insert(key, stream, DisposeAfterUse::YES);
+	return cached ? cached : stream;
+}
+
+void PCMCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		i->samples->release();
+	_entries.clear();
+	_index.clear();
+	_stats.entries = 0;
+	_stats.size = 0;
+}
+
+PCMCache::Stats PCMCache::getStats() const {
+	Common::StackLock lock(_mutex);
+	Stats stats = _stats;
+	stats.budget = _budget;
+	return stats;
+}
+
+void PCMCache::resetStats() {
+	Common::StackLock lock(_mutex);
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.evictions = 0;
+}
+
+void PCMCache::trim(uint32 budget) {
+	while (_stats.size > budget && !_entries.empty()) {
+		const Entry &entry = _entries.back();
+		_stats.size -= entry.samples->count * sizeof(int16);
+		_stats.entries--;
+		_stats.evictions++;
+		_index.erase(entry.key);
+		entry.samples->release();
+		_entries.pop_back();
+	}
+}
+
+} // End of namespace Audio
@@ -0,0 +1,152 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_PCMCACHE_H
+#define AUDIO_PCMCACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/types.h"
+
+#include "audio/audiostream.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_pcmcache PCM cache
+ * @ingroup audio
+ *
+ * @brief API for caching the decoded samples of short sounds.
+ * @{
+ */
+
+/**
+ * Cache of decoded PCM samples, for short sounds which are played over and
+ * over again, like footsteps, clicks and UI sounds.
+ *
+ * Sounds are identified by a Key, and the cache hands out cheap streams over
+ * the cached samples. Sounds are evicted in least recently used order once
+ * the memory budget is exceeded. Streams handed out stay valid after the
+ * eviction of their sound, and may be destroyed from any thread.
+ */
+class PCMCache : public Common::Singleton<PCMCache> {
+public:
+	/**
+	 * Identifies a sound: where its encoded data comes from, and how it is
+	 * decoded.
+	 */
+	struct Key {
+		Common::String source; ///< Name of the file or resource holding the sound.
+		uint32 offset;         ///< Offset of the sound in the source.
+		uint32 codec;          ///< Tag of the decoder, like MKTAG('V','O','C',' ').
+		uint32 params[4];      ///< Decoder parameters, like flags and rates.
+
+		Key(const Common::String &s, uint32 o, uint32 c, uint32 p0 = 0, uint32 p1 = 0, uint32 p2 = 0, uint32 p3 = 0);
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Stats {
+		uint32 hits;      ///< Number of lookups finding their sound.
+		uint32 misses;    ///< Number of lookups not finding their sound.
+		uint32 evictions; ///< Number of sounds dropped to stay within the budget.
+		uint32 entries;   ///< Number of cached sounds.
+		uint32 size;      ///< Size of the cached samples in bytes.
+		uint32 budget;    ///< Maximum size of the cached samples in bytes.
+	};
+
+	/**
+	 * Set the memory budget in bytes. Sounds larger than a quarter of the
+	 * budget are not cached. A budget of 0 disables the cache.
+	 */
+	void setBudget(uint32 bytes);
+
+	/**
+	 * Look up a sound, and return a new stream over its samples, or NULL if
+	 * the sound is not cached.
+	 */
+	SeekableAudioStream *find(const Key &key);
+
+	/**
+	 * Decode the given stream completely into the cache, and return a new
+	 * stream over the decoded samples.
+	 *
+	 * If the sound is too large to be cached, NULL is returned and the
+	 * stream is left untouched, and is not disposed of.
+	 */
+	SeekableAudioStream *insert(const Key &key, SeekableAudioStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+	/**
+	 * Cache the given freshly created stream if it is small enough, and
+	 * return a stream over the cached samples. Otherwise, the stream itself
+	 * is returned. Takes ownership of the stream, which may be NULL.
+	 */
+	SeekableAudioStream *cacheStream(const Key &key, SeekableAudioStream *stream);
+
+	/** Drop all cached sounds. */
+	void clear();
+
+	Stats getStats() const;
+
+	/** Reset the hit, miss and eviction counters. */
+	void resetStats();
+
+	struct Samples;
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	PCMCache();
+	~PCMCache();
+
+	struct Entry {
+		Key key;
+		Samples *samples;
+
+		Entry(const Key &k, Samples *s) : key(k), samples(s) {}
+	};
+
+	typedef Common::List<Entry> EntryList;
+
+	void trim(uint32 budget);
+
+	mutable Common::Mutex _mutex;
+	EntryList _entries; ///< Most recently used first
+	Common::HashMap<Key, EntryList::iterator, KeyHash> _index;
+	uint32 _budget;
+	Stats _stats;
+};
+
+/** @} */
+
+} // End of namespace Audio
+
+/** Shortcut for accessing the PCM cache. */
+#define PCMCacheMan		Audio::PCMCache::instance()
+
+#endif
@@ -35,6 +35,17 @@
 #include "common/textconsole.h"
 #include "common/util.h"
 
+// The vector kernels assume signed output samples
+#if !defined(OUTPUT_UNSIGNED_AUDIO)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RATE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RATE_USE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 namespace Audio {
 
 
@@ -57,6 +68,114 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Scale the given frames by the channel volumes and add them to the
+ * interleaved stereo output buffer, clamping the result.
+ *
+ * @param obuf   Output buffer, receives 2 * frames samples.
+ * @param ibuf   Input samples, 1 or 2 per frame depending on @p stereo.
+ * @param frames Number of frames to mix.
+ */
+template<bool stereo, bool reverseStereo>
+static void mixFrames(st_sample_t *obuf, const st_sample_t *ibuf, uint frames, st_volume_t vol_l, st_volume_t vol_r) {
+	// Silent channels are still converted, to keep their position, but
+	// there is nothing to mix
+	if (vol_l == 0 && vol_r == 0)
+		return;
+
+	uint i = 0;
+
+#if defined(RATE_USE_SSE2)
+	// With reversed stereo, the input channels are swapped instead
+	const __m128i vol = reverseStereo ? _mm_set_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r)
+	                                  : _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+	for (; i + 4 <= frames; i += 4) {
+		__m128i in;
+		if (stereo) {
+			in = _mm_loadu_si128((const __m128i *)(ibuf + i * 2));
+			if (reverseStereo)
+				in = _mm_shufflehi_epi16(_mm_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+		} else {
+			in = _mm_loadl_epi64((const __m128i *)(ibuf + i));
+			in = _mm_unpacklo_epi16(in, in);
+		}
+
+		// Volumes are at most 256, so the products fit in 32 bits
+		const __m128i lo = _mm_mullo_epi16(in, vol);
+		const __m128i hi = _mm_mulhi_epi16(in, vol);
+		__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+		__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+
+		// Divide by kMaxMixerVolume, rounding towards zero like the scalar code
+		p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_srli_epi32(_mm_srai_epi32(p0, 31), 24)), 8);
+		p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_srli_epi32(_mm_srai_epi32(p1, 31), 24)), 8);
+
+		// The scaled samples fit in 16 bits, the saturating add does the clamping
+		__m128i *out = (__m128i *)(obuf + i * 2);
+		_mm_storeu_si128(out, _mm_adds_epi16(_mm_loadu_si128(out), _mm_packs_epi32(p0, p1)));
+	}
+#elif defined(RATE_USE_NEON)
+	const int16 volumes[4] = {
+		(int16)(reverseStereo ? vol_r : vol_l), (int16)(reverseStereo ? vol_l : vol_r),
+		(int16)(reverseStereo ? vol_r : vol_l), (int16)(reverseStereo ? vol_l : vol_r)
+	};
+	const int16x4_t vol = vld1_s16(volumes);
+	for (; i + 4 <= frames; i += 4) {
+		int16x8_t in;
+		if (stereo) {
+			in = vld1q_s16(ibuf + i * 2);
+			if (reverseStereo)
+				in = vrev32q_s16(in);
+		} else {
+			const int16x4_t mono = vld1_s16(ibuf + i);
+			const int16x4x2_t pairs = vzip_s16(mono, mono);
+			in = vcombine_s16(pairs.val[0], pairs.val[1]);
+		}
+
+		int32x4_t p0 = vmull_s16(vget_low_s16(in), vol);
+		int32x4_t p1 = vmull_s16(vget_high_s16(in), vol);
+
+		// Divide by kMaxMixerVolume, rounding towards zero like the scalar code
+		p0 = vshrq_n_s32(vaddq_s32(p0, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p0, 31)), 24))), 8);
+		p1 = vshrq_n_s32(vaddq_s32(p1, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p1, 31)), 24))), 8);
+
+		int16 *out = obuf + i * 2;
+		vst1q_s16(out, vqaddq_s16(vld1q_s16(out), vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1))));
+	}
+#endif
+
+	ibuf += i * (stereo ? 2 : 1);
+	obuf += i * 2;
+	for (; i < frames; ++i) {
+		st_sample_t out0, out1;
+		out0 = *ibuf++;
+		out1 = (stereo ? *ibuf++ : out0);
+
+		// output left channel
+		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		obuf += 2;
+	}
+}
+
+void clampedAddBuffer(st_sample_t *dst, const st_sample_t *src, uint count) {
+	uint i = 0;
+#if defined(RATE_USE_SSE2)
+	for (; i + 8 <= count; i += 8) {
+		__m128i *out = (__m128i *)(dst + i);
+		_mm_storeu_si128(out, _mm_adds_epi16(_mm_loadu_si128(out), _mm_loadu_si128((const __m128i *)(src + i))));
+	}
+#elif defined(RATE_USE_NEON)
+	for (; i + 8 <= count; i += 8)
+		vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), vld1q_s16(src + i)));
+#endif
+	for (; i < count; ++i)
+		clampedAdd(dst[i], src[i]);
+}
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -70,6 +189,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled frames, which are mixed into the output in one go */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -83,6 +205,7 @@ public:
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+	const char *getName() const { return "simple"; }
 };
 
 
@@ -118,38 +241,44 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
-			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
-
-		// Increment output position
-		opos += opos_inc;
-
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+	bool endOfInput = false;
+	while (obuf < oend && !endOfInput) {
+		st_sample_t *tmp = outBuf;
+		const st_sample_t *tmpEnd = outBuf + MIN<int>((oend - obuf) / 2, ARRAYSIZE(outBuf) / 2) * (stereo ? 2 : 1);
+
+		while (tmp < tmpEnd) {
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (endOfInput)
+				break;
+
+			*tmp++ = *inPtr++;
+			if (stereo)
+				*tmp++ = *inPtr++;
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			// Increment output position
+			opos += opos_inc;
+		}
 
-		obuf += 2;
+		const uint frames = (tmp - outBuf) / (stereo ? 2 : 1);
+		mixFrames<stereo, reverseStereo>(obuf, outBuf, frames, vol_l, vol_r);
+		obuf += frames * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -172,6 +301,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled frames, which are mixed into the output in one go */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** fractional position of the output stream in input stream unit */
 	frac_t opos;
 
@@ -189,6 +321,7 @@ public:
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+	const char *getName() const { return "linear"; }
 };
 
 
@@ -227,48 +360,52 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE_LOW <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+	bool endOfInput = false;
+	while (obuf < oend && !endOfInput) {
+		st_sample_t *tmp = outBuf;
+		const st_sample_t *tmpEnd = outBuf + MIN<int>((oend - obuf) / 2, ARRAYSIZE(outBuf) / 2) * (stereo ? 2 : 1);
+
+		while (tmp < tmpEnd) {
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE_LOW;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
-			}
-			opos -= FRAC_ONE_LOW;
-		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						  out0);
+			if (endOfInput)
+				break;
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && tmp < tmpEnd) {
+				// interpolate
+				*tmp++ = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (stereo)
+					*tmp++ = (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-
-			// Increment output position
-			opos += opos_inc;
+				// Increment output position
+				opos += opos_inc;
+			}
 		}
+
+		const uint frames = (tmp - outBuf) / (stereo ? 2 : 1);
+		mixFrames<stereo, reverseStereo>(obuf, outBuf, frames, vol_l, vol_r);
+		obuf += frames * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -293,11 +430,6 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
-		st_size_t len;
-
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -312,29 +444,20 @@ public:
 			error("[CopyRateConverter::flow] Cannot allocate memory for temp buffer");
 
 		// Read up to 'osamp' samples into our temporary buffer
-		len = input.readBuffer(_buffer, osamp);
+		const int len = input.readBuffer(_buffer, osamp);
+		if (len <= 0)
+			return 0;
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-		}
-		return (obuf - ostart) / 2;
+		const uint frames = len / (stereo ? 2 : 1);
+		mixFrames<stereo, reverseStereo>(obuf, _buffer, frames, vol_l, vol_r);
+		return frames;
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+	virtual const char *getName() const { return "copy"; }
 };
 
 
@@ -72,6 +72,13 @@ static inline void clampedAdd(int16& a, int b) {
 #endif
 }
 
+/**
+ * Add count samples of src to dst with clampedAdd(), using the same vector
+ * kernels as the rate converters. Meant for mixers which render some
+ * channels on their own, then mix them in.
+ */
+void clampedAddBuffer(st_sample_t *dst, const st_sample_t *src, uint count);
+
 class RateConverter {
 public:
 	RateConverter() {}
@@ -83,6 +90,11 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
+
+	/**
+	 * @return The name of the conversion method, for statistics.
+	 */
+	virtual const char *getName() const = 0;
 };
 
 RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
@@ -0,0 +1,276 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/softsynth/emumidi.h"
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#include <atomic>
+
+namespace {
+
+// Extra room in the ring for the largest mixer request on top of the latency
+const uint32 kRingSlack = 8192;
+
+// Number of frames rendered in one go, published to the mixer as soon as done
+const uint32 kRenderChunk = 512;
+
+} // End of anonymous namespace
+
+/**
+ * State shared between the render thread, the mixer callback and the
+ * threads sending MIDI events.
+ *
+ * The PCM ring has a single producer (the render thread) and a single
+ * consumer (the mixer callback), so it only needs the two atomic positions.
+ * Positions count frames and wrap around naturally; the ring size is a power
+ * of two.
+ */
+struct MidiDriver_Emulated::RenderAhead {
+	struct Event {
+		uint32 frame;
+		uint32 b;
+		byte *data;
+		uint16 length;
+	};
+
+	int16 *ring;
+	uint32 ringFrames;
+	uint channels;
+	std::atomic<uint32> readPos;
+	std::atomic<uint32> writePos;
+
+	uint32 latencyFrames;
+	std::atomic<uint32> targetFrames;
+
+	// The render clock, which events are stamped with
+	std::atomic<uint32> renderFrame;
+
+	Common::Mutex eventMutex;
+	Common::List<Event> events;
+
+	OSystem::SemaphoreRef wakeUp;
+	OSystem::ThreadRef thread;
+	std::atomic<bool> quit;
+
+	std::atomic<uint32> underruns;
+};
+
+MidiDriver_Emulated::~MidiDriver_Emulated() {
+	stopRenderAhead();
+}
+
+bool MidiDriver_Emulated::startRenderAhead(uint32 latencyMillis) {
+	if (_renderAhead || !latencyMillis)
+		return _renderAhead != nullptr;
+
+	OSystem::SemaphoreRef wakeUp = g_system->createSemaphore(0);
+	if (!wakeUp)
+		return false;
+
+	RenderAhead *renderAhead = new RenderAhead();
+	renderAhead->channels = isStereo() ? 2 : 1;
+	renderAhead->latencyFrames = (uint32)getRate() * latencyMillis / 1000;
+	renderAhead->ringFrames = 1;
+	while (renderAhead->ringFrames < renderAhead->latencyFrames + kRingSlack)
+		renderAhead->ringFrames <<= 1;
+	renderAhead->ring = new int16[renderAhead->ringFrames * renderAhead->channels];
+	renderAhead->readPos = 0;
+	renderAhead->writePos = 0;
+	renderAhead->targetFrames = renderAhead->latencyFrames;
+	renderAhead->renderFrame = 0;
+	renderAhead->wakeUp = wakeUp;
+	renderAhead->quit = false;
+	renderAhead->underruns = 0;
+
+	// Set before the thread starts, as it renders through this driver
+	_renderAhead = renderAhead;
+	renderAhead->thread = g_system->createThread(&MidiDriver_Emulated::renderThreadProc, this);
+	if (!renderAhead->thread) {
+		_renderAhead = nullptr;
+		g_system->deleteSemaphore(wakeUp);
+		delete[] renderAhead->ring;
+		delete renderAhead;
+		return false;
+	}
+
+	return true;
+}
+
+void MidiDriver_Emulated::stopRenderAhead() {
+	RenderAhead *renderAhead = _renderAhead;
+	if (!renderAhead)
+		return;
+
+	renderAhead->quit = true;
+	g_system->postSemaphore(renderAhead->wakeUp);
+	g_system->joinThread(renderAhead->thread);
+	g_system->deleteSemaphore(renderAhead->wakeUp);
+
+	debug(3, "MidiDriver_Emulated: Rendered %u frames ahead, %u underruns",
+	      renderAhead->renderFrame.load(), renderAhead->underruns.load());
+
+	_renderAhead = nullptr;
+
+	// The synthesizer still has to see the events which were not played yet
+	for (Common::List<RenderAhead::Event>::const_iterator i = renderAhead->events.begin(); i != renderAhead->events.end(); ++i) {
+		playEvent(i->b, i->data, i->length);
+		delete[] i->data;
+	}
+
+	delete[] renderAhead->ring;
+	delete renderAhead;
+}
+
+bool MidiDriver_Emulated::queueEvent(uint32 b, const byte *data, uint16 length) {
+	RenderAhead *renderAhead = _renderAhead;
+	if (!renderAhead) {
+		playEvent(b, data, length);
+		return false;
+	}
+
+	RenderAhead::Event event;
+	event.b = b;
+	event.data = nullptr;
+	event.length = length;
+	if (data && length) {
+		event.data = new byte[length];
+		memcpy(event.data, data, length);
+	}
+
+	Common::StackLock lock(renderAhead->eventMutex);
+	event.frame = renderAhead->renderFrame.load(std::memory_order_relaxed);
+	renderAhead->events.push_back(event);
+	return true;
+}
+
+void MidiDriver_Emulated::playQueuedEvents(uint32 frame) {
+	RenderAhead *renderAhead = _renderAhead;
+	Common::Array<RenderAhead::Event> due;
+
+	{
+		Common::StackLock lock(renderAhead->eventMutex);
+		while (!renderAhead->events.empty() && (int32)(renderAhead->events.front().frame - frame) <= 0) {
+			due.push_back(renderAhead->events.front());
+			renderAhead->events.pop_front();
+		}
+	}
+
+	for (uint i = 0; i < due.size(); ++i) {
+		playEvent(due[i].b, due[i].data, due[i].length);
+		delete[] due[i].data;
+	}
+}
+
+void MidiDriver_Emulated::render(int16 *data, int len) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int step;
+
+	do {
+		step = len;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		if (_renderAhead)
+			playQueuedEvents(_renderAhead->renderFrame.load(std::memory_order_relaxed));
+
+		generateSamples(data, step);
+
+		if (_renderAhead)
+			_renderAhead->renderFrame.fetch_add(step, std::memory_order_relaxed);
+
+		_nextTick -= step << FIXP_SHIFT;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			if (_timerProc)
+				(*_timerProc)(_timerParam);
+
+			onTimer();
+
+			_nextTick += _samplesPerTick;
+		}
+
+		data += step * stereoFactor;
+		len -= step;
+	} while (len);
+}
+
+void MidiDriver_Emulated::renderThreadProc(void *refCon) {
+	MidiDriver_Emulated *driver = (MidiDriver_Emulated *)refCon;
+	RenderAhead *renderAhead = driver->_renderAhead;
+	const uint32 mask = renderAhead->ringFrames - 1;
+
+	while (!renderAhead->quit) {
+		const uint32 writePos = renderAhead->writePos.load(std::memory_order_relaxed);
+		const uint32 fill = writePos - renderAhead->readPos.load(std::memory_order_acquire);
+		const uint32 target = renderAhead->targetFrames.load(std::memory_order_relaxed);
+		if (fill >= target) {
+			// Sleep until the mixer took some frames
+			g_system->waitSemaphore(renderAhead->wakeUp);
+			continue;
+		}
+
+		const uint32 pos = writePos & mask;
+		const uint32 len = MIN(MIN(target - fill, kRenderChunk), renderAhead->ringFrames - pos);
+		driver->render(renderAhead->ring + pos * renderAhead->channels, len);
+		renderAhead->writePos.store(writePos + len, std::memory_order_release);
+	}
+}
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	RenderAhead *renderAhead = _renderAhead;
+	if (!renderAhead) {
+		render(data, numSamples / (isStereo() ? 2 : 1));
+		return numSamples;
+	}
+
+	const uint channels = renderAhead->channels;
+	const uint32 frames = numSamples / channels;
+	const uint32 mask = renderAhead->ringFrames - 1;
+
+	// Keep enough ahead for the largest request on top of the latency
+	const uint32 target = MIN(renderAhead->latencyFrames + frames, renderAhead->ringFrames);
+	if (target > renderAhead->targetFrames.load(std::memory_order_relaxed))
+		renderAhead->targetFrames.store(target, std::memory_order_relaxed);
+
+	const uint32 readPos = renderAhead->readPos.load(std::memory_order_relaxed);
+	const uint32 available = renderAhead->writePos.load(std::memory_order_acquire) - readPos;
+	const uint32 len = MIN(frames, available);
+
+	const uint32 pos = readPos & mask;
+	const uint32 first = MIN(len, renderAhead->ringFrames - pos);
+	memcpy(data, renderAhead->ring + pos * channels, first * channels * sizeof(int16));
+	memcpy(data + first * channels, renderAhead->ring, (len - first) * channels * sizeof(int16));
+	renderAhead->readPos.store(readPos + len, std::memory_order_release);
+
+	if (len < frames) {
+		memset(data + len * channels, 0, (frames - len) * channels * sizeof(int16));
+		renderAhead->underruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	g_system->postSemaphore(renderAhead->wakeUp);
+	return numSamples;
+}
@@ -27,6 +27,20 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+/**
+ * Base class for MIDI drivers which synthesize their output in software and
+ * play it through the mixer as an AudioStream.
+ *
+ * By default, the synthesizer is run inside the mixer callback, and so is the
+ * timer callback of the music player. Drivers for expensive synthesizers can
+ * call startRenderAhead() once they are open, to run both on a dedicated
+ * thread instead, which stays ahead of the mixer by a fixed latency. The
+ * mixer callback then only copies the rendered samples. MIDI events sent
+ * from other threads are stamped with the position of the render clock and
+ * applied by the render thread at that position, which keeps them in order
+ * with the events sent by the timer callback. Drivers using this route all
+ * their synthesizer accesses through queueEvent() and implement playEvent().
+ */
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -34,6 +48,8 @@ protected:
 	Audio::SoundHandle _mixerSoundHandle;
 
 private:
+	struct RenderAhead;
+
 	Common::TimerManager::TimerProc _timerProc;
 	void *_timerParam;
 
@@ -44,12 +60,54 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	RenderAhead *_renderAhead;
+
+	/** Render the given number of frames, calling the timer callback in between. */
+	void render(int16 *data, int len);
+	void playQueuedEvents(uint32 frame);
+	static void renderThreadProc(void *refCon);
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Start the render thread, which keeps the given amount of audio rendered
+	 * ahead of the mixer. Must be called before the stream is passed to the
+	 * mixer.
+	 *
+	 * @return False if the backend does not support threads, in which case
+	 *         rendering stays in the mixer callback.
+	 */
+	bool startRenderAhead(uint32 latencyMillis);
+
+	/**
+	 * Stop the render thread. Must be called before the synthesizer is
+	 * closed, and after the stream has been removed from the mixer.
+	 */
+	void stopRenderAhead();
+
+	bool isRenderingAhead() const { return _renderAhead != nullptr; }
+
+	/**
+	 * Pass a MIDI event to playEvent(). While the render thread runs, the event
+	 * is queued for it, and true is returned. Otherwise, playEvent() is called
+	 * right away and false is returned.
+	 *
+	 * @param b      A short MIDI message, or 0 for a SysEx message.
+	 * @param data   The SysEx message data, which is copied when queued.
+	 * @param length The length of the SysEx message data.
+	 */
+	bool queueEvent(uint32 b, const byte *data = nullptr, uint16 length = 0);
+
+	/**
+	 * Send a MIDI event to the synthesizer. Only drivers using queueEvent()
+	 * need to implement this.
+	 */
+	virtual void playEvent(uint32 b, const byte *data, uint16 length) {}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -58,9 +116,12 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_renderAhead(nullptr),
 		_baseFreq(250) {
 	}
 
+	virtual ~MidiDriver_Emulated();
+
 	// MidiDriver API
 	virtual int open() {
 		_isOpen = true;
@@ -88,34 +149,7 @@ public:
 	}
 
 	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	virtual int readBuffer(int16 *data, const int numSamples);
 
 	virtual bool endOfData() const {
 		return false;
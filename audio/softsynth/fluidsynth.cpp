@@ -62,6 +62,7 @@ protected:
 	void setStr(const char *name, const char *str);
 
 	void generateSamples(int16 *buf, int len) override;
+	void playEvent(uint32 b, const byte *data, uint16 length) override;
 
 public:
 	MidiDriver_FluidSynth(Audio::Mixer *mixer);
@@ -283,6 +284,8 @@ int MidiDriver_FluidSynth::open() {
 
 	MidiDriver_Emulated::open();
 
+	startRenderAhead(ConfMan.getInt("midi_render_ahead"));
+
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
@@ -294,6 +297,7 @@ void MidiDriver_FluidSynth::close() {
 	_isOpen = false;
 
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderAhead();
 
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
@@ -307,7 +311,10 @@ void MidiDriver_FluidSynth::send(uint32 b) {
 		return;
 
 	midiDriverCommonSend(b);
+	queueEvent(b);
+}
 
+void MidiDriver_FluidSynth::playEvent(uint32 b, const byte *data, uint16 length) {
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
 	uint param2 = (byte) ((b >> 16) & 0xFF);
 	uint param1 = (byte) ((b >>  8) & 0xFF);
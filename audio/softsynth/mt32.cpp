@@ -115,6 +115,7 @@ private:
 
 protected:
 	void generateSamples(int16 *buf, int len) override;
+	void playEvent(uint32 b, const byte *data, uint16 length) override;
 
 public:
 	MidiDriver_MT32(Audio::Mixer *mixer);
@@ -209,6 +210,9 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
+	// Munt is expensive enough to render it outside of the mixer callback
+	startRenderAhead(ConfMan.getInt("midi_render_ahead"));
+
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
@@ -216,9 +220,7 @@ int MidiDriver_MT32::open() {
 
 void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
-
-	Common::StackLock lock(_mutex);
-	_service.playMsg(b);
+	queueEvent(b);
 }
 
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
@@ -227,15 +229,22 @@ void MidiDriver_MT32::setPitchBendRange(byte channel, uint range) {
 	if (range > 24) {
 		warning("setPitchBendRange() called with range > 24: %d", range);
 	}
-	byte benderRangeSysex[4] = { 0, 0, 4, (uint8)range };
-	Common::StackLock lock(_mutex);
-	_service.writeSysex(channel, benderRangeSysex, 4);
+	// A DT1 command for the channel, in the format handled by playEvent()
+	byte benderRangeSysex[9] = { 0x41, channel, 0x16, 0x12, 0, 0, 4, (uint8)range, 0 };
+	queueEvent(0, benderRangeSysex, sizeof(benderRangeSysex));
 }
 
 void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	midiDriverCommonSysEx(msg, length);
-	if (msg[0] == 0xf0) {
-		Common::StackLock lock(_mutex);
+	queueEvent(0, msg, length);
+}
+
+void MidiDriver_MT32::playEvent(uint32 b, const byte *msg, uint16 length) {
+	Common::StackLock lock(_mutex);
+
+	if (!msg) {
+		_service.playMsg(b);
+	} else if (msg[0] == 0xf0) {
 		_service.playSysex(msg, length);
 	} else {
 		enum {
@@ -244,7 +253,6 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 		};
 
 		if (msg[3] == SYSEX_CMD_DT1 || msg[3] == SYSEX_CMD_DAT) {
-			Common::StackLock lock(_mutex);
 			_service.writeSysex(msg[1], msg + 4, length - 5);
 		} else {
 			warning("Unused sysEx command %d", msg[3]);
@@ -257,10 +265,12 @@ void MidiDriver_MT32::close() {
 		return;
 	_isOpen = false;
 
-	// Detach the player callback handler
-	setTimerCallback(NULL, NULL);
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
+	// The render thread calls the player callback handler, stop it first
+	stopRenderAhead();
+	// Detach the player callback handler
+	setTimerCallback(NULL, NULL);
 
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
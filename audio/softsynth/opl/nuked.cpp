@@ -689,6 +689,32 @@ static void OPL3_SlotCalcFB(opl3_slot *slot)
     slot->prout = slot->out;
 }
 
+static void OPL3_SlotProcess(opl3_slot *slot)
+{
+    opl3_chip *chip = slot->chip;
+    Bit8u n_bit;
+
+    // A keyed off slot at the maximum attenuation stays silent until the
+    // next key on, which resets its phase. Only the noise generator has
+    // to keep running for it. The rhythm slots are needed for their phase.
+    if (chip->skipidle && !slot->key && slot->eg_rout == 0x1ff
+        && slot->eg_gen == envelope_gen_num_release
+        && !((chip->rhy & 0x20) && slot->slot_num >= 12 && slot->slot_num <= 17))
+    {
+        slot->out = 0;
+        slot->prout = 0;
+        slot->fbmod = 0;
+        n_bit = ((chip->noise >> 14) ^ chip->noise) & 0x01;
+        chip->noise = (chip->noise >> 1) | (n_bit << 22);
+        return;
+    }
+
+    OPL3_SlotCalcFB(slot);
+    OPL3_EnvelopeCalc(slot);
+    OPL3_PhaseGenerate(slot);
+    OPL3_SlotGenerate(slot);
+}
+
 //
 // Channel
 //
@@ -1071,10 +1097,7 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     for (ii = 0; ii < 15; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     chip->mixbuff[0] = 0;
@@ -1090,20 +1113,14 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     for (ii = 15; ii < 18; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     buf[0] = OPL3_ClipSample(chip->mixbuff[0]);
 
     for (ii = 18; ii < 33; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     chip->mixbuff[1] = 0;
@@ -1119,10 +1136,7 @@ void OPL3_Generate(opl3_chip *chip, Bit16s *buf)
 
     for (ii = 33; ii < 36; ii++)
     {
-        OPL3_SlotCalcFB(&chip->slot[ii]);
-        OPL3_EnvelopeCalc(&chip->slot[ii]);
-        OPL3_PhaseGenerate(&chip->slot[ii]);
-        OPL3_SlotGenerate(&chip->slot[ii]);
+        OPL3_SlotProcess(&chip->slot[ii]);
     }
 
     if ((chip->timer & 0x3f) == 0x3f)
@@ -1399,7 +1413,7 @@ void OPL3_GenerateStream(opl3_chip *chip, Bit16s *sndptr, Bit32u numsamples)
     }
 }
 
-OPL::OPL(Config::OplType type) : _type(type), _rate(0) {
+OPL::OPL(Config::OplType type, bool fast) : _type(type), _rate(0), _fast(fast) {
 }
 
 OPL::~OPL() {
@@ -1409,6 +1423,7 @@ OPL::~OPL() {
 bool OPL::init() {
 	_rate = g_system->getMixer()->getOutputRate();
 	OPL3_Reset(&chip, _rate);
+	chip.skipidle = _fast;
 
 	if (_type == Config::kDualOpl2) {
 		OPL3_WriteReg(&chip, 0x105, 0x01);
@@ -1419,6 +1434,7 @@ bool OPL::init() {
 
 void OPL::reset() {
 	OPL3_Reset(&chip, _rate);
+	chip.skipidle = _fast;
 }
 
 void OPL::write(int port, int val) {
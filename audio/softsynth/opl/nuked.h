@@ -139,6 +139,8 @@ struct _opl3_chip {
     Bit32s samplecnt;
     Bit16s oldsamples[2];
     Bit16s samples[2];
+    //Skip the slots which are silent, at the expense of exactness
+    Bit8u skipidle;
 
     Bit64u writebuf_samplecnt;
     Bit32u writebuf_cur;
@@ -158,12 +160,13 @@ class OPL : public ::OPL::EmulatedOPL {
 private:
 	Config::OplType _type;
 	uint _rate;
+	bool _fast;
 	opl3_chip chip;
 	uint address[2];
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
 
 public:
-	OPL(Config::OplType type);
+	OPL(Config::OplType type, bool fast = false);
 	~OPL();
 
 	bool init();
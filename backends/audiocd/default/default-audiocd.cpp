@@ -22,10 +22,126 @@
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "audio/audiostream.h"
+#include "audio/decodeahead.h"
 #include "common/config-manager.h"
 #include "common/system.h"
 #include "common/util.h"
 
+#include <atomic>
+
+// Longest track segment whose decoded samples are kept for looping
+static const uint32 kMaxSegmentSeconds = 30;
+
+/**
+ * Decoded samples of an emulated track segment, shared by the manager and
+ * the stream playing the segment. The samples are only read by others once
+ * the segment is complete.
+ */
+struct AudioCDSegment {
+	std::atomic<int> refCount;
+	std::atomic<bool> complete;
+
+	const int track;
+	const int start;
+	const int duration;
+	const int rate;
+	const bool stereo;
+
+	int16 *data;
+	uint32 count;
+	uint32 capacity;
+
+	AudioCDSegment(int t, int s, int d, int r, bool st, uint32 c) :
+		refCount(1), complete(false), track(t), start(s), duration(d), rate(r), stereo(st),
+		data(nullptr), count(0), capacity(c) {}
+	~AudioCDSegment() { free(data); }
+
+	void acquire() { refCount.fetch_add(1); }
+	void release() {
+		if (refCount.fetch_sub(1) == 1)
+			delete this;
+	}
+
+	bool matches(int t, int s, int d) const {
+		return complete.load() && track == t && start == s && duration == d;
+	}
+};
+
+/**
+ * Plays a track segment while keeping its decoded samples. Once the segment
+ * played through completely, rewinding closes the track and plays the
+ * samples from memory, so that loops cost neither decoding nor seeking.
+ */
+class AudioCDSegmentStream : public Audio::RewindableAudioStream {
+public:
+	/**
+	 * @param parent The segment, or NULL to play the samples of a complete segment
+	 */
+	AudioCDSegmentStream(Audio::RewindableAudioStream *parent, AudioCDSegment *segment) :
+		_parent(parent), _segment(segment), _recording(parent != nullptr), _pos(0) {
+		_segment->acquire();
+	}
+
+	~AudioCDSegmentStream() {
+		delete _parent;
+		_segment->release();
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		if (!_parent) {
+			const uint32 len = MIN<uint32>(numSamples, _segment->count - _pos);
+			memcpy(buffer, _segment->data + _pos, len * sizeof(int16));
+			_pos += len;
+			return len;
+		}
+
+		const int len = _parent->readBuffer(buffer, numSamples);
+		if (_recording && len > 0) {
+			if (_segment->count + len > _segment->capacity) {
+				// Longer than announced, give up
+				_recording = false;
+			} else {
+				if (!_segment->data)
+					_segment->data = (int16 *)malloc(_segment->capacity * sizeof(int16));
+				memcpy(_segment->data + _segment->count, buffer, len * sizeof(int16));
+				_segment->count += len;
+			}
+		}
+
+		if (_recording && _parent->endOfData()) {
+			_recording = false;
+			_segment->complete.store(_segment->count > 0);
+		}
+		return len;
+	}
+
+	bool isStereo() const override { return _segment->stereo; }
+	int getRate() const override { return _segment->rate; }
+	bool endOfData() const override { return _parent ? _parent->endOfData() : _pos >= _segment->count; }
+
+	bool rewind() override {
+		if (_parent && _segment->complete.load()) {
+			delete _parent;
+			_parent = nullptr;
+		}
+
+		if (!_parent) {
+			_pos = 0;
+			return true;
+		}
+
+		// Only record a pass from the start
+		_recording = false;
+		return _parent->rewind();
+	}
+
+private:
+	Audio::RewindableAudioStream *_parent;
+	AudioCDSegment *_segment;
+	bool _recording;
+	uint32 _pos;
+};
+
 DefaultAudioCDManager::DefaultAudioCDManager() {
 	_cd.playing = false;
 	_cd.track = 0;
@@ -36,12 +152,16 @@ DefaultAudioCDManager::DefaultAudioCDManager() {
 	_cd.balance = 0;
 	_mixer = g_system->getMixer();
 	_emulating = false;
+	_segment = nullptr;
 	assert(_mixer);
 }
 
 DefaultAudioCDManager::~DefaultAudioCDManager() {
 	// Subclasses should call close as well
 	close();
+
+	if (_segment)
+		_segment->release();
 }
 
 bool DefaultAudioCDManager::open() {
@@ -65,6 +185,21 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 		_cd.start = startFrame;
 		_cd.duration = duration;
 
+		/*
+		FIXME: Seems numLoops == 0 and numLoops == 1 both indicate a single repetition,
+		while all other positive numbers indicate precisely the number of desired
+		repetitions. Finally, -1 means infinitely many
+		*/
+		const uint loops = (numLoops < 1) ? numLoops + 1 : numLoops;
+
+		// Replay the segment from memory if it played through before
+		if (_segment && _segment->matches(track, startFrame, duration)) {
+			_emulating = true;
+			_mixer->playStream(soundType, &_handle,
+			                        Audio::makeLoopingAudioStream(new AudioCDSegmentStream(nullptr, _segment), loops), -1, _cd.volume, _cd.balance);
+			return true;
+		}
+
 		// Try to load the track from a compressed data file, and if found, use
 		// that. If not found, attempt to start regular Audio CD playback of
 		// the requested track.
@@ -82,14 +217,29 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 			Audio::Timestamp start = Audio::Timestamp(0, startFrame, 75);
 			Audio::Timestamp end = duration ? Audio::Timestamp(0, startFrame + duration, 75) : stream->getLength();
 
-			/*
-			FIXME: Seems numLoops == 0 and numLoops == 1 both indicate a single repetition,
-			while all other positive numbers indicate precisely the number of desired
-			repetitions. Finally, -1 means infinitely many
-			*/
+			// Keep the decoder away from the mixer thread
+			const int rate = stream->getRate();
+			const bool stereo = stream->isStereo();
+			stream = Audio::makeDecodeAheadStream(stream);
+
+			// Keep the samples of short segments, which are usually looped
+			if (start < end && end <= stream->getLength() && (end - start).msecs() <= (int)kMaxSegmentSeconds * 1000) {
+				if (_segment)
+					_segment->release();
+				// Leave some room for rounding by the decoder
+				const uint32 samples = ((uint32)(end - start).convertToFramerate(rate).totalNumberOfFrames() + rate / 75) * (stereo ? 2 : 1);
+				_segment = new AudioCDSegment(track, startFrame, duration, rate, stereo, samples);
+
+				_emulating = true;
+				_mixer->playStream(soundType, &_handle,
+				                        Audio::makeLoopingAudioStream(new AudioCDSegmentStream(new Audio::SubSeekableAudioStream(stream, start, end), _segment), loops),
+				                        -1, _cd.volume, _cd.balance);
+				return true;
+			}
+
 			_emulating = true;
 			_mixer->playStream(soundType, &_handle,
-			                        Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops), -1, _cd.volume, _cd.balance);
+			                        Audio::makeLoopingAudioStream(stream, start, end, loops), -1, _cd.volume, _cd.balance);
 			return true;
 		}
 	}
@@ -30,6 +30,8 @@ namespace Common {
 class String;
 } // End of namespace Common
 
+struct AudioCDSegment;
+
 /**
  * The default audio cd manager. Implements emulation of audio cd playback.
  */
@@ -74,6 +76,9 @@ protected:
 
 	Status _cd;
 	Audio::Mixer *_mixer;
+
+	/** Decoded samples of the last emulated track segment */
+	AudioCDSegment *_segment;
 };
 
 #endif
@@ -365,6 +365,9 @@ Common::String CloudManager::savesDirectoryPath() {
 }
 
 bool CloudManager::canSyncFilename(const Common::String &filename) const {
+	// Files starting with a dot are never synced. The files ScummVM keeps
+	// for itself in the saves directory, such as the save index and the
+	// detection and theme caches, rely on this.
 	if (filename == "" || filename[0] == '.')
 		return false;
 
@@ -38,7 +38,7 @@ namespace Dropbox {
 
 DropboxUploadRequest::DropboxUploadRequest(DropboxStorage *storage, Common::String path, Common::SeekableReadStream *contents, Storage::UploadCallback callback, Networking::ErrorCallback ecb):
 	Networking::Request(nullptr, ecb), _storage(storage), _savePath(path), _contentsStream(contents), _uploadCallback(callback),
-	_workingRequest(nullptr), _ignoreCallback(false) {
+	_workingRequest(nullptr), _ignoreCallback(false), _partOffset(0), _partRetries(0) {
 	start();
 }
 
@@ -64,6 +64,8 @@ void DropboxUploadRequest::start() {
 		finishError(Networking::ErrorResponse(this, false, true, "DropboxUploadRequest::start: cannot restart because stream couldn't seek(0)", -1));
 		return;
 	}
+	_partOffset = 0;
+	_partRetries = 0;
 	_ignoreCallback = false;
 
 	uploadNextPart();
@@ -116,6 +118,7 @@ void DropboxUploadRequest::uploadNextPart() {
 	request->addHeader("Content-Type: application/octet-stream");
 	request->addHeader("Dropbox-API-Arg: " + Common::JSON::stringify(&value));
 
+	_partOffset = _contentsStream->pos();
 	byte *buffer = new byte[UPLOAD_PER_ONE_REQUEST];
 	uint32 size = _contentsStream->read(buffer, UPLOAD_PER_ONE_REQUEST);
 	request->setBuffer(buffer, size);
@@ -140,6 +143,7 @@ void DropboxUploadRequest::partUploadedCallback(Networking::JsonResponse respons
 		return;
 	}
 
+	_partRetries = 0;
 	bool needsFinishRequest = false;
 
 	if (json->isObject()) {
@@ -186,9 +190,22 @@ void DropboxUploadRequest::partUploadedCallback(Networking::JsonResponse respons
 }
 
 void DropboxUploadRequest::partUploadedErrorCallback(Networking::ErrorResponse error) {
+	const uint32 MAX_PART_RETRIES = 3;
+
 	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
+
+	//the connection failed or the server had a problem: send the same part again,
+	//instead of uploading the whole file again during the next sync
+	bool transient = !error.interrupted && (error.httpResponseCode <= 0 || error.httpResponseCode >= 500);
+	if (transient && _partRetries < MAX_PART_RETRIES && _contentsStream->seek(_partOffset)) {
+		++_partRetries;
+		warning("DropboxUploadRequest: failed to upload the part at %u, retrying", _partOffset);
+		uploadNextPart();
+		return;
+	}
+
 	finishError(error);
 }
 
@@ -41,6 +41,7 @@ class DropboxUploadRequest: public Networking::Request {
 	Request *_workingRequest;
 	bool _ignoreCallback;
 	Common::String _sessionId;
+	uint32 _partOffset, _partRetries;
 
 	void start();
 	void uploadNextPart();
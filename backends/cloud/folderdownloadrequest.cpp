@@ -33,7 +33,7 @@ namespace Cloud {
 FolderDownloadRequest::FolderDownloadRequest(Storage *storage, Storage::FileArrayCallback callback, Networking::ErrorCallback ecb, Common::String remoteDirectoryPath, Common::String localDirectoryPath, bool recursive):
 	Request(nullptr, ecb), CommandSender(nullptr), _storage(storage), _fileArrayCallback(callback),
 	_remoteDirectoryPath(remoteDirectoryPath), _localDirectoryPath(localDirectoryPath), _recursive(recursive),
-	_workingRequest(nullptr), _ignoreCallback(false), _totalFiles(0) {
+	_workingRequest(nullptr), _ignoreCallback(false), _startingDownloads(false), _totalFiles(0) {
 	start();
 }
 
@@ -42,6 +42,7 @@ FolderDownloadRequest::~FolderDownloadRequest() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
+	finishDownloads();
 	delete _fileArrayCallback;
 }
 
@@ -50,7 +51,7 @@ void FolderDownloadRequest::start() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
-	_currentFile = StorageFile();
+	finishDownloads();
 	_pendingFiles.clear();
 	_failedFiles.clear();
 	_ignoreCallback = false;
@@ -84,7 +85,8 @@ void FolderDownloadRequest::directoryListedCallback(Storage::ListDirectoryRespon
 		}
 
 	_totalFiles = _pendingFiles.size();
-	downloadNextFile();
+	_downloads.reserve(ConnMan.getMaxHostConnections());
+	downloadNextFiles();
 }
 
 void FolderDownloadRequest::directoryListedErrorCallback(Networking::ErrorResponse error) {
@@ -95,58 +97,98 @@ void FolderDownloadRequest::directoryListedErrorCallback(Networking::ErrorRespon
 }
 
 void FolderDownloadRequest::fileDownloadedCallback(Storage::BoolResponse response) {
-	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
-	if (!response.value) _failedFiles.push_back(_currentFile);
-	_downloadedBytes += _currentFile.size();
-	downloadNextFile();
+	int index = findDownload(response.request);
+	if (index < 0)
+		return;
+	if (!response.value) _failedFiles.push_back(_downloads[index].file);
+	_downloadedBytes += _downloads[index].file.size();
+	_downloads.remove_at(index);
+	downloadNextFiles();
 }
 
 void FolderDownloadRequest::fileDownloadedErrorCallback(Networking::ErrorResponse error) {
-	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
 	fileDownloadedCallback(Storage::BoolResponse(error.request, false));
 }
 
-void FolderDownloadRequest::downloadNextFile() {
-	do {
-		if (_pendingFiles.empty()) {
-			sendCommand(GUI::kDownloadEndedCmd, 0);
-			finishDownload(_failedFiles);
-			return;
-		}
+int FolderDownloadRequest::findDownload(Request *request) const {
+	// The error callbacks may pass the inner Request which failed instead
+	// of the one we started, so fall back to the one which just finished,
+	// or to the one being started if it failed right away
+	for (uint i = 0; i < _downloads.size(); ++i)
+		if (request && _downloads[i].request == request)
+			return i;
+	for (uint i = 0; i < _downloads.size(); ++i)
+		if (_downloads[i].request && _downloads[i].request->state() == Networking::FINISHED)
+			return i;
+	for (uint i = 0; i < _downloads.size(); ++i)
+		if (!_downloads[i].request)
+			return i;
+	return -1;
+}
 
-		_currentFile = _pendingFiles.back();
-		_pendingFiles.pop_back();
-	} while (_currentFile.isDirectory()); // directories are actually removed earlier, in the directoryListedCallback()
+void FolderDownloadRequest::finishDownloads() {
+	bool ignoreCallback = _ignoreCallback;
+	_ignoreCallback = true;
+	for (uint i = 0; i < _downloads.size(); ++i)
+		if (_downloads[i].request)
+			_downloads[i].request->finish();
+	_downloads.clear();
+	_ignoreCallback = ignoreCallback;
+}
 
-	sendCommand(GUI::kDownloadProgressCmd, (int)(getProgress() * 100));
+void FolderDownloadRequest::downloadNextFiles() {
+	// a download failing right away calls back from downloadById(), and the loop below goes on
+	if (_startingDownloads)
+		return;
 
-	Common::String remotePath = _currentFile.path();
-	Common::String localPath = remotePath;
-	if (_remoteDirectoryPath == "" || remotePath.hasPrefix(_remoteDirectoryPath)) {
-		localPath.erase(0, _remoteDirectoryPath.size());
-		if (_remoteDirectoryPath != "" && (_remoteDirectoryPath.lastChar() != '/' && _remoteDirectoryPath.lastChar() != '\\'))
-			localPath.erase(0, 1);
-	} else {
-		warning("FolderDownloadRequest: Can't process the following paths:");
-		warning("remote directory: %s", _remoteDirectoryPath.c_str());
-		warning("remote file under that directory: %s", remotePath.c_str());
+	_startingDownloads = true;
+	while (_downloads.size() < ConnMan.getMaxHostConnections() && !_pendingFiles.empty()) {
+		StorageFile file = _pendingFiles.back();
+		_pendingFiles.pop_back();
+		if (file.isDirectory()) // directories are actually removed earlier, in the directoryListedCallback()
+			continue;
+
+		Common::String remotePath = file.path();
+		Common::String localPath = remotePath;
+		if (_remoteDirectoryPath == "" || remotePath.hasPrefix(_remoteDirectoryPath)) {
+			localPath.erase(0, _remoteDirectoryPath.size());
+			if (_remoteDirectoryPath != "" && (_remoteDirectoryPath.lastChar() != '/' && _remoteDirectoryPath.lastChar() != '\\'))
+				localPath.erase(0, 1);
+		} else {
+			warning("FolderDownloadRequest: Can't process the following paths:");
+			warning("remote directory: %s", _remoteDirectoryPath.c_str());
+			warning("remote file under that directory: %s", remotePath.c_str());
+		}
+		if (_localDirectoryPath != "") {
+			if (_localDirectoryPath.lastChar() == '/' || _localDirectoryPath.lastChar() == '\\')
+				localPath = _localDirectoryPath + localPath;
+			else
+				localPath = _localDirectoryPath + "/" + localPath;
+		}
+		debug(9, "FolderDownloadRequest: %s -> %s", remotePath.c_str(), localPath.c_str());
+		_downloads.push_back(FileDownload(file));
+		Request *request = _storage->downloadById(
+			file.id(), localPath,
+			new Common::Callback<FolderDownloadRequest, Storage::BoolResponse>(this, &FolderDownloadRequest::fileDownloadedCallback),
+			new Common::Callback<FolderDownloadRequest, Networking::ErrorResponse>(this, &FolderDownloadRequest::fileDownloadedErrorCallback)
+		);
+		int index = findDownload(nullptr);
+		if (index >= 0 && !_downloads[index].request)
+			_downloads[index].request = request;
 	}
-	if (_localDirectoryPath != "") {
-		if (_localDirectoryPath.lastChar() == '/' || _localDirectoryPath.lastChar() == '\\')
-			localPath = _localDirectoryPath + localPath;
-		else
-			localPath = _localDirectoryPath + "/" + localPath;
+	_startingDownloads = false;
+
+	if (_downloads.empty() && _pendingFiles.empty()) {
+		sendCommand(GUI::kDownloadEndedCmd, 0);
+		finishDownload(_failedFiles);
+		return;
 	}
-	debug(9, "FolderDownloadRequest: %s -> %s", remotePath.c_str(), localPath.c_str());
-	_workingRequest = _storage->downloadById(
-		_currentFile.id(), localPath,
-		new Common::Callback<FolderDownloadRequest, Storage::BoolResponse>(this, &FolderDownloadRequest::fileDownloadedCallback),
-		new Common::Callback<FolderDownloadRequest, Networking::ErrorResponse>(this, &FolderDownloadRequest::fileDownloadedErrorCallback)
-	);
+
+	sendCommand(GUI::kDownloadProgressCmd, (int)(getProgress() * 100));
 }
 
 void FolderDownloadRequest::handle() {
@@ -175,17 +217,20 @@ uint64 FolderDownloadRequest::getDownloadedBytes() const {
 	if (_totalFiles == 0)
 		return 0;
 
-	double currentFileProgress = 0;
-	DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(_workingRequest);
-	if (downloadRequest != nullptr) {
-		currentFileProgress = downloadRequest->getProgress();
-	} else {
-		Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(_workingRequest);
-		if (idDownloadRequest != nullptr)
-			currentFileProgress = idDownloadRequest->getProgress();
+	uint64 downloadedBytes = _downloadedBytes;
+	for (uint i = 0; i < _downloads.size(); ++i) {
+		double fileProgress = 0;
+		DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(_downloads[i].request);
+		if (downloadRequest != nullptr) {
+			fileProgress = downloadRequest->getProgress();
+		} else {
+			Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(_downloads[i].request);
+			if (idDownloadRequest != nullptr)
+				fileProgress = idDownloadRequest->getProgress();
+		}
+		downloadedBytes += (uint64)(fileProgress * _downloads[i].file.size());
 	}
-
-	return _downloadedBytes + (uint64)(currentFileProgress * _currentFile.size());
+	return downloadedBytes;
 }
 
 uint64 FolderDownloadRequest::getTotalBytesToDownload() const {
@@ -30,14 +30,22 @@
 namespace Cloud {
 
 class FolderDownloadRequest: public Networking::Request, public GUI::CommandSender {
+	/** A file which is being downloaded, and the Request downloading it. */
+	struct FileDownload {
+		StorageFile file;
+		Request *request;
+
+		FileDownload(const StorageFile &f = StorageFile()): file(f), request(nullptr) {}
+	};
+
 	Storage *_storage;
 	Storage::FileArrayCallback _fileArrayCallback;
 	Common::String _remoteDirectoryPath, _localDirectoryPath;
 	bool _recursive;
 	Common::Array<StorageFile> _pendingFiles, _failedFiles;
-	StorageFile _currentFile;
+	Common::Array<FileDownload> _downloads;
 	Request *_workingRequest;
-	bool _ignoreCallback;
+	bool _ignoreCallback, _startingDownloads;
 	uint32 _totalFiles;
 	uint64 _downloadedBytes, _totalBytes, _wasDownloadedBytes, _currentDownloadSpeed;
 
@@ -46,7 +54,9 @@ class FolderDownloadRequest: public Networking::Request, public GUI::CommandSend
 	void directoryListedErrorCallback(Networking::ErrorResponse error);
 	void fileDownloadedCallback(Storage::BoolResponse response);
 	void fileDownloadedErrorCallback(Networking::ErrorResponse error);
-	void downloadNextFile();
+	int findDownload(Request *request) const;
+	void finishDownloads();
+	void downloadNextFiles();
 	void finishDownload(Common::Array<StorageFile> &files);
 public:
 	FolderDownloadRequest(Storage *storage, Storage::FileArrayCallback callback, Networking::ErrorCallback ecb, Common::String remoteDirectoryPath, Common::String localDirectoryPath, bool recursive);
@@ -37,7 +37,7 @@ namespace GoogleDrive {
 
 GoogleDriveUploadRequest::GoogleDriveUploadRequest(GoogleDriveStorage *storage, Common::String path, Common::SeekableReadStream *contents, Storage::UploadCallback callback, Networking::ErrorCallback ecb):
 	Networking::Request(nullptr, ecb), _storage(storage), _savePath(path), _contentsStream(contents), _uploadCallback(callback),
-	_workingRequest(nullptr), _ignoreCallback(false) {
+	_workingRequest(nullptr), _ignoreCallback(false), _serverReceivedBytes(0), _partRetries(0) {
 	start();
 }
 
@@ -61,6 +61,7 @@ void GoogleDriveUploadRequest::start() {
 	_resolvedId = ""; //used to update file contents
 	_parentId = ""; //used to create file within parent directory
 	_serverReceivedBytes = 0;
+	_partRetries = 0;
 	_ignoreCallback = false;
 
 	resolveId();
@@ -221,6 +222,19 @@ void GoogleDriveUploadRequest::uploadNextPart() {
 	_workingRequest = ConnMan.addRequest(request);
 }
 
+void GoogleDriveUploadRequest::queryUploadStatus() {
+	//an empty PUT with "bytes */size" range makes the server tell how much it has received
+	Networking::JsonCallback callback = new Common::Callback<GoogleDriveUploadRequest, Networking::JsonResponse>(this, &GoogleDriveUploadRequest::partUploadedCallback);
+	Networking::ErrorCallback failureCallback = new Common::Callback<GoogleDriveUploadRequest, Networking::ErrorResponse>(this, &GoogleDriveUploadRequest::partUploadedErrorCallback);
+	Networking::CurlJsonRequest *request = new GoogleDriveTokenRefresher(_storage, callback, failureCallback, _uploadUrl.c_str());
+	request->addHeader("Authorization: Bearer " + _storage->accessToken());
+	request->usePut();
+	request->addHeader("Content-Length: 0");
+	request->addHeader(Common::String::format("Content-Range: bytes */%u", _contentsStream->size()));
+
+	_workingRequest = ConnMan.addRequest(request);
+}
+
 bool GoogleDriveUploadRequest::handleHttp308(const Networking::NetworkReadStream *stream) {
 	//308 Resume Incomplete, with Range: X-Y header
 	if (!stream)
@@ -237,11 +251,19 @@ bool GoogleDriveUploadRequest::handleHttp308(const Networking::NetworkReadStream
 
 			if (range.hasPrefix(needle)) {
 				range.erase(0, needleLength);
-				_serverReceivedBytes = range.asUint64() + 1;
+				uint64 receivedBytes = range.asUint64() + 1;
+				if (receivedBytes > _serverReceivedBytes)
+					_partRetries = 0;
+				_serverReceivedBytes = receivedBytes;
 				uploadNextPart();
 				return true;
 			}
 		}
+	} else {
+		//no range means nothing was received yet
+		_serverReceivedBytes = 0;
+		uploadNextPart();
+		return true;
 	}
 
 	return false;
@@ -313,6 +335,8 @@ void GoogleDriveUploadRequest::partUploadedCallback(Networking::JsonResponse res
 }
 
 void GoogleDriveUploadRequest::partUploadedErrorCallback(Networking::ErrorResponse error) {
+	const uint32 MAX_PART_RETRIES = 3;
+
 	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
@@ -328,6 +352,16 @@ void GoogleDriveUploadRequest::partUploadedErrorCallback(Networking::ErrorRespon
 		}
 	}
 
+	//the connection failed or the server had a problem: ask how much it has received,
+	//and go on from there instead of uploading the whole file again during the next sync
+	bool transient = !error.interrupted && (error.httpResponseCode <= 0 || error.httpResponseCode >= 500);
+	if (transient && _uploadUrl != "" && _partRetries < MAX_PART_RETRIES) {
+		++_partRetries;
+		warning("GoogleDriveUploadRequest: failed to upload the part at %u, retrying", (uint32)_serverReceivedBytes);
+		queryUploadStatus();
+		return;
+	}
+
 	finishError(error);
 }
 
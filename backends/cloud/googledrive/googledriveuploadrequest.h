@@ -42,6 +42,7 @@ class GoogleDriveUploadRequest: public Networking::Request {
 	Common::String _resolvedId, _parentId;
 	Common::String _uploadUrl;
 	uint64 _serverReceivedBytes;
+	uint32 _partRetries;
 
 	void start();
 	void resolveId();
@@ -51,6 +52,7 @@ class GoogleDriveUploadRequest: public Networking::Request {
 	void startUploadCallback(Networking::JsonResponse response);
 	void startUploadErrorCallback(Networking::ErrorResponse error);
 	void uploadNextPart();
+	void queryUploadStatus();
 	void partUploadedCallback(Networking::JsonResponse response);
 	void partUploadedErrorCallback(Networking::ErrorResponse error);
 	bool handleHttp308(const Networking::NetworkReadStream *stream);
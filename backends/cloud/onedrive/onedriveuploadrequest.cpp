@@ -38,7 +38,7 @@ namespace OneDrive {
 
 OneDriveUploadRequest::OneDriveUploadRequest(OneDriveStorage *storage, Common::String path, Common::SeekableReadStream *contents, Storage::UploadCallback callback, Networking::ErrorCallback ecb):
 	Networking::Request(nullptr, ecb), _storage(storage), _savePath(path), _contentsStream(contents), _uploadCallback(callback),
-	_workingRequest(nullptr), _ignoreCallback(false) {
+	_workingRequest(nullptr), _ignoreCallback(false), _partOffset(0), _partRetries(0) {
 	start();
 }
 
@@ -64,6 +64,8 @@ void OneDriveUploadRequest::start() {
 		finishError(Networking::ErrorResponse(this, false, true, "OneDriveUploadRequest::start: can't restart, because seek(0) didn't work", -1));
 		return;
 	}
+	_partOffset = 0;
+	_partRetries = 0;
 	_ignoreCallback = false;
 
 	uploadNextPart();
@@ -97,6 +99,7 @@ void OneDriveUploadRequest::uploadNextPart() {
 	request->usePut();
 
 	uint32 oldPos = _contentsStream->pos();
+	_partOffset = oldPos;
 
 	byte *buffer = new byte[UPLOAD_PER_ONE_REQUEST];
 	uint32 size = _contentsStream->read(buffer, UPLOAD_PER_ONE_REQUEST);
@@ -131,6 +134,7 @@ void OneDriveUploadRequest::partUploadedCallback(Networking::JsonResponse respon
 		return;
 	}
 
+	_partRetries = 0;
 	if (json->isObject()) {
 		Common::JSONObject object = json->asObject();
 
@@ -171,9 +175,22 @@ void OneDriveUploadRequest::partUploadedCallback(Networking::JsonResponse respon
 }
 
 void OneDriveUploadRequest::partUploadedErrorCallback(Networking::ErrorResponse error) {
+	const uint32 MAX_PART_RETRIES = 3;
+
 	_workingRequest = nullptr;
 	if (_ignoreCallback)
 		return;
+
+	//the connection failed or the server had a problem: send the same part again,
+	//instead of uploading the whole file again during the next sync
+	bool transient = !error.interrupted && (error.httpResponseCode <= 0 || error.httpResponseCode >= 500);
+	if (transient && _partRetries < MAX_PART_RETRIES && _contentsStream->seek(_partOffset)) {
+		++_partRetries;
+		warning("OneDriveUploadRequest: failed to upload the part at %u, retrying", _partOffset);
+		uploadNextPart();
+		return;
+	}
+
 	finishError(error);
 }
 
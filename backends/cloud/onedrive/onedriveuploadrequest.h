@@ -40,6 +40,7 @@ class OneDriveUploadRequest: public Networking::Request {
 	Request *_workingRequest;
 	bool _ignoreCallback;
 	Common::String _uploadUrl;
+	uint32 _partOffset, _partRetries;
 
 	void start();
 	void uploadNextPart();
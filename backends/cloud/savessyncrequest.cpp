@@ -22,6 +22,7 @@
 
 #include "backends/cloud/savessyncrequest.h"
 #include "backends/cloud/cloudmanager.h"
+#include "backends/networking/curl/connectionmanager.h"
 #include "backends/networking/curl/curljsonrequest.h"
 #include "backends/saves/default/default-saves.h"
 #include "common/config-manager.h"
@@ -36,7 +37,7 @@ namespace Cloud {
 
 SavesSyncRequest::SavesSyncRequest(Storage *storage, Storage::BoolCallback callback, Networking::ErrorCallback ecb):
 	Request(nullptr, ecb), CommandSender(nullptr), _storage(storage), _boolCallback(callback),
-	_workingRequest(nullptr), _ignoreCallback(false) {
+	_workingRequest(nullptr), _ignoreCallback(false), _startingDownloads(false), _nextDownloadId(0) {
 	start();
 }
 
@@ -44,6 +45,9 @@ SavesSyncRequest::~SavesSyncRequest() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
+	for (uint32 i = 0; i < _downloads.size(); ++i)
+		if (_downloads[i].request)
+			_downloads[i].request->finish();
 	delete _boolCallback;
 }
 
@@ -52,16 +56,21 @@ void SavesSyncRequest::start() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
-	_currentDownloadingFile = StorageFile();
+	for (uint32 i = 0; i < _downloads.size(); ++i)
+		if (_downloads[i].request)
+			_downloads[i].request->finish();
+	_downloads.clear();
 	_currentUploadingFile = "";
 	_filesToDownload.clear();
 	_filesToUpload.clear();
 	_localFilesTimestamps.clear();
+	_localFilesHashes.clear();
 	_totalFilesToHandle = 0;
 	_ignoreCallback = false;
 
 	//load timestamps
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
+	_localFilesHashes = DefaultSaveFileManager::loadHashes();
 
 	//list saves directory
 	Common::String dir = _storage->savesDirectoryPath();
@@ -90,6 +99,7 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 	//determine which files to download and which files to upload
 	Common::Array<StorageFile> &remoteFiles = response.value;
 	uint64 totalSize = 0;
+	bool timestampsRestored = false;
 	debug(9, "SavesSyncRequest decisions:");
 	for (uint32 i = 0; i < remoteFiles.size(); ++i) {
 		StorageFile &file = remoteFiles[i];
@@ -106,6 +116,16 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 		} else {
 			localFileNotAvailableInCloud[name] = false;
 
+			//a file saved again with the same contents gets back the timestamp it was synced with
+			if (_localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP && _localFilesHashes.contains(name)) {
+				const DefaultSaveFileManager::SyncedHash &hash = _localFilesHashes[name];
+				if (DefaultSaveFileManager::computeHash(name) == hash.md5) {
+					debug(9, "- file %s was saved with the same contents it was synced with", name.c_str());
+					_localFilesTimestamps[name] = hash.timestamp;
+					timestampsRestored = true;
+				}
+			}
+
 			if (_localFilesTimestamps[name] == file.timestamp())
 				continue;
 
@@ -125,6 +145,9 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 		}
 	}
 
+	if (timestampsRestored)
+		DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+
 	CloudMan.setStorageUsedSpace(CloudMan.getStorageIndex(), totalSize);
 
 	//upload files which are unavailable in cloud
@@ -160,7 +183,7 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 
 	//start downloading files
 	if (!_filesToDownload.empty()) {
-		downloadNextFile();
+		downloadNextFiles();
 	} else {
 		uploadNextFile();
 	}
@@ -267,56 +290,93 @@ void SavesSyncRequest::directoryCreatedErrorCallback(Networking::ErrorResponse e
 	finishError(error);
 }
 
-void SavesSyncRequest::downloadNextFile() {
-	if (_filesToDownload.empty()) {
-		_currentDownloadingFile = StorageFile("", 0, 0, false); //so getFilesToDownload() would return an empty array
-		sendCommand(GUI::kSavesSyncEndedCmd, 0);
-		uploadNextFile();
-		return;
-	}
+int SavesSyncRequest::findDownload(uint32 id) const {
+	for (uint32 i = 0; i < _downloads.size(); ++i)
+		if (_downloads[i].id == id)
+			return i;
+	return -1;
+}
 
-	_currentDownloadingFile = _filesToDownload.back();
-	_filesToDownload.pop_back();
+void SavesSyncRequest::downloadNextFiles() {
+	//a download failing right away calls back from downloadById(), and the loop below handles it
+	if (_startingDownloads)
+		return;
 
-	sendCommand(GUI::kSavesSyncProgressCmd, (int)(getDownloadingProgress() * 100));
+	_startingDownloads = true;
+	while (_downloads.size() < ConnMan.getMaxHostConnections() && !_filesToDownload.empty()) {
+		StorageFile file = _filesToDownload.back();
+		_filesToDownload.pop_back();
+		const uint32 id = _nextDownloadId++;
+		_downloads.push_back(FileDownload(file, id));
+
+		sendCommand(GUI::kSavesSyncProgressCmd, (int)(getDownloadingProgress() * 100));
+
+		debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", file.name().c_str(), (int)(getProgress() * 100));
+		//the save is written behind the save file manager's back
+		g_system->getSavefileManager()->saveFileChanged(file.name());
+		Request *request = _storage->downloadById(
+			file.id(),
+			DefaultSaveFileManager::concatWithSavesPath(file.name()),
+			new DownloadCallback<Storage::BoolResponse>(this, &SavesSyncRequest::fileDownloadedCallback, id),
+			new DownloadCallback<Networking::ErrorResponse>(this, &SavesSyncRequest::fileDownloadedErrorCallback, id)
+		);
+		if (_state == Networking::FINISHED) {
+			//the download failed right away, and finishError() stopped the others
+			_startingDownloads = false;
+			return;
+		}
+		if (!request) {
+			_startingDownloads = false;
+			finishError(Networking::ErrorResponse(this, "SavesSyncRequest::downloadNextFiles: Storage couldn't create Request to download a file"));
+			return;
+		}
+		//the download may also have finished right away
+		int index = findDownload(id);
+		if (index >= 0)
+			_downloads[index].request = request;
+	}
+	_startingDownloads = false;
 
-	debug(9, "\nSavesSyncRequest: downloading %s (%d %%)", _currentDownloadingFile.name().c_str(), (int)(getProgress() * 100));
-	_workingRequest = _storage->downloadById(
-		_currentDownloadingFile.id(),
-		DefaultSaveFileManager::concatWithSavesPath(_currentDownloadingFile.name()),
-		new Common::Callback<SavesSyncRequest, Storage::BoolResponse>(this, &SavesSyncRequest::fileDownloadedCallback),
-		new Common::Callback<SavesSyncRequest, Networking::ErrorResponse>(this, &SavesSyncRequest::fileDownloadedErrorCallback)
-	);
-	if (!_workingRequest)
-		finishError(Networking::ErrorResponse(this, "SavesSyncRequest::downloadNextFile: Storage couldn't create Request to download a file"));
+	if (_downloads.empty() && _filesToDownload.empty()) {
+		sendCommand(GUI::kSavesSyncEndedCmd, 0);
+		uploadNextFile();
+	}
 }
 
-void SavesSyncRequest::fileDownloadedCallback(Storage::BoolResponse response) {
-	_workingRequest = nullptr;
+void SavesSyncRequest::fileDownloadedCallback(uint32 id, Storage::BoolResponse response) {
 	if (_ignoreCallback)
 		return;
+	int index = findDownload(id);
+	if (index < 0)
+		return;
 
 	//stop syncing if download failed
 	if (!response.value) {
-		//delete the incomplete file
-		g_system->getSavefileManager()->removeSavefile(_currentDownloadingFile.name());
+		//finishError() deletes the incomplete file
+		_downloads[index].request = nullptr;
 		finishError(Networking::ErrorResponse(this, false, true, "SavesSyncRequest::fileDownloadedCallback: failed to download a file", -1));
 		return;
 	}
 
 	//update local timestamp for downloaded file
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
-	_localFilesTimestamps[_currentDownloadingFile.name()] = _currentDownloadingFile.timestamp();
+	_localFilesTimestamps[_downloads[index].file.name()] = _downloads[index].file.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	_localFilesHashes[_downloads[index].file.name()] = DefaultSaveFileManager::SyncedHash(_downloads[index].file.timestamp(), DefaultSaveFileManager::computeHash(_downloads[index].file.name()));
+	DefaultSaveFileManager::saveHashes(_localFilesHashes);
+	g_system->getSavefileManager()->saveFileChanged(_downloads[index].file.name());
+	_downloads.remove_at(index);
 
 	//continue downloading files
-	downloadNextFile();
+	downloadNextFiles();
 }
 
-void SavesSyncRequest::fileDownloadedErrorCallback(Networking::ErrorResponse error) {
-	_workingRequest = nullptr;
+void SavesSyncRequest::fileDownloadedErrorCallback(uint32 id, Networking::ErrorResponse error) {
 	if (_ignoreCallback)
 		return;
+	int index = findDownload(id);
+	if (index >= 0)
+		_downloads[index].request = nullptr;
 
 	//stop syncing if download failed
 	finishError(error);
@@ -359,6 +419,8 @@ void SavesSyncRequest::fileUploadedCallback(Storage::UploadResponse response) {
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
 	_localFilesTimestamps[_currentUploadingFile] = response.value.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	_localFilesHashes[_currentUploadingFile] = DefaultSaveFileManager::SyncedHash(response.value.timestamp(), DefaultSaveFileManager::computeHash(_currentUploadingFile));
+	DefaultSaveFileManager::saveHashes(_localFilesHashes);
 
 	//continue uploading files
 	uploadNextFile();
@@ -388,7 +450,7 @@ double SavesSyncRequest::getDownloadingProgress() const {
 		return 1; //nothing to download => download complete
 
 	uint32 totalFilesToDownload = _totalFilesToHandle - _filesToUpload.size();
-	uint32 filesLeftToDownload = _filesToDownload.size() + (_currentDownloadingFile.name() != "" ? 1 : 0);
+	uint32 filesLeftToDownload = _filesToDownload.size() + _downloads.size();
 	return (double)(totalFilesToDownload - filesLeftToDownload) / (double)(totalFilesToDownload);
 }
 
@@ -406,28 +468,33 @@ Common::Array<Common::String> SavesSyncRequest::getFilesToDownload() {
 	Common::Array<Common::String> result;
 	for (uint32 i = 0; i < _filesToDownload.size(); ++i)
 		result.push_back(_filesToDownload[i].name());
-	if (_currentDownloadingFile.name() != "")
-		result.push_back(_currentDownloadingFile.name());
+	for (uint32 i = 0; i < _downloads.size(); ++i)
+		result.push_back(_downloads[i].file.name());
 	return result;
 }
 
 void SavesSyncRequest::finishError(Networking::ErrorResponse error) {
 	debug(9, "SavesSync::finishError");
-	//if we were downloading a file - remember the name
-	//and make the Request close() it, so we can delete it
-	Common::String name = _currentDownloadingFile.name();
+	//if we were downloading files - remember the names
+	//and make the Requests close() them, so we can delete them
+	Common::Array<Common::String> names;
+	_ignoreCallback = true;
 	if (_workingRequest) {
-		_ignoreCallback = true;
 		_workingRequest->finish();
 		_workingRequest = nullptr;
-		_ignoreCallback = false;
 	}
+	for (uint32 i = 0; i < _downloads.size(); ++i) {
+		names.push_back(_downloads[i].file.name());
+		if (_downloads[i].request)
+			_downloads[i].request->finish();
+	}
+	_ignoreCallback = false;
 	//unlock all the files by making getFilesToDownload() return empty array
-	_currentDownloadingFile = StorageFile();
+	_downloads.clear();
 	_filesToDownload.clear();
-	//delete the incomplete file
-	if (name != "")
-		g_system->getSavefileManager()->removeSavefile(name);
+	//delete the incomplete files
+	for (uint32 i = 0; i < names.size(); ++i)
+		g_system->getSavefileManager()->removeSavefile(names[i]);
 	Request::finishError(error);
 }
 
@@ -25,6 +25,7 @@
 
 #include "backends/networking/curl/request.h"
 #include "backends/cloud/storage.h"
+#include "backends/saves/default/default-saves.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
 #include "gui/object.h"
@@ -32,15 +33,38 @@
 namespace Cloud {
 
 class SavesSyncRequest: public Networking::Request, public GUI::CommandSender {
+	/** A save which is being downloaded, and the Request downloading it. */
+	struct FileDownload {
+		StorageFile file;
+		uint32 id;
+		Request *request;
+
+		FileDownload(const StorageFile &f = StorageFile(), uint32 i = 0): file(f), id(i), request(nullptr) {}
+	};
+
+	/** Passes the response of a download on, along with the id of its FileDownload. */
+	template<typename S>
+	class DownloadCallback: public Common::BaseCallback<S> {
+		typedef void (SavesSyncRequest::*TMethod)(uint32, S);
+		SavesSyncRequest *_object;
+		TMethod _method;
+		uint32 _id;
+	public:
+		DownloadCallback(SavesSyncRequest *object, TMethod method, uint32 id): _object(object), _method(method), _id(id) {}
+		void operator()(S data) override { (_object->*_method)(_id, data); }
+	};
+
 	Storage *_storage;
 	Storage::BoolCallback _boolCallback;
 	Common::HashMap<Common::String, uint32> _localFilesTimestamps;
+	Common::HashMap<Common::String, DefaultSaveFileManager::SyncedHash> _localFilesHashes;
 	Common::Array<StorageFile> _filesToDownload;
 	Common::Array<Common::String> _filesToUpload;
-	StorageFile _currentDownloadingFile;
+	Common::Array<FileDownload> _downloads;
 	Common::String _currentUploadingFile;
 	Request *_workingRequest;
-	bool _ignoreCallback;
+	bool _ignoreCallback, _startingDownloads;
+	uint32 _nextDownloadId;
 	uint32 _totalFilesToHandle;
 	Common::String _date;
 
@@ -49,11 +73,12 @@ class SavesSyncRequest: public Networking::Request, public GUI::CommandSender {
 	void directoryListedErrorCallback(Networking::ErrorResponse error);
 	void directoryCreatedCallback(Storage::BoolResponse response);
 	void directoryCreatedErrorCallback(Networking::ErrorResponse error);
-	void fileDownloadedCallback(Storage::BoolResponse response);
-	void fileDownloadedErrorCallback(Networking::ErrorResponse error);
+	void fileDownloadedCallback(uint32 id, Storage::BoolResponse response);
+	void fileDownloadedErrorCallback(uint32 id, Networking::ErrorResponse error);
 	void fileUploadedCallback(Storage::UploadResponse response);
 	void fileUploadedErrorCallback(Networking::ErrorResponse error);
-	void downloadNextFile();
+	int findDownload(uint32 id) const;
+	void downloadNextFiles();
 	void uploadNextFile();
 	virtual void finishError(Networking::ErrorResponse error);
 	void finishSync(bool success);
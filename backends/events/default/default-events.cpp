@@ -26,6 +26,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
@@ -82,6 +83,8 @@ void DefaultEventManager::init() {
 }
 
 bool DefaultEventManager::pollEvent(Common::Event &event) {
+	PROFILE_SCOPE("events.poll");
+
 	_dispatcher.dispatch();
 
 	if (g_engine)
@@ -93,6 +96,29 @@ bool DefaultEventManager::pollEvent(Common::Event &event) {
 	}
 
 	event = _eventQueue.pop();
+	return handleEvent(event);
+}
+
+bool DefaultEventManager::pollEvents(Common::Array<Common::Event> &events) {
+	PROFILE_SCOPE("events.poll");
+
+	events.clear();
+	_dispatcher.dispatch();
+
+	if (g_engine)
+		// Handle autosaves if enabled
+		g_engine->handleAutoSave();
+
+	while (!_eventQueue.empty()) {
+		Common::Event event = _eventQueue.pop();
+		if (handleEvent(event))
+			events.push_back(event);
+	}
+
+	return !events.empty();
+}
+
+bool DefaultEventManager::handleEvent(Common::Event &event) {
 	bool forwardEvent = true;
 
 	// If the backend has the kFeatureNoQuit or the "Return to Launcher at Exit" option is enabled,
@@ -59,12 +59,16 @@ class DefaultEventManager : public Common::EventManager, Common::EventObserver {
 	bool _shouldReturnToLauncher;
 	bool _confirmExitDialogActive;
 
+	/** Update the state from an event, returns whether to forward it. */
+	bool handleEvent(Common::Event &event);
+
 public:
 	DefaultEventManager(Common::EventSource *boss);
 	~DefaultEventManager();
 
 	virtual void init() override;
 	virtual bool pollEvent(Common::Event &event) override;
+	virtual bool pollEvents(Common::Array<Common::Event> &events) override;
 	virtual void pushEvent(const Common::Event &event) override;
 	virtual void purgeMouseEvents() override;
 
@@ -79,6 +79,9 @@ SdlEventSource::SdlEventSource()
       , _queuedFakeKeyUp(false), _fakeKeyUp(), _controller(nullptr)
 #endif
       {
+	ConfMan.registerDefault("coalesce_mouse_motion", true);
+	_coalesceMouseMotion = ConfMan.getBool("coalesce_mouse_motion");
+
 	int joystick_num = ConfMan.getInt("joystick_num");
 	if (joystick_num >= 0) {
 		// Initialize SDL joystick subsystem
@@ -435,6 +438,10 @@ bool SdlEventSource::pollEvent(Common::Event &event) {
 		return true;
 	}
 
+	if (dynamic_cast<SdlGraphicsManager *>(_graphicsManager)) {
+		dynamic_cast<SdlGraphicsManager *>(_graphicsManager)->presentPendingFrame();
+	}
+
 	SDL_Event ev;
 	while (SDL_PollEvent(&ev)) {
 		preprocessEvents(&ev);
@@ -686,7 +693,31 @@ bool SdlEventSource::handleKeyUp(SDL_Event &ev, Common::Event &event) {
 bool SdlEventSource::handleMouseMotion(SDL_Event &ev, Common::Event &event) {
 	event.type = Common::EVENT_MOUSEMOVE;
 
-	return processMouseEvent(event, ev.motion.x, ev.motion.y, ev.motion.xrel, ev.motion.yrel);
+	int relX = ev.motion.xrel;
+	int relY = ev.motion.yrel;
+
+	// Fast mice report many motions between two polls. Merge the ones which
+	// directly follow, keeping the last position and the whole relative
+	// motion, so the engines don't have to go through each of them.
+	if (_coalesceMouseMotion) {
+		SDL_Event next;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		while (SDL_PeepEvents(&next, 1, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0 && next.type == SDL_MOUSEMOTION &&
+		       next.motion.which == ev.motion.which && next.motion.windowID == ev.motion.windowID) {
+			SDL_PeepEvents(&next, 1, SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+#else
+		while (SDL_PeepEvents(&next, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) > 0 && next.type == SDL_MOUSEMOTION) {
+			SDL_PeepEvents(&next, 1, SDL_GETEVENT, SDL_MOUSEMOTIONMASK);
+#endif
+			preprocessEvents(&next);
+			ev.motion.x = next.motion.x;
+			ev.motion.y = next.motion.y;
+			relX += next.motion.xrel;
+			relY += next.motion.yrel;
+		}
+	}
+
+	return processMouseEvent(event, ev.motion.x, ev.motion.y, relX, relY);
 }
 
 bool SdlEventSource::handleMouseButtonDown(SDL_Event &ev, Common::Event &event) {
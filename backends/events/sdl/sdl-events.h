@@ -68,6 +68,9 @@ protected:
 
 	bool _engineRunning;
 
+	/** Whether consecutive mouse motions are sent as one event */
+	bool _coalesceMouseMotion;
+
 	int _mouseX;
 	int _mouseY;
 
@@ -183,6 +183,26 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a memory-mapped SeekableReadStream instance corresponding
+	 * to the file referred by this node. Backends which do not support
+	 * mapping files simply return 0, in which case the caller falls back
+	 * to createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure.
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return nullptr; }
+
+	/**
+	 * Retrieves the size and the last modification time of the file
+	 * referred by this node, without opening it. The time is only meant
+	 * to be compared with other values returned by this method.
+	 *
+	 * @return true if both are known, false if the file does not exist or
+	 *         the backend cannot query them.
+	 */
+	virtual bool getFileInfo(int64 &size, int64 &modificationTime) const { return false; }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -192,6 +212,17 @@ public:
 	 */
 	virtual Common::WriteStream *createWriteStream() = 0;
 
+	/**
+	 * Creates a WriteStream which only replaces the file referred by this
+	 * node once it is finalized, so that the file is never left partially
+	 * written.
+	 *
+	 * The default implementation writes to the file directly.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::WriteStream *createAtomicWriteStream() { return createWriteStream(); }
+
 	/**
 	* Creates a directory referred by this node.
 	*
@@ -35,6 +35,7 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
+#include "common/memstream.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -50,6 +51,11 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#if defined(POSIX) && !defined(PLAYSTATION3) && !defined(PSP2) && !defined(__DS__)
+#define POSIX_FS_HAS_MMAP
+#include <sys/mman.h>
+#endif
+
 #ifdef __OS2__
 #define INCL_DOS
 #include <os2.h>
@@ -290,10 +296,68 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
+#ifdef POSIX_FS_HAS_MMAP
+namespace {
+
+class PosixMapping : public Common::MappedReadStream::Mapping {
+public:
+	PosixMapping(void *addr, size_t size) : _addr(addr), _size(size) {}
+	~PosixMapping() override { munmap(_addr, _size); }
+
+private:
+	void *_addr;
+	size_t _size;
+};
+
+} // End of anonymous namespace
+#endif
+
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+#ifdef POSIX_FS_HAS_MMAP
+	int fd = open(_path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	void *addr = MAP_FAILED;
+	// Empty files cannot be mapped, and streams are limited to 32-bit sizes
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64)st.st_size <= 0x7FFFFFFF)
+		addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after closing the descriptor
+	close(fd);
+
+	if (addr == MAP_FAILED)
+		return nullptr;
+
+	Common::MappedReadStream::MappingPtr mapping(new PosixMapping(addr, st.st_size));
+	return new Common::MappedReadStream(mapping, (const byte *)addr, st.st_size);
+#else
+	return nullptr;
+#endif
+}
+
+bool POSIXFilesystemNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
 
+#if !defined(ANDROID_PLAIN_PORT)
+// Files created through SAF on Android cannot be renamed this way
+Common::WriteStream *POSIXFilesystemNode::createAtomicWriteStream() {
+	return StdioAtomicWriteStream::makeFromPath(getPath());
+}
+#endif
+
 bool POSIXFilesystemNode::createDirectory() {
 	if (mkdir(_path.c_str(), 0755) == 0)
 		setFlags();
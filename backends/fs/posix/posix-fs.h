@@ -67,7 +67,12 @@ public:
 	virtual AbstractFSNode *getParent() const;
 
 	virtual Common::SeekableReadStream *createReadStream();
+	virtual Common::SeekableReadStream *createMappedReadStream();
+	virtual bool getFileInfo(int64 &size, int64 &modificationTime) const;
 	virtual Common::WriteStream *createWriteStream();
+#if !defined(ANDROID_PLAIN_PORT)
+	virtual Common::WriteStream *createAtomicWriteStream();
+#endif
 	virtual bool createDirectory();
 
 protected:
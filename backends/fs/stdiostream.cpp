@@ -27,12 +27,18 @@
 
 #include "backends/fs/stdiostream.h"
 
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
 StdioStream::StdioStream(void *handle) : _handle(handle) {
 	assert(handle);
 }
 
 StdioStream::~StdioStream() {
-	fclose((FILE *)_handle);
+	if (_handle)
+		fclose((FILE *)_handle);
 }
 
 bool StdioStream::err() const {
@@ -92,4 +98,51 @@ StdioStream *StdioStream::makeFromPath(const Common::String &path, bool writeMod
 	return 0;
 }
 
+StdioAtomicWriteStream::StdioAtomicWriteStream(void *handle, const Common::String &path, const Common::String &tempPath)
+	: StdioStream(handle), _path(path), _tempPath(tempPath), _finalized(false), _error(false) {
+}
+
+StdioAtomicWriteStream::~StdioAtomicWriteStream() {
+	if (!_finalized) {
+		fclose((FILE *)_handle);
+		_handle = nullptr;
+		remove(_tempPath.c_str());
+	}
+}
+
+bool StdioAtomicWriteStream::err() const {
+	return _error || (_handle && StdioStream::err());
+}
+
+void StdioAtomicWriteStream::finalize() {
+	if (_finalized)
+		return;
+	_finalized = true;
+
+	// The file must be closed before it can be renamed on Windows
+	_error = StdioStream::err() || !flush();
+	_error |= fclose((FILE *)_handle) != 0;
+	_handle = nullptr;
+
+	if (!_error) {
+#if defined(WIN32)
+		_error = !MoveFileExA(_tempPath.c_str(), _path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+		_error = rename(_tempPath.c_str(), _path.c_str()) != 0;
+#endif
+	}
+
+	if (_error)
+		remove(_tempPath.c_str());
+}
+
+StdioAtomicWriteStream *StdioAtomicWriteStream::makeFromPath(const Common::String &path) {
+	const Common::String tempPath = path + ".new";
+	FILE *handle = fopen(tempPath.c_str(), "wb");
+
+	if (handle)
+		return new StdioAtomicWriteStream(handle, path, tempPath);
+	return 0;
+}
+
 #endif
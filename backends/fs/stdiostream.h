@@ -67,4 +67,30 @@ public:
 	bool setBufferSize(uint32 bufferSize);
 };
 
+/**
+ * A write stream to a temporary file next to the target file, which replaces
+ * the target once the stream is finalized without errors. Other readers of
+ * the target only ever see either its old or its new contents.
+ *
+ * If the stream is deleted without being finalized, the target is left
+ * untouched.
+ */
+class StdioAtomicWriteStream : public StdioStream {
+public:
+	static StdioAtomicWriteStream *makeFromPath(const Common::String &path);
+
+	~StdioAtomicWriteStream() override;
+
+	bool err() const override;
+	void finalize() override;
+
+private:
+	StdioAtomicWriteStream(void *handle, const Common::String &path, const Common::String &tempPath);
+
+	Common::String _path;
+	Common::String _tempPath;
+	bool _finalized;
+	bool _error;
+};
+
 #endif
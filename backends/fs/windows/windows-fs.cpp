@@ -27,6 +27,7 @@
 
 #include "backends/fs/windows/windows-fs.h"
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
 
 // F_OK, R_OK and W_OK are not defined under MSVC, so we define them here
 // For more information on the modes used by MSVC, check:
@@ -234,10 +235,71 @@ Common::SeekableReadStream *WindowsFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+namespace {
+
+class WindowsMapping : public Common::MappedReadStream::Mapping {
+public:
+	WindowsMapping(HANDLE mappingHandle, LPVOID view) : _mappingHandle(mappingHandle), _view(view) {}
+	~WindowsMapping() override {
+		UnmapViewOfFile(_view);
+		CloseHandle(_mappingHandle);
+	}
+
+private:
+	HANDLE _mappingHandle;
+	LPVOID _view;
+};
+
+} // End of anonymous namespace
+
+Common::SeekableReadStream *WindowsFilesystemNode::createMappedReadStream() {
+	HANDLE fileHandle = CreateFile(toUnicode(_path.c_str()), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	// Empty files cannot be mapped, and streams are limited to 32-bit sizes
+	DWORD sizeHigh = 0;
+	DWORD sizeLow = GetFileSize(fileHandle, &sizeHigh);
+	if (sizeLow == INVALID_FILE_SIZE || sizeHigh != 0 || sizeLow == 0 || sizeLow > 0x7FFFFFFF) {
+		CloseHandle(fileHandle);
+		return nullptr;
+	}
+
+	// The mapping object keeps the file open on its own
+	HANDLE mappingHandle = CreateFileMapping(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(fileHandle);
+	if (mappingHandle == NULL)
+		return nullptr;
+
+	LPVOID view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL) {
+		CloseHandle(mappingHandle);
+		return nullptr;
+	}
+
+	Common::MappedReadStream::MappingPtr mapping(new WindowsMapping(mappingHandle, view));
+	return new Common::MappedReadStream(mapping, (const byte *)view, sizeLow);
+}
+
+bool WindowsFilesystemNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data) ||
+	    (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		return false;
+
+	size = ((int64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	modificationTime = ((int64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
 Common::WriteStream *WindowsFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
 
+Common::WriteStream *WindowsFilesystemNode::createAtomicWriteStream() {
+	return StdioAtomicWriteStream::makeFromPath(getPath());
+}
+
 bool WindowsFilesystemNode::createDirectory() {
 	if (CreateDirectory(toUnicode(_path.c_str()), NULL) != 0)
 		setFlags();
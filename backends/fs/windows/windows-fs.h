@@ -79,7 +79,10 @@ public:
 	virtual AbstractFSNode *getParent() const override;
 
 	virtual Common::SeekableReadStream *createReadStream() override;
+	virtual Common::SeekableReadStream *createMappedReadStream() override;
+	virtual bool getFileInfo(int64 &size, int64 &modificationTime) const override;
 	virtual Common::WriteStream *createWriteStream() override;
+	virtual Common::WriteStream *createAtomicWriteStream() override;
 	virtual bool createDirectory() override;
 
 private:
@@ -24,10 +24,26 @@
 #define BACKENDS_GRAPHICS_NULL_H
 
 #include "backends/graphics/graphics.h"
+#include "graphics/surface.h"
 
+/**
+ * Graphics manager which keeps the screen and the overlay in memory, without
+ * ever presenting them.
+ *
+ * The frames can still be grabbed, for screenshots or the checksums of the
+ * events recorder, and the presented frames are counted.
+ */
 class NullGraphicsManager : public GraphicsManager {
 public:
-	virtual ~NullGraphicsManager() {}
+	NullGraphicsManager() : _width(0), _height(0), _format(Graphics::PixelFormat::createFormatCLUT8()),
+		_overlayVisible(false), _screenChangeID(0), _frameCount(0) {
+		memset(_palette, 0, sizeof(_palette));
+	}
+
+	virtual ~NullGraphicsManager() {
+		_screen.free();
+		_overlay.free();
+	}
 
 	bool hasFeature(OSystem::Feature f) const override { return false; }
 	void setFeatureState(OSystem::Feature f, bool enable) override {}
@@ -52,22 +68,42 @@ public:
 		_width = width;
 		_height = height;
 		_format = format ? *format : Graphics::PixelFormat::createFormatCLUT8();
+
+		if (_screen.w != (int16)width || _screen.h != (int16)height || _screen.format != _format) {
+			_screen.free();
+			_screen.create(width, height, _format);
+			_overlay.free();
+			_overlay.create(width, height, getOverlayFormat());
+			_screenChangeID++;
+		}
 	}
 
-	virtual int getScreenChangeID() const override { return 0; }
+	virtual int getScreenChangeID() const override { return _screenChangeID; }
 
 	void beginGFXTransaction() override {}
 	OSystem::TransactionError endGFXTransaction() override { return OSystem::kTransactionSuccess; }
 
 	int16 getHeight() const override { return _height; }
 	int16 getWidth() const override { return _width; }
-	void setPalette(const byte *colors, uint start, uint num) override {}
-	void grabPalette(byte *colors, uint start, uint num) const override {}
-	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {}
-	Graphics::Surface *lockScreen() override { return NULL; }
+	void setPalette(const byte *colors, uint start, uint num) override {
+		assert(start + num <= 256);
+		memcpy(_palette + start * 3, colors, num * 3);
+	}
+	void grabPalette(byte *colors, uint start, uint num) const override {
+		assert(start + num <= 256);
+		memcpy(colors, _palette + start * 3, num * 3);
+	}
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {
+		if (_screen.getPixels())
+			_screen.copyRectToSurface(buf, pitch, x, y, w, h);
+	}
+	Graphics::Surface *lockScreen() override { return _screen.getPixels() ? &_screen : NULL; }
 	void unlockScreen() override {}
-	void fillScreen(uint32 col) override {}
-	void updateScreen() override {}
+	void fillScreen(uint32 col) override {
+		if (_screen.getPixels())
+			_screen.fillRect(Common::Rect(_screen.w, _screen.h), col);
+	}
+	void updateScreen() override { _frameCount++; }
 	void setShakePos(int shakeXOffset, int shakeYOffset) override {}
 	void setFocusRectangle(const Common::Rect& rect) override {}
 	void clearFocusRectangle() override {}
@@ -76,9 +112,20 @@ public:
 	void hideOverlay() override { _overlayVisible = false; }
 	bool isOverlayVisible() const override { return _overlayVisible; }
 	Graphics::PixelFormat getOverlayFormat() const override { return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0); }
-	void clearOverlay() override {}
-	void grabOverlay(void *buf, int pitch) const override {}
-	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override {}
+	void clearOverlay() override {
+		if (_overlay.getPixels())
+			_overlay.fillRect(Common::Rect(_overlay.w, _overlay.h), 0);
+	}
+	void grabOverlay(void *buf, int pitch) const override {
+		const byte *src = (const byte *)_overlay.getPixels();
+		byte *dst = (byte *)buf;
+		for (int y = 0; y < _overlay.h; ++y, src += _overlay.pitch, dst += pitch)
+			memcpy(dst, src, _overlay.w * _overlay.format.bytesPerPixel);
+	}
+	void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) override {
+		if (_overlay.getPixels())
+			_overlay.copyRectToSurface(buf, pitch, x, y, w, h);
+	}
 	int16 getOverlayHeight() const override { return _height; }
 	int16 getOverlayWidth() const override { return _width; }
 
@@ -87,10 +134,18 @@ public:
 	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale = false, const Graphics::PixelFormat *format = NULL) override {}
 	void setCursorPalette(const byte *colors, uint start, uint num) override {}
 
+	/** Return the number of frames presented with updateScreen() */
+	uint32 getFrameCount() const { return _frameCount; }
+
 private:
 	uint _width, _height;
 	Graphics::PixelFormat _format;
 	bool _overlayVisible;
+	Graphics::Surface _screen;
+	Graphics::Surface _overlay;
+	byte _palette[256 * 3];
+	int _screenChangeID;
+	uint32 _frameCount;
 };
 
 #endif
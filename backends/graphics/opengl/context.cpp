@@ -28,6 +28,7 @@
 
 #include "common/tokenizer.h"
 #include "common/debug.h"
+#include "common/util.h"
 
 namespace OpenGL {
 
@@ -38,6 +39,8 @@ void Context::reset() {
 	shadersSupported = false;
 	multitextureSupported = false;
 	framebufferObjectSupported = false;
+	unpackSubImageSupported = false;
+	pixelBufferObjectSupported = false;
 
 #define GL_FUNC_DEF(ret, name, param) name = nullptr;
 #include "backends/graphics/opengl/opengl-func.h"
@@ -62,6 +65,33 @@ Pipeline *Context::setPipeline(Pipeline *pipeline) {
 
 Context g_context;
 
+namespace {
+
+/**
+ * Parse the version of the context from GL_VERSION, which is of the form
+ * "<major>.<minor> ..." for GL and "OpenGL ES <major>.<minor> ..." for GLES.
+ */
+void parseVersion(const char *version, int &major, int &minor) {
+	major = minor = 0;
+	if (!version) {
+		return;
+	}
+
+	while (*version && !Common::isDigit(*version)) {
+		++version;
+	}
+	while (Common::isDigit(*version)) {
+		major = major * 10 + (*version++ - '0');
+	}
+	if (*version++ == '.') {
+		while (Common::isDigit(*version)) {
+			minor = minor * 10 + (*version++ - '0');
+		}
+	}
+}
+
+} // End of anonymous namespace
+
 void OpenGLGraphicsManager::setContextType(ContextType type) {
 #if USE_FORCED_GL
 	type = kContextGL;
@@ -119,6 +149,8 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	bool ARBShadingLanguage100 = false;
 	bool ARBVertexShader = false;
 	bool ARBFragmentShader = false;
+	bool ARBPixelBufferObject = false;
+	bool EXTUnpackSubImage = false;
 
 	Common::StringTokenizer tokenizer(extString, " ");
 	while (!tokenizer.empty()) {
@@ -138,9 +170,17 @@ void OpenGLGraphicsManager::initializeGLContext() {
 			g_context.multitextureSupported = true;
 		} else if (token == "GL_EXT_framebuffer_object") {
 			g_context.framebufferObjectSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object") {
+			ARBPixelBufferObject = true;
+		} else if (token == "GL_EXT_unpack_subimage") {
+			EXTUnpackSubImage = true;
 		}
 	}
 
+	int major, minor;
+	parseVersion((const char *)g_context.glGetString(GL_VERSION), major, minor);
+	debug(5, "OpenGL version: %d.%d", major, minor);
+
 	if (g_context.type == kContextGLES2) {
 		// GLES2 always has (limited) NPOT support.
 		g_context.NPOTSupported = true;
@@ -153,8 +193,16 @@ void OpenGLGraphicsManager::initializeGLContext() {
 
 		// GLES2 always has FBO support.
 		g_context.framebufferObjectSupported = true;
+
+		// GLES3 has both of these, GLES2 only the former with an extension.
+		g_context.unpackSubImageSupported = EXTUnpackSubImage || major >= 3;
+		g_context.pixelBufferObjectSupported = major >= 3;
 	} else {
 		g_context.shadersSupported = ARBShaderObjects & ARBShadingLanguage100 & ARBVertexShader & ARBFragmentShader;
+
+		// GLES lacks GL_UNPACK_ROW_LENGTH, which GL always had.
+		g_context.unpackSubImageSupported = g_context.type == kContextGL;
+		g_context.pixelBufferObjectSupported = g_context.type == kContextGL && (ARBPixelBufferObject || major > 2 || (major == 2 && minor >= 1));
 	}
 
 	// Log context type.
@@ -181,6 +229,8 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	debug(5, "OpenGL: Shader support: %d", g_context.shadersSupported);
 	debug(5, "OpenGL: Multitexture support: %d", g_context.multitextureSupported);
 	debug(5, "OpenGL: FBO support: %d", g_context.framebufferObjectSupported);
+	debug(5, "OpenGL: Unpack sub image support: %d", g_context.unpackSubImageSupported);
+	debug(5, "OpenGL: PBO support: %d", g_context.pixelBufferObjectSupported);
 }
 
 } // End of namespace OpenGL
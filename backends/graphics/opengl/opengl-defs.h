@@ -76,6 +76,8 @@ typedef float  GLclampf; /* single precision float in [0,1] */
 typedef double GLdouble; /* double precision float */
 typedef double GLclampd; /* double precision float in [0,1] */
 typedef char   GLchar;
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
 #if defined(MACOSX)
 typedef void  *GLhandleARB;
 #else
@@ -187,6 +189,7 @@ typedef GLhandleARB GLshader;
 #define GL_R8                             0x8229
 
 /* PixelStoreParameter */
+#define GL_UNPACK_ROW_LENGTH              0x0CF2
 #define GL_UNPACK_ALIGNMENT               0x0CF5
 #define GL_PACK_ALIGNMENT                 0x0D05
 
@@ -250,6 +253,7 @@ typedef GLhandleARB GLshader;
 /* Textures */
 #define GL_TEXTURE0                       0x84C0
 #define GL_TEXTURE1                       0x84C1
+#define GL_TEXTURE2                       0x84C2
 
 /* GetPName */
 #define GL_VIEWPORT                       0x0BA2
@@ -259,4 +263,8 @@ typedef GLhandleARB GLshader;
 #define GL_COLOR_ATTACHMENT0              0x8CE0
 #define GL_FRAMEBUFFER                    0x8D40
 
+/* Buffer objects */
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_PIXEL_UNPACK_BUFFER            0x88EC
+
 #endif
@@ -26,13 +26,15 @@
 #include "backends/graphics/opengl/pipelines/pipeline.h"
 #include "backends/graphics/opengl/pipelines/fixed.h"
 #include "backends/graphics/opengl/pipelines/shader.h"
+#include "backends/graphics/opengl/scaler.h"
 #include "backends/graphics/opengl/shader.h"
 
 #include "common/array.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/algorithm.h"
-#include "common/file.h"
+#include "common/config-manager.h"
+#include "common/fs.h"
 #include "gui/debugger.h"
 #include "engines/engine.h"
 #ifdef USE_OSD
@@ -46,12 +48,6 @@
 #include "graphics/font.h"
 #endif
 
-#ifdef USE_PNG
-#include "image/png.h"
-#else
-#include "image/bmp.h"
-#endif
-
 #ifdef USE_TTS
 #include "common/text-to-speech.h"
 #endif
@@ -63,6 +59,10 @@ OpenGLGraphicsManager::OpenGLGraphicsManager()
       _pipeline(nullptr), _stretchMode(STRETCH_FIT),
       _defaultFormat(), _defaultFormatAlpha(),
       _gameScreen(nullptr), _overlay(nullptr),
+#if !USE_FORCED_GLES
+      _yuvFrame(nullptr), _yuvFrameVisible(false), _yuvFrameX(0), _yuvFrameY(0),
+      _currentShader(GFX_SHADER_NONE), _shaderScaler(nullptr),
+#endif
       _cursor(nullptr),
       _cursorHotspotX(0), _cursorHotspotY(0),
       _cursorHotspotXScaled(0), _cursorHotspotYScaled(0), _cursorWidthScaled(0), _cursorHeightScaled(0),
@@ -85,6 +85,8 @@ OpenGLGraphicsManager::~OpenGLGraphicsManager() {
 	delete _osdIconSurface;
 #endif
 #if !USE_FORCED_GLES
+	delete _yuvFrame;
+	delete _shaderScaler;
 	ShaderManager::destroy();
 #endif
 }
@@ -100,6 +102,14 @@ bool OpenGLGraphicsManager::hasFeature(OSystem::Feature f) const {
 	case OSystem::kFeatureOverlaySupportsAlpha:
 		return _defaultFormatAlpha.aBits() > 3;
 
+#if !USE_FORCED_GLES
+	case OSystem::kFeatureYUVFrames:
+		return TextureYUVGPU::isSupportedByContext();
+
+	case OSystem::kFeatureShader:
+		return true;
+#endif
+
 	default:
 		return false;
 	}
@@ -117,6 +127,10 @@ void OpenGLGraphicsManager::setFeatureState(OSystem::Feature f, bool enable) {
 		_currentState.filtering = enable;
 
 		if (_gameScreen) {
+#if !USE_FORCED_GLES
+			// The shader scaler decides how it samples the game screen.
+			if (!_shaderScaler)
+#endif
 			_gameScreen->enableLinearFiltering(enable);
 		}
 
@@ -124,6 +138,12 @@ void OpenGLGraphicsManager::setFeatureState(OSystem::Feature f, bool enable) {
 			_cursor->enableLinearFiltering(enable);
 		}
 
+#if !USE_FORCED_GLES
+		if (_yuvFrame) {
+			_yuvFrame->enableLinearFiltering(enable);
+		}
+#endif
+
 		// The overlay UI should also obey the filtering choice (managed via the Filter Graphics checkbox in Graphics Tab).
 		// Thus, when overlay filtering is disabled, scaling in OPENGL is done with GL_NEAREST (nearest neighbor scaling).
 		// It may look crude, but it should be crispier and it's left to user choice to enable filtering.
@@ -288,6 +308,105 @@ int OpenGLGraphicsManager::getStretchMode() const {
 	return _stretchMode;
 }
 
+namespace {
+const OSystem::GraphicsMode glShaders[] = {
+	{"NONE", _s("Normal (no shader)"), GFX_SHADER_NONE},
+#if !USE_FORCED_GLES
+	{"advmame2x", "AdvMAME2x", GFX_SHADER_ADVMAME2X},
+	{"advmame3x", "AdvMAME3x", GFX_SHADER_ADVMAME3X},
+	{"tv2x", "TV2x", GFX_SHADER_TV2X},
+	{"preset", _s("Shader preset"), GFX_SHADER_PRESET},
+#endif
+	{nullptr, nullptr, 0}
+};
+
+} // End of anonymous namespace
+
+const OSystem::GraphicsMode *OpenGLGraphicsManager::getSupportedShaders() const {
+	return glShaders;
+}
+
+int OpenGLGraphicsManager::getDefaultShader() const {
+	return GFX_SHADER_NONE;
+}
+
+bool OpenGLGraphicsManager::setShader(int id) {
+#if !USE_FORCED_GLES
+	if (id == _currentShader)
+		return true;
+
+	const OSystem::GraphicsMode *sm = getSupportedShaders();
+	while (sm->name && sm->id != id)
+		sm++;
+	if (!sm->name) {
+		warning("unknown shader %d", id);
+		return false;
+	}
+
+	// The scaler is created on the next screen update, once there is a
+	// context to compile its shaders in.
+	_currentShader = id;
+	delete _shaderScaler;
+	_shaderScaler = nullptr;
+	if (_gameScreen) {
+		_gameScreen->enableLinearFiltering(_currentState.filtering);
+	}
+	_forceRedraw = true;
+	return true;
+#else
+	return id == GFX_SHADER_NONE;
+#endif
+}
+
+int OpenGLGraphicsManager::getShader() const {
+#if !USE_FORCED_GLES
+	return _currentShader;
+#else
+	return GFX_SHADER_NONE;
+#endif
+}
+
+#if !USE_FORCED_GLES
+void OpenGLGraphicsManager::updateShaderScaler() {
+	if (!g_context.shadersSupported) {
+		warning("OpenGL: Shader scalers need shader support");
+		_currentShader = GFX_SHADER_NONE;
+		return;
+	}
+
+	switch (_currentShader) {
+	case GFX_SHADER_ADVMAME2X:
+		_shaderScaler = ShaderScaler::createBuiltIn(ShaderScaler::kBuiltInAdvMame2x);
+		break;
+
+	case GFX_SHADER_ADVMAME3X:
+		_shaderScaler = ShaderScaler::createBuiltIn(ShaderScaler::kBuiltInAdvMame3x);
+		break;
+
+	case GFX_SHADER_TV2X:
+		_shaderScaler = ShaderScaler::createBuiltIn(ShaderScaler::kBuiltInTV2x);
+		break;
+
+	case GFX_SHADER_PRESET:
+		if (ConfMan.hasKey("shader_preset")) {
+			_shaderScaler = ShaderScaler::loadPreset(Common::FSNode(ConfMan.get("shader_preset")));
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (!_shaderScaler) {
+		warning("OpenGL: Could not create shader scaler %d, disabling it", _currentShader);
+		_currentShader = GFX_SHADER_NONE;
+		return;
+	}
+
+	_gameScreen->enableLinearFiltering(_shaderScaler->isInputLinearFiltered());
+}
+#endif
+
 void OpenGLGraphicsManager::beginGFXTransaction() {
 	assert(_transactionMode == kTransactionNone);
 
@@ -392,6 +511,11 @@ OSystem::TransactionError OpenGLGraphicsManager::endGFXTransaction() {
 		delete _gameScreen;
 		_gameScreen = nullptr;
 
+#if !USE_FORCED_GLES
+		// The frame position no longer fits the game screen.
+		_yuvFrameVisible = false;
+#endif
+
 #ifdef USE_RGB_COLOR
 		_gameScreen = createSurface(_currentState.gameFormat);
 #else
@@ -403,6 +527,11 @@ OSystem::TransactionError OpenGLGraphicsManager::endGFXTransaction() {
 		}
 
 		_gameScreen->allocate(_currentState.gameWidth, _currentState.gameHeight);
+#if !USE_FORCED_GLES
+		if (_shaderScaler)
+			_gameScreen->enableLinearFiltering(_shaderScaler->isInputLinearFiltered());
+		else
+#endif
 		_gameScreen->enableLinearFiltering(_currentState.filtering);
 		// We fill the screen to all black or index 0 for CLUT8.
 #ifdef USE_RGB_COLOR
@@ -466,6 +595,32 @@ void OpenGLGraphicsManager::fillScreen(uint32 col) {
 	_gameScreen->fill(col);
 }
 
+void OpenGLGraphicsManager::showYUVFrame(const Graphics::YUVFrame *frame, int x, int y) {
+#if !USE_FORCED_GLES
+	if (!frame) {
+		if (_yuvFrameVisible) {
+			_yuvFrameVisible = false;
+			_forceRedraw = true;
+		}
+		return;
+	}
+
+	if (!TextureYUVGPU::isSupportedByContext()) {
+		return;
+	}
+
+	if (!_yuvFrame) {
+		_yuvFrame = new TextureYUVGPU();
+		_yuvFrame->enableLinearFiltering(_currentState.filtering);
+	}
+
+	_yuvFrame->setFrame(*frame);
+	_yuvFrameX = x;
+	_yuvFrameY = y;
+	_yuvFrameVisible = true;
+#endif
+}
+
 void OpenGLGraphicsManager::updateScreen() {
 	if (!_gameScreen) {
 		return;
@@ -492,6 +647,9 @@ void OpenGLGraphicsManager::updateScreen() {
 	    && !_gameScreen->isDirty()
 	    && !(_overlayVisible && _overlay->isDirty())
 	    && !(_cursorVisible && _cursor && _cursor->isDirty())
+#if !USE_FORCED_GLES
+	    && !(_yuvFrameVisible && _yuvFrame->isDirty())
+#endif
 #ifdef USE_OSD
 	    && !_osdMessageSurface && !_osdIconSurface
 #endif
@@ -499,12 +657,23 @@ void OpenGLGraphicsManager::updateScreen() {
 		return;
 	}
 
+#if !USE_FORCED_GLES
+	if (_currentShader != GFX_SHADER_NONE && !_shaderScaler) {
+		updateShaderScaler();
+	}
+#endif
+
 	// Update changes to textures.
 	_gameScreen->updateGLTexture();
 	if (_cursorVisible && _cursor) {
 		_cursor->updateGLTexture();
 	}
 	_overlay->updateGLTexture();
+#if !USE_FORCED_GLES
+	if (_yuvFrameVisible) {
+		_yuvFrame->updateGLTexture();
+	}
+#endif
 
 	// Clear the screen buffer.
 	GL_CALL(glClear(GL_COLOR_BUFFER_BIT));
@@ -520,8 +689,26 @@ void OpenGLGraphicsManager::updateScreen() {
 	_backBuffer.enableBlend(Framebuffer::kBlendModeDisabled);
 
 	// First step: Draw the (virtual) game screen.
+#if !USE_FORCED_GLES
+	if (_shaderScaler)
+		_shaderScaler->drawTexture(_gameScreen->getGLTexture(), &_backBuffer, _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
+	else
+#endif
 	g_context.getActivePipeline()->drawTexture(_gameScreen->getGLTexture(), _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
 
+#if !USE_FORCED_GLES
+	// Draw the YUV frame on top of the game screen, scaled the same way.
+	if (_yuvFrameVisible) {
+		const int gameWidth = _gameScreen->getWidth();
+		const int gameHeight = _gameScreen->getHeight();
+		const int dstX = _gameDrawRect.left + _yuvFrameX * _gameDrawRect.width() / gameWidth;
+		const int dstY = _gameDrawRect.top + _yuvFrameY * _gameDrawRect.height() / gameHeight;
+		const int dstW = _yuvFrame->getWidth() * _gameDrawRect.width() / gameWidth;
+		const int dstH = _yuvFrame->getHeight() * _gameDrawRect.height() / gameHeight;
+		g_context.getActivePipeline()->drawTexture(_yuvFrame->getGLTexture(), dstX, dstY, dstW, dstH);
+	}
+#endif
+
 	// Second step: Draw the overlay if visible.
 	if (_overlayVisible) {
 		int dstX = (_windowWidth - _overlayDrawRect.width()) / 2;
@@ -1050,6 +1237,12 @@ void OpenGLGraphicsManager::notifyContextCreate(const Graphics::PixelFormat &def
 		_cursor->recreate();
 	}
 
+#if !USE_FORCED_GLES
+	if (_yuvFrame) {
+		_yuvFrame->recreate();
+	}
+#endif
+
 #ifdef USE_OSD
 	if (_osdMessageSurface) {
 		_osdMessageSurface->recreate();
@@ -1074,6 +1267,12 @@ void OpenGLGraphicsManager::notifyContextDestroy() {
 		_cursor->destroy();
 	}
 
+#if !USE_FORCED_GLES
+	if (_yuvFrame) {
+		_yuvFrame->destroy();
+	}
+#endif
+
 #ifdef USE_OSD
 	if (_osdMessageSurface) {
 		_osdMessageSurface->destroy();
@@ -1085,6 +1284,10 @@ void OpenGLGraphicsManager::notifyContextDestroy() {
 #endif
 
 #if !USE_FORCED_GLES
+	// The scaler is created again on the next screen update.
+	delete _shaderScaler;
+	_shaderScaler = nullptr;
+
 	if (g_context.shadersSupported) {
 		ShaderMan.notifyDestroy();
 	}
@@ -1315,42 +1518,24 @@ const Graphics::Font *OpenGLGraphicsManager::getFontOSD() const {
 }
 #endif
 
-bool OpenGLGraphicsManager::saveScreenshot(const Common::String &filename) const {
+void OpenGLGraphicsManager::finishRendering() {
+	GL_CALL(glFinish());
+}
+
+void OpenGLGraphicsManager::grabScreen(Graphics::Surface &surface) const {
 	const uint width  = _windowWidth;
 	const uint height = _windowHeight;
 
-	// A line of a BMP image must have a size divisible by 4.
-	// We calculate the padding bytes needed here.
-	// Since we use a 4 byte per pixel mode, we can use 0 here, since it is
-	// equal to (4 - (width * 4)) % 4. (4 - (width * Bpp)) % 4, is the usual
-	// way of computing the padding bytes required).
-	// GL_PACK_ALIGNMENT is 4, so this line padding is required for PNG too
-	const uint linePaddingSize = 0;
-	const uint lineSize        = width * 4 + linePaddingSize;
-
-	Common::DumpFile out;
-	if (!out.open(filename)) {
-		return false;
-	}
-
-	Common::Array<uint8> pixels;
-	pixels.resize(lineSize * height);
-	GL_CALL(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &pixels.front()));
-
+	// GL_PACK_ALIGNMENT is 4, and we use a 4 byte per pixel mode, so the
+	// lines of the read back pixels need no padding.
 #ifdef SCUMM_LITTLE_ENDIAN
 	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 0, 8, 16, 24);
 #else
 	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
 #endif
-	Graphics::Surface data;
-	data.init(width, height, lineSize, &pixels.front(), format);
-	data.flipVertical(Common::Rect(width, height));
-
-#ifdef USE_PNG
-	return Image::writePNG(out, data);
-#else
-	return Image::writeBMP(out, data);
-#endif
+	surface.create(width, height, format);
+	GL_CALL(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, surface.getPixels()));
+	surface.flipVertical(Common::Rect(width, height));
 }
 
 } // End of namespace OpenGL
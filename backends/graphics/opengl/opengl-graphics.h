@@ -48,12 +48,22 @@ class Surface;
 class Pipeline;
 #if !USE_FORCED_GLES
 class Shader;
+class ShaderScaler;
+class TextureYUVGPU;
 #endif
 
 enum {
 	GFX_OPENGL = 0
 };
 
+enum {
+	GFX_SHADER_NONE = 0,
+	GFX_SHADER_ADVMAME2X = 1,
+	GFX_SHADER_ADVMAME3X = 2,
+	GFX_SHADER_TV2X = 3,
+	GFX_SHADER_PRESET = 4
+};
+
 class OpenGLGraphicsManager : virtual public WindowedGraphicsManager {
 public:
 	OpenGLGraphicsManager();
@@ -79,6 +89,11 @@ public:
 	virtual bool setStretchMode(int mode) override;
 	virtual int getStretchMode() const override;
 
+	virtual const OSystem::GraphicsMode *getSupportedShaders() const override;
+	virtual int getDefaultShader() const override;
+	virtual bool setShader(int id) override;
+	virtual int getShader() const override;
+
 	virtual void beginGFXTransaction() override;
 	virtual OSystem::TransactionError endGFXTransaction() override;
 
@@ -92,6 +107,8 @@ public:
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
 	virtual void fillScreen(uint32 col) override;
 
+	virtual void showYUVFrame(const Graphics::YUVFrame *frame, int x, int y) override;
+
 	virtual void updateScreen() override;
 
 	virtual Graphics::Surface *lockScreen() override;
@@ -258,12 +275,17 @@ protected:
 	virtual void refreshScreen() = 0;
 
 	/**
-	 * Saves a screenshot of the entire window, excluding window decorations.
+	 * Copies the entire window, excluding window decorations, into a surface.
 	 *
-	 * @param filename The output filename.
-	 * @return true on success, false otherwise
+	 * @param surface The surface to create and fill. It is freed by the caller.
 	 */
-	bool saveScreenshot(const Common::String &filename) const;
+	void grabScreen(Graphics::Surface &surface) const;
+
+	/**
+	 * Wait until the GPU has executed all the commands, which includes the
+	 * buffer swap of the last frame with most drivers.
+	 */
+	void finishRendering();
 
 private:
 	//
@@ -330,6 +352,40 @@ protected:
 	 */
 	byte _gamePalette[3 * 256];
 
+#if !USE_FORCED_GLES
+	/**
+	 * The planar YUV frame shown on top of the game screen.
+	 */
+	TextureYUVGPU *_yuvFrame;
+
+	/**
+	 * Whether the YUV frame is shown.
+	 */
+	bool _yuvFrameVisible;
+
+	/**
+	 * The current shader scaler, as GFX_SHADER_*.
+	 */
+	int _currentShader;
+
+	/**
+	 * The scaler the game screen is drawn through, created on demand for
+	 * the current shader.
+	 */
+	ShaderScaler *_shaderScaler;
+
+	/**
+	 * Create the scaler for the current shader, falling back to no shader
+	 * when it cannot be created.
+	 */
+	void updateShaderScaler();
+
+	/**
+	 * The position of the YUV frame on the game screen.
+	 */
+	int _yuvFrameX, _yuvFrameY;
+#endif
+
 	//
 	// Overlay
 	//
@@ -118,6 +118,12 @@ struct Context {
 	/** Whether FBO support is available or not. */
 	bool framebufferObjectSupported;
 
+	/** Whether GL_UNPACK_ROW_LENGTH can be used for texture uploads or not. */
+	bool unpackSubImageSupported;
+
+	/** Whether pixel buffer objects can be used for texture uploads or not. */
+	bool pixelBufferObjectSupported;
+
 #define GL_FUNC_DEF(ret, name, param) ret (GL_CALL_CONV *name)param
 #include "backends/graphics/opengl/opengl-func.h"
 #undef GL_FUNC_DEF
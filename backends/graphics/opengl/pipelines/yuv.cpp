@@ -0,0 +1,69 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/opengl/pipelines/yuv.h"
+#include "backends/graphics/opengl/shader.h"
+#include "backends/graphics/opengl/framebuffer.h"
+
+namespace OpenGL {
+
+#if !USE_FORCED_GLES
+YUVToRGBPipeline::YUVToRGBPipeline()
+    : ShaderPipeline(ShaderMan.query(ShaderManager::kYUVToRGB)), _uTexture(nullptr), _vTexture(nullptr),
+      _chromaShift(1), _ituScale(true) {
+}
+
+void YUVToRGBPipeline::setChromaTextures(const GLTexture *uTexture, const GLTexture *vTexture, int chromaShift) {
+	_uTexture = uTexture;
+	_vTexture = vTexture;
+	_chromaShift = chromaShift;
+}
+
+void YUVToRGBPipeline::drawTexture(const GLTexture &texture, const GLfloat *coordinates) {
+	// Set the chroma textures.
+	GL_CALL(glActiveTexture(GL_TEXTURE1));
+	if (_uTexture) {
+		_uTexture->bind();
+	}
+
+	GL_CALL(glActiveTexture(GL_TEXTURE2));
+	if (_vTexture) {
+		_vTexture->bind();
+	}
+
+	// The texture sizes might be rounded up to powers of two, so the chroma
+	// coordinates are not simply the luma coordinates.
+	if (_uTexture) {
+		_activeShader->setUniform("chromaScaleX", new ShaderUniformFloat((GLfloat)texture.getWidth() / (_uTexture->getWidth() << _chromaShift)));
+		_activeShader->setUniform("chromaScaleY", new ShaderUniformFloat((GLfloat)texture.getHeight() / (_uTexture->getHeight() << _chromaShift)));
+	}
+
+	// Stretching [16, 235] to [0, 255] also takes care of clamping.
+	_activeShader->setUniform("lumaOffset", new ShaderUniformFloat(_ituScale ? 16.0f / 255.0f : 0.0f));
+	_activeShader->setUniform("lumaScale", new ShaderUniformFloat(_ituScale ? 255.0f / 219.0f : 1.0f));
+
+	GL_CALL(glActiveTexture(GL_TEXTURE0));
+	ShaderPipeline::drawTexture(texture, coordinates);
+}
+#endif // !USE_FORCED_GLES
+
+} // End of namespace OpenGL
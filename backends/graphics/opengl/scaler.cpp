@@ -0,0 +1,361 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/opengl/scaler.h"
+
+#if !USE_FORCED_GLES
+
+#include "backends/graphics/opengl/framebuffer.h"
+#include "backends/graphics/opengl/shader.h"
+#include "backends/graphics/opengl/texture.h"
+#include "backends/graphics/opengl/pipelines/shader.h"
+
+#include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+#include "common/tokenizer.h"
+
+namespace OpenGL {
+
+namespace {
+
+#pragma mark - Scaler Shader Sources -
+
+const char *const g_scalerVertexShader =
+	"attribute vec4 position;\n"
+	"attribute vec2 texCoordIn;\n"
+	"attribute vec4 blendColorIn;\n"
+	"\n"
+	"uniform mat4 projection;\n"
+	"\n"
+	"varying vec2 texCoord;\n"
+	"varying vec4 blendColor;\n"
+	"\n"
+	"void main(void) {\n"
+	"\ttexCoord    = texCoordIn;\n"
+	"\tblendColor  = blendColorIn;\n"
+	"\tgl_Position = projection * position;\n"
+	"}\n";
+
+// The neighbours of the source pixel of each fragment, named as in
+// graphics/scaler/scalebit.cpp:
+//  A B C
+//  D E F
+//  G H I
+const char *const g_scalerNeighbours =
+	"varying vec2 texCoord;\n"
+	"varying vec4 blendColor;\n"
+	"\n"
+	"uniform sampler2D shaderTexture;\n"
+	"uniform vec2 textureSize;\n"
+	"\n"
+	"vec4 A, B, C, D, E, F, G, H, I;\n"
+	"\n"
+	"// Returns the position of the fragment inside of its source pixel\n"
+	"vec2 fetchNeighbours(void) {\n"
+	"\tvec2 texel = 1.0 / textureSize;\n"
+	"\tvec2 center = (floor(texCoord * textureSize) + 0.5) * texel;\n"
+	"\tA = texture2D(shaderTexture, center + vec2(-texel.x, -texel.y));\n"
+	"\tB = texture2D(shaderTexture, center + vec2(0.0, -texel.y));\n"
+	"\tC = texture2D(shaderTexture, center + vec2(texel.x, -texel.y));\n"
+	"\tD = texture2D(shaderTexture, center + vec2(-texel.x, 0.0));\n"
+	"\tE = texture2D(shaderTexture, center);\n"
+	"\tF = texture2D(shaderTexture, center + vec2(texel.x, 0.0));\n"
+	"\tG = texture2D(shaderTexture, center + vec2(-texel.x, texel.y));\n"
+	"\tH = texture2D(shaderTexture, center + vec2(0.0, texel.y));\n"
+	"\tI = texture2D(shaderTexture, center + vec2(texel.x, texel.y));\n"
+	"\treturn fract(texCoord * textureSize);\n"
+	"}\n"
+	"\n";
+
+// Scale2x, as AdvMame2x
+const char *const g_advMame2xFragmentShader =
+	"void main(void) {\n"
+	"\tvec2 pos = fetchNeighbours();\n"
+	"\tvec4 result = E;\n"
+	"\tif (B != H && D != F) {\n"
+	"\t\tif (pos.y < 0.5) {\n"
+	"\t\t\tif (pos.x < 0.5) {\n"
+	"\t\t\t\tif (D == B) result = D;\n"
+	"\t\t\t} else {\n"
+	"\t\t\t\tif (B == F) result = F;\n"
+	"\t\t\t}\n"
+	"\t\t} else {\n"
+	"\t\t\tif (pos.x < 0.5) {\n"
+	"\t\t\t\tif (D == H) result = D;\n"
+	"\t\t\t} else {\n"
+	"\t\t\t\tif (H == F) result = F;\n"
+	"\t\t\t}\n"
+	"\t\t}\n"
+	"\t}\n"
+	"\tgl_FragColor = blendColor * result;\n"
+	"}\n";
+
+// Scale3x, as AdvMame3x
+const char *const g_advMame3xFragmentShader =
+	"void main(void) {\n"
+	"\tvec2 cell = floor(fetchNeighbours() * 3.0);\n"
+	"\tvec4 result = E;\n"
+	"\tif (B != H && D != F) {\n"
+	"\t\tif (cell.y == 0.0) {\n"
+	"\t\t\tif (cell.x == 0.0) {\n"
+	"\t\t\t\tif (D == B) result = D;\n"
+	"\t\t\t} else if (cell.x == 1.0) {\n"
+	"\t\t\t\tif ((D == B && E != C) || (B == F && E != A)) result = B;\n"
+	"\t\t\t} else {\n"
+	"\t\t\t\tif (B == F) result = F;\n"
+	"\t\t\t}\n"
+	"\t\t} else if (cell.y == 1.0) {\n"
+	"\t\t\tif (cell.x == 0.0) {\n"
+	"\t\t\t\tif ((D == B && E != G) || (D == H && E != A)) result = D;\n"
+	"\t\t\t} else if (cell.x == 2.0) {\n"
+	"\t\t\t\tif ((B == F && E != I) || (H == F && E != C)) result = F;\n"
+	"\t\t\t}\n"
+	"\t\t} else {\n"
+	"\t\t\tif (cell.x == 0.0) {\n"
+	"\t\t\t\tif (D == H) result = D;\n"
+	"\t\t\t} else if (cell.x == 1.0) {\n"
+	"\t\t\t\tif ((D == H && E != I) || (H == F && E != G)) result = H;\n"
+	"\t\t\t} else {\n"
+	"\t\t\t\tif (H == F) result = F;\n"
+	"\t\t\t}\n"
+	"\t\t}\n"
+	"\t}\n"
+	"\tgl_FragColor = blendColor * result;\n"
+	"}\n";
+
+// Every second line darkened to 7/8, as TV2x
+const char *const g_tv2xFragmentShader =
+	"void main(void) {\n"
+	"\tvec2 pos = fetchNeighbours();\n"
+	"\tvec4 result = E;\n"
+	"\tif (pos.y >= 0.5)\n"
+	"\t\tresult.rgb *= 7.0 / 8.0;\n"
+	"\tgl_FragColor = blendColor * result;\n"
+	"}\n";
+
+Common::String g_emptyString;
+
+const Common::String &getPresetValue(const Common::StringMap &values, const Common::String &key) {
+	Common::StringMap::const_iterator i = values.find(key);
+	return i != values.end() ? i->_value : g_emptyString;
+}
+
+Common::SeekableReadStream *openRelative(const Common::FSNode &base, const Common::String &path) {
+	Common::FSNode node = base.getParent();
+	Common::StringTokenizer tokenizer(path, "/\\");
+	while (!tokenizer.empty())
+		node = node.getChild(tokenizer.nextToken());
+	return node.createReadStream();
+}
+
+} // End of anonymous namespace
+
+#pragma mark - Shader Scaler -
+
+ShaderScaler::ShaderScaler() : _passes() {
+}
+
+ShaderScaler::~ShaderScaler() {
+	for (uint i = 0; i < _passes.size(); ++i) {
+		delete _passes[i].pipeline;
+		delete _passes[i].shader;
+		delete _passes[i].target;
+	}
+}
+
+ShaderScaler *ShaderScaler::createBuiltIn(BuiltIn builtIn) {
+	const char *fragment = nullptr;
+	switch (builtIn) {
+	case kBuiltInAdvMame2x:
+		fragment = g_advMame2xFragmentShader;
+		break;
+	case kBuiltInAdvMame3x:
+		fragment = g_advMame3xFragmentShader;
+		break;
+	case kBuiltInTV2x:
+		fragment = g_tv2xFragmentShader;
+		break;
+	default:
+		return nullptr;
+	}
+
+	// A single pass, which works at any output size
+	ShaderScaler *scaler = new ShaderScaler();
+	if (!scaler->addPass(g_scalerVertexShader, Common::String(g_scalerNeighbours) + fragment, 1.0f, false)) {
+		delete scaler;
+		return nullptr;
+	}
+	return scaler;
+}
+
+ShaderScaler *ShaderScaler::loadPreset(const Common::FSNode &file) {
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream) {
+		warning("OpenGL: Could not open shader preset '%s'", file.getPath().c_str());
+		return nullptr;
+	}
+
+	Common::StringMap values;
+	while (!stream->eos() && !stream->err()) {
+		Common::String line = stream->readLine();
+		line.trim();
+		if (line.empty() || line.firstChar() == '#')
+			continue;
+
+		const size_t separator = line.findFirstOf('=');
+		if (separator == Common::String::npos)
+			continue;
+
+		Common::String key(line.c_str(), separator);
+		Common::String value(line.c_str() + separator + 1);
+		key.trim();
+		value.trim();
+		if (value.size() >= 2 && value.firstChar() == '"' && value.lastChar() == '"')
+			value = Common::String(value.c_str() + 1, value.size() - 2);
+		values[key] = value;
+	}
+	delete stream;
+
+	const int numPasses = atoi(getPresetValue(values, "shaders").c_str());
+	if (numPasses <= 0) {
+		warning("OpenGL: Shader preset '%s' has no passes", file.getPath().c_str());
+		return nullptr;
+	}
+
+	if (numPasses > 1 && !g_context.framebufferObjectSupported) {
+		warning("OpenGL: Multi-pass shader presets need framebuffer objects");
+		return nullptr;
+	}
+
+	ShaderScaler *scaler = new ShaderScaler();
+	for (int i = 0; i < numPasses; ++i) {
+		const Common::String &shaderPath = getPresetValue(values, Common::String::format("shader%d", i));
+		Common::SeekableReadStream *shaderStream = shaderPath.empty() ? nullptr : openRelative(file, shaderPath);
+		if (!shaderStream) {
+			warning("OpenGL: Could not open shader %d of preset '%s'", i, file.getPath().c_str());
+			delete scaler;
+			return nullptr;
+		}
+
+		const uint32 size = shaderStream->size();
+		char *buffer = new char[size + 1];
+		buffer[shaderStream->read(buffer, size)] = 0;
+		const Common::String source(buffer);
+		delete[] buffer;
+		delete shaderStream;
+
+		const Common::String &scaleValue = getPresetValue(values, Common::String::format("scale%d", i));
+		const GLfloat scale = scaleValue.empty() ? 1.0f : atof(scaleValue.c_str());
+		const Common::String &filterValue = getPresetValue(values, Common::String::format("filter_linear%d", i));
+		const bool linearFiltering = filterValue.equalsIgnoreCase("true") || filterValue == "1";
+
+		if (!scaler->addPass("#define VERTEX\n" + source, "#define FRAGMENT\n" + source, scale, linearFiltering)) {
+			warning("OpenGL: Could not build shader %d of preset '%s'", i, file.getPath().c_str());
+			delete scaler;
+			return nullptr;
+		}
+	}
+
+	return scaler;
+}
+
+bool ShaderScaler::addPass(const Common::String &vertex, const Common::String &fragment, GLfloat scale, bool linearFiltering) {
+	Shader *shader = new Shader(vertex, fragment);
+	if (!shader->isValid()
+	    || shader->getAttributeLocation("position") == -1
+	    || shader->getAttributeLocation("texCoordIn") == -1
+	    || shader->getAttributeLocation("blendColorIn") == -1) {
+		delete shader;
+		return false;
+	}
+	shader->setUniform1I("shaderTexture", 0);
+
+	// The target of the former last pass is now the input of this one
+	if (!_passes.empty()) {
+		Pass &last = _passes.back();
+		last.target = new TextureTarget();
+		last.target->create();
+		last.target->enableBlend(Framebuffer::kBlendModeDisabled);
+		last.target->getTexture()->enableLinearFiltering(linearFiltering);
+	}
+
+	Pass pass;
+	pass.shader = shader;
+	pass.pipeline = new ShaderPipeline(shader);
+	pass.pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+	pass.target = nullptr;
+	pass.scale = scale > 0.0f ? scale : 1.0f;
+	pass.linearFiltering = linearFiltering;
+	_passes.push_back(pass);
+	return true;
+}
+
+bool ShaderScaler::isInputLinearFiltered() const {
+	return !_passes.empty() && _passes.front().linearFiltering;
+}
+
+void ShaderScaler::drawTexture(const GLTexture &texture, Framebuffer *target, GLfloat x, GLfloat y, GLfloat w, GLfloat h) {
+	Pipeline *oldPipeline = g_context.getActivePipeline();
+
+	const GLTexture *input = &texture;
+	GLfloat inputWidth = texture.getLogicalWidth();
+	GLfloat inputHeight = texture.getLogicalHeight();
+
+	for (uint i = 0; i < _passes.size(); ++i) {
+		Pass &pass = _passes[i];
+
+		GLfloat outputWidth = w, outputHeight = h;
+		if (pass.target) {
+			outputWidth = (GLfloat)(uint)(inputWidth * pass.scale + 0.5f);
+			outputHeight = (GLfloat)(uint)(inputHeight * pass.scale + 0.5f);
+			pass.target->setSize((uint)outputWidth, (uint)outputHeight);
+			pass.pipeline->setFramebuffer(pass.target);
+		} else {
+			pass.pipeline->setFramebuffer(target);
+		}
+
+		pass.shader->setUniform("textureSize", new ShaderUniformVector2(input->getWidth(), input->getHeight()));
+		pass.shader->setUniform("inputSize", new ShaderUniformVector2(inputWidth, inputHeight));
+		pass.shader->setUniform("outputSize", new ShaderUniformVector2(outputWidth, outputHeight));
+
+		g_context.setPipeline(pass.pipeline);
+		if (pass.target) {
+			g_context.getActivePipeline()->drawTexture(*input, 0, 0, outputWidth, outputHeight);
+		} else {
+			g_context.getActivePipeline()->drawTexture(*input, x, y, w, h);
+		}
+
+		if (pass.target) {
+			input = pass.target->getTexture();
+			inputWidth = outputWidth;
+			inputHeight = outputHeight;
+		}
+	}
+
+	g_context.setPipeline(oldPipeline);
+}
+
+} // End of namespace OpenGL
+
+#endif // !USE_FORCED_GLES
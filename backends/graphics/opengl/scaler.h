@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef BACKENDS_GRAPHICS_OPENGL_SCALER_H
+#define BACKENDS_GRAPHICS_OPENGL_SCALER_H
+
+#include "backends/graphics/opengl/opengl-sys.h"
+
+#if !USE_FORCED_GLES
+
+#include "common/array.h"
+#include "common/str.h"
+
+namespace Common {
+class FSNode;
+}
+
+namespace OpenGL {
+
+class Framebuffer;
+class GLTexture;
+class Shader;
+class ShaderPipeline;
+class TextureTarget;
+
+/**
+ * Draws a texture through a chain of shader passes, as a GPU replacement
+ * for the software scalers.
+ *
+ * Every pass but the last renders into a texture target, sized relative to
+ * its input, which is the input of the next pass. The last pass renders
+ * directly into the requested area of the target framebuffer.
+ *
+ * The shaders of the passes use the same attributes and uniforms as the
+ * built-in shaders, plus these uniforms:
+ *  - textureSize: the size of the input texture in texels,
+ *  - inputSize:   the size of the used area of the input texture,
+ *  - outputSize:  the size of the area the pass renders to.
+ */
+class ShaderScaler {
+public:
+	enum BuiltIn {
+		kBuiltInAdvMame2x,
+		kBuiltInAdvMame3x,
+		kBuiltInTV2x
+	};
+
+	ShaderScaler();
+	~ShaderScaler();
+
+	/**
+	 * Create a scaler for one of the ports of the software scalers.
+	 *
+	 * @return The scaler, or nullptr if its shaders could not be compiled.
+	 */
+	static ShaderScaler *createBuiltIn(BuiltIn builtIn);
+
+	/**
+	 * Create a scaler from a shader preset file. Presets consist of
+	 * "key = value" lines, in the style of the .glslp presets:
+	 *  - shaders:        the number of passes,
+	 *  - shaderN:        the shader file of pass N, relative to the preset,
+	 *  - scaleN:         the scale of the output of pass N to its input,
+	 *  - filter_linearN: whether pass N samples its input with linear filtering.
+	 *
+	 * Shader files contain both shaders; the vertex shader is compiled with
+	 * VERTEX defined, and the fragment shader with FRAGMENT defined. They
+	 * must not have a #version directive, since one is prepended as for the
+	 * built-in shaders.
+	 *
+	 * @return The scaler, or nullptr if the preset could not be loaded.
+	 */
+	static ShaderScaler *loadPreset(const Common::FSNode &file);
+
+	/**
+	 * Add a pass at the end of the chain.
+	 *
+	 * @return false if the shaders of the pass could not be compiled.
+	 */
+	bool addPass(const Common::String &vertex, const Common::String &fragment, GLfloat scale, bool linearFiltering);
+
+	/**
+	 * Whether the first pass wants its input to be linearly filtered.
+	 */
+	bool isInputLinearFiltered() const;
+
+	/**
+	 * Draw a texture through all the passes into a framebuffer.
+	 *
+	 * The active pipeline is restored afterwards.
+	 *
+	 * @param texture     Texture to scale.
+	 * @param target      Framebuffer the last pass renders to.
+	 * @param x, y, w, h  Area of the framebuffer to render to.
+	 */
+	void drawTexture(const GLTexture &texture, Framebuffer *target, GLfloat x, GLfloat y, GLfloat w, GLfloat h);
+
+private:
+	struct Pass {
+		Shader *shader;
+		ShaderPipeline *pipeline;
+		TextureTarget *target;
+		GLfloat scale;
+		bool linearFiltering;
+	};
+
+	Common::Array<Pass> _passes;
+};
+
+} // End of namespace OpenGL
+
+#endif // !USE_FORCED_GLES
+
+#endif
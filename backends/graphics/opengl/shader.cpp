@@ -77,6 +77,28 @@ const char *const g_lookUpFragmentShader =
 	"\tgl_FragColor = blendColor * texture2D(palette, vec2(index.a * adjustFactor, 0.0));\n"
 	"}\n";
 
+// Same coefficients as the YUVToRGBManager tables in graphics/yuv_to_rgb.cpp
+const char *const g_yuvToRGBFragmentShader =
+	"varying vec2 texCoord;\n"
+	"varying vec4 blendColor;\n"
+	"\n"
+	"uniform sampler2D shaderTexture;\n"
+	"uniform sampler2D uTexture;\n"
+	"uniform sampler2D vTexture;\n"
+	"uniform float chromaScaleX;\n"
+	"uniform float chromaScaleY;\n"
+	"uniform float lumaOffset;\n"
+	"uniform float lumaScale;\n"
+	"\n"
+	"void main(void) {\n"
+	"\tvec2 chromaCoord = texCoord * vec2(chromaScaleX, chromaScaleY);\n"
+	"\tfloat y = texture2D(shaderTexture, texCoord).a;\n"
+	"\tfloat u = texture2D(uTexture, chromaCoord).a - 128.0 / 255.0;\n"
+	"\tfloat v = texture2D(vTexture, chromaCoord).a - 128.0 / 255.0;\n"
+	"\tvec3 rgb = vec3(y + 1.4013 * v, y - 0.7136 * v - 0.3444 * u, y + 1.7734 * u);\n"
+	"\tgl_FragColor = blendColor * vec4(clamp((rgb - lumaOffset) * lumaScale, 0.0, 1.0), 1.0);\n"
+	"}\n";
+
 
 // Taken from: https://en.wikibooks.org/wiki/OpenGL_Programming/Modern_OpenGL_Tutorial_03#OpenGL_ES_2_portability
 const char *const g_precisionDefines =
@@ -104,6 +126,10 @@ void ShaderUniformFloat::set(GLint location) const {
 	GL_CALL(glUniform1f(location, _value));
 }
 
+void ShaderUniformVector2::set(GLint location) const {
+	GL_CALL(glUniform2f(location, _x, _y));
+}
+
 void ShaderUniformMatrix44::set(GLint location) const {
 	GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, _matrix));
 }
@@ -312,6 +338,9 @@ void ShaderManager::notifyCreate() {
 		_builtIn[kDefault] = new Shader(g_defaultVertexShader, g_defaultFragmentShader);
 		_builtIn[kCLUT8LookUp] = new Shader(g_defaultVertexShader, g_lookUpFragmentShader);
 		_builtIn[kCLUT8LookUp]->setUniform1I("palette", 1);
+		_builtIn[kYUVToRGB] = new Shader(g_defaultVertexShader, g_yuvToRGBFragmentShader);
+		_builtIn[kYUVToRGB]->setUniform1I("uTexture", 1);
+		_builtIn[kYUVToRGB]->setUniform1I("vTexture", 2);
 
 		for (uint i = 0; i < kMaxUsages; ++i) {
 			_builtIn[i]->setUniform1I("shaderTexture", 0);
@@ -74,6 +74,19 @@ private:
 	const GLfloat _value;
 };
 
+/**
+ * Two component float vector value for a shader uniform.
+ */
+class ShaderUniformVector2 : public ShaderUniformValue {
+public:
+	ShaderUniformVector2(GLfloat x, GLfloat y) : _x(x), _y(y) {}
+
+	virtual void set(GLint location) const override;
+
+private:
+	const GLfloat _x, _y;
+};
+
 /**
  * 4x4 Matrix value for a shader uniform.
  */
@@ -110,6 +123,11 @@ public:
 	 */
 	bool recreate();
 
+	/**
+	 * Whether the shader program was compiled and linked successfully.
+	 */
+	bool isValid() const { return _program != 0; }
+
 	/**
 	 * Make shader active.
 	 */
@@ -249,6 +267,9 @@ public:
 		/** CLUT8 look up shader. */
 		kCLUT8LookUp,
 
+		/** Planar YUV to RGB conversion shader. */
+		kYUVToRGB,
+
 		/** Number of built-in shaders. Should not be used for query. */
 		kMaxUsages
 	};
@@ -24,6 +24,7 @@
 #include "backends/graphics/opengl/shader.h"
 #include "backends/graphics/opengl/pipelines/pipeline.h"
 #include "backends/graphics/opengl/pipelines/clut8.h"
+#include "backends/graphics/opengl/pipelines/yuv.h"
 #include "backends/graphics/opengl/framebuffer.h"
 
 #include "common/algorithm.h"
@@ -31,6 +32,8 @@
 #include "common/rect.h"
 #include "common/textconsole.h"
 
+#include "graphics/conversion.h"
+
 namespace OpenGL {
 
 GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
@@ -38,11 +41,20 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
       _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
       _texCoords(), _glFilter(GL_NEAREST),
       _glTexture(0) {
+#if !USE_FORCED_GLES
+	_glBuffers[0] = _glBuffers[1] = 0;
+	_currentBuffer = 0;
+#endif
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#if !USE_FORCED_GLES
+	if (_glBuffers[0]) {
+		GL_CALL_SAFE(glDeleteBuffers, (2, _glBuffers));
+	}
+#endif
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -61,6 +73,13 @@ void GLTexture::enableLinearFiltering(bool enable) {
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+#if !USE_FORCED_GLES
+	if (_glBuffers[0]) {
+		GL_CALL(glDeleteBuffers(2, _glBuffers));
+		_glBuffers[0] = _glBuffers[1] = 0;
+	}
+#endif
 }
 
 void GLTexture::create() {
@@ -84,6 +103,13 @@ void GLTexture::create() {
 		GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, _glIntFormat, _width, _height,
 		                     0, _glFormat, _glType, NULL));
 	}
+
+#if !USE_FORCED_GLES
+	if (g_context.pixelBufferObjectSupported) {
+		GL_CALL(glGenBuffers(2, _glBuffers));
+		_currentBuffer = 0;
+	}
+#endif
 }
 
 void GLTexture::bind() const {
@@ -132,16 +158,39 @@ void GLTexture::setSize(uint width, uint height) {
 }
 
 void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &src) {
+	Common::Array<Common::Rect> areas;
+	areas.push_back(area);
+	updateAreas(areas, src);
+}
+
+void GLTexture::updateAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src) {
 	// Set the texture on the active texture unit.
 	bind();
 
+#if !USE_FORCED_GLES
+	if (_glBuffers[0]) {
+		streamAreas(areas, src);
+		return;
+	}
+
+	// With GL_UNPACK_ROW_LENGTH set to the pitch, glTexSubImage2D can take
+	// just the dirty rect out of the texture buffer.
+	if (g_context.unpackSubImageSupported) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+		for (uint i = 0; i < areas.size(); ++i) {
+			const Common::Rect &area = areas[i];
+			GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+			                        _glFormat, _glType, src.getBasePtr(area.left, area.top)));
+		}
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+		return;
+	}
+#endif
+
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
+	// OpenGL ES 1.0 and 2.0 do not support GL_UNPACK_ROW_LENGTH, and thus
+	// there is no way to specify a pitch to glTexSubImage2D. Thus, we are
+	// left with the following options:
 	//
 	// 1) (As we do right now) Simply always update the whole texture lines of
 	//    rect changed. This is simplest to implement. In case performance is
@@ -153,16 +202,52 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	//
 	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
 	//    graphics manager did but it is much slower! Thus, we do not use it.
-	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
-	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	for (uint i = 0; i < areas.size(); ++i) {
+		const Common::Rect &area = areas[i];
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
+		                        _glFormat, _glType, src.getBasePtr(0, area.top)));
+	}
 }
 
+#if !USE_FORCED_GLES
+void GLTexture::streamAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src) {
+	// Each area is copied as the span from its top left to its bottom right
+	// pixel, which is contiguous in the texture buffer.
+	uint32 size = 0;
+	for (uint i = 0; i < areas.size(); ++i) {
+		const Common::Rect &area = areas[i];
+		size += (area.height() - 1) * src.pitch + area.width() * src.format.bytesPerPixel;
+	}
+
+	// Alternate between the buffers, and orphan the old storage, such that
+	// the driver never waits for the upload of the former frame.
+	_currentBuffer ^= 1;
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _glBuffers[_currentBuffer]));
+	GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+	GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+
+	uint32 offset = 0;
+	for (uint i = 0; i < areas.size(); ++i) {
+		const Common::Rect &area = areas[i];
+		const uint32 span = (area.height() - 1) * src.pitch + area.width() * src.format.bytesPerPixel;
+		GL_CALL(glBufferSubData(GL_PIXEL_UNPACK_BUFFER, offset, span, src.getBasePtr(area.left, area.top)));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                        _glFormat, _glType, (const void *)(uintptr)offset));
+		offset += span;
+	}
+
+	// The buffer must not be bound for the uploads from client memory.
+	GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+}
+#endif
+
 //
 // Surface
 //
 
 Surface::Surface()
-    : _allDirty(false), _dirtyArea() {
+    : _allDirty(false), _dirtyArea(), _dirtyRects() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -170,15 +255,7 @@ void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcP
 	assert(x + w <= dstSurf->w);
 	assert(y + h <= dstSurf->h);
 
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = Common::Rect(x, y, x + w, y + h);
-	} else {
-		_dirtyArea.extend(Common::Rect(x, y, x + w, y + h));
-	}
+	addDirtyArea(Common::Rect(x, y, x + w, y + h));
 
 	const byte *src = (const byte *)srcPtr;
 	byte *dst = (byte *)dstSurf->getBasePtr(x, y);
@@ -211,6 +288,56 @@ Common::Rect Surface::getDirtyArea() const {
 	}
 }
 
+Common::Array<Common::Rect> Surface::getDirtyRects() const {
+	if (_allDirty) {
+		Common::Array<Common::Rect> rects;
+		rects.push_back(Common::Rect(getWidth(), getHeight()));
+		return rects;
+	} else {
+		return _dirtyRects;
+	}
+}
+
+void Surface::addDirtyArea(const Common::Rect &area) {
+	if (area.isEmpty()) {
+		return;
+	}
+
+	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
+	// parameters is an empty rect. Thus, we check whether the current dirty
+	// area is valid. In case it is not we simply use the parameters as new
+	// dirty area. Otherwise, we simply call extend.
+	if (_dirtyArea.isEmpty()) {
+		_dirtyArea = area;
+	} else {
+		_dirtyArea.extend(area);
+	}
+
+	// Merge the area with the ones it overlaps, or with ones which cover
+	// about as much as the both of them, as when they are adjacent.
+	Common::Rect merged = area;
+	for (uint i = 0; i < _dirtyRects.size();) {
+		const Common::Rect &rect = _dirtyRects[i];
+		Common::Rect bounds = rect;
+		bounds.extend(merged);
+		if (rect.intersects(merged)
+		    || (uint32)bounds.width() * bounds.height() <= (uint32)rect.width() * rect.height() + (uint32)merged.width() * merged.height()) {
+			merged = bounds;
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyRects.size() < kMaxDirtyRects) {
+		_dirtyRects.push_back(merged);
+	} else {
+		_dirtyRects.clear();
+		_dirtyRects.push_back(_dirtyArea);
+	}
+}
+
 //
 // Surface implementations
 //
@@ -268,46 +395,50 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	Common::Array<Common::Rect> dirtyRects = getDirtyRects();
 
 	// In case we use linear filtering we might need to duplicate the last
 	// pixel row/column to avoid glitches with filtering.
 	if (_glTexture.isLinearFilteringEnabled()) {
-		if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
-			uint height = dirtyArea.height();
+		for (uint i = 0; i < dirtyRects.size(); ++i) {
+			Common::Rect &dirtyArea = dirtyRects[i];
 
-			const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
-			byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
+			if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
+				uint height = dirtyArea.height();
 
-			while (height-- > 0) {
-				memcpy(dst, src, _textureData.format.bytesPerPixel);
-				dst += _textureData.pitch;
-				src += _textureData.pitch;
-			}
+				const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
+				byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
 
-			// Extend the dirty area.
-			++dirtyArea.right;
-		}
+				while (height-- > 0) {
+					memcpy(dst, src, _textureData.format.bytesPerPixel);
+					dst += _textureData.pitch;
+					src += _textureData.pitch;
+				}
 
-		if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
-			const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
-			byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
-			memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
+				// Extend the dirty area.
+				++dirtyArea.right;
+			}
+
+			if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
+				const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
+				byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
+				memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
 
-			// Extend the dirty area.
-			++dirtyArea.bottom;
+				// Extend the dirty area.
+				++dirtyArea.bottom;
+			}
 		}
 	}
 
-	_glTexture.updateArea(dirtyArea, _textureData);
+	_glTexture.updateAreas(dirtyRects, _textureData);
 
 	// We should have handled everything, thus not dirty anymore.
 	clearDirty();
 }
 
 TextureCLUT8::TextureCLUT8(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format)
-    : Texture(glIntFormat, glFormat, glType, format), _clut8Data(), _palette(new byte[256 * format.bytesPerPixel]) {
-	memset(_palette, 0, sizeof(byte) * format.bytesPerPixel);
+    : Texture(glIntFormat, glFormat, glType, format), _clut8Data(), _palette(new uint32[256]) {
+	memset(_palette, 0, sizeof(uint32) * 256);
 }
 
 TextureCLUT8::~TextureCLUT8() {
@@ -337,60 +468,23 @@ void TextureCLUT8::setColorKey(uint colorKey) {
 	// to avoid color fringes due to filtering.
 	// Erasing the color data is not a problem as the palette is always fully re-initialized
 	// before setting the key color.
-	if (_format.bytesPerPixel == 2) {
-		uint16 *palette = (uint16 *)_palette + colorKey;
-		*palette = 0;
-	} else if (_format.bytesPerPixel == 4) {
-		uint32 *palette = (uint32 *)_palette + colorKey;
-		*palette = 0;
-	} else {
-		warning("TextureCLUT8::setColorKey: Unsupported pixel depth %d", _format.bytesPerPixel);
-	}
+	_palette[colorKey] = 0;
 
 	// A palette changes means we need to refresh the whole surface.
 	flagDirty();
 }
 
-namespace {
-template<typename ColorType>
-inline void convertPalette(ColorType *dst, const byte *src, uint colors, const Graphics::PixelFormat &format) {
-	while (colors-- > 0) {
-		*dst++ = format.RGBToColor(src[0], src[1], src[2]);
-		src += 3;
-	}
-}
-} // End of anonymous namespace
-
 void TextureCLUT8::setPalette(uint start, uint colors, const byte *palData) {
-	if (_format.bytesPerPixel == 2) {
-		convertPalette<uint16>((uint16 *)_palette + start, palData, colors, _format);
-	} else if (_format.bytesPerPixel == 4) {
-		convertPalette<uint32>((uint32 *)_palette + start, palData, colors, _format);
-	} else {
-		warning("TextureCLUT8::setPalette: Unsupported pixel depth: %d", _format.bytesPerPixel);
+	uint32 *dst = _palette + start;
+	while (colors-- > 0) {
+		*dst++ = _format.RGBToColor(palData[0], palData[1], palData[2]);
+		palData += 3;
 	}
 
 	// A palette changes means we need to refresh the whole surface.
 	flagDirty();
 }
 
-namespace {
-template<typename PixelType>
-inline void doPaletteLookUp(PixelType *dst, const byte *src, uint width, uint height, uint dstPitch, uint srcPitch, const PixelType *palette) {
-	uint srcAdd = srcPitch - width;
-	uint dstAdd = dstPitch - width * sizeof(PixelType);
-
-	while (height-- > 0) {
-		for (uint x = width; x > 0; --x) {
-			*dst++ = palette[*src++];
-		}
-
-		dst = (PixelType *)((byte *)dst + dstAdd);
-		src += srcAdd;
-	}
-}
-} // End of anonymous namespace
-
 void TextureCLUT8::updateGLTexture() {
 	if (!isDirty()) {
 		return;
@@ -399,20 +493,18 @@ void TextureCLUT8::updateGLTexture() {
 	// Do the palette look up
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
-
-	if (outSurf->format.bytesPerPixel == 2) {
-		doPaletteLookUp<uint16>((uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        dirtyArea.width(), dirtyArea.height(),
-		                        outSurf->pitch, _clut8Data.pitch, (const uint16 *)_palette);
-	} else if (outSurf->format.bytesPerPixel == 4) {
-		doPaletteLookUp<uint32>((uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        dirtyArea.width(), dirtyArea.height(),
-		                        outSurf->pitch, _clut8Data.pitch, (const uint32 *)_palette);
-	} else {
-		warning("TextureCLUT8::updateGLTexture: Unsupported pixel depth: %d", outSurf->format.bytesPerPixel);
+	const Common::Array<Common::Rect> dirtyRects = getDirtyRects();
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyRects[i];
+
+		if (!Graphics::crossBlitMap((byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
+		                            (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
+		                            outSurf->pitch, _clut8Data.pitch,
+		                            dirtyArea.width(), dirtyArea.height(),
+		                            outSurf->format.bytesPerPixel, _palette)) {
+			warning("TextureCLUT8::updateGLTexture: Unsupported pixel depth: %d", outSurf->format.bytesPerPixel);
+			break;
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -458,25 +550,28 @@ void TextureRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyRects = getDirtyRects();
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyRects[i];
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -508,23 +603,26 @@ void TextureRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyRects = getDirtyRects();
+	for (uint i = 0; i < dirtyRects.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyRects[i];
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+				*dst++ = SWAP_BYTES_32(color);
+			}
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -658,7 +756,7 @@ void TextureCLUT8GPU::updateGLTexture() {
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		_clut8Texture.updateAreas(getDirtyRects(), _clut8Data);
 		clearDirty();
 	}
 
@@ -693,6 +791,125 @@ void TextureCLUT8GPU::lookUpColors() {
 	// Restore old state.
 	g_context.setPipeline(oldPipeline);
 }
+
+TextureYUVGPU::TextureYUVGPU()
+    : _yTexture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
+      _uTexture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
+      _vTexture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
+      _target(new TextureTarget()), _yuvPipeline(new YUVToRGBPipeline()),
+      _yuvVertices(), _yData(), _uData(), _vData(), _chromaShift(-1),
+      _dirty(false) {
+	// Setup pipeline.
+	_yuvPipeline->setFramebuffer(_target);
+	_yuvPipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+TextureYUVGPU::~TextureYUVGPU() {
+	delete _yuvPipeline;
+	delete _target;
+	_yData.free();
+	_uData.free();
+	_vData.free();
+}
+
+void TextureYUVGPU::destroy() {
+	_yTexture.destroy();
+	_uTexture.destroy();
+	_vTexture.destroy();
+	_target->destroy();
+}
+
+void TextureYUVGPU::recreate() {
+	_yTexture.create();
+	_uTexture.create();
+	_vTexture.create();
+	_target->create();
+
+	// In case a frame exists assure it will be converted again next time.
+	if (_yData.getPixels()) {
+		_dirty = true;
+	}
+}
+
+void TextureYUVGPU::enableLinearFiltering(bool enable) {
+	_target->getTexture()->enableLinearFiltering(enable);
+}
+
+void TextureYUVGPU::allocate(uint width, uint height, int chromaShift) {
+	const uint uvWidth = (width + (1 << chromaShift) - 1) >> chromaShift;
+	const uint uvHeight = (height + (1 << chromaShift) - 1) >> chromaShift;
+
+	_yTexture.setSize(width, height);
+	_uTexture.setSize(uvWidth, uvHeight);
+	_vTexture.setSize(uvWidth, uvHeight);
+	_target->setSize(width, height);
+
+	// The planes are uploaded without padding, see GLTexture::updateArea.
+	_yData.create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+	_uData.create(uvWidth, uvHeight, Graphics::PixelFormat::createFormatCLUT8());
+	_vData.create(uvWidth, uvHeight, Graphics::PixelFormat::createFormatCLUT8());
+
+	// YUV410 is interpolated on the CPU too, YUV420 is not.
+	_uTexture.enableLinearFiltering(chromaShift > 1);
+	_vTexture.enableLinearFiltering(chromaShift > 1);
+
+	_chromaShift = chromaShift;
+	_yuvPipeline->setChromaTextures(&_uTexture, &_vTexture, chromaShift);
+
+	// Setup structures for internal rendering to _target.
+	_yuvVertices[0] = 0;
+	_yuvVertices[1] = 0;
+
+	_yuvVertices[2] = width;
+	_yuvVertices[3] = 0;
+
+	_yuvVertices[4] = 0;
+	_yuvVertices[5] = height;
+
+	_yuvVertices[6] = width;
+	_yuvVertices[7] = height;
+}
+
+void TextureYUVGPU::setFrame(const Graphics::YUVFrame &frame) {
+	if ((int)_yData.w != frame.w || (int)_yData.h != frame.h || _chromaShift != frame.chromaShift) {
+		allocate(frame.w, frame.h, frame.chromaShift);
+	}
+
+	_yData.copyRectToSurface(frame.yPlane, frame.yPitch, 0, 0, _yData.w, _yData.h);
+	_uData.copyRectToSurface(frame.uPlane, frame.uvPitch, 0, 0, _uData.w, _uData.h);
+	_vData.copyRectToSurface(frame.vPlane, frame.uvPitch, 0, 0, _vData.w, _vData.h);
+
+	_yuvPipeline->setITUScale(frame.scale == Graphics::YUVToRGBManager::kScaleITU);
+	_dirty = true;
+}
+
+const GLTexture &TextureYUVGPU::getGLTexture() const {
+	return *_target->getTexture();
+}
+
+void TextureYUVGPU::updateGLTexture() {
+	if (!_dirty) {
+		return;
+	}
+
+	_yTexture.updateArea(Common::Rect(_yData.w, _yData.h), _yData);
+	_uTexture.updateArea(Common::Rect(_uData.w, _uData.h), _uData);
+	_vTexture.updateArea(Common::Rect(_vData.w, _vData.h), _vData);
+	_dirty = false;
+
+	convertColors();
+}
+
+void TextureYUVGPU::convertColors() {
+	// Setup pipeline to do the conversion.
+	Pipeline *oldPipeline = g_context.setPipeline(_yuvPipeline);
+
+	// Do the conversion.
+	g_context.getActivePipeline()->drawTexture(_yTexture, _yuvVertices);
+
+	// Restore old state.
+	g_context.setPipeline(oldPipeline);
+}
 #endif // !USE_FORCED_GLES
 
 } // End of namespace OpenGL
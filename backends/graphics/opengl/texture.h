@@ -27,7 +27,9 @@
 
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace OpenGL {
@@ -99,6 +101,18 @@ public:
 	 */
 	void updateArea(const Common::Rect &area, const Graphics::Surface &src);
 
+	/**
+	 * Copy image data of several areas to the texture.
+	 *
+	 * When the context supports it, the data is streamed through pixel
+	 * buffer objects, such that the upload does not stall.
+	 *
+	 * @param areas    The areas to update.
+	 * @param src      Surface for the whole texture containing the pixel data
+	 *                 to upload.
+	 */
+	void updateAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src);
+
 	/**
 	 * Query the GL texture's width.
 	 */
@@ -143,6 +157,20 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+#if !USE_FORCED_GLES
+	/**
+	 * Upload the areas through the next of the pixel buffer objects.
+	 */
+	void streamAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src);
+
+	/**
+	 * The pixel buffer objects uploads alternate between, or 0 if they are
+	 * not supported.
+	 */
+	GLuint _glBuffers[2];
+	uint _currentBuffer;
+#endif
 };
 
 /**
@@ -239,12 +267,29 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); _dirtyRects.clear(); }
 
+	/**
+	 * @return The bounding box of all dirty areas.
+	 */
 	Common::Rect getDirtyArea() const;
+
+	/**
+	 * @return The dirty areas, which do not overlap each other.
+	 */
+	Common::Array<Common::Rect> getDirtyRects() const;
 private:
+	/**
+	 * The maximum number of dirty areas kept apart. Any more are merged
+	 * into their bounding box.
+	 */
+	static const uint kMaxDirtyRects = 8;
+
+	void addDirtyArea(const Common::Rect &area);
+
 	bool _allDirty;
 	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyRects;
 };
 
 /**
@@ -315,7 +360,8 @@ public:
 	virtual void updateGLTexture();
 private:
 	Graphics::Surface _clut8Data;
-	byte *_palette;
+	// The colors in the texture format, kept as 32 bit values for crossBlitMap
+	uint32 *_palette;
 };
 
 #if !USE_FORCED_GL
@@ -412,6 +458,81 @@ private:
 	byte _palette[4 * 256];
 	bool _paletteDirty;
 };
+
+class YUVToRGBPipeline;
+
+/**
+ * A planar YUV frame, uploaded as three textures and converted to RGB by a
+ * shader into a render target.
+ */
+class TextureYUVGPU {
+public:
+	TextureYUVGPU();
+	~TextureYUVGPU();
+
+	/**
+	 * Destroy OpenGL description of the frame.
+	 */
+	void destroy();
+
+	/**
+	 * Recreate OpenGL description of the frame.
+	 */
+	void recreate();
+
+	/**
+	 * Enable or disable linear filtering of the converted frame.
+	 *
+	 * @param enable true to enable and false to disable.
+	 */
+	void enableLinearFiltering(bool enable);
+
+	/**
+	 * Copy the planes of a frame, which are uploaded and converted by the next
+	 * updateGLTexture() call.
+	 */
+	void setFrame(const Graphics::YUVFrame &frame);
+
+	bool isDirty() const { return _dirty; }
+
+	uint getWidth() const { return _yData.w; }
+	uint getHeight() const { return _yData.h; }
+
+	/**
+	 * Update the converted frame to reflect the current planes.
+	 */
+	void updateGLTexture();
+
+	/**
+	 * Obtain the OpenGL texture holding the converted frame.
+	 */
+	const GLTexture &getGLTexture() const;
+
+	static bool isSupportedByContext() {
+		return g_context.shadersSupported
+		    && g_context.multitextureSupported
+		    && g_context.framebufferObjectSupported;
+	}
+private:
+	void allocate(uint width, uint height, int chromaShift);
+	void convertColors();
+
+	GLTexture _yTexture;
+	GLTexture _uTexture;
+	GLTexture _vTexture;
+
+	TextureTarget *_target;
+	YUVToRGBPipeline *_yuvPipeline;
+
+	GLfloat _yuvVertices[4*2];
+
+	Graphics::Surface _yData;
+	Graphics::Surface _uData;
+	Graphics::Surface _vData;
+
+	int _chromaShift;
+	bool _dirty;
+};
 #endif // !USE_FORCED_GLES
 
 } // End of namespace OpenGL
@@ -26,6 +26,8 @@
 #include "backends/platform/sdl/sdl.h"
 #include "graphics/scaler/aspect.h"
 
+#include "common/debug.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/config-manager.h"
 #ifdef USE_OSD
@@ -40,7 +42,8 @@ OpenGLSdlGraphicsManager::OpenGLSdlGraphicsManager(SdlEventSource *eventSource,
       _lastVideoModeLoad(0),
 #endif
       _graphicsScale(2), _ignoreLoadVideoMode(false), _gotResize(false), _wantsFullScreen(false), _ignoreResizeEvents(0),
-      _desiredFullscreenWidth(0), _desiredFullscreenHeight(0) {
+      _desiredFullscreenWidth(0), _desiredFullscreenHeight(0),
+      _framePacing(ConfMan.getBool("frame_pacing")), _pendingFrame(false), _refreshIntervalMicros(1000000 / 60), _lastPresentMicros(0) {
 	// Setup OpenGL attributes for SDL
 	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
@@ -195,6 +198,10 @@ OpenGLSdlGraphicsManager::OpenGLSdlGraphicsManager(SdlEventSource *eventSource,
 }
 
 OpenGLSdlGraphicsManager::~OpenGLSdlGraphicsManager() {
+	debug(1, "OpenGL: %u frames requested, %u presented, %u coalesced, %u missed vsyncs, swap time avg %u us, max %u us",
+	      _presentStats.requested, _presentStats.presented, _presentStats.coalesced, _presentStats.missedVsyncs,
+	      _presentStats.presented ? (uint)(_presentStats.swapMicros / _presentStats.presented) : 0, _presentStats.maxSwapMicros);
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	notifyContextDestroy();
 	SDL_GL_DeleteContext(_glContext);
@@ -275,9 +282,47 @@ void OpenGLSdlGraphicsManager::updateScreen() {
 		--_ignoreResizeEvents;
 	}
 
+	++_presentStats.requested;
+#ifdef USE_PROFILER
+	Common::Profiler::addCounter("opengl.framesRequested");
+#endif
+
+	// The held back update is merged into this one
+	if (_pendingFrame) {
+		++_presentStats.coalesced;
+#ifdef USE_PROFILER
+		Common::Profiler::addCounter("opengl.framesCoalesced");
+#endif
+	}
+
+	// The changes stay dirty, and are presented by presentPendingFrame once
+	// the display is ready, unless another update comes first.
+	if (isTooEarlyToPresent()) {
+		_pendingFrame = true;
+		return;
+	}
+
+	_pendingFrame = false;
 	OpenGLGraphicsManager::updateScreen();
 }
 
+void OpenGLSdlGraphicsManager::presentPendingFrame() {
+	if (!_pendingFrame || isTooEarlyToPresent()) {
+		return;
+	}
+
+	_pendingFrame = false;
+	OpenGLGraphicsManager::updateScreen();
+}
+
+bool OpenGLSdlGraphicsManager::isTooEarlyToPresent() const {
+	// Only holding back the updates within 3/4 of an interval keeps the timer
+	// jitter of an engine running at the refresh rate from halving its frame
+	// rate.
+	return _framePacing && _presentStats.presented &&
+	       Common::Profiler::getMicros() - _lastPresentMicros < _refreshIntervalMicros * 3 / 4;
+}
+
 void OpenGLSdlGraphicsManager::notifyVideoExpose() {
 }
 
@@ -335,12 +380,57 @@ bool OpenGLSdlGraphicsManager::loadVideoMode(uint requestedWidth, uint requested
 }
 
 void OpenGLSdlGraphicsManager::refreshScreen() {
+	// The rolling screenshots read the back buffer, before it is swapped
+	notifyFramePresented();
+
+	const uint64 swapStart = Common::Profiler::getMicros();
+
 	// Swap OpenGL buffers
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	SDL_GL_SwapWindow(_window->getSDLWindow());
 #else
 	SDL_GL_SwapBuffers();
 #endif
+
+	// Most drivers return from the swap right away and block the next GL
+	// call instead, so the swap to present time is only known after waiting
+	if (_framePacing) {
+		finishRendering();
+	}
+
+	const uint64 swapEnd = Common::Profiler::getMicros();
+	const uint32 swapMicros = (uint32)MIN<uint64>(swapEnd - swapStart, 0xFFFFFFFF);
+	const bool missedVsync = swapMicros > _refreshIntervalMicros;
+	_lastPresentMicros = swapEnd;
+	++_presentStats.presented;
+	_presentStats.swapMicros += swapMicros;
+	_presentStats.maxSwapMicros = MAX(_presentStats.maxSwapMicros, swapMicros);
+	if (missedVsync) {
+		++_presentStats.missedVsyncs;
+	}
+
+#ifdef USE_PROFILER
+	Common::Profiler::addZone("opengl.swap", swapStart, swapEnd);
+	Common::Profiler::addCounter("opengl.framesPresented");
+	if (missedVsync) {
+		Common::Profiler::addCounter("opengl.missedVsyncs");
+	}
+#endif
+}
+
+void OpenGLSdlGraphicsManager::updateRefreshInterval() {
+	int refreshRate = 0;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	SDL_DisplayMode mode;
+	if (_window->getSDLWindow() && SDL_GetWindowDisplayMode(_window->getSDLWindow(), &mode) == 0) {
+		refreshRate = mode.refresh_rate;
+	}
+#endif
+	// SDL 1.2 cannot tell, and SDL 2 reports 0 when the rate is unknown
+	if (refreshRate <= 0) {
+		refreshRate = 60;
+	}
+	_refreshIntervalMicros = 1000000 / refreshRate;
 }
 
 void *OpenGLSdlGraphicsManager::getProcAddress(const char *name) const {
@@ -352,8 +442,9 @@ void OpenGLSdlGraphicsManager::handleResizeImpl(const int width, const int heigh
 	SdlGraphicsManager::handleResizeImpl(width, height, xdpi, ydpi);
 }
 
-bool OpenGLSdlGraphicsManager::saveScreenshot(const Common::String &filename) const {
-	return OpenGLGraphicsManager::saveScreenshot(filename);
+bool OpenGLSdlGraphicsManager::grabScreenshot(Graphics::Surface &surface) const {
+	grabScreen(surface);
+	return true;
 }
 
 bool OpenGLSdlGraphicsManager::setupMode(uint width, uint height) {
@@ -451,6 +542,7 @@ bool OpenGLSdlGraphicsManager::setupMode(uint width, uint height) {
 	}
 
 	notifyContextCreate(rgba8888, rgba8888);
+	updateRefreshInterval();
 	int actualWidth, actualHeight;
 	getWindowSizeFromSdl(&actualWidth, &actualHeight);
 	// TODO: Implement high DPI support
@@ -48,6 +48,7 @@ public:
 	// SdlGraphicsManager API
 	virtual void notifyVideoExpose() override;
 	virtual void notifyResize(const int width, const int height) override;
+	virtual void presentPendingFrame() override;
 
 protected:
 	virtual bool loadVideoMode(uint requestedWidth, uint requestedHeight, const Graphics::PixelFormat &format) override;
@@ -58,13 +59,24 @@ protected:
 
 	virtual void handleResizeImpl(const int width, const int height, const int xdpi, const int ydpi) override;
 
-	virtual bool saveScreenshot(const Common::String &filename) const override;
+	virtual bool grabScreenshot(Graphics::Surface &surface) const override;
 
 	virtual int getGraphicsModeScale(int mode) const override { return 1; }
 
 private:
 	bool setupMode(uint width, uint height);
 
+	/**
+	 * Read the refresh rate of the display the window is on.
+	 */
+	void updateRefreshInterval();
+
+	/**
+	 * Return whether, with frame pacing, the display could not have shown
+	 * the last frame yet.
+	 */
+	bool isTooEarlyToPresent() const;
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	int _glContextProfileMask, _glContextMajor, _glContextMinor;
 	SDL_GLContext _glContext;
@@ -110,6 +122,30 @@ private:
 
 	uint _desiredFullscreenWidth;
 	uint _desiredFullscreenHeight;
+
+	/**
+	 * With frame pacing, enabled by the frame_pacing setting, the updates
+	 * which come before the display could show the last frame are held
+	 * back, and the swaps wait for the frame to be presented.
+	 */
+	bool _framePacing;
+	/** Whether an update was held back, and is still to be presented. */
+	bool _pendingFrame;
+	uint32 _refreshIntervalMicros;
+	uint64 _lastPresentMicros;
+
+	struct PresentStats {
+		PresentStats() : requested(0), presented(0), coalesced(0), missedVsyncs(0), swapMicros(0), maxSwapMicros(0) {}
+
+		uint32 requested;
+		uint32 presented;
+		uint32 coalesced;
+		/** The swaps which took longer than a refresh interval */
+		uint32 missedVsyncs;
+		uint64 swapMicros;
+		uint32 maxSwapMicros;
+	};
+	PresentStats _presentStats;
 };
 
 #endif
@@ -27,21 +27,62 @@
 #include "backends/keymapper/action.h"
 #include "backends/keymapper/keymap.h"
 #include "common/config-manager.h"
+#include "common/file.h"
 #include "common/fs.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/translation.h"
 #include "graphics/scaler/aspect.h"
+#include "graphics/surface.h"
+#ifdef USE_PNG
+#include "image/png.h"
+#else
+#include "image/bmp.h"
+#endif
 #ifdef USE_OSD
 #include "common/translation.h"
 #endif
 
+// The most screenshots being written at once. Taking more waits for the oldest.
+enum {
+	kMaxBackgroundScreenshots = 8
+};
+
+struct SdlGraphicsManager::BackgroundScreenshot {
+	Common::String path;
+	Common::String filename;
+	Common::DumpFile out;
+	Graphics::Surface surface;
+	bool rolling;
+	bool success;
+	Common::TaskGroup task;
+
+	static void write(void *refCon) {
+		BackgroundScreenshot *screenshot = (BackgroundScreenshot *)refCon;
+#ifdef USE_PNG
+		screenshot->success = Image::writePNG(screenshot->out, screenshot->surface);
+#else
+		screenshot->success = Image::writeBMP(screenshot->out, screenshot->surface);
+#endif
+		screenshot->out.close();
+	}
+};
+
 SdlGraphicsManager::SdlGraphicsManager(SdlEventSource *source, SdlWindow *window)
-	: _eventSource(source), _window(window), _hwScreen(nullptr)
+	: _eventSource(source), _window(window), _hwScreen(nullptr), _nextScreenshot(0),
+	  _rollingScreenshotPeriod(0), _framesSinceScreenshot(0)
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	, _allowWindowSizeReset(false), _hintedWidth(0), _hintedHeight(0), _lastFlags(0)
 #endif
 {
 	SDL_GetMouseState(&_cursorX, &_cursorY);
+
+	if (ConfMan.hasKey("rolling_screenshots"))
+		_rollingScreenshotPeriod = MAX(ConfMan.getInt("rolling_screenshots"), 0);
+}
+
+SdlGraphicsManager::~SdlGraphicsManager() {
+	finishScreenshots(true);
 }
 
 void SdlGraphicsManager::activateManager() {
@@ -297,7 +338,11 @@ bool SdlGraphicsManager::createOrUpdateWindow(int width, int height, const Uint3
 #endif
 
 void SdlGraphicsManager::saveScreenshot() {
-	Common::String filename;
+	takeScreenshot(false);
+}
+
+void SdlGraphicsManager::takeScreenshot(bool rolling) {
+	finishScreenshots(false);
 
 	Common::String screenshotsPath;
 	OSystem_SDL *sdl_g_system = dynamic_cast<OSystem_SDL*>(g_system);
@@ -306,6 +351,10 @@ void SdlGraphicsManager::saveScreenshot() {
 
 	// Use the name of the running target as a base for screenshot file names
 	Common::String currentTarget = ConfMan.getActiveDomainName();
+	if (currentTarget != _screenshotTarget) {
+		_screenshotTarget = currentTarget;
+		_nextScreenshot = 0;
+	}
 
 #ifdef USE_PNG
 	const char *extension = "png";
@@ -313,22 +362,21 @@ void SdlGraphicsManager::saveScreenshot() {
 	const char *extension = "bmp";
 #endif
 
-	for (int n = 0;; n++) {
+	// The numbers already used are remembered, so the rolling screenshots
+	// do not check all the previous files each time
+	Common::String filename;
+	for (;; _nextScreenshot++) {
 		filename = Common::String::format("scummvm%s%s-%05d.%s", currentTarget.empty() ? "" : "-",
-		                                  currentTarget.c_str(), n, extension);
+		                                  currentTarget.c_str(), _nextScreenshot, extension);
 
 		Common::FSNode file = Common::FSNode(screenshotsPath + filename);
 		if (!file.exists()) {
 			break;
 		}
 	}
+	_nextScreenshot++;
 
-	if (saveScreenshot(screenshotsPath + filename)) {
-		if (screenshotsPath.empty())
-			debug("Saved screenshot '%s' in current directory", filename.c_str());
-		else
-			debug("Saved screenshot '%s' in directory '%s'", filename.c_str(), screenshotsPath.c_str());
-	} else {
+	if (!startScreenshot(screenshotsPath, filename, rolling)) {
 		if (screenshotsPath.empty())
 			warning("Could not save screenshot in current directory");
 		else
@@ -336,6 +384,75 @@ void SdlGraphicsManager::saveScreenshot() {
 	}
 }
 
+bool SdlGraphicsManager::startScreenshot(const Common::String &path, const Common::String &filename, bool rolling) {
+	if (_screenshots.size() >= kMaxBackgroundScreenshots) {
+		// Wait for the oldest one rather than skipping frames, so the rolling
+		// screenshots stay predictable
+		_screenshots.front()->task.wait();
+		finishScreenshots(false);
+	}
+
+	BackgroundScreenshot *screenshot = new BackgroundScreenshot();
+	screenshot->path = path;
+	screenshot->filename = filename;
+	screenshot->rolling = rolling;
+	screenshot->success = false;
+	if (!screenshot->out.open(path + filename) || !grabScreenshot(screenshot->surface)) {
+		screenshot->surface.free();
+		delete screenshot;
+		return false;
+	}
+
+	_screenshots.push_back(screenshot);
+	screenshot->task.run(&BackgroundScreenshot::write, screenshot);
+	return true;
+}
+
+void SdlGraphicsManager::finishScreenshots(bool wait) {
+	for (Common::List<BackgroundScreenshot *>::iterator i = _screenshots.begin(); i != _screenshots.end();) {
+		BackgroundScreenshot *screenshot = *i;
+		if (wait)
+			screenshot->task.wait();
+		else if (!screenshot->task.isDone()) {
+			++i;
+			continue;
+		}
+
+		if (!screenshot->success) {
+			if (screenshot->path.empty())
+				warning("Could not save screenshot in current directory");
+			else
+				warning("Could not save screenshot in directory '%s'", screenshot->path.c_str());
+		} else {
+			Common::String message;
+			if (screenshot->path.empty())
+				message = Common::String::format("Saved screenshot '%s' in current directory", screenshot->filename.c_str());
+			else
+				message = Common::String::format("Saved screenshot '%s' in directory '%s'", screenshot->filename.c_str(), screenshot->path.c_str());
+
+			// Only report the rolling screenshots with debug level 1, not to flood the console
+			if (screenshot->rolling)
+				debug(1, "%s", message.c_str());
+			else
+				debug("%s", message.c_str());
+		}
+
+		screenshot->surface.free();
+		delete screenshot;
+		i = _screenshots.erase(i);
+	}
+}
+
+void SdlGraphicsManager::notifyFramePresented() {
+	if (!_screenshots.empty())
+		finishScreenshots(false);
+
+	if (_rollingScreenshotPeriod && ++_framesSinceScreenshot >= _rollingScreenshotPeriod) {
+		_framesSinceScreenshot = 0;
+		takeScreenshot(true);
+	}
+}
+
 bool SdlGraphicsManager::notifyEvent(const Common::Event &event) {
 	if (event.type != Common::EVENT_CUSTOM_BACKEND_ACTION_START) {
 		return false;
@@ -27,6 +27,7 @@
 #include "backends/platform/sdl/sdl-window.h"
 
 #include "common/events.h"
+#include "common/list.h"
 #include "common/rect.h"
 
 class SdlEventSource;
@@ -41,7 +42,7 @@ class SdlEventSource;
 class SdlGraphicsManager : virtual public WindowedGraphicsManager, public Common::EventObserver {
 public:
 	SdlGraphicsManager(SdlEventSource *source, SdlWindow *window);
-	virtual ~SdlGraphicsManager() {}
+	virtual ~SdlGraphicsManager();
 
 	/**
 	 * Makes this graphics manager active. That means it should be ready to
@@ -79,6 +80,14 @@ public:
 	 */
 	virtual void notifyResize(const int width, const int height) {}
 
+	/**
+	 * Give the graphics manager a chance to present a frame whose update
+	 * it held back. Called whenever events are polled.
+	 *
+	 * The default implementation just does nothing.
+	 */
+	virtual void presentPendingFrame() {}
+
 	/**
 	 * Notifies the graphics manager about a mouse position change.
 	 *
@@ -97,7 +106,18 @@ public:
 	virtual bool showMouse(bool visible) override;
 	virtual bool lockMouse(bool lock) override;
 
-	virtual bool saveScreenshot(const Common::String &filename) const { return false; }
+	/**
+	 * Copy the current frame for a screenshot, as it is shown in the window.
+	 *
+	 * @param surface The surface to create and fill. It is freed by the caller.
+	 * @return true on success, false otherwise
+	 */
+	virtual bool grabScreenshot(Graphics::Surface &surface) const { return false; }
+
+	/**
+	 * Save a screenshot. The frame is copied right away, but it is encoded
+	 * and written to the file on a worker thread.
+	 */
 	void saveScreenshot() override;
 
 	// Override from Common::EventObserver
@@ -203,12 +223,34 @@ protected:
 	bool createOrUpdateWindow(const int width, const int height, const Uint32 flags);
 #endif
 
+	/**
+	 * To be called each time a frame is presented. Takes the rolling
+	 * screenshots, and finishes the screenshots written in the background.
+	 */
+	void notifyFramePresented();
+
 	SDL_Surface *_hwScreen;
 	SdlEventSource *_eventSource;
 	SdlWindow *_window;
 
 private:
 	void toggleFullScreen();
+
+	struct BackgroundScreenshot;
+
+	void takeScreenshot(bool rolling);
+
+	/** Start writing a screenshot of the current frame on a worker thread. */
+	bool startScreenshot(const Common::String &path, const Common::String &filename, bool rolling);
+
+	/** Report and free the screenshots written in the background which are done. */
+	void finishScreenshots(bool wait);
+
+	Common::List<BackgroundScreenshot *> _screenshots;
+	Common::String _screenshotTarget;
+	int _nextScreenshot;
+	int _rollingScreenshotPeriod; /*!< Take a screenshot every that many frames, if not 0 */
+	int _framesSinceScreenshot;
 };
 
 #endif
@@ -28,6 +28,7 @@
 #include "common/config-manager.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/translation.h"
 #include "common/util.h"
 #include "common/file.h"
@@ -42,11 +43,6 @@
 #include "graphics/surface.h"
 #include "gui/debugger.h"
 #include "gui/EventRecorder.h"
-#ifdef USE_PNG
-#include "image/png.h"
-#else
-#include "image/bmp.h"
-#endif
 #ifdef USE_TTS
 #include "common/text-to-speech.h"
 #endif
@@ -111,6 +107,90 @@ static const int s_gfxModeSwitchTable[][4] = {
 		{ GFX_NORMAL, GFX_DOTMATRIX, -1, -1 }
 	};
 
+namespace {
+
+// Dirty rects smaller than this are not split up for the thread pool
+enum {
+	kMinScaleBandHeight = 16,
+	kMinStretchStripWidth = 64
+};
+
+/**
+ * Scales horizontal bands of a dirty rect. The scalers read the rows
+ * around the ones they scale, so neighbouring bands overlap in the
+ * source, which is only read; their destination rows are disjoint.
+ */
+struct ScaleBandProc {
+	ScalerProc *_scalerProc;
+	const uint8 *_src;
+	uint32 _srcPitch;
+	uint8 *_dst;
+	uint32 _dstPitch;
+	int _width;
+	int _height;
+	int _scaleFactor;
+	uint _numBands;
+
+	// Bands start on multiples of 4 rows, as DotMatrix depends on where its rows are
+	int getBandStart(uint band) const {
+		if (band >= _numBands)
+			return _height;
+		return (_height * band / _numBands) & ~3;
+	}
+
+	void operator()(uint begin, uint end) const {
+		for (uint band = begin; band < end; ++band) {
+			const int y = getBandStart(band);
+			_scalerProc(_src + y * _srcPitch, _srcPitch, _dst + y * _scaleFactor * _dstPitch, _dstPitch,
+				_width, getBandStart(band + 1) - y);
+		}
+	}
+};
+
+#ifdef USE_SCALERS
+/**
+ * Applies the aspect ratio correction to vertical strips of a scaled rect.
+ * It works in place from the bottom up, but each column only depends on
+ * itself, so the strips are independent.
+ */
+struct StretchStripProc {
+	uint8 *_buf;
+	uint32 _pitch;
+	int _x;
+	int _y;
+	int _width;
+	int _height;
+	int _origSrcY;
+	bool _interpolate;
+	uint _numStrips;
+
+	void operator()(uint begin, uint end) const {
+		for (uint strip = begin; strip < end; ++strip) {
+			const int x = _width * strip / _numStrips;
+			stretch200To240(_buf, _pitch, _width * (strip + 1) / _numStrips - x, _height, _x + x, _y, _origSrcY, _interpolate);
+		}
+	}
+};
+#endif
+
+bool isThreadSafeScaler(ScalerProc *scalerProc) {
+#if defined(USE_NASM) && defined(USE_HQ_SCALERS)
+	// The assembly versions of the HQ scalers keep their state in globals
+	if (scalerProc == HQ2x || scalerProc == HQ3x)
+		return false;
+#endif
+	return true;
+}
+
+uint getNumParts(int size, int minPartSize) {
+	const uint maxParts = size / minPartSize;
+	if (maxParts < 2)
+		return 1;
+	return MIN(Common::ThreadPool::instance().getNumWorkers() + 1, maxParts);
+}
+
+} // End of anonymous namespace
+
 AspectRatio::AspectRatio(int w, int h) {
 	// TODO : Validation and so on...
 	// Currently, we just ensure the program don't instantiate non-supported aspect ratios
@@ -1134,6 +1214,7 @@ void SurfaceSdlGraphicsManager::updateScreen() {
 	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
 
 	internUpdateScreen();
+	notifyFramePresented();
 }
 
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
@@ -1278,8 +1359,15 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 					dst_y = real2Aspect(dst_y);
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, dst_w, dst_h);
+				const uint8 *src = (const uint8 *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch;
+				uint8 *dstPtr = (uint8 *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch;
+				const uint numBands = isThreadSafeScaler(scalerProc) ? getNumParts(dst_h, kMinScaleBandHeight) : 1;
+				if (numBands > 1) {
+					ScaleBandProc proc = { scalerProc, src, srcPitch, dstPtr, dstPitch, dst_w, dst_h, scale1, numBands };
+					Common::parallelFor(0, numBands, 1, proc);
+				} else {
+					scalerProc(src, srcPitch, dstPtr, dstPitch, dst_w, dst_h);
+				}
 			}
 
 			r->x = dst_x;
@@ -1288,8 +1376,16 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			r->h = dst_h * scale1;
 
 #ifdef USE_SCALERS
-			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible)
-				r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering);
+			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible) {
+				const uint numStrips = getNumParts(r->w, kMinStretchStripWidth);
+				if (numStrips > 1) {
+					StretchStripProc proc = { (uint8 *)_hwScreen->pixels, dstPitch, r->x, r->y, r->w, r->h, orig_dst_y * scale1, _videoMode.filtering, numStrips };
+					Common::parallelFor(0, numStrips, 1, proc);
+					r->h = 1 + real2Aspect(orig_dst_y * scale1 + r->h - 1) - r->y;
+				} else {
+					r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering);
+				}
+			}
 #endif
 		}
 		SDL_UnlockSurface(srcSurf);
@@ -1398,16 +1494,11 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	_cursorNeedsRedraw = false;
 }
 
-bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::String &filename) const {
+bool SurfaceSdlGraphicsManager::grabScreenshot(Graphics::Surface &surface) const {
 	assert(_hwScreen != NULL);
 
 	Common::StackLock lock(_graphicsMutex);
 
-	Common::DumpFile out;
-	if (!out.open(filename)) {
-		return false;
-	}
-
 	int result = SDL_LockSurface(_hwScreen);
 	if (result < 0) {
 		warning("Could not lock RGB surface");
@@ -1417,15 +1508,11 @@ bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::String &filename) c
 	Graphics::PixelFormat format = convertSDLPixelFormat(_hwScreen->format);
 	Graphics::Surface data;
 	data.init(_hwScreen->w, _hwScreen->h, _hwScreen->pitch, _hwScreen->pixels, format);
-#ifdef USE_PNG
-	const bool success = Image::writePNG(out, data);
-#else
-	const bool success = Image::writeBMP(out, data);
-#endif
+	surface.copyFrom(data);
 
 	SDL_UnlockSurface(_hwScreen);
 
-	return success;
+	return true;
 }
 
 void SurfaceSdlGraphicsManager::setFullscreenMode(bool enable) {
@@ -1507,6 +1594,41 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 	SDL_UnlockSurface(_screen);
 }
 
+void SurfaceSdlGraphicsManager::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	assert(_transactionMode == kTransactionNone);
+	assert(buf);
+
+	if (_screen == NULL) {
+		warning("SurfaceSdlGraphicsManager::copyRectsToScreen: _screen == NULL");
+		return;
+	}
+
+	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
+
+	// Lock the screen surface once for all the rects
+	if (SDL_LockSurface(_screen) == -1)
+		error("SDL_LockSurface failed: %s", SDL_GetError());
+
+	for (uint i = 0; i < count; ++i) {
+		const Common::Rect &r = rects[i];
+		assert(r.left >= 0 && r.right <= _videoMode.screenWidth && r.left < r.right);
+		assert(r.top >= 0 && r.bottom <= _videoMode.screenHeight && r.top < r.bottom);
+
+		addDirtyRect(r.left, r.top, r.width(), r.height());
+
+		const byte *src = (const byte *)buf + r.top * pitch + r.left * _screenFormat.bytesPerPixel;
+		byte *dst = (byte *)_screen->pixels + r.top * _screen->pitch + r.left * _screenFormat.bytesPerPixel;
+		for (int y = r.top; y < r.bottom; ++y) {
+			memcpy(dst, src, r.width() * _screenFormat.bytesPerPixel);
+			src += pitch;
+			dst += _screen->pitch;
+		}
+	}
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+}
+
 Graphics::Surface *SurfaceSdlGraphicsManager::lockScreen() {
 	assert(_transactionMode == kTransactionNone);
 
@@ -115,6 +115,7 @@ protected:
 	Graphics::PixelFormat convertSDLPixelFormat(SDL_PixelFormat *in) const;
 public:
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) override;
 	virtual Graphics::Surface *lockScreen() override;
 	virtual void unlockScreen() override;
 	virtual void fillScreen(uint32 col) override;
@@ -419,7 +420,7 @@ protected:
 	virtual void setAspectRatioCorrection(bool enable);
 	void setFilteringMode(bool enable);
 
-	virtual bool saveScreenshot(const Common::String &filename) const override;
+	virtual bool grabScreenshot(Graphics::Surface &surface) const override;
 	virtual void setGraphicsModeIntern();
 
 private:
@@ -33,6 +33,8 @@
 
 namespace Common {
 
+uint32 Keymap::_mappingsGeneration = 0;
+
 Keymap::Keymap(KeymapType type, const String &id, const U32String &description) :
 		_type(type),
 		_id(id),
@@ -58,6 +60,8 @@ Keymap::Keymap(KeymapType type, const String &id, const String &description) :
 Keymap::~Keymap() {
 	for (ActionArray::iterator it = _actions.begin(); it != _actions.end(); ++it)
 		delete *it;
+
+	_mappingsGeneration++;
 }
 
 void Keymap::addAction(Action *action) {
@@ -75,6 +79,8 @@ void Keymap::registerMapping(Action *action, const HardwareInput &hwInput) {
 	if (found == actionArray.end()) {
 		actionArray.push_back(action);
 	}
+
+	_mappingsGeneration++;
 }
 
 void Keymap::unregisterMapping(Action *action) {
@@ -90,6 +96,8 @@ void Keymap::unregisterMapping(Action *action) {
 			_hwActionMap.erase(itInput);
 		}
 	}
+
+	_mappingsGeneration++;
 }
 
 void Keymap::resetMapping(Action *action) {
@@ -287,6 +295,7 @@ void Keymap::loadMappings() {
 	String prefix = KEYMAP_KEY_PREFIX + _id + "_";
 
 	_hwActionMap.clear();
+	_mappingsGeneration++;
 	for (ActionArray::const_iterator it = _actions.begin(); it != _actions.end(); ++it) {
 		Action *action = *it;
 		String confKey = prefix + action->id;
@@ -163,7 +163,18 @@ public:
 	 * Defines if the keymap is considered when mapping events
 	 */
 	bool isEnabled() const { return _enabled; }
-	void setEnabled(bool enabled) { _enabled = enabled; }
+	void setEnabled(bool enabled) {
+		_enabled = enabled;
+		_mappingsGeneration++;
+	}
+
+	/**
+	 * Return a number which changes each time the mappings of any keymap
+	 * change, or a keymap is enabled, disabled or deleted.
+	 *
+	 * This allows keeping what the mappings resolve to until they change.
+	 */
+	static uint32 getMappingsGeneration() { return _mappingsGeneration; }
 
 	/** Helper to return an array with a single keymap element */
 	static Array<Keymap *> arrayOf(Keymap *keymap) {
@@ -191,6 +202,8 @@ private:
 	ConfigManager::Domain *_configDomain;
 	HardwareInputSet *_hardwareInputSet;
 	const KeymapperDefaultBindings *_backendDefaultBindings;
+
+	static uint32 _mappingsGeneration;
 };
 
 typedef Array<Keymap *> KeymapArray;
@@ -40,9 +40,12 @@ Keymapper::Keymapper(EventManager *eventMan) :
 		_backendDefaultBindings(nullptr),
 		_delayedEventSource(new DelayedEventSource()),
 		_enabled(true),
-		_enabledKeymapType(Keymap::kKeymapTypeGame) {
+		_enabledKeymapType(Keymap::kKeymapTypeGame),
+		_mappedActionsGeneration(0),
+		_mappedActionsKeymapType(Keymap::kKeymapTypeGame) {
 	_eventMan->getEventDispatcher()->registerSource(_delayedEventSource, true);
 	resetInputState();
+	invalidateMappedActions();
 }
 
 Keymapper::~Keymapper() {
@@ -60,6 +63,8 @@ void Keymapper::clear() {
 
 	delete _hardwareInputs;
 	_hardwareInputs = nullptr;
+
+	invalidateMappedActions();
 }
 
 void Keymapper::registerHardwareInputSet(HardwareInputSet *inputs, KeymapperDefaultBindings *backendDefaultBindings) {
@@ -96,6 +101,7 @@ void Keymapper::addGlobalKeymap(Keymap *keymap) {
 	ConfigManager::Domain *keymapperDomain = ConfMan.getDomain(ConfigManager::kKeymapperDomain);
 	initKeymap(keymap, keymapperDomain);
 	_keymaps.push_back(keymap);
+	invalidateMappedActions();
 }
 
 void Keymapper::addGameKeymap(Keymap *keymap) {
@@ -109,6 +115,7 @@ void Keymapper::addGameKeymap(Keymap *keymap) {
 
 	initKeymap(keymap, gameDomain);
 	_keymaps.push_back(keymap);
+	invalidateMappedActions();
 }
 
 void Keymapper::initKeymap(Keymap *keymap, ConfigManager::Domain *domain) {
@@ -170,18 +177,9 @@ List<Event> Keymapper::mapEvent(const Event &ev) {
 
 	hardcodedEventMapping(ev);
 
-	Keymap::ActionArray actions;
-	Keymap::KeymapMatch match = getMappedActions(ev, actions, _enabledKeymapType);
-	if (match != Keymap::kKeymapMatchExact) {
-		// If we found exact matching actions this input in the game / gui keymaps,
-		// no need to look at the global keymaps. An input resulting in actions
-		// from system and game keymaps would lead to unexpected user experience.
-		Keymap::ActionArray globalActions;
-		match = getMappedActions(ev, globalActions, Keymap::kKeymapTypeGlobal);
-		if (match == Keymap::kKeymapMatchExact || actions.empty()) {
-			actions = globalActions;
-		}
-	}
+	static const Keymap::ActionArray noActions;
+	HardwareInput input;
+	const Keymap::ActionArray &actions = findMappingInput(ev, input) ? getCachedMappedActions(input, ev) : noActions;
 
 	bool matchedAction = !actions.empty();
 	List<Event> mappedEvents;
@@ -222,6 +220,93 @@ List<Event> Keymapper::mapEvent(const Event &ev) {
 	return mappedEvents;
 }
 
+bool Keymapper::findMappingInput(const Event &event, HardwareInput &input) {
+	switch (event.type) {
+	case EVENT_KEYDOWN:
+	case EVENT_KEYUP:
+		input = HardwareInput::createKeyboard("", KeyboardHardwareInputSet::normalizeKeyState(event.kbd), U32String());
+		return true;
+	case EVENT_LBUTTONDOWN:
+	case EVENT_LBUTTONUP:
+		input = HardwareInput::createMouse("", MOUSE_BUTTON_LEFT, U32String());
+		return true;
+	case EVENT_RBUTTONDOWN:
+	case EVENT_RBUTTONUP:
+		input = HardwareInput::createMouse("", MOUSE_BUTTON_RIGHT, U32String());
+		return true;
+	case EVENT_MBUTTONDOWN:
+	case EVENT_MBUTTONUP:
+		input = HardwareInput::createMouse("", MOUSE_BUTTON_MIDDLE, U32String());
+		return true;
+	case EVENT_WHEELUP:
+		input = HardwareInput::createMouse("", MOUSE_WHEEL_UP, U32String());
+		return true;
+	case EVENT_WHEELDOWN:
+		input = HardwareInput::createMouse("", MOUSE_WHEEL_DOWN, U32String());
+		return true;
+	case EVENT_X1BUTTONDOWN:
+	case EVENT_X1BUTTONUP:
+		input = HardwareInput::createMouse("", MOUSE_BUTTON_X1, U32String());
+		return true;
+	case EVENT_X2BUTTONDOWN:
+	case EVENT_X2BUTTONUP:
+		input = HardwareInput::createMouse("", MOUSE_BUTTON_X2, U32String());
+		return true;
+	case EVENT_JOYBUTTON_DOWN:
+	case EVENT_JOYBUTTON_UP:
+		input = HardwareInput::createJoystickButton("", event.joystick.button, U32String());
+		return true;
+	case EVENT_JOYAXIS_MOTION:
+		if (event.joystick.position != 0) {
+			input = HardwareInput::createJoystickHalfAxis("", event.joystick.axis, event.joystick.position > 0, U32String());
+		} else {
+			// The center of the axis triggers the actions of both halves, so
+			// it is given its own entry, out of the range of the half axes
+			input = HardwareInput::createJoystickHalfAxis("", event.joystick.axis, false, U32String());
+			input.inputCode += kJoystickAxisCenterCode;
+		}
+		return true;
+	case EVENT_CUSTOM_BACKEND_HARDWARE:
+		input = HardwareInput::createCustom("", event.customType, U32String());
+		return true;
+	default:
+		// No other events are ever mapped
+		return false;
+	}
+}
+
+const Keymap::ActionArray &Keymapper::getCachedMappedActions(const HardwareInput &input, const Event &event) {
+	if (_mappedActionsGeneration != Keymap::getMappingsGeneration() || _mappedActionsKeymapType != _enabledKeymapType) {
+		invalidateMappedActions();
+	}
+
+	MappedActionsTable::iterator it = _mappedActions.find(input);
+	if (it != _mappedActions.end()) {
+		return it->_value;
+	}
+
+	Keymap::ActionArray &actions = _mappedActions[input];
+	Keymap::KeymapMatch match = getMappedActions(event, actions, _enabledKeymapType);
+	if (match != Keymap::kKeymapMatchExact) {
+		// If we found exact matching actions this input in the game / gui keymaps,
+		// no need to look at the global keymaps. An input resulting in actions
+		// from system and game keymaps would lead to unexpected user experience.
+		Keymap::ActionArray globalActions;
+		match = getMappedActions(event, globalActions, Keymap::kKeymapTypeGlobal);
+		if (match == Keymap::kKeymapMatchExact || actions.empty()) {
+			actions = globalActions;
+		}
+	}
+
+	return actions;
+}
+
+void Keymapper::invalidateMappedActions() {
+	_mappedActions.clear();
+	_mappedActionsGeneration = Keymap::getMappingsGeneration();
+	_mappedActionsKeymapType = _enabledKeymapType;
+}
+
 Keymap::KeymapMatch Keymapper::getMappedActions(const Event &event, Keymap::ActionArray &actions, Keymap::KeymapType keymapType) const {
 	Keymap::KeymapMatch match = Keymap::kKeymapMatchNone;
 
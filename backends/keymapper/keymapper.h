@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 
+#include "backends/keymapper/hardware-input.h"
 #include "backends/keymapper/keymap.h"
 
 #include "common/array.h"
@@ -151,6 +152,25 @@ private:
 
 	bool _joystickAxisPreviouslyPressed[6];
 
+	/**
+	 * The actions each input resolves to over all the enabled keymaps, with
+	 * the keymap priorities applied. Entries are added as the inputs are
+	 * used, and the whole table is dropped when the keymaps change.
+	 */
+	typedef HashMap<HardwareInput, Keymap::ActionArray, HardwareInput_Hash, HardwareInput_EqualTo> MappedActionsTable;
+	MappedActionsTable _mappedActions;
+	uint32 _mappedActionsGeneration;
+	Keymap::KeymapType _mappedActionsKeymapType;
+
+	enum {
+		kJoystickAxisCenterCode = 0x10000
+	};
+
+	/** Find the input used to look up the actions of an event. Returns false for the events which are never mapped. */
+	static bool findMappingInput(const Event &event, HardwareInput &input);
+	const Keymap::ActionArray &getCachedMappedActions(const HardwareInput &input, const Event &event);
+	void invalidateMappedActions();
+
 	Keymap::KeymapMatch getMappedActions(const Event &event, Keymap::ActionArray &actions, Keymap::KeymapType keymapType) const;
 	Event executeAction(const Action *act, const Event &incomingEvent);
 	EventType convertStartToEnd(EventType eventType);
@@ -26,6 +26,7 @@
 NullMixerManager::NullMixerManager() : MixerManager() {
 	_outputRate = 22050;
 	_callsCounter = 0;
+	_mixedSamples = 0;
 	_samples = 8192;
 	while (_samples * 16 > _outputRate * 2)
 		_samples >>= 1;
@@ -64,3 +65,15 @@ void NullMixerManager::update(uint8 callbackPeriod) {
 		_mixer->mixCallback(_samplesBuf, _samples);
 	}
 }
+
+void NullMixerManager::updateUntil(uint32 millis) {
+	if (_audioSuspended) {
+		return;
+	}
+	assert(_mixer);
+	const uint64 target = (uint64)millis * _outputRate / 1000;
+	while (_mixedSamples + _samples <= target) {
+		_mixer->mixCallback(_samplesBuf, _samples * 4);
+		_mixedSamples += _samples;
+	}
+}
@@ -42,6 +42,12 @@ public:
 	virtual void init();
 	void update(uint8 callbackPeriod = 10);
 
+	/**
+	 * Mix all the samples the output would have played after the given
+	 * number of milliseconds, however fast the time is going.
+	 */
+	void updateUntil(uint32 millis);
+
 	virtual void suspendAudio();
 	virtual int resumeAudio();
 
@@ -50,6 +56,7 @@ private:
 	uint32 _callsCounter;
 	uint32 _samples;
 	uint8 *_samplesBuf;
+	uint64 _mixedSamples;
 };
 
 #endif
@@ -26,6 +26,7 @@
 
 #include "backends/mixer/sdl/sdl-mixer.h"
 #include "common/debug.h"
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/config-manager.h"
 #include "common/textconsole.h"
@@ -38,7 +39,23 @@
 #define SAMPLES_PER_SEC 44100
 #endif
 
+enum {
+	kAdaptiveMinSamples = 256,		// The buffer size the adaptive mode starts with
+	kAdaptiveMaxSamples = 8192,		// The largest buffer size it grows to, unless audio_buffer_size is set
+	kAdaptiveCheckMillis = 1000,	// The period of the underrun checks
+	kAdaptiveStableChecks = 30,		// The checks without underrun before the buffer is shrunk
+	kAdaptiveMaxStableChecks = 8 * kAdaptiveStableChecks
+};
+
 SdlMixerManager::~SdlMixerManager() {
+	if (_adaptiveTimer) {
+		SDL_RemoveTimer(_adaptiveTimer);
+		// Wait for a check which may be running
+		Common::StackLock lock(_adaptiveMutex);
+		_adaptiveTimer = 0;
+		SDL_QuitSubSystem(SDL_INIT_TIMER);
+	}
+
 	_mixer->setReady(false);
 
 	SDL_CloseAudio();
@@ -62,8 +79,24 @@ void SdlMixerManager::init() {
 #endif
 	debug(1, "Using SDL Audio Driver \"%s\"", sdlDriverName);
 
-	// Get the desired audio specs
-	SDL_AudioSpec desired = getAudioSpec(SAMPLES_PER_SEC);
+	// Get the desired audio specs. Prefer the native rate and format of the
+	// device, so that neither the mixer nor SDL need to convert the output.
+	uint32 rate = SAMPLES_PER_SEC;
+	bool floatOutput = false;
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+	SDL_AudioSpec native;
+	if (SDL_GetDefaultAudioInfo(NULL, &native, 0) == 0) {
+		debug(1, "Native audio device format: %d, %d Hz", native.format, native.freq);
+		if (native.freq > 0)
+			rate = native.freq;
+		floatOutput = (native.format == AUDIO_F32SYS);
+	}
+#endif
+	SDL_AudioSpec desired = getAudioSpec(rate);
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (floatOutput)
+		desired.format = AUDIO_F32SYS;
+#endif
 
 	// Needed as SDL_OpenAudio as of SDL-1.2.14 mutates fields in
 	// "desired" if used directly.
@@ -81,7 +114,7 @@ void SdlMixerManager::init() {
 	// The obtained sample format is not supported by the mixer, call
 	// SDL_OpenAudio again with NULL as the second argument to force
 	// SDL to do resampling to the desired audio spec.
-	if (_obtained.format != desired.format) {
+	if (!isSupportedFormat(_obtained.format)) {
 		debug(1, "SDL mixer sound format: %d differs from desired: %d", _obtained.format, desired.format);
 		SDL_CloseAudio();
 
@@ -111,11 +144,37 @@ void SdlMixerManager::init() {
 		error("SDL mixer output requires stereo output device");
 #endif
 
-	_mixer = new Audio::MixerImpl(_obtained.freq);
+	_mixer = new Audio::MixerImpl(_obtained.freq, getOutputFormat(_obtained.format));
 	assert(_mixer);
 	_mixer->setReady(true);
 
 	startAudio();
+
+	if (_maxSamples) {
+		if (SDL_InitSubSystem(SDL_INIT_TIMER) == -1) {
+			warning("Could not initialize SDL timer, the audio buffer size won't adapt: %s", SDL_GetError());
+			return;
+		}
+
+		_stablePeriod = kAdaptiveStableChecks;
+		_adaptiveTimer = SDL_AddTimer(kAdaptiveCheckMillis, adaptiveTimerCallback, this);
+	}
+}
+
+bool SdlMixerManager::isSupportedFormat(uint16 format) const {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (format == AUDIO_F32SYS)
+		return true;
+#endif
+	return format == AUDIO_S16SYS;
+}
+
+Audio::MixerImpl::OutputFormat SdlMixerManager::getOutputFormat(uint16 format) const {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (format == AUDIO_F32SYS)
+		return Audio::MixerImpl::kOutputFloat32;
+#endif
+	return Audio::MixerImpl::kOutputS16;
 }
 
 static uint32 roundDownPowerOfTwo(uint32 samples) {
@@ -160,7 +219,8 @@ SDL_AudioSpec SdlMixerManager::getAudioSpec(uint32 outputRate) {
 
 	// 256 is an arbitrary minimum; 32768 is the largest power-of-two value
 	// representable with uint16
-	if (samples < 256 || samples > 32768)
+	const bool explicitSize = samples >= 256 && samples <= 32768;
+	if (!explicitSize)
 		// By default, hold no more than 45ms worth of samples to avoid
 		// perceptable audio lag (ATSC IS-191). For reference, DOSBox (as of Sep
 		// 2017) uses a buffer size of 1024 samples by default for a 16-bit
@@ -168,6 +228,18 @@ SDL_AudioSpec SdlMixerManager::getAudioSpec(uint32 outputRate) {
 		// below 45ms.
 		samples = freq / (1000.0 / 45);
 
+	// In the adaptive mode, start from the smallest buffer and let
+	// adaptBufferSize() find the size the device can sustain. A configured
+	// size is then the largest one it grows to.
+	_minSamples = _maxSamples = 0;
+	if (ConfMan.hasKey("adaptive_audio_buffer", Common::ConfigManager::kApplicationDomain) &&
+			ConfMan.getBool("adaptive_audio_buffer", Common::ConfigManager::kApplicationDomain)) {
+		_maxSamples = explicitSize ? roundDownPowerOfTwo(samples) : (uint32)kAdaptiveMaxSamples;
+		_minSamples = MIN<uint16>(kAdaptiveMinSamples, _maxSamples);
+		samples = _minSamples;
+		debug(1, "Adaptive audio buffer size between %d and %d samples", _minSamples, _maxSamples);
+	}
+
 	memset(&desired, 0, sizeof(desired));
 	desired.freq = freq;
 	desired.format = AUDIO_S16SYS;
@@ -186,6 +258,17 @@ void SdlMixerManager::startAudio() {
 
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
+
+	// SDL asks for the next buffer once the previous one started playing, so
+	// a gap of more than two buffers means that the device ran dry
+	const uint64 now = Common::Profiler::getMicros();
+	const uint64 bufferMicros = (uint64)(len / _mixer->getOutputFrameSize()) * 1000000 / _obtained.freq;
+	if (_lastCallbackMicros && now - _lastCallbackMicros > 2 * bufferMicros) {
+		_mixer->notifyUnderrun();
+		_underruns++;
+	}
+	_lastCallbackMicros = now;
+
 	_mixer->mixCallback(samples, len);
 }
 
@@ -196,12 +279,86 @@ void SdlMixerManager::sdlCallback(void *this_, byte *samples, int len) {
 	manager->callbackHandler(samples, len);
 }
 
+Uint32 SDLCALL SdlMixerManager::adaptiveTimerCallback(Uint32 interval, void *param) {
+	SdlMixerManager *manager = (SdlMixerManager *)param;
+	assert(manager);
+
+	manager->adaptBufferSize();
+	return interval;
+}
+
+void SdlMixerManager::adaptBufferSize() {
+	Common::StackLock lock(_adaptiveMutex);
+
+	if (!_adaptiveTimer || _audioSuspended)
+		return;
+
+	const uint32 underruns = _underruns;
+	const bool underran = underruns != _checkedUnderruns;
+	_checkedUnderruns = underruns;
+
+	if (underran) {
+		// The smaller buffer did not last a stable period: wait longer
+		// before trying it again, so the size does not keep flipping
+		if (_shrunk)
+			_stablePeriod = MIN<uint>(_stablePeriod * 2, kAdaptiveMaxStableChecks);
+		_shrunk = false;
+		_stableChecks = 0;
+
+		if (_obtained.samples < _maxSamples)
+			resizeBuffer(_obtained.samples * 2);
+	} else if (++_stableChecks >= _stablePeriod) {
+		_shrunk = false;
+		_stableChecks = 0;
+
+		if (_obtained.samples > _minSamples) {
+			_shrunk = resizeBuffer(_obtained.samples / 2);
+		} else {
+			// The smallest buffer is sustained, forget the earlier failures
+			_stablePeriod = kAdaptiveStableChecks;
+		}
+	}
+}
+
+bool SdlMixerManager::resizeBuffer(uint16 samples) {
+	SDL_CloseAudio();
+	_lastCallbackMicros = 0;
+
+	// Needed as SDL_OpenAudio as of SDL-1.2.14 mutates fields in
+	// "desired" if used directly.
+	SDL_AudioSpec desired = _obtained;
+	desired.samples = samples;
+
+	bool resized = true;
+	if (SDL_OpenAudio(&desired, NULL) != 0) {
+		warning("Could not reopen audio device with %d samples: %s", samples, SDL_GetError());
+		resized = false;
+
+		if (SDL_OpenAudio(&_obtained, NULL) != 0) {
+			warning("Could not reopen audio device: %s", SDL_GetError());
+			_audioSuspended = true;
+			return false;
+		}
+	} else {
+		_obtained.samples = samples;
+	}
+
+	SDL_PauseAudio(0);
+	debug(1, "Output buffer size: %d samples", _obtained.samples);
+	return resized;
+}
+
 void SdlMixerManager::suspendAudio() {
+	Common::StackLock lock(_adaptiveMutex);
+
 	SDL_CloseAudio();
 	_audioSuspended = true;
+	_lastCallbackMicros = 0;
 }
 
 int SdlMixerManager::resumeAudio() {
+	Common::StackLock lock(_adaptiveMutex);
+
 	if (!_audioSuspended)
 		return -2;
 	if (SDL_OpenAudio(&_obtained, NULL) < 0) {
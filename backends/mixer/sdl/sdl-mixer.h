@@ -26,6 +26,8 @@
 #include "backends/platform/sdl/sdl-sys.h"
 #include "backends/mixer/mixer.h"
 
+#include "common/mutex.h"
+
 /**
  * SDL mixer manager. It wraps the actual implementation
  * of the Audio:Mixer used by the engine, and setups
@@ -34,6 +36,8 @@
  */
 class SdlMixerManager : public MixerManager {
 public:
+	SdlMixerManager() : _lastCallbackMicros(0), _adaptiveTimer(0), _underruns(0), _checkedUnderruns(0),
+		_minSamples(0), _maxSamples(0), _stableChecks(0), _stablePeriod(0), _shrunk(false) {}
 	virtual ~SdlMixerManager();
 
 	/**
@@ -60,11 +64,52 @@ protected:
 	 */
 	SDL_AudioSpec _obtained;
 
+	/**
+	 * The time of the last audio callback, to detect underruns.
+	 */
+	uint64 _lastCallbackMicros;
+
+	/**
+	 * The adaptive buffer size mode: the buffer starts small, is doubled
+	 * when the output underruns, and halved again after a stable period.
+	 * The checks run on an SDL timer, as the device can't be reopened from
+	 * the audio callback.
+	 */
+	SDL_TimerID _adaptiveTimer;
+	Common::Mutex _adaptiveMutex;
+	volatile uint32 _underruns;
+	uint32 _checkedUnderruns;
+	uint16 _minSamples, _maxSamples;
+	uint _stableChecks, _stablePeriod;
+	bool _shrunk;
+
 	/**
 	 * Returns the desired audio specification
 	 */
 	virtual SDL_AudioSpec getAudioSpec(uint32 rate);
 
+	/**
+	 * Returns whether the mixer can output the given SDL sample format
+	 */
+	bool isSupportedFormat(uint16 format) const;
+
+	/**
+	 * Returns the mixer output format for a supported SDL sample format
+	 */
+	Audio::MixerImpl::OutputFormat getOutputFormat(uint16 format) const;
+
+	/**
+	 * Grows or shrinks the buffer depending on the underruns since the last check
+	 */
+	void adaptBufferSize();
+
+	/**
+	 * Reopens the audio device with a different buffer size
+	 */
+	bool resizeBuffer(uint16 samples);
+
+	static Uint32 SDLCALL adaptiveTimerCallback(Uint32 interval, void *param);
+
 	/**
 	 * Starts SDL audio
 	 */
@@ -29,6 +29,7 @@
 #include "backends/mutex/mutex.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 #include "graphics/pixelbuffer.h"
@@ -157,6 +158,10 @@ void ModularGraphicsBackend::copyRectToScreen(const void *buf, int pitch, int x,
 	_graphicsManager->copyRectToScreen(buf, pitch, x, y, w, h);
 }
 
+void ModularGraphicsBackend::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	_graphicsManager->copyRectsToScreen(buf, pitch, rects, count);
+}
+
 Graphics::Surface *ModularGraphicsBackend::lockScreen() {
 	return _graphicsManager->lockScreen();
 }
@@ -169,8 +174,16 @@ void ModularGraphicsBackend::fillScreen(uint32 col) {
 	_graphicsManager->fillScreen(col);
 }
 
+void ModularGraphicsBackend::showYUVFrame(const Graphics::YUVFrame *frame, int x, int y) {
+	_graphicsManager->showYUVFrame(frame, x, y);
+}
+
 void ModularGraphicsBackend::updateScreen() {
+	PROFILE_SCOPE("system.updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
+	if (g_eventRec.processUpdateScreen())
+		return;
 	g_eventRec.preDrawOverlayGui();
 #endif
 
@@ -320,3 +333,43 @@ void ModularMutexBackend::deleteMutex(MutexRef mutex) {
 	assert(_mutexManager);
 	_mutexManager->deleteMutex(mutex);
 }
+
+uint ModularMutexBackend::getCPUCount() {
+	assert(_mutexManager);
+	return _mutexManager->getCPUCount();
+}
+
+OSystem::ThreadRef ModularMutexBackend::createThread(ThreadProc proc, void *refCon) {
+	assert(_mutexManager);
+	return _mutexManager->createThread(proc, refCon);
+}
+
+void ModularMutexBackend::joinThread(ThreadRef thread) {
+	assert(_mutexManager);
+	_mutexManager->joinThread(thread);
+}
+
+OSystem::ThreadId ModularMutexBackend::getCurrentThreadId() {
+	assert(_mutexManager);
+	return _mutexManager->getCurrentThreadId();
+}
+
+OSystem::SemaphoreRef ModularMutexBackend::createSemaphore(uint initialCount) {
+	assert(_mutexManager);
+	return _mutexManager->createSemaphore(initialCount);
+}
+
+void ModularMutexBackend::waitSemaphore(SemaphoreRef semaphore) {
+	assert(_mutexManager);
+	_mutexManager->waitSemaphore(semaphore);
+}
+
+void ModularMutexBackend::postSemaphore(SemaphoreRef semaphore) {
+	assert(_mutexManager);
+	_mutexManager->postSemaphore(semaphore);
+}
+
+void ModularMutexBackend::deleteSemaphore(SemaphoreRef semaphore) {
+	assert(_mutexManager);
+	_mutexManager->deleteSemaphore(semaphore);
+}
@@ -91,9 +91,11 @@ public:
 	virtual int16 getWidth() override final;
 	virtual PaletteManager *getPaletteManager() override final;
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override final;
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) override final;
 	virtual Graphics::Surface *lockScreen() override final;
 	virtual void unlockScreen() override final;
 	virtual void fillScreen(uint32 col) override final;
+	virtual void showYUVFrame(const Graphics::YUVFrame *frame, int x, int y) override final;
 	virtual void updateScreen() override final;
 	virtual void setShakePos(int shakeXOffset, int shakeYOffset) override final;
 	virtual void setFocusRectangle(const Common::Rect& rect) override final;
@@ -173,6 +175,20 @@ public:
 
 	//@}
 
+	/** @name Worker threads */
+	//@{
+
+	virtual uint getCPUCount() override final;
+	virtual ThreadRef createThread(ThreadProc proc, void *refCon) override final;
+	virtual void joinThread(ThreadRef thread) override final;
+	virtual ThreadId getCurrentThreadId() override final;
+	virtual SemaphoreRef createSemaphore(uint initialCount) override final;
+	virtual void waitSemaphore(SemaphoreRef semaphore) override final;
+	virtual void postSemaphore(SemaphoreRef semaphore) override final;
+	virtual void deleteSemaphore(SemaphoreRef semaphore) override final;
+
+	//@}
+
 protected:
 	/** @name Managers variables */
 	//@{
@@ -126,12 +126,14 @@ MODULE_OBJS += \
 	graphics/opengl/debug.o \
 	graphics/opengl/framebuffer.o \
 	graphics/opengl/opengl-graphics.o \
+	graphics/opengl/scaler.o \
 	graphics/opengl/shader.o \
 	graphics/opengl/texture.o \
 	graphics/opengl/pipelines/clut8.o \
 	graphics/opengl/pipelines/fixed.o \
 	graphics/opengl/pipelines/pipeline.o \
-	graphics/opengl/pipelines/shader.o
+	graphics/opengl/pipelines/shader.o \
+	graphics/opengl/pipelines/yuv.o
 endif
 
 # SDL specific source files.
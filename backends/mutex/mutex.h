@@ -38,6 +38,16 @@ public:
 	virtual void lockMutex(OSystem::MutexRef mutex) = 0;
 	virtual void unlockMutex(OSystem::MutexRef mutex) = 0;
 	virtual void deleteMutex(OSystem::MutexRef mutex) = 0;
+
+	// Worker threads are optional. By default, none are available.
+	virtual uint getCPUCount() { return 1; }
+	virtual OSystem::ThreadRef createThread(OSystem::ThreadProc proc, void *refCon) { return nullptr; }
+	virtual void joinThread(OSystem::ThreadRef thread) {}
+	virtual OSystem::ThreadId getCurrentThreadId() { return 0; }
+	virtual OSystem::SemaphoreRef createSemaphore(uint initialCount) { return nullptr; }
+	virtual void waitSemaphore(OSystem::SemaphoreRef semaphore) {}
+	virtual void postSemaphore(OSystem::SemaphoreRef semaphore) {}
+	virtual void deleteSemaphore(OSystem::SemaphoreRef semaphore) {}
 };
 
 #endif
@@ -21,6 +21,7 @@
  */
 
 #define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
 
 #include "common/scummsys.h"
 
@@ -29,6 +30,7 @@
 #include "backends/mutex/pthread/pthread-mutex.h"
 
 #include <pthread.h>
+#include <unistd.h>
 
 
 OSystem::MutexRef PthreadMutexManager::createMutex() {
@@ -67,4 +69,106 @@ void PthreadMutexManager::deleteMutex(OSystem::MutexRef mutex) {
 		delete m;
 }
 
+namespace {
+
+struct PthreadThread {
+	pthread_t thread;
+	OSystem::ThreadProc proc;
+	void *refCon;
+};
+
+void *pthreadThreadProc(void *data) {
+	PthreadThread *thread = (PthreadThread *)data;
+	thread->proc(thread->refCon);
+	return NULL;
+}
+
+// Unnamed POSIX semaphores are not available on iOS, so build them
+// from a mutex and a condition variable instead.
+struct PthreadSemaphore {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint count;
+};
+
+} // End of anonymous namespace
+
+uint PthreadMutexManager::getCPUCount() {
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (uint)count : 1;
+}
+
+OSystem::ThreadRef PthreadMutexManager::createThread(OSystem::ThreadProc proc, void *refCon) {
+	PthreadThread *thread = new PthreadThread;
+	thread->proc = proc;
+	thread->refCon = refCon;
+
+	if (pthread_create(&thread->thread, NULL, pthreadThreadProc, thread) != 0) {
+		warning("pthread_create() failed");
+		delete thread;
+		return NULL;
+	}
+
+	return (OSystem::ThreadRef)thread;
+}
+
+void PthreadMutexManager::joinThread(OSystem::ThreadRef thread) {
+	PthreadThread *t = (PthreadThread *)thread;
+
+	if (pthread_join(t->thread, NULL) != 0)
+		warning("pthread_join() failed");
+	delete t;
+}
+
+OSystem::ThreadId PthreadMutexManager::getCurrentThreadId() {
+	return (OSystem::ThreadId)pthread_self();
+}
+
+OSystem::SemaphoreRef PthreadMutexManager::createSemaphore(uint initialCount) {
+	PthreadSemaphore *semaphore = new PthreadSemaphore;
+	semaphore->count = initialCount;
+
+	if (pthread_mutex_init(&semaphore->mutex, NULL) != 0) {
+		warning("pthread_mutex_init() failed");
+		delete semaphore;
+		return NULL;
+	}
+
+	if (pthread_cond_init(&semaphore->cond, NULL) != 0) {
+		warning("pthread_cond_init() failed");
+		pthread_mutex_destroy(&semaphore->mutex);
+		delete semaphore;
+		return NULL;
+	}
+
+	return (OSystem::SemaphoreRef)semaphore;
+}
+
+void PthreadMutexManager::waitSemaphore(OSystem::SemaphoreRef semaphore) {
+	PthreadSemaphore *s = (PthreadSemaphore *)semaphore;
+
+	pthread_mutex_lock(&s->mutex);
+	while (s->count == 0)
+		pthread_cond_wait(&s->cond, &s->mutex);
+	s->count--;
+	pthread_mutex_unlock(&s->mutex);
+}
+
+void PthreadMutexManager::postSemaphore(OSystem::SemaphoreRef semaphore) {
+	PthreadSemaphore *s = (PthreadSemaphore *)semaphore;
+
+	pthread_mutex_lock(&s->mutex);
+	s->count++;
+	pthread_cond_signal(&s->cond);
+	pthread_mutex_unlock(&s->mutex);
+}
+
+void PthreadMutexManager::deleteSemaphore(OSystem::SemaphoreRef semaphore) {
+	PthreadSemaphore *s = (PthreadSemaphore *)semaphore;
+
+	pthread_cond_destroy(&s->cond);
+	pthread_mutex_destroy(&s->mutex);
+	delete s;
+}
+
 #endif
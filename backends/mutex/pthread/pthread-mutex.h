@@ -34,6 +34,15 @@ public:
 	virtual void lockMutex(OSystem::MutexRef mutex) override;
 	virtual void unlockMutex(OSystem::MutexRef mutex) override;
 	virtual void deleteMutex(OSystem::MutexRef mutex) override;
+
+	virtual uint getCPUCount() override;
+	virtual OSystem::ThreadRef createThread(OSystem::ThreadProc proc, void *refCon) override;
+	virtual void joinThread(OSystem::ThreadRef thread) override;
+	virtual OSystem::ThreadId getCurrentThreadId() override;
+	virtual OSystem::SemaphoreRef createSemaphore(uint initialCount) override;
+	virtual void waitSemaphore(OSystem::SemaphoreRef semaphore) override;
+	virtual void postSemaphore(OSystem::SemaphoreRef semaphore) override;
+	virtual void deleteSemaphore(OSystem::SemaphoreRef semaphore) override;
 };
 
 
@@ -26,6 +26,8 @@
 
 #include "backends/mutex/sdl/sdl-mutex.h"
 #include "backends/platform/sdl/sdl-sys.h"
+#include "common/textconsole.h"
+#include "common/util.h"
 
 
 OSystem::MutexRef SdlMutexManager::createMutex() {
@@ -44,4 +46,74 @@ void SdlMutexManager::deleteMutex(OSystem::MutexRef mutex) {
 	SDL_DestroyMutex((SDL_mutex *)mutex);
 }
 
+namespace {
+
+struct SdlThread {
+	SDL_Thread *thread;
+	OSystem::ThreadProc proc;
+	void *refCon;
+};
+
+int SDLCALL sdlThreadProc(void *data) {
+	SdlThread *thread = (SdlThread *)data;
+	thread->proc(thread->refCon);
+	return 0;
+}
+
+} // End of anonymous namespace
+
+uint SdlMutexManager::getCPUCount() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return MAX(SDL_GetCPUCount(), 1);
+#else
+	return 1;
+#endif
+}
+
+OSystem::ThreadRef SdlMutexManager::createThread(OSystem::ThreadProc proc, void *refCon) {
+	SdlThread *thread = new SdlThread();
+	thread->proc = proc;
+	thread->refCon = refCon;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	thread->thread = SDL_CreateThread(sdlThreadProc, "ScummVM worker", thread);
+#else
+	thread->thread = SDL_CreateThread(sdlThreadProc, thread);
+#endif
+
+	if (!thread->thread) {
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		delete thread;
+		return nullptr;
+	}
+
+	return (OSystem::ThreadRef)thread;
+}
+
+void SdlMutexManager::joinThread(OSystem::ThreadRef thread) {
+	SdlThread *t = (SdlThread *)thread;
+	SDL_WaitThread(t->thread, nullptr);
+	delete t;
+}
+
+OSystem::ThreadId SdlMutexManager::getCurrentThreadId() {
+	return (OSystem::ThreadId)SDL_ThreadID();
+}
+
+OSystem::SemaphoreRef SdlMutexManager::createSemaphore(uint initialCount) {
+	return (OSystem::SemaphoreRef) SDL_CreateSemaphore(initialCount);
+}
+
+void SdlMutexManager::waitSemaphore(OSystem::SemaphoreRef semaphore) {
+	SDL_SemWait((SDL_sem *)semaphore);
+}
+
+void SdlMutexManager::postSemaphore(OSystem::SemaphoreRef semaphore) {
+	SDL_SemPost((SDL_sem *)semaphore);
+}
+
+void SdlMutexManager::deleteSemaphore(OSystem::SemaphoreRef semaphore) {
+	SDL_DestroySemaphore((SDL_sem *)semaphore);
+}
+
 #endif
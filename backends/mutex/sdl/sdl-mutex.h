@@ -34,6 +34,15 @@ public:
 	virtual void lockMutex(OSystem::MutexRef mutex);
 	virtual void unlockMutex(OSystem::MutexRef mutex);
 	virtual void deleteMutex(OSystem::MutexRef mutex);
+
+	virtual uint getCPUCount();
+	virtual OSystem::ThreadRef createThread(OSystem::ThreadProc proc, void *refCon);
+	virtual void joinThread(OSystem::ThreadRef thread);
+	virtual OSystem::ThreadId getCurrentThreadId();
+	virtual OSystem::SemaphoreRef createSemaphore(uint initialCount);
+	virtual void waitSemaphore(OSystem::SemaphoreRef semaphore);
+	virtual void postSemaphore(OSystem::SemaphoreRef semaphore);
+	virtual void deleteSemaphore(OSystem::SemaphoreRef semaphore);
 };
 
 
@@ -25,6 +25,7 @@
 #include <curl/curl.h>
 #include "backends/networking/curl/connectionmanager.h"
 #include "backends/networking/curl/networkreadstream.h"
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/fs.h"
 #include "common/system.h"
@@ -38,9 +39,47 @@ DECLARE_SINGLETON(Networking::ConnectionManager);
 
 namespace Networking {
 
-ConnectionManager::ConnectionManager(): _multi(0), _timerStarted(false), _frame(0) {
+static void lockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *mutex) {
+	((Common::Mutex *)mutex)->lock();
+}
+
+static void unlockShare(CURL *handle, curl_lock_data data, void *mutex) {
+	((Common::Mutex *)mutex)->unlock();
+}
+
+ConnectionManager::ConnectionManager(): _multi(0), _share(0), _maxHostConnections(DEFAULT_MAX_HOST_CONNECTIONS), _timerStarted(false), _frame(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+
+	if (ConfMan.hasKey("max_host_connections")) {
+		int connections = ConfMan.getInt("max_host_connections");
+		_maxHostConnections = (connections > 0 ? connections : 1);
+	}
+
+#if LIBCURL_VERSION_NUM >= 0x071E00
+	// CURLMOPT_MAX_HOST_CONNECTIONS introduced in libcurl 7.30.0
+	curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)_maxHostConnections);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// CURLPIPE_MULTIPLEX introduced in libcurl 7.43.0
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+	// The multi handle only keeps the connections of the transfers it runs:
+	// share the DNS cache, the TLS sessions and the connections between all
+	// the easy handles, including the ones created after the cache emptied
+	_share = curl_share_init();
+	if (_share) {
+		curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockShare);
+		curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+		curl_share_setopt(_share, CURLSHOPT_USERDATA, &_shareMutex);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+		// CURL_LOCK_DATA_CONNECT introduced in libcurl 7.57.0
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+	}
 }
 
 ConnectionManager::~ConnectionManager() {
@@ -61,8 +100,11 @@ ConnectionManager::~ConnectionManager() {
 
 	//cleanup
 	curl_multi_cleanup(_multi);
+	if (_share)
+		curl_share_cleanup(_share);
 	curl_global_cleanup();
 	_multi = nullptr;
+	_share = nullptr;
 	_handleMutex.unlock();
 }
 
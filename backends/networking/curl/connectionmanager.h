@@ -31,6 +31,7 @@
 
 typedef void CURL;
 typedef void CURLM;
+typedef void CURLSH;
 struct curl_slist;
 
 namespace Networking {
@@ -43,6 +44,7 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	static const uint32 CLOUD_PERIOD = 1; //every frame
 	static const uint32 CURL_PERIOD = 1; //every frame
 	static const uint32 DEBUG_PRINT_PERIOD = FRAMES_PER_SECOND; // once per second
+	static const uint32 DEFAULT_MAX_HOST_CONNECTIONS = 4;
 
 	friend void connectionsThread(void *); //calls handle()
 
@@ -76,6 +78,9 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	};
 
 	CURLM *_multi;
+	CURLSH *_share;
+	Common::Mutex _shareMutex;
+	uint _maxHostConnections;
 	bool _timerStarted;
 	Common::Array<RequestWithCallback> _requests, _addedRequests;
 	Common::Mutex _handleMutex, _addedRequestsMutex;
@@ -99,6 +104,22 @@ public:
 	 */
 	void registerEasyHandle(CURL *easy) const;
 
+	/**
+	 * Return the share handle the easy handles should use, so they reuse
+	 * the DNS cache, the TLS sessions and the open connections of the
+	 * earlier transfers instead of doing the handshakes again.
+	 */
+	CURLSH *getShareHandle() const { return _share; }
+
+	/**
+	 * Return how many transfers may run at once against the same host.
+	 * Requests downloading many files use it as the number of files to
+	 * download in parallel.
+	 *
+	 * It is read from the "max_host_connections" setting.
+	 */
+	uint getMaxHostConnections() const { return _maxHostConnections; }
+
 	/**
 	 * Use this method to add new Request into manager's queue.
 	 * Manager will periodically call handle() method of these
@@ -101,6 +101,19 @@ void NetworkReadStream::initCurl(const char *url, curl_slist *headersList) {
 		curl_easy_setopt(_easy, CURLOPT_CAINFO, caCertPath);
 	}
 
+	if (ConnMan.getShareHandle())
+		curl_easy_setopt(_easy, CURLOPT_SHARE, ConnMan.getShareHandle());
+
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// CURLOPT_PIPEWAIT introduced in libcurl 7.43.0
+	// Rather wait for a connection to multiplex on than open a new one
+	curl_easy_setopt(_easy, CURLOPT_PIPEWAIT, 1L);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072F00
+	// CURL_HTTP_VERSION_2TLS introduced in libcurl 7.47.0
+	curl_easy_setopt(_easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+
 #if LIBCURL_VERSION_NUM >= 0x072000
 	// CURLOPT_XFERINFOFUNCTION introduced in libcurl 7.32.0
 	// CURLOPT_PROGRESSFUNCTION is used as a backup plan in case older version is used
@@ -49,17 +49,19 @@ typedef void (*sighandler_t)(int);
 
 #if defined(USE_NULL_DRIVER)
 #include "backends/modular-backend.h"
+#include "backends/mutex/null/null-mutex.h"
 #include "base/main.h"
 
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
-#include "backends/mixer/null/null-mixer.h"
-#include "backends/mutex/null/null-mutex.h"
-#include "backends/graphics/null/null-graphics.h"
+#include "common/config-manager.h"
 #include "gui/debugger.h"
+#include "gui/EventRecorder.h"
 #endif
+#include "backends/graphics/null/null-graphics.h"
+#include "backends/mixer/null/null-mixer.h"
 
 /*
  * Include header files needed for the getFilesystemFactory() method.
@@ -91,19 +93,54 @@ public:
 
 	virtual void quit();
 
+#if defined(ENABLE_EVENTRECORDER) && !defined(NULL_DRIVER_USE_FOR_TEST)
+	virtual MixerManager *getMixerManager();
+	virtual Common::TimerManager *getTimerManager();
+	virtual Common::SaveFileManager *getSavefileManager();
+#endif
+
 	virtual void logMessage(LogMessageType::Type type, const char *message);
 
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority);
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	/**
+	 * Set up the mixer for the code under test. This needs g_system to be
+	 * set, since the mixer uses mutexes.
+	 */
+	void initMixerForTest() {
+		_mixerManager = new NullMixerManager();
+		_mixerManager->init();
+	}
+
+	/**
+	 * Set up a graphics manager which discards everything, for the code
+	 * under test which looks at the screen format.
+	 */
+	void initGraphicsForTest() {
+		_graphicsManager = new NullGraphicsManager();
+	}
+#endif
+
 private:
+	/** Return the time since initBackend(), including the skipped delays */
+	uint32 getElapsedMillis() const;
+
 #ifdef POSIX
 	timeval _startTime;
 #elif defined(WIN32)
 	DWORD _startTime;
 #endif
+
+	/**
+	 * With the virtual clock, the delays are not waited for but added to
+	 * the time, so the engines run as fast as they can.
+	 */
+	bool _virtualClock;
+	uint32 _skippedMillis;
 };
 
-OSystem_NULL::OSystem_NULL() {
+OSystem_NULL::OSystem_NULL() : _virtualClock(false), _skippedMillis(0) {
 	#if defined(__amigaos4__)
 		_fsFactory = new AmigaOSFilesystemFactory();
 	#elif defined(__MORPHOS__)	
@@ -117,6 +154,11 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	// Tests never call initBackend(), but the code under test may use mutexes
+	_mutexManager = new NullMutexManager();
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -145,14 +187,23 @@ void OSystem_NULL::initBackend() {
 	last_handler = signal(SIGINT, intHandler);
 #endif
 
+	_virtualClock = ConfMan.getBool("virtual_clock");
+
 	_mutexManager = new NullMutexManager();
-	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
 	_savefileManager = new DefaultSaveFileManager();
 	_graphicsManager = new NullGraphicsManager();
 	_mixerManager = new NullMixerManager();
 	// Setup and start mixer
 	_mixerManager->init();
+
+#ifdef ENABLE_EVENTRECORDER
+	g_eventRec.registerMixerManager(_mixerManager);
+
+	g_eventRec.registerTimerManager(new DefaultTimerManager());
+#else
+	_timerManager = new DefaultTimerManager();
+#endif
 #endif
 
 	BaseBackend::initBackend();
@@ -161,7 +212,8 @@ void OSystem_NULL::initBackend() {
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 #ifndef NULL_DRIVER_USE_FOR_TEST
 	((DefaultTimerManager *)getTimerManager())->checkTimers();
-	((NullMixerManager *)_mixerManager)->update(1);
+	// Keep the audio going with the clock, even when it runs faster than real time
+	((NullMixerManager *)_mixerManager)->updateUntil(getElapsedMillis());
 
 #ifdef POSIX
 	if (intReceived) {
@@ -185,22 +237,42 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 	return false;
 }
 
-uint32 OSystem_NULL::getMillis(bool skipRecord) {
+uint32 OSystem_NULL::getElapsedMillis() const {
 #ifdef POSIX
 	timeval curTime;
 
 	gettimeofday(&curTime, 0);
 
 	return (uint32)(((curTime.tv_sec - _startTime.tv_sec) * 1000) +
-			((curTime.tv_usec - _startTime.tv_usec) / 1000));
+			((curTime.tv_usec - _startTime.tv_usec) / 1000)) + _skippedMillis;
 #elif defined(WIN32)
-	return GetTickCount() - _startTime;
+	return GetTickCount() - _startTime + _skippedMillis;
 #else
-	return 0;
+	return _skippedMillis;
 #endif
 }
 
+uint32 OSystem_NULL::getMillis(bool skipRecord) {
+	uint32 millis = getElapsedMillis();
+
+#if defined(ENABLE_EVENTRECORDER) && !defined(NULL_DRIVER_USE_FOR_TEST)
+	g_eventRec.processMillis(millis, skipRecord);
+#endif
+
+	return millis;
+}
+
 void OSystem_NULL::delayMillis(uint msecs) {
+#if defined(ENABLE_EVENTRECORDER) && !defined(NULL_DRIVER_USE_FOR_TEST)
+	if (g_eventRec.processDelayMillis())
+		return;
+#endif
+
+	if (_virtualClock) {
+		_skippedMillis += msecs;
+		return;
+	}
+
 #ifdef POSIX
 	usleep(msecs * 1000);
 #elif defined(WIN32)
@@ -224,6 +296,20 @@ void OSystem_NULL::quit() {
 	exit(0);
 }
 
+#if defined(ENABLE_EVENTRECORDER) && !defined(NULL_DRIVER_USE_FOR_TEST)
+MixerManager *OSystem_NULL::getMixerManager() {
+	return g_eventRec.getMixerManager();
+}
+
+Common::TimerManager *OSystem_NULL::getTimerManager() {
+	return g_eventRec.getTimerManager();
+}
+
+Common::SaveFileManager *OSystem_NULL::getSavefileManager() {
+	return g_eventRec.getSaveManager(_savefileManager);
+}
+#endif
+
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
 	FILE *output = 0;
 
@@ -31,14 +31,14 @@
 bool ARMDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment) {
 	Elf32_Rel *rel = 0; //relocation entry
 
-	// Allocate memory for relocation table
-	if (!(rel = (Elf32_Rel *)malloc(size))) {
+	// Allocate memory for a chunk of the relocation table
+	if (!(rel = (Elf32_Rel *)malloc(kRelocationChunkEntries * sizeof(*rel)))) {
 		warning("elfloader: Out of memory.");
 		return false;
 	}
 
-	// Read in our relocation table
-	if (!_file->seek(offset, SEEK_SET) || _file->read(rel, size) != size) {
+	// The relocation table is read in chunks while we go
+	if (!_file->seek(offset, SEEK_SET)) {
 		warning("elfloader: Relocation table load failed.");
 		free(rel);
 		return false;
@@ -47,23 +47,31 @@ bool ARMDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 	// Treat each relocation entry. Loop over all of them
 	uint32 cnt = size / sizeof(*rel);
 
-	debug(2, "elfloader: Loaded relocation table. %d entries. base address=%p", cnt, relSegment);
+	debug(2, "elfloader: Relocating %d entries. base address=%p", cnt, relSegment);
 
 	int32 a = 0;
 	uint32 relocation = 0;
 
 	// Loop over relocation entries
 	for (uint32 i = 0; i < cnt; i++) {
+		// Read the next chunk of the relocation table
+		if (i % kRelocationChunkEntries == 0 && !readRelocationChunk(rel, sizeof(*rel), cnt - i)) {
+			free(rel);
+			return false;
+		}
+
+		Elf32_Rel *cur = &rel[i % kRelocationChunkEntries];
+
 		// Get the symbol this relocation entry is referring to
-		Elf32_Sym *sym = _symtab + (REL_INDEX(rel[i].r_info));
+		Elf32_Sym *sym = _symtab + (REL_INDEX(cur->r_info));
 
 		// Get the target instruction in the code.
-		uint32 *target = (uint32 *)((byte *)relSegment + rel[i].r_offset - _segmentVMA);
+		uint32 *target = (uint32 *)((byte *)relSegment + cur->r_offset - _segmentVMA);
 
 //		uint32 origTarget = *target;	//Save for debugging
 
 		// Act differently based on the type of relocation
-		switch (REL_TYPE(rel[i].r_info)) {
+		switch (REL_TYPE(cur->r_info)) {
 		case R_ARM_ABS32:
 		case R_ARM_TARGET1:
 			if (sym->st_shndx < SHN_LOPROC) {			// Only shift for plugin section.
@@ -89,7 +97,7 @@ bool ARMDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 			break;
 
 		default:
-			warning("elfloader: Unknown relocation type %d.", REL_TYPE(rel[i].r_info));
+			warning("elfloader: Unknown relocation type %d.", REL_TYPE(cur->r_info));
 			free(rel);
 			return false;
 		}
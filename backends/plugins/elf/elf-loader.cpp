@@ -323,6 +323,19 @@ void DLObject::relocateSymbols(ptrdiff_t offset) {
 	}
 }
 
+uint32 DLObject::readRelocationChunk(void *chunk, uint32 entrySize, uint32 remaining) {
+	assert(_file);
+
+	uint32 cnt = MIN<uint32>(remaining, kRelocationChunkEntries);
+
+	if (_file->read(chunk, cnt * entrySize) != cnt * entrySize) {
+		warning("elfloader: Relocation table load failed.");
+		return 0;
+	}
+
+	return cnt;
+}
+
 // Track the size of the plugin through memory manager without loading
 // the plugin into memory.
 //
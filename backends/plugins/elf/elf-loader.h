@@ -70,6 +70,22 @@ protected:
 	virtual void relocateSymbols(ptrdiff_t offset);
 	void discardSegment();
 
+	enum {
+		kRelocationChunkEntries = 128	///< Number of relocation entries read at a time
+	};
+
+	/**
+	 * Read the next entries of a relocation section into a chunk buffer
+	 * of kRelocationChunkEntries entries, so that the relocation tables never
+	 * need to be held in memory as a whole.
+	 *
+	 * @param chunk			Buffer receiving the entries
+	 * @param entrySize		Size of one relocation entry
+	 * @param remaining		Number of entries of the section not read yet
+	 * @return				Number of entries read, 0 on failure
+	 */
+	uint32 readRelocationChunk(void *chunk, uint32 entrySize, uint32 remaining);
+
 	// architecture specific
 
 	/**
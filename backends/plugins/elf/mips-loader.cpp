@@ -27,6 +27,7 @@
 #include "backends/plugins/elf/mips-loader.h"
 #include "backends/plugins/elf/memory-manager.h"
 
+#include "common/array.h"
 #include "common/debug.h"
 
 #define DEBUG_NUM 2
@@ -34,14 +35,14 @@
 bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment) {
 	Elf32_Rel *rel = 0;	// relocation entry
 
-	// Allocate memory for relocation table
-	if (!(rel = (Elf32_Rel *)malloc(size))) {
+	// Allocate memory for a chunk of the relocation table
+	if (!(rel = (Elf32_Rel *)malloc(kRelocationChunkEntries * sizeof(*rel)))) {
 		warning("elfloader: Out of memory.");
 		return false;
 	}
 
-	// Read in our relocation table
-	if (!_file->seek(offset, SEEK_SET) || _file->read(rel, size) != size) {
+	// The relocation table is read in chunks while we go
+	if (!_file->seek(offset, SEEK_SET)) {
 		warning("elfloader: Relocation table load failed.");
 		free(rel);
 		return false;
@@ -50,7 +51,7 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 	// Treat each relocation entry. Loop over all of them
 	uint32 cnt = size / sizeof(*rel);
 
-	debug(2, "elfloader: Loaded relocation table. %d entries. base address=%p", cnt, relSegment);
+	debug(2, "elfloader: Relocating %d entries. base address=%p", cnt, relSegment);
 
 	Elf32_Addr adjustedMainSegment = Elf32_Addr(_segment) - _segmentVMA;	// adjust for VMA offset
 
@@ -66,22 +67,36 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 	Elf32_Addr lastHiSymVal = 0;
 	bool hi16InShorts = false;
 
+	// The HI16s of a block are treated when their LO16 arrives, possibly in a
+	// later chunk of the relocation table: keep their offsets until then
+	Common::Array<Elf32_Addr> pendingHi16;
+
 	// Loop over relocation entries
 	for (uint32 i = 0; i < cnt; i++) {
+		// Read the next chunk of the relocation table
+		if (i % kRelocationChunkEntries == 0 && !readRelocationChunk(rel, sizeof(*rel), cnt - i)) {
+			free(rel);
+			return false;
+		}
+
+		Elf32_Rel *cur = &rel[i % kRelocationChunkEntries];
+
 		// Get the symbol this relocation entry is referring to
-		Elf32_Sym *sym = _symtab + (REL_INDEX(rel[i].r_info));
+		Elf32_Sym *sym = _symtab + (REL_INDEX(cur->r_info));
 
 		// Get the target instruction in the code.
-		uint32 *target = (uint32 *)((byte *)relSegment + rel[i].r_offset);
+		uint32 *target = (uint32 *)((byte *)relSegment + cur->r_offset);
 
 		uint32 origTarget = *target;	// Save for debugging
 
 		// Act differently based on the type of relocation
-		switch (REL_TYPE(rel[i].r_info)) {
+		switch (REL_TYPE(cur->r_info)) {
 		case R_MIPS_HI16:							// Absolute addressing.
-			if (sym->st_shndx < SHN_LOPROC &&		// Only shift for plugin section (ie. has a real section index)
-				firstHi16 < 0) {					// Only process first in block of HI16s
+			if (firstHi16 >= 0) {					// Later ones in the block are treated with the first one
+				pendingHi16.push_back(cur->r_offset);
+			} else if (sym->st_shndx < SHN_LOPROC) {	// Only shift for plugin section (ie. has a real section index)
 				firstHi16 = i;						// Keep the first Hi16 we saw
+				pendingHi16.push_back(cur->r_offset);
 				seenHi16 = true;
 				ahl = (*target & 0xffff) << 16;		// Take lower 16 bits shifted up
 
@@ -89,7 +104,7 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 				hi16InShorts = ShortsMan.inGeneralSegment((char *)sym->st_value); // Fix for problem with switching btw segments
 				if (debugRelocs[0]++ < DEBUG_NUM)	// Print only a set number
 					debug(8, "elfloader: R_MIPS_HI16: i=%d, offset=%x, ahl = %x, target = %x",
-							i, rel[i].r_offset, ahl, *target);
+							i, cur->r_offset, ahl, *target);
 			}
 			break;
 
@@ -124,17 +139,15 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 					relocation = ahl + adjustedMainSegment;				// Add in the new offset for the segment
 
 				if (firstHi16 >= 0) {					// We haven't treated the HI16s yet so do it now
-					for (uint32 j = firstHi16; j < i; j++) {
-						if (REL_TYPE(rel[j].r_info) != R_MIPS_HI16)
-							continue;	// Skip over non-Hi16s
-
-						lastTarget = (uint32 *)((char *)relSegment + rel[j].r_offset);	// get hi16 target
+					for (uint32 j = 0; j < pendingHi16.size(); j++) {
+						lastTarget = (uint32 *)((char *)relSegment + pendingHi16[j]);	// get hi16 target
 						*lastTarget &= 0xffff0000;		// Clear the lower 16 bits of the last target
 						*lastTarget |= (relocation >> 16) & 0xffff;	// Take the upper 16 bits of the relocation
 						if (relocation & 0x8000)
 							(*lastTarget)++;	// Subtle: we need to add 1 to the HI16 in this case
 					}
 
+					pendingHi16.clear();
 					firstHi16 = -1;						// Reset so we'll know we treated it
 				} else {
 					extendedHi16++;
@@ -146,12 +159,12 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 				if (debugRelocs[1]++ < DEBUG_NUM)
 					debug(8, "elfloader: R_MIPS_LO16: i=%d, offset=%x, a=%x, ahl = %x, "
 							"lastTarget = %x, origt = %x, target = %x",
-							i, rel[i].r_offset, a, ahl, *lastTarget, origTarget, *target);
+							i, cur->r_offset, a, ahl, *lastTarget, origTarget, *target);
 
 				if (lo16InShorts && debugRelocs[2]++ < DEBUG_NUM)
 					debug(8, "elfloader: R_MIPS_LO16s: i=%d, offset=%x, a=%x, ahl = %x, "
 							"lastTarget = %x, origt = %x, target = %x",
-							i, rel[i].r_offset, a, ahl, *lastTarget, origTarget, *target);
+							i, cur->r_offset, a, ahl, *lastTarget, origTarget, *target);
 			}
 			break;
 
@@ -166,12 +179,12 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 				if (debugRelocs[3]++ < DEBUG_NUM)
 					debug(8, "elfloader: R_MIPS_26: i=%d, offset=%x, symbol=%d, stinfo=%x, "
 							"a=%x, origTarget=%x, target=%x",
-							i, rel[i].r_offset, REL_INDEX(rel[i].r_info), sym->st_info, a, origTarget, *target);
+							i, cur->r_offset, REL_INDEX(cur->r_info), sym->st_info, a, origTarget, *target);
 			} else {
 				if (debugRelocs[4]++ < DEBUG_NUM)
 					debug(8, "elfloader: R_MIPS_26: i=%d, offset=%x, symbol=%d, stinfo=%x, "
 							"a=%x, origTarget=%x, target=%x",
-							i, rel[i].r_offset, REL_INDEX(rel[i].r_info), sym->st_info, a, origTarget, *target);
+							i, cur->r_offset, REL_INDEX(cur->r_info), sym->st_info, a, origTarget, *target);
 			}
 			break;
 
@@ -213,7 +226,7 @@ bool MIPSDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 			break;
 
 		default:
-			warning("elfloader: Unknown relocation type %x at relocation %d.", REL_TYPE(rel[i].r_info), i);
+			warning("elfloader: Unknown relocation type %x at relocation %d.", REL_TYPE(cur->r_info), i);
 			free(rel);
 			return false;
 		}
@@ -32,12 +32,14 @@
 bool PPCDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment) {
 	Elf32_Rela *rel = NULL;
 
-	if (!(rel = (Elf32_Rela *)malloc(size))) {
+	// Allocate memory for a chunk of the relocation table
+	if (!(rel = (Elf32_Rela *)malloc(kRelocationChunkEntries * sizeof(*rel)))) {
 		warning("elfloader: Out of memory.");
 		return false;
 	}
 
-	if (!_file->seek(offset, SEEK_SET) || _file->read(rel, size) != size) {
+	// The relocation table is read in chunks while we go
+	if (!_file->seek(offset, SEEK_SET)) {
 		warning("elfloader: Relocation table load failed.");
 		free(rel);
 		return false;
@@ -45,22 +47,30 @@ bool PPCDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 
 	uint32 cnt = size / sizeof(*rel);
 
-	debug(2, "elfloader: Loaded relocation table. %d entries. base address=%p", cnt, relSegment);
+	debug(2, "elfloader: Relocating %d entries. base address=%p", cnt, relSegment);
 
 	uint32 *src;
 	uint32 value;
 
 	for (uint32 i = 0; i < cnt; i++) {
+		// Read the next chunk of the relocation table
+		if (i % kRelocationChunkEntries == 0 && !readRelocationChunk(rel, sizeof(*rel), cnt - i)) {
+			free(rel);
+			return false;
+		}
+
+		Elf32_Rela *cur = &rel[i % kRelocationChunkEntries];
+
 		// Get the symbol this relocation entry is referring to
-		Elf32_Sym *sym = _symtab + (REL_INDEX(rel[i].r_info));
+		Elf32_Sym *sym = _symtab + (REL_INDEX(cur->r_info));
 
 		// Get the target instruction in the code
-		src = (uint32 *)((char *)relSegment + rel[i].r_offset - _segmentVMA);
-		value = sym->st_value + rel[i].r_addend;
+		src = (uint32 *)((char *)relSegment + cur->r_offset - _segmentVMA);
+		value = sym->st_value + cur->r_addend;
 
-		//debug(8, "elfloader: i=%05d %p +0x%04x: (0x%08x) 0x%08x ", i, src, rel[i].r_addend, sym->st_value, *src);
+		//debug(8, "elfloader: i=%05d %p +0x%04x: (0x%08x) 0x%08x ", i, src, cur->r_addend, sym->st_value, *src);
 
-		switch (REL_TYPE(rel[i].r_info)) {
+		switch (REL_TYPE(cur->r_info)) {
 		case R_PPC_NONE:
 			debug(8, "elfloader: R_PPC_NONE");
 			break;
@@ -89,7 +99,7 @@ bool PPCDLObject::relocate(Elf32_Off offset, Elf32_Word size, byte *relSegment)
 			debug(8, "elfloader: R_PPC_REL32 -> 0x%08x", *src);
 			break;
 		default:
-			warning("elfloader: Unknown relocation type %d", REL_TYPE(rel[i].r_info));
+			warning("elfloader: Unknown relocation type %d", REL_TYPE(cur->r_info));
 			free(rel);
 			return false;
 		}
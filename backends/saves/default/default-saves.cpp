@@ -42,18 +42,26 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/md5.h"
 #include "common/zlib.h"
 
 #include <errno.h>	// for removeSavefile()
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
+const char *DefaultSaveFileManager::HASHES_FILENAME = ".synchashes";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+const char *DefaultSaveFileManager::INDEX_FILENAME = ".saveindex";
+
+enum {
+	kIndexVersion = 1
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _indexDirty(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _indexDirty(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
@@ -98,6 +106,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	waitForBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -114,6 +124,8 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	waitForBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -136,6 +148,16 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	return createSaveFile(filename, compress, false);
+}
+
+Common::OutSaveFile *DefaultSaveFileManager::openForSavingAtomically(const Common::String &filename, bool compress) {
+	return createSaveFile(filename, compress, true);
+}
+
+Common::OutSaveFile *DefaultSaveFileManager::createSaveFile(const Common::String &filename, bool compress, bool atomic) {
+	waitForBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::String savePathName = getSavePath();
 	assureCached(savePathName);
@@ -167,8 +189,11 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
+	removeIndexEntry(filename);
+	saveFileChanged(filename);
+
 	// Open the file for saving.
-	Common::WriteStream *const sf = fileNode.createWriteStream();
+	Common::WriteStream *const sf = atomic ? fileNode.createAtomicWriteStream() : fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
 	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
@@ -180,6 +205,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	waitForBackgroundSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -200,6 +227,9 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	if (file == _saveFileCache.end()) {
 		return false;
 	} else {
+		removeIndexEntry(filename);
+		saveFileChanged(filename);
+
 		const Common::FSNode fileNode = file->_value;
 		// Remove from cache, this invalidates the 'file' iterator.
 		_saveFileCache.erase(file);
@@ -222,6 +252,154 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	}
 }
 
+int32 DefaultSaveFileManager::getRawSize(const Common::String &filename) {
+	waitForBackgroundSave(filename);
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return -1;
+
+	Common::SeekableReadStream *sf = file->_value.createReadStream();
+	if (!sf)
+		return -1;
+	const int32 size = sf->size();
+	delete sf;
+	return size;
+}
+
+bool DefaultSaveFileManager::readIndexEntry(const Common::String &filename, Common::Array<byte> &data) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	assureIndexLoaded();
+	SaveIndex::iterator entry = _index.find(filename);
+	if (entry == _index.end())
+		return false;
+
+	// The stamp catches the save files written since, including the ones
+	// downloaded by the cloud sync. The size catches the ones changed by hand
+	// before, and is only checked once.
+	if (entry->_value.stamp != getSaveFileStamp(filename) ||
+	    (!entry->_value.checked && getRawSize(filename) != (int32)entry->_value.size)) {
+		_index.erase(entry);
+		_indexDirty = true;
+		return false;
+	}
+	entry->_value.checked = true;
+
+	data = entry->_value.data;
+	return true;
+}
+
+void DefaultSaveFileManager::writeIndexEntry(const Common::String &filename, const Common::Array<byte> &data) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return;
+
+	const int32 size = getRawSize(filename);
+	if (size < 0)
+		return;
+
+	assureIndexLoaded();
+	IndexEntry &entry = _index[filename];
+	entry.size = size;
+	entry.stamp = getSaveFileStamp(filename);
+	entry.checked = true;
+	entry.data = data;
+	_indexDirty = true;
+}
+
+void DefaultSaveFileManager::removeIndexEntry(const Common::String &filename) {
+	assureIndexLoaded();
+	SaveIndex::iterator entry = _index.find(filename);
+	if (entry == _index.end())
+		return;
+
+	_index.erase(entry);
+	_indexDirty = true;
+	flushIndex();
+}
+
+void DefaultSaveFileManager::flushIndex() {
+	if (_indexDirectory.empty())
+		return;
+
+	// Leave out the entries of the saves written since they were made
+	for (SaveIndex::iterator i = _index.begin(); i != _index.end(); ++i) {
+		if (i->_value.stamp != getSaveFileStamp(i->_key)) {
+			_index.erase(i);
+			_indexDirty = true;
+		}
+	}
+
+	if (!_indexDirty)
+		return;
+	_indexDirty = false;
+
+	const Common::FSNode savePath(_indexDirectory);
+	Common::WriteStream *out = savePath.getChild(INDEX_FILENAME).createWriteStream();
+	if (!out) {
+		warning("DefaultSaveFileManager: failed to write the index of the saves in '%s'", _indexDirectory.c_str());
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('S', 'V', 'I', 'X'));
+	out->writeByte(kIndexVersion);
+	out->writeUint32LE(_index.size());
+	for (SaveIndex::const_iterator i = _index.begin(); i != _index.end(); ++i) {
+		out->writeUint16LE(i->_key.size());
+		out->writeString(i->_key);
+		out->writeUint32LE(i->_value.size);
+		out->writeUint16LE(i->_value.data.size());
+		out->write(i->_value.data.begin(), i->_value.data.size());
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("DefaultSaveFileManager: failed to write the index of the saves in '%s'", _indexDirectory.c_str());
+	delete out;
+}
+
+void DefaultSaveFileManager::assureIndexLoaded() {
+	const Common::String savePathName = getSavePath();
+	if (_indexDirectory == savePathName)
+		return;
+
+	flushIndex();
+	_index.clear();
+	_indexDirectory = savePathName;
+
+	const Common::FSNode indexNode = Common::FSNode(savePathName).getChild(INDEX_FILENAME);
+	if (!indexNode.exists())
+		return;
+
+	Common::SeekableReadStream *in = indexNode.createReadStream();
+	if (!in)
+		return;
+
+	if (in->readUint32BE() == MKTAG('S', 'V', 'I', 'X') && in->readByte() == kIndexVersion) {
+		const uint32 count = in->readUint32LE();
+		for (uint32 i = 0; i < count && !in->eos() && !in->err(); ++i) {
+			const uint16 nameSize = in->readUint16LE();
+			Common::String name;
+			for (uint16 j = 0; j < nameSize; ++j)
+				name += (char)in->readByte();
+			IndexEntry entry;
+			entry.size = in->readUint32LE();
+			entry.stamp = getSaveFileStamp(name);
+			entry.data.resize(in->readUint16LE());
+			if (in->read(entry.data.begin(), entry.data.size()) != entry.data.size())
+				break;
+			_index[name] = entry;
+		}
+	}
+
+	delete in;
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
@@ -369,6 +547,67 @@ void DefaultSaveFileManager::saveTimestamps(Common::HashMap<Common::String, uint
 	f.close();
 }
 
+Common::HashMap<Common::String, DefaultSaveFileManager::SyncedHash> DefaultSaveFileManager::loadHashes() {
+	Common::HashMap<Common::String, SyncedHash> hashes;
+	Common::InSaveFile *file = g_system->getSavefileManager()->openRawFile(HASHES_FILENAME);
+	if (!file)
+		return hashes;
+
+	//each line is "<md5> <timestamp> <filename>", and the filename may contain spaces
+	while (!file->eos() && !file->err()) {
+		Common::String line = file->readLine();
+		const char *md5End = strchr(line.c_str(), ' ');
+		if (!md5End)
+			continue;
+		const char *timestampEnd = strchr(md5End + 1, ' ');
+		if (!timestampEnd || timestampEnd[1] == '\0')
+			continue;
+
+		Common::String md5(line.c_str(), md5End);
+		uint32 timestamp = Common::String(md5End + 1, timestampEnd).asUint64();
+		if (md5.size() != 32 || timestamp == 0)
+			continue;
+		hashes[timestampEnd + 1] = SyncedHash(timestamp, md5);
+	}
+
+	delete file;
+	return hashes;
+}
+
+void DefaultSaveFileManager::saveHashes(Common::HashMap<Common::String, SyncedHash> &hashes) {
+	Common::DumpFile f;
+	Common::String filename = concatWithSavesPath(HASHES_FILENAME);
+	if (!f.open(filename, true)) {
+		warning("DefaultSaveFileManager: failed to open '%s' file to save hashes", filename.c_str());
+		return;
+	}
+
+	for (Common::HashMap<Common::String, SyncedHash>::iterator i = hashes.begin(); i != hashes.end(); ++i) {
+		if (i->_value.md5.empty() || i->_value.timestamp == 0 || i->_value.timestamp == INVALID_TIMESTAMP)
+			continue;
+
+		Common::String data = Common::String::format("%s %u ", i->_value.md5.c_str(), i->_value.timestamp) + i->_key + "\n";
+		if (f.write(data.c_str(), data.size()) != data.size()) {
+			warning("DefaultSaveFileManager: failed to write hashes data into '%s'", filename.c_str());
+			return;
+		}
+	}
+
+	f.flush();
+	f.finalize();
+	f.close();
+}
+
+Common::String DefaultSaveFileManager::computeHash(const Common::String &filename) {
+	Common::InSaveFile *file = g_system->getSavefileManager()->openRawFile(filename);
+	if (!file)
+		return "";
+
+	Common::String md5 = Common::computeStreamMD5AsString(*file);
+	delete file;
+	return md5;
+}
+
 #endif // ifdef USE_LIBCURL
 
 Common::String DefaultSaveFileManager::concatWithSavesPath(Common::String name) {
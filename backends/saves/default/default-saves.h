@@ -45,6 +45,12 @@ public:
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
 
+	virtual bool readIndexEntry(const Common::String &filename, Common::Array<byte> &data);
+	virtual void writeIndexEntry(const Common::String &filename, const Common::Array<byte> &data);
+	virtual void flushIndex();
+
+	static const char *INDEX_FILENAME;
+
 #ifdef USE_LIBCURL
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
@@ -52,11 +58,38 @@ public:
 
 	static Common::HashMap<Common::String, uint32> loadTimestamps();
 	static void saveTimestamps(Common::HashMap<Common::String, uint32> &timestamps);
+
+	/**
+	 * The contents of a savefile when it was last synced: their MD5, and
+	 * the timestamp they had in the cloud.
+	 *
+	 * Saving a file invalidates its timestamp, so a save rewritten with the
+	 * same contents can get its synced timestamp back instead of being
+	 * uploaded again.
+	 */
+	struct SyncedHash {
+		uint32 timestamp;
+		Common::String md5;
+
+		SyncedHash(): timestamp(INVALID_TIMESTAMP) {}
+		SyncedHash(uint32 t, const Common::String &m): timestamp(t), md5(m) {}
+	};
+
+	static const char *HASHES_FILENAME;
+
+	static Common::HashMap<Common::String, SyncedHash> loadHashes();
+	static void saveHashes(Common::HashMap<Common::String, SyncedHash> &hashes);
+
+	/** Return the MD5 of the savefile contents, or an empty string if it can't be read. */
+	static Common::String computeHash(const Common::String &filename);
 #endif
 
 	static Common::String concatWithSavesPath(Common::String name);
 
 protected:
+	virtual bool canSaveInBackground() const { return true; }
+	virtual Common::OutSaveFile *openForSavingAtomically(const Common::String &filename, bool compress);
+
 	/**
 	 * Get the path to the savegame directory.
 	 * Should only be used internally since some platforms
@@ -94,11 +127,59 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	struct IndexEntry {
+		uint32 size;  ///< Size of the raw save file the data is for
+		uint32 stamp; ///< Save file stamp the entry is up to date with, not stored
+		bool checked; ///< Whether the size was checked since the entry was loaded, not stored
+		Common::Array<byte> data;
+
+		IndexEntry() : size(0), stamp(0), checked(false) {}
+	};
+
+	typedef Common::HashMap<Common::String, IndexEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveIndex;
+
+	/**
+	 * Assure the index of the saves in the current save path is loaded.
+	 * Writes back the index of the previous save path first.
+	 */
+	void assureIndexLoaded();
+
+	/**
+	 * Drop the index entry of a save file about to be written or removed.
+	 */
+	void removeIndexEntry(const Common::String &filename);
+
+	/**
+	 * Return the size of a raw save file, or -1 if it cannot be opened.
+	 */
+	int32 getRawSize(const Common::String &filename);
+
+	/**
+	 * Index of the saves in _indexDirectory, stored in its INDEX_FILENAME.
+	 */
+	SaveIndex _index;
+
+	/**
+	 * Whether _index changed since it was last written.
+	 */
+	bool _indexDirty;
+
 private:
+	/**
+	 * Open the save file for saving, through an atomic write stream if
+	 * @p atomic is set.
+	 */
+	Common::OutSaveFile *createSaveFile(const Common::String &filename, bool compress, bool atomic);
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	/**
+	 * The directory whose index is loaded.
+	 */
+	Common::String _indexDirectory;
 };
 
 #endif
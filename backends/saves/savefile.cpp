@@ -21,8 +21,11 @@
  */
 
 #include "common/util.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/str.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 #include "backends/cloud/cloudmanager.h"
 #endif
@@ -101,6 +104,205 @@ bool SaveFileManager::renameSavefile(const String &oldFilename, const String &ne
 	return removeSavefile(oldFilename);
 }
 
+/**
+ * Keeps what is written in memory, until it is handed to the save file manager
+ * to be written out in the background.
+ */
+class BackgroundOutSaveFile : public OutSaveFile {
+public:
+	BackgroundOutSaveFile(SaveFileManager *manager, const String &name, OutSaveFile *file) :
+		OutSaveFile(new MemoryWriteStreamDynamic(DisposeAfterUse::NO)), _manager(manager), _name(name), _file(file) {
+	}
+
+	~BackgroundOutSaveFile() override {
+		// Like the other save files, it is written out even if it was not finalized
+		startWriting();
+	}
+
+	void finalize() override {
+		startWriting();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (!_file)
+			return 0;
+		return OutSaveFile::write(dataPtr, dataSize);
+	}
+
+private:
+	void startWriting() {
+		if (!_file)
+			return;
+
+		MemoryWriteStreamDynamic *memory = (MemoryWriteStreamDynamic *)_wrapped;
+		_manager->startBackgroundSave(_name, _file, memory->getData(), memory->size());
+		_file = nullptr;
+
+		// The data belongs to the save file manager now
+		delete _wrapped;
+		_wrapped = new MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+	}
+
+	SaveFileManager *_manager;
+	String _name;
+	OutSaveFile *_file;
+};
+
+struct SaveFileManager::BackgroundSave {
+	String name;
+	OutSaveFile *file;
+	byte *data;
+	uint32 size;
+	TaskGroup task;
+
+	static void write(void *refCon) {
+		BackgroundSave *save = (BackgroundSave *)refCon;
+		// The compression happens in here, with the save file wrapping a
+		// compressed stream. Only finalizing it is left to the main thread.
+		save->file->write(save->data, save->size);
+	}
+};
+
+SaveFileManager::SaveFileManager() : _mainThread(0), _hasMainThread(false), _nextSaveFileStamp(1) {
+}
+
+SaveFileManager::~SaveFileManager() {
+	finishBackgroundSaves(true);
+}
+
+bool SaveFileManager::isMainThread() const {
+	// Until a save is started in the background, there is nothing which
+	// only the main thread may do
+	StackLock lock(_backgroundSavesMutex);
+	return !_hasMainThread || g_system->getCurrentThreadId() == _mainThread;
+}
+
+OutSaveFile *SaveFileManager::openForSavingInBackground(const String &name, bool compress) {
+	{
+		StackLock lock(_backgroundSavesMutex);
+		if (!_hasMainThread) {
+			_mainThread = g_system->getCurrentThreadId();
+			_hasMainThread = true;
+		}
+	}
+
+	OutSaveFile *file = openForSavingAtomically(name, compress);
+	saveFileChanged(name);
+	if (!file || !canSaveInBackground())
+		return file;
+
+	return new BackgroundOutSaveFile(this, name, file);
+}
+
+void SaveFileManager::startBackgroundSave(const String &name, OutSaveFile *file, byte *data, uint32 size) {
+	BackgroundSave *save = new BackgroundSave();
+	save->name = name;
+	save->file = file;
+	save->data = data;
+	save->size = size;
+
+	// The task is started with the lock held, so that other threads never
+	// see the save before it is being written
+	StackLock lock(_backgroundSavesMutex);
+	_backgroundSaves.push_back(save);
+	save->task.run(&BackgroundSave::write, save);
+}
+
+bool SaveFileManager::isSavingInBackground() const {
+	StackLock lock(_backgroundSavesMutex);
+	return !_backgroundSaves.empty();
+}
+
+uint32 SaveFileManager::getSaveFileStamp(const String &name) const {
+	StackLock lock(_saveFileStampsMutex);
+	SaveFileStampMap::const_iterator i = _saveFileStamps.find(name);
+	return i != _saveFileStamps.end() ? i->_value : 0;
+}
+
+void SaveFileManager::saveFileChanged(const String &name) {
+	StackLock lock(_saveFileStampsMutex);
+	_saveFileStamps[name] = _nextSaveFileStamp++;
+}
+
+bool SaveFileManager::updateBackgroundSaves(bool wait) {
+	finishBackgroundSaves(wait);
+	if (_failedBackgroundSave.empty())
+		return true;
+
+	setError(kWritingFailed, "Could not write the save file '" + _failedBackgroundSave + "'");
+	_failedBackgroundSave.clear();
+	return false;
+}
+
+void SaveFileManager::finishBackgroundSaves(bool wait) {
+	assert(isMainThread());
+
+	// Only this thread removes saves from the list, so the saves stay valid
+	// without the lock. It is not held while waiting, since other threads
+	// look at the list until the writing is done.
+	List<BackgroundSave *> finished;
+	{
+		StackLock lock(_backgroundSavesMutex);
+		for (List<BackgroundSave *>::iterator i = _backgroundSaves.begin(); i != _backgroundSaves.end(); ++i) {
+			if (wait || (*i)->task.isDone())
+				finished.push_back(*i);
+		}
+	}
+
+	for (List<BackgroundSave *>::iterator i = finished.begin(); i != finished.end(); ++i) {
+		BackgroundSave *save = *i;
+		save->task.wait();
+
+		{
+			StackLock lock(_backgroundSavesMutex);
+			_backgroundSaves.remove(save);
+		}
+
+		save->file->finalize();
+		if (save->file->err())
+			_failedBackgroundSave = save->name;
+
+		delete save->file;
+		free(save->data);
+		delete save;
+	}
+}
+
+void SaveFileManager::waitForBackgroundSave(const String &name) {
+	if (!isMainThread()) {
+		// Finalizing the save file is left to the main thread, which syncs
+		// the saves again once it is done. Waiting for it here could dead
+		// lock, for example with the cloud sync calling from its timer.
+		for (;;) {
+			bool writing = false;
+			{
+				StackLock lock(_backgroundSavesMutex);
+				for (List<BackgroundSave *>::iterator i = _backgroundSaves.begin(); i != _backgroundSaves.end(); ++i) {
+					if ((*i)->name.equalsIgnoreCase(name) && !(*i)->task.isDone())
+						writing = true;
+				}
+			}
+			if (!writing)
+				return;
+			g_system->delayMillis(1);
+		}
+	}
+
+	List<BackgroundSave *> matching;
+	{
+		StackLock lock(_backgroundSavesMutex);
+		for (List<BackgroundSave *>::iterator i = _backgroundSaves.begin(); i != _backgroundSaves.end(); ++i) {
+			if ((*i)->name.equalsIgnoreCase(name))
+				matching.push_back(*i);
+		}
+	}
+	for (List<BackgroundSave *>::iterator i = matching.begin(); i != matching.end(); ++i)
+		(*i)->task.wait();
+
+	// Writing the save file is only over once it is finalized
+	finishBackgroundSaves(false);
+}
+
 String SaveFileManager::popErrorDesc() {
 	String err = _errorDesc;
 	clearError();
@@ -22,97 +22,153 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
+enum {
+	// A timer falling further behind than this, as when the process was
+	// suspended, starts over from the current time, rather than firing
+	// all the calls it missed in a burst
+	kMaxCatchUp = 500000,
+
+	// How long the backend may wait when no timer is installed
+	kIdleWait = 100000
+};
+
 struct TimerSlot {
 	Common::TimerManager::TimerProc callback;
 	void *refCon;
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint64 nextFireTime;	// in microseconds
+	uint32 order;
 
-	TimerSlot *next;
+	DefaultTimerManager::TimerStats stats;
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), order(0) {}
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+static bool firesBefore(const TimerSlot *a, const TimerSlot *b) {
+	if (a->nextFireTime != b->nextFireTime)
+		return a->nextFireTime < b->nextFireTime;
+	// The order wraps around, so compare the distance
+	return (int32)(a->order - b->order) < 0;
+}
+
+static void siftUp(Common::Array<TimerSlot *> &queue, uint i) {
+	TimerSlot *slot = queue[i];
+	while (i > 0) {
+		const uint parent = (i - 1) / 2;
+		if (!firesBefore(slot, queue[parent]))
+			break;
+		queue[i] = queue[parent];
+		i = parent;
 	}
+	queue[i] = slot;
 }
 
+static void siftDown(Common::Array<TimerSlot *> &queue, uint i) {
+	TimerSlot *slot = queue[i];
+	const uint size = queue.size();
+	for (;;) {
+		uint child = 2 * i + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && firesBefore(queue[child + 1], queue[child]))
+			child++;
+		if (!firesBefore(queue[child], slot))
+			break;
+		queue[i] = queue[child];
+		i = child;
+	}
+	queue[i] = slot;
+}
+
+static void printStats(const DefaultTimerManager::TimerStats &stats) {
+	if (!stats.calls)
+		return;
+
+	debug(2, "Timer '%s' (%u us): %u calls, %u skipped, run time %u us on average and %u us at most, late %u us on average and %u us at most",
+	      stats.id.c_str(), stats.interval, stats.calls, stats.skippedCalls, (uint32)(stats.totalRunTime / stats.calls), stats.maxRunTime,
+	      (uint32)(stats.totalLateness / stats.calls), stats.maxLateness);
+}
 
-DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(0) {
 
-	_head = new TimerSlot();
+DefaultTimerManager::DefaultTimerManager() :
+	_runningSlot(nullptr),
+	_scheduleOrder(0),
+	_timerCallbackNext(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
-	}
-	_head = 0;
+	for (uint i = 0; i < _queue.size(); ++i)
+		delete _queue[i];
+	_queue.clear();
 }
 
-void DefaultTimerManager::handler() {
-	Common::StackLock lock(_mutex);
+uint64 DefaultTimerManager::getMicros(bool skipRecord) {
+	return (uint64)g_system->getMillis(skipRecord) * 1000;
+}
 
-	uint32 curTime = g_system->getMillis(true);
+void DefaultTimerManager::schedule(TimerSlot *slot) {
+	slot->order = _scheduleOrder++;
+	_queue.push_back(slot);
+	siftUp(_queue, _queue.size() - 1);
+}
 
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+uint32 DefaultTimerManager::handler() {
+	Common::StackLock lock(_mutex);
+
+	uint64 curTime = getMicros(true);
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
+	while (!_queue.empty() && _queue[0]->nextFireTime <= curTime) {
+		TimerSlot *slot = _queue[0];
+		const uint64 lateness = curTime - slot->nextFireTime;
 
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+		// Move on to the next fire time, which is kept as an absolute time
+		// so the calls don't drift, and put the slot back in the queue
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+		if (lateness > kMaxCatchUp) {
+			slot->stats.skippedCalls += (uint32)(lateness / slot->interval);
+			slot->nextFireTime = curTime + slot->interval;
+		} else {
+			slot->nextFireTime += slot->interval;
 		}
-		insertPrioQueue(_head, slot);
+		slot->order = _scheduleOrder++;
+		siftDown(_queue, 0);
 
 		// Invoke the timer callback
 		assert(slot->callback);
+		_runningSlot = slot;
 		slot->callback(slot->refCon);
+		const uint64 endTime = getMicros(true);
+
+		if (_runningSlot) {
+			TimerStats &stats = slot->stats;
+			const uint32 runTime = (uint32)MIN<uint64>(endTime - curTime, 0xFFFFFFFF);
+			stats.calls++;
+			stats.totalRunTime += runTime;
+			stats.maxRunTime = MAX(stats.maxRunTime, runTime);
+			stats.totalLateness += lateness;
+			stats.maxLateness = MAX(stats.maxLateness, (uint32)MIN<uint64>(lateness, 0xFFFFFFFF));
+		} else {
+			// The callback removed its own timer
+			delete slot;
+		}
+		_runningSlot = nullptr;
 
 		// Look at the next scheduled timer
-		slot = _head->next;
+		curTime = endTime;
 	}
+
+	if (_queue.empty())
+		return kIdleWait;
+	return (uint32)MIN<uint64>(_queue[0]->nextFireTime - curTime, kIdleWait);
 }
 
 void DefaultTimerManager::checkTimers(uint32 interval) {
@@ -125,6 +181,14 @@ void DefaultTimerManager::checkTimers(uint32 interval) {
 	}
 }
 
+void DefaultTimerManager::getStats(Common::Array<TimerStats> &stats) {
+	Common::StackLock lock(_mutex);
+
+	stats.clear();
+	for (uint i = 0; i < _queue.size(); ++i)
+		stats.push_back(_queue[i]->stats);
+}
+
 bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, void *refCon, const Common::String &id) {
 	assert(interval > 0);
 	Common::StackLock lock(_mutex);
@@ -148,11 +212,15 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
+	slot->nextFireTime = getMicros() + interval;
 
-	insertPrioQueue(_head, slot);
+	slot->stats.id = id;
+	slot->stats.interval = interval;
+	slot->stats.calls = slot->stats.skippedCalls = 0;
+	slot->stats.totalRunTime = slot->stats.totalLateness = 0;
+	slot->stats.maxRunTime = slot->stats.maxLateness = 0;
+
+	schedule(slot);
 
 	return true;
 }
@@ -160,16 +228,27 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
+	// installTimerProc() makes sure a callback has at most one slot
+	for (uint i = 0; i < _queue.size(); ++i) {
+		TimerSlot *slot = _queue[i];
+		if (slot->callback != callback)
+			continue;
+
+		// Fill the hole with the last slot, and move that one where it belongs
+		printStats(slot->stats);
+		_queue[i] = _queue.back();
+		_queue.pop_back();
+		if (i < _queue.size()) {
+			siftDown(_queue, i);
+			siftUp(_queue, i);
 		}
+
+		// A callback removing itself is deleted once it returns
+		if (slot == _runningSlot)
+			_runningSlot = nullptr;
+		else
+			delete slot;
+		break;
 	}
 
 	// We need to remove all names referencing the timer proc here.
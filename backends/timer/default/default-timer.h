@@ -23,6 +23,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -31,15 +32,36 @@
 struct TimerSlot;
 
 class DefaultTimerManager : public Common::TimerManager {
+public:
+	/** How a timer proc has been keeping up with its interval */
+	struct TimerStats {
+		Common::String id;
+		uint32 interval;      ///< in microseconds
+		uint32 calls;
+		uint32 skippedCalls;  ///< the calls dropped when it fell too far behind
+		uint64 totalRunTime;  ///< in microseconds
+		uint32 maxRunTime;    ///< in microseconds
+		uint64 totalLateness; ///< in microseconds
+		uint32 maxLateness;   ///< in microseconds
+	};
+
 private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	// A binary min-heap on the fire times of the slots
+	Common::Array<TimerSlot *> _queue;
 	TimerSlotMap _callbacks;
 
+	// The slot whose callback is running, unless it removed itself
+	TimerSlot *_runningSlot;
+	// Keeps the slots due at the same time in the order they were scheduled
+	uint32 _scheduleOrder;
+
 	uint32 _timerCallbackNext;
 
+	void schedule(TimerSlot *slot);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
@@ -48,14 +70,26 @@ public:
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
+	 *
+	 * @return the time until the next timer is due, in microseconds
 	 */
-	void handler();
+	uint32 handler();
 
 	/*
 	 * Ensure that the callback is called at regular time intervals.
 	 * Should be called from pollEvents() on backends without threads.
 	 */
 	void checkTimers(uint32 interval = 10);
+
+	/** Get the statistics of the installed timer procs */
+	void getStats(Common::Array<TimerStats> &stats);
+
+protected:
+	/**
+	 * The clock the timers run on, in microseconds. This defaults to the
+	 * milliseconds of OSystem, which the event recorder replays.
+	 */
+	virtual uint64 getMicros(bool skipRecord = false);
 };
 
 #endif
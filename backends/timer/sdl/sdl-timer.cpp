@@ -21,40 +21,97 @@
  *
  */
 
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
 #include "common/scummsys.h"
 
 #if defined(SDL_BACKEND)
 
 #include "backends/timer/sdl/sdl-timer.h"
 
+#include "common/profiler.h"
 #include "common/textconsole.h"
 
-OSystem::MutexRef timerMutex;
+#if defined(POSIX)
+#include <time.h>
+#endif
+
+enum {
+	// Below this, the thread sleeps for the exact time left rather than
+	// waiting on the semaphore, whose timeout is in milliseconds
+	kPreciseWait = 2000
+};
+
+static void sleepMicros(uint32 micros) {
+#if defined(POSIX)
+	struct timespec ts;
+	ts.tv_sec = micros / 1000000;
+	ts.tv_nsec = (micros % 1000000) * 1000;
+	nanosleep(&ts, 0);
+#else
+	// Wait at least as long; firing early would only loop again
+	SDL_Delay((micros + 999) / 1000);
+#endif
+}
+
+int SDLCALL SdlTimerManager::timerThread(void *refCon) {
+	SdlTimerManager *manager = (SdlTimerManager *)refCon;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// The music drivers need their ticks on time; this may not be allowed
+	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+#endif
+
+	while (!manager->_quit) {
+		const uint32 wait = manager->handler();
 
-static Uint32 timer_handler(Uint32 interval, void *param) {
-	Common::StackLock lock(timerMutex);
+		if (wait >= kPreciseWait)
+			SDL_SemWaitTimeout(manager->_wakeUp, (wait - kPreciseWait / 2) / 1000);
+		else if (wait > 0)
+			sleepMicros(wait);
+	}
 
-	((DefaultTimerManager *)param)->handler();
-	return interval;
+	return 0;
 }
 
-SdlTimerManager::SdlTimerManager() {
+SdlTimerManager::SdlTimerManager() : _thread(nullptr), _wakeUp(nullptr), _quit(false) {
 	// Initializes the SDL timer subsystem
 	if (SDL_InitSubSystem(SDL_INIT_TIMER) == -1) {
 		error("Could not initialize SDL: %s", SDL_GetError());
 	}
 
-	// Creates the timer callback
-	_timerID = SDL_AddTimer(10, &timer_handler, this);
+	// Creates the timer thread
+	_wakeUp = SDL_CreateSemaphore(0);
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	_thread = SDL_CreateThread(timerThread, "ScummVM timer", this);
+#else
+	_thread = SDL_CreateThread(timerThread, this);
+#endif
+	if (!_wakeUp || !_thread)
+		error("Could not create the timer thread: %s", SDL_GetError());
 }
 
 SdlTimerManager::~SdlTimerManager() {
-	Common::StackLock lock(timerMutex);
-
-	// Removes the timer callback
-	SDL_RemoveTimer(_timerID);
+	// Stops the timer thread
+	_quit = true;
+	SDL_SemPost(_wakeUp);
+	SDL_WaitThread(_thread, nullptr);
+	SDL_DestroySemaphore(_wakeUp);
 
 	SDL_QuitSubSystem(SDL_INIT_TIMER);
 }
 
+bool SdlTimerManager::installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id) {
+	if (!DefaultTimerManager::installTimerProc(proc, interval, refCon, id))
+		return false;
+
+	// The new timer may be due before the thread wakes up
+	SDL_SemPost(_wakeUp);
+	return true;
+}
+
+uint64 SdlTimerManager::getMicros(bool skipRecord) {
+	return Common::Profiler::getMicros();
+}
+
 #endif
@@ -28,16 +28,26 @@
 #include "backends/platform/sdl/sdl-sys.h"
 
 /**
- * SDL timer manager. Setups the timer callback for
- * DefaultTimerManager.
+ * SDL timer manager. Runs the timers of DefaultTimerManager on a thread of
+ * their own, which sleeps until the next one is due.
  */
 class SdlTimerManager : public DefaultTimerManager {
 public:
 	SdlTimerManager();
 	virtual ~SdlTimerManager();
 
+	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
+
 protected:
-	SDL_TimerID _timerID;
+	virtual uint64 getMicros(bool skipRecord = false);
+
+private:
+	static int SDLCALL timerThread(void *refCon);
+
+	SDL_Thread *_thread;
+	// Wakes the thread up early, when a timer is installed
+	SDL_sem *_wakeUp;
+	volatile bool _quit;
 };
 
 
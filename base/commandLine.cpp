@@ -163,6 +163,13 @@ static const char HELP_STRING[] =
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
+	"  --timedemo               Play the record back as fast as possible, and report\n"
+	"                           the frame times and the final screen checksum. With\n"
+	"                           --disable-display, the frames are not presented\n"
+#endif
+#if defined(USE_NULL_DRIVER)
+	"  --virtual-clock          Skip the delays, advancing the clock instead, so the\n"
+	"                           games run faster than real time\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -241,6 +248,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("show_fps", false);
 	ConfMan.registerDefault("dirtyrects", true);
 	ConfMan.registerDefault("vsync", true);
+	ConfMan.registerDefault("frame_pacing", false);
 
 	// Sound & Music
 	ConfMan.registerDefault("music_volume", 192);
@@ -257,6 +265,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("midi_render_ahead", 40);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -304,6 +313,10 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_sdl_parachute", false);
 
 	ConfMan.registerDefault("disable_display", false);
+	ConfMan.registerDefault("timedemo", false);
+#if defined(USE_NULL_DRIVER)
+	ConfMan.registerDefault("virtual_clock", false);
+#endif
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
 
@@ -608,6 +621,14 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
+
+			DO_LONG_OPTION_BOOL("timedemo")
+			END_OPTION
+#endif
+
+#if defined(USE_NULL_DRIVER)
+			DO_LONG_OPTION_BOOL("virtual-clock")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
@@ -32,6 +32,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_printf
 
 #include "engines/engine.h"
+#include "engines/detectioncache.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
 #include "base/plugins.h"
@@ -52,10 +53,12 @@
 #include "common/tokenizer.h"
 #include "common/translation.h"
 #include "common/text-to-speech.h"
+#include "common/threadpool.h"
 #include "common/osd_message_queue.h"
 
 #include "gui/gui-manager.h"
 #include "gui/error.h"
+#include "gui/saveload.h"
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
@@ -689,7 +692,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 	PluginManager::instance().unloadDetectionPlugin();
 	PluginManager::instance().unloadAllPlugins();
+	Common::ThreadPool::destroy();
+	DetectionCache::destroy();
 	PluginManager::destroy();
+	GUI::SaveMetaInfoCache::destroy();
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
 	Common::DebugManager::destroy();
@@ -25,6 +25,7 @@
 #include "common/func.h"
 #include "common/debug.h"
 #include "common/config-manager.h"
+#include "common/file.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
@@ -271,30 +272,36 @@ void PluginManager::addPluginProvider(PluginProvider *pp) {
 	_providers.push_back(pp);
 }
 
+static Plugin *findEnginePluginInMemory(const Common::String &engineId) {
+	const PluginList &pl = PluginMan.getPlugins(PLUGIN_TYPE_ENGINE);
+	// Iterate over all engine plugins.
+	for (PluginList::const_iterator itr = pl.begin(); itr != pl.end(); itr++) {
+		// The getName() provides a name which is similiar to getEngineId.
+		// Because engines are engines themselves, this function is simply named getName.
+		if (engineId.equalsIgnoreCase((*itr)->getName()))
+			return *itr;
+	}
+	return nullptr;
+}
+
 Plugin *PluginManager::getEngineFromMetaEngine(const Plugin *plugin) {
 	assert(plugin->getType() == PLUGIN_TYPE_ENGINE_DETECTION);
 
 	Plugin *enginePlugin = nullptr;
-	bool found = false;
 
 	// Use the engineID from MetaEngine for comparasion.
 	Common::String metaEnginePluginName = plugin->getEngineId();
-	PluginMan.loadFirstPlugin();
-	do {
-		PluginList pl = PluginMan.getPlugins(PLUGIN_TYPE_ENGINE);
-		// Iterate over all engine plugins.
-		for (PluginList::const_iterator itr = pl.begin(); itr != pl.end(); itr++) {
-			// The getName() provides a name which is similiar to getEngineId.
-			// Because engines are engines themselves, this function is simply named getName.
-			Common::String enginePluginName((*itr)->getName());
-
-			if (metaEnginePluginName.equalsIgnoreCase(enginePluginName)) {
-				enginePlugin = (*itr);
-				found = true;
-				break;
-			}
-		}
-	} while (!found && PluginMan.loadNextPlugin());
+
+	// A plugin file known for this engine ID saves trying all the plugins
+	if (PluginMan.loadPluginFromEngineId(metaEnginePluginName))
+		enginePlugin = findEnginePluginInMemory(metaEnginePluginName);
+
+	if (!enginePlugin) {
+		PluginMan.loadFirstPlugin();
+		do {
+			enginePlugin = findEnginePluginInMemory(metaEnginePluginName);
+		} while (!enginePlugin && PluginMan.loadNextPlugin());
+	}
 
 	if (enginePlugin) {
 		debug(9, "MetaEngine: %s \t matched to \t Engine: %s", plugin->getName(), enginePlugin->getFileName());
@@ -388,11 +395,52 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	loadPluginIndex();
+}
+
+/**
+ * Read the plugins.idx files generated by the build next to the plugins. Each
+ * line holds an engine ID and the name of its plugin file in that directory.
+ **/
+void PluginManagerUncached::loadPluginIndex() {
+	_pluginIndex.clear();
+
+	// All the plugin files of a directory, by name
+	typedef Common::HashMap<Common::String, Common::StringMap> DirectoryMap;
+	DirectoryMap dirs;
+	for (PluginList::const_iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		if (!(*p)->getFileName())
+			continue;
+
+		Common::FSNode node((*p)->getFileName());
+		dirs[node.getParent().getPath()][node.getName()] = (*p)->getFileName();
+	}
+
+	for (DirectoryMap::const_iterator dir = dirs.begin(); dir != dirs.end(); ++dir) {
+		Common::File index;
+		if (!index.open(Common::FSNode(dir->_key).getChild("plugins.idx")))
+			continue;
+
+		while (!index.eos() && !index.err()) {
+			Common::String line = index.readLine();
+			const char *separator = strchr(line.c_str(), ' ');
+			if (!separator)
+				continue;
+
+			Common::String engineId(line.c_str(), separator);
+			Common::String fileName = dir->_value.getValOrDefault(separator + 1);
+			if (!engineId.empty() && !fileName.empty())
+				_pluginIndex[engineId] = fileName;
+		}
+	}
+
+	debug(9, "Plugin index: %u engines", _pluginIndex.size());
 }
 
 /**
  * Try to load the plugin by searching in the ConfigManager for a matching
- * engine ID under the domain 'engine_plugin_files'.
+ * engine ID under the domain 'engine_plugin_files', then in the plugin index.
  **/
 bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineId) {
 	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
@@ -406,7 +454,9 @@ bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineI
 			}
 		}
 	}
-	return false;
+
+	// Fall back to the index generated by the build
+	return loadPluginByFileName(_pluginIndex.getValOrDefault(engineId));
 }
 
 /**
@@ -622,6 +672,7 @@ void PluginManager::addToPluginsInMemList(Plugin *plugin) {
 
 // Engine plugins
 
+#include "engines/detectioncache.h"
 #include "engines/metaengine.h"
 
 namespace Common {
@@ -693,20 +744,38 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) const
 
 	// Iterate over all known games and for each check if it might be
 	// the game in the presented directory.
-	for (iter = plugins.begin(); iter != plugins.end(); ++iter) {
-		const MetaEngineDetection &metaEngine = (*iter)->get<MetaEngineDetection>();
-		DetectedGames engineCandidates = metaEngine.detectGames(fslist);
+	for (iter = plugins.begin(); iter != plugins.end(); ++iter)
+		detectGamesWithPlugin(**iter, fslist, candidates);
 
-		for (uint i = 0; i < engineCandidates.size(); i++) {
-			engineCandidates[i].path = fslist.begin()->getParent().getPath();
-			engineCandidates[i].shortPath = fslist.begin()->getParent().getDisplayName();
-			candidates.push_back(engineCandidates[i]);
-		}
-	}
+	// Keep the file properties computed by the engines for the next scan
+	DetectionCache::instance().flush();
 
 	return DetectionResults(candidates);
 }
 
+DetectedGames EngineManager::detectGamesPass(const Common::FSList &fslist, bool threadSafe) const {
+	DetectedGames candidates;
+	const PluginList &plugins = getPlugins(PLUGIN_TYPE_ENGINE_DETECTION);
+
+	for (PluginList::const_iterator iter = plugins.begin(); iter != plugins.end(); ++iter) {
+		if ((*iter)->get<MetaEngineDetection>().isDetectionThreadSafe() == threadSafe)
+			detectGamesWithPlugin(**iter, fslist, candidates);
+	}
+
+	return candidates;
+}
+
+void EngineManager::detectGamesWithPlugin(const Plugin &plugin, const Common::FSList &fslist, DetectedGames &candidates) const {
+	const MetaEngineDetection &metaEngine = plugin.get<MetaEngineDetection>();
+	DetectedGames engineCandidates = metaEngine.detectGames(fslist);
+
+	for (uint i = 0; i < engineCandidates.size(); i++) {
+		engineCandidates[i].path = fslist.begin()->getParent().getPath();
+		engineCandidates[i].shortPath = fslist.begin()->getParent().getDisplayName();
+		candidates.push_back(engineCandidates[i]);
+	}
+}
+
 const PluginList &EngineManager::getPlugins(const PluginType fetchPluginType) const {
 	return PluginManager::instance().getPlugins(fetchPluginType);
 }
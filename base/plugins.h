@@ -25,6 +25,7 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
 #include "common/str.h"
 #include "backends/plugins/elf/version.h"
 
@@ -372,8 +373,12 @@ protected:
 
 	bool _isDetectionLoaded;
 
+	/** Maps engine IDs to the file names of their plugins, read from plugins.idx. */
+	Common::StringMap _pluginIndex;
+
 	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr) {}
 	bool loadPluginByFileName(const Common::String &filename);
+	void loadPluginIndex();
 
 public:
 	virtual void init() override;
@@ -22,6 +22,7 @@
 
 #include "common/archive.h"
 #include "common/fs.h"
+#include "common/str-array.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -98,6 +99,7 @@ void SearchSet::add(const String &name, Archive *archive, int priority, bool aut
 	if (find(name) == _list.end()) {
 		Node node(priority, name, archive, autoFree);
 		insert(node);
+		indexArchive(node);
 	} else {
 		if (autoFree)
 			delete archive;
@@ -170,9 +172,12 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
-		if (it->_autoFree)
-			delete it->_arc;
+		Archive *arc = it->_arc;
+		bool autoFree = it->_autoFree;
 		_list.erase(it);
+		unindexArchive(arc);
+		if (autoFree)
+			delete arc;
 	}
 }
 
@@ -187,6 +192,8 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_index.clear(true);
+	_indexBuilt = false;
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -201,14 +208,107 @@ void SearchSet::setPriority(const String &name, int priority) {
 
 	Node node(*it);
 	_list.erase(it);
+	unindexArchive(node._arc);
 	node._priority = priority;
 	insert(node);
+	indexArchive(node);
+}
+
+void SearchSet::enableMemberIndex(bool enable) {
+	_useIndex = enable;
+	if (!enable) {
+		_index.clear(true);
+		_indexBuilt = false;
+	}
+}
+
+void SearchSet::buildIndex() const {
+	_index.clear();
+
+	// The list is sorted by descending priority, so the first archive
+	// listing a member is the one a linear search would pick.
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		ArchiveMemberList members;
+		it->_arc->listMembers(members);
+
+		for (ArchiveMemberList::const_iterator m = members.begin(); m != members.end(); ++m) {
+			const String name = (*m)->getName();
+			if (!_index.contains(name))
+				_index[name] = IndexEntry(it->_arc, it->_priority);
+		}
+	}
+
+	_indexBuilt = true;
+}
+
+void SearchSet::indexArchive(const Node &node) const {
+	if (!_indexBuilt)
+		return;
+
+	ArchiveMemberList members;
+	node._arc->listMembers(members);
+
+	// In case of equal priorities insertion order prevails, so a newly
+	// added archive only takes over members from lower priority ones.
+	for (ArchiveMemberList::const_iterator m = members.begin(); m != members.end(); ++m) {
+		const String name = (*m)->getName();
+		MemberIndex::iterator entry = _index.find(name);
+		if (entry == _index.end() || entry->_value._priority < node._priority)
+			_index[name] = IndexEntry(node._arc, node._priority);
+	}
+}
+
+void SearchSet::unindexArchive(const Archive *arc) const {
+	if (!_indexBuilt)
+		return;
+
+	StringArray orphans;
+	for (MemberIndex::const_iterator entry = _index.begin(); entry != _index.end(); ++entry) {
+		if (entry->_value._arc == arc)
+			orphans.push_back(entry->_key);
+	}
+
+	// Hand the members over to the next archive containing them, if any.
+	for (StringArray::const_iterator name = orphans.begin(); name != orphans.end(); ++name) {
+		_index.erase(*name);
+
+		ArchiveNodeList::const_iterator it = _list.begin();
+		for (; it != _list.end(); ++it) {
+			if (it->_arc != arc && it->_arc->hasFile(*name)) {
+				_index[*name] = IndexEntry(it->_arc, it->_priority);
+				break;
+			}
+		}
+	}
+}
+
+Archive *SearchSet::findIndexed(const String &name) const {
+	if (!_useIndex)
+		return nullptr;
+
+	if (!_indexBuilt)
+		buildIndex();
+
+	MemberIndex::const_iterator entry = _index.find(name);
+	if (entry == _index.end())
+		return nullptr;
+
+	// Member names are not necessarily valid lookup paths (e.g. FSDirectory
+	// lists files in subdirectories by their plain name), hence the check.
+	if (!entry->_value._arc->hasFile(name))
+		return nullptr;
+
+	return entry->_value._arc;
 }
 
 bool SearchSet::hasFile(const String &name) const {
 	if (name.empty())
 		return false;
 
+	if (findIndexed(name))
+		return true;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(name))
@@ -242,6 +342,10 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
+	Archive *indexed = findIndexed(name);
+	if (indexed)
+		return indexed->getMember(name);
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(name))
@@ -255,6 +359,13 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return nullptr;
 
+	Archive *indexed = findIndexed(name);
+	if (indexed) {
+		SeekableReadStream *stream = indexed->createReadStreamForMember(name);
+		if (stream)
+			return stream;
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
@@ -24,6 +24,8 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -168,8 +170,26 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	/** Entry of the member index: the highest priority archive known to contain a member. */
+	struct IndexEntry {
+		Archive	*_arc;
+		int		_priority;
+		IndexEntry() : _arc(nullptr), _priority(0) {}
+		IndexEntry(Archive *arc, int priority) : _arc(arc), _priority(priority) {}
+	};
+	typedef HashMap<String, IndexEntry, IgnoreCase_Hash, IgnoreCase_EqualTo> MemberIndex;
+
+	bool _useIndex;
+	mutable bool _indexBuilt;
+	mutable MemberIndex _index;
+
+	void buildIndex() const;
+	void indexArchive(const Node &node) const;      //!< Add the members of an archive to an already built index.
+	void unindexArchive(const Archive *arc) const;  //!< Drop an archive from an already built index.
+	Archive *findIndexed(const String &name) const;
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _useIndex(false), _indexBuilt(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -268,6 +288,22 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
+	/**
+	 * Enable or disable the member index.
+	 *
+	 * When enabled, the SearchSet keeps a hash index mapping every member name
+	 * (as reported by listMembers) to the highest priority archive containing it.
+	 * The index is built lazily on the first lookup and kept up to date when
+	 * archives are added, removed or reprioritized, so that looking up a present
+	 * member costs a single hash probe regardless of the number of archives.
+	 * Names which are not in the index still fall back to querying every archive.
+	 *
+	 * @note The index assumes that the contents of the archives do not change
+	 *       after they have been added to the set, and that archives list their
+	 *       members under the names used to look them up.
+	 */
+	void enableMemberIndex(bool enable);
 };
 
 
@@ -150,6 +150,56 @@ public:
 			insert_aux(end(), &element, &element + 1);
 	}
 
+#ifdef USE_CXX11
+	/** Append an element to the end of the array, moving it in place. */
+	void push_back(T &&element) {
+		emplace_back(Common::move(element));
+	}
+
+	/** Construct an element at the end of the array from the given arguments. */
+	template<class... TArgs>
+	void emplace_back(TArgs &&...args) {
+		if (_size + 1 <= _capacity) {
+			new ((void *)&_storage[_size++]) T(Common::forward<TArgs>(args)...);
+			return;
+		}
+
+		// Construct the new element first, as the arguments may refer
+		// to elements of the old storage.
+		T *const oldStorage = _storage;
+		allocCapacity(roundUpCapacity(_size + 1));
+		new ((void *)&_storage[_size]) T(Common::forward<TArgs>(args)...);
+		uninitialized_move(oldStorage, oldStorage + _size, _storage);
+		freeStorage(oldStorage, _size);
+		_size++;
+	}
+
+	/** Construct an element before @p pos from the given arguments. */
+	template<class... TArgs>
+	void emplace(const_iterator pos, TArgs &&...args) {
+		assert(_storage <= pos && pos <= _storage + _size);
+		const size_type idx = pos - _storage;
+
+		if (idx == _size) {
+			emplace_back(Common::forward<TArgs>(args)...);
+		} else if (_size + 1 <= _capacity) {
+			T tmp(Common::forward<TArgs>(args)...);
+			new ((void *)&_storage[_size]) T(Common::move(_storage[_size - 1]));
+			moveBackward(_storage + idx, _storage + _size - 1, _storage + _size);
+			_storage[idx] = Common::move(tmp);
+			_size++;
+		} else {
+			T *const oldStorage = _storage;
+			allocCapacity(roundUpCapacity(_size + 1));
+			new ((void *)&_storage[idx]) T(Common::forward<TArgs>(args)...);
+			uninitialized_move(oldStorage, oldStorage + idx, _storage);
+			uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + 1);
+			freeStorage(oldStorage, _size);
+			_size++;
+		}
+	}
+#endif
+
     /** Append an element to the end of the array. */
 	void push_back(const Array<T> &array) {
 		if (_size + array.size() <= _capacity) {
@@ -223,8 +273,12 @@ public:
 	/** Remove an element at the given position from the array and return the value of that element. */
 	T remove_at(size_type idx) {
 		assert(idx < _size);
+#ifdef USE_CXX11
+		T tmp = Common::move(_storage[idx]);
+#else
 		T tmp = _storage[idx];
-		copy(_storage + idx + 1, _storage + _size, _storage + idx);
+#endif
+		moveForward(_storage + idx + 1, _storage + _size, _storage + idx);
 		_size--;
 		// We also need to destroy the last object properly here.
 		_storage[_size].~T();
@@ -292,7 +346,7 @@ public:
 
     /** Erase the element at @p pos position and return an iterator pointing to the next element in the array. */
 	iterator erase(iterator pos) {
-		copy(pos + 1, _storage + _size, pos);
+		moveForward(pos + 1, _storage + _size, pos);
 		_size--;
 		// We also need to destroy the last object properly here.
 		_storage[_size].~T();
@@ -342,8 +396,12 @@ public:
 		return _storage + _size;
 	}
 
-    /** Reserve enough memory in the array so that it can store at least the given number of elements. 
+    /** Reserve enough memory in the array so that it can store at least the given number of elements.
 	 *  The current content of the array is not modified.
+	 *
+	 *  Until the array holds more than @p newCapacity elements, appending
+	 *  to it does not reallocate, so pointers and iterators to its elements
+	 *  stay valid.
 	 */
 	void reserve(size_type newCapacity) {
 		if (newCapacity <= _capacity)
@@ -353,12 +411,28 @@ public:
 		allocCapacity(newCapacity);
 
 		if (oldStorage) {
-			// Copy old data
-			uninitialized_copy(oldStorage, oldStorage + _size, _storage);
+			// Move old data
+			uninitialized_move(oldStorage, oldStorage + _size, _storage);
 			freeStorage(oldStorage, _size);
 		}
 	}
 
+	/** Return the number of elements the array can hold without reallocating. */
+	size_type capacity() const {
+		return _capacity;
+	}
+
+	/** Reduce the capacity of the array to its size, releasing the unused memory. */
+	void shrink_to_fit() {
+		if (_capacity == _size)
+			return;
+
+		T *oldStorage = _storage;
+		allocCapacity(_size);
+		uninitialized_move(oldStorage, oldStorage + _size, _storage);
+		freeStorage(oldStorage, _size);
+	}
+
     /** Change the size of the array. */
 	void resize(size_type newSize) {
 		reserve(newSize);
@@ -402,6 +476,26 @@ protected:
 		}
 	}
 
+	/** Move-assign the elements of [first, last) to dst, front to back. */
+	static void moveForward(T *first, T *last, T *dst) {
+		while (first != last)
+#ifdef USE_CXX11
+			*dst++ = Common::move(*first++);
+#else
+			*dst++ = *first++;
+#endif
+	}
+
+	/** Move-assign the elements of [first, last) to the range ending at dstEnd, back to front. */
+	static void moveBackward(T *first, T *last, T *dstEnd) {
+		while (first != last)
+#ifdef USE_CXX11
+			*--dstEnd = Common::move(*--last);
+#else
+			*--dstEnd = *--last;
+#endif
+	}
+
     /** Free the storage used by the array. */
 	void freeStorage(T *storage, const size_type elements) {
 		for (size_type i = 0; i < elements; ++i)
@@ -436,30 +530,31 @@ protected:
 				// storage to avoid conflicts.
 				allocCapacity(roundUpCapacity(_size + n));
 
-				// Copy the data from the old storage till the position where
-				// we insert new data
-				uninitialized_copy(oldStorage, oldStorage + idx, _storage);
-				// Copy the data we insert
+				// Copy the data we insert. This comes first, as it may be
+				// coming from the old storage.
 				uninitialized_copy(first, last, _storage + idx);
-				// Afterwards, copy the old data from the position where we
+				// Move the data from the old storage till the position where
+				// we insert new data
+				uninitialized_move(oldStorage, oldStorage + idx, _storage);
+				// Afterwards, move the old data from the position where we
 				// insert.
-				uninitialized_copy(oldStorage + idx, oldStorage + _size, _storage + idx + n);
+				uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + n);
 
 				freeStorage(oldStorage, _size);
 			} else if (idx + n <= _size) {
 				// Make room for the new elements by shifting back
 				// existing ones.
 				// 1. Move a part of the data to the uninitialized area
-				uninitialized_copy(_storage + _size - n, _storage + _size, _storage + _size);
+				uninitialized_move(_storage + _size - n, _storage + _size, _storage + _size);
 				// 2. Move a part of the data to the initialized area
-				copy_backward(pos, _storage + _size - n, _storage + _size);
+				moveBackward(pos, _storage + _size - n, _storage + _size);
 
 				// Insert the new elements.
 				copy(first, last, pos);
 			} else {
-				// Copy the old data from the position till the end to the new
+				// Move the old data from the position till the end to the new
 				// place.
-				uninitialized_copy(pos, _storage + _size, _storage + idx + n);
+				uninitialized_move(pos, _storage + _size, _storage + idx + n);
 
 				// Copy a part of the new data to the position inside the
 				// initialized space.
@@ -84,6 +84,25 @@ BASESTRING::BaseString(const BASESTRING &str)
 	assert(_str != nullptr);
 }
 
+#ifdef USE_CXX11
+TEMPLATE
+BASESTRING::BaseString(BASESTRING &&str)
+    : _size(str._size) {
+	if (str.isStorageIntern()) {
+		memcpy(_storage, str._storage, _builtinCapacity * sizeof(value_type));
+		_str = _storage;
+	} else {
+		// String in external storage: take it over, along with its refcount
+		_extern._refCount = str._extern._refCount;
+		_extern._capacity = str._extern._capacity;
+		_str = str._str;
+		str._str = str._storage;
+	}
+	str._size = 0;
+	str._storage[0] = 0;
+}
+#endif
+
 TEMPLATE BASESTRING::BaseString(const value_type *str) : _size(0), _str(_storage) {
 	if (str == nullptr) {
 		_storage[0] = 0;
@@ -505,6 +524,28 @@ TEMPLATE void BASESTRING::assign(const BaseString &str) {
 	}
 }
 
+#ifdef USE_CXX11
+TEMPLATE void BASESTRING::assign(BaseString &&str) {
+	if (&str == this)
+		return;
+
+	decRefCount(_extern._refCount);
+	_size = str._size;
+
+	if (str.isStorageIntern()) {
+		_str = _storage;
+		memcpy(_str, str._str, (_size + 1) * sizeof(value_type));
+	} else {
+		_extern._refCount = str._extern._refCount;
+		_extern._capacity = str._extern._capacity;
+		_str = str._str;
+		str._str = str._storage;
+	}
+	str._size = 0;
+	str._storage[0] = 0;
+}
+#endif
+
 TEMPLATE void BASESTRING::assign(value_type c) {
 	decRefCount(_extern._refCount);
 	_str = _storage;
@@ -87,6 +87,11 @@ public:
 	/** Construct a copy of the given string. */
 	BaseString(const BaseString &str);
 
+#ifdef USE_CXX11
+	/** Construct a string by taking over the contents of the given string, which is left empty. */
+	BaseString(BaseString &&str);
+#endif
+
 	/** Construct a new string from the given NULL-terminated C string. */
 	explicit BaseString(const value_type *str);
 
@@ -248,6 +253,9 @@ protected:
 	void assignAppend(value_type c);
 	void assignAppend(const BaseString &str);
 	void assign(const BaseString &str);
+#ifdef USE_CXX11
+	void assign(BaseString &&str);
+#endif
 	void assign(value_type c);
 	void assign(const value_type *str);
 
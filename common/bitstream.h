@@ -85,31 +85,45 @@ private:
 		return 0;
 	}
 
+	/** Move a data value to the right position in the bit container. */
+	inline void pushData(uint64 data) {
+		if (MSB2LSB)
+			_bitContainer |= data << (64 - valueBits - _bitsLeft);
+		else
+			_bitContainer |= data << _bitsLeft;
+
+		_bitsLeft += valueBits;
+	}
+
 	/** Fill the container with at least @p min bits. */
 	inline void fillContainer(size_t min) {
-		while (_bitsLeft < min) {
-
-			uint64 data;
-			if (_pos + _bitsLeft + valueBits <= _size) {
-				data = readData();
-			} else {
-				// Peeking data out of bounds is well-defined and returns 0 bits.
-				// This is for convenience when using speed-up techniques reading
-				// more bits than actually available. Call eos() to check if data
-				// was actually read out of bounds. Peeking out of bounds does not
-				// set the eos flag.
-				data = 0;
-			}
+		if (_bitsLeft < min)
+			refillContainer();
+	}
 
-			// Move the data value to the right position in the bit container
-			if (MSB2LSB)
-				_bitContainer |= data << (64 - valueBits - _bitsLeft);
-			else
-				_bitContainer |= data << _bitsLeft;
+	/** Fill the container with at least @p min bits, assuming the data is in bounds. */
+	inline void fillContainerFast(size_t min) {
+		while (_bitsLeft < min)
+			pushData(readData());
+	}
 
-			_bitsLeft += valueBits;
-		}
-}
+	/** Top up the container with as many data values as fit in it. */
+	void refillContainer() {
+		// Both the stream size and the read data are multiples of valueBits
+		const uint32 end = _pos + _bitsLeft;
+		uint32 available = (end < _size) ? (_size - end) / valueBits : 0;
+		uint32 count = (64 - _bitsLeft) / valueBits;
+
+		for (; count > 0 && available > 0; count--, available--)
+			pushData(readData());
+
+		// Peeking data out of bounds is well-defined and returns 0 bits.
+		// This is for convenience when using speed-up techniques reading
+		// more bits than actually available. Call eos() to check if data
+		// was actually read out of bounds. Peeking out of bounds does not
+		// set the eos flag.
+		_bitsLeft += count * valueBits;
+	}
 
 	/** Get @p n bits from the bit container. */
 	inline static uint32 getNBits(uint64 value, size_t n) {
@@ -214,6 +228,42 @@ public:
 		return b;
 	}
 
+	/**
+	 * Read a multi-bit value from the bit stream, without changing the stream's position
+	 * and without any checks.
+	 *
+	 * The caller must make sure that @p n is at most 32 and that the data read is
+	 * within the stream, for example by validating the size of a packet before
+	 * decoding it.
+	 */
+	uint32 peekBitsFast(size_t n) {
+		fillContainerFast(n);
+		return getNBits(_bitContainer, n);
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream, without any checks.
+	 *
+	 * @see peekBitsFast()
+	 */
+	uint32 getBitsFast(size_t n) {
+		const uint32 b = peekBitsFast(n);
+
+		skipBits(n);
+
+		return b;
+	}
+
+	/**
+	 * Skip at most 32 bits, without any checks.
+	 *
+	 * @see peekBitsFast()
+	 */
+	void skipFast(uint32 n) {
+		fillContainerFast(n);
+		skipBits(n);
+	}
+
 	/**
 	 * Add a bit to the value x, making it an n+1-bit value.
 	 *
@@ -24,6 +24,7 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -47,6 +48,9 @@ char const *const ConfigManager::kKeymapperDomain = "keymapper";
 char const *const ConfigManager::kCloudDomain = "cloud";
 #endif
 
+// Start above the revision of new Key handles, so that they are looked up
+uint32 ConfigManager::Domain::_revision = 1;
+
 #pragma mark -
 
 
@@ -250,60 +254,69 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	// Generate the whole file in memory first. Only the domains which
+	// changed since the last flush need to be serialized again.
+	MemoryWriteStreamDynamic contents(DisposeAfterUse::YES);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(contents, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(contents, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(contents, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(contents, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
 	// Note: It's possible for _domainSaveOrder to list domains which
 	// are not present anymore, so we validate each name.
+	HashMap<String, bool> savedDomains;
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
+		savedDomains[*i] = true;
 		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+			writeDomain(contents, *i, _gameDomains[*i]);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
-		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+		if (!savedDomains.contains(d->_key))
+			writeDomain(contents, d->_key, d->_value);
 	}
 
+	// The previous file is only replaced once the new one is complete, on
+	// backends which support it.
+	WriteStream *stream;
+
+	if (_filename.empty()) {
+		// Write to the default config file
+		assert(g_system);
+		stream = g_system->createConfigWriteStream();
+		if (!stream)    // If writing to the config file is not possible, do nothing
+			return;
+	} else {
+		stream = FSNode(_filename).createAtomicWriteStream();
+
+		if (!stream) {
+			warning("Unable to write configuration file: %s", _filename.c_str());
+			return;
+		}
+	}
+
+	stream->write(contents.getData(), contents.size());
+	stream->finalize();
+	if (stream->err())
+		warning("Unable to write configuration file: %s", _filename.empty() ? g_system->getDefaultConfigFileName().c_str() : _filename.c_str());
+
 	delete stream;
 
 #endif // !__DC__
@@ -332,22 +345,27 @@ void ConfigManager::writeDomain(WriteStream &stream, const String &name, const D
 	stream.writeByte(']');
 	stream.writeByte('\n');
 
-	// Write all key/value pairs in this domain, including comments
-	Domain::const_iterator x;
-	for (x = domain.begin(); x != domain.end(); ++x) {
-		if (!x->_value.empty()) {
-			// Write comment (if any)
-			if (domain.hasKVComment(x->_key)) {
-				comment = domain.getKVComment(x->_key);
-				stream.writeString(comment);
+	if (!domain._bodyValid) {
+		domain._body.clear();
+
+		// Write all key/value pairs in this domain, including comments
+		Domain::const_iterator x;
+		for (x = domain.begin(); x != domain.end(); ++x) {
+			if (!x->_value.empty()) {
+				// Write comment (if any)
+				if (domain.hasKVComment(x->_key))
+					domain._body += domain.getKVComment(x->_key);
+				// Write the key/value pair
+				domain._body += x->_key;
+				domain._body += '=';
+				domain._body += x->_value;
+				domain._body += '\n';
 			}
-			// Write the key/value pair
-			stream.writeString(x->_key);
-			stream.writeByte('=');
-			stream.writeString(x->_value);
-			stream.writeByte('\n');
 		}
+		domain._bodyValid = true;
 	}
+
+	stream.writeString(domain._body);
 	stream.writeByte('\n');
 }
 
@@ -480,8 +498,7 @@ const String &ConfigManager::get(const String &key, const String &domName) const
 	return _defaultsDomain.getValOrDefault(key);
 }
 
-int ConfigManager::getInt(const String &key, const String &domName) const {
-	String value(get(key, domName));
+static int parseConfigInt(const String &value, const String &key, const String &domName) {
 	char *errpos;
 
 	// For now, be tolerant against missing config keys. Strictly spoken, it is
@@ -501,8 +518,7 @@ int ConfigManager::getInt(const String &key, const String &domName) const {
 	return ivalue;
 }
 
-bool ConfigManager::getBool(const String &key, const String &domName) const {
-	String value(get(key, domName));
+static bool parseConfigBool(const String &value, const String &key, const String &domName) {
 	bool val;
 	if (parseBool(value, val))
 		return val;
@@ -511,6 +527,41 @@ bool ConfigManager::getBool(const String &key, const String &domName) const {
 	      key.c_str(), domName.c_str(), value.c_str());
 }
 
+int ConfigManager::getInt(const String &key, const String &domName) const {
+	return parseConfigInt(get(key, domName), key, domName);
+}
+
+bool ConfigManager::getBool(const String &key, const String &domName) const {
+	return parseConfigBool(get(key, domName), key, domName);
+}
+
+void ConfigManager::lookUp(const Key &key) const {
+	if (key._revision == Domain::_revision)
+		return;
+
+	key._found = hasKey(key._name);
+	key._value = &get(key._name);
+	key._revision = Domain::_revision;
+}
+
+bool ConfigManager::hasKey(const Key &key) const {
+	lookUp(key);
+	return key._found;
+}
+
+const String &ConfigManager::get(const Key &key) const {
+	lookUp(key);
+	return *key._value;
+}
+
+int ConfigManager::getInt(const Key &key) const {
+	return parseConfigInt(get(key), key._name, String());
+}
+
+bool ConfigManager::getBool(const Key &key) const {
+	return parseConfigBool(get(key), key._name, String());
+}
+
 
 #pragma mark -
 
@@ -618,6 +669,9 @@ void ConfigManager::registerDefault(const String &key, bool value) {
 
 
 void ConfigManager::setActiveDomain(const String &domName) {
+	// The values found through Key handles depend on the active domain
+	Domain::_revision++;
+
 	if (domName.empty()) {
 		_activeDomain = nullptr;
 	} else {
@@ -711,6 +765,23 @@ bool ConfigManager::hasMiscDomain(const String &domName) const {
 
 #pragma mark -
 
+ConfigManager::Domain::Domain(const Domain &other)
+	: _entries(other._entries), _keyValueComments(other._keyValueComments), _domainComment(other._domainComment),
+	  _body(other._body), _bodyValid(other._bodyValid) {
+}
+
+ConfigManager::Domain &ConfigManager::Domain::operator=(const Domain &other) {
+	if (this != &other) {
+		_entries = other._entries;
+		_keyValueComments = other._keyValueComments;
+		_domainComment = other._domainComment;
+		_body = other._body;
+		_bodyValid = other._bodyValid;
+		_revision++;
+	}
+	return *this;
+}
+
 void ConfigManager::Domain::setDomainComment(const String &comment) {
 	_domainComment = comment;
 }
@@ -719,6 +790,7 @@ const String &ConfigManager::Domain::getDomainComment() const {
 }
 
 void ConfigManager::Domain::setKVComment(const String &key, const String &comment) {
+	_bodyValid = false;
 	_keyValueComments[key] = comment;
 }
 const String &ConfigManager::Domain::getKVComment(const String &key) const {
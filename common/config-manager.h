@@ -58,11 +58,27 @@ public:
 
 	class Domain {
 	private:
+		friend class ConfigManager;
+
 		StringMap _entries;
 		StringMap _keyValueComments;
 		String _domainComment;
 
+		/** The key/value lines written by the last flush, reused while the domain is unchanged. */
+		mutable String _body;
+		mutable bool _bodyValid;
+
+		/** Incremented whenever any domain changes, see ConfigManager::Key. */
+		static uint32 _revision;
+
+		void           modified() { _bodyValid = false; _revision++; }
+
 	public:
+		Domain() : _bodyValid(false) {}
+		Domain(const Domain &other);
+		~Domain() { _revision++; }
+		Domain &operator=(const Domain &other);
+
 		typedef StringMap::const_iterator const_iterator;
 		const_iterator begin() const { return _entries.begin(); } /*!< Return the beginning position of configuration entries. */
 		const_iterator end()   const { return _entries.end(); }   /*!< Return the ending position of configuration entries. */
@@ -79,10 +95,10 @@ public:
 		 */
 		const String &operator[](const String &key) const { return _entries[key]; }
 
-		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const String &key, const String &value) { modified(); _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
 
-		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(key); }
-		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
+		String &getOrCreateVal(const String &key) { modified(); return _entries.getOrCreateVal(key); }
+		String        &getVal(const String &key) { _bodyValid = false; return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
 		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
          /**
           * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
@@ -92,9 +108,9 @@ public:
 		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(key); }
 		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
 
-		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
+		void           clear() { modified(); _entries.clear(); } /*!< Clear all configuration entries in the domain. */
 
-		void           erase(const String &key) { _entries.erase(key); } /*!< Remove a key from the domain. */
+		void           erase(const String &key) { modified(); _entries.erase(key); } /*!< Remove a key from the domain. */
 
 		void           setDomainComment(const String &comment); /*!< Add a @p comment for this configuration domain. */
 		const String  &getDomainComment() const; /*!< Retrieve the comment of this configuration domain. */
@@ -107,6 +123,30 @@ public:
 	/** A hash map of existing configuration domains. */
 	typedef HashMap<String, Domain, IgnoreCase_Hash, IgnoreCase_EqualTo> DomainMap;
 
+	/**
+	 * A handle to a configuration key for the generic access methods, which
+	 * remembers where the value was found. Until any domain changes, or the
+	 * active domain is switched, queries through the same handle neither
+	 * hash the key nor search the domains again.
+	 *
+	 * Create handles once, e.g. as static variables, for keys which are
+	 * read often.
+	 */
+	class Key {
+	public:
+		explicit Key(const char *name) : _name(name), _revision(0), _found(false), _value(nullptr) {}
+
+		const String &getName() const { return _name; } /*!< Return the name of the key. */
+
+	private:
+		friend class ConfigManager;
+
+		String _name;
+		mutable uint32 _revision;
+		mutable bool _found;
+		mutable const String *_value;
+	};
+
 	/** The name of the application domain (normally 'scummvm'). */
 	static char const *const kApplicationDomain;
 
@@ -143,6 +183,11 @@ public:
 	bool                     hasKey(const String &key) const; /*!< Check if a given @p key exists. */
 	const String            &get(const String &key) const;    /*!< Get the value of a @p key. */
 	void                     set(const String &key, const String &value); /*!< Assign a @p value to a @p key. */
+
+	bool                     hasKey(const Key &key) const; /*!< @overload */
+	const String            &get(const Key &key) const;    /*!< @overload */
+	int                      getInt(const Key &key) const; /*!< Get integer value of a @p key. */
+	bool                     getBool(const Key &key) const; /*!< Get Boolean value of a @p key. */
     /** @} */
 
 	/**
@@ -218,6 +263,7 @@ private:
 	void			addDomain(const String &domainName, const Domain &domain);
 	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
+	void			lookUp(const Key &key) const;
 
 	Domain			_transientDomain;
 	DomainMap		_gameDomains;
@@ -25,6 +25,7 @@
 #include "common/debug.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/memorypool.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -72,6 +73,54 @@ static void displayCoroStats() {
 } // End of anonymous namespace
 #endif
 
+namespace {
+
+// Contexts are rounded up to a multiple of this, and the ones up to
+// kNumContextPools times that size come from the pools.
+const size_t kContextSizeGranularity = 16;
+const uint kNumContextPools = 16;
+
+// Coroutines only ever run on the engine thread
+MemoryPool *s_contextPools[kNumContextPools];
+uint s_liveContexts = 0;
+uint s_contextAllocations = 0;
+
+} // End of anonymous namespace
+
+void *CoroBaseContext::operator new(size_t size) {
+	s_liveContexts++;
+	s_contextAllocations++;
+
+	const uint sizeClass = (size - 1) / kContextSizeGranularity;
+	if (sizeClass >= kNumContextPools)
+		return ::operator new(size);
+
+	if (!s_contextPools[sizeClass])
+		s_contextPools[sizeClass] = new MemoryPool((sizeClass + 1) * kContextSizeGranularity);
+	return s_contextPools[sizeClass]->allocChunk();
+}
+
+void CoroBaseContext::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	s_liveContexts--;
+
+	const uint sizeClass = (size - 1) / kContextSizeGranularity;
+	if (sizeClass >= kNumContextPools)
+		::operator delete(ptr);
+	else
+		s_contextPools[sizeClass]->freeChunk(ptr);
+}
+
+uint CoroBaseContext::getLiveCount() {
+	return s_liveContexts;
+}
+
+uint CoroBaseContext::getAllocationCount() {
+	return s_contextAllocations;
+}
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(nullptr) {
 #ifdef COROUTINE_DEBUG
@@ -107,6 +156,8 @@ CoroutineScheduler::CoroutineScheduler() {
 
 	pRCfunction = nullptr;
 	pidCounter = 0;
+	_eventsPulsed = false;
+	_lastTickAllocations = 0;
 
 	active = new PROCESS;
 	active->pPrevious = nullptr;
@@ -131,9 +182,8 @@ CoroutineScheduler::~CoroutineScheduler() {
 	active = nullptr;
 
 	// Clear the event list
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i)
-		delete *i;
+	for (Common::HashMap<uint32, EVENT *>::iterator i = _events.begin(); i != _events.end(); ++i)
+		delete i->_value;
 }
 
 void CoroutineScheduler::reset() {
@@ -166,6 +216,7 @@ void CoroutineScheduler::reset() {
 
 	// no active processes
 	pCurrent = active->pNext = nullptr;
+	_activePids.clear();
 
 	// place first process on free list
 	pFreeProcesses = processList;
@@ -181,6 +232,8 @@ void CoroutineScheduler::reset() {
 #ifdef DEBUG
 void CoroutineScheduler::printStats() {
 	debug("%i process of %i used", maxProcs, CORO_NUM_PROCESS);
+	debug("%u coroutine contexts allocated, %u during the last tick",
+	      CoroBaseContext::getLiveCount(), _lastTickAllocations);
 }
 #endif
 
@@ -220,6 +273,8 @@ void CoroutineScheduler::checkStack() {
 #endif
 
 void CoroutineScheduler::schedule() {
+	const uint allocations = CoroBaseContext::getAllocationCount();
+
 	// start dispatching active process list
 	PROCESS *pNext;
 	PROCESS *pProc = active->pNext;
@@ -248,13 +303,17 @@ void CoroutineScheduler::schedule() {
 	}
 
 	// Disable any events that were pulsed
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pulsing) {
-			evt->pulsing = evt->signalled = false;
+	if (_eventsPulsed) {
+		for (Common::HashMap<uint32, EVENT *>::iterator i = _events.begin(); i != _events.end(); ++i) {
+			EVENT *evt = i->_value;
+			if (evt->pulsing) {
+				evt->pulsing = evt->signalled = false;
+			}
 		}
+		_eventsPulsed = false;
 	}
+
+	_lastTickAllocations = CoroBaseContext::getAllocationCount() - allocations;
 }
 
 void CoroutineScheduler::rescheduleAll() {
@@ -348,7 +407,7 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -365,12 +424,12 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
 		// Check to see if a process or event with the given Id exists
-		_ctx->pProcess = getProcess(pid);
-		_ctx->pEvent = !_ctx->pProcess ? getEvent(pid) : nullptr;
+		_ctx->processActive = isProcessActive(pid);
+		_ctx->pEvent = !_ctx->processActive ? getEvent(pid) : nullptr;
 
 		// If there's no active process or event, presume it's a process that's finished,
 		// so the waiting can immediately exit
-		if ((_ctx->pProcess == nullptr) && (_ctx->pEvent == nullptr)) {
+		if (!_ctx->processActive && (_ctx->pEvent == nullptr)) {
 			if (expired)
 				*expired = false;
 			break;
@@ -408,7 +467,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		bool signalled;
 		bool pidSignalled;
 		int i;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -428,11 +487,11 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		_ctx->signalled = bWaitAll;
 
 		for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
-			_ctx->pProcess = getProcess(pidList[_ctx->i]);
-			_ctx->pEvent = !_ctx->pProcess ? getEvent(pidList[_ctx->i]) : nullptr;
+			_ctx->processActive = isProcessActive(pidList[_ctx->i]);
+			_ctx->pEvent = !_ctx->processActive ? getEvent(pidList[_ctx->i]) : nullptr;
 
 			// Determine the signalled state
-			_ctx->pidSignalled = (_ctx->pProcess) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
+			_ctx->pidSignalled = _ctx->processActive || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
 
 			if (bWaitAll && !_ctx->pidSignalled)
 				_ctx->signalled = false;
@@ -539,6 +598,7 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// set new process id
 	pProc->pid = pid;
+	addActivePid(pid);
 
 	// set new process specific info
 	if (sizeParam) {
@@ -580,6 +640,7 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 
 	delete pKillProc->state;
 	pKillProc->state = nullptr;
+	removeActivePid(pKillProc->pid);
 
 	// Take the process out of the active chain list
 	pKillProc->pPrevious->pNext = pKillProc->pNext;
@@ -629,6 +690,7 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 
 				delete pProc->state;
 				pProc->state = nullptr;
+				removeActivePid(pProc->pid);
 
 				// make prev point to next to unlink pProc
 				pPrev->pNext = pProc->pNext;
@@ -663,23 +725,23 @@ void CoroutineScheduler::setResourceCallback(VFPTRPP pFunc) {
 	pRCfunction = pFunc;
 }
 
-PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
-	PROCESS *pProc = active->pNext;
-	while ((pProc != nullptr) && (pProc->pid != pid))
-		pProc = pProc->pNext;
-
-	return pProc;
+bool CoroutineScheduler::isProcessActive(uint32 pid) const {
+	return _activePids.contains(pid);
 }
 
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pid == pid)
-			return evt;
-	}
+	return _events.getValOrDefault(pid);
+}
+
+void CoroutineScheduler::addActivePid(uint32 pid) {
+	_activePids[pid]++;
+}
 
-	return nullptr;
+void CoroutineScheduler::removeActivePid(uint32 pid) {
+	Common::HashMap<uint32, uint>::iterator i = _activePids.find(pid);
+	assert(i != _activePids.end());
+	if (--i->_value == 0)
+		_activePids.erase(i);
 }
 
 
@@ -690,14 +752,14 @@ uint32 CoroutineScheduler::createEvent(bool bManualReset, bool bInitialState) {
 	evt->signalled = bInitialState;
 	evt->pulsing = false;
 
-	_events.push_back(evt);
+	_events[evt->pid] = evt;
 	return evt->pid;
 }
 
 void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
 	if (evt) {
-		_events.remove(evt);
+		_events.erase(pidEvent);
 		delete evt;
 	}
 }
@@ -722,6 +784,7 @@ void CoroutineScheduler::pulseEvent(uint32 pidEvent) {
 	// Set the event as signalled and pulsing
 	evt->signalled = true;
 	evt->pulsing = true;
+	_eventsPulsed = true;
 
 	// If there's an active process, and it's not the first in the queue, then reschedule all
 	// the other prcoesses in the queue to run again this frame
@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/util.h"    // for SCUMMVM_CURRENT_FUNCTION
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/singleton.h"
 
@@ -68,6 +69,19 @@ struct CoroBaseContext {
 	 * Destructor for coroutine context.
 	 */
 	virtual ~CoroBaseContext();
+
+	/**
+	 * Contexts are allocated from pools of a few size classes, as coroutines
+	 * create and delete them on every invocation.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
+
+	/** Return the number of contexts currently allocated. */
+	static uint getLiveCount();
+
+	/** Return the number of contexts allocated since the start. */
+	static uint getAllocationCount();
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -359,8 +373,20 @@ private:
 	/** Auto-incrementing process ID. */
 	int pidCounter;
 
-	/** Event list. */
-	Common::List<EVENT *> _events;
+	/** Events, indexed by their ID. */
+	Common::HashMap<uint32, EVENT *> _events;
+
+	/** Whether an event was pulsed during this tick. */
+	bool _eventsPulsed;
+
+	/**
+	 * Number of active processes for each process ID, so that waiting on a
+	 * process does not need to walk the active process list.
+	 */
+	Common::HashMap<uint32, uint> _activePids;
+
+	/** Number of contexts allocated during the last schedule() call. */
+	uint _lastTickAllocations;
 
 #ifdef DEBUG
     /** Diagnostic process counters. */
@@ -380,8 +406,11 @@ private:
 	 */
 	VFPTRPP pRCfunction;
 
-	PROCESS *getProcess(uint32 pid);
+	bool isProcessActive(uint32 pid) const;
 	EVENT *getEvent(uint32 pid);
+
+	void addActivePid(uint32 pid);
+	void removeActivePid(uint32 pid);
 public:
 	/**
 	 * Kill all processes and place them on the free list.
@@ -400,6 +429,12 @@ public:
 	 */
 	void schedule();
 
+	/**
+	 * Return the number of coroutine contexts allocated during the last
+	 * schedule() call.
+	 */
+	uint getLastTickAllocations() const { return _lastTickAllocations; }
+
 	/**
 	 * Reschedule all processes to run again this tick.
 	 */
@@ -23,10 +23,37 @@
 // Based on eos' cosine tables
 
 #include "common/cosinetables.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
 #include "common/scummsys.h"
 
 namespace Common {
 
+namespace {
+
+struct SharedCosineTable {
+	CosineTable *table;
+	int refCount;
+
+	SharedCosineTable() : table(nullptr), refCount(0) {}
+};
+
+typedef HashMap<int, SharedCosineTable> SharedCosineTableMap;
+
+// Codecs are usually created on the main thread, but audio streams may
+// also set up their transforms from the mixer thread.
+Mutex &getSharedTablesMutex() {
+	static Mutex *mutex = new Mutex();
+	return *mutex;
+}
+
+SharedCosineTableMap &getSharedTables() {
+	static SharedCosineTableMap *tables = new SharedCosineTableMap();
+	return *tables;
+}
+
+} // End of anonymous namespace
+
 CosineTable::CosineTable(int nPoints) {
 	assert((nPoints >= 16) && (nPoints <= 65536)); // log2 space is in [4,16]
 	assert(nPoints % 4 == 0);
@@ -76,4 +103,29 @@ CosineTable::~CosineTable() {
 	delete[] _table;
 }
 
+const CosineTable *CosineTable::getShared(int nPoints) {
+	StackLock lock(getSharedTablesMutex());
+
+	SharedCosineTable &shared = getSharedTables()[nPoints];
+	if (!shared.table)
+		shared.table = new CosineTable(nPoints);
+	shared.refCount++;
+	return shared.table;
+}
+
+void CosineTable::releaseShared(const CosineTable *table) {
+	if (!table)
+		return;
+
+	StackLock lock(getSharedTablesMutex());
+
+	SharedCosineTableMap &tables = getSharedTables();
+	SharedCosineTable &shared = tables[table->_nPoints];
+	assert(shared.table == table);
+	if (--shared.refCount == 0) {
+		delete shared.table;
+		tables.erase(table->_nPoints);
+	}
+}
+
 } // End of namespace Common
@@ -30,6 +30,8 @@ namespace Common {
 
 class DecompressorDCL {
 public:
+	DecompressorDCL();
+
 	bool unpack(SeekableReadStream *sourceStream, WriteStream *targetStream, uint32 targetSize, bool targetFixedSize);
 
 protected:
@@ -62,7 +64,28 @@ protected:
 	 */
 	void putByte(byte b);
 
-	int huffman_lookup(const int *tree);
+	enum {
+		kLookupBits = 8,
+		kLookupLeaf = 0x8000
+	};
+
+	/**
+	 * Fill the lookup table of a tree from one of its nodes.
+	 * @param code	the bits leading to the node, the first one read in bit 0
+	 * @param depth	the number of these bits
+	 */
+	static void buildLookup(const int *tree, uint16 *lookup, int pos, uint code, int depth);
+
+	/**
+	 * Decode a value with the lookup table of its tree. Each entry, indexed by
+	 * the next kLookupBits bits, is either a leaf with the value in the low
+	 * byte and its code length above, or the node reached after these bits.
+	 */
+	int huffman_lookup(const int *tree, const uint16 *lookup);
+
+	uint16 _lengthLookup[1 << kLookupBits];
+	uint16 _distanceLookup[1 << kLookupBits];
+	uint16 _asciiLookup[1 << kLookupBits];
 
 	uint32 _dwBits;			///< bits buffer
 	byte _nBits;			///< number of unread bits in _dwBits
@@ -87,11 +110,16 @@ void DecompressorDCL::init(SeekableReadStream *sourceStream, WriteStream *target
 }
 
 void DecompressorDCL::fetchBitsLSB() {
-	while (_nBits <= 24) {
-		_dwBits |= ((uint32)_sourceStream->readByte()) << _nBits;
+	// Read all the bytes which fit in one go. Past the end of the source,
+	// they are zero, as from readByte().
+	byte buffer[4] = { 0, 0, 0, 0 };
+	const int count = (32 - _nBits) / 8;
+	_sourceStream->read(buffer, count);
+	for (int i = 0; i < count; i++) {
+		_dwBits |= ((uint32)buffer[i]) << _nBits;
 		_nBits += 8;
-		_bytesRead++;
 	}
+	_bytesRead += count;
 }
 
 uint32 DecompressorDCL::getBitsLSB(int n) {
@@ -316,8 +344,38 @@ static const int ascii_tree[] = {
 	LN(509, 128)      LN(510, 26)
 };
 
-int DecompressorDCL::huffman_lookup(const int *tree) {
-	int pos = 0;
+DecompressorDCL::DecompressorDCL() {
+	buildLookup(length_tree, _lengthLookup, 0, 0, 0);
+	buildLookup(distance_tree, _distanceLookup, 0, 0, 0);
+	buildLookup(ascii_tree, _asciiLookup, 0, 0, 0);
+}
+
+void DecompressorDCL::buildLookup(const int *tree, uint16 *lookup, int pos, uint code, int depth) {
+	if (tree[pos] & HUFFMAN_LEAF) {
+		const uint16 entry = kLookupLeaf | (depth << 8) | (tree[pos] & 0xFF);
+		for (uint i = code; i < (1 << kLookupBits); i += 1 << depth)
+			lookup[i] = entry;
+	} else if (depth == kLookupBits) {
+		lookup[code] = pos;
+	} else {
+		buildLookup(tree, lookup, tree[pos] >> 12, code, depth + 1);
+		buildLookup(tree, lookup, tree[pos] & 0xFFF, code | (1 << depth), depth + 1);
+	}
+}
+
+int DecompressorDCL::huffman_lookup(const int *tree, const uint16 *lookup) {
+	if (_nBits < kLookupBits)
+		fetchBitsLSB();
+
+	const uint16 entry = lookup[_dwBits & ((1 << kLookupBits) - 1)];
+	if (entry & kLookupLeaf) {
+		getBitsLSB((entry >> 8) & 0xF);
+		return entry & 0xFF;
+	}
+
+	// The longer codes of the ASCII tree go on bit by bit
+	getBitsLSB(kLookupBits);
+	int pos = entry;
 
 	while (!(tree[pos] & HUFFMAN_LEAF)) {
 		int bit = getBitsLSB(1);
@@ -342,6 +400,7 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 	int value;
 	uint16 tokenOffset = 0;
 	uint16 tokenLength = 0;
+	byte   tokenBuffer[518];
 
 	init(sourceStream, targetStream, targetSize, targetFixedSize);
 
@@ -374,7 +433,7 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 
 	while ((!targetFixedSize) || (_bytesWritten < _targetSize)) {
 		if (getBitsLSB(1)) { // (length,distance) pair
-			value = huffman_lookup(length_tree);
+			value = huffman_lookup(length_tree, _lengthLookup);
 
 			if (value < 8)
 				tokenLength = value + 2;
@@ -386,7 +445,7 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 
 			debug(8, " | ");
 
-			value = huffman_lookup(distance_tree);
+			value = huffman_lookup(distance_tree, _distanceLookup);
 
 			if (tokenLength == 2)
 				tokenOffset = (value << 2) | getBitsLSB(2);
@@ -414,9 +473,22 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 			uint16 dictionaryIndex = dictionaryBaseIndex;
 			uint16 dictionaryNextIndex = dictionaryPos;
 
+			if (tokenOffset >= tokenLength && dictionaryBaseIndex + tokenLength <= dictionarySize && dictionaryPos + tokenLength <= dictionarySize) {
+				// The bytes do not repeat and do not wrap around the dictionary,
+				// so they can be copied as a block. The source may be ahead of
+				// the destination, which the byte copy handled as memmove does.
+				memmove(dictionary + dictionaryPos, dictionary + dictionaryBaseIndex, tokenLength);
+				_targetStream->write(dictionary + dictionaryPos, tokenLength);
+				_bytesWritten += tokenLength;
+				dictionaryPos = (dictionaryPos + tokenLength) & dictionaryMask;
+				continue;
+			}
+
+			const uint16 tokenSize = tokenLength;
+			byte *token = tokenBuffer;
 			while (tokenLength) {
 				// Write byte from dictionary
-				putByte(dictionary[dictionaryIndex]);
+				*token++ = dictionary[dictionaryIndex];
 				debug(9, "\33[32;31m%02x\33[37;37m ", dictionary[dictionaryIndex]);
 
 				dictionary[dictionaryNextIndex] = dictionary[dictionaryIndex];
@@ -431,11 +503,13 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 
 				tokenLength--;
 			}
+			_targetStream->write(tokenBuffer, tokenSize);
+			_bytesWritten += tokenSize;
 			dictionaryPos = dictionaryNextIndex;
 			debug(9, "\n");
 
 		} else { // Copy byte verbatim
-			value = (mode == DCL_ASCII_MODE) ? huffman_lookup(ascii_tree) : getByteLSB();
+			value = (mode == DCL_ASCII_MODE) ? huffman_lookup(ascii_tree, _asciiLookup) : getByteLSB();
 			putByte(value);
 
 			// Also remember it inside dictionary
@@ -70,7 +70,7 @@ private:
 	int _bits;
 	TransformType _trans;
 
-	CosineTable _cos;
+	const CosineTable *_cos;
 	const float *_tCos;
 
 	float *_csc2;
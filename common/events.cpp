@@ -50,6 +50,16 @@ EventMapper::~EventMapper() {}
 
 EventManager::~EventManager() {}
 
+bool EventManager::pollEvents(Array<Event> &events) {
+	events.clear();
+
+	Event event;
+	while (pollEvent(event))
+		events.push_back(event);
+
+	return !events.empty();
+}
+
 EventDispatcher::EventDispatcher() : _mapper(nullptr) {
 }
 
@@ -23,6 +23,7 @@
 #ifndef COMMON_EVENTS_H
 #define COMMON_EVENTS_H
 
+#include "common/array.h"
 #include "common/keyboard.h"
 #include "common/queue.h"
 #include "common/rect.h"
@@ -472,6 +473,19 @@ public:
 	 */
 	virtual bool pollEvent(Event &event) = 0;
 
+	/**
+	 * Get all the events in the event queue at once, as pollEvent() would
+	 * one after the other. The sources are only polled once, so this is
+	 * cheaper for engines which go through all the pending events anyway.
+	 *
+	 * The state of the event manager, such as the mouse position, is the one
+	 * after the last of the events.
+	 *
+	 * @param events	Array to fill with the events, it is cleared first.
+	 * @retval true If any event was retrieved.
+	 */
+	virtual bool pollEvents(Array<Event> &events);
+
 	/**
 	 * Push a "fake" event into the event queue.
 	 */
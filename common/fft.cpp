@@ -31,6 +31,14 @@
 #include "common/util.h"
 #include "common/textconsole.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FFT_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FFT_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
 FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
@@ -51,7 +59,7 @@ FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
 	for (int i = 0; i < ARRAYSIZE(_cosTables); i++) {
 		if (i + 4 <= _bits) {
 			nPoints = 1 << (i + 4);
-			_cosTables[i] = new Common::CosineTable(nPoints);
+			_cosTables[i] = CosineTable::getShared(nPoints);
 		}
 		else
 			_cosTables[i] = nullptr;
@@ -60,7 +68,7 @@ FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
 
 FFT::~FFT() {
 	for (int i = 0; i < ARRAYSIZE(_cosTables); i++) {
-		delete _cosTables[i];
+		CosineTable::releaseShared(_cosTables[i]);
 	}
 
 	delete[] _revTab;
@@ -176,10 +184,101 @@ static void name(Complex *z, const float *wre, unsigned int n) { \
 	} while(--n);\
 }
 
+#if !defined(FFT_USE_SSE2) && !defined(FFT_USE_NEON)
 PASS(pass)
+#endif
 #undef BUTTERFLIES
 #define BUTTERFLIES BUTTERFLIES_BIG
+#if !defined(FFT_USE_SSE2) && !defined(FFT_USE_NEON)
 PASS(pass_big)
+#endif
+
+#if defined(FFT_USE_SSE2) || defined(FFT_USE_NEON)
+
+// The same pass as above, transforming the two Complex values handled by
+// each step of the loop at once. All the inputs are loaded before storing
+// anything, so it also replaces pass_big(). The results are identical to the
+// scalar version, as the operations are done in the same order.
+
+#ifdef FFT_USE_SSE2
+
+typedef __m128 FFTVector;
+
+#define VLOAD(p)    _mm_loadu_ps(&(p).re)
+#define VLOADF(p)   _mm_loadu_ps(p)
+#define VSTORE(p, x) _mm_storeu_ps(&(p).re, x)
+#define VSET(a, b)  _mm_setr_ps(a, a, b, b)
+#define VADD(x, y)  _mm_add_ps(x, y)
+#define VSUB(x, y)  _mm_sub_ps(x, y)
+#define VMUL(x, y)  _mm_mul_ps(x, y)
+#define VSWAP(x)    _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1))
+
+#else
+
+typedef float32x4_t FFTVector;
+
+#define VLOAD(p)    vld1q_f32(&(p).re)
+#define VLOADF(p)   vld1q_f32(p)
+#define VSTORE(p, x) vst1q_f32(&(p).re, x)
+#define VSET(a, b)  vcombine_f32(vdup_n_f32(a), vdup_n_f32(b))
+#define VADD(x, y)  vaddq_f32(x, y)
+#define VSUB(x, y)  vsubq_f32(x, y)
+#define VMUL(x, y)  vmulq_f32(x, y)
+#define VSWAP(x)    vrev64q_f32(x)
+
+#endif
+
+static inline void transform2(Complex *z, int o1, int o2, int o3, const FFTVector &wre, const FFTVector &wim, const FFTVector &signIm) {
+	const FFTVector a0 = VLOAD(z[0]);
+	const FFTVector a1 = VLOAD(z[o1]);
+	const FFTVector a2 = VLOAD(z[o2]);
+	const FFTVector a3 = VLOAD(z[o3]);
+
+	// { t1, t2 } and { t5, t6 } of TRANSFORM for both values
+	const FFTVector t12 = VADD(VMUL(a2, wre), VMUL(VMUL(VSWAP(a2), wim), signIm));
+	const FFTVector t56 = VSUB(VMUL(a3, wre), VMUL(VMUL(VSWAP(a3), wim), signIm));
+
+	// BUTTERFLIES
+	const FFTVector sum = VADD(t56, t12);
+	const FFTVector diff = VSWAP(VMUL(VSUB(t56, t12), signIm));
+
+	VSTORE(z[o2], VSUB(a0, sum));
+	VSTORE(z[0], VADD(a0, sum));
+	VSTORE(z[o3], VSUB(a1, diff));
+	VSTORE(z[o1], VADD(a1, diff));
+}
+
+static void pass_simd(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Flips the sign of the imaginary parts
+	static const float signs[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+	const FFTVector signIm = VLOADF(signs);
+
+	// The first value is the TRANSFORM_ZERO one
+	transform2(z, o1, o2, o3, VSET(1.0f, wre[1]), VSET(0.0f, wim[-1]), signIm);
+
+	for (unsigned int i = 1; i < n; i++) {
+		z += 2;
+		wre += 2;
+		wim -= 2;
+		transform2(z, o1, o2, o3, VSET(wre[0], wre[1]), VSET(wim[0], wim[-1]), signIm);
+	}
+}
+
+#undef VLOAD
+#undef VLOADF
+#undef VSTORE
+#undef VSET
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VSWAP
+
+#endif
 
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
@@ -245,10 +344,14 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
+#if defined(FFT_USE_SSE2) || defined(FFT_USE_NEON)
+		pass_simd(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#else
 		if (n > 1024)
 			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
 		else
 			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#endif
 	}
 }
 
@@ -81,7 +81,7 @@ private:
 
 	static int splitRadixPermutation(int i, int n, int inverse);
 
-	CosineTable *_cosTables[13];
+	const CosineTable *_cosTables[13];
 
 	void fft4(Complex *z);
 	void fft8(Complex *z);
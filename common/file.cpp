@@ -74,6 +74,38 @@ bool File::open(const FSNode &node) {
 	return open(stream, node.getPath());
 }
 
+bool File::openMapped(const String &filename) {
+	assert(!filename.empty());
+	assert(!_handle);
+
+	ArchiveMemberPtr member = SearchMan.getMember(filename);
+	if (!member)
+		member = SearchMan.getMember(filename + ".");
+
+	// Only files in plain directories can be mapped
+	const FSNode *node = dynamic_cast<const FSNode *>(member.get());
+	if (!node)
+		return open(filename);
+
+	debug(8, "Opening mapped: %s", filename.c_str());
+	return open(node->createMappedReadStream(), filename);
+}
+
+bool File::openMapped(const FSNode &node) {
+	assert(!_handle);
+
+	if (!node.exists()) {
+		warning("File::openMapped: '%s' does not exist", node.getPath().c_str());
+		return false;
+	} else if (node.isDirectory()) {
+		warning("File::openMapped: '%s' is a directory", node.getPath().c_str());
+		return false;
+	}
+
+	SeekableReadStream *stream = node.createMappedReadStream();
+	return open(stream, node.getPath());
+}
+
 bool File::open(SeekableReadStream *stream, const String &name) {
 	assert(!_handle);
 
@@ -143,6 +175,11 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+SeekableReadStream *File::readStream(uint32 dataSize) {
+	assert(_handle);
+	return _handle->readStream(dataSize);
+}
+
 
 DumpFile::DumpFile() : _handle(nullptr) {
 }
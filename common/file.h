@@ -96,6 +96,29 @@ public:
 	 */
 	virtual bool open(const FSNode &node);
 
+	/**
+	 * Try to open the file with the given file name, by searching SearchMan,
+	 * and memory-map it if it is found in a plain directory and the backend
+	 * supports it. Otherwise, this behaves like open(const String &).
+	 *
+	 * A mapped file hands out zero-copy streams from readStream().
+	 * @note Must not be called if this file is already open (i.e. if isOpen returns true).
+	 *
+	 * @param	filename	Name of the file to open.
+	 * @return	True if the file was opened successfully, false otherwise.
+	 */
+	virtual bool openMapped(const String &filename);
+
+	/**
+	 * Try to memory-map the file corresponding to the given node, falling back
+	 * to regular file access if the backend does not support mapping it.
+	 * @note Must not be called if this file already is open (i.e. if isOpen returns true).
+	 *
+	 * @param   node        The node to consider.
+	 * @return	True if the file was opened successfully, false otherwise.
+	 */
+	virtual bool openMapped(const FSNode &node);
+
 	/**
 	 * Try to 'open' the given stream. That is, wrap around it, and if the stream
 	 * is a NULL pointer, gracefully treat this as if opening failed.
@@ -134,6 +157,7 @@ public:
 	int32 size() const override; /*!< Implement abstract SeekableReadStream method. */
 	bool seek(int32 offs, int whence = SEEK_SET) override;	/*!< Implement abstract SeekableReadStream method. */
 	uint32 read(void *dataPtr, uint32 dataSize) override;	/*!< Implement abstract SeekableReadStream method. */
+	SeekableReadStream *readStream(uint32 dataSize) override;	/*!< Forward to the underlying stream, which might avoid copying. */
 };
 
 
@@ -0,0 +1,594 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/hashmap.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flathashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on an open-addressing hash table.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap<Key,Val> which
+ * stores its keys and values inline in a single array instead of allocating
+ * a separate node for every entry. The hash of every entry is cached in a
+ * parallel array, so a probe only has to touch the key when the cached hashes
+ * match.
+ *
+ * Collisions are resolved with linear probing and robin-hood ordering, and
+ * erased entries are removed via backward shifting, so no tombstones are left
+ * behind and lookup chains stay short even after many erasures.
+ *
+ * The API mirrors HashMap, with one difference: since entries are stored
+ * inline, inserting or erasing an entry may move other entries around. Any
+ * iterator, pointer or reference into the map is therefore invalidated by
+ * insertions and erasures. In particular, do not keep iterating after calling
+ * erase().
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+		Node(const Key &key, const Val &value) : _key(key), _value(value) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// Robin-hood probing keeps chains short even at high load, so we can
+		// fill the table further than HashMap does before growing it.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	/**
+	 * Marker bit set in every cached hash of an occupied slot. A cached hash
+	 * of 0 therefore always denotes an empty slot.
+	 */
+	static const size_type FLATHASHMAP_USED_BIT = 1U << (sizeof(size_type) * 8 - 1);
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	Node *_storage;         ///< Raw storage for the entries; a slot is only constructed if its hash is non-zero.
+	size_type *_hashes;     ///< Cached hashes of the entries, with FLATHASHMAP_USED_BIT set.
+	size_type _mask;        ///< Capacity of the FlatHashMap minus one; capacity must be a power of two
+	size_type _size;
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	size_type hashOf(const Key &key) const {
+		return _hash(key) | FLATHASHMAP_USED_BIT;
+	}
+
+	size_type probeDistance(size_type idx) const {
+		return (idx - (_hashes[idx] & _mask)) & _mask;
+	}
+
+	void allocStorage(size_type capacity) {
+		_mask = capacity - 1;
+		_storage = (Node *)malloc(capacity * sizeof(Node));
+		assert(_storage != nullptr);
+		_hashes = new size_type[capacity];
+		assert(_hashes != nullptr);
+		memset(_hashes, 0, capacity * sizeof(size_type));
+	}
+
+	void freeStorage() {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_hashes[ctr])
+				_storage[ctr].~Node();
+		}
+		free(_storage);
+		delete[] _hashes;
+	}
+
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type insertNew(size_type hash, const Key &key);
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void eraseAt(size_type idx);
+	void expandStorage(size_type newCapacity);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->_hashes[_idx] != 0);
+			return &_hashmap->_storage[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && _hashmap->_hashes[_idx] == 0);
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_hashes[ctr])
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_hashes[ctr])
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator	find(const Key &key) const {
+		size_type ctr = lookup(key);
+		if (ctr <= _mask)
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	_size = 0;
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) :
+	_defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage here is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// Both tables have the same capacity, so every entry can simply be
+	// cloned into the same slot.
+	_size = 0;
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (map._hashes[ctr]) {
+			new ((void *)&_storage[ctr]) Node(map._storage[ctr]);
+			_hashes[ctr] = map._hashes[ctr];
+			_size++;
+		}
+	}
+	// Perform a sanity check (to help track down hashmap corruption)
+	assert(_size == map._size);
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_hashes[ctr]) {
+				_storage[ctr].~Node();
+				_hashes[ctr] = 0;
+			}
+		}
+	}
+
+	_size = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity) {
+	assert(newCapacity > _mask + 1);
+
+	const size_type old_mask = _mask;
+	Node *old_storage = _storage;
+	size_type *old_hashes = _hashes;
+
+	allocStorage(newCapacity);
+
+	// Rehash all the old elements. The cached hashes save us from calling
+	// _hash() again, and since no key exists twice in the old table we
+	// never have to call _equal() either.
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		if (old_hashes[ctr] == 0)
+			continue;
+
+		size_type idx = old_hashes[ctr] & _mask;
+		size_type dist = 0;
+		Node carry(old_storage[ctr]);
+		size_type carryHash = old_hashes[ctr];
+		old_storage[ctr].~Node();
+
+		// Robin-hood insertion: whenever we meet an entry which is closer to
+		// its home slot than we are to ours, we take its place and move it on.
+		while (_hashes[idx]) {
+			const size_type existingDist = probeDistance(idx);
+			if (existingDist < dist) {
+				SWAP(carry, _storage[idx]);
+				SWAP(carryHash, _hashes[idx]);
+				dist = existingDist;
+			}
+			idx = (idx + 1) & _mask;
+			dist++;
+		}
+
+		new ((void *)&_storage[idx]) Node(carry);
+		_hashes[idx] = carryHash;
+	}
+
+	free(old_storage);
+	delete[] old_hashes;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const size_type hash = hashOf(key);
+	size_type ctr = hash & _mask;
+	for (size_type dist = 0; ; ++dist) {
+		// Thanks to the robin-hood ordering we can stop as soon as we reach
+		// an entry which is closer to its home slot than the key would be.
+		if (_hashes[ctr] == 0 || probeDistance(ctr) < dist)
+			return _mask + 1;
+		if (_hashes[ctr] == hash && _equal(_storage[ctr]._key, key))
+			return ctr;
+
+		ctr = (ctr + 1) & _mask;
+	}
+}
+
+/**
+ * Internal method which inserts a key known not to be present yet, and
+ * returns the slot it ended up in.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::insertNew(size_type hash, const Key &key) {
+	// Find the slot the new key belongs to: the first free slot, or the first
+	// one whose entry is closer to its home slot than the new key would be.
+	size_type pos = hash & _mask;
+	for (size_type dist = 0; _hashes[pos] && probeDistance(pos) >= dist; ++dist)
+		pos = (pos + 1) & _mask;
+
+	if (_hashes[pos]) {
+		// Shift the rest of the cluster one slot ahead; this is equivalent
+		// to the robin-hood swapping chain, but copies each entry only once.
+		size_type last = pos;
+		while (_hashes[(last + 1) & _mask])
+			last = (last + 1) & _mask;
+
+		size_type dst = (last + 1) & _mask;
+		new ((void *)&_storage[dst]) Node(_storage[last]);
+		_hashes[dst] = _hashes[last];
+		while (last != pos) {
+			dst = last;
+			last = (last - 1) & _mask;
+			_storage[dst] = _storage[last];
+			_hashes[dst] = _hashes[last];
+		}
+		_storage[pos].~Node();
+	}
+
+	new ((void *)&_storage[pos]) Node(key);
+	_hashes[pos] = hash;
+	_size++;
+
+	return pos;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return ctr;
+
+	// Keep the load factor below a certain threshold. Growing before the
+	// insertion guarantees that the returned slot stays valid.
+	size_type capacity = _mask + 1;
+	if ((_size + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR >
+	        capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		capacity = capacity < 500 ? (capacity * 4) : (capacity * 2);
+		expandStorage(capacity);
+	}
+
+	return insertNew(hashOf(key), key);
+}
+
+/**
+ * Internal method which removes the entry in the given slot and closes the
+ * gap by shifting the following entries of the cluster back by one.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseAt(size_type idx) {
+	assert(idx <= _mask);
+	assert(_hashes[idx] != 0);
+
+	size_type next = (idx + 1) & _mask;
+	while (_hashes[next] && probeDistance(next) > 0) {
+		_storage[idx] = _storage[next];
+		_hashes[idx] = _hashes[next];
+		idx = next;
+		next = (next + 1) & _mask;
+	}
+
+	_storage[idx].~Node();
+	_hashes[idx] = 0;
+	_size--;
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) <= _mask;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _storage[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _storage[ctr]._value;
+	else
+		unknownKeyError(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _storage[ctr]._value;
+	else
+		unknownKeyError(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		return _storage[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask) {
+		out = _storage[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_storage[ctr]._value = val;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	eraseAt(entry._idx);
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr <= _mask)
+		eraseAt(ctr);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,96 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/framearena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+FrameArena::FrameArena(size_t blockSize)
+	: _current(0), _offset(0), _used(0), _blockSize(blockSize) {
+	assert(blockSize > 0);
+}
+
+FrameArena::~FrameArena() {
+	freeBlocks();
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+	assert(alignment && !(alignment & (alignment - 1)));
+
+	while (_current < _blocks.size()) {
+		const Block &block = _blocks[_current];
+		const size_t start = (size_t)(((uintptr)block.data + _offset + alignment - 1) & ~(uintptr)(alignment - 1)) - (uintptr)block.data;
+		if (start + size <= block.size) {
+			_used += start + size - _offset;
+			_offset = start + size;
+			return block.data + start;
+		}
+
+		// Go on with the next block, the rest of this one stays unused
+		_current++;
+		_offset = 0;
+	}
+
+	allocBlock(size + alignment);
+	return allocate(size, alignment);
+}
+
+void FrameArena::allocBlock(size_t minSize) {
+	Block block;
+	block.size = MAX(minSize, _blockSize);
+	block.data = (byte *)malloc(block.size);
+	if (!block.data)
+		::error("Common::FrameArena: failure to allocate %u bytes", (uint)block.size);
+
+	_blocks.push_back(block);
+	_current = _blocks.size() - 1;
+	_offset = 0;
+}
+
+void FrameArena::freeBlocks() {
+	for (uint i = 0; i < _blocks.size(); ++i)
+		free(_blocks[i].data);
+	_blocks.clear();
+}
+
+void FrameArena::reset() {
+	// Replace several blocks with one which fits everything at once
+	if (_blocks.size() > 1) {
+		const size_t capacity = getCapacity();
+		freeBlocks();
+		allocBlock(capacity);
+	}
+
+	_current = 0;
+	_offset = 0;
+	_used = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _blocks.size(); ++i)
+		capacity += _blocks[i].size;
+	return capacity;
+}
+
+} // End of namespace Common
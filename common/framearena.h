@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FRAMEARENA_H
+#define COMMON_FRAMEARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_frame_arena Frame arena
+ * @ingroup common_memory
+ *
+ * @brief API for allocating short-lived memory in bulk.
+ * @{
+ */
+
+/**
+ * A bump allocator for temporary data which is all released at once,
+ * typically at the end of each frame.
+ *
+ * Allocating is just a matter of advancing a pointer, and freeing is not
+ * possible at all: reset() releases everything that was allocated since the
+ * previous reset. When a frame needed more than one block, the blocks are
+ * merged into a single bigger one on reset, so after a few frames the arena
+ * does not call malloc() anymore.
+ *
+ * Destructors of objects created in the arena are never called, so only
+ * use it for objects which do not own other resources.
+ */
+class FrameArena : NonCopyable {
+public:
+	/**
+	 * Construct an arena which allocates memory in blocks of at least
+	 * @p blockSize bytes. No memory is allocated until first use.
+	 */
+	explicit FrameArena(size_t blockSize = 64 * 1024);
+	~FrameArena();
+
+	/**
+	 * Allocate @p size bytes aligned to @p alignment, which must be a power of two.
+	 */
+	void *allocate(size_t size, size_t alignment = sizeof(void *));
+
+	/**
+	 * Allocate uninitialized storage for @p count objects of type @p T.
+	 */
+	template<class T>
+	T *allocArray(size_t count) {
+		return (T *)allocate(sizeof(T) * count, MAX<size_t>(sizeof(void *), alignof(T)));
+	}
+
+	/**
+	 * Release everything allocated so far. Pointers obtained earlier
+	 * must not be used anymore.
+	 */
+	void reset();
+
+	/** Return the number of bytes allocated since the last reset, including padding. */
+	size_t getUsed() const { return _used; }
+
+	/** Return the number of bytes currently reserved from the system. */
+	size_t getCapacity() const;
+
+private:
+	struct Block {
+		byte *data;
+		size_t size;
+	};
+
+	void allocBlock(size_t minSize);
+	void freeBlocks();
+
+	Array<Block> _blocks;
+	uint _current;   ///< Index of the block allocations are made from
+	size_t _offset;  ///< Offset of the first free byte in the current block
+	size_t _used;
+	const size_t _blockSize;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+/**
+ * A custom placement new operator, allocating from a FrameArena. Objects
+ * created this way are never destroyed, see Common::FrameArena.
+ */
+inline void *operator new(size_t nbytes, Common::FrameArena &arena) {
+	return arena.allocate(nbytes, MAX<size_t>(sizeof(void *), 8));
+}
+
+inline void operator delete(void *, Common::FrameArena &) {
+}
+
+#endif
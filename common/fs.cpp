@@ -140,6 +140,31 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	SeekableReadStream *stream = _realNode->createMappedReadStream();
+	if (!stream)
+		stream = _realNode->createReadStream();
+	return stream;
+}
+
+bool FSNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	if (_realNode == nullptr)
+		return false;
+
+	return _realNode->getFileInfo(size, modificationTime);
+}
+
 WriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -152,6 +177,18 @@ WriteStream *FSNode::createWriteStream() const {
 	return _realNode->createWriteStream();
 }
 
+WriteStream *FSNode::createAtomicWriteStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (_realNode->isDirectory()) {
+		warning("FSNode::createAtomicWriteStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createAtomicWriteStream();
+}
+
 bool FSNode::createDirectory() const {
 	if (_realNode == nullptr)
 		return false;
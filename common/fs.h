@@ -231,6 +231,26 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Create a memory-mapped SeekableReadStream instance corresponding to
+	 * the file referred by this node. Parts of the file can then be
+	 * accessed without copying, see MappedReadStream. If the backend
+	 * cannot map the file, this falls back to createReadStream().
+	 *
+	 * @return Pointer to the stream object, 0 in case of a failure.
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
+	/**
+	 * Get the size and the last modification time of the file referred by
+	 * this node, without opening it. This is cheap enough to decide whether
+	 * data cached about the file is still valid.
+	 *
+	 * @return True if both are known, false if the node is not a file or
+	 *         the backend cannot query them.
+	 */
+	bool getFileInfo(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -240,6 +260,17 @@ public:
 	 */
 	WriteStream *createWriteStream() const;
 
+	/**
+	 * Create a WriteStream which replaces the file referred by this node
+	 * only when it is finalized without errors. As long as that has not
+	 * happened, the file keeps its previous contents.
+	 *
+	 * Only some backends support this, the others write to the file directly.
+	 *
+	 * @return Pointer to the stream object, 0 in case of a failure.
+	 */
+	WriteStream *createAtomicWriteStream() const;
+
 	/**
 	 * Create a directory referred by this node. This assumes that this
 	 * node refers to a non-existing directory. If this is not the case,
@@ -55,6 +55,8 @@ inline uint32 REVERSEBITS(uint32 x) {
 /**
  * Huffman bit stream decoding.
  *
+ * Codes of up to 10 bits are decoded with a single table lookup, and codes of
+ * up to 20 bits with two. Only longer codes are searched for bit by bit.
  */
 template<class BITSTREAM>
 class Huffman {
@@ -83,21 +85,61 @@ private:
 	typedef List<Symbol> CodeList;
 	typedef Array<CodeList> CodeLists;
 
-	/** Lists of codes and their symbols, sorted by code length. */
+	/**
+	 * Lists of codes and their symbols, sorted by code length. Only used for the
+	 * codes too long to be resolved by the lookup tables.
+	 */
 	CodeLists _codes;
 
-	/** Prefix lookup table used to speed up the decoding of short codes. */
-	struct PrefixEntry {
+	/**
+	 * A lookup table entry.
+	 *
+	 * If length is set, the entry resolves the code to the symbol. Otherwise, if
+	 * subBits is set, symbol is the offset of a second-level table indexed by the
+	 * next subBits bits. If neither is set, the code lists are searched.
+	 */
+	struct TableEntry {
 		uint32 symbol;
 		uint8  length;
+		uint8  subBits;
 
-		PrefixEntry() : length(0xFF) {}
+		TableEntry() : symbol(0), length(0), subBits(0) {}
 	};
 
-	static const uint8 _prefixTableBits = 8;
-	PrefixEntry _prefixTable[1 << _prefixTableBits];
+	/** Maximum number of bits looked up in the first-level table. */
+	static const uint8 kMaxPrefixBits = 10;
+	/** Maximum number of bits looked up in a second-level table. */
+	static const uint8 kMaxSubTableBits = 10;
+
+	/** Number of bits looked up in the first-level table. */
+	uint8 _prefixBits;
+
+	/** First-level table, indexed by the next _prefixBits bits. */
+	Array<TableEntry> _prefixTable;
+	/** All the second-level tables, for the codes longer than _prefixBits. */
+	Array<TableEntry> _subTables;
+
+	/** Fill all the entries of @p table whose index starts with @p code. */
+	static void fillTable(TableEntry *table, uint8 tableBits, uint32 code, uint8 length, uint32 symbol, uint8 totalLength);
 };
 
+template <class BITSTREAM>
+void Huffman<BITSTREAM>::fillTable(TableEntry *table, uint8 tableBits, uint32 code, uint8 length, uint32 symbol, uint8 totalLength) {
+	const uint32 count = 1 << (tableBits - length);
+
+	for (uint32 i = 0; i < count; i++) {
+		// The code comes first in the bit stream, the bits following it are free
+		uint32 index;
+		if (BITSTREAM::isMSB2LSB())
+			index = (code << (tableBits - length)) | i;
+		else
+			index = code | (i << length);
+
+		table[index].symbol = symbol;
+		table[index].length = totalLength;
+	}
+}
+
 template <class BITSTREAM>
 Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols) {
 	assert(codeCount > 0);
@@ -111,53 +153,90 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 
 	assert(maxLength <= 32);
 
-	// Codes that do not fit in the prefix table are stored in the _codes array.
-	_codes.resize(MAX(maxLength - _prefixTableBits, 0));
+	_prefixBits = MIN(maxLength, kMaxPrefixBits);
+	_prefixTable.resize(1 << _prefixBits);
 
-	for (uint i = 0; i < codeCount; i++) {
-		uint8 length = lengths[i];
+	// Codes that do not fit in the lookup tables are stored in the _codes array.
+	_codes.resize(maxLength - _prefixBits);
+
+	// Find how many more bits the codes sharing each prefix need
+	for (uint32 i = 0; i < codeCount; i++) {
+		const uint8 length = lengths[i];
+		if (length <= _prefixBits)
+			continue;
+
+		const uint32 prefix = BITSTREAM::isMSB2LSB() ? codes[i] >> (length - _prefixBits) : codes[i] & ((1 << _prefixBits) - 1);
+		TableEntry &entry = _prefixTable[prefix];
+		entry.subBits = MAX<uint8>(entry.subBits, length - _prefixBits);
+	}
+
+	// Lay out the second-level tables. Prefixes with too long codes keep using the lists.
+	uint32 subTablesSize = 0;
+	for (uint32 i = 0; i < _prefixTable.size(); i++) {
+		TableEntry &entry = _prefixTable[i];
+		if (entry.subBits > kMaxSubTableBits) {
+			entry.subBits = 0;
+		} else if (entry.subBits) {
+			entry.symbol = subTablesSize;
+			subTablesSize += 1 << entry.subBits;
+		}
+	}
+	_subTables.resize(subTablesSize);
+
+	for (uint32 i = 0; i < codeCount; i++) {
+		const uint8 length = lengths[i];
 
 		// The symbol. If none was specified, assume it is identical to the code index.
-		uint32 symbol = symbols ? symbols[i] : i;
-
-		if (length <= _prefixTableBits) {
-			// Short codes go in the prefix lookup table. Set all the entries in the table
-			// with an index starting with the code to the symbol value.
-			uint32 startIndex;
-			if (BITSTREAM::isMSB2LSB()) {
-				startIndex = codes[i] << (_prefixTableBits - length);
-			} else {
-				startIndex = REVERSEBITS(codes[i]) >> (32 - _prefixTableBits);
-			}
-
-			uint32 endIndex = startIndex | ((1 << (_prefixTableBits - length)) - 1);
-
-			for (uint32 j = startIndex; j <= endIndex; j++) {
-				uint32 index = BITSTREAM::isMSB2LSB() ? j : REVERSEBITS(j) >> (32 - _prefixTableBits);
-				_prefixTable[index].symbol = symbol;
-				_prefixTable[index].length = length;
-			}
+		const uint32 symbol = symbols ? symbols[i] : i;
+
+		if (length <= _prefixBits) {
+			// Short codes are resolved by the first-level table alone
+			fillTable(_prefixTable.begin(), _prefixBits, codes[i], length, symbol, length);
+			continue;
+		}
+
+		uint32 prefix, rest;
+		if (BITSTREAM::isMSB2LSB()) {
+			prefix = codes[i] >> (length - _prefixBits);
+			rest = codes[i] & ((1 << (length - _prefixBits)) - 1);
+		} else {
+			prefix = codes[i] & ((1 << _prefixBits) - 1);
+			rest = codes[i] >> _prefixBits;
+		}
+
+		const TableEntry &entry = _prefixTable[prefix];
+		if (entry.subBits) {
+			fillTable(&_subTables[entry.symbol], entry.subBits, rest, length - _prefixBits, symbol, length);
 		} else {
 			// Put the code and symbol into the correct list for the length.
-			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
+			_codes[length - 1 - _prefixBits].push_back(Symbol(codes[i], symbol));
 		}
 	}
 }
 
 template <class BITSTREAM>
 uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
-	uint32 code = bits.peekBits(_prefixTableBits);
+	uint32 code = bits.peekBits(_prefixBits);
 
-	uint8 length = _prefixTable[code].length;
+	const TableEntry &entry = _prefixTable[code];
 
-	if (length != 0xFF) {
-		bits.skip(length);
-		return _prefixTable[code].symbol;
-	} else {
-		bits.skip(_prefixTableBits);
+	if (entry.length) {
+		bits.skip(entry.length);
+		return entry.symbol;
+	}
+
+	bits.skip(_prefixBits);
 
+	if (entry.subBits) {
+		const TableEntry &subEntry = _subTables[entry.symbol + bits.peekBits(entry.subBits)];
+
+		if (subEntry.length) {
+			bits.skip(subEntry.length - _prefixBits);
+			return subEntry.symbol;
+		}
+	} else {
 		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i + _prefixTableBits);
+			bits.addBit(code, i + _prefixBits);
 
 			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
 				if (code == cCode->code)
@@ -47,6 +47,7 @@
 #include "common/debug.h"
 #include "common/hash-str.h"
 #include "common/installshield_cab.h"
+#include "common/membercache.h"
 #include "common/memstream.h"
 #include "common/zlib.h"
 
@@ -75,6 +76,9 @@ private:
 	FileMap _map;
 	Common::SeekableReadStream *_stream;
 	DisposeAfterUse::Flag _disposeAfterUse;
+
+	// The inflated members, as games open the same ones repeatedly
+	mutable MemberCache _cache;
 };
 
 InstallShieldCabinet::~InstallShieldCabinet() {
@@ -184,6 +188,10 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 		return _stream->readStream(entry.uncompressedSize);
 
 #ifdef USE_ZLIB
+	SeekableReadStream *cached = _cache.createReadStream(name);
+	if (cached)
+		return cached;
+
 	byte *src = (byte *)malloc(entry.compressedSize);
 	byte *dst = (byte *)malloc(entry.uncompressedSize);
 
@@ -198,7 +206,7 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 		return nullptr;
 	}
 
-	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+	return _cache.add(name, dst, entry.uncompressedSize);
 #else
 	warning("zlib required to extract compressed CAB file '%s'", name.c_str());
 	return 0;
@@ -0,0 +1,60 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/interned-str.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(GlobalStringPool);
+
+StringPool::~StringPool() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete i->_value;
+}
+
+const StringPool::Entry *StringPool::intern(const String &str) {
+	if (str.empty())
+		return getEmptyEntry();
+
+	EntryMap::iterator i = _entries.find(str);
+	if (i != _entries.end())
+		return i->_value;
+
+	Entry *entry = new Entry(str);
+	_entries[str] = entry;
+
+	// All the case variations of a string share the entry of the lowercase
+	// one, so comparing them ignoring the case is a pointer comparison too
+	String lower(str);
+	lower.toLowercase();
+	if (lower != str)
+		entry->folded = intern(lower);
+
+	return entry;
+}
+
+const StringPool::Entry *StringPool::getEmptyEntry() {
+	static const Entry empty((String()));
+	return &empty;
+}
+
+} // End of namespace Common
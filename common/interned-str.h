@@ -0,0 +1,146 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_INTERNED_STR_H
+#define COMMON_INTERNED_STR_H
+
+#include "common/hash-str.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_interned_str Interned strings
+ * @ingroup common_hashmap
+ *
+ * @brief Strings stored once in a pool, for cheap hashing and comparison.
+ *
+ * @{
+ */
+
+/**
+ * A pool of immutable strings. Interning the same string twice returns the
+ * same entry, so interned strings compare by pointer, and their hashes are
+ * only computed once, when they are first interned.
+ *
+ * The entries live as long as the pool. The pool is not thread safe.
+ */
+class StringPool : NonCopyable {
+public:
+	struct Entry {
+		String str;
+		uint hash;           ///< Case sensitive hash of str
+		const Entry *folded; ///< Entry of the lowercase version of str, shared by all its case variations
+
+		Entry(const String &s) : str(s), hash(s.hash()), folded(this) {}
+	};
+
+	StringPool() {}
+	virtual ~StringPool();
+
+	/** Return the entry of a string, adding it if it is not in the pool yet. */
+	const Entry *intern(const String &str);
+
+	/** Return the number of strings in the pool. */
+	uint size() const { return _entries.size(); }
+
+	/** The entry of the empty string, which is shared by all the pools. */
+	static const Entry *getEmptyEntry();
+
+private:
+	typedef HashMap<String, Entry *> EntryMap;
+	EntryMap _entries;
+};
+
+/**
+ * The pool used by default by InternedString.
+ */
+class GlobalStringPool : public StringPool, public Singleton<GlobalStringPool> {
+private:
+	friend class Singleton<SingletonBaseType>;
+	GlobalStringPool() {}
+};
+
+/**
+ * A string interned in a StringPool. It is meant for strings which are looked
+ * up over and over, like resource names or script symbols: they are interned
+ * once, when they are loaded, then hashing them and comparing them costs the
+ * same as for an integer, for case sensitive and case insensitive maps alike.
+ *
+ * Strings interned in different pools are never equal, except for the empty
+ * string.
+ */
+class InternedString {
+public:
+	InternedString() : _entry(StringPool::getEmptyEntry()) {}
+	explicit InternedString(const String &str, StringPool &pool = GlobalStringPool::instance()) : _entry(pool.intern(str)) {}
+	explicit InternedString(const char *str, StringPool &pool = GlobalStringPool::instance()) : _entry(pool.intern(String(str))) {}
+
+	const String &str() const { return _entry->str; }
+	const char *c_str() const { return _entry->str.c_str(); }
+	uint size() const { return _entry->str.size(); }
+	bool empty() const { return _entry->str.empty(); }
+
+	/** Case sensitive hash of the string. */
+	uint hash() const { return _entry->hash; }
+	/** Case insensitive hash of the string, same as hashit_lower(). */
+	uint hashIgnoreCase() const { return _entry->folded->hash; }
+
+	bool operator==(const InternedString &x) const { return _entry == x._entry; }
+	bool operator!=(const InternedString &x) const { return _entry != x._entry; }
+	bool equalsIgnoreCase(const InternedString &x) const { return _entry->folded == x._entry->folded; }
+
+private:
+	const StringPool::Entry *_entry;
+};
+
+struct InternedString_EqualTo {
+	bool operator()(const InternedString &x, const InternedString &y) const { return x == y; }
+};
+
+struct InternedString_Hash {
+	uint operator()(const InternedString &x) const { return x.hash(); }
+};
+
+struct InternedString_IgnoreCase_EqualTo {
+	bool operator()(const InternedString &x, const InternedString &y) const { return x.equalsIgnoreCase(y); }
+};
+
+struct InternedString_IgnoreCase_Hash {
+	uint operator()(const InternedString &x) const { return x.hashIgnoreCase(); }
+};
+
+// Specialization of the Hash functor for interned strings. Like for String,
+// the default hashing is case sensitive. Case insensitive maps use
+// InternedString_IgnoreCase_Hash and InternedString_IgnoreCase_EqualTo.
+template<>
+struct Hash<InternedString> {
+	uint operator()(const InternedString &s) const {
+		return s.hash();
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
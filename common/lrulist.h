@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_LRULIST_H
+#define COMMON_LRULIST_H
+
+#include "common/scummsys.h"
+#include "common/list.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_lrulist LRU list
+ * @ingroup common
+ *
+ * @brief Template for the entries of least recently used caches.
+ * @{
+ */
+
+/**
+ * The entries of a cache, ordered from the most to the least recently used,
+ * implemented using our List class. Caches look their entries up by walking
+ * the list, and make room by removing its least recently used entries.
+ */
+template<class T>
+class LRUList {
+public:
+	typedef typename List<T>::iterator iterator;
+	typedef typename List<T>::const_iterator const_iterator;
+
+	LRUList() : _size(0) {}
+
+	iterator begin() { return _impl.begin(); }
+	iterator end() { return _impl.end(); }
+	const_iterator begin() const { return _impl.begin(); }
+	const_iterator end() const { return _impl.end(); }
+
+	bool empty() const { return _impl.empty(); }
+
+	/** Return the number of entries, without walking the list. */
+	uint size() const { return _size; }
+
+	/** Add an entry, as the most recently used one. */
+	void add(const T &entry) {
+		_impl.push_front(entry);
+		_size++;
+	}
+
+	/**
+	 * Make the entry at @p pos the most recently used one. Return an
+	 * iterator pointing to it in its new place.
+	 */
+	iterator touch(iterator pos) {
+		if (pos != _impl.begin()) {
+			const T entry = *pos;
+			_impl.erase(pos);
+			_impl.push_front(entry);
+		}
+		return _impl.begin();
+	}
+
+	/** Return the least recently used entry. The list must not be empty. */
+	T &leastRecent() { return _impl.back(); }
+
+	/** Remove the least recently used entry. The list must not be empty. */
+	void removeLeastRecent() {
+		_impl.pop_back();
+		_size--;
+	}
+
+	/**
+	 * Remove the entry at @p pos, and return an iterator pointing to the
+	 * entry after it.
+	 */
+	iterator erase(iterator pos) {
+		_size--;
+		return _impl.erase(pos);
+	}
+
+	void clear() {
+		_impl.clear();
+		_size = 0;
+	}
+
+private:
+	List<T> _impl;
+	uint _size;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,112 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/lua/lua_allocator.h"
+#include "common/textconsole.h"
+
+namespace Lua {
+
+static int panic(lua_State *L) {
+	error("Lua panic: %s", lua_isstring(L, -1) ? lua_tostring(L, -1) : "unknown error");
+	return 0;
+}
+
+LuaAllocator::LuaAllocator() : _frameStart(0) {
+	for (int i = 0; i < kNumSizeClasses; ++i)
+		_pools[i] = new Common::MemoryPool((i + 1) * kSizeClassStep);
+
+	_stats.liveBytes = 0;
+	_stats.peakBytes = 0;
+	_stats.allocations = 0;
+	_stats.frameAllocations = 0;
+}
+
+LuaAllocator::~LuaAllocator() {
+	for (int i = 0; i < kNumSizeClasses; ++i)
+		delete _pools[i];
+}
+
+lua_State *LuaAllocator::newState() {
+	lua_State *L = lua_newstate(alloc, this);
+	if (L)
+		lua_atpanic(L, panic);
+	return L;
+}
+
+void LuaAllocator::endFrame() {
+	_stats.frameAllocations = _stats.allocations - _frameStart;
+	_frameStart = _stats.allocations;
+}
+
+void *LuaAllocator::allocate(size_t size) {
+	void *ptr = size <= kMaxPooledSize ? _pools[sizeClass(size)]->allocChunk() : malloc(size);
+	if (!ptr)
+		return nullptr;
+
+	_stats.allocations++;
+	_stats.liveBytes += size;
+	if (_stats.liveBytes > _stats.peakBytes)
+		_stats.peakBytes = _stats.liveBytes;
+	return ptr;
+}
+
+void LuaAllocator::release(void *ptr, size_t size) {
+	if (size <= kMaxPooledSize)
+		_pools[sizeClass(size)]->freeChunk(ptr);
+	else
+		free(ptr);
+
+	_stats.liveBytes -= size;
+}
+
+void *LuaAllocator::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	LuaAllocator *allocator = (LuaAllocator *)ud;
+
+	if (nsize == 0) {
+		if (ptr)
+			allocator->release(ptr, osize);
+		return nullptr;
+	}
+
+	if (!ptr)
+		return allocator->allocate(nsize);
+
+	// Blocks which stay in the same pool don't need to move
+	if (osize <= kMaxPooledSize && nsize <= kMaxPooledSize && sizeClass(osize) == sizeClass(nsize)) {
+		allocator->_stats.liveBytes += nsize;
+		allocator->_stats.liveBytes -= osize;
+		if (allocator->_stats.liveBytes > allocator->_stats.peakBytes)
+			allocator->_stats.peakBytes = allocator->_stats.liveBytes;
+		return ptr;
+	}
+
+	// Lua expects a failed reallocation to leave the block untouched
+	void *newPtr = allocator->allocate(nsize);
+	if (!newPtr)
+		return nullptr;
+
+	memcpy(newPtr, ptr, MIN(osize, nsize));
+	allocator->release(ptr, osize);
+	return newPtr;
+}
+
+} // End of namespace Lua
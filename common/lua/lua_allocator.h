@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef LUA_ALLOCATOR_H
+#define LUA_ALLOCATOR_H
+
+#include "common/memorypool.h"
+
+#include "common/lua/lua.h"
+
+namespace Lua {
+
+/**
+ * A lua_Alloc for the Lua states of the engines. The many small blocks Lua
+ * allocates for its strings, tables and closures are served from pools of
+ * chunks of a few sizes, instead of going through the system heap each time.
+ * Larger blocks are allocated with malloc.
+ *
+ * The allocator must outlive the states which use it.
+ */
+class LuaAllocator {
+public:
+	struct Stats {
+		size_t liveBytes;        ///< Size of the blocks currently allocated
+		size_t peakBytes;        ///< Highest liveBytes so far
+		uint32 allocations;      ///< Number of blocks allocated so far
+		uint32 frameAllocations; ///< Number of blocks allocated during the last frame
+	};
+
+	LuaAllocator();
+	~LuaAllocator();
+
+	/**
+	 * Create a Lua state using this allocator, with a panic function which
+	 * reports the Lua error through error().
+	 */
+	lua_State *newState();
+
+	/** Mark the end of a frame, for the frameAllocations statistics. */
+	void endFrame();
+
+	const Stats &getStats() const { return _stats; }
+
+	/** The lua_Alloc function, whose userdata is the allocator. */
+	static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+private:
+	enum {
+		kSizeClassStep = 16,
+		kNumSizeClasses = 16,
+		kMaxPooledSize = kSizeClassStep * kNumSizeClasses
+	};
+
+	static int sizeClass(size_t size) { return (size - 1) / kSizeClassStep; }
+
+	void *allocate(size_t size);
+	void release(void *ptr, size_t size);
+
+	Common::MemoryPool *_pools[kNumSizeClasses];
+	Stats _stats;
+	uint32 _frameStart;
+};
+
+} // End of namespace Lua
+
+#endif
@@ -27,6 +27,7 @@
 #include "common/fs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/memstream.h"
 #include "common/substream.h"
 #include "common/textconsole.h"
 #include "common/archive.h"
@@ -45,6 +46,20 @@ namespace Common {
 #define MBI_RFLEN 87
 #define MAXNAMELEN 63
 
+namespace {
+
+// Owner of the buffer of a cached resource
+class ResourceBuffer : public MappedReadStream::Mapping {
+public:
+	explicit ResourceBuffer(byte *data) : _data(data) {}
+	~ResourceBuffer() override { free(_data); }
+
+private:
+	byte *_data;
+};
+
+} // End of anonymous namespace
+
 MacResManager::MacResManager() {
 	_stream = nullptr;
 	// _baseFileName cleared by String constructor
@@ -61,6 +76,9 @@ MacResManager::MacResManager() {
 	_resMap.reset();
 	_resTypes = nullptr;
 	_resLists = nullptr;
+
+	_mapped = false;
+	_cacheMaxSize = 0;
 }
 
 MacResManager::~MacResManager() {
@@ -83,6 +101,12 @@ void MacResManager::close() {
 	delete[] _resTypes; _resTypes = nullptr;
 	delete _stream; _stream = nullptr;
 	_resMap.numTypes = 0;
+
+	_typeIndex.clear();
+	_resIndex.clear();
+	_nameIndex.clear();
+	_mapped = false;
+	clearCache();
 }
 
 bool MacResManager::hasDataFork() const {
@@ -119,6 +143,19 @@ bool MacResManager::open(const String &fileName) {
 	return open(fileName, SearchMan);
 }
 
+SeekableReadStream *MacResManager::openFork(Archive &archive, const String &fileName) {
+	if (!archive.hasFile(fileName))
+		return nullptr;
+
+	// Plain files are mapped, so resources can be handed out without copying
+	const ArchiveMemberPtr archiveMember = archive.getMember(fileName);
+	const FSNode *fsNode = dynamic_cast<const FSNode *>(archiveMember.get());
+	if (fsNode)
+		return fsNode->createMappedReadStream();
+
+	return archive.createReadStreamForMember(fileName);
+}
+
 bool MacResManager::open(const String &fileName, Archive &archive) {
 	close();
 
@@ -140,7 +177,7 @@ bool MacResManager::open(const String &fileName, Archive &archive) {
 #endif
 
 	// Prefer standalone files first, starting with raw forks
-	SeekableReadStream *stream = archive.createReadStreamForMember(fileName + ".rsrc");
+	SeekableReadStream *stream = openFork(archive, fileName + ".rsrc");
 	if (stream && loadFromRawFork(*stream)) {
 		_baseFileName = fileName;
 		return true;
@@ -148,7 +185,7 @@ bool MacResManager::open(const String &fileName, Archive &archive) {
 	delete stream;
 
 	// Then try for AppleDouble using Apple's naming
-	stream = archive.createReadStreamForMember(constructAppleDoubleName(fileName));
+	stream = openFork(archive, constructAppleDoubleName(fileName));
 	if (stream && loadFromAppleDouble(*stream)) {
 		_baseFileName = fileName;
 		return true;
@@ -156,7 +193,7 @@ bool MacResManager::open(const String &fileName, Archive &archive) {
 	delete stream;
 
 	// Check .bin for MacBinary next
-	stream = archive.createReadStreamForMember(fileName + ".bin");
+	stream = openFork(archive, fileName + ".bin");
 	if (stream && loadFromMacBinary(*stream)) {
 		_baseFileName = fileName;
 		return true;
@@ -164,7 +201,7 @@ bool MacResManager::open(const String &fileName, Archive &archive) {
 	delete stream;
 
 	// As a last resort, see if just the data fork exists
-	stream = archive.createReadStreamForMember(fileName);
+	stream = openFork(archive, fileName);
 	if (stream) {
 		_baseFileName = fileName;
 
@@ -403,6 +440,7 @@ bool MacResManager::load(SeekableReadStream &stream) {
 		_dataOffset, _dataLength, _mapOffset, _mapLength);
 
 	_stream = &stream;
+	_mapped = dynamic_cast<MappedReadStream *>(_stream) != nullptr;
 
 	readMap();
 	return true;
@@ -427,15 +465,9 @@ SeekableReadStream *MacResManager::getDataFork() {
 }
 
 MacResIDArray MacResManager::getResIDArray(uint32 typeID) {
-	int typeNum = -1;
+	const int typeNum = findType(typeID);
 	MacResIDArray res;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
 	if (typeNum == -1)
 		return res;
 
@@ -461,96 +493,116 @@ MacResTagArray MacResManager::getResTagArray() {
 	return tagArray;
 }
 
-String MacResManager::getResName(uint32 typeID, uint16 resID) const {
-	int typeNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
+int MacResManager::findType(uint32 typeID) const {
+	const HashMap<uint32, uint16>::const_iterator it = _typeIndex.find(typeID);
+	return it != _typeIndex.end() ? it->_value : -1;
+}
 
+const MacResManager::Resource *MacResManager::findResource(uint32 typeID, uint16 resID) const {
+	const int typeNum = findType(typeID);
 	if (typeNum == -1)
-		return "";
+		return nullptr;
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID)
-			return _resLists[typeNum][i].name;
+	return _resIndex.getValOrDefault((uint32)typeNum << 16 | resID, nullptr);
+}
 
-	return "";
+String MacResManager::getResName(uint32 typeID, uint16 resID) const {
+	const Resource *res = findResource(typeID, resID);
+	if (!res || !res->name)
+		return "";
+
+	return res->name;
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
-	int typeNum = -1;
-	int resNum = -1;
+	const Resource *res = findResource(typeID, resID);
+	if (!res)
+		return nullptr;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
+	return readResource(*res);
+}
 
-	if (typeNum == -1)
+SeekableReadStream *MacResManager::getResource(const String &fileName) {
+	const Resource *res = _nameIndex.getValOrDefault(fileName, nullptr);
+	if (!res)
 		return nullptr;
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID) {
-			resNum = i;
-			break;
-		}
+	return readResource(*res);
+}
 
-	if (resNum == -1)
+SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &fileName) {
+	const int typeNum = findType(typeID);
+	if (typeNum == -1)
 		return nullptr;
 
-	_stream->seek(_dataOffset + _resLists[typeNum][resNum].dataOffset);
+	for (uint32 j = 0; j < _resTypes[typeNum].items; j++) {
+		if (_resLists[typeNum][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[typeNum][j].name))
+			return readResource(_resLists[typeNum][j]);
+	}
+
+	return nullptr;
+}
+
+SeekableReadStream *MacResManager::readResource(const Resource &res) {
+	if (_cacheMaxSize && !_mapped) {
+		const HashMap<uint32, CacheList::iterator>::iterator cached = _cacheIndex.find(res.dataOffset);
+		if (cached != _cacheIndex.end()) {
+			// Move the entry to the front
+			const CacheEntry entry = *cached->_value;
+			_cache.erase(cached->_value);
+			_cache.push_front(entry);
+			cached->_value = _cache.begin();
+
+			_cacheStats.hits++;
+			return entry.stream->createView(0, entry.stream->size());
+		}
+		_cacheStats.misses++;
+	}
+
+	_stream->seek(_dataOffset + res.dataOffset);
 	uint32 len = _stream->readUint32BE();
 
 	// Ignore resources with 0 length
 	if (!len)
 		return nullptr;
 
-	return _stream->readStream(len);
-}
+	if (!_cacheMaxSize || _mapped || len > _cacheMaxSize)
+		return _stream->readStream(len);
 
-SeekableReadStream *MacResManager::getResource(const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
+	byte *data = (byte *)malloc(len);
+	len = _stream->read(data, len);
 
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+	CacheEntry entry;
+	entry.dataOffset = res.dataOffset;
+	entry.stream = new MappedReadStream(MappedReadStream::MappingPtr(new ResourceBuffer(data)), data, len);
 
-				return _stream->readStream(len);
-			}
-		}
-	}
+	trimCache(_cacheMaxSize - len);
+	_cache.push_front(entry);
+	_cacheIndex[res.dataOffset] = _cache.begin();
+	_cacheStats.size += len;
 
-	return nullptr;
+	return entry.stream->createView(0, len);
 }
 
-SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		if (_resTypes[i].id != typeID)
-			continue;
+void MacResManager::setResourceCacheSize(uint32 maxBytes) {
+	_cacheMaxSize = maxBytes;
+	trimCache(maxBytes);
+}
 
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
+void MacResManager::clearCache() {
+	trimCache(0);
+}
 
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+void MacResManager::trimCache(uint32 maxBytes) {
+	while (_cacheStats.size > maxBytes) {
+		const CacheEntry &entry = _cache.back();
+		_cacheStats.size -= entry.stream->size();
+		_cacheStats.evictions++;
 
-				return _stream->readStream(len);
-			}
-		}
+		_cacheIndex.erase(entry.dataOffset);
+		delete entry.stream;
+		_cache.pop_back();
 	}
-
-	return nullptr;
 }
 
 void MacResManager::readMap() {
@@ -604,6 +656,22 @@ void MacResManager::readMap() {
 			}
 		}
 	}
+
+	// Index the resources, keeping the first one of any duplicates
+	for (int i = 0; i < _resMap.numTypes; i++) {
+		if (!_typeIndex.contains(_resTypes[i].id))
+			_typeIndex[_resTypes[i].id] = i;
+
+		for (int j = 0; j < _resTypes[i].items; j++) {
+			const Resource *res = _resLists[i] + j;
+			const uint32 key = (uint32)i << 16 | res->id;
+			if (!_resIndex.contains(key))
+				_resIndex[key] = res;
+
+			if (res->nameOffset != -1 && !_nameIndex.contains(res->name))
+				_nameIndex[res->name] = res;
+		}
+	}
 }
 
 String MacResManager::constructAppleDoubleName(String name) {
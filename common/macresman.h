@@ -27,6 +27,9 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "common/str.h"
 #include "common/str-array.h"
 
@@ -35,6 +38,8 @@
 
 namespace Common {
 
+class MappedReadStream;
+
 /**
  * @defgroup common_macresman Macintosh resource fork manager
  * @ingroup common
@@ -62,6 +67,16 @@ class MacResManager {
 #define MBI_INFOHDR 128
 
 public:
+	/** Statistics of the resource cache, see setResourceCacheSize(). */
+	struct CacheStats {
+		uint32 hits;      ///< Resources served from the cache
+		uint32 misses;    ///< Resources read from the fork
+		uint32 evictions; ///< Resources dropped to stay within the budget
+		uint32 size;      ///< Bytes currently held by the cache
+
+		CacheStats() : hits(0), misses(0), evictions(0), size(0) {}
+	};
+
 	MacResManager();
 	~MacResManager();
 
@@ -123,6 +138,10 @@ public:
 
 	/**
 	 * Read resource from the MacBinary file
+	 *
+	 * When the fork is memory-mapped, the returned stream is a view into
+	 * the mapping and no data is copied.
+	 *
 	 * @param typeID FourCC of the type
 	 * @param resID Resource ID to fetch
 	 * @return Pointer to a SeekableReadStream with loaded resource
@@ -145,6 +164,21 @@ public:
 	 */
 	SeekableReadStream *getResource(uint32 typeID, const String &filename);
 
+	/**
+	 * Keep up to @p maxBytes of recently requested resources in memory, so
+	 * that requesting them again does not read from the fork. Resources are
+	 * evicted least recently used first. The streams handed out share the
+	 * cached data and stay valid after eviction.
+	 *
+	 * The cache is not used for memory-mapped forks, which are never copied.
+	 *
+	 * @param maxBytes Cache budget in bytes, 0 (the default) disables it
+	 */
+	void setResourceCacheSize(uint32 maxBytes);
+
+	/** Return the hit/miss statistics of the resource cache. */
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+
 	/**
 	 * Retrieve the data fork
 	 * @return The stream if present, 0 otherwise
@@ -226,6 +260,11 @@ private:
 
 	bool load(SeekableReadStream &stream);
 
+	/**
+	 * Open a member of the archive, memory-mapping it if it is a plain file.
+	 */
+	static SeekableReadStream *openFork(Archive &archive, const String &fileName);
+
 	bool loadFromRawFork(SeekableReadStream &stream);
 	bool loadFromAppleDouble(SeekableReadStream &stream);
 
@@ -280,6 +319,13 @@ private:
 
 	typedef Resource *ResPtr;
 
+	int findType(uint32 typeID) const;
+	const Resource *findResource(uint32 typeID, uint16 resID) const;
+	SeekableReadStream *readResource(const Resource &res);
+
+	void clearCache();
+	void trimCache(uint32 maxBytes);
+
 	int32 _resForkOffset;
 	uint32 _resForkSize;
 
@@ -290,6 +336,26 @@ private:
 	ResMap _resMap;
 	ResType *_resTypes;
 	ResPtr  *_resLists;
+
+	// Index built when the map is read, the resource keys are the type number
+	// in the upper and the resource ID in the lower 16 bits
+	HashMap<uint32, uint16> _typeIndex;
+	HashMap<uint32, const Resource *> _resIndex;
+	HashMap<String, const Resource *, IgnoreCase_Hash, IgnoreCase_EqualTo> _nameIndex;
+
+	bool _mapped;
+
+	struct CacheEntry {
+		uint32 dataOffset;
+		MappedReadStream *stream;
+	};
+	typedef List<CacheEntry> CacheList;
+
+	// Most recently used first, indexed by the data offset of the resource
+	CacheList _cache;
+	HashMap<uint32, CacheList::iterator> _cacheIndex;
+	uint32 _cacheMaxSize;
+	CacheStats _cacheStats;
 };
 
 /** @} */
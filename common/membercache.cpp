@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/membercache.h"
+
+namespace Common {
+
+MemberCache::MemberCache(uint32 maxSize) : _size(0), _maxSize(maxSize), _hits(0), _misses(0) {
+}
+
+SeekableReadStream *MemberCache::createStream(const MemberPtr &member) {
+	return new MappedReadStream(member, member->data, member->size);
+}
+
+SeekableReadStream *MemberCache::createReadStream(const String &name) {
+	MemberMap::iterator it = _map.find(name);
+	if (it == _map.end()) {
+		_misses++;
+		return nullptr;
+	}
+
+	_hits++;
+
+	// Move the member to the front, the members are dropped from the back
+	MemberPtr member = *it->_value;
+	_members.erase(it->_value);
+	_members.push_front(member);
+	it->_value = _members.begin();
+
+	return createStream(member);
+}
+
+SeekableReadStream *MemberCache::add(const String &name, byte *data, uint32 size) {
+	MemberPtr member(new Member(name, data, size));
+	if (size > _maxSize)
+		return createStream(member);
+
+	MemberMap::iterator it = _map.find(name);
+	if (it != _map.end()) {
+		_size -= (*it->_value)->size;
+		_members.erase(it->_value);
+		_map.erase(it);
+	}
+
+	while (!_members.empty() && _size + size > _maxSize) {
+		const MemberPtr &last = _members.back();
+		_size -= last->size;
+		_map.erase(last->name);
+		_members.pop_back();
+	}
+
+	_members.push_front(member);
+	_map.setVal(name, _members.begin());
+	_size += size;
+
+	return createStream(member);
+}
+
+void MemberCache::clear() {
+	_members.clear();
+	_map.clear();
+	_size = 0;
+}
+
+} // End of namespace Common
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_MEMBERCACHE_H
+#define COMMON_MEMBERCACHE_H
+
+#include "common/scummsys.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_member_cache Archive member cache
+ * @ingroup common_arch
+ *
+ * @brief API for keeping the decompressed members of an archive in memory.
+ * @{
+ */
+
+/**
+ * The decompressed members of an archive, kept in memory so that opening
+ * a member again does not decompress it again.
+ *
+ * The streams it returns share the decompressed data, which stays valid
+ * until the last of them is deleted, even when the member was dropped from
+ * the cache or the archive was closed meanwhile. When the cached members
+ * exceed the maximum size, the least recently opened ones are dropped.
+ */
+class MemberCache : NonCopyable {
+public:
+	enum {
+		kDefaultMaxSize = 16 * 1024 * 1024
+	};
+
+	explicit MemberCache(uint32 maxSize = kDefaultMaxSize);
+
+	/**
+	 * Return a new stream over a cached member, or nullptr if the member
+	 * is not cached.
+	 */
+	SeekableReadStream *createReadStream(const String &name);
+
+	/**
+	 * Cache the decompressed data of a member, and return a new stream
+	 * over it. The data must have been allocated with malloc(), the cache
+	 * takes the ownership of it. Members bigger than the maximum size are
+	 * not kept, their stream then owns the data alone.
+	 */
+	SeekableReadStream *add(const String &name, byte *data, uint32 size);
+
+	/** Drop all the cached members. */
+	void clear();
+
+	uint32 getSize() const { return _size; }
+	uint getHits() const { return _hits; }
+	uint getMisses() const { return _misses; }
+
+private:
+	struct Member : public MappedReadStream::Mapping {
+		String name;
+		byte *data;
+		uint32 size;
+
+		Member(const String &n, byte *d, uint32 s) : name(n), data(d), size(s) {}
+		~Member() override { free(data); }
+	};
+
+	typedef SharedPtr<Member> MemberPtr;
+	typedef List<MemberPtr> MemberList;
+	typedef HashMap<String, MemberList::iterator, IgnoreCase_Hash, IgnoreCase_EqualTo> MemberMap;
+
+	static SeekableReadStream *createStream(const MemberPtr &member);
+
+	// The most recently opened members first
+	MemberList _members;
+	MemberMap _map;
+	uint32 _size;
+	uint32 _maxSize;
+	uint _hits;
+	uint _misses;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -47,6 +47,52 @@ Type *uninitialized_copy(In first, In last, Type *dst) {
 	return dst;
 }
 
+#ifdef USE_CXX11
+template<class T> struct RemoveReference { typedef T type; };
+template<class T> struct RemoveReference<T &> { typedef T type; };
+template<class T> struct RemoveReference<T &&> { typedef T type; };
+
+/**
+ * Turn @p t into an rvalue, so that its contents can be taken over
+ * (like std::move).
+ */
+template<class T>
+inline typename RemoveReference<T>::type &&move(T &&t) {
+	return static_cast<typename RemoveReference<T>::type &&>(t);
+}
+
+/**
+ * Pass on a forwarding reference with its original value category
+ * (like std::forward).
+ */
+template<class T>
+inline T &&forward(typename RemoveReference<T>::type &t) {
+	return static_cast<T &&>(t);
+}
+
+template<class T>
+inline T &&forward(typename RemoveReference<T>::type &&t) {
+	return static_cast<T &&>(t);
+}
+#endif
+
+/**
+ * Moves data from the range [first, last) to [dst, dst + (last - first)),
+ * leaving the source elements in a valid but unspecified state. It requires
+ * the range [dst, dst + (last - first)) to be valid and uninitialized.
+ * Without C++11 support, the elements are copied.
+ */
+template<class In, class Type>
+Type *uninitialized_move(In first, In last, Type *dst) {
+#ifdef USE_CXX11
+	while (first != last)
+		new ((void *)dst++) Type(Common::move(*first++));
+	return dst;
+#else
+	return uninitialized_copy(first, last, dst);
+#endif
+}
+
 /**
  * Initializes the memory [first, first + (last - first)) with the value x.
  * It requires the range [first, first + (last - first)) to be valid and
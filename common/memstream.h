@@ -23,6 +23,7 @@
 #ifndef COMMON_MEMSTREAM_H
 #define COMMON_MEMSTREAM_H
 
+#include "common/ptr.h"
 #include "common/stream.h"
 #include "common/types.h"
 #include "common/util.h"
@@ -72,6 +73,11 @@ public:
 
 	uint32 read(void *dataPtr, uint32 dataSize);
 
+	uint32 readUint16LEArray(uint16 *dst, uint32 count);
+	uint32 readUint16BEArray(uint16 *dst, uint32 count);
+	uint32 readUint32LEArray(uint32 *dst, uint32 count);
+	uint32 readUint32BEArray(uint32 *dst, uint32 count);
+
 	bool eos() const { return _eos; }
 	void clearErr() { _eos = false; }
 
@@ -79,6 +85,53 @@ public:
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
+
+private:
+	/** Advance past up to @p dataSize bytes and return where they start. */
+	const byte *consume(uint32 &dataSize);
+};
+
+/**
+ * A MemoryReadStream over a block of memory which may be shared with other
+ * streams, like a memory-mapped file. The memory is released when the last
+ * stream referring to it is deleted, which allows handing out zero-copy views
+ * of parts of the stream which remain valid after the stream itself is gone.
+ */
+class MappedReadStream : public MemoryReadStream {
+public:
+	/**
+	 * Owner of a shared block of memory. Subclasses release the memory in
+	 * their destructor, e.g. by unmapping it.
+	 */
+	class Mapping {
+	public:
+		virtual ~Mapping() {}
+	};
+	typedef SharedPtr<Mapping> MappingPtr;
+
+	MappedReadStream(const MappingPtr &mapping, const byte *dataPtr, uint32 dataSize) :
+		MemoryReadStream(dataPtr, dataSize),
+		_mapping(mapping),
+		_data(dataPtr) {}
+
+	/** Return a pointer to the data this stream refers to. */
+	const byte *getData() const { return _data; }
+
+	/**
+	 * Create a stream for the range [begin, end) of this stream, without
+	 * copying any data.
+	 */
+	MappedReadStream *createView(uint32 begin, uint32 end) const {
+		assert(begin <= end && end <= (uint32)size());
+		return new MappedReadStream(_mapping, _data + begin, end - begin);
+	}
+
+	/** Return a view of the next @p dataSize bytes instead of copying them. */
+	SeekableReadStream *readStream(uint32 dataSize) override;
+
+private:
+	MappingPtr _mapping;
+	const byte *_data;
 };
 
 
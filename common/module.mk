@@ -11,10 +11,12 @@ MODULE_OBJS := \
 	error.o \
 	events.o \
 	file.o \
+	framearena.o \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
 	iff_container.o \
+	interned-str.o \
 	ini-file.o \
 	installshield_cab.o \
 	json.o \
@@ -24,12 +26,15 @@ MODULE_OBJS := \
 	memorypool.o \
 	md5.o \
 	mdct.o \
+	membercache.o \
 	mutex.o \
 	osd_message_queue.o \
 	platform.o \
+	profiler.o \
 	quicktime.o \
 	random.o \
 	rational.o \
+	readaheadstream.o \
 	rendermode.o \
 	sinewindows.o \
 	str.o \
@@ -40,6 +45,7 @@ MODULE_OBJS := \
 	stuffit.o \
 	system.o \
 	textconsole.o \
+	threadpool.o \
 	tokenizer.o \
 	translation.o \
 	unarj.o \
@@ -98,6 +104,7 @@ MODULE_OBJS += \
 	lua/ltable.o \
 	lua/ltablib.o \
 	lua/ltm.o \
+	lua/lua_allocator.o \
 	lua/lua_persist.o \
 	lua/lua_persistence_util.o \
 	lua/lua_unpersist.o \
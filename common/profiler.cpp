@@ -0,0 +1,299 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#include "common/profiler.h"
+#include "common/system.h"
+
+#if defined(POSIX)
+#include <time.h>
+#endif
+
+namespace Common {
+namespace Profiler {
+
+uint64 getMicros() {
+#if defined(WIN32)
+	static LARGE_INTEGER frequency = { { 0, 0 } };
+	if (!frequency.QuadPart)
+		QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (uint64)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+		(uint64)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#elif defined(POSIX) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+	return (uint64)g_system->getMillis(true) * 1000;
+#endif
+}
+
+} // End of namespace Profiler
+} // End of namespace Common
+
+#ifdef USE_PROFILER
+
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+struct ProfileEvent {
+	const char *name;
+	uint64 start;
+	uint32 duration;
+	uint32 depth;
+};
+
+/**
+ * The zones recorded by a single thread. Only the owning thread writes to it,
+ * the mutex is only contended while the buffer is being dumped.
+ */
+struct ProfileThreadBuffer {
+	// Number of zones kept per thread, older ones are overwritten
+	static const uint kCapacity = 32768;
+
+	Mutex mutex;
+	uint id;
+	OSystem::ThreadId thread;
+	uint depth;
+	uint head;
+	uint count;
+	ProfileEvent events[kCapacity];
+
+	ProfileThreadBuffer(uint id_, OSystem::ThreadId thread_) : id(id_), thread(thread_), depth(0), head(0), count(0) {}
+};
+
+namespace {
+
+// The registry is created by the first zone, which in practice always runs
+// on the main thread before any other thread records anything.
+struct ProfileRegistry {
+	Mutex mutex;
+	Array<ProfileThreadBuffer *> buffers;
+	// Counters are rare compared to zones, so they share the registry mutex
+	HashMap<String, int64> counters;
+};
+
+ProfileRegistry *g_registry = nullptr;
+
+ProfileRegistry *getRegistry() {
+	if (!g_registry)
+		g_registry = new ProfileRegistry();
+	return g_registry;
+}
+
+ProfileThreadBuffer *getThreadBuffer() {
+	const OSystem::ThreadId thread = g_system->getCurrentThreadId();
+
+	getRegistry();
+	StackLock lock(g_registry->mutex);
+	// There are only ever a handful of threads, so a linear search will do
+	for (uint i = 0; i < g_registry->buffers.size(); ++i) {
+		if (g_registry->buffers[i]->thread == thread)
+			return g_registry->buffers[i];
+	}
+
+	// Buffers are never freed, as their threads might still be finishing a zone
+	ProfileThreadBuffer *buffer = new ProfileThreadBuffer(g_registry->buffers.size(), thread);
+	g_registry->buffers.push_back(buffer);
+	return buffer;
+}
+
+String escapeJSON(const char *str) {
+	String result;
+	for (; *str; ++str) {
+		if (*str == '"' || *str == '\\')
+			result += '\\';
+		result += *str;
+	}
+	return result;
+}
+
+struct ZoneSummary {
+	String name;
+	uint32 calls;
+	uint64 total;
+	uint32 max;
+
+	ZoneSummary() : calls(0), total(0), max(0) {}
+};
+
+struct ZoneTotalGreater {
+	bool operator()(const ZoneSummary &x, const ZoneSummary &y) const {
+		return x.total > y.total;
+	}
+};
+
+} // End of anonymous namespace
+
+ProfileScope::ProfileScope(const char *name) : _buffer(getThreadBuffer()), _name(name) {
+	_buffer->depth++;
+	_start = Profiler::getMicros();
+}
+
+static void addEvent(ProfileThreadBuffer *buffer, const char *name, uint64 start, uint64 end) {
+	StackLock lock(buffer->mutex);
+	ProfileEvent &event = buffer->events[(buffer->head + buffer->count) % ProfileThreadBuffer::kCapacity];
+	event.name = name;
+	event.start = start;
+	event.duration = (uint32)MIN<uint64>(end - start, 0xFFFFFFFF);
+	event.depth = buffer->depth;
+
+	if (buffer->count < ProfileThreadBuffer::kCapacity)
+		buffer->count++;
+	else
+		buffer->head = (buffer->head + 1) % ProfileThreadBuffer::kCapacity;
+}
+
+ProfileScope::~ProfileScope() {
+	const uint64 end = Profiler::getMicros();
+	_buffer->depth--;
+
+	addEvent(_buffer, _name, _start, end);
+}
+
+namespace Profiler {
+
+void addZone(const char *name, uint64 start, uint64 end) {
+	addEvent(getThreadBuffer(), name, start, end);
+}
+
+void reset() {
+	if (!g_registry)
+		return;
+
+	StackLock lock(g_registry->mutex);
+	for (uint i = 0; i < g_registry->buffers.size(); ++i) {
+		ProfileThreadBuffer *buffer = g_registry->buffers[i];
+		StackLock bufferLock(buffer->mutex);
+		buffer->head = 0;
+		buffer->count = 0;
+	}
+	g_registry->counters.clear();
+}
+
+void addCounter(const char *name, int64 delta) {
+	ProfileRegistry *registry = getRegistry();
+	StackLock lock(registry->mutex);
+	registry->counters[name] += delta;
+}
+
+bool writeChromeTrace(WriteStream &stream) {
+	stream.writeString("{\"traceEvents\":[\n");
+
+	bool first = true;
+	if (g_registry) {
+		StackLock lock(g_registry->mutex);
+		for (uint i = 0; i < g_registry->buffers.size(); ++i) {
+			ProfileThreadBuffer *buffer = g_registry->buffers[i];
+			StackLock bufferLock(buffer->mutex);
+
+			for (uint j = 0; j < buffer->count; ++j) {
+				const ProfileEvent &event = buffer->events[(buffer->head + j) % ProfileThreadBuffer::kCapacity];
+				stream.writeString(String::format("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u}",
+					first ? "" : ",\n", escapeJSON(event.name).c_str(), buffer->id,
+					(unsigned long long)event.start, event.duration));
+				first = false;
+			}
+		}
+
+		// The counters are written as their value at the time of the dump
+		const uint64 now = getMicros();
+		for (HashMap<String, int64>::const_iterator i = g_registry->counters.begin(); i != g_registry->counters.end(); ++i) {
+			stream.writeString(String::format("%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%llu,\"args\":{\"value\":%lld}}",
+				first ? "" : ",\n", escapeJSON(i->_key.c_str()).c_str(), (unsigned long long)now, (long long)i->_value));
+			first = false;
+		}
+	}
+
+	stream.writeString("\n]}\n");
+	return !stream.err();
+}
+
+String getSummary() {
+	typedef HashMap<String, ZoneSummary> ZoneMap;
+	ZoneMap zones;
+	HashMap<String, int64> counters;
+
+	if (g_registry) {
+		StackLock lock(g_registry->mutex);
+		counters = g_registry->counters;
+		for (uint i = 0; i < g_registry->buffers.size(); ++i) {
+			ProfileThreadBuffer *buffer = g_registry->buffers[i];
+			StackLock bufferLock(buffer->mutex);
+
+			for (uint j = 0; j < buffer->count; ++j) {
+				const ProfileEvent &event = buffer->events[(buffer->head + j) % ProfileThreadBuffer::kCapacity];
+				ZoneSummary &zone = zones[event.name];
+				zone.name = event.name;
+				zone.calls++;
+				zone.total += event.duration;
+				zone.max = MAX(zone.max, event.duration);
+			}
+		}
+	}
+
+	Array<ZoneSummary> sorted;
+	for (ZoneMap::const_iterator i = zones.begin(); i != zones.end(); ++i)
+		sorted.push_back(i->_value);
+	sort(sorted.begin(), sorted.end(), ZoneTotalGreater());
+
+	String result = String::format("%-32s %8s %12s %10s %10s\n", "zone", "calls", "total (us)", "avg (us)", "max (us)");
+	for (uint i = 0; i < sorted.size(); ++i) {
+		const ZoneSummary &zone = sorted[i];
+		result += String::format("%-32s %8u %12llu %10llu %10u\n", zone.name.c_str(), zone.calls,
+			(unsigned long long)zone.total, (unsigned long long)(zone.total / zone.calls), zone.max);
+	}
+
+	if (!counters.empty()) {
+		Array<String> names;
+		for (HashMap<String, int64>::const_iterator i = counters.begin(); i != counters.end(); ++i)
+			names.push_back(i->_key);
+		sort(names.begin(), names.end());
+
+		result += String::format("\n%-32s %12s\n", "counter", "value");
+		for (uint i = 0; i < names.size(); ++i)
+			result += String::format("%-32s %12lld\n", names[i].c_str(), (long long)counters[names[i]]);
+	}
+	return result;
+}
+
+} // End of namespace Profiler
+
+} // End of namespace Common
+
+#endif
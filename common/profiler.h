@@ -0,0 +1,123 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Scoped profiling zones, enabled with --enable-profiler.
+ *
+ * Put PROFILE_SCOPE("engine.zone") at the start of a block to time it. Each
+ * thread records its zones into its own ring buffer, which can be dumped
+ * from the debugger console with the "profile" command, either as a summary
+ * or as a Chrome trace (load it in chrome://tracing or Perfetto).
+ *
+ * When the profiler is not built in, PROFILE_SCOPE expands to nothing.
+ *
+ * @{
+ */
+
+#ifdef USE_PROFILER
+
+#define PROFILE_CONCAT_DETAIL(a, b) a ## b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_DETAIL(a, b)
+
+/** Time the rest of the enclosing block. @p name must be a string literal. */
+#define PROFILE_SCOPE(name) ::Common::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+namespace Common {
+
+class String;
+class WriteStream;
+
+struct ProfileThreadBuffer;
+
+/**
+ * Records the time spent between its construction and destruction.
+ * Use the PROFILE_SCOPE macro rather than this class directly.
+ */
+class ProfileScope {
+public:
+	explicit ProfileScope(const char *name);
+	~ProfileScope();
+
+private:
+	ProfileThreadBuffer *_buffer;
+	const char *_name;
+	uint64 _start;
+};
+
+namespace Profiler {
+
+/** Discard all the recorded zones, and clear the counters. */
+void reset();
+
+/**
+ * Record a zone which is not a scope of the code, like a phase of a frame.
+ */
+void addZone(const char *name, uint64 start, uint64 end);
+
+/**
+ * Add @p delta to the counter @p name, for the events which are not
+ * durations, like dropped frames.
+ */
+void addCounter(const char *name, int64 delta = 1);
+
+/** Write all the recorded zones and the counters in the Chrome trace_event JSON format. */
+bool writeChromeTrace(WriteStream &stream);
+
+/**
+ * Return a table with the call count and the total, average and maximum time
+ * of each zone, followed by the value of each counter.
+ */
+String getSummary();
+
+} // End of namespace Profiler
+
+} // End of namespace Common
+
+#else
+
+#define PROFILE_SCOPE(name) do {} while (0)
+
+#endif
+
+namespace Common {
+namespace Profiler {
+
+/**
+ * Return a monotonic timestamp in microseconds. This is available even
+ * when the profiler is not built in, for lightweight counters.
+ */
+uint64 getMicros();
+
+} // End of namespace Profiler
+} // End of namespace Common
+
+/** @} */
+
+#endif
@@ -131,6 +131,8 @@ void QuickTimeParser::init() {
 				_tracks[i]->editList[0].mediaTime = 0;
 				_tracks[i]->editList[0].mediaRate = 1;
 			}
+
+			_tracks[i]->initSampleTables();
 		}
 	}
 }
@@ -832,6 +834,10 @@ QuickTimeParser::Track::Track() {
 	keyframeCount = 0;
 	keyframes = nullptr;
 	timeScale = 0;
+	chunkFirstSample = nullptr;
+	timeToSampleFirst = nullptr;
+	timeToSampleTime = nullptr;
+	sampleOffsets = nullptr;
 	width = 0;
 	height = 0;
 	codecType = CODEC_TYPE_MOV_OTHER;
@@ -847,9 +853,159 @@ QuickTimeParser::Track::~Track() {
 	delete[] sampleToChunk;
 	delete[] sampleSizes;
 	delete[] keyframes;
+	delete[] chunkFirstSample;
+	delete[] timeToSampleFirst;
+	delete[] timeToSampleTime;
+	delete[] sampleOffsets;
 
 	for (uint32 i = 0; i < sampleDescs.size(); i++)
 		delete sampleDescs[i];
 }
 
+// Return the number of entries of a sorted table which are not above the value
+static uint32 upperBound(const uint32 *table, uint32 count, uint32 value) {
+	uint32 low = 0, high = count;
+
+	while (low < high) {
+		uint32 mid = low + (high - low) / 2;
+
+		if (table[mid] <= value)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	return low;
+}
+
+void QuickTimeParser::Track::initSampleTables() {
+	// init() runs again for each decoder layer
+	if (chunkFirstSample)
+		return;
+
+	// The sample-to-chunk entries apply from their first chunk up to the next entry
+	chunkFirstSample = new uint32[chunkCount + 1];
+	uint32 totalSampleCount = 0;
+	uint32 entry = 0;
+
+	for (uint32 i = 0; i < chunkCount; i++) {
+		while (entry < sampleToChunkCount && i >= sampleToChunk[entry].first)
+			entry++;
+
+		chunkFirstSample[i] = totalSampleCount;
+
+		if (entry > 0)
+			totalSampleCount += sampleToChunk[entry - 1].count;
+	}
+
+	chunkFirstSample[chunkCount] = totalSampleCount;
+
+	uint32 timeToSampleEntries = MAX<int32>(timeToSampleCount, 0);
+	timeToSampleFirst = new uint32[timeToSampleEntries + 1];
+	timeToSampleTime = new uint32[timeToSampleEntries + 1];
+	uint32 sample = 0;
+	uint32 time = 0;
+
+	for (uint32 i = 0; i < timeToSampleEntries; i++) {
+		timeToSampleFirst[i] = sample;
+		timeToSampleTime[i] = time;
+		sample += timeToSample[i].count;
+		time += timeToSample[i].count * timeToSample[i].duration;
+	}
+
+	timeToSampleFirst[timeToSampleEntries] = sample;
+	timeToSampleTime[timeToSampleEntries] = time;
+
+	if (!sampleSizes)
+		return;
+
+	sampleOffsets = new uint32[sampleCount]();
+
+	for (uint32 i = 0; i < chunkCount; i++) {
+		uint32 offset = chunkOffsets[i];
+
+		for (uint32 j = chunkFirstSample[i]; j < chunkFirstSample[i + 1] && j < sampleCount; j++) {
+			sampleOffsets[j] = offset;
+			offset += sampleSizes[j];
+		}
+	}
+}
+
+uint32 QuickTimeParser::Track::getChunkSampleCount(uint32 chunk) const {
+	if (chunk >= chunkCount)
+		return 0;
+
+	return chunkFirstSample[chunk + 1] - chunkFirstSample[chunk];
+}
+
+uint32 QuickTimeParser::Track::getChunkDescId(uint32 chunk) const {
+	// Find the last sample-to-chunk entry starting at or before the chunk
+	uint32 low = 0, high = sampleToChunkCount;
+
+	while (low < high) {
+		uint32 mid = low + (high - low) / 2;
+
+		if (sampleToChunk[mid].first <= chunk)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	return low > 0 ? sampleToChunk[low - 1].id : 0;
+}
+
+int32 QuickTimeParser::Track::findSampleChunk(uint32 sample) const {
+	if (sample >= chunkFirstSample[chunkCount])
+		return -1;
+
+	// Empty chunks share their first sample with the next one, so this
+	// finds the chunk actually holding the sample
+	return upperBound(chunkFirstSample, chunkCount, sample) - 1;
+}
+
+uint32 QuickTimeParser::Track::getSampleOffset(uint32 sample, uint32 chunk) const {
+	if (sampleOffsets && sample < sampleCount)
+		return sampleOffsets[sample];
+
+	return chunkOffsets[chunk] + (sample - chunkFirstSample[chunk]) * sampleSize;
+}
+
+uint32 QuickTimeParser::Track::getSampleTime(uint32 sample) const {
+	uint32 entries = MAX<int32>(timeToSampleCount, 0);
+
+	if (sample >= timeToSampleFirst[entries])
+		return timeToSampleTime[entries];
+
+	uint32 entry = upperBound(timeToSampleFirst, entries, sample) - 1;
+	return timeToSampleTime[entry] + (sample - timeToSampleFirst[entry]) * timeToSample[entry].duration;
+}
+
+uint32 QuickTimeParser::Track::getSampleDuration(uint32 sample) const {
+	uint32 entries = MAX<int32>(timeToSampleCount, 0);
+
+	if (sample >= timeToSampleFirst[entries])
+		return 0;
+
+	return timeToSample[upperBound(timeToSampleFirst, entries, sample) - 1].duration;
+}
+
+uint32 QuickTimeParser::Track::findSampleAtTime(uint32 time) const {
+	uint32 entries = MAX<int32>(timeToSampleCount, 0);
+
+	if (time >= timeToSampleTime[entries])
+		return timeToSampleFirst[entries];
+
+	// Entries without any duration share their start time with the next
+	// one, so this finds an entry with a duration
+	uint32 entry = upperBound(timeToSampleTime, entries, time) - 1;
+	return timeToSampleFirst[entry] + (time - timeToSampleTime[entry]) / timeToSample[entry].duration;
+}
+
+uint32 QuickTimeParser::Track::findKeyframe(uint32 sample) const {
+	uint32 index = upperBound(keyframes, keyframeCount, sample);
+
+	// If none is found, assume the sample is a keyframe
+	return index > 0 ? keyframes[index - 1] : sample;
+}
+
 } // End of namespace Video
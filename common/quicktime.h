@@ -149,6 +149,23 @@ protected:
 		uint32 *keyframes;
 		int32 timeScale;
 
+		// Cumulative versions of the tables above, built by init() so that
+		// finding a sample is a binary search rather than a walk
+		uint32 *chunkFirstSample;  // First sample of each chunk, and the sample count
+		uint32 *timeToSampleFirst; // First sample of each time-to-sample entry, and the sample count
+		uint32 *timeToSampleTime;  // Start time of each time-to-sample entry, and the media duration
+		uint32 *sampleOffsets;     // Offset of each sample in the file, if sampleSizes is set
+
+		void initSampleTables();
+		uint32 getChunkSampleCount(uint32 chunk) const;
+		uint32 getChunkDescId(uint32 chunk) const;
+		int32 findSampleChunk(uint32 sample) const;
+		uint32 getSampleOffset(uint32 sample, uint32 chunk) const;
+		uint32 getSampleTime(uint32 sample) const;
+		uint32 getSampleDuration(uint32 sample) const;
+		uint32 findSampleAtTime(uint32 time) const;
+		uint32 findKeyframe(uint32 sample) const;
+
 		uint16 width;
 		uint16 height;
 		CodecType codecType;
@@ -28,7 +28,7 @@
 
 namespace Common {
 
-RDFT::RDFT(int bits, TransformType trans) : _bits(bits), _sin(1 << bits), _cos(1 << bits), _fft(nullptr) {
+RDFT::RDFT(int bits, TransformType trans) : _bits(bits), _fft(nullptr) {
 	assert((_bits >= 4) && (_bits <= 16));
 
 	_inverse        = trans == IDFT_C2R || trans == DFT_C2R;
@@ -36,13 +36,18 @@ RDFT::RDFT(int bits, TransformType trans) : _bits(bits), _sin(1 << bits), _cos(1
 
 	_fft = new FFT(bits - 1, trans == IDFT_C2R || trans == IDFT_R2C);
 
+	_sin = SineTable::getShared(1 << bits);
+	_cos = CosineTable::getShared(1 << bits);
+
 	int n = 1 << bits;
 
-	_tSin = _sin.getTable() + (trans == DFT_R2C || trans == DFT_C2R) * (n >> 2);
-	_tCos = _cos.getTable();
+	_tSin = _sin->getTable() + (trans == DFT_R2C || trans == DFT_C2R) * (n >> 2);
+	_tCos = _cos->getTable();
 }
 
 RDFT::~RDFT() {
+	SineTable::releaseShared(_sin);
+	CosineTable::releaseShared(_cos);
 	delete _fft;
 }
 
@@ -108,8 +108,8 @@ private:
 	int _inverse;
 	int _signConvention;
 
-	SineTable _sin;
-	CosineTable _cos;
+	const SineTable *_sin;
+	const CosineTable *_cos;
 	const float *_tSin;
 	const float *_tCos;
 
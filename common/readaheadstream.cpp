@@ -0,0 +1,264 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/readaheadstream.h"
+#include "common/threadpool.h"
+
+namespace Common {
+
+namespace {
+
+void fillAheadProc(void *refCon) {
+	((ReadAheadStream *)refCon)->fillAhead();
+}
+
+} // End of anonymous namespace
+
+ReadAheadStream::ReadAheadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(parentStream, disposeParentStream),
+	_blockSize(blockSize),
+	_numBlocks(numBlocks),
+	_head(0),
+	_headOffset(0),
+	_count(0),
+	_pos(parentStream->pos()),
+	_size(parentStream->size()),
+	_eos(false),
+	_parentEos(false) {
+
+	assert(blockSize > 0 && numBlocks > 0);
+	_blocks = new Block[numBlocks];
+	for (uint32 i = 0; i < numBlocks; ++i) {
+		_blocks[i].data = new byte[blockSize];
+		_blocks[i].size = 0;
+	}
+
+	RefillScheduler::addClient(&fillAheadProc, this);
+}
+
+ReadAheadStream::~ReadAheadStream() {
+	RefillScheduler::removeClient(this);
+
+	for (uint32 i = 0; i < _numBlocks; ++i)
+		delete[] _blocks[i].data;
+	delete[] _blocks;
+}
+
+void ReadAheadStream::fillAhead() {
+	// Fill one block at a time, so that the consumer gets a chance to seek
+	// in between.
+	for (;;) {
+		StackLock parentLock(_parentMutex);
+
+		Block *block;
+		{
+			StackLock lock(_mutex);
+			if (_count == _numBlocks || _parentEos)
+				return;
+			block = &_blocks[(_head + _count) % _numBlocks];
+		}
+
+		// The consumer only takes blocks from the head, and needs the
+		// parent lock to discard them, so the block stays ours
+		const uint32 size = _parentStream->read(block->data, _blockSize);
+		const bool end = _parentStream->eos() || _parentStream->err();
+
+		StackLock lock(_mutex);
+		block->size = size;
+		if (end)
+			_parentEos = true;
+		if (!size)
+			return;
+
+		_count++;
+		_stats.prefetchedBytes += size;
+	}
+}
+
+void ReadAheadStream::discardBlocks() {
+	_head = 0;
+	_headOffset = 0;
+	_count = 0;
+}
+
+bool ReadAheadStream::eos() const {
+	StackLock lock(_mutex);
+	return _eos;
+}
+
+bool ReadAheadStream::err() const {
+	StackLock parentLock(_parentMutex);
+	return _parentStream->err();
+}
+
+void ReadAheadStream::clearErr() {
+	StackLock parentLock(_parentMutex);
+	StackLock lock(_mutex);
+	_eos = false;
+	_parentStream->clearErr();
+}
+
+uint32 ReadAheadStream::readBlocks(byte *dst, uint32 dataSize) {
+	uint32 alreadyRead = 0;
+
+	while (alreadyRead < dataSize && _count > 0) {
+		Block &block = _blocks[_head];
+		const uint32 n = MIN(dataSize - alreadyRead, block.size - _headOffset);
+		memcpy(dst + alreadyRead, block.data + _headOffset, n);
+		alreadyRead += n;
+		_headOffset += n;
+
+		if (_headOffset == block.size) {
+			_head = (_head + 1) % _numBlocks;
+			_headOffset = 0;
+			_count--;
+		}
+	}
+
+	return alreadyRead;
+}
+
+uint32 ReadAheadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 alreadyRead;
+
+	{
+		StackLock lock(_mutex);
+		alreadyRead = readBlocks(dst, dataSize);
+		if (alreadyRead == dataSize || _parentEos)
+			return finishRead(alreadyRead, dataSize, false);
+	}
+
+	// The ring ran empty. Once the block being filled is done, the parent
+	// stream is positioned right at the data we need: read the rest directly.
+	StackLock parentLock(_parentMutex);
+	StackLock lock(_mutex);
+	bool stalled = false;
+	alreadyRead += readBlocks(dst + alreadyRead, dataSize - alreadyRead);
+	if (alreadyRead < dataSize && !_parentEos) {
+		stalled = true;
+		alreadyRead += _parentStream->read(dst + alreadyRead, dataSize - alreadyRead);
+		if (_parentStream->eos() || _parentStream->err())
+			_parentEos = true;
+	}
+	return finishRead(alreadyRead, dataSize, stalled);
+}
+
+uint32 ReadAheadStream::finishRead(uint32 alreadyRead, uint32 dataSize, bool stalled) {
+	_stats.reads++;
+	if (stalled)
+		_stats.stalls++;
+	else if (alreadyRead == dataSize)
+		_stats.hits++;
+
+	if (alreadyRead < dataSize)
+		_eos = true;
+
+	_pos += alreadyRead;
+
+	// Have the freed blocks filled again
+	if (_count < _numBlocks && !_parentEos)
+		RefillScheduler::wake();
+	return alreadyRead;
+}
+
+int32 ReadAheadStream::pos() const {
+	StackLock lock(_mutex);
+	return _pos;
+}
+
+int32 ReadAheadStream::size() const {
+	return _size;
+}
+
+bool ReadAheadStream::seek(int32 offset, int whence) {
+	StackLock parentLock(_parentMutex);
+	StackLock lock(_mutex);
+	int32 newPos;
+
+	switch (whence) {
+	case SEEK_END:
+		newPos = _size + offset;
+		break;
+	case SEEK_CUR:
+		newPos = _pos + offset;
+		break;
+	case SEEK_SET:
+	default:
+		newPos = offset;
+		break;
+	}
+
+	if (newPos < 0 || newPos > (int32)_size)
+		return false;
+
+	_eos = false;
+
+	// Forward seeks inside the buffered data just skip over it
+	if ((uint32)newPos >= _pos) {
+		uint32 skip = newPos - _pos;
+		while (_count > 0 && skip > 0) {
+			Block &block = _blocks[_head];
+			const uint32 n = MIN(skip, block.size - _headOffset);
+			skip -= n;
+			_headOffset += n;
+			_pos += n;
+
+			if (_headOffset == block.size) {
+				_head = (_head + 1) % _numBlocks;
+				_headOffset = 0;
+				_count--;
+			}
+		}
+
+		if (skip == 0)
+			return true;
+	}
+
+	discardBlocks();
+	_stats.seeks++;
+	_parentEos = false;
+	_parentStream->clearErr();
+	_pos = newPos;
+	const bool result = _parentStream->seek(newPos, SEEK_SET);
+	RefillScheduler::wake();
+	return result;
+}
+
+ReadAheadStats ReadAheadStream::getStats() const {
+	StackLock lock(_mutex);
+	return _stats;
+}
+
+void ReadAheadStream::resetStats() {
+	StackLock lock(_mutex);
+	_stats = ReadAheadStats();
+}
+
+ReadAheadStream *wrapReadAheadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream) {
+	if (!parentStream)
+		return nullptr;
+
+	return new ReadAheadStream(parentStream, blockSize, numBlocks, disposeParentStream);
+}
+
+} // End of namespace Common
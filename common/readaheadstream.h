@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_READAHEADSTREAM_H
+#define COMMON_READAHEADSTREAM_H
+
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_readaheadstream Read-ahead stream
+ * @ingroup common
+ *
+ * @brief API for reading streams ahead in the background.
+ *
+ * @{
+ */
+
+/**
+ * Statistics collected by a ReadAheadStream.
+ */
+struct ReadAheadStats {
+	uint32 reads;           ///< Number of read() calls.
+	uint32 hits;            ///< Number of read() calls fully served from read-ahead data.
+	uint32 stalls;          ///< Number of read() calls which had to wait for the parent stream.
+	uint32 seeks;           ///< Number of seeks which discarded the read-ahead data.
+	uint32 prefetchedBytes; ///< Number of bytes read ahead in the background.
+
+	ReadAheadStats() : reads(0), hits(0), stalls(0), seeks(0), prefetchedBytes(0) {}
+
+	/** Return the percentage of read() calls served without waiting. */
+	uint32 getHitRate() const { return reads ? hits * 100 / reads : 100; }
+};
+
+/**
+ * A stream wrapper which reads a SeekableReadStream ahead of its consumer.
+ *
+ * The parent stream is read into a ring of buffers on a background thread, so
+ * that sequential consumers like video decoders or streamed audio usually find
+ * their data already in memory instead of blocking on slow storage. Reads which
+ * find the ring empty, and seeks outside of the buffered range, fall back to
+ * accessing the parent stream directly.
+ *
+ * Once wrapped, the parent stream must not be accessed by anything else.
+ */
+class ReadAheadStream : public SeekableReadStream {
+public:
+	ReadAheadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream);
+	~ReadAheadStream();
+
+	bool eos() const override;
+	bool err() const override;
+	void clearErr() override;
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+	int32 pos() const override;
+	int32 size() const override;
+	bool seek(int32 offset, int whence = SEEK_SET) override;
+
+	/** Return the statistics collected since creation or the last resetStats(). */
+	ReadAheadStats getStats() const;
+	void resetStats();
+
+	/**
+	 * Fill the free buffers of the ring from the parent stream.
+	 *
+	 * This is called from the background thread as the buffers are consumed,
+	 * but can also be called manually, e.g. while waiting for the next frame.
+	 */
+	void fillAhead();
+
+private:
+	struct Block {
+		byte *data;
+		uint32 size;
+	};
+
+	void discardBlocks();
+
+	/**
+	 * Copy the buffered data at the current position. Called with _mutex held.
+	 *
+	 * @return The number of bytes copied.
+	 */
+	uint32 readBlocks(byte *dst, uint32 dataSize);
+
+	/** Update the position and the statistics after a read. Called with _mutex held. */
+	uint32 finishRead(uint32 alreadyRead, uint32 dataSize, bool stalled);
+
+	/**
+	 * Protects the parent stream. Taken before _mutex, and held without it
+	 * while reading ahead, so that the consumer can keep on reading the
+	 * buffers already filled.
+	 */
+	Mutex _parentMutex;
+	/** Protects the ring, the positions and the statistics. */
+	Mutex _mutex;
+	DisposablePtr<SeekableReadStream> _parentStream;
+
+	Block *_blocks;
+	const uint32 _blockSize;
+	const uint32 _numBlocks;
+	uint32 _head;       ///< Index of the block containing the current position
+	uint32 _headOffset; ///< Current position inside the head block
+	uint32 _count;      ///< Number of filled blocks, starting with the head block
+
+	uint32 _pos;
+	const uint32 _size;
+	bool _eos;
+	bool _parentEos;    ///< True if the parent stream has been read up to its end
+
+	ReadAheadStats _stats;
+};
+
+/**
+ * Take a SeekableReadStream and wrap it in a ReadAheadStream, which reads
+ * the stream ahead in the background using @p numBlocks buffers of
+ * @p blockSize bytes.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The SeekableReadStream to wrap.
+ * @param blockSize           Size of each read-ahead buffer.
+ * @param numBlocks           Number of read-ahead buffers.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+ReadAheadStream *wrapReadAheadStream(SeekableReadStream *parentStream, uint32 blockSize, uint32 numBlocks, DisposeAfterUse::Flag disposeParentStream);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
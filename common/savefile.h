@@ -23,11 +23,15 @@
 #ifndef COMMON_SAVEFILE_H
 #define COMMON_SAVEFILE_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/mutex.h"
 #include "common/noncopyable.h"
 #include "common/scummsys.h"
 #include "common/stream.h"
 #include "common/str-array.h"
 #include "common/error.h"
+#include "common/hash-str.h"
 
 namespace Common {
 
@@ -134,6 +138,33 @@ protected:
 	Error _error;      /*!< Error code. */
 	String _errorDesc; /*!< Description of an error. */
 
+	/**
+	 * Return whether openForSavingInBackground() may write the save files
+	 * on a worker thread. This requires the streams returned by
+	 * openForSaving() to be usable from another thread.
+	 */
+	virtual bool canSaveInBackground() const { return false; }
+
+	/**
+	 * Open the save file with the specified @p name like openForSaving(),
+	 * but leave an existing save file in place until the new one has been
+	 * finalized without errors. Used by openForSavingInBackground().
+	 *
+	 * The default implementation simply calls openForSaving().
+	 */
+	virtual OutSaveFile *openForSavingAtomically(const String &name, bool compress) { return openForSaving(name, compress); }
+
+	/**
+	 * Wait for the save file with the specified @p name to be written, if it
+	 * is being written in the background. Implementations supporting saving
+	 * in the background call this before using a save file.
+	 *
+	 * This may be called from any thread, but only the main thread, which
+	 * starts the saves in the background, finalizes the save file. Other threads only wait
+	 * for its data to be written.
+	 */
+	void waitForBackgroundSave(const String &name);
+
 	/**
 	 * Set some information about the last error that occurred.
 	 * @param error     Code identifying the last error.
@@ -142,7 +173,10 @@ protected:
 	virtual void setError(Error error, const String &errorDesc) { _error = error; _errorDesc = errorDesc; }
 
 public:
-	virtual ~SaveFileManager() {}
+	SaveFileManager();
+
+	/** Wait for the save files still being written in the background. */
+	virtual ~SaveFileManager();
 
 	/**
 	 * Clear the last set error code and string.
@@ -190,6 +224,60 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the save file with the specified @p name for saving in the
+	 * background. What is written to it is kept in memory. Once it is
+	 * finalized (or deleted), it is compressed and written out on a worker
+	 * thread, so that the caller does not wait for the disk. This must be
+	 * called from the main thread, which also finalizes the save files.
+	 *
+	 * Errors of the writing are reported by updateBackgroundSaves(). If the
+	 * save file manager cannot save in the background, the save file is
+	 * written right away, as with openForSaving().
+	 *
+	 * An existing save file of the same name is only replaced once the new
+	 * one has been written and finalized successfully.
+	 *
+	 * @param name      Name of the save file.
+	 * @param compress  Whether to compress the resulting save file (default) or not.
+	 *
+	 * @return Pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	OutSaveFile *openForSavingInBackground(const String &name, bool compress = true);
+
+	/**
+	 * Finish the save files written in the background which are done.
+	 * To be called regularly, for example once a frame, after saving in the
+	 * background. Only to be called from the thread which created the save
+	 * file manager.
+	 *
+	 * @param wait  Whether to wait for all the save files still being written.
+	 * @return False if writing one of the finished save files failed, in which
+	 *         case the error is set accordingly. True otherwise.
+	 */
+	bool updateBackgroundSaves(bool wait = false);
+
+	/**
+	 * Return whether save files are still being written in the background.
+	 */
+	bool isSavingInBackground() const;
+
+	/**
+	 * Return a number which changes whenever the save file with the specified
+	 * @p name is written or removed, so that what is known about its contents
+	 * can be checked for being up to date. Save files untouched since the
+	 * start return 0.
+	 */
+	uint32 getSaveFileStamp(const String &name) const;
+
+	/**
+	 * Record that the save file with the specified @p name was written or
+	 * removed. This is done by openForSavingInBackground() and by the save
+	 * file managers themselves, and is needed for save files written behind
+	 * their back, such as the ones downloaded by the cloud sync.
+	 */
+	void saveFileChanged(const String &name);
+
 	/**
 	 * Open the file with the specified @p name in the given directory for loading.
 	 *
@@ -256,6 +344,66 @@ public:
 	 * for saving or loading because they are being synced by CloudManager.
 	 */
 	virtual void updateSavefilesList(StringArray &lockedFiles) = 0;
+
+	/**
+	 * Look up the data stored for a save file in the index of the saves,
+	 * which lets listing the saves skip opening and parsing each of them.
+	 * The entry of a save file is dropped whenever the file is written,
+	 * renamed or removed.
+	 *
+	 * The default implementation keeps no index.
+	 *
+	 * @param name  Name of the save file.
+	 * @param data  Receives the data stored with writeIndexEntry().
+	 * @return True if the save file has an up to date entry, false otherwise.
+	 */
+	virtual bool readIndexEntry(const String &name, Array<byte> &data) { return false; }
+
+	/**
+	 * Store data for the current contents of a save file in the index of the
+	 * saves. The index is only written back by flushIndex().
+	 *
+	 * @param name  Name of the save file.
+	 * @param data  Data to store, usually what its header holds.
+	 */
+	virtual void writeIndexEntry(const String &name, const Array<byte> &data) {}
+
+	/**
+	 * Write back the entries stored since the last call.
+	 */
+	virtual void flushIndex() {}
+
+private:
+	friend class BackgroundOutSaveFile;
+
+	struct BackgroundSave;
+
+	/** Start writing data to the save file on a worker thread. Takes over the file and the data. */
+	void startBackgroundSave(const String &name, OutSaveFile *file, byte *data, uint32 size);
+
+	/** Finalize the save files written in the background which are done. */
+	void finishBackgroundSaves(bool wait);
+
+	bool isMainThread() const;
+
+	/** Guards _backgroundSaves, which is also looked at by other threads. */
+	mutable Mutex _backgroundSavesMutex;
+	List<BackgroundSave *> _backgroundSaves;
+	/**
+	 * The OSystem::ThreadId of the thread which started the first save in
+	 * the background, if _hasMainThread is set. Guarded by
+	 * _backgroundSavesMutex.
+	 */
+	uintptr _mainThread;
+	bool _hasMainThread;
+	String _failedBackgroundSave; /*!< Name of the last save file which failed to be written in the background. */
+
+	typedef HashMap<String, uint32, IgnoreCase_Hash, IgnoreCase_EqualTo> SaveFileStampMap;
+
+	/** Guards _saveFileStamps, which the cloud sync changes from its thread. */
+	mutable Mutex _saveFileStampsMutex;
+	SaveFileStampMap _saveFileStamps;
+	uint32 _nextSaveFileStamp;
 };
 
 /** @} */
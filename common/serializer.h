@@ -25,6 +25,7 @@
 
 #include "common/stream.h"
 #include "common/str.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -296,6 +297,80 @@ public:
 			serializer(*this, arr[i]);
 		}
 	}
+
+	/**
+	 * Sync an array of integers stored in little endian byte order.
+	 *
+	 * Unlike syncArray(), the whole array is transferred with a single stream
+	 * call and only needs to be byte-swapped on big endian hosts. T must be an
+	 * integer type of 1, 2, 4 or 8 bytes, matching the size of the stored values.
+	 */
+	template <typename T>
+	void syncArrayLE(T *arr, uint32 entries, Version minVersion = 0, Version maxVersion = kLastVersion) {
+#ifdef SCUMM_BIG_ENDIAN
+		syncIntegerArray(arr, entries, true, minVersion, maxVersion);
+#else
+		syncIntegerArray(arr, entries, false, minVersion, maxVersion);
+#endif
+	}
+
+	/**
+	 * Sync an array of integers stored in big endian byte order.
+	 * @see syncArrayLE
+	 */
+	template <typename T>
+	void syncArrayBE(T *arr, uint32 entries, Version minVersion = 0, Version maxVersion = kLastVersion) {
+#ifdef SCUMM_BIG_ENDIAN
+		syncIntegerArray(arr, entries, false, minVersion, maxVersion);
+#else
+		syncIntegerArray(arr, entries, true, minVersion, maxVersion);
+#endif
+	}
+
+private:
+	template <typename T>
+	void syncIntegerArray(T *arr, uint32 entries, bool swap, Version minVersion, Version maxVersion) {
+		STATIC_ASSERT(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, syncArray_needs_integer_entries);
+
+		if (_version < minVersion || _version > maxVersion)
+			return; // Ignore anything which is not supposed to be present in this save game version
+
+		const uint32 size = entries * sizeof(T);
+		if (isLoading()) {
+			_loadStream->read(arr, size);
+			if (swap)
+				swapArray(arr, entries);
+		} else if (!swap) {
+			_saveStream->write(arr, size);
+		} else {
+			// Swap a copy, chunk by chunk, to leave the array untouched
+			T buffer[256];
+			for (uint32 i = 0; i < entries; i += ARRAYSIZE(buffer)) {
+				const uint32 count = MIN<uint32>(entries - i, ARRAYSIZE(buffer));
+				memcpy(buffer, arr + i, count * sizeof(T));
+				swapArray(buffer, count);
+				_saveStream->write(buffer, count * sizeof(T));
+			}
+		}
+		_bytesSynced += size;
+	}
+
+	template <typename T>
+	static void swapArray(T *arr, uint32 entries) {
+		if (sizeof(T) == 2) {
+			uint16 *values = (uint16 *)arr;
+			for (uint32 i = 0; i < entries; ++i)
+				values[i] = SWAP_BYTES_16(values[i]);
+		} else if (sizeof(T) == 4) {
+			uint32 *values = (uint32 *)arr;
+			for (uint32 i = 0; i < entries; ++i)
+				values[i] = SWAP_BYTES_32(values[i]);
+		} else if (sizeof(T) == 8) {
+			uint64 *values = (uint64 *)arr;
+			for (uint32 i = 0; i < entries; ++i)
+				values[i] = SWAP_BYTES_64(values[i]);
+		}
+	}
 };
 
 #undef SYNC_PRIMITIVE
@@ -23,10 +23,36 @@
 // Based on eos' sine tables
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
 #include "common/sinetables.h"
 
 namespace Common {
 
+namespace {
+
+struct SharedSineTable {
+	SineTable *table;
+	int refCount;
+
+	SharedSineTable() : table(nullptr), refCount(0) {}
+};
+
+typedef HashMap<int, SharedSineTable> SharedSineTableMap;
+
+// Guards the shared tables, for the same reason as in cosinetables.cpp
+Mutex &getSharedTablesMutex() {
+	static Mutex *mutex = new Mutex();
+	return *mutex;
+}
+
+SharedSineTableMap &getSharedTables() {
+	static SharedSineTableMap *tables = new SharedSineTableMap();
+	return *tables;
+}
+
+} // End of anonymous namespace
+
 SineTable::SineTable(int nPoints) {
 	assert((nPoints >= 16) && (nPoints <= 65536)); // log2 space is in [4,16]
 	assert(nPoints % 4 == 0);
@@ -79,4 +105,29 @@ SineTable::~SineTable() {
 	delete[] _table;
 }
 
+const SineTable *SineTable::getShared(int nPoints) {
+	StackLock lock(getSharedTablesMutex());
+
+	SharedSineTable &shared = getSharedTables()[nPoints];
+	if (!shared.table)
+		shared.table = new SineTable(nPoints);
+	shared.refCount++;
+	return shared.table;
+}
+
+void SineTable::releaseShared(const SineTable *table) {
+	if (!table)
+		return;
+
+	StackLock lock(getSharedTablesMutex());
+
+	SharedSineTableMap &tables = getSharedTables();
+	SharedSineTable &shared = tables[table->_nPoints];
+	assert(shared.table == table);
+	if (--shared.refCount == 0) {
+		delete shared.table;
+		tables.erase(table->_nPoints);
+	}
+}
+
 } // End of namespace Common
@@ -55,7 +55,7 @@ public:
 	 * - Entries 2_nPoints/4 up to nPoints/2:
 	 *           sin(pi) till (excluding) sin(3/2*pi)
 	 */
-	const float *getTable() { return _tableEOS; }
+	const float *getTable() const { return _tableEOS; }
 
 	/**
 	 * Returns sin(2*pi * index / nPoints )
@@ -70,6 +70,17 @@ public:
 	 */
 	float atLegacy(int index) const;	
 
+	/**
+	 * Get a table of nPoints points shared by all its users.
+	 *
+	 * The table is created on the first request, and deleted when its last
+	 * user gives it back with releaseShared().
+	 */
+	static const SineTable *getShared(int nPoints);
+
+	/** Give back a table obtained with getShared(). */
+	static void releaseShared(const SineTable *table);
+
 private:
 	float *_tableEOS;
 	float *_table;
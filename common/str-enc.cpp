@@ -29,8 +29,112 @@
 #include "common/enc-internal.h"
 #include "common/file.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STR_ENC_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define STR_ENC_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
+namespace {
+
+// Nearly all the strings which are converted are plain ASCII, which is the
+// same in all the supported code pages, so runs of ASCII characters are
+// detected and copied at once.
+
+uint32 asciiPrefixLength(const char *src, uint32 len) {
+	uint32 i = 0;
+#if defined(STR_ENC_USE_SSE2)
+	for (; i + 16 <= len; i += 16) {
+		if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(src + i))))
+			break;
+	}
+#elif defined(STR_ENC_USE_NEON)
+	for (; i + 16 <= len; i += 16) {
+		const uint8x16_t v = vld1q_u8((const uint8_t *)(src + i));
+		if (vget_lane_u64(vreinterpret_u64_u8(vorr_u8(vget_low_u8(v), vget_high_u8(v))), 0) & 0x8080808080808080ULL)
+			break;
+	}
+#else
+	for (; i + 4 <= len; i += 4) {
+		if (READ_UINT32(src + i) & 0x80808080)
+			break;
+	}
+#endif
+	while (i < len && !(src[i] & 0x80))
+		i++;
+	return i;
+}
+
+uint32 asciiPrefixLength(const U32String::value_type *src, uint32 len) {
+	uint32 i = 0;
+#if defined(STR_ENC_USE_SSE2)
+	const __m128i nonASCII = _mm_set1_epi32(~0x7F);
+	for (; i + 4 <= len; i += 4) {
+		const __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + i)), nonASCII);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_setzero_si128())) != 0xFFFF)
+			break;
+	}
+#elif defined(STR_ENC_USE_NEON)
+	const uint32x4_t nonASCII = vdupq_n_u32(~0x7F);
+	for (; i + 4 <= len; i += 4) {
+		const uint32x4_t v = vandq_u32(vld1q_u32((const uint32_t *)(src + i)), nonASCII);
+		const uint32x2_t o = vorr_u32(vget_low_u32(v), vget_high_u32(v));
+		if (vget_lane_u32(o, 0) | vget_lane_u32(o, 1))
+			break;
+	}
+#endif
+	while (i < len && (uint32)src[i] < 0x80)
+		i++;
+	return i;
+}
+
+void widenASCII(U32String::value_type *dst, const char *src, uint32 count) {
+	uint32 i = 0;
+#if defined(STR_ENC_USE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= count; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+		const __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#elif defined(STR_ENC_USE_NEON)
+	for (; i + 8 <= count; i += 8) {
+		const uint16x8_t v = vmovl_u8(vld1_u8((const uint8_t *)(src + i)));
+		vst1q_u32((uint32_t *)(dst + i), vmovl_u16(vget_low_u16(v)));
+		vst1q_u32((uint32_t *)(dst + i + 4), vmovl_u16(vget_high_u16(v)));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = (byte)src[i];
+}
+
+void narrowASCII(char *dst, const U32String::value_type *src, uint32 count) {
+	uint32 i = 0;
+#if defined(STR_ENC_USE_SSE2)
+	for (; i + 16 <= count; i += 16) {
+		const __m128i lo = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(src + i)), _mm_loadu_si128((const __m128i *)(src + i + 4)));
+		const __m128i hi = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(src + i + 8)), _mm_loadu_si128((const __m128i *)(src + i + 12)));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#elif defined(STR_ENC_USE_NEON)
+	for (; i + 8 <= count; i += 8) {
+		const uint16x8_t v = vcombine_u16(vmovn_u32(vld1q_u32((const uint32_t *)(src + i))), vmovn_u32(vld1q_u32((const uint32_t *)(src + i + 4))));
+		vst1_u8((uint8_t *)(dst + i), vmovn_u16(v));
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = (char)src[i];
+}
+
+} // End of anonymous namespace
+
 // //TODO: This is a quick and dirty converter. Refactoring needed:
 // 1. Original version has an option for performing strict / nonstrict
 //    conversion for the 0xD800...0xDFFF interval
@@ -39,7 +143,7 @@ namespace Common {
 //
 // More comprehensive one lives in wintermute/utils/convert_utf.cpp
 void U32String::decodeUTF8(const char *src, uint32 len) {
-	ensureCapacity(len, false);
+	ensureCapacity(_size + len, true);
 
 	// The String class, and therefore the Font class as well, assume one
 	// character is one byte, but in this case it's actually an UTF-8
@@ -143,7 +247,7 @@ static void loadCJKTables() {
 }
 
 void U32String::decodeWindows932(const char *src, uint32 len) {
-	ensureCapacity(len, false);
+	ensureCapacity(_size + len, true);
 
 	if (!cjk_tables_loaded)
 		loadCJKTables();
@@ -222,7 +326,7 @@ uint16 convertUHCToUCS(uint8 high, uint8 low) {
 
 
 void U32String::decodeWindows949(const char *src, uint32 len) {
-	ensureCapacity(len, false);
+	ensureCapacity(_size + len, true);
 
 	if (!cjk_tables_loaded)
 		loadCJKTables();
@@ -253,7 +357,7 @@ void U32String::decodeWindows949(const char *src, uint32 len) {
 }
 
 void U32String::decodeWindows950(const char *src, uint32 len) {
-	ensureCapacity(len, false);
+	ensureCapacity(_size + len, true);
 
 	if (!cjk_tables_loaded)
 		loadCJKTables();
@@ -320,11 +424,14 @@ void String::encodeWindows932(const U32String &src) {
 	if (!reverseTable && windows932ConversionTable) {
 		uint16 *rt = new uint16[0x10000];
 		memset(rt, 0, sizeof(rt[0]) * 0x10000);
-		for (uint highidx = 0; highidx < 58; highidx++)
+		// The table loaded from encoding.dat has 47 rows
+		for (uint highidx = 0; highidx < 47; highidx++)
 			for (uint lowidx = 0; lowidx < 192; lowidx++) {
 				uint8 high = 0;
 				uint8 low = lowidx + 0x40;
 				uint16 unicode = windows932ConversionTable[highidx * 192 + lowidx];
+				if (!unicode)
+					continue;
 
 				if (highidx < 4)
 					high = highidx + 0x81;
@@ -775,7 +882,7 @@ void U32String::decodeOneByte(const char *src, uint32 len, CodePage page) {
 		conversionTable = kASCIIConversionTable;
 	}
 
-	ensureCapacity(len, false);
+	ensureCapacity(_size + len, true);
 
 	for (uint i = 0; i < len; ++i) {
 		if ((src[i] & 0x80) == 0) {
@@ -834,6 +941,14 @@ void String::encodeOneByte(const U32String &src, CodePage page, bool translitera
 }
 
 void String::encodeInternal(const U32String &src, CodePage page) {
+	if (asciiPrefixLength(src.c_str(), src.size()) == src.size()) {
+		ensureCapacity(src.size(), false);
+		narrowASCII(_str, src.c_str(), src.size());
+		_size = src.size();
+		_str[_size] = 0;
+		return;
+	}
+
 	switch(page) {
 	case kUtf8:
 		encodeUTF8(src);
@@ -875,6 +990,20 @@ void U32String::decodeInternal(const char *str, uint32 len, CodePage page) {
 	_storage[0] = 0;
 	_size = 0;
 
+	// The ASCII characters before the first other one are the same in all
+	// the code pages, and the decoders append the rest of the string
+	const uint32 ascii = asciiPrefixLength(str, len);
+	if (ascii) {
+		ensureCapacity(len, false);
+		widenASCII(_str, str, ascii);
+		_size = ascii;
+		_str[_size] = 0;
+		if (ascii == len)
+			return;
+		str += ascii;
+		len -= ascii;
+	}
+
 	switch(page) {
 	case kUtf8:
 		decodeUTF8(str, len);
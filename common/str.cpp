@@ -56,6 +56,13 @@ String &String::operator=(const String &str) {
 	return *this;
 }
 
+#ifdef USE_CXX11
+String &String::operator=(String &&str) {
+	assign(static_cast<BaseString<char> &&>(str));
+	return *this;
+}
+#endif
+
 String &String::operator=(char c) {
 	assign(c);
 	return *this;
@@ -26,8 +26,79 @@
 #include "common/substream.h"
 #include "common/str.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STREAM_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define STREAM_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
+namespace {
+
+#ifdef SCUMM_BIG_ENDIAN
+const bool kSwapLE = true;
+const bool kSwapBE = false;
+#else
+const bool kSwapLE = false;
+const bool kSwapBE = true;
+#endif
+
+// Both copy functions allow src and dst to be the same buffer.
+void copySwapBytes16(uint16 *dst, const byte *src, uint32 count) {
+	uint32 i = 0;
+#if defined(STREAM_USE_SSE2)
+	for (; i + 8 <= count; i += 8) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(src + i * 2));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+	}
+#elif defined(STREAM_USE_NEON)
+	for (; i + 8 <= count; i += 8)
+		vst1q_u8((uint8_t *)(dst + i), vrev16q_u8(vld1q_u8(src + i * 2)));
+#endif
+	for (; i < count; ++i)
+		dst[i] = SWAP_BYTES_16(READ_UINT16(src + i * 2));
+}
+
+void copySwapBytes32(uint32 *dst, const byte *src, uint32 count) {
+	uint32 i = 0;
+#if defined(STREAM_USE_SSE2)
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(src + i * 4));
+		v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+	}
+#elif defined(STREAM_USE_NEON)
+	for (; i + 4 <= count; i += 4)
+		vst1q_u8((uint8_t *)(dst + i), vrev32q_u8(vld1q_u8(src + i * 4)));
+#endif
+	for (; i < count; ++i)
+		dst[i] = SWAP_BYTES_32(READ_UINT32(src + i * 4));
+}
+
+template<typename T>
+void convertArray(T *dst, const byte *src, uint32 count, bool swap) {
+	if (swap) {
+		if (sizeof(T) == 2)
+			copySwapBytes16((uint16 *)dst, src, count);
+		else
+			copySwapBytes32((uint32 *)dst, src, count);
+	} else if ((const byte *)dst != src) {
+		memcpy(dst, src, count * sizeof(T));
+	}
+}
+
+template<typename T>
+uint32 readArray(ReadStream &stream, T *dst, uint32 count, bool swap) {
+	const uint32 n = stream.read(dst, count * sizeof(T)) / sizeof(T);
+	convertArray(dst, (const byte *)dst, n, swap);
+	return n;
+}
+
+} // End of anonymous namespace
+
 uint32 WriteStream::writeStream(ReadStream *stream, uint32 dataSize) {
 	void *buf = malloc(dataSize);
 	dataSize = stream->read(buf, dataSize);
@@ -45,6 +116,22 @@ void WriteStream::writeString(const String &str) {
 	write(str.c_str(), str.size());
 }
 
+uint32 ReadStream::readUint16LEArray(uint16 *dst, uint32 count) {
+	return readArray(*this, dst, count, kSwapLE);
+}
+
+uint32 ReadStream::readUint16BEArray(uint16 *dst, uint32 count) {
+	return readArray(*this, dst, count, kSwapBE);
+}
+
+uint32 ReadStream::readUint32LEArray(uint32 *dst, uint32 count) {
+	return readArray(*this, dst, count, kSwapLE);
+}
+
+uint32 ReadStream::readUint32BEArray(uint32 *dst, uint32 count) {
+	return readArray(*this, dst, count, kSwapBE);
+}
+
 SeekableReadStream *ReadStream::readStream(uint32 dataSize) {
 	void *buf = malloc(dataSize);
 	dataSize = read(buf, dataSize);
@@ -52,6 +139,25 @@ SeekableReadStream *ReadStream::readStream(uint32 dataSize) {
 	return new MemoryReadStream((byte *)buf, dataSize, DisposeAfterUse::YES);
 }
 
+SeekableReadStream *MappedReadStream::readStream(uint32 dataSize) {
+	const uint32 start = pos();
+	const uint32 available = size() - start;
+	const bool truncated = dataSize > available;
+
+	if (truncated)
+		dataSize = available;
+	seek(start + dataSize);
+
+	if (truncated) {
+		// Read past the end, to set the EOS flag like read() would.
+		byte dummy;
+		read(&dummy, 1);
+	}
+
+	assert(dataSize > 0);
+	return createView(start, start + dataSize);
+}
+
 Common::String ReadStream::readString(char terminator) {
 	Common::String result;
 	char c;
@@ -86,16 +192,47 @@ Common::String ReadStream::readPascalString(bool transformCR) {
 
 uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Read at most as many bytes as are still available...
+	memcpy(dataPtr, consume(dataSize), dataSize);
+	return dataSize;
+}
+
+const byte *MemoryReadStream::consume(uint32 &dataSize) {
 	if (dataSize > _size - _pos) {
 		dataSize = _size - _pos;
 		_eos = true;
 	}
-	memcpy(dataPtr, _ptr, dataSize);
-
+	const byte *data = _ptr;
 	_ptr += dataSize;
 	_pos += dataSize;
+	return data;
+}
 
-	return dataSize;
+uint32 MemoryReadStream::readUint16LEArray(uint16 *dst, uint32 count) {
+	uint32 dataSize = count * 2;
+	const byte *src = consume(dataSize);
+	convertArray(dst, src, dataSize / 2, kSwapLE);
+	return dataSize / 2;
+}
+
+uint32 MemoryReadStream::readUint16BEArray(uint16 *dst, uint32 count) {
+	uint32 dataSize = count * 2;
+	const byte *src = consume(dataSize);
+	convertArray(dst, src, dataSize / 2, kSwapBE);
+	return dataSize / 2;
+}
+
+uint32 MemoryReadStream::readUint32LEArray(uint32 *dst, uint32 count) {
+	uint32 dataSize = count * 4;
+	const byte *src = consume(dataSize);
+	convertArray(dst, src, dataSize / 4, kSwapLE);
+	return dataSize / 4;
+}
+
+uint32 MemoryReadStream::readUint32BEArray(uint32 *dst, uint32 count) {
+	uint32 dataSize = count * 4;
+	const byte *src = consume(dataSize);
+	convertArray(dst, src, dataSize / 4, kSwapBE);
+	return dataSize / 4;
 }
 
 bool MemoryReadStream::seek(int32 offs, int whence) {
@@ -225,6 +362,17 @@ uint32 SubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+SeekableReadStream *makeSafeSeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream) {
+	MappedReadStream *mapped = dynamic_cast<MappedReadStream *>(parentStream);
+	if (!mapped)
+		return new SafeSeekableSubReadStream(parentStream, begin, end, disposeParentStream);
+
+	SeekableReadStream *view = mapped->createView(begin, end);
+	if (disposeParentStream == DisposeAfterUse::YES)
+		delete parentStream;
+	return view;
+}
+
 SeekableSubReadStream::SeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream)
 	: SubReadStream(parentStream, end, disposeParentStream),
 	_parentStream(parentStream),
@@ -626,6 +626,46 @@ public:
 		return d;
 	}
 
+	/**
+	 * Read an array of unsigned 16-bit words stored in little endian
+	 * (LSB first) order from the stream.
+	 *
+	 * This is much faster than calling readUint16LE() in a loop, as the
+	 * data is read in one go and converted afterwards.
+	 *
+	 * @param dst   Buffer receiving at least @p count words.
+	 * @param count Number of words to read.
+	 *
+	 * @return The number of complete words read, which is less than
+	 *         @p count if a read error occurred or the end of the stream
+	 *         was reached.
+	 */
+	virtual uint32 readUint16LEArray(uint16 *dst, uint32 count);
+
+	/**
+	 * Read an array of unsigned 16-bit words stored in big endian
+	 * (MSB first) order from the stream.
+	 *
+	 * @see readUint16LEArray
+	 */
+	virtual uint32 readUint16BEArray(uint16 *dst, uint32 count);
+
+	/**
+	 * Read an array of unsigned 32-bit words stored in little endian
+	 * (LSB first) order from the stream.
+	 *
+	 * @see readUint16LEArray
+	 */
+	virtual uint32 readUint32LEArray(uint32 *dst, uint32 count);
+
+	/**
+	 * Read an array of unsigned 32-bit words stored in big endian
+	 * (MSB first) order from the stream.
+	 *
+	 * @see readUint16LEArray
+	 */
+	virtual uint32 readUint32BEArray(uint32 *dst, uint32 count);
+
 	/**
 	 * Read the specified amount of data into a malloc'ed buffer
 	 * which is then wrapped into a MemoryReadStream.
@@ -634,8 +674,11 @@ public:
 	 * if reading more data failed. This is because of an I/O error or because
 	 * the end of the stream was reached. It can be determined by
 	 * calling err() and eos().
+	 *
+	 * Streams backed by shared memory (see MappedReadStream) may return
+	 * a view into their data instead of a copy.
 	 */
-	SeekableReadStream *readStream(uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 
 	/**
 	 * Reads in a terminated string. Upon successful completion,
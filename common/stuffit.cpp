@@ -30,6 +30,7 @@
 #include "common/debug.h"
 #include "common/hash-str.h"
 #include "common/hashmap.h"
+#include "common/membercache.h"
 #include "common/memstream.h"
 #include "common/substream.h"
 
@@ -65,8 +66,11 @@ private:
 	typedef Common::HashMap<Common::String, FileEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileMap;
 	FileMap _map;
 
+	// The decompressed members, as games open the same ones repeatedly
+	mutable Common::MemberCache _cache;
+
 	// Decompression Functions
-	Common::SeekableReadStream *decompress14(Common::SeekableReadStream *src, uint32 uncompressedSize) const;
+	byte *decompress14(Common::SeekableReadStream *src, uint32 uncompressedSize) const;
 
 	// Decompression Helpers
 	void update14(uint16 first, uint16 last, byte *code, uint16 *freq) const;
@@ -197,6 +201,7 @@ bool StuffItArchive::open(const Common::String &filename) {
 void StuffItArchive::close() {
 	delete _stream; _stream = nullptr;
 	_map.clear();
+	_cache.clear();
 }
 
 bool StuffItArchive::hasFile(const Common::String &name) const {
@@ -229,8 +234,13 @@ Common::SeekableReadStream *StuffItArchive::createReadStreamForMember(const Comm
 	switch (entry.compression) {
 	case 0: // Uncompressed
 		return subStream.readStream(subStream.size());
-	case 14: // Installer
-		return decompress14(&subStream, entry.uncompressedSize);
+	case 14: { // Installer
+		Common::SeekableReadStream *cached = _cache.createReadStream(name);
+		if (cached)
+			return cached;
+
+		return _cache.add(name, decompress14(&subStream, entry.uncompressedSize), entry.uncompressedSize);
+	}
 	default:
 		error("Unhandled StuffIt compression %d", entry.compression);
 	}
@@ -425,7 +435,7 @@ void StuffItArchive::readTree14(Common::BitStream8LSB *bits, SIT14Data *dat, uin
 	dat->window[j++] = x; \
 	j &= 0x3FFFF
 
-Common::SeekableReadStream *StuffItArchive::decompress14(Common::SeekableReadStream *src, uint32 uncompressedSize) const {
+byte *StuffItArchive::decompress14(Common::SeekableReadStream *src, uint32 uncompressedSize) const {
 	byte *dst = (byte *)malloc(uncompressedSize);
 	Common::MemoryWriteStream out(dst, uncompressedSize);
 
@@ -517,7 +527,7 @@ Common::SeekableReadStream *StuffItArchive::decompress14(Common::SeekableReadStr
 	delete dat;
 	delete bits;
 
-	return new Common::MemoryReadStream(dst, uncompressedSize, DisposeAfterUse::YES);
+	return dst;
 }
 
 #undef OUTPUT_VAL
@@ -133,6 +133,18 @@ public:
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
 };
 
+/**
+ * Create a seekable stream restricted to the range [begin, end) of the given
+ * parent stream.
+ *
+ * If the parent is a MappedReadStream, a zero-copy view into its memory is
+ * returned. Such a view is independent from the parent: it neither moves the
+ * parent's position nor requires the parent to stay alive (if
+ * disposeParentStream is set, the parent is deleted right away). Otherwise a
+ * SafeSeekableSubReadStream is returned.
+ */
+SeekableReadStream *makeSafeSeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream = DisposeAfterUse::NO);
+
 /** @} */
 
 } // End of namespace Common
@@ -25,6 +25,7 @@
 #include "common/system.h"
 #include "common/events.h"
 #include "common/fs.h"
+#include "common/rect.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/taskbar.h"
@@ -191,6 +192,14 @@ void OSystem::fatalError() {
 	exit(1);
 }
 
+void OSystem::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	const int bytesPerPixel = getScreenFormat().bytesPerPixel;
+	for (uint i = 0; i < count; ++i) {
+		const Common::Rect &r = rects[i];
+		copyRectToScreen((const byte *)buf + r.top * pitch + r.left * bytesPerPixel, pitch, r.left, r.top, r.width(), r.height());
+	}
+}
+
 FilesystemFactory *OSystem::getFilesystemFactory() {
 	assert(_fsFactory);
 	return _fsFactory;
@@ -206,7 +215,7 @@ Common::WriteStream *OSystem::createConfigWriteStream() {
 	return nullptr;
 #else
 	Common::FSNode file(getDefaultConfigFileName());
-	return file.createWriteStream();
+	return file.createAtomicWriteStream();
 #endif
 }
 
@@ -38,6 +38,7 @@ class Mixer;
 
 namespace Graphics {
 struct Surface;
+struct YUVFrame;
 }
 
 namespace GUI {
@@ -499,7 +500,15 @@ public:
 		/**
 		* For platforms that should not have a Quit button.
 		*/
-		kFeatureNoQuit
+		kFeatureNoQuit,
+
+		/**
+		 * The backend can show planar YUV frames and converts them to RGB
+		 * itself, usually in a shader.
+		 *
+		 * @see showYUVFrame
+		 */
+		kFeatureYUVFrames
 	};
 
 	/**
@@ -1023,6 +1032,23 @@ public:
 	 */
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 
+	/**
+	 * Blit several rectangles of a buffer covering the whole screen onto
+	 * the virtual screen, as copyRectToScreen does for each of them.
+	 *
+	 * Backends can override this to do the work shared by the rects,
+	 * such as locking the screen, only once.
+	 *
+	 * @param buf    Buffer containing the graphics data of the whole screen,
+	 *               starting with its top left pixel.
+	 * @param pitch  Pitch of the buffer (number of bytes in a scanline).
+	 * @param rects  The rectangles to copy, in screen coordinates.
+	 * @param count  The number of rectangles.
+	 *
+	 * @see copyRectToScreen
+	 */
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count);
+
 	/**
 	 * Lock the active screen framebuffer and return a Graphics::Surface
 	 * representing it.
@@ -1054,6 +1080,22 @@ public:
 	 */
 	virtual void fillScreen(uint32 col) = 0;
 
+	/**
+	 * Show a planar YUV frame on top of the screen, for example a frame
+	 * of a video decoded with Video::VideoDecoder::setOutputYUV().
+	 *
+	 * The frame is copied, and is drawn at the given position of the game
+	 * screen by every updateScreen() call, until this is called again.
+	 * Any screen content it covers is hidden.
+	 *
+	 * This is only supported by backends with kFeatureYUVFrames.
+	 *
+	 * @param frame The frame to show, or nullptr to stop showing a frame.
+	 * @param x     x coordinate of the frame on the game screen.
+	 * @param y     y coordinate of the frame on the game screen.
+	 */
+	virtual void showYUVFrame(const Graphics::YUVFrame *frame, int x, int y) {}
+
 	/**
 	 * Flush the whole screen, i.e. render the current content of the screen
 	 * framebuffer to the display.
@@ -1417,6 +1459,76 @@ public:
 
 	/** @} */
 
+	/**
+	 * @defgroup common_system_threads Worker threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Optional support for worker threads, used by Common::ThreadPool to
+	 * spread independent pieces of work (decoding, scaling, etc.) over
+	 * several cores. Nothing may rely on these being available: backends
+	 * without thread support simply keep the default implementations, in
+	 * which case all work is run on the calling thread.
+	 */
+
+	typedef struct OpaqueThread *ThreadRef;
+	typedef struct OpaqueSemaphore *SemaphoreRef;
+	typedef void (*ThreadProc)(void *refCon);
+	typedef uintptr ThreadId;
+
+	/**
+	 * Return the number of CPU cores available to worker threads,
+	 * including the one running the calling thread.
+	 */
+	virtual uint getCPUCount() { return 1; }
+
+	/**
+	 * Create a new thread running the given procedure.
+	 *
+	 * @return The newly created thread, or 0 if threads are not supported
+	 *         or an error occurred.
+	 */
+	virtual ThreadRef createThread(ThreadProc proc, void *refCon) { return nullptr; }
+
+	/**
+	 * Wait for the given thread to finish and release it.
+	 */
+	virtual void joinThread(ThreadRef thread) {}
+
+	/**
+	 * Return an identifier of the calling thread, which differs from the
+	 * identifiers of all other running threads. This includes threads not
+	 * created with createThread(), such as the main or the timer thread.
+	 *
+	 * Backends without thread support return 0 for every thread.
+	 */
+	virtual ThreadId getCurrentThreadId() { return 0; }
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * @return The newly created semaphore, or 0 if threads are not supported
+	 *         or an error occurred.
+	 */
+	virtual SemaphoreRef createSemaphore(uint initialCount) { return nullptr; }
+
+	/**
+	 * Wait until the count of the given semaphore is positive, and decrement it.
+	 */
+	virtual void waitSemaphore(SemaphoreRef semaphore) {}
+
+	/**
+	 * Increment the count of the given semaphore, waking up one waiting thread.
+	 */
+	virtual void postSemaphore(SemaphoreRef semaphore) {}
+
+	/**
+	 * Delete the given semaphore. No thread may be waiting on it.
+	 */
+	virtual void deleteSemaphore(SemaphoreRef semaphore) {}
+
+	/** @} */
+
 
 
 	/** @defgroup common_system_sound Sound
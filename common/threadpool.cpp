@@ -0,0 +1,330 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/threadpool.h"
+#include "common/timer.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(ThreadPool);
+
+// More workers than this rarely pay off for the kind of work we queue.
+static const uint kMaxWorkers = 16;
+
+TaskGroup::TaskGroup() : _pending(0), _waiting(false), _done(nullptr) {
+}
+
+TaskGroup::~TaskGroup() {
+	wait();
+	if (_done)
+		g_system->deleteSemaphore(_done);
+}
+
+void TaskGroup::run(TaskProc proc, void *refCon) {
+	ThreadPool &pool = ThreadPool::instance();
+	if (pool.getNumWorkers() == 0) {
+		proc(refCon);
+		return;
+	}
+
+	{
+		StackLock lock(_mutex);
+		if (!_done)
+			_done = g_system->createSemaphore(0);
+		_pending++;
+	}
+
+	ThreadPool::Task task;
+	task.proc = proc;
+	task.refCon = refCon;
+	task.group = this;
+	pool.queueTask(task);
+}
+
+void TaskGroup::wait() {
+	ThreadPool &pool = ThreadPool::instance();
+
+	for (;;) {
+		{
+			StackLock lock(_mutex);
+			if (_pending == 0)
+				return;
+		}
+
+		// Help with the queued tasks, whichever group they belong to
+		if (pool.runQueuedTask())
+			continue;
+
+		// Nothing is queued anymore, so our remaining tasks are running on
+		// workers: sleep until the last one is done.
+		{
+			StackLock lock(_mutex);
+			if (_pending == 0)
+				return;
+			_waiting = true;
+		}
+		g_system->waitSemaphore(_done);
+	}
+}
+
+bool TaskGroup::isDone() {
+	StackLock lock(_mutex);
+	return _pending == 0;
+}
+
+void TaskGroup::taskDone() {
+	StackLock lock(_mutex);
+	assert(_pending > 0);
+	_pending--;
+	if (_pending == 0 && _waiting) {
+		_waiting = false;
+		g_system->postSemaphore(_done);
+	}
+}
+
+ThreadPool::ThreadPool() : _workAvailable(nullptr), _started(false), _quit(false) {
+}
+
+ThreadPool::~ThreadPool() {
+	stopWorkers();
+}
+
+uint ThreadPool::getNumWorkers() {
+	if (!_started)
+		startWorkers();
+	return _workers.size();
+}
+
+void ThreadPool::startWorkers() {
+	_started = true;
+
+#ifndef THREADPOOL_SERIAL_ONLY
+	const uint numWorkers = MIN(g_system->getCPUCount(), kMaxWorkers + 1) - 1;
+	if (numWorkers == 0)
+		return;
+
+	_workAvailable = g_system->createSemaphore(0);
+	if (!_workAvailable)
+		return;
+
+	_quit = false;
+	for (uint i = 0; i < numWorkers; ++i) {
+		OSystem::ThreadRef thread = g_system->createThread(&ThreadPool::workerProc, this);
+		if (!thread)
+			break;
+		_workers.push_back(thread);
+	}
+
+	if (_workers.empty()) {
+		g_system->deleteSemaphore(_workAvailable);
+		_workAvailable = nullptr;
+	}
+#endif
+}
+
+void ThreadPool::stopWorkers() {
+	if (!_workers.empty()) {
+		{
+			StackLock lock(_mutex);
+			_quit = true;
+		}
+
+		for (uint i = 0; i < _workers.size(); ++i)
+			g_system->postSemaphore(_workAvailable);
+		for (uint i = 0; i < _workers.size(); ++i)
+			g_system->joinThread(_workers[i]);
+		_workers.clear();
+
+		g_system->deleteSemaphore(_workAvailable);
+		_workAvailable = nullptr;
+	}
+
+	_started = false;
+}
+
+void ThreadPool::queueTask(const Task &task) {
+	{
+		StackLock lock(_mutex);
+		_tasks.push_back(task);
+	}
+	g_system->postSemaphore(_workAvailable);
+}
+
+bool ThreadPool::runQueuedTask() {
+	Task task;
+	{
+		StackLock lock(_mutex);
+		if (_tasks.empty())
+			return false;
+		task = _tasks.front();
+		_tasks.pop_front();
+	}
+
+	task.proc(task.refCon);
+	task.group->taskDone();
+	return true;
+}
+
+void ThreadPool::workerProc(void *refCon) {
+	ThreadPool *pool = (ThreadPool *)refCon;
+
+	for (;;) {
+		g_system->waitSemaphore(pool->_workAvailable);
+
+		{
+			StackLock lock(pool->_mutex);
+			if (pool->_quit)
+				return;
+		}
+
+		// The task may already have been taken by a waiting thread
+		pool->runQueuedTask();
+	}
+}
+
+WorkerThread::WorkerThread() : _proc(nullptr), _refCon(nullptr), _woken(false), _quit(false), _thread(nullptr), _wakeUp(nullptr) {
+}
+
+WorkerThread::~WorkerThread() {
+	if (_thread) {
+		{
+			StackLock lock(_mutex);
+			_quit = true;
+		}
+		g_system->postSemaphore(_wakeUp);
+		g_system->joinThread(_thread);
+	}
+
+	if (_wakeUp)
+		g_system->deleteSemaphore(_wakeUp);
+}
+
+bool WorkerThread::start(TaskProc proc, void *refCon) {
+	assert(!_thread);
+
+#ifndef THREADPOOL_SERIAL_ONLY
+	if (!_wakeUp)
+		_wakeUp = g_system->createSemaphore(0);
+	if (!_wakeUp)
+		return false;
+
+	_proc = proc;
+	_refCon = refCon;
+	_thread = g_system->createThread(&WorkerThread::threadProc, this);
+#endif
+	return _thread != nullptr;
+}
+
+void WorkerThread::wake() {
+	if (!_thread)
+		return;
+
+	StackLock lock(_mutex);
+	if (_woken)
+		return;
+	_woken = true;
+	g_system->postSemaphore(_wakeUp);
+}
+
+void WorkerThread::threadProc(void *refCon) {
+	WorkerThread *worker = (WorkerThread *)refCon;
+
+	for (;;) {
+		g_system->waitSemaphore(worker->_wakeUp);
+
+		{
+			StackLock lock(worker->_mutex);
+			if (worker->_quit)
+				return;
+			worker->_woken = false;
+		}
+
+		worker->_proc(worker->_refCon);
+	}
+}
+
+namespace {
+
+struct RefillClient {
+	TaskProc proc;
+	void *refCon;
+};
+
+struct RefillSchedulerState {
+	Mutex mutex;
+	Array<RefillClient> clients;
+	WorkerThread worker;
+
+	static void refillProc(void *refCon) {
+		RefillSchedulerState *state = (RefillSchedulerState *)refCon;
+		StackLock lock(state->mutex);
+
+		for (uint i = 0; i < state->clients.size(); ++i)
+			state->clients[i].proc(state->clients[i].refCon);
+	}
+};
+
+// Created with the first client and then kept around, as clients may be
+// removed from other threads (e.g. the mixer thread).
+RefillSchedulerState *g_refillScheduler = nullptr;
+
+} // End of anonymous namespace
+
+void RefillScheduler::addClient(TaskProc proc, void *refCon) {
+	if (!g_system)
+		return;
+
+	if (!g_refillScheduler) {
+		g_refillScheduler = new RefillSchedulerState();
+		if (!g_refillScheduler->worker.start(&RefillSchedulerState::refillProc, g_refillScheduler) && g_system->getTimerManager())
+			g_system->getTimerManager()->installTimerProc(&RefillSchedulerState::refillProc, 10000, g_refillScheduler, "RefillScheduler");
+	}
+
+	{
+		StackLock lock(g_refillScheduler->mutex);
+		RefillClient client = { proc, refCon };
+		g_refillScheduler->clients.push_back(client);
+	}
+	g_refillScheduler->worker.wake();
+}
+
+void RefillScheduler::removeClient(void *refCon) {
+	if (!g_refillScheduler)
+		return;
+
+	// Once we hold the lock, the client is not being refilled anymore
+	StackLock lock(g_refillScheduler->mutex);
+	Array<RefillClient> &clients = g_refillScheduler->clients;
+	for (uint i = 0; i < clients.size(); ++i) {
+		if (clients[i].refCon == refCon) {
+			clients.remove_at(i);
+			break;
+		}
+	}
+}
+
+void RefillScheduler::wake() {
+	if (g_refillScheduler)
+		g_refillScheduler->worker.wake();
+}
+
+} // End of namespace Common
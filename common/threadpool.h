@@ -0,0 +1,275 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/system.h"
+#include "common/util.h"
+
+// Platforms which never get worker threads: everything is run inline.
+#if defined(__PSP__) || defined(__DS__) || defined(__N64__)
+#define THREADPOOL_SERIAL_ONLY
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief API for running independent pieces of work on worker threads.
+ *
+ * @{
+ */
+
+typedef void (*TaskProc)(void *refCon);
+
+/**
+ * A set of tasks which can be waited for as a whole.
+ *
+ * Tasks must be independent of each other and must not call into OSystem
+ * (except for mutexes) or touch engine state shared with the main thread.
+ */
+class TaskGroup : NonCopyable {
+public:
+	TaskGroup();
+	/** Wait for all the remaining tasks of the group. */
+	~TaskGroup();
+
+	/**
+	 * Queue a task on the thread pool. If no worker threads are
+	 * available, it is run right away on the calling thread.
+	 */
+	void run(TaskProc proc, void *refCon);
+
+	/**
+	 * Wait until all the tasks of the group are finished. The calling thread
+	 * runs queued tasks itself in the meantime.
+	 */
+	void wait();
+
+	/** Return whether all the tasks of the group are finished, without waiting. */
+	bool isDone();
+
+private:
+	friend class ThreadPool;
+
+	void taskDone();
+
+	Mutex _mutex;
+	uint _pending;
+	bool _waiting;
+	OSystem::SemaphoreRef _done;
+};
+
+/**
+ * A fixed set of worker threads, sized to the number of CPU cores of the host.
+ *
+ * The workers are created on first use. On backends without thread support,
+ * or if THREADPOOL_SERIAL_ONLY is defined, there are no workers and all tasks
+ * run on the thread which queues them.
+ */
+class ThreadPool : public Singleton<ThreadPool> {
+public:
+	/** Return the number of worker threads, not counting the calling thread. */
+	uint getNumWorkers();
+
+	/** Stop and join all the worker threads. They are restarted on demand. */
+	void stopWorkers();
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	friend class TaskGroup;
+
+	struct Task {
+		TaskProc proc;
+		void *refCon;
+		TaskGroup *group;
+	};
+
+	ThreadPool();
+	~ThreadPool();
+
+	void startWorkers();
+	void queueTask(const Task &task);
+	/** Run one queued task on the calling thread. Returns false if there was none. */
+	bool runQueuedTask();
+
+	static void workerProc(void *refCon);
+
+	Mutex _mutex;
+	List<Task> _tasks;
+	Array<OSystem::ThreadRef> _workers;
+	OSystem::SemaphoreRef _workAvailable;
+	bool _started;
+	bool _quit;
+};
+
+/**
+ * A thread of its own, for background work which blocks or runs for long,
+ * such as reading or decoding ahead, and would otherwise hold up the timer
+ * thread or the workers of the pool. The thread runs a procedure each time
+ * it is woken up.
+ *
+ * On backends without thread support, or if THREADPOOL_SERIAL_ONLY is
+ * defined, it cannot be started, and the work has to be done elsewhere.
+ */
+class WorkerThread : NonCopyable {
+public:
+	WorkerThread();
+	/** Stop and join the thread. */
+	~WorkerThread();
+
+	/**
+	 * Start the thread, which is to run @p proc each time it is woken up.
+	 *
+	 * @return Whether the thread could be started.
+	 */
+	bool start(TaskProc proc, void *refCon);
+
+	/** Return whether the thread was started. */
+	bool isRunning() const { return _thread != nullptr; }
+
+	/**
+	 * Have the thread run its procedure. Wake ups coming before it gets to
+	 * it are merged. May be called from any thread.
+	 */
+	void wake();
+
+private:
+	static void threadProc(void *refCon);
+
+	Mutex _mutex;
+	TaskProc _proc;
+	void *_refCon;
+	bool _woken;
+	bool _quit;
+	OSystem::ThreadRef _thread;
+	OSystem::SemaphoreRef _wakeUp;
+};
+
+/**
+ * Keeps the buffers of its clients refilled in the background, as they are
+ * consumed, such as those of ReadAheadStream and Audio::DecodeAheadStream.
+ * The refill procedures of all the clients run on a WorkerThread shared by
+ * them, which the clients wake up. Without thread support, they are run from
+ * a timer callback instead.
+ *
+ * Lock order is: timer manager, scheduler, client. Clients must not hold
+ * their own locks while being added or removed.
+ */
+class RefillScheduler {
+public:
+	/** Have @p proc called with @p refCon each time the clients are refilled. */
+	static void addClient(TaskProc proc, void *refCon);
+
+	/**
+	 * Stop refilling the client added with @p refCon. Once this returns,
+	 * its procedure is not running anymore. May be called from any thread.
+	 */
+	static void removeClient(void *refCon);
+
+	/** Have the clients refilled. May be called from any thread. */
+	static void wake();
+};
+
+namespace ThreadPoolInternal {
+
+template<class Fn>
+struct ParallelForContext {
+	Mutex mutex;
+	uint next;
+	uint end;
+	uint grain;
+	Fn *fn;
+
+	static void run(void *refCon) {
+		ParallelForContext *ctx = (ParallelForContext *)refCon;
+		for (;;) {
+			uint chunkBegin, chunkEnd;
+			{
+				StackLock lock(ctx->mutex);
+				if (ctx->next >= ctx->end)
+					return;
+				chunkBegin = ctx->next;
+				chunkEnd = ctx->end - chunkBegin > ctx->grain ? chunkBegin + ctx->grain : ctx->end;
+				ctx->next = chunkEnd;
+			}
+			(*ctx->fn)(chunkBegin, chunkEnd);
+		}
+	}
+};
+
+} // End of namespace ThreadPoolInternal
+
+/**
+ * Split the range [begin, end) in chunks of @p grain items and call
+ * `fn(chunkBegin, chunkEnd)` for each of them, spread over the worker
+ * threads. Returns once all the chunks have been processed.
+ *
+ * Chunks may run in any order and concurrently, so @p fn must only write
+ * to data belonging to its own chunk.
+ */
+template<class Fn>
+void parallelFor(uint begin, uint end, uint grain, Fn fn) {
+	if (grain == 0)
+		grain = 1;
+	if (begin >= end)
+		return;
+
+	const uint numChunks = (end - begin + grain - 1) / grain;
+	const uint numWorkers = numChunks > 1 ? ThreadPool::instance().getNumWorkers() : 0;
+
+	if (numWorkers == 0) {
+		for (uint chunkBegin = begin; chunkBegin < end;) {
+			const uint chunkEnd = end - chunkBegin > grain ? chunkBegin + grain : end;
+			fn(chunkBegin, chunkEnd);
+			chunkBegin = chunkEnd;
+		}
+		return;
+	}
+
+	ThreadPoolInternal::ParallelForContext<Fn> ctx;
+	ctx.next = begin;
+	ctx.end = end;
+	ctx.grain = grain;
+	ctx.fn = &fn;
+
+	// Every task keeps on taking chunks until none are left, so one per
+	// worker is enough; the calling thread joins in while waiting.
+	TaskGroup group;
+	for (uint i = 0; i < MIN(numWorkers, numChunks - 1); ++i)
+		group.run(&ThreadPoolInternal::ParallelForContext<Fn>::run, &ctx);
+	ThreadPoolInternal::ParallelForContext<Fn>::run(&ctx);
+	group.wait();
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
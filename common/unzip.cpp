@@ -106,6 +106,7 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/zlib.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -1453,6 +1454,13 @@ public:
 };
 */
 
+/**
+ * Deflated members at least this large are inflated on the fly. Smaller
+ * ones are inflated at once, which costs less than the buffers and the
+ * window of a streaming decompressor.
+ */
+static const uLong kZipStreamingThreshold = 64 * 1024;
+
 ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
 	assert(_zipFile);
 }
@@ -1496,6 +1504,32 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
 		return nullptr;
 
+	// Stored members of a memory-mapped archive can be handed out as
+	// views into the mapping, without copying them. Large deflated
+	// members are inflated on the fly from such a view instead, so that
+	// reading their start does not cost inflating all of them. Each view
+	// has its own position, so the members can be read independently.
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	MappedReadStream *mapped = dynamic_cast<MappedReadStream *>(archive->_stream);
+#ifdef USE_ZLIB
+	const bool streamed = fileInfo.compression_method == Z_DEFLATED && fileInfo.uncompressed_size >= kZipStreamingThreshold;
+#else
+	const bool streamed = false;
+#endif
+	if (mapped && ((fileInfo.compression_method == 0 && fileInfo.uncompressed_size > 0) || streamed)) {
+		const uLong begin = archive->pfile_in_zip_read->pos_in_zipfile + archive->byte_before_the_zipfile;
+		const uLong end = begin + (streamed ? fileInfo.compressed_size : fileInfo.uncompressed_size);
+		unzCloseCurrentFile(_zipFile);
+		if (end > (uLong)mapped->size())
+			return nullptr;
+		if (streamed)
+			return wrapDeflateReadStream(mapped->createView(begin, end), fileInfo.uncompressed_size);
+		return mapped->createView(begin, end);
+	}
+
+	// FIXME: archives which are not memory-mapped share a single stream,
+	// which the members would have to share as well, so they are still
+	// read all into a memory stream.
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
@@ -1510,11 +1544,6 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -1522,7 +1551,7 @@ Archive *makeZipArchive(const String &name) {
 }
 
 Archive *makeZipArchive(const FSNode &node) {
-	return makeZipArchive(node.createReadStream());
+	return makeZipArchive(node.createMappedReadStream());
 }
 
 Archive *makeZipArchive(SeekableReadStream *stream) {
@@ -83,6 +83,11 @@ public:
 	/** Construct a copy of the given string. */
 	U32String(const U32String &str) : BaseString<u32char_type_t>(str) {}
 
+#ifdef USE_CXX11
+	/** Construct a string by taking over the contents of the given string, which is left empty. */
+	U32String(U32String &&str) : BaseString<u32char_type_t>(static_cast<BaseString<u32char_type_t> &&>(str)) {}
+#endif
+
 	/** Construct a new string from the given null-terminated C string that uses the given @p page encoding. */
 	explicit U32String(const char *str, CodePage page = kUtf8);
 
@@ -98,6 +103,11 @@ public:
 	/** Assign a given string to this string. */
 	U32String &operator=(const U32String &str);
 
+#ifdef USE_CXX11
+	/** Assign a given string to this string, leaving the given string empty. */
+	U32String &operator=(U32String &&str);
+#endif
+
 	/** @overload */
 	U32String &operator=(const String &str);
 
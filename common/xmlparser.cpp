@@ -28,6 +28,30 @@
 
 namespace Common {
 
+// Operations of the compiled form of an XML file
+enum {
+	kCompiledOpenKey = 1,
+	kCompiledCloseKey = 2,
+	kCompiledEnd = 3
+};
+
+static void writeCompiledString(WriteStream &stream, const String &str) {
+	stream.writeUint32LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+static bool readCompiledString(SeekableReadStream &stream, String &str) {
+	const uint32 size = stream.readUint32LE();
+	if (stream.eos() || size > (uint32)(stream.size() - stream.pos()))
+		return false;
+
+	char *buffer = new char[size];
+	stream.read(buffer, size);
+	str = String(buffer, size);
+	delete[] buffer;
+	return !stream.err();
+}
+
 XMLParser::~XMLParser() {
 	while (!_activeKey.empty())
 		freeNode(_activeKey.pop());
@@ -80,6 +104,14 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	if (_compiled) {
+		Common::String errorMessage = Common::String::format("\n  File <%s> (compiled):\n\nParser error: ", _fileName.c_str());
+		errorMessage += errStr;
+		errorMessage += "\n\n";
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -159,6 +191,9 @@ bool XMLParser::parseActiveKey(bool closed) {
 
 	ParserNode *key = _activeKey.top();
 
+	if (_compiledStream)
+		compileOpenKey(key, closed);
+
 	if (key->name == "xml" && key->header == true) {
 		assert(closed);
 		return parseXMLHeader(key) && closeKey();
@@ -387,6 +422,9 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_compiledStream)
+					compileCloseKey();
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -462,6 +500,118 @@ bool XMLParser::parse() {
 	return true;
 }
 
+bool XMLParser::parseAndCompile(WriteStream &compiled) {
+	_compiledStream = &compiled;
+	const bool result = parse();
+	_compiledStream = nullptr;
+
+	compiled.writeByte(kCompiledEnd);
+	return result && !compiled.err();
+}
+
+void XMLParser::compileOpenKey(const ParserNode *node, bool closed) {
+	_compiledStream->writeByte(kCompiledOpenKey);
+	writeCompiledString(*_compiledStream, node->name);
+	_compiledStream->writeByte(node->header);
+	_compiledStream->writeByte(closed);
+
+	_compiledStream->writeUint32LE(node->values.size());
+	for (StringMap::const_iterator i = node->values.begin(); i != node->values.end(); ++i) {
+		writeCompiledString(*_compiledStream, i->_key);
+		writeCompiledString(*_compiledStream, i->_value);
+	}
+}
+
+void XMLParser::compileCloseKey() {
+	_compiledStream->writeByte(kCompiledCloseKey);
+}
+
+bool XMLParser::parseCompiled() {
+	if (_stream == nullptr)
+		return false;
+
+	_stream->seek(0, SEEK_SET);
+
+	if (_XMLkeys == nullptr)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_compiled = true;
+	_state = kParserNeedKey;
+
+	bool done = false;
+	while (!done && _state != kParserError) {
+		const byte op = _stream->readByte();
+		if (_stream->eos()) {
+			parserError("Unexpected end of file.");
+			break;
+		}
+
+		switch (op) {
+		case kCompiledOpenKey: {
+			ParserNode *node = allocNode();
+			node->ignore = false;
+			node->depth = _activeKey.size();
+			node->layout = nullptr;
+			_activeKey.push(node);
+
+			if (!readCompiledString(*_stream, node->name)) {
+				parserError("Invalid key name.");
+				break;
+			}
+
+			node->header = _stream->readByte() != 0;
+			const bool closed = _stream->readByte() != 0;
+
+			const uint32 count = _stream->readUint32LE();
+			for (uint32 i = 0; i < count && _state != kParserError; ++i) {
+				String name, value;
+				if (!readCompiledString(*_stream, name) || !readCompiledString(*_stream, value))
+					parserError("Invalid key value.");
+				else
+					node->values[name] = value;
+			}
+
+			if (_state != kParserError)
+				parseActiveKey(closed);
+			break;
+		}
+
+		case kCompiledCloseKey:
+			if (_activeKey.empty()) {
+				parserError("Unexpected closure.");
+			} else {
+				const String name = _activeKey.top()->name;
+				if (!closeKey())
+					parserError("Missing data when closing key '" + name + "'.");
+			}
+			break;
+
+		case kCompiledEnd:
+			done = true;
+			break;
+
+		default:
+			parserError("Invalid compiled data.");
+			break;
+		}
+	}
+
+	_compiled = false;
+
+	if (_state == kParserError)
+		return false;
+
+	if (!_activeKey.empty())
+		return parserError("Unexpected end of file.");
+
+	return true;
+}
+
 bool XMLParser::skipSpaces() {
 	if (!isSpace(_char))
 		return false;
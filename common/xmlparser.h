@@ -46,6 +46,7 @@ namespace Common {
  */
 
 class SeekableReadStream;
+class WriteStream;
 
 #define MAX_XML_DEPTH 8
 
@@ -101,7 +102,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _compiledStream(nullptr), _compiled(false) {}
 
 	virtual ~XMLParser();
 
@@ -196,6 +197,19 @@ public:
 	 */
 	bool parse();
 
+	/**
+	 * Parses the loaded data stream like parse(), and writes a compiled form
+	 * of its keys and their properties to @p compiled. Replaying it with
+	 * parseCompiled() runs the same callbacks without tokenizing the XML.
+	 */
+	bool parseAndCompile(WriteStream &compiled);
+
+	/**
+	 * Parses a loaded data stream written by parseAndCompile().
+	 * Returns true if successful.
+	 */
+	bool parseCompiled();
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -356,6 +370,12 @@ private:
 	String _token; /** Current text token */
 
 	Stack<ParserNode *> _activeKey; /** Node stack of the parsed keys */
+
+	WriteStream *_compiledStream; /** Where parseAndCompile() writes the keys */
+	bool _compiled; /** Whether the loaded data stream is compiled */
+
+	void compileOpenKey(const ParserNode *node, bool closed);
+	void compileCloseKey();
 };
 
 /** @} */
@@ -24,6 +24,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -380,6 +381,177 @@ public:
 	}
 };
 
+/**
+ * Inflates raw deflate data, e.g. a zip archive member, on the fly. The
+ * state of the decompressor is saved every CHECKPOINT_INTERVAL bytes of
+ * output, so that backward seeks restart from the closest checkpoint
+ * instead of from the start of the data.
+ */
+class DeflateReadStream : public SeekableReadStream {
+protected:
+	enum {
+		BUFSIZE = 16384,
+		CHECKPOINT_INTERVAL = 256 * 1024
+	};
+
+	struct Checkpoint {
+		z_stream stream;
+		uint32 inputPos;   ///< Offset of the next compressed byte in the wrapped stream
+		uint32 outputPos;  ///< Offset of the next inflated byte
+	};
+
+	byte _buf[BUFSIZE];
+
+	ScopedPtr<SeekableReadStream> _wrapped;
+	z_stream _stream;
+	int _zlibErr;
+	uint32 _pos;
+	uint32 _size;
+	uint32 _inputPos;
+	bool _eos;
+	Array<Checkpoint *> _checkpoints;
+
+	void addCheckpoint() {
+		Checkpoint *checkpoint = new Checkpoint();
+		if (inflateCopy(&checkpoint->stream, &_stream) != Z_OK) {
+			delete checkpoint;
+			return;
+		}
+		checkpoint->inputPos = _inputPos - _stream.avail_in;
+		checkpoint->outputPos = _pos;
+		_checkpoints.push_back(checkpoint);
+	}
+
+	bool restart(const Checkpoint *checkpoint) {
+		inflateEnd(&_stream);
+		if (checkpoint) {
+			_zlibErr = inflateCopy(&_stream, const_cast<z_stream *>(&checkpoint->stream));
+			_inputPos = checkpoint->inputPos;
+			_pos = checkpoint->outputPos;
+		} else {
+			_stream = z_stream();
+			_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+			_inputPos = 0;
+			_pos = 0;
+		}
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		return _zlibErr == Z_OK && _wrapped->seek(_inputPos, SEEK_SET);
+	}
+
+public:
+	DeflateReadStream(SeekableReadStream *w, uint32 size) : _wrapped(w), _stream(), _pos(0), _size(size), _inputPos(0), _eos(false) {
+		assert(w != nullptr);
+
+		w->seek(0, SEEK_SET);
+
+		// Negative windowBits indicate raw deflate data, without any header
+		_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+	}
+
+	~DeflateReadStream() {
+		for (uint i = 0; i < _checkpoints.size(); ++i) {
+			inflateEnd(&_checkpoints[i]->stream);
+			delete _checkpoints[i];
+		}
+		inflateEnd(&_stream);
+	}
+
+	bool err() const { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
+	void clearErr() {
+		// only reset _eos; I/O errors are not recoverable
+		_eos = false;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+
+		while (_zlibErr == Z_OK && total < dataSize) {
+			// Stop at the next checkpoint, to save the state there
+			const uint32 nextCheckpoint = (_checkpoints.size() + 1) * CHECKPOINT_INTERVAL;
+			const uint32 chunk = (_pos < nextCheckpoint) ? MIN(dataSize - total, nextCheckpoint - _pos) : dataSize - total;
+
+			_stream.next_out = dst + total;
+			_stream.avail_out = chunk;
+			while (_zlibErr == Z_OK && _stream.avail_out) {
+				if (_stream.avail_in == 0 && !_wrapped->eos()) {
+					// If we are out of input data: Read more data, if available.
+					_stream.next_in = _buf;
+					_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
+					_inputPos += _stream.avail_in;
+				}
+				_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+				if (_zlibErr == Z_BUF_ERROR && _stream.avail_in == 0 && _wrapped->eos())
+					_zlibErr = Z_DATA_ERROR;
+			}
+
+			const uint32 produced = chunk - _stream.avail_out;
+			_pos += produced;
+			total += produced;
+			if (_zlibErr == Z_OK && _pos == nextCheckpoint)
+				addCheckpoint();
+		}
+
+		if (_zlibErr == Z_STREAM_END && total < dataSize)
+			_eos = true;
+
+		return total;
+	}
+
+	bool eos() const {
+		return _eos;
+	}
+	int32 pos() const {
+		return _pos;
+	}
+	int32 size() const {
+		return _size;
+	}
+	bool seek(int32 offset, int whence = SEEK_SET) {
+		int32 newPos = 0;
+		switch (whence) {
+		default:
+			// fallthrough intended
+		case SEEK_SET:
+			newPos = offset;
+			break;
+		case SEEK_CUR:
+			newPos = _pos + offset;
+			break;
+		case SEEK_END:
+			newPos = _size + offset;
+			break;
+		}
+
+		if (newPos < 0 || (uint32)newPos > _size)
+			return false;
+
+		// Restart from the closest checkpoint before the new position, when
+		// seeking backward or when it saves inflating some data
+		const uint32 index = MIN<uint32>((uint32)newPos / CHECKPOINT_INTERVAL, _checkpoints.size());
+		const Checkpoint *checkpoint = index ? _checkpoints[index - 1] : nullptr;
+		const uint32 checkpointPos = checkpoint ? checkpoint->outputPos : 0;
+		if ((uint32)newPos < _pos || checkpointPos > _pos) {
+			if (!restart(checkpoint))
+				return false;
+		}
+
+		// Inflate up to the new position, which also saves the checkpoints
+		// on the way
+		byte tmpBuf[1024];
+		while (!err() && _pos < (uint32)newPos) {
+			if (!read(tmpBuf, MIN<uint32>(sizeof(tmpBuf), newPos - _pos)))
+				break;
+		}
+
+		_eos = false;
+		return _pos == (uint32)newPos;
+	}
+};
+
 /**
  * A simple wrapper class which can be used to wrap around an arbitrary
  * other WriteStream and will then provide on-the-fly compression support.
@@ -511,6 +683,17 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 	return toBeWrapped;
 }
 
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 size) {
+	if (!toBeWrapped)
+		return nullptr;
+#if defined(USE_ZLIB)
+	return new DeflateReadStream(toBeWrapped, size);
+#else
+	delete toBeWrapped;
+	return nullptr;
+#endif
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 #if defined(USE_ZLIB)
 	if (toBeWrapped)
@@ -142,6 +142,23 @@ bool inflateZlibHeaderless(Common::WriteStream *dst, Common::SeekableReadStream
  */
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize = 0);
 
+/**
+ * Take a SeekableReadStream of raw deflate data, without any zlib or gzip
+ * header, and wrap it in a custom stream which inflates it on the fly. This
+ * is the format of the compressed members of zip archives.
+ *
+ * Backward seeks restart the decompression from checkpoints saved at
+ * regular intervals, so they only cost the decompression of the data since
+ * the closest checkpoint.
+ *
+ * The created stream becomes responsible for freeing the passed stream.
+ * Without ZLIB support, the passed stream is destroyed and NULL is returned.
+ *
+ * @param toBeWrapped	the stream of compressed data
+ * @param size			the size of the data once inflated
+ */
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 size);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which provides
  * transparent on-the-fly compression. The compressed data is written in the
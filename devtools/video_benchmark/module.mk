@@ -0,0 +1,22 @@
+
+MODULE := devtools/video_benchmark
+
+MODULE_OBJS := \
+	video_benchmark.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := video_benchmark
+
+# The decoders run against the null OSystem of the tests, so this needs the
+# objects of TEST_LIBS first, then the libraries
+TOOL_DEPS := $(filter-out %.a,$(TEST_LIBS)) \
+	video/libvideo.a \
+	image/libimage.a \
+	graphics/libgraphics.a \
+	audio/libaudio.a \
+	math/libmath.a \
+	common/libcommon.a
+TOOL_LIBS := $(LIBS)
+
+# Include common rules
+include $(srcdir)/rules.mk
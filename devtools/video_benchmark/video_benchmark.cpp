@@ -0,0 +1,305 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Decodes videos as fast as possible against the null OSystem, and
+// reports the decoding speed. See the README for the options.
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/profiler.h"
+#include "common/str.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include "video/3do_decoder.h"
+#include "video/avi_decoder.h"
+#include "video/bink_decoder.h"
+#if defined(ENABLE_GOB) || defined(ENABLE_SCI32) || defined(DYNAMIC_MODULES)
+#define VIDEO_BENCHMARK_VMD
+#include "video/coktel_decoder.h"
+#endif
+#include "video/dxa_decoder.h"
+#include "video/flic_decoder.h"
+#include "video/mpegps_decoder.h"
+#include "video/mve_decoder.h"
+#include "video/psx_decoder.h"
+#include "video/qt_decoder.h"
+#include "video/smk_decoder.h"
+#include "video/theora_decoder.h"
+
+#include "test/null_osystem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef POSIX
+#include <sys/resource.h>
+#endif
+
+struct Options {
+	Options() : type(0), format(4, 8, 8, 8, 8, 16, 8, 0, 24), yuv(false), convert(false), decodeAhead(0), maxFrames(0) {}
+
+	const char *type;
+	Graphics::PixelFormat format;
+	bool yuv;
+	bool convert;
+	uint decodeAhead;
+	uint maxFrames;
+};
+
+static const struct {
+	const char *name;
+	Graphics::PixelFormat format;
+} formats[] = {
+	{ "rgb565",   Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+	{ "rgb555",   Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0) },
+	{ "xrgb8888", Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0) },
+	{ "argb8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24) },
+	{ "rgba8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) }
+};
+
+static const struct {
+	const char *type;
+	const char *extensions;
+} types[] = {
+#ifdef USE_BINK
+	{ "bink",      "bik bk2" },
+#endif
+	{ "smacker",   "smk" },
+	{ "quicktime", "mov qt mp4 m4v" },
+	{ "avi",       "avi" },
+#ifdef VIDEO_BENCHMARK_VMD
+	{ "vmd",       "vmd" },
+#endif
+	{ "dxa",       "dxa" },
+	{ "flic",      "flc fli" },
+	{ "mve",       "mve" },
+	{ "psx",       "str" },
+#ifdef USE_THEORADEC
+	{ "theora",    "ogv ogg" },
+#endif
+	{ "mpegps",    "mpg mpeg vob" },
+	{ "3do",       "stream" }
+};
+
+static Video::VideoDecoder *createDecoder(const Common::String &type) {
+#ifdef USE_BINK
+	if (type == "bink")
+		return new Video::BinkDecoder();
+#endif
+	if (type == "smacker")
+		return new Video::SmackerDecoder();
+	if (type == "quicktime")
+		return new Video::QuickTimeDecoder();
+	if (type == "avi")
+		return new Video::AVIDecoder();
+#ifdef VIDEO_BENCHMARK_VMD
+	if (type == "vmd")
+		return new Video::AdvancedVMDDecoder();
+#endif
+	if (type == "dxa")
+		return new Video::DXADecoder();
+	if (type == "flic")
+		return new Video::FlicDecoder();
+	if (type == "mve")
+		return new Video::MveDecoder();
+	if (type == "psx")
+		return new Video::PSXStreamDecoder(Video::PSXStreamDecoder::kCD2x);
+#ifdef USE_THEORADEC
+	if (type == "theora")
+		return new Video::TheoraDecoder();
+#endif
+	if (type == "mpegps")
+		return new Video::MPEGPSDecoder();
+	if (type == "3do")
+		return new Video::ThreeDOMovieDecoder();
+	return 0;
+}
+
+static const char *findType(const Common::String &fileName) {
+	const char *dot = strrchr(fileName.c_str(), '.');
+	if (!dot)
+		return 0;
+
+	const Common::String extension = Common::String(dot + 1);
+	for (int i = 0; i < ARRAYSIZE(types); ++i) {
+		const Common::String extensions = types[i].extensions;
+		uint start = 0;
+		while (start < extensions.size()) {
+			uint end = start;
+			while (end < extensions.size() && extensions[end] != ' ')
+				end++;
+			if (extension.equalsIgnoreCase(Common::String(extensions.c_str() + start, end - start)))
+				return types[i].type;
+			start = end + 1;
+		}
+	}
+	return 0;
+}
+
+static uint64 percentile(const Common::Array<uint64> &sorted, uint percent) {
+	if (sorted.empty())
+		return 0;
+	return sorted[MIN<uint>(sorted.size() * percent / 100, sorted.size() - 1)];
+}
+
+static long getPeakMemory() {
+#ifdef POSIX
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss;
+#endif
+	return -1;
+}
+
+static bool benchmark(const char *fileName, const Options &options) {
+	const char *type = options.type ? options.type : findType(fileName);
+	if (!type) {
+		fprintf(stderr, "%s: unknown video type, use --type\n", fileName);
+		return false;
+	}
+
+	Video::VideoDecoder *decoder = createDecoder(type);
+	if (!decoder) {
+		fprintf(stderr, "%s: unsupported video type '%s'\n", fileName, type);
+		return false;
+	}
+	decoder->setDefaultHighColorFormat(options.format);
+
+	Common::SeekableReadStream *stream = Common::FSNode(fileName).createReadStream();
+	if (!stream || !decoder->loadStream(stream)) {
+		fprintf(stderr, "%s: could not open the video as %s\n", fileName, type);
+		delete decoder;
+		return false;
+	}
+
+	if (options.yuv && !decoder->setOutputYUV())
+		fprintf(stderr, "%s: no YUV output, the frames are converted by the decoder\n", fileName);
+	decoder->setDecodeAhead(options.decodeAhead);
+
+	Graphics::Surface converted;
+	Common::Array<uint64> frameTimes;
+	const uint64 start = Common::Profiler::getMicros();
+	while (!decoder->endOfVideo() && (!options.maxFrames || frameTimes.size() < options.maxFrames)) {
+		const uint64 frameStart = Common::Profiler::getMicros();
+		decoder->decodeNextFrame();
+		const Graphics::YUVFrame *yuvFrame = decoder->getYUVFrame();
+		if (options.convert && yuvFrame) {
+			if (converted.w != yuvFrame->w || converted.h != yuvFrame->h) {
+				converted.free();
+				converted.create(yuvFrame->w, yuvFrame->h, options.format);
+			}
+			YUVToRGBMan.convert(&converted, *yuvFrame);
+		}
+		frameTimes.push_back(Common::Profiler::getMicros() - frameStart);
+	}
+	const uint64 total = Common::Profiler::getMicros() - start;
+
+	Common::sort(frameTimes.begin(), frameTimes.end());
+	printf("%s: %s, %dx%d, %u frames in %.3f s, %.1f fps\n", fileName, type, decoder->getWidth(), decoder->getHeight(),
+	       frameTimes.size(), total / 1000000.0, total ? frameTimes.size() * 1000000.0 / total : 0.0);
+	printf("  ms per frame: p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n", percentile(frameTimes, 50) / 1000.0,
+	       percentile(frameTimes, 90) / 1000.0, percentile(frameTimes, 99) / 1000.0, percentile(frameTimes, 100) / 1000.0);
+
+	converted.free();
+	delete decoder;
+	return true;
+}
+
+static void printUsage(const char *name) {
+	printf("Usage: %s [options] <video>...\n\n", name);
+	printf("Decodes the videos as fast as possible, and reports their decoding speed.\n\n");
+	printf("Options:\n");
+	printf("  --type=<type>        the video type, instead of guessing it from the extension:\n                      ");
+	for (int i = 0; i < ARRAYSIZE(types); ++i)
+		printf(" %s", types[i].type);
+	printf("\n");
+	printf("  --format=<format>    the format YUV videos are converted to (default argb8888):\n                      ");
+	for (int i = 0; i < ARRAYSIZE(formats); ++i)
+		printf(" %s", formats[i].name);
+	printf("\n");
+	printf("  --yuv                keep the decoded frames in planar YUV\n");
+	printf("  --convert            with --yuv, convert the frames with YUVToRGBManager\n");
+	printf("  --decode-ahead=<n>   decode <n> frames ahead on a worker thread\n");
+	printf("  --frames=<n>         stop after <n> frames of each video\n");
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+	Common::Array<const char *> fileNames;
+	for (int i = 1; i < argc; ++i) {
+		if (!strncmp(argv[i], "--type=", 7)) {
+			options.type = argv[i] + 7;
+		} else if (!strncmp(argv[i], "--format=", 9)) {
+			int j = 0;
+			while (j < ARRAYSIZE(formats) && strcmp(argv[i] + 9, formats[j].name))
+				j++;
+			if (j == ARRAYSIZE(formats)) {
+				fprintf(stderr, "Unknown format '%s'\n", argv[i] + 9);
+				return 1;
+			}
+			options.format = formats[j].format;
+		} else if (!strcmp(argv[i], "--yuv")) {
+			options.yuv = true;
+		} else if (!strcmp(argv[i], "--convert")) {
+			options.convert = true;
+		} else if (!strncmp(argv[i], "--decode-ahead=", 15)) {
+			options.decodeAhead = atoi(argv[i] + 15);
+		} else if (!strncmp(argv[i], "--frames=", 9)) {
+			options.maxFrames = atoi(argv[i] + 9);
+		} else if (argv[i][0] == '-') {
+			printUsage(argv[0]);
+			return !strcmp(argv[i], "--help") ? 0 : 1;
+		} else {
+			fileNames.push_back(argv[i]);
+		}
+	}
+
+	if (fileNames.empty()) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	Common::install_null_g_system();
+
+	bool success = true;
+	for (uint i = 0; i < fileNames.size(); ++i)
+		success &= benchmark(fileNames[i], options);
+
+	const long peakMemory = getPeakMemory();
+	if (peakMemory >= 0)
+		printf("Peak memory: %ld KB\n", peakMemory);
+
+	return success ? 0 : 1;
+}
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/mutex.h"
 #include "common/config-manager.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -33,6 +34,7 @@
 #include "gui/gui-manager.h"
 #include "gui/message.h"
 #include "engines/advancedDetector.h"
+#include "engines/detectioncache.h"
 #include "engines/obsolete.h"
 
 /**
@@ -196,6 +198,61 @@ DetectedGame AdvancedMetaEngineDetection::toDetectedGame(const ADDetectedGame &a
 	return game;
 }
 
+namespace {
+// The deferrers in scope, each on the thread running its detection
+struct PiratedReportDeferrers {
+	Common::Mutex mutex;
+	Common::Array<ADPiratedReportDeferrer *> list;
+};
+
+PiratedReportDeferrers &getPiratedReportDeferrers() {
+	static PiratedReportDeferrers *deferrers = new PiratedReportDeferrers();
+	return *deferrers;
+}
+} // End of anonymous namespace
+
+ADPiratedReportDeferrer::ADPiratedReportDeferrer() : _thread(g_system->getCurrentThreadId()), _foundPirated(false) {
+	PiratedReportDeferrers &deferrers = getPiratedReportDeferrers();
+	Common::StackLock lock(deferrers.mutex);
+	deferrers.list.push_back(this);
+}
+
+ADPiratedReportDeferrer::~ADPiratedReportDeferrer() {
+	PiratedReportDeferrers &deferrers = getPiratedReportDeferrers();
+	Common::StackLock lock(deferrers.mutex);
+	for (uint i = 0; i < deferrers.list.size(); ++i) {
+		if (deferrers.list[i] == this) {
+			deferrers.list.remove_at(i);
+			break;
+		}
+	}
+}
+
+bool ADPiratedReportDeferrer::foundPirated() const {
+	return _foundPirated;
+}
+
+bool ADPiratedReportDeferrer::deferPiratedMessage() {
+	const OSystem::ThreadId thread = g_system->getCurrentThreadId();
+	PiratedReportDeferrers &deferrers = getPiratedReportDeferrers();
+	Common::StackLock lock(deferrers.mutex);
+	// The innermost deferrer of the thread is the last one added
+	for (uint i = deferrers.list.size(); i > 0; --i) {
+		if (deferrers.list[i - 1]->_thread == thread) {
+			deferrers.list[i - 1]->_foundPirated = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ADPiratedReportDeferrer::showPiratedMessage() {
+	if (GUI::GuiManager::hasInstance()) {
+		GUI::MessageDialog dialog(_("Illegitimate game copy detected. We provide no support in such cases"));
+		dialog.runModal();
+	}
+}
+
 bool cleanupPirated(ADDetectedGames &matched) {
 	// OKay, now let's sense presence of pirated games
 	if (!matched.empty()) {
@@ -209,10 +266,8 @@ bool cleanupPirated(ADDetectedGames &matched) {
 		// We ruled out all variants and now have nothing
 		if (matched.empty()) {
 			warning("Illegitimate game copy detected. We provide no support in such cases");
-			if (GUI::GuiManager::hasInstance()) {
-				GUI::MessageDialog dialog(_("Illegitimate game copy detected. We provide no support in such cases"));
-				dialog.runModal();
-			};
+			if (!ADPiratedReportDeferrer::deferPiratedMessage())
+				ADPiratedReportDeferrer::showPiratedMessage();
 			return true;
 		}
 	}
@@ -253,6 +308,12 @@ DetectedGames AdvancedMetaEngineDetection::detectGames(const Common::FSList &fsl
 	}
 
 	if (!foundKnownGames) {
+		// Fallback detectors commonly use static buffers or SearchMan, so
+		// only one of them may run at a time. The mutex is never freed, as
+		// it cannot outlive g_system.
+		static Common::Mutex *fallbackMutex = new Common::Mutex();
+		Common::StackLock lock(*fallbackMutex);
+
 		// Use fallback detector if there were no matches by other means
 		ADDetectedGame fallbackDetectionResult = fallbackDetect(allFiles, fslist);
 
@@ -467,14 +528,7 @@ bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, con
 	if (!allFiles.contains(fname))
 		return false;
 
-	Common::File testFile;
-
-	if (!testFile.open(allFiles[fname]))
-		return false;
-
-	fileProps.size = (int32)testFile.size();
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
-	return true;
+	return DetectionCache::instance().getFileProperties(allFiles[fname], _md5Bytes, fileProps);
 }
 
 bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const {
@@ -499,14 +553,7 @@ bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &a
 	if (!allFiles.contains(fname))
 		return false;
 
-	Common::File testFile;
-
-	if (!testFile.open(allFiles[fname]))
-		return false;
-
-	fileProps.size = (int32)testFile.size();
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, md5Bytes);
-	return true;
+	return DetectionCache::instance().getFileProperties(allFiles[fname], md5Bytes, fileProps);
 }
 
 ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &parent, const FileMap &allFiles, Common::Language language, Common::Platform platform, const Common::String &extra) const {
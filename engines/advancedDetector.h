@@ -224,6 +224,34 @@ struct ADExtraGuiOptionsMap {
 
 #define AD_EXTRA_GUI_OPTIONS_TERMINATOR { 0, { 0, 0, 0, 0 } }
 
+/**
+ * While in scope, the advanced detectors running on the calling thread do not
+ * show their message about illegitimate game copies, since dialogs can only
+ * be run from the GUI thread. Whether they found one is recorded instead, for
+ * the caller to report with showPiratedMessage().
+ */
+class ADPiratedReportDeferrer : Common::NonCopyable {
+public:
+	ADPiratedReportDeferrer();
+	~ADPiratedReportDeferrer();
+
+	/** Return whether an illegitimate game copy was found while in scope. */
+	bool foundPirated() const;
+
+	/** Tell the user about an illegitimate game copy. */
+	static void showPiratedMessage();
+
+	/**
+	 * Record that an illegitimate game copy was found, in the deferrer in
+	 * scope on the calling thread. Return false if there is none.
+	 */
+	static bool deferPiratedMessage();
+
+private:
+	uintptr _thread; /*!< OSystem::ThreadId of the thread it is in scope on. */
+	bool _foundPirated;
+};
+
 /**
  * A @ref MetaEngineDetection implementation based on the Advanced Detector code.
  */
@@ -342,6 +370,15 @@ public:
 	 */
 	DetectedGames detectGames(const Common::FSList &fslist) const override;
 
+	/**
+	 * The MD5-based detection is thread-safe, and fallbackDetect() calls are
+	 * serialized. Engines whose fallback detection goes through the plugin
+	 * manager or other engine code must return false.
+	 */
+	bool isDetectionThreadSafe() const override {
+		return true;
+	}
+
 	/**
 	 * A generic createInstance.
 	 *
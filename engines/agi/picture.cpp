@@ -46,6 +46,8 @@ PictureMgr::PictureMgr(AgiBase *agi, GfxMgr *gfx) {
 	_currentStep = 0;
 
 	_width = _height = 0;
+
+	_cacheUseCounter = 0;
 }
 
 void PictureMgr::putVirtPixel(int x, int y) {
@@ -838,6 +840,9 @@ void PictureMgr::draw_Fill(int16 x, int16 y) {
 	if (!_scrOn && !_priOn)
 		return;
 
+	byte *gameScreen = _gfx->getGameScreen();
+	byte *priorityScreen = _gfx->getPriorityScreen();
+
 	// Push initial pixel on the stack
 	Common::Stack<Common::Point> stack;
 	stack.push(Common::Point(x, y));
@@ -845,52 +850,52 @@ void PictureMgr::draw_Fill(int16 x, int16 y) {
 	// Exit if stack is empty
 	while (!stack.empty()) {
 		Common::Point p = stack.pop();
-		unsigned int c;
-		bool newspanUp, newspanDown;
 
 		if (!draw_FillCheck(p.x, p.y))
 			continue;
 
-		// Scan for left border
-		for (c = p.x - 1; draw_FillCheck(c, p.y); c--)
-			;
-
-		newspanUp = newspanDown = true;
-		for (c++; draw_FillCheck(c, p.y); c++) {
-			putVirtPixel(c, p.y);
-			if (draw_FillCheck(c, p.y - 1)) {
-				if (newspanUp) {
-					stack.push(Common::Point(c, p.y - 1));
-					newspanUp = false;
+		// Scan for both borders, then fill the whole span at once
+		int16 left = p.x;
+		int16 right = p.x;
+		while (draw_FillCheck(left - 1, p.y))
+			left--;
+		while (draw_FillCheck(right + 1, p.y))
+			right++;
+
+		int offset = (p.y + _yOffset) * SCRIPT_WIDTH + left + _xOffset;
+		if (_scrOn)
+			memset(gameScreen + offset, _scrColor, right - left + 1);
+		if (_priOn)
+			memset(priorityScreen + offset, _priColor, right - left + 1);
+
+		// Queue the start of each span touching this one, above and below
+		for (int16 row = p.y - 1; row <= p.y + 1; row += 2) {
+			bool newspan = true;
+			for (int16 c = left; c <= right; c++) {
+				if (draw_FillCheck(c, row)) {
+					if (newspan) {
+						stack.push(Common::Point(c, row));
+						newspan = false;
+					}
+				} else {
+					newspan = true;
 				}
-			} else {
-				newspanUp = true;
-			}
-
-			if (draw_FillCheck(c, p.y + 1)) {
-				if (newspanDown) {
-					stack.push(Common::Point(c, p.y + 1));
-					newspanDown = false;
-				}
-			} else {
-				newspanDown = true;
 			}
 		}
 	}
 }
 
-int PictureMgr::draw_FillCheck(int16 x, int16 y) {
+int PictureMgr::draw_FillCheck(int16 x, int16 y) const {
 	byte screenColor;
 	byte screenPriority;
 
 	if (x < 0 || x >= _width || y < 0 || y >= _height)
 		return false;
 
-	x += _xOffset;
-	y += _yOffset;
+	int offset = (y + _yOffset) * SCRIPT_WIDTH + x + _xOffset;
 
-	screenColor = _gfx->getColor(x, y);
-	screenPriority = _gfx->getPriority(x, y);
+	screenColor = _gfx->getGameScreen()[offset];
+	screenPriority = _gfx->getPriorityScreen()[offset];
 
 	if (_flags & kPicFTrollMode)
 		return ((screenColor != 11) && (screenColor != _scrColor));
@@ -931,14 +936,42 @@ int PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256, i
 	_width = pic_width;
 	_height = pic_height;
 
-	if (clearScreen && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
-		_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
+	// Only full screen 16 color pictures are cached. An overlay is cached along with the pictures
+	// below it, as long as the screen still holds exactly what they were rendered to.
+	bool cacheable = !agi256 && !(_flags & kPicFStep) && !_xOffset && !_yOffset &&
+	                 _width == _DEFAULT_WIDTH && _height == _DEFAULT_HEIGHT;
+	if (cacheable && !clearScreen) {
+		PictureCacheEntry *below = findCachedPicture(_cacheChain);
+		cacheable = below && _cacheChain.size() <= kPictureCacheMaxOverlays &&
+		            !memcmp(_gfx->getGameScreen(), below->visual.begin(), below->visual.size()) &&
+		            !memcmp(_gfx->getPriorityScreen(), below->priority.begin(), below->priority.size());
+	}
+	if (cacheable) {
+		if (clearScreen)
+			_cacheChain.clear();
+		_cacheChain.push_back(resourceNr);
+	} else {
+		_cacheChain.clear();
 	}
 
-	if (!agi256) {
-		drawPicture(); // Draw 16 color picture.
+	PictureCacheEntry *cached = cacheable ? findCachedPicture(_cacheChain) : nullptr;
+	if (cached) {
+		cached->lastUse = ++_cacheUseCounter;
+		memcpy(_gfx->getGameScreen(), cached->visual.begin(), cached->visual.size());
+		memcpy(_gfx->getPriorityScreen(), cached->priority.begin(), cached->priority.size());
 	} else {
-		drawPictureAGI256();
+		if (clearScreen && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
+			_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
+		}
+
+		if (!agi256) {
+			drawPicture(); // Draw 16 color picture.
+		} else {
+			drawPictureAGI256();
+		}
+
+		if (cacheable)
+			cachePicture(_cacheChain);
 	}
 
 	if (clearScreen)
@@ -980,6 +1013,42 @@ int PictureMgr::decodePicture(byte *data, uint32 length, int clr, int pic_width,
 	return errOK;
 }
 
+PictureCacheEntry *PictureMgr::findCachedPicture(const Common::Array<int16> &resources) {
+	if (resources.empty())
+		return nullptr;
+
+	for (uint i = 0; i < _cache.size(); i++) {
+		PictureCacheEntry &entry = _cache[i];
+		if (entry.resources == resources && entry.version == _pictureVersion && entry.flags == _flags)
+			return &entry;
+	}
+	return nullptr;
+}
+
+void PictureMgr::cachePicture(const Common::Array<int16> &resources) {
+	PictureCacheEntry *entry;
+	if (_cache.size() < kPictureCacheSize) {
+		_cache.push_back(PictureCacheEntry());
+		entry = &_cache.back();
+	} else {
+		// Replace the least recently used picture
+		entry = &_cache[0];
+		for (uint i = 1; i < _cache.size(); i++) {
+			if (_cache[i].lastUse < entry->lastUse)
+				entry = &_cache[i];
+		}
+	}
+
+	entry->resources = resources;
+	entry->version = _pictureVersion;
+	entry->flags = _flags;
+	entry->lastUse = ++_cacheUseCounter;
+	entry->visual.resize(SCRIPT_WIDTH * SCRIPT_HEIGHT);
+	entry->priority.resize(SCRIPT_WIDTH * SCRIPT_HEIGHT);
+	memcpy(entry->visual.begin(), _gfx->getGameScreen(), entry->visual.size());
+	memcpy(entry->priority.begin(), _gfx->getPriorityScreen(), entry->priority.size());
+}
+
 /**
  * Unload an AGI picture resource.
  * This function unloads an AGI picture resource and deallocates
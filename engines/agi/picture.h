@@ -23,6 +23,8 @@
 #ifndef AGI_PICTURE_H
 #define AGI_PICTURE_H
 
+#include "common/array.h"
+
 namespace Agi {
 
 #define _DEFAULT_WIDTH      160
@@ -61,6 +63,21 @@ enum AgiPictureFlags {
 	kPicFTrollMode = (1 << 5)
 };
 
+// Rendered pictures kept around, so that a room can be shown again without decoding it
+enum {
+	kPictureCacheSize = 8,
+	kPictureCacheMaxOverlays = 8
+};
+
+struct PictureCacheEntry {
+	Common::Array<int16> resources; // the picture, then the pictures overlaid on it
+	AgiPictureVersion version;
+	int flags;
+	uint32 lastUse;
+	Common::Array<byte> visual;
+	Common::Array<byte> priority;
+};
+
 class AgiBase;
 class GfxMgr;
 
@@ -105,10 +122,13 @@ private:
 	void draw_LineShort();
 	void draw_LineAbsolute();
 
-	int  draw_FillCheck(int16 x, int16 y);
+	int  draw_FillCheck(int16 x, int16 y) const;
 	void draw_Fill(int16 x, int16 y);
 	void draw_Fill();
 
+	PictureCacheEntry *findCachedPicture(const Common::Array<int16> &resources);
+	void cachePicture(const Common::Array<int16> &resources);
+
 public:
 	void showPic(); // <-- for regular AGI games
 	void showPic(int16 x, int16 y, int16 pic_width, int16 pic_height); // <-- for preAGI games
@@ -158,6 +178,10 @@ private:
 
 	int _flags;
 	int _currentStep;
+
+	Common::Array<PictureCacheEntry> _cache;
+	Common::Array<int16> _cacheChain; // what the screen holds, if it is a cached picture
+	uint32 _cacheUseCounter;
 };
 
 } // End of namespace Agi
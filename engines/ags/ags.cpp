@@ -53,6 +53,7 @@
 #include "ags/engine/main/main.h"
 #include "ags/engine/platform/base/agsplatformdriver.h"
 #include "ags/engine/script/script.h"
+#include "ags/shared/script/cc_options.h"
 #include "ags/engine/ac/route_finder.h"
 #include "ags/shared/core/assetmanager.h"
 #include "ags/shared/util/directory.h"
@@ -286,6 +287,7 @@ AGSEngine::AGSEngine(OSystem *syst, const AGSGameDescription *gameDesc) : Engine
 	DebugMan.addDebugChannel(kDebugGraphics, "Graphics", "Graphics debug level");
 	DebugMan.addDebugChannel(kDebugPath, "Path", "Pathfinding debug level");
 	DebugMan.addDebugChannel(kDebugScan, "Scan", "Scan for unrecognised games");
+	DebugMan.addDebugChannel(kDebugScript, "Script", "Count the instructions run by each script function");
 
 	_events = new EventsManager();
 	_music = new Music(_mixer);
@@ -334,6 +336,8 @@ Common::Error AGSEngine::run() {
 	setup_malloc_handling();
 #endif
 	AGS3::debug_flags = 0;
+	if (debugChannelSet(-1, kDebugScript))
+		AGS3::ccSetOption(SCOPT_PROFILE, 1);
 
 	AGS3::ConfigTree startup_opts;
 	int res = AGS3::main_process_cmdline(startup_opts, ARGC, ARGV);
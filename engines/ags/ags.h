@@ -49,7 +49,8 @@ namespace AGS {
 enum AGSDebugChannels {
 	kDebugGraphics = 1 << 0,
 	kDebugPath     = 1 << 1,
-	kDebugScan     = 1 << 2
+	kDebugScan     = 1 << 2,
+	kDebugScript   = 1 << 3
 };
 
 struct AGSGameDescription;
@@ -75,13 +75,19 @@ String GetRuntimeInfo() {
 		"Adventure Game Studio run-time engine[ACI version %s"
 		"[Game resolution %d x %d (%d-bit)"
 		"[Running %d x %d at %d-bit%s%s[GFX: %s; %s[Draw frame %d x %d["
-		"Sprite cache size: %d KB (limit %d KB; %d locked)",
+		"Sprite cache size: %d KB (limit %d KB; %d locked)"
+		"[Sprite cache: 8-bit %d KB, 16-bit %d KB, 24-bit %d KB, 32-bit %d KB"
+		"[Sprite cache: %u hits, %u misses, %u prefetched; %u ms loading",
 		_G(EngineVersion).LongString.GetCStr(), game.GetGameRes().Width, game.GetGameRes().Height, game.GetColorDepth(),
 		mode.Width, mode.Height, mode.ColorDepth, (convert_16bit_bgr) ? " BGR" : "",
 		mode.Windowed ? " W" : "",
 		gfxDriver->GetDriverName(), filter->GetInfo().Name.GetCStr(),
 		render_frame.GetWidth(), render_frame.GetHeight(),
-		spriteset.GetCacheSize() / 1024, spriteset.GetMaxCacheSize() / 1024, spriteset.GetLockedSize() / 1024);
+		spriteset.GetCacheSize() / 1024, spriteset.GetMaxCacheSize() / 1024, spriteset.GetLockedSize() / 1024,
+		spriteset.GetCacheSizeByDepth(1) / 1024, spriteset.GetCacheSizeByDepth(2) / 1024,
+		spriteset.GetCacheSizeByDepth(3) / 1024, spriteset.GetCacheSizeByDepth(4) / 1024,
+		spriteset.GetHitCount(), spriteset.GetMissCount(), spriteset.GetPrefetchCount(),
+		(uint32)(spriteset.GetLoadTime() / 1000));
 	if (play.separate_music_lib)
 		runtimeInfo.Append("[AUDIO.VOX enabled");
 	if (play.want_speech >= 1)
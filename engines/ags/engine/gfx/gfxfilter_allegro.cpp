@@ -29,6 +29,12 @@ namespace ALGfx {
 
 using namespace Shared;
 
+enum {
+	// The size of the blocks compared to find what changed in a frame
+	kChangeBlockWidth = 64,
+	kChangeBlockHeight = 16
+};
+
 const GfxFilterInfo AllegroGfxFilter::FilterInfo = GfxFilterInfo("StdScale", "Nearest-neighbour");
 
 AllegroGfxFilter::AllegroGfxFilter()
@@ -81,7 +87,7 @@ void AllegroGfxFilter::RenderScreen(Bitmap *toRender, int x, int y) {
 		const int height = _scaling.Y.ScaleDistance(toRender->GetHeight());
 		Bitmap *render_src = PreRenderPass(toRender);
 		if (render_src->GetSize() == _dstRect.GetSize())
-			realScreen->Blit(render_src, 0, 0, x, y, width, height);
+			BlitChangedAreas(render_src, x, y, width, height);
 		else {
 			realScreen->StretchBlt(render_src, RectWH(x, y, width, height));
 		}
@@ -151,6 +157,47 @@ void AllegroGfxFilter::GetCopyOfScreenIntoBitmap(Bitmap *copyBitmap, bool copy_w
 	}
 }
 
+void AllegroGfxFilter::BlitChangedAreas(Bitmap *toRender, int x, int y, int width, int height) {
+	// Most games are static most of the time, and the real screen only gives
+	// the backend the areas it was drawn to. Rather than tracking each
+	// sprite, which may also be drawn to the room surfaces before they get
+	// here, the frame is compared with what the screen shows.
+	if (toRender->GetAllegroBitmap()->format != realScreen->GetAllegroBitmap()->format
+	        || x < 0 || y < 0 || x + width > realScreen->GetWidth() || y + height > realScreen->GetHeight()) {
+		realScreen->Blit(toRender, 0, 0, x, y, width, height);
+		return;
+	}
+
+	const int bpp = toRender->GetBPP();
+	for (int top = 0; top < height; top += kChangeBlockHeight) {
+		const int bottom = MIN<int>(top + kChangeBlockHeight, height);
+
+		// Neighbouring changed blocks are copied at once
+		int runStart = -1, runEnd = -1;
+		for (int left = 0; left < width; left += kChangeBlockWidth) {
+			const int right = MIN<int>(left + kChangeBlockWidth, width);
+
+			bool changed = false;
+			for (int row = top; row < bottom && !changed; ++row) {
+				changed = memcmp(toRender->GetScanLine(row) + left * bpp,
+					realScreen->GetScanLine(y + row) + (x + left) * bpp, (right - left) * bpp) != 0;
+			}
+
+			if (changed) {
+				if (runStart < 0)
+					runStart = left;
+				runEnd = right;
+			} else if (runStart >= 0) {
+				realScreen->Blit(toRender, runStart, top, x + runStart, y + top, runEnd - runStart, bottom - top);
+				runStart = -1;
+			}
+		}
+
+		if (runStart >= 0)
+			realScreen->Blit(toRender, runStart, top, x + runStart, y + top, runEnd - runStart, bottom - top);
+	}
+}
+
 Bitmap *AllegroGfxFilter::PreRenderPass(Bitmap *toRender) {
 	// do nothing by default
 	return toRender;
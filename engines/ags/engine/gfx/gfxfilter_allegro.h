@@ -58,6 +58,8 @@ public:
 
 protected:
 	virtual Bitmap *PreRenderPass(Bitmap *toRender);
+	// Copies only the blocks of the frame which differ from the real screen
+	void BlitChangedAreas(Bitmap *toRender, int x, int y, int width, int height);
 
 	// pointer to real screen bitmap
 	Bitmap *realScreen;
@@ -31,6 +31,7 @@
 #include "ags/engine/ac/draw.h"
 #include "ags/engine/ac/gamestate.h"
 #include "ags/shared/ac/gamesetupstruct.h"
+#include "ags/shared/ac/spritecache.h"
 #include "ags/engine/ac/global_character.h"
 #include "ags/engine/ac/lipsync.h"
 #include "ags/engine/ac/overlay.h"
@@ -73,6 +74,11 @@ extern SpeechLipSyncLine *splipsync;
 extern int numLipLines, curLipLine, curLipLinePhoneme;
 extern int is_text_overlay;
 extern IGraphicsDriver *gfxDriver;
+extern SpriteCache spriteset;
+extern int displayed_room;
+
+// Max bytes of sprites to load ahead of their use in one game update
+#define SPRITE_PREFETCH_BUDGET (256 * 1024)
 
 int do_movelist_move(int16 *mlnum, int *xx, int *yy) {
 	int need_to_fix_sprite = 0;
@@ -208,6 +214,36 @@ void update_cycling_views() {
 	}
 }
 
+// Queues the next frame of the given loop for loading, if the budget allows
+static void prefetch_next_frame(int view, int loop, int frame, size_t &budget) {
+	if (view < 0 || view >= game.numviews || loop < 0 || loop >= views[view].numLoops)
+		return;
+	const ViewLoopNew &vloop = views[view].loops[loop];
+	if (vloop.numFrames < 2)
+		return;
+	int next = (frame + 1 < vloop.numFrames) ? frame + 1 : 0;
+	size_t size = spriteset.Prefetch(vloop.frames[next].pic);
+	budget = (size < budget) ? budget - size : 0;
+}
+
+void update_sprite_prefetch() {
+	// load the next frames of the running animations, so that they are
+	// already cached when the animation advances
+	size_t budget = SPRITE_PREFETCH_BUDGET;
+	for (int aa = 0; aa < game.numcharacters && budget > 0; aa++) {
+		CharacterInfo *chi = &game.chars[aa];
+		if (chi->on != 1 || chi->room != displayed_room)
+			continue;
+		if (chi->walking || chi->animating)
+			prefetch_next_frame(chi->view, chi->loop, chi->frame, budget);
+	}
+	for (int aa = 0; aa < croom->numobj && budget > 0; aa++) {
+		RoomObject *obj = &objs[aa];
+		if (obj->on == 1 && obj->cycling)
+			prefetch_next_frame(obj->view, obj->loop, obj->frame, budget);
+	}
+}
+
 void update_shadow_areas() {
 	// shadow areas
 	int onwalkarea = get_walkable_area_at_character(game.playercharacter);
@@ -472,6 +508,8 @@ void update_stuff() {
 
 	update_sierra_speech();
 
+	update_sprite_prefetch();
+
 	our_eip = 25;
 }
 
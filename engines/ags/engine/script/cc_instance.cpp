@@ -44,6 +44,8 @@
 #include "ags/shared/util/memory.h"
 #include "ags/shared/util/string_utils.h" // linux strnicmp definition
 #include "ags/engine/globals.h"
+#include "ags/lib/std/algorithm.h"
+#include "ags/lib/std/vector.h"
 
 namespace AGS3 {
 
@@ -237,6 +239,8 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	code_ops            = nullptr;
+	code_profile        = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -442,20 +446,22 @@ int ccInstance::Run(int curpc) {
 		*/
 		/* ReadOperation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+		// The instruction was decoded and checked on load
+		const ScriptCodeOp &op = codeInst->code_ops[pc];
+		codeOp.Instruction.Code         = op.Code;
+		codeOp.Instruction.InstanceId   = op.InstanceId;
+		codeOp.ArgCount                 = op.ArgCount;
+
+		if (op.Status != ScriptCodeOp::kValid) {
+			if (op.Status == ScriptCodeOp::kInvalidCode)
+				cc_error("invalid instruction %d found in code stream", op.Code);
+			else
+				cc_error("unexpected end of code data (%d; %d)", pc + op.ArgCount, codeInst->codesize);
 			return -1;
 		}
 
-		codeOp.ArgCount = sccmd_info[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
-		}
+		if (codeInst->code_profile)
+			codeInst->code_profile[funcstart[curnest]]++;
 
 		int pc_at = pc + 1;
 		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
@@ -1357,6 +1363,8 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		code_ops = joined->code_ops;
+		code_profile = joined->code_profile;
 	} else {
 		if (!ResolveScriptImports(scri)) {
 			return false;
@@ -1367,6 +1375,11 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 		if (!CreateRuntimeCodeFixups(scri)) {
 			return false;
 		}
+		CreateRuntimeCodeOps();
+		if (ccGetOption(SCOPT_PROFILE) && codesize > 0) {
+			code_profile = new uint32[codesize];
+			memset(code_profile, 0, codesize * sizeof(uint32));
+		}
 	}
 
 	exports = new RuntimeScriptValue[scri->numexports];
@@ -1412,6 +1425,9 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 }
 
 void ccInstance::Free() {
+	if ((flags & INSTF_SHAREDATA) == 0 && code_profile)
+		DumpProfile();
+
 	if (instanceof != nullptr) {
 		instanceof->instances--;
 		if (instanceof->instances == 0) {
@@ -1442,9 +1458,13 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete [] resolved_imports;
 		delete [] code_fixups;
+		delete [] code_ops;
+		delete [] code_profile;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	code_ops = nullptr;
+	code_profile = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(PScript scri) {
@@ -1615,6 +1635,66 @@ bool ccInstance::CreateRuntimeCodeFixups(PScript scri) {
 	return true;
 }
 
+// Decode the instruction at every code position, so that Run() does not
+// have to unpack and check it each time. The code does not change after
+// the fixups; the positions of the arguments decode to garbage, which is
+// fine as they are never run.
+void ccInstance::CreateRuntimeCodeOps() {
+	code_ops = new ScriptCodeOp[codesize];
+	for (int at_pc = 0; at_pc < codesize; ++at_pc) {
+		ScriptCodeOp &op = code_ops[at_pc];
+		op.Code = (int32)(code[at_pc] & INSTANCE_ID_REMOVEMASK);
+		op.InstanceId = (uint8)((code[at_pc] >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK);
+		op.ArgCount = 0;
+		if (op.Code < 0 || op.Code >= CC_NUM_SCCMDS) {
+			op.Status = ScriptCodeOp::kInvalidCode;
+			continue;
+		}
+		op.ArgCount = sccmd_info[op.Code].ArgCount;
+		op.Status = at_pc + op.ArgCount >= codesize ? ScriptCodeOp::kTruncated : ScriptCodeOp::kValid;
+	}
+}
+
+struct ProfileCount {
+	uint32 Count;
+	int    Start;
+};
+
+struct ProfileCountGreater {
+	bool operator()(const ProfileCount &a, const ProfileCount &b) const {
+		return a.Count > b.Count;
+	}
+};
+
+// Log the instructions counted for each function with SCOPT_PROFILE, the
+// busiest first
+void ccInstance::DumpProfile() {
+	std::vector<ProfileCount> counts;
+	for (int at_pc = 0; at_pc < codesize; ++at_pc) {
+		if (code_profile[at_pc]) {
+			ProfileCount count = { code_profile[at_pc], at_pc };
+			counts.push_back(count);
+		}
+	}
+	if (counts.empty())
+		return;
+	std::sort(counts.begin(), counts.end(), ProfileCountGreater());
+
+	Debug::Printf(kDbgMsg_Info, "Script profile of \"%s\":", instanceof->GetSectionName(0));
+	for (size_t i = 0; i < counts.size(); ++i) {
+		const int start = counts[i].Start;
+		String name = String::FromFormat("function at %d", start);
+		for (int k = 0; k < instanceof->numexports; k++) {
+			if ((instanceof->export_addr[k] & 0x00ffffff) == start &&
+			        ((instanceof->export_addr[k] >> 24L) & 0x000ff) == EXPORT_FUNCTION) {
+				name = instanceof->exports[k];
+				break;
+			}
+		}
+		Debug::Printf(kDbgMsg_Info, "  %10u  %s", counts[i].Count, name.GetCStr());
+	}
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int at_pc)
 {
@@ -78,6 +78,20 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Instruction of a code position, decoded once by CreateRuntimeCodeOps()
+struct ScriptCodeOp {
+	enum Status {
+		kValid,
+		kInvalidCode,   // not a known instruction
+		kTruncated      // arguments past the end of the code
+	};
+
+	int32   Code;       // pure instruction code
+	uint8   InstanceId;
+	uint8   ArgCount;
+	uint8   Status;
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -149,6 +163,11 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// decoded instruction of each code position
+	ScriptCodeOp *code_ops;
+	// with SCOPT_PROFILE, the instructions run by the function starting
+	// at each code position
+	uint32 *code_profile;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -191,6 +210,8 @@ protected:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int var_addr);
 	bool    CreateRuntimeCodeFixups(PScript scri);
+	void    CreateRuntimeCodeOps();
+	void    DumpProfile();
 	//bool    ReadOperation(ScriptOperation &op, int at_pc);
 
 	// Runtime fixups
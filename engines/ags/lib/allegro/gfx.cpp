@@ -27,6 +27,14 @@
 #include "common/textconsole.h"
 #include "graphics/screen.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AGS_GFX_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AGS_GFX_USE_NEON
+#endif
+
 namespace AGS3 {
 
 int color_conversion;
@@ -306,9 +314,140 @@ void stretch_sprite(BITMAP *bmp, const BITMAP *sprite, int x, int y, int w, int
 		Common::Rect(x, y, x + w, y + h));
 }
 
+/**
+ * Draws a row of 32-bit pixels, leaving alone the destination pixels for
+ * which (src & keyMask) == key. With alpha 255, the others are set to
+ * (src & copyMask) | alphaBits; otherwise the RGB channels are blended as
+ * (src * alpha + dest * (255 - alpha)) / 255, and the alpha one set to
+ * alphaBits.
+ */
+static void drawTransRow32(const uint32 *src, uint32 *dest, int count, uint32 keyMask, uint32 key,
+		uint32 copyMask, uint32 alphaBits, int alpha) {
+	int i = 0;
+#if defined(AGS_GFX_USE_SSE2)
+	const __m128i vKeyMask = _mm_set1_epi32(keyMask);
+	const __m128i vKey = _mm_set1_epi32(key);
+	const __m128i vAlphaBits = _mm_set1_epi32(alphaBits);
+	if (alpha == 255) {
+		const __m128i vCopyMask = _mm_set1_epi32(copyMask);
+		for (; i + 4 <= count; i += 4) {
+			const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+			const __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+			const __m128i keep = _mm_cmpeq_epi32(_mm_and_si128(s, vKeyMask), vKey);
+			const __m128i c = _mm_or_si128(_mm_and_si128(s, vCopyMask), vAlphaBits);
+			_mm_storeu_si128((__m128i *)(dest + i), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, c)));
+		}
+	} else {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i one = _mm_set1_epi16(1);
+		const __m128i vAlpha = _mm_set1_epi16(alpha);
+		const __m128i vInvAlpha = _mm_set1_epi16(255 - alpha);
+		for (; i + 4 <= count; i += 4) {
+			const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+			const __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+			const __m128i keep = _mm_cmpeq_epi32(_mm_and_si128(s, vKeyMask), vKey);
+			__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), vAlpha), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), vInvAlpha));
+			__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), vAlpha), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), vInvAlpha));
+			// x / 255 == (x + 1 + (x >> 8)) >> 8 for all the products
+			lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+			const __m128i c = _mm_or_si128(_mm_packus_epi16(lo, hi), vAlphaBits);
+			_mm_storeu_si128((__m128i *)(dest + i), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, c)));
+		}
+	}
+#elif defined(AGS_GFX_USE_NEON)
+	const uint32x4_t vKeyMask = vdupq_n_u32(keyMask);
+	const uint32x4_t vKey = vdupq_n_u32(key);
+	const uint32x4_t vAlphaBits = vdupq_n_u32(alphaBits);
+	if (alpha == 255) {
+		const uint32x4_t vCopyMask = vdupq_n_u32(copyMask);
+		for (; i + 4 <= count; i += 4) {
+			const uint32x4_t s = vld1q_u32(src + i);
+			const uint32x4_t d = vld1q_u32(dest + i);
+			const uint32x4_t keep = vceqq_u32(vandq_u32(s, vKeyMask), vKey);
+			const uint32x4_t c = vorrq_u32(vandq_u32(s, vCopyMask), vAlphaBits);
+			vst1q_u32(dest + i, vbslq_u32(keep, d, c));
+		}
+	} else {
+		const uint16x8_t one = vdupq_n_u16(1);
+		const uint8x8_t vAlpha = vdup_n_u8(alpha);
+		const uint8x8_t vInvAlpha = vdup_n_u8(255 - alpha);
+		for (; i + 4 <= count; i += 4) {
+			const uint32x4_t s = vld1q_u32(src + i);
+			const uint32x4_t d = vld1q_u32(dest + i);
+			const uint32x4_t keep = vceqq_u32(vandq_u32(s, vKeyMask), vKey);
+			const uint8x16_t s8 = vreinterpretq_u8_u32(s);
+			const uint8x16_t d8 = vreinterpretq_u8_u32(d);
+			uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(s8), vAlpha), vget_low_u8(d8), vInvAlpha);
+			uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(s8), vAlpha), vget_high_u8(d8), vInvAlpha);
+			// x / 255 == (x + 1 + (x >> 8)) >> 8 for all the products
+			lo = vshrq_n_u16(vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8)), 8);
+			hi = vshrq_n_u16(vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8)), 8);
+			const uint32x4_t c = vorrq_u32(vreinterpretq_u32_u8(vcombine_u8(vmovn_u16(lo), vmovn_u16(hi))), vAlphaBits);
+			vst1q_u32(dest + i, vbslq_u32(keep, d, c));
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		const uint32 s = src[i];
+		if ((s & keyMask) == key)
+			continue;
+
+		if (alpha == 255) {
+			dest[i] = (s & copyMask) | alphaBits;
+		} else {
+			const uint32 d = dest[i];
+			uint32 result = alphaBits;
+			for (int shift = 0; shift < 32; shift += 8) {
+				const uint x = ((s >> shift) & 0xff) * alpha + ((d >> shift) & 0xff) * (255 - alpha);
+				result |= ((x + 1 + (x >> 8)) >> 8) << shift;
+			}
+			dest[i] = result;
+		}
+	}
+}
+
+/**
+ * Fast path of draw_trans_sprite, for sprites drawn onto memory bitmaps of
+ * the same 8 bits per channel format. Returns false when it does not apply.
+ */
+static bool drawTransSprite32(BITMAP *bmp, const BITMAP *sprite, int x, int y, int alpha) {
+	const Graphics::PixelFormat &format = bmp->format;
+	if (sprite->format != format || format.bytesPerPixel != 4 || format.rLoss || format.gLoss || format.bLoss ||
+			format.aLoss || alpha < -1 || alpha > 255 || dynamic_cast<const Graphics::Screen *>(&bmp->getSurface()) != nullptr)
+		return false;
+
+	const Common::Rect destRect = Common::Rect(x, y, x + sprite->w, y + sprite->h).findIntersectingRect(Common::Rect(bmp->w, bmp->h));
+	if (destRect.isEmpty() || alpha == 0)
+		return true;
+
+	const uint32 alphaBits = format.ARGBToColor(0xff, 0, 0, 0);
+	const uint32 rgbMask = ~alphaBits;
+
+	// The same choices as transBlitFrom: the transparent color is matched
+	// on its RGB values, and with the sprite alpha used as it is (alpha -1)
+	// the pixels are copied as they are
+	const uint transColor = TRANSPARENT_COLOR(*sprite);
+	const uint32 keyMask = transColor ? rgbMask : 0xffffffff;
+	const uint32 key = transColor & keyMask;
+	const uint32 copyMask = alpha == -1 ? 0xffffffff : rgbMask;
+	if (alpha == -1)
+		alpha = 255;
+
+	for (int yp = destRect.top; yp < destRect.bottom; ++yp) {
+		const uint32 *srcP = (const uint32 *)sprite->getBasePtr(destRect.left - x, yp - y);
+		uint32 *destP = (uint32 *)bmp->getBasePtr(destRect.left, yp);
+		drawTransRow32(srcP, destP, destRect.width(), keyMask, key, copyMask, alpha == 255 && copyMask == 0xffffffff ? 0 : alphaBits, alpha);
+	}
+	return true;
+}
+
 void draw_trans_sprite(BITMAP *bmp, const BITMAP *sprite, int x, int y) {
 	assert(sprite->format.bytesPerPixel == 4);
 
+	if (drawTransSprite32(bmp, sprite, x, y, trans_blend_alpha))
+		return;
+
 	if (trans_blend_alpha == -1) {
 		bmp->getSurface().transBlitFrom(sprite->getSurface(), Common::Point(x, y),
 			TRANSPARENT_COLOR(*sprite));
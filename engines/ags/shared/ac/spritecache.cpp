@@ -41,6 +41,7 @@
 #include "ags/shared/util/compress.h"
 #include "ags/shared/util/file.h"
 #include "ags/shared/util/stream.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 namespace AGS3 {
@@ -71,6 +72,7 @@ SpriteInfo::SpriteInfo()
 SpriteCache::SpriteData::SpriteData()
 	: Offset(0)
 	, Size(0)
+	, ColorDepth(0)
 	, Flags(0)
 	, Image(nullptr) {
 }
@@ -115,6 +117,31 @@ sprkey_t SpriteCache::FindTopmostSprite() const {
 	return topmost;
 }
 
+size_t SpriteCache::GetCacheSizeByDepth(int coldep) const {
+	size_t size = 0;
+	for (size_t i = 0; i < _spriteData.size(); ++i) {
+		if (_spriteData[i].Image && _spriteData[i].IsAssetSprite() && _spriteData[i].ColorDepth == coldep)
+			size += _spriteData[i].Size;
+	}
+	return size;
+}
+
+uint32 SpriteCache::GetHitCount() const {
+	return _hits;
+}
+
+uint32 SpriteCache::GetMissCount() const {
+	return _misses;
+}
+
+uint32 SpriteCache::GetPrefetchCount() const {
+	return _prefetches;
+}
+
+uint64 SpriteCache::GetLoadTime() const {
+	return _loadTime;
+}
+
 void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
@@ -126,6 +153,10 @@ void SpriteCache::Init() {
 	_liststart = -1;
 	_listend = -1;
 	_lastLoad = -2;
+	_hits = 0;
+	_misses = 0;
+	_prefetches = 0;
+	_loadTime = 0;
 }
 
 void SpriteCache::Reset() {
@@ -253,13 +284,45 @@ Bitmap *SpriteCache::operator [](sprkey_t index) {
 		return _spriteData[index].Image;
 
 	// Sprite exists in file but is not in mem, load it
-	if ((_spriteData[index].Image == nullptr) && _spriteData[index].IsAssetSprite())
-		LoadSprite(index);
+	if (_spriteData[index].IsAssetSprite()) {
+		if (_spriteData[index].Image == nullptr) {
+			_misses++;
+			LoadSprite(index);
+		} else {
+			_hits++;
+		}
+	}
 
 	// Locked sprite that shouldn't be put into MRU list
 	if (_spriteData[index].IsLocked())
 		return _spriteData[index].Image;
 
+	TouchSprite(index);
+	return _spriteData[index].Image;
+}
+
+size_t SpriteCache::Prefetch(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return 0;
+	if (_spriteData[index].Image != nullptr || !_spriteData[index].IsAssetSprite())
+		return 0;
+
+	// Never make room for a sprite which may not be drawn at all
+	const SpriteInfo &info = _sprInfos[index];
+	if (_cacheSize + (size_t)info.Width * info.Height * 4 > _maxCacheSize)
+		return 0;
+
+	size_t size = LoadSprite(index);
+	if (_spriteData[index].Image == nullptr)
+		return 0;
+	_prefetches++;
+	// Put it in the MRU list, or the cache would never dispose it
+	if (!_spriteData[index].IsLocked())
+		TouchSprite(index);
+	return size;
+}
+
+void SpriteCache::TouchSprite(sprkey_t index) {
 	if (_liststart < 0) {
 		_liststart = index;
 		_listend = index;
@@ -283,8 +346,6 @@ Bitmap *SpriteCache::operator [](sprkey_t index) {
 		_mrubacklink[index] = _listend;
 		_listend = index;
 	}
-
-	return _spriteData[index].Image;
 }
 
 void SpriteCache::DisposeOldest() {
@@ -398,6 +459,7 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	if (index < 0 || (size_t)index >= _spriteData.size())
 		quit("sprite cache array index out of bounds");
 
+	const uint64 start = Common::Profiler::getMicros();
 	sprkey_t load_index = GetDataIndex(index);
 	SeekToSprite(load_index);
 
@@ -458,7 +520,9 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	// alter spritewidth/height if it resizes stuff
 	size_t size = _sprInfos[index].Width * _sprInfos[index].Height * coldep;
 	_spriteData[index].Size = size;
+	_spriteData[index].ColorDepth = coldep;
 	_cacheSize += size;
+	_loadTime += Common::Profiler::getMicros() - start;
 
 #ifdef DEBUG_SPRITECACHE
 	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "Loaded %d, size now %u KB", index, _cacheSize / 1024);
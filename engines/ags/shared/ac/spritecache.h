@@ -143,6 +143,20 @@ public:
 	sprkey_t    FindTopmostSprite() const;
 	// Loads sprite and and locks in memory (so it cannot get removed implicitly)
 	void        Precache(sprkey_t index);
+	// Loads sprite ahead of its use, if it fits in the free cache space;
+	// returns the size in bytes of the loaded sprite, or 0 if none was loaded
+	size_t      Prefetch(sprkey_t index);
+	// Returns the size in bytes of the cached sprites of the given colour depth
+	// (in bytes per pixel, as stored in the sprite file)
+	size_t      GetCacheSizeByDepth(int coldep) const;
+	// Returns the number of sprite requests served from the cache
+	uint32      GetHitCount() const;
+	// Returns the number of sprite requests that had to load the sprite
+	uint32      GetMissCount() const;
+	// Returns the number of sprites loaded ahead of their use
+	uint32      GetPrefetchCount() const;
+	// Returns the time spent loading sprites, in microseconds
+	uint64      GetLoadTime() const;
 	// Remap the given index to the sprite 0
 	void        RemapSpriteToSprite0(sprkey_t index);
 	// Unregisters sprite from the bank and optionally deletes bitmap
@@ -190,12 +204,15 @@ private:
 	void        SeekToSprite(sprkey_t index);
 	// Delete the oldest image in cache
 	void        DisposeOldest();
+	// Marks the sprite as the most recently used one
+	void        TouchSprite(sprkey_t index);
 
 	// Information required for the sprite streaming
 	// TODO: split into sprite cache and sprite stream data
 	struct SpriteData {
 		soff_t          Offset; // data offset
 		soff_t          Size;   // cache size of element, in bytes
+		int             ColorDepth; // colour depth in the file, in bytes per pixel
 		uint32        Flags;
 		// TODO: investigate if we may safely use unique_ptr here
 		// (some of these bitmaps may be assigned from outside of the cache)
@@ -227,6 +244,11 @@ private:
 	size_t _lockedSize;    // size in bytes of currently locked images
 	size_t _cacheSize;     // size in bytes of currently cached images
 
+	uint32 _hits;          // requests served from the cache
+	uint32 _misses;        // requests that loaded the sprite
+	uint32 _prefetches;    // sprites loaded ahead of their use
+	uint64 _loadTime;      // time spent loading sprites, in microseconds
+
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
 	// that were last time used long ago.
@@ -1050,8 +1050,11 @@ void BladeRunnerEngine::gameLoop() {
 			playerDied();
 			_playerDead = false;
 		}
+		getFrameStats().beginFrame();
+		getFrameStats().beginPhase(FrameStats::kPhaseLogic);
 		gameTick();
 	} while (_gameIsRunning);
+	getFrameStats().endFrame();
 }
 
 void BladeRunnerEngine::gameTick() {
@@ -1152,6 +1155,7 @@ void BladeRunnerEngine::gameTick() {
 	}
 
 	_sliceRenderer->setView(_view);
+	getFrameStats().beginPhase(FrameStats::kPhaseRender);
 
 	// Tick and draw all actors in current set
 	int setId = _scene->getSetId();
@@ -49,9 +49,11 @@ void Framelimiter::wait() {
 	// TODO: when vsync will be supported, use it
 
 	if (!_enabled) {
+		_vm->getFrameStats().beginPhase(Engine::FrameStats::kPhasePresent);
 		return;
 	}
 
+	_vm->getFrameStats().beginPhase(Engine::FrameStats::kPhaseSleep);
 	uint32 timeNow = _vm->_time->currentSystem();
 	uint32 frameDuration = timeNow - _timeFrameStart;
 	if (frameDuration < _speedLimitMs) {
@@ -66,6 +68,7 @@ void Framelimiter::wait() {
 	// debug("frametime %i ms", timeNow - _timeFrameStart);
 	// using _vm->_time->currentSystem() here is slower and causes some shutters
 	_timeFrameStart = timeNow;
+	_vm->getFrameStats().beginPhase(Engine::FrameStats::kPhasePresent);
 }
 
 void Framelimiter::reset() {
@@ -44,6 +44,10 @@ Obstacles::Obstacles(BladeRunnerEngine *vm) {
 	_polygons       = new Polygon[kPolygonCount];
 	_polygonsBackup = new Polygon[kPolygonCount];
 	_path           = new Vector2[kVertexCount];
+	_waypointCache  = new WaypointCacheEntry[kWaypointCacheSize];
+	_waypointCacheNext = 0;
+	_nextState      = 0;
+	_backupState    = ++_nextState;
 	clear();
 }
 
@@ -58,6 +62,9 @@ Obstacles::~Obstacles() {
 
 	delete[] _path;
 	_path = nullptr;
+
+	delete[] _waypointCache;
+	_waypointCache = nullptr;
 }
 
 void Obstacles::clear() {
@@ -72,6 +79,10 @@ void Obstacles::clear() {
 	_pathSize = 0;
 	_backup = false;
 	_count = 0;
+
+	_state = _polygonsState = ++_nextState;
+	_added.clear();
+	_polygonsAdded.clear();
 }
 
 #define IN_RANGE(v, start, end) ((start) <= (v) && (v) <= (end))
@@ -266,7 +277,21 @@ bool Obstacles::mergePolygons(Polygon &polyA, Polygon &polyB) {
 	return flagDidMergePolygons;
 }
 
+/*
+ * All the vertices of a polygon, merged or not, are inside its rect, so
+ * a segment that is clear of the rect can't cross any of its edges.
+ */
+bool Obstacles::segmentCanIntersect(const RectFloat &rect, Vector2 from, Vector2 to) {
+	const float kMargin = 1.0f;
+	return MAX(from.x, to.x) >= rect.x0 - kMargin && MIN(from.x, to.x) <= rect.x1 + kMargin
+	    && MAX(from.y, to.y) >= rect.y0 - kMargin && MIN(from.y, to.y) <= rect.y1 + kMargin;
+}
+
 void Obstacles::add(RectFloat rect) {
+	_added.push_back(rect);
+}
+
+void Obstacles::mergeRect(RectFloat rect) {
 	int polygonIndex = findEmptyPolygon();
 	if (polygonIndex < 0) {
 		return;
@@ -326,6 +351,28 @@ restart:
 	}
 }
 
+void Obstacles::updatePolygons() {
+	bool samePolygons = _polygonsState == _state && _polygonsAdded.size() <= _added.size();
+	for (uint i = 0; samePolygons && i < _polygonsAdded.size(); ++i) {
+		samePolygons = _polygonsAdded[i] == _added[i];
+	}
+
+	if (!samePolygons) {
+		// Only restore() leaves the polygons of another state behind
+		assert(_state == _backupState);
+		for (int i = 0; i != kPolygonCount; ++i) {
+			_polygons[i] = _polygonsBackup[i];
+		}
+		_polygonsState = _state;
+		_polygonsAdded.clear();
+	}
+
+	for (uint i = _polygonsAdded.size(); i < _added.size(); ++i) {
+		mergeRect(_added[i]);
+		_polygonsAdded.push_back(_added[i]);
+	}
+}
+
 int Obstacles::findEmptyPolygon() const {
 	for (int i = 0; i < kPolygonCount; ++i) {
 		if (!_polygons[i].isPresent) {
@@ -342,15 +389,49 @@ float Obstacles::getLength(float x0, float z0, float x1, float z1) {
 	return fabs(x1 - x0);
 }
 
-#if DISABLE_PATHFINDING
 bool Obstacles::findNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3 *next) {
+	// Actors blocked by each other ask for the same path every frame
+	for (int i = 0; i != kWaypointCacheSize; ++i) {
+		const WaypointCacheEntry &entry = _waypointCache[i];
+		if (entry.state == _state && entry.from.xz() == from.xz() && entry.from.y == from.y
+		 && entry.to.xz() == to.xz() && entry.to.y == to.y && entry.added == _added) {
+			*next = entry.next;
+			_pathSize = entry.pathSize;
+			for (int j = 0; j != _pathSize; ++j) {
+				_path[j] = entry.path[j];
+			}
+			return entry.result;
+		}
+	}
+
+	updatePolygons();
+	bool result = searchNextWaypoint(from, to, next);
+
+	WaypointCacheEntry &entry = _waypointCache[_waypointCacheNext];
+	_waypointCacheNext = (_waypointCacheNext + 1) % kWaypointCacheSize;
+	entry.state = _state;
+	entry.added = _added;
+	entry.from = from;
+	entry.to = to;
+	entry.next = *next;
+	entry.result = result;
+	entry.pathSize = _pathSize;
+	for (int j = 0; j != _pathSize; ++j) {
+		entry.path[j] = _path[j];
+	}
+
+	return result;
+}
+
+#if DISABLE_PATHFINDING
+bool Obstacles::searchNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3 *next) {
 	*next = to;
 
 	return true;
 }
 #else
 
-bool Obstacles::findNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3 *next) {
+bool Obstacles::searchNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3 *next) {
 	static int  recursionLevel = 0;
 	static bool polygonVisited[kPolygonCount];
 
@@ -371,7 +452,7 @@ bool Obstacles::findNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3
 
 	for (int i = 0; i != kPolygonCount; ++i) {
 		Polygon &poly = _polygons[i];
-		if (!poly.isPresent || polygonVisited[i]) {
+		if (!poly.isPresent || polygonVisited[i] || !segmentCanIntersect(poly.rect, from.xz(), to.xz())) {
 			continue;
 		}
 
@@ -448,7 +529,7 @@ bool Obstacles::findNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3
 		}
 		assert(_pathSize > 0);
 		Vector3 lastPathPos(_path[_pathSize - 1].x, from.y, _path[_pathSize - 1].y);
-		findNextWaypoint(lastPathPos, to, next);
+		searchNextWaypoint(lastPathPos, to, next);
 	}
 
 	if (--recursionLevel > 1) {
@@ -737,7 +818,8 @@ bool Obstacles::findFarthestAvailablePathVertex(Vector2 *path, int pathSize, Vec
 		for (int currentPolygonIdx = 0; currentPolygonIdx < kPolygonCount && pathVertexAvailable; ++currentPolygonIdx) {
 			Polygon *polygon = &_polygons[currentPolygonIdx];
 
-			if (!polygon->isPresent || polygon->verticeCount == 0) {
+			if (!polygon->isPresent || polygon->verticeCount == 0
+			 || !segmentCanIntersect(polygon->rect, Vector2(start.x, start.z), path[pathVertexIdx])) {
 				continue;
 			}
 
@@ -841,6 +923,8 @@ bool Obstacles::findFarthestAvailablePathVertex(Vector2 *path, int pathSize, Vec
 }
 
 void Obstacles::backup() {
+	updatePolygons();
+
 	for (int i = 0; i != kPolygonCount; ++i) {
 		_polygonsBackup[i].isPresent = false;
 	}
@@ -859,15 +943,17 @@ void Obstacles::backup() {
 
 	_count = count;
 	_backup = true;
+
+	_backupState = ++_nextState;
+	_state = _polygonsState = ++_nextState;
+	_added.clear();
+	_polygonsAdded.clear();
 }
 
 void Obstacles::restore() {
-	for (int i = 0; i != kPolygonCount; ++i) {
-		_polygons[i].isPresent = false;
-	}
-	for (int i = 0; i != kPolygonCount; ++i) {
-		_polygons[i] = _polygonsBackup[i];
-	}
+	// The backup is copied back by updatePolygons(), if it's needed
+	_state = _backupState;
+	_added.clear();
 }
 
 void Obstacles::save(SaveFileWriteStream &f) {
@@ -923,6 +1009,9 @@ void Obstacles::load(SaveFileReadStream &f) {
 	for (int i = 0; i < kPolygonCount; ++i) {
 		_polygons[i] = _polygonsBackup[i];
 	}
+	_state = _polygonsState = _backupState = ++_nextState;
+	_added.clear();
+	_polygonsAdded.clear();
 
 	for (int i = 0; i < kVertexCount; ++i) {
 		_path[i] = f.readVector2();
@@ -931,6 +1020,8 @@ void Obstacles::load(SaveFileReadStream &f) {
 }
 
 void Obstacles::draw() {
+	updatePolygons();
+
 	float y = _vm->_playerActor->getY();
 
 	for (int i = 0; i != kPolygonCount; ++i) {
@@ -26,6 +26,8 @@
 #include "bladerunner/rect_float.h"
 #include "bladerunner/vector.h"
 
+#include "common/array.h"
+
 namespace BladeRunner {
 
 class BladeRunnerEngine;
@@ -37,6 +39,7 @@ class Obstacles {
 	static const int kPolygonCount       =  50;
 	static const int kPolygonVertexCount = 160;
 	static const int kMaxPathSize        = 500;
+	static const int kWaypointCacheSize  =  16;
 
 	enum VertexType {
 		BOTTOM_LEFT,
@@ -61,6 +64,20 @@ class Obstacles {
 		{}
 	};
 
+	// A findNextWaypoint() result, for one set of obstacles
+	struct WaypointCacheEntry {
+		uint32                   state;
+		Common::Array<RectFloat> added;
+		Vector3                  from;
+		Vector3                  to;
+		Vector3                  next;
+		bool                     result;
+		int                      pathSize;
+		Vector2                  path[kVertexCount];
+
+		WaypointCacheEntry() : state(0), result(false), pathSize(0) {}
+	};
+
 	BladeRunnerEngine *_vm;
 
 	Polygon *_polygons;
@@ -70,10 +87,29 @@ class Obstacles {
 	int      _count;
 	bool     _backup;
 
+	// The obstacles are the polygons of _state with the _added rectangles
+	// merged in. Those are only merged when the polygons are needed, and
+	// _polygons keeps the merged ones of _polygonsState and _polygonsAdded,
+	// so the same actors added again after restore() cost nothing.
+	uint32                   _nextState;
+	uint32                   _state;
+	uint32                   _backupState;
+	uint32                   _polygonsState;
+	Common::Array<RectFloat> _added;
+	Common::Array<RectFloat> _polygonsAdded;
+
+	WaypointCacheEntry *_waypointCache;
+	int                 _waypointCacheNext;
+
 	static bool lineLineIntersection(LineSegment a, LineSegment b, Vector2 *intersectionPoint);
 	static bool linePolygonIntersection(LineSegment lineA, VertexType lineAType, Polygon *polyB, Vector2 *intersectionPoint, int *intersectionIndex, int pathLengthSinceLastIntersection);
 
+	static bool segmentCanIntersect(const RectFloat &rect, Vector2 from, Vector2 to);
+
 	bool mergePolygons(Polygon &polyA, Polygon &PolyB);
+	void mergeRect(RectFloat rect);
+	void updatePolygons();
+	bool searchNextWaypoint(const Vector3 &from, const Vector3 &to, Vector3 *next);
 
 public:
 	Obstacles(BladeRunnerEngine *vm);
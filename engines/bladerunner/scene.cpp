@@ -118,6 +118,9 @@ bool Scene::open(int setId, int sceneId, bool isLoadingGame) {
 	}
 
 	_vqaPlayer = new VQAPlayer(_vm, &_vm->_surfaceBack, vqaName);
+	// The set backgrounds are loops, so the same frames come back over and
+	// over. Keep a few dozen of them decoded.
+	_vqaPlayer->setFrameCacheSize(32 * 1024 * 1024);
 
 	if (!_vm->_sceneScript->open(sceneName)) {
 		return false;
@@ -234,10 +237,9 @@ bool Scene::close(bool isLoadingGame) {
 }
 
 int Scene::advanceFrame(bool useTime) {
-	int frame = _vqaPlayer->update(false, true, useTime);
+	int frame = _vqaPlayer->update(false, true, useTime, nullptr, _vm->_zbuffer);
 	if (frame >= 0) {
 		blit(_vm->_surfaceBack, _vm->_surfaceFront);
-		_vqaPlayer->updateZBuffer(_vm->_zbuffer);
 		_vqaPlayer->updateView(_vm->_view);
 		_vqaPlayer->updateScreenEffects(_vm->_screenEffects);
 		_vqaPlayer->updateLights(_vm->_lights);
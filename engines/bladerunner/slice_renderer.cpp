@@ -30,6 +30,7 @@
 
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 
 namespace BladeRunner {
@@ -59,8 +60,6 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_frameSliceCount   = 0;
 	_startSlice        = 0.0f;
 	_endSlice          = 0.0f;
-	_m13               = 0;
-	_m23               = 0;
 
 	_shadowPolygonDefault[ 0] = Vector3( 16.0f,  96.0f, 0.0f);
 	_shadowPolygonDefault[ 1] = Vector3( 16.0f, 160.0f, 0.0f);
@@ -412,20 +411,10 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		&setEffectsColorCoeficient,
 		&setEffectColor);
 
-	_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-	_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-	_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
-
-	_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-	_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-	_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
-
 	setupLookupTable(_m12lookup, sliceLineIterator._sliceMatrix(0, 1));
 	setupLookupTable(_m11lookup, sliceLineIterator._sliceMatrix(0, 0));
-	_m13 = sliceLineIterator._sliceMatrix(0, 2);
 	setupLookupTable(_m21lookup, sliceLineIterator._sliceMatrix(1, 0));
 	setupLookupTable(_m22lookup, sliceLineIterator._sliceMatrix(1, 1));
-	_m23 = sliceLineIterator._sliceMatrix(1, 2);
 
 	if (_animationsShadowEnabled[_animation]) {
 		float coeficientShadow;
@@ -443,11 +432,14 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 
 	int frameY = sliceLineIterator._startY;
 
-	uint16 *zBufferLinePtr = zbuffer + 640 * frameY;
-
+	// The lighting of each line depends on the previous ones, so it's worked
+	// out first. The lines are then drawn in parallel: each one only writes
+	// its own screen and z-buffer line, so the result doesn't change.
+	_sliceLines.clear();
 	while (sliceLineIterator._currentY <= sliceLineIterator._endY) {
-		_m13 = sliceLineIterator._sliceMatrix(0, 2);
-		_m23 = sliceLineIterator._sliceMatrix(1, 2);
+		SliceLine line;
+		line.m13 = sliceLineIterator._sliceMatrix(0, 2);
+		line.m23 = sliceLineIterator._sliceMatrix(1, 2);
 		sliceLine = sliceLineIterator.line();
 
 		sliceRendererLights.calculateColorSlice(Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight));
@@ -460,22 +452,29 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 				&setEffectColor);
 		}
 
-		_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-		_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-		_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
+		line.lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
+		line.lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
+		line.lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
 
-		_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-		_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-		_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+		line.setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
+		line.setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
+		line.setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
 
 		if (frameY >= 0 && frameY < surface.h) {
-			drawSlice((int)sliceLine, true, frameY, surface, zBufferLinePtr);
+			line.slice = (int)sliceLine;
+			line.y = frameY;
+			_sliceLines.push_back(line);
 		}
 
 		sliceLineIterator.advance();
 		++frameY;
-		zBufferLinePtr += 640;
 	}
+
+	Common::parallelFor(0, _sliceLines.size(), 32, [this, &surface, zbuffer](uint begin, uint end) {
+		for (uint i = begin; i < end; ++i) {
+			drawSlice(_sliceLines[i], true, surface, zbuffer + 640 * _sliceLines[i].y);
+		}
+	});
 }
 
 void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screenX, int screenY, float facing, float scale, Graphics::Surface &surface) {
@@ -515,10 +514,12 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 
 	setupLookupTable(_m11lookup, m(0, 0));
 	setupLookupTable(_m12lookup, m(0, 1));
-	_m13 = m(0, 2);
 	setupLookupTable(_m21lookup, m(1, 0));
 	setupLookupTable(_m22lookup, m(1, 1));
-	_m23 = m(1, 2);
+
+	SliceLine line;
+	line.m13 = m(0, 2);
+	line.m23 = m(1, 2);
 
 	int frameY = screenY + (size / 2.0f * frameHeight);
 	int currentY = frameY;
@@ -531,14 +532,18 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	while (currentSlice < _frameSliceCount) {
 		if (currentY >= 0 && currentY < surface.h) {
 			memset(lineZbuffer, 0xFF, 640 * 2);
-			drawSlice(currentSlice, false, currentY, surface, lineZbuffer);
+			line.slice = currentSlice;
+			line.y = currentY;
+			drawSlice(line, false, surface, lineZbuffer);
 			currentSlice += sliceStep;
 			--currentY;
 		}
 	}
 }
 
-void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
+void SliceRenderer::drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) const {
+	const int slice = line.slice;
+	const int y = line.y;
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
 	}
@@ -554,6 +559,9 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 	uint32 polyCount = READ_LE_UINT32(p);
 	p += 4;
 
+	byte *linePtr = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	const int lineWidth = MIN<int>(surface.w, 640);
+
 	while (polyCount--) {
 		uint32 vertexCount = READ_LE_UINT32(p);
 		p += 4;
@@ -562,15 +570,15 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 			continue;
 
 		uint32 lastVertex = vertexCount - 1;
-		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + _m13) / 65536, 0);
+		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + line.m13) / 65536, 0);
 
 		int previousVertexX = lastVertexX;
 
 		while (vertexCount--) {
-			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + _m13) / 65536, 0, 640);
+			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + line.m13) / 65536, 0, 640);
 
 			if (vertexX > previousVertexX) {
-				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
+				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + line.m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
 					uint32 outColor = palette.value[p[2]];
@@ -579,15 +587,36 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
 
 						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+						color.r = ((int)(line.setEffectColor.r + line.lightsColor.r * color.r) / 65536) + aescColor.r;
+						color.g = ((int)(line.setEffectColor.g + line.lightsColor.g * color.g) / 65536) + aescColor.g;
+						color.b = ((int)(line.setEffectColor.b + line.lightsColor.b * color.b) / 65536) + aescColor.b;
 
 						int bladeToScummVmConstant = 256 / 32;
 						outColor = _pixelFormat.RGBToColor(CLIP(color.r * bladeToScummVmConstant, 0, 255), CLIP(color.g * bladeToScummVmConstant, 0, 255), CLIP(color.b * bladeToScummVmConstant, 0, 255));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
+					// Draw the span straight into the line, for the usual pixel formats
+					int x = previousVertexX;
+					const int spanEnd = MIN(vertexX, lineWidth);
+					if (surface.format.bytesPerPixel == 2) {
+						uint16 *dst = (uint16 *)linePtr;
+						for (; x < spanEnd; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
+								dst[x] = (uint16)outColor;
+							}
+						}
+					} else if (surface.format.bytesPerPixel == 4) {
+						uint32 *dst = (uint32 *)linePtr;
+						for (; x < spanEnd; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
+								dst[x] = outColor;
+							}
+						}
+					}
+
+					for (; x != vertexX; ++x) {
 						if (vertexZ < zbufferLine[x]) {
 							zbufferLine[x] = (uint16)vertexZ;
 
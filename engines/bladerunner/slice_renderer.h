@@ -28,6 +28,7 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
@@ -44,6 +45,16 @@ class Lights;
 class SetEffects;
 
 class SliceRenderer {
+	// Everything drawSlice() needs to draw one screen line
+	struct SliceLine {
+		int   slice;
+		int   y;
+		int   m13;
+		int   m23;
+		Color setEffectColor;
+		Color lightsColor;
+	};
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -76,19 +87,16 @@ class SliceRenderer {
 
 	int _m11lookup[256];
 	int _m12lookup[256];
-	int _m13;
 	int _m21lookup[256];
 	int _m22lookup[256];
-	int _m23;
+
+	Common::Array<SliceLine> _sliceLines;
 
 	bool _animationsShadowEnabled[997];
 
 	Vector3 _shadowPolygonDefault[12];
 	Vector3 _shadowPolygonCurrent[12];
 
-	Color _setEffectColor;
-	Color _lightsColor;
-
 	Graphics::PixelFormat _pixelFormat;
 
 public:
@@ -114,7 +122,7 @@ private:
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) const;
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
@@ -36,6 +36,7 @@
 #include "common/array.h"
 #include "common/util.h"
 #include "common/memstream.h"
+#include "common/threadpool.h"
 
 namespace BladeRunner {
 
@@ -106,6 +107,50 @@ static inline uint32 roundup(uint32 v) {
 	return (v + 1) & ~1u;
 }
 
+/**
+ * The video tracks which last decoded into each of the surfaces. The players
+ * of the scene and of the UI screens share the back surface, so a track can
+ * only trust its frame cache while it was the last to write the surface.
+ */
+struct SurfaceWriter {
+	const Graphics::Surface *surface;
+	const void *track;
+};
+
+static SurfaceWriter surfaceWriters[8];
+
+static bool isLastWriter(const Graphics::Surface *surface, const void *track) {
+	for (uint i = 0; i < ARRAYSIZE(surfaceWriters); ++i) {
+		if (surfaceWriters[i].surface == surface)
+			return surfaceWriters[i].track == track;
+	}
+	return false;
+}
+
+static void setLastWriter(const Graphics::Surface *surface, const void *track) {
+	uint slot = 0;
+	for (uint i = 0; i < ARRAYSIZE(surfaceWriters); ++i) {
+		if (surfaceWriters[i].surface == surface) {
+			slot = i;
+			break;
+		}
+		// Forgetting the writer of another surface only costs its cache
+		if (surfaceWriters[i].surface == nullptr)
+			slot = i;
+	}
+	surfaceWriters[slot].surface = surface;
+	surfaceWriters[slot].track = track;
+}
+
+static void forgetWriter(const void *track) {
+	for (uint i = 0; i < ARRAYSIZE(surfaceWriters); ++i) {
+		if (surfaceWriters[i].track == track) {
+			surfaceWriters[i].surface = nullptr;
+			surfaceWriters[i].track = nullptr;
+		}
+	}
+}
+
 VQADecoder::VQADecoder() {
 	_s                   = nullptr;
 	_frameInfo           = nullptr;
@@ -137,6 +182,7 @@ VQADecoder::VQADecoder() {
 	_header.unk5         = 0;
 	_readingFrame        = -1;
 	_decodingFrame       = -1;
+	_frameCacheSize      = 0;
 }
 
 VQADecoder::~VQADecoder() {
@@ -190,15 +236,19 @@ bool VQADecoder::loadStream(Common::SeekableReadStream *s) {
 		}
 	} while (chd.id != kFINF);
 
+	// The tracks of the previous opening, if the stream is reopened
+	delete _videoTrack;
+	delete _audioTrack;
+
 	_videoTrack = new VQAVideoTrack(this);
 	_audioTrack = new VQAAudioTrack(this);
 
 	return true;
 }
 
-void VQADecoder::decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw) {
+void VQADecoder::decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw, ZBuffer *zbuffer) {
 	_decodingFrame = frame;
-	_videoTrack->decodeVideoFrame(surface, forceDraw);
+	_videoTrack->decodeVideoFrame(surface, forceDraw, zbuffer);
 }
 
 void VQADecoder::decodeZBuffer(ZBuffer *zbuffer) {
@@ -614,9 +664,22 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 
 	_lightsDataSize = 0;
 	_lightsData     = nullptr;
+
+	_frameCacheUsed = 0;
+	_stateSurface   = nullptr;
+	_state          = 0;
+	_nextState      = 1;
+
+	_zbufferTarget = nullptr;
 }
 
 VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
+	forgetWriter(this);
+
+	for (uint i = 0; i < _frameCache.size(); ++i) {
+		delete[] _frameCache[i].pixels;
+	}
+
 	delete[] _cbfz;
 	delete[] _zbufChunk;
 	delete[] _vpointer;
@@ -642,12 +705,27 @@ Common::Rational VQADecoder::VQAVideoTrack::getFrameRate() const {
 	return _frameRate;
 }
 
-void VQADecoder::VQAVideoTrack::decodeVideoFrame(Graphics::Surface *surface, bool forceDraw) {
+void VQADecoder::VQAVideoTrack::decodeVideoFrame(Graphics::Surface *surface, bool forceDraw, ZBuffer *zbuffer) {
+	// The z-buffer doesn't depend on the blocks, so it is decoded on
+	// another thread in the meantime, when there is one
+	Common::TaskGroup group;
+	if (zbuffer) {
+		_zbufferTarget = zbuffer;
+		group.run(&decodeZBufferProc, this);
+	}
+
 	if (_hasNewFrame || forceDraw) {
 		assert(surface);
 		decodeFrame(surface);
 		_hasNewFrame = false;
 	}
+
+	group.wait();
+}
+
+void VQADecoder::VQAVideoTrack::decodeZBufferProc(void *refCon) {
+	VQAVideoTrack *track = (VQAVideoTrack *)refCon;
+	track->decodeZBuffer(track->_zbufferTarget);
 }
 
 bool VQADecoder::VQAVideoTrack::readVQFL(Common::SeekableReadStream *s, uint32 size, uint readFlags) {
@@ -849,6 +927,106 @@ void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsig
 }
 
 bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
+	// Anything else on the surface is a state never seen before
+	bool knownState = surface == _stateSurface && isLastWriter(surface, this);
+	setLastWriter(surface, this);
+
+	if (_vqaDecoder->_frameCacheSize == 0) {
+		bool complete;
+		return decodeBlocks(surface, complete);
+	}
+
+	int frame = _vqaDecoder->_decodingFrame;
+	if (_frameCache.size() < _numFrames) {
+		_frameCache.resize(_numFrames);
+	}
+	if (frame < 0 || frame >= (int)_frameCache.size()) {
+		bool complete;
+		_stateSurface = nullptr;
+		return decodeBlocks(surface, complete);
+	}
+
+	if (!knownState) {
+		_stateSurface = surface;
+		_state = _nextState++;
+	}
+
+	CachedFrame &cached = _frameCache[frame];
+	if (cached.pixels && (cached.complete || cached.inputState == _state)) {
+		copyFrameRect(surface, cached.pixels, true);
+		_state = cached.outputState;
+		return true;
+	}
+
+	uint32 inputState = _state;
+	bool complete;
+	if (!decodeBlocks(surface, complete)) {
+		_state = _nextState++;
+		return false;
+	}
+
+	if (cached.pixels) {
+		// Coming to the frame from elsewhere, as at the start of a loop,
+		// often gives the same picture still. From there on the cache
+		// applies again.
+		if (complete || compareFrameRect(surface, cached.pixels)) {
+			_state = cached.outputState;
+		} else {
+			_state = _nextState++;
+		}
+		return true;
+	}
+
+	_state = _nextState++;
+
+	Common::Rect rect = getFrameRect(surface);
+	uint32 size = rect.width() * rect.height() * surface->format.bytesPerPixel;
+	if (_frameCacheUsed + size <= _vqaDecoder->_frameCacheSize) {
+		cached.pixels = new uint8[size];
+		cached.inputState = inputState;
+		cached.outputState = _state;
+		cached.complete = complete;
+		copyFrameRect(surface, cached.pixels, false);
+		_frameCacheUsed += size;
+	}
+
+	return true;
+}
+
+Common::Rect VQADecoder::VQAVideoTrack::getFrameRect(const Graphics::Surface *surface) const {
+	Common::Rect rect(_offsetX, _offsetY, _offsetX + _width, _offsetY + _height);
+	rect.clip(Common::Rect(surface->w, surface->h));
+	return rect;
+}
+
+void VQADecoder::VQAVideoTrack::copyFrameRect(Graphics::Surface *surface, uint8 *pixels, bool toSurface) const {
+	Common::Rect rect = getFrameRect(surface);
+	uint32 lineSize = rect.width() * surface->format.bytesPerPixel;
+
+	for (int y = rect.top; y < rect.bottom; ++y, pixels += lineSize) {
+		uint8 *line = (uint8 *)surface->getBasePtr(rect.left, y);
+		if (toSurface) {
+			memcpy(line, pixels, lineSize);
+		} else {
+			memcpy(pixels, line, lineSize);
+		}
+	}
+}
+
+bool VQADecoder::VQAVideoTrack::compareFrameRect(const Graphics::Surface *surface, const uint8 *pixels) const {
+	Common::Rect rect = getFrameRect(surface);
+	uint32 lineSize = rect.width() * surface->format.bytesPerPixel;
+
+	for (int y = rect.top; y < rect.bottom; ++y, pixels += lineSize) {
+		if (memcmp(surface->getBasePtr(rect.left, y), pixels, lineSize)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool VQADecoder::VQAVideoTrack::decodeBlocks(Graphics::Surface *surface, bool &complete) {
 	CodebookInfo &codebookInfo = _vqaDecoder->codebookInfoForFrame(_vqaDecoder->_decodingFrame);
 
 	if (!codebookInfo.data) {
@@ -865,6 +1043,9 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	uint16 count, srcBlock, dstBlock = 0;
 	(void)srcBlock;
 
+	// Whether all the blocks get overwritten
+	complete = true;
+
 	while (end - src >= 2) {
 		uint16 command = src[0] | (src[1] << 8);
 		uint8  prefix = command >> 13;
@@ -874,6 +1055,7 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 		case 0:
 			count = command & 0x1fff;
 			dstBlock += count;
+			complete = complete && count == 0;
 			break;
 		case 1:
 			count = 2 * (((command >> 8) & 0x1f) + 1);
@@ -902,6 +1084,7 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 
 			VPTRWriteBlock(surface, dstBlock, srcBlock, count, prefix == 4);
 			++dstBlock;
+			complete = complete && prefix != 4;
 			break;
 		case 5:
 		case 6:
@@ -910,12 +1093,16 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 
 			VPTRWriteBlock(surface, dstBlock, srcBlock, count, prefix == 6);
 			dstBlock += count;
+			complete = complete && prefix != 6;
 			break;
 		default:
 			warning("VQAVideoTrack::decodeFrame: Undefined case %d", command >> 13);
+			complete = false;
 		}
 	}
 
+	complete = complete && dstBlock >= (_width / _blockW) * (_height / _blockH);
+
 	return true;
 }
 
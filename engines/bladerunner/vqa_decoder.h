@@ -36,6 +36,7 @@
 
 #include "common/array.h"
 #include "common/rational.h"
+#include "common/rect.h"
 
 namespace BladeRunner {
 
@@ -64,7 +65,7 @@ public:
 
 	void readFrame(int frame, uint readFlags = kVQAReadAll);
 
-	void                        decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw = false);
+	void                        decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw = false, ZBuffer *zbuffer = nullptr);
 	void                        decodeZBuffer(ZBuffer *zbuffer);
 	Audio::SeekableAudioStream *decodeAudioFrame();
 	void                        decodeView(View *view);
@@ -82,6 +83,13 @@ public:
 
 	bool getLoopBeginAndEndFrame(int loop, int *begin, int *end);
 
+	/**
+	 * Keep up to the given number of bytes of decoded frames around, so
+	 * that looping videos don't decode the same frames over and over.
+	 * The surface decoded into must not be drawn to by anything else.
+	 */
+	void setFrameCacheSize(uint32 size) { _frameCacheSize = size; }
+
 	struct Header {
 		uint16 version;     // 0x00
 		uint16 flags;       // 0x02
@@ -156,6 +164,8 @@ public:
 	VQAVideoTrack *_videoTrack;
 	VQAAudioTrack *_audioTrack;
 
+	uint32   _frameCacheSize;
+
 	void readPacket(uint readFlags);
 
 	bool readVQHD(Common::SeekableReadStream *s, uint32 size);
@@ -179,7 +189,7 @@ public:
 
 		int getFrameCount() const;
 
-		void decodeVideoFrame(Graphics::Surface *surface, bool forceDraw);
+		void decodeVideoFrame(Graphics::Surface *surface, bool forceDraw, ZBuffer *zbuffer);
 		void decodeZBuffer(ZBuffer *zbuffer);
 		void decodeView(View *view);
 		void decodeScreenEffects(ScreenEffects *aesc);
@@ -225,6 +235,30 @@ public:
 
 		int      _curFrame;
 
+		/**
+		 * A decoded frame. Frames usually only update some of the blocks,
+		 * so the result depends on what was on the surface before. That is
+		 * tracked by numbering the states of the surface: a cached frame
+		 * can only be reused on the state it was decoded on, unless it
+		 * overwrote all the blocks.
+		 */
+		struct CachedFrame {
+			uint8  *pixels;
+			uint32  inputState;
+			uint32  outputState;
+			bool    complete;
+
+			CachedFrame() : pixels(nullptr), inputState(0), outputState(0), complete(false) {}
+		};
+
+		Common::Array<CachedFrame> _frameCache;
+		uint32 _frameCacheUsed;
+		const Graphics::Surface *_stateSurface;
+		uint32 _state;
+		uint32 _nextState;
+
+		ZBuffer *_zbufferTarget;
+
 		uint8   *_viewData;
 		uint32   _viewDataSize;
 		uint8   *_lightsData;
@@ -234,6 +268,12 @@ public:
 
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
+		bool decodeBlocks(Graphics::Surface *surface, bool &complete);
+		Common::Rect getFrameRect(const Graphics::Surface *surface) const;
+		void copyFrameRect(Graphics::Surface *surface, uint8 *pixels, bool toSurface) const;
+		bool compareFrameRect(const Graphics::Surface *surface, const uint8 *pixels) const;
+
+		static void decodeZBufferProc(void *refCon);
 	};
 
 	class VQAAudioTrack {
@@ -95,7 +95,7 @@ void VQAPlayer::close() {
 	_s = nullptr;
 }
 
-int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics::Surface *customSurface) {
+int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics::Surface *customSurface, ZBuffer *zbuffer) {
 	uint32 now = 60 * _vm->_time->currentSystem();
 	int result = -1;
 
@@ -137,7 +137,7 @@ int VQAPlayer::update(bool forceDraw, bool advanceFrame, bool useTime, Graphics:
 	} else if (advanceFrame) {
 		_frame = _frameNext;
 		_decoder.readFrame(_frameNext, kVQAReadVideo);
-		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext);
+		_decoder.decodeVideoFrame(customSurface != nullptr ? customSurface : _surface, _frameNext, false, zbuffer);
 
 		if (_hasAudio) {
 			int audioPreloadFrames = 14;
@@ -106,12 +106,18 @@ public:
 	bool open();
 	void close();
 
-	int  update(bool forceDraw = false, bool advanceFrame = true, bool useTime = true, Graphics::Surface *customSurface = nullptr);
+	/**
+	 * Advance and draw the video. When a z-buffer is given, the z-buffer
+	 * data of the new frame is decoded into it at the same time.
+	 */
+	int  update(bool forceDraw = false, bool advanceFrame = true, bool useTime = true, Graphics::Surface *customSurface = nullptr, ZBuffer *zbuffer = nullptr);
 	void updateZBuffer(ZBuffer *zbuffer);
 	void updateView(View *view);
 	void updateScreenEffects(ScreenEffects *screenEffects);
 	void updateLights(Lights *lights);
 
+	void setFrameCacheSize(uint32 size) { _decoder.setFrameCacheSize(size); }
+
 	bool setBeginAndEndFrame(int begin, int end, int repeatsCount, int loopSetMode, void(*callback)(void *, int, int), void *callbackData);
 	bool setLoop(int loop, int repeatsCount, int loopSetMode, void(*callback)(void*, int, int), void *callbackData);
 
@@ -62,6 +62,10 @@ void Omni3DManager::init(double hfov) {
 		}
 	}
 
+	memset(_imageCoords, 0, sizeof(_imageCoords));
+	_gridValid = false;
+	_dirtyCoords = true;
+
 	_surface.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
 	clearConstraints();
 }
@@ -121,10 +125,32 @@ void Omni3DManager::updateCoords(int xDelta, int yDelta, bool useOldSpeed) {
 
 	_dirtyCoords = true;
 
-	updateImageCoords();
+	// The view is only redrawn when moving shows a different image, which
+	// saves the redraws at the end of the slowing down
+	updateImageCoords(false);
+}
+
+void Omni3DManager::updateGrid() {
+	if (_gridValid && _gridBeta == _beta) {
+		return;
+	}
+
+	for (uint i = 0; i < 31; i++) {
+		double v11 = _anglesH[i] + _beta;
+		double v26 = sin(v11);
+		double v25 = cos(v11) * _hypothenusesH[i];
+
+		for (uint j = 0; j < 21; j++) {
+			_gridX[i][j] = atan2(_oppositeV[j], v25) * _helperValue;
+			_gridY[i][j] = (384 * 65536) - _squaresCoords[i][j] * v26;
+		}
+	}
+
+	_gridBeta = _beta;
+	_gridValid = true;
 }
 
-void Omni3DManager::updateImageCoords() {
+void Omni3DManager::updateImageCoords(bool exact) {
 	if (!_dirtyCoords) {
 		return;
 	}
@@ -140,40 +166,54 @@ void Omni3DManager::updateImageCoords() {
 		_beta = -0.9 * _vfov;
 	}
 
+	updateGrid();
+
 	double tmp = (2048 * 65536) - 2048 * 65536 / (2. * M_PI) * _alpha;
 
+	int imageCoords[ARRAYSIZE(_imageCoords)];
+	memcpy(imageCoords, _imageCoords, sizeof(imageCoords));
+
 	uint k = 0;
 	for (uint i = 0; i < 31; i++) {
-		double v11 = _anglesH[i] + _beta;
-		double v26 = sin(v11);
-		double v25 = cos(v11) * _hypothenusesH[i];
-
 		uint offset = 80;
 		uint j;
 		for (j = 0; j < 20; j++) {
-			double v16 = atan2(_oppositeV[j], v25);
-			double v17 = v16 * _helperValue;
-			double v18 = (384 * 65536) - _squaresCoords[i][j] * v26;
+			double v17 = _gridX[i][j];
+			double v18 = _gridY[i][j];
 
 			k += 2;
-			_imageCoords[k + 0] = (int)(tmp + v17);
-			_imageCoords[k + offset + 0] = (int)(tmp - v17);
-			_imageCoords[k + 1] = (int) v18;
-			_imageCoords[k + offset + 1] = (int) v18;
+			imageCoords[k + 0] = (int)(tmp + v17);
+			imageCoords[k + offset + 0] = (int)(tmp - v17);
+			imageCoords[k + 1] = (int) v18;
+			imageCoords[k + offset + 1] = (int) v18;
 
 			offset -= 4;
 		}
 
-		double v19 = atan2(_oppositeV[j], v25);
-
 		k += 2;
-		_imageCoords[k + 0] = (int)((2048.*65536.) - (_alpha - v19) * _helperValue);
-		_imageCoords[k + 1] = (int)((384.*65536.) - _squaresCoords[i][j] * v26);
+		imageCoords[k + 0] = (int)(tmp + _gridX[i][j]);
+		imageCoords[k + 1] = (int) _gridY[i][j];
 
 		k += 40;
 	}
 
 	_dirtyCoords = false;
+
+	if (!exact && !_dirty) {
+		// Coordinates are in 1/65536 of a panorama pixel, and a panorama
+		// pixel is about one and a half screen pixel
+		static const int kMinCoordsChange = 65536 / 2;
+
+		bool changed = false;
+		for (uint i = 0; i < ARRAYSIZE(_imageCoords) && !changed; i++) {
+			changed = ABS(imageCoords[i] - _imageCoords[i]) >= kMinCoordsChange;
+		}
+		if (!changed) {
+			return;
+		}
+	}
+
+	memcpy(_imageCoords, imageCoords, sizeof(imageCoords));
 	_dirty = true;
 }
 
@@ -30,8 +30,8 @@ namespace CryOmni3D {
 class Omni3DManager {
 public:
 	Omni3DManager() : _vfov(0), _alpha(0), _beta(0), _xSpeed(0), _ySpeed(0), _alphaMin(0), _alphaMax(0),
-		_betaMin(0), _betaMax(0), _helperValue(0), _dirty(true), _dirtyCoords(true),
-		_sourceSurface(nullptr) {}
+		_betaMin(0), _betaMax(0), _helperValue(0), _gridBeta(0), _gridValid(false), _dirty(true),
+		_dirtyCoords(true), _sourceSurface(nullptr) {}
 	virtual ~Omni3DManager();
 
 	void init(double hfov);
@@ -57,7 +57,8 @@ public:
 	const Graphics::Surface *getSurface();
 
 private:
-	void updateImageCoords();
+	void updateGrid();
+	void updateImageCoords(bool exact = true);
 
 	double _vfov;
 
@@ -74,6 +75,13 @@ private:
 	double _oppositeV[21];
 	double _helperValue;
 
+	// The part of the image coordinates which only depends on beta, for
+	// the last beta: changing alpha only shifts the coordinates
+	double _gridBeta;
+	bool _gridValid;
+	double _gridX[31][21];
+	double _gridY[31][21];
+
 	bool _dirty;
 	bool _dirtyCoords;
 	const Graphics::Surface *_sourceSurface;
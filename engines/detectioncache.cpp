@@ -0,0 +1,181 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/detectioncache.h"
+
+#include "common/debug.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/md5.h"
+#include "common/savefile.h"
+#include "common/system.h"
+
+namespace Common {
+DECLARE_SINGLETON(DetectionCache);
+}
+
+static const char *const kCacheFileName = ".detection.cache";
+static const uint32 kCacheMagic = MKTAG('D', 'C', 'A', 'C');
+static const uint32 kCacheVersion = 1;
+
+DetectionCache::DetectionCache() : _loaded(false), _dirty(false) {
+}
+
+DetectionCache::~DetectionCache() {
+	flush();
+}
+
+static void writeString(Common::WriteStream *out, const Common::String &str) {
+	out->writeUint32LE(str.size());
+	out->writeString(str);
+}
+
+static bool readString(Common::ReadStream *in, Common::String &str) {
+	const uint32 size = in->readUint32LE();
+	// Paths and MD5s are short, anything else means the file is corrupt
+	if (size > 4096 || in->eos() || in->err())
+		return false;
+
+	char *buffer = new char[size];
+	const bool ok = in->read(buffer, size) == size;
+	str = Common::String(buffer, size);
+	delete[] buffer;
+	return ok;
+}
+
+static Common::String makeKey(const Common::FSNode &node, uint32 md5Bytes) {
+	return Common::String::format("%u:", md5Bytes) + node.getPath();
+}
+
+bool DetectionCache::getFileProperties(const Common::FSNode &node, uint32 md5Bytes, FileProperties &fileProps) {
+	int64 fileSize, modificationTime;
+	const bool hasInfo = node.getFileInfo(fileSize, modificationTime);
+	const Common::String key = makeKey(node, md5Bytes);
+
+	if (hasInfo) {
+		Common::StackLock lock(_mutex);
+		loadEntries();
+
+		EntryMap::const_iterator i = _entries.find(key);
+		if (i != _entries.end() && i->_value.fileSize == fileSize && i->_value.modificationTime == modificationTime) {
+			fileProps = i->_value.props;
+			return true;
+		}
+	}
+
+	Common::File testFile;
+	if (!testFile.open(node))
+		return false;
+
+	fileProps.size = (int32)testFile.size();
+	fileProps.md5 = Common::computeStreamMD5AsString(testFile, md5Bytes);
+
+	if (hasInfo) {
+		Common::StackLock lock(_mutex);
+		Entry &entry = _entries[key];
+		entry.fileSize = fileSize;
+		entry.modificationTime = modificationTime;
+		entry.props = fileProps;
+		_dirty = true;
+	}
+
+	return true;
+}
+
+void DetectionCache::load() {
+	Common::StackLock lock(_mutex);
+	loadEntries();
+}
+
+void DetectionCache::loadEntries() {
+	if (_loaded)
+		return;
+	_loaded = true;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	Common::InSaveFile *in = saveFileMan ? saveFileMan->openForLoading(kCacheFileName) : nullptr;
+	if (!in)
+		return;
+
+	if (in->readUint32BE() != kCacheMagic || in->readUint32LE() != kCacheVersion) {
+		delete in;
+		return;
+	}
+
+	const uint32 count = in->readUint32LE();
+	for (uint32 i = 0; i < count; ++i) {
+		Common::String key;
+		Entry entry;
+		if (!readString(in, key))
+			break;
+		entry.fileSize = (int64)in->readUint64LE();
+		entry.modificationTime = (int64)in->readUint64LE();
+		entry.props.size = in->readSint32LE();
+		if (!readString(in, entry.props.md5))
+			break;
+
+		_entries[key] = entry;
+	}
+
+	debug(2, "DetectionCache: loaded %u entries", _entries.size());
+	delete in;
+}
+
+void DetectionCache::flush() {
+	Common::StackLock lock(_mutex);
+	if (!_dirty)
+		return;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	Common::OutSaveFile *out = saveFileMan ? saveFileMan->openForSaving(kCacheFileName, false) : nullptr;
+	if (!out)
+		return;
+
+	out->writeUint32BE(kCacheMagic);
+	out->writeUint32LE(kCacheVersion);
+	out->writeUint32LE(_entries.size());
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		writeString(out, i->_key);
+		out->writeUint64LE((uint64)i->_value.fileSize);
+		out->writeUint64LE((uint64)i->_value.modificationTime);
+		out->writeSint32LE(i->_value.props.size);
+		writeString(out, i->_value.props.md5);
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("DetectionCache: could not write '%s'", kCacheFileName);
+	else
+		_dirty = false;
+	delete out;
+}
+
+void DetectionCache::clear() {
+	Common::StackLock lock(_mutex);
+	_entries.clear();
+	_loaded = true;
+	_dirty = false;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (saveFileMan)
+		saveFileMan->removeSavefile(kCacheFileName);
+}
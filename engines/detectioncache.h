@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef ENGINES_DETECTIONCACHE_H
+#define ENGINES_DETECTIONCACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+#include "engines/game.h"
+
+namespace Common {
+class FSNode;
+}
+
+/**
+ * @defgroup engines_detectioncache Detection cache
+ * @ingroup engines
+ *
+ * @brief Persistent cache of the file properties computed during detection.
+ * @{
+ */
+
+/**
+ * Remembers the MD5 and size computed for game files across runs, so that
+ * repeated scans of the same directories (launcher start, Mass Add, Add Game)
+ * only need to query the size and modification time of each candidate file
+ * instead of reading it.
+ *
+ * An entry is keyed by the path of the file and the number of bytes hashed,
+ * and is only used while the file keeps the same size and modification time.
+ * Files on backends which cannot report these are never cached.
+ *
+ * The cache is stored in the savefile directory and written by flush().
+ */
+class DetectionCache : public Common::Singleton<DetectionCache> {
+public:
+	/**
+	 * Fill @p fileProps with the MD5 of the first @p md5Bytes bytes of the file
+	 * and its size, from the cache if possible and by reading the file otherwise.
+	 *
+	 * @return false if the file could not be read.
+	 */
+	bool getFileProperties(const Common::FSNode &node, uint32 md5Bytes, FileProperties &fileProps);
+
+	/**
+	 * Read the cache from disk, if not done yet. This happens on first use,
+	 * so it only needs to be called before detecting on worker threads.
+	 */
+	void load();
+
+	/** Write the cache to disk if it has changed. */
+	void flush();
+
+	/** Forget all the cached entries, in memory and on disk. */
+	void clear();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+
+	struct Entry {
+		int64 fileSize;
+		int64 modificationTime;
+		FileProperties props;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	DetectionCache();
+	~DetectionCache();
+
+	void loadEntries();
+
+	Common::Mutex _mutex;
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+};
+
+/** @} */
+
+#endif
@@ -27,12 +27,10 @@
 
 #include "graphics/macgui/macfontmanager.h"
 #include "graphics/macgui/macwindowmanager.h"
-#include "image/bmp.h"
 
 #include "director/director.h"
 #include "director/cast.h"
 #include "director/castmember.h"
-#include "director/images.h"
 #include "director/movie.h"
 #include "director/score.h"
 #include "director/sound.h"
@@ -530,8 +528,9 @@ void Cast::loadCastChildren() {
 		uint16 imgId = c->_key;
 		uint16 realId = 0;
 
-		Image::ImageDecoder *img = NULL;
-		Common::SeekableReadStream *pic = NULL;
+		// Images of this cast are only decoded when first drawn, those found
+		// in the shared cast are decoded now as it may be unloaded first
+		Archive *archive = nullptr;
 
 		if (_vm->getVersion() >= 400) {
 			if (bitmapCast->_children.size() > 0) {
@@ -539,68 +538,37 @@ void Cast::loadCastChildren() {
 				tag = bitmapCast->_children[0].tag;
 
 				if (_castArchive->hasResource(tag, imgId))
-					pic = _castArchive->getResource(tag, imgId);
+					archive = _castArchive;
 				else if (sharedCast && sharedCast->getArchive()->hasResource(tag, imgId))
-					pic = sharedCast->getArchive()->getResource(tag, imgId);
+					archive = sharedCast->getArchive();
 			}
+			realId = imgId;
 		} else {
 			if (_loadedCast->contains(imgId)) {
 				bitmapCast->_tag = tag = ((BitmapCastMember *)_loadedCast->getVal(imgId))->_tag;
 				realId = imgId + _castIDoffset;
-				pic = _castArchive->getResource(tag, realId);
+				archive = _castArchive;
 			} else if (sharedCast && sharedCast->_loadedCast && sharedCast->_loadedCast->contains(imgId)) {
 				bitmapCast->_tag = tag = ((BitmapCastMember *)sharedCast->_loadedCast->getVal(imgId))->_tag;
 				realId = imgId + sharedCast->_castIDoffset;
-				pic = sharedCast->getArchive()->getResource(tag, realId);
+				archive = sharedCast->getArchive();
 			}
 		}
 
-		if (pic == NULL) {
+		if (archive == NULL || !archive->hasResource(tag, realId)) {
 			warning("Cast::loadCastChildren(): Bitmap image %d not found", imgId);
 			continue;
 		}
 
-		int w = bitmapCast->_initialRect.width();
-		int h = bitmapCast->_initialRect.height();
-
-		switch (tag) {
-		case MKTAG('D', 'I', 'B', ' '):
-			debugC(2, kDebugLoading, "****** Loading 'DIB ' id: %d (%d), %d bytes", imgId, realId, pic->size());
-			img = new DIBDecoder();
-			break;
-
-		case MKTAG('B', 'I', 'T', 'D'):
-			debugC(2, kDebugLoading, "****** Loading 'BITD' id: %d (%d), %d bytes", imgId, realId, pic->size());
-
-			if (w > 0 && h > 0) {
-				if (_vm->getVersion() < 600) {
-					img = new BITDDecoder(w, h, bitmapCast->_bitsPerPixel, bitmapCast->_pitch, _vm->getPalette());
-				} else {
-					img = new Image::BitmapDecoder();
-				}
-			} else {
-				warning("Cast::loadCastChildren(): Bitmap image %d not found", imgId);
-			}
-
-			break;
-
-		default:
-			warning("Cast::loadCastChildren(): Unknown Bitmap CastMember Tag: [%d] %s", tag, tag2str(tag));
-			break;
+		if (archive == _castArchive) {
+			bitmapCast->setImageSource(tag, realId);
+		} else {
+			Common::SeekableReadStream *pic = archive->getResource(tag, realId);
+			bitmapCast->_img = bitmapCast->decodeImage(pic, tag);
+			delete pic;
 		}
 
-		if (!img)
-			continue;
-
-		img->loadStream(*pic);
-
-		bitmapCast->_img = img;
-		const Graphics::Surface *surf = img->getSurface();
-		bitmapCast->_size = surf->pitch * surf->h + img->getPaletteColorCount() * 3;
-
-		delete pic;
-
-		debugC(4, kDebugImages, "Cast::loadCastChildren(): Bitmap: id: %d, w: %d, h: %d, flags1: %x, flags2: %x bytes: %x, bpp: %d clut: %x", imgId, w, h, bitmapCast->_flags1, bitmapCast->_flags2, bitmapCast->_bytes, bitmapCast->_bitsPerPixel, bitmapCast->_clut);
+		debugC(4, kDebugImages, "Cast::loadCastChildren(): Bitmap: id: %d, w: %d, h: %d, flags1: %x, flags2: %x bytes: %x, bpp: %d clut: %x", imgId, bitmapCast->_initialRect.width(), bitmapCast->_initialRect.height(), bitmapCast->_flags1, bitmapCast->_flags2, bitmapCast->_bytes, bitmapCast->_bitsPerPixel, bitmapCast->_clut);
 	}
 }
 
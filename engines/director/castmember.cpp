@@ -20,14 +20,19 @@
  *
  */
 
+#include "common/list.h"
+
 #include "graphics/macgui/macbutton.h"
+#include "image/bmp.h"
 #include "image/image_decoder.h"
 #include "video/qt_decoder.h"
 
 #include "director/director.h"
+#include "director/cast.h"
 #include "director/castmember.h"
 #include "director/cursor.h"
 #include "director/channel.h"
+#include "director/images.h"
 #include "director/movie.h"
 #include "director/window.h"
 #include "director/stxt.h"
@@ -54,11 +59,22 @@ CastMember::CastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndi
 // Bitmap
 /////////////////////////////////////
 
+enum {
+	kMaxDecodedImagesSize = 64 * 1024 * 1024
+};
+
+// The images decoded on demand in all the casts, most recently used first
+static Common::List<BitmapCastMember *> s_decodedImages;
+static uint32 s_decodedImagesSize = 0;
+
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndian &stream, uint32 castTag, uint16 version, uint8 flags1)
 		: CastMember(cast, castId, stream) {
 	_type = kCastBitmap;
 	_img = nullptr;
 	_matte = nullptr;
+	_imageTag = 0;
+	_imageId = 0;
+	_imageUnloadable = false;
 	_noMatte = false;
 	_bytes = 0;
 	_pitch = 0;
@@ -165,6 +181,8 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 }
 
 BitmapCastMember::~BitmapCastMember() {
+	unloadImage();
+
 	if (_img)
 		delete _img;
 
@@ -172,25 +190,123 @@ BitmapCastMember::~BitmapCastMember() {
 		delete _matte;
 }
 
-Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel) {
+void BitmapCastMember::setImageSource(uint32 tag, uint16 id) {
+	_imageTag = tag;
+	_imageId = id;
+	_imageUnloadable = true;
+}
+
+Image::ImageDecoder *BitmapCastMember::decodeImage(Common::SeekableReadStream *pic, uint32 tag) {
+	int w = _initialRect.width();
+	int h = _initialRect.height();
+	Image::ImageDecoder *img = nullptr;
+
+	switch (tag) {
+	case MKTAG('D', 'I', 'B', ' '):
+		debugC(2, kDebugLoading, "****** Loading 'DIB ' id: %d, %d bytes", _castId, pic->size());
+		img = new DIBDecoder();
+		break;
+
+	case MKTAG('B', 'I', 'T', 'D'):
+		debugC(2, kDebugLoading, "****** Loading 'BITD' id: %d, %d bytes", _castId, pic->size());
+
+		if (w > 0 && h > 0) {
+			if (g_director->getVersion() < 600) {
+				img = new BITDDecoder(w, h, _bitsPerPixel, _pitch, g_director->getPalette());
+			} else {
+				img = new Image::BitmapDecoder();
+			}
+		} else {
+			warning("BitmapCastMember::decodeImage(): Bitmap image %d not found", _castId);
+		}
+
+		break;
+
+	default:
+		warning("BitmapCastMember::decodeImage(): Unknown Bitmap CastMember Tag: [%d] %s", tag, tag2str(tag));
+		break;
+	}
+
+	if (!img)
+		return nullptr;
+
+	img->loadStream(*pic);
+
+	const Graphics::Surface *surf = img->getSurface();
+	_size = surf->pitch * surf->h + img->getPaletteColorCount() * 3;
+
+	return img;
+}
+
+Image::ImageDecoder *BitmapCastMember::getImage() {
+	if (!_imageUnloadable)
+		return _img;
+
+	if (_img) {
+		if (s_decodedImages.front() != this) {
+			s_decodedImages.remove(this);
+			s_decodedImages.push_front(this);
+		}
+		return _img;
+	}
+
+	Common::SeekableReadStream *pic = _cast->getArchive()->getResource(_imageTag, _imageId);
+	if (pic) {
+		_img = decodeImage(pic, _imageTag);
+		delete pic;
+	}
+
 	if (!_img) {
+		// Do not try again every time the member is drawn
+		_imageUnloadable = false;
+		return nullptr;
+	}
+
+	s_decodedImages.push_front(this);
+	s_decodedImagesSize += _size;
+
+	// Drop the images which were not used for the longest time, but never the
+	// one just decoded
+	while (s_decodedImagesSize > kMaxDecodedImagesSize && s_decodedImages.size() > 1)
+		s_decodedImages.back()->unloadImage();
+
+	return _img;
+}
+
+void BitmapCastMember::unloadImage() {
+	if (!_imageUnloadable || !_img)
+		return;
+
+	s_decodedImages.remove(this);
+	s_decodedImagesSize -= _size;
+
+	delete _img;
+	_img = nullptr;
+}
+
+Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel) {
+	Image::ImageDecoder *img = getImage();
+	if (!img) {
 		warning("BitmapCastMember::createWidget: No image decoder");
 		return nullptr;
 	}
 
 	Graphics::MacWidget *widget = new Graphics::MacWidget(g_director->getCurrentWindow(), bbox.left, bbox.top, bbox.width(), bbox.height(), g_director->_wm, false);
-	widget->getSurface()->blitFrom(*_img->getSurface());
+	widget->getSurface()->blitFrom(*img->getSurface());
 	return widget;
 }
 
 void BitmapCastMember::createMatte() {
 	// Like background trans, but all white pixels NOT ENCLOSED by coloured pixels
 	// are transparent
+	Image::ImageDecoder *img = getImage();
+	_noMatte = true;
+	if (!img)
+		return;
+
 	Graphics::Surface tmp;
 	tmp.create(_initialRect.width(), _initialRect.height(), g_director->_pixelformat);
-	tmp.copyFrom(*_img->getSurface());
-
-	_noMatte = true;
+	tmp.copyFrom(*img->getSurface());
 
 	// Searching white color in the corners
 	uint32 whiteColor = 0;
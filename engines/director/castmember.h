@@ -111,6 +111,11 @@ public:
 	void createMatte();
 	Graphics::Surface *getMatte();
 
+	void setImageSource(uint32 tag, uint16 id);
+	Image::ImageDecoder *decodeImage(Common::SeekableReadStream *pic, uint32 tag);
+	Image::ImageDecoder *getImage();
+	void unloadImage();
+
 	bool hasField(int field) override;
 	Datum getField(int field) override;
 	bool setField(int field, const Datum &value) override;
@@ -118,6 +123,11 @@ public:
 	Image::ImageDecoder *_img;
 	Graphics::FloodFill *_matte;
 
+	// Resource of the image in the archive of the cast, decoded on first use
+	uint32 _imageTag;
+	uint16 _imageId;
+	bool _imageUnloadable;
+
 	uint16 _pitch;
 	uint16 _regX;
 	uint16 _regY;
@@ -145,7 +145,10 @@ bool Channel::isDirty(Sprite *nextSprite) {
 		// When puppet is set, the overall dirty flag should be set when sprite is
 		// modified.
 		isDirty |= _sprite->_castId != nextSprite->_castId ||
-			_sprite->_ink != nextSprite->_ink;
+			_sprite->_ink != nextSprite->_ink ||
+			_sprite->_blend != nextSprite->_blend ||
+			_sprite->_foreColor != nextSprite->_foreColor ||
+			_sprite->_backColor != nextSprite->_backColor;
 		if (!_sprite->_moveable)
 			isDirty |= _currentPoint != nextSprite->_startPoint;
 		if (!_sprite->_stretch)
@@ -164,6 +167,14 @@ bool Channel::isEmpty() {
 	return (_sprite->_spriteType == kInactiveSprite);
 }
 
+// Whether every pixel of the bounding box is overwritten, so that whatever
+// lies below it does not have to be drawn
+bool Channel::isOpaque() {
+	return _visible && _sprite->_ink == kInkTypeCopy && !_sprite->_blend &&
+		_sprite->_cast && _sprite->_cast->_type == kCastBitmap &&
+		getSurface() && !isActiveVideo();
+}
+
 bool Channel::isActiveText() {
 	if (_sprite->_spriteType != kTextSprite)
 		return false;
@@ -48,6 +48,7 @@ public:
 	bool isStretched();
 	bool isDirty(Sprite *nextSprite = nullptr);
 	bool isEmpty();
+	bool isOpaque();
 	bool isActiveText();
 	bool isMouseIn(const Common::Point &pos);
 	bool isMatteIntersect(Channel *channel);
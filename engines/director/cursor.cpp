@@ -70,21 +70,28 @@ void Cursor::readFromCast(uint cursorId, uint maskId) {
 	BitmapCastMember *cursorBitmap = (BitmapCastMember *)cursorCast;
 	BitmapCastMember *maskBitmap = (BitmapCastMember *)maskCast;
 
+	Image::ImageDecoder *cursorImage = cursorBitmap->getImage();
+	Image::ImageDecoder *maskImage = maskBitmap->getImage();
+	if (!cursorImage || !maskImage) {
+		warning("Cursor::readFromCast: No image for cursor");
+		return;
+	}
+
 	_surface = new byte[getWidth() * getHeight()];
 	byte *dst = _surface;
 
 	for (int y = 0; y < 16; y++) {
 		const byte *cursor = nullptr, *mask = nullptr;
 
-		if (y < cursorBitmap->_img->getSurface()->h &&
-				y < maskBitmap->_img->getSurface()->h) {
-			cursor = (const byte *)cursorBitmap->_img->getSurface()->getBasePtr(0, y);
-			mask = (const byte *)maskBitmap->_img->getSurface()->getBasePtr(0, y);
+		if (y < cursorImage->getSurface()->h &&
+				y < maskImage->getSurface()->h) {
+			cursor = (const byte *)cursorImage->getSurface()->getBasePtr(0, y);
+			mask = (const byte *)maskImage->getSurface()->getBasePtr(0, y);
 		}
 
 		for (int x = 0; x < 16; x++) {
-			if (x >= cursorBitmap->_img->getSurface()->w ||
-					x >= maskBitmap->_img->getSurface()->w) {
+			if (x >= cursorImage->getSurface()->w ||
+					x >= maskImage->getSurface()->w) {
 				cursor = mask = nullptr;
 			}
 
@@ -1453,14 +1453,10 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 	funcSym = g_lingo->getHandler(name);
 
 	// Builtin
-	if (allowRetVal) {
-		if (g_lingo->_builtinFuncs.contains(name)) {
-			funcSym = g_lingo->_builtinFuncs[name];
-		}
-	} else {
-		if (g_lingo->_builtinCmds.contains(name)) {
-			funcSym = g_lingo->_builtinCmds[name];
-		}
+	const SymbolHash &builtins = allowRetVal ? g_lingo->_builtinFuncs : g_lingo->_builtinCmds;
+	SymbolHash::const_iterator it = builtins.find(name);
+	if (it != builtins.end()) {
+		funcSym = it->_value;
 	}
 
 	call(funcSym, nargs, allowRetVal);
@@ -85,6 +85,8 @@ Symbol ScriptContext::define(Common::String &name, int nargs, ScriptData *code,
 		debugC(1, kDebugCompile, "<end define code>");
 	}
 
+	Lingo::invalidateHandlers();
+
 	if (!g_lingo->_eventHandlerTypeIds.contains(name)) {
 		_functionHandlers[name] = sym;
 		if (_scriptType == kMovieScript && _archive && !_archive->functionHandlers.contains(name)) {
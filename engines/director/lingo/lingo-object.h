@@ -197,6 +197,7 @@ public:
 	Common::Array<Datum> _constants;
 	DatumHash _properties;
 	Common::HashMap<uint32, Datum> _objArray;
+	HandlerLinks _handlerLinks;
 
 public:
 	ScriptContext(Common::String name, LingoArchive *archive = nullptr, ScriptType type = kNoneScript, int id = 0);
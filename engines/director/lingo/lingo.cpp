@@ -138,6 +138,8 @@ PCell::PCell(const Datum &prop, const Datum &val) {
 	v = val;
 }
 
+uint32 Lingo::_handlerGeneration = 1;
+
 Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	g_lingo = this;
 
@@ -213,6 +215,8 @@ void Lingo::reloadBuiltIns() {
 }
 
 LingoArchive::~LingoArchive() {
+	Lingo::invalidateHandlers();
+
 	for (int i = 0; i <= kMaxScriptType; i++) {
 		for (ScriptContextHash::iterator it = scriptContexts[i].begin(); it != scriptContexts[i].end(); ++it) {
 			delete it->_value;
@@ -238,10 +242,33 @@ Common::String LingoArchive::getName(uint16 id) {
 }
 
 Symbol Lingo::getHandler(const Common::String &name) {
+	// Every script context remembers the handlers its calls resolved to,
+	// until a script is compiled or unloaded, or another movie is played
+	Movie *movie = g_director->getCurrentMovie();
+	HandlerLinks &links = _currentScriptContext ? _currentScriptContext->_handlerLinks : _handlerLinks;
+	if (links.movie != movie || links.generation != _handlerGeneration) {
+		links.symbols.clear();
+		links.movie = movie;
+		links.generation = _handlerGeneration;
+	}
+
+	SymbolHash::const_iterator it = links.symbols.find(name);
+	if (it != links.symbols.end())
+		return it->_value;
+
+	Symbol sym = resolveHandler(name);
+	links.symbols[name] = sym;
+	return sym;
+}
+
+Symbol Lingo::resolveHandler(const Common::String &name) {
 	if (!_eventHandlerTypeIds.contains(name)) {
 		// local functions
-		if (_currentScriptContext && _currentScriptContext->_functionHandlers.contains(name))
-			return _currentScriptContext->_functionHandlers[name];
+		if (_currentScriptContext) {
+			SymbolHash::const_iterator it = _currentScriptContext->_functionHandlers.find(name);
+			if (it != _currentScriptContext->_functionHandlers.end())
+				return it->_value;
+		}
 
 		Symbol sym = g_director->getCurrentMovie()->getHandler(name);
 		if (sym.type != VOIDSYM)
@@ -1273,13 +1300,16 @@ void Lingo::varAssign(Datum &var, Datum &value, bool global, DatumHash *localvar
 	}
 
 	if (var.type == VAR) {
-		Common::String name = *var.u.s;
-
-		if (localvars && localvars->contains(name)) {
-			(*localvars)[name] = value;
-			if (global)
-				warning("varAssign: variable %s is local, not global", name.c_str());
-			return;
+		const Common::String &name = *var.u.s;
+
+		if (localvars) {
+			DatumHash::iterator it = localvars->find(name);
+			if (it != localvars->end()) {
+				it->_value = value;
+				if (global)
+					warning("varAssign: variable %s is local, not global", name.c_str());
+				return;
+			}
 		}
 		if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
 			_currentMe.u.obj->setProp(name, value);
@@ -1287,8 +1317,9 @@ void Lingo::varAssign(Datum &var, Datum &value, bool global, DatumHash *localvar
 				warning("varAssign: variable %s is instance or property, not global", name.c_str());
 			return;
 		}
-		if (_globalvars.contains(name)) {
-			_globalvars[name] = value;
+		DatumHash::iterator it = _globalvars.find(name);
+		if (it != _globalvars.end()) {
+			it->_value = value;
 			if (!global)
 				warning("varAssign: variable %s is global, not local", name.c_str());
 			return;
@@ -1328,23 +1359,26 @@ Datum Lingo::varFetch(Datum &var, bool global, DatumHash *localvars, bool silent
 	Datum result;
 
 	if (var.type == VAR) {
-		Datum d;
-		Common::String name = *var.u.s;
-
-		if (localvars && localvars->contains(name)) {
-			if (global)
-				warning("varFetch: variable %s is local, not global", name.c_str());
-			return (*localvars)[name];
+		const Common::String &name = *var.u.s;
+
+		if (localvars) {
+			DatumHash::const_iterator it = localvars->find(name);
+			if (it != localvars->end()) {
+				if (global)
+					warning("varFetch: variable %s is local, not global", name.c_str());
+				return it->_value;
+			}
 		}
 		if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
 			if (global)
 				warning("varFetch: variable %s is instance or property, not global", name.c_str());
 			return _currentMe.u.obj->getProp(name);
 		}
-		if (_globalvars.contains(name)) {
+		DatumHash::const_iterator it = _globalvars.find(name);
+		if (it != _globalvars.end()) {
 			if (!global)
 				warning("varFetch: variable %s is global, not local", name.c_str());
-			return _globalvars[name];
+			return it->_value;
 		}
 
 		if (!silent)
@@ -46,6 +46,7 @@ struct LingoV4TheEntity;
 class AbstractObject;
 class ScriptContext;
 class DirectorEngine;
+class Movie;
 class Frame;
 
 enum LexerDefineState {
@@ -232,6 +233,16 @@ struct LingoArchive {
 	void addNamesV4(Common::SeekableReadStreamEndian &stream);
 };
 
+// Handler names resolved by Lingo::getHandler(), valid as long as no script
+// is compiled or unloaded, and the current movie stays the same
+struct HandlerLinks {
+	SymbolHash symbols;
+	Movie *movie;
+	uint32 generation;
+
+	HandlerLinks() : movie(nullptr), generation(0) {}
+};
+
 struct RepeatBlock {
 	Common::Array<uint32> exits;
 	Common::Array<uint32> nexts;
@@ -287,9 +298,16 @@ private:
 public:
 	ScriptType event2script(LEvent ev);
 	Symbol getHandler(const Common::String &name);
+	static void invalidateHandlers() { _handlerGeneration++; }
 
 	void processEvents();
 
+private:
+	Symbol resolveHandler(const Common::String &name);
+
+	HandlerLinks _handlerLinks;
+	static uint32 _handlerGeneration;
+
 public:
 	void execute(uint pc);
 	void pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRetVal);
@@ -340,11 +340,15 @@ ScriptContext *Movie::getScriptContext(ScriptType type, uint16 id) {
 
 Symbol Movie::getHandler(const Common::String &name) {
 	if (!g_lingo->_eventHandlerTypeIds.contains(name)) {
-		if (_cast->_lingoArchive->functionHandlers.contains(name))
-			return _cast->_lingoArchive->functionHandlers[name];
-
-		if (_sharedCast && _sharedCast->_lingoArchive->functionHandlers.contains(name))
-			return _sharedCast->_lingoArchive->functionHandlers[name];
+		SymbolHash::const_iterator it = _cast->_lingoArchive->functionHandlers.find(name);
+		if (it != _cast->_lingoArchive->functionHandlers.end())
+			return it->_value;
+
+		if (_sharedCast) {
+			it = _sharedCast->_lingoArchive->functionHandlers.find(name);
+			if (it != _sharedCast->_lingoArchive->functionHandlers.end())
+				return it->_value;
+		}
 	}
 	return Symbol();
 }
@@ -116,11 +116,22 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 
 	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++) {
 		const Common::Rect &r = *i;
-		blitTo->fillRect(r, _stageColor);
-
 		_dirtyChannels = _currentMovie->getScore()->getSpriteIntersections(r);
+
+		// Nothing below the topmost opaque sprite covering the whole rect shows
+		Common::List<Channel *>::iterator first = _dirtyChannels.begin();
+		bool covered = false;
+		for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end(); j++) {
+			if ((*j)->isOpaque() && (*j)->getBbox().contains(r)) {
+				first = j;
+				covered = true;
+			}
+		}
+		if (!covered)
+			blitTo->fillRect(r, _stageColor);
+
 		for (int pass = 0; pass < 2; pass++) {
-			for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end(); j++) {
+			for (Common::List<Channel *>::iterator j = (pass == 0 ? first : _dirtyChannels.begin()); j != _dirtyChannels.end(); j++) {
 				if ((*j)->isActiveVideo() && (*j)->isVideoDirectToStage()) {
 					if (pass == 0)
 						continue;
@@ -133,6 +144,13 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 					inkBlitFrom(*j, r, blitTo);
 			}
 		}
+
+		// Only the redrawn parts of the stage have to reach the screen
+		if (blitTo == _composeSurface) {
+			Common::Rect damage = r;
+			damage.translate(_innerDims.left - _dims.left, _innerDims.top - _dims.top);
+			addDamagedRect(damage);
+		}
 	}
 
 	_dirtyRects.clear();
@@ -153,6 +171,7 @@ void Window::reset() {
 	resize(_composeSurface->w, _composeSurface->h, true);
 	_composeSurface->clear(_stageColor);
 	_contentIsDirty = true;
+	markFullyDamaged();
 }
 
 void Window::inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::ManagedSurface *blitTo) {
@@ -241,6 +260,35 @@ void Window::inkBlitShape(DirectorPlotData *pd, Common::Rect &srcRect) {
 	}
 }
 
+// The inks which copy the source pixels unchanged, a row at a time. Gives the
+// same result as going through inkDrawPixel() for every pixel.
+template <typename T>
+static void copyBlitSurface(DirectorPlotData *pd, const Common::Rect &srcRect, const Graphics::Surface *mask) {
+	const int srcX = abs(srcRect.left - pd->destRect.left);
+	const int width = pd->destRect.width();
+	const bool keyed = pd->ink == kInkTypeBackgndTrans;
+	const T key = (T)pd->backColor;
+	const bool drawMasked = pd->ink == kInkTypeMask;
+
+	for (int i = 0, srcY = abs(srcRect.top - pd->destRect.top); i < pd->destRect.height(); i++, srcY++) {
+		const T *src = (const T *)pd->srf->getBasePtr(srcX, srcY);
+		T *dst = (T *)pd->dst->getBasePtr(pd->destRect.left, pd->destRect.top + i);
+
+		if (!mask && !keyed) {
+			memcpy(dst, src, width * sizeof(T));
+			continue;
+		}
+
+		const T *msk = mask ? (const T *)mask->getBasePtr(srcX, srcY) : nullptr;
+		for (int j = 0; j < width; j++) {
+			if (msk && (msk[j] != 0) != drawMasked)
+				continue;
+			if (!keyed || src[j] != key)
+				dst[j] = src[j];
+		}
+	}
+}
+
 void Window::inkBlitSurface(DirectorPlotData *pd, Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!pd->srf)
 		return;
@@ -249,6 +297,25 @@ void Window::inkBlitSurface(DirectorPlotData *pd, Common::Rect &srcRect, const G
 	if (pd->sprite == kTextSprite)
 		pd->applyColor = false;
 
+	if (!pd->alpha && !pd->applyColor) {
+		switch (pd->ink) {
+		case kInkTypeMask:
+			if (pd->sprite == kTextSprite)
+				break;
+			// fall through
+		case kInkTypeCopy:
+		case kInkTypeMatte:
+		case kInkTypeBackgndTrans:
+			if (_wm->_pixelformat.bytesPerPixel == 1)
+				copyBlitSurface<byte>(pd, srcRect, mask);
+			else
+				copyBlitSurface<uint32>(pd, srcRect, mask);
+			return;
+		default:
+			break;
+		}
+	}
+
 	pd->srcPoint.y = abs(srcRect.top - pd->destRect.top);
 	for (int i = 0; i < pd->destRect.height(); i++, pd->srcPoint.y++) {
 		if (_wm->_pixelformat.bytesPerPixel == 1) {
@@ -33,6 +33,7 @@
 #include "engines/util.h"
 #include "engines/metaengine.h"
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/file.h"
@@ -42,6 +43,8 @@
 #include "common/error.h"
 #include "common/list.h"
 #include "common/memstream.h"
+#include "common/osd_message_queue.h"
+#include "common/profiler.h"
 #include "common/savefile.h"
 #include "common/scummsys.h"
 #include "common/taskbar.h"
@@ -182,13 +185,132 @@ Engine::Engine(OSystem *syst)
 	CursorMan.pushCursorPalette(NULL, 0, 0);
 }
 
+Engine::FrameStats::FrameStats() : _overlay(false), _overlayStart(0) {
+	reset();
+}
+
+void Engine::FrameStats::reset() {
+	_inFrame = false;
+	_frameStart = 0;
+	_phase = -1;
+	_phaseStart = 0;
+	_frames = 0;
+	_totalMicros = 0;
+	memset(_phaseMicros, 0, sizeof(_phaseMicros));
+	_historyCount = 0;
+}
+
+void Engine::FrameStats::beginFrame() {
+	endFrame();
+
+	_inFrame = true;
+	_frameStart = Common::Profiler::getMicros();
+	_phase = -1;
+}
+
+void Engine::FrameStats::beginPhase(Phase phase) {
+	if (!_inFrame)
+		return;
+
+	const uint64 now = Common::Profiler::getMicros();
+	endPhase(now);
+	_phase = phase;
+	_phaseStart = now;
+}
+
+void Engine::FrameStats::endPhase(uint64 now) {
+	if (_phase < 0)
+		return;
+
+	_phaseMicros[_phase] += now - _phaseStart;
+#ifdef USE_PROFILER
+	static const char *const phaseNames[kPhaseCount] = { "frame.logic", "frame.render", "frame.present", "frame.sleep" };
+	Common::Profiler::addZone(phaseNames[_phase], _phaseStart, now);
+#endif
+	_phase = -1;
+}
+
+void Engine::FrameStats::endFrame() {
+	if (!_inFrame)
+		return;
+
+	const uint64 now = Common::Profiler::getMicros();
+	endPhase(now);
+	_inFrame = false;
+#ifdef USE_PROFILER
+	Common::Profiler::addZone("frame", _frameStart, now);
+#endif
+
+	const uint32 duration = (uint32)MIN<uint64>(now - _frameStart, 0xFFFFFFFF);
+	_history[_frames % kHistorySize] = duration;
+	_historyCount = MIN<uint>(_historyCount + 1, kHistorySize);
+	_frames++;
+	_totalMicros += duration;
+
+	if (_overlay && now - _overlayStart >= 2000000) {
+		_overlayStart = now;
+		Common::String summary = getSummary();
+		// Only the first two lines fit on the OSD
+		const char *thirdLine = strchr(summary.c_str(), '\n');
+		if (thirdLine)
+			thirdLine = strchr(thirdLine + 1, '\n');
+		if (thirdLine)
+			summary = Common::String(summary.c_str(), thirdLine);
+		Common::OSDMessageQueue::instance().addMessage(Common::U32String(summary));
+	}
+}
+
+void Engine::FrameStats::setOverlay(bool enable) {
+	_overlay = enable;
+	_overlayStart = 0;
+}
+
+uint32 Engine::FrameStats::getPercentile(const uint32 *sorted, uint percent) const {
+	return sorted[MIN<uint>(_historyCount * percent / 100, _historyCount - 1)];
+}
+
+Common::String Engine::FrameStats::getSummary() const {
+	if (!_historyCount)
+		return "No frames measured";
+
+	uint32 sorted[kHistorySize];
+	uint64 recentMicros = 0;
+	for (uint i = 0; i < _historyCount; ++i) {
+		sorted[i] = _history[i];
+		recentMicros += _history[i];
+	}
+	Common::sort(sorted, sorted + _historyCount);
+
+	Common::String result = Common::String::format("%.1f fps over the last %u frames (%u in total)\n",
+		recentMicros ? _historyCount * 1000000.0 / recentMicros : 0.0, _historyCount, _frames);
+	result += Common::String::format("Frame ms: p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+		getPercentile(sorted, 50) / 1000.0, getPercentile(sorted, 90) / 1000.0,
+		getPercentile(sorted, 99) / 1000.0, getPercentile(sorted, 100) / 1000.0);
+
+	static const char *const phaseNames[kPhaseCount] = { "logic", "render", "present", "sleep" };
+	uint64 unmarked = _totalMicros;
+	for (int i = 0; i < kPhaseCount; ++i) {
+		result += Common::String::format("%s %.1f%%, ", phaseNames[i], _totalMicros ? _phaseMicros[i] * 100.0 / _totalMicros : 0.0);
+		unmarked -= MIN(unmarked, _phaseMicros[i]);
+	}
+	result += Common::String::format("other %.1f%%\n", _totalMicros ? unmarked * 100.0 / _totalMicros : 0.0);
+	return result;
+}
+
 Engine::~Engine() {
 	_mixer->stopAll();
 
+	if (!_saveFileMan->updateBackgroundSaves(true))
+		warning("Engine: %s", _saveFileMan->popErrorDesc().c_str());
+
 	delete _debugger;
 	delete _mainMenuDialog;
 	g_engine = NULL;
 
+	// The game may have written its saves in ways the save/load choosers
+	// do not notice
+	GUI::SaveMetaInfoCache::instance().invalidate(_targetName);
+
 	// Remove our cursors again to prevent memory leaks
 	CursorMan.popCursor();
 	CursorMan.popCursorPalette();
@@ -526,6 +648,10 @@ void Engine::checkCD() {
 }
 
 void Engine::handleAutoSave() {
+	// Check on the saves written in the background
+	if (_saveFileMan->isSavingInBackground() && !_saveFileMan->updateBackgroundSaves())
+		g_system->displayMessageOnOSD(_("Error occurred writing the saved game"));
+
 	const int diff = _system->getMillis() - _lastAutosaveTime;
 
 	if (_autosaveInterval != 0 && diff > (_autosaveInterval * 1000)) {
@@ -551,6 +677,9 @@ void Engine::saveAutosaveIfEnabled() {
 			saveFlag = false;
 		}
 
+		if (saveFlag)
+			GUI::SaveMetaInfoCache::instance().invalidate(_targetName, getAutosaveSlot());
+
 		if (!saveFlag) {
 			// Set the next autosave interval to be in 5 minutes, rather than whatever
 			// full autosave interval the user has selected
@@ -767,7 +896,9 @@ bool Engine::canLoadGameStateCurrently() {
 }
 
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
-	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
+	// Compressing and writing it out is left to a worker thread, so that
+	// the game does not stall on big saves
+	Common::OutSaveFile *saveFile = _saveFileMan->openForSavingInBackground(getSaveStateName(slot));
 
 	if (!saveFile)
 		return Common::kWritingFailed;
@@ -780,6 +911,9 @@ Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool i
 	}
 
 	delete saveFile;
+
+	// The choosers have to read the save again
+	GUI::SaveMetaInfoCache::instance().invalidate(_targetName, slot);
 	return result;
 }
 
@@ -218,6 +218,77 @@ private:
 	 */
 	GUI::Debugger *_debugger;
 public:
+	/**
+	 * Frame timing statistics.
+	 *
+	 * This is opt-in: an engine that wants them calls beginFrame() at the start of each
+	 * iteration of its main loop, and beginPhase() whenever it moves on to another phase
+	 * of the frame. A phase lasts until the next one, or the end of the frame.
+	 * The debugger shows them with the 'framestats' command.
+	 */
+	class FrameStats {
+	public:
+		enum Phase {
+			kPhaseLogic,
+			kPhaseRender,
+			kPhasePresent,
+			kPhaseSleep,
+			kPhaseCount
+		};
+
+		FrameStats();
+
+		/** Start a frame, ending the previous one if needed. */
+		void beginFrame();
+		/** End the current frame. */
+		void endFrame();
+		/** Start a phase of the current frame, ending the previous phase. */
+		void beginPhase(Phase phase);
+
+		/** Forget the frames measured until now. */
+		void reset();
+
+		/** Show a summary on the OSD every two seconds. */
+		void setOverlay(bool enable);
+
+		uint32 getFrameCount() const { return _frames; }
+
+		/**
+		 * The frame rate, frame time percentiles of the last frames, and the share of the
+		 * time spent in each phase.
+		 */
+		Common::String getSummary() const;
+
+	private:
+		static const uint kHistorySize = 256;
+
+		void endPhase(uint64 now);
+		uint32 getPercentile(const uint32 *sorted, uint percent) const;
+
+		bool _inFrame;
+		uint64 _frameStart;
+		int _phase;
+		uint64 _phaseStart;
+
+		uint32 _frames;
+		uint64 _totalMicros;
+		uint64 _phaseMicros[kPhaseCount];
+
+		uint32 _history[kHistorySize];
+		uint _historyCount;
+
+		bool _overlay;
+		uint64 _overlayStart;
+	};
+
+private:
+	FrameStats _frameStats;
+
+public:
+	/**
+	 * Return the engine's frame timing statistics.
+	 */
+	FrameStats &getFrameStats() { return _frameStats; }
 
 
 	/**
@@ -59,6 +59,7 @@ GlkEngine::GlkEngine(OSystem *syst, const GlkGameDescription &gameDesc) :
 	DebugMan.addDebugChannel(kDebugGraphics, "graphics", "Graphics handling");
 	DebugMan.addDebugChannel(kDebugSound, "sound", "Sound and Music handling");
 	DebugMan.addDebugChannel(kDebugSpeech, "speech", "Text to Speech handling");
+	DebugMan.addDebugChannel(kDebugProfile, "profile", "Count the calls of the game functions");
 
 	g_vm = this;
 }
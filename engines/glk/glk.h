@@ -52,7 +52,8 @@ enum GlkDebugChannels {
 	kDebugScripts   = 1 << 1,
 	kDebugGraphics  = 1 << 2,
 	kDebugSound     = 1 << 3,
-	kDebugSpeech    = 1 << 4
+	kDebugSpeech    = 1 << 4,
+	kDebugProfile   = 1 << 5
 };
 
 
@@ -85,8 +85,17 @@ void Glulx::execute_loop() {
 			fatal_error_i("Encountered unknown opcode.", opcode);
 
 		/* Based on the oplist structure, load the actual operand values
-		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+		   into inst. This moves the PC up to the end of the instruction.
+		   The operands of the instructions in ROM are only decoded once. */
+		if (pc < ramstart && instcache) {
+			instcache_t *entry = &instcache[pc & (INST_CACHE_SIZE - 1)];
+			if (entry->addr == pc || decode_operands(entry, oplist))
+				load_cached_operands(inst, entry);
+			else
+				parse_operands(inst, oplist);
+		} else {
+			parse_operands(inst, oplist);
+		}
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
@@ -21,6 +21,8 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "common/algorithm.h"
+#include "common/debug.h"
 
 namespace Glk {
 namespace Glulx {
@@ -34,6 +36,9 @@ void Glulx::enter_function(uint funcaddr, uint argc, uint *argv) {
 	int loctype, locnum;
 	uint addr = funcaddr;
 
+	if (count_calls)
+		call_counts[funcaddr]++;
+
 	accelFunc = accel_get_func(addr);
 	if (accelFunc) {
 		profile_in(addr, stackptr, true);
@@ -295,5 +300,41 @@ uint Glulx::pop_callstub_string(int *bitnum) {
 	return 0;
 }
 
+namespace {
+
+struct CallCount {
+	uint addr;
+	uint calls;
+};
+
+struct CallCountGreater {
+	bool operator()(const CallCount &a, const CallCount &b) const {
+		return a.calls > b.calls;
+	}
+};
+
+} // End of anonymous namespace
+
+void Glulx::dump_call_counts() {
+	if (!count_calls || call_counts.empty())
+		return;
+
+	Common::Array<CallCount> counts;
+	uint total = 0;
+	for (Common::HashMap<uint, uint>::const_iterator it = call_counts.begin(); it != call_counts.end(); ++it) {
+		CallCount count = { it->_key, it->_value };
+		counts.push_back(count);
+		total += it->_value;
+	}
+	Common::sort(counts.begin(), counts.end(), CallCountGreater());
+
+	debug("Glulx: %u calls of %u functions", total, counts.size());
+	for (uint ix = 0; ix < counts.size() && ix < 20; ix++) {
+		debug("  %08x: %u calls%s", counts[ix].addr, counts[ix].calls,
+		      accel_get_func(counts[ix].addr) ? " (accelerated)" : "");
+	}
+	call_counts.clear();
+}
+
 } // End of namespace Glulx
 } // End of namespace Glk
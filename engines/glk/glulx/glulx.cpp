@@ -41,6 +41,10 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		classes_table(0), indiv_prop_start(0), class_metaclass(0), object_metaclass(0),
 		routine_metaclass(0), string_metaclass(0), self(0), num_attr_bytes(0), cpv__start(0),
 		accelentries(nullptr),
+		// operand
+		instcache(nullptr),
+		// profiling
+		count_calls(false),
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
 		// serial
@@ -66,7 +70,9 @@ void Glulx::runGame() {
 	if (library_autorestore_hook)
 		library_autorestore_hook();
 
+	count_calls = debugChannelSet(-1, kDebugProfile);
 	execute_loop();
+	dump_call_counts();
 	finalize_vm();
 
 	gamefile_start = 0;
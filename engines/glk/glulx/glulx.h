@@ -26,6 +26,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -146,6 +147,25 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Decoded operands of the instructions in ROM, indexed by address
+	 */
+	instcache_t *instcache;
+
+	/**@}*/
+
+	/**
+	 * \defgroup profiling fields
+	 * @{
+	 */
+
+	bool count_calls;   ///< set when the profile debug channel is enabled
+
+	/**
+	 * Number of calls of each function, by address
+	 */
+	Common::HashMap<uint, uint> call_counts;
+
 	/**@}*/
 
 	/**
@@ -537,6 +557,11 @@ public:
 	 */
 	void init_operands();
 
+	/**
+	 * Free the decoded instruction cache, when the VM shuts down.
+	 */
+	void final_operands();
+
 	/**
 	 * Return the operandlist for a given opcode. For opcodes in the range 00..7F, it's faster
 	 * to use the array fast_operandlist[].
@@ -552,6 +577,17 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Decode the operands of the instruction at the PC into the given cache entry, without
+	 * loading their values. Returns false if the instruction can't be cached.
+	 */
+	bool decode_operands(instcache_t *entry, const operandlist_t *oplist);
+
+	/**
+	 * Same as parse_operands(), for an instruction already decoded by decode_operands().
+	 */
+	void load_cached_operands(oparg_t *opargs, const instcache_t *entry);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
@@ -575,6 +611,11 @@ public:
 	 */
 	void enter_function(uint addr, uint argc, uint *argv);
 
+	/**
+	 * Print the most called functions, when the profile debug channel is set.
+	 */
+	void dump_call_counts();
+
 	/**
 	 * Pop the current call frame off the stack. This is very simple.
 	*/
@@ -352,6 +352,39 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How a cached operand is fetched. The addressing modes of the game file are folded
+ * into these, with the RAM offset and the immediate bytes already decoded.
+ */
+enum cachedmode {
+	cachedmode_Const = 0,       ///< Load the value
+	cachedmode_Pop = 1,         ///< Load from the top of the stack
+	cachedmode_Mem = 2,         ///< Load from the main memory at the value
+	cachedmode_Locals = 3,      ///< Load from the locals at the value
+	cachedmode_Discard = 4,     ///< Discard the stored value
+	cachedmode_Push = 5,        ///< Store on the stack
+	cachedmode_StoreMem = 6,    ///< Store in the main memory at the value
+	cachedmode_StoreLocals = 7  ///< Store in the locals at the value
+};
+
+/**
+ * The decoded operands of an instruction in ROM. Since ROM can't change, an instruction
+ * only needs to be decoded the first time it's run.
+ */
+struct instcache_struct {
+	uint addr;                  ///< Address of the operand modes, or 0 if the entry is unused
+	uint nextpc;                ///< Address of the next instruction
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];   ///< cachedmode of each operand
+	uint values[MAX_OPERANDS];
+};
+typedef instcache_struct instcache_t;
+
+/**
+ * Number of instructions in the decoded instruction cache. Must be a power of two.
+ */
+#define INST_CACHE_SIZE (4096)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -67,6 +67,20 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	if (!instcache)
+		instcache = (instcache_t *)glulx_malloc(INST_CACHE_SIZE * sizeof(instcache_t));
+	if (instcache) {
+		for (int ix = 0; ix < INST_CACHE_SIZE; ix++)
+			instcache[ix].addr = 0;
+	}
+}
+
+void Glulx::final_operands() {
+	if (instcache) {
+		glulx_free(instcache);
+		instcache = nullptr;
+	}
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -517,6 +531,173 @@ WrLocalsAddr:
 	}
 }
 
+bool Glulx::decode_operands(instcache_t *entry, const operandlist_t *oplist) {
+	int numops = oplist->num_ops;
+	uint modeaddr = pc;
+	uint addr = pc + (numops + 1) / 2;
+
+	entry->addr = 0;
+	for (int ix = 0; ix < numops; ix++) {
+		int mode = Mem1(modeaddr + ix / 2);
+		mode = (ix & 1) ? ((mode >> 4) & 0x0F) : (mode & 0x0F);
+
+		/* The low two bits of the addressing modes tell the size of the
+		   immediate bytes: none, one, two or four. */
+		uint value = 0;
+		switch (mode & 3) {
+		case 1:
+			value = Mem1(addr);
+			addr++;
+			break;
+		case 2:
+			value = Mem2(addr);
+			addr += 2;
+			break;
+		case 3:
+			value = Mem4(addr);
+			addr += 4;
+			break;
+		default:
+			break;
+		}
+
+		byte cached;
+		if (oplist->formlist[ix] == modeform_Load) {
+			switch (mode) {
+			case 0:
+			case 3:
+				cached = cachedmode_Const;
+				break;
+			case 1:
+				value = (int)(signed char)value;
+				cached = cachedmode_Const;
+				break;
+			case 2:
+				value = (int)(int16)value;
+				cached = cachedmode_Const;
+				break;
+			case 8:
+				cached = cachedmode_Pop;
+				break;
+			case 5: case 6: case 7:
+				cached = cachedmode_Mem;
+				break;
+			case 13: case 14: case 15:
+				value += ramstart;
+				cached = cachedmode_Mem;
+				break;
+			case 9: case 10: case 11:
+				cached = cachedmode_Locals;
+				break;
+			default:
+				/* Leave the error to parse_operands() */
+				return false;
+			}
+		} else {
+			switch (mode) {
+			case 0:
+				cached = cachedmode_Discard;
+				break;
+			case 8:
+				cached = cachedmode_Push;
+				break;
+			case 5: case 6: case 7:
+				cached = cachedmode_StoreMem;
+				break;
+			case 13: case 14: case 15:
+				value += ramstart;
+				cached = cachedmode_StoreMem;
+				break;
+			case 9: case 10: case 11:
+				cached = cachedmode_StoreLocals;
+				break;
+			default:
+				return false;
+			}
+		}
+
+		entry->modes[ix] = cached;
+		entry->values[ix] = value;
+	}
+
+	/* An instruction running over the end of ROM could change */
+	if (addr > ramstart)
+		return false;
+
+	entry->addr = pc;
+	entry->nextpc = addr;
+	entry->oplist = oplist;
+	return true;
+}
+
+void Glulx::load_cached_operands(oparg_t *args, const instcache_t *entry) {
+	int numops = entry->oplist->num_ops;
+	int argsize = entry->oplist->arg_size;
+	oparg_t *curarg = args;
+
+	for (int ix = 0; ix < numops; ix++, curarg++) {
+		uint value = entry->values[ix];
+
+		curarg->desttype = 0;
+
+		switch (entry->modes[ix]) {
+		case cachedmode_Const:
+			curarg->value = value;
+			break;
+
+		case cachedmode_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case cachedmode_Mem:
+			if (argsize == 4) {
+				curarg->value = Mem4(value);
+			} else if (argsize == 2) {
+				curarg->value = Mem2(value);
+			} else {
+				curarg->value = Mem1(value);
+			}
+			break;
+
+		case cachedmode_Locals:
+			value += localsbase;
+			if (argsize == 4) {
+				curarg->value = Stk4(value);
+			} else if (argsize == 2) {
+				curarg->value = Stk2(value);
+			} else {
+				curarg->value = Stk1(value);
+			}
+			break;
+
+		case cachedmode_Discard:
+			curarg->value = 0;
+			break;
+
+		case cachedmode_Push:
+			curarg->desttype = 3;
+			curarg->value = 0;
+			break;
+
+		case cachedmode_StoreMem:
+			curarg->desttype = 1;
+			curarg->value = value;
+			break;
+
+		default: /* cachedmode_StoreLocals */
+			curarg->desttype = 2;
+			curarg->value = value;
+			break;
+		}
+	}
+
+	pc = entry->nextpc;
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
@@ -117,6 +117,7 @@ void Glulx::finalize_vm() {
 	}
 
 	final_serial();
+	final_operands();
 }
 
 void Glulx::vm_restart() {
@@ -241,7 +241,13 @@ void TextBufferWindow::touchScroll() {
 	g_vm->_selection->clearSelection();
 	_windows->repaint(_bbox);
 
-	for (int i = 0; i < _scrollMax; i++)
+	// Only the rows on screen, and the ones at the bottom of the scrollback
+	// which are shown again when the window scrolls back down, need drawing
+	int bottom = MIN(_height, _scrollMax);
+	for (int i = 0; i < bottom; i++)
+		_lines[i]._dirty = true;
+	int top = MIN(_scrollPos + _height, _scrollMax);
+	for (int i = MAX(_scrollPos, bottom); i < top; i++)
 		_lines[i]._dirty = true;
 }
 
@@ -857,12 +863,12 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
-
 		// skip if we can
-		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
+		if (!_lines[i]._dirty && !_lines[i]._repaint && !Windows::_forceRedraw && _scrollPos == 0)
 			continue;
 
+		TextBufferRow ln(_lines[i]);
+
 		// repaint previously selected lines if needed
 		if (ln._repaint && !Windows::_forceRedraw)
 			_windows->redrawRect(Rect(x0 / GLI_SUBPIX, y,
@@ -1088,7 +1094,7 @@ void TextBufferWindow::redraw() {
 	 * draw the images
 	 */
 	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1550,11 +1556,18 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// the oldest row becomes the new last line
+	TextBufferRow &oldest = _lines[_scrollBack - 1];
+	if (oldest._lPic)
+		oldest._lPic->decrement();
+	if (oldest._rPic)
+		oldest._rPic->decrement();
+	_lines.rotate();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1574,7 +1587,8 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._rPic = nullptr;
 	_lines[0]._lHyper = 0;
 	_lines[0]._rHyper = 0;
-	
+	_lines[0]._repaint = false;
+
 	Common::fill(_chars, _chars + TBLINELEN, ' ');
 	Attributes *a = _attrs;
 	for (int i = 0; i < TBLINELEN; ++i, ++a)
@@ -1589,7 +1603,13 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 void TextBufferWindow::scrollResize() {
 	int i;
 
-	_lines.clear();
+	if (_scrollBack >= SCROLLBACK_MAX) {
+		// drop the oldest lines rather than growing any further
+		_scrollMax = MIN(_scrollMax, _scrollBack - 1);
+		_lastSeen = MIN(_lastSeen, _scrollBack - 1);
+		return;
+	}
+
 	_lines.resize(_scrollBack + SCROLLBACK);
 
 	_chars = _lines[0]._chars;
@@ -1646,6 +1666,18 @@ void TextBufferWindow::flowBreak() {
 
 /*--------------------------------------------------------------------------*/
 
+void TextBufferWindow::TextBufferRows::resize(uint newSize) {
+	Common::Array<TextBufferRow> rows;
+	rows.resize(newSize);
+	for (uint idx = 0; idx < newSize && idx < _rows.size(); ++idx)
+		rows[idx] = (*this)[idx];
+
+	_rows = rows;
+	_first = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+
 TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(false),
 	_repaint(false), _lPic(nullptr), _rPic(nullptr), _lHyper(0), _rHyper(0),
 	_lm(0), _rm(0) {
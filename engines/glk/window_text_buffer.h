@@ -53,7 +53,41 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window, the newest first. Scrolling rotates the rows rather
+	 * than moving them, so it doesn't get slower as the scrollback grows
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow> _rows;
+		uint _first;
+	public:
+		TextBufferRows() : _first(0) {}
+
+		TextBufferRow &operator[](uint idx) {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+		const TextBufferRow &operator[](uint idx) const {
+			return _rows[(_first + idx) % _rows.size()];
+		}
+
+		uint size() const {
+			return _rows.size();
+		}
+
+		/**
+		 * Changes the number of rows, keeping the existing ones
+		 */
+		void resize(uint newSize);
+
+		/**
+		 * Makes the oldest row the newest one
+		 */
+		void rotate() {
+			_first = (_first + _rows.size() - 1) % _rows.size();
+		}
+	};
 private:
 	PropFontInfo &_font;
 private:
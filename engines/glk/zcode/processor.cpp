@@ -200,23 +200,30 @@ void Processor::initialize() {
 	}
 }
 
+inline zword Processor::load_variable() {
+	zbyte variable;
+	zword value;
+
+	CODE_BYTE(variable);
+
+	if (variable == 0)
+		value = *_sp++;
+	else if (variable < 16)
+		value = *(_fp - variable);
+	else {
+		zword addr = h_globals + 2 * (variable - 16);
+		LOW_WORD(addr, value);
+	}
+
+	return value;
+}
+
 void Processor::load_operand(zbyte type) {
 	zword value;
 
 	if (type & 2) {
 		// variable
-		zbyte variable;
-
-		CODE_BYTE(variable);
-
-		if (variable == 0)
-			value = *_sp++;
-		else if (variable < 16)
-			value = *(_fp - variable);
-		else {
-			zword addr = h_globals + 2 * (variable - 16);
-			LOW_WORD(addr, value);
-		}
+		value = load_variable();
 	} else if (type & 1) {
 		// small constant
 		zbyte bvalue;
@@ -244,23 +251,53 @@ void Processor::load_all_operands(zbyte specifier) {
 }
 
 void Processor::interpret() {
+	// Asking the event manager whether to quit is much slower than running an
+	// instruction, so it is only done every so many instructions
+	const uint QUIT_POLL_MASK = 0xff;
+	uint count = 0;
+
 	do {
 		zbyte opcode;
 		CODE_BYTE(opcode);
 		zargc = 0;
 
 		if (opcode < 0x80) {
-			// 2OP opcodes
-			load_operand((zbyte)(opcode & 0x40) ? 2 : 1);
-			load_operand((zbyte)(opcode & 0x20) ? 2 : 1);
-
-			(*this.*var_opcodes[opcode & 0x1f])();
+			// 2OP opcodes, the operands can only be variables or small constants
+			zargs[0] = (opcode & 0x40) ? load_variable() : codeByte();
+			zargs[1] = (opcode & 0x20) ? load_variable() : codeByte();
+			zargc = 2;
+
+			// The comparisons and arithmetic dominate most story files, so
+			// they are done here rather than through the opcode table
+			switch (opcode & 0x1f) {
+			case 0x01:
+				branch(zargs[0] == zargs[1]);
+				break;
+			case 0x02:
+				branch((short)zargs[0] < (short)zargs[1]);
+				break;
+			case 0x03:
+				branch((short)zargs[0] > (short)zargs[1]);
+				break;
+			case 0x14:
+				store((zword)((short)zargs[0] + (short)zargs[1]));
+				break;
+			case 0x15:
+				store((zword)((short)zargs[0] - (short)zargs[1]));
+				break;
+			default:
+				(*this.*var_opcodes[opcode & 0x1f])();
+				break;
+			}
 
 		} else if (opcode < 0xb0) {
 			// 1OP opcodes
 			load_operand((zbyte)(opcode >> 4));
 
-			(*this.*op1_opcodes[opcode & 0x0f])();
+			if ((opcode & 0x0f) == 0x00)
+				branch((short)zargs[0] == 0);
+			else
+				(*this.*op1_opcodes[opcode & 0x0f])();
 
 		} else if (opcode < 0xc0) {
 			// 0OP opcodes
@@ -289,7 +326,7 @@ void Processor::interpret() {
 		if (end_of_sound_flag)
 			end_of_sound();
 #endif
-	} while (!shouldQuit() && !_finished);
+	} while (!_finished && ((++count & QUIT_POLL_MASK) || !shouldQuit()));
 
 	_finished--;
 }
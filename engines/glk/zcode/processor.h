@@ -106,6 +106,11 @@ protected:
 	 */
 	void load_operand(zbyte type);
 
+	/**
+	 * Read a variable number from the code, and return the variable's value
+	 */
+	zword load_variable();
+
 	/**
 	 * Given the operand specifier byte, load all (up to four) operands
 	 * for a VAR or EXT opcode.
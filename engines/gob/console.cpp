@@ -37,6 +37,7 @@ GobConsole::GobConsole(GobEngine *vm) : GUI::Debugger(), _vm(vm), _cheater(0) {
 	registerCmd("varString",    WRAP_METHOD(GobConsole, cmd_varString));
 	registerCmd("cheat",        WRAP_METHOD(GobConsole, cmd_cheat));
 	registerCmd("listArchives", WRAP_METHOD(GobConsole, cmd_listArchives));
+	registerCmd("unpackCache",  WRAP_METHOD(GobConsole, cmd_unpackCache));
 }
 
 GobConsole::~GobConsole() {
@@ -186,4 +187,15 @@ bool GobConsole::cmd_listArchives(int argc, const char **argv) {
 	return true;
 }
 
+bool GobConsole::cmd_unpackCache(int argc, const char **argv) {
+	UnpackCacheInfo info;
+
+	_vm->_dataIO->getUnpackCacheInfo(info);
+
+	debugPrintf("Unpacked archive members kept: %d, %d bytes\n", info.fileCount, info.size);
+	debugPrintf("Unpacked members opened: %d from the cache, %d unpacked\n", info.hits, info.misses);
+
+	return true;
+}
+
 } // End of namespace Gob
@@ -53,6 +53,7 @@ private:
 	bool cmd_cheat(int argc, const char **argv);
 
 	bool cmd_listArchives(int argc, const char **argv);
+	bool cmd_unpackCache(int argc, const char **argv);
 };
 
 } // End of namespace Gob
@@ -37,7 +37,7 @@ DataIO::File::File(const Common::String &n, uint32 s, uint32 o, uint8 c, Archive
 }
 
 
-DataIO::DataIO() {
+DataIO::DataIO() : _unpackedSize(0), _unpackHits(0), _unpackMisses(0) {
 	// Reserve memory for the standard max amount of archives
 	_archives.reserve(kMaxArchives);
 	for (int i = 0; i < kMaxArchives; i++)
@@ -68,6 +68,13 @@ void DataIO::getArchiveInfo(Common::Array<ArchiveInfo> &info) const {
 	}
 }
 
+void DataIO::getUnpackCacheInfo(UnpackCacheInfo &info) const {
+	info.fileCount = _unpackedFiles.size();
+	info.size      = _unpackedSize;
+	info.hits      = _unpackHits;
+	info.misses    = _unpackMisses;
+}
+
 uint32 DataIO::getSizeChunks(Common::SeekableReadStream &src) {
 	uint32 size = 0;
 
@@ -305,6 +312,7 @@ bool DataIO::closeArchive(bool base) {
 }
 
 bool DataIO::closeArchive(Archive &archive) {
+	dropUnpacked(archive);
 	archive.file.close();
 
 	return true;
@@ -326,6 +334,9 @@ int32 DataIO::fileSize(const Common::String &name) {
 		if (file->compression == 0)
 			return file->size;
 
+		if (file->unpacked)
+			return file->unpacked->size;
+
 		// Sanity checks
 		assert(file->size >= 4);
 		assert(file->archive);
@@ -413,20 +424,19 @@ Common::SeekableReadStream *DataIO::getFile(File &file) {
 	if (!file.archive->file.isOpen())
 		return 0;
 
-	if (!file.archive->file.seek(file.offset))
-		return 0;
-
-	Common::SeekableReadStream *rawData =
-		new Common::SafeSeekableSubReadStream(&file.archive->file, file.offset, file.offset + file.size);
-
-	if (file.compression == 0)
-		return rawData;
+	if (file.compression != 0) {
+		// The streams share the unpacked data, which is only read
+		UnpackedPtr unpacked = getUnpacked(file);
+		if (!unpacked)
+			return 0;
 
-	Common::SeekableReadStream *unpackedData = unpack(*rawData, file.compression);
+		return new Common::MappedReadStream(unpacked, unpacked->data, unpacked->size);
+	}
 
-	delete rawData;
+	if (!file.archive->file.seek(file.offset))
+		return 0;
 
-	return unpackedData;
+	return new Common::SafeSeekableSubReadStream(&file.archive->file, file.offset, file.offset + file.size);
 }
 
 byte *DataIO::getFile(File &file, int32 &size) {
@@ -436,6 +446,19 @@ byte *DataIO::getFile(File &file, int32 &size) {
 	if (!file.archive->file.isOpen())
 		return 0;
 
+	if (file.compression != 0) {
+		// The caller owns, and may modify, the data it gets
+		UnpackedPtr unpacked = getUnpacked(file);
+		if (!unpacked)
+			return 0;
+
+		size = unpacked->size;
+
+		byte *data = new byte[size];
+		memcpy(data, unpacked->data, size);
+		return data;
+	}
+
 	if (!file.archive->file.seek(file.offset))
 		return 0;
 
@@ -447,14 +470,63 @@ byte *DataIO::getFile(File &file, int32 &size) {
 		return 0;
 	}
 
-	if (file.compression == 0)
-		return rawData;
+	return rawData;
+}
+
+DataIO::UnpackedPtr DataIO::getUnpacked(File &file) {
+	if (file.unpacked) {
+		_unpackHits++;
+
+		_unpackedFiles.remove(&file);
+		_unpackedFiles.push_front(&file);
+		return file.unpacked;
+	}
+
+	_unpackMisses++;
 
-	byte *unpackedData = unpack(rawData, file.size, size, file.compression);
+	if (!file.archive->file.seek(file.offset))
+		return UnpackedPtr();
+
+	byte *rawData = new byte[file.size];
+	if (file.archive->file.read(rawData, file.size) != file.size) {
+		delete[] rawData;
+		return UnpackedPtr();
+	}
+
+	int32 size;
+	byte *data = unpack(rawData, file.size, size, file.compression);
 
 	delete[] rawData;
 
-	return unpackedData;
+	UnpackedPtr unpacked(new Unpacked(data, size));
+
+	file.unpacked = unpacked;
+	_unpackedFiles.push_front(&file);
+	_unpackedSize += size;
+
+	// Forget the least recently used members, the streams still open on them keep their data
+	while (_unpackedSize > kMaxUnpackedSize) {
+		File *oldest = _unpackedFiles.back();
+		_unpackedFiles.pop_back();
+
+		_unpackedSize -= oldest->unpacked->size;
+		oldest->unpacked.reset();
+	}
+
+	return unpacked;
+}
+
+void DataIO::dropUnpacked(Archive &archive) {
+	for (Common::List<File *>::iterator it = _unpackedFiles.begin(); it != _unpackedFiles.end(); ) {
+		if ((*it)->archive != &archive) {
+			++it;
+			continue;
+		}
+
+		_unpackedSize -= (*it)->unpacked->size;
+		(*it)->unpacked.reset();
+		it = _unpackedFiles.erase(it);
+	}
 }
 
 } // End of namespace Gob
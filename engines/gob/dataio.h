@@ -27,7 +27,10 @@
 #include "common/str.h"
 #include "common/hashmap.h"
 #include "common/array.h"
+#include "common/list.h"
 #include "common/file.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -41,12 +44,20 @@ struct ArchiveInfo {
 	uint32 fileCount;
 };
 
+struct UnpackCacheInfo {
+	uint32 fileCount;
+	uint32 size;
+	uint32 hits;
+	uint32 misses;
+};
+
 class DataIO {
 public:
 	DataIO();
 	~DataIO();
 
 	void getArchiveInfo(Common::Array<ArchiveInfo> &info) const;
+	void getUnpackCacheInfo(UnpackCacheInfo &info) const;
 
 	bool openArchive(Common::String name, bool base);
 	bool closeArchive(bool base);
@@ -64,8 +75,22 @@ public:
 private:
 	static const int kMaxArchives = 8;
 
+	/** Maximum size of the unpacked archive members kept in memory. */
+	static const uint32 kMaxUnpackedSize = 2 * 1024 * 1024;
+
 	struct Archive;
 
+	/** The unpacked data of an archive member, shared by all its streams. */
+	struct Unpacked : public Common::MappedReadStream::Mapping {
+		byte *data;
+		int32 size;
+
+		Unpacked(byte *d, int32 s) : data(d), size(s) {}
+		~Unpacked() override { delete[] data; }
+	};
+
+	typedef Common::SharedPtr<Unpacked> UnpackedPtr;
+
 	struct File {
 		Common::String name;
 		uint32 size;
@@ -74,6 +99,8 @@ private:
 
 		Archive *archive;
 
+		UnpackedPtr unpacked;
+
 		File();
 		File(const Common::String &n, uint32 s, uint32 o, uint8 c, Archive &a);
 	};
@@ -91,6 +118,13 @@ private:
 
 	Common::Array<Archive *> _archives;
 
+	/** The archive members whose unpacked data is kept, most recently used first. */
+	Common::List<File *> _unpackedFiles;
+	uint32 _unpackedSize;
+
+	uint32 _unpackHits;
+	uint32 _unpackMisses;
+
 	Archive *openArchive(const Common::String &name);
 	bool closeArchive(Archive &archive);
 
@@ -99,6 +133,9 @@ private:
 	Common::SeekableReadStream *getFile(File &file);
 	byte *getFile(File &file, int32 &size);
 
+	UnpackedPtr getUnpacked(File &file);
+	void dropUnpacked(Archive &archive);
+
 	static byte *unpack(Common::SeekableReadStream &src, int32 &size, uint8 compression, bool useMalloc);
 
 	static uint32 getSizeChunks(Common::SeekableReadStream &src);
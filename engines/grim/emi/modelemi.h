@@ -55,7 +55,7 @@ class Skeleton;
 class EMIMeshFace {
 public:
 	Vector3int *_indexes;
-	uint32 _indicesEBO;
+	uint32 _indicesOffset;
 	uint32 _faceLength;
 	uint32 _numFaces;
 	uint32 _hasTexture;
@@ -69,7 +69,7 @@ public:
 		kUnknownBlend = 0x40000 // used only in intro screen actors
 	};
 
-	EMIMeshFace() : _faceLength(0), _numFaces(0), _hasTexture(0), _texID(0), _flags(0), _indexes(NULL), _parent(NULL), _indicesEBO(0) { }
+	EMIMeshFace() : _faceLength(0), _numFaces(0), _hasTexture(0), _texID(0), _flags(0), _indexes(NULL), _parent(NULL), _indicesOffset(0) { }
 	~EMIMeshFace();
 	void loadFace(Common::SeekableReadStream *data);
 	void setParent(EMIModel *m) { _parent = m; }
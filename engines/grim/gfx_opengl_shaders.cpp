@@ -120,8 +120,12 @@ struct EMIModelUserData {
 	OpenGL::ShaderGL *_shaderLights;
 	uint32 _texCoordsVBO;
 	uint32 _colorMapVBO;
-	uint32 _verticesVBO;
-	uint32 _normalsVBO;
+	// The skinned positions and normals, interleaved so that they are
+	// updated with a single upload per frame
+	uint32 _drawVBO;
+	Common::Array<float> _drawData;
+	// The indices of all the faces, each face knows where its own start
+	uint32 _indicesEBO;
 };
 
 struct ModelUserData {
@@ -928,12 +932,19 @@ void GfxOpenGLS::translateViewpointFinish() {
 	_matrixStack.pop();
 }
 
+static void interleaveEMIModel(float *dst, const Math::Vector3d *vertices, const Math::Vector3d *normals, int numVertices) {
+	for (int i = 0; i < numVertices; ++i) {
+		memcpy(dst, vertices[i].getData(), 3 * sizeof(float));
+		memcpy(dst + 3, normals[i].getData(), 3 * sizeof(float));
+		dst += 6;
+	}
+}
+
 void GfxOpenGLS::updateEMIModel(const EMIModel* model) {
-	const EMIModelUserData *mud = (const EMIModelUserData *)model->_userData;
-	glBindBuffer(GL_ARRAY_BUFFER, mud->_verticesVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, model->_numVertices * 3 * sizeof(float), model->_drawVertices);
-	glBindBuffer(GL_ARRAY_BUFFER, mud->_normalsVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, model->_numVertices * 3 * sizeof(float), model->_drawNormals);
+	EMIModelUserData *mud = (EMIModelUserData *)model->_userData;
+	interleaveEMIModel(mud->_drawData.data(), model->_drawVertices, model->_drawNormals, model->_numVertices);
+	glBindBuffer(GL_ARRAY_BUFFER, mud->_drawVBO);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, mud->_drawData.size() * sizeof(float), mud->_drawData.data());
 }
 
 void GfxOpenGLS::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face) {
@@ -953,9 +964,9 @@ void GfxOpenGLS::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face
 	actorShader->setUniform("useVertexAlpha", _selectedTexture->_colorFormat == BM_BGRA);
 	actorShader->setUniform1f("meshAlpha", (model->_meshAlphaMode == Actor::AlphaReplace) ? model->_meshAlpha : 1.0f);
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, face->_indicesEBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mud->_indicesEBO);
 
-	glDrawElements(GL_TRIANGLES, 3 * face->_faceLength, GL_UNSIGNED_SHORT, 0);
+	glDrawElements(GL_TRIANGLES, 3 * face->_faceLength, GL_UNSIGNED_SHORT, (void *)(uintptr)face->_indicesOffset);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
@@ -1994,52 +2005,55 @@ void GfxOpenGLS::renderZBitmaps(bool render) {
 void GfxOpenGLS::createEMIModel(EMIModel *model) {
 	EMIModelUserData *mud = new EMIModelUserData;
 	model->_userData = mud;
-	mud->_verticesVBO = OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 3 * sizeof(float), model->_vertices, GL_STREAM_DRAW);
-
-	mud->_normalsVBO = OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 3 * sizeof(float), model->_normals, GL_STREAM_DRAW);
+	mud->_drawData.resize(model->_numVertices * 6);
+	interleaveEMIModel(mud->_drawData.data(), model->_vertices, model->_normals, model->_numVertices);
+	mud->_drawVBO = OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, mud->_drawData.size() * sizeof(float), mud->_drawData.data(), GL_STREAM_DRAW);
 
 	mud->_texCoordsVBO = OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 2 * sizeof(float), model->_texVerts, GL_STATIC_DRAW);
 
 	mud->_colorMapVBO = OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, model->_numVertices * 4 * sizeof(byte), model->_colorMap, GL_STATIC_DRAW);
 
 	OpenGL::ShaderGL * actorShader = _actorProgram->clone();
-	actorShader->enableVertexAttribute("position", mud->_verticesVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
-	actorShader->enableVertexAttribute("normal", mud->_normalsVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("position", mud->_drawVBO, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("normal", mud->_drawVBO, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 3 * sizeof(float));
 	actorShader->enableVertexAttribute("texcoord", mud->_texCoordsVBO, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
 	actorShader->enableVertexAttribute("color", mud->_colorMapVBO, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof(byte), 0);
 	mud->_shader = actorShader;
 
 	actorShader = _actorLightsProgram->clone();
-	actorShader->enableVertexAttribute("position", mud->_verticesVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
-	actorShader->enableVertexAttribute("normal", mud->_normalsVBO, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("position", mud->_drawVBO, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 0);
+	actorShader->enableVertexAttribute("normal", mud->_drawVBO, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), 3 * sizeof(float));
 	actorShader->enableVertexAttribute("texcoord", mud->_texCoordsVBO, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
 	actorShader->enableVertexAttribute("color", mud->_colorMapVBO, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof(byte), 0);
 	mud->_shaderLights = actorShader;
 
+	uint32 numIndices = 0;
 	for (uint32 i = 0; i < model->_numFaces; ++i) {
-		EMIMeshFace * face = &model->_faces[i];
-		face->_indicesEBO = OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, face->_faceLength * 3 * sizeof(uint16), face->_indexes, GL_STATIC_DRAW);
+		EMIMeshFace *face = &model->_faces[i];
+		face->_indicesOffset = numIndices * sizeof(uint16);
+		numIndices += face->_faceLength * 3;
 	}
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
-
-void GfxOpenGLS::destroyEMIModel(EMIModel *model) {
+	mud->_indicesEBO = OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, numIndices * sizeof(uint16), nullptr, GL_STATIC_DRAW);
 	for (uint32 i = 0; i < model->_numFaces; ++i) {
 		EMIMeshFace *face = &model->_faces[i];
-		OpenGL::ShaderGL::freeBuffer(face->_indicesEBO);
-		face->_indicesEBO = 0;
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, face->_indicesOffset, face->_faceLength * 3 * sizeof(uint16), face->_indexes);
 	}
 
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void GfxOpenGLS::destroyEMIModel(EMIModel *model) {
 	EMIModelUserData *mud = static_cast<EMIModelUserData *>(model->_userData);
 
 	if (mud) {
-		OpenGL::ShaderGL::freeBuffer(mud->_verticesVBO);
-		OpenGL::ShaderGL::freeBuffer(mud->_normalsVBO);
+		OpenGL::ShaderGL::freeBuffer(mud->_drawVBO);
 		OpenGL::ShaderGL::freeBuffer(mud->_texCoordsVBO);
 		OpenGL::ShaderGL::freeBuffer(mud->_colorMapVBO);
+		OpenGL::ShaderGL::freeBuffer(mud->_indicesEBO);
 
 		delete mud->_shader;
+		delete mud->_shaderLights;
 		delete mud;
 	}
 
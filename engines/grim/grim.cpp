@@ -71,6 +71,7 @@
 #include "engines/grim/localize.h"
 #include "engines/grim/gfx_base.h"
 #include "engines/grim/bitmap.h"
+#include "engines/grim/material.h"
 #include "engines/grim/font.h"
 #include "engines/grim/primitives.h"
 #include "engines/grim/objectstate.h"
@@ -997,6 +998,8 @@ void GrimEngine::mainLoop() {
 			_savegameFileName = "";
 			savegameSave();
 			clearPools();
+			// The materials kept for later hold textures of the old renderer
+			MaterialData::flushUnused();
 
 			delete g_driver;
 			g_driver = createRenderer(screenWidth, screenHeight);
@@ -35,15 +35,15 @@ LabEntry::LabEntry(const Common::String &name, uint32 offset, uint32 len, Lab *p
 }
 
 Common::SeekableReadStream *LabEntry::createReadStream() const {
-	return _parent->createReadStreamForMember(_name);
+	return _parent->createReadStreamForEntry(*this);
 }
 
 Lab::Lab() {
-	_stream = nullptr;
+	_data = nullptr;
 }
 
 Lab::~Lab() {
-	delete _stream;
+	free(_data);
 }
 
 bool Lab::open(const Common::String &filename, bool keepStream) {
@@ -64,9 +64,8 @@ bool Lab::open(const Common::String &filename, bool keepStream) {
 	}
 	if (result && keepStream) {
 		file->seek(0, SEEK_SET);
-		byte *data = static_cast<byte*>(malloc(sizeof(byte) * file->size()));
-		file->read(data, file->size());
-		_stream = new Common::MemoryReadStream(data, file->size(), DisposeAfterUse::YES);
+		_data = static_cast<byte*>(malloc(sizeof(byte) * file->size()));
+		file->read(_data, file->size());
 	}
 	delete file;
 
@@ -147,9 +146,7 @@ void Lab::parseMonkey4FileTable(Common::File *file) {
 }
 
 bool Lab::hasFile(const Common::String &filename) const {
-	Common::String fname(filename);
-	fname.toLowercase();
-	return _entries.contains(fname);
+	return _entries.contains(filename);
 }
 
 int Lab::listMembers(Common::ArchiveMemberList &list) const {
@@ -163,32 +160,31 @@ int Lab::listMembers(Common::ArchiveMemberList &list) const {
 	return count;
 }
 
+// The entries are looked up ignoring the case, there is no need to lowercase the names
 const Common::ArchiveMemberPtr Lab::getMember(const Common::String &name) const {
-	if (!hasFile(name))
+	LabMap::const_iterator i = _entries.find(name);
+	if (i == _entries.end())
 		return Common::ArchiveMemberPtr();
 
-	Common::String fname(name);
-	fname.toLowercase();
-	return _entries[fname];
+	return i->_value;
 }
 
 Common::SeekableReadStream *Lab::createReadStreamForMember(const Common::String &filename) const {
-	if (!hasFile(filename))
+	LabMap::const_iterator i = _entries.find(filename);
+	if (i == _entries.end())
 		return nullptr;
 
-	Common::String fname(filename);
-	fname.toLowercase();
-	LabEntryPtr i = _entries[fname];
+	return createReadStreamForEntry(*i->_value);
+}
 
-	if (!_stream) {
+Common::SeekableReadStream *Lab::createReadStreamForEntry(const LabEntry &entry) const {
+	if (!_data) {
 		Common::File *file = new Common::File();
 		file->open(_labFileName);
-		return new Common::SeekableSubReadStream(file, i->_offset, i->_offset + i->_len, DisposeAfterUse::YES);
+		return new Common::SeekableSubReadStream(file, entry._offset, entry._offset + entry._len, DisposeAfterUse::YES);
 	} else {
-		byte *data = static_cast<byte*>(malloc(sizeof(byte) * i->_len));
-		_stream->seek(i->_offset, SEEK_SET);
-		_stream->read(data, i->_len);
-		return new Common::MemoryReadStream(data, i->_len, DisposeAfterUse::YES);
+		// The data stays with the lab, which outlives the streams of its members
+		return new Common::MemoryReadStream(_data + entry._offset, entry._len, DisposeAfterUse::NO);
 	}
 }
 
@@ -58,12 +58,15 @@ public:
 private:
 	void parseGrimFileTable(Common::File *_f);
 	void parseMonkey4FileTable(Common::File *_f);
+	Common::SeekableReadStream *createReadStreamForEntry(const LabEntry &entry) const;
+	friend class LabEntry;
 
 	Common::String _labFileName;
 	typedef Common::SharedPtr<LabEntry> LabEntryPtr;
 	typedef Common::HashMap<Common::String, LabEntryPtr, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> LabMap;
 	LabMap _entries;
-	Common::SeekableReadStream *_stream;
+	// The whole file, when it is kept in memory
+	byte *_data;
 };
 
 } // end of namespace Grim
@@ -36,6 +36,12 @@
 namespace Grim {
 
 Common::List<MaterialData *> *MaterialData::_materials = nullptr;
+Common::List<MaterialData *> *MaterialData::_unused = nullptr;
+uint32 MaterialData::_unusedSize = 0;
+
+enum {
+	kMaxUnusedTextureSize = 16 * 1024 * 1024
+};
 
 MaterialData::MaterialData(const Common::String &filename, Common::SeekableReadStream *data, CMap *cmap) :
 		_fname(filename), _cmap(cmap), _refCount(1), _textures(nullptr) {
@@ -234,12 +240,14 @@ MaterialData *MaterialData::getMaterialData(const Common::String &filename, Comm
 
 	for (Common::List<MaterialData *>::iterator i = _materials->begin(); i != _materials->end(); ++i) {
 		MaterialData *m = *i;
-		if (m->_fname == filename && g_grim->getGameType() == GType_MONKEY4) {
-			++m->_refCount;
-			return m;
-		}
+		if (m->_fname != filename)
+			continue;
 		// We need to allow null cmaps for remastered overlays
-		if (m->_fname == filename && (!(m->_cmap || cmap) || m->_cmap->getFilename() == cmap->getFilename())) {
+		if (g_grim->getGameType() == GType_MONKEY4 || !(m->_cmap || cmap) || m->_cmap->getFilename() == cmap->getFilename()) {
+			if (m->_refCount == 0) {
+				_unused->remove(m);
+				_unusedSize -= m->getTextureSize();
+			}
 			++m->_refCount;
 			return m;
 		}
@@ -250,6 +258,49 @@ MaterialData *MaterialData::getMaterialData(const Common::String &filename, Comm
 	return m;
 }
 
+void MaterialData::release(MaterialData *m) {
+	--m->_refCount;
+	if (m->_refCount > 0)
+		return;
+
+	if (!_unused)
+		_unused = new Common::List<MaterialData *>();
+	_unused->push_front(m);
+	_unusedSize += m->getTextureSize();
+
+	while (_unusedSize > kMaxUnusedTextureSize && !_unused->empty()) {
+		MaterialData *oldest = _unused->back();
+		_unused->pop_back();
+		_unusedSize -= oldest->getTextureSize();
+		delete oldest;
+	}
+}
+
+void MaterialData::flushUnused() {
+	if (!_unused)
+		return;
+
+	while (!_unused->empty()) {
+		MaterialData *m = _unused->front();
+		_unused->pop_front();
+		delete m;
+	}
+	_unusedSize = 0;
+
+	delete _unused;
+	_unused = nullptr;
+}
+
+uint32 MaterialData::getTextureSize() const {
+	uint32 size = 0;
+	for (int i = 0; i < _numImages; ++i) {
+		const Texture *t = _textures[i];
+		if (t && !t->_isShared)
+			size += t->_width * t->_height * t->_bpp;
+	}
+	return size;
+}
+
 Material::Material(const Common::String &filename, Common::SeekableReadStream *data, CMap *cmap, bool clamp) :
 		Object(), _currImage(0) {
 	_data = MaterialData::getMaterialData(filename, data, cmap);
@@ -262,10 +313,7 @@ Material::Material() :
 
 void Material::reload(CMap *cmap) {
 	Common::String fname = _data->_fname;
-	--_data->_refCount;
-	if (_data->_refCount < 1) {
-		delete _data;
-	}
+	MaterialData::release(_data);
 
 	Material *m = g_resourceloader->loadMaterial(fname, cmap, _clampTexture);
 	// Steal the data from the new material and discard it.
@@ -290,10 +338,7 @@ void Material::select() const {
 
 Material::~Material() {
 	if (_data) {
-		--_data->_refCount;
-		if (_data->_refCount < 1) {
-			delete _data;
-		}
+		MaterialData::release(_data);
 	}
 }
 
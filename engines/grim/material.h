@@ -49,6 +49,8 @@ public:
 	~MaterialData();
 
 	static MaterialData *getMaterialData(const Common::String &filename, Common::SeekableReadStream *data, CMap *cmap);
+	static void release(MaterialData *m);
+	static void flushUnused();
 	static Common::List<MaterialData *> *_materials;
 
 	Common::String _fname;
@@ -60,6 +62,12 @@ public:
 private:
 	void initGrim(Common::SeekableReadStream *data);
 	void initEMI(Common::SeekableReadStream *data);
+	uint32 getTextureSize() const;
+
+	// The materials no longer used, most recently released first. They are
+	// kept while they fit in the budget, as the next set often uses them again.
+	static Common::List<MaterialData *> *_unused;
+	static uint32 _unusedSize;
 };
 
 class Material : public Object {
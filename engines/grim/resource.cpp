@@ -234,6 +234,7 @@ ResourceLoader::~ResourceLoader() {
 		delete[] r.fname;
 		delete[] r.resPtr;
 	}
+	MaterialData::flushUnused();
 	clearList(_models);
 	clearList(_colormaps);
 	clearList(_keyframeAnims);
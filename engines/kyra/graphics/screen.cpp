@@ -80,6 +80,8 @@ Screen::Screen(KyraEngine_v1 *vm, OSystem *system, const ScreenDim *dimTable, co
 	_curDim = 0;
 
 	_yTransOffs = 0;
+
+	_decodedShapesUse = 0;
 }
 
 Screen::~Screen() {
@@ -1674,6 +1676,17 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	if (flags & 0x800)
 		dsPlot3 = dsPlotFunc[((flags >> 8) & 0xF7) & 0x3F];
 
+	// The plain and the remapped unscaled shapes don't need a call for each pixel
+	if (!(drawFunc & 4) && dsPlot2 == dsPlot3 && (ppc == 0 || ppc == 4)) {
+		static const DsLineFunc dsLineRunsFunc[] = {
+			&Screen::drawShapeProcessLineNoScaleRuns<true, false>,
+			&Screen::drawShapeProcessLineNoScaleRuns<false, false>,
+			&Screen::drawShapeProcessLineNoScaleRuns<true, true>,
+			&Screen::drawShapeProcessLineNoScaleRuns<false, true>
+		};
+		_dsProcessLine = dsLineRunsFunc[(drawFunc & 1) | (ppc == 4 ? 2 : 0)];
+	}
+
 	if (!_dsPlot || !dsPlot2 || !dsPlot3) {
 		if (!dsPlot2)
 			warning("Missing drawShape plotting method type %d", ppc);
@@ -1733,8 +1746,12 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		src += colorTableColors;
 
 	if (!(shapeFlags & 2)) {
-		decodeFrame4(src, _animBlockPtr, frameSize);
-		src = _animBlockPtr;
+		if (frameSize) {
+			src = getDecodedShape(src, frameSize);
+		} else {
+			decodeFrame4(src, _animBlockPtr, frameSize);
+			src = _animBlockPtr;
+		}
 	}
 
 	int t = (flags & 2) ? y2 - y - shapeHeight : y - y1;
@@ -2019,6 +2036,39 @@ void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src,
 	} while (cnt > 0);
 }
 
+template<bool upwind, bool colorTable>
+void Screen::drawShapeProcessLineNoScaleRuns(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
+	do {
+		if (*src) {
+			int run = 1;
+			while (run < cnt && src[run])
+				++run;
+
+			if (upwind) {
+				if (colorTable) {
+					for (int i = 0; i < run; ++i)
+						dst[i] = _dsColorTable[src[i]];
+				} else {
+					memcpy(dst, src, run);
+				}
+				dst += run;
+			} else {
+				for (int i = 0; i < run; ++i)
+					dst[-i] = colorTable ? _dsColorTable[src[i]] : src[i];
+				dst -= run;
+			}
+
+			src += run;
+			cnt -= run;
+		} else {
+			uint8 c = src[1];
+			src += 2;
+			dst += upwind ? c : -c;
+			cnt -= c;
+		}
+	} while (cnt > 0);
+}
+
 void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -2378,7 +2428,37 @@ void Screen::decodeFrame3(const uint8 *src, uint8 *dst, uint32 size, bool isAmig
 	}
 }
 
-uint Screen::decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize) {
+const uint8 *Screen::getDecodedShape(const uint8 *src, uint16 frameSize) {
+	// The compressed data is compared too, as the memory of a freed shape can be reused
+	DecodedShape *shape = 0;
+	for (uint i = 0; i < _decodedShapes.size(); ++i) {
+		DecodedShape &cur = _decodedShapes[i];
+		if (cur.src == src && cur.pixels.size() == frameSize && !memcmp(src, cur.compressed.begin(), cur.compressed.size())) {
+			cur.lastUse = ++_decodedShapesUse;
+			return cur.pixels.begin();
+		}
+
+		if (!shape || cur.lastUse < shape->lastUse)
+			shape = &cur;
+	}
+
+	if (_decodedShapes.size() < kDecodedShapesNum) {
+		_decodedShapes.push_back(DecodedShape());
+		shape = &_decodedShapes.back();
+	}
+
+	uint32 srcSize = 0;
+	shape->pixels.resize(frameSize);
+	decodeFrame4(src, shape->pixels.begin(), frameSize, &srcSize);
+	shape->compressed.resize(srcSize);
+	memcpy(shape->compressed.begin(), src, srcSize);
+	shape->src = src;
+	shape->lastUse = ++_decodedShapesUse;
+	return shape->pixels.begin();
+}
+
+uint Screen::decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize, uint32 *srcSize) {
+	const uint8 *srcOrig = src;
 	uint8 *dstOrig = dst;
 	uint8 *dstEnd = dst + dstSize;
 	while (1) {
@@ -2424,6 +2504,8 @@ uint Screen::decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize) {
 			break;
 		}
 	}
+	if (srcSize)
+		*srcSize = src - srcOrig;
 	return dst - dstOrig;
 }
 
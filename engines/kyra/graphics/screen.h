@@ -580,7 +580,7 @@ public:
 	static uint16 decodeEGAGetCode(const uint8 *&pos, uint8 &nib);
 
 	static void decodeFrame3(const uint8 *src, uint8 *dst, uint32 size, bool isAmiga);
-	static uint decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize);
+	static uint decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize, uint32 *srcSize = 0);
 	static void decodeFrameDelta(uint8 *dst, const uint8 *src, bool noXor = false);
 	static void decodeFrameDeltaPage(uint8 *dst, const uint8 *src, const int pitch, bool noXor);
 
@@ -711,6 +711,9 @@ protected:
 	void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 	void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 	void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	// Unscaled lines plotted with drawShapePlotType0 or drawShapePlotType4, a run of pixels at a time
+	template<bool upwind, bool colorTable>
+	void drawShapeProcessLineNoScaleRuns(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 
 	void drawShapePlotType0(uint8 *dst, uint8 cmd);
 	void drawShapePlotType1(uint8 *dst, uint8 cmd);
@@ -761,6 +764,23 @@ protected:
 	int _drawShapeVar4;
 	int _drawShapeVar5;
 
+	// The last few compressed shapes drawn, decoded
+	struct DecodedShape {
+		const uint8 *src;
+		Common::Array<uint8> compressed;
+		Common::Array<uint8> pixels;
+		uint32 lastUse;
+	};
+
+	enum {
+		kDecodedShapesNum = 32
+	};
+
+	Common::Array<DecodedShape> _decodedShapes;
+	uint32 _decodedShapesUse;
+
+	const uint8 *getDecodedShape(const uint8 *src, uint16 frameSize);
+
 	// AMIGA version
 	int _dualPaletteModeSplitY;
 
@@ -26,6 +26,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -264,6 +265,38 @@ WARN_UNUSED_RESULT bool MetaEngine::readSavegameHeader(Common::InSaveFile *in, E
 // MetaEngine default implementations
 //////////////////////////////////////////////
 
+enum {
+	kSaveIndexEntryVersion = 1
+};
+
+// The index entry of a save holds what listSaves shows of it
+static Common::Array<byte> createSaveIndexEntry(const ExtendedSavegameHeader &header) {
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	out.writeByte(kSaveIndexEntryVersion);
+	out.writeUint32LE(header.date);
+	out.writeUint16LE(header.time);
+	out.writeUint32LE(header.playtime);
+	out.writeUint16LE(header.description.size());
+	out.writeString(header.description);
+	return Common::Array<byte>(out.getData(), out.size());
+}
+
+static bool parseSaveIndexEntry(const Common::Array<byte> &data, ExtendedSavegameHeader *header) {
+	Common::MemoryReadStream in(data.begin(), data.size());
+	if (in.readByte() != kSaveIndexEntryVersion)
+		return false;
+
+	header->date = in.readUint32LE();
+	header->time = in.readUint16LE();
+	header->playtime = in.readUint32LE();
+	const uint16 size = in.readUint16LE();
+	header->description.clear();
+	for (uint16 i = 0; i < size; ++i)
+		header->description += (char)in.readByte();
+
+	return !in.eos() && !in.err();
+}
+
 SaveStateList MetaEngine::listSaves(const char *target) const {
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateList();
@@ -280,25 +313,30 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(file->c_str() + file->size() - 2);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			Common::ScopedPtr<Common::InSaveFile> in(saveFileMan->openForLoading(*file));
-			if (in) {
-				ExtendedSavegameHeader header;
-				if (!readSavegameHeader(in.get(), &header)) {
+			// Use the index of the saves, and only open the saves not in it
+			ExtendedSavegameHeader header;
+			Common::Array<byte> indexEntry;
+			if (!saveFileMan->readIndexEntry(*file, indexEntry) || !parseSaveIndexEntry(indexEntry, &header)) {
+				Common::ScopedPtr<Common::InSaveFile> in(saveFileMan->openForLoading(*file));
+				if (!in || !readSavegameHeader(in.get(), &header)) {
 					continue;
 				}
 
-				SaveStateDescriptor desc;
+				saveFileMan->writeIndexEntry(*file, createSaveIndexEntry(header));
+			}
 
-				parseSavegameHeader(&header, &desc);
+			SaveStateDescriptor desc;
 
-				desc.setSaveSlot(slotNum);
-				if (slotNum == getAutosaveSlot())
-					desc.setWriteProtectedFlag(true);
+			parseSavegameHeader(&header, &desc);
 
-				saveList.push_back(desc);
-			}
+			desc.setSaveSlot(slotNum);
+			if (slotNum == getAutosaveSlot())
+				desc.setWriteProtectedFlag(true);
+
+			saveList.push_back(desc);
 		}
 	}
+	saveFileMan->flushIndex();
 
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
@@ -144,6 +144,19 @@ public:
 	 */
 	virtual DetectedGames detectGames(const Common::FSList &fslist) const = 0;
 
+	/**
+	 * Return whether detectGames() may run on several threads at the same time.
+	 *
+	 * This requires the detector to only access files through the given nodes,
+	 * and to leave all global and static state (SearchMan, ConfMan, the plugin
+	 * manager...) untouched. Mass Add runs such detectors on worker threads.
+	 *
+	 * The default implementation returns false.
+	 */
+	virtual bool isDetectionThreadSafe() const {
+		return false;
+	}
+
 	/**
 	 * Return a list of extra GUI options for the specified target.
 	 *
@@ -517,6 +530,18 @@ public:
 	 */
 	DetectionResults detectGames(const Common::FSList &fslist) const;
 
+	/**
+	 * Run only the detectors whose MetaEngineDetection::isDetectionThreadSafe()
+	 * matches @p threadSafe on the given list of FSNodes.
+	 *
+	 * Unlike detectGames(), this does not write the detection cache to disk, so
+	 * that the thread-safe pass can run on worker threads. The other pass must
+	 * run on the main thread while no thread-safe pass is running. On worker
+	 * threads, the messages of the detectors have to be deferred with an
+	 * ADPiratedReportDeferrer.
+	 */
+	DetectedGames detectGamesPass(const Common::FSList &fslist, bool threadSafe) const;
+
 	/** Find a plugin by its engine ID. */
 	const Plugin *findPlugin(const Common::String &engineId) const;
 
@@ -560,6 +585,9 @@ private:
 
 	/** Use heuristics to complete a target lacking an engine ID. */
 	void upgradeTargetForEngineId(const Common::String &target) const;
+
+	/** Run the detector of a single plugin and append its results to @p candidates. */
+	void detectGamesWithPlugin(const Plugin &plugin, const Common::FSList &fslist, DetectedGames &candidates) const;
 };
 
 /** Convenience shortcut for accessing the engine manager. */
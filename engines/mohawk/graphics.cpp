@@ -30,6 +30,9 @@
 
 namespace Mohawk {
 
+// Size of the decoded images kept across releaseCache() calls
+static const uint32 kImageCacheBudget = 16 * 1024 * 1024;
+
 MohawkSurface::MohawkSurface() : _surface(nullptr), _palette(nullptr) {
 	_offsetX = 0;
 	_offsetY = 0;
@@ -68,7 +71,7 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() : _cacheSize(0), _cacheUseCounter(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -76,8 +79,8 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		delete it->_value.surface;
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface *> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
@@ -86,18 +89,78 @@ void GraphicsManager::clearCache() {
 
 	_cache.clear();
 	_subImageCache.clear();
+	_cacheSize = 0;
+	_prefetchQueue.clear();
+}
+
+void GraphicsManager::releaseCache() {
+	Common::Array<uint16> evicted;
+	for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+		if (it->_value.modified)
+			evicted.push_back(it->_key);
+
+	for (uint i = 0; i < evicted.size(); i++) {
+		_cacheSize -= _cache[evicted[i]].size;
+		delete _cache[evicted[i]].surface;
+		_cache.erase(evicted[i]);
+	}
+
+	while (_cacheSize > kImageCacheBudget) {
+		Common::HashMap<uint16, CachedImage>::iterator oldest = _cache.begin();
+		for (Common::HashMap<uint16, CachedImage>::iterator it = _cache.begin(); it != _cache.end(); it++)
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+
+		_cacheSize -= oldest->_value.size;
+		delete oldest->_value.surface;
+		_cache.erase(oldest);
+	}
+}
+
+void GraphicsManager::cacheImage(uint16 id, MohawkSurface *surface, bool modified) {
+	CachedImage &image = _cache[id];
+	image.surface = surface;
+	image.size = surface->getSurface()->pitch * surface->getSurface()->h;
+	image.lastUse = ++_cacheUseCounter;
+	image.modified = modified;
+	_cacheSize += image.size;
 }
 
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
+	Common::HashMap<uint16, CachedImage>::iterator it = _cache.find(id);
+	if (it != _cache.end()) {
+		it->_value.lastUse = ++_cacheUseCounter;
+		return it->_value.surface;
+	}
+
+	MohawkSurface *surface = decodeImage(id);
+	cacheImage(id, surface, false);
+	return surface;
+}
+
+void GraphicsManager::queuePrefetch(uint16 id) {
 	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+		_prefetchQueue.push_back(id);
+}
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+void GraphicsManager::clearPrefetchQueue() {
+	_prefetchQueue.clear();
+}
+
+bool GraphicsManager::prefetchImage() {
+	while (!_prefetchQueue.empty() && _cacheSize < kImageCacheBudget) {
+		uint16 id = _prefetchQueue.remove_at(0);
+		if (_cache.contains(id))
+			continue;
+
+		// Prefetched images are the first to go if they are not used
+		MohawkSurface *surface = decodeImage(id);
+		cacheImage(id, surface, false);
+		_cache[id].lastUse = 0;
+		return true;
+	}
 
-	return _cache[id];
+	return false;
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -227,7 +290,13 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	cacheImage(id, surface, true);
+}
+
+void GraphicsManager::setImageModified(uint16 id) {
+	Common::HashMap<uint16, CachedImage>::iterator it = _cache.find(id);
+	if (it != _cache.end())
+		it->_value.modified = true;
 }
 
 } // End of namespace Mohawk
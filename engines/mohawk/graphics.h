@@ -74,10 +74,23 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Done with the images in use, for instance when changing card.
+	// The least recently used ones are freed to bring the cache back
+	// within its budget, the others may be used again without decoding.
+	void releaseCache();
+
 	// findImage will search the cache to find the image.
 	// If not found, it will call decodeImage to get a new one.
 	MohawkSurface *findImage(uint16 id);
 
+	// Queue an image to be decoded ahead of being needed
+	void queuePrefetch(uint16 id);
+	void clearPrefetchQueue();
+
+	// Decode the next queued image if the cache has room for it.
+	// Returns false when there is nothing left to do.
+	bool prefetchImage();
+
 	void preloadImage(uint16 image);
 	virtual void setPalette(uint16 id);
 	void copyAnimImageToScreen(uint16 image, int left = 0, int top = 0);
@@ -96,9 +109,27 @@ protected:
 	virtual MohawkEngine *getVM() = 0;
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
+	// The image was drawn on, don't keep it past releaseCache()
+	void setImageModified(uint16 id);
+
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface *> _cache;
+	struct CachedImage {
+		MohawkSurface *surface;
+		uint32 size;
+		uint32 lastUse;
+		bool modified;
+
+		CachedImage() : surface(nullptr), size(0), lastUse(0), modified(false) {}
+	};
+
+	void cacheImage(uint16 id, MohawkSurface *surface, bool modified);
+
+	// An image cache that stores images until clearCache() is called,
+	// or they are evicted by releaseCache()
+	Common::HashMap<uint16, CachedImage> _cache;
+	uint32 _cacheSize;
+	uint32 _cacheUseCounter;
+	Common::Array<uint16> _prefetchQueue;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
@@ -932,9 +932,10 @@ void MohawkEngine_Myst::changeToCard(uint16 card, TransitionType transition) {
 
 	_video->stopVideos();
 
-	// Clear the resource cache and image cache
+	// Clear the resource cache, and let go of the images of the previous
+	// card. The ones it shares with the new card are kept decoded.
 	_cache.clear();
-	_gfx->clearCache();
+	_gfx->releaseCache();
 
 	_mouseClicked = false;
 	_mouseMoved = false;
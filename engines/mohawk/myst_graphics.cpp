@@ -872,6 +872,7 @@ void MystGraphics::drawText(uint16 image, const Common::U32String &text, const C
 
 	const Graphics::Font *font = getMenuFont();
 	font->drawString(surface, text, dest.left, dest.top + deltaY, dest.width(), surface->format.RGBToColor(r, g, b), align);
+	setImageModified(image);
 }
 
 Common::Rect MystGraphics::getTextBoundingBox(const Common::U32String &text, const Common::Rect &dest, Graphics::TextAlign align) {
@@ -234,6 +234,11 @@ void MohawkEngine_Riven::doFrame() {
 
 	// Update the screen once per frame
 	_system->updateScreen();
+
+	// Use the rest of the frame to decode the images of the next cards
+	while (_system->getMillis() - loopStart < 10 && _gfx->prefetchImage())
+		;
+
 	uint32 loopElapsed = _system->getMillis() - loopStart;
 
 	// Cut down on CPU usage
@@ -610,9 +615,10 @@ static const RivenSpecialChange rivenSpecialChange[] = {
 void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	debug (1, "Changing to card %d", dest);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	// Let go of the images of the previous card. They stay decoded
+	// as long as the cache has room for them, for coming back.
+	_gfx->releaseCache();
+	_gfx->clearPrefetchQueue();
 
 	if (!isGameVariant(GF_DEMO)) {
 		for (byte i = 0; i < ARRAYSIZE(rivenSpecialChange); i++)
@@ -633,6 +639,10 @@ void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	_card = new RivenCard(this, dest);
 	_card->enter(true);
 
+	// Decode the images of the cards the player can go to next
+	// while waiting for input
+	_card->prefetchNextCards();
+
 	// Now we need to redraw the cursor if necessary and handle mouse over scripts
 	_stack->queueMouseCursorRefresh();
 
@@ -716,6 +716,35 @@ void RivenCard::loadCardPictureList(uint16 id) {
 	delete plst;
 }
 
+void RivenCard::prefetchNextCards() const {
+	Common::Array<uint16> cards;
+	for (uint i = 0; i < _hotspots.size(); i++) {
+		if (_hotspots[i]->isEnabled()) {
+			_hotspots[i]->findCardChanges(cards);
+		}
+	}
+
+	for (uint i = 0; i < cards.size(); i++) {
+		if (cards[i] == _id || !_vm->hasResource(ID_PLST, cards[i])) {
+			continue;
+		}
+
+		Common::SeekableReadStream *plst = _vm->getResource(ID_PLST, cards[i]);
+		uint16 recordCount = plst->readUint16BE();
+		for (uint16 j = 0; j < recordCount; j++) {
+			uint16 index = plst->readUint16BE();
+			uint16 pictureId = plst->readUint16BE();
+			plst->skip(8); // rect
+
+			// The first picture is the one drawn by default when entering the card
+			if (index == 1 && _vm->hasResource(ID_TBMP, pictureId)) {
+				_vm->_gfx->queuePrefetch(pictureId);
+			}
+		}
+		delete plst;
+	}
+}
+
 void RivenCard::drawPicture(uint16 index, bool queue) {
 	if (index > 0 && index <= _pictureList.size()) {
 		RivenScriptPtr script = _vm->_scriptMan->createScriptFromData(1, kRivenCommandActivatePLST, 1, index);
@@ -1340,6 +1369,12 @@ void RivenHotspot::applyScriptPatches(uint32 cardGlobalId) {
 	}
 }
 
+void RivenHotspot::findCardChanges(Common::Array<uint16> &cards) const {
+	for (uint16 i = 0; i < _scripts.size(); i++) {
+		_scripts[i].script->findCardChanges(cards);
+	}
+}
+
 bool RivenHotspot::isEnabled() const {
 	return (_flags & kFlagEnabled) != 0;
 }
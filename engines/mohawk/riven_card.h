@@ -143,6 +143,9 @@ public:
 	/** Write all of the card's data to standard output */
 	void dump() const;
 
+	/** Queue the pictures of the cards the hotspots lead to for decoding ahead of time */
+	void prefetchNextCards() const;
+
 private:
 	void loadCardResource(uint16 id);
 	void loadHotspots(uint16 id);
@@ -274,6 +277,9 @@ public:
 	/** Apply patches to the hotspot's scripts to fix bugs in the original game scripts */
 	void applyScriptPatches(uint32 cardGlobalId);
 
+	/** Add the cards the hotspot's scripts can change to to the list */
+	void findCardChanges(Common::Array<uint16> &cards) const;
+
 	/** Apply patches to the hotspot's properties to fix bugs in the original game scripts */
 	void applyPropertiesPatches(uint32 cardGlobalId);
 
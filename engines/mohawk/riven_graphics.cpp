@@ -282,24 +282,33 @@ public:
 			Graphics::Surface *screen = _system->lockScreen();
 
 			uint alpha = elapsed * 255 / _duration;
+
+			// Each output channel only depends on the two input ones, so blend
+			// all their combinations once for the frame instead of every pixel
+			uint8 blend5[32][32], blend6[64][64];
+			for (uint c1 = 0; c1 < 32; c1++) {
+				for (uint c2 = 0; c2 < 32; c2++) {
+					uint c = ((c1 << 3) * alpha + (c2 << 3) * (255 - alpha)) / 255;
+					blend5[c1][c2] = c >> 3;
+				}
+			}
+			for (uint c1 = 0; c1 < 64; c1++) {
+				for (uint c2 = 0; c2 < 64; c2++) {
+					uint c = ((c1 << 2) * alpha + (c2 << 2) * (255 - alpha)) / 255;
+					blend6[c1][c2] = c >> 2;
+				}
+			}
+
 			for (uint y = 0; y < _mainScreen->h; y++) {
 				uint16 *src1 = (uint16 *) _mainScreen->getBasePtr(0, y);
 				uint16 *src2 = (uint16 *) _effectScreen->getBasePtr(0, y);
 				uint16 *dst = (uint16 *) screen->getBasePtr(0, y);
 				for (uint x = 0; x < _mainScreen->w; x++) {
-					uint8 r1, g1, b1, r2, g2, b2;
-					Graphics::colorToRGB< Graphics::ColorMasks<565> >(*src1++, r1, g1, b1);
-					Graphics::colorToRGB< Graphics::ColorMasks<565> >(*src2++, r2, g2, b2);
-
-					uint r = r1 * alpha + r2 * (255 - alpha);
-					uint g = g1 * alpha + g2 * (255 - alpha);
-					uint b = b1 * alpha + b2 * (255 - alpha);
-
-					r /= 255;
-					g /= 255;
-					b /= 255;
-
-					*dst++ = (uint16) Graphics::RGBToColor< Graphics::ColorMasks<565> >(r, g, b);
+					uint16 p1 = *src1++;
+					uint16 p2 = *src2++;
+					*dst++ = (blend5[p1 >> 11][p2 >> 11] << 11)
+					       | (blend6[(p1 >> 5) & 0x3F][(p2 >> 5) & 0x3F] << 5)
+					       | blend5[p1 & 0x1F][p2 & 0x1F];
 				}
 			}
 
@@ -372,11 +381,13 @@ void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uin
 	beginScreenUpdate();
 
 	// Clip the width to fit on the screen. Fixes some images.
-	if (left + surface->w > 608)
-		surface->w = 608 - left;
+	// The cached image is left as it is, it may be drawn elsewhere later.
+	uint16 width = surface->w;
+	if (left + width > 608)
+		width = 608 - left;
 
 	for (uint16 i = 0; i < surface->h; i++)
-		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), surface->w * surface->format.bytesPerPixel);
+		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), width * surface->format.bytesPerPixel);
 
 	_dirtyScreen = true;
 	applyScreenUpdate();
@@ -437,11 +448,27 @@ WaterEffect::WaterEffect(MohawkEngine_Riven *vm, uint16 sfxeID) :
 	for (uint16 i = 0; i < frameCount; i++)
 		frameOffsets[i] = sfxeStream->readUint32BE();
 
-	// Read in the scripts
-	sfxeStream->seek(frameOffsets[0]);
+	// Run the scripts once, and keep the pixel copies they make
+	_frames.resize(frameCount);
 	for (uint16 i = 0; i < frameCount; i++) {
-		uint scriptLength = (i == frameCount - 1) ? sfxeStream->size() - frameOffsets[i] : frameOffsets[i + 1] - frameOffsets[i];
-		_frameScripts.push_back(sfxeStream->readStream(scriptLength));
+		sfxeStream->seek(frameOffsets[i]);
+
+		uint16 curRow = 0;
+		for (uint16 op = sfxeStream->readUint16BE(); op != 4; op = sfxeStream->readUint16BE()) {
+			if (op == 1) {        // Increment Row
+				curRow++;
+			} else if (op == 3) { // Copy Pixels
+				PixelCopy copy;
+				copy.dstLeft = sfxeStream->readUint16BE();
+				copy.dstTop = curRow + _rect.top;
+				copy.srcLeft = sfxeStream->readUint16BE();
+				copy.srcTop = sfxeStream->readUint16BE();
+				copy.width = sfxeStream->readUint16BE();
+				_frames[i].push_back(copy);
+			} else if (op != 4) { // End of Script
+				error ("Unknown SFXE opcode %d", op);
+			}
+		}
 	}
 
 	// Set it to the first frame
@@ -456,39 +483,22 @@ void WaterEffect::update() {
 		return; // Nothing to do yet
 	}
 
-	// Make sure the script is at the starting point
-	Common::SeekableReadStream *script = _frameScripts[_curFrame];
-	script->seek(0);
-
 	Graphics::Surface *screen = _vm->_system->lockScreen();
 	Graphics::Surface *mainScreen = _vm->_gfx->getBackScreen();
 	assert(screen->format == mainScreen->format);
 
-	// Run script
-	uint16 curRow = 0;
-	for (uint16 op = script->readUint16BE(); op != 4; op = script->readUint16BE()) {
-		if (op == 1) {        // Increment Row
-			curRow++;
-		} else if (op == 3) { // Copy Pixels
-			uint16 dstLeft = script->readUint16BE();
-			uint16 srcLeft = script->readUint16BE();
-			uint16 srcTop = script->readUint16BE();
-			uint16 rowWidth = script->readUint16BE();
-
-			byte *src = (byte *)mainScreen->getBasePtr(srcLeft, srcTop);
-			byte *dst = (byte *)screen->getBasePtr(dstLeft, curRow + _rect.top);
-
-			memcpy(dst, src, rowWidth * screen->format.bytesPerPixel);
-		} else if (op != 4) { // End of Script
-			error ("Unknown SFXE opcode %d", op);
-		}
+	const Common::Array<PixelCopy> &frame = _frames[_curFrame];
+	for (uint i = 0; i < frame.size(); i++) {
+		const PixelCopy &copy = frame[i];
+		memcpy(screen->getBasePtr(copy.dstLeft, copy.dstTop), mainScreen->getBasePtr(copy.srcLeft, copy.srcTop),
+		       copy.width * screen->format.bytesPerPixel);
 	}
 
 	_vm->_system->unlockScreen();
 
 	// Increment frame
 	_curFrame++;
-	if (_curFrame == _frameScripts.size())
+	if (_curFrame == _frames.size())
 		_curFrame = 0;
 
 	// Set the new time
@@ -496,9 +506,6 @@ void WaterEffect::update() {
 }
 
 WaterEffect::~WaterEffect() {
-	for (uint i = 0; i < _frameScripts.size(); i++) {
-		delete _frameScripts[i];
-	}
 }
 
 void RivenGraphics::setTransitionMode(RivenTransitionMode mode) {
@@ -1179,9 +1186,13 @@ void FliesEffect::draw() {
 						hoveringBrightBackground = true;
 					}
 				}
-				colorBlending(color, r, g, b, fly.alphaMap[fly.width * y + x] - fly.posZ);
 
-				*pixel = format.RGBToColor(r, g, b);
+				// Most of the alpha map leaves the background as it is
+				int alpha = fly.alphaMap[fly.width * y + x] - fly.posZ;
+				if (alpha > 0) {
+					colorBlending(color, r, g, b, alpha);
+					*pixel = format.RGBToColor(r, g, b);
+				}
 				++pixel;
 			}
 		}
@@ -1195,12 +1206,13 @@ void FliesEffect::draw() {
 			for (uint y = 0; y < fly.blurHeight; y++) {
 				uint16 *pixel = (uint16 *) _effectSurface->getBasePtr(fly.blurPosX, fly.blurPosY + y);
 				for (uint x = 0; x < fly.blurWidth; x++) {
-					byte r, g, b;
-					format.colorToRGB(*pixel, r, g, b);
-
-					colorBlending(color, r, g, b, fly.blurAlphaMap[fly.blurWidth * y + x] - fly.posZ);
-
-					*pixel = format.RGBToColor(r, g, b);
+					int alpha = fly.blurAlphaMap[fly.blurWidth * y + x] - fly.posZ;
+					if (alpha > 0) {
+						byte r, g, b;
+						format.colorToRGB(*pixel, r, g, b);
+						colorBlending(color, r, g, b, alpha);
+						*pixel = format.RGBToColor(r, g, b);
+					}
 					++pixel;
 				}
 			}
@@ -161,10 +161,19 @@ public:
 private:
 	MohawkEngine_Riven *_vm;
 
+	// A row of pixels copied from the main screen
+	struct PixelCopy {
+		uint16 dstLeft;
+		uint16 dstTop;
+		uint16 srcLeft;
+		uint16 srcTop;
+		uint16 width;
+	};
+
 	// Record values
 	Common::Rect _rect;
 	uint16 _speed;
-	Common::Array<Common::SeekableReadStream *> _frameScripts;
+	Common::Array<Common::Array<PixelCopy> > _frames;
 
 	// Cur frame
 	uint16 _curFrame;
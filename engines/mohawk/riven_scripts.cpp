@@ -385,6 +385,12 @@ void RivenScript::applyCardPatches(MohawkEngine_Riven *vm, uint32 cardGlobalId,
 	}
 }
 
+void RivenScript::findCardChanges(Common::Array<uint16> &cards) const {
+	for (uint i = 0; i < _commands.size(); i++) {
+		_commands[i]->findCardChanges(cards);
+	}
+}
+
 RivenScriptPtr &operator+=(RivenScriptPtr &lhs, const RivenScriptPtr &rhs) {
 	if (rhs) {
 		*lhs += *rhs;
@@ -831,6 +837,12 @@ RivenCommandType RivenSimpleCommand::getType() const {
 	return _type;
 }
 
+void RivenSimpleCommand::findCardChanges(Common::Array<uint16> &cards) const {
+	if (_type == kRivenCommandChangeCard) {
+		cards.push_back(_arguments[0]);
+	}
+}
+
 RivenSwitchCommand::RivenSwitchCommand(MohawkEngine_Riven *vm) :
 		RivenCommand(vm),
 		_variableId(0) {
@@ -918,6 +930,12 @@ void RivenSwitchCommand::applyCardPatches(uint32 globalId, int scriptType, uint1
 	}
 }
 
+void RivenSwitchCommand::findCardChanges(Common::Array<uint16> &cards) const {
+	for (uint i = 0; i < _branches.size(); i++) {
+		_branches[i].script->findCardChanges(cards);
+	}
+}
+
 RivenStackChangeCommand::RivenStackChangeCommand(MohawkEngine_Riven *vm, uint16 stackId, uint32 globalCardId,
                                                  bool byStackId, bool byStackCardId) :
 		RivenCommand(vm),
@@ -131,6 +131,9 @@ public:
 	/** Apply patches to card script to fix bugs in the original game scripts */
 	void applyCardPatches(MohawkEngine_Riven *vm, uint32 cardGlobalId, uint16 scriptType, uint16 hotspotId);
 
+	/** Add the cards the script can change to to the list */
+	void findCardChanges(Common::Array<uint16> &cards) const;
+
 	/** Append the commands of the other script to this script */
 	RivenScript &operator+=(const RivenScript &other);
 
@@ -267,6 +270,9 @@ public:
 	/** Apply card patches for the command's sub-scripts */
 	virtual void applyCardPatches(uint32 globalId, int scriptType, uint16 hotspotId) {}
 
+	/** Add the cards the command and its sub-scripts can change to to the list */
+	virtual void findCardChanges(Common::Array<uint16> &cards) const {}
+
 protected:
 	MohawkEngine_Riven *_vm;
 };
@@ -291,6 +297,7 @@ public:
 	void dump(byte tabs) override;
 	void execute() override;
 	RivenCommandType getType() const override;
+	void findCardChanges(Common::Array<uint16> &cards) const override;
 
 private:
 	typedef void (RivenSimpleCommand::*OpcodeProcRiven)(uint16 op, const ArgumentArray &args);
@@ -365,6 +372,7 @@ public:
 	void execute() override;
 	RivenCommandType getType() const override;
 	void applyCardPatches(uint32 globalId, int scriptType, uint16 hotspotId) override;
+	void findCardChanges(Common::Array<uint16> &cards) const override;
 
 private:
 	RivenSwitchCommand(MohawkEngine_Riven *vm);
@@ -64,7 +64,7 @@ namespace Myst3 {
 
 Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		Engine(syst), _system(syst), _gameDescription(version),
-		_db(0), _scriptEngine(0),
+		_db(0), _cubeFaceCache(0), _scriptEngine(0),
 		_state(0), _node(0), _scene(0), _archiveNode(0),
 		_cursor(0), _inventory(0), _gfx(0), _menu(0),
 		_rnd(0), _sound(0), _ambient(0),
@@ -119,6 +119,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _inventory;
 	delete _cursor;
 	delete _scene;
+	delete _cubeFaceCache;
 	delete _archiveNode;
 	delete _db;
 	delete _scriptEngine;
@@ -169,6 +170,7 @@ Common::Error Myst3Engine::run() {
 		_menu = new PagingMenu(this);
 	}
 	_archiveNode = new Archive();
+	_cubeFaceCache = new CubeFaceCache(this);
 
 	_system->showMouse(false);
 
@@ -873,6 +875,51 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	// Releeshan to the player when he is trapped between both shields.
 	if (nodeID == 9 && roomID == kRoomNarayan)
 		_state->setVar(39, 0);
+
+	prefetchNodeNeighbours();
+}
+
+void Myst3Engine::prefetchNodeNeighbours() {
+	// The opcodes moving to another node of the current room,
+	// their first argument is the destination node
+	static const uint8 nodeChangeOpcodes[] = {
+		136, // goToNodeTransition
+		137, // goToNodeTrans2
+		138, // goToNodeTrans1
+		140, // zipToNode
+		164  // changeNode
+	};
+
+	uint16 currentNode = _state->getLocationNode();
+	uint32 room = _state->getLocationRoom();
+	uint32 age = _state->getLocationAge();
+
+	NodePtr nodeData = _db->getNodeData(currentNode, room, age);
+	if (!nodeData)
+		return;
+
+	Common::String roomName = _db->getRoomName(room, age);
+	Common::Array<uint16> destinations;
+	for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+		for (uint j = 0; j < script.size(); j++) {
+			bool nodeChange = false;
+			for (uint k = 0; k < ARRAYSIZE(nodeChangeOpcodes); k++)
+				nodeChange |= script[j].op == nodeChangeOpcodes[k];
+
+			// Destinations read from a variable are not predictable
+			if (!nodeChange || script[j].args.empty() || script[j].args[0] <= 0)
+				continue;
+
+			uint16 destination = script[j].args[0];
+			if (destination != currentNode && Common::find(destinations.begin(), destinations.end(), destination) == destinations.end())
+				destinations.push_back(destination);
+		}
+	}
+
+	// Prefetch in reverse so that the first hotspots are the most recent cache entries
+	for (uint i = MIN<uint>(destinations.size(), 4); i > 0; i--)
+		_cubeFaceCache->prefetch(roomName, destinations[i - 1]);
 }
 
 void Myst3Engine::unloadNode() {
@@ -73,6 +73,7 @@ class SunSpot;
 class Renderer;
 class Menu;
 class Node;
+class CubeFaceCache;
 class Sound;
 class Ambient;
 class ScriptedMovie;
@@ -101,6 +102,7 @@ public:
 	Renderer *_gfx;
 	Menu *_menu;
 	Database *_db;
+	CubeFaceCache *_cubeFaceCache;
 	Sound *_sound;
 	Ambient *_ambient;
 	
@@ -199,6 +201,9 @@ private:
 	Common::Array<Archive *> _archivesCommon;
 	Archive *_archiveNode;
 
+	/** Start decoding the cube faces of the nodes reachable from the current one */
+	void prefetchNodeNeighbours();
+
 	Script *_scriptEngine;
 
 	Common::Array<ScriptedMovie *> _movies;
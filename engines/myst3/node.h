@@ -48,6 +48,8 @@ public:
 	~Face();
 
 	void setTextureFromJPEG(const ResourceDescription *jpegDesc);
+	/** Use an already decoded bitmap for the face, the face takes its ownership */
+	void setTextureFromBitmap(Graphics::Surface *bitmap);
 
 	void addTextureDirtyRect(const Common::Rect &rect);
 	bool isTextureDirty() { return _textureDirty; }
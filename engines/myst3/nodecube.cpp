@@ -21,10 +21,15 @@
  */
 
 #include "engines/myst3/archive.h"
+#include "engines/myst3/database.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
 
 #include "common/debug.h"
+#include "common/threadpool.h"
+
+#include "image/jpeg.h"
 
 namespace Myst3 {
 
@@ -32,6 +37,15 @@ NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 		Node(vm, id) {
 	_is3D = true;
 
+	Graphics::Surface *prefetched[6];
+	if (_vm->_cubeFaceCache->take(_vm->_db->getRoomName(_vm->_state->getLocationRoom(), _vm->_state->getLocationAge()), id, prefetched)) {
+		for (int i = 0; i < 6; i++) {
+			_faces[i] = new Face(_vm);
+			_faces[i]->setTextureFromBitmap(prefetched[i]);
+		}
+		return;
+	}
+
 	for (int i = 0; i < 6; i++) {
 		ResourceDescription jpegDesc = _vm->getFileDescription("", id, i + 1, Archive::kCubeFace);
 
@@ -66,4 +80,113 @@ bool NodeCube::isFaceVisible(uint faceId) {
 	return _vm->_gfx->isCubeFaceVisible(faceId);
 }
 
+CubeFaceCache::CubeFaceCache(Myst3Engine *vm) :
+		_vm(vm) {
+}
+
+CubeFaceCache::~CubeFaceCache() {
+	clear();
+}
+
+void CubeFaceCache::prefetch(const Common::String &room, uint16 node) {
+	for (Common::List<Entry *>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		if ((*it)->node == node && (*it)->room == room) {
+			// Keep the most recently requested nodes at the front
+			Entry *entry = *it;
+			_entries.erase(it);
+			_entries.push_front(entry);
+			return;
+		}
+	}
+
+	ResourceDescription jpegDesc[6];
+	for (uint i = 0; i < 6; i++) {
+		jpegDesc[i] = _vm->getFileDescription(room, node, i + 1, Archive::kCubeFace);
+		if (!jpegDesc[i].isValid())
+			return;
+	}
+
+	// The archives can only be read from the main thread,
+	// only the decoding is done by the thread pool
+	Entry *entry = new Entry();
+	entry->room = room;
+	entry->node = node;
+	entry->group = new Common::TaskGroup();
+	for (uint i = 0; i < 6; i++) {
+		entry->faces[i].jpeg = jpegDesc[i].getData();
+		entry->faces[i].bitmap = nullptr;
+		entry->group->run(decodeFace, &entry->faces[i]);
+	}
+	_entries.push_front(entry);
+
+	while (_entries.size() > kMaxNodes) {
+		freeEntry(_entries.back());
+		_entries.pop_back();
+	}
+}
+
+bool CubeFaceCache::take(const Common::String &room, uint16 node, Graphics::Surface *faces[6]) {
+	for (Common::List<Entry *>::iterator it = _entries.begin(); it != _entries.end(); it++) {
+		Entry *entry = *it;
+		if (entry->node != node || entry->room != room)
+			continue;
+
+		_entries.erase(it);
+		entry->group->wait();
+
+		bool decoded = true;
+		for (uint i = 0; i < 6; i++)
+			decoded &= entry->faces[i].bitmap != nullptr;
+
+		if (decoded) {
+			for (uint i = 0; i < 6; i++) {
+				faces[i] = entry->faces[i].bitmap;
+				entry->faces[i].bitmap = nullptr;
+			}
+		}
+
+		// On failure, the regular path reports the broken face
+		freeEntry(entry);
+		return decoded;
+	}
+
+	return false;
+}
+
+void CubeFaceCache::clear() {
+	for (Common::List<Entry *>::iterator it = _entries.begin(); it != _entries.end(); it++)
+		freeEntry(*it);
+	_entries.clear();
+}
+
+void CubeFaceCache::decodeFace(void *refCon) {
+	PrefetchedFace *face = (PrefetchedFace *)refCon;
+
+	Image::JPEGDecoder jpeg;
+	jpeg.setOutputPixelFormat(Texture::getRGBAPixelFormat());
+
+	if (jpeg.loadStream(*face->jpeg) && jpeg.getSurface()->format == Texture::getRGBAPixelFormat()) {
+		face->bitmap = new Graphics::Surface();
+		face->bitmap->copyFrom(*jpeg.getSurface());
+	}
+
+	delete face->jpeg;
+	face->jpeg = nullptr;
+}
+
+void CubeFaceCache::freeEntry(Entry *entry) {
+	// The decoding tasks use the entry, they have to be finished first
+	delete entry->group;
+
+	for (uint i = 0; i < 6; i++) {
+		delete entry->faces[i].jpeg;
+		if (entry->faces[i].bitmap) {
+			entry->faces[i].bitmap->free();
+			delete entry->faces[i].bitmap;
+		}
+	}
+
+	delete entry;
+}
+
 } // End of namespace Myst3
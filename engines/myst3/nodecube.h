@@ -25,8 +25,64 @@
 
 #include "engines/myst3/node.h"
 
+#include "common/list.h"
+#include "common/str.h"
+
+namespace Common {
+class TaskGroup;
+}
+
 namespace Myst3 {
 
+/**
+ * Decodes the faces of the cube nodes the player is likely to go to next
+ * on the thread pool, so that entering them does not stall on the JPEG
+ * decoding of six 640x640 faces.
+ */
+class CubeFaceCache {
+public:
+	CubeFaceCache(Myst3Engine *vm);
+	~CubeFaceCache();
+
+	/**
+	 * Start decoding the faces of a node in the background.
+	 * The compressed data is read right away, on the calling thread.
+	 * Does nothing if the node is not a cube, or is already cached.
+	 */
+	void prefetch(const Common::String &room, uint16 node);
+
+	/**
+	 * Take the decoded faces of a node out of the cache, waiting
+	 * for the decoding to finish if needed.
+	 * Returns false if the node was not prefetched.
+	 */
+	bool take(const Common::String &room, uint16 node, Graphics::Surface *faces[6]);
+
+	/** Drop all the prefetched nodes */
+	void clear();
+
+private:
+	static const uint kMaxNodes = 4;
+
+	struct PrefetchedFace {
+		Common::SeekableReadStream *jpeg;
+		Graphics::Surface *bitmap;
+	};
+
+	struct Entry {
+		Common::String room;
+		uint16 node;
+		PrefetchedFace faces[6];
+		Common::TaskGroup *group;
+	};
+
+	static void decodeFace(void *refCon);
+	static void freeEntry(Entry *entry);
+
+	Myst3Engine *_vm;
+	Common::List<Entry *> _entries;
+};
+
 class NodeCube: public Node {
 public:
 	NodeCube(Myst3Engine *vm, uint16 id);
@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/algorithm.h"
+
 #include "neverhood/resourceman.h"
 
 namespace Neverhood {
@@ -31,7 +33,7 @@ ResourceHandle::ResourceHandle()
 ResourceHandle::~ResourceHandle() {
 }
 
-ResourceMan::ResourceMan() {
+ResourceMan::ResourceMan() : _useCounter(0) {
 }
 
 ResourceMan::~ResourceMan() {
@@ -150,6 +152,7 @@ void ResourceMan::loadResource(ResourceHandle &resourceHandle, bool applyResourc
 			}
 
 			resourceData->data = new byte[entry->size];
+			resourceData->size = entry->size;
 			resourceHandle._resourceFileEntry->archive->load(entry, resourceData->data, 0);
 			resourceData->dataRefCount = 1;
 		}
@@ -160,17 +163,34 @@ void ResourceMan::loadResource(ResourceHandle &resourceHandle, bool applyResourc
 void ResourceMan::unloadResource(ResourceHandle &resourceHandle) {
 	if (resourceHandle.isValid()) {
 		ResourceData *resourceData = _data[resourceHandle.fileHash()];
-		if (resourceData && resourceData->dataRefCount > 0)
-			--resourceData->dataRefCount;
+		if (resourceData && resourceData->dataRefCount > 0 && --resourceData->dataRefCount == 0)
+			resourceData->lastUse = ++_useCounter;
 		resourceHandle._resourceFileEntry = NULL;
 		resourceHandle._data = NULL;
 	}
 }
 
+static bool isUsedLater(const ResourceData *a, const ResourceData *b) {
+	return a->lastUse > b->lastUse;
+}
+
 void ResourceMan::purgeResources() {
+	// Adjacent scenes share most of their resources, so the most recently
+	// used ones are kept for the next scene instead of being loaded again
+	Common::Array<ResourceData*> unused;
 	for (Common::HashMap<uint32, ResourceData*>::iterator it = _data.begin(); it != _data.end(); ++it) {
 		ResourceData *resourceData = (*it)._value;
-		if (resourceData->dataRefCount == 0) {
+		if (resourceData && resourceData->data && resourceData->dataRefCount == 0)
+			unused.push_back(resourceData);
+	}
+	Common::sort(unused.begin(), unused.end(), isUsedLater);
+
+	uint32 keptSize = 0;
+	for (Common::Array<ResourceData*>::iterator it = unused.begin(); it != unused.end(); ++it) {
+		ResourceData *resourceData = *it;
+		if (keptSize + resourceData->size <= kMaxUnusedSize) {
+			keptSize += resourceData->size;
+		} else {
 			delete[] resourceData->data;
 			resourceData->data = NULL;
 		}
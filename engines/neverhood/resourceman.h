@@ -44,8 +44,10 @@ struct Resource {
 
 struct ResourceData {
 	byte *data;
+	uint32 size;
 	int dataRefCount;
-	ResourceData() : data(NULL), dataRefCount() {}
+	uint32 lastUse;
+	ResourceData() : data(NULL), size(0), dataRefCount(), lastUse(0) {}
 };
 
 class ResourceMan;
@@ -82,11 +84,15 @@ public:
 	void unloadResource(ResourceHandle &resourceHandle);
 	void purgeResources();
 protected:
+	// Maximum size of the unused resources which are kept when purging
+	static const uint32 kMaxUnusedSize = 8 * 1024 * 1024;
+
 	typedef Common::HashMap<uint32, ResourceFileEntry> EntriesMap;
 	Common::Array<BlbArchive*> _archives;
 	EntriesMap _entries;
 	Common::HashMap<uint32, ResourceData*> _data;
 	Common::Array<Resource*> _resources;
+	uint32 _useCounter;
 };
 
 } // End of namespace Neverhood
@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -150,6 +151,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -163,6 +165,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -226,6 +229,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("script_sends",		WRAP_METHOD(Console, cmdScriptSends));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -376,6 +380,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows the hits and misses of the cel cache (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -388,6 +393,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows the pause times and the freed entries of the garbage collections\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -433,6 +439,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" script_sends - Shows the number of message sends per frame, and the selector cache hits\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -2075,6 +2082,23 @@ bool Console::cmdPlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		const uint32 hits = CelObj::getCacheHits();
+		const uint32 misses = CelObj::getCacheMisses();
+		debugPrintf("Cel cache: %u of %u entries used\n", CelObj::getCacheSize(), CelObj::getCacheCapacity());
+		debugPrintf("Hits: %u, misses: %u (%d%% hits)\n", hits, misses, hits + misses ? (int)((uint64)hits * 100 / (hits + misses)) : 0);
+		debugPrintf("LarryScale cache: %u of %u KB used\n", CelObj::getLarryScaleCacheUsed() / 1024, (uint)kLarryScaleCacheSize / 1024);
+	} else {
+		debugPrintf("This SCI version does not have a cel cache\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 #ifdef ENABLE_SCI32
 	if (_engine->_gfxFrameout) {
@@ -2733,6 +2757,15 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	const EngineState *s = _engine->_gamestate;
+	debugPrintf("Collections: %u, periodic ones skipped: %u\n", s->gcRuns, s->gcSkipped);
+	debugPrintf("Pause: last %u us, longest %u us, average %u us\n", s->gcLastPause, s->gcMaxPause,
+		s->gcRuns ? (uint32)(s->gcTotalPause / s->gcRuns) : 0);
+	debugPrintf("Entries freed: last %u, total %u\n", s->gcLastCollected, s->gcTotalCollected);
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -3268,6 +3301,15 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdScriptSends(int argc, const char **argv) {
+	const EngineState *s = _engine->_gamestate;
+	const uint32 lookups = s->_segMan->getSelectorLookups();
+	const uint32 hits = s->_segMan->getSelectorCacheHits();
+	debugPrintf("Message sends in the last frame: %u\n", s->_sendsLastFrame);
+	debugPrintf("Selector lookups: %u, found in the cache: %u (%d%%)\n", lookups, hits, lookups ? (int)((uint64)hits * 100 / lookups) : 0);
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
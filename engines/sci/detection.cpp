@@ -452,6 +452,11 @@ public:
 		return "Sierra's Creative Interpreter (C) Sierra Online";
 	}
 
+	// The fallback detection goes through the engine plugin
+	bool isDetectionThreadSafe() const override {
+		return false;
+	}
+
 	ADDetectedGame fallbackDetect(const FileMap &allFiles, const Common::FSList &fslist) const override;
 	void registerDefaultSettings(const Common::String &target) const override;
 	GUI::OptionsContainerWidget *buildEngineOptionsWidgetStatic(GUI::GuiObject *boss, const Common::String &name, const Common::String &target) const override;
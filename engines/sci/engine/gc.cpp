@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/profiler.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -181,6 +182,8 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	const uint64 startTime = Common::Profiler::getMicros();
+	uint32 collected = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -214,6 +217,7 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
+					++collected;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -226,6 +230,16 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	const uint32 pause = (uint32)(Common::Profiler::getMicros() - startTime);
+	s->gcAllocations = segMan->getGCAllocations();
+	s->gcRuns++;
+	s->gcLastPause = pause;
+	s->gcMaxPause = MAX(s->gcMaxPause, pause);
+	s->gcTotalPause += pause;
+	s->gcLastCollected = collected;
+	s->gcTotalCollected += collected;
+	debugC(kDebugLevelGC, "[GC] Freed %u entries in %u us", collected, pause);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -235,4 +249,17 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+void run_gc_if_needed(EngineState *s) {
+	// Without new allocations, the heap cannot have grown since the last
+	// collection, and whatever became unreachable in the meantime is freed
+	// by the next one. Skipping it avoids the full heap walk in the scenes
+	// that just run their scripts.
+	if (s->_segMan->getGCAllocations() == s->gcAllocations) {
+		s->gcSkipped++;
+		return;
+	}
+
+	run_gc(s);
+}
+
 } // End of namespace Sci
@@ -67,6 +67,14 @@ enum {
 
 #define HUGE_DISTANCE 0xFFFFFFFF
 
+enum {
+	// Number of obstacle sets whose vertex visibility is kept by kAvoidPath
+	kAvoidPathCacheSize = 4,
+	// Obstacle sets with more vertices are not cached, as the visibility takes
+	// the square of the vertex count
+	kAvoidPathMaxCachedVertices = 512
+};
+
 #define VERTEX_HAS_EDGES(V) ((V) != CLIST_NEXT(V))
 
 // Error codes
@@ -117,13 +125,23 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Index of the vertex in the obstacle polygons, or -1 for the vertices
+	// added for the start and end points
+	int index;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		index = -1;
 	}
 };
 
+// Bounding box of the edge starting at a vertex
+struct EdgeBounds {
+	int16 minX, minY, maxX, maxY;
+};
+
 class VertexList: public Common::List<Vertex *> {
 public:
 	bool contains(Vertex *v) {
@@ -256,6 +274,14 @@ struct PathfindingState {
 	// Total number of vertices
 	int vertices;
 
+	// Bounding boxes of the edges starting at the vertices of vertex_index
+	EdgeBounds *edge_bounds;
+
+	// Visibility between the obstacle vertices, shared by the calls with the
+	// same obstacles, or NULL. Its rows and columns are Vertex::index
+	byte *visibility;
+	int indexedVertices;
+
 	// Point to prepend and append to final path
 	Common::Point *_prependPoint;
 	Common::Point *_appendPoint;
@@ -270,10 +296,14 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		edge_bounds = NULL;
+		visibility = NULL;
+		indexedVertices = 0;
 	}
 
 	~PathfindingState() {
 		free(vertex_index);
+		free(edge_bounds);
 
 		delete _prependPoint;
 		delete _appendPoint;
@@ -707,19 +737,53 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	byte *visibilityRow = NULL;
+	if (s->visibility && vertex_cur->index >= 0)
+		visibilityRow = s->visibility + vertex_cur->index * s->indexedVertices;
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
+		if (vertex == vertex_cur)
+			continue;
+
+		// Reuse the result of the previous calls with the same obstacles
+		byte *visibility = NULL;
+		if (visibilityRow && vertex->index >= 0) {
+			visibility = visibilityRow + vertex->index;
+			if (*visibility) {
+				if (*visibility == 1)
+					visVerts->push_front(vertex);
+				continue;
+			}
+		}
+
 		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		if ((inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex))) {
+			if (visibility)
+				*visibility = 2;
 			continue;
+		}
+
+		// Only the edges whose bounding box touches the one of the line can
+		// intersect it or have their start on it. An empty line (two
+		// vertices at the same place) is a special case of between(), so
+		// all the edges are checked then.
+		const bool checkBounds = vertex_cur->v != vertex->v;
+		const int16 minX = MIN(vertex_cur->v.x, vertex->v.x), maxX = MAX(vertex_cur->v.x, vertex->v.x);
+		const int16 minY = MIN(vertex_cur->v.y, vertex->v.y), maxY = MAX(vertex_cur->v.y, vertex->v.y);
 
 		// Check for intersecting edges
 		int j;
 		for (j = 0; j < s->vertices; j++) {
 			Vertex *edge = s->vertex_index[j];
 			if (VERTEX_HAS_EDGES(edge)) {
+				if (checkBounds) {
+					const EdgeBounds &bounds = s->edge_bounds[j];
+					if (bounds.maxX < minX || bounds.minX > maxX || bounds.maxY < minY || bounds.minY > maxY)
+						continue;
+				}
+
 				if (between(vertex_cur->v, vertex->v, edge->v)) {
 					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
 					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
@@ -736,6 +800,9 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 
 		if (j == s->vertices)
 			visVerts->push_front(vertex);
+
+		if (visibility)
+			*visibility = (j == s->vertices) ? 1 : 2;
 	}
 
 	return visVerts;
@@ -1322,6 +1389,23 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// Number the obstacle vertices, and describe the obstacles for looking up
+	// their visibility graph
+	Common::Array<int16> obstacles;
+	int indexedVertices = 0;
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		const uint sizeIndex = obstacles.size();
+		obstacles.push_back(0);
+
+		Vertex *vertex;
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			vertex->index = indexedVertices++;
+			obstacles.push_back(vertex->v.x);
+			obstacles.push_back(vertex->v.y);
+			++obstacles[sizeIndex];
+		}
+	}
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1331,6 +1415,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	// Allocate and build vertex index
 	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
+	pf_s->edge_bounds = (EdgeBounds *)malloc(sizeof(EdgeBounds) * (count + 2));
 
 	count = 0;
 
@@ -1339,12 +1424,53 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			const Common::Point &next = CLIST_NEXT(vertex)->v;
+			EdgeBounds &bounds = pf_s->edge_bounds[count];
+			bounds.minX = MIN(vertex->v.x, next.x);
+			bounds.maxX = MAX(vertex->v.x, next.x);
+			bounds.minY = MIN(vertex->v.y, next.y);
+			bounds.maxY = MAX(vertex->v.y, next.y);
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	// The visibility between the obstacle vertices only depends on the
+	// obstacles, unless the start or end point split one of their edges
+	const bool splitEdge =
+		(pf_s->vertex_start->index == -1 && VERTEX_HAS_EDGES(pf_s->vertex_start)) ||
+		(pf_s->vertex_end->index == -1 && VERTEX_HAS_EDGES(pf_s->vertex_end));
+	if (!splitEdge && indexedVertices > 0 && indexedVertices <= kAvoidPathMaxCachedVertices) {
+		const uint32 now = ++s->_avoidPathCalls;
+		AvoidPathVisibility *entry = nullptr;
+		for (uint i = 0; i < s->_avoidPathCache.size() && !entry; ++i) {
+			if (s->_avoidPathCache[i].polygons == obstacles)
+				entry = &s->_avoidPathCache[i];
+		}
+
+		if (!entry) {
+			if (s->_avoidPathCache.size() < kAvoidPathCacheSize) {
+				s->_avoidPathCache.push_back(AvoidPathVisibility());
+				entry = &s->_avoidPathCache.back();
+			} else {
+				entry = &s->_avoidPathCache[0];
+				for (uint i = 1; i < s->_avoidPathCache.size(); ++i) {
+					if (s->_avoidPathCache[i].lastUsed < entry->lastUsed)
+						entry = &s->_avoidPathCache[i];
+				}
+			}
+			entry->polygons = obstacles;
+			entry->visible.clear();
+			entry->visible.resize(indexedVertices * indexedVertices);
+			Common::fill(entry->visible.begin(), entry->visible.end(), 0);
+		}
+
+		entry->lastUsed = now;
+		pf_s->visibility = entry->visible.begin();
+		pf_s->indexedVertices = indexedVertices;
+	}
+
 	return pf_s;
 }
 
@@ -280,6 +280,9 @@ public:
 	uint16 getMethodCount() const { return _methodCount; }
 	reg_t getPos() const { return _pos; }
 
+	/** The script data defining the object, which its clones share. */
+	const byte *getBaseObjData() const { return _baseObj.data(); }
+
 	void saveLoadWithSerializer(Common::Serializer &ser) override;
 
 	void cloneFromObject(const Object *obj) {
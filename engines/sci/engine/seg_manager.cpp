@@ -48,6 +48,11 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_bitmapSegId = 0;
 #endif
 
+	_selectorLookups = 0;
+	_selectorCacheHits = 0;
+	_gcAllocations = 0;
+	clearSelectorCache();
+
 	createClassTable();
 }
 
@@ -165,6 +170,7 @@ void SegManager::deallocate(SegmentId seg) {
 		error("Attempt to deallocate an already freed segment");
 
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
+		clearSelectorCache();
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
 		if (scr->getLocalsSegment()) {
@@ -184,6 +190,13 @@ void SegManager::deallocate(SegmentId seg) {
 	_heap[actualSegment] = NULL;
 }
 
+void SegManager::clearSelectorCache() {
+	for (uint i = 0; i < kSelectorCacheSize; ++i) {
+		_selectorCache[i].obj = NULL_REG;
+		_selectorCache[i].baseObj = nullptr;
+	}
+}
+
 bool SegManager::isHeapObject(reg_t pos) const {
 	const Object *obj = getObject(pos);
 	if (obj == NULL || (obj && obj->isFreed()))
@@ -403,6 +416,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	table = (HunkTable *)_heap[_hunksSegId];
 
 	offset = table->allocEntry();
+	++_gcAllocations;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk *h = &table->at(offset);
@@ -438,6 +452,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	++_gcAllocations;
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -452,6 +467,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	table = (ListTable *)_heap[_listsSegId];
 
 	offset = table->allocEntry();
+	++_gcAllocations;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -466,6 +482,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	table = (NodeTable *)_heap[_nodesSegId];
 
 	offset = table->allocEntry();
+	++_gcAllocations;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -850,6 +867,7 @@ Common::String SegManager::getString(reg_t pointer) {
 byte *SegManager::allocDynmem(int size, const char *descr, reg_t *addr) {
 	SegmentId seg;
 	SegmentObj *mobj = allocSegment(new DynMem(), &seg);
+	++_gcAllocations;
 	*addr = make_reg(seg, 0);
 
 	DynMem &d = *(DynMem *)mobj;
@@ -893,6 +911,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 		table = (ArrayTable *)_heap[_arraysSegId];
 
 	offset = table->allocEntry();
+	++_gcAllocations;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -949,6 +968,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	offset = table->allocEntry();
+	++_gcAllocations;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1042,6 +1062,9 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 		scr = allocateScript(scriptNum, &segmentId);
 	}
 
+	// The objects of the script may be loaded where the ones of another
+	// script were
+	clearSelectorCache();
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
@@ -399,6 +399,45 @@ public:
 	 */
 	bool isObject(reg_t obj) const { return getObject(obj) != NULL; }
 
+	/**
+	 * A lookupSelector() result, kept for the next sends of the selector to
+	 * the same object. The entry is only valid while the object at the
+	 * address has the same base object, i.e. was defined by the same script
+	 * code, and it is dropped when a script is loaded or freed.
+	 */
+	struct SelectorCacheEntry {
+		reg_t obj;
+		const byte *baseObj;
+		Selector selector;
+		SelectorType type;
+		int varIndex;
+		reg_t funcp;
+	};
+
+	/**
+	 * Returns the cache entry for a selector of an object, and counts a
+	 * lookup for the statistics.
+	 */
+	SelectorCacheEntry &getSelectorCacheEntry(reg_t obj, Selector selector) {
+		++_selectorLookups;
+		const uint32 hash = (obj.getSegment() * 0x9E5) ^ (obj.getOffset() * 0x3B) ^ ((uint16)selector * 0x61);
+		return _selectorCache[hash & (kSelectorCacheSize - 1)];
+	}
+
+	void countSelectorCacheHit() { ++_selectorCacheHits; }
+	uint32 getSelectorLookups() const { return _selectorLookups; }
+	uint32 getSelectorCacheHits() const { return _selectorCacheHits; }
+
+	/** Drops all the kept lookupSelector() results. */
+	void clearSelectorCache();
+
+	/**
+	 * Returns the number of garbage collectable entries allocated so far.
+	 * The garbage collector compares it between runs, to skip the periodic
+	 * collections when nothing new was allocated in the meantime.
+	 */
+	uint32 getGCAllocations() const { return _gcAllocations; }
+
 	// TODO: document this
 	bool isHeapObject(reg_t pos) const;
 
@@ -481,6 +520,15 @@ private:
 	SegmentId _bitmapSegId;
 #endif
 
+	enum {
+		kSelectorCacheSize = 1024
+	};
+
+	SelectorCacheEntry _selectorCache[kSelectorCacheSize];
+	uint32 _selectorLookups;
+	uint32 _selectorCacheHits;
+	uint32 _gcAllocations;
+
 public:
 	SegmentObj *allocSegment(SegmentObj *mem, SegmentId *segid);
 
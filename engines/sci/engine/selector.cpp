@@ -341,6 +341,22 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
 	}
 
+	SegManager::SelectorCacheEntry &cached = segMan->getSelectorCacheEntry(obj_location, selectorId);
+	if (cached.obj == obj_location && cached.selector == selectorId && cached.baseObj == obj->getBaseObjData()) {
+		segMan->countSelectorCacheHit();
+		if (cached.type == kSelectorVariable && varp) {
+			varp->obj = obj_location;
+			varp->varindex = cached.varIndex;
+		} else if (cached.type == kSelectorMethod && fptr) {
+			*fptr = cached.funcp;
+		}
+		return cached.type;
+	}
+
+	cached.obj = obj_location;
+	cached.baseObj = obj->getBaseObjData();
+	cached.selector = selectorId;
+
 	index = obj->locateVarSelector(segMan, selectorId);
 
 	if (index >= 0) {
@@ -349,6 +365,8 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
+		cached.type = kSelectorVariable;
+		cached.varIndex = index;
 		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
@@ -358,12 +376,15 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				if (fptr)
 					*fptr = obj->getFunction(index);
 
+				cached.type = kSelectorMethod;
+				cached.funcp = obj->getFunction(index);
 				return kSelectorMethod;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
 			}
 		}
 
+		cached.type = kSelectorNone;
 		return kSelectorNone;
 	}
 
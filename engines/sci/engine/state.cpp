@@ -103,6 +103,14 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcAllocations = 0;
+	gcRuns = 0;
+	gcSkipped = 0;
+	gcLastPause = 0;
+	gcMaxPause = 0;
+	gcTotalPause = 0;
+	gcLastCollected = 0;
+	gcTotalCollected = 0;
 
 #ifdef ENABLE_SCI32
 	_eventCounter = 0;
@@ -120,6 +128,10 @@ void EngineState::reset(bool isRestoring) {
 
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
+	_sendsThisFrame = 0;
+	_sendsLastFrame = 0;
+	_avoidPathCache.clear();
+	_avoidPathCalls = 0;
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
@@ -98,6 +98,16 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * The polygon vertex visibility computed by kAvoidPath for a set of
+ * obstacles, reused for as long as the scripts pass the same obstacles.
+ */
+struct AvoidPathVisibility {
+	Common::Array<int16> polygons; ///< The vertex count and the points of each polygon
+	Common::Array<byte> visible; ///< For each pair of vertices: 0 if not known yet, 1 if visible, 2 if not
+	uint32 lastUsed;
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -177,6 +187,8 @@ public:
 	int16 gameIsRestarting; // is set when restarting (=1) or restoring the game (=2)
 
 	int scriptStepCounter; // Counts the number of steps executed
+	uint32 _sendsThisFrame; /**< message sends since the last call to kAnimate or kFrameOut */
+	uint32 _sendsLastFrame; /**< message sends of the last complete frame */
 	int scriptGCInterval; // Number of steps in between gcs
 
 	uint16 currentRoomNumber() const;
@@ -194,9 +206,22 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	uint32 gcAllocations; /**< SegManager::getGCAllocations() at the last gc */
+
+	// Garbage collection statistics, for the gc_stats console command
+	uint32 gcRuns; /**< Number of garbage collections */
+	uint32 gcSkipped; /**< Number of periodic collections skipped, as nothing was allocated */
+	uint32 gcLastPause; /**< Duration of the last garbage collection, in microseconds */
+	uint32 gcMaxPause; /**< Duration of the longest garbage collection, in microseconds */
+	uint64 gcTotalPause; /**< Time spent in all garbage collections, in microseconds */
+	uint32 gcLastCollected; /**< Number of entries freed by the last garbage collection */
+	uint32 gcTotalCollected; /**< Number of entries freed by all garbage collections */
 
 	MessageState *_msgState;
 
+	Common::Array<AvoidPathVisibility> _avoidPathCache; /**< The last obstacle sets used by kAvoidPath */
+	uint32 _avoidPathCalls; /**< Number of kAvoidPath path searches, for aging _avoidPathCache */
+
 	// MemorySegment provides access to a 256-byte block of memory that remains
 	// intact across restarts and restores
 	enum {
@@ -285,6 +285,8 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 		if (argc > 0x800)	// More arguments than the stack could possibly accomodate for
 			error("send_selector(): More than 0x800 arguments to function call");
 
+		++s->_sendsThisFrame;
+
 #ifdef ENABLE_SCI32
 		g_sci->_guestAdditions->sendSelectorHook(send_obj, selector, argp);
 #endif
@@ -909,7 +911,7 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc_if_needed(s);
 			}
 
 			// Call kernel function
@@ -91,12 +91,20 @@ void CelObj::init() {
 	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
-	_cache.reset(new CelCache(100));
+	_cache.reset(new CelCache(kCelCacheSize));
+	_cacheIndex.reset(new CelCacheIndex());
+	_cacheHits = 0;
+	_cacheMisses = 0;
+	_larryScaleCache.reset(new LarryScaleCache());
+	_larryScaleCacheUsed = 0;
 }
 
 void CelObj::deinit() {
 	_scaler.reset();
 	_cache.reset();
+	_cacheIndex.reset();
+	_larryScaleCache.reset();
+	_larryScaleCacheUsed = 0;
 }
 
 #pragma mark -
@@ -233,14 +241,18 @@ struct SCALER_Scale {
 				scaledPosition.y,
 				scaledPosition.x + (celObj._width * scaleX).toInt(),
 				scaledPosition.y + (celObj._height * scaleY).toInt());
-			_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
-			_sourceBuffer->create(
-				scaledImageRect.width(), scaledImageRect.height(),
-				Graphics::PixelFormat::createFormatCLUT8());
-			Copier copier(_reader, *_sourceBuffer);
-			Graphics::larryScale(
-				celObj._width, celObj._height, celObj._skipColor, copier,
-				scaledImageRect.width(), scaledImageRect.height(), copier);
+			_sourceBuffer = celObj.findLarryScaled(scaledImageRect.width(), scaledImageRect.height());
+			if (!_sourceBuffer) {
+				_sourceBuffer = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+				_sourceBuffer->create(
+					scaledImageRect.width(), scaledImageRect.height(),
+					Graphics::PixelFormat::createFormatCLUT8());
+				Copier copier(_reader, *_sourceBuffer);
+				Graphics::larryScale(
+					celObj._width, celObj._height, celObj._skipColor, copier,
+					scaledImageRect.width(), scaledImageRect.height(), copier);
+				celObj.putLarryScaledInCache(_sourceBuffer);
+			}
 
 			// Set _valuesX and _valuesY to reference the scaled image without additional scaling
 			for (int16 x = targetRect.left; x < targetRect.right; ++x) {
@@ -687,32 +699,42 @@ void CelObj::submitPalette() const {
 
 int CelObj::_nextCacheId = 1;
 Common::ScopedPtr<CelCache> CelObj::_cache;
+Common::ScopedPtr<CelCacheIndex> CelObj::_cacheIndex;
+uint32 CelObj::_cacheHits = 0;
+uint32 CelObj::_cacheMisses = 0;
+Common::ScopedPtr<LarryScaleCache> CelObj::_larryScaleCache;
+uint32 CelObj::_larryScaleCacheUsed = 0;
 
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	CelCacheIndex::const_iterator it = _cacheIndex->find(celInfo);
+	if (it != _cacheIndex->end()) {
+		(*_cache)[it->_value].id = ++_nextCacheId;
+		++_cacheHits;
+		return it->_value;
+	}
+
+	++_cacheMisses;
+
+	// Only misses pay for finding the slot to replace, and they are followed
+	// by the much more expensive initialisation of the cel anyway
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
 	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+		const CelCacheEntry &entry = (*_cache)[i];
 
 		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
+			*nextInsertIndex = i;
+			return -1;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
 		}
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
-	}
-
+	*nextInsertIndex = oldestIndex;
 	return -1;
 }
 
@@ -722,8 +744,84 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	}
 
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	if (entry.celObj) {
+		_cacheIndex->erase(entry.celObj->_info);
+		eraseLarryScaled(entry.celObj->_info);
+	}
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	(*_cacheIndex)[_info] = cacheIndex;
+}
+
+Common::SharedPtr<Buffer> CelObj::findLarryScaled(const int16 width, const int16 height) const {
+	if (_info.type == kCelTypeMem || !_larryScaleCache) {
+		return Common::SharedPtr<Buffer>();
+	}
+
+	LarryScaleCache::iterator it = _larryScaleCache->find(_info);
+	if (it != _larryScaleCache->end()) {
+		for (uint i = 0; i < it->_value.size(); ++i) {
+			LarryScaleCacheEntry &entry = it->_value[i];
+			if (entry.buffer->w == width && entry.buffer->h == height) {
+				entry.id = ++_nextCacheId;
+				return entry.buffer;
+			}
+		}
+	}
+
+	return Common::SharedPtr<Buffer>();
+}
+
+void CelObj::putLarryScaledInCache(const Common::SharedPtr<Buffer> &buffer) const {
+	const uint32 size = buffer->w * buffer->h;
+	if (_info.type == kCelTypeMem || !_larryScaleCache || size > kLarryScaleCacheSize) {
+		return;
+	}
+
+	while (_larryScaleCacheUsed + size > kLarryScaleCacheSize) {
+		// Like the cel cache misses, this only follows the scaling of a cel,
+		// which costs far more than going through the scaled cels
+		LarryScaleCache::iterator oldestCel = _larryScaleCache->end();
+		uint oldestIndex = 0;
+		int oldestId = _nextCacheId + 1;
+		for (LarryScaleCache::iterator it = _larryScaleCache->begin(); it != _larryScaleCache->end(); ++it) {
+			for (uint i = 0; i < it->_value.size(); ++i) {
+				if (it->_value[i].id < oldestId) {
+					oldestId = it->_value[i].id;
+					oldestCel = it;
+					oldestIndex = i;
+				}
+			}
+		}
+		assert(oldestCel != _larryScaleCache->end());
+
+		const Buffer &oldest = *oldestCel->_value[oldestIndex].buffer;
+		_larryScaleCacheUsed -= oldest.w * oldest.h;
+		oldestCel->_value.remove_at(oldestIndex);
+		if (oldestCel->_value.empty()) {
+			_larryScaleCache->erase(oldestCel);
+		}
+	}
+
+	LarryScaleCacheEntry entry;
+	entry.id = ++_nextCacheId;
+	entry.buffer = buffer;
+	(*_larryScaleCache)[_info].push_back(entry);
+	_larryScaleCacheUsed += size;
+}
+
+void CelObj::eraseLarryScaled(const CelInfo32 &celInfo) {
+	if (!_larryScaleCache) {
+		return;
+	}
+
+	LarryScaleCache::iterator it = _larryScaleCache->find(celInfo);
+	if (it != _larryScaleCache->end()) {
+		for (uint i = 0; i < it->_value.size(); ++i) {
+			_larryScaleCacheUsed -= it->_value[i].buffer->w * it->_value[i].buffer->h;
+		}
+		_larryScaleCache->erase(it);
+	}
 }
 
 #pragma mark -
@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -106,7 +107,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -116,7 +117,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -139,6 +140,16 @@ struct CelInfo32 {
 	}
 };
 
+enum {
+	/**
+	 * The number of cel objects kept in the cel cache. 100 is too few for the
+	 * scenes with many screen items, and since the cache is indexed, more
+	 * entries only cost the memory of the cel objects, as their pixels stay in
+	 * the resources.
+	 */
+	kCelCacheSize = 500
+};
+
 class CelObj;
 struct CelCacheEntry {
 	/**
@@ -152,6 +163,47 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+/**
+ * Hashes the fields of a CelInfo32 that are compared by its equality
+ * operator, for the cel cache index.
+ */
+struct CelInfo32_Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return ((uint)info.type << 28) ^ ((uint)info.resourceId << 12) ^ ((uint16)info.loopNo << 6) ^ (uint16)info.celNo ^
+			((uint)info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
+/**
+ * Maps the CelInfo32 of every cached cel object to its index in the cel
+ * cache.
+ */
+typedef Common::HashMap<CelInfo32, int, CelInfo32_Hash> CelCacheIndex;
+
+enum {
+	/**
+	 * The number of bytes of cels scaled by LarryScale which are kept for
+	 * drawing them again at the same size.
+	 */
+	kLarryScaleCacheSize = 8 * 1024 * 1024
+};
+
+struct LarryScaleCacheEntry {
+	/**
+	 * A cache ID from the same counter as the cel cache, to find the least
+	 * recently used scaled cel.
+	 */
+	int id;
+	Common::SharedPtr<Buffer> buffer;
+};
+
+/**
+ * Maps the CelInfo32 of view and pic cels to the versions of them scaled by
+ * LarryScale, at most one per size. Memory cels are never kept, since
+ * scripts can change their pixels.
+ */
+typedef Common::HashMap<CelInfo32, Common::Array<LarryScaleCacheEntry>, CelInfo32_Hash> LarryScaleCache;
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -466,11 +518,30 @@ protected:
 	 */
 	static Common::ScopedPtr<CelCache> _cache;
 
+	/**
+	 * The index of `_cache`, so that looking up a cel does not compare it to
+	 * every cached cel.
+	 */
+	static Common::ScopedPtr<CelCacheIndex> _cacheIndex;
+
+	/**
+	 * The number of searchCache calls that found a cached cel, and of those
+	 * that did not, since the last call to init().
+	 */
+	static uint32 _cacheHits;
+	static uint32 _cacheMisses;
+
+	/**
+	 * The cels scaled by LarryScale, and the number of bytes of their pixels.
+	 */
+	static Common::ScopedPtr<LarryScaleCache> _larryScaleCache;
+	static uint32 _larryScaleCacheUsed;
+
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
+	 * not found, -1 is returned, and `nextInsertIndex` will receive the index
+	 * of a free slot or of the oldest item in the cache, which can be used to
+	 * replace the oldest item with a newer item.
 	 */
 	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
 
@@ -478,6 +549,30 @@ protected:
 	 * Puts a copy of this CelObj into the cache at the given cache index.
 	 */
 	void putCopyInCache(int index) const;
+
+	/**
+	 * Drops the versions of the given cel scaled by LarryScale.
+	 */
+	static void eraseLarryScaled(const CelInfo32 &celInfo);
+
+public:
+	/**
+	 * Returns this cel scaled by LarryScale to the given size, if it is in the
+	 * cache.
+	 */
+	Common::SharedPtr<Buffer> findLarryScaled(int16 width, int16 height) const;
+
+	/**
+	 * Puts this cel scaled by LarryScale in the cache, dropping the least
+	 * recently used scaled cels to stay within kLarryScaleCacheSize.
+	 */
+	void putLarryScaledInCache(const Common::SharedPtr<Buffer> &buffer) const;
+
+	static uint32 getCacheHits() { return _cacheHits; }
+	static uint32 getCacheMisses() { return _cacheMisses; }
+	static uint32 getCacheSize() { return _cacheIndex ? _cacheIndex->size() : 0; }
+	static uint32 getCacheCapacity() { return _cache ? _cache->size() : 0; }
+	static uint32 getLarryScaleCacheUsed() { return _larryScaleCacheUsed; }
 };
 
 #pragma mark -
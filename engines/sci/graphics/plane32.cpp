@@ -314,7 +314,29 @@ void Plane::breakEraseListByPlanes(RectList &eraseList, const PlaneList &planeLi
 	eraseList.pack();
 }
 
+bool Plane::hasScreenItemChanges() const {
+	for (ScreenItemList::const_iterator it = _screenItemList.begin(); it != _screenItemList.end(); ++it) {
+		const ScreenItem *item = *it;
+		if (item != nullptr && (item->_created || item->_updated || item->_deleted)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList &drawList, RectList &eraseList) {
+	// Most frames only change a few of the planes. When nothing in this plane
+	// changed and no other plane erased anything in it, there is nothing to
+	// draw, so skip the dirty rect calculation (and the sorting of the screen
+	// items in SCI3) and only do the packing of the item lists that
+	// decrementScreenItemArrayCounts would have done
+	if (eraseList.size() == 0 && !hasScreenItemChanges()) {
+		_screenItemList.pack();
+		visiblePlane._screenItemList.pack();
+		return;
+	}
+
 	const ScreenItemList::size_type screenItemCount = _screenItemList.size();
 	const ScreenItemList::size_type visiblePlaneItemCount = visiblePlane._screenItemList.size();
 
@@ -390,6 +390,12 @@ private:
 	 */
 	void mergeToRectList(const Common::Rect &rect, RectList &eraseList) const;
 
+	/**
+	 * Returns true if any screen item in this plane has been created, updated,
+	 * or deleted since it was last synchronised to the visible plane.
+	 */
+	bool hasScreenItemChanges() const;
+
 public:
 	/**
 	 * Calculates the location and dimensions of dirty rects of the screen items
@@ -22,14 +22,14 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/memstream.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/translation.h"
-#ifdef ENABLE_SCI32
-#include "common/memstream.h"
-#endif
 
 #include "sci/engine/workarounds.h"
 #include "sci/parser/vocabulary.h"
@@ -47,6 +47,11 @@ enum {
 	SCI11_RESMAP_ENTRIES_SIZE = 5
 };
 
+enum {
+	/** The maximum number of resources recorded for prefetching per room */
+	kMaxRoomPrefetch = 128
+};
+
 /** resource type for SCI1 resource.map file */
 struct resource_index_t {
 	uint16 wOffset;
@@ -427,6 +432,136 @@ void ResourceManager::loadResource(Resource *res) {
 	if (_patcher) {
 		_patcher->applyPatch(*res);
 	};
+
+	if (_prefetchRoomNumber != -1 && res->data() && isPrefetchable(res)) {
+		Common::Array<ResourceId> &roomResources = _roomResources[_prefetchRoomNumber];
+		if (roomResources.size() < kMaxRoomPrefetch && Common::find(roomResources.begin(), roomResources.end(), res->_id) == roomResources.end())
+			roomResources.push_back(res->_id);
+	}
+}
+
+bool ResourceManager::isPrefetchable(const Resource *res) const {
+	// Only the resources read by ResourceSource::loadResource, whose
+	// decompression does not depend on anything but the volume data
+	if (res->_source->getSourceType() != kSourceVolume)
+		return false;
+
+	switch (res->getType()) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypePalette:
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+		return true;
+	default:
+		return false;
+	}
+}
+
+namespace {
+struct PrefetchTask {
+	Resource *res;
+	ResVersion volVersion;
+	Common::SeekableReadStream *stream;
+	int error;
+};
+} // End of anonymous namespace
+
+void ResourceManager::decompressPrefetched(void *refCon) {
+	PrefetchTask *task = (PrefetchTask *)refCon;
+	task->error = task->res->decompress(task->volVersion, task->stream);
+}
+
+void ResourceManager::prefetchRoom(uint16 roomNumber) {
+	_prefetchRoomNumber = roomNumber;
+
+	if (Common::ThreadPool::instance().getNumWorkers() == 0)
+		return;
+
+	Common::Array<ResourceId> ids;
+	if (_roomResources.contains(roomNumber)) {
+		ids = _roomResources[roomNumber];
+	} else {
+		ids.push_back(ResourceId(kResourceTypePic, roomNumber));
+		ids.push_back(ResourceId(kResourceTypeView, roomNumber));
+	}
+
+	// The packed data is read here, as the volume files are shared with the
+	// main thread; only the decompression runs on the worker threads. Stop
+	// at half of the LRU budget, so that prefetching does not evict what the
+	// previous rooms left behind for nothing.
+	Common::Array<PrefetchTask> tasks;
+	tasks.reserve(ids.size());
+	int prefetchedSize = 0;
+	for (uint i = 0; i < ids.size() && prefetchedSize < _maxMemoryLRU / 2; ++i) {
+		Resource *res = testResource(ids[i]);
+		if (!res || res->_status != kResStatusNoMalloc || !isPrefetchable(res))
+			continue;
+
+		Common::SeekableReadStream *fileStream = getVolumeFile(res->_source);
+		if (!fileStream)
+			continue;
+
+		fileStream->seek(0, SEEK_SET);
+		const ResourceType type = convertResType(fileStream->readByte());
+		ResVersion volVersion = _volVersion;
+		// Same as in ResourceSource::loadResource
+		if (((type == kResourceTypeMessage && res->getType() == kResourceTypeMessage) || (type == kResourceTypeText && res->getType() == kResourceTypeText)) && g_sci->getLanguage() == Common::KO_KOR)
+			volVersion = kResVersionSci11;
+
+		fileStream->seek(res->_fileOffset, SEEK_SET);
+		uint32 szPacked;
+		ResourceCompression compression;
+		if (res->readResourceInfo(volVersion, fileStream, szPacked, compression) == SCI_ERROR_NONE) {
+			const uint32 dataSize = fileStream->pos() - res->_fileOffset + szPacked;
+			byte *data = (byte *)malloc(dataSize);
+			fileStream->seek(res->_fileOffset, SEEK_SET);
+			if (data && fileStream->read(data, dataSize) == dataSize) {
+				PrefetchTask task;
+				task.res = res;
+				task.volVersion = volVersion;
+				task.stream = new Common::MemoryReadStream(data, dataSize, DisposeAfterUse::YES);
+				task.error = SCI_ERROR_NONE;
+				tasks.push_back(task);
+				prefetchedSize += res->_size;
+			} else {
+				free(data);
+			}
+		}
+
+		disposeVolumeFileStream(fileStream, res->_source);
+	}
+
+	if (tasks.empty())
+		return;
+
+	{
+		Common::TaskGroup group;
+		for (uint i = 0; i < tasks.size(); ++i)
+			group.run(&decompressPrefetched, &tasks[i]);
+		group.wait();
+	}
+
+	for (uint i = 0; i < tasks.size(); ++i) {
+		Resource *res = tasks[i].res;
+		delete tasks[i].stream;
+
+		if (tasks[i].error) {
+			warning("Error %d occurred while reading %s from resource file %s: %s",
+					tasks[i].error, res->_id.toString().c_str(), res->getResourceLocation().c_str(),
+					s_errorDescriptions[tasks[i].error]);
+			res->unalloc();
+			continue;
+		}
+
+		if (_patcher) {
+			_patcher->applyPatch(*res);
+		}
+		addToLRU(res);
+	}
+
+	debugC(kDebugLevelResMan, "resMan: Prefetched %u resources (%d bytes) for room %d", tasks.size(), prefetchedSize, roomNumber);
+	freeOldResources();
 }
 
 
@@ -1066,6 +1201,15 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Platforms with plenty of memory can keep many more resources around,
+	// and avoid decompressing them again on every visit of a room
+	if (ConfMan.hasKey("sci_resource_cache_size")) {
+		_maxMemoryLRU = MAX(ConfMan.getInt("sci_resource_cache_size"), 256) * 1024;
+	}
+
+	_prefetchRoomNumber = -1;
+	_roomResources.clear();
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
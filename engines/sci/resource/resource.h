@@ -383,6 +383,15 @@ public:
 	 */
 	Resource *testResource(ResourceId id);
 
+	/**
+	 * Loads the resources that the given room loaded the last time it was
+	 * entered, or its picture and view on the first time, decompressing them
+	 * on worker threads. The resources loaded from then on are recorded for
+	 * this room. Called on room changes, before the room script is loaded.
+	 * @param roomNumber	The number of the room being entered
+	 */
+	void prefetchRoom(uint16 roomNumber);
+
 	/**
 	 * Returns a list of all resources of the specified type.
 	 * @param type		The resource type to look for
@@ -490,6 +499,8 @@ protected:
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _prefetchRoomNumber; ///< Room whose loaded resources are recorded, or -1
+	Common::HashMap<uint16, Common::Array<ResourceId> > _roomResources; ///< Resources loaded by each room
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -551,6 +562,8 @@ protected:
 	void disposeVolumeFileStream(Common::SeekableReadStream *fileStream, ResourceSource *source);
 	void loadResource(Resource *res);
 	void freeOldResources();
+	bool isPrefetchable(const Resource *res) const;
+	static void decompressPrefetched(void *refCon);
 	bool validateResource(const ResourceId &resourceId, const Common::String &sourceMapLocation, const Common::String &sourceName, const uint32 offset, const uint32 size, const uint32 sourceSize) const;
 	Resource *addResource(ResourceId resId, ResourceSource *src, uint32 offset, uint32 size = 0, const Common::String &sourceMapLocation = Common::String("(no map location)"));
 	Resource *updateResource(ResourceId resId, ResourceSource *src, uint32 size, const Common::String &sourceMapLocation = Common::String("(no map location)"));
@@ -414,15 +414,9 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 			if (numSamples > (int)_monitoredBuffer.size()) {
 				_monitoredBuffer.resize(numSamples);
 			}
-			memset(_monitoredBuffer.data(), 0, _monitoredBuffer.size() * sizeof(Audio::st_sample_t));
+			memset(_monitoredBuffer.data(), 0, numSamples * sizeof(Audio::st_sample_t));
 			_numMonitoredSamples = writeAudioInternal(*channel.stream, *channel.converter, _monitoredBuffer.data(), numSamples, leftVolume, rightVolume);
-
-			Audio::st_sample_t *sourceBuffer = _monitoredBuffer.data();
-			Audio::st_sample_t *targetBuffer = buffer;
-			const Audio::st_sample_t *const end = _monitoredBuffer.data() + _numMonitoredSamples;
-			while (sourceBuffer != end) {
-				Audio::clampedAdd(*targetBuffer++, *sourceBuffer++);
-			}
+			Audio::clampedAddBuffer(buffer, _monitoredBuffer.data(), _numMonitoredSamples);
 
 			if (_numMonitoredSamples > maxSamplesWritten) {
 				maxSamplesWritten = _numMonitoredSamples;
@@ -351,6 +351,7 @@ RobotDecoder::RobotDecoder(SegManager *segMan) :
 	_segMan(segMan),
 	_status(kRobotStatusUninitialized),
 	_audioBuffer(nullptr),
+	_usePrefetchedCels(false),
 	_rawPalette((uint8 *)malloc(kRawPaletteSize)) {}
 
 RobotDecoder::~RobotDecoder() {
@@ -586,6 +587,14 @@ void RobotDecoder::close() {
 
 	debugC(kDebugLevelVideo, "Closing robot");
 
+	_prefetchTask.wait();
+	_prefetch.frameNo = -1;
+	_prefetch.hasVideoData = false;
+	_prefetch.ready = false;
+	_prefetch.videoData.clear();
+	_prefetch.cels.clear();
+	_prefetch.squashedCel.clear();
+
 	for (CelHandleList::size_type i = 0; i < _celHandles.size(); ++i) {
 		if (_celHandles[i].status == CelHandleInfo::kFrameLifetime) {
 			_segMan->freeBitmap(_celHandles[i].bitmapId);
@@ -1248,6 +1257,7 @@ void RobotDecoder::doRobot() {
 	if (_hasAudio) {
 		_audioList.submitDriverMax();
 	}
+	prefetchFrame(_currentFrameNo + 1);
 }
 
 void RobotDecoder::frameAlmostVisible() {
@@ -1331,10 +1341,10 @@ void RobotDecoder::frameNowVisible() {
 	}
 }
 
-void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWidth, const int16 celHeight) const {
+void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWidth, const int16 celHeight, const int verticalScaleFactor) {
 	assert(source != nullptr && target != nullptr);
 
-	const int sourceHeight = (celHeight * _verticalScaleFactor) / 100;
+	const int sourceHeight = (celHeight * verticalScaleFactor) / 100;
 	assert(sourceHeight > 0);
 
 	const int16 numerator = celHeight;
@@ -1365,12 +1375,21 @@ void RobotDecoder::setPriority(const int16 newPriority) {
 void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 	const RobotScreenItemList::size_type oldScreenItemCount = _screenItemList.size();
 	const int videoSize = _videoSizes[_currentFrameNo];
-	_doVersion5Scratch.resize(videoSize);
 
-	byte *videoFrameData = _doVersion5Scratch.begin();
+	// The worker only touches `_prefetch`, so it has to be done before the
+	// next frame is read either way
+	_prefetchTask.wait();
+
+	byte *videoFrameData;
+	if (_prefetch.hasVideoData && _prefetch.frameNo == _currentFrameNo) {
+		videoFrameData = _prefetch.videoData.begin();
+	} else {
+		_doVersion5Scratch.resize(videoSize);
+		videoFrameData = _doVersion5Scratch.begin();
 
-	if (!_stream->read(videoFrameData, videoSize)) {
-		error("RobotDecoder::doVersion5: Read error");
+		if (!_stream->read(videoFrameData, videoSize)) {
+			error("RobotDecoder::doVersion5: Read error");
+		}
 	}
 
 	const RobotScreenItemList::size_type screenItemCount = READ_SCI11ENDIAN_UINT16(videoFrameData);
@@ -1395,7 +1414,9 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 		_originalScreenItemY.resize(screenItemCount);
 	}
 
+	_usePrefetchedCels = _prefetch.ready && _prefetch.frameNo == _currentFrameNo && _prefetch.numCels == (int16)screenItemCount;
 	createCels5(videoFrameData + 2, screenItemCount, true);
+	_usePrefetchedCels = false;
 	for (RobotScreenItemList::size_type i = 0; i < screenItemCount; ++i) {
 		Common::Point position(_screenItemX[i], _screenItemY[i]);
 
@@ -1514,10 +1535,26 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 	assert(bitmap.getHunkPaletteOffset() == (uint32)bitmap.getWidth() * bitmap.getHeight() + SciBitmap::getBitmapHeaderSize());
 	bitmap.setOrigin(origin);
 
+	const ScratchMemory *prefetchedCel = _usePrefetchedCels ? &_prefetch.cels[screenItemIndex] : nullptr;
+	if (prefetchedCel && prefetchedCel->size() == (uint)(celWidth * celHeight)) {
+		// decompressed ahead by prefetchFrame
+		Common::copy(prefetchedCel->begin(), prefetchedCel->end(), bitmap.getPixels());
+	} else {
+		decompressCel5(rawVideoData, bitmap.getPixels(), celWidth, celHeight, numDataChunks);
+	}
+
+	if (usePalette) {
+		Common::copy(_rawPalette, _rawPalette + kRawPaletteSize, bitmap.getHunkPalette());
+	}
+
+	return kCelHeaderSize + dataSize;
+}
+
+void RobotDecoder::decompressCel5(const byte *rawVideoData, byte *target, const int16 celWidth, const int16 celHeight, const int16 numDataChunks) {
 	byte *targetBuffer;
 	if (_verticalScaleFactor == 100) {
 		// direct copy to bitmap
-		targetBuffer = bitmap.getPixels();
+		targetBuffer = target;
 	} else {
 		// go through squashed cel decompressor
 		_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
@@ -1548,14 +1585,122 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 	}
 
 	if (_verticalScaleFactor != 100) {
-		expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight);
+		expandCel(target, _celDecompressionBuffer.begin(), celWidth, celHeight, _verticalScaleFactor);
 	}
+}
 
-	if (usePalette) {
-		Common::copy(_rawPalette, _rawPalette + kRawPaletteSize, bitmap.getHunkPalette());
+void RobotDecoder::prefetchFrame(const int frameNo) {
+	if (frameNo >= _numFramesTotal || Common::ThreadPool::instance().getNumWorkers() == 0) {
+		return;
 	}
 
-	return kCelHeaderSize + dataSize;
+	_prefetchTask.wait();
+	_prefetch.frameNo = frameNo;
+	_prefetch.hasVideoData = false;
+	_prefetch.ready = false;
+
+	// The stream is not thread safe, so the data is read here, and only the
+	// decompression is left to the worker
+	const int videoSize = _videoSizes[frameNo];
+	if (videoSize < 2) {
+		return;
+	}
+	_prefetch.videoData.resize(videoSize);
+	seekToFrame(frameNo);
+	if (_stream->read(_prefetch.videoData.begin(), videoSize) != (uint32)videoSize) {
+		return;
+	}
+	_prefetch.hasVideoData = true;
+
+	_prefetchTask.run(&decompressPrefetchedCels, &_prefetch);
+}
+
+void RobotDecoder::decompressPrefetchedCels(void *refCon) {
+	FramePrefetch &prefetch = *(FramePrefetch *)refCon;
+	const byte *rawVideoData = prefetch.videoData.begin();
+	const byte *const end = prefetch.videoData.end();
+
+	const int16 numCels = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData);
+	if (numCels < 0 || numCels > kScreenItemListSize) {
+		return;
+	}
+	rawVideoData += 2;
+
+	if (prefetch.cels.size() < (uint)numCels) {
+		prefetch.cels.resize(numCels);
+	}
+	prefetch.numCels = numCels;
+
+	for (int16 cel = 0; cel < numCels; ++cel) {
+		if (end - rawVideoData < kCelHeaderSize) {
+			return;
+		}
+
+		const int verticalScaleFactor = rawVideoData[1];
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 4);
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(rawVideoData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 16);
+		const int sourceHeight = celHeight * verticalScaleFactor / 100;
+		if (celWidth <= 0 || celHeight <= 0 || sourceHeight <= 0 || end - rawVideoData < kCelHeaderSize + dataSize) {
+			return;
+		}
+
+		ScratchMemory &pixels = prefetch.cels[cel];
+		pixels.resize(celWidth * celHeight);
+		byte *targetBuffer = pixels.begin();
+		uint targetSize = pixels.size();
+		if (verticalScaleFactor != 100) {
+			prefetch.squashedCel.resize(celWidth * sourceHeight);
+			targetBuffer = prefetch.squashedCel.begin();
+			targetSize = prefetch.squashedCel.size();
+		}
+
+		const byte *chunk = rawVideoData + kCelHeaderSize;
+		const byte *const chunksEnd = chunk + dataSize;
+		for (int16 i = 0; i < numDataChunks; ++i) {
+			if (chunksEnd - chunk < 10) {
+				return;
+			}
+			const uint compressedSize = READ_SCI11ENDIAN_UINT32(chunk);
+			const uint decompressedSize = READ_SCI11ENDIAN_UINT32(chunk + 4);
+			const uint16 compressionType = READ_SCI11ENDIAN_UINT16(chunk + 8);
+			chunk += 10;
+			if ((uint)(chunksEnd - chunk) < compressedSize || targetSize < decompressedSize) {
+				return;
+			}
+
+			switch (compressionType) {
+			case kCompressionLZS: {
+				Common::MemoryReadStream videoDataStream(chunk, compressedSize, DisposeAfterUse::NO);
+				if (prefetch.decompressor.unpack(&videoDataStream, targetBuffer, compressedSize, decompressedSize) != 0) {
+					return;
+				}
+				break;
+			}
+			case kCompressionNone:
+				if (compressedSize < decompressedSize) {
+					return;
+				}
+				Common::copy(chunk, chunk + decompressedSize, targetBuffer);
+				break;
+			default:
+				return;
+			}
+
+			chunk += compressedSize;
+			targetBuffer += decompressedSize;
+			targetSize -= decompressedSize;
+		}
+
+		if (verticalScaleFactor != 100) {
+			expandCel(pixels.begin(), prefetch.squashedCel.begin(), celWidth, celHeight, verticalScaleFactor);
+		}
+
+		rawVideoData += kCelHeaderSize + dataSize;
+	}
+
+	prefetch.ready = true;
 }
 
 void RobotDecoder::preallocateCelMemory(const byte *rawVideoData, const int16 numCels) {
@@ -29,6 +29,7 @@
 #include "common/mutex.h"                // for StackLock, Mutex
 #include "common/rect.h"                 // for Point, Rect (ptr only)
 #include "common/scummsys.h"             // for int16, int32, byte, uint16
+#include "common/threadpool.h"           // for TaskGroup
 #include "sci/engine/vm_types.h"         // for NULL_REG, reg_t
 #include "sci/graphics/helpers.h"        // for GuiResourceId
 #include "sci/graphics/screen_item32.h"  // for ScaleInfo, ScreenItem (ptr o...
@@ -1154,7 +1155,7 @@ public:
 	 * Scales a vertically compressed cel to its original uncompressed
 	 * dimensions.
 	 */
-	void expandCel(byte *target, const byte* source, const int16 celWidth, const int16 celHeight) const;
+	static void expandCel(byte *target, const byte* source, const int16 celWidth, const int16 celHeight, const int verticalScaleFactor);
 
 	int16 getPriority() const;
 
@@ -1227,6 +1228,11 @@ private:
 	 */
 	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette);
 
+	/**
+	 * Decompresses the data chunks of a version 5/6 cel into `target`.
+	 */
+	void decompressCel5(const byte *rawVideoData, byte *target, const int16 celWidth, const int16 celHeight, const int16 numDataChunks);
+
 	/**
 	 * Preallocates memory for the next `numCels` cels in the robot data stream.
 	 */
@@ -1237,6 +1243,77 @@ private:
 	 */
 	DecompressorLZS _decompressor;
 
+	/**
+	 * The cels of the frame following the one on screen, decompressed by a
+	 * worker thread while the current frame is shown.
+	 */
+	struct FramePrefetch {
+		FramePrefetch() : frameNo(-1), hasVideoData(false), ready(false), numCels(0) {}
+
+		/**
+		 * The frame number of the prefetched data, or -1.
+		 */
+		int frameNo;
+
+		/**
+		 * Whether `videoData` holds the whole raw video data of the frame.
+		 */
+		bool hasVideoData;
+
+		/**
+		 * Whether the worker finished decompressing every cel of the frame.
+		 * Left false when the data is not understood, in which case the
+		 * frame is decoded again on the main thread, which reports the error.
+		 */
+		bool ready;
+
+		/**
+		 * The raw video data of the frame, read on the main thread.
+		 */
+		ScratchMemory videoData;
+
+		/**
+		 * The fully expanded pixels of each cel. The buffers are reused from
+		 * one frame to the next.
+		 */
+		Common::Array<ScratchMemory> cels;
+		int16 numCels;
+
+		/**
+		 * Scratch memory for vertically squashed cels.
+		 */
+		ScratchMemory squashedCel;
+
+		/**
+		 * The decompressor used by the worker thread.
+		 */
+		DecompressorLZS decompressor;
+	};
+
+	/**
+	 * Reads the given frame and starts decompressing its cels on a worker
+	 * thread, if there are any.
+	 */
+	void prefetchFrame(const int frameNo);
+
+	/**
+	 * Decompresses the cels of a FramePrefetch. Runs on a worker thread.
+	 */
+	static void decompressPrefetchedCels(void *refCon);
+
+	FramePrefetch _prefetch;
+
+	/**
+	 * The task decompressing `_prefetch`. Declared after it, so it is waited
+	 * for before the buffers go away.
+	 */
+	Common::TaskGroup _prefetchTask;
+
+	/**
+	 * Whether createCel5 should take the pixels of the cels from `_prefetch`.
+	 */
+	bool _usePrefetchedCels;
+
 	/**
 	 * The ID of the robot plane.
 	 */
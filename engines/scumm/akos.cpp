@@ -539,7 +539,8 @@ byte AkosRenderer::drawLimb(const Actor *a, int limb) {
 	return result;
 }
 
-void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
+template<bool scaled, bool shadowed>
+void AkosRenderer::codec1_decode(Codec1 &v1) {
 	const byte *mask, *src;
 	byte *dst;
 	byte len, maskbit;
@@ -571,7 +572,7 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 			len = *src++;
 
 		do {
-			if (_scaleY == 255 || *scaleytab++ < _scaleY) {
+			if (!scaled || _scaleY == 255 || *scaleytab++ < _scaleY) {
 				if (_actorHitMode) {
 					if (color && y == _actorHitY && v1.x == _actorHitX) {
 						_actorHitResult = true;
@@ -582,12 +583,12 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 
 					if (color && !masked && !skip_column) {
 						pcolor = _palette[color];
-						if (_shadow_mode == 1) {
+						if (shadowed && _shadow_mode == 1) {
 							if (pcolor == 13)
 								pcolor = _shadow_table[*dst];
-						} else if (_shadow_mode == 2) {
+						} else if (shadowed && _shadow_mode == 2) {
 							error("codec1_spec2"); // TODO
-						} else if (_shadow_mode == 3) {
+						} else if (shadowed && _shadow_mode == 3) {
 							if (_vm->_game.features & GF_16BIT_COLOR) {
 								uint16 srcColor = (pcolor >> 1) & 0x7DEF;
 								uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
@@ -619,7 +620,7 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 
 				scaleytab = &v1.scaletable[v1.scaleYindex];
 
-				if (_scaleX == 255 || v1.scaletable[v1.scaleXindex] < _scaleX) {
+				if (!scaled || _scaleX == 255 || v1.scaletable[v1.scaleXindex] < _scaleX) {
 					v1.x += v1.scaleXstep;
 					if (v1.x < 0 || v1.x >= v1.boundsRect.right)
 						return;
@@ -637,6 +638,23 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	} while (1);
 }
 
+void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
+	// Most actors are drawn unscaled and without shadows, leave out
+	// their checks from the pixel loop then
+	const bool scaled = (_scaleX != 255 || _scaleY != 255);
+	if (scaled) {
+		if (_shadow_mode)
+			codec1_decode<true, true>(v1);
+		else
+			codec1_decode<true, false>(v1);
+	} else {
+		if (_shadow_mode)
+			codec1_decode<false, true>(v1);
+		else
+			codec1_decode<false, false>(v1);
+	}
+}
+
 // This is exact duplicate of smallCostumeScaleTable[] in costume.cpp
 // See FIXME below for explanation
 const byte smallCostumeScaleTableAKOS[256] = {
@@ -1234,16 +1234,53 @@ void CharsetRendererClassic::drawChar(int chr, Graphics::Surface &s, int x, int
 		drawBitsN(s, dst, _charPtr, *_fontPtr, y, _width, _height);
 }
 
+void CharsetRendererClassic::invalidateCharset(int id) {
+	// The glyphs are looked up by their address, which a reloaded charset may reuse
+	_glyphCache.clear(true);
+	_glyphCacheSize = 0;
+}
+
+const CharsetRendererClassic::DecodedGlyph &CharsetRendererClassic::getDecodedGlyph(const byte *src, byte bpp, int width, int height) {
+	GlyphCache::iterator i = _glyphCache.find(src);
+	if (i != _glyphCache.end() && i->_value.width == width && i->_value.height == height)
+		return i->_value;
+
+	if (_glyphCacheSize + width * height > kMaxGlyphCacheSize) {
+		_glyphCache.clear(true);
+		_glyphCacheSize = 0;
+	}
+
+	DecodedGlyph &glyph = _glyphCache[src];
+	_glyphCacheSize -= glyph.pixels.size();
+	glyph.width = width;
+	glyph.height = height;
+	glyph.pixels.resize(width * height);
+	_glyphCacheSize += glyph.pixels.size();
+
+	// The lines are not byte aligned, the bits of a line follow the ones of the previous line
+	byte bits = *src++;
+	byte numbits = 8;
+	for (uint p = 0; p < glyph.pixels.size(); p++) {
+		glyph.pixels[p] = (bits >> (8 - bpp)) & 0xFF;
+		bits <<= bpp;
+		numbits -= bpp;
+		if (numbits == 0) {
+			bits = *src++;
+			numbits = 8;
+		}
+	}
+
+	return glyph;
+}
+
 void CharsetRendererClassic::drawBitsN(const Graphics::Surface &s, byte *dst, const byte *src, byte bpp, int drawTop, int width, int height) {
 	int y, x;
 	int color;
-	byte numbits, bits;
 
 	int pitch = s.pitch - width;
 
 	assert(bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8);
-	bits = *src++;
-	numbits = 8;
+	const byte *pixels = getDecodedGlyph(src, bpp, width, height).pixels.begin();
 	byte *cmap = _vm->_charsetColorMap;
 
 	// Indy4 Amiga always uses the room or verb palette map to match colors to
@@ -1258,22 +1295,22 @@ void CharsetRendererClassic::drawBitsN(const Graphics::Surface &s, byte *dst, co
 	}
 
 	for (y = 0; y < height && y + drawTop < s.h; y++) {
+		if (y + drawTop < 0) {
+			pixels += width;
+			dst += width + pitch;
+			continue;
+		}
+
 		for (x = 0; x < width; x++) {
-			color = (bits >> (8 - bpp)) & 0xFF;
+			color = *pixels++;
 
-			if (color && y + drawTop >= 0) {
+			if (color) {
 				if (amigaMap)
 					*dst = amigaMap[cmap[color]];
 				else
 					*dst = cmap[color];
 			}
 			dst++;
-			bits <<= bpp;
-			numbits -= bpp;
-			if (numbits == 0) {
-				bits = *src++;
-				numbits = 8;
-			}
 		}
 		dst += pitch;
 	}
@@ -24,6 +24,9 @@
 #define SCUMM_CHARSET_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/hash-ptr.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 #include "graphics/sjis.h"
 #include "scumm/scumm.h"
@@ -103,6 +106,9 @@ public:
 	virtual void setCurID(int32 id) = 0;
 	int getCurID() { return _curId; }
 
+	/** Called when the resource of a charset is freed or changed. */
+	virtual void invalidateCharset(int id) {}
+
 	virtual int getFontHeight() = 0;
 	virtual int getCharHeight(byte chr) { return getFontHeight(); }
 	virtual int getCharWidth(uint16 chr) = 0;
@@ -149,6 +155,21 @@ public:
 };
 
 class CharsetRendererClassic : public CharsetRendererPC {
+	/** The color indices of a glyph, one byte per pixel. */
+	struct DecodedGlyph {
+		int width, height;
+		Common::Array<byte> pixels;
+	};
+
+	// Enough for the glyphs of a few charsets
+	static const uint32 kMaxGlyphCacheSize = 256 * 1024;
+
+	typedef Common::HashMap<const byte *, DecodedGlyph> GlyphCache;
+	GlyphCache _glyphCache;
+	uint32 _glyphCacheSize;
+
+	const DecodedGlyph &getDecodedGlyph(const byte *src, byte bpp, int width, int height);
+
 protected:
 	virtual void drawBitsN(const Graphics::Surface &s, byte *dst, const byte *src, byte bpp, int drawTop, int width, int height);
 	void printCharIntern(bool is2byte, const byte *charPtr, int origWidth, int origHeight, int width, int height, VirtScreen *vs, bool ignoreCharsetMask);
@@ -162,10 +183,11 @@ protected:
 	VirtScreenNumber _drawScreen;
 
 public:
-	CharsetRendererClassic(ScummEngine *vm) : CharsetRendererPC(vm) {}
+	CharsetRendererClassic(ScummEngine *vm) : CharsetRendererPC(vm), _glyphCacheSize(0) {}
 
 	void printChar(int chr, bool ignoreCharsetMask) override;
 	void drawChar(int chr, Graphics::Surface &s, int x, int y) override;
+	void invalidateCharset(int id) override;
 
 	int getCharWidth(uint16 chr) override;
 };
@@ -434,14 +434,6 @@ extern "C" int ClassicProc3RendererShadowARM(int _scaleY,
 #endif
 
 void ClassicCostumeRenderer::proc3(Codec1 &v1) {
-	const byte *mask, *src;
-	byte *dst;
-	byte len, maskbit;
-	int y;
-	uint color, height, pcolor;
-	byte scaleIndexY;
-	bool masked;
-
 #ifdef USE_ARM_COSTUME_ASM
 	if (((_shadow_mode & 0x20) == 0) &&
 	    (v1.mask_ptr != NULL) &&
@@ -462,6 +454,33 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 	}
 #endif /* USE_ARM_COSTUME_ASM */
 
+	// Most actors are drawn unscaled and without shadows, leave out
+	// their checks from the pixel loop then
+	const bool scaled = (_scaleX != 255 || _scaleY != 255);
+	const bool shadowed = ((_shadow_mode & 0x20) || _shadow_table);
+	if (scaled) {
+		if (shadowed)
+			proc3Decode<true, true>(v1);
+		else
+			proc3Decode<true, false>(v1);
+	} else {
+		if (shadowed)
+			proc3Decode<false, true>(v1);
+		else
+			proc3Decode<false, false>(v1);
+	}
+}
+
+template<bool scaled, bool shadowed>
+void ClassicCostumeRenderer::proc3Decode(Codec1 &v1) {
+	const byte *mask, *src;
+	byte *dst;
+	byte len, maskbit;
+	int y;
+	uint color, height, pcolor;
+	byte scaleIndexY;
+	bool masked;
+
 	y = v1.y;
 	src = _srcptr;
 	dst = v1.destptr;
@@ -484,11 +503,13 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 			len = *src++;
 
 		do {
-			if (_scaleY == 255 || v1.scaletable[scaleIndexY++] < _scaleY) {
+			if (!scaled || _scaleY == 255 || v1.scaletable[scaleIndexY++] < _scaleY) {
 				masked = (y < 0 || y >= _out.h) || (v1.x < 0 || v1.x >= _out.w) || (v1.mask_ptr && (mask[0] & maskbit));
 
 				if (color && !masked) {
-					if (_shadow_mode & 0x20) {
+					if (!shadowed) {
+						pcolor = _palette[color];
+					} else if (_shadow_mode & 0x20) {
 						pcolor = _shadow_table[*dst];
 					} else {
 						pcolor = _palette[color];
@@ -509,7 +530,7 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 
 				scaleIndexY = _scaleIndexY;
 
-				if (_scaleX == 255 || v1.scaletable[_scaleIndexX] < _scaleX) {
+				if (!scaled || _scaleX == 255 || v1.scaletable[_scaleIndexX] < _scaleX) {
 					v1.x += v1.scaleXstep;
 					if (v1.x < 0 || v1.x >= _out.w)
 						return;
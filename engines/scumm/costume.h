@@ -99,6 +99,7 @@ protected:
 	byte drawLimb(const Actor *a, int limb) override;
 
 	void proc3(Codec1 &v1);
+	template<bool scaled, bool shadowed> void proc3Decode(Codec1 &v1);
 	void proc3_ami(Codec1 &v1);
 
 	void procC64(Codec1 &v1, int actor);
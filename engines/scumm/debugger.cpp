@@ -30,6 +30,11 @@
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
 #include "scumm/imuse/imuse.h"
+#ifdef ENABLE_SCUMM_7_8
+#include "scumm/imuse_digi/dimuse.h"
+#include "scumm/imuse_digi/dimuse_bndmgr.h"
+#include "scumm/imuse_digi/dimuse_sndmgr.h"
+#endif
 #include "scumm/object.h"
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
@@ -166,6 +171,20 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 				debugPrintf("Specify a music resource # or \"all\".\n");
 			}
 			return true;
+#ifdef ENABLE_SCUMM_7_8
+		} else if (!strcmp(argv[1], "bundles") && _vm->_imuseDigital) {
+			BundleDirCache *cache = _vm->_imuseDigital->getSndMgr()->getBundleDirCache();
+			debugPrintf("Bundle                hits   misses  prefetched  hit rate\n");
+			for (int slot = 0; slot < cache->getNumSlots(); slot++) {
+				if (!cache->getFileName(slot)[0])
+					continue;
+				const BundleDirCache::BlockStats &stats = cache->getBlockStats(slot);
+				const uint32 reads = stats.hits + stats.misses;
+				debugPrintf("%-18s %7u  %7u  %10u  %7u%%\n", cache->getFileName(slot), stats.hits, stats.misses,
+							stats.prefetches, reads ? stats.hits * 100 / reads : 0);
+			}
+			return true;
+#endif
 		}
 	}
 
@@ -173,6 +192,10 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 	debugPrintf("  panic - Stop all music tracks\n");
 	debugPrintf("  play # - Play a music resource\n");
 	debugPrintf("  stop # - Stop a music resource\n");
+#ifdef ENABLE_SCUMM_7_8
+	if (_vm->_imuseDigital)
+		debugPrintf("  bundles - Show the block cache hit rates of the bundles\n");
+#endif
 	return true;
 }
 
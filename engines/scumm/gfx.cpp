@@ -215,9 +215,12 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	memset(&_stripCache, 0, sizeof(_stripCache));
 }
 
 Gdi::~Gdi() {
+	invalidateStripCache();
 }
 
 GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(0) {
@@ -1021,7 +1024,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbRoomBackground);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1829,6 +1832,10 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// Only the room background is cached, as drawn by redrawBGStrip()
+	const bool useStripCache = flag == dbRoomBackground && !y && height == vs->h && vs->number == kMainVirtScreen &&
+		canCacheStrips() && prepareStripCache(ptr, vs, height, numzbuf);
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1861,7 +1868,12 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const bool cached = useStripCache && restoreCachedStrip(dstPtr, vs, x, y, stripnr, numzbuf, zplane_list);
+		if (!cached)
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		else
+			transpStrip = false;
+		const bool decodedTranspStrip = transpStrip;
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -1875,7 +1887,12 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!cached) {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			if (useStripCache && !decodedTranspStrip)
+				storeCachedStrip(dstPtr, vs, x, y, stripnr, numzbuf, zplane_list);
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -2274,6 +2291,99 @@ void ScummEngine_v70he::restoreBackgroundHE(Common::Rect rect, int dirtybit) {
 }
 #endif
 
+void Gdi::invalidateStripCache() {
+	free(_stripCache.pixels);
+	free(_stripCache.masks);
+	free(_stripCache.cached);
+	memset(&_stripCache, 0, sizeof(_stripCache));
+}
+
+bool Gdi::prepareStripCache(const byte *ptr, VirtScreen *vs, const int height, int numzbuf) {
+	// The room palette map may be changed by the scripts while in the room
+	if (_stripCache.cached && (_stripCache.room != ptr || _stripCache.height != height ||
+			_stripCache.bytesPerPixel != vs->format.bytesPerPixel || _stripCache.numZBuffer != numzbuf ||
+			memcmp(_stripCache.palette, _vm->_roomPalette, sizeof(_stripCache.palette))))
+		invalidateStripCache();
+
+	if (!_stripCache.cached) {
+		const int numStrips = _vm->_roomWidth / 8;
+		const int numMasks = MAX(numzbuf - 1, 0);
+		if (numStrips <= 0)
+			return false;
+
+		_stripCache.pixels = (byte *)malloc(numStrips * height * 8 * vs->format.bytesPerPixel);
+		_stripCache.masks = numMasks ? (byte *)malloc(numStrips * numMasks * height) : 0;
+		_stripCache.cached = (bool *)calloc(numStrips, sizeof(bool));
+		if (!_stripCache.pixels || (numMasks && !_stripCache.masks) || !_stripCache.cached) {
+			invalidateStripCache();
+			return false;
+		}
+
+		_stripCache.room = ptr;
+		_stripCache.numStrips = numStrips;
+		_stripCache.height = height;
+		_stripCache.bytesPerPixel = vs->format.bytesPerPixel;
+		_stripCache.numZBuffer = numzbuf;
+		memcpy(_stripCache.palette, _vm->_roomPalette, sizeof(_stripCache.palette));
+	}
+
+	return true;
+}
+
+bool Gdi::restoreCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, int stripnr,
+                int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr < 0 || stripnr >= _stripCache.numStrips || !_stripCache.cached[stripnr])
+		return false;
+
+	const int height = _stripCache.height;
+	const int stripPitch = 8 * _stripCache.bytesPerPixel;
+	const byte *src = _stripCache.pixels + stripnr * height * stripPitch;
+	for (int h = 0; h < height; h++) {
+		memcpy(dstPtr, src, stripPitch);
+		dstPtr += vs->pitch;
+		src += stripPitch;
+	}
+
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		const byte *mask = _stripCache.masks + ((i - 1) * _stripCache.numStrips + stripnr) * height;
+		for (int h = 0; h < height; h++)
+			mask_ptr[h * _numStrips] = mask[h];
+	}
+
+	return true;
+}
+
+void Gdi::storeCachedStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, int stripnr,
+                int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr < 0 || stripnr >= _stripCache.numStrips)
+		return;
+
+	const int height = _stripCache.height;
+	const int stripPitch = 8 * _stripCache.bytesPerPixel;
+	byte *dst = _stripCache.pixels + stripnr * height * stripPitch;
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, dstPtr, stripPitch);
+		dstPtr += vs->pitch;
+		dst += stripPitch;
+	}
+
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		byte *mask = _stripCache.masks + ((i - 1) * _stripCache.numStrips + stripnr) * height;
+		for (int h = 0; h < height; h++)
+			mask[h] = mask_ptr[h * _numStrips];
+	}
+
+	_stripCache.cached[stripnr] = true;
+}
+
 /**
  * Reset the background behind an actor or blast object.
  */
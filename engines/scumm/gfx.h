@@ -209,6 +209,24 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * The decoded strips and masks of the current room background. Drawing
+	 * a strip which was already decoded, e.g. when scrolling back or after
+	 * an object moved, then only copies it. Strips with transparent pixels
+	 * depend on what was drawn before, and are always decoded.
+	 */
+	struct StripCache {
+		const byte *room;
+		int numStrips;
+		int height;
+		int bytesPerPixel;
+		int numZBuffer;
+		byte palette[256];
+		byte *pixels;
+		byte *masks;
+		bool *cached;
+	} _stripCache;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -256,6 +274,15 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
 
+	/** Whether the room strips are decoded by drawStrip() and decodeMask() alone, and can be cached. */
+	virtual bool canCacheStrips() const { return true; }
+
+	bool prepareStripCache(const byte *ptr, VirtScreen *vs, const int height, int numzbuf);
+	bool restoreCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, int stripnr,
+	                int numzbuf, const byte *zplane_list[9]);
+	void storeCachedStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, int stripnr,
+	                int numzbuf, const byte *zplane_list[9]);
+
 public:
 	Gdi(ScummEngine *vm);
 	virtual ~Gdi();
@@ -279,10 +306,14 @@ public:
 
 	void resetBackground(int top, int bottom, int strip);
 
+	/** Forget the decoded room strips, to be called when the room changes. */
+	void invalidateStripCache();
+
 	enum DrawBitmapFlags {
-		dbAllowMaskOr   = 1 << 0,
-		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbAllowMaskOr    = 1 << 0,
+		dbDrawMaskOnAll  = 1 << 1,
+		dbObjectMode     = 2 << 2,
+		dbRoomBackground = 1 << 4
 	};
 };
 
@@ -300,6 +331,8 @@ protected:
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
+
+	bool canCacheStrips() const override { return false; }
 public:
 	GdiHE(ScummEngine *vm);
 };
@@ -333,6 +366,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiNES(ScummEngine *vm);
 
@@ -376,6 +411,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiPCEngine(ScummEngine *vm);
 	~GdiPCEngine() override;
@@ -413,6 +450,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiV1(ScummEngine *vm);
 
@@ -439,6 +478,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiV2(ScummEngine *vm);
 	~GdiV2() override;
@@ -232,6 +232,8 @@ protected:
 
 	void clearDrawQueues() override;
 
+	void resourceChanged(ResType type, ResId idx) override;
+
 	int getStringCharWidth(byte chr);
 	void appendSubstring(int dst, int src, int len2, int len);
 	void adjustRect(Common::Rect &rect);
@@ -257,6 +257,13 @@ void ScummEngine_v70he::readGlobalObjects() {
 }
 
 #ifdef ENABLE_HE
+void ScummEngine_v71he::resourceChanged(ResType type, ResId idx) {
+	ScummEngine_v70he::resourceChanged(type, idx);
+
+	if (type == rtImage)
+		_wiz->invalidateDecodedImage(idx);
+}
+
 void ScummEngine_v99he::readMAXS(int blockSize) {
 	if (blockSize == 52) {
 		_numVariables = _fileHandle->readUint16LE();
@@ -33,6 +33,14 @@
 #include "scumm/he/wiz_he.h"
 #include "scumm/he/moonbase/moonbase.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WIZ_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define WIZ_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Scumm {
 
 Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
@@ -41,6 +49,13 @@ Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_decodedImagesSize = 0;
+	_decodedImagesCounter = 0;
+}
+
+Wiz::~Wiz() {
+	while (!_decodedImages.empty())
+		freeDecodedImage(_decodedImages.begin());
 }
 
 void Wiz::clearWizBuffer() {
@@ -1581,7 +1596,7 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 		y1 = 0;
 		width = rScreen.width();
 		height = rScreen.height();
-	} else {
+	} else if (mask || !drawDecodedImage(dst, dataPtr, resNum, state, dstPitch, dstType, cw, ch, x1, y1, &rScreen, flags, palPtr, xmapPtr)) {
 		drawWizImageEx(dst, dataPtr, mask, dstPitch, dstType, cw, ch, x1, y1, width, height,
 			state, &rScreen, flags, palPtr, transColor, _vm->_bytesPerPixel, xmapPtr, conditionBits);
 	}
@@ -1602,6 +1617,211 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 	return dst;
 }
 
+void Wiz::invalidateDecodedImage(int resNum) {
+	DecodedImageMap::iterator it = _decodedImages.begin();
+	while (it != _decodedImages.end()) {
+		DecodedImageMap::iterator cur = it++;
+		if ((int)(cur->_key >> 16) == resNum)
+			freeDecodedImage(cur);
+	}
+}
+
+void Wiz::freeDecodedImage(DecodedImageMap::iterator it) {
+	DecodedImage *image = it->_value;
+	_decodedImagesSize -= image->width * image->height * 4;
+	delete[] image->pixels;
+	delete[] image->mask;
+	delete image;
+	_decodedImages.erase(it);
+}
+
+#ifdef USE_RGB_COLOR
+// Walk over the lines of a compressed image as decompressWizImage does, and
+// mark the pixels it draws
+static void markDrawnPixels(uint16 *mask, const uint8 *src, int width, int height, int pixelSize) {
+	memset(mask, 0, width * height * 2);
+	for (int y = 0; y < height; ++y) {
+		uint16 lineSize = READ_LE_UINT16(src); src += 2;
+		const uint8 *srcNext = src + lineSize;
+		uint16 *line = mask + y * width;
+		int x = 0;
+		if (lineSize != 0) {
+			while (x < width) {
+				uint8 code = *src++;
+				if (code & 1) {
+					x += code >> 1;
+					continue;
+				}
+				int count = (code >> 2) + 1;
+				src += (code & 2) ? pixelSize : count * pixelSize;
+				count = MIN(count, width - x);
+				while (count--)
+					line[x++] = 0xFFFF;
+			}
+		}
+		src = srcNext;
+	}
+}
+
+static inline uint16 shadowColor(uint16 srcColor, uint16 dstColor) {
+	return ((srcColor >> 1) & 0x7DEF) + ((dstColor >> 1) & 0x7DEF);
+}
+
+template<bool shadow>
+static void blitDecodedLine(uint16 *dst, const uint16 *src, const uint16 *mask, int count) {
+	int i = 0;
+#if defined(WIZ_USE_SSE2)
+	const __m128i half = _mm_set1_epi16(0x7DEF);
+	for (; i + 8 <= count; i += 8) {
+		__m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+		const __m128i m = _mm_loadu_si128((const __m128i *)(mask + i));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+		if (shadow)
+			s = _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(s, 1), half), _mm_and_si128(_mm_srli_epi16(d, 1), half));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, d)));
+	}
+#elif defined(WIZ_USE_NEON)
+	const uint16x8_t half = vdupq_n_u16(0x7DEF);
+	for (; i + 8 <= count; i += 8) {
+		uint16x8_t s = vld1q_u16(src + i);
+		const uint16x8_t m = vld1q_u16(mask + i);
+		const uint16x8_t d = vld1q_u16(dst + i);
+		if (shadow)
+			s = vaddq_u16(vandq_u16(vshrq_n_u16(s, 1), half), vandq_u16(vshrq_n_u16(d, 1), half));
+		vst1q_u16(dst + i, vbslq_u16(m, s, d));
+	}
+#endif
+	for (; i < count; ++i) {
+		if (mask[i])
+			dst[i] = shadow ? shadowColor(src[i], dst[i]) : src[i];
+	}
+}
+
+template<bool shadow>
+static void blitDecodedLineFlipped(uint16 *dst, const uint16 *src, const uint16 *mask, int count) {
+	for (int i = 0; i < count; ++i) {
+		const int j = count - 1 - i;
+		if (mask[j])
+			dst[i] = shadow ? shadowColor(src[j], dst[i]) : src[j];
+	}
+}
+
+Wiz::DecodedImage *Wiz::getDecodedImage(int resNum, int state, const uint8 *wizd, int comp, int width, int height, const uint8 *palPtr) {
+	const uint32 key = (resNum << 16) | state;
+	DecodedImageMap::iterator it = _decodedImages.find(key);
+	if (it != _decodedImages.end()) {
+		DecodedImage *image = it->_value;
+		if (image->wizd == wizd && image->width == width && image->height == height &&
+				image->hasPalette == (palPtr != NULL) && (!palPtr || !memcmp(image->palette, palPtr, sizeof(image->palette)))) {
+			image->lastUsed = ++_decodedImagesCounter;
+			return image;
+		}
+		freeDecodedImage(it);
+	}
+
+	// Make room by dropping the images which were drawn the longest ago
+	const uint32 size = width * height * 4;
+	while (!_decodedImages.empty() && _decodedImagesSize + size > kDecodedImagesSize) {
+		DecodedImageMap::iterator oldest = _decodedImages.begin();
+		for (it = _decodedImages.begin(); it != _decodedImages.end(); ++it) {
+			if (it->_value->lastUsed < oldest->_value->lastUsed)
+				oldest = it;
+		}
+		freeDecodedImage(oldest);
+	}
+
+	DecodedImage *image = new DecodedImage;
+	image->wizd = wizd;
+	image->hasPalette = (palPtr != NULL);
+	if (palPtr)
+		memcpy(image->palette, palPtr, sizeof(image->palette));
+	image->width = width;
+	image->height = height;
+	image->pixels = new uint16[width * height];
+	image->mask = new uint16[width * height];
+	image->lastUsed = ++_decodedImagesCounter;
+
+	memset(image->pixels, 0, width * height * 2);
+	const Common::Rect r(width, height);
+	if (comp == 5) {
+		decompress16BitWizImage<kWizCopy>((uint8 *)image->pixels, width * 2, kDstScreen, wizd, r, 0);
+	} else if (palPtr) {
+		decompressWizImage<kWizRMap>((uint8 *)image->pixels, width * 2, kDstScreen, wizd, r, 0, palPtr, NULL, 2);
+	} else {
+		decompressWizImage<kWizCopy>((uint8 *)image->pixels, width * 2, kDstScreen, wizd, r, 0, NULL, NULL, 2);
+	}
+	markDrawnPixels(image->mask, wizd, width, height, (comp == 5) ? 2 : 1);
+
+	_decodedImages[key] = image;
+	_decodedImagesSize += size;
+	return image;
+}
+#endif
+
+bool Wiz::drawDecodedImage(uint8 *dst, uint8 *dataPtr, int resNum, int state, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr) {
+#ifdef USE_RGB_COLOR
+	if (_vm->_bytesPerPixel != 2 || dstType != kDstScreen || (flags & (kWIFZPlaneOn | kWIFZPlaneOff)) ||
+			resNum < 0 || resNum > 0xFFFF || state < 0 || state > 0xFFFF)
+		return false;
+
+	uint8 *wizh = _vm->findWrappedBlock(MKTAG('W','I','Z','H'), dataPtr, state, 0);
+	assert(wizh);
+	const uint32 comp = READ_LE_UINT32(wizh + 0x0);
+	const int width   = READ_LE_UINT32(wizh + 0x4);
+	const int height  = READ_LE_UINT32(wizh + 0x8);
+	if ((comp != 1 && comp != 5) || (comp == 1 && xmapPtr && !palPtr))
+		return false;
+	// The big images are usually drawn once per room, keep the memory for the sprites
+	if ((uint32)(width * height * 4) > kDecodedImagesSize / 4)
+		return false;
+
+	Common::Rect r1, r2;
+	if (!calcClipRects(dstw, dsth, srcx, srcy, width, height, rect, r1, r2))
+		return true;
+	if (flags & kWIFFlipY) {
+		const int dy = (srcy < 0) ? srcy : (height - r1.height());
+		r1.translate(0, dy);
+	}
+	if (flags & kWIFFlipX) {
+		const int dx = (srcx < 0) ? srcx : (width - r1.width());
+		r1.translate(dx, 0);
+	}
+	// The flipped images cut on both sides don't end up inside of the image
+	if (!Common::Rect(width, height).contains(r1))
+		return false;
+
+	uint8 *wizd = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dataPtr, state, 0);
+	assert(wizd);
+	const DecodedImage *image = getDecodedImage(resNum, state, wizd, comp, width, height, (comp == 1) ? palPtr : NULL);
+
+	const int w = r1.width();
+	const int h = r1.height();
+	dst += r2.top * dstPitch + r2.left * 2;
+	if (flags & kWIFFlipY) {
+		dst += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	for (int y = 0; y < h; ++y) {
+		const int offset = (r1.top + y) * width + r1.left;
+		if (flags & kWIFFlipX) {
+			if (xmapPtr)
+				blitDecodedLineFlipped<true>((uint16 *)dst, image->pixels + offset, image->mask + offset, w);
+			else
+				blitDecodedLineFlipped<false>((uint16 *)dst, image->pixels + offset, image->mask + offset, w);
+		} else {
+			if (xmapPtr)
+				blitDecodedLine<true>((uint16 *)dst, image->pixels + offset, image->mask + offset, w);
+			else
+				blitDecodedLine<false>((uint16 *)dst, image->pixels + offset, image->mask + offset, w);
+		}
+		dst += dstPitch;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
 void Wiz::drawWizImageEx(uint8 *dst, uint8 *dataPtr, uint8 *maskPtr, int dstPitch, int dstType,
 		int dstw, int dsth, int srcx, int srcy, int srcw, int srch, int state, const Common::Rect *rect,
 		int flags, const uint8 *palPtr, int transColor, uint8 bitDepth, const uint8 *xmapPtr, uint32 conditionBits) {
@@ -23,6 +23,7 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -245,6 +246,7 @@ public:
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -332,8 +334,40 @@ public:
 	void computeWizHistogram(uint32 *histogram, const uint8 *data, const Common::Rect& rCapt);
 	void computeRawWizHistogram(uint32 *histogram, const uint8 *data, int srcPitch, const Common::Rect& rCapt);
 
+	void invalidateDecodedImage(int resNum);
+
 private:
 	ScummEngine_v71he *_vm;
+
+	enum {
+		kDecodedImagesSize = 8 * 1024 * 1024
+	};
+
+	/**
+	 * A state of a compressed image, decoded to 16 bit screen colors, with
+	 * a mask which is 0xFFFF for the drawn pixels and 0 for the transparent
+	 * ones.
+	 */
+	struct DecodedImage {
+		const uint8 *wizd;
+		bool hasPalette;
+		uint8 palette[512];
+		int width, height;
+		uint16 *pixels;
+		uint16 *mask;
+		uint32 lastUsed;
+	};
+
+	typedef Common::HashMap<uint32, DecodedImage *> DecodedImageMap;
+	DecodedImageMap _decodedImages;
+	uint32 _decodedImagesSize;
+	uint32 _decodedImagesCounter;
+
+	void freeDecodedImage(DecodedImageMap::iterator it);
+#ifdef USE_RGB_COLOR
+	DecodedImage *getDecodedImage(int resNum, int state, const uint8 *wizd, int comp, int width, int height, const uint8 *palPtr);
+#endif
+	bool drawDecodedImage(uint8 *dst, uint8 *dataPtr, int resNum, int state, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr);
 };
 
 } // End of namespace Scumm
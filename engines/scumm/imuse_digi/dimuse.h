@@ -181,6 +181,8 @@ public:
 	int32 getCurMusicLipSyncWidth(int syncId);
 	int32 getCurMusicLipSyncHeight(int syncId);
 	int32 getSoundElapsedTimeInMs(int soundId);
+
+	ImuseDigiSndMgr *getSndMgr() { return _sound; }
 };
 
 } // End of namespace Scumm
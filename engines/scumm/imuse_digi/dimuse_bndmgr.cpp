@@ -30,13 +30,21 @@
 
 namespace Scumm {
 
-BundleDirCache::BundleDirCache() {
+BundleDirCache::BundleDirCache() : _blockUseCounter(0) {
 	for (int fileId = 0; fileId < ARRAYSIZE(_budleDirCache); fileId++) {
 		_budleDirCache[fileId].bundleTable = NULL;
 		_budleDirCache[fileId].fileName[0] = 0;
 		_budleDirCache[fileId].numFiles = 0;
 		_budleDirCache[fileId].isCompressed = false;
 		_budleDirCache[fileId].indexTable = NULL;
+		for (int i = 0; i < kNumCachedBlocks; i++) {
+			_budleDirCache[fileId].blocks[i].index = -1;
+			_budleDirCache[fileId].blocks[i].block = -1;
+			_budleDirCache[fileId].blocks[i].size = 0;
+			_budleDirCache[fileId].blocks[i].lastUse = 0;
+			_budleDirCache[fileId].blocks[i].data = NULL;
+		}
+		memset(&_budleDirCache[fileId].stats, 0, sizeof(BlockStats));
 	}
 }
 
@@ -44,7 +52,38 @@ BundleDirCache::~BundleDirCache() {
 	for (int fileId = 0; fileId < ARRAYSIZE(_budleDirCache); fileId++) {
 		free(_budleDirCache[fileId].bundleTable);
 		free(_budleDirCache[fileId].indexTable);
+		for (int i = 0; i < kNumCachedBlocks; i++)
+			free(_budleDirCache[fileId].blocks[i].data);
+	}
+}
+
+BundleDirCache::CachedBlock *BundleDirCache::findBlock(int slot, int32 index, int32 block) {
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		CachedBlock &cached = _budleDirCache[slot].blocks[i];
+		if (cached.index == index && cached.block == block) {
+			cached.lastUse = ++_blockUseCounter;
+			return &cached;
+		}
+	}
+	return NULL;
+}
+
+BundleDirCache::CachedBlock *BundleDirCache::allocBlock(int slot, int32 index, int32 block) {
+	CachedBlock *oldest = &_budleDirCache[slot].blocks[0];
+	for (int i = 1; i < kNumCachedBlocks; i++) {
+		if (_budleDirCache[slot].blocks[i].lastUse < oldest->lastUse)
+			oldest = &_budleDirCache[slot].blocks[i];
+	}
+
+	if (!oldest->data) {
+		oldest->data = (byte *)malloc(0x2000);
+		assert(oldest->data);
 	}
+	oldest->index = index;
+	oldest->block = block;
+	oldest->size = 0;
+	oldest->lastUse = ++_blockUseCounter;
+	return oldest;
 }
 
 BundleDirCache::AudioTable *BundleDirCache::getTable(int slot) {
@@ -149,6 +188,7 @@ BundleMgr::BundleMgr(BundleDirCache *cache) {
 	_fileBundleId = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
+	_nextOffset = -1;
 }
 
 BundleMgr::~BundleMgr() {
@@ -186,6 +226,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_fileBundleId = slot;
 	compressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -194,8 +235,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 	assert(_bundleTable);
 	_compTableLoaded = false;
 	_isUncompressed = false;
-	_outputSize = 0;
-	_lastBlock = -1;
+	_nextOffset = -1;
 
 	return true;
 }
@@ -208,9 +248,9 @@ void BundleMgr::close() {
 		_numCompItems = 0;
 		_compTableLoaded = false;
 		_isUncompressed = false;
-		_lastBlock = -1;
-		_outputSize = 0;
+		_nextOffset = -1;
 		_curSampleId = -1;
+		_fileBundleId = -1;
 		free(_compTable);
 		_compTable = NULL;
 		free(_compInputBuff);
@@ -254,6 +294,32 @@ bool BundleMgr::loadCompTable(int32 index) {
 	return true;
 }
 
+BundleDirCache::CachedBlock *BundleMgr::getBlock(int32 index, int32 block, bool prefetch) {
+	BundleDirCache::BlockStats &stats = _cache->getBlockStats(_fileBundleId);
+	BundleDirCache::CachedBlock *cached = _cache->findBlock(_fileBundleId, index, block);
+	if (cached) {
+		if (!prefetch)
+			stats.hits++;
+		return cached;
+	}
+
+	cached = _cache->allocBlock(_fileBundleId, index, block);
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[block].size);
+	cached->size = BundleCodecs::decompressCodec(_compTable[block].codec, _compInputBuff, cached->data, _compTable[block].size);
+	if (cached->size > 0x2000) {
+		error("_outputSize: %d", cached->size);
+	}
+
+	if (prefetch)
+		stats.prefetches++;
+	else
+		stats.misses++;
+	return cached;
+}
+
 int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
 	bool ignored = false;
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside, ignored);
@@ -306,20 +372,14 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 	skip = (offset + headerSize) % 0x2000;
 
+	// Sequential reads get the following block decompressed ahead of time
+	const bool sequential = (offset == _nextOffset);
+	_nextOffset = offset + size;
+
 	for (i = firstBlock; i <= lastBlock; i++) {
-		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
-			}
-			_lastBlock = i;
-		}
+		const BundleDirCache::CachedBlock *block = getBlock(index, i, false);
 
-		outputSize = _outputSize;
+		outputSize = block->size;
 
 		if (headerOutside) {
 			outputSize -= skip;
@@ -336,7 +396,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 		assert(finalSize + outputSize <= blocksFinalSize);
 
-		memcpy(*compFinal + finalSize, _compOutputBuff + skip, outputSize);
+		memcpy(*compFinal + finalSize, block->data + skip, outputSize);
 		finalSize += outputSize;
 
 		size -= outputSize;
@@ -347,6 +407,9 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 		skip = 0;
 	}
 
+	if (sequential && lastBlock + 1 < _numCompItems)
+		getBlock(index, lastBlock + 1, true);
+
 	return finalSize;
 }
 
@@ -43,16 +43,39 @@ public:
 		int32 index;
 	};
 
+	/** A decompressed 0x2000 bytes block of a sound in the bundle */
+	struct CachedBlock {
+		int32 index;
+		int32 block;
+		int32 size;
+		uint32 lastUse;
+		byte *data;
+	};
+
+	struct BlockStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 prefetches;
+	};
+
 private:
 
+	enum {
+		kNumCachedBlocks = 16
+	};
+
 	struct FileDirCache {
 		char fileName[20];
 		AudioTable *bundleTable;
 		int32 numFiles;
 		bool isCompressed;
 		IndexNode *indexTable;
+		CachedBlock blocks[kNumCachedBlocks];
+		BlockStats stats;
 	} _budleDirCache[4];
 
+	uint32 _blockUseCounter;
+
 public:
 	BundleDirCache();
 	~BundleDirCache();
@@ -62,6 +85,25 @@ public:
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
+
+	int getNumSlots() const { return ARRAYSIZE(_budleDirCache); }
+	const char *getFileName(int slot) { return _budleDirCache[slot].fileName; }
+	BlockStats &getBlockStats(int slot) { return _budleDirCache[slot].stats; }
+
+	/**
+	 * Look up a decompressed block. The blocks are shared by all sounds
+	 * playing from the same bundle, so that crossfades between two
+	 * positions of a track use the same cache.
+	 *
+	 * @return the block, or NULL if it is not cached
+	 */
+	CachedBlock *findBlock(int slot, int32 index, int32 block);
+
+	/**
+	 * Return the least recently used entry of the bundle, reassigned to the
+	 * given block. The caller has to decompress the block to its data.
+	 */
+	CachedBlock *allocBlock(int slot, int32 index, int32 block);
 };
 
 class BundleMgr {
@@ -86,12 +128,11 @@ private:
 	bool _compTableLoaded;
 	bool _isUncompressed;
 	int _fileBundleId;
-	byte _compOutputBuff[0x2000];
 	byte *_compInputBuff;
-	int _outputSize;
-	int _lastBlock;
+	int32 _nextOffset;
 
 	bool loadCompTable(int32 index);
+	BundleDirCache::CachedBlock *getBlock(int32 index, int32 block, bool prefetch);
 
 public:
 
@@ -155,6 +155,8 @@ public:
 	void getSyncSizeAndPtrById(SoundDesc *soundDesc, int number, int32 &sync_size, byte **sync_ptr);
 
 	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size);
+
+	BundleDirCache *getBundleDirCache() { return _cacheBundleDir; }
 };
 
 } // End of namespace Scumm
@@ -44,8 +44,6 @@ namespace Scumm {
 
 enum {
 	RF_LOCK = 0x80,
-	RF_USAGE = 0x7F,
-	RF_USAGE_MAX = RF_USAGE,
 
 	RS_MODIFIED = 0x10,
 	RF_OFFHEAP = 0x40
@@ -543,6 +541,9 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 
 	// If there was data in there, let's clear it out completely. This is important
 	// in case we are restarting the game.
+	_allocatedSize -= _types[type]._allocatedSize;
+	_types[type]._allocatedSize = 0;
+	_types[type]._lruHead = _types[type]._lruTail = kNoResId;
 	_types[type].clear();
 	_types[type].resize(num);
 
@@ -586,6 +587,11 @@ void ScummEngine::loadCharset(int no) {
 	}
 }
 
+void ScummEngine::resourceChanged(ResType type, ResId idx) {
+	if (type == rtCharset && _charset)
+		_charset->invalidateCharset(idx);
+}
+
 void ScummEngine::nukeCharset(int i) {
 	assertRange(1, i, _numCharsets - 1, "charset");
 	_res->nukeResource(rtCharset, i);
@@ -778,36 +784,61 @@ byte *ScummEngine::getStringAddressVar(int i) {
 	return getStringAddress(_scummVars[i]);
 }
 
-void ResourceManager::increaseExpireCounter() {
-	++_expireCounter;
-	if (_expireCounter == 0) {	// overflow?
-		increaseResourceCounters();
-	}
+void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
+	if (!validateResource("setResourceCounter", type, idx))
+		return;
+
+	// Only the resources which can be reloaded are in the lists
+	Resource &res = _types[type][idx];
+	if (!res._address || _types[type]._mode == kDynamicResTypeMode)
+		return;
+
+	unlinkResource(type, idx);
+	linkResource(type, idx, counter <= 1);
 }
 
-void ResourceManager::increaseResourceCounters() {
-	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-		ResId idx = _types[type].size();
-		while (idx-- > 0) {
-			byte counter = _types[type][idx].getResourceCounter();
-			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
-			}
-		}
+void ResourceManager::linkResource(ResType type, ResId idx, bool mostRecent) {
+	ResTypeData &data = _types[type];
+	Resource &res = data[idx];
+
+	if (mostRecent) {
+		res._lastUsed = ++_useCounter;
+		res._lruPrev = kNoResId;
+		res._lruNext = data._lruHead;
+		if (data._lruHead != kNoResId)
+			data[data._lruHead]._lruPrev = idx;
+		else
+			data._lruTail = idx;
+		data._lruHead = idx;
+	} else {
+		res._lastUsed = 0;
+		res._lruNext = kNoResId;
+		res._lruPrev = data._lruTail;
+		if (data._lruTail != kNoResId)
+			data[data._lruTail]._lruNext = idx;
+		else
+			data._lruHead = idx;
+		data._lruTail = idx;
 	}
 }
 
-void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
-	_types[type][idx].setResourceCounter(counter);
-}
+void ResourceManager::unlinkResource(ResType type, ResId idx) {
+	ResTypeData &data = _types[type];
+	Resource &res = data[idx];
 
-void ResourceManager::Resource::setResourceCounter(byte counter) {
-	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
-	_flags |= counter;	// Update the usage counter
-}
+	if (res._lruPrev != kNoResId)
+		data[res._lruPrev]._lruNext = res._lruNext;
+	else if (data._lruHead == idx)
+		data._lruHead = res._lruNext;
+	else
+		return;	// Not in the list
+
+	if (res._lruNext != kNoResId)
+		data[res._lruNext]._lruPrev = res._lruPrev;
+	else
+		data._lruTail = res._lruPrev;
 
-byte ResourceManager::Resource::getResourceCounter() const {
-	return _flags & RF_USAGE;
+	res._lruPrev = res._lruNext = kNoResId;
 }
 
 /* 2 bytes safety area to make "precaching" of bytes in the gdi drawer easier */
@@ -842,7 +873,9 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
-	setResourceCounter(type, idx, 1);
+	_types[type]._allocatedSize += size;
+	if (_types[type]._mode != kDynamicResTypeMode)
+		linkResource(type, idx, true);
 	return ptr;
 }
 
@@ -850,6 +883,8 @@ ResourceManager::Resource::Resource() {
 	_address = 0;
 	_size = 0;
 	_flags = 0;
+	_lruPrev = _lruNext = kNoResId;
+	_lastUsed = 0;
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
@@ -871,6 +906,9 @@ void ResourceManager::Resource::nuke() {
 ResourceManager::ResTypeData::ResTypeData() {
 	_mode = kDynamicResTypeMode;
 	_tag = 0;
+	_lruHead = _lruTail = kNoResId;
+	_allocatedSize = 0;
+	_budget = 0;
 }
 
 ResourceManager::ResTypeData::~ResTypeData() {
@@ -880,7 +918,7 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_allocatedSize = 0;
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
-	_expireCounter = 0;
+	_useCounter = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -892,6 +930,16 @@ void ResourceManager::setHeapThreshold(int min, int max) {
 	assert(min <= max);
 	_maxHeapThreshold = max;
 	_minHeapThreshold = min;
+
+	// Keep the big sounds and costumes from pushing out the rooms and
+	// scripts which are needed next
+	setTypeBudget(rtSound, max / 2);
+	setTypeBudget(rtCostume, max / 2);
+}
+
+void ResourceManager::setTypeBudget(ResType type, uint32 budget) {
+	assert(type >= rtFirst && type <= rtLast);
+	_types[type]._budget = budget;
 }
 
 bool ResourceManager::validateResource(const char *str, ResType type, ResId idx) const {
@@ -906,7 +954,10 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	byte *ptr = _types[type][idx]._address;
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
+		_vm->resourceChanged(type, idx);
 		_allocatedSize -= _types[type][idx]._size;
+		_types[type]._allocatedSize -= _types[type][idx]._size;
+		unlinkResource(type, idx);
 		_types[type][idx].nuke();
 	}
 }
@@ -1001,6 +1052,7 @@ void ResourceManager::setModified(ResType type, ResId idx) {
 	if (!validateResource("Modified", type, idx))
 		return;
 	_types[type][idx].setModified();
+	_vm->resourceChanged(type, idx);
 }
 
 void ResourceManager::setOffHeap(ResType type, ResId idx) {
@@ -1041,40 +1093,63 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
-void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
-	uint32 oldAllocatedSize;
-
-	if (_expireCounter != 0xFF) {
-		_expireCounter = 0xFF;
-		increaseResourceCounters();
+ResId ResourceManager::findExpirableResource(ResType type) {
+	ResTypeData &data = _types[type];
+
+	// Look for the least recently used resource which may be removed. The
+	// ones in use are moved to the front as they are being used, so that
+	// they are not looked at again by the next calls.
+	uint checked = 0;
+	const uint count = data.size();
+	while (data._lruTail != kNoResId && checked++ < count) {
+		const ResId idx = data._lruTail;
+		Resource &res = data[idx];
+		if (!res.isLocked() && !res.isOffHeap() && !_vm->isResourceInUse(type, idx))
+			return idx;
+
+		setResourceCounter(type, idx, 1);
 	}
 
+	return kNoResId;
+}
+
+void ResourceManager::expireResources(uint32 size) {
 	if (size + _allocatedSize < _maxHeapThreshold)
 		return;
 
-	oldAllocatedSize = _allocatedSize;
+	const uint32 oldAllocatedSize = _allocatedSize;
+
+	// The types without any resource which may be removed
+	bool exhausted[rtLast + 1];
+	memset(exhausted, 0, sizeof(exhausted));
 
 	do {
-		best_type = rtInvalid;
-		best_counter = 2;
+		ResType best_type = rtInvalid;
+		ResId best_res = kNoResId;
+		bool best_overBudget = false;
+		uint32 best_lastUsed = 0;
 
 		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
+			if (_types[type]._mode == kDynamicResTypeMode || exhausted[type])
+				continue;
+
+			// Resources of this type can be reloaded from the data files,
+			// so we can potentially unload them to free memory. The types
+			// over their budget go first, then the least recently used.
+			const ResId idx = findExpirableResource(type);
+			if (idx == kNoResId) {
+				exhausted[type] = true;
+				continue;
+			}
+
+			const bool overBudget = _types[type]._budget && _types[type]._allocatedSize > _types[type]._budget;
+			const uint32 lastUsed = _types[type][idx]._lastUsed;
+			if (best_type == rtInvalid || (overBudget && !best_overBudget) ||
+					(overBudget == best_overBudget && lastUsed < best_lastUsed)) {
+				best_type = type;
+				best_res = idx;
+				best_overBudget = overBudget;
+				best_lastUsed = lastUsed;
 			}
 		}
 
@@ -1083,8 +1158,6 @@ void ResourceManager::expireResources(uint32 size) {
 		nukeResource(best_type, best_res);
 	} while (size + _allocatedSize > _minHeapThreshold);
 
-	increaseResourceCounters();
-
 	debugC(DEBUG_RESOURCE, "Expired resources, mem %d -> %d", oldAllocatedSize, _allocatedSize);
 }
 
@@ -1165,6 +1238,10 @@ void ResourceManager::resourceStats() {
 	}
 
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (_types[type]._allocatedSize)
+			debug(1, "  %s: %d, budget %d", nameOfResType(type), _types[type]._allocatedSize, _types[type]._budget);
+	}
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
@@ -80,7 +80,12 @@ protected:
 	ScummEngine *_vm;
 
 public:
+	enum {
+		kNoResId = 0xFFFF	///< Marks the end of the lists of loaded resources
+	};
+
 	class Resource {
+	friend class ResourceManager;
 	public:
 		/**
 		 * Pointer to the data contained in this resource
@@ -95,15 +100,24 @@ public:
 	protected:
 		/**
 		 * The uppermost bit indicates whether the resources is locked.
-		 * The lower 7 bits contain a counter. This counter measures roughly
-		 * how old the resource is; it starts out with a count of 1 and can go
-		 * as high as 127. When memory falls low resp. when the engine decides
-		 * that it should throw out some unused stuff, then it begins by
-		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
 		 */
 		byte _flags;
 
+		/**
+		 * The neighbours of this resource in the list of the loaded resources
+		 * of its type, from the most to the least recently used. When memory
+		 * falls low, the engine removes the least recently used resources
+		 * first (excluding locked resources and resources that are known to
+		 * be in use).
+		 */
+		ResId _lruPrev, _lruNext;
+
+		/**
+		 * When the resource was last used, to compare the least recently used
+		 * resources of the different types.
+		 */
+		uint32 _lastUsed;
+
 		/**
 		 * The status of the resource. Currently only one bit is used, which
 		 * indicates whether the resource is modified.
@@ -132,9 +146,6 @@ public:
 
 		void nuke();
 
-		inline void setResourceCounter(byte counter);
-		inline byte getResourceCounter() const;
-
 		void lock();
 		void unlock();
 		bool isLocked() const;
@@ -165,6 +176,24 @@ public:
 		 */
 		uint32 _tag;
 
+	protected:
+		/**
+		 * The most and least recently used loaded resources of this type,
+		 * or kNoResId.
+		 */
+		ResId _lruHead, _lruTail;
+
+		/**
+		 * The memory used by the loaded resources of this type.
+		 */
+		uint32 _allocatedSize;
+
+		/**
+		 * The memory the resources of this type may use before they are
+		 * removed ahead of the others, or 0 for no limit.
+		 */
+		uint32 _budget;
+
 	public:
 		ResTypeData();
 		~ResTypeData();
@@ -174,7 +203,7 @@ public:
 protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
-	byte _expireCounter;
+	uint32 _useCounter;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -182,6 +211,12 @@ public:
 
 	void setHeapThreshold(int min, int max);
 
+	/**
+	 * Set the memory the resources of a type may use before they are removed
+	 * ahead of the others, or 0 for no limit.
+	 */
+	void setTypeBudget(ResType type, uint32 budget);
+
 	void allocResTypeData(ResType type, uint32 tag, int num, ResTypeMode mode);
 	void freeResources();
 
@@ -204,31 +239,22 @@ public:
 	void setOnHeap(ResType type, ResId idx);
 
 	/**
-	 * This method increments the _expireCounter, and if it overflows (which happens
-	 * after at most 256 calls), it calls increaseResourceCounter.
-	 * It is invoked in the engine's main loop ScummEngine::scummLoop().
-	 */
-	void increaseExpireCounter();
-
-	/**
-	 * Update the specified resource's counter.
+	 * Update the specified resource's age: a counter of 1 marks it as just
+	 * used, a higher one as to be removed first when memory falls low, as
+	 * the scripts do for the resources they are done with.
 	 */
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
-	/**
-	 * Increment the counter of all unlocked loaded resources.
-	 * The maximal count is 255.
-	 * This is called by increaseExpireCounter and expireResources,
-	 * but also by ScummEngine::startScene.
-	 */
-	void increaseResourceCounters();
-
 	void resourceStats();
 
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	void linkResource(ResType type, ResId idx, bool mostRecent);
+	void unlinkResource(ResType type, ResId idx);
+	ResId findExpirableResource(ResType type);
 };
 
 } // End of namespace Scumm
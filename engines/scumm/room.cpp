@@ -115,8 +115,6 @@ void ScummEngine::startScene(int room, Actor *a, int objectNr) {
 	VAR(VAR_ROOM) = room;
 	_fullRedraw = true;
 
-	_res->increaseResourceCounters();
-
 	_currentRoom = room;
 	VAR(VAR_ROOM) = room;
 
@@ -454,6 +452,7 @@ void ScummEngine::setupRoomSubBlocks() {
 		putClass(182, kObjectClassUntouchable, 0);
 	}
 
+	_gdi->invalidateStripCache();
 	_gdi->roomChanged(roomptr);
 	_gdi->setTransparentColor(trans);
 }
@@ -718,6 +717,7 @@ void ScummEngine_v3old::setupRoomSubBlocks() {
 		}
 	}
 
+	_gdi->invalidateStripCache();
 	_gdi->roomChanged(roomptr);
 }
 
@@ -23,6 +23,7 @@
 #include "common/config-manager.h"
 #include "common/debug-channels.h"
 #include "common/md5.h"
+#include "common/profiler.h"
 #include "common/events.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -641,6 +642,7 @@ ScummEngine::~ScummEngine() {
 		if (_2byteMultiFontPtr[i])
 			delete _2byteMultiFontPtr[i];
 	delete _charset;
+	_charset = NULL;	// The resources freed below notify the charset renderer
 	delete _messageDialog;
 	delete _pauseDialog;
 	delete _versionDialog;
@@ -2249,6 +2251,8 @@ void ScummEngine_v0::scummLoop(int delta) {
 }
 
 void ScummEngine::scummLoop(int delta) {
+	PROFILE_SCOPE("scumm.loop");
+
 	if (_game.version >= 3) {
 		VAR(VAR_TMR_1) += delta;
 		VAR(VAR_TMR_2) += delta;
@@ -2406,8 +2410,6 @@ load_game:
 
 	camera._last = camera._cur;
 
-	_res->increaseExpireCounter();
-
 	animateCursor();
 
 	/* show or hide mouse */
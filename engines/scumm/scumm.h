@@ -678,6 +678,8 @@ protected:
 	int readSoundResource(ResId idx);
 	int readSoundResourceSmallHeader(ResId idx);
 	bool isResourceInUse(ResType type, ResId idx) const;
+	/** Called before a resource is freed, and after it was changed in place. */
+	virtual void resourceChanged(ResType type, ResId idx);
 
 	virtual void setupRoomSubBlocks();
 	virtual void resetRoomSubBlocks();
@@ -325,6 +325,28 @@ void Codec37Decoder::maketable(int pitch, int index) {
 		dst += 4;						  \
 	} while (0)
 
+/*
+ * Copy a run of 4x4 pixel blocks from the same place in the other buffer.
+ * The blocks of a row are next to each other, so they are copied a row of
+ * pixels at a time.
+ */
+
+static inline void copyRun(byte *&dst, int32 &i, int &bh, int32 length, int32 next_offs, int bw, int pitch) {
+	while (length > 0) {
+		const int32 count = MIN(length, i);
+		for (int x = 0; x < 4; x++)
+			memcpy(dst + pitch * x, dst + pitch * x + next_offs, count * 4);
+		dst += count * 4;
+		length -= count;
+		i -= count;
+		if (i == 0) {
+			dst += pitch * 3;
+			bh--;
+			i = bw;
+		}
+	}
+}
+
 void Codec37Decoder::proc1(byte *dst, const byte *src, int32 next_offs, int bw, int bh, int pitch, int16 *offset_table) {
 	uint8 code;
 	bool filling, skipCode;
@@ -438,17 +460,7 @@ void Codec37Decoder::proc4WithFDFE(byte *dst, const byte *src, int32 next_offs,
 			} else if (code == 0xFF) {
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
-				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				copyRun(dst, i, bh, *src++ + 1, next_offs, bw, pitch);
 				if (bh == 0) {
 					return;
 				}
@@ -470,17 +482,7 @@ void Codec37Decoder::proc4WithoutFDFE(byte *dst, const byte *src, int32 next_off
 			if (code == 0xFF) {
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
-				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
-					if (i == 0) {
-						dst += pitch * 3;
-						bh--;
-						i = bw;
-					}
-				}
+				copyRun(dst, i, bh, *src++ + 1, next_offs, bw, pitch);
 				if (bh == 0) {
 					return;
 				}
@@ -27,6 +27,14 @@
 #include "scumm/bomp.h"
 #include "scumm/smush/codec47.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMUSH_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SMUSH_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Scumm {
 
 #if defined(SCUMM_NEED_ALIGNMENT)
@@ -45,17 +53,6 @@ namespace Scumm {
 		(dst)[1] = (src)[1];	\
 	} while (0)
 
-
-#else /* SCUMM_NEED_ALIGNMENT */
-
-#define COPY_4X1_LINE(dst, src)			\
-	*(uint32 *)(dst) = *(const uint32 *)(src)
-
-#define COPY_2X1_LINE(dst, src)			\
-	*(uint16 *)(dst) = *(const uint16 *)(src)
-
-#endif
-
 #define FILL_4X1_LINE(dst, val)			\
 	do {					\
 		(dst)[0] = val;	\
@@ -70,6 +67,78 @@ namespace Scumm {
 		(dst)[1] = val;	\
 	} while (0)
 
+
+#else /* SCUMM_NEED_ALIGNMENT */
+
+#define COPY_4X1_LINE(dst, src)			\
+	*(uint32 *)(dst) = *(const uint32 *)(src)
+
+#define COPY_2X1_LINE(dst, src)			\
+	*(uint16 *)(dst) = *(const uint16 *)(src)
+
+#define FILL_4X1_LINE(dst, val)			\
+	*(uint32 *)(dst) = (val) * 0x01010101U
+
+#define FILL_2X1_LINE(dst, val)			\
+	*(uint16 *)(dst) = (val) * 0x0101U
+
+#endif
+
+/* Copy an 8x8 pixel block from a different place in the buffers */
+
+static inline void copy8x8(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 8; i++) {
+#if defined(SMUSH_USE_SSE2)
+		_mm_storel_epi64((__m128i *)dst, _mm_loadl_epi64((const __m128i *)src));
+#elif defined(SMUSH_USE_NEON)
+		vst1_u8(dst, vld1_u8(src));
+#else
+		COPY_4X1_LINE(dst + 0, src + 0);
+		COPY_4X1_LINE(dst + 4, src + 4);
+#endif
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+/* Fill an 8x8 pixel block with a single color */
+
+static inline void fill8x8(byte *dst, byte val, int pitch) {
+#if defined(SMUSH_USE_SSE2)
+	const __m128i v = _mm_set1_epi8((char)val);
+#elif defined(SMUSH_USE_NEON)
+	const uint8x8_t v = vdup_n_u8(val);
+#endif
+	for (int i = 0; i < 8; i++) {
+#if defined(SMUSH_USE_SSE2)
+		_mm_storel_epi64((__m128i *)dst, v);
+#elif defined(SMUSH_USE_NEON)
+		vst1_u8(dst, v);
+#else
+		FILL_4X1_LINE(dst + 0, val);
+		FILL_4X1_LINE(dst + 4, val);
+#endif
+		dst += pitch;
+	}
+}
+
+/* The same for 4x4 pixel blocks, which are a single word wide */
+
+static inline void copy4x4(byte *dst, const byte *src, int pitch) {
+	for (int i = 0; i < 4; i++) {
+		COPY_4X1_LINE(dst, src);
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+static inline void fill4x4(byte *dst, byte val, int pitch) {
+	for (int i = 0; i < 4; i++) {
+		FILL_4X1_LINE(dst, val);
+		dst += pitch;
+	}
+}
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -390,14 +459,10 @@ void Codec47Decoder::level3(byte *d_dst) {
 void Codec47Decoder::level2(byte *d_dst) {
 	int32 tmp;
 	byte code = *_d_src++;
-	int i;
 
 	if (code < 0xF8) {
 		tmp = _table[code] + _offset1;
-		for (i = 0; i < 4; i++) {
-			COPY_4X1_LINE(d_dst, d_dst + tmp);
-			d_dst += _d_pitch;
-		}
+		copy4x4(d_dst, d_dst + tmp, _d_pitch);
 	} else if (code == 0xFF) {
 		level3(d_dst);
 		d_dst += 2;
@@ -407,11 +472,7 @@ void Codec47Decoder::level2(byte *d_dst) {
 		d_dst += 2;
 		level3(d_dst);
 	} else if (code == 0xFE) {
-		byte t = *_d_src++;
-		for (i = 0; i < 4; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			d_dst += _d_pitch;
-		}
+		fill4x4(d_dst, *_d_src++, _d_pitch);
 	} else if (code == 0xFD) {
 		byte *tmp_ptr = _tableSmall + *_d_src++ * 128;
 		int32 l = tmp_ptr[96];
@@ -429,32 +490,18 @@ void Codec47Decoder::level2(byte *d_dst) {
 			tmp_ptr2++;
 		}
 	} else if (code == 0xFC) {
-		tmp = _offset2;
-		for (i = 0; i < 4; i++) {
-			COPY_4X1_LINE(d_dst, d_dst + tmp);
-			d_dst += _d_pitch;
-		}
+		copy4x4(d_dst, d_dst + _offset2, _d_pitch);
 	} else {
-		byte t = _paramPtr[code];
-		for (i = 0; i < 4; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			d_dst += _d_pitch;
-		}
+		fill4x4(d_dst, _paramPtr[code], _d_pitch);
 	}
 }
 
 void Codec47Decoder::level1(byte *d_dst) {
-	int32 tmp, tmp2;
+	int32 tmp;
 	byte code = *_d_src++;
-	int i;
 
 	if (code < 0xF8) {
-		tmp2 = _table[code] + _offset1;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
-			d_dst += _d_pitch;
-		}
+		copy8x8(d_dst, d_dst + _table[code] + _offset1, _d_pitch);
 	} else if (code == 0xFF) {
 		level2(d_dst);
 		d_dst += 4;
@@ -464,12 +511,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 		d_dst += 4;
 		level2(d_dst);
 	} else if (code == 0xFE) {
-		byte t = *_d_src++;
-		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
-			d_dst += _d_pitch;
-		}
+		fill8x8(d_dst, *_d_src++, _d_pitch);
 	} else if (code == 0xFD) {
 		tmp = *_d_src++;
 		byte *tmp_ptr = _tableBig + tmp * 388;
@@ -488,19 +530,9 @@ void Codec47Decoder::level1(byte *d_dst) {
 			tmp_ptr2++;
 		}
 	} else if (code == 0xFC) {
-		tmp2 = _offset2;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
-			d_dst += _d_pitch;
-		}
+		copy8x8(d_dst, d_dst + _offset2, _d_pitch);
 	} else {
-		byte t = _paramPtr[code];
-		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
-			d_dst += _d_pitch;
-		}
+		fill8x8(d_dst, _paramPtr[code], _d_pitch);
 	}
 }
 
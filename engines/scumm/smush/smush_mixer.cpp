@@ -27,11 +27,100 @@
 
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
-#include "audio/decoders/raw.h"
+
+#include "common/endian.h"
 
 
 namespace Scumm {
 
+/**
+ * Audio stream fed by a SMUSH channel. The sound data of every frame is
+ * converted into a ring buffer which the mixer reads from directly, instead
+ * of queuing a new stream per frame.
+ */
+class SmushAudioStream : public Audio::AudioStream {
+public:
+	SmushAudioStream(int rate, bool stereo) :
+		_rate(rate), _stereo(stereo), _buffer(NULL), _size(0), _start(0), _count(0), _finished(false) {}
+	~SmushAudioStream() override { free(_buffer); }
+
+	void queueData(const byte *data, int32 size, bool is16Bit);
+	void finish() { Common::StackLock lock(_mutex); _finished = true; }
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { Common::StackLock lock(_mutex); return _count == 0; }
+	bool endOfStream() const override { Common::StackLock lock(_mutex); return _finished && _count == 0; }
+
+private:
+	void grow(uint32 count);
+
+	const int _rate;
+	const bool _stereo;
+
+	mutable Common::Mutex _mutex;
+	int16 *_buffer;
+	uint32 _size;
+	uint32 _start;
+	uint32 _count;
+	bool _finished;
+};
+
+void SmushAudioStream::queueData(const byte *data, int32 size, bool is16Bit) {
+	const uint32 samples = is16Bit ? size / 2 : size;
+	if (!samples)
+		return;
+
+	Common::StackLock lock(_mutex);
+	if (_count + samples > _size)
+		grow(_count + samples);
+
+	uint32 pos = (_start + _count) % _size;
+	for (uint32 i = 0; i < samples; i++) {
+		// 16-bit data is big endian, 8-bit data is unsigned
+		_buffer[pos] = is16Bit ? (int16)READ_BE_UINT16(data + 2 * i) : (int16)((int8)(data[i] ^ 0x80) << 8);
+		if (++pos == _size)
+			pos = 0;
+	}
+	_count += samples;
+}
+
+void SmushAudioStream::grow(uint32 count) {
+	// Start with a second of sound, which holds several frames
+	uint32 size = MAX<uint32>(_size * 2, _rate * (_stereo ? 2 : 1));
+	while (size < count)
+		size *= 2;
+
+	int16 *buffer = (int16 *)malloc(size * sizeof(int16));
+	if (!buffer)
+		error("SmushAudioStream: failed to allocate memory");
+
+	const uint32 first = MIN(_count, _size - _start);
+	if (_count) {
+		memcpy(buffer, _buffer + _start, first * sizeof(int16));
+		memcpy(buffer + first, _buffer, (_count - first) * sizeof(int16));
+	}
+	free(_buffer);
+	_buffer = buffer;
+	_size = size;
+	_start = 0;
+}
+
+int SmushAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	Common::StackLock lock(_mutex);
+	const uint32 samples = MIN<uint32>(numSamples, _count);
+	if (!samples)
+		return 0;
+
+	const uint32 first = MIN(samples, _size - _start);
+	memcpy(buffer, _buffer + _start, first * sizeof(int16));
+	memcpy(buffer + first, _buffer, (samples - first) * sizeof(int16));
+	_start = (_start + samples) % _size;
+	_count -= samples;
+	return samples;
+}
+
 SmushMixer::SmushMixer(Audio::Mixer *m) :
 	_mixer(m),
 	_soundFrequency(22050) {
@@ -107,24 +196,17 @@ bool SmushMixer::handleFrame() {
 				int32 size = _channels[i].chan->getAvailableSoundDataSize();
 				byte *data = _channels[i].chan->getSoundData();
 
-				byte flags = stereo ? Audio::FLAG_STEREO : 0;
-				if (is_16bit) {
-					flags |= Audio::FLAG_16BITS;
-				} else {
-					flags |= Audio::FLAG_UNSIGNED;
-				}
-
 				if (_mixer->isReady()) {
-					// Stream the data
+					// Stream the data. Volume and balance are applied by the mixer.
 					if (!_channels[i].stream) {
-						_channels[i].stream = Audio::makeQueuingAudioStream(_channels[i].chan->getRate(), stereo);
+						_channels[i].stream = new SmushAudioStream(_channels[i].chan->getRate(), stereo);
 						_mixer->playStream(Audio::Mixer::kSFXSoundType, &_channels[i].handle, _channels[i].stream);
 					}
 					_mixer->setChannelVolume(_channels[i].handle, vol);
 					_mixer->setChannelBalance(_channels[i].handle, pan);
-					_channels[i].stream->queueBuffer(data, size, DisposeAfterUse::YES, flags);	// The stream will free the buffer for us
-				} else
-					delete[] data;
+					_channels[i].stream->queueData(data, size, is_16bit);
+				}
+				free(data);
 			}
 		}
 	}
@@ -28,12 +28,9 @@
 #include "common/mutex.h"
 #include "scumm/sound.h"
 
-namespace Audio {
-class QueuingAudioStream;
-}
-
 namespace Scumm {
 
+class SmushAudioStream;
 class SmushChannel;
 
 class SmushMixer {
@@ -47,7 +44,7 @@ private:
 		int id;
 		SmushChannel *chan;
 		Audio::SoundHandle handle;
-		Audio::QueuingAudioStream *stream;
+		SmushAudioStream *stream;
 	} _channels[NUM_CHANNELS];
 
 	int _soundFrequency;
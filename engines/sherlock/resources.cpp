@@ -28,7 +28,7 @@
 
 namespace Sherlock {
 
-Cache::Cache(SherlockEngine *vm) : _vm(vm) {
+Cache::Cache(SherlockEngine *vm) : _vm(vm), _size(0), _useCounter(0) {
 }
 
 bool Cache::isCached(const Common::String &filename) const {
@@ -48,6 +48,9 @@ void Cache::load(const Common::String &name) {
 	load(name, f);
 
 	f.close();
+
+	// The file can be read again if it gets dropped from the cache
+	_resources[name]->_reloadable = true;
 }
 
 void Cache::load(const Common::String &name, Common::SeekableReadStream &stream) {
@@ -55,32 +58,72 @@ void Cache::load(const Common::String &name, Common::SeekableReadStream &stream)
 	if (_resources.contains(name))
 		return;
 
+	// Allocate a new cache entry
+	CacheEntryPtr cacheEntry(new CacheEntry());
+	_resources[name] = cacheEntry;
+
+	loadEntry(*cacheEntry, stream);
+	cacheEntry->_lastUse = ++_useCounter;
+	trim();
+}
+
+void Cache::loadEntry(CacheEntry &cacheEntry, Common::SeekableReadStream &stream) {
 	int32 signature = stream.readUint32BE();
 	stream.seek(0);
 
-	// Allocate a new cache entry
-	_resources[name] = CacheEntry();
-	CacheEntry &cacheEntry = _resources[name];
-
 	// Check whether the file is compressed
 	if (signature == MKTAG('L', 'Z', 'V', 26)) {
 		// It's compressed, so decompress the file and store its data in the cache entry
 		Common::SeekableReadStream *decompressed = _vm->_res->decompress(stream);
-		cacheEntry.resize(decompressed->size());
-		decompressed->read(&cacheEntry[0], decompressed->size());
+		cacheEntry._data.resize(decompressed->size());
+		decompressed->read(&cacheEntry._data[0], decompressed->size());
 
 		delete decompressed;
 	} else {
 		// It's not, so read the raw data of the file into the cache entry
-		cacheEntry.resize(stream.size());
-		stream.read(&cacheEntry[0], stream.size());
+		cacheEntry._data.resize(stream.size());
+		stream.read(&cacheEntry._data[0], stream.size());
+	}
+
+	_size += cacheEntry._data.size();
+}
+
+void Cache::trim() {
+	while (_size > kMaxCacheSize) {
+		CacheHash::iterator oldest = _resources.end();
+		for (CacheHash::iterator i = _resources.begin(); i != _resources.end(); ++i) {
+			const CacheEntry &cacheEntry = *i->_value;
+			if (cacheEntry._reloadable && !cacheEntry._data.empty() && cacheEntry._lastUse != _useCounter &&
+					(oldest == _resources.end() || cacheEntry._lastUse < oldest->_value->_lastUse))
+				oldest = i;
+		}
+		if (oldest == _resources.end())
+			break;
+
+		// Streams still open on the dropped entry keep its data alive
+		_size -= oldest->_value->_data.size();
+		CacheEntryPtr dropped(new CacheEntry());
+		dropped->_reloadable = true;
+		oldest->_value = dropped;
 	}
 }
 
-Common::SeekableReadStream *Cache::get(const Common::String &filename) const {
-	// Return a memory stream that encapsulates the data
-	const CacheEntry &cacheEntry = _resources[filename];
-	return new Common::MemoryReadStream(&cacheEntry[0], cacheEntry.size());
+Common::SeekableReadStream *Cache::get(const Common::String &filename) {
+	CacheEntryPtr cacheEntry = _resources[filename];
+	cacheEntry->_lastUse = ++_useCounter;
+
+	if (cacheEntry->_reloadable && cacheEntry->_data.empty()) {
+		// The file was dropped from the cache, so read it in again
+		Common::File f;
+		if (!f.open(filename))
+			error("Could not read file - %s", filename.c_str());
+
+		loadEntry(*cacheEntry, f);
+		trim();
+	}
+
+	// Return a memory stream that shares the data
+	return new Common::MappedReadStream(cacheEntry, cacheEntry->_data.begin(), cacheEntry->_data.size());
 }
 
 /*----------------------------------------------------------------*/
@@ -27,6 +27,8 @@
 #include "common/file.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 #include "common/str.h"
 #include "common/str-array.h"
@@ -35,8 +37,15 @@
 
 namespace Sherlock {
 
-typedef Common::Array<byte> CacheEntry;
-typedef Common::HashMap<Common::String, CacheEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> CacheHash;
+struct CacheEntry : public Common::MappedReadStream::Mapping {
+	Common::Array<byte> _data;
+	bool _reloadable;
+	uint32 _lastUse;
+
+	CacheEntry() : _reloadable(false), _lastUse(0) {}
+};
+typedef Common::SharedPtr<CacheEntry> CacheEntryPtr;
+typedef Common::HashMap<Common::String, CacheEntryPtr, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> CacheHash;
 
 struct LibraryEntry {
 	uint32 _offset, _size;
@@ -53,8 +62,27 @@ class SherlockEngine;
 
 class Cache {
 private:
+	/**
+	 * Maximum size of the cached files. Only files which can be read again from
+	 * disk are dropped to stay below it
+	 */
+	static const uint32 kMaxCacheSize = 16 * 1024 * 1024;
+
 	SherlockEngine *_vm;
 	CacheHash _resources;
+	uint32 _size;
+	uint32 _useCounter;
+
+	/**
+	 * Read the data of a cache entry from a stream, decompressing it if necessary
+	 */
+	void loadEntry(CacheEntry &cacheEntry, Common::SeekableReadStream &stream);
+
+	/**
+	 * Drop the least recently used files which can be read again, until the cache
+	 * is within its maximum size
+	 */
+	void trim();
 public:
 	Cache(SherlockEngine *_vm);
 
@@ -78,7 +106,7 @@ public:
 	/**
 	 * Get a file from the cache
 	 */
-	Common::SeekableReadStream *get(const Common::String &filename) const;
+	Common::SeekableReadStream *get(const Common::String &filename);
 };
 
 class Resources {
@@ -36,6 +36,7 @@ static const char *const dataFilename = "sky.dsk";
 static const char *const dinnerFilename = "sky.dnr";
 
 Disk::Disk() {
+	_decompressedSize = 0;
 	_dataDiskHandle = new Common::File();
 	Common::File *dnrHandle = new Common::File();
 
@@ -69,6 +70,8 @@ Disk::~Disk() {
 	if (_dataDiskHandle->isOpen())
 		_dataDiskHandle->close();
 	fnFlushBuffers();
+	for (Common::List<DecompressedFile>::iterator i = _decompressedFiles.begin(); i != _decompressedFiles.end(); ++i)
+		free(i->data);
 	free(_dinnerTableArea);
 	delete _dataDiskHandle;
 }
@@ -77,12 +80,56 @@ bool Disk::fileExists(uint16 fileNr) {
 	return (getFileInfo(fileNr) != NULL);
 }
 
+uint8 *Disk::loadDecompressedFile(uint16 fileNr) {
+	for (Common::List<DecompressedFile>::iterator i = _decompressedFiles.begin(); i != _decompressedFiles.end(); ++i) {
+		if (i->fileNr != fileNr)
+			continue;
+
+		DecompressedFile file = *i;
+		_decompressedFiles.erase(i);
+		_decompressedFiles.push_front(file);
+
+		// The callers own the files they load, so they get a copy
+		uint8 *data = (uint8 *)malloc(file.size);
+		memcpy(data, file.data, file.size);
+		_lastLoadedFileSize = file.size;
+		return data;
+	}
+
+	return NULL;
+}
+
+void Disk::addDecompressedFile(uint16 fileNr, const uint8 *data, uint32 size) {
+	if (size > kMaxDecompressedSize / 4)
+		return;
+
+	while (_decompressedSize + size > kMaxDecompressedSize) {
+		_decompressedSize -= _decompressedFiles.back().size;
+		free(_decompressedFiles.back().data);
+		_decompressedFiles.pop_back();
+	}
+
+	DecompressedFile file;
+	file.fileNr = fileNr;
+	file.data = (uint8 *)malloc(size);
+	file.size = size;
+	memcpy(file.data, data, size);
+	_decompressedFiles.push_front(file);
+	_decompressedSize += size;
+}
+
 // allocate memory, load the file and return a pointer
 uint8 *Disk::loadFile(uint16 fileNr) {
 	uint8 cflag;
 
 	debug(3, "load file %d,%d (%d)", (fileNr >> 11), (fileNr & 2047), fileNr);
 
+	uint8 *decompressed = loadDecompressedFile(fileNr);
+	if (decompressed) {
+		debug(4, "File is in the decompressed file cache.");
+		return decompressed;
+	}
+
 	uint8 *fileInfoPtr = getFileInfo(fileNr);
 	if (fileInfoPtr == NULL) {
 		debug(1, "File %d not found", fileNr);
@@ -157,6 +204,8 @@ uint8 *Disk::loadFile(uint16 fileNr) {
 		} else {
 			if (unpackLen != (int32)decompSize)
 				debug(1, "ERROR: File %d: invalid decomp size! (was: %d, should be: %d)", fileNr, unpackLen, decompSize);
+			else
+				addDecompressedFile(fileNr, uncompDest, decompSize);
 			_lastLoadedFileSize = decompSize;
 
 			free(fileDest);
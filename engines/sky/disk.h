@@ -25,6 +25,7 @@
 
 
 #include "common/scummsys.h"
+#include "common/list.h"
 #include "sky/rnc_deco.h"
 
 #define MAX_FILES_IN_LIST 60
@@ -57,8 +58,20 @@ public:
 	void refreshFilesList(uint32 *list);
 
 protected:
+	// The decompressed files are kept, up to this size, as the rooms and the
+	// Linc terminal load the same ones again and again
+	static const uint32 kMaxDecompressedSize = 1024 * 1024;
+
+	struct DecompressedFile {
+		uint16 fileNr;
+		uint8 *data;
+		uint32 size;
+	};
+
 	uint8 *getFileInfo(uint16 fileNr);
 	void dumpFile(uint16 fileNr);
+	uint8 *loadDecompressedFile(uint16 fileNr);
+	void addDecompressedFile(uint16 fileNr, const uint8 *data, uint32 size);
 
 	uint32 _dinnerTableEntries;
 	uint8 *_dinnerTableArea;
@@ -67,6 +80,10 @@ protected:
 
 	uint16 _buildList[MAX_FILES_IN_LIST];
 	uint32 _loadedFilesList[MAX_FILES_IN_LIST];
+
+	// From the most to the least recently used
+	Common::List<DecompressedFile> _decompressedFiles;
+	uint32 _decompressedSize;
 };
 
 } // End of namespace Sky
@@ -63,54 +63,36 @@ void RncDecoder::initCrc() {
 //calculate 16 bit crc of a block of memory
 uint16 RncDecoder::crcBlock(const uint8 *block, uint32 size) {
 	uint16 crc = 0;
-	uint8 *crcTable8 = (uint8 *)_crcTable; //make a uint8* to crc_table
-	uint8 tmp;
-	uint32 i;
-
-	for (i = 0; i < size; i++) {
-		tmp = *block++;
-		crc ^= tmp;
-		tmp = (uint8)((crc >> 8) & 0x00FF);
-		crc &= 0x00FF;
-		crc = *(uint16 *)&crcTable8[crc << 1];
-		crc ^= tmp;
-	}
+
+	for (uint32 i = 0; i < size; i++)
+		crc = _crcTable[(crc ^ *block++) & 0xFF] ^ (crc >> 8);
 
 	return crc;
 }
 
 uint16 RncDecoder::inputBits(uint8 amount) {
-	uint16 newBitBuffh = _bitBuffh;
-	uint16 newBitBuffl = _bitBuffl;
-	int16 newBitCount = _bitCount;
-	uint16 remBits, returnVal;
-
-	returnVal = ((1 << amount) - 1) & newBitBuffl;
-	newBitCount -= amount;
-
-	if (newBitCount < 0) {
-		newBitCount += amount;
-		remBits = (newBitBuffh << (16 - newBitCount));
-		newBitBuffh >>= newBitCount;
-		newBitBuffl >>= newBitCount;
-		newBitBuffl |= remBits;
+	uint16 returnVal = ((1 << amount) - 1) & _bitBuff;
+
+	if (amount > _bitCount) {
+		// Only the low word is kept, the high word is replaced by the
+		// next word of the stream
+		_bitBuff >>= _bitCount;
 		_srcPtr += 2;
-		newBitBuffh = READ_LE_UINT16(_srcPtr);
-		amount -= newBitCount;
-		newBitCount = 16 - amount;
+		_bitBuff = (_bitBuff & 0xFFFF) | (READ_LE_UINT16(_srcPtr) << 16);
+		amount -= _bitCount;
+		_bitCount = 16;
 	}
-	remBits = (newBitBuffh << (16 - amount));
-	_bitBuffh = newBitBuffh >> amount;
-	_bitBuffl = (newBitBuffl >> amount) | remBits;
-	_bitCount = (uint8)newBitCount;
+	_bitBuff >>= amount;
+	_bitCount -= amount;
 
 	return returnVal;
 }
 
-void RncDecoder::makeHufftable(uint16 *table) {
+void RncDecoder::makeHufftable(uint16 *table, uint8 *lookup) {
 	uint16 bitLength, i, j;
 	uint16 numCodes = inputBits(5);
 
+	// Without codes, the table and its lookup are kept from the previous block
 	if (!numCodes)
 		return;
 
@@ -119,6 +101,8 @@ void RncDecoder::makeHufftable(uint16 *table) {
 		huffLength[i] = (uint8)(inputBits(4) & 0x00FF);
 
 	uint16 huffCode = 0;
+	uint8 entry = 0;
+	memset(lookup, 0, 1 << kLookupBits);
 
 	for (bitLength = 1; bitLength < 17; bitLength++) {
 		for (i = 0; i < numCodes; i++) {
@@ -134,19 +118,34 @@ void RncDecoder::makeHufftable(uint16 *table) {
 
 				*(table + 0x1e) = (huffLength[i] << 8) | (i & 0x00FF);
 				huffCode += 1 << (16 - bitLength);
+
+				// The codes are in the order inputValue() tries them, so
+				// the first one matching the bits is kept
+				entry++;
+				if (bitLength <= kLookupBits) {
+					for (uint k = a; k < (1 << kLookupBits); k += 1 << bitLength) {
+						if (!lookup[k])
+							lookup[k] = entry;
+					}
+				}
 			}
 		}
 	}
 }
 
-uint16 RncDecoder::inputValue(uint16 *table) {
-	uint16 valOne, valTwo, value = _bitBuffl;
+uint16 RncDecoder::inputValue(const uint16 *table, const uint8 *lookup) {
+	uint16 valOne, valTwo, value = _bitBuff & 0xFFFF;
 
-	do {
-		valTwo = (*table++) & value;
-		valOne = *table++;
+	uint8 entry = lookup[value & ((1 << kLookupBits) - 1)];
+	if (entry) {
+		table += entry * 2;
+	} else {
+		do {
+			valTwo = (*table++) & value;
+			valOne = *table++;
 
-	} while (valOne != valTwo);
+		} while (valOne != valTwo);
+	}
 
 	value = *(table + 0x1e);
 	inputBits((uint8)((value>>8) & 0x00FF));
@@ -173,8 +172,7 @@ int32 RncDecoder::unpackM1(const void *input, void *output, uint16 key) {
 	uint16 crcPacked = 0;
 
 
-	_bitBuffl = 0;
-	_bitBuffh = 0;
+	_bitBuff = 0;
 	_bitCount = 0;
 
 	//Check for "RNC "
@@ -214,40 +212,43 @@ int32 RncDecoder::unpackM1(const void *input, void *output, uint16 key) {
 	_dstPtr = (uint8 *)output;
 	_bitCount = 0;
 
-	_bitBuffl = READ_LE_UINT16(_srcPtr);
+	_bitBuff = READ_LE_UINT16(_srcPtr);
 	inputBits(2);
 
 	do {
-		makeHufftable(_rawTable);
-		makeHufftable(_posTable);
-		makeHufftable(_lenTable);
+		makeHufftable(_rawTable, _rawLookup);
+		makeHufftable(_posTable, _posLookup);
+		makeHufftable(_lenTable, _lenLookup);
 
 		counts = inputBits(16);
 
 		do {
-			uint32 inputLength = inputValue(_rawTable);
+			uint32 inputLength = inputValue(_rawTable, _rawLookup);
 			uint32 inputOffset;
 
 			if (inputLength) {
 				memcpy(_dstPtr, _srcPtr, inputLength); //memcpy is allowed here
 				_dstPtr += inputLength;
 				_srcPtr += inputLength;
-				uint16 a = READ_LE_UINT16(_srcPtr);
-				uint16 b = READ_LE_UINT16(_srcPtr + 2);
 
-				_bitBuffl &= ((1 << _bitCount) - 1);
-				_bitBuffl |= (a << _bitCount);
-				_bitBuffh = (a >> (16 - _bitCount)) | (b << _bitCount);
+				// The bits which are left stay, the next 32 follow the literals
+				_bitBuff &= ((1 << _bitCount) - 1);
+				_bitBuff |= READ_LE_UINT32(_srcPtr) << _bitCount;
 			}
 
 			if (counts > 1) {
-				inputOffset = inputValue(_posTable) + 1;
-				inputLength = inputValue(_lenTable) + MIN_LENGTH;
+				inputOffset = inputValue(_posTable, _posLookup) + 1;
+				inputLength = inputValue(_lenTable, _lenLookup) + MIN_LENGTH;
 
-				// Don't use memcpy here! because input and output overlap.
 				uint8 *tmpPtr = (_dstPtr-inputOffset);
-				while (inputLength--)
-					*_dstPtr++ = *tmpPtr++;
+				if (inputOffset >= inputLength) {
+					memcpy(_dstPtr, tmpPtr, inputLength);
+					_dstPtr += inputLength;
+				} else {
+					// Don't use memcpy here! because input and output overlap.
+					while (inputLength--)
+						*_dstPtr++ = *tmpPtr++;
+				}
 			}
 		} while (--counts);
 	} while (--blocks);
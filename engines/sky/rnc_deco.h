@@ -32,13 +32,24 @@ namespace Sky {
 class RncDecoder {
 
 protected:
+	enum {
+		// Codes up to this length are decoded with a single lookup
+		kLookupBits = 9
+	};
+
 	uint16 _rawTable[64];
 	uint16 _posTable[64];
 	uint16 _lenTable[64];
 	uint16 _crcTable[256];
 
-	uint16 _bitBuffl;
-	uint16 _bitBuffh;
+	// For each value of the next kLookupBits bits, the index + 1 of the
+	// entry of the table whose code they start with, 0 for longer codes
+	uint8 _rawLookup[1 << kLookupBits];
+	uint8 _posLookup[1 << kLookupBits];
+	uint8 _lenLookup[1 << kLookupBits];
+
+	// The low word is the next 16 bits of the stream
+	uint32 _bitBuff;
 	uint8 _bitCount;
 
 	const uint8 *_srcPtr;
@@ -53,8 +64,8 @@ protected:
 	void initCrc();
 	uint16 crcBlock(const uint8 *block, uint32 size);
 	uint16 inputBits(uint8 amount);
-	void makeHufftable(uint16 *table);
-	uint16 inputValue(uint16 *table);
+	void makeHufftable(uint16 *table, uint8 *lookup);
+	uint16 inputValue(const uint16 *table, const uint8 *lookup);
 
 };
 
@@ -28,6 +28,7 @@
 
 #include "common/debug.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/substream.h"
 
 namespace Stark {
@@ -96,31 +97,47 @@ Common::String XARCMember::readString(Common::ReadStream &stream) {
 
 // ARCHIVE
 
-bool XARCArchive::open(const Common::String &filename) {
-	Common::File stream;
-	if (!stream.open(filename)) {
-		return false;
+XARCArchive::XARCArchive() :
+		_contents(nullptr),
+		_contentsSize(0) {
+}
+
+XARCArchive::~XARCArchive() {
+	delete[] _contents;
+}
+
+bool XARCArchive::open(const Common::String &filename, byte *contents, uint32 size) {
+	Common::File file;
+	Common::MemoryReadStream memoryStream(contents, size);
+	Common::ReadStream *stream = &memoryStream;
+	if (!contents) {
+		if (!file.open(filename)) {
+			return false;
+		}
+		stream = &file;
 	}
 
 	_filename = filename;
+	_contents = contents;
+	_contentsSize = size;
 
 	// Unknown: always 1? version?
-	uint32 unknown = stream.readUint32LE();
+	uint32 unknown = stream->readUint32LE();
 	debugC(kDebugUnknown, "Stark::XARC: \"%s\" has unknown=%d", _filename.c_str(), unknown);
 	if (unknown != 1) {
 		warning("Stark::XARC: \"%s\" has unknown=%d with unknown meaning", _filename.c_str(), unknown);
 	}
 
 	// Read the number of contained files
-	uint32 numFiles = stream.readUint32LE();
+	uint32 numFiles = stream->readUint32LE();
 	debugC(20, kDebugArchive, "Stark::XARC: \"%s\" contains %d files", _filename.c_str(), numFiles);
 
 	// Read the offset to the contents of the first file
-	uint32 offset = stream.readUint32LE();
+	uint32 offset = stream->readUint32LE();
 	debugC(20, kDebugArchive, "Stark::XARC: \"%s\"'s first file has offset=%d", _filename.c_str(), offset);
 
 	for (uint32 i = 0; i < numFiles; i++) {
-		XARCMember *member = new XARCMember(this, stream, offset);
+		XARCMember *member = new XARCMember(this, *stream, offset);
 		_members.push_back(Common::ArchiveMemberPtr(member));
 
 		// Set the offset to the next member
@@ -195,6 +212,17 @@ Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const Common:
 }
 
 Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const XARCMember *member) const {
+	uint32 offset = member->getOffset();
+	uint32 length = member->getLength();
+
+	if (_contents && offset + length <= _contentsSize) {
+		// The archive was read to memory, copy the member out of it so that
+		// the stream can outlive the archive, as the sound streams may
+		byte *data = (byte *)malloc(length);
+		memcpy(data, _contents + offset, length);
+		return new Common::MemoryReadStream(data, length, DisposeAfterUse::YES);
+	}
+
 	// Open the xarc file
 	Common::File *f = new Common::File;
 	if (!f)
@@ -206,13 +234,7 @@ Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const XARCMem
 	}
 
 	// Return the substream that contains the archive member
-	uint32 offset = member->getOffset();
-	uint32 length = member->getLength();
 	return new Common::SeekableSubReadStream(f, offset, offset + length, DisposeAfterUse::YES);
-
-	// Different approach: keep the archive open and read full resources to memory
-	//f.seek(member->getOffset());
-	//return f.readStream(member->getLength());
 }
 
 } // End of namespace Formats
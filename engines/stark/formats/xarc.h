@@ -33,7 +33,17 @@ class XARCMember;
 
 class XARCArchive : public Common::Archive {
 public:
-	bool open(const Common::String &filename);
+	XARCArchive();
+	~XARCArchive() override;
+
+	/**
+	 * Open an archive file
+	 *
+	 * When the file was already read to memory, its contents are given
+	 * here, and the members are read from them. The archive takes the
+	 * ownership of the contents, they are freed with delete[].
+	 */
+	bool open(const Common::String &filename, byte *contents = nullptr, uint32 size = 0);
 	Common::String getFilename() const;
 
 	// Archive API
@@ -48,6 +58,8 @@ public:
 private:
 	Common::String _filename;
 	Common::ArchiveMemberList _members;
+	byte *_contents;
+	uint32 _contentsSize;
 };
 
 } // End of namespace Formats
@@ -22,6 +22,7 @@
 
 #include "engines/stark/gfx/opengls.h"
 
+#include "common/algorithm.h"
 #include "common/system.h"
 
 #include "math/matrix4.h"
@@ -33,6 +34,7 @@
 #include "engines/stark/gfx/openglssurface.h"
 #include "engines/stark/gfx/openglsfade.h"
 #include "engines/stark/gfx/opengltexture.h"
+#include "engines/stark/model/model.h"
 
 #include "graphics/pixelbuffer.h"
 #include "graphics/surface.h"
@@ -60,6 +62,7 @@ static const GLfloat fadeVertices[] = {
 OpenGLSDriver::OpenGLSDriver() :
 	_surfaceShader(nullptr),
 	_actorShader(nullptr),
+	_propShader(nullptr),
 	_fadeShader(nullptr),
 	_shadowShader(nullptr),
 	_surfaceVBO(0),
@@ -71,6 +74,7 @@ OpenGLSDriver::~OpenGLSDriver() {
 	OpenGL::ShaderGL::freeBuffer(_fadeVBO);
 	delete _surfaceShader;
 	delete _actorShader;
+	delete _propShader;
 	delete _fadeShader;
 	delete _shadowShader;
 }
@@ -87,6 +91,9 @@ void OpenGLSDriver::init() {
 	static const char* actorAttributes[] = { "position1", "position2", "bone1", "bone2", "boneWeight", "normal", "texcoord", nullptr };
 	_actorShader = OpenGL::ShaderGL::fromFiles("stark_actor", actorAttributes);
 
+	static const char* propAttributes[] = { "position", "normal", "texcoord", nullptr };
+	_propShader = OpenGL::ShaderGL::fromFiles("stark_prop", propAttributes);
+
 	static const char* shadowAttributes[] = { "position1", "position2", "bone1", "bone2", "boneWeight", nullptr };
 	_shadowShader = OpenGL::ShaderGL::fromFiles("stark_shadow", shadowAttributes);
 
@@ -203,6 +210,10 @@ OpenGL::ShaderGL *OpenGLSDriver::createActorShaderInstance() {
 	return _actorShader->clone();
 }
 
+OpenGL::ShaderGL *OpenGLSDriver::createPropShaderInstance() {
+	return _propShader->clone();
+}
+
 OpenGL::ShaderGL *OpenGLSDriver::createSurfaceShaderInstance() {
 	return _surfaceShader->clone();
 }
@@ -215,6 +226,65 @@ OpenGL::ShaderGL *OpenGLSDriver::createShadowShaderInstance() {
 	return _shadowShader->clone();
 }
 
+struct FaceMaterialLess {
+	const Common::Array<const Face *> &faces;
+
+	explicit FaceMaterialLess(const Common::Array<const Face *> &f) : faces(f) {}
+
+	bool operator()(uint a, uint b) const {
+		// Keep the original face order for a given material
+		if (faces[a]->materialId != faces[b]->materialId)
+			return faces[a]->materialId < faces[b]->materialId;
+		return a < b;
+	}
+};
+
+GLuint OpenGLSDriver::createMaterialSortedEBO(const Common::Array<const Face *> &faces, Common::Array<MaterialDrawRange> &ranges) {
+	Common::Array<uint> order;
+	order.resize(faces.size());
+	for (uint i = 0; i < faces.size(); i++)
+		order[i] = i;
+	Common::sort(order.begin(), order.end(), FaceMaterialLess(faces));
+
+	ranges.clear();
+	Common::Array<uint32> indices;
+	for (uint i = 0; i < order.size(); i++) {
+		const Face *face = faces[order[i]];
+		if (face->vertexIndices.empty())
+			continue;
+
+		if (ranges.empty() || ranges.back().materialId != face->materialId) {
+			MaterialDrawRange range;
+			range.materialId = face->materialId;
+			range.offset = indices.size();
+			range.count = 0;
+			ranges.push_back(range);
+		}
+
+		indices.push_back(face->vertexIndices);
+		ranges.back().count += face->vertexIndices.size();
+	}
+
+	if (indices.empty())
+		return 0;
+
+	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(), &indices.front());
+}
+
+const LightUniformNames &OpenGLSDriver::getLightUniformNames(uint light) {
+	static LightUniformNames names[kMaxLights];
+
+	assert(light < kMaxLights);
+	if (names[light].position.empty()) {
+		names[light].position = Common::String::format("lights[%d].position", light);
+		names[light].direction = Common::String::format("lights[%d].direction", light);
+		names[light].color = Common::String::format("lights[%d].color", light);
+		names[light].params = Common::String::format("lights[%d].params", light);
+	}
+
+	return names[light];
+}
+
 Graphics::Surface *OpenGLSDriver::getViewportScreenshot() const {
 	Graphics::Surface *s = new Graphics::Surface();
 	s->create(_viewport.width(), _viewport.height(), getRGBAPixelFormat());
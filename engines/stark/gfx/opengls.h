@@ -29,6 +29,9 @@
 
 #include "engines/stark/gfx/driver.h"
 
+#include "common/array.h"
+#include "common/str.h"
+
 #include "graphics/opengl/system_headers.h"
 
 namespace OpenGL {
@@ -36,8 +39,26 @@ class ShaderGL;
 }
 
 namespace Stark {
+
+struct Face;
+
 namespace Gfx {
 
+/** A range of the index buffer of a model, drawn with a single material */
+struct MaterialDrawRange {
+	uint32 materialId;
+	uint32 offset;
+	uint32 count;
+};
+
+/** The uniform names of a light of the actor and prop shaders */
+struct LightUniformNames {
+	Common::String position;
+	Common::String direction;
+	Common::String color;
+	Common::String params;
+};
+
 class OpenGLSDriver : public Driver {
 public:
 	OpenGLSDriver();
@@ -58,6 +79,7 @@ public:
 	FadeRenderer *createFadeRenderer() override;
 
 	OpenGL::ShaderGL *createActorShaderInstance();
+	OpenGL::ShaderGL *createPropShaderInstance();
 	OpenGL::ShaderGL *createSurfaceShaderInstance();
 	OpenGL::ShaderGL *createFadeShaderInstance();
 	OpenGL::ShaderGL *createShadowShaderInstance();
@@ -71,12 +93,24 @@ public:
 
 	Graphics::Surface *getViewportScreenshot() const override;
 
+	/**
+	 * Create a single index buffer for the faces of a model, with the faces
+	 * sorted by material, so that each material is drawn with one call.
+	 */
+	static GLuint createMaterialSortedEBO(const Common::Array<const Face *> &faces, Common::Array<MaterialDrawRange> &ranges);
+
+	/** Get the uniform names of a light, without formatting them every frame */
+	static const LightUniformNames &getLightUniformNames(uint light);
+
+	static const uint kMaxLights = 10;
+
 private:
 	Common::Rect _viewport;
 	Common::Rect _unscaledViewport;
 
 	OpenGL::ShaderGL *_surfaceShader;
 	OpenGL::ShaderGL *_actorShader;
+	OpenGL::ShaderGL *_propShader;
 	OpenGL::ShaderGL *_fadeShader;
 	OpenGL::ShaderGL *_shadowShader;
 	GLuint _surfaceVBO;
@@ -40,7 +40,9 @@ namespace Gfx {
 OpenGLSActorRenderer::OpenGLSActorRenderer(OpenGLSDriver *gfx) :
 		VisualActor(),
 		_gfx(gfx),
-		_faceVBO(0) {
+		_faceVBO(0),
+		_faceEBO(0),
+		_indexCount(0) {
 	_shader = _gfx->createActorShaderInstance();
 	_shadowShader = _gfx->createShadowShaderInstance();
 }
@@ -63,6 +65,7 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	// TODO: Move updates outside of the rendering code
 	_animHandler->animate(_time);
 	_model->updateBoundingBox();
+	updateBoneArrays();
 
 	_gfx->set3DMode();
 
@@ -97,12 +100,13 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	setBonePositionArrayUniform(_shader, "bonePosition");
 	setLightArrayUniform(lights);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	Common::Array<Material *> mats = _model->getMaterials();
+	const Common::Array<Material *> &mats = _model->getMaterials();
 
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		// For each face draw its vertices from the VBO, indexed by the EBO
-		const Material *material = mats[(*face)->materialId];
+	// The faces are sorted by material in the index buffer, each material is drawn at once
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+	for (uint i = 0; i < _drawRanges.size(); i++) {
+		const MaterialDrawRange &range = _drawRanges[i];
+		const Material *material = mats[range.materialId];
 		const Gfx::Texture *tex = resolveTexture(material);
 		if (tex) {
 			tex->bind();
@@ -113,9 +117,7 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		_shader->setUniform("textured", tex != nullptr);
 		_shader->setUniform("color", Math::Vector3d(material->r, material->g, material->b));
 
-		GLuint ebo = _faceEBO[*face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (const void *)(range.offset * sizeof(uint32)));
 	}
 
 	_shader->unbind();
@@ -144,11 +146,8 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		modelInverse.inverse();
 		setShadowUniform(lights, position, modelInverse.getRotation());
 
-		for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-			GLuint ebo = _faceEBO[*face];
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-			glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
-		}
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+		glDrawElements(GL_TRIANGLES, _indexCount, GL_UNSIGNED_INT, 0);
 
 		glDisable(GL_BLEND);
 		glDisable(GL_STENCIL_TEST);
@@ -161,19 +160,25 @@ void OpenGLSActorRenderer::clearVertices() {
 	OpenGL::ShaderGL::freeBuffer(_faceVBO); // Zero names are silently ignored
 	_faceVBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::ShaderGL::freeBuffer(it->_value);
-	}
+	OpenGL::ShaderGL::freeBuffer(_faceEBO);
+	_faceEBO = 0;
 
-	_faceEBO.clear();
+	_drawRanges.clear();
+	_indexCount = 0;
 }
 
 void OpenGLSActorRenderer::uploadVertices() {
 	_faceVBO = createModelVBO(_model);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[*face] = createFaceEBO(*face);
+	const Common::Array<Face *> &modelFaces = _model->getFaces();
+	Common::Array<const Face *> faces;
+	for (uint i = 0; i < modelFaces.size(); i++) {
+		faces.push_back(modelFaces[i]);
+	}
+	_faceEBO = OpenGLSDriver::createMaterialSortedEBO(faces, _drawRanges);
+
+	for (uint i = 0; i < _drawRanges.size(); i++) {
+		_indexCount += _drawRanges[i].count;
 	}
 }
 
@@ -212,58 +217,50 @@ GLuint OpenGLSActorRenderer::createModelVBO(const Model *model) {
 	return vbo;
 }
 
-GLuint OpenGLSActorRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices[0]);
-}
-
-void OpenGLSActorRenderer::setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform) {
+void OpenGLSActorRenderer::updateBoneArrays() {
 	const Common::Array<BoneNode *> &bones = _model->getBones();
 
-	GLint pos = shader->getUniformLocation(uniform);
-	if (pos == -1) {
-		error("No uniform named '%s'", uniform);
-	}
+	_bonePositions.resize(3 * bones.size());
+	_boneRotations.resize(4 * bones.size());
 
-	float *positions = new float[3 * bones.size()];
-	float *positionsPtr = positions;
+	float *positionsPtr = _bonePositions.begin();
+	float *rotationsPtr = _boneRotations.begin();
 
 	for (uint i = 0; i < bones.size(); i++) {
 		*positionsPtr++ = bones[i]->_animPos.x();
 		*positionsPtr++ = bones[i]->_animPos.y();
 		*positionsPtr++ = bones[i]->_animPos.z();
+
+		*rotationsPtr++ =  bones[i]->_animRot.x();
+		*rotationsPtr++ =  bones[i]->_animRot.y();
+		*rotationsPtr++ =  bones[i]->_animRot.z();
+		*rotationsPtr++ =  bones[i]->_animRot.w();
+	}
+}
+
+void OpenGLSActorRenderer::setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform) {
+	GLint pos = shader->getUniformLocation(uniform);
+	if (pos == -1) {
+		error("No uniform named '%s'", uniform);
 	}
 
-	glUniform3fv(pos, bones.size(), positions);
-	delete[] positions;
+	if (!_bonePositions.empty())
+		glUniform3fv(pos, _bonePositions.size() / 3, _bonePositions.begin());
 }
 
 void OpenGLSActorRenderer::setBoneRotationArrayUniform(OpenGL::ShaderGL *shader, const char *uniform) {
-	const Common::Array<BoneNode *> &bones = _model->getBones();
-
 	GLint rot = shader->getUniformLocation(uniform);
 	if (rot == -1) {
 		error("No uniform named '%s'", uniform);
 	}
 
-	float *rotations = new float[4 * bones.size()];
-	float *rotationsPtr = rotations;
-
-	for (uint i = 0; i < bones.size(); i++) {
-		*rotationsPtr++ =  bones[i]->_animRot.x();
-		*rotationsPtr++ =  bones[i]->_animRot.y();
-		*rotationsPtr++ =  bones[i]->_animRot.z();
-		*rotationsPtr++ =  bones[i]->_animRot.w();
-	}
-
-	glUniform4fv(rot, bones.size(), rotations);
-	delete[] rotations;
+	if (!_boneRotations.empty())
+		glUniform4fv(rot, _boneRotations.size() / 4, _boneRotations.begin());
 }
 
 void OpenGLSActorRenderer::setLightArrayUniform(const LightEntryArray &lights) {
-	static const uint maxLights = 10;
-
 	assert(lights.size() >= 1);
-	assert(lights.size() <= maxLights);
+	assert(lights.size() <= OpenGLSDriver::kMaxLights);
 
 	const LightEntry *ambient = lights[0];
 	assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
@@ -290,9 +287,10 @@ void OpenGLSActorRenderer::setLightArrayUniform(const LightEntryArray &lights) {
 		Math::Vector3d eyeDirection = viewMatrixRot * worldDirection;
 		eyeDirection.normalize();
 
-		_shader->setUniform(Common::String::format("lights[%d].position", i).c_str(), eyePosition);
-		_shader->setUniform(Common::String::format("lights[%d].direction", i).c_str(), eyeDirection);
-		_shader->setUniform(Common::String::format("lights[%d].color", i).c_str(), l->color);
+		const LightUniformNames &names = OpenGLSDriver::getLightUniformNames(i);
+		_shader->setUniform(names.position.c_str(), eyePosition);
+		_shader->setUniform(names.direction.c_str(), eyeDirection);
+		_shader->setUniform(names.color.c_str(), l->color);
 
 		Math::Vector4d params;
 		params.x() = l->falloffNear;
@@ -300,12 +298,12 @@ void OpenGLSActorRenderer::setLightArrayUniform(const LightEntryArray &lights) {
 		params.z() = l->innerConeAngle.getCosine();
 		params.w() = l->outerConeAngle.getCosine();
 
-		_shader->setUniform(Common::String::format("lights[%d].params", i).c_str(), params);
+		_shader->setUniform(names.params.c_str(), params);
 	}
 
-	for (uint i = lights.size() - 1; i < maxLights; i++) {
+	for (uint i = lights.size() - 1; i < OpenGLSDriver::kMaxLights; i++) {
 		// Make sure unused lights are disabled
-		_shader->setUniform(Common::String::format("lights[%d].position", i).c_str(), Math::Vector4d());
+		_shader->setUniform(OpenGLSDriver::getLightUniformNames(i).position.c_str(), Math::Vector4d());
 	}
 }
 
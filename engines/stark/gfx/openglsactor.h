@@ -23,12 +23,10 @@
 #ifndef STARK_GFX_OPENGL_S_ACTOR_H
 #define STARK_GFX_OPENGL_S_ACTOR_H
 
+#include "engines/stark/gfx/opengls.h"
 #include "engines/stark/gfx/renderentry.h"
 #include "engines/stark/visual/actor.h"
 
-#include "common/hashmap.h"
-#include "common/hash-ptr.h"
-
 #include "graphics/opengl/system_headers.h"
 
 #if defined(USE_GLES2) || defined(USE_OPENGL_SHADERS)
@@ -50,18 +48,22 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<Face *, GLuint> FaceBufferMap;
-
 	OpenGLSDriver *_gfx;
 	OpenGL::ShaderGL *_shader, *_shadowShader;
 
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	GLuint _faceEBO;
+	Common::Array<MaterialDrawRange> _drawRanges;
+	uint32 _indexCount;
+
+	// The animated bones, shared by the actor and shadow passes
+	Common::Array<float> _bonePositions;
+	Common::Array<float> _boneRotations;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createModelVBO(const Model *model);
-	GLuint createFaceEBO(const Face *face);
+	void updateBoneArrays();
 	void setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform);
 	void setBoneRotationArrayUniform(OpenGL::ShaderGL *shader, const char *uniform);
 	void setLightArrayUniform(const LightEntryArray &lights);
@@ -22,7 +22,6 @@
 
 #include "engines/stark/gfx/openglsprop.h"
 
-#include "engines/stark/gfx/driver.h"
 #include "engines/stark/gfx/texture.h"
 #include "engines/stark/formats/biffmesh.h"
 #include "engines/stark/scene.h"
@@ -35,13 +34,13 @@
 namespace Stark {
 namespace Gfx {
 
-OpenGLSPropRenderer::OpenGLSPropRenderer(Driver *gfx) :
+OpenGLSPropRenderer::OpenGLSPropRenderer(OpenGLSDriver *gfx) :
 		VisualProp(),
 		_gfx(gfx),
 		_faceVBO(0),
+		_faceEBO(0),
 		_modelIsDirty(true) {
-	static const char* attributes[] = { "position", "normal", "texcoord", nullptr };
-	_shader = OpenGL::ShaderGL::fromFiles("stark_prop", attributes);
+	_shader = _gfx->createPropShaderInstance();
 }
 
 OpenGLSPropRenderer::~OpenGLSPropRenderer() {
@@ -50,13 +49,17 @@ OpenGLSPropRenderer::~OpenGLSPropRenderer() {
 	delete _shader;
 }
 
-void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) {
+void OpenGLSPropRenderer::warmUp() {
 	if (_modelIsDirty) {
 		// Update the OpenGL Buffer Objects if required
 		clearVertices();
 		uploadVertices();
 		_modelIsDirty = false;
 	}
+}
+
+void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) {
+	warmUp();
 
 	_gfx->set3DMode();
 
@@ -85,13 +88,14 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 	_shader->setUniform("normalMatrix", normalMatrix.getRotation());
 	setLightArrayUniform(lights);
 
-	const Common::Array<Face> &faces = _model->getFaces();
 	const Common::Array<Material> &materials = _model->getMaterials();
 
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		const Material &material = materials[face->materialId];
+	// The faces are sorted by material in the index buffer, each material is drawn at once
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+	for (uint i = 0; i < _drawRanges.size(); i++) {
+		const MaterialDrawRange &range = _drawRanges[i];
+		const Material &material = materials[range.materialId];
 
-		// For each face draw its vertices from the VBO, indexed by the EBO
 		const Gfx::Texture *tex = _texture->getTexture(material.texture);
 		if (tex) {
 			tex->bind();
@@ -103,9 +107,7 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 		_shader->setUniform("color", Math::Vector3d(material.r, material.g, material.b));
 		_shader->setUniform("doubleSided", material.doubleSided ? 1 : 0);
 
-		GLuint ebo = _faceEBO[face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, face->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (const void *)(range.offset * sizeof(uint32)));
 	}
 
 	_shader->unbind();
@@ -113,21 +115,23 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 
 void OpenGLSPropRenderer::clearVertices() {
 	OpenGL::ShaderGL::freeBuffer(_faceVBO);
+	_faceVBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::ShaderGL::freeBuffer(it->_value);
-	}
+	OpenGL::ShaderGL::freeBuffer(_faceEBO);
+	_faceEBO = 0;
 
-	_faceEBO.clear();
+	_drawRanges.clear();
 }
 
 void OpenGLSPropRenderer::uploadVertices() {
 	_faceVBO = createFaceVBO();
 
-	const Common::Array<Face> &faces = _model->getFaces();
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[face] = createFaceEBO(face);
+	const Common::Array<Face> &modelFaces = _model->getFaces();
+	Common::Array<const Face *> faces;
+	for (uint i = 0; i < modelFaces.size(); i++) {
+		faces.push_back(&modelFaces[i]);
 	}
+	_faceEBO = OpenGLSDriver::createMaterialSortedEBO(faces, _drawRanges);
 }
 
 GLuint OpenGLSPropRenderer::createFaceVBO() {
@@ -136,15 +140,9 @@ GLuint OpenGLSPropRenderer::createFaceVBO() {
 	return OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, sizeof(float) * 9 * vertices.size(), &vertices.front());
 }
 
-GLuint OpenGLSPropRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices.front());
-}
-
 void OpenGLSPropRenderer::setLightArrayUniform(const LightEntryArray &lights) {
-	static const uint maxLights = 10;
-
 	assert(lights.size() >= 1);
-	assert(lights.size() <= maxLights);
+	assert(lights.size() <= OpenGLSDriver::kMaxLights);
 
 	const LightEntry *ambient = lights[0];
 	assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
@@ -171,9 +169,10 @@ void OpenGLSPropRenderer::setLightArrayUniform(const LightEntryArray &lights) {
 		Math::Vector3d eyeDirection = viewMatrixRot * worldDirection;
 		eyeDirection.normalize();
 
-		_shader->setUniform(Common::String::format("lights[%d].position", i).c_str(), eyePosition);
-		_shader->setUniform(Common::String::format("lights[%d].direction", i).c_str(), eyeDirection);
-		_shader->setUniform(Common::String::format("lights[%d].color", i).c_str(), l->color);
+		const LightUniformNames &names = OpenGLSDriver::getLightUniformNames(i);
+		_shader->setUniform(names.position.c_str(), eyePosition);
+		_shader->setUniform(names.direction.c_str(), eyeDirection);
+		_shader->setUniform(names.color.c_str(), l->color);
 
 		Math::Vector4d params;
 		params.x() = l->falloffNear;
@@ -181,12 +180,12 @@ void OpenGLSPropRenderer::setLightArrayUniform(const LightEntryArray &lights) {
 		params.z() = l->innerConeAngle.getCosine();
 		params.w() = l->outerConeAngle.getCosine();
 
-		_shader->setUniform(Common::String::format("lights[%d].params", i).c_str(), params);
+		_shader->setUniform(names.params.c_str(), params);
 	}
 
-	for (uint i = lights.size() - 1; i < maxLights; i++) {
+	for (uint i = lights.size() - 1; i < OpenGLSDriver::kMaxLights; i++) {
 		// Make sure unused lights are disabled
-		_shader->setUniform(Common::String::format("lights[%d].position", i).c_str(), Math::Vector4d());
+		_shader->setUniform(OpenGLSDriver::getLightUniformNames(i).position.c_str(), Math::Vector4d());
 	}
 }
 
@@ -23,12 +23,10 @@
 #ifndef STARK_GFX_OPENGL_S_RENDERED_H
 #define STARK_GFX_OPENGL_S_RENDERED_H
 
+#include "engines/stark/gfx/opengls.h"
 #include "engines/stark/model/model.h"
 #include "engines/stark/visual/prop.h"
 
-#include "common/hashmap.h"
-#include "common/hash-ptr.h"
-
 #include "graphics/opengl/system_headers.h"
 
 #if defined(USE_GLES2) || defined(USE_OPENGL_SHADERS)
@@ -41,29 +39,26 @@ namespace Stark {
 
 namespace Gfx {
 
-class Driver;
-
 class OpenGLSPropRenderer : public VisualProp {
 public:
-	explicit OpenGLSPropRenderer(Driver *gfx);
+	explicit OpenGLSPropRenderer(OpenGLSDriver *gfx);
 	~OpenGLSPropRenderer() override;
 
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
+	void warmUp() override;
 
 protected:
-	typedef Common::HashMap<const Face *, GLuint> FaceBufferMap;
-
-	Driver *_gfx;
+	OpenGLSDriver *_gfx;
 	OpenGL::ShaderGL *_shader;
 
 	bool _modelIsDirty;
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	GLuint _faceEBO;
+	Common::Array<MaterialDrawRange> _drawRanges;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createFaceVBO();
-	GLuint createFaceEBO(const Face *face);
 
 	void setLightArrayUniform(const LightEntryArray &lights);
 
@@ -22,17 +22,39 @@
 
 #include "engines/stark/services/archiveloader.h"
 
+#include "engines/stark/debug.h"
 #include "engines/stark/formats/xrc.h"
 #include "engines/stark/resources/level.h"
 #include "engines/stark/resources/location.h"
 
+#include "common/algorithm.h"
+#include "common/debug.h"
+#include "common/file.h"
+#include "common/threadpool.h"
+
 namespace Stark {
 
-ArchiveLoader::LoadedArchive::LoadedArchive(const Common::String& archiveName) :
+enum {
+	// The archives of the next locations are read ahead up to these limits
+	kMaxPreloads = 4,
+	kMaxPreloadedSize = 32 * 1024 * 1024
+};
+
+// An archive read to memory by a task of the thread pool
+struct ArchiveLoader::Preload {
+	Common::String filename;
+	Common::File *file;
+	byte *contents;
+	uint32 size;
+	bool failed;
+	Common::TaskGroup group;
+};
+
+ArchiveLoader::LoadedArchive::LoadedArchive(const Common::String& archiveName, byte *contents, uint32 size) :
 		_filename(archiveName),
 		_root(nullptr),
 		_useCount(0) {
-	if (!_xarc.open(archiveName)) {
+	if (!_xarc.open(archiveName, contents, size)) {
 		error("Unable to open archive '%s'", archiveName.c_str());
 	}
 }
@@ -49,7 +71,13 @@ void ArchiveLoader::LoadedArchive::importResources() {
 	_root = Formats::XRCReader::importTree(&_xarc);
 }
 
+ArchiveLoader::ArchiveLoader() :
+		_preloadedSize(0) {
+}
+
 ArchiveLoader::~ArchiveLoader() {
+	preload(Common::StringArray());
+
 	for (LoadedArchiveList::iterator it = _archives.begin(); it != _archives.end(); it++) {
 		delete *it;
 	}
@@ -61,14 +89,102 @@ bool ArchiveLoader::load(const Common::String &archiveName) {
 		return false;
 	}
 
-	LoadedArchive *archive = new LoadedArchive(archiveName);
+	// Use the contents read ahead, waiting for them if they are still being read
+	byte *contents = nullptr;
+	uint32 size = 0;
+	for (PreloadList::iterator it = _preloads.begin(); it != _preloads.end(); it++) {
+		if ((*it)->filename == archiveName) {
+			finishPreload(*it, contents, size);
+			_preloads.erase(it);
+			break;
+		}
+	}
+
+	LoadedArchive *archive = new LoadedArchive(archiveName, contents, size);
 	_archives.push_back(archive);
 
+	// The resource tree is imported here on the main thread, the resources
+	// create their renderers and textures while being read
 	archive->importResources();
 
 	return true;
 }
 
+void ArchiveLoader::preload(const Common::StringArray &archiveNames) {
+	// Forget the archives which are not needed anymore
+	for (PreloadList::iterator it = _preloads.begin(); it != _preloads.end(); ) {
+		if (Common::find(archiveNames.begin(), archiveNames.end(), (*it)->filename) == archiveNames.end()) {
+			byte *contents = nullptr;
+			uint32 size = 0;
+			finishPreload(*it, contents, size);
+			delete[] contents;
+			it = _preloads.erase(it);
+		} else {
+			it++;
+		}
+	}
+
+	if (archiveNames.empty() || Common::ThreadPool::instance().getNumWorkers() == 0) {
+		return;
+	}
+
+	for (uint i = 0; i < archiveNames.size() && _preloads.size() < kMaxPreloads; i++) {
+		const Common::String &archiveName = archiveNames[i];
+		if (hasArchive(archiveName)) {
+			continue;
+		}
+
+		bool pending = false;
+		for (PreloadList::const_iterator it = _preloads.begin(); it != _preloads.end(); it++) {
+			pending |= (*it)->filename == archiveName;
+		}
+		if (pending) {
+			continue;
+		}
+
+		// The file is opened here, only its contents are read in the background
+		Common::File *file = new Common::File();
+		if (!file->open(archiveName) || _preloadedSize + (uint32)file->size() > kMaxPreloadedSize) {
+			delete file;
+			continue;
+		}
+
+		Preload *preload = new Preload();
+		preload->filename = archiveName;
+		preload->file = file;
+		preload->size = file->size();
+		preload->contents = new byte[preload->size];
+		preload->failed = false;
+		_preloadedSize += preload->size;
+
+		_preloads.push_back(preload);
+		preload->group.run(&readPreload, preload);
+
+		debugC(3, kDebugArchive, "Reading ahead archive '%s' (%d bytes)", archiveName.c_str(), preload->size);
+	}
+}
+
+void ArchiveLoader::readPreload(void *refCon) {
+	Preload *preload = (Preload *)refCon;
+	preload->failed = preload->file->read(preload->contents, preload->size) != preload->size;
+}
+
+void ArchiveLoader::finishPreload(Preload *preload, byte *&contents, uint32 &size) {
+	preload->group.wait();
+
+	if (preload->failed) {
+		warning("Could not read ahead archive '%s'", preload->filename.c_str());
+		delete[] preload->contents;
+	} else {
+		contents = preload->contents;
+		size = preload->size;
+	}
+
+	_preloadedSize -= preload->size;
+	delete preload->file;
+	delete preload;
+}
+
 void ArchiveLoader::unloadUnused() {
 	for (LoadedArchiveList::iterator it = _archives.begin(); it != _archives.end(); it++) {
 		if (!(*it)->isInUse()) {
@@ -133,12 +249,16 @@ Common::String ArchiveLoader::buildArchiveName(Resources::Level *level, Resource
 			error("Unknown level type %d", level->getSubType());
 		}
 	} else {
-		archive = Common::String::format("%02x/%02x/%02x.xarc", level->getIndex(), location->getIndex(), location->getIndex());
+		archive = buildLocationArchiveName(level->getIndex(), location->getIndex());
 	}
 
 	return archive;
 }
 
+Common::String ArchiveLoader::buildLocationArchiveName(uint16 level, uint16 location) const {
+	return Common::String::format("%02x/%02x/%02x.xarc", level, location, location);
+}
+
 Common::String ArchiveLoader::getExternalFilePath(const Common::String &fileName, const Common::String &archiveName) const {
 	static const char separator = '/';
 
@@ -25,6 +25,7 @@
 
 #include "common/list.h"
 #include "common/str.h"
+#include "common/str-array.h"
 #include "common/substream.h"
 #include "common/util.h"
 
@@ -65,11 +66,20 @@ public:
 class ArchiveLoader {
 
 public:
+	ArchiveLoader();
 	~ArchiveLoader();
 
 	/** Load a Xarc archive, and add it to the managed archives list */
 	bool load(const Common::String &archiveName);
 
+	/**
+	 * Read Xarc archives to memory in the background, for a later load
+	 *
+	 * The archives read ahead before, which are not in the list and were
+	 * not loaded, are forgotten.
+	 */
+	void preload(const Common::StringArray &archiveNames);
+
 	/** Unload all the unused Xarc archives */
 	void unloadUnused();
 
@@ -85,6 +95,7 @@ public:
 
 	/** Build the archive filename for a level or a location */
 	Common::String buildArchiveName(Resources::Level *level, Resources::Location *location = nullptr) const;
+	Common::String buildLocationArchiveName(uint16 level, uint16 location) const;
 
 	/** Retrieve a file relative to a specified archive */
 	Common::SeekableReadStream *getExternalFile(const Common::String &fileName, const Common::String &archiveName) const;
@@ -93,7 +104,7 @@ public:
 private:
 	class LoadedArchive {
 	public:
-		explicit LoadedArchive(const Common::String &archiveName);
+		LoadedArchive(const Common::String &archiveName, byte *contents, uint32 size);
 		~LoadedArchive();
 
 		const Common::String &getFilename() const { return _filename; }
@@ -113,12 +124,20 @@ private:
 		Resources::Object *_root;
 	};
 
+	struct Preload;
+
 	typedef Common::List<LoadedArchive *> LoadedArchiveList;
+	typedef Common::List<Preload *> PreloadList;
 
 	bool hasArchive(const Common::String &archiveName) const;
 	LoadedArchive *findArchive(const Common::String &archiveName) const;
 
+	static void readPreload(void *refCon);
+	void finishPreload(Preload *preload, byte *&contents, uint32 &size);
+
 	LoadedArchiveList _archives;
+	PreloadList _preloads;
+	uint32 _preloadedSize;
 };
 
 template <class T>
@@ -22,8 +22,10 @@
 
 #include "engines/stark/services/resourceprovider.h"
 
+#include "engines/stark/resources/anim.h"
 #include "engines/stark/resources/bookmark.h"
 #include "engines/stark/resources/camera.h"
+#include "engines/stark/resources/command.h"
 #include "engines/stark/resources/floor.h"
 #include "engines/stark/resources/item.h"
 #include "engines/stark/resources/knowledgeset.h"
@@ -40,8 +42,18 @@
 #include "engines/stark/services/stateprovider.h"
 #include "engines/stark/services/userinterface.h"
 
+#include "engines/stark/visual/prop.h"
+
+#include "common/algorithm.h"
+#include "common/profiler.h"
+
 namespace Stark {
 
+enum {
+	// The time spent each frame uploading the models of a new location
+	kWarmUpBudgetMicros = 2000
+};
+
 ResourceProvider::ResourceProvider(ArchiveLoader *archiveLoader, StateProvider *stateProvider, Global *global) :
 		_archiveLoader(archiveLoader),
 		_stateProvider(stateProvider),
@@ -256,9 +268,71 @@ void ResourceProvider::performLocationChange() {
 	current->getLocation()->resetAnimationBlending();
 	purgeOldLocations();
 
+	preloadExits();
+	_propsToWarmUp = current->getLocation()->listChildrenRecursive<Resources::AnimProp>();
+
 	_locationChangeRequest = false;
 }
 
+void ResourceProvider::preloadExits() {
+	// Read the archives of the locations the exits of the current location
+	// lead to in the background, so that they are in memory when the player
+	// takes one of them. The resource trees are imported when the location
+	// is entered, on the main thread.
+	Resources::Root *root = _global->getRoot();
+	Common::StringArray archiveNames;
+
+	Common::Array<Resources::Command *> commands = _global->getCurrent()->getLocation()->listChildrenRecursive<Resources::Command>();
+	for (uint i = 0; i < commands.size(); i++) {
+		if (commands[i]->getSubType() != Resources::Command::kLocationGoTo
+				&& commands[i]->getSubType() != Resources::Command::kLocationGoToNewCD) {
+			continue;
+		}
+
+		Common::Array<Resources::Command::Argument> arguments = commands[i]->getArguments();
+		if (arguments.size() < 2) {
+			continue;
+		}
+
+		uint levelIndex = strtol(arguments[0].stringValue.c_str(), nullptr, 16);
+		uint locationIndex = strtol(arguments[1].stringValue.c_str(), nullptr, 16);
+
+		Resources::Level *level = root->findChildWithIndex<Resources::Level>(levelIndex);
+		if (!level) {
+			continue;
+		}
+
+		Common::String exitArchiveNames[] = {
+			_archiveLoader->buildArchiveName(level),
+			_archiveLoader->buildLocationArchiveName(levelIndex, locationIndex)
+		};
+		for (uint j = 0; j < ARRAYSIZE(exitArchiveNames); j++) {
+			if (Common::find(archiveNames.begin(), archiveNames.end(), exitArchiveNames[j]) == archiveNames.end()) {
+				archiveNames.push_back(exitArchiveNames[j]);
+			}
+		}
+	}
+
+	_archiveLoader->preload(archiveNames);
+}
+
+void ResourceProvider::warmUpLocation() {
+	if (_propsToWarmUp.empty()) {
+		return;
+	}
+
+	uint64 start = Common::Profiler::getMicros();
+	while (!_propsToWarmUp.empty() && Common::Profiler::getMicros() - start < kWarmUpBudgetMicros) {
+		Visual *visual = _propsToWarmUp.back()->getVisual();
+		_propsToWarmUp.pop_back();
+
+		VisualProp *prop = visual ? visual->get<VisualProp>() : nullptr;
+		if (prop) {
+			prop->warmUp();
+		}
+	}
+}
+
 void ResourceProvider::runLocationChangeScripts(Resources::Object *resource, uint32 scriptCallMode) {
 	Common::Array<Resources::Script *> scripts = resource->listChildrenRecursive<Resources::Script>();
 
@@ -353,6 +427,9 @@ void ResourceProvider::commitActiveLocationsState() {
 void ResourceProvider::shutdown() {
 	_stateProvider->clear();
 
+	_propsToWarmUp.clear();
+	_archiveLoader->preload(Common::StringArray());
+
 	_locationStack.clear();
 
 	// Flush the locations list
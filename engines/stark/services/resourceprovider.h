@@ -23,6 +23,7 @@
 #ifndef STARK_SERVICES_RESOURCE_PROVIDER_H
 #define STARK_SERVICES_RESOURCE_PROVIDER_H
 
+#include "common/array.h"
 #include "common/list.h"
 
 #include "engines/stark/resourcereference.h"
@@ -30,6 +31,7 @@
 namespace Stark {
 
 namespace Resources {
+class AnimProp;
 class Level;
 class Location;
 class Object;
@@ -79,6 +81,12 @@ public:
 	/** Set the initial position and direction for the next location change */
 	void setNextLocationPosition(const ResourceReference &bookmark, int32 direction);
 
+	/**
+	 * Upload the models of the current location which were not rendered yet,
+	 * for a short time each frame, so that they do not stall a later frame
+	 */
+	void warmUpLocation();
+
 	/** Save the current location state to the state store. */
 	void commitActiveLocationsState();
 
@@ -112,6 +120,7 @@ private:
 	Current *findLocation(uint16 level, uint16 location) const;
 
 	void purgeOldLocations();
+	void preloadExits();
 
 	void runLocationChangeScripts(Resources::Object *resource, uint32 scriptCallMode);
 	void setAprilInitialPosition();
@@ -125,6 +134,7 @@ private:
 	bool _restoreCurrentState;
 
 	CurrentList _locations;
+	Common::Array<Resources::AnimProp *> _propsToWarmUp;
 
 	ResourceReference _nextPositionBookmarkReference;
 	int32 _nextDirection;
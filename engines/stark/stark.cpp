@@ -169,6 +169,8 @@ void StarkEngine::mainLoop() {
 			StarkResourceProvider->performLocationChange();
 		}
 
+		StarkResourceProvider->warmUpLocation();
+
 		StarkUserInterface->doQueuedScreenChange();
 
 		updateDisplayScene();
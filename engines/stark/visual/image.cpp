@@ -78,6 +78,7 @@ bool VisualImageXMG::loadPNG(Common::SeekableReadStream *stream) {
 
 	// Decode the XMG
 	Image::PNGDecoder pngDecoder;
+	pngDecoder.setOutputPixelFormat(Gfx::Driver::getRGBAPixelFormat());
 	if (!pngDecoder.loadStream(*stream)) {
 		return false;
 	}
@@ -53,6 +53,9 @@ public:
 	bool intersectRay(const Math::Ray &ray, const Math::Vector3d &position, float direction);
 	virtual void render(const Math::Vector3d &position, float direction, const Gfx::LightEntryArray &lights) = 0;
 
+	/** Upload the model to the renderer ahead of its first render */
+	virtual void warmUp() {}
+
 protected:
 	Formats::BiffMesh *_model;
 	Gfx::TextureSet *_texture;
@@ -88,6 +88,7 @@ Debugger::Debugger(Sword2Engine *vm)
 	registerCmd("tony",     WRAP_METHOD(Debugger, Cmd_Tony));
 	registerCmd("res",      WRAP_METHOD(Debugger, Cmd_Res));
 	registerCmd("reslist",  WRAP_METHOD(Debugger, Cmd_ResList));
+	registerCmd("rescache", WRAP_METHOD(Debugger, Cmd_ResCache));
 	registerCmd("starts",   WRAP_METHOD(Debugger, Cmd_Starts));
 	registerCmd("start",    WRAP_METHOD(Debugger, Cmd_Start));
 	registerCmd("s",        WRAP_METHOD(Debugger, Cmd_Start));
@@ -292,6 +293,11 @@ bool Debugger::Cmd_ResList(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::Cmd_ResCache(int argc, const char **argv) {
+	_vm->_resman->printCacheInfo();
+	return true;
+}
+
 bool Debugger::Cmd_Starts(int argc, const char **argv) {
 	uint32 numStarts = _vm->getNumStarts();
 
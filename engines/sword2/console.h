@@ -91,6 +91,7 @@ private:
 	bool Cmd_Tony(int argc, const char **argv);
 	bool Cmd_Res(int argc, const char **argv);
 	bool Cmd_ResList(int argc, const char **argv);
+	bool Cmd_ResCache(int argc, const char **argv);
 	bool Cmd_Starts(int argc, const char **argv);
 	bool Cmd_Start(int argc, const char **argv);
 	bool Cmd_Info(int argc, const char **argv);
@@ -225,6 +225,9 @@ void Logic::expressChangeSession(uint32 sesh_id) {
 	_router->clearWalkGridList();
 	_vm->_sound->clearFxQueue(false);
 	_router->freeAllRouteMem();
+
+	// Start reading the new screen while the old one is being left
+	_vm->_resman->prefetchSession(sesh_id);
 }
 
 /**
@@ -23,9 +23,12 @@
  */
 
 
+#include "common/algorithm.h"
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 
 #include "sword2/sword2.h"
 #include "sword2/defs.h"
@@ -64,6 +67,28 @@ struct CdInf {
 	uint8 cd;		// Cd cluster is on and whether it is on the local drive or not.
 };
 
+enum {
+	// The maximum number of resources recorded for a session
+	kMaxSessionPrefetch = 64
+};
+
+struct PrefetchEntry {
+	uint32 res;
+	byte *ptr;
+	uint32 pos;
+	uint32 len;
+
+	bool operator<(const PrefetchEntry &other) const { return pos < other.pos; }
+};
+
+// The resources read ahead from one cluster file, by a task of the thread pool
+struct PrefetchCluster {
+	Common::File *file;
+	Common::Array<PrefetchEntry> entries;
+	bool failed;
+	Common::TaskGroup group;
+};
+
 ResourceManager::ResourceManager(Sword2Engine *vm) {
 	_vm = vm;
 
@@ -73,9 +98,15 @@ ResourceManager::ResourceManager(Sword2Engine *vm) {
 	_cacheStart = NULL;
 	_cacheEnd = NULL;
 	_usedMem = 0;
+	_maxMem = MAX_MEM_CACHE;
+	_recordedSession = 0;
+	_cacheHits = _cacheMisses = 0;
+	_numPrefetched = _prefetchHits = 0;
 }
 
 ResourceManager::~ResourceManager() {
+	finishPrefetches(true);
+
 	Resource *res = _cacheStart;
 	while (res) {
 		_vm->_memory->memFree(res->ptr);
@@ -248,8 +279,15 @@ bool ResourceManager::init() {
 		_resList[i].size = 0;
 		_resList[i].refCount = 0;
 		_resList[i].prev = _resList[i].next = NULL;
+		_resList[i].pending = NULL;
+		_resList[i].prefetched = false;
 	}
 
+	// The cache size can be raised on platforms with plenty of memory, to
+	// keep more screens around
+	if (ConfMan.hasKey("sword2_resource_cache_size"))
+		_maxMem = MAX(ConfMan.getInt("sword2_resource_cache_size"), 1024) * 1024;
+
 	return true;
 }
 
@@ -266,9 +304,32 @@ byte *ResourceManager::openResource(uint32 res, bool dump) {
 		if (res == 342) res = 364; // Rewire RESTORE ICON to SAVE ICON
 	}
 
+	// Take the resources which were read in the background meanwhile, or
+	// wait for this one if it is still being read.
+
+	if (!_prefetchClusters.empty()) {
+		if (_resList[res].pending)
+			finishPrefetch(_resList[res].pending);
+		finishPrefetches(false);
+	}
+
 	// Is the resource in memory already? If not, load it.
 
-	if (!_resList[res].ptr) {
+	if (_resList[res].ptr) {
+		_cacheHits++;
+		if (_resList[res].prefetched) {
+			_resList[res].prefetched = false;
+			_prefetchHits++;
+		}
+	} else {
+		_cacheMisses++;
+
+		if (_recordedSession && res != 1 && res != CUR_PLAYER_ID) {
+			Common::Array<uint32> &resources = _sessionResources[_recordedSession];
+			if (resources.size() < kMaxSessionPrefetch && Common::find(resources.begin(), resources.end(), res) == resources.end())
+				resources.push_back(res);
+		}
+
 		// Fetch the correct file and read in the correct portion.
 		uint16 cluFileNum = _resConvTable[res * 2]; // points to the number of the ascii filename
 
@@ -382,7 +443,9 @@ byte *ResourceManager::openResource(uint32 res, bool dump) {
 
 		_usedMem += len;
 		checkMemUsage();
-	} else if (_resList[res].refCount == 0)
+	}
+
+	if (_resList[res].refCount == 0)
 		removeFromCacheList(_resList + res);
 
 	_resList[res].refCount++;
@@ -558,7 +621,7 @@ uint32 ResourceManager::fetchLen(uint32 res) {
 }
 
 void ResourceManager::checkMemUsage() {
-	while (_usedMem > MAX_MEM_CACHE) {
+	while (_usedMem > _maxMem) {
 		// we're using up more memory than we wanted to. free some old stuff.
 		// Newly loaded objects are added to the start of the list,
 		// we start freeing from the end, to free the oldest items first
@@ -578,16 +641,179 @@ void ResourceManager::checkMemUsage() {
 }
 
 void ResourceManager::remove(int res) {
+	if (_resList[res].pending)
+		finishPrefetch(_resList[res].pending);
+
 	if (_resList[res].ptr) {
 		removeFromCacheList(_resList + res);
 
 		_vm->_memory->memFree(_resList[res].ptr);
 		_resList[res].ptr = NULL;
 		_resList[res].refCount = 0;
+		_resList[res].prefetched = false;
 		_usedMem -= _resList[res].size;
 	}
 }
 
+void ResourceManager::readPrefetched(void *refCon) {
+	PrefetchCluster *cluster = (PrefetchCluster *)refCon;
+
+	for (uint i = 0; i < cluster->entries.size() && !cluster->failed; i++) {
+		const PrefetchEntry &entry = cluster->entries[i];
+		cluster->file->seek(entry.pos, SEEK_SET);
+		if (cluster->file->read(entry.ptr, entry.len) != entry.len)
+			cluster->failed = true;
+	}
+}
+
+void ResourceManager::prefetchSession(uint32 runList) {
+	_recordedSession = runList;
+
+	if (!runList || !checkValid(runList) || Common::ThreadPool::instance().getNumWorkers() == 0)
+		return;
+
+	// The run list itself is needed right away, so it is read here, the
+	// objects it lists are read in the background with the resources the
+	// session loaded the last time.
+	Common::Array<uint32> ids;
+	byte *objectList = openResource(runList) + ResHeader::size();
+	for (uint32 i = 0; ; i++) {
+		uint32 id = READ_LE_UINT32(objectList + 4 * i);
+		if (!id)
+			break;
+		ids.push_back(id);
+	}
+	closeResource(runList);
+
+	if (_sessionResources.contains(runList)) {
+		const Common::Array<uint32> &resources = _sessionResources[runList];
+		for (uint i = 0; i < resources.size(); i++) {
+			if (Common::find(ids.begin(), ids.end(), resources[i]) == ids.end())
+				ids.push_back(resources[i]);
+		}
+	}
+
+	// Use at most half of the cache, so that reading ahead does not push
+	// out what is being used for nothing, and keep clear of the limit of
+	// the memory manager.
+	PrefetchCluster *clusters[MAX_res_files] = { NULL };
+	uint32 prefetchedMem = 0;
+	uint numPrefetched = 0;
+
+	for (uint i = 0; i < ids.size() && prefetchedMem < _maxMem / 2; i++) {
+		uint32 res = ids[i];
+		if (!checkValid(res) || _resList[res].ptr || _resList[res].pending)
+			continue;
+
+		if (_vm->_memory->getNumBlocks() + numPrefetched >= MAX_MEMORY_BLOCKS / 2)
+			break;
+
+		uint16 cluFileNum = _resConvTable[res * 2];
+		uint16 actual_res = _resConvTable[(res * 2) + 1];
+
+		// Never ask for a CD here. The clusters of the other CD are left
+		// to openResource, which also keeps track of the current CD.
+		if (!Sword2Engine::isPsx() && _resFiles[cluFileNum].cd != 0 && _resFiles[cluFileNum].cd != _curCD)
+			continue;
+
+		PrefetchCluster *cluster = clusters[cluFileNum];
+		if (!cluster) {
+			Common::File *file = new Common::File;
+			if (!file->open(_resFiles[cluFileNum].fileName)) {
+				delete file;
+				continue;
+			}
+
+			if (_resFiles[cluFileNum].entryTab == NULL)
+				readCluIndex(cluFileNum, file);
+
+			cluster = clusters[cluFileNum] = new PrefetchCluster;
+			cluster->file = file;
+			cluster->failed = false;
+		}
+
+		PrefetchEntry entry;
+		entry.res = res;
+		entry.pos = _resFiles[cluFileNum].entryTab[actual_res * 2 + 0];
+		entry.len = _resFiles[cluFileNum].entryTab[actual_res * 2 + 1];
+		entry.ptr = _vm->_memory->memAlloc(entry.len, res);
+		cluster->entries.push_back(entry);
+
+		_resList[res].pending = cluster;
+		prefetchedMem += entry.len;
+		numPrefetched++;
+	}
+
+	for (uint i = 0; i < MAX_res_files; i++) {
+		PrefetchCluster *cluster = clusters[i];
+		if (!cluster)
+			continue;
+
+		// Read the cluster in order, as it is laid out on the CD
+		Common::sort(cluster->entries.begin(), cluster->entries.end());
+		_prefetchClusters.push_back(cluster);
+		cluster->group.run(&readPrefetched, cluster);
+	}
+
+	debug(3, "Prefetching %d resources (%d bytes) for session %d", numPrefetched, prefetchedMem, runList);
+}
+
+void ResourceManager::finishPrefetch(PrefetchCluster *cluster) {
+	cluster->group.wait();
+
+	if (cluster->failed)
+		warning("Could not read ahead from '%s'", cluster->file->getName());
+
+	for (uint i = 0; i < cluster->entries.size(); i++) {
+		const PrefetchEntry &entry = cluster->entries[i];
+		Resource *res = _resList + entry.res;
+		res->pending = NULL;
+
+		if (cluster->failed) {
+			_vm->_memory->memFree(entry.ptr);
+			continue;
+		}
+
+		res->ptr = entry.ptr;
+		res->size = entry.len;
+		res->refCount = 0;
+		res->prefetched = true;
+		addToCacheList(res);
+		_usedMem += entry.len;
+		_numPrefetched++;
+	}
+
+	delete cluster->file;
+	_prefetchClusters.erase(Common::find(_prefetchClusters.begin(), _prefetchClusters.end(), cluster));
+	delete cluster;
+
+	checkMemUsage();
+}
+
+void ResourceManager::finishPrefetches(bool wait) {
+	for (uint i = 0; i < _prefetchClusters.size();) {
+		if (wait || _prefetchClusters[i]->group.isDone())
+			finishPrefetch(_prefetchClusters[i]);
+		else
+			i++;
+	}
+}
+
+void ResourceManager::printCacheInfo() {
+	uint numCached = 0;
+	uint32 cachedMem = 0;
+	for (Resource *res = _cacheStart; res; res = res->next) {
+		numCached++;
+		cachedMem += res->size;
+	}
+
+	Debug_Printf("Resources in memory: %d KB of %d KB\n", _usedMem / 1024, _maxMem / 1024);
+	Debug_Printf("Closed resources kept: %d (%d KB)\n", numCached, cachedMem / 1024);
+	Debug_Printf("Opened: %d from memory, %d from disk\n", _cacheHits, _cacheMisses);
+	Debug_Printf("Read ahead: %d, %d of them used\n", _numPrefetched, _prefetchHits);
+	Debug_Printf("Sessions recorded: %d, being read: %d clusters\n", _sessionResources.size(), _prefetchClusters.size());
+}
+
 /**
  * Remove all res files from memory - ready for a total restart. This includes
  * the player object and global variables resource.
@@ -25,22 +25,28 @@
 #ifndef	SWORD2_RESMAN_H
 #define	SWORD2_RESMAN_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
+
 namespace Common {
 class File;
 }
 
-#define MAX_MEM_CACHE (8 * 1024 * 1024) // we keep up to 8 megs of resource data files in memory
+#define MAX_MEM_CACHE (8 * 1024 * 1024) // we keep up to 8 megs of resource data files in memory, unless configured otherwise
 #define	MAX_res_files 20
 
 namespace Sword2 {
 
 class Sword2Engine;
+struct PrefetchCluster;
 
 struct Resource {
 	byte *ptr;
 	uint32 size;
 	uint32 refCount;
 	Resource *next, *prev;
+	PrefetchCluster *pending;	// being read in the background
+	bool prefetched;		// read in the background, and not opened yet
 };
 
 struct ResourceFile {
@@ -58,6 +64,10 @@ private:
 	void addToCacheList(Resource *res);
 	void checkMemUsage();
 
+	static void readPrefetched(void *refCon);
+	void finishPrefetch(PrefetchCluster *cluster);
+	void finishPrefetches(bool wait);
+
 	Sword2Engine *_vm;
 
 	int _curCD;
@@ -72,6 +82,15 @@ private:
 
 	Resource *_cacheStart, *_cacheEnd;
 	uint32 _usedMem; // amount of used memory in bytes
+	uint32 _maxMem; // amount of memory the closed resources may use
+
+	// The resources loaded by each session, read ahead when it starts again
+	Common::HashMap<uint32, Common::Array<uint32> > _sessionResources;
+	uint32 _recordedSession;
+	Common::Array<PrefetchCluster *> _prefetchClusters;
+
+	uint32 _cacheHits, _cacheMisses;
+	uint32 _numPrefetched, _prefetchHits;
 
 public:
 	ResourceManager(Sword2Engine *vm);	// read in the config file
@@ -130,10 +149,17 @@ public:
 	void remove(int res);
 	void removeAll();
 
+	/**
+	 * Start reading the resources of a new session in the background: the
+	 * objects of its run list, and what it loaded the last time it ran.
+	 */
+	void prefetchSession(uint32 runList);
+
 	// ----console commands
 
 	void killAll(bool wantInfo);
 	void killAllObjects(bool wantInfo);
+	void printCacheInfo();
 };
 
 } // End of namespace Sword2
@@ -192,6 +192,11 @@ public:
 		return _pImage->isSolid();
 	}
 
+	Common::Rect getOpaqueRect() {
+		assert(_pImage);
+		return _pImage->getOpaqueRect();
+	}
+
 private:
 	Image *_pImage;
 };
@@ -192,6 +192,11 @@ public:
 
 	virtual bool isSolid() const { return false; }
 
+	/**
+	    @brief Returns the largest rectangle, in image coordinates, which only contains fully opaque pixels
+	*/
+	virtual Common::Rect getOpaqueRect() const { return Common::Rect(); }
+
 	//@}
 };
 
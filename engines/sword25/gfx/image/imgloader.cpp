@@ -42,17 +42,22 @@ bool ImgLoader::decodePNGImage(const byte *fileDataPtr, uint fileSize, Graphics:
 	assert(dest);
 	Common::MemoryReadStream *fileStr = new Common::MemoryReadStream(fileDataPtr, fileSize, DisposeAfterUse::NO);
 
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
 	::Image::PNGDecoder png;
+	png.setOutputPixelFormat(format);
 	if (!png.loadStream(*fileStr)) // the fileStr pointer, and thus pFileData will be deleted after this is done
 		error("Error while reading PNG image");
 
 	const Graphics::Surface *sourceSurface = png.getSurface();
-	Graphics::Surface *pngSurface = sourceSurface->convertTo(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), png.getPalette());
-
-	dest->copyFrom(*pngSurface);
+	if (sourceSurface->format == format) {
+		dest->copyFrom(*sourceSurface);
+	} else {
+		Graphics::Surface *pngSurface = sourceSurface->convertTo(format, png.getPalette());
+		dest->copyFrom(*pngSurface);
+		pngSurface->free();
+		delete pngSurface;
+	}
 
-	pngSurface->free();
-	delete pngSurface;
 	delete fileStr;
 
 	// Signal success
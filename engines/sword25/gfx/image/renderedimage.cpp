@@ -142,10 +142,7 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 
 	_doCleanup = true;
 
-#if defined(SCUMM_LITTLE_ENDIAN)
-	// Makes sense for LE only at the moment
 	checkForTransparency();
-#endif
 
 	return;
 }
@@ -259,13 +256,48 @@ void RenderedImage::copyDirectly(int posX, int posY) {
 void RenderedImage::checkForTransparency() {
 	// Check if the source bitmap has any transparent pixels at all
 	_isTransparent = false;
-	byte *data = (byte *)_surface.getPixels();
-	for (int i = 0; i < _surface.h; i++) {
+	const uint32 alphaMask = 0xff << _surface.format.aShift;
+	for (int i = 0; i < _surface.h && !_isTransparent; i++) {
+		const uint32 *data = (const uint32 *)_surface.getBasePtr(0, i);
 		for (int j = 0; j < _surface.w; j++) {
-			_isTransparent = data[3] != 0xff;
+			_isTransparent = (data[j] & alphaMask) != alphaMask;
 			if (_isTransparent)
-				return;
-			data += 4;
+				break;
+		}
+	}
+
+	if (_isTransparent)
+		findOpaqueRect();
+}
+
+void RenderedImage::findOpaqueRect() {
+	// Find the largest rectangle of opaque pixels, row by row: the opaque pixels
+	// ending on each row form columns, and the largest rectangle under those is
+	// found from a stack of increasing column heights
+	const uint32 alphaMask = 0xff << _surface.format.aShift;
+	const int w = _surface.w;
+	Common::Array<int> heights(w + 1, 0);
+	Common::Array<int> stack;
+	int bestArea = 0;
+
+	_opaqueRect = Common::Rect();
+	for (int y = 0; y < _surface.h; y++) {
+		const uint32 *data = (const uint32 *)_surface.getBasePtr(0, y);
+		for (int x = 0; x < w; x++)
+			heights[x] = ((data[x] & alphaMask) == alphaMask) ? heights[x] + 1 : 0;
+
+		stack.clear();
+		for (int x = 0; x <= w; x++) {
+			while (!stack.empty() && heights[stack.back()] >= heights[x]) {
+				const int height = heights[stack.back()];
+				stack.pop_back();
+				const int left = stack.empty() ? 0 : stack.back() + 1;
+				if (height * (x - left) > bestArea) {
+					bestArea = height * (x - left);
+					_opaqueRect = Common::Rect(left, y - height + 1, x, y + 1);
+				}
+			}
+			stack.push_back(x);
 		}
 	}
 }
@@ -110,15 +110,20 @@ public:
 
 	void setIsTransparent(bool isTransparent) { _isTransparent = isTransparent; }
 	bool isSolid() const override { return !_isTransparent; }
+	Common::Rect getOpaqueRect() const override {
+		return _isTransparent ? _opaqueRect : Common::Rect(_surface.w, _surface.h);
+	}
 
 private:
 	Graphics::TransparentSurface _surface;
 	bool _doCleanup;
 	bool _isTransparent;
+	Common::Rect _opaqueRect;
 
 	Graphics::Surface *_backSurface;
 
 	void checkForTransparency();
+	void findOpaqueRect();
 };
 
 } // End of namespace Sword25
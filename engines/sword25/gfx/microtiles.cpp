@@ -24,9 +24,11 @@
 
 namespace Sword25 {
 
-MicroTileArray::MicroTileArray(int16 width, int16 height) {
-	_tilesW = (width / TileSize) + ((width % TileSize) > 0 ? 1 : 0);
-	_tilesH = (height / TileSize) + ((height % TileSize) > 0 ? 1 : 0);
+MicroTileArray::MicroTileArray(int16 width, int16 height, int tileSize) :
+	_width(width), _height(height), _tileSize(tileSize) {
+	assert(tileSize > 0 && tileSize <= MaxTileSize);
+	_tilesW = (width / _tileSize) + ((width % _tileSize) > 0 ? 1 : 0);
+	_tilesH = (height / _tileSize) + ((height % _tileSize) > 0 ? 1 : 0);
 	_tiles = new BoundingBox[_tilesW * _tilesH];
 	clear();
 }
@@ -41,24 +43,24 @@ void MicroTileArray::addRect(Common::Rect r) {
 	int tx0, ty0, tx1, ty1;
 	int ix0, iy0, ix1, iy1;
 
-	r.clip(Common::Rect(0, 0, 799, 599));
+	r.clip(Common::Rect(0, 0, _width - 1, _height - 1));
 
-	ux0 = r.left / TileSize;
-	uy0 = r.top / TileSize;
-	ux1 = r.right / TileSize;
-	uy1 = r.bottom / TileSize;
+	ux0 = r.left / _tileSize;
+	uy0 = r.top / _tileSize;
+	ux1 = r.right / _tileSize;
+	uy1 = r.bottom / _tileSize;
 
-	tx0 = r.left % TileSize;
-	ty0 = r.top % TileSize;
-	tx1 = r.right % TileSize;
-	ty1 = r.bottom % TileSize;
+	tx0 = r.left % _tileSize;
+	ty0 = r.top % _tileSize;
+	tx1 = r.right % _tileSize;
+	ty1 = r.bottom % _tileSize;
 
 	for (int yc = uy0; yc <= uy1; yc++) {
 		for (int xc = ux0; xc <= ux1; xc++) {
 			ix0 = (xc == ux0) ? tx0 : 0;
-			ix1 = (xc == ux1) ? tx1 : TileSize - 1;
+			ix1 = (xc == ux1) ? tx1 : _tileSize - 1;
 			iy0 = (yc == uy0) ? ty0 : 0;
-			iy1 = (yc == uy1) ? ty1 : TileSize - 1;
+			iy1 = (yc == uy1) ? ty1 : _tileSize - 1;
 			updateBoundingBox(_tiles[xc + yc * _tilesW], ix0, iy0, ix1, iy1);
 		}
 	}
@@ -90,7 +92,7 @@ bool MicroTileArray::isBoundingBoxEmpty(const BoundingBox &boundingBox) {
 }
 
 bool MicroTileArray::isBoundingBoxFull(const BoundingBox &boundingBox) {
-	return boundingBox == FullBoundingBox;
+	return boundingBox == (BoundingBox)(((_tileSize - 1) << 8) | (_tileSize - 1));
 }
 
 void MicroTileArray::setBoundingBox(BoundingBox &boundingBox, byte x0, byte y0, byte x1, byte y1) {
@@ -126,11 +128,11 @@ RectangleList *MicroTileArray::getRectangles() {
 				continue;
 			}
 
-			x0 = (x * TileSize) + TileX0(boundingBox);
-			y0 = (y * TileSize) + TileY0(boundingBox);
-			y1 = (y * TileSize) + TileY1(boundingBox);
+			x0 = (x * _tileSize) + TileX0(boundingBox);
+			y0 = (y * _tileSize) + TileY0(boundingBox);
+			y1 = (y * _tileSize) + TileY1(boundingBox);
 
-			if (TileX1(boundingBox) == TileSize - 1 && x != _tilesW - 1) {	// check if the tile continues
+			if (TileX1(boundingBox) == _tileSize - 1 && x != _tilesW - 1) {	// check if the tile continues
 				while (!finish) {
 					++x;
 					++i;
@@ -146,7 +148,7 @@ RectangleList *MicroTileArray::getRectangles() {
 				}
 			}
 
-			x1 = (x * TileSize) + TileX1(_tiles[i]);
+			x1 = (x * _tileSize) + TileX1(_tiles[i]);
 
 			rects->push_back(Common::Rect(x0, y0, x1 + 1, y1 + 1));
 
@@ -32,23 +32,25 @@ namespace Sword25 {
 
 typedef uint32 BoundingBox;
 
-const BoundingBox FullBoundingBox  = 0x00001F1F;
 const BoundingBox EmptyBoundingBox = 0x00000000;
-const int TileSize = 32;
+const int TileSize = 32;      ///< default tile size
+const int MaxTileSize = 256;  ///< the bounding boxes use a byte per coordinate
 
 class RectangleList : public Common::List<Common::Rect> {
 };
 
 class MicroTileArray {
 public:
-	MicroTileArray(int16 width, int16 height);
+	MicroTileArray(int16 width, int16 height, int tileSize = TileSize);
 	~MicroTileArray();
 	void addRect(Common::Rect r);
 	void clear();
 	RectangleList *getRectangles();
 protected:
 	BoundingBox *_tiles;
+	int16 _width, _height;
 	int16 _tilesW, _tilesH;
+	int _tileSize;
 	byte TileX0(const BoundingBox &boundingBox);
 	byte TileY0(const BoundingBox &boundingBox);
 	byte TileX1(const BoundingBox &boundingBox);
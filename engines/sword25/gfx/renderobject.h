@@ -372,6 +372,11 @@ public:
 		return _isSolid;
 	}
 
+	// Get the part of the object, in screen coordinates, which hides whatever is below it
+	virtual Common::Rect getOpaqueRect() const {
+		return _isSolid ? _bbox : Common::Rect();
+	}
+
 	// Persistenz-Methoden
 	// -------------------
 	virtual bool persist(OutputPersistenceBlock &writer);
@@ -62,7 +62,8 @@ RenderObjectManager::RenderObjectManager(int width, int height, int framebufferC
 	_frameStarted(false) {
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
 	_rootPtr = (new RootRenderObject(this, width, height))->getHandle();
-	_uta = new MicroTileArray(width, height);
+	// Larger tiles merge more of the dirty rectangles on high resolution screens
+	_uta = new MicroTileArray(width, height, width > 1024 ? TileSize * 2 : TileSize);
 	_currQueue = new RenderObjectQueue();
 	_prevQueue = new RenderObjectQueue();
 }
@@ -121,13 +122,13 @@ bool RenderObjectManager::render() {
 	updateRectsMinZ.reserve(updateRects->size());
 
 	// Calculate the minimum drawing Z value of each update rectangle
-	// Solid bitmaps with a Z order less than the value calculated here would be overdrawn again and
-	// so don't need to be drawn in the first place which speeds things up a bit.
+	// Bitmaps with a Z order less than the value calculated here would be overdrawn again by an
+	// opaque part of a bitmap and so don't need to be drawn in the first place which speeds things up a bit.
 	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
 		int minZ = 0;
 		for (RenderObjectQueue::iterator it = _currQueue->reverse_begin(); it != _currQueue->end(); --it) {
-			if ((*it)._renderObject->isVisible() && (*it)._renderObject->isSolid() &&
-				(*it)._renderObject->getBbox().contains(*rectIt)) {
+			if ((*it)._renderObject->isVisible() &&
+				(*it)._renderObject->getOpaqueRect().contains(*rectIt)) {
 				minZ = (*it)._renderObject->getAbsoluteZ();
 				break;
 			}
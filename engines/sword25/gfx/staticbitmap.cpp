@@ -73,6 +73,7 @@ bool StaticBitmap::initBitmapResource(const Common::String &filename) {
 	_originalHeight = _height = bitmapPtr->getHeight();
 
 	_isSolid = bitmapPtr->isSolid();
+	_opaqueRect = bitmapPtr->getOpaqueRect();
 
 	// Bild-Resource freigeben
 	bitmapPtr->release();
@@ -83,6 +84,38 @@ bool StaticBitmap::initBitmapResource(const Common::String &filename) {
 StaticBitmap::~StaticBitmap() {
 }
 
+Common::Rect StaticBitmap::getOpaqueRect() const {
+	// The modulation alpha blends the whole bitmap
+	if ((_modulationColor >> 24) != 0xff || _opaqueRect.isEmpty() || _originalWidth <= 0 || _originalHeight <= 0)
+		return Common::Rect();
+
+	Common::Rect rect = _opaqueRect;
+	if (_flipH) {
+		rect.left = _originalWidth - _opaqueRect.right;
+		rect.right = _originalWidth - _opaqueRect.left;
+	}
+	if (_flipV) {
+		rect.top = _originalHeight - _opaqueRect.bottom;
+		rect.bottom = _originalHeight - _opaqueRect.top;
+	}
+
+	// Round inwards, the scaled edges may be blended
+	if (_width != _originalWidth) {
+		rect.left = (rect.left * _width + _originalWidth - 1) / _originalWidth;
+		rect.right = rect.right * _width / _originalWidth;
+	}
+	if (_height != _originalHeight) {
+		rect.top = (rect.top * _height + _originalHeight - 1) / _originalHeight;
+		rect.bottom = rect.bottom * _height / _originalHeight;
+	}
+	if (rect.left >= rect.right || rect.top >= rect.bottom)
+		return Common::Rect();
+
+	rect.translate(_absoluteX, _absoluteY);
+	rect.clip(_bbox);
+	return rect;
+}
+
 bool StaticBitmap::doRender(RectangleList *updateRects) {
 	// Bitmap holen
 	Resource *resourcePtr = Kernel::getInstance()->getResourceManager()->requestResource(_resourceFilename);
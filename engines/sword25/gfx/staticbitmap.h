@@ -57,6 +57,7 @@ public:
 	bool isScalingAllowed() const override;
 	bool isAlphaAllowed() const override;
 	bool isColorModulationAllowed() const override;
+	Common::Rect getOpaqueRect() const override;
 	bool isSetContentAllowed() const override {
 		return false;
 	}
@@ -69,6 +70,7 @@ protected:
 
 private:
 	Common::String _resourceFilename;
+	Common::Rect _opaqueRect; ///< opaque part of the unscaled bitmap
 
 	bool initBitmapResource(const Common::String &filename);
 };
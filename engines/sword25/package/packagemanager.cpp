@@ -97,6 +97,12 @@ Common::String PackageManager::ensureSpeechLang(const Common::String &fileName)
  */
 Common::ArchiveMemberPtr PackageManager::getArchiveMember(const Common::String &fileName) {
 	Common::String fileName2 = ensureSpeechLang(fileName);
+
+	if (!_extractedFiles) {
+		FileIndex::const_iterator it = _fileIndex.find(fileName2);
+		return it != _fileIndex.end() ? it->_value : Common::ArchiveMemberPtr();
+	}
+
 	// Loop through checking each archive
 	Common::List<ArchiveEntry *>::iterator i;
 	for (i = _archiveList.begin(); i != _archiveList.end(); ++i) {
@@ -132,8 +138,11 @@ bool PackageManager::loadPackage(const Common::String &fileName, const Common::S
 		zipFile->listMembers(files);
 		debug(3, "Capacity %d", files.size());
 
-		for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it)
+		// The packages mounted last take precedence
+		for (Common::ArchiveMemberList::iterator it = files.begin(); it != files.end(); ++it) {
 			debug(3, "%s", (*it)->getName().c_str());
+			_fileIndex.setVal(mountPosition + (*it)->getName(), *it);
+		}
 
 		_archiveList.push_front(new ArchiveEntry(zipFile, mountPosition));
 
@@ -50,6 +50,7 @@
 #include "common/archive.h"
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 
 #include "sword25/kernel/common.h"
@@ -88,6 +89,11 @@ private:
 	Common::FSNode _rootFolder;
 	Common::List<ArchiveEntry *> _archiveList;
 	bool _extractedFiles;
+
+	// The members of all the mounted packages, by absolute path. Unused if a
+	// directory is mounted, as the directory members don't know their path.
+	typedef Common::HashMap<Common::String, Common::ArchiveMemberPtr, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileIndex;
+	FileIndex _fileIndex;
 	Common::String _directoryName;
 
 	bool _useEnglishSpeech;
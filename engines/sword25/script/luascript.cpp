@@ -55,8 +55,12 @@ LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 
 LuaScriptEngine::~LuaScriptEngine() {
 	// Lua de-initialisation
-	if (_state)
+	if (_state) {
 		lua_close(_state);
+
+		const Lua::LuaAllocator::Stats &stats = _allocator.getStats();
+		debugC(kDebugScript, "Lua allocated %u blocks, peak memory %u bytes", stats.allocations, (uint)stats.peakBytes);
+	}
 }
 
 namespace {
@@ -75,7 +79,7 @@ void debugHook(lua_State *L, lua_Debug *ar) {
 
 bool LuaScriptEngine::init() {
 	// Lua-State initialisation, as well as standard libaries initialisation
-	_state = luaL_newstate();
+	_state = _allocator.newState();
 	if (!_state || ! registerStandardLibs() || !registerStandardLibExtensions()) {
 		error("Lua could not be initialized.");
 		return false;
@@ -34,6 +34,7 @@
 
 #include "common/str.h"
 #include "common/str-array.h"
+#include "common/lua/lua_allocator.h"
 #include "sword25/kernel/common.h"
 #include "sword25/script/script.h"
 
@@ -94,6 +95,7 @@ public:
 	bool unpersist(InputPersistenceBlock &reader) override;
 
 private:
+	Lua::LuaAllocator _allocator;
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
 
@@ -0,0 +1,280 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/archive.h"
+#include "common/profiler.h"
+#include "common/savefile.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+#include "audio/decoders/raw.h"
+
+#include "engines/engine.h"
+
+#include "graphics/pixelformat.h"
+
+#include "testbed/performance.h"
+
+namespace Testbed {
+
+enum {
+	kScreenFrames = 200,
+	kOverlayFrames = 100,
+	kMixerSeconds = 4,
+	kMixerChunkFrames = 1024,
+	kMaxFileReadBytes = 32 * 1024 * 1024,
+	kSavefileBytes = 1024 * 1024
+};
+
+void PerformanceTests::logRate(const char *what, uint64 bytes, uint64 micros) {
+	Testsuite::logPrintf("Info! %s: %u KB in %u ms, %.1f MB/s\n", what, (uint)(bytes / 1024), (uint)(micros / 1000),
+		micros ? bytes / (double)micros : 0.0);
+}
+
+/**
+ * Copy a changing full screen image to the screen and show it, for the given
+ * number of frames. Returns the time it took, in microseconds.
+ */
+uint64 PerformanceTests::measureScreenUpdates(byte *buffer, int frames) {
+	const int width = g_system->getWidth();
+	const int height = g_system->getHeight();
+
+	const uint64 start = Common::Profiler::getMicros();
+	for (int frame = 0; frame < frames; ++frame) {
+		// Move the pattern every frame, so that nothing can be skipped as unchanged
+		for (int y = 0; y < height; ++y)
+			memset(buffer + y * width, (y + frame) & 0xFF, width);
+
+		g_system->copyRectToScreen(buffer, width, 0, 0, width, height);
+		g_system->updateScreen();
+	}
+	return Common::Profiler::getMicros() - start;
+}
+
+TestExitStatus PerformanceTests::testScreenUpdates() {
+	const int width = g_system->getWidth();
+	const int height = g_system->getHeight();
+	byte *buffer = new byte[width * height];
+
+	// Every graphics mode is a different scaler, measure all of them
+	const int currGFXMode = g_system->getGraphicsMode();
+	const OSystem::GraphicsMode *gfxMode = g_system->getSupportedGraphicsModes();
+	bool passed = true;
+
+	for (; gfxMode->name; ++gfxMode) {
+		if (Engine::shouldQuit())
+			break;
+
+		g_system->beginGFXTransaction();
+			bool isGFXModeSet = g_system->setGraphicsMode(gfxMode->id);
+			g_system->initSize(width, height);
+		OSystem::TransactionError gfxError = g_system->endGFXTransaction();
+
+		if (gfxError != OSystem::kTransactionSuccess || !isGFXModeSet) {
+			Testsuite::logDetailedPrintf("Switching to graphics mode %s failed\n", gfxMode->name);
+			passed = false;
+			continue;
+		}
+
+		const uint64 micros = measureScreenUpdates(buffer, kScreenFrames);
+		Testsuite::logPrintf("Info! GFX mode %s: %d frames of %dx%d in %u ms, %.1f frames/s\n", gfxMode->name,
+			kScreenFrames, width, height, (uint)(micros / 1000), micros ? kScreenFrames * 1000000.0 / micros : 0.0);
+	}
+
+	// Restore Original State
+	g_system->beginGFXTransaction();
+		bool isGFXModeSet = g_system->setGraphicsMode(currGFXMode);
+		g_system->initSize(width, height);
+	OSystem::TransactionError gfxError = g_system->endGFXTransaction();
+
+	delete[] buffer;
+	Testsuite::clearScreen();
+
+	if (gfxError != OSystem::kTransactionSuccess || !isGFXModeSet) {
+		Testsuite::logDetailedPrintf("Switching to initial state failed\n");
+		return kTestFailed;
+	}
+
+	return passed ? kTestPassed : kTestFailed;
+}
+
+TestExitStatus PerformanceTests::testOverlayBlits() {
+	g_system->showOverlay();
+
+	const int width = g_system->getOverlayWidth();
+	const int height = g_system->getOverlayHeight();
+	const Graphics::PixelFormat format = g_system->getOverlayFormat();
+	const int pitch = width * format.bytesPerPixel;
+	byte *buffer = new byte[pitch * height];
+
+	const uint64 start = Common::Profiler::getMicros();
+	for (int frame = 0; frame < kOverlayFrames; ++frame) {
+		for (int y = 0; y < height; ++y)
+			memset(buffer + y * pitch, (y + frame) & 0xFF, pitch);
+
+		g_system->copyRectToOverlay(buffer, pitch, 0, 0, width, height);
+		g_system->updateScreen();
+	}
+	const uint64 micros = Common::Profiler::getMicros() - start;
+
+	g_system->hideOverlay();
+	delete[] buffer;
+
+	Testsuite::logPrintf("Info! Overlay: %d frames of %dx%d in %u ms, %.1f frames/s\n", kOverlayFrames,
+		width, height, (uint)(micros / 1000), micros ? kOverlayFrames * 1000000.0 / micros : 0.0);
+	return kTestPassed;
+}
+
+TestExitStatus PerformanceTests::testMixer() {
+	// One second of a 22 kHz stereo square wave, which the mixer has to resample to its output rate
+	const int rate = 22050;
+	const uint32 size = rate * 2 * 2;
+	byte *tone = new byte[size];
+	for (uint32 i = 0; i < size / 4; ++i) {
+		const int16 sample = ((i / 50) & 1) ? 4096 : -4096;
+		WRITE_LE_INT16(tone + i * 4, sample);
+		WRITE_LE_INT16(tone + i * 4 + 2, sample);
+	}
+
+	// The channels are mixed by a mixer of our own, at the backend's output rate, so
+	// that the sounds played by the backend don't add to the measurements
+	const uint outputRate = g_system->getMixer()->getOutputRate();
+	static const int channelCounts[] = { 1, 8, 16, 32 };
+
+	for (int i = 0; i < ARRAYSIZE(channelCounts); ++i) {
+		Audio::MixerImpl mixer(outputRate);
+		mixer.setReady(true);
+
+		for (int channel = 0; channel < channelCounts[i]; ++channel) {
+			Audio::SeekableAudioStream *stream = Audio::makeRawStream(tone, size, rate,
+				Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN, DisposeAfterUse::NO);
+			mixer.playStream(Audio::Mixer::kSFXSoundType, nullptr, Audio::makeLoopingAudioStream(stream, 0),
+				-1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, false, false);
+		}
+
+		byte *output = new byte[kMixerChunkFrames * mixer.getOutputFrameSize()];
+		const uint chunks = kMixerSeconds * outputRate / kMixerChunkFrames;
+
+		const uint64 start = Common::Profiler::getMicros();
+		for (uint chunk = 0; chunk < chunks; ++chunk)
+			mixer.mixCallback(output, kMixerChunkFrames * mixer.getOutputFrameSize());
+		const uint64 micros = Common::Profiler::getMicros() - start;
+
+		delete[] output;
+		mixer.stopAll();
+
+		const double mixedMicros = chunks * kMixerChunkFrames * 1000000.0 / outputRate;
+		Testsuite::logPrintf("Info! Mixer: %d channels at %u Hz, %u us per second of sound, %.2f%% of real time\n",
+			channelCounts[i], outputRate, (uint)(micros * 1000000.0 / mixedMicros), micros * 100.0 / mixedMicros);
+	}
+
+	delete[] tone;
+	return kTestPassed;
+}
+
+TestExitStatus PerformanceTests::testFileReads() {
+	Common::ArchiveMemberList list;
+	SearchMan.listMembers(list);
+
+	byte *buffer = new byte[64 * 1024];
+	uint64 bytes = 0;
+	int files = 0;
+
+	const uint64 start = Common::Profiler::getMicros();
+	for (Common::ArchiveMemberList::const_iterator i = list.begin(); i != list.end() && bytes < kMaxFileReadBytes; ++i) {
+		Common::SeekableReadStream *stream = (*i)->createReadStream();
+		if (!stream)
+			continue;
+
+		uint32 read;
+		while ((read = stream->read(buffer, 64 * 1024)) > 0)
+			bytes += read;
+
+		delete stream;
+		files++;
+	}
+	const uint64 micros = Common::Profiler::getMicros() - start;
+
+	delete[] buffer;
+
+	if (!files) {
+		Testsuite::logDetailedPrintf("No files to read found\n");
+		return kTestSkipped;
+	}
+
+	logRate(Common::String::format("File reads of %d files", files).c_str(), bytes, micros);
+	return kTestPassed;
+}
+
+TestExitStatus PerformanceTests::testSavefiles() {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const char *fileName = "tBedPerformance.0";
+
+	byte *data = new byte[kSavefileBytes];
+	for (uint i = 0; i < kSavefileBytes; ++i)
+		data[i] = (i * 7) ^ (i >> 8);
+
+	// Uncompressed, as the raw write speed of the save files is measured
+	uint64 start = Common::Profiler::getMicros();
+	Common::OutSaveFile *saveFile = saveFileMan->openForSaving(fileName, false);
+	if (!saveFile) {
+		Testsuite::logDetailedPrintf("Can't open saveFile %s\n", fileName);
+		delete[] data;
+		return kTestFailed;
+	}
+	saveFile->write(data, kSavefileBytes);
+	saveFile->finalize();
+	const bool writeError = saveFile->err();
+	delete saveFile;
+	const uint64 writeMicros = Common::Profiler::getMicros() - start;
+
+	start = Common::Profiler::getMicros();
+	Common::InSaveFile *loadFile = saveFileMan->openForLoading(fileName);
+	byte *readData = new byte[kSavefileBytes];
+	const bool readError = !loadFile || loadFile->read(readData, kSavefileBytes) != kSavefileBytes;
+	delete loadFile;
+	const uint64 readMicros = Common::Profiler::getMicros() - start;
+
+	const bool matches = !writeError && !readError && !memcmp(data, readData, kSavefileBytes);
+	saveFileMan->removeSavefile(fileName);
+	delete[] readData;
+	delete[] data;
+
+	if (!matches) {
+		Testsuite::logDetailedPrintf("Reading back the savefile failed\n");
+		return kTestFailed;
+	}
+
+	logRate("Savefile writes", kSavefileBytes, writeMicros);
+	logRate("Savefile reads", kSavefileBytes, readMicros);
+	return kTestPassed;
+}
+
+PerformanceTestSuite::PerformanceTestSuite() {
+	addTest("ScreenUpdates", &PerformanceTests::testScreenUpdates, false);
+	addTest("OverlayBlits", &PerformanceTests::testOverlayBlits, false);
+	addTest("Mixer", &PerformanceTests::testMixer, false);
+	addTest("FileReads", &PerformanceTests::testFileReads, false);
+	addTest("Savefiles", &PerformanceTests::testSavefiles, false);
+}
+
+} // End of namespace Testbed
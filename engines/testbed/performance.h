@@ -0,0 +1,70 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TESTBED_PERFORMANCE_H
+#define TESTBED_PERFORMANCE_H
+
+#include "testbed/testsuite.h"
+
+namespace Testbed {
+
+namespace PerformanceTests {
+
+// Performance tests run fixed workloads on the backend, and log how long they took
+
+// Helper functions for Performance tests
+uint64 measureScreenUpdates(byte *buffer, int frames);
+void logRate(const char *what, uint64 bytes, uint64 micros);
+
+// will contain function declarations for Performance tests
+TestExitStatus testScreenUpdates();
+TestExitStatus testOverlayBlits();
+TestExitStatus testMixer();
+TestExitStatus testFileReads();
+TestExitStatus testSavefiles();
+// add more here
+
+} // End of namespace PerformanceTests
+
+class PerformanceTestSuite : public Testsuite {
+public:
+	/**
+	 * The constructor for the PerformanceTestSuite
+	 * For every test to be executed one must:
+	 * 1) Create a function that would invoke the test
+	 * 2) Add that test to list by executing addTest()
+	 *
+	 * @see addTest()
+	 */
+	PerformanceTestSuite();
+	~PerformanceTestSuite() override {}
+	const char *getName() const override {
+		return "Performance";
+	}
+	const char *getDescription() const override {
+		return "Performance: Screen updates/Overlay/Mixer/File reads/Savefiles";
+	}
+};
+
+} // End of namespace Testbed
+
+#endif // TESTBED_PERFORMANCE_H
@@ -30,6 +30,9 @@ namespace Tinsel {
 
 #define	NUM_MNODES	192	// the number of memory management nodes (was 128, then 192)
 
+#define	NUM_FREE_BLOCKS	16	// the number of discarded memory blocks kept for reuse
+#define	FREE_BLOCKS_SIZE	(2 * 1024 * 1024)	// the most memory kept in discarded blocks
+
 
 // internal allocation flags
 #define	DWM_USED		0x0001	///< the objects memory block is in use
@@ -47,6 +50,11 @@ struct MEM_NODE {
 	int flags;		// allocation attributes
 };
 
+struct FREE_BLOCK {
+	uint8 *pBaseAddr;	// base address of the memory block
+	long size;		// size of the memory block
+};
+
 
 // Specifies the total amount of memory required for DW1 demo, DW1, or DW2 respectively.
 // Currently this is set at 5MB for the DW1 demo and DW1 and 10MB for DW2
@@ -68,6 +76,12 @@ MEM_NODE g_s_fixedMnodesList[5];
 // the mnode heap sentinel
 static MEM_NODE g_heapSentinel;
 
+// memory blocks of discarded objects, oldest first. A discarded file is usually
+// loaded again later, and then gets its old block back instead of a new one.
+static FREE_BLOCK g_freeBlocks[NUM_FREE_BLOCKS];
+static int g_numFreeBlocks;
+static long g_freeBlocksSize;
+
 //
 static MEM_NODE *AllocMemNode();
 
@@ -133,6 +147,9 @@ void MemoryInit() {
 		size = MemoryPoolSize[3];
 	}
 	g_heapSentinel.size = size;
+
+	g_numFreeBlocks = 0;
+	g_freeBlocksSize = 0;
 }
 
 /**
@@ -153,11 +170,62 @@ void MemoryDeinit() {
 		pCur->pBaseAddr = 0;
 	}
 
+	for (int i = 0; i < g_numFreeBlocks; ++i)
+		free(g_freeBlocks[i].pBaseAddr);
+	g_numFreeBlocks = 0;
+	g_freeBlocksSize = 0;
+
 	memset(g_mnodeList, 0, sizeof(g_mnodeList));
 	memset(g_s_fixedMnodesList, 0, sizeof(g_s_fixedMnodesList));
 	g_pFreeMemNodes = nullptr;
 }
 
+/**
+ * Allocates a memory block, reusing a discarded block of the same size if there is one.
+ * @param size			Number of bytes to allocate
+ */
+static uint8 *BlockAlloc(long size) {
+	for (int i = g_numFreeBlocks - 1; i >= 0; --i) {
+		if (g_freeBlocks[i].size == size) {
+			uint8 *pBaseAddr = g_freeBlocks[i].pBaseAddr;
+			g_freeBlocksSize -= size;
+
+			// close the gap in the list
+			--g_numFreeBlocks;
+			memmove(g_freeBlocks + i, g_freeBlocks + i + 1, (g_numFreeBlocks - i) * sizeof(FREE_BLOCK));
+			return pBaseAddr;
+		}
+	}
+
+	return (uint8 *)malloc(size);
+}
+
+/**
+ * Frees a memory block, or keeps it to be reused by BlockAlloc().
+ * @param pBaseAddr		Base address of the memory block
+ * @param size			Size of the memory block
+ */
+static void BlockFree(uint8 *pBaseAddr, long size) {
+	if (!pBaseAddr || size > FREE_BLOCKS_SIZE / 2) {
+		free(pBaseAddr);
+		return;
+	}
+
+	// free the oldest blocks to make room
+	while (g_numFreeBlocks == NUM_FREE_BLOCKS || g_freeBlocksSize + size > FREE_BLOCKS_SIZE) {
+		free(g_freeBlocks[0].pBaseAddr);
+		g_freeBlocksSize -= g_freeBlocks[0].size;
+
+		--g_numFreeBlocks;
+		memmove(g_freeBlocks, g_freeBlocks + 1, g_numFreeBlocks * sizeof(FREE_BLOCK));
+	}
+
+	g_freeBlocks[g_numFreeBlocks].pBaseAddr = pBaseAddr;
+	g_freeBlocks[g_numFreeBlocks].size = size;
+	++g_numFreeBlocks;
+	g_freeBlocksSize += size;
+}
+
 
 /**
  * Allocate a mnode from the free list.
@@ -255,7 +323,7 @@ static MEM_NODE *MemoryAlloc(long size) {
 	MEM_NODE *pNode = AllocMemNode();
 
 	// Allocate memory for the node.
-	pNode->pBaseAddr = (byte *)malloc(size);
+	pNode->pBaseAddr = BlockAlloc(size);
 
 	// Verify that we got the memory.
 	// TODO: If this fails, we should first try to compact the heap some further.
@@ -327,7 +395,7 @@ MEM_NODE *MemoryAllocFixed(long size) {
 		if (!pNode->pBaseAddr) {
 			pNode->pNext = 0;
 			pNode->pPrev = 0;
-			pNode->pBaseAddr = (byte *)malloc(size);
+			pNode->pBaseAddr = BlockAlloc(size);
 			pNode->size = size;
 			pNode->lruTime = DwGetCurrentTime() + 1;
 			pNode->flags = DWM_USED;
@@ -357,7 +425,7 @@ void MemoryDiscard(MEM_NODE *pMemNode) {
 	// discard it if it isn't already
 	if ((pMemNode->flags & DWM_DISCARDED) == 0) {
 		// free memory
-		free(pMemNode->pBaseAddr);
+		BlockFree(pMemNode->pBaseAddr, pMemNode->size);
 		g_heapSentinel.size += pMemNode->size;
 
 #ifdef DEBUG
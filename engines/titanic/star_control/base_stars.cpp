@@ -65,6 +65,8 @@ CBaseStars::CBaseStars() : _minVal(0.0), _maxVal(1.0), _range(0.0),
 
 void CBaseStars::clear() {
 	_data.clear();
+	_layoutStars.clear();
+	_blocks.clear();
 }
 
 void CBaseStars::initialize() {
@@ -128,6 +130,9 @@ void CBaseStars::resetEntry(CBaseStarEntry &entry) {
 
 void CBaseStars::draw(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
 	if (!_data.empty()) {
+		if (_layoutStars.size() != _data.size())
+			buildBlocks();
+
 		switch (camera->getStarColor()) {
 		case WHITE: // draw white, green, and red stars (mostly white)
 			switch (surfaceArea->_bpp) {
@@ -161,92 +166,137 @@ void CBaseStars::draw(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *
 	}
 }
 
-void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
-	FPose pose = camera->getPose();
-	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
+namespace {
 
-	const double MAX_VAL = 1.0e9 * 1.0e9;
-	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
-	double threshold = camera->getFrontClip();
-	double minVal = threshold - 9216.0;
-	int width1 = surfaceArea->_width - 1;
-	int height1 = surfaceArea->_height - 1;
-	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double tempX, tempY, tempZ, total2;
+float getAxis(const FVector &v, int axis) {
+	return axis == 0 ? v._x : (axis == 1 ? v._y : v._z);
+}
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
+struct StarAxisLess {
+	const Common::Array<CBaseStarEntry> &_data;
+	int _axis;
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ; 
+	StarAxisLess(const Common::Array<CBaseStarEntry> &data, int axis) : _data(data), _axis(axis) {}
 
-		if (total2 < 1.0e12) {
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
-				surfaceArea, camera);
-			continue;
-		}
+	bool operator()(uint star1, uint star2) const {
+		return getAxis(_data[star1]._position, _axis) < getAxis(_data[star2]._position, _axis);
+	}
+};
+
+} // End of anonymous namespace
+
+void CBaseStars::buildBlocks() {
+	_layoutStars.resize(_data.size());
+	for (uint idx = 0; idx < _data.size(); ++idx)
+		_layoutStars[idx] = idx;
+
+	_blocks.clear();
+	splitBlock(0, _layoutStars.size());
+
+	_layoutX.resize(_layoutStars.size());
+	_layoutY.resize(_layoutStars.size());
+	_layoutZ.resize(_layoutStars.size());
+	for (uint idx = 0; idx < _layoutStars.size(); ++idx) {
+		const FVector &position = _data[_layoutStars[idx]]._position;
+		_layoutX[idx] = position._x;
+		_layoutY[idx] = position._y;
+		_layoutZ[idx] = position._z;
+	}
+}
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+void CBaseStars::splitBlock(uint start, uint end) {
+	FVector minPos = _data[_layoutStars[start]]._position, maxPos = minPos;
+	for (uint idx = start + 1; idx < end; ++idx) {
+		const FVector &position = _data[_layoutStars[idx]]._position;
+		minPos = FVector(MIN(minPos._x, position._x), MIN(minPos._y, position._y), MIN(minPos._z, position._z));
+		maxPos = FVector(MAX(maxPos._x, position._x), MAX(maxPos._y, position._y), MAX(maxPos._z, position._z));
+	}
 
-		int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
-		int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
+	if (end - start > kStarsPerBlock) {
+		// Split the stars in two halves along their longest extent
+		FVector extent = maxPos - minPos;
+		int axis = (extent._x >= extent._y && extent._x >= extent._z) ? 0 : (extent._y >= extent._z ? 1 : 2);
+		Common::sort(&_layoutStars[start], &_layoutStars[start] + (end - start), StarAxisLess(_data, axis));
 
-		double sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		double red = MIN((double)entry._red * sVal, (double)255.0);
-		double green = MIN((double)entry._green * sVal, (double)255.0);
-		double blue = MIN((double)entry._green * sVal, (double)255.0);
+		uint middle = start + (end - start) / 2;
+		splitBlock(start, middle);
+		splitBlock(middle, end);
+		return;
+	}
 
-		int skipCtr = 0;
-		if (red < 0.0) {
-			red = 0.0;
-			++skipCtr;
-		}
-		if (green < 0.0) {
-			green = 0.0;
-			++skipCtr;
-		}
-		if (blue < 0.0) {
-			blue = 0.0;
-			++skipCtr;
-		}
-		if (skipCtr == 3)
-			continue;
+	CStarBlock block;
+	block._center = (minPos + maxPos) * 0.5;
+	block._start = start;
+	block._end = end;
+	for (uint idx = start; idx < end; ++idx) {
+		const FVector &position = _data[_layoutStars[idx]]._position;
+		block._radius = MAX(block._radius, (double)(position - block._center).getDistance(FVector()));
+	}
+	_blocks.push_back(block);
+}
 
-		int r = (int)(red - 0.5) & 0xfff8;
-		int g = (int)(green - 0.5) & 0xfff8;
-		int b = (int)(blue - 0.5) & 0xfff8;
-		int rgb = ((g | (r << 5)) << 2) | ((b >> 3) & 0xfff8);
-		uint16 *pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
+void CBaseStars::cullBlocks(CSurfaceArea *surfaceArea, const FPose &pose, const FPoint &centroid,
+		double minVal, double threshold, double xOffset) {
+	_visibleBlocks.clear();
+
+	// The most the pose can stretch a block
+	double scale = sqrt(pose._row1._x * pose._row1._x + pose._row1._y * pose._row1._y + pose._row1._z * pose._row1._z
+		+ pose._row2._x * pose._row2._x + pose._row2._y * pose._row2._y + pose._row2._z * pose._row2._z
+		+ pose._row3._x * pose._row3._x + pose._row3._y * pose._row3._y + pose._row3._z * pose._row3._z);
+
+	// The planes of the screen edges, with a pixel of margin on each side. A star is drawn
+	// at (_value1 * (x + xOffset) / z + centroid._x, _value2 * y / z + centroid._y)
+	double leftZ = centroid._x + 2.0, rightZ = centroid._x - surfaceArea->_width - 1.0;
+	double topZ = centroid._y + 2.0, bottomZ = centroid._y - surfaceArea->_height - 1.0;
+	double leftNorm = sqrt(_value1 * _value1 + leftZ * leftZ), rightNorm = sqrt(_value1 * _value1 + rightZ * rightZ);
+	double topNorm = sqrt(_value2 * _value2 + topZ * topZ), bottomNorm = sqrt(_value2 * _value2 + bottomZ * bottomZ);
+
+	for (uint idx = 0; idx < _blocks.size(); ++idx) {
+		const CStarBlock &block = _blocks[idx];
+		const FVector &center = block._center;
+		double x = center._x * pose._row1._x + center._y * pose._row2._x + center._z * pose._row3._x + pose._vector._x;
+		double y = center._x * pose._row1._y + center._y * pose._row2._y + center._z * pose._row3._y + pose._vector._y;
+		double z = center._x * pose._row1._z + center._y * pose._row2._z + center._z * pose._row3._z + pose._vector._z;
+		double distance = sqrt(x * x + y * y + z * z);
+
+		// Leave room for the rounding of the single precision star positions
+		double radius = block._radius * scale;
+		radius += (distance + radius) * 1.0e-5 + 1.0;
+
+		// Behind the camera, or too far away
+		if (z + radius <= minVal || distance - radius >= 1.0e9)
+			continue;
 
-		switch (entry._thickness) {
-		case 0:
-			*pixelP = rgb;
-			break;
+		// Stars closer than 1.0e6 get a closeup wherever they are, the others must be on the screen
+		if (distance - radius >= 1.0e6) {
+			if (z + radius <= threshold)
+				continue;
+
+			if (threshold > 0.0) {
+				double xShifted = _value1 * (x + xOffset);
+				double yScaled = _value2 * y;
+				if (xShifted + leftZ * z + radius * leftNorm <= 0.0 || xShifted + rightZ * z - radius * rightNorm >= 0.0
+						|| yScaled + topZ * z + radius * topNorm <= 0.0 || yScaled + bottomZ * z - radius * bottomNorm >= 0.0)
+					continue;
+			}
+		}
 
-		case 1:
-			*pixelP = rgb;
-			*(pixelP + 1) = rgb;
-			*(pixelP + surfaceArea->_pitch / 2) = rgb;
-			*(pixelP + surfaceArea->_pitch / 2 + 1) = rgb;
-			break;
+		_visibleBlocks.push_back(idx);
+	}
+}
 
-		default:
-			break;
-		}
+void CBaseStars::projectBlock(const CStarBlock &block, const FPose &pose) {
+	// Kept free of branches, so that the compiler can vectorize it
+	const float *xP = &_layoutX[block._start], *yP = &_layoutY[block._start], *zP = &_layoutZ[block._start];
+	uint count = block._end - block._start;
+	for (uint idx = 0; idx < count; ++idx) {
+		_cameraX[idx] = xP[idx] * pose._row1._x + yP[idx] * pose._row2._x + zP[idx] * pose._row3._x + pose._vector._x;
+		_cameraY[idx] = xP[idx] * pose._row1._y + yP[idx] * pose._row2._y + zP[idx] * pose._row3._y + pose._vector._y;
+		_cameraZ[idx] = xP[idx] * pose._row1._z + yP[idx] * pose._row2._z + zP[idx] * pose._row3._z + pose._vector._z;
 	}
 }
 
-void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
+void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
@@ -259,80 +309,85 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
+	cullBlocks(surfaceArea, pose, centroid, minVal, threshold, 0.0);
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+	for (uint blockIdx = 0; blockIdx < _visibleBlocks.size(); ++blockIdx) {
+		const CStarBlock &block = _blocks[_visibleBlocks[blockIdx]];
+		projectBlock(block, pose);
 
-		if (total2 < 1.0e12) {
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
-				surfaceArea, camera);
-			continue;
-		}
+		for (uint idx = 0; idx < block._end - block._start; ++idx) {
+			CBaseStarEntry &entry = _data[_layoutStars[block._start + idx]];
+			const FVector &vector = entry._position;
+			tempZ = _cameraZ[idx];
+			if (tempZ <= minVal)
+				continue;
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+			tempY = _cameraY[idx];
+			tempX = _cameraX[idx];
+			total2 = tempY * tempY + tempX * tempX + tempZ * tempZ; 
 
-		int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
-		int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
+			if (total2 < 1.0e12) {
+				closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+					surfaceArea, camera);
+				continue;
+			}
 
-		double sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		double red = MIN((double)entry._red * sVal, (double)255.0);
-		double green = MIN((double)entry._green * sVal, (double)255.0);
-		double blue = MIN((double)entry._green * sVal, (double)255.0);
+			if (tempZ <= threshold || total2 >= MAX_VAL)
+				continue;
 
-		int skipCtr = 0;
-		if (red < 0.0) {
-			red = 0.0;
-			++skipCtr;
-		}
-		if (green < 0.0) {
-			green = 0.0;
-			++skipCtr;
-		}
-		if (blue < 0.0) {
-			blue = 0.0;
-			++skipCtr;
-		}
-		if (skipCtr == 3)
-			continue;
+			int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
+			int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
+			if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+				continue;
 
-		int r = (int)(red - 0.5) & 0xf8;
-		int g = (int)(green - 0.5) & 0xfc;
-		int b = (int)(blue - 0.5) & 0xfff8;
+			double sVal = sqrt(total2);
+			sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			double red = MIN((double)entry._red * sVal, (double)255.0);
+			double green = MIN((double)entry._green * sVal, (double)255.0);
+			double blue = MIN((double)entry._green * sVal, (double)255.0);
 
-		int rgb = ((g | (r << 5)) << 3) | (b >> 3);
-		uint16 *pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
+			int skipCtr = 0;
+			if (red < 0.0) {
+				red = 0.0;
+				++skipCtr;
+			}
+			if (green < 0.0) {
+				green = 0.0;
+				++skipCtr;
+			}
+			if (blue < 0.0) {
+				blue = 0.0;
+				++skipCtr;
+			}
+			if (skipCtr == 3)
+				continue;
 
-		switch (entry._thickness) {
-		case 0:
-			*pixelP = rgb;
-			break;
+			int r = (int)(red - 0.5) & 0xfff8;
+			int g = (int)(green - 0.5) & 0xfff8;
+			int b = (int)(blue - 0.5) & 0xfff8;
+			int rgb = ((g | (r << 5)) << 2) | ((b >> 3) & 0xfff8);
+			uint16 *pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
 
-		case 1:
-			*pixelP = rgb;
-			*(pixelP + 1) = rgb;
-			*(pixelP + surfaceArea->_pitch / 2) = rgb;
-			*(pixelP + surfaceArea->_pitch / 2 + 1) = rgb;
-			break;
+			switch (entry._thickness) {
+			case 0:
+				*pixelP = rgb;
+				break;
 
-		default:
-			break;
+			case 1:
+				*pixelP = rgb;
+				*(pixelP + 1) = rgb;
+				*(pixelP + surfaceArea->_pitch / 2) = rgb;
+				*(pixelP + surfaceArea->_pitch / 2 + 1) = rgb;
+				break;
+
+			default:
+				break;
+			}
 		}
 	}
 }
 
-void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
+void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
 	FPose pose = camera->getPose();
 	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
@@ -343,48 +398,67 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
-	double *v3Ptr = &_value3, *v4Ptr = &_value4;
-	double tempX, tempY, tempZ, total2, sVal;
-	int xStart, yStart, rgb;
-	uint16 *pixelP;
+	double tempX, tempY, tempZ, total2;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
+	cullBlocks(surfaceArea, pose, centroid, minVal, threshold, 0.0);
 
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
+	for (uint blockIdx = 0; blockIdx < _visibleBlocks.size(); ++blockIdx) {
+		const CStarBlock &block = _blocks[_visibleBlocks[blockIdx]];
+		projectBlock(block, pose);
 
-		if (total2 < 1.0e12) {
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
-				surfaceArea, camera);
-			continue;
-		}
+		for (uint idx = 0; idx < block._end - block._start; ++idx) {
+			CBaseStarEntry &entry = _data[_layoutStars[block._start + idx]];
+			const FVector &vector = entry._position;
+			tempZ = _cameraZ[idx];
+			if (tempZ <= minVal)
+				continue;
 
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
+			tempY = _cameraY[idx];
+			tempX = _cameraX[idx];
+			total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
 
-		// First pixel
-		xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
+			if (total2 < 1.0e12) {
+				closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+					surfaceArea, camera);
+				continue;
+			}
+
+			if (tempZ <= threshold || total2 >= MAX_VAL)
+				continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
+			int xStart = (int)(*v1Ptr * tempX / tempZ + centroid._x);
+			int yStart = (int)(*v2Ptr * tempY / tempZ + centroid._y);
+			if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+				continue;
 
-		if (sVal > 255.0)
-			sVal = 255.0;
+			double sVal = sqrt(total2);
+			sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			double red = MIN((double)entry._red * sVal, (double)255.0);
+			double green = MIN((double)entry._green * sVal, (double)255.0);
+			double blue = MIN((double)entry._green * sVal, (double)255.0);
 
-		if (sVal > 2.0) {
-			pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
-			rgb = ((int)(sVal - 0.5) & 0xf8) << 7;
+			int skipCtr = 0;
+			if (red < 0.0) {
+				red = 0.0;
+				++skipCtr;
+			}
+			if (green < 0.0) {
+				green = 0.0;
+				++skipCtr;
+			}
+			if (blue < 0.0) {
+				blue = 0.0;
+				++skipCtr;
+			}
+			if (skipCtr == 3)
+				continue;
+
+			int r = (int)(red - 0.5) & 0xf8;
+			int g = (int)(green - 0.5) & 0xfc;
+			int b = (int)(blue - 0.5) & 0xfff8;
+
+			int rgb = ((g | (r << 5)) << 3) | (b >> 3);
+			uint16 *pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
 
 			switch (entry._thickness) {
 			case 0:
@@ -402,38 +476,117 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 				break;
 			}
 		}
+	}
+}
 
-		// Second pixel
-		xStart = (int)((tempX + *v4Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
+void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup) {
+	FPose pose = camera->getPose();
+	camera->getRelativeXCenterPixels(&_value1, &_value2, &_value3, &_value4);
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
+	const double MAX_VAL = 1.0e9 * 1.0e9;
+	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
+	double threshold = camera->getFrontClip();
+	double minVal = threshold - 9216.0;
+	int width1 = surfaceArea->_width - 1;
+	int height1 = surfaceArea->_height - 1;
+	double *v1Ptr = &_value1, *v2Ptr = &_value2;
+	double *v3Ptr = &_value3, *v4Ptr = &_value4;
+	double tempX, tempY, tempZ, total2, sVal;
+	int xStart, yStart, rgb;
+	uint16 *pixelP;
 
-		if (sVal > 255.0)
-			sVal = 255.0;
+	cullBlocks(surfaceArea, pose, centroid, minVal, threshold, _value3);
 
-		if (sVal > 2.0) {
-			pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
-			rgb = ((int)(sVal - 0.5) & 0xf8) << 7;
+	for (uint blockIdx = 0; blockIdx < _visibleBlocks.size(); ++blockIdx) {
+		const CStarBlock &block = _blocks[_visibleBlocks[blockIdx]];
+		projectBlock(block, pose);
 
-			switch (entry._thickness) {
-			case 0:
-				*pixelP |= rgb;
-				break;
+		for (uint idx = 0; idx < block._end - block._start; ++idx) {
+			CBaseStarEntry &entry = _data[_layoutStars[block._start + idx]];
+			const FVector &vector = entry._position;
+			tempZ = _cameraZ[idx];
+			if (tempZ <= minVal)
+				continue;
 
-			case 1:
-				*pixelP |= rgb;
-				*(pixelP + 1) |= rgb;
-				*(pixelP + surfaceArea->_pitch / 2) |= rgb;
-				*(pixelP + surfaceArea->_pitch / 2 + 1) |= rgb;
-				break;
+			tempY = _cameraY[idx];
+			tempX = _cameraX[idx];
+			total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
 
-			default:
-				break;
+			if (total2 < 1.0e12) {
+				closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+					surfaceArea, camera);
+				continue;
+			}
+
+			if (tempZ <= threshold || total2 >= MAX_VAL)
+				continue;
+
+			// First pixel
+			xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
+			yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
+			if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+				continue;
+
+			sVal = sqrt(total2);
+			sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			sVal *= 255.0;
+
+			if (sVal > 255.0)
+				sVal = 255.0;
+
+			if (sVal > 2.0) {
+				pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
+				rgb = ((int)(sVal - 0.5) & 0xf8) << 7;
+
+				switch (entry._thickness) {
+				case 0:
+					*pixelP = rgb;
+					break;
+
+				case 1:
+					*pixelP = rgb;
+					*(pixelP + 1) = rgb;
+					*(pixelP + surfaceArea->_pitch / 2) = rgb;
+					*(pixelP + surfaceArea->_pitch / 2 + 1) = rgb;
+					break;
+
+				default:
+					break;
+				}
+			}
+
+			// Second pixel
+			xStart = (int)((tempX + *v4Ptr) * *v1Ptr / tempZ + centroid._x);
+			yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
+			if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+				continue;
+
+			sVal = sqrt(total2);
+			sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			sVal *= 255.0;
+
+			if (sVal > 255.0)
+				sVal = 255.0;
+
+			if (sVal > 2.0) {
+				pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
+				rgb = ((int)(sVal - 0.5) & 0xf8) << 7;
+
+				switch (entry._thickness) {
+				case 0:
+					*pixelP |= rgb;
+					break;
+
+				case 1:
+					*pixelP |= rgb;
+					*(pixelP + 1) |= rgb;
+					*(pixelP + surfaceArea->_pitch / 2) |= rgb;
+					*(pixelP + surfaceArea->_pitch / 2 + 1) |= rgb;
+					break;
+
+				default:
+					break;
+				}
 			}
 		}
 	}
@@ -454,94 +607,99 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	int xStart, yStart, rgb;
 	uint16 *pixelP;
 
-	for (uint idx = 0; idx < _data.size(); ++idx) {
-		const CBaseStarEntry &entry = _data[idx];
-		const FVector &vector = entry._position;
-
-		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
-			+ vector._z * pose._row3._z + pose._vector._z;
-		if (tempZ <= minVal)
-			continue;
-
-		tempY = vector._x * pose._row1._y + vector._y * pose._row2._y + vector._z * pose._row3._y + pose._vector._y;
-		tempX = vector._x * pose._row1._x + vector._y * pose._row2._x + vector._z * pose._row3._x + pose._vector._x;
-		total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
-
-		if (total2 < 1.0e12) {
-			// We're in close proximity to the given star, so draw a closeup of it
-			closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
-				surfaceArea, camera);
-			continue;
-		}
-
-		if (tempZ <= threshold || total2 >= MAX_VAL)
-			continue;
-
-		// First pixel
-		xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
-
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
-
-		if (sVal > 255.0)
-			sVal = 255.0;
+	cullBlocks(surfaceArea, pose, centroid, minVal, threshold, _value3);
 
-		if (sVal > 2.0) {
-			pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
-			rgb = ((int)(sVal - 0.5) & 0xf8) << 8;
+	for (uint blockIdx = 0; blockIdx < _visibleBlocks.size(); ++blockIdx) {
+		const CStarBlock &block = _blocks[_visibleBlocks[blockIdx]];
+		projectBlock(block, pose);
 
-			switch (entry._thickness) {
-			case 0:
-				*pixelP = rgb;
-				break;
+		for (uint idx = 0; idx < block._end - block._start; ++idx) {
+			const CBaseStarEntry &entry = _data[_layoutStars[block._start + idx]];
+			const FVector &vector = entry._position;
+			tempZ = _cameraZ[idx];
+			if (tempZ <= minVal)
+				continue;
 
-			case 1:
-				*pixelP = rgb;
-				*(pixelP + 1) = rgb;
-				*(pixelP + surfaceArea->_pitch / 2) = rgb;
-				*(pixelP + surfaceArea->_pitch / 2 + 1) = rgb;
-				break;
+			tempY = _cameraY[idx];
+			tempX = _cameraX[idx];
+			total2 = tempY * tempY + tempX * tempX + tempZ * tempZ;
 
-			default:
-				break;
+			if (total2 < 1.0e12) {
+				// We're in close proximity to the given star, so draw a closeup of it
+				closeup->draw(pose, vector, FVector(centroid._x, centroid._y, total2),
+					surfaceArea, camera);
+				continue;
 			}
-		}
-
-		// Second pixel
-		xStart = (int)((tempX + *v4Ptr) * *v1Ptr / tempZ + centroid._x);
-		yStart = (int)((tempY * *v2Ptr) / tempZ + centroid._y);
-		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
-			continue;
-
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
-		sVal *= 255.0;
-
-		if (sVal > 255.0)
-			sVal = 255.0;
 
-		if (sVal > 2.0) {
-			pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
-			rgb = ((int)(sVal - 0.5) >> 3) & 0xff;
-
-			switch (entry._thickness) {
-			case 0:
-				*pixelP |= rgb;
-				break;
-
-			case 1:
-				*pixelP |= rgb;
-				*(pixelP + 1) |= rgb;
-				*(pixelP + surfaceArea->_pitch / 2) |= rgb;
-				*(pixelP + surfaceArea->_pitch / 2 + 1) |= rgb;
-				break;
+			if (tempZ <= threshold || total2 >= MAX_VAL)
+				continue;
+
+			// First pixel
+			xStart = (int)((tempX + *v3Ptr) * *v1Ptr / tempZ + centroid._x);
+			yStart = (int)(tempY * *v2Ptr / tempZ + centroid._y);
+			if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+				continue;
+
+			sVal = sqrt(total2);
+			sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			sVal *= 255.0;
+
+			if (sVal > 255.0)
+				sVal = 255.0;
+
+			if (sVal > 2.0) {
+				pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
+				rgb = ((int)(sVal - 0.5) & 0xf8) << 8;
+
+				switch (entry._thickness) {
+				case 0:
+					*pixelP = rgb;
+					break;
+
+				case 1:
+					*pixelP = rgb;
+					*(pixelP + 1) = rgb;
+					*(pixelP + surfaceArea->_pitch / 2) = rgb;
+					*(pixelP + surfaceArea->_pitch / 2 + 1) = rgb;
+					break;
+
+				default:
+					break;
+				}
+			}
 
-			default:
-				break;
+			// Second pixel
+			xStart = (int)((tempX + *v4Ptr) * *v1Ptr / tempZ + centroid._x);
+			yStart = (int)((tempY * *v2Ptr) / tempZ + centroid._y);
+			if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
+				continue;
+
+			sVal = sqrt(total2);
+			sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+			sVal *= 255.0;
+
+			if (sVal > 255.0)
+				sVal = 255.0;
+
+			if (sVal > 2.0) {
+				pixelP = (uint16 *)(surfaceArea->_pixelsPtr + surfaceArea->_pitch * yStart + xStart * 2);
+				rgb = ((int)(sVal - 0.5) >> 3) & 0xff;
+
+				switch (entry._thickness) {
+				case 0:
+					*pixelP |= rgb;
+					break;
+
+				case 1:
+					*pixelP |= rgb;
+					*(pixelP + 1) |= rgb;
+					*(pixelP + surfaceArea->_pitch / 2) |= rgb;
+					*(pixelP + surfaceArea->_pitch / 2 + 1) |= rgb;
+					break;
+
+				default:
+					break;
+				}
 			}
 		}
 	}
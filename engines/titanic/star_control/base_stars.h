@@ -23,6 +23,8 @@
 #ifndef TITANIC_BASE_STARS_H
 #define TITANIC_BASE_STARS_H
 
+#include "titanic/star_control/fpoint.h"
+#include "titanic/star_control/fpose.h"
 #include "titanic/star_control/frange.h"
 #include "common/array.h"
 
@@ -59,6 +61,17 @@ struct CBaseStarEntry {
 	bool operator==(const CBaseStarEntry &s) const;
 };
 
+/**
+ * A block of stars close to each other, culled as a whole when drawing
+ */
+struct CStarBlock {
+	FVector _center;
+	double _radius;
+	uint _start, _end;	// Range of the block in the star layout
+
+	CStarBlock() : _radius(0.0), _start(0), _end(0) {}
+};
+
 struct CStarPosition : public Common::Point {
 	int _index1;
 	int _index2;
@@ -73,11 +86,36 @@ struct CStarPosition : public Common::Point {
  * Base class for views that draw a set of stars in simulated 3D space
  */
 class CBaseStars {
+	enum { kStarsPerBlock = 16 };
+private:
+	// The star positions, ordered in blocks of nearby stars
+	Common::Array<uint> _layoutStars;
+	Common::Array<float> _layoutX, _layoutY, _layoutZ;
+	Common::Array<CStarBlock> _blocks;
+	Common::Array<uint> _visibleBlocks;
+	float _cameraX[kStarsPerBlock], _cameraY[kStarsPerBlock], _cameraZ[kStarsPerBlock];
 private:
 	void draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
+
+	/**
+	 * Splits the stars into blocks of nearby stars
+	 */
+	void buildBlocks();
+	void splitBlock(uint start, uint end);
+
+	/**
+	 * Lists the blocks that may have a star drawn for the given pose
+	 */
+	void cullBlocks(CSurfaceArea *surfaceArea, const FPose &pose, const FPoint &centroid,
+		double minVal, double threshold, double xOffset);
+
+	/**
+	 * Transforms the positions of a block of stars into camera space
+	 */
+	void projectBlock(const CStarBlock &block, const FPose &pose);
 protected:
 	FRange _minMax;
 	double _minVal;
@@ -151,6 +151,9 @@ PathFinding::PathFinding() {
 	_height = 0;
 	_heap = new PathFindingHeap();
 	_sq = NULL;
+	_regions = nullptr;
+	_regionsValid = false;
+	_regionsMaskChanges = 0;
 	_numBlockingRects = 0;
 
 	_currentMask = nullptr;
@@ -161,6 +164,7 @@ PathFinding::~PathFinding(void) {
 		_heap->unload();
 	delete _heap;
 	delete[] _sq;
+	delete[] _regions;
 }
 
 void PathFinding::init(Picture *mask) {
@@ -173,6 +177,117 @@ void PathFinding::init(Picture *mask) {
 	_heap->init(500);
 	delete[] _sq;
 	_sq = new uint16[_width * _height];
+	delete[] _regions;
+	_regions = new uint16[_width * _height];
+	_regionsValid = false;
+}
+
+void PathFinding::updateRegions() {
+	if (_regionsValid && _regionsMaskChanges == _currentMask->getMaskChanges())
+		return;
+
+	debugC(1, kDebugPath, "updateRegions()");
+
+	// Label the areas the way findPath() moves, one pixel in all 8 directions
+	memset(_regions, 0, _width * _height * sizeof(uint16));
+	Common::Array<int32> stack;
+	uint16 region = 0;
+	_regionsValid = true;
+	_regionsMaskChanges = _currentMask->getMaskChanges();
+
+	for (int32 start = 0; start < _width * _height; start++) {
+		if (_regions[start] || !isWalkable(start % _width, start / _width))
+			continue;
+
+		if (region == 0xFFFF) {
+			// Too many areas to tell, findPath() will search them
+			_regionsValid = false;
+			return;
+		}
+
+		region++;
+		_regions[start] = region;
+		stack.push_back(start);
+		while (!stack.empty()) {
+			int32 node = stack.back();
+			stack.pop_back();
+
+			int16 curX = node % _width;
+			int16 curY = node / _width;
+			int16 endX = MIN<int16>(curX + 1, _width - 1);
+			int16 endY = MIN<int16>(curY + 1, _height - 1);
+			for (int16 py = MAX<int16>(curY - 1, 0); py <= endY; py++) {
+				for (int16 px = MAX<int16>(curX - 1, 0); px <= endX; px++) {
+					int32 pNode = px + py * _width;
+					if (!_regions[pNode] && isWalkable(px, py)) {
+						_regions[pNode] = region;
+						stack.push_back(pNode);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool PathFinding::canReach(int16 x, int16 y, int16 destX, int16 destY) {
+	if (!isWalkable(destX, destY))
+		return false;
+
+	updateRegions();
+	if (!_regionsValid)
+		return true;
+
+	uint16 destRegion = _regions[destX + destY * _width];
+
+	// The start doesn't need to be walkable, its neighbours do
+	int16 endX = MIN<int16>(x + 1, _width - 1);
+	int16 endY = MIN<int16>(y + 1, _height - 1);
+	for (int16 py = MAX<int16>(y - 1, 0); py <= endY; py++) {
+		for (int16 px = MAX<int16>(x - 1, 0); px <= endX; px++) {
+			if ((px != x || py != y) && _regions[px + py * _width] == destRegion)
+				return true;
+		}
+	}
+	return false;
+}
+
+void PathFinding::smoothPath(const Common::Array<Common::Point> &path) {
+	// The path goes from the destination back to the start. Walk it from the
+	// start, and go straight to the farthest point that can be seen.
+	Common::Array<Common::Point> points;
+	int32 anchor = path.size() - 1;
+	points.push_back(path[anchor]);
+
+	while (anchor > 0) {
+		int32 best = anchor - 1;
+		for (int32 i = anchor - kSmoothingStep; i > -kSmoothingStep; i -= kSmoothingStep) {
+			int32 candidate = MAX<int32>(i, 0);
+			if (!lineIsWalkable(path[anchor].x, path[anchor].y, path[candidate].x, path[candidate].y))
+				break;
+			best = candidate;
+		}
+
+		// Same steps as walkLine()
+		int32 dx = path[best].x - path[anchor].x;
+		int32 dy = path[best].y - path[anchor].y;
+		int32 t = MAX(abs(dx), abs(dy));
+		int32 cdx = (dx << 16) / t;
+		int32 cdy = (dy << 16) / t;
+		uint32 bx = path[anchor].x << 16;
+		uint32 by = path[anchor].y << 16;
+		for (int32 i = 1; i < t; i++) {
+			bx += cdx;
+			by += cdy;
+			points.push_back(Common::Point(bx >> 16, by >> 16));
+		}
+		points.push_back(path[best]);
+
+		anchor = best;
+	}
+
+	_tempPath.clear();
+	for (int32 i = points.size() - 1; i >= 0; i--)
+		_tempPath.push_back(points[i]);
 }
 
 bool PathFinding::isLikelyWalkable(int16 x, int16 y) {
@@ -305,6 +420,12 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 		return true;
 	}
 
+	// don't search the whole area for a point that is somewhere else
+	if (!canReach(x, y, destx, desty)) {
+		_tempPath.clear();
+		return false;
+	}
+
 	// no direct line, we use the standard A* algorithm
 	memset(_sq , 0, _width * _height * sizeof(uint16));
 	_heap->clear();
@@ -317,6 +438,12 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 
 	while (_heap->getCount()) {
 		_heap->pop(&curX, &curY, &curWeight);
+
+		// the distance estimate never overestimates, so the first time the
+		// destination comes out of the heap its cost is the lowest possible
+		if (curX == destx && curY == desty)
+			break;
+
 		int32 curNode = curX + curY * _width;
 
 		int16 endX = MIN<int16>(curX + 1, _width - 1);
@@ -400,9 +527,7 @@ bool PathFinding::findPath(int16 x, int16 y, int16 destx, int16 desty) {
 		retPath.push_back(Common::Point(bestX, bestY));
 
 		if ((bestX == x && bestY == y)) {
-			_tempPath.clear();
-			for (uint32 i = 0; i < retPath.size(); i++)
-				_tempPath.push_back(retPath[i]);
+			smoothPath(retPath);
 
 			retVal = true;
 			break;
@@ -79,11 +79,22 @@ public:
 
 private:
 	static const uint8 kMaxBlockingRects = 16;
+	static const int16 kSmoothingStep = 8;
+
+	void updateRegions();
+	bool canReach(int16 x, int16 y, int16 destX, int16 destY);
+	void smoothPath(const Common::Array<Common::Point> &path);
 
 	Picture *_currentMask;
 
 	PathFindingHeap *_heap;
 
+	// The connected walkable areas of the mask, so that findPath()
+	// can give up straight away on the points it can't reach
+	uint16 *_regions;
+	bool _regionsValid;
+	uint32 _regionsMaskChanges;
+
 	uint16 *_sq;
 	int16 _width;
 	int16 _height;
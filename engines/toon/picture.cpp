@@ -37,6 +37,8 @@ bool Picture::loadPicture(const Common::String &file) {
 	if (!fileData)
 		return false;
 
+	_maskChanges++;
+
 	uint32 compId = READ_BE_UINT32(fileData);
 
 	switch (compId) {
@@ -143,6 +145,7 @@ Picture::Picture(ToonEngine *vm) : _vm(vm) {
 	_height = 0;
 	_paletteEntries = 0;
 	_useFullPalette = false;
+	_maskChanges = 0;
 }
 
 Picture::~Picture() {
@@ -271,6 +274,7 @@ uint8 Picture::getData(int16 x, int16 y) {
 // use original work from johndoe
 void Picture::floodFillNotWalkableOnMask(int16 x, int16 y) {
 	debugC(1, kDebugPicture, "floodFillNotWalkableOnMask(%d, %d)", x, y);
+	_maskChanges++;
 	// Stack-based floodFill algorithm based on
 	// http://student.kuleuven.be/~m0216922/CG/files/floodfill.cpp
 	Common::Stack<Common::Point> stack;
@@ -303,6 +307,7 @@ void Picture::floodFillNotWalkableOnMask(int16 x, int16 y) {
 
 void Picture::drawLineOnMask(int16 x, int16 y, int16 x2, int16 y2, bool walkable) {
 	debugC(1, kDebugPicture, "drawLineOnMask(%d, %d, %d, %d, %d)", x, y, x2, y2, (walkable) ? 1 : 0);
+	_maskChanges++;
 	static int16 lastX = 0;
 	static int16 lastY = 0;
 
@@ -51,10 +51,14 @@ public:
 	int16 getWidth() const { return _width; }
 	int16 getHeight() const { return _height; }
 
+	// Incremented every time the walkable areas of the mask change
+	uint32 getMaskChanges() const { return _maskChanges; }
+
 protected:
 	int16 _width;
 	int16 _height;
 	uint8 *_data;
+	uint32 _maskChanges;
 	uint8 *_palette; // need to be copied at 3-387
 	int32 _paletteEntries;
 	bool _useFullPalette;
@@ -28,8 +28,42 @@
 namespace Ultima {
 namespace Nuvie {
 
-AStarPath::AStarPath() : final_node(0) {
-} void AStarPath::create_path() {
+AStarPath::AStarPath() : nodes_used(0), final_node(0) {
+}
+
+AStarPath::~AStarPath() {
+	for (uint32 i = 0; i < node_pool.size(); i++)
+		delete node_pool[i];
+}
+
+/* Get a cleared node from the pool. */
+astar_node *AStarPath::new_node() {
+	if (nodes_used == node_pool.size())
+		node_pool.push_back(new astar_node);
+	astar_node *node = node_pool[nodes_used++];
+	*node = astar_node();
+	return node;
+}
+
+/* Give back the last node taken from the pool. */
+void AStarPath::free_node(astar_node *node) {
+	assert(nodes_used > 0 && node_pool[nodes_used - 1] == node);
+	nodes_used--;
+}
+
+/* Return PathFinder::check_loc() for `loc', checking each location once per
+ * search. */
+bool AStarPath::check_loc_cached(const MapCoord &loc) {
+	const uint32 key = node_key(loc);
+	Common::HashMap<uint32, bool>::const_iterator i = checked_locs.find(key);
+	if (i != checked_locs.end())
+		return i->_value;
+	const bool passable = pf->check_loc(loc);
+	checked_locs[key] = passable;
+	return passable;
+}
+
+void AStarPath::create_path() {
 	astar_node *i = final_node; // iterator through steps, from back
 	delete_path();
 	Std::vector<astar_node *> reverse_list;
@@ -52,7 +86,7 @@ bool AStarPath::score_to_neighbor(sint8 dir, astar_node *nnode, astar_node *neig
 	neighbor->loc = nnode->loc.abs_coords(sx, sy);
 	nnode_to_neighbor = step_cost(nnode->loc, neighbor->loc);
 	if (nnode_to_neighbor == -1) {
-		delete neighbor; // this neighbor is blocked
+		free_node(neighbor); // this neighbor is blocked
 		return false;
 	}
 	return true;
@@ -64,7 +98,7 @@ bool AStarPath::compare_neighbors(astar_node *nnode, astar_node *neighbor,
 	// ignore this neighbor if already checked and closer to start
 	if ((in_open && in_open->to_start <= neighbor->to_start)
 	        || (in_closed && in_closed->to_start <= neighbor->to_start)) {
-		delete neighbor;
+		free_node(neighbor);
 		return false;
 	}
 	return true;
@@ -72,7 +106,7 @@ bool AStarPath::compare_neighbors(astar_node *nnode, astar_node *neighbor,
 bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
                                       const uint32 max_score) {
 	for (uint32 dir = 1; dir < 8; dir += 2) {
-		astar_node *neighbor = new astar_node;
+		astar_node *neighbor = new_node();
 		sint32 nnode_to_neighbor = -1;
 		if (!score_to_neighbor(dir, nnode, neighbor, nnode_to_neighbor))
 			continue; // this neighbor is blocked
@@ -85,7 +119,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 		neighbor->score = neighbor->to_start + neighbor->to_goal;
 		neighbor->len = nnode->len + 1;
 		if (neighbor->score > max_score) {
-			delete neighbor; // too far away
+			free_node(neighbor); // too far away
 			continue;
 		}
 		// take neighbor out of closed list and put into open list
@@ -102,7 +136,8 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
  * Returns true if a path is created
  */bool AStarPath::path_search(MapCoord &start, MapCoord &goal) {
 	//DEBUG(0,LEVEL_DEBUGGING,"SEARCH: %d: %d,%d -> %d,%d\n",actor->get_actor_num(),start.x,start.y,goal.x,goal.y);
-	astar_node *start_node = new astar_node;
+	delete_nodes(); // forget the locations checked since the last search
+	astar_node *start_node = new_node();
 	start_node->loc = start;
 	start_node->to_start = 0;
 	start_node->to_goal = path_cost_est(start, goal);
@@ -125,7 +160,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 		// check cardinal neighbors (starting at top going clockwise)
 		search_node_neighbors(nnode, goal, max_score);
 		// node and neighbors checked, put into closed
-		closed_nodes.push_back(nnode);
+		nnode->closed = true;
 	}
 //DEBUG(0,LEVEL_DEBUGGING,"FAIL\n");
 	delete_nodes();
@@ -134,27 +169,26 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
  * isn't very helpful, so subclasses should provide their own function.
  * Returns -1 if c2 is blocked. */
 sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
-	if (!pf->check_loc(c2.x, c2.y, c2.z)
+	if (!check_loc_cached(c2)
 	        || c2.distance(c1) > 1)
 		return (-1);
 	return (1);
 }/* Return an item in the list of closed nodes whose location matches `ncmp'.
  */astar_node *AStarPath::find_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
+	Common::HashMap<uint32, astar_node *>::const_iterator n = seen_nodes.find(node_key(ncmp->loc));
+	if (n != seen_nodes.end() && n->_value->closed)
+		return (n->_value);
 	return (NULL);
-}/* Return an item in the list of closed nodes whose location matches `ncmp'.
+}/* Return an item in the list of open nodes whose location matches `ncmp'.
  */astar_node *AStarPath::find_open_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = open_nodes.begin(); n != open_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
+	Common::HashMap<uint32, astar_node *>::const_iterator n = seen_nodes.find(node_key(ncmp->loc));
+	if (n != seen_nodes.end() && !n->_value->closed)
+		return (n->_value);
 	return (NULL);
 }/* Add new node pointer to the list of open nodes (sorting by score).
  */void AStarPath::push_open_node(astar_node *node) {
 	Std::list<astar_node *>::iterator n, next;
+	seen_nodes[node_key(node->loc)] = node;
 	if (open_nodes.empty()) {
 		open_nodes.push_front(node);
 		return;
@@ -175,27 +209,19 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
  * remove it from the list.
  */
 void AStarPath::remove_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc) {
-			closed_nodes.erase(n);
-			return;
-		}
+	Common::HashMap<uint32, astar_node *>::iterator n = seen_nodes.find(node_key(ncmp->loc));
+	if (n != seen_nodes.end() && n->_value->closed)
+		seen_nodes.erase(n);
 }
 
-/* Delete nodes dereferenced from pointers in the lists.
+/* Give back all the nodes of the search to the pool, and forget the
+ * locations checked.
  */
 void AStarPath::delete_nodes() {
-	while (!open_nodes.empty()) {
-		astar_node *delnode = open_nodes.front();
-		open_nodes.pop_front();
-		delete delnode;
-	}
-	while (!closed_nodes.empty()) {
-		astar_node *delnode = closed_nodes.front();
-		closed_nodes.pop_front();
-		delete delnode;
-	}
+	open_nodes.clear();
+	seen_nodes.clear();
+	checked_locs.clear();
+	nodes_used = 0;
 }
 
 } // End of namespace Nuvie
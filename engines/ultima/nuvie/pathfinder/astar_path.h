@@ -25,6 +25,7 @@
 
 #include "ultima/nuvie/core/map.h"
 #include "ultima/nuvie/pathfinder/path.h"
+#include "common/hashmap.h"
 
 namespace Ultima {
 namespace Nuvie {
@@ -36,14 +37,31 @@ typedef struct astar_node_s {
 	uint32 score; // node score
 	uint32 len; // number of nodes before this one, regardless of score
 	struct astar_node_s *parent;
+	bool closed; // searched already, rather than in the open list
 	astar_node_s() : loc(0, 0, 0), to_start(0), to_goal(0), score(0), len(0),
-		parent(NULL) { }
+		parent(NULL), closed(false) { }
 } astar_node;
 /* Provides A* search and cost methods for PathFinder and subclasses.
  */class AStarPath: public Path {
 protected:
-	Std::list<astar_node *> open_nodes, closed_nodes; // nodes seen
+	Std::list<astar_node *> open_nodes; // nodes to search, sorted by score
+	/* Open or closed node of each location seen, by node_key(). A location
+	 * is never in both lists. */
+	Common::HashMap<uint32, astar_node *> seen_nodes;
+	/* Result of PathFinder::check_loc() for the locations checked, by node_key().
+	 * Nothing moves during a search, so each location is only checked once. */
+	Common::HashMap<uint32, bool> checked_locs;
+	/* The nodes are taken from this pool, and all given back after a search. */
+	Std::vector<astar_node *> node_pool;
+	uint32 nodes_used;
 	astar_node *final_node; // last node in path search, used by create_path()
+	/* All the nodes of a search are on the level of the start. */
+	static uint32 node_key(const MapCoord &loc) {
+		return loc.x | ((uint32)loc.y << 16);
+	}
+	astar_node *new_node();
+	void free_node(astar_node *node);
+	bool check_loc_cached(const MapCoord &loc);
 	/* Forms a usable path from results of a search. */
 	void create_path();
 	/* Search routine. */
@@ -55,7 +73,7 @@ protected:
 	                       sint32 &nnode_to_neighbor);
 public:
 	AStarPath();
-	~AStarPath() override { }
+	~AStarPath() override;
 	bool path_search(MapCoord &start, MapCoord &goal) override;
 	uint32 path_cost_est(MapCoord &s, MapCoord &g) override  {
 		return (Path::path_cost_est(s, g));
@@ -40,7 +40,7 @@ sint32 U6AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
 	// FIXME: need an actor->check_move(loc2, loc1) to check one step only
 	if (c2.distance(c1) > 1)
 		return (-1);
-	if (!pf->check_loc(c2.x, c2.y, c2.z)) {
+	if (!check_loc_cached(c2)) {
 		// check for door
 		Obj *block = game->get_obj_manager()->get_obj(c2.x, c2.y, c2.z);
 		// HACK: check the neighboring tiles for the "real" door
@@ -524,7 +524,7 @@ Script::Script(Configuration *cfg, GUI *gui, SoundManager *sm, nuvie_game_t type
 
 	script_obj_list = iAVLAllocTree(get_iAVLKey);
 
-	L = luaL_newstate();
+	L = allocator.newState();
 	luaL_openlibs(L);
 
 	luaL_newmetatable(L, "nuvie.U6Link");
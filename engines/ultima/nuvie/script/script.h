@@ -24,6 +24,7 @@
 #define NUVIE_SCRIPT_SCRIPT_H
 
 #include "common/lua/lua.h"
+#include "common/lua/lua_allocator.h"
 
 #include "ultima/shared/std/string.h"
 #include "ultima/shared/std/containers.h"
@@ -105,6 +106,7 @@ class Script {
 	Configuration *config;
 	nuvie_game_t gametype; // what game is being played?
 	SoundManager *soundManager;
+	Lua::LuaAllocator allocator;
 	lua_State *L;
 
 public:
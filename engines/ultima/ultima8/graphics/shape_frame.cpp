@@ -72,6 +72,26 @@ ShapeFrame::ShapeFrame(const RawShapeFrame *rawframe) :
 
 	}
 
+	// The runs of the RLE data may touch, so the spans are taken from the mask
+	_lineSpans.resize(_height + 1);
+	for (int y = 0; y < _height; y++) {
+		_lineSpans[y] = _spans.size();
+		const uint8 *maskline = _mask + y * _width;
+		int32 xpos = 0;
+		while (xpos < _width) {
+			if (!maskline[xpos]) {
+				xpos++;
+				continue;
+			}
+			Span span;
+			span._start = xpos;
+			while (xpos < _width && maskline[xpos])
+				xpos++;
+			span._end = xpos;
+			_spans.push_back(span);
+		}
+	}
+	_lineSpans[_height] = _spans.size();
 }
 
 ShapeFrame::~ShapeFrame() {
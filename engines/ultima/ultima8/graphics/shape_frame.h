@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_GRAPHICS_SHAPEFRAME_H
 #define ULTIMA8_GRAPHICS_SHAPEFRAME_H
 
+#include "common/array.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -41,6 +43,17 @@ public:
 	uint8 *_pixels;
 	uint8 *_mask;
 
+	//! A run of set pixels in the mask, [_start, _end) within its line
+	struct Span {
+		uint16 _start;
+		uint16 _end;
+	};
+
+	//! The spans of all the lines, line y having
+	//! [_lineSpans[y], _lineSpans[y + 1]) in _spans
+	Common::Array<Span> _spans;
+	Common::Array<uint32> _lineSpans;
+
 	bool hasPoint(int32 x, int32 y) const;  // Check to see if a point is in the frame
 
 	uint8 getPixelAtPoint(int32 x, int32 y) const;  // Get the pixel at the point
@@ -50,11 +50,9 @@
 //
 // NOT_CLIPPED_Y - Does Y Clipping check per line
 // 
-// NOT_CLIPPED_X - Does X Clipping check per Pixel
-// 
-// LINE_END_ASSIGN - Calcuates the line_end pointer required for X clipping
-//
 // XNEG - Negates X values if doing shape flipping
+//
+// SPAN_CLIP - Clips the span [span_start, span_end) of the source line
 // 
 // USE_XFORM_FUNC - Checks to see if we want to use XForm Blending for this pixel
 // 
@@ -103,9 +101,8 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 //	
 #ifdef NO_CLIPPING
 
-#define LINE_END_ASSIGN //
-#define NOT_CLIPPED_X (1)
 #define NOT_CLIPPED_Y (1)
+#define SPAN_CLIP //
 #define OFFSET_PIXELS (_pixels)
 
 //
@@ -116,11 +113,20 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	const int		scrn_width = _clipWindow.width();
 	const int		scrn_height = _clipWindow.height();
 
-#define LINE_END_ASSIGN const uintX *dst_line_end = dst_line_start + scrn_width
-#define NOT_CLIPPED_X (dstpix >= dst_line_start && dstpix < dst_line_end)
 #define NOT_CLIPPED_Y (line >= 0 && line < scrn_height)
 #define OFFSET_PIXELS (off_pixels)
 
+// The source columns which land in [0, scrn_width): [-x, scrn_width - x),
+// or (x - scrn_width, x] when flipping.
+#define SPAN_CLIP \
+	if (XNEG(1) > 0) { \
+		span_start = MAX<int32>(span_start, -x); \
+		span_end = MIN<int32>(span_end, scrn_width - x); \
+	} else { \
+		span_start = MAX<int32>(span_start, x - scrn_width + 1); \
+		span_end = MIN<int32>(span_end, x + 1); \
+	}
+
 	uint8			*off_pixels  = _pixels + _clipWindow.left * sizeof(uintX) + _clipWindow.top * _pitch;
 	x -= _clipWindow.left;
 	y -= _clipWindow.top;
@@ -175,7 +181,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	if (!frame)
 		return;
 	const uint8		*srcpixels		= frame->_pixels;
-	const uint8		*srcmask		= frame->_mask;
 	const uint32	*pal			= untformed_pal ?
 										s->getPalette()->_native_untransformed:
 										s->getPalette()->_native;
@@ -191,33 +196,36 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	x -= XNEG(frame->_xoff);
 	y -= frame->_yoff;
 
-	assert(_pixels00 && _pixels && srcpixels && srcmask);
+	assert(_pixels00 && _pixels && srcpixels && frame->_mask);
 
 	for (int i = 0; i < height_; i++)  {
 		int line = y + i;
 
 		if (NOT_CLIPPED_Y) {
 			const uint8	*srcline = srcpixels + i * width_;
-			const uint8	*srcmaskline = srcmask + i * width_;
 			uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * line);
-			LINE_END_ASSIGN;
-
-			for (int xpos = 0; xpos < width_; xpos++) {
-				if (srcmaskline[xpos] == 0)
-					continue;
 
-				uintX *dstpix = dst_line_start + x + XNEG(xpos);
-
-				if (NOT_CLIPPED_X && NOT_DESTINATION_MASKED) {
-					const uint8 *srcpix = srcline + xpos;
-					#ifdef XFORM_SHAPES
-					if (USE_XFORM_FUNC) {
-						*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix));
-					}
-					else
-					#endif
-					{
-						*dstpix = CUSTOM_BLEND(pal[*srcpix]);
+			// Only the set pixels of the mask are drawn, and the spans are
+			// clipped as a whole, so the pixels need no more checks
+			for (uint32 j = frame->_lineSpans[i]; j < frame->_lineSpans[i + 1]; j++) {
+				int32 span_start = frame->_spans[j]._start;
+				int32 span_end = frame->_spans[j]._end;
+				SPAN_CLIP;
+
+				for (int32 xpos = span_start; xpos < span_end; xpos++) {
+					uintX *dstpix = dst_line_start + x + XNEG(xpos);
+
+					if (NOT_DESTINATION_MASKED) {
+						const uint8 *srcpix = srcline + xpos;
+						#ifdef XFORM_SHAPES
+						if (USE_XFORM_FUNC) {
+							*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix));
+						}
+						else
+						#endif
+						{
+							*dstpix = CUSTOM_BLEND(pal[*srcpix]);
+						}
 					}
 				}
 			}
@@ -227,8 +235,7 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 #undef NOT_DESTINATION_MASKED
 #undef OFFSET_PIXELS
 #undef CUSTOM_BLEND
-#undef LINE_END_ASSIGN
-#undef NOT_CLIPPED_X
+#undef SPAN_CLIP
 #undef NOT_CLIPPED_Y
 #undef XNEG
 #undef USE_XFORM_FUNC
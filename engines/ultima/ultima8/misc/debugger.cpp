@@ -47,6 +47,7 @@
 #include "ultima/ultima8/world/camera_process.h"
 #include "ultima/ultima8/world/get_object.h"
 #include "ultima/ultima8/world/item_factory.h"
+#include "ultima/ultima8/world/item_sorter.h"
 #include "ultima/ultima8/world/actors/quick_avatar_mover_process.h"
 #include "ultima/ultima8/world/actors/avatar_mover_process.h"
 #include "ultima/ultima8/world/target_reticle_process.h"
@@ -133,6 +134,7 @@ Debugger::Debugger() : Shared::Debugger() {
 	registerCmd("GameMapGump::dumpMap", WRAP_METHOD(Debugger, cmdDumpMap));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::sortStats", WRAP_METHOD(Debugger, cmdSortStats));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -179,6 +181,7 @@ Debugger::Debugger() : Shared::Debugger() {
 
 	registerCmd("UCMachine::getGlobal", WRAP_METHOD(Debugger, cmdGetGlobal));
 	registerCmd("UCMachine::setGlobal", WRAP_METHOD(Debugger, cmdSetGlobal));
+	registerCmd("UCMachine::executionCounts", WRAP_METHOD(Debugger, cmdExecutionCounts));
 #ifdef DEBUG
 	registerCmd("UCMachine::traceObjID", WRAP_METHOD(Debugger, cmdTraceObjID));
 	registerCmd("UCMachine::tracePID", WRAP_METHOD(Debugger, cmdTracePID));
@@ -817,6 +820,19 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdSortStats(int argc, const char **argv) {
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No GameMapGump\n");
+		return true;
+	}
+
+	uint32 items, tests, micros;
+	gump->getDisplayList()->GetSortStats(items, tests, micros);
+	debugPrintf("Last frame: %u items sorted with %u overlap tests in %u us\n", items, tests, micros);
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
@@ -1625,6 +1641,48 @@ bool Debugger::cmdSetGlobal(int argc, const char **argv) {
 	return true;
 }
 
+struct ExecutionCount {
+	unsigned int _index;
+	uint32 _count;
+
+	bool operator<(const ExecutionCount &other) const {
+		return _count > other._count;
+	}
+};
+
+static void printExecutionCounts(Debugger *debugger, const char *kind, const uint32 *counts, unsigned int size) {
+	Common::Array<ExecutionCount> sorted;
+	for (unsigned int i = 0; i < size; ++i) {
+		if (counts[i]) {
+			ExecutionCount count = { i, counts[i] };
+			sorted.push_back(count);
+		}
+	}
+	Common::sort(sorted.begin(), sorted.end());
+
+	for (unsigned int i = 0; i < sorted.size() && i < 32; ++i)
+		debugger->debugPrintf("%s %04X: %u\n", kind, sorted[i]._index, sorted[i]._count);
+}
+
+bool Debugger::cmdExecutionCounts(int argc, const char **argv) {
+	UCMachine *uc = UCMachine::get_instance();
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("usage: UCMachine::executionCounts [reset]\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		uc->resetExecutionCounts();
+		debugPrintf("Execution counts reset\n");
+		return true;
+	}
+
+	printExecutionCounts(this, "opcode", uc->_opcodeCounts, ARRAYSIZE(uc->_opcodeCounts));
+	if (!uc->_intrinsicCounts.empty())
+		printExecutionCounts(this, "intrinsic", &uc->_intrinsicCounts[0], uc->_intrinsicCounts.size());
+	return true;
+}
+
 #ifdef DEBUG
 
 bool Debugger::cmdTracePID(int argc, const char **argv) {
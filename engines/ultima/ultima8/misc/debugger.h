@@ -198,6 +198,7 @@ private:
 	bool cmdDumpMap(int argc, const char **argvv);
 	bool cmdIncrementSortOrder(int argc, const char **argv);
 	bool cmdDecrementSortOrder(int argc, const char **argv);
+	bool cmdSortStats(int argc, const char **argv);
 
 	// Kernel
 	bool cmdProcessTypes(int argc, const char **argv);
@@ -249,6 +250,7 @@ private:
 	// UCMachine
 	bool cmdGetGlobal(int argc, const char **argv);
 	bool cmdSetGlobal(int argc, const char **argv);
+	bool cmdExecutionCounts(int argc, const char **argv);
 #ifdef DEBUG
 	bool cmdTracePID(int argc, const char **argv);
 	bool cmdTraceObjID(int argc, const char **argv);
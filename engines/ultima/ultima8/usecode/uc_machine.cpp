@@ -68,6 +68,62 @@ static const char *print_sp(const int16 offset) {
 
 //#define DUMPHEAP
 
+/**
+ * Reads the usecode of a class straight from memory. The operands are read
+ * inline, instead of through the virtual calls of an IDataSource.
+ */
+class UCCodeSegment {
+public:
+	UCCodeSegment(const uint8 *data, uint32 size) : _data(data), _size(size), _pos(0) {}
+
+	void load(const uint8 *data, uint32 size) {
+		_data = data;
+		_size = size;
+		_pos = 0;
+	}
+
+	void seek(uint32 position) {
+		_pos = position;
+	}
+
+	uint32 pos() const {
+		return _pos;
+	}
+
+	// Reading past the end of the class gives zeros, as the data sources do
+	uint8 readByte() {
+		return _pos < _size ? _data[_pos++] : 0;
+	}
+
+	int8 readSByte() {
+		return static_cast<int8>(readByte());
+	}
+
+	uint16 readUint16LE() {
+		uint16 value = readByte();
+		return value | (readByte() << 8);
+	}
+
+	uint32 readUint32LE() {
+		uint32 value = readUint16LE();
+		return value | (readUint16LE() << 16);
+	}
+
+	uint32 read(void *buf, uint32 count) {
+		if (_pos >= _size)
+			return 0;
+		count = MIN(count, _size - _pos);
+		memcpy(buf, _data + _pos, count);
+		_pos += count;
+		return count;
+	}
+
+private:
+	const uint8 *_data;
+	uint32 _size;
+	uint32 _pos;
+};
+
 enum UCSegments {
 	SEG_STACK      = 0x0000,
 	SEG_STACK_FIRST = 0x0001,
@@ -103,6 +159,7 @@ UCMachine::UCMachine(Intrinsic *iset, unsigned int icount) {
 	}
 
 	loadIntrinsics(iset, icount); //!...
+	resetExecutionCounts();
 
 	_listIDs = new idMan(1, 65534, 128);
 	_stringIDs = new idMan(1, 65534, 256);
@@ -149,14 +206,22 @@ void UCMachine::reset() {
 void UCMachine::loadIntrinsics(Intrinsic *i, unsigned int icount) {
 	_intrinsics = i;
 	_intrinsicCount = icount;
+	_intrinsicCounts.clear();
+	_intrinsicCounts.resize(icount);
+}
+
+void UCMachine::resetExecutionCounts() {
+	memset(_opcodeCounts, 0, sizeof(_opcodeCounts));
+	for (unsigned int i = 0; i < _intrinsicCounts.size(); ++i)
+		_intrinsicCounts[i] = 0;
 }
 
 void UCMachine::execProcess(UCProcess *p) {
 	assert(p);
 
 	uint32 base = p->_usecode->get_class_base_offset(p->_classId);
-	IBufferDataSource cs(p->_usecode->get_class(p->_classId) + base,
-	                     p->_usecode->get_class_size(p->_classId) - base);
+	UCCodeSegment cs(p->_usecode->get_class(p->_classId) + base,
+	                 p->_usecode->get_class_size(p->_classId) - base);
 	cs.seek(p->_ip);
 
 #ifdef DEBUG
@@ -176,6 +241,7 @@ void UCMachine::execProcess(UCProcess *p) {
 		//! guard against other error conditions
 
 		uint8 opcode = cs.readByte();
+		_opcodeCounts[opcode]++;
 
 #ifdef DEBUG
 		uint16 trace_classid = p->_classId;
@@ -364,6 +430,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			uint16 arg_bytes = cs.readByte();
 			uint16 func = cs.readUint16LE();
 			LOGPF(("calli\t\t%04Xh (%02Xh arg bytes) %s\n", func, arg_bytes, _convUse->intrinsics()[func]));
+			if (func < _intrinsicCount)
+				_intrinsicCounts[func]++;
 
 			// !constants
 			if (func >= _intrinsicCount || _intrinsics[func] == 0) {
@@ -63,6 +63,9 @@ public:
 
 	void usecodeStats() const;
 
+	//! Reset the counts of executed opcodes and intrinsic calls
+	void resetExecutionCounts();
+
 	static uint32 listToPtr(uint16 l);
 	static uint32 stringToPtr(uint16 s);
 	static uint32 stackToPtr(uint16 pid, uint16 offset);
@@ -97,6 +100,10 @@ private:
 	Intrinsic *_intrinsics;
 	unsigned int _intrinsicCount;
 
+	// execution counts, shown by the debugger
+	uint32 _opcodeCounts[256];
+	Std::vector<uint32> _intrinsicCounts;
+
 	GlobalStorage *_globals;
 
 	Std::map<uint16, UCList *> _listHeap;
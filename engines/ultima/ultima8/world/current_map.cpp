@@ -546,6 +546,21 @@ inline void CurrentMap::clipMapChunks(int &minx, int &maxx, int &miny, int &maxy
 	maxy = CLIP(maxy, 0, MAP_NUM_CHUNKS - 1);
 }
 
+// Items are listed in the chunk of their x,y, the corner of their footpad
+// with the largest coordinates. As the footpads are smaller than a chunk
+// (4 bit dimensions in U8, 5 bit in Crusader, 32 units each), only the
+// items of the chunks from the one of (x1,y1) to the one after (x2,y2) can
+// reach the area. The start is moved back by one unit, as some of the tests
+// also consider the items which merely touch the area.
+inline void CurrentMap::getSearchChunks(int32 x1, int32 y1, int32 x2, int32 y2,
+                                        int &minx, int &maxx, int &miny, int &maxy) const {
+	minx = (x1 - 1) / _mapChunkSize;
+	maxx = (x2 / _mapChunkSize) + 1;
+	miny = (y1 - 1) / _mapChunkSize;
+	maxy = (y2 / _mapChunkSize) + 1;
+	clipMapChunks(minx, maxx, miny, maxy);
+}
+
 void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
                             uint32 scriptsize, const Item *check, uint16 range,
                             bool recurse, int32 x, int32 y) const {
@@ -561,11 +576,9 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 
 	const Rect searchrange(x - xd - range, y - yd - range, x + range, y + range);
 
-	int minx = ((x - xd - range) / _mapChunkSize) - 1;
-	int maxx = ((x + range) / _mapChunkSize) + 1;
-	int miny = ((y - yd - range) / _mapChunkSize) - 1;
-	int maxy = ((y + range) / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(x - xd - range, y - yd - range, x + range, y + range,
+	                minx, maxx, miny, maxy);
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
@@ -630,11 +643,9 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	const Rect searchrange(origin[0] - dims[0], origin[1] - dims[1],
 	                       origin[0], origin[1]);
 
-	int minx = ((origin[0] - dims[0]) / _mapChunkSize) - 1;
-	int maxx = ((origin[0]) / _mapChunkSize) + 1;
-	int miny = ((origin[1] - dims[1]) / _mapChunkSize) - 1;
-	int maxy = ((origin[1]) / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(origin[0] - dims[0], origin[1] - dims[1], origin[0], origin[1],
+	                minx, maxx, miny, maxy);
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
@@ -761,11 +772,8 @@ bool CurrentMap::isValidPosition(int32 x, int32 y, int32 z,
 	ObjId roof = 0;
 	int32 roofz = INT_MAX_VALUE;
 
-	int minx = ((x - xd) / _mapChunkSize) - 1;
-	int maxx = (x / _mapChunkSize) + 1;
-	int miny = ((y - yd) / _mapChunkSize) - 1;
-	int maxy = (y / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getSearchChunks(x - xd, y - yd, x, y, minx, maxx, miny, maxy);
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
@@ -778,14 +786,19 @@ bool CurrentMap::isValidPosition(int32 x, int32 y, int32 z,
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
+				// The footpad ends at the location, so the items located
+				// before the area can't overlap it in any way
+				int32 ix, iy, iz, ixd, iyd, izd;
+				item->getLocation(ix, iy, iz);
+				if (ix <= x - xd || iy <= y - yd)
+					continue;
+
 				const ShapeInfo *si = item->getShapeInfo();
 				//!! need to check is_sea() and is_land() maybe?
 				if (!(si->_flags & flagmask))
 					continue; // not an interesting item
 
-				int32 ix, iy, iz, ixd, iyd, izd;
 				item->getFootpadWorld(ixd, iyd, izd);
-				item->getLocation(ix, iy, iz);
 
 #if 0
 				if (item->getShape() == 145) {
@@ -1015,27 +1028,11 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
                            Std::list<SweepItem> *hit) const {
 	const uint32 blockflagmask = (ShapeInfo::SI_SOLID | ShapeInfo::SI_DAMAGING);
 
-	int minx = ((start[0] - dims[0]) / _mapChunkSize) - 1;
-	int maxx = (start[0] / _mapChunkSize) + 1;
-	int miny = ((start[1] - dims[1]) / _mapChunkSize) - 1;
-	int maxy = (start[1] / _mapChunkSize) + 1;
-
-	{
-		int dminx = ((end[0] - dims[0]) / _mapChunkSize) - 1;
-		int dmaxx = (end[0] / _mapChunkSize) + 1;
-		int dminy = ((end[1] - dims[1]) / _mapChunkSize) - 1;
-		int dmaxy = (end[1] / _mapChunkSize) + 1;
-		if (dminx < minx)
-			minx = dminx;
-		if (dmaxx > maxx)
-			maxx = dmaxx;
-		if (dminy < miny)
-			miny = dminy;
-		if (dmaxy > maxy)
-			maxy = dmaxy;
-	}
-
-	clipMapChunks(minx, maxx, miny, maxy);
+	// The chunks of the whole box swept from start to end
+	int minx, maxx, miny, maxy;
+	getSearchChunks(MIN(start[0], end[0]) - dims[0], MIN(start[1], end[1]) - dims[1],
+	                MAX(start[0], end[0]), MAX(start[1], end[1]),
+	                minx, maxx, miny, maxy);
 
 	// Get velocity, extents, and centre of item
 	int32 vel[3];
@@ -223,6 +223,10 @@ private:
 	//! clip the given map chunk numbers to iterate over them safely
 	static void clipMapChunks(int &minx, int &maxx, int &miny, int &maxy);
 
+	//! get the map chunks whose items can reach the given world area
+	void getSearchChunks(int32 x1, int32 y1, int32 x2, int32 y2,
+	                     int &minx, int &maxx, int &miny, int &maxy) const;
+
 	Map *_currentMap;
 
 	// item lists. Lots of them :-)
@@ -29,6 +29,8 @@
 #include "ultima/ultima8/graphics/render_surface.h"
 #include "ultima/ultima8/misc/rect.h"
 #include "ultima/ultima8/games/game_data.h"
+#include "common/algorithm.h"
+#include "common/profiler.h"
 
 // temp
 #include "ultima/ultima8/world/actors/weapon_overlay.h"
@@ -49,7 +51,8 @@ struct SortItem {
 			_syTop(0), _sxBot(0), _syBot(0),_f32x32(false), _flat(false),
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
-			_land(false), _occluded(false), _clipped(0) { }
+			_land(false), _occluded(false), _clipped(0), _listOrder(0),
+			_stamp(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -114,6 +117,9 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _listOrder;  // Increases along the item list, see InsertListOrder
+	uint32  _stamp;      // Last AddItem that collected this as a candidate
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
@@ -575,13 +581,25 @@ inline bool SortItem::operator<<(const SortItem &si2) const {
 }
 
 
+struct ListOrderLess {
+	bool operator()(const SortItem *a, const SortItem *b) const {
+		return a->_listOrder < b->_listOrder;
+	}
+};
+
 //
 // ItemSorter
 //
 
+static const int32 BUCKET_SIZE = 64;
+static const uint32 LIST_ORDER_STEP = 1 << 12;
+
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_gridX(0), _gridY(0), _gridW(0), _gridH(0), _candidateStamp(0),
+	_sortItems(0), _sortTests(0), _sortTime(0),
+	_lastSortItems(0), _lastSortTests(0), _lastSortTime(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
@@ -621,6 +639,25 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	_surf = rs;
 	_orderCounter = 0;
 
+	_lastSortItems = _sortItems;
+	_lastSortTests = _sortTests;
+	_lastSortTime = _sortTime;
+	_sortItems = _sortTests = _sortTime = 0;
+
+	// Cover the clipping window with the grid. The items outside of it
+	// go in the border cells, which keeps every overlapping pair in a
+	// common cell
+	Rect clipWindow;
+	_surf->GetClippingRect(clipWindow);
+	_gridX = clipWindow.left;
+	_gridY = clipWindow.top;
+	_gridW = MAX<int32>(1, (clipWindow.width() + BUCKET_SIZE - 1) / BUCKET_SIZE);
+	_gridH = MAX<int32>(1, (clipWindow.height() + BUCKET_SIZE - 1) / BUCKET_SIZE);
+	if (_buckets.size() != (uint)(_gridW * _gridH))
+		_buckets.resize(_gridW * _gridH);
+	for (uint i = 0; i < _buckets.size(); i++)
+		_buckets[i].resize(0);
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	_camSx = (camx - camy) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -711,14 +748,43 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	const uint64 sortStart = Common::Profiler::getMicros();
 
-	// Ok,
+	// Get the insert point... which is before the first item that has higher z than us
 	SortItem *addpoint = nullptr;
 	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
+		if (si->ListLessThan(si2)) {
 			addpoint = si2;
+			break;
+		}
+	}
+
+	// Only the items sharing a grid cell with us can overlap us. Compare
+	// them in the order of the list, as the dependencies and occlusion
+	// depend on it
+	int32 bx1, by1, bx2, by2;
+	GetBuckets(si, bx1, by1, bx2, by2);
+
+	_candidates.resize(0);
+	_candidateStamp++;
+	for (int32 by = by1; by <= by2; by++) {
+		for (int32 bx = bx1; bx <= bx2; bx++) {
+			const Std::vector<SortItem *> &bucket = _buckets[by * _gridW + bx];
+			for (uint i = 0; i < bucket.size(); i++) {
+				SortItem *si2 = bucket[i];
+				if (si2->_stamp != _candidateStamp && !si2->_occluded) {
+					si2->_stamp = _candidateStamp;
+					_candidates.push_back(si2);
+				}
+			}
+		}
+	}
+	Common::sort(_candidates.begin(), _candidates.end(), ListOrderLess());
+
+	// Iterate the candidates and compare _shapes
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
+		_sortTests++;
 
 		// Doesn't overlap
 		if (si2->_occluded || !si->overlap(*si2))
@@ -747,6 +813,14 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
+	InsertListOrder(si, addpoint);
+
+	// Nothing needs to be compared to an occluded item
+	if (!si->_occluded) {
+		for (int32 by = by1; by <= by2; by++)
+			for (int32 bx = bx1; bx <= bx2; bx++)
+				_buckets[by * _gridW + bx].push_back(si);
+	}
 
 	// have a position
 	//addpoint = 0;
@@ -769,6 +843,47 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		si->_prev = _itemsTail;
 		_itemsTail = si;
 	}
+
+	_sortItems++;
+	_sortTime += (uint32)(Common::Profiler::getMicros() - sortStart);
+}
+
+/**
+ * Give si a _listOrder between the ones of the items around its insert
+ * point, renumbering the whole list when there is no room left.
+ */
+void ItemSorter::InsertListOrder(SortItem *si, SortItem *addpoint) {
+	const SortItem *prev = addpoint ? addpoint->_prev : _itemsTail;
+	uint32 low = prev ? prev->_listOrder : 0;
+	uint32 high = addpoint ? addpoint->_listOrder : 0xFFFFFFFF;
+
+	if (high - low < 2) {
+		uint32 order = 0;
+		for (SortItem *it = _items; it != nullptr; it = it->_next) {
+			if (it == addpoint)
+				order += LIST_ORDER_STEP;
+			order += LIST_ORDER_STEP;
+			it->_listOrder = order;
+		}
+		low = prev ? prev->_listOrder : 0;
+		high = addpoint ? addpoint->_listOrder : low + 2 * LIST_ORDER_STEP;
+	}
+
+	if (addpoint)
+		si->_listOrder = low + (high - low) / 2;
+	else
+		si->_listOrder = low + MIN<uint32>(LIST_ORDER_STEP, (high - low) / 2);
+}
+
+/**
+ * Get the grid cells covered by the screenspace bounding box of si.
+ * Two items can only overlap if their boxes intersect.
+ */
+void ItemSorter::GetBuckets(const SortItem *si, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const {
+	x1 = CLIP<int32>((si->_sxLeft - _gridX) / BUCKET_SIZE, 0, _gridW - 1);
+	x2 = CLIP<int32>((si->_sxRight - _gridX) / BUCKET_SIZE, 0, _gridW - 1);
+	y1 = CLIP<int32>((si->_syTop - _gridY) / BUCKET_SIZE, 0, _gridH - 1);
+	y2 = CLIP<int32>((si->_syBot - _gridY) / BUCKET_SIZE, 0, _gridH - 1);
 }
 
 void ItemSorter::AddItem(const Item *add) {
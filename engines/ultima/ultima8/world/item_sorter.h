@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "ultima/shared/std/containers.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -44,6 +46,19 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	// Screenspace grid of the items, so that AddItem only compares the
+	// items whose bounding boxes share a cell
+	Std::vector<Std::vector<SortItem *> > _buckets;
+	int32       _gridX, _gridY;
+	int32       _gridW, _gridH;
+
+	Std::vector<SortItem *> _candidates;
+	uint32      _candidateStamp;
+
+	// Sorting statistics of the current and of the last display list
+	uint32      _sortItems, _sortTests, _sortTime;
+	uint32      _lastSortItems, _lastSortTests, _lastSortTime;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -72,9 +87,20 @@ public:
 		if (_sortLimit > 0) _sortLimit--;
 	}
 
+	// Statistics of the last display list: the items sorted, the overlap
+	// tests done between them, and the time spent in AddItem in microseconds
+	void GetSortStats(uint32 &items, uint32 &tests, uint32 &micros) const {
+		items = _lastSortItems;
+		tests = _lastSortTests;
+		micros = _lastSortTime;
+	}
+
 private:
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
+
+	void InsertListOrder(SortItem *si, SortItem *addpoint);
+	void GetBuckets(const SortItem *si, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const;
 };
 
 } // End of namespace Ultima8
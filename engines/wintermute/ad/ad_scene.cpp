@@ -571,7 +571,10 @@ bool AdScene::initLoop() {
 
 //////////////////////////////////////////////////////////////////////////
 bool AdScene::loadFile(const char *filename) {
-	char *buffer = (char *)BaseFileManager::getEngineInstance()->readWholeFile(filename);
+	BaseFileManager *fileManager = BaseFileManager::getEngineInstance();
+	fileManager->resetFileStats();
+
+	char *buffer = (char *)fileManager->readWholeFile(filename);
 	if (buffer == nullptr) {
 		_gameRef->LOG(0, "AdScene::LoadFile failed for file '%s'", filename);
 		return STATUS_FAILED;
@@ -589,6 +592,8 @@ bool AdScene::loadFile(const char *filename) {
 
 	delete[] buffer;
 
+	debugC(kWintermuteDebugFileAccess, "Scene '%s' opened %d files, %d bytes", filename, fileManager->getNumFilesOpened(), fileManager->getNumBytesOpened());
+
 	return ret;
 }
 
@@ -59,6 +59,11 @@ BaseFileManager::BaseFileManager(Common::Language lang, bool detectionMode) {
 	_detectionMode = detectionMode;
 	_language = lang;
 	_resources = nullptr;
+	_numFilesOpened = 0;
+	_numBytesOpened = 0;
+	// Games open lots of small files from their packages, look them up
+	// in a single index rather than asking every package in turn
+	_packages.enableMemberIndex(true);
 	initResources();
 	initPaths();
 	registerPackages();
@@ -344,17 +349,13 @@ void BaseFileManager::initResources() {
 
 //////////////////////////////////////////////////////////////////////////
 Common::SeekableReadStream *BaseFileManager::openPkgFile(const Common::String &filename) {
-	Common::String upcName = filename;
-	upcName.toUppercase();
 	Common::SeekableReadStream *file = nullptr;
 
-	// correct slashes
-	for (uint32 i = 0; i < upcName.size(); i++) {
-		if (upcName[(int32)i] == '/') {
-			upcName.setChar('\\', (uint32)i);
-		}
-	}
-	Common::ArchiveMemberPtr entry = _packages.getMember(upcName);
+	// correct slashes, the package lookups ignore the case
+	Common::String backwardSlashesPath = filename;
+	Common::replace(backwardSlashesPath.begin(), backwardSlashesPath.end(), '/', '\\');
+
+	Common::ArchiveMemberPtr entry = _packages.getMember(backwardSlashesPath);
 	if (!entry) {
 		return nullptr;
 	}
@@ -426,12 +427,22 @@ Common::SeekableReadStream *BaseFileManager::openFile(const Common::String &file
 	debugC(kWintermuteDebugFileAccess, "Open file %s", filename.c_str());
 
 	Common::SeekableReadStream *file = openFileRaw(filename);
+	if (file) {
+		_numFilesOpened++;
+		_numBytesOpened += file->size();
+	}
 	if (file && keepTrackOf) {
 		_openFiles.push_back(file);
 	}
 	return file;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void BaseFileManager::resetFileStats() {
+	_numFilesOpened = 0;
+	_numBytesOpened = 0;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 Common::WriteStream *BaseFileManager::openFileForWrite(const Common::String &filename) {
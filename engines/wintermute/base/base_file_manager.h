@@ -50,6 +50,11 @@ public:
 	byte *readWholeFile(const Common::String &filename, uint32 *size = nullptr, bool mustExist = true);
 	uint32 getPackageVersion(const Common::String &filename);
 
+	// Counters of the files opened through openFile, see resetFileStats
+	uint32 getNumFilesOpened() const { return _numFilesOpened; }
+	uint32 getNumBytesOpened() const { return _numBytesOpened; }
+	void resetFileStats();
+
 	BaseFileManager(Common::Language lang, bool detectionMode = false);
 	virtual ~BaseFileManager();
 	// Used only for detection
@@ -76,6 +81,8 @@ private:
 	Common::Language _language;
 	Common::Archive *_resources;
 	Common::HashMap<Common::String, uint32> _versions;
+	uint32 _numFilesOpened;
+	uint32 _numBytesOpened;
 
 	// This class is intentionally not a subclass of Base, as it needs to be used by
 	// the detector too, without launching the entire engine:
@@ -33,6 +33,8 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/platform_osystem.h"
+#include "engines/wintermute/wintermute.h"
+#include "common/debug.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -81,10 +83,51 @@ bool BaseSurfaceStorage::initLoop() {
 			}
 		}
 	}
+
+	if (_gameRef->_smartCache) {
+		enforceBudget();
+	}
 	return STATUS_OK;
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::enforceBudget() {
+	uint32 residentSize = 0;
+	for (uint32 i = 0; i < _surfaces.size(); i++) {
+		residentSize += _surfaces[i]->getResidentSize();
+	}
+
+	uint32 evictedCount = 0;
+	if (residentSize > kMaxResidentSize) {
+		uint32 now = _gameRef->getLiveTimer()->getTime();
+
+		Common::Array<BaseSurface *> candidates;
+		for (uint32 i = 0; i < _surfaces.size(); i++) {
+			BaseSurface *surface = _surfaces[i];
+			if (surface->_valid && !surface->isKeptLoaded() && now - surface->_lastUsedTime >= kMinIdleTime) {
+				candidates.push_back(surface);
+			}
+		}
+		Common::sort(candidates.begin(), candidates.end(), surfaceLastUsedCB);
+
+		for (uint32 i = 0; i < candidates.size() && residentSize > kMaxResidentSize; i++) {
+			uint32 size = candidates[i]->getResidentSize();
+			if (DID_SUCCEED(candidates[i]->invalidate())) {
+				residentSize -= size;
+				evictedCount++;
+			}
+		}
+
+		if (evictedCount) {
+			debugC(1, kWintermuteDebugGeneral, "BaseSurfaceStorage: unloaded %d surfaces to stay in the budget", evictedCount);
+		}
+	}
+
+	debugC(5, kWintermuteDebugGeneral, "BaseSurfaceStorage: %d surfaces, %d KB resident", _surfaces.size(), residentSize / 1024);
+}
+
+
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
 	for (uint32 i = 0; i < _surfaces.size(); i++) {
@@ -203,4 +246,10 @@ bool BaseSurfaceStorage::surfaceSortCB(const BaseSurface *s1, const BaseSurface
 	}
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceStorage::surfaceLastUsedCB(const BaseSurface *s1, const BaseSurface *s2) {
+	return s1->_lastUsedTime < s2->_lastUsedTime;
+}
+
 } // End of namespace Wintermute
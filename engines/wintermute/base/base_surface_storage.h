@@ -46,10 +46,23 @@ public:
 	bool restoreAll();
 	BaseSurface *addSurface(const Common::String &filename, bool defaultCK = true, byte ckRed = 0, byte ckGreen = 0, byte ckBlue = 0, int lifeTime = -1, bool keepLoaded = false);
 	bool removeSurface(BaseSurface *surface);
+	/**
+	 * Unload the least recently used surfaces while the decoded surfaces
+	 * use more than kMaxResidentSize. The surfaces used recently, as the
+	 * ones of the current scene are, and the ones kept loaded stay resident.
+	 */
+	void enforceBudget();
 	BaseSurfaceStorage(BaseGame *inGame);
 	~BaseSurfaceStorage() override;
 
 	Common::Array<BaseSurface *> _surfaces;
+
+private:
+	static const uint32 kMaxResidentSize = 128 * 1024 * 1024;
+	// Surfaces used more recently than this, in ms, are never unloaded by the budget
+	static const uint32 kMinIdleTime = 2000;
+
+	static bool surfaceLastUsedCB(const BaseSurface *s1, const BaseSurface *s2);
 };
 
 } // End of namespace Wintermute
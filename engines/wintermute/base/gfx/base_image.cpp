@@ -78,6 +78,15 @@ bool BaseImage::loadFile(const Common::String &filename) {
 		return false;
 	}
 
+	// Decode straight to the screen format, which the surfaces convert to
+	const Graphics::PixelFormat screenFormat = g_system->getScreenFormat();
+	if (screenFormat.bytesPerPixel == 4) {
+		if (_filename.hasSuffix(".png"))
+			((Image::PNGDecoder *)_decoder)->setOutputPixelFormat(screenFormat);
+		else if (_filename.hasSuffix(".jpg"))
+			((Image::JPEGDecoder *)_decoder)->setOutputPixelFormat(screenFormat);
+	}
+
 	_decoder->loadStream(*file);
 	_surface = _decoder->getSurface();
 	_palette = _decoder->getPalette();
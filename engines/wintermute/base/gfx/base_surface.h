@@ -79,6 +79,13 @@ public:
 	virtual int getHeight() {
 		return _height;
 	}
+	/** The memory used by the decoded pixels, 0 when the surface is not loaded */
+	uint32 getResidentSize() const {
+		return _valid ? _width * _height * 4 : 0;
+	}
+	bool isKeptLoaded() const {
+		return _keepLoaded;
+	}
 	Common::String getFileNameStr() { return _filename; }
 	const char* getFileName() { return _filename.c_str(); }
 	//void SetWidth(int Width) { _width = Width;    }
@@ -127,8 +127,12 @@ bool MeshXOpenGLShader::renderFlatShadowModel() {
 bool MeshXOpenGLShader::update(FrameNode *parentFrame) {
 	MeshX::update(parentFrame);
 
-	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * kVertexComponentCount * _vertexCount, _vertexData);
+	// The vertices are only uploaded again when the pose changes
+	if (_poseChanged) {
+		glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * kVertexComponentCount * _vertexCount, _vertexData);
+		_poseChanged = false;
+	}
 
 	return true;
 }
@@ -420,38 +420,63 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
+
+	// Find the tickets that completely hide what is below them in the dirty rect.
+	// Typical use-cases: Fullscreen FMVs, and the opaque backgrounds of the scenes.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+	Common::Array<RenderTicket *> tickets;
+	Common::Array<uint> opaqueTickets;
+	uint firstVisible = 0;
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		RenderTicket *ticket = *it;
+		if (ticket->_dstRect.intersects(*_dirtyRect) && ticket->isOpaque()) {
+			if (ticket->_dstRect.contains(*_dirtyRect)) {
+				// Nothing drawn before this ticket can be seen
+				firstVisible = tickets.size();
+				opaqueTickets.clear();
+			}
+			opaqueTickets.push_back(tickets.size());
 		}
-		// Otherwise Do NOT fill.
-	} else {
+		tickets.push_back(ticket);
+	}
+
+	if (opaqueTickets.empty() || opaqueTickets.front() != firstVisible || !tickets[firstVisible]->_dstRect.contains(*_dirtyRect)) {
 		// Apply the clear-color to the dirty rect.
 		_renderSurface->fillRect(*_dirtyRect, _clearColor);
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+	// Otherwise Do NOT fill.
+
+	uint nextOpaque = 0;
+	for (uint i = 0; i < tickets.size(); ++i) {
+		RenderTicket *ticket = tickets[i];
+		if (nextOpaque < opaqueTickets.size() && opaqueTickets[nextOpaque] <= i) {
+			nextOpaque++;
+		}
+
+		if (i >= firstVisible && ticket->_dstRect.intersects(*_dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
 			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+
+			// Skip the tickets hidden by an opaque ticket drawn after them
+			bool hidden = false;
+			for (uint j = nextOpaque; j < opaqueTickets.size() && !hidden; ++j) {
+				hidden = tickets[opaqueTickets[j]]->_dstRect.contains(dstClip);
+			}
+
+			if (!hidden) {
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
 		ticket->_wantsDraw = false;
@@ -50,6 +50,7 @@ BaseSurfaceOSystem::BaseSurfaceOSystem(BaseGame *inGame) : BaseSurface(inGame) {
 	_lockPixels = nullptr;
 	_lockPitch = 0;
 	_loaded = false;
+	_restorable = false;
 	_rotation = 0;
 }
 
@@ -64,7 +65,9 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	delete[] _alphaMask;
 	_alphaMask = nullptr;
 
-	_gameRef->addMem(-_width * _height * 4);
+	if (_valid) {
+		_gameRef->addMem(-_width * _height * 4);
+	}
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 }
@@ -182,6 +185,7 @@ bool BaseSurfaceOSystem::finishLoad() {
 
 	_alphaType = hasTransparencyType(_surface);
 	_valid = true;
+	_restorable = true;
 
 	_gameRef->addMem(_width * _height * 4);
 
@@ -301,6 +305,28 @@ bool BaseSurfaceOSystem::create(int width, int height) {
 	_gameRef->addMem(_width * _height * 4);
 
 	_valid = true;
+	_restorable = false;
+
+	return STATUS_OK;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::invalidate() {
+	// Only the surfaces loaded from a file can be loaded again on their next use
+	if (!_valid || !_restorable) {
+		return STATUS_FAILED;
+	}
+
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
+	_surface->free();
+	delete[] _alphaMask;
+	_alphaMask = nullptr;
+
+	_gameRef->addMem(-_width * _height * 4);
+	_valid = false;
+	_loaded = false;
 
 	return STATUS_OK;
 }
@@ -312,6 +338,10 @@ bool BaseSurfaceOSystem::isTransparentAt(int x, int y) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::isTransparentAtLite(int x, int y) {
+	if (!_loaded) {
+		finishLoad();
+	}
+
 	if (x < 0 || x >= _surface->w || y < 0 || y >= _surface->h) {
 		return true;
 	}
@@ -463,6 +493,7 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
 	_loaded = true;
+	_restorable = false;
 	if (surface.format == _surface->format && surface.pitch == _surface->pitch && surface.h == _surface->h) {
 		const byte *src = (const byte *)surface.getBasePtr(0, 0);
 		byte *dst = (byte *)_surface->getBasePtr(0, 0);
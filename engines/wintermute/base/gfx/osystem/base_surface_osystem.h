@@ -44,6 +44,7 @@ public:
 
 	bool create(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime = -1, bool keepLoaded = false) override;
 	bool create(int width, int height) override;
+	bool invalidate() override;
 
 	bool isTransparentAt(int x, int y) override;
 	bool isTransparentAtLite(int x, int y) override;
@@ -97,6 +98,8 @@ public:
 private:
 	Graphics::Surface *_surface;
 	bool _loaded;
+	// Whether the pixels are the ones of _filename, and can be loaded again
+	bool _restorable;
 	bool finishLoad();
 	bool drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect, Graphics::TransformStruct transformStruct);
 	void genAlphaMask(Graphics::Surface *surface);
@@ -101,6 +101,20 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 }
 
 // Replacement for SDL2's SDL_RenderCopy
+bool RenderTicket::isOpaque() const {
+	// Without an owner, the surface is blitted with its default alpha mode
+	if (!_owner || !_surface) {
+		return false;
+	}
+	if (_transform._angle != Graphics::kDefaultAngle || _transform._blendMode != Graphics::BLEND_NORMAL || _transform._rgbaMod != Graphics::kDefaultRgbaMod) {
+		return false;
+	}
+	if (_surface->w * _transform._numTimesX != _dstRect.width() || _surface->h * _transform._numTimesY != _dstRect.height()) {
+		return false;
+	}
+	return _transform._alphaDisable || _owner->getAlphaType() == Graphics::ALPHA_OPAQUE;
+}
+
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
 
@@ -55,6 +55,8 @@ public:
 	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
 	~RenderTicket();
 	const Graphics::Surface *getSurface() const { return _surface; }
+	/** Whether drawing the ticket overwrites every pixel of its destination rect */
+	bool isOpaque() const;
 	// Non-dirty-rects:
 	void drawToSurface(Graphics::Surface *_targetSurface) const;
 	// Dirty-rects:
@@ -34,6 +34,8 @@
 #include "engines/wintermute/base/gfx/x/modelx.h"
 #include "engines/wintermute/math/math_util.h"
 
+#include "common/profiler.h"
+
 namespace Wintermute {
 
 // define constant to make it available to the linker
@@ -42,7 +44,8 @@ const uint32 MeshX::kNullIndex;
 MeshX::MeshX(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame),
 	_BBoxStart(0.0f, 0.0f, 0.0f), _BBoxEnd(0.0f, 0.0f, 0.0f),
 	_vertexData(nullptr), _vertexPositionData(nullptr), _vertexNormalData(nullptr),
-	_vertexCount(0), _numAttrs(0), _skinnedMesh(false) {
+	_vertexCount(0), _numAttrs(0), _skinnedMesh(false), _poseChanged(true),
+	_shadowEdgeCount(0), _shadowEdgesValid(false) {
 }
 
 MeshX::~MeshX() {
@@ -217,6 +220,8 @@ bool MeshX::update(FrameNode *parentFrame) {
 		return false;
 	}
 
+	PROFILE_SCOPE("wintermute.skinning");
+
 	// update skinned mesh
 	if (_skinnedMesh) {
 		BaseArray<Math::Matrix4> finalBoneMatrices;
@@ -226,6 +231,10 @@ bool MeshX::update(FrameNode *parentFrame) {
 			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
 		}
 
+		if (!updatePose(finalBoneMatrices)) {
+			return true;
+		}
+
 		// the new vertex coordinates are the weighted sum of the product
 		// of the combined bone transformation matrices and the static pose coordinates
 		// to be able too add the weighted summands together, we reset everything to zero first
@@ -282,6 +291,12 @@ bool MeshX::update(FrameNode *parentFrame) {
 
 //		updateNormals();
 	} else { // update static
+		BaseArray<Math::Matrix4> pose;
+		pose.push_back(*parentFrame->getCombinedMatrix());
+		if (!updatePose(pose)) {
+			return true;
+		}
+
 		for (uint32 i = 0; i < _vertexCount; ++i) {
 			Math::Vector3d pos(_vertexPositionData + 3 * i);
 			parentFrame->getCombinedMatrix()->transform(&pos, true);
@@ -297,6 +312,21 @@ bool MeshX::update(FrameNode *parentFrame) {
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool MeshX::updatePose(const BaseArray<Math::Matrix4> &matrices) {
+	_poseChanged = matrices.size() != _poseMatrices.size();
+	for (uint i = 0; i < matrices.size() && !_poseChanged; ++i) {
+		_poseChanged = !(matrices[i] == _poseMatrices[i]);
+	}
+
+	if (_poseChanged) {
+		_poseMatrices = matrices;
+		_shadowEdgesValid = false;
+	}
+
+	return _poseChanged;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool MeshX::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const Math::Vector3d &light, float extrusionDepth) {
 	if (_vertexData == nullptr) {
@@ -308,9 +338,39 @@ bool MeshX::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const
 	matInverseModel.inverse();
 	matInverseModel.transform(&invLight, false);
 
+	PROFILE_SCOPE("wintermute.shadowVolume");
+
+	if (!_shadowEdgesValid || !(invLight == _shadowLight)) {
+		findSilhouetteEdges(invLight);
+	}
+
+	const Common::Array<uint16> &edges = _shadowEdges;
+	uint32 numEdges = _shadowEdgeCount;
+
+	for (uint32 i = 0; i < numEdges; i++) {
+		Math::Vector3d v1(_vertexData + edges[2 * i + 0] * kVertexComponentCount + kPositionOffset);
+		Math::Vector3d v2(_vertexData + edges[2 * i + 1] * kVertexComponentCount + kPositionOffset);
+		Math::Vector3d v3 = v1 - invLight * extrusionDepth;
+		Math::Vector3d v4 = v2 - invLight * extrusionDepth;
+
+		// Add a quad (two triangles) to the vertex list
+		shadow->addVertex(v1);
+		shadow->addVertex(v2);
+		shadow->addVertex(v3);
+		shadow->addVertex(v2);
+		shadow->addVertex(v4);
+		shadow->addVertex(v3);
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MeshX::findSilhouetteEdges(const Math::Vector3d &light) {
 	uint32 numEdges = 0;
 
-	Common::Array<bool> isFront(_indexData.size() / 3, false);
+	Common::Array<bool> &isFront = _shadowFrontFaces;
+	isFront.resize(_indexData.size() / 3);
 
 	// First pass : for each face, record if it is front or back facing the light
 	for (uint32 i = 0; i < _indexData.size() / 3; i++) {
@@ -325,15 +385,16 @@ bool MeshX::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const
 		// Transform vertices or transform light?
 		Math::Vector3d vNormal = Math::Vector3d::crossProduct(v2 - v1, v1 - v0);
 
-		if (Math::Vector3d::dotProduct(vNormal, invLight) >= 0.0f) {
+		if (Math::Vector3d::dotProduct(vNormal, light) >= 0.0f) {
 			isFront[i] = false; // back face
 		} else {
 			isFront[i] = true; // front face
 		}
 	}
 
-	// Allocate a temporary edge list
-	Common::Array<uint16> edges(_indexData.size() * 2, 0);
+	// The edge list is kept for the next frames
+	Common::Array<uint16> &edges = _shadowEdges;
+	edges.resize(_indexData.size() * 2);
 
 	// First pass : for each face, record if it is front or back facing the light
 	for (uint32 i = 0; i < _indexData.size() / 3; i++) {
@@ -367,22 +428,9 @@ bool MeshX::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const
 		}
 	}
 
-	for (uint32 i = 0; i < numEdges; i++) {
-		Math::Vector3d v1(_vertexData + edges[2 * i + 0] * kVertexComponentCount + kPositionOffset);
-		Math::Vector3d v2(_vertexData + edges[2 * i + 1] * kVertexComponentCount + kPositionOffset);
-		Math::Vector3d v3 = v1 - invLight * extrusionDepth;
-		Math::Vector3d v4 = v2 - invLight * extrusionDepth;
-
-		// Add a quad (two triangles) to the vertex list
-		shadow->addVertex(v1);
-		shadow->addVertex(v2);
-		shadow->addVertex(v3);
-		shadow->addVertex(v2);
-		shadow->addVertex(v4);
-		shadow->addVertex(v3);
-	}
-
-	return true;
+	_shadowEdgeCount = numEdges;
+	_shadowLight = light;
+	_shadowEdgesValid = true;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -452,6 +500,9 @@ bool MeshX::restoreDeviceObjects() {
 		_materials[i]->restoreDeviceObjects();
 	}
 
+	// Transform and upload the vertices again on the next update
+	_poseMatrices.clear();
+
 	if (_skinnedMesh) {
 		return generateAdjacency();
 	} else {
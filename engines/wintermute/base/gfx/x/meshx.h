@@ -94,6 +94,14 @@ protected:
 
 	void updateBoundingBox();
 
+	/**
+	 * Remember the matrices of the new pose.
+	 * Returns false if they are the ones of the last update.
+	 */
+	bool updatePose(const BaseArray<Math::Matrix4> &matrices);
+	/** Find the edges between the faces facing the light and the others, in model space */
+	void findSilhouetteEdges(const Math::Vector3d &light);
+
 	bool generateAdjacency();
 	bool adjacentEdge(uint16 index1, uint16 index2, uint16 index3, uint16 index4);
 
@@ -117,6 +125,20 @@ protected:
 	// we will only store, whether this mesh is skinned at all
 	// and factor out the necessary computations into some functions
 	bool _skinnedMesh;
+
+	// The matrices the vertices were last transformed with, the vertices
+	// are only transformed again when they change
+	BaseArray<Math::Matrix4> _poseMatrices;
+	// Whether the last update changed the vertices
+	bool _poseChanged;
+
+	// The silhouette edges of the last shadow volume, reused as long
+	// as neither the pose nor the light direction change
+	Common::Array<bool> _shadowFrontFaces;
+	Common::Array<uint16> _shadowEdges;
+	uint32 _shadowEdgeCount;
+	Math::Vector3d _shadowLight;
+	bool _shadowEdgesValid;
 };
 
 } // namespace Wintermute
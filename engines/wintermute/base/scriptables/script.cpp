@@ -57,6 +57,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_currentLine = 0;
 
 	_symbols = nullptr;
+	_symbolNames.clear();
 	_numSymbols = 0;
 
 	_engine = engine;
@@ -184,9 +185,11 @@ bool ScScript::initTables() {
 
 	_numSymbols = getDWORD();
 	_symbols = new char*[_numSymbols];
+	_symbolNames.resize(_numSymbols);
 	for (uint32 i = 0; i < _numSymbols; i++) {
 		uint32 index = getDWORD();
 		_symbols[index] = getString();
+		_symbolNames[index] = _symbols[index];
 	}
 
 	// load functions table
@@ -409,6 +412,7 @@ void ScScript::cleanup() {
 		delete[] _symbols;
 	}
 	_symbols = nullptr;
+	_symbolNames.clear();
 	_numSymbols = 0;
 
 	if (_globals && !_thread) {
@@ -755,7 +759,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(_symbolNames[getDWORD()]);
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -766,15 +770,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(_symbolNames[getDWORD()]);
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(_symbolNames[getDWORD()]);
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -827,7 +830,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(_symbolNames[getDWORD()]));
 		_thisStack->push(_operand);
 		break;
 
@@ -1186,40 +1189,40 @@ uint32 ScScript::getMethodPos(const Common::String &name) const {
 
 //////////////////////////////////////////////////////////////////////////
 ScValue *ScScript::getVar(char *name) {
+	return getVar(Common::String(name));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVar(const Common::String &name) {
 	ScValue *ret = nullptr;
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
-		}
+		ret = _scopeStack->getTop()->findProp(name);
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
-		}
+		ret = _globals->findProp(name);
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
-		}
+		ret = _engine->_globals->findProp(name);
 	}
 
 	if (ret == nullptr) {
 		//RuntimeError("Variable '%s' is inaccessible in the current block. Consider changing the script.", name);
-		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name, _filename, _currentLine);
+		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name.c_str(), _filename, _currentLine);
 		ScValue *val = new ScValue(_gameRef);
 		ScValue *scope = _scopeStack->getTop();
 		if (scope) {
-			scope->setProp(name, val);
-			ret = _scopeStack->getTop()->getProp(name);
+			scope->setProp(name.c_str(), val);
+			ret = _scopeStack->getTop()->getProp(name.c_str());
 		} else {
-			_globals->setProp(name, val);
-			ret = _globals->getProp(name);
+			_globals->setProp(name.c_str(), val);
+			ret = _globals->getProp(name.c_str());
 		}
 		delete val;
 	}
@@ -40,7 +40,7 @@ namespace Wintermute {
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-IMPLEMENT_PERSISTENT(ScValue, false)
+IMPLEMENT_PERSISTENT_POOLED(ScValue, false)
 
 //////////////////////////////////////////////////////////////////////////
 ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
@@ -270,6 +270,20 @@ bool ScValue::propExists(const char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::findProp(const Common::String &name) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->findProp(name);
+	}
+	if (_type == VAL_NATIVE) {
+		return propExists(name.c_str()) ? getProp(name.c_str()) : nullptr;
+	}
+
+	_valIter = _valObject.find(name);
+	return _valIter != _valObject.end() ? _valIter->_value : nullptr;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 void ScValue::deleteProps() {
 	_valIter = _valObject.begin();
@@ -53,6 +53,11 @@ public:
 	void setValue(ScValue *val);
 	bool _persistent;
 	bool propExists(const char *name);
+	/**
+	 * Same as propExists(name) ? getProp(name) : nullptr, with a single lookup
+	 * in the properties of script objects.
+	 */
+	ScValue *findProp(const Common::String &name);
 	void copy(ScValue *orig, bool copyWhole = false);
 	void setStringVal(const char *val);
 	TValType getType();
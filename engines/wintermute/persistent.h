@@ -40,6 +40,7 @@ typedef void(*SYS_INSTANCE_CALLBACK)(void *instance, void *data);
 } // End of namespace Wintermute
 
 #include "engines/wintermute/system/sys_class_registry.h"
+#include "common/memorypool.h"
 namespace Wintermute {
 
 
@@ -54,11 +55,8 @@ namespace Wintermute {
 	void operator delete(void* p);\
 
 
-#define IMPLEMENT_PERSISTENT(className, persistentClass)\
+#define IMPLEMENT_PERSISTENT_COMMON(className)\
 	const char className::_className[] = #className;\
-	void* className::persistBuild() {\
-		return ::new className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
-	}\
 	\
 	bool className::persistLoad(void *instance, BasePersistenceManager *persistMgr) {\
 		return ((className*)instance)->persist(persistMgr);\
@@ -69,6 +67,13 @@ namespace Wintermute {
 	}\
 	\
 	/*SystemClass Register##class_name(class_name::_className, class_name::PersistBuild, class_name::PersistLoad, persistent_class);*/\
+
+#define IMPLEMENT_PERSISTENT(className, persistentClass)\
+	IMPLEMENT_PERSISTENT_COMMON(className)\
+	\
+	void* className::persistBuild() {\
+		return ::new className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
+	}\
 	\
 	void* className::operator new(size_t size) {\
 		void* ret = ::operator new(size);\
@@ -81,6 +86,36 @@ namespace Wintermute {
 		::operator delete(p);\
 	}\
 
+// Same as IMPLEMENT_PERSISTENT, for classes which are created and destroyed
+// all the time: freed instances go back to a free list, and are reused
+// by the next ones.
+#define IMPLEMENT_PERSISTENT_POOLED(className, persistentClass)\
+	IMPLEMENT_PERSISTENT_COMMON(className)\
+	\
+	static Common::MemoryPool &className##Pool() {\
+		static Common::MemoryPool pool(sizeof(className));\
+		return pool;\
+	}\
+	\
+	void* className::persistBuild() {\
+		return ::new (className##Pool()) className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
+	}\
+	\
+	void* className::operator new(size_t size) {\
+		assert(size == sizeof(className));\
+		void* ret = className##Pool().allocChunk();\
+		SystemClassRegistry::getInstance()->registerInstance(#className, ret);\
+		return ret;\
+	}\
+	\
+	void className::operator delete(void *p) {\
+		if (!p) {\
+			return;\
+		}\
+		SystemClassRegistry::getInstance()->unregisterInstance(#className, p);\
+		className##Pool().freeChunk(p);\
+	}\
+
 #define TMEMBER(memberName) #memberName, &memberName
 #define TMEMBER_PTR(memberName) #memberName, &memberName
 #define TMEMBER_INT(memberName) #memberName, (int32*)&memberName
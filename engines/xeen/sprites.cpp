@@ -273,15 +273,15 @@ void SpriteDrawer::draw(XSurface &dest, uint16 offset, const Common::Point &pt,
 			f.skip(lineLength);
 			destPos.y++;
 		} else {
-			scaleMaskX = scaleMaskXCopy;
 			xOffset = f.readByte();
 
 			// Initialize the array to hold the temporary data for the line. We do this to make it simpler
 			// to handle both deciding which pixels to draw in a scaled image, as well as when images
 			// have been horizontally flipped. Note that we allocate an extra line for before and after our
 			// work line, just in case the sprite is screwed up and overruns the line
+			// Only the part of the work line holding the sprite line gets drawn, so only that gets cleared
 			int tempLine[SCREEN_WIDTH * 3];
-			Common::fill(&tempLine[SCREEN_WIDTH], &tempLine[SCREEN_WIDTH * 3], -1);
+			Common::fill(&tempLine[SCREEN_WIDTH], &tempLine[SCREEN_WIDTH + MIN(width, SCREEN_WIDTH * 2)], -1);
 			int *lineP = flipped ? &tempLine[SCREEN_WIDTH + width - 1 - xOffset] : &tempLine[SCREEN_WIDTH + xOffset];
 
 			// Build up the line
@@ -370,35 +370,8 @@ void SpriteDrawer::draw(XSurface &dest, uint16 offset, const Common::Point &pt,
 				(flags & SPRFLAG_SCENE_CLIPPED) ? SCENE_CLIP_LEFT : clipRect.left, destPos.y);
 			_destRight = (byte *)dest.getBasePtr(
 				(flags & SPRFLAG_SCENE_CLIPPED) ? SCENE_CLIP_RIGHT : clipRect.right, destPos.y);
-			int16 xp = destPos.x;
-			lineP = &tempLine[SCREEN_WIDTH];
-
-			for (int xCtr = 0; xCtr < width; ++xCtr, ++lineP) {
-				bit = (scaleMaskX >> 15) & 1;
-				scaleMaskX = ((scaleMaskX & 0x7fff) << 1) + bit;
-
-				if (bit) {
-					// Check whether there's a pixel to write, and we're within the allowable bounds. Note that for
-					// the SPRFLAG_SCENE_CLIPPED or when enlarging, we also have an extra horizontal bounds check
-					if (*lineP != -1 && xp >= bounds.left && xp < bounds.right) {
-						drawBounds.left = MIN(drawBounds.left, xp);
-						drawBounds.right = MAX((int)drawBounds.right, xp + 1);
-						drawPixel(destP, (byte)*lineP);
-						if (enlarge) {
-							drawPixel(destP + SCREEN_WIDTH, (byte)*lineP);
-							drawPixel(destP + 1, (byte)*lineP);
-							drawPixel(destP + 1 + SCREEN_WIDTH, (byte)*lineP);
-						}
-					}
-
-					++xp;
-					++destP;
-					if (enlarge) {
-						++destP;
-						++xp;
-					}
-				}
-			}
+			drawLine(destP, &tempLine[SCREEN_WIDTH], MIN(width, SCREEN_WIDTH * 2), destPos.x, scaleMaskXCopy,
+				bounds, enlarge, drawBounds);
 
 			++destPos.y;
 			if (enlarge)
@@ -427,8 +400,61 @@ uint SpriteDrawer::getScaledVal(int xy, uint16 &scaleMask) {
 	return result;
 }
 
-void SpriteDrawer::drawPixel(byte *dest, byte pixel) {
-	*dest = pixel;
+void SpriteDrawer::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+template<class DRAWER>
+void SpriteDrawer::drawLinePixels(DRAWER &drawer, byte *destP, const int *lineP, int width, int16 xp,
+		uint16 scaleMask, const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	if (scaleMask == 0xFFFF && !enlarge) {
+		// Unscaled lines are drawn by runs of set pixels, within the bounds
+		int xStart = MAX(bounds.left - xp, 0);
+		int xEnd = MIN(bounds.right - xp, width);
+
+		for (int xCtr = xStart; xCtr < xEnd; ) {
+			while (xCtr < xEnd && lineP[xCtr] == -1)
+				++xCtr;
+
+			int runStart = xCtr;
+			for (; xCtr < xEnd && lineP[xCtr] != -1; ++xCtr)
+				drawer.drawPixel(destP + xCtr, (byte)lineP[xCtr]);
+
+			if (xCtr > runStart) {
+				drawBounds.left = MIN((int)drawBounds.left, xp + runStart);
+				drawBounds.right = MAX((int)drawBounds.right, xp + xCtr);
+			}
+		}
+		return;
+	}
+
+	for (int xCtr = 0; xCtr < width; ++xCtr, ++lineP) {
+		uint bit = (scaleMask >> 15) & 1;
+		scaleMask = ((scaleMask & 0x7fff) << 1) + bit;
+
+		if (bit) {
+			// Check whether there's a pixel to write, and we're within the allowable bounds. Note that for
+			// the SPRFLAG_SCENE_CLIPPED or when enlarging, we also have an extra horizontal bounds check
+			if (*lineP != -1 && xp >= bounds.left && xp < bounds.right) {
+				drawBounds.left = MIN(drawBounds.left, xp);
+				drawBounds.right = MAX((int)drawBounds.right, xp + 1);
+				drawer.drawPixel(destP, (byte)*lineP);
+				if (enlarge) {
+					drawer.drawPixel(destP + SCREEN_WIDTH, (byte)*lineP);
+					drawer.drawPixel(destP + 1, (byte)*lineP);
+					drawer.drawPixel(destP + 1 + SCREEN_WIDTH, (byte)*lineP);
+				}
+			}
+
+			++xp;
+			++destP;
+			if (enlarge) {
+				++destP;
+				++xp;
+			}
+		}
+	}
 }
 
 void SpriteDrawer::rcr(uint16 &val, bool &cf) {
@@ -454,7 +480,12 @@ SpriteDrawer1::SpriteDrawer1(byte *data, size_t filesize, int index) : SpriteDra
 	_mask = DRAWER1_MASK[index];
 }
 
-void SpriteDrawer1::drawPixel(byte *dest, byte pixel) {
+void SpriteDrawer1::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+inline void SpriteDrawer1::drawPixel(byte *dest, byte pixel) {
 	*dest = (pixel & _mask) + _offset;
 }
 
@@ -489,7 +520,12 @@ SpriteDrawer2::SpriteDrawer2(byte *data, size_t filesize, int index) : SpriteDra
 	_random2 = g_vm->getRandomNumber(0xffff);
 }
 
-void SpriteDrawer2::drawPixel(byte *dest, byte pixel) {
+void SpriteDrawer2::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+inline void SpriteDrawer2::drawPixel(byte *dest, byte pixel) {
 	bool flag = (_random1 & 0x8000) != 0;
 	_random1 = (int)((uint16)_random1 << 1) - _random2 - (flag ? 1 : 0);
 
@@ -522,7 +558,12 @@ SpriteDrawer3::SpriteDrawer3(byte *data, size_t filesize, int index) : SpriteDra
 		_hasPalette = *pal != 0;
 }
 
-void SpriteDrawer3::drawPixel(byte *dest, byte pixel) {
+void SpriteDrawer3::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+inline void SpriteDrawer3::drawPixel(byte *dest, byte pixel) {
 	// WORKAROUND: This is slightly different then the original:
 	// 1) The original has bunches of black pixels appearing. This does index increments to avoid such pixels
 	// 2) It also prevents any pixels being drawn in the single initial frame until the palette is set
@@ -551,7 +592,12 @@ SpriteDrawer4::SpriteDrawer4(byte *data, size_t filesize, int index) : SpriteDra
 	_threshold = DRAWER4_THRESHOLD[index];
 }
 
-void SpriteDrawer4::drawPixel(byte *dest, byte pixel) {
+void SpriteDrawer4::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+inline void SpriteDrawer4::drawPixel(byte *dest, byte pixel) {
 	if ((pixel & 0xf) >= _threshold)
 		*dest = pixel;
 }
@@ -566,7 +612,12 @@ SpriteDrawer5::SpriteDrawer5(byte *data, size_t filesize, int index) : SpriteDra
 	_random2 = g_vm->getRandomNumber(0xffff);
 }
 
-void SpriteDrawer5::drawPixel(byte *dest, byte pixel) {
+void SpriteDrawer5::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+inline void SpriteDrawer5::drawPixel(byte *dest, byte pixel) {
 	bool flag = (_random1 & 0x8000) != 0;
 	_random1 = (int)((uint16)_random1 << 1) - _random2 - (flag ? 1 : 0);
 
@@ -586,7 +637,12 @@ SpriteDrawer6::SpriteDrawer6(byte *data, size_t filesize, int index) : SpriteDra
 	_mask = DRAWER6_MASK[index];
 }
 
-void SpriteDrawer6::drawPixel(byte *dest, byte pixel) {
+void SpriteDrawer6::drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) {
+	drawLinePixels(*this, destP, lineP, width, xp, scaleMask, bounds, enlarge, drawBounds);
+}
+
+inline void SpriteDrawer6::drawPixel(byte *dest, byte pixel) {
 	*dest = pixel ^ _mask;
 }
 
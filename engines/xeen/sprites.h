@@ -203,7 +203,20 @@ protected:
 	/**
 	 * Output a pixel
 	 */
-	virtual void drawPixel(byte *dest, byte pixel);
+	void drawPixel(byte *dest, byte pixel) {
+		*dest = pixel;
+	}
+
+	/**
+	 * Output the pixels of a decoded line. The drawers each instantiate
+	 * drawLinePixels, so that their pixel operation gets inlined
+	 */
+	virtual void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds);
+
+	template<class DRAWER>
+	static void drawLinePixels(DRAWER &drawer, byte *destP, const int *lineP, int width, int16 xp,
+		uint16 scaleMask, const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds);
 public:
 	/**
 	 * Constructor
@@ -226,10 +239,18 @@ class SpriteDrawer1 : public SpriteDrawer {
 private:
 	byte _offset, _mask;
 protected:
+	friend class SpriteDrawer;
+
 	/**
 	 * Output a pixel
 	 */
-	void drawPixel(byte *dest, byte pixel) override;
+	void drawPixel(byte *dest, byte pixel);
+
+	/**
+	 * Output the pixels of a decoded line
+	 */
+	void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) override;
 public:
 	/**
 	 * Constructor
@@ -246,10 +267,18 @@ private:
 	uint16 _mask1, _mask2;
 	uint16 _random1, _random2;
 private:
+	friend class SpriteDrawer;
+
 	/**
 	 * Output a pixel
 	 */
-	void drawPixel(byte *dest, byte pixel) override;
+	void drawPixel(byte *dest, byte pixel);
+
+	/**
+	 * Output the pixels of a decoded line
+	 */
+	void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) override;
 public:
 	/**
 	 * Constructor
@@ -266,10 +295,18 @@ private:
 	byte _palette[256 * 3];
 	bool _hasPalette;
 private:
+	friend class SpriteDrawer;
+
 	/**
 	 * Output a pixel
 	 */
-	void drawPixel(byte *dest, byte pixel) override;
+	void drawPixel(byte *dest, byte pixel);
+
+	/**
+	 * Output the pixels of a decoded line
+	 */
+	void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) override;
 public:
 	/**
 	 * Constructor
@@ -281,10 +318,18 @@ class SpriteDrawer4 : public SpriteDrawer {
 private:
 	byte _threshold;
 protected:
+	friend class SpriteDrawer;
+
 	/**
 	 * Output a pixel
 	 */
-	void drawPixel(byte *dest, byte pixel) override;
+	void drawPixel(byte *dest, byte pixel);
+
+	/**
+	 * Output the pixels of a decoded line
+	 */
+	void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) override;
 public:
 	/**
 	 * Constructor
@@ -299,10 +344,18 @@ class SpriteDrawer5 : public SpriteDrawer {
 private:
 	uint16 _threshold, _random1, _random2;
 protected:
+	friend class SpriteDrawer;
+
 	/**
 	 * Output a pixel
 	 */
-	void drawPixel(byte *dest, byte pixel) override;
+	void drawPixel(byte *dest, byte pixel);
+
+	/**
+	 * Output the pixels of a decoded line
+	 */
+	void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) override;
 public:
 	/**
 	 * Constructor
@@ -314,10 +367,18 @@ class SpriteDrawer6 : public SpriteDrawer {
 private:
 	byte _mask;
 protected:
+	friend class SpriteDrawer;
+
 	/**
 	 * Output a pixel
 	 */
-	void drawPixel(byte *dest, byte pixel) override;
+	void drawPixel(byte *dest, byte pixel);
+
+	/**
+	 * Output the pixels of a decoded line
+	 */
+	void drawLine(byte *destP, const int *lineP, int width, int16 xp, uint16 scaleMask,
+		const Common::Rect &bounds, bool enlarge, Common::Rect &drawBounds) override;
 public:
 	/**
 	 * Constructor
@@ -34,7 +34,9 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 	  _renderState(FLAT) {
 	assert(numRows != 0 && numColumns != 0);
 
-	_internalBuffer = new Common::Point[numRows * numColumns];
+	_internalBuffer = new uint32[numRows * numColumns];
+	for (uint32 i = 0; i < numRows * numColumns; ++i)
+		_internalBuffer[i] = i;
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -75,55 +77,48 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 		return Common::Point(x, y);
 	}
 
-	uint32 index = point.y * _numColumns + point.x;
-
-	Common::Point newPoint(point);
-	newPoint.x += _internalBuffer[index].x;
-	newPoint.y += _internalBuffer[index].y;
+	const uint32 offset = _internalBuffer[point.y * _numColumns + point.x];
+	return Common::Point(offset % _numColumns, offset / _numColumns);
+}
 
-	return newPoint;
+void RenderTable::mutateRow(const uint16 *sourceBuffer, uint16 *destBuffer, const uint32 *offsets, uint32 width) {
+	// The table holds the source offsets themselves, so each pixel is a
+	// single gather, and the table is read sequentially
+	uint32 x = 0;
+	for (; x + 4 <= width; x += 4) {
+		const uint16 p0 = sourceBuffer[offsets[x]];
+		const uint16 p1 = sourceBuffer[offsets[x + 1]];
+		const uint16 p2 = sourceBuffer[offsets[x + 2]];
+		const uint16 p3 = sourceBuffer[offsets[x + 3]];
+		destBuffer[x] = p0;
+		destBuffer[x + 1] = p1;
+		destBuffer[x + 2] = p2;
+		destBuffer[x + 3] = p3;
+	}
+	for (; x < width; ++x)
+		destBuffer[x] = sourceBuffer[offsets[x]];
 }
 
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
-	uint32 destOffset = 0;
-
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
-
-		destOffset += destWidth;
+		mutateRow(sourceBuffer, destBuffer, _internalBuffer + y * _numColumns + subRect.left, subRect.width());
+		destBuffer += destWidth;
 	}
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+	if (srcBuf->w == (int16)_numColumns) {
+		// The destination has the same layout, so the whole image is one run
+		mutateRow(sourceBuffer, destBuffer, _internalBuffer, srcBuf->w * srcBuf->h);
+		return;
+	}
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
-		}
+	for (int16 y = 0; y < srcBuf->h; ++y) {
+		mutateRow(sourceBuffer, destBuffer, _internalBuffer + y * _numColumns, srcBuf->w);
+		destBuffer += srcBuf->w;
 	}
 }
 
@@ -147,8 +142,7 @@ void RenderTable::generatePanoramaLookupTable() {
 	for (uint y = 0; y < _numRows; y++) {
 		for (uint x = 0; x < _numColumns; x++) {
 			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
+			_internalBuffer[index] = index;
 		}
 	}
 
@@ -176,9 +170,7 @@ void RenderTable::generatePanoramaLookupTable() {
 
 			uint32 index = y * _numColumns + x;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			_internalBuffer[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
@@ -211,9 +203,7 @@ void RenderTable::generateTiltLookupTable() {
 
 			uint32 index = columnIndex + x;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			_internalBuffer[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
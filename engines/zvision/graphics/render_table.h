@@ -42,7 +42,11 @@ public:
 
 private:
 	uint _numColumns, _numRows;
-	Common::Point *_internalBuffer;
+	/**
+	 * For each pixel of the warped image, the offset of the pixel of the
+	 * flat image it shows, i.e. y * _numColumns + x
+	 */
+	uint32 *_internalBuffer;
 	RenderState _renderState;
 
 	struct {
@@ -88,6 +92,7 @@ public:
 	float getLinscale();
 
 private:
+	void mutateRow(const uint16 *sourceBuffer, uint16 *destBuffer, const uint32 *offsets, uint32 width);
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
 };
@@ -25,6 +25,14 @@
 
 #include "common/endian.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONVERSION_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CONVERSION_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 // TODO: YUV to RGB conversion function
@@ -115,6 +123,191 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+#if defined(CONVERSION_USE_SSE2) || defined(CONVERSION_USE_NEON)
+
+// The vector code handles pixels as 32 bit lanes, four at a time. A channel
+// is extracted and expanded to 8 bits the same way colorToARGB() does it,
+// which is (v << (8 - bits)) | (v >> (2 * bits - 8)) for 4 to 8 bits.
+static bool isVectorChannel(int bits) {
+	return bits >= 4 && bits <= 8;
+}
+
+// Whether crossBlit() can use the vector code for the two formats
+static bool isVectorPair(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	if ((srcFmt.bytesPerPixel != 2 && srcFmt.bytesPerPixel != 4) || (dstFmt.bytesPerPixel != 2 && dstFmt.bytesPerPixel != 4))
+		return false;
+
+	return isVectorChannel(srcFmt.rBits()) && isVectorChannel(srcFmt.gBits()) && isVectorChannel(srcFmt.bBits())
+	    && (srcFmt.aBits() == 0 || isVectorChannel(srcFmt.aBits()));
+}
+
+#if defined(CONVERSION_USE_SSE2)
+typedef __m128i PixelVector;
+
+// The shift counts and masks of one channel
+struct ChannelVector {
+	void init(int srcShift, int srcBits, int dstChannelShift, int dstLoss) {
+		shift = _mm_cvtsi32_si128(srcShift);
+		mask = _mm_set1_epi32((1 << srcBits) - 1);
+		expandLeft = _mm_cvtsi32_si128(8 - srcBits);
+		expandRight = _mm_cvtsi32_si128(2 * srcBits - 8);
+		loss = _mm_cvtsi32_si128(dstLoss);
+		dstShift = _mm_cvtsi32_si128(dstChannelShift);
+	}
+
+	inline PixelVector convert(PixelVector pixels) const {
+		const __m128i value = _mm_and_si128(_mm_srl_epi32(pixels, shift), mask);
+		const __m128i expanded = _mm_or_si128(_mm_sll_epi32(value, expandLeft), _mm_srl_epi32(value, expandRight));
+		return _mm_sll_epi32(_mm_srl_epi32(expanded, loss), dstShift);
+	}
+
+	__m128i shift, mask, expandLeft, expandRight, loss, dstShift;
+};
+
+static inline PixelVector setPixels(uint32 value) { return _mm_set1_epi32(value); }
+static inline PixelVector orPixels(PixelVector a, PixelVector b) { return _mm_or_si128(a, b); }
+
+// Load eight pixels into two vectors
+static inline void loadPixels(const uint16 *src, PixelVector &lo, PixelVector &hi) {
+	const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+	lo = _mm_unpacklo_epi16(pixels, _mm_setzero_si128());
+	hi = _mm_unpackhi_epi16(pixels, _mm_setzero_si128());
+}
+
+static inline void loadPixels(const uint32 *src, PixelVector &lo, PixelVector &hi) {
+	lo = _mm_loadu_si128((const __m128i *)src);
+	hi = _mm_loadu_si128((const __m128i *)(src + 4));
+}
+
+static inline void storePixels(uint16 *dst, PixelVector lo, PixelVector hi) {
+	// Sign extend the lower halves, so that the saturation does not change them
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+}
+
+static inline void storePixels(uint32 *dst, PixelVector lo, PixelVector hi) {
+	_mm_storeu_si128((__m128i *)dst, lo);
+	_mm_storeu_si128((__m128i *)(dst + 4), hi);
+}
+#elif defined(CONVERSION_USE_NEON)
+typedef uint32x4_t PixelVector;
+
+// The shift counts and masks of one channel, negative counts shift right
+struct ChannelVector {
+	void init(int srcShift, int srcBits, int dstChannelShift, int dstLoss) {
+		shift = vdupq_n_s32(-srcShift);
+		mask = vdupq_n_u32((1 << srcBits) - 1);
+		expandLeft = vdupq_n_s32(8 - srcBits);
+		expandRight = vdupq_n_s32(8 - 2 * srcBits);
+		loss = vdupq_n_s32(-dstLoss);
+		dstShift = vdupq_n_s32(dstChannelShift);
+	}
+
+	inline PixelVector convert(PixelVector pixels) const {
+		const uint32x4_t value = vandq_u32(vshlq_u32(pixels, shift), mask);
+		const uint32x4_t expanded = vorrq_u32(vshlq_u32(value, expandLeft), vshlq_u32(value, expandRight));
+		return vshlq_u32(vshlq_u32(expanded, loss), dstShift);
+	}
+
+	int32x4_t shift;
+	uint32x4_t mask;
+	int32x4_t expandLeft, expandRight, loss, dstShift;
+};
+
+static inline PixelVector setPixels(uint32 value) { return vdupq_n_u32(value); }
+static inline PixelVector orPixels(PixelVector a, PixelVector b) { return vorrq_u32(a, b); }
+
+static inline void loadPixels(const uint16 *src, PixelVector &lo, PixelVector &hi) {
+	const uint16x8_t pixels = vld1q_u16(src);
+	lo = vmovl_u16(vget_low_u16(pixels));
+	hi = vmovl_u16(vget_high_u16(pixels));
+}
+
+static inline void loadPixels(const uint32 *src, PixelVector &lo, PixelVector &hi) {
+	lo = vld1q_u32(src);
+	hi = vld1q_u32(src + 4);
+}
+
+static inline void storePixels(uint16 *dst, PixelVector lo, PixelVector hi) {
+	vst1q_u16(dst, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+
+static inline void storePixels(uint32 *dst, PixelVector lo, PixelVector hi) {
+	vst1q_u32(dst, lo);
+	vst1q_u32(dst + 4, hi);
+}
+#endif
+
+// Both pixel formats, in the form the vector code needs them
+struct VectorFormatPair {
+	VectorFormatPair(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+		r.init(srcFmt.rShift, srcFmt.rBits(), dstFmt.rShift, dstFmt.rLoss);
+		g.init(srcFmt.gShift, srcFmt.gBits(), dstFmt.gShift, dstFmt.gLoss);
+		b.init(srcFmt.bShift, srcFmt.bBits(), dstFmt.bShift, dstFmt.bLoss);
+		// A missing source alpha is opaque, a missing destination alpha is dropped
+		hasAlpha = srcFmt.aBits() != 0 && dstFmt.aBits() != 0;
+		if (hasAlpha)
+			a.init(srcFmt.aShift, srcFmt.aBits(), dstFmt.aShift, dstFmt.aLoss);
+		alpha = setPixels(srcFmt.aBits() == 0 ? dstFmt.ARGBToColor(0xFF, 0, 0, 0) : 0);
+	}
+
+	inline PixelVector convert(PixelVector pixels) const {
+		PixelVector result = orPixels(orPixels(alpha, r.convert(pixels)), orPixels(g.convert(pixels), b.convert(pixels)));
+		if (hasAlpha)
+			result = orPixels(result, a.convert(pixels));
+		return result;
+	}
+
+	ChannelVector r, g, b, a;
+	PixelVector alpha;
+	bool hasAlpha;
+};
+
+template<typename SrcColor, typename DstColor>
+static inline void convertPixel(DstColor *dst, const SrcColor *src, const PixelFormat &srcFmt, const PixelFormat &dstFmt) {
+	byte a, r, g, b;
+	srcFmt.colorToARGB(*src, a, r, g, b);
+	*dst = dstFmt.ARGBToColor(a, r, g, b);
+}
+
+// Same as crossBlitLogic, eight pixels at a time. Backward blits go from the
+// bottom right to the top left in the same way, to convert in place.
+template<typename SrcColor, typename DstColor, bool backward>
+void crossBlitLogicSIMD(byte *dst, const byte *src, const uint w, const uint h,
+                        const PixelFormat &srcFmt, const PixelFormat &dstFmt,
+                        const uint srcPitch, const uint dstPitch) {
+	const VectorFormatPair format(dstFmt, srcFmt);
+	const uint vectorWidth = w & ~7;
+
+	for (uint i = 0; i < h; ++i) {
+		const uint y = backward ? h - 1 - i : i;
+		const SrcColor *srcRow = (const SrcColor *)(src + y * srcPitch);
+		DstColor *dstRow = (DstColor *)(dst + y * dstPitch);
+		PixelVector lo, hi;
+
+		if (backward) {
+			for (uint x = w; x > vectorWidth; --x)
+				convertPixel(dstRow + x - 1, srcRow + x - 1, srcFmt, dstFmt);
+
+			for (uint x = vectorWidth; x > 0; x -= 8) {
+				loadPixels(srcRow + x - 8, lo, hi);
+				storePixels(dstRow + x - 8, format.convert(lo), format.convert(hi));
+			}
+		} else {
+			for (uint x = 0; x < vectorWidth; x += 8) {
+				loadPixels(srcRow + x, lo, hi);
+				storePixels(dstRow + x, format.convert(lo), format.convert(hi));
+			}
+
+			for (uint x = vectorWidth; x < w; ++x)
+				convertPixel(dstRow + x, srcRow + x, srcFmt, dstFmt);
+		}
+	}
+}
+
+#endif
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -134,6 +327,24 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+#if defined(CONVERSION_USE_SSE2) || defined(CONVERSION_USE_NEON)
+	if (isVectorPair(dstFmt, srcFmt)) {
+		if (dstFmt.bytesPerPixel == 2) {
+			if (srcFmt.bytesPerPixel == 2)
+				crossBlitLogicSIMD<uint16, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+			else
+				crossBlitLogicSIMD<uint32, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+		} else {
+			// Backwards when widening the pixels, see below
+			if (srcFmt.bytesPerPixel == 2)
+				crossBlitLogicSIMD<uint16, uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+			else
+				crossBlitLogicSIMD<uint32, uint32, false>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+		}
+		return true;
+	}
+#endif
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -177,6 +388,64 @@ bool crossBlit(byte *dst, const byte *src,
 
 namespace {
 
+// The lookups can not be vectorized without gather instructions, but
+// they are unrolled so that the loads of the map can overlap.
+template<typename DstColor, bool backward>
+void crossBlitMapLogic(byte *dst, const byte *src, const uint w, const uint h,
+                       const uint srcPitch, const uint dstPitch, const uint32 *map) {
+	for (uint i = 0; i < h; ++i) {
+		const uint y = backward ? h - 1 - i : i;
+		const byte *srcRow = src + y * srcPitch;
+		DstColor *dstRow = (DstColor *)(dst + y * dstPitch);
+
+		if (backward) {
+			uint x = w;
+			for (; x >= 4; x -= 4) {
+				const uint32 c3 = map[srcRow[x - 1]], c2 = map[srcRow[x - 2]];
+				const uint32 c1 = map[srcRow[x - 3]], c0 = map[srcRow[x - 4]];
+				dstRow[x - 1] = c3;
+				dstRow[x - 2] = c2;
+				dstRow[x - 3] = c1;
+				dstRow[x - 4] = c0;
+			}
+			for (; x > 0; --x)
+				dstRow[x - 1] = map[srcRow[x - 1]];
+		} else {
+			uint x = 0;
+			for (; x + 4 <= w; x += 4) {
+				dstRow[x + 0] = map[srcRow[x + 0]];
+				dstRow[x + 1] = map[srcRow[x + 1]];
+				dstRow[x + 2] = map[srcRow[x + 2]];
+				dstRow[x + 3] = map[srcRow[x + 3]];
+			}
+			for (; x < w; ++x)
+				dstRow[x] = map[srcRow[x]];
+		}
+	}
+}
+
+} // End of anonymous namespace
+
+bool crossBlitMap(byte *dst, const byte *src,
+                  const uint dstPitch, const uint srcPitch,
+                  const uint w, const uint h,
+                  const uint bytesPerPixel, const uint32 *map) {
+	// Widening the pixels is done from bottom right to top left, to be able
+	// to convert in place, as in crossBlit
+	if (bytesPerPixel == 1) {
+		crossBlitMapLogic<uint8, false>(dst, src, w, h, srcPitch, dstPitch, map);
+	} else if (bytesPerPixel == 2) {
+		crossBlitMapLogic<uint16, true>(dst, src, w, h, srcPitch, dstPitch, map);
+	} else if (bytesPerPixel == 4) {
+		crossBlitMapLogic<uint32, true>(dst, src, w, h, srcPitch, dstPitch, map);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+namespace {
+
 template <typename Size>
 void scaleNN(byte *dst, const byte *src,
                const uint dstPitch, const uint srcPitch,
@@ -97,6 +97,29 @@ bool crossBlit(byte *dst, const byte *src,
                const uint w, const uint h,
                const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * Blits a rectangle of palettized graphics data, looking up each pixel
+ * in a map of the colors in the destination format.
+ *
+ * @param dst			the buffer which will recieve the converted graphics data
+ * @param src			the buffer containing the original 1Bpp graphics data
+ * @param dstPitch		width in bytes of one full line of the dest buffer
+ * @param srcPitch		width in bytes of one full line of the source buffer
+ * @param w				the width of the graphics data
+ * @param h				the height of the graphics data
+ * @param bytesPerPixel	the number of bytes per pixel of the destination
+ * @param map			the 256 colors of the palette, in the destination format
+ * @return				true if conversion completes successfully,
+ *						false if there is an error.
+ *
+ * @note Blitting to a 3Bpp destination is not supported
+ * @note This can convert a surface in place, the same way crossBlit does.
+ */
+bool crossBlitMap(byte *dst, const byte *src,
+                  const uint dstPitch, const uint srcPitch,
+                  const uint w, const uint h,
+                  const uint bytesPerPixel, const uint32 *map);
+
 bool scaleBlit(byte *dst, const byte *src,
                const uint dstPitch, const uint srcPitch,
                const uint dstW, const uint dstH,
@@ -122,6 +122,16 @@ void CursorManager::replaceCursor(const void *buf, uint w, uint h, int hotspotX,
 	uint size = w * h;
 #endif
 
+	// Many engines set the same cursor again on every frame, there is no
+	// need to have the backend convert and upload it again then
+	if (buf && cur->_data && cur->_width == w && cur->_height == h && cur->_hotspotX == hotspotX &&
+			cur->_hotspotY == hotspotY && cur->_keycolor == keycolor && cur->_dontScale == dontScale &&
+#ifdef USE_RGB_COLOR
+			cur->_format == (format ? *format : Graphics::PixelFormat::createFormatCLUT8()) &&
+#endif
+			!memcmp(cur->_data, buf, size))
+		return;
+
 	if (cur->_size < size) {
 		delete[] cur->_data;
 		cur->_data = new byte[size];
@@ -220,6 +230,10 @@ void CursorManager::replaceCursorPalette(const byte *colors, uint start, uint nu
 	Palette *pal = _cursorPaletteStack.top();
 	uint size = 3 * num;
 
+	// Skip setting the same palette again, like for the cursor itself
+	if (num && !pal->_disabled && pal->_data && pal->_start == start && pal->_num == num && !memcmp(pal->_data, colors, size))
+		return;
+
 	if (pal->_size < size) {
 		// Could not re-use the old buffer. Create a new one.
 		delete[] pal->_data;
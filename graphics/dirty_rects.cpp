@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirty_rects.h"
+
+namespace Graphics {
+
+static inline int32 getRectArea(const Common::Rect &r) {
+	return (int32)r.width() * r.height();
+}
+
+DirtyRectList::DirtyRectList(uint rectOverhead, uint maxRects) : _rectOverhead(rectOverhead), _maxRects(MAX<uint>(maxRects, 1)) {
+}
+
+int32 DirtyRectList::getMergeWaste(const Common::Rect &r1, const Common::Rect &r2) {
+	Common::Rect merged = r1;
+	merged.extend(r2);
+
+	const Common::Rect overlap = r1.findIntersectingRect(r2);
+	const int32 covered = getRectArea(r1) + getRectArea(r2) - (overlap.isEmpty() ? 0 : getRectArea(overlap));
+
+	return getRectArea(merged) - covered;
+}
+
+void DirtyRectList::add(const Common::Rect &r) {
+	if (r.isEmpty())
+		return;
+
+	Common::Rect rect = r;
+
+	// Merge the new rect with whatever is cheaper to handle together. The
+	// rects already in the list are not worth merging with each other, so
+	// only the grown rect has to be checked again.
+	for (uint i = 0; i < _rects.size(); ) {
+		if (_rects[i].contains(rect))
+			return;
+
+		if (getMergeWaste(_rects[i], rect) <= (int32)_rectOverhead) {
+			rect.extend(_rects[i]);
+			_rects[i] = _rects.back();
+			_rects.pop_back();
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	_rects.push_back(rect);
+
+	while (_rects.size() > _maxRects)
+		mergeCheapestPair();
+}
+
+void DirtyRectList::mergeCheapestPair() {
+	uint best1 = 0, best2 = 1;
+	int32 bestWaste = getMergeWaste(_rects[0], _rects[1]);
+
+	for (uint i = 0; i < _rects.size(); ++i) {
+		for (uint j = i + 1; j < _rects.size(); ++j) {
+			const int32 waste = getMergeWaste(_rects[i], _rects[j]);
+			if (waste < bestWaste) {
+				bestWaste = waste;
+				best1 = i;
+				best2 = j;
+			}
+		}
+	}
+
+	_rects[best1].extend(_rects[best2]);
+	_rects[best2] = _rects.back();
+	_rects.pop_back();
+}
+
+uint32 DirtyRectList::getArea() const {
+	uint32 area = 0;
+	for (uint i = 0; i < _rects.size(); ++i)
+		area += getRectArea(_rects[i]);
+	return area;
+}
+
+} // End of namespace Graphics
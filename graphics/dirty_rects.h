@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTY_RECTS_H
+#define GRAPHICS_DIRTY_RECTS_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_dirty_rects Dirty rects
+ * @ingroup graphics
+ *
+ * @brief DirtyRectList class for tracking the changed areas of a surface.
+ *
+ * @{
+ */
+
+/**
+ * A list of changed areas, merged as they are added.
+ *
+ * Two rects are only merged when copying the pixels their union adds costs
+ * less than handling one more rect, so that far apart sprites do not end up
+ * in a single large rect. The list is capped at a maximum number of rects, by
+ * merging the pair wasting the fewest pixels.
+ */
+class DirtyRectList {
+public:
+	enum {
+		/** The cost of one more rect, in pixels copied */
+		kDefaultRectOverhead = 1024,
+		/** The number of rects over which they are merged whatever the cost */
+		kDefaultMaxRects = 32
+	};
+
+	typedef Common::Array<Common::Rect>::const_iterator const_iterator;
+
+	DirtyRectList(uint rectOverhead = kDefaultRectOverhead, uint maxRects = kDefaultMaxRects);
+
+	/**
+	 * Adds a changed area. Empty rects are ignored.
+	 */
+	void add(const Common::Rect &r);
+
+	void clear() { _rects.clear(); }
+	bool empty() const { return _rects.empty(); }
+	uint size() const { return _rects.size(); }
+
+	const Common::Rect &operator[](uint idx) const { return _rects[idx]; }
+	const_iterator begin() const { return _rects.begin(); }
+	const_iterator end() const { return _rects.end(); }
+
+	/**
+	 * The rects as a plain array, e.g. for OSystem::copyRectsToScreen().
+	 */
+	const Common::Rect *data() const { return _rects.empty() ? nullptr : &_rects[0]; }
+
+	/**
+	 * Returns the number of pixels covered by the rects. The rects do not
+	 * overlap much, pixels they share are counted once per rect.
+	 */
+	uint32 getArea() const;
+
+	void setRectOverhead(uint rectOverhead) { _rectOverhead = rectOverhead; }
+	void setMaxRects(uint maxRects) { _maxRects = MAX<uint>(maxRects, 1); }
+
+private:
+	/**
+	 * Returns how many more pixels the union of two rects covers than
+	 * the rects themselves.
+	 */
+	static int32 getMergeWaste(const Common::Rect &r1, const Common::Rect &r2);
+
+	void mergeCheapestPair();
+
+	Common::Array<Common::Rect> _rects;
+	uint _rectOverhead;
+	uint _maxRects;
+};
+/** @} */
+} // End of namespace Graphics
+
+#endif
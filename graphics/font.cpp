@@ -24,6 +24,8 @@
 #include "graphics/managed_surface.h"
 
 #include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/util.h"
 
 namespace Graphics {
@@ -392,8 +394,106 @@ StringType handleEllipsis(const Font &font, const StringType &input, int w) {
 	return s;
 }
 
+// The number of strings kept by each of the maps of a FontLayoutCache
+const uint kMaxCachedLayouts = 256;
+
+template<class StringType>
+struct WrapKey {
+	StringType str;
+	int maxWidth;
+	int initWidth;
+	uint32 mode;
+
+	bool operator==(const WrapKey &other) const {
+		return maxWidth == other.maxWidth && initWidth == other.initWidth && mode == other.mode && str == other.str;
+	}
+};
+
+template<class StringType>
+struct WrapKeyHash {
+	uint operator()(const WrapKey<StringType> &key) const {
+		return Common::Hash<StringType>()(key.str) ^ ((uint)key.maxWidth * 2654435761U) ^ ((uint)key.initWidth << 16) ^ key.mode;
+	}
+};
+
+template<class StringType>
+struct Wrap {
+	Common::Array<StringType> lines;
+	int width;
+};
+
+template<class StringType>
+struct Layouts {
+	Common::HashMap<StringType, int> widths;
+	Common::HashMap<WrapKey<StringType>, Wrap<StringType>, WrapKeyHash<StringType> > wraps;
+
+	void clear() {
+		widths.clear();
+		wraps.clear();
+	}
+};
+
+template<class StringType>
+int getCachedStringWidth(const Font &font, Layouts<StringType> &layouts, const StringType &str) {
+	typename Common::HashMap<StringType, int>::const_iterator i = layouts.widths.find(str);
+	if (i != layouts.widths.end())
+		return i->_value;
+
+	if (layouts.widths.size() >= kMaxCachedLayouts)
+		layouts.widths.clear();
+
+	const int width = getStringWidthImpl(font, str);
+	layouts.widths[str] = width;
+	return width;
+}
+
+template<class StringType>
+int getCachedWordWrap(const Font &font, Layouts<StringType> &layouts, const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth, uint32 mode) {
+	// Lines already there are kept, except in the Even Width Lines mode,
+	// thus only wraps into an empty array are cached.
+	if (!lines.empty())
+		return wordWrapTextImpl(font, str, maxWidth, lines, initWidth, mode);
+
+	WrapKey<StringType> key;
+	key.str = str;
+	key.maxWidth = maxWidth;
+	key.initWidth = initWidth;
+	key.mode = mode;
+
+	typename Common::HashMap<WrapKey<StringType>, Wrap<StringType>, WrapKeyHash<StringType> >::const_iterator i = layouts.wraps.find(key);
+	if (i != layouts.wraps.end()) {
+		lines = i->_value.lines;
+		return i->_value.width;
+	}
+
+	if (layouts.wraps.size() >= kMaxCachedLayouts)
+		layouts.wraps.clear();
+
+	Wrap<StringType> &wrap = layouts.wraps[key];
+	wrap.width = wordWrapTextImpl(font, str, maxWidth, wrap.lines, initWidth, mode);
+	lines = wrap.lines;
+	return wrap.width;
+}
+
 } // End of anonymous namespace
 
+struct FontLayoutCache::Entries {
+	Layouts<Common::String> strings;
+	Layouts<Common::U32String> u32Strings;
+};
+
+FontLayoutCache::FontLayoutCache() : _entries(new Entries()) {
+}
+
+FontLayoutCache::~FontLayoutCache() {
+	delete _entries;
+}
+
+void FontLayoutCache::clear() {
+	_entries->strings.clear();
+	_entries->u32Strings.clear();
+}
+
 Common::Rect Font::getBoundingBox(const Common::String &input, int x, int y, const int w, TextAlign align, int deltax, bool useEllipsis) const {
 	// In case no width was given we cannot use ellipsis or any alignment
 	// apart from left alignment.
@@ -435,10 +535,16 @@ Common::Rect Font::getBoundingBox(const Common::U32String &input, int x, int y,
 }
 
 int Font::getStringWidth(const Common::String &str) const {
+	FontLayoutCache *cache = getLayoutCache();
+	if (cache)
+		return getCachedStringWidth(*this, cache->_entries->strings, str);
 	return getStringWidthImpl(*this, str);
 }
 
 int Font::getStringWidth(const Common::U32String &str) const {
+	FontLayoutCache *cache = getLayoutCache();
+	if (cache)
+		return getCachedStringWidth(*this, cache->_entries->u32Strings, str);
 	return getStringWidthImpl(*this, str);
 }
 
@@ -475,10 +581,16 @@ void Font::drawString(ManagedSurface *dst, const Common::U32String &str, int x,
 }
 
 int Font::wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth, uint32 mode) const {
+	FontLayoutCache *cache = getLayoutCache();
+	if (cache)
+		return getCachedWordWrap(*this, cache->_entries->strings, str, maxWidth, lines, initWidth, mode);
 	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth, mode);
 }
 
 int Font::wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth, uint32 mode) const {
+	FontLayoutCache *cache = getLayoutCache();
+	if (cache)
+		return getCachedWordWrap(*this, cache->_entries->u32Strings, str, maxWidth, lines, initWidth, mode);
 	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth, mode);
 }
 
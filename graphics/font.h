@@ -44,6 +44,7 @@ namespace Graphics {
 
 struct Surface;
 class ManagedSurface;
+class FontLayoutCache;
 
 /** Text alignment modes. */
 enum TextAlign {
@@ -239,6 +240,39 @@ public:
 	/** @overload */
 	int wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth = 0, uint32 mode = kWordWrapOnExplicitNewLines) const;
 
+protected:
+	/**
+	 * Return the cache for the widths and word wraps of strings drawn with
+	 * this font, or nullptr if they are always computed.
+	 *
+	 * Fonts for which measuring glyphs is expensive can keep a cache
+	 * around, as long as their glyph metrics never change.
+	 */
+	virtual FontLayoutCache *getLayoutCache() const { return nullptr; }
+};
+
+/**
+ * Cache of the widths and word wraps of strings, as computed by
+ * Font::getStringWidth and Font::wordWrapText.
+ *
+ * Each cache holds a limited number of strings and is emptied once it is
+ * full, such that it keeps up with text which changes every frame.
+ */
+class FontLayoutCache {
+public:
+	FontLayoutCache();
+	~FontLayoutCache();
+
+	/**
+	 * Forget all cached layouts.
+	 */
+	void clear();
+
+private:
+	friend class Font;
+
+	struct Entries;
+	Entries *_entries;
 };
 /** @} */
 } // End of namespace Graphics
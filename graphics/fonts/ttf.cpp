@@ -31,6 +31,7 @@
 #include "graphics/font.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/ustr.h"
 #include "common/file.h"
 #include "common/config-manager.h"
@@ -178,7 +179,31 @@ private:
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
-	void assureCached(uint32 chr) const;
+	const Glyph *findGlyph(uint32 chr) const;
+
+	/**
+	 * The glyph images are packed row by row into the pages of an atlas,
+	 * instead of being allocated one by one.
+	 */
+	struct AtlasPage {
+		Surface surface;
+		int x, y;
+		int rowHeight;
+	};
+
+	enum {
+		kAtlasPageSize = 256
+	};
+
+	mutable Common::Array<AtlasPage *> _atlas;
+	void allocateGlyphImage(Surface &image, int w, int h) const;
+
+	// Kerning offsets by the pair of glyph indices
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerning;
+
+	mutable FontLayoutCache _layoutCache;
+	virtual FontLayoutCache *getLayoutCache() const { return &_layoutCache; }
 
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
@@ -196,7 +221,7 @@ private:
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+      _descent(0), _glyphs(), _atlas(), _kerning(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
       _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
 }
 
@@ -207,11 +232,13 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	for (uint i = 0; i < _atlas.size(); ++i) {
+		_atlas[i]->surface.free();
+		delete _atlas[i];
+	}
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
@@ -526,55 +553,48 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
-	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
-
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *leftGlyph = findGlyph(left);
+	if (!leftGlyph)
 		return 0;
-	}
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *rightGlyph = findGlyph(right);
+	if (!rightGlyph)
 		return 0;
-	}
 
-	if (!leftGlyph || !rightGlyph)
+	if (!leftGlyph->slot || !rightGlyph->slot)
 		return 0;
 
+	// TrueType fonts have at most 65535 glyphs.
+	const uint32 pair = (leftGlyph->slot << 16) | (rightGlyph->slot & 0xFFFF);
+	KerningCache::const_iterator kerningEntry = _kerning.find(pair);
+	if (kerningEntry != _kerning.end())
+		return kerningEntry->_value;
+
 	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
+	FT_Get_Kerning(_face, leftGlyph->slot, rightGlyph->slot, FT_KERNING_DEFAULT, &kerningVector);
+	_kerning[pair] = kerningVector.x / 64;
 	return (kerningVector.x / 64);
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
+		const int xOffset = glyph->xOffset;
+		const int yOffset = glyph->yOffset;
+		const Graphics::Surface &image = glyph->image;
 		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
 	}
 }
@@ -618,12 +638,11 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyphEntry = findGlyph(chr);
+	if (!glyphEntry)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = *glyphEntry;
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -755,7 +774,8 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	// The atlas pages are cleared when they are allocated.
+	allocateGlyphImage(glyph.image, bitmap->width, bitmap->rows);
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -765,7 +785,6 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 	uint8 *dst = (uint8 *)glyph.image.getPixels();
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
 
 	switch (bitmap->pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -778,12 +797,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -798,7 +817,6 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 
 	default:
 		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
 		return false;
 	}
 
@@ -811,15 +829,50 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	return true;
 }
 
-void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
+const TTFFont::Glyph *TTFFont::findGlyph(uint32 chr) const {
+	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	if (glyphEntry != _glyphs.end())
+		return &glyphEntry->_value;
+
+	if (!chr || !_allowLateCaching)
+		return nullptr;
+
+	Glyph newGlyph;
+	if (!cacheGlyph(newGlyph, chr))
+		return nullptr;
+
+	Glyph &glyph = _glyphs[chr];
+	glyph = newGlyph;
+	return &glyph;
+}
+
+void TTFFont::allocateGlyphImage(Surface &image, int w, int h) const {
+	if (w == 0 || h == 0) {
+		image.init(w, h, 0, nullptr, PixelFormat::createFormatCLUT8());
 		return;
 	}
 
-	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
+	AtlasPage *page = _atlas.empty() ? nullptr : _atlas.back();
+
+	// Start a new row when the glyph does not fit into the current one.
+	if (page && page->x + w > page->surface.w) {
+		page->x = 0;
+		page->y += page->rowHeight;
+		page->rowHeight = 0;
+	}
+
+	// Glyphs bigger than the pages get a page of their own.
+	if (!page || w > page->surface.w || page->y + h > page->surface.h) {
+		page = new AtlasPage();
+		page->surface.create(MAX<int>(w, kAtlasPageSize), MAX<int>(h, kAtlasPageSize), PixelFormat::createFormatCLUT8());
+		memset(page->surface.getPixels(), 0, page->surface.h * page->surface.pitch);
+		page->x = page->y = page->rowHeight = 0;
+		_atlas.push_back(page);
 	}
+
+	image = page->surface.getSubArea(Common::Rect(page->x, page->y, page->x + w, page->y + h));
+	page->x += w;
+	page->rowHeight = MAX(page->rowHeight, h);
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
@@ -22,6 +22,7 @@
 
 #include "larryScale.h"
 #include "common/array.h"
+#include "common/threadpool.h"
 
 namespace Graphics {
 
@@ -29,6 +30,9 @@ typedef LarryScaleColor Color;
 
 const int kMargin = 2;
 
+// The number of rows scaled by each task of the thread pool
+const int kBandHeight = 16;
+
 // A bitmap that has a margin of `kMargin` pixels all around it.
 // Allows fast access without time-consuming bounds checking.
 template<typename T>
@@ -137,17 +141,6 @@ MarginedBitmap<Color> createMarginedBitmap(int width, int height, Color marginCo
 	return result;
 }
 
-class MarginedBitmapWriter : public RowWriter {
-	MarginedBitmap<Color> &_target;
-public:
-	explicit MarginedBitmapWriter(MarginedBitmap<Color> &target)
-		: _target(target) {}
-
-	void writeRow(int y, const LarryScaleColor *row) {
-		memcpy(_target.getPointerTo(0, y), row, _target.getWidth() * sizeof(Color));
-	}
-};
-
 inline bool isLinePixel(const MarginedBitmap<Color> &src, int x, int y) {
 #define EQUALS(xOffset, yOffset) (src.get(x + xOffset, y + yOffset) == pixel)
 
@@ -182,27 +175,26 @@ inline bool isLinePixel(const MarginedBitmap<Color> &src, int x, int y) {
 
 MarginedBitmap<bool> createMarginedLinePixelsBitmap(const MarginedBitmap<Color> &src) {
 	MarginedBitmap<bool> result(src.getWidth(), src.getHeight(), false);
-	for (int y = 0; y < src.getHeight(); ++y) {
-		for (int x = 0; x < src.getWidth(); ++x) {
-			result.set(x, y, isLinePixel(src, x, y));
+	Common::parallelFor(0, src.getHeight(), kBandHeight, [&src, &result](uint begin, uint end) {
+		for (int y = begin; y < (int)end; ++y) {
+			for (int x = 0; x < src.getWidth(); ++x) {
+				result.set(x, y, isLinePixel(src, x, y));
+			}
 		}
-	}
+	});
 	return result;
 }
 
-void scaleDown(
+// Scales the destination rows [dstYBegin, dstYEnd) of a downscale
+void scaleDownBand(
 	const MarginedBitmap<Color> &src,
 	Color transparentColor,
 	int dstWidth, int dstHeight,
-	RowWriter &rowWriter
+	Color *dst, int dstPitch,
+	int dstYBegin, int dstYEnd
 ) {
-	assert(src.getWidth() > 0);
-	assert(src.getHeight() > 0);
-	assert(dstWidth > 0 && dstWidth <= src.getWidth());
-	assert(dstHeight > 0 && dstHeight <= src.getHeight());
-
-	Common::Array<Color> dstRow(dstWidth);
-	for (int dstY = 0; dstY < dstHeight; ++dstY) {
+	for (int dstY = dstYBegin; dstY < dstYEnd; ++dstY) {
+		Color *dstRow = dst + dstY * dstPitch;
 		const int srcY1 = dstY * src.getHeight() / dstHeight;
 		const int srcY2 = (dstY + 1) * src.getHeight() / dstHeight;
 
@@ -251,10 +243,26 @@ void scaleDown(
 				dstRow[dstX] = bestColor;
 			}
 		}
-		rowWriter.writeRow(dstY, dstRow.data());
 	}
 }
 
+void scaleDown(
+	const MarginedBitmap<Color> &src,
+	Color transparentColor,
+	int dstWidth, int dstHeight,
+	Color *dst, int dstPitch
+) {
+	assert(src.getWidth() > 0);
+	assert(src.getHeight() > 0);
+	assert(dstWidth > 0 && dstWidth <= src.getWidth());
+	assert(dstHeight > 0 && dstHeight <= src.getHeight());
+
+	// Every destination row only reads the source, so the bands are independent
+	Common::parallelFor(0, dstHeight, kBandHeight, [&](uint begin, uint end) {
+		scaleDownBand(src, transparentColor, dstWidth, dstHeight, dst, dstPitch, begin, end);
+	});
+}
+
 // An equality matrix is a combination of eight Boolean flags indicating whether
 // each of the surrounding pixels has the same color as the central pixel.
 //
@@ -285,26 +293,20 @@ EqualityMatrix getEqualityMatrix(const Color *pixel, int stride) {
 // scapeUp() requires generated functions
 #include "larryScale_generated.cpp"
 
-void scaleUp(
+// Scales the source rows [srcYBegin, srcYEnd) of an upscale
+void scaleUpBand(
 	const MarginedBitmap<Color> &src,
+	const MarginedBitmap<bool> &linePixels,
 	int dstWidth, int dstHeight,
-	RowWriter &rowWriter
+	Color *dst, int dstPitch,
+	int srcYBegin, int srcYEnd
 ) {
-	const int srcWidth = src.getWidth();
-	const int srcHeight = src.getHeight();
-
-	assert(srcWidth > 0);
-	assert(srcHeight > 0);
-	assert(dstWidth >= srcWidth && dstWidth <= 2 * src.getWidth());
-	assert(dstHeight >= srcHeight && dstHeight <= 2 * src.getHeight());
-
-	const MarginedBitmap<bool> linePixels = createMarginedLinePixelsBitmap(src);
-	Common::Array<Color> topDstRow(dstWidth);
-	Common::Array<Color> bottomDstRow(dstWidth);
-	for (int srcY = 0; srcY < src.getHeight(); ++srcY) {
+	for (int srcY = srcYBegin; srcY < srcYEnd; ++srcY) {
 		const int dstY1 = srcY * dstHeight / src.getHeight();
 		const int dstY2 = (srcY + 1) * dstHeight / src.getHeight();
 		const int dstBlockHeight = dstY2 - dstY1;
+		Color *topDstRow = dst + dstY1 * dstPitch;
+		Color *bottomDstRow = dstBlockHeight == 2 ? topDstRow + dstPitch : nullptr;
 
 		for (int srcX = 0; srcX < src.getWidth(); ++srcX) {
 			const int dstX1 = srcX * dstWidth / src.getWidth();
@@ -337,13 +339,31 @@ void scaleUp(
 				}
 			}
 		}
-		rowWriter.writeRow(dstY1, topDstRow.data());
-		if (dstBlockHeight == 2) {
-			rowWriter.writeRow(dstY1 + 1, bottomDstRow.data());
-		}
 	}
 }
 
+void scaleUp(
+	const MarginedBitmap<Color> &src,
+	int dstWidth, int dstHeight,
+	Color *dst, int dstPitch
+) {
+	const int srcWidth = src.getWidth();
+	const int srcHeight = src.getHeight();
+
+	assert(srcWidth > 0);
+	assert(srcHeight > 0);
+	assert(dstWidth >= srcWidth && dstWidth <= 2 * src.getWidth());
+	assert(dstHeight >= srcHeight && dstHeight <= 2 * src.getHeight());
+
+	// The pixels of a band depend on the line pixels of the neighboring rows,
+	// so these are all found before any band is scaled. Each source row then
+	// writes its own destination rows only.
+	const MarginedBitmap<bool> linePixels = createMarginedLinePixelsBitmap(src);
+	Common::parallelFor(0, srcHeight, kBandHeight, [&](uint begin, uint end) {
+		scaleUpBand(src, linePixels, dstWidth, dstHeight, dst, dstPitch, begin, end);
+	});
+}
+
 void copyRows(int height, RowReader &rowReader, RowWriter &rowWriter) {
 	for (int y = 0; y < height; ++y) {
 		rowWriter.writeRow(y, rowReader.readRow(y));
@@ -354,7 +374,7 @@ void larryScale(
 	const MarginedBitmap<Color> &src,
 	Color transparentColor,
 	int dstWidth, int dstHeight,
-	RowWriter &rowWriter
+	Color *dst, int dstPitch
 ) {
 	const int srcWidth = src.getWidth();
 	const int srcHeight = src.getHeight();
@@ -370,15 +390,14 @@ void larryScale(
 		const int tmpWidth = CLIP(dstWidth, srcWidth, 2 * srcWidth);
 		const int tmpHeight = CLIP(dstHeight, srcHeight, 2 * srcHeight);
 		MarginedBitmap<Color> tmp(tmpWidth, tmpHeight, transparentColor);
-		MarginedBitmapWriter writer = MarginedBitmapWriter(tmp);
-		larryScale(src, transparentColor, tmpWidth, tmpHeight, writer);
-		larryScale(tmp, transparentColor, dstWidth, dstHeight, rowWriter);
+		larryScale(src, transparentColor, tmpWidth, tmpHeight, tmp.getOrigin(), tmp.getStride());
+		larryScale(tmp, transparentColor, dstWidth, dstHeight, dst, dstPitch);
 	} else if (dstWidth > srcWidth || dstHeight > srcHeight) {
 		// Upscaling to no more than 200%
-		scaleUp(src, dstWidth, dstHeight, rowWriter);
+		scaleUp(src, dstWidth, dstHeight, dst, dstPitch);
 	} else {
 		// Downscaling
-		scaleDown(src, transparentColor, dstWidth, dstHeight, rowWriter);
+		scaleDown(src, transparentColor, dstWidth, dstHeight, dst, dstPitch);
 	}
 }
 
@@ -395,9 +414,15 @@ void larryScale(
 	} else if (dstWidth == srcWidth && dstHeight == srcHeight) {
 		copyRows(srcHeight, rowReader, rowWriter);
 	} else {
+		// The row callbacks are not required to be thread-safe, so the bands
+		// are scaled to memory and handed to the row writer afterwards
 		const MarginedBitmap<Color> src =
 			createMarginedBitmap(srcWidth, srcHeight, transparentColor, rowReader);
-		larryScale(src, transparentColor, dstWidth, dstHeight, rowWriter);
+		Common::Array<Color> dst(dstWidth * dstHeight);
+		larryScale(src, transparentColor, dstWidth, dstHeight, dst.data(), dstWidth);
+		for (int y = 0; y < dstHeight; ++y) {
+			rowWriter.writeRow(y, dst.data() + y * dstWidth);
+		}
 	}
 }
 
@@ -19,7 +19,9 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "common/algorithm.h"
 #include "common/archive.h"
+#include "common/profiler.h"
 #include "common/stream.h"
 #include "common/unzip.h"
 #include "common/macresman.h"
@@ -109,7 +111,7 @@ Common::String cleanFontName(const Common::String fontname) {
 	return f;
 }
 
-MacFontManager::MacFontManager(uint32 mode) : _mode(mode) {
+MacFontManager::MacFontManager(uint32 mode) : _mode(mode), _numGeneratedFonts(0), _generationMicros(0) {
 	for (uint i = 0; i < ARRAYSIZE(fontNames); i++)
 		if (fontNames[i])
 			_fontIds.setVal(fontNames[i], i);
@@ -122,6 +124,8 @@ MacFontManager::MacFontManager(uint32 mode) : _mode(mode) {
 }
 
 MacFontManager::~MacFontManager() {
+	printFontStats();
+
 	for (Common::HashMap<int, const Graphics::Font *>::iterator it = _uniFonts.begin(); it != _uniFonts.end(); it++)
 		delete it->_value;
 	for (Common::HashMap<int, Common::SeekableReadStream *>::iterator it = _ttfData.begin(); it != _ttfData.end(); it++)
@@ -129,6 +133,8 @@ MacFontManager::~MacFontManager() {
 }
 
 void MacFontManager::loadFontsBDF() {
+	_fontCache.clear();
+
 	Common::Archive *dat;
 
 	dat = Common::makeZipArchive("classicmacfonts.dat");
@@ -231,6 +237,9 @@ void MacFontManager::loadFonts(const Common::String &fileName) {
 }
 
 void MacFontManager::loadFonts(Common::MacResManager *fontFile) {
+	// New fonts may replace the substitutes which were picked before
+	_fontCache.clear();
+
 	Common::MacResIDArray fonds = fontFile->getResIDArray(MKTAG('F','O','N','D'));
 	if (fonds.size() > 0) {
 		for (Common::Array<uint16>::iterator iterator = fonds.begin(); iterator != fonds.end(); ++iterator) {
@@ -308,6 +317,30 @@ void MacFontManager::loadFonts(Common::MacResManager *fontFile) {
 }
 
 const Font *MacFontManager::getFont(MacFont macFont) {
+	// The fonts asked for by id are only looked up and generated once, until
+	// the loaded fonts or the font mapping change
+	const FontCacheKey key = { macFont.getId(), macFont.getSize(), macFont.getSlant(), macFont.getFallback() };
+	const bool cacheable = macFont.getName().empty();
+
+	CachedFont cached;
+	if (!cacheable || !_fontCache.tryGetVal(key, cached)) {
+		cached.font = findFont(macFont);
+
+		MacFont *registered = _fontRegistry.getValOrDefault(macFont.getName(), nullptr);
+		if (registered && registered->isGenerated() && registered->getFont() == cached.font)
+			cached.generatedName = macFont.getName();
+
+		if (cacheable)
+			_fontCache.setVal(key, cached);
+	}
+
+	if (!cached.generatedName.empty())
+		_generatedFontUses[cached.generatedName]++;
+
+	return cached.font;
+}
+
+const Font *MacFontManager::findFont(MacFont &macFont) {
 	Common::String name;
 	const Font *font = 0;
 
@@ -378,11 +411,38 @@ int MacFontManager::parseFontSlant(Common::String slant) {
 void MacFontManager::registerFontMapping(uint16 id, Common::String name) {
 	_extraFontNames[id] = name;
 	_extraFontIds[name] = id;
+	_fontCache.clear();
 }
 
 void MacFontManager::clearFontMapping() {
 	_extraFontNames.clear();
 	_extraFontIds.clear();
+	_fontCache.clear();
+}
+
+struct GeneratedFontUse {
+	Common::String name;
+	uint uses;
+
+	bool operator<(const GeneratedFontUse &other) const { return uses > other.uses; }
+};
+
+void MacFontManager::printFontStats(int debugLevel) const {
+	if (!_numGeneratedFonts)
+		return;
+
+	debug(debugLevel, "MacFontManager: generated %d fonts in %d ms", _numGeneratedFonts, (int)(_generationMicros / 1000));
+
+	// The most requested ones first
+	Common::Array<GeneratedFontUse> uses;
+	for (Common::HashMap<Common::String, uint>::const_iterator it = _generatedFontUses.begin(); it != _generatedFontUses.end(); ++it) {
+		GeneratedFontUse use = { it->_key, it->_value };
+		uses.push_back(use);
+	}
+	Common::sort(uses.begin(), uses.end());
+
+	for (uint i = 0; i < uses.size(); i++)
+		debug(debugLevel, "  %s: requested %d times", uses[i].name.c_str(), uses[i].uses);
 }
 
 void MacFont::setName(const char *name) {
@@ -525,8 +585,11 @@ void MacFontManager::generateTTFFont(MacFont &toFont, Common::SeekableReadStream
 
 	// TODO: Handle getSlant() flags
 
+	const uint64 start = Common::Profiler::getMicros();
 	stream->seek(0);
 	Font *font = Graphics::loadTTFFont(*stream, toFont.getSize());
+	_generationMicros += Common::Profiler::getMicros() - start;
+	_numGeneratedFonts++;
 
 	if (!font) {
 		warning("Failed to generate font '%s'", getFontName(toFont).c_str());
@@ -560,7 +623,10 @@ void MacFontManager::generateFONTFont(MacFont &toFont, MacFont &fromFont) {
 	}
 
 	MacFONTFont *fromFONTFont = static_cast<MacFONTFont *>(fromFont.getFont());
+	const uint64 start = Common::Profiler::getMicros();
 	MacFONTFont *font = Graphics::MacFONTFont::scaleFont(fromFONTFont, toFont.getSize(), bold, italic, outline);
+	_generationMicros += Common::Profiler::getMicros() - start;
+	_numGeneratedFonts++;
 
 	if (!font) {
 		warning("Failed to generate font '%s'", getFontName(toFont).c_str());
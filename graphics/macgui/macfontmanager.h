@@ -138,12 +138,19 @@ public:
 	void registerFontMapping(uint16 id, Common::String name);
 	void clearFontMapping();
 
-	void forceBuiltinFonts() { _builtInFonts = true; }
+	void forceBuiltinFonts() { _builtInFonts = true; _fontCache.clear(); }
+
+	/**
+	 * Print how many fonts were generated from the available sizes and
+	 * styles, and how often each of them was requested.
+	 */
+	void printFontStats(int debugLevel = 1) const;
 
 private:
 	void loadFontsBDF();
 	void loadFonts();
 
+	const Font *findFont(MacFont &macFont);
 	void generateFontSubstitute(MacFont &macFont);
 	void generateFONTFont(MacFont &toFont, MacFont &fromFont);
 
@@ -152,9 +159,42 @@ private:
 #endif
 
 private:
+	// The fonts returned for a font id, size, slant and fallback. They
+	// depend on the font mapping and the loaded fonts, and are dropped when
+	// these change. The generated fonts themselves stay in the registry.
+	struct FontCacheKey {
+		int id;
+		int size;
+		int slant;
+		FontManager::FontUsage fallback;
+
+		bool operator==(const FontCacheKey &other) const {
+			return id == other.id && size == other.size && slant == other.slant && fallback == other.fallback;
+		}
+	};
+
+	struct FontCacheKey_Hash {
+		uint operator()(const FontCacheKey &key) const {
+			return (key.id * 31 + key.size) * 131 + key.slant * 8 + key.fallback;
+		}
+	};
+
+	struct CachedFont {
+		const Font *font;
+		Common::String generatedName;
+	};
+
+	typedef Common::HashMap<FontCacheKey, CachedFont, FontCacheKey_Hash> FontCache;
+
 	bool _builtInFonts;
 	uint32 _mode;
 	Common::HashMap<Common::String, MacFont *> _fontRegistry;
+	FontCache _fontCache;
+
+	// The requests answered with each generated font
+	Common::HashMap<Common::String, uint> _generatedFontUses;
+	uint _numGeneratedFonts;
+	uint64 _generationMicros;
 
 	Common::HashMap<Common::String, int> _fontIds;
 
@@ -527,12 +527,45 @@ void MacText::reallocSurface() {
 }
 
 void MacText::render() {
+	renderArea(0, _textMaxHeight + 1);
+}
+
+void MacText::renderArea(int top, int bottom) {
+	if (_textLines.empty())
+		return;
+
+	reallocSurface();
+
 	if (_fullRefresh) {
 		_surface->clear(_bgcolor);
-		render(0, _textLines.size());
+		for (uint i = 0; i < _textLines.size(); i++)
+			_textLines[i].rendered = false;
 
 		_fullRefresh = false;
 	}
+
+	// The lines are sorted by position, look for the first one ending below the top
+	uint first = 0, last = _textLines.size();
+	while (first < last) {
+		uint mid = (first + last) / 2;
+		if (_textLines[mid].y + getLineHeight(mid) <= top)
+			first = mid + 1;
+		else
+			last = mid;
+	}
+
+	for (uint i = first; i < _textLines.size() && _textLines[i].y < bottom; i++) {
+		if (_textLines[i].rendered)
+			continue;
+
+		// Render the runs of missing lines at once
+		uint end = i;
+		while (end + 1 < _textLines.size() && !_textLines[end + 1].rendered && _textLines[end + 1].y < bottom)
+			end++;
+
+		render(i, end);
+		i = end;
+	}
 }
 
 void MacText::render(int from, int to) {
@@ -564,9 +597,10 @@ void MacText::render(int from, int to) {
 
 		// TODO: _textMaxWidth, when -1, was not rendering ANY text.
 		for (uint j = 0; j < _textLines[i].chunks.size(); j++) {
-			debug(9, "MacText::render: line %d[%d] h:%d at %d,%d (%s) fontid: %d on %dx%d, color: %d",
-				i, j, xOffset, _textLines[i].y, _textLines[i].height, _textLines[i].chunks[j].text.encode().c_str(),
-				_textLines[i].chunks[j].fontId, _surface->w, _surface->h, _textLines[i].chunks[j].fgcolor);
+			if (debugLevelSet(9))
+				debug(9, "MacText::render: line %d[%d] h:%d at %d,%d (%s) fontid: %d on %dx%d, color: %d",
+					i, j, xOffset, _textLines[i].y, _textLines[i].height, _textLines[i].chunks[j].text.encode().c_str(),
+					_textLines[i].chunks[j].fontId, _surface->w, _surface->h, _textLines[i].chunks[j].fgcolor);
 
 			if (_textLines[i].chunks[j].text.empty())
 				continue;
@@ -581,8 +615,14 @@ void MacText::render(int from, int to) {
 			_textLines[i].chunks[j].getFont()->drawString(_surface, convertBiDiU32String(_textLines[i].chunks[j].text), xOffset, _textLines[i].y + yOffset, w, _textLines[i].chunks[j].fgcolor);
 			xOffset += _textLines[i].chunks[j].getFont()->getStringWidth(_textLines[i].chunks[j].text);
 		}
+
+		_textLines[i].rendered = true;
 	}
 
+	// Dumping the whole text is costly, only do it when it is shown
+	if (!debugLevelSet(9))
+		return;
+
 	for (uint i = 0; i < _textLines.size(); i++) {
 		debugN(9, "MacText::render: %2d ", i);
 
@@ -674,7 +714,7 @@ void MacText::setInterLinear(int interLinear) {
 	recalcDims();
 }
 
-void MacText::recalcDims() {
+void MacText::recalcDims(bool enforce) {
 	if (_textLines.empty())
 		return;
 
@@ -686,7 +726,7 @@ void MacText::recalcDims() {
 
 		// We must calculate width first, because it enforces
 		// the computation. Calling Height() will return cached value!
-		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, true));
+		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, enforce));
 		y += getLineHeight(i) + _interLinear;
 	}
 
@@ -779,7 +819,11 @@ void MacText::appendText(const Common::U32String &str, int fontId, int fontSize,
 	}
 
 	splitString(str);
-	recalcDims();
+
+	// Only the last line may have been extended, the others are new
+	if (oldLen)
+		_textLines[oldLen - 1].width = -1;
+	recalcDims(false);
 
 	render(oldLen - 1, _textLines.size());
 
@@ -810,7 +854,11 @@ void MacText::appendTextDefault(const Common::U32String &str, bool skipAdd) {
 	}
 
 	splitString(str);
-	recalcDims();
+
+	// Only the last line may have been extended, the others are new
+	if (oldLen)
+		_textLines[oldLen - 1].width = -1;
+	recalcDims(false);
 
 	render(oldLen - 1, _textLines.size());
 }
@@ -849,7 +897,7 @@ void MacText::draw(ManagedSurface *g, int x, int y, int w, int h, int xoff, int
 	if (_textLines.empty())
 		return;
 
-	render();
+	renderArea(y, y + h);
 
 	g->blitFrom(*_surface, Common::Rect(MIN<int>(_surface->w, x), MIN<int>(_surface->h, y), MIN<int>(_surface->w, x + w), MIN<int>(_surface->h, y + h)), Common::Point(xoff, yoff));
 
@@ -915,7 +963,7 @@ void MacText::drawToPoint(ManagedSurface *g, Common::Rect srcRect, Common::Point
 	if (_textLines.empty())
 		return;
 
-	render();
+	renderArea(srcRect.top, srcRect.bottom);
 
 	srcRect.clip(_surface->getBounds());
 
@@ -1538,12 +1586,11 @@ void MacText::insertChar(byte c, int *row, int *col) {
 	(*col)++;
 
 	if (getLineWidth(*row) - oldw + chunkw > _maxWidth) { // Needs reshuffle
-		reshuffleParagraph(row, col);
-		_fullRefresh = true;
-		recalcDims();
-		render();
+		int start = reshuffleParagraph(row, col);
+		recalcDims(false);
+		redrawFrom(start);
 	} else {
-		recalcDims();
+		recalcDims(false);
 		render(*row, *row);
 	}
 }
@@ -1584,11 +1631,10 @@ void MacText::deletePreviousChar(int *row, int *col) {
 
 	_textLines[*row].width = -1; // flush the cache
 
-	reshuffleParagraph(row, col);
+	int start = reshuffleParagraph(row, col);
 
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	recalcDims(false);
+	redrawFrom(start);
 }
 
 void MacText::addNewLine(int *row, int *col) {
@@ -1622,12 +1668,11 @@ void MacText::addNewLine(int *row, int *col) {
 	(*row)++;
 	*col = 0;
 
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	recalcDims(false);
+	redrawFrom(*row - 1);
 }
 
-void MacText::reshuffleParagraph(int *row, int *col) {
+int MacText::reshuffleParagraph(int *row, int *col) {
 	// First, we looking for the paragraph start and end
 	int start = *row, end = *row;
 
@@ -1664,6 +1709,24 @@ void MacText::reshuffleParagraph(int *row, int *col) {
 		(*row)++;
 	}
 	*col = ppos;
+
+	return start;
+}
+
+void MacText::redrawFrom(int line) {
+	// The lines move horizontally too when the text width changes
+	if (_textAlignment != kTextAlignLeft) {
+		_fullRefresh = true;
+		return;
+	}
+
+	reallocSurface();
+
+	int top = line < (int)_textLines.size() ? _textLines[line].y : _textMaxHeight;
+	_surface->fillRect(Common::Rect(0, top, _surface->w, _surface->h), _bgcolor);
+
+	for (uint i = line; i < _textLines.size(); i++)
+		_textLines[i].rendered = false;
 }
 
 //////////////////
@@ -91,6 +91,7 @@ struct MacTextLine {
 	int y;
 	int charwidth;
 	bool paragraphEnd;
+	bool rendered; // Drawn into the surface since its last full refresh
 
 	Common::Array<MacFontRun> chunks;
 
@@ -98,6 +99,7 @@ struct MacTextLine {
 		width = height = charwidth = -1;
 		y = 0;
 		paragraphEnd = false;
+		rendered = false;
 	}
 
 	MacFontRun &firstChunk() { return chunks[0]; }
@@ -218,13 +220,32 @@ private:
 	 * Rewraps paragraph containing given text row.
 	 * When text is modified, we redo whole thing again without touching
 	 * other paragraphs. Also, cursor position is returned in the arguments
+	 *
+	 * @return The first line of the paragraph
 	 */
-	void reshuffleParagraph(int *row, int *col);
+	int reshuffleParagraph(int *row, int *col);
+
+	/**
+	 * Drops the rendering of the lines from the given one on, after an edit
+	 * changed them or moved them. The lines above stay in the surface.
+	 */
+	void redrawFrom(int line);
 
 	void chopChunk(const Common::U32String &str, int *curLine);
 	void splitString(const Common::U32String &s, int curLine = -1);
 	void render(int from, int to);
-	void recalcDims();
+	/**
+	 * Renders the lines which are not in the surface yet, between the given
+	 * vertical positions. Long texts only get drawn where they are looked at.
+	 */
+	void renderArea(int top, int bottom);
+	/**
+	 * Recomputes the positions of the lines and the text dimensions.
+	 *
+	 * @param enforce Measure all the lines again. Otherwise only the lines
+	 *                whose cached width was dropped are measured, as after edits
+	 */
+	void recalcDims(bool enforce = true);
 	void reallocSurface();
 
 	void scroll(int delta);
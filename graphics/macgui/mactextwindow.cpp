@@ -70,6 +70,7 @@ MacTextWindow::MacTextWindow(MacWindowManager *wm, const MacFont *font, int fgco
 	_cursorDirty = true;
 
 	_cursorRect = new Common::Rect(0, 0, 1, kCursorHeight);
+	_drawnCursorRect = Common::Rect();
 
 	_cursorSurface = new ManagedSurface(1, kCursorHeight);
 	_cursorSurface->fillRect(*_cursorRect, _wm->_colorBlack);
@@ -139,6 +140,17 @@ bool MacTextWindow::draw(bool forceRedraw) {
 	if (!_borderIsDirty && !_contentIsDirty && !_cursorDirty && !_inputIsDirty && !forceRedraw)
 		return false;
 
+	// When only the cursor blinked or moved, the screen only changes where it was and where it is
+	Common::Rect cursorRect = *_cursorRect;
+	cursorRect.moveTo(_cursorX + kConWOverlap - 4, _cursorY + kConHOverlap - 4);
+	if (!_borderIsDirty && !_contentIsDirty && !_inputIsDirty && !forceRedraw) {
+		addDamagedRect(_drawnCursorRect);
+		addDamagedRect(cursorRect);
+	} else {
+		markFullyDamaged();
+	}
+	_drawnCursorRect = cursorRect;
+
 	if (_borderIsDirty || forceRedraw) {
 		drawBorder();
 
@@ -176,6 +188,19 @@ bool MacTextWindow::draw(ManagedSurface *g, bool forceRedraw) {
 	return true;
 }
 
+void MacTextWindow::composite(ManagedSurface *g, const Common::Rect &area) {
+	// The compose surface holds the border too, with an overlap of 2 pixels
+	const Common::Point origin(_dims.left - 2, _dims.top - 2);
+	Common::Rect r = area;
+	r.clip(Common::Rect(origin.x, origin.y, origin.x + _composeSurface->w, origin.y + _composeSurface->h));
+	if (r.isEmpty())
+		return;
+
+	Common::Rect src = r;
+	src.translate(-origin.x, -origin.y);
+	g->transBlitFrom(*_composeSurface, src, Common::Point(r.left, r.top), _wm->_colorGreen2);
+}
+
 void MacTextWindow::blit(ManagedSurface *g, Common::Rect &dest) {
 	g->transBlitFrom(*_composeSurface, _composeSurface->getBounds(), dest, _wm->_colorGreen2);
 }
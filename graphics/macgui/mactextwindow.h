@@ -39,6 +39,7 @@ public:
 
 	virtual bool draw(ManagedSurface *g, bool forceRedraw = false);
 	virtual bool draw(bool forceRedraw = false);
+	virtual void composite(ManagedSurface *g, const Common::Rect &area);
 	virtual void blit(ManagedSurface *g, Common::Rect &dest);
 
 	void setTextWindowFont(const MacFont *macFont);
@@ -82,6 +83,7 @@ public:
 
 	bool _cursorDirty;
 	Common::Rect *_cursorRect;
+	Common::Rect _drawnCursorRect;
 	bool _cursorOff;
 	bool _editable;
 	bool _selectable;
@@ -41,12 +41,50 @@ BaseMacWindow::BaseMacWindow(int id, bool editable, MacWindowManager *wm) :
 	_type = kWindowUnknown;
 
 	_visible = true;
+
+	_fullyDamaged = true;
 }
 
 void BaseMacWindow::setVisible(bool visible, bool silent) { _visible = visible; _wm->setFullRefresh(true); }
 
 bool BaseMacWindow::isVisible() { return _visible; }
 
+void BaseMacWindow::composite(ManagedSurface *g, const Common::Rect &area) {
+	const Common::Rect &innerDims = getInnerDimensions();
+	Common::Rect r = area;
+	r.clip(innerDims);
+	if (!r.isEmpty()) {
+		Common::Rect src = r;
+		src.translate(-innerDims.left, -innerDims.top);
+		g->blitFrom(*_composeSurface, src, Common::Point(r.left, r.top));
+	}
+
+	ManagedSurface *border = getBorderSurface();
+	r = area;
+	r.clip(_dims);
+	if (border && !r.isEmpty()) {
+		Common::Rect src = r;
+		src.translate(-_dims.left, -_dims.top);
+		uint32 transcolor = (_wm->_pixelformat.bytesPerPixel == 1) ? _wm->_colorGreen : 0;
+		g->transBlitFrom(*border, src, Common::Point(r.left, r.top), transcolor);
+	}
+}
+
+void BaseMacWindow::addDamagedRect(const Common::Rect &r) {
+	if (!_fullyDamaged && !r.isEmpty())
+		_damagedRects.push_back(r);
+}
+
+void BaseMacWindow::markFullyDamaged() {
+	_fullyDamaged = true;
+	_damagedRects.clear();
+}
+
+void BaseMacWindow::clearDamagedRects() {
+	_fullyDamaged = false;
+	_damagedRects.clear();
+}
+
 MacWindow::MacWindow(int id, bool scrollable, bool resizable, bool editable, MacWindowManager *wm) :
 		BaseMacWindow(id, editable, wm), _scrollable(scrollable), _resizable(resizable) {
 	_borderIsDirty = true;
@@ -158,6 +196,7 @@ void MacWindow::setBackgroundPattern(int pattern) {
 	_hasPattern = true;
 	drawPattern();
 	_contentIsDirty = true;
+	markFullyDamaged();
 }
 
 bool MacWindow::draw(bool forceRedraw) {
@@ -251,6 +290,7 @@ void MacWindow::updateOuterDims() {
 
 void MacWindow::drawBorder() {
 	_borderIsDirty = false;
+	markFullyDamaged();
 
 	ManagedSurface *g = &_borderSurface;
 	int width = _borderSurface.w;
@@ -146,6 +146,33 @@ public:
 	 */
 	virtual bool draw(ManagedSurface *g, bool forceRedraw = false) = 0;
 
+	/**
+	 * Method called by the WM to blit a part of the window, as it was last
+	 * drawn, into the target surface.
+	 * @param g Surface on which to blit the window.
+	 * @param area The part of the window to blit, in screen coordinates.
+	 */
+	virtual void composite(ManagedSurface *g, const Common::Rect &area);
+
+	/**
+	 * Report that only a part of the window changed since the WM last drew it,
+	 * so that only that part gets composited onto the screen. A window which
+	 * reports its changes has to call markFullyDamaged() for the changes over
+	 * the whole window; one which reports nothing is always composited whole.
+	 * @param r The changed area, relative to the outer dimensions of the window.
+	 */
+	void addDamagedRect(const Common::Rect &r);
+	/**
+	 * Mark the whole window as changed, whatever parts were reported before.
+	 */
+	void markFullyDamaged();
+	/**
+	 * Accessor for the WM to retrieve the changed parts of the window.
+	 * @return The changed areas, empty when the whole window changed.
+	 */
+	const Common::Array<Common::Rect> &getDamagedRects() const { return _damagedRects; }
+	void clearDamagedRects();
+
 	/**
 	 * Method called by the WM when there is an event concerning the window.
 	 * Note that depending on the subclass of the window, it might not be called
@@ -179,6 +206,9 @@ protected:
 	void *_dataPtr;
 
 	bool _visible;
+
+	Common::Array<Common::Rect> _damagedRects;
+	bool _fullyDamaged;
 };
 
 /**
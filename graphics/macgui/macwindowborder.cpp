@@ -40,6 +40,8 @@ MacWindowBorder::MacWindowBorder() : _activeInitialized(false), _inactiveInitial
 	_borderOffsets.titleTop = -1;
 	_borderOffsets.titleBottom = -1;
 	_borderOffsets.dark = false;
+
+	_cachedPaletteVersion[0] = _cachedPaletteVersion[1] = 0;
 }
 
 MacWindowBorder::~MacWindowBorder() {
@@ -47,6 +49,9 @@ MacWindowBorder::~MacWindowBorder() {
 		delete _activeBorder;
 	if (_inactiveBorder)
 		delete _inactiveBorder;
+
+	_cachedBorder[0].free();
+	_cachedBorder[1].free();
 }
 
 bool MacWindowBorder::hasBorder(bool active) {
@@ -59,6 +64,7 @@ void MacWindowBorder::addActiveBorder(TransparentSurface *source) {
 
 	_activeBorder = new NinePatchBitmap(source, true);
 	_activeInitialized = true;
+	_cachedBorder[1].free();
 
 	if (_activeBorder->getPadding().isValidRect())
 		setOffsets(_activeBorder->getPadding());
@@ -70,6 +76,7 @@ void MacWindowBorder::addInactiveBorder(TransparentSurface *source) {
 
 	_inactiveBorder = new NinePatchBitmap(source, true);
 	_inactiveInitialized = true;
+	_cachedBorder[0].free();
 
 	if (!_inactiveBorder->getPadding().isValidRect())
 		setOffsets(_inactiveBorder->getPadding());
@@ -104,7 +111,6 @@ BorderOffsets &MacWindowBorder::getOffset() {
 
 void MacWindowBorder::blitBorderInto(ManagedSurface &destination, bool active, MacWindowManager *wm) {
 
-	TransparentSurface srf;
 	NinePatchBitmap *src = active ? _activeBorder : _inactiveBorder;
 
 	if ((active && !_activeInitialized) || (!active && !_inactiveInitialized)) {
@@ -116,12 +122,18 @@ void MacWindowBorder::blitBorderInto(ManagedSurface &destination, bool active, M
 		return;
 	}
 
-	srf.create(destination.w, destination.h, destination.format);
-	srf.fillRect(Common::Rect(srf.w, srf.h), wm->_colorGreen2);
+	Surface &srf = _cachedBorder[active ? 1 : 0];
+	uint32 &paletteVersion = _cachedPaletteVersion[active ? 1 : 0];
+
+	if (srf.w != destination.w || srf.h != destination.h || srf.format != destination.format || paletteVersion != wm->getPaletteVersion()) {
+		srf.create(destination.w, destination.h, destination.format);
+		srf.fillRect(Common::Rect(srf.w, srf.h), wm->_colorGreen2);
+
+		src->blit(srf, 0, 0, srf.w, srf.h, NULL, 0, wm);
+		paletteVersion = wm->getPaletteVersion();
+	}
 
-	src->blit(srf, 0, 0, srf.w, srf.h, NULL, 0, wm);
 	destination.transBlitFrom(srf, wm->_colorGreen2);
-	srf.free();
 }
 
 } // End of namespace Graphics
@@ -107,6 +107,8 @@ public:
 	/**
 	 * Blit the desired border (active or inactive) into a destination surface.
 	 * It automatically resizes the border to fit the given surface.
+	 * The resized border is kept for each state, and reused as long as the
+	 * size of the destination and the palette of the window manager do not change.
 	 * @param destination The surface we want to blit into.
 	 * @param active True if we want to blit the active border, false otherwise.
 	 * @param wm The window manager.
@@ -121,6 +123,10 @@ private:
 	bool _activeInitialized;
 	bool _inactiveInitialized;
 
+	// The last resized border of each state, indexed by the active flag
+	Surface _cachedBorder[2];
+	uint32 _cachedPaletteVersion[2];
+
 	BorderOffsets _borderOffsets;
 
 };
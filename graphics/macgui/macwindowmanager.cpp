@@ -191,6 +191,7 @@ MacWindowManager::MacWindowManager(uint32 mode, MacPatterns *patterns) {
 
 	_palette = nullptr;
 	_paletteSize = 0;
+	_paletteVersion = 0;
 
 	if (mode & kWMMode32bpp)
 		_pixelformat = Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
@@ -500,6 +501,70 @@ void MacWindowManager::drawDesktop() {
 	}
 }
 
+// Add an area to the list, merged with the ones it overlaps so that no pixel is composited twice
+static void addDirtyRect(Common::Array<Common::Rect> &dirtyRects, Common::Rect r) {
+	if (r.isEmpty())
+		return;
+
+	for (uint i = 0; i < dirtyRects.size();) {
+		if (dirtyRects[i].intersects(r)) {
+			r.extend(dirtyRects[i]);
+			dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+	dirtyRects.push_back(r);
+}
+
+bool MacWindowManager::isWindowOnScreen(BaseMacWindow *w, const Common::Rect &bounds, Common::Rect &clip) {
+	if (!w->isVisible())
+		return false;
+
+	clip = w->getInnerDimensions();
+	clip.clip(bounds);
+
+	if (clip.isEmpty())
+		return false;
+
+	clip = w->getDimensions();
+	clip.clip(bounds);
+
+	return !clip.isEmpty();
+}
+
+void MacWindowManager::copyWindowToScreen(BaseMacWindow *w, const Common::Rect &area) {
+	const Common::Rect &outerDims = w->getDimensions();
+	const Common::Rect &innerDims = w->getInnerDimensions();
+	ManagedSurface *border = w->getBorderSurface();
+
+	Common::Rect r = area;
+	r.clip(outerDims);
+	if (border && !r.isEmpty()) {
+		if (_pixelformat.bytesPerPixel == 1) {
+			Surface *surface = g_system->lockScreen();
+
+			for (int y = r.top; y < r.bottom; y++) {
+				const byte *src = (const byte *)border->getBasePtr(r.left - outerDims.left, y - outerDims.top);
+				byte *dst = (byte *)surface->getBasePtr(r.left, y);
+				for (int x = r.left; x < r.right; x++, src++, dst++)
+					if (*src != _colorGreen2 && *src != _colorGreen)
+						*dst = *src;
+			}
+
+			g_system->unlockScreen();
+		} else {
+			g_system->copyRectToScreen(border->getBasePtr(r.left - outerDims.left, r.top - outerDims.top), border->pitch, r.left, r.top, r.width(), r.height());
+		}
+	}
+
+	r = area;
+	r.clip(innerDims);
+	if (!r.isEmpty())
+		g_system->copyRectToScreen(w->getWindowSurface()->getBasePtr(r.left - innerDims.left, r.top - innerDims.top), w->getWindowSurface()->pitch, r.left, r.top, r.width(), r.height());
+}
+
 void MacWindowManager::draw() {
 	removeMarked();
 
@@ -525,81 +590,67 @@ void MacWindowManager::draw() {
 			_redrawEngineCallback(_engineR);
 	}
 
+	// Redraw the windows which changed, and collect the screen areas they cover
 	Common::Array<Common::Rect> dirtyRects;
+	if (_fullRefresh)
+		dirtyRects.push_back(bounds);
+
 	for (Common::List<BaseMacWindow *>::const_iterator it = _windowStack.begin(); it != _windowStack.end(); it++) {
 		BaseMacWindow *w = *it;
-		if (!w->isVisible())
+		Common::Rect clip;
+		if (!isWindowOnScreen(w, bounds, clip))
 			continue;
 
-		Common::Rect clip = w->getInnerDimensions();
-		clip.clip(bounds);
-
-		if (clip.isEmpty())
+		if (!w->draw(_fullRefresh))
 			continue;
 
-		clip = w->getDimensions();
-		clip.clip(bounds);
-
-		if (clip.isEmpty())
-			continue;
+		if (_screen)
+			w->setDirty(false);
 
-		bool forceRedraw = _fullRefresh;
-		if (!forceRedraw && dirtyRects.size()) {
-			for (Common::Array<Common::Rect>::iterator dirty = dirtyRects.begin(); dirty != dirtyRects.end(); dirty++) {
-				if (clip.intersects(*dirty)) {
-					forceRedraw = true;
-					break;
+		if (!_fullRefresh) {
+			const Common::Array<Common::Rect> &damage = w->getDamagedRects();
+			if (damage.empty()) {
+				addDirtyRect(dirtyRects, clip);
+			} else {
+				for (uint i = 0; i < damage.size(); i++) {
+					Common::Rect r = damage[i];
+					r.translate(w->getDimensions().left, w->getDimensions().top);
+					r.clip(clip);
+					addDirtyRect(dirtyRects, r);
 				}
 			}
 		}
+		w->clearDamagedRects();
+	}
 
-		if (!_screen) {
-			if (w->isDirty() || forceRedraw) {
-				w->draw(forceRedraw);
-
-				Common::Rect outerDims = w->getDimensions();
-				Common::Rect innerDims = w->getInnerDimensions();
-				int adjWidth, adjHeight;
-
-				if (w->isDirty() || forceRedraw) {
-					w->draw(forceRedraw);
-
-					adjustDimensions(clip, outerDims, adjWidth, adjHeight);
+	// Composite every window over each changed area, in z-order
+	for (uint i = 0; i < dirtyRects.size(); i++) {
+		const Common::Rect &dirty = dirtyRects[i];
 
-					if (_pixelformat.bytesPerPixel == 1) {
-						Surface *surface = g_system->lockScreen();
-						ManagedSurface *border = w->getBorderSurface();
+		for (Common::List<BaseMacWindow *>::const_iterator it = _windowStack.begin(); it != _windowStack.end(); it++) {
+			BaseMacWindow *w = *it;
+			Common::Rect clip;
+			if (!isWindowOnScreen(w, bounds, clip))
+				continue;
 
-						for (int y = 0; y < adjHeight; y++) {
-							const byte *src = (const byte *)border->getBasePtr(clip.left - outerDims.left, y);
-							byte *dst = (byte *)surface->getBasePtr(clip.left, y + clip.top);
-							for (int x = 0; x < adjWidth; x++, src++, dst++)
-									if (*src != _colorGreen2 && *src != _colorGreen)
-										*dst = *src;
-						}
+			clip.clip(dirty);
+			if (clip.isEmpty())
+				continue;
 
-						g_system->unlockScreen();
-					} else {
-						g_system->copyRectToScreen(w->getBorderSurface()->getBasePtr(MAX(clip.left - outerDims.left, 0), MAX(clip.top - outerDims.top, 0)), w->getBorderSurface()->pitch, clip.left, clip.top, adjWidth, adjHeight);
-					}
-				}
-
-				adjustDimensions(clip, innerDims, adjWidth, adjHeight);
-				g_system->copyRectToScreen(w->getWindowSurface()->getBasePtr(MAX(clip.left - innerDims.left, 0), MAX(clip.top - innerDims.top, 0)), w->getWindowSurface()->pitch,MAX(innerDims.left, (int16)0), MAX(innerDims.top, (int16)0), adjWidth, adjHeight);
+			if (_screen)
+				w->composite(_screen, clip);
+			else
+				copyWindowToScreen(w, clip);
+		}
 
-				dirtyRects.push_back(clip);
-			}
+		if (_screen)
+			g_system->copyRectToScreen(_screen->getBasePtr(dirty.left, dirty.top), _screen->pitch, dirty.left, dirty.top, dirty.width(), dirty.height());
+	}
 
-			if (_screenCopyPauseToken) {
-				_screenCopyPauseToken->clear();
-				delete _screenCopyPauseToken;
-				_screenCopyPauseToken = nullptr;
-			}
-		} else if (w->draw(_screen, forceRedraw)) {
-			w->setDirty(false);
-			g_system->copyRectToScreen(_screen->getBasePtr(clip.left, clip.top), _screen->pitch, clip.left, clip.top, clip.width(), clip.height());
-			dirtyRects.push_back(clip);
-		}
+	if (_screenCopyPauseToken) {
+		_screenCopyPauseToken->clear();
+		delete _screenCopyPauseToken;
+		_screenCopyPauseToken = nullptr;
 	}
 
 	// Menu is drawn on top of everything and always
@@ -684,26 +735,6 @@ bool MacWindowManager::processEvent(Common::Event &event) {
 	return false;
 }
 
-void MacWindowManager::adjustDimensions(const Common::Rect &clip, const Common::Rect &dims, int &adjWidth, int &adjHeight) {
-	int wOffset, hOffset;
-
-	wOffset = clip.left - dims.left;
-	adjWidth = dims.width();
-	if (wOffset > 0) {
-		adjWidth -= wOffset;
-	} else if (dims.right > getScreenBounds().right) {
-		adjWidth -= (dims.right - getScreenBounds().right);
-	}
-
-	hOffset = clip.top - dims.top;
-	adjHeight = dims.height();
-	if (hOffset > 0) {
-		adjHeight -= hOffset;
-	} else if (dims.bottom > getScreenBounds().bottom) {
-		adjHeight -= (dims.bottom - getScreenBounds().bottom);
-	}
-}
-
 void MacWindowManager::removeMarked() {
 	if (!_needsRemoval) return;
 
@@ -950,6 +981,7 @@ void MacWindowManager::passPalette(const byte *pal, uint size) {
 	_palette = (byte *)malloc(size * 3);
 	memcpy(_palette, pal, size * 3);
 	_paletteSize = size;
+	_paletteVersion++;
 
 	_colorHash.clear();
 
@@ -294,6 +294,11 @@ public:
 	void setEngineRedrawCallback(void *engine, void (*redrawCallback)(void *engine));
 
 	void passPalette(const byte *palette, uint size);
+	/**
+	 * Accessor for anything keeping colors looked up in the palette.
+	 * @return A number which changes each time a new palette is passed.
+	 */
+	uint32 getPaletteVersion() const { return _paletteVersion; }
 	uint findBestColor(byte cr, byte cg, byte cb);
 	void decomposeColor(uint32 color, byte &r, byte &g, byte &b);
 
@@ -332,7 +337,8 @@ private:
 	void zoomBoxInner(Common::Rect &r, Graphics::MacPlotData &pd);
 	bool haveZoomBox() { return !_zoomBoxes.empty(); }
 
-	void adjustDimensions(const Common::Rect &clip, const Common::Rect &dims, int &adjWidth, int &adjHeight);
+	bool isWindowOnScreen(BaseMacWindow *w, const Common::Rect &bounds, Common::Rect &clip);
+	void copyWindowToScreen(BaseMacWindow *w, const Common::Rect &area);
 
 public:
 	TransparentSurface *_desktopBmp;
@@ -358,6 +364,7 @@ private:
 	MacPatterns _patterns;
 	byte *_palette;
 	uint _paletteSize;
+	uint32 _paletteVersion;
 
 	MacMenu *_menu;
 	uint32 _menuDelay;
@@ -23,6 +23,7 @@
 #include "graphics/managed_surface.h"
 #include "common/algorithm.h"
 #include "common/textconsole.h"
+#include "graphics/conversion.h"
 
 namespace Graphics {
 
@@ -239,6 +240,36 @@ void ManagedSurface::blitFrom(const ManagedSurface &src, const Common::Rect &src
 		blitFromInner(src._innerSurface, srcRect, destRect, src._paletteSet ? src._palette : nullptr);
 }
 
+bool ManagedSurface::blitFromFast(const Surface &src, const Common::Rect &srcRect,
+		const Common::Rect &destRect, const uint32 *srcPalette) {
+	const byte *srcP = (const byte *)src.getBasePtr(srcRect.left, srcRect.top);
+	byte *destP = (byte *)getBasePtr(destRect.left, destRect.top);
+
+	if (src.format.bytesPerPixel == 1) {
+		// Building the map only pays off for larger areas, and it can not
+		// blend the partially transparent colors
+		if (!srcPalette || srcRect.width() * srcRect.height() < 256)
+			return false;
+
+		uint32 map[256];
+		for (int i = 0; i < 256; ++i) {
+			const uint32 col = srcPalette[i];
+			if ((col >> 24) != 0xff)
+				return false;
+			map[i] = format.ARGBToColor(0xff, col & 0xff, (col >> 8) & 0xff, (col >> 16) & 0xff);
+		}
+
+		return crossBlitMap(destP, srcP, pitch, src.pitch, srcRect.width(), srcRect.height(),
+			format.bytesPerPixel, map);
+	}
+
+	// Opaque source pixels are converted without any blending
+	if (src.format.aBits() != 0)
+		return false;
+
+	return crossBlit(destP, srcP, pitch, src.pitch, srcRect.width(), srcRect.height(), format, src.format);
+}
+
 void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRect,
 		const Common::Rect &destRect, const uint32 *srcPalette) {
 	const int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
@@ -261,6 +292,13 @@ void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRe
 	}
 
 	const bool noScale = scaleX == SCALE_THRESHOLD && scaleY == SCALE_THRESHOLD;
+	if (noScale && format != src.format && (format.bytesPerPixel == 2 || format.bytesPerPixel == 4)
+			&& destRect.left >= 0 && destRect.top >= 0 && destRect.right <= w && destRect.bottom <= h
+			&& blitFromFast(src, srcRect, destRect, srcPalette)) {
+		addDirtyRect(Common::Rect(0, 0, this->w, this->h));
+		return;
+	}
+
 	for (int destY = destRect.top, scaleYCtr = 0; destY < destRect.bottom; ++destY, scaleYCtr += scaleY) {
 		if (destY < 0 || destY >= h)
 			continue;
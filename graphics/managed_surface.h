@@ -97,6 +97,13 @@ protected:
 	void blitFromInner(const Surface &src, const Common::Rect &srcRect,
 		const Common::Rect &destRect, const uint32 *srcPalette);
 
+	/**
+	 * Converts an unscaled blit with crossBlit or crossBlitMap, if the
+	 * source pixels are all opaque. Returns false if it can not be done.
+	 */
+	bool blitFromFast(const Surface &src, const Common::Rect &srcRect,
+		const Common::Rect &destRect, const uint32 *srcPalette);
+
 	/**
 	 * Inner method for copying another surface into this one at a given destination position.
 	 */
@@ -3,6 +3,7 @@ MODULE := graphics
 MODULE_OBJS := \
 	conversion.o \
 	cursorman.o \
+	dirty_rects.o \
 	font.o \
 	fontman.o \
 	fonts/bdf.o \
@@ -100,7 +101,8 @@ endif
 ifdef USE_HQ_SCALERS
 MODULE_OBJS += \
 	scaler/hq2x.o \
-	scaler/hq3x.o
+	scaler/hq3x.o \
+	scaler/hqx_pattern.o
 
 ifdef USE_NASM
 MODULE_OBJS += \
@@ -21,12 +21,70 @@
  */
 
 #include "common/algorithm.h"
+#include "common/array.h"
 #include "common/util.h"
+#include "graphics/managed_surface.h"
 #include "graphics/primitives.h"
 
 namespace Graphics {
 
-void drawLine(int x0, int y0, int x1, int y1, int color, void (*plotProc)(int, int, int, void *), void *data) {
+namespace {
+
+// Draws the spans of the primitives pixel by pixel
+struct PlotSpans {
+	void (*plotProc)(int, int, int, void *);
+	void *data;
+
+	void operator()(int x1, int x2, int y, int color) const {
+		drawHLine(x1, x2, y, color, plotProc, data);
+	}
+};
+
+struct HLineSpans {
+	void (*hLineProc)(int, int, int, int, void *);
+	void *data;
+
+	void operator()(int x1, int x2, int y, int color) const {
+		if (x1 > x2)
+			SWAP(x1, x2);
+
+		(*hLineProc)(x1, x2, y, color, data);
+	}
+};
+
+// Gathers the consecutive pixels of a row into a single span
+struct SpanCollector {
+	const HLineSpans &spans;
+	int color;
+	int x1, x2, y;
+	bool pending;
+
+	SpanCollector(const HLineSpans &spans_, int color_) : spans(spans_), color(color_), x1(0), x2(0), y(0), pending(false) {}
+
+	void operator()(int x, int y_) {
+		if (pending && y_ == y && (x == x2 + 1 || x == x1 - 1)) {
+			x1 = MIN(x1, x);
+			x2 = MAX(x2, x);
+			return;
+		}
+
+		flush();
+		x1 = x2 = x;
+		y = y_;
+		pending = true;
+	}
+
+	void flush() {
+		if (pending)
+			spans(x1, x2, y, color);
+		pending = false;
+	}
+};
+
+} // End of anonymous namespace
+
+template<class Plot>
+static void drawLineSteps(int x0, int y0, int x1, int y1, Plot &plot) {
 	// Bresenham's line algorithm, as described by Wikipedia
 	const bool steep = ABS(y1 - y0) > ABS(x1 - x0);
 
@@ -46,9 +104,9 @@ void drawLine(int x0, int y0, int x1, int y1, int color, void (*plotProc)(int, i
 	const int y_step = (y0 < y1) ? 1 : -1;
 
 	if (steep)
-		(*plotProc)(y, x, color, data);
+		plot(y, x);
 	else
-		(*plotProc)(x, y, color, data);
+		plot(x, y);
 
 	while (x != x1) {
 		x += x_step;
@@ -58,10 +116,36 @@ void drawLine(int x0, int y0, int x1, int y1, int color, void (*plotProc)(int, i
 			err -= delta_x;
 		}
 		if (steep)
-			(*plotProc)(y, x, color, data);
+			plot(y, x);
 		else
-			(*plotProc)(x, y, color, data);
+			plot(x, y);
+	}
+}
+
+namespace {
+
+struct PlotPixels {
+	void (*plotProc)(int, int, int, void *);
+	int color;
+	void *data;
+
+	void operator()(int x, int y) const {
+		(*plotProc)(x, y, color, data);
 	}
+};
+
+} // End of anonymous namespace
+
+void drawLine(int x0, int y0, int x1, int y1, int color, void (*plotProc)(int, int, int, void *), void *data) {
+	PlotPixels plot = { plotProc, color, data };
+	drawLineSteps(x0, y0, x1, y1, plot);
+}
+
+void drawLine(int x0, int y0, int x1, int y1, int color, void (*hLineProc)(int, int, int, int, void *), void *data) {
+	HLineSpans spans = { hLineProc, data };
+	SpanCollector collector(spans, color);
+	drawLineSteps(x0, y0, x1, y1, collector);
+	collector.flush();
 }
 
 void drawHLine(int x1, int x2, int y, int color, void (*plotProc)(int, int, int, void *), void *data) {
@@ -239,9 +323,20 @@ void drawThickLine2(int x1, int y1, int x2, int y2, int thick, int color, void (
 	}
 }
 
-void drawFilledRect(Common::Rect &rect, int color, void (*plotProc)(int, int, int, void *), void *data) {
+template<class Spans>
+static void drawFilledRectSpans(Common::Rect &rect, int color, const Spans &spans) {
 	for (int y = rect.top; y <= rect.bottom; y++)
-		drawHLine(rect.left, rect.right, y, color, plotProc, data);
+		spans(rect.left, rect.right, y, color);
+}
+
+void drawFilledRect(Common::Rect &rect, int color, void (*plotProc)(int, int, int, void *), void *data) {
+	PlotSpans spans = { plotProc, data };
+	drawFilledRectSpans(rect, color, spans);
+}
+
+void drawFilledRect(Common::Rect &rect, int color, void (*hLineProc)(int, int, int, int, void *), void *data) {
+	HLineSpans spans = { hLineProc, data };
+	drawFilledRectSpans(rect, color, spans);
 }
 
 void drawRect(Common::Rect &rect, int color, void (*plotProc)(int, int, int, void *), void *data) {
@@ -348,7 +443,8 @@ void drawRoundRect(Common::Rect &rect, int arc, int color, bool filled, void (*p
 
 // Based on public-domain code by Darel Rex Finley, 2007
 // http://alienryderflex.com/polygon_fill/
-void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, int color, void (*plotProc)(int, int, int, void *), void *data) {
+template<class Spans>
+static void drawPolygonScanSpans(int *polyX, int *polyY, int npoints, Common::Rect &bbox, int color, const Spans &spans) {
 	int *nodeX = (int *)calloc(npoints, sizeof(int));
 	int i, j;
 
@@ -377,7 +473,7 @@ void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, in
 				nodeX[i] = MAX<int16>(nodeX[i], bbox.left);
 				nodeX[i + 1] = MIN<int16>(nodeX[i + 1], bbox.right);
 
-				drawHLine(nodeX[i], nodeX[i + 1], pixelY, color, plotProc, data);
+				spans(nodeX[i], nodeX[i + 1], pixelY, color);
 			}
 		}
 	}
@@ -385,8 +481,19 @@ void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, in
 	free(nodeX);
 }
 
+void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, int color, void (*plotProc)(int, int, int, void *), void *data) {
+	PlotSpans spans = { plotProc, data };
+	drawPolygonScanSpans(polyX, polyY, npoints, bbox, color, spans);
+}
+
+void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, int color, void (*hLineProc)(int, int, int, int, void *), void *data) {
+	HLineSpans spans = { hLineProc, data };
+	drawPolygonScanSpans(polyX, polyY, npoints, bbox, color, spans);
+}
+
 // http://members.chello.at/easyfilter/bresenham.html
-void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*plotProc)(int, int, int, void *), void *data) {
+template<class Spans>
+static void drawEllipseSpans(int x0, int y0, int x1, int y1, int color, bool filled, const Spans &spans) {
 	int a = abs(x1 - x0), b = abs(y1 - y0), b1 = b & 1; /* values of diameter */
 	long dx = 4 * (1 - a) * b * b, dy = 4 * (b1 + 1) * a * a; /* error increment */
 	long err = dx + dy + b1 * a * a, e2; /* error of 1.step */
@@ -398,13 +505,13 @@ void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*
 
 	do {
 		if (filled) {
-			drawHLine(x0, x1, y0, color, plotProc, data);
-			drawHLine(x0, x1, y1, color, plotProc, data);
+			spans(x0, x1, y0, color);
+			spans(x0, x1, y1, color);
 		} else {
-			(*plotProc)(x1, y0, color, data); /*   I. Quadrant */
-			(*plotProc)(x0, y0, color, data); /*  II. Quadrant */
-			(*plotProc)(x0, y1, color, data); /* III. Quadrant */
-			(*plotProc)(x1, y1, color, data); /*  IV. Quadrant */
+			spans(x1, x1, y0, color); /*   I. Quadrant */
+			spans(x0, x0, y0, color); /*  II. Quadrant */
+			spans(x0, x0, y1, color); /* III. Quadrant */
+			spans(x1, x1, y1, color); /*  IV. Quadrant */
 		}
 		e2 = 2*err;
 		if (e2 <= dy) { y0++; y1--; err += dy += a; }  /* y step */
@@ -413,19 +520,76 @@ void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*
 
 	while (y0-y1 < b) {  /* too early stop of flat ellipses a=1 */
 		if (filled) {
-			drawHLine(x0 - 1, x0 - 1, y0, color, plotProc, data); /* -> finish tip of ellipse */
-			drawHLine(x1 + 1, x1 + 1, y0, color, plotProc, data);
-			drawHLine(x0 - 1, x0 - 1, y1, color, plotProc, data);
-			drawHLine(x1 + 1, x1 + 1, y1, color, plotProc, data);
+			spans(x0 - 1, x0 - 1, y0, color); /* -> finish tip of ellipse */
+			spans(x1 + 1, x1 + 1, y0, color);
+			spans(x0 - 1, x0 - 1, y1, color);
+			spans(x1 + 1, x1 + 1, y1, color);
 		} else {
-			(*plotProc)(x0 - 1, y0, color, data); /* -> finish tip of ellipse */
-			(*plotProc)(x1 + 1, y0, color, data);
-			(*plotProc)(x0 - 1, y1, color, data);
-			(*plotProc)(x1 + 1, y1, color, data);
+			spans(x0 - 1, x0 - 1, y0, color); /* -> finish tip of ellipse */
+			spans(x1 + 1, x1 + 1, y0, color);
+			spans(x0 - 1, x0 - 1, y1, color);
+			spans(x1 + 1, x1 + 1, y1, color);
 		}
 		y0++;
 		y1--;
 	}
 }
 
+void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*plotProc)(int, int, int, void *), void *data) {
+	PlotSpans spans = { plotProc, data };
+	drawEllipseSpans(x0, y0, x1, y1, color, filled, spans);
+}
+
+void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*hLineProc)(int, int, int, int, void *), void *data) {
+	HLineSpans spans = { hLineProc, data };
+	drawEllipseSpans(x0, y0, x1, y1, color, filled, spans);
+}
+
+void drawHLineManagedSurface(int x1, int x2, int y, int color, void *data) {
+	((ManagedSurface *)data)->hLine(x1, y, x2, color);
+}
+
+void floodFill(int x, int y, const Common::Rect &bounds, int color, bool (*insideProc)(int, int, void *), void (*hLineProc)(int, int, int, int, void *), void *data) {
+	if (!bounds.contains(x, y) || !(*insideProc)(x, y, data))
+		return;
+
+	// Each seed stands for a run of pixels of the area, filled when it is taken
+	Common::Array<Common::Point> seeds;
+	seeds.push_back(Common::Point(x, y));
+
+	while (!seeds.empty()) {
+		const Common::Point seed = seeds.back();
+		seeds.pop_back();
+
+		// Another run already reached it
+		if (!(*insideProc)(seed.x, seed.y, data))
+			continue;
+
+		int left = seed.x, right = seed.x;
+		while (left > bounds.left && (*insideProc)(left - 1, seed.y, data))
+			left--;
+		while (right < bounds.right - 1 && (*insideProc)(right + 1, seed.y, data))
+			right++;
+
+		(*hLineProc)(left, right, seed.y, color, data);
+
+		// Seed each run touching the span, in the rows above and below
+		for (int row = seed.y - 1; row <= seed.y + 1; row += 2) {
+			if (row < bounds.top || row >= bounds.bottom)
+				continue;
+
+			bool inRun = false;
+			for (int i = left; i <= right; i++) {
+				if ((*insideProc)(i, row, data)) {
+					if (!inRun)
+						seeds.push_back(Common::Point(i, row));
+					inRun = true;
+				} else {
+					inRun = false;
+				}
+			}
+		}
+	}
+}
+
 } // End of namespace Graphics
@@ -40,6 +40,38 @@ void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, in
 								void (*plotProc)(int, int, int, void *), void *data);
 void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*plotProc)(int, int, int, void *), void *data);
 
+/**
+ * Variants of the primitives above, which draw whole horizontal spans at once.
+ * hLineProc(x1, x2, y, color, data) fills row y from x1 to x2 included, with x1 <= x2.
+ * They cover the same pixels as the per-pixel versions, with one call per run
+ * instead of one per pixel.
+ */
+void drawLine(int x0, int y0, int x1, int y1, int color, void (*hLineProc)(int, int, int, int, void *), void *data);
+void drawFilledRect(Common::Rect &rect, int color, void (*hLineProc)(int, int, int, int, void *), void *data);
+void drawPolygonScan(int *polyX, int *polyY, int npoints, Common::Rect &bbox, int color,
+								void (*hLineProc)(int, int, int, int, void *), void *data);
+void drawEllipse(int x0, int y0, int x1, int y1, int color, bool filled, void (*hLineProc)(int, int, int, int, void *), void *data);
+
+/**
+ * A hLineProc drawing into the Graphics::ManagedSurface passed as data,
+ * clipped to its bounds.
+ */
+void drawHLineManagedSurface(int x1, int x2, int y, int color, void *data);
+
+/**
+ * Scanline flood fill of the 4-connected area around a pixel.
+ *
+ * @param x, y       The pixel to start from.
+ * @param bounds     The area the fill may not leave.
+ * @param color      The color passed on to hLineProc.
+ * @param insideProc insideProc(x, y, data) tells whether a pixel belongs to the
+ *                   area and still has to be filled. It must return false for
+ *                   the pixels hLineProc already filled.
+ * @param hLineProc  Fills a span of the area, as for the primitives above.
+ */
+void floodFill(int x, int y, const Common::Rect &bounds, int color, bool (*insideProc)(int, int, void *),
+								void (*hLineProc)(int, int, int, int, void *), void *data);
+
 } // End of namespace Graphics
 
 #endif
@@ -135,6 +135,9 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+#ifdef HQX_USE_SIMD
+		uint8 patterns[kHQPatternChunk];
+#endif
 		int tmpWidth = width;
 		while (tmpWidth--) {
 			p++;
@@ -143,6 +146,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
+#ifdef HQX_USE_SIMD
+			const int x = width - 1 - tmpWidth;
+			if (x % kHQPatternChunk == 0)
+				computeHQPatterns(p - 1, nextlineSrc, MIN<int>(kHQPatternChunk, width - x), patterns);
+			const int pattern = patterns[x % kHQPatternChunk];
+#else
 			int pattern = 0;
 			const int yuv5 = YUV(5);
 			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
@@ -153,6 +162,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
 			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
 			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+#endif
 
 			switch (pattern) {
 			case 0:
@@ -0,0 +1,219 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/scaler/intern.h"
+
+#ifdef HQX_USE_SIMD
+
+#if defined(HQX_USE_SSE2)
+#include <emmintrin.h>
+#elif defined(HQX_USE_NEON)
+#include <arm_neon.h>
+#endif
+
+extern "C" uint32 *RGBtoYUV;
+extern int gBitFormat;
+
+namespace {
+
+#if defined(HQX_USE_SSE2)
+typedef __m128i PixelVector;
+
+static inline PixelVector load(const uint16 *src) {
+	return _mm_loadu_si128((const __m128i *)src);
+}
+
+static inline PixelVector splat(int16 value) {
+	return _mm_set1_epi16(value);
+}
+
+static inline PixelVector add(PixelVector a, PixelVector b) {
+	return _mm_add_epi16(a, b);
+}
+
+static inline PixelVector sub(PixelVector a, PixelVector b) {
+	return _mm_sub_epi16(a, b);
+}
+
+static inline PixelVector bitAnd(PixelVector a, PixelVector b) {
+	return _mm_and_si128(a, b);
+}
+
+static inline PixelVector bitOr(PixelVector a, PixelVector b) {
+	return _mm_or_si128(a, b);
+}
+
+template<int shift>
+static inline PixelVector shiftLeft(PixelVector a) {
+	return _mm_slli_epi16(a, shift);
+}
+
+template<int shift>
+static inline PixelVector shiftRight(PixelVector a) {
+	return _mm_srli_epi16(a, shift);
+}
+
+template<int shift>
+static inline PixelVector shiftRightSigned(PixelVector a) {
+	return _mm_srai_epi16(a, shift);
+}
+
+/** All bits set in the lanes where |a - b| > threshold. */
+static inline PixelVector absDiffGreater(PixelVector a, PixelVector b, PixelVector threshold) {
+	const PixelVector diff = _mm_sub_epi16(a, b);
+	return _mm_cmpgt_epi16(_mm_max_epi16(diff, _mm_sub_epi16(_mm_setzero_si128(), diff)), threshold);
+}
+
+static inline void storePatterns(uint8 *dst, PixelVector patterns) {
+	_mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(patterns, patterns));
+}
+#elif defined(HQX_USE_NEON)
+typedef int16x8_t PixelVector;
+
+static inline PixelVector load(const uint16 *src) {
+	return vreinterpretq_s16_u16(vld1q_u16(src));
+}
+
+static inline PixelVector splat(int16 value) {
+	return vdupq_n_s16(value);
+}
+
+static inline PixelVector add(PixelVector a, PixelVector b) {
+	return vaddq_s16(a, b);
+}
+
+static inline PixelVector sub(PixelVector a, PixelVector b) {
+	return vsubq_s16(a, b);
+}
+
+static inline PixelVector bitAnd(PixelVector a, PixelVector b) {
+	return vandq_s16(a, b);
+}
+
+static inline PixelVector bitOr(PixelVector a, PixelVector b) {
+	return vorrq_s16(a, b);
+}
+
+template<int shift>
+static inline PixelVector shiftLeft(PixelVector a) {
+	return vshlq_n_s16(a, shift);
+}
+
+template<int shift>
+static inline PixelVector shiftRight(PixelVector a) {
+	return vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(a), shift));
+}
+
+template<int shift>
+static inline PixelVector shiftRightSigned(PixelVector a) {
+	return vshrq_n_s16(a, shift);
+}
+
+static inline PixelVector absDiffGreater(PixelVector a, PixelVector b, PixelVector threshold) {
+	return vreinterpretq_s16_u16(vcgtq_s16(vabdq_s16(a, b), threshold));
+}
+
+static inline void storePatterns(uint8 *dst, PixelVector patterns) {
+	vst1_u8(dst, vqmovun_s16(patterns));
+}
+#endif
+
+/** Expand a 5 or 6 bit component to 8 bits, as PixelFormat::colorToRGB() does. */
+template<int bits>
+static inline PixelVector expand(PixelVector value) {
+	return bitOr(shiftLeft<8 - bits>(value), shiftRight<2 * bits - 8>(value));
+}
+
+/**
+ * The YUV components of eight pixels, as computed by InitLUT(), without the
+ * offset of 128 of the chroma, which does not matter for the differences.
+ */
+struct YUVVector {
+	PixelVector y, u, v;
+};
+
+template<int greenBits>
+static inline YUVVector toYUV(const uint16 *src) {
+	const PixelVector pixels = load(src);
+	const PixelVector mask5 = splat(0x1F);
+	const PixelVector r = expand<5>(bitAnd(shiftRight<5 + greenBits>(pixels), mask5));
+	const PixelVector g = expand<greenBits>(bitAnd(shiftRight<5>(pixels), splat((1 << greenBits) - 1)));
+	const PixelVector b = expand<5>(bitAnd(pixels, mask5));
+
+	YUVVector yuv;
+	yuv.y = shiftRight<2>(add(add(r, g), b));
+	yuv.u = shiftRightSigned<2>(sub(r, b));
+	yuv.v = shiftRightSigned<3>(sub(sub(shiftLeft<1>(g), r), b));
+	return yuv;
+}
+
+/** The same test as diffYUV(), for eight pixels at once. */
+static inline PixelVector diffYUVVector(const YUVVector &a, const YUVVector &b) {
+	return bitOr(absDiffGreater(a.y, b.y, splat(0x30)),
+		bitOr(absDiffGreater(a.u, b.u, splat(0x7)), absDiffGreater(a.v, b.v, splat(0x6))));
+}
+
+template<int greenBits>
+static int computePatternsVector(const uint16 *src, uint32 nextlineSrc, int width, uint8 *patterns) {
+	// The neighbours, in the order of the pattern bits
+	const int offsets[8] = {
+		-1 - (int)nextlineSrc, -(int)nextlineSrc, 1 - (int)nextlineSrc,
+		-1, 1,
+		-1 + (int)nextlineSrc, (int)nextlineSrc, 1 + (int)nextlineSrc
+	};
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const YUVVector center = toYUV<greenBits>(src + x);
+		PixelVector pattern = splat(0);
+		for (int i = 0; i < 8; ++i)
+			pattern = bitOr(pattern, bitAnd(diffYUVVector(center, toYUV<greenBits>(src + x + offsets[i])), splat(1 << i)));
+		storePatterns(patterns + x, pattern);
+	}
+	return x;
+}
+
+} // End of anonymous namespace
+
+void computeHQPatterns(const uint16 *src, uint32 nextlineSrc, int width, uint8 *patterns) {
+	int x = gBitFormat == 565 ? computePatternsVector<6>(src, nextlineSrc, width, patterns)
+	                          : computePatternsVector<5>(src, nextlineSrc, width, patterns);
+
+	for (; x < width; ++x) {
+		const uint16 *p = src + x;
+		const int w5 = *p;
+		const int yuv5 = RGBtoYUV[w5];
+		const int neighbours[8] = {
+			*(p - 1 - nextlineSrc), *(p - nextlineSrc), *(p + 1 - nextlineSrc),
+			*(p - 1), *(p + 1),
+			*(p - 1 + nextlineSrc), *(p + nextlineSrc), *(p + 1 + nextlineSrc)
+		};
+		int pattern = 0;
+		for (int i = 0; i < 8; ++i) {
+			if (w5 != neighbours[i] && diffYUV(yuv5, RGBtoYUV[neighbours[i]]))
+				pattern |= 1 << i;
+		}
+		patterns[x] = pattern;
+	}
+}
+
+#endif
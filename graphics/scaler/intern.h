@@ -24,8 +24,35 @@
 #define GRAPHICS_SCALER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/util.h"
 #include "graphics/colormasks.h"
 
+// The assembly versions of the HQ scalers do not use the C pattern code
+#if defined(USE_HQ_SCALERS) && !defined(USE_NASM)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HQX_USE_SSE2
+#elif defined(__ARM_NEON)
+#define HQX_USE_NEON
+#endif
+
+#if defined(HQX_USE_SSE2) || defined(HQX_USE_NEON)
+#define HQX_USE_SIMD
+
+/** Number of pixels the HQ scalers compute the patterns of in one go. */
+enum {
+	kHQPatternChunk = 32
+};
+
+/**
+ * Compute the neighbour patterns of the HQ scalers for @p width pixels of
+ * a row, as in the C versions: bit n is set if the nth neighbour (in the
+ * order w1, w2, w3, w4, w6, w7, w8, w9) differs from the pixel according
+ * to diffYUV(). Uses the format of the scalers, set by InitScalers().
+ */
+void computeHQPatterns(const uint16 *src, uint32 nextlineSrc, int width, uint8 *patterns);
+#endif
+#endif
+
 
 /**
  * Interpolate two 16 bit pixel *pairs* at once with equal weights 1.
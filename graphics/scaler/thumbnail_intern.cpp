@@ -29,6 +29,72 @@
 #include "graphics/scaler/intern.h"
 #include "graphics/palette.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define THUMBNAIL_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define THUMBNAIL_USE_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef THUMBNAIL_USE_SSE2
+/**
+ * Given one color channel of two lines of 8 pixels, each in a 16-bit lane,
+ * return the average of each 2x2 block, rounded down, in 32-bit lanes.
+ */
+static inline __m128i averageBlocks(__m128i line1, __m128i line2) {
+	const __m128i sum = _mm_add_epi16(line1, line2);
+	const __m128i blocks = _mm_add_epi32(_mm_and_si128(sum, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(sum, 16));
+	return _mm_srli_epi32(blocks, 2);
+}
+
+/**
+ * Average the 2x2 blocks of 565 pixels of two lines of 16 pixels.
+ */
+static inline __m128i quadBlockInterpolate565(const uint8 *src, uint32 srcPitch) {
+	const __m128i mask6 = _mm_set1_epi16(0x3F);
+	const __m128i mask5 = _mm_set1_epi16(0x1F);
+	__m128i r[2], g[2], b[2];
+
+	for (int i = 0; i < 2; ++i) {
+		const __m128i line1 = _mm_loadu_si128((const __m128i *)(src + i * 16));
+		const __m128i line2 = _mm_loadu_si128((const __m128i *)(src + srcPitch + i * 16));
+
+		r[i] = averageBlocks(_mm_srli_epi16(line1, 11), _mm_srli_epi16(line2, 11));
+		g[i] = averageBlocks(_mm_and_si128(_mm_srli_epi16(line1, 5), mask6), _mm_and_si128(_mm_srli_epi16(line2, 5), mask6));
+		b[i] = averageBlocks(_mm_and_si128(line1, mask5), _mm_and_si128(line2, mask5));
+	}
+
+	// The averages fit in 16 bits, so packing them with signed saturation is exact
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_packs_epi32(r[0], r[1]), 11),
+	                                 _mm_slli_epi16(_mm_packs_epi32(g[0], g[1]), 5)),
+	                    _mm_packs_epi32(b[0], b[1]));
+}
+#elif defined(THUMBNAIL_USE_NEON)
+static inline uint16x4_t averageBlocks(uint16x8_t line1, uint16x8_t line2) {
+	return vmovn_u32(vshrq_n_u32(vpaddlq_u16(vaddq_u16(line1, line2)), 2));
+}
+
+static inline uint16x8_t quadBlockInterpolate565(const uint8 *src, uint32 srcPitch) {
+	const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+	const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+	uint16x4_t r[2], g[2], b[2];
+
+	for (int i = 0; i < 2; ++i) {
+		const uint16x8_t line1 = vld1q_u16((const uint16 *)(src + i * 16));
+		const uint16x8_t line2 = vld1q_u16((const uint16 *)(src + srcPitch + i * 16));
+
+		r[i] = averageBlocks(vshrq_n_u16(line1, 11), vshrq_n_u16(line2, 11));
+		g[i] = averageBlocks(vandq_u16(vshrq_n_u16(line1, 5), mask6), vandq_u16(vshrq_n_u16(line2, 5), mask6));
+		b[i] = averageBlocks(vandq_u16(line1, mask5), vandq_u16(line2, mask5));
+	}
+
+	return vorrq_u16(vorrq_u16(vshlq_n_u16(vcombine_u16(r[0], r[1]), 11),
+	                           vshlq_n_u16(vcombine_u16(g[0], g[1]), 5)),
+	                 vcombine_u16(b[0], b[1]));
+}
+#endif
+
 template<int bitFormat>
 uint16 quadBlockInterpolate(const uint8 *src, uint32 srcPitch) {
 	uint16 colorx1y1 = *(((const uint16 *)src));
@@ -47,7 +113,22 @@ void createThumbnail_2(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32
 	height &= ~1;
 
 	for (int y = 0; y < height; y += 2) {
-		for (int x = 0; x < width; x += 2, dstPtr += 2) {
+		int x = 0;
+#if defined(THUMBNAIL_USE_SSE2) || defined(THUMBNAIL_USE_NEON)
+		// Eight blocks at once. This gives the same result as quadBlockInterpolate, which
+		// averages each channel rounding down. The thumbnails are scaled in place, but the
+		// pixels written are always left of or above the ones still to read.
+		if (bitFormat == 565) {
+			for (; x + 16 <= width; x += 16, dstPtr += 16) {
+#ifdef THUMBNAIL_USE_SSE2
+				_mm_storeu_si128((__m128i *)dstPtr, quadBlockInterpolate565(src + 2 * x, srcPitch));
+#else
+				vst1q_u16((uint16 *)dstPtr, quadBlockInterpolate565(src + 2 * x, srcPitch));
+#endif
+			}
+		}
+#endif
+		for (; x < width; x += 2, dstPtr += 2) {
 			*((uint16 *)dstPtr) = quadBlockInterpolate<bitFormat>(src + 2 * x, srcPitch);
 		}
 		dstPtr += (dstPitch - 2 * width / 2);
@@ -55,33 +136,9 @@ void createThumbnail_2(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32
 	}
 }
 
-template<int bitFormat>
-void createThumbnail_4(const uint8 *src, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
-	// Make sure the width and height is a multiple of 4
-	width &= ~3;
-	height &= ~3;
-
-	for (int y = 0; y < height; y += 4) {
-		for (int x = 0; x < width; x += 4, dstPtr += 2) {
-			uint16 upleft = quadBlockInterpolate<bitFormat>(src + 2 * x, srcPitch);
-			uint16 upright = quadBlockInterpolate<bitFormat>(src + 2 * (x + 2), srcPitch);
-			uint16 downleft = quadBlockInterpolate<bitFormat>(src + srcPitch * 2 + 2 * x, srcPitch);
-			uint16 downright = quadBlockInterpolate<bitFormat>(src + srcPitch * 2 + 2 * (x + 2), srcPitch);
-
-			*((uint16 *)dstPtr) = interpolate16_1_1_1_1<Graphics::ColorMasks<bitFormat> >(upleft, upright, downleft, downright);
-		}
-		dstPtr += (dstPitch - 2 * width / 4);
-		src += 4 * srcPitch;
-	}
-}
-
 static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
-	while (in.w / out.w >= 4 || in.h / out.h >= 4) {
-		createThumbnail_4<565>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
-		in.w /= 4;
-		in.h /= 4;
-	}
-
+	// Reducing by 4 is the same as reducing by 2 twice, the averages of the
+	// 2x2 blocks are rounded down in both cases
 	while (in.w / out.w >= 2 || in.h / out.h >= 2) {
 		createThumbnail_2<565>((const uint8 *)in.getPixels(), in.pitch, (uint8 *)in.getPixels(), in.pitch, in.w, in.h);
 		in.w /= 2;
@@ -160,6 +217,14 @@ static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
 }
 
 
+/**
+ * Converts a 256 color palette to RGB565, so that the pixels can be converted with a lookup.
+ */
+static void createColorTable565(const byte *palette, uint16 *colors) {
+	for (int i = 0; i < 256; ++i)
+		colors[i] = Graphics::RGBToColor<Graphics::ColorMasks<565> >(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+}
+
 /**
  * Copies the current screen contents to a new surface, using RGB565 format.
  * WARNING: surf->free() must be called by the user to avoid leaking.
@@ -179,36 +244,35 @@ static bool grabScreen565(Graphics::Surface *surf) {
 
 	surf->create(screen->w, screen->h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	byte *palette = 0;
 	if (screenFormat.bytesPerPixel == 1) {
-		palette = new byte[256 * 3];
-		assert(palette);
+		byte palette[256 * 3];
 		g_system->getPaletteManager()->grabPalette(palette, 0, 256);
-	}
 
-	for (uint y = 0; y < screen->h; ++y) {
-		for (uint x = 0; x < screen->w; ++x) {
-			byte r = 0, g = 0, b = 0;
-
-			if (screenFormat.bytesPerPixel == 1) {
-				uint8 pixel = *(uint8 *)screen->getBasePtr(x, y);
-				r = palette[pixel * 3 + 0];
-				g = palette[pixel * 3 + 1];
-				b = palette[pixel * 3 + 2];
-			} else if (screenFormat.bytesPerPixel == 2) {
-				uint16 col = READ_UINT16(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			} else if (screenFormat.bytesPerPixel == 4) {
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
+		uint16 colors[256];
+		createColorTable565(palette, colors);
+
+		for (uint y = 0; y < screen->h; ++y) {
+			const uint8 *src = (const uint8 *)screen->getBasePtr(0, y);
+			uint16 *dst = (uint16 *)surf->getBasePtr(0, y);
+			for (uint x = 0; x < screen->w; ++x)
+				dst[x] = colors[src[x]];
+		}
+	} else if (screenFormat == surf->format) {
+		for (uint y = 0; y < screen->h; ++y)
+			memcpy(surf->getBasePtr(0, y), screen->getBasePtr(0, y), screen->w * 2);
+	} else {
+		for (uint y = 0; y < screen->h; ++y) {
+			const byte *src = (const byte *)screen->getBasePtr(0, y);
+			uint16 *dst = (uint16 *)surf->getBasePtr(0, y);
+			for (uint x = 0; x < screen->w; ++x, src += screenFormat.bytesPerPixel) {
+				const uint32 col = screenFormat.bytesPerPixel == 2 ? READ_UINT16(src) : READ_UINT32(src);
+				byte r, g, b;
 				screenFormat.colorToRGB(col, r, g, b);
+				dst[x] = Graphics::RGBToColor<Graphics::ColorMasks<565> >(r, g, b);
 			}
-
-			*((uint16 *)surf->getBasePtr(x, y)) = Graphics::RGBToColor<Graphics::ColorMasks<565> >(r, g, b);
 		}
 	}
 
-	delete[] palette;
-
 	g_system->unlockScreen();
 	return true;
 }
@@ -244,15 +308,13 @@ bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h,
 	Graphics::Surface screen;
 	screen.create(w, h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	for (uint y = 0; y < screen.h; ++y) {
-		for (uint x = 0; x < screen.w; ++x) {
-			byte r, g, b;
-			r = palette[pixels[y * w + x] * 3];
-			g = palette[pixels[y * w + x] * 3 + 1];
-			b = palette[pixels[y * w + x] * 3 + 2];
+	uint16 colors[256];
+	createColorTable565(palette, colors);
 
-			*((uint16 *)screen.getBasePtr(x, y)) = Graphics::RGBToColor<Graphics::ColorMasks<565> >(r, g, b);
-		}
+	for (uint y = 0; y < screen.h; ++y) {
+		uint16 *dst = (uint16 *)screen.getBasePtr(0, y);
+		for (uint x = 0; x < screen.w; ++x)
+			dst[x] = colors[pixels[y * w + x]];
 	}
 
 	return createThumbnail(*surf, screen);
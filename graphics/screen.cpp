@@ -27,30 +27,23 @@
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+Screen::Screen(): ManagedSurface(), _pixelsUploaded(0) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(), _pixelsUploaded(0) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(), _pixelsUploaded(0) {
 	create(width, height, pixelFormat);
 }
 
 void Screen::update() {
-	// Merge the dirty rects
-	mergeDirtyRects();
-
-	// Loop through copying dirty areas to the physical screen
-	Common::List<Common::Rect>::iterator i;
-	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
-		const Common::Rect &r = *i;
-		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
-		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
-			r.width(), r.height());
-	}
+	// Copy the dirty areas to the physical screen
+	if (!_dirtyRects.empty())
+		g_system->copyRectsToScreen(getPixels(), pitch, _dirtyRects.data(), _dirtyRects.size());
+	_pixelsUploaded = _dirtyRects.getArea();
 
 	// Signal the physical screen to update
 	updateScreen();
@@ -68,35 +61,13 @@ void Screen::addDirtyRect(const Common::Rect &r) {
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
 	if (bounds.width() > 0 && bounds.height() > 0)
-		_dirtyRects.push_back(bounds);
+		_dirtyRects.add(bounds);
 }
 
 void Screen::makeAllDirty() {
 	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
-void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
-
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
-
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
-
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
-
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
-	}
-}
-
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
 	destRect = src1;
 	destRect.extend(src2);
@@ -23,9 +23,9 @@
 #ifndef GRAPHICS_SCREEN_H
 #define GRAPHICS_SCREEN_H
 
+#include "graphics/dirty_rects.h"
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
-#include "common/list.h"
 #include "common/rect.h"
 
 namespace Graphics {
@@ -53,12 +53,19 @@ protected:
 	/**
 	 * List of affected areas of the screen
 	 */
-	Common::List<Common::Rect> _dirtyRects;
+	DirtyRectList _dirtyRects;
+
+	/**
+	 * Number of pixels copied to the system by the last update
+	 */
+	uint32 _pixelsUploaded;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Merges together overlapping dirty areas of the screen. The list
+	 * merges the areas as they are added, this is kept for the engines
+	 * calling it before going through the list.
 	 */
-	void mergeDirtyRects();
+	void mergeDirtyRects() {}
 
 	/**
 	 * Returns the union of two dirty area rectangles
@@ -96,6 +103,11 @@ public:
 	 */
 	virtual void update();
 
+	/**
+	 * Returns the number of pixels the last update copied to the system
+	 */
+	uint32 getPixelsUploaded() const { return _pixelsUploaded; }
+
 	/**
 	 * Updates the screen at the end of an update call
 	 */
@@ -411,26 +411,11 @@ void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette
 	if (format.bytesPerPixel == 1) {
 		assert(palette);
 
-		for (int y = h; y > 0; --y) {
-			const byte *srcRow = (const byte *)pixels + y * pitch - 1;
-			byte *dstRow = (byte *)pixels + y * w * dstFormat.bytesPerPixel - dstFormat.bytesPerPixel;
-
-			for (int x = 0; x < w; x++) {
-				byte index = *srcRow--;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
+		uint32 map[256];
+		for (int i = 0; i < 256; ++i)
+			map[i] = dstFormat.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
 
-				if (dstFormat.bytesPerPixel == 2)
-					*((uint16 *)dstRow) = color;
-				else
-					*((uint32 *)dstRow) = color;
-
-				dstRow -= dstFormat.bytesPerPixel;
-			}
-		}
+		crossBlitMap((byte *)pixels, (const byte *)pixels, w * dstFormat.bytesPerPixel, pitch, w, h, dstFormat.bytesPerPixel, map);
 	} else {
 		crossBlit((byte *)pixels, (const byte *)pixels, w * dstFormat.bytesPerPixel, pitch, w, h, dstFormat, format);
 	}
@@ -472,6 +457,13 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 		// Converting from paletted to high color
 		assert(palette);
 
+		uint32 map[256];
+		for (int i = 0; i < 256; ++i)
+			map[i] = dstFormat.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+
+		if (crossBlitMap((byte *)surface->getPixels(), (const byte *)getPixels(), surface->pitch, pitch, w, h, dstFormat.bytesPerPixel, map))
+			return surface;
+
 		for (int y = 0; y < h; y++) {
 			const byte *srcRow = (const byte *)getBasePtr(0, y);
 			byte *dstRow = (byte *)surface->getBasePtr(0, y);
@@ -496,6 +488,11 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 		}
 	} else {
 		// Converting from high color to high color
+		if (dstFormat.bytesPerPixel != 3 && format.bytesPerPixel != 3) {
+			crossBlit((byte *)surface->getPixels(), (const byte *)getPixels(), surface->pitch, pitch, w, h, dstFormat, format);
+			return surface;
+		}
+
 		for (int y = 0; y < h; y++) {
 			const byte *srcRow = (const byte *)getBasePtr(0, y);
 			byte *dstRow = (byte *)surface->getBasePtr(0, y);
@@ -614,14 +611,50 @@ void FloodFill::addSeed(int x, int y) {
 	}
 }
 
+bool FloodFill::isFillable(int x, int y, void *data) {
+	FloodFill *ff = (FloodFill *)data;
+
+	if (x < 0 || x >= ff->_w || y < 0 || y >= ff->_h || ff->_visited[y * ff->_w + x])
+		return false;
+
+	const void *src = ff->_surface->getBasePtr(x, y);
+
+	if (ff->_surface->format.bytesPerPixel == 1)
+		return *((const byte *)src) == ff->_oldColor;
+	else if (ff->_surface->format.bytesPerPixel == 2)
+		return READ_UINT16(src) == ff->_oldColor;
+	else if (ff->_surface->format.bytesPerPixel == 4)
+		return READ_UINT32(src) == ff->_oldColor;
+
+	error("Unsupported bpp in FloodFill");
+}
+
+void FloodFill::fillSpan(int x1, int x2, int y, int color, void *data) {
+	FloodFill *ff = (FloodFill *)data;
+	Surface *dst = ff->_maskMode ? ff->_mask : ff->_surface;
+	const int bpp = ff->_surface->format.bytesPerPixel;
+
+	memset(ff->_visited + y * ff->_w + x1, 1, x2 - x1 + 1);
+
+	if (bpp == 1)
+		memset(dst->getBasePtr(x1, y), ff->_maskMode ? 255 : ff->_fillColor, x2 - x1 + 1);
+	else if (bpp == 2)
+		Common::fill((uint16 *)dst->getBasePtr(x1, y), (uint16 *)dst->getBasePtr(x2 + 1, y), (uint16)(ff->_maskMode ? 0xffff : ff->_fillColor));
+	else
+		Common::fill((uint32 *)dst->getBasePtr(x1, y), (uint32 *)dst->getBasePtr(x2 + 1, y), ff->_maskMode ? 0xffffffff : ff->_fillColor);
+}
+
 void FloodFill::fill() {
+	// The seeds are filled already, the scanline fill takes care of the area around them
+	const Common::Rect bounds(_w, _h);
+
 	while (!_queue.empty()) {
 		Common::Point *p = _queue.front();
 		_queue.pop_front();
-		addSeed(p->x    , p->y - 1);
-		addSeed(p->x - 1, p->y    );
-		addSeed(p->x    , p->y + 1);
-		addSeed(p->x + 1, p->y    );
+		Graphics::floodFill(p->x    , p->y - 1, bounds, _fillColor, isFillable, fillSpan, this);
+		Graphics::floodFill(p->x - 1, p->y    , bounds, _fillColor, isFillable, fillSpan, this);
+		Graphics::floodFill(p->x    , p->y + 1, bounds, _fillColor, isFillable, fillSpan, this);
+		Graphics::floodFill(p->x + 1, p->y    , bounds, _fillColor, isFillable, fillSpan, this);
 
 		delete p;
 	}
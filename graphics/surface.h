@@ -438,6 +438,9 @@ public:
 	Surface *getMask() { return _mask; }
 
 private:
+	static bool isFillable(int x, int y, void *data);
+	static void fillSpan(int x1, int x2, int y, int color, void *data);
+
 	Common::List<Common::Point *> _queue;
 	Surface *_surface;
 	Surface *_mask;
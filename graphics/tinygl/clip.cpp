@@ -379,6 +379,30 @@ void gl_draw_triangle_select(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex
 int count_triangles, count_triangles_textured, count_pixels;
 #endif
 
+// Pick the mipmap level whose texels are the closest to the size of a pixel,
+// from the area the triangle covers in the texture and on screen.
+static const Graphics::TexelBuffer *getTriangleTexture(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2) {
+	const GLImage *images = c->current_texture->images;
+	if (!images[1].pixmap || !images[0].pixmap)
+		return images[0].pixmap;
+
+	const float screenArea = fabs((float)(p1->zp.x - p0->zp.x) * (p2->zp.y - p0->zp.y) -
+	                              (float)(p2->zp.x - p0->zp.x) * (p1->zp.y - p0->zp.y));
+	const float texelArea = fabs((p1->tex_coord.X - p0->tex_coord.X) * (p2->tex_coord.Y - p0->tex_coord.Y) -
+	                             (p2->tex_coord.X - p0->tex_coord.X) * (p1->tex_coord.Y - p0->tex_coord.Y)) *
+	                        images[0].pixmap->getWidth() * images[0].pixmap->getHeight();
+	// Each level has a quarter of the texels of the previous one. The level
+	// is rounded to the nearest, so the next one is taken from twice as many
+	// texels as pixels.
+	float threshold = MAX(screenArea, 1.0f) * 2;
+	int level = 0;
+	while (level + 1 < MAX_TEXTURE_LEVELS && images[level + 1].pixmap && texelArea >= threshold) {
+		level++;
+		threshold *= 4;
+	}
+	return images[level].pixmap;
+}
+
 void gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2) {
 #ifdef TINYGL_PROFILE
 	{
@@ -411,7 +435,7 @@ void gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p
 #ifdef TINYGL_PROFILE
 		count_triangles_textured++;
 #endif
-		c->fb->setTexture(c->current_texture->images[0].pixmap, c->texture_wrap_s, c->texture_wrap_t);
+		c->fb->setTexture(getTriangleTexture(c, p0, p1, p2), c->texture_wrap_s, c->texture_wrap_t);
 		if (c->current_shade_model == TGL_SMOOTH) {
 			c->fb->fillTriangleTextureMappingPerspectiveSmooth(&p0->zp, &p1->zp, &p2->zp);
 		} else {
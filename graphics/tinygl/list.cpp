@@ -31,6 +31,8 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_fputc
 #define FORBIDDEN_SYMBOL_EXCEPTION_stderr
 
+#include "common/threadpool.h"
+
 #include "graphics/tinygl/zgl.h"
 
 namespace TinyGL {
@@ -53,10 +55,28 @@ static int op_table_size[] = {
 #include "graphics/tinygl/opinfo.h"
 };
 
+#ifndef THREADPOOL_SERIAL_ONLY
+// Set while a worker thread replays the draw calls of a tile, see zdirtyrect.cpp
+static thread_local GLContext *t_threadContext = nullptr;
+
+GLContext *gl_get_context() {
+	GLContext *c = t_threadContext;
+	return c ? c : gl_ctx;
+}
+
+void gl_set_thread_context(GLContext *c) {
+	t_threadContext = c;
+}
+#else
 GLContext *gl_get_context() {
 	return gl_ctx;
 }
 
+void gl_set_thread_context(GLContext *c) {
+	assert(!c);
+}
+#endif
+
 static GLList *find_list(GLContext *c, unsigned int list) {
 	return c->shared_state.lists[list];
 }
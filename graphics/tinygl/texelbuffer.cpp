@@ -37,6 +37,7 @@ TexelBuffer::TexelBuffer(unsigned int width, unsigned int height, unsigned int t
 
 	_width = width;
 	_height = height;
+	_blocksPerRow = (width + 3) >> 2;
 	_fracTextureUnit = textureSize << ZB_POINT_ST_FRAC_BITS;
 	_fracTextureMask = _fracTextureUnit - 1;
 	_widthRatio = (float) width / textureSize;
@@ -71,7 +72,7 @@ void TexelBuffer::getARGBAt(
 	x = wrap(wrap_s, s, _fracTextureUnit, _fracTextureMask) * _widthRatio;
 	y = wrap(wrap_t, t, _fracTextureUnit, _fracTextureMask) * _heightRatio;
 	getARGBAt(
-		(x >> ZB_POINT_ST_FRAC_BITS) + (y >> ZB_POINT_ST_FRAC_BITS) * _width,
+		getTexelIndex(x >> ZB_POINT_ST_FRAC_BITS, y >> ZB_POINT_ST_FRAC_BITS),
 		x & ZB_POINT_ST_FRAC_MASK, y & ZB_POINT_ST_FRAC_MASK,
 		a, r, g, b
 	);
@@ -79,9 +80,11 @@ void TexelBuffer::getARGBAt(
 
 // Nearest: store texture in original size.
 NearestTexelBuffer::NearestTexelBuffer(const PixelBuffer &buf, unsigned int width, unsigned int height, unsigned int textureSize) : TexelBuffer(width, height, textureSize) {
-	unsigned int pixel_count = _width * _height;
-	_buf = PixelBuffer(buf.getFormat(), pixel_count, DisposeAfterUse::NO);
-	_buf.copyBuffer(0, pixel_count, buf);
+	_buf = PixelBuffer(buf.getFormat(), getTexelCount(), DisposeAfterUse::NO);
+	for (unsigned int y = 0; y < _height; y++) {
+		for (unsigned int x = 0; x < _width; x++)
+			_buf.setPixelAt(getTexelIndex(x, y), buf, y * _width + x);
+	}
 }
 
 NearestTexelBuffer::~NearestTexelBuffer() {
@@ -117,9 +120,10 @@ BilinearTexelBuffer::BilinearTexelBuffer(const PixelBuffer &buf, unsigned int wi
 	uint8 *texel8;
 	uint32 *texel32;
 
-	texel32 = _texels = new uint32[_width * _height << PIXEL_PER_TEXEL_SHIFT];
+	_texels = new uint32[getTexelCount() << PIXEL_PER_TEXEL_SHIFT];
 	for (unsigned int y = 0; y < _height; y++) {
 		for (unsigned int x = 0; x < _width; x++) {
+			texel32 = _texels + (getTexelIndex(x, y) << PIXEL_PER_TEXEL_SHIFT);
 			texel8 = (uint8 *)texel32;
 			pixel11_offset = pixel00_offset + _width + 1;
 			buf.getARGBAt(
@@ -160,7 +164,6 @@ BilinearTexelBuffer::BilinearTexelBuffer(const PixelBuffer &buf, unsigned int wi
 				*(texel8 + P11_OFFSET + G_OFFSET),
 				*(texel8 + P11_OFFSET + B_OFFSET)
 			);
-			texel32 += 1 << PIXEL_PER_TEXEL_SHIFT;
 			pixel00_offset++;
 		}
 	}
@@ -38,13 +38,29 @@ public:
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const;
 
+	unsigned int getWidth() const { return _width; }
+	unsigned int getHeight() const { return _height; }
+
 protected:
 	virtual void getARGBAt(
 		unsigned int pixel,
 		unsigned int ds, unsigned int dt,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const = 0;
+
+	// Texels are stored in blocks of 4x4, so that the texels sampled for
+	// neighbouring pixels are likely to share cache lines whatever the
+	// direction the texture is walked in.
+	unsigned int getTexelIndex(unsigned int x, unsigned int y) const {
+		return (((y >> 2) * _blocksPerRow + (x >> 2)) << 4) | ((y & 3) << 2) | (x & 3);
+	}
+	// The number of texels to allocate, including the padding of the last blocks
+	unsigned int getTexelCount() const {
+		return _blocksPerRow * ((_height + 3) >> 2) << 4;
+	}
+
 	unsigned int _width, _height, _fracTextureUnit, _fracTextureMask;
+	unsigned int _blocksPerRow;
 	float _widthRatio, _heightRatio;
 };
 
@@ -166,6 +166,70 @@ static inline const Graphics::PixelFormat formatType2PixelFormat(TGLuint format,
 	error("TinyGL texture: format 0x%04x and type 0x%04x combination not supported", format, type);
 }
 
+static Graphics::TexelBuffer *createTexelBuffer(const Graphics::PixelBuffer &src, int width, int height, unsigned int textureSize, unsigned int filter) {
+	switch (filter) {
+	case TGL_LINEAR_MIPMAP_NEAREST:
+	case TGL_LINEAR_MIPMAP_LINEAR:
+	case TGL_LINEAR:
+		return new Graphics::BilinearTexelBuffer(
+			src,
+			width, height,
+			textureSize
+		);
+	default:
+		return new Graphics::NearestTexelBuffer(
+			src,
+			width, height,
+			textureSize
+		);
+	}
+}
+
+static bool isMipmapFilter(unsigned int filter) {
+	return filter == TGL_NEAREST_MIPMAP_NEAREST || filter == TGL_NEAREST_MIPMAP_LINEAR ||
+	       filter == TGL_LINEAR_MIPMAP_NEAREST || filter == TGL_LINEAR_MIPMAP_LINEAR;
+}
+
+// Build the levels after the first one, each texel averaging 2x2 texels of
+// the level above. All the levels keep the same virtual texture size, so the
+// texture coordinates do not depend on the level which is sampled.
+static void generateMipmaps(GLContext *c, GLTexture *texture, const Graphics::PixelBuffer &src, int width, int height, unsigned int filter) {
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	// ARGB components of the previous level
+	byte *prev = new byte[width * height * 4];
+	for (int i = 0; i < width * height; i++)
+		src.getARGBAt(i, prev[i * 4], prev[i * 4 + 1], prev[i * 4 + 2], prev[i * 4 + 3]);
+
+	for (int level = 1; level < MAX_TEXTURE_LEVELS && (width > 1 || height > 1); level++) {
+		const int levelWidth = MAX(width >> 1, 1);
+		const int levelHeight = MAX(height >> 1, 1);
+		byte *next = new byte[levelWidth * levelHeight * 4];
+		Graphics::PixelBuffer levelBuf(format, levelWidth * levelHeight, DisposeAfterUse::YES);
+		for (int y = 0; y < levelHeight; y++) {
+			const byte *row0 = prev + (y * 2) * width * 4;
+			const byte *row1 = prev + MIN(y * 2 + 1, height - 1) * width * 4;
+			for (int x = 0; x < levelWidth; x++) {
+				const int x0 = x * 2 * 4, x1 = MIN(x * 2 + 1, width - 1) * 4;
+				byte *texel = next + (y * levelWidth + x) * 4;
+				for (int i = 0; i < 4; i++)
+					texel[i] = (row0[x0 + i] + row0[x1 + i] + row1[x0 + i] + row1[x1 + i] + 2) >> 2;
+				levelBuf.setPixelAt(y * levelWidth + x, texel[0], texel[1], texel[2], texel[3]);
+			}
+		}
+
+		GLImage *im = &texture->images[level];
+		im->xsize = c->_textureSize;
+		im->ysize = c->_textureSize;
+		im->pixmap = createTexelBuffer(levelBuf, levelWidth, levelHeight, c->_textureSize, filter);
+
+		delete[] prev;
+		prev = next;
+		width = levelWidth;
+		height = levelHeight;
+	}
+	delete[] prev;
+}
+
 void glopTexImage2D(GLContext *c, GLParam *p) {
 	int target = p[1].i;
 	int level = p[2].i;
@@ -194,6 +258,13 @@ void glopTexImage2D(GLContext *c, GLParam *p) {
 		delete im->pixmap;
 		im->pixmap = nullptr;
 	}
+	// The generated levels belong to the previous image
+	if (level == 0) {
+		for (int i = 1; i < MAX_TEXTURE_LEVELS; i++) {
+			delete c->current_texture->images[i].pixmap;
+			c->current_texture->images[i].pixmap = nullptr;
+		}
+	}
 	if (pixels != NULL) {
 		unsigned int filter;
 		Graphics::PixelBuffer src(formatType2PixelFormat(format, type), pixels);
@@ -201,24 +272,9 @@ void glopTexImage2D(GLContext *c, GLParam *p) {
 			filter = c->texture_mag_filter;
 		else
 			filter = c->texture_min_filter;
-		switch (filter) {
-		case TGL_LINEAR_MIPMAP_NEAREST:
-		case TGL_LINEAR_MIPMAP_LINEAR:
-		case TGL_LINEAR:
-			im->pixmap = new Graphics::BilinearTexelBuffer(
-				src,
-				width, height,
-				c->_textureSize
-			);
-			break;
-		default:
-			im->pixmap = new Graphics::NearestTexelBuffer(
-				src,
-				width, height,
-				c->_textureSize
-			);
-			break;
-		}
+		im->pixmap = createTexelBuffer(src, width, height, c->_textureSize, filter);
+		if (level == 0 && isMipmapFilter(c->texture_min_filter))
+			generateMipmaps(c, c->current_texture, src, width, height, filter);
 	}
 }
 
@@ -31,6 +31,7 @@
 #include "graphics/tinygl/gl.h"
 #include "common/debug.h"
 #include "common/math.h"
+#include "common/threadpool.h"
 
 namespace TinyGL {
 
@@ -119,6 +120,65 @@ static inline void _appendDirtyRectangle(const Graphics::DrawCall &call, Common:
 		rectangles.push_back(DirtyRectangle(dirty_region, r, g, b));
 }
 
+// Height of the bands the dirty rectangles are split in, to be drawn by the worker threads
+static const int kDrawCallTileHeight = 32;
+
+// Replay the draw calls within one band of a dirty rectangle, on a worker thread.
+// The context and frame buffer are shallow copies of the main ones: they share the
+// pixel and z buffers, textures and blit images, but have their own state and scissor
+// rectangles. Being plain memory copies, they are freed without running destructors.
+static void tglExecuteTile(TinyGL::GLContext *c, const Common::Rect &tile) {
+	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
+
+	GLContext *tileContext = (GLContext *)gl_malloc(sizeof(GLContext));
+	memcpy((void *)tileContext, (const void *)c, sizeof(GLContext));
+	FrameBuffer *tileBuffer = (FrameBuffer *)gl_malloc(sizeof(FrameBuffer));
+	memcpy((void *)tileBuffer, (const void *)c->fb, sizeof(FrameBuffer));
+	tileContext->fb = tileBuffer;
+	// Rasterization writes to the vertices, so each tile works on its own copy of them
+	tileContext->vertex = (GLVertex *)gl_malloc(sizeof(GLVertex) * c->vertex_max);
+
+	gl_set_thread_context(tileContext);
+	for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
+		if (tile.intersects((*it)->getDirtyRegion()))
+			(*it)->execute(tile, true);
+	}
+	gl_set_thread_context(nullptr);
+
+	gl_free(tileContext->vertex);
+	gl_free(tileBuffer);
+	gl_free(tileContext);
+}
+
+// Split the dirty rectangles in horizontal bands, and replay the draw calls of each band
+// on the worker threads. The dirty rectangles do not overlap, so every pixel is drawn by
+// a single band, with the draw calls in the same order as when drawing serially.
+// Returns false if there are no workers, or not enough bands to share between them.
+static bool tglExecuteDrawCallsInTiles(TinyGL::GLContext *c, const Common::List<DirtyRectangle> &rectangles) {
+	typedef Common::List<TinyGL::DirtyRectangle>::const_iterator RectangleIterator;
+
+	if (Common::ThreadPool::instance().getNumWorkers() == 0)
+		return false;
+
+	Common::Array<Common::Rect> tiles;
+	for (RectangleIterator it = rectangles.begin(); it != rectangles.end(); ++it) {
+		const Common::Rect &rect = (*it).rectangle;
+		if (rect.isEmpty())
+			continue;
+		for (int top = rect.top; top < rect.bottom; top += kDrawCallTileHeight)
+			tiles.push_back(Common::Rect(rect.left, top, rect.right, MIN<int>(top + kDrawCallTileHeight, rect.bottom)));
+	}
+	if (tiles.size() < 2)
+		return false;
+
+	const Common::Rect *tileRects = tiles.begin();
+	Common::parallelFor(0, tiles.size(), 1, [c, tileRects](uint begin, uint end) {
+		for (uint i = begin; i < end; ++i)
+			tglExecuteTile(c, tileRects[i]);
+	});
+	return true;
+}
+
 static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<TinyGL::DirtyRectangle>::iterator RectangleIterator;
@@ -195,12 +255,14 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 
 	if (!rectangles.empty()) {
 		// Execute draw calls.
-		for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
-			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
+		if (!tglExecuteDrawCallsInTiles(c, rectangles)) {
+			for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
+				Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+				for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
+					Common::Rect dirtyRegion = (*itRect).rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						(*it)->execute(dirtyRegion, true);
+					}
 				}
 			}
 		}
@@ -345,7 +407,12 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 	TinyGL::GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
-	c->vertex = _vertex;
+	if (c != TinyGL::gl_ctx) {
+		// Drawing a tile on a worker thread, see tglExecuteTile()
+		memcpy((void *)c->vertex, (const void *)_vertex, sizeof(TinyGL::GLVertex) * _vertexCount);
+	} else {
+		c->vertex = _vertex;
+	}
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (TinyGL::gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (TinyGL::gl_draw_triangle_func)_drawTriangleBack;
@@ -693,5 +760,5 @@ bool RasterizationDrawCall::RasterizationState::operator==(const RasterizationSt
 
 void *Internal::allocateFrame(int size) {
 	TinyGL::GLContext *c = TinyGL::gl_get_context();
-	return c->_drawCallAllocator[c->_currentAllocatorIndex].allocate(size);
+	return c->_drawCallAllocator[c->_currentAllocatorIndex].allocate(size, 8);
 }
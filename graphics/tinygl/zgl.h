@@ -32,6 +32,7 @@
 #include "common/util.h"
 #include "common/textconsole.h"
 #include "common/array.h"
+#include "common/framearena.h"
 #include "common/list.h"
 #include "common/scummsys.h"
 
@@ -199,56 +200,6 @@ struct GLSharedState {
 	GLTexture **texture_hash_table;
 };
 
-/**
- * A linear allocator implementation.
- * The allocator can be initialized to a specific buffer size only once.
- * The allocation scheme is pretty simple: pointers are returned relative to a current memory position,
- * the allocator starts with an offset of 0 and increases its offset by the allocated amount every time.
- * Memory is released through the method free(), care has to be taken to call the destructors of the deallocated objects either manually (for complex struct arrays) or
- * by overriding the delete operator (with an empty implementation).
- */
-class LinearAllocator {
-public:
-	LinearAllocator() {
-		_memoryBuffer = nullptr;
-		_memorySize = 0;
-		_memoryPosition = 0;
-	}
-
-	void initialize(size_t newSize) {
-		assert(_memoryBuffer == nullptr);
-		void *newBuffer = gl_malloc(newSize);
-		if (newBuffer == nullptr) {
-			error("Couldn't allocate memory for linear allocator.");
-		}
-		_memoryBuffer = newBuffer;
-		_memorySize = newSize;
-	}
-
-	~LinearAllocator() {
-		if (_memoryBuffer != nullptr) {
-			gl_free(_memoryBuffer);
-		}
-	}
-
-	void *allocate(size_t size) {
-		if (_memoryPosition + size >= _memorySize) {
-			error("Allocator out of memory: couldn't allocate more memory from linear allocator.");
-		}
-		size_t returnPos = _memoryPosition;
-		_memoryPosition += size;
-		return ((char *)_memoryBuffer) + returnPos;
-	}
-
-	void reset() {
-		_memoryPosition = 0;
-	}
-private:
-	void *_memoryBuffer;
-	size_t _memorySize;
-	size_t _memoryPosition;
-};
-
 struct GLContext;
 
 typedef void (*gl_draw_triangle_func)(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2);
@@ -394,8 +345,10 @@ struct GLContext {
 	// Draw call queue
 	Common::List<Graphics::DrawCall *> _drawCallsQueue;
 	Common::List<Graphics::DrawCall *> _previousFrameDrawCallsQueue;
+	// The draw calls of a frame are kept until the next one is presented,
+	// so the allocators of two frames take turns
 	int _currentAllocatorIndex;
-	LinearAllocator _drawCallAllocator[2];
+	Common::FrameArena _drawCallAllocator[2];
 };
 
 extern GLContext *gl_ctx;
@@ -440,6 +393,8 @@ void tglDisposeResources(GLContext *c);
 void tglDisposeDrawCallLists(TinyGL::GLContext *c);
 
 GLContext *gl_get_context();
+// Make gl_get_context() return c on the calling thread, or the global context again if c is nullptr
+void gl_set_thread_context(GLContext *c);
 
 // specular buffer "api"
 GLSpecBuf *specbuf_get_buffer(GLContext *c, const int shininess_i, const float shininess);
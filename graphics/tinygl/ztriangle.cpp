@@ -31,10 +31,149 @@
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TINYGL_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TINYGL_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace TinyGL {
 
 static const int NB_INTERP = 8;
 
+#if defined(TINYGL_USE_SSE2) || defined(TINYGL_USE_NEON)
+
+// The depth tests handled by the vector code, the others are left to the scalar code
+enum SpanDepthTest {
+	kSpanDepthUnsupported,
+	kSpanDepthAlways,
+	kSpanDepthLess,
+	kSpanDepthLessEqual
+};
+
+static SpanDepthTest getSpanDepthTest(bool depthTestEnabled, int depthFunc) {
+	if (!depthTestEnabled || depthFunc == TGL_ALWAYS)
+		return kSpanDepthAlways;
+	if (depthFunc == TGL_LESS)
+		return kSpanDepthLess;
+	if (depthFunc == TGL_LEQUAL)
+		return kSpanDepthLessEqual;
+	return kSpanDepthUnsupported;
+}
+
+#if defined(TINYGL_USE_SSE2)
+typedef __m128i SpanVector;
+
+static inline SpanVector spanSet(uint32 v) { return _mm_set1_epi32(v); }
+static inline SpanVector spanRamp(uint32 v, uint32 step) { return _mm_setr_epi32(v, v + step, v + 2 * step, v + 3 * step); }
+static inline SpanVector spanAdd(SpanVector a, SpanVector b) { return _mm_add_epi32(a, b); }
+static inline SpanVector spanAnd(SpanVector a, SpanVector b) { return _mm_and_si128(a, b); }
+static inline SpanVector spanOr(SpanVector a, SpanVector b) { return _mm_or_si128(a, b); }
+// a & ~b
+static inline SpanVector spanAndNot(SpanVector a, SpanVector b) { return _mm_andnot_si128(b, a); }
+static inline SpanVector spanSelect(SpanVector mask, SpanVector a, SpanVector b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+static inline SpanVector spanLess(SpanVector a, SpanVector b) { return _mm_cmplt_epi32(a, b); }
+static inline SpanVector spanLessUnsigned(SpanVector a, SpanVector b) {
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	return _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+static inline bool spanAny(SpanVector mask) { return _mm_movemask_epi8(mask) != 0; }
+static inline SpanVector spanLoad(const uint32 *p) { return _mm_loadu_si128((const __m128i *)p); }
+static inline void spanStore(uint32 *p, SpanVector v) { _mm_storeu_si128((__m128i *)p, v); }
+static inline SpanVector spanLoad16(const uint16 *p) { return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128()); }
+static inline void spanStore16(uint16 *p, SpanVector v) {
+	// There is no unsigned saturation from 32 to 16 bits, so sign extend the low halves first
+	const __m128i low = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+	_mm_storel_epi64((__m128i *)p, _mm_packs_epi32(low, low));
+}
+#elif defined(TINYGL_USE_NEON)
+typedef uint32x4_t SpanVector;
+
+static inline SpanVector spanSet(uint32 v) { return vdupq_n_u32(v); }
+static inline SpanVector spanRamp(uint32 v, uint32 step) {
+	const uint32 ramp[4] = { v, v + step, v + 2 * step, v + 3 * step };
+	return vld1q_u32(ramp);
+}
+static inline SpanVector spanAdd(SpanVector a, SpanVector b) { return vaddq_u32(a, b); }
+static inline SpanVector spanAnd(SpanVector a, SpanVector b) { return vandq_u32(a, b); }
+static inline SpanVector spanOr(SpanVector a, SpanVector b) { return vorrq_u32(a, b); }
+// a & ~b
+static inline SpanVector spanAndNot(SpanVector a, SpanVector b) { return vbicq_u32(a, b); }
+static inline SpanVector spanSelect(SpanVector mask, SpanVector a, SpanVector b) { return vbslq_u32(mask, a, b); }
+static inline SpanVector spanLess(SpanVector a, SpanVector b) { return vcltq_s32(vreinterpretq_s32_u32(a), vreinterpretq_s32_u32(b)); }
+static inline SpanVector spanLessUnsigned(SpanVector a, SpanVector b) { return vcltq_u32(a, b); }
+static inline bool spanAny(SpanVector mask) {
+	const uint32x2_t halves = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+	return (vget_lane_u32(halves, 0) | vget_lane_u32(halves, 1)) != 0;
+}
+static inline SpanVector spanLoad(const uint32 *p) { return vld1q_u32(p); }
+static inline void spanStore(uint32 *p, SpanVector v) { vst1q_u32(p, v); }
+static inline SpanVector spanLoad16(const uint16 *p) { return vmovl_u16(vld1_u16(p)); }
+static inline void spanStore16(uint16 *p, SpanVector v) { vst1_u16(p, vmovn_u32(v)); }
+#endif
+
+// The pixels of a block of four which are inside the scissor rectangle and pass the
+// depth test. As in FrameBuffer::compareDepth(), the test passes for TGL_LESS if the
+// stored value is less than the new one.
+template <bool kEnableScissor>
+static inline SpanVector spanMask(SpanDepthTest depthTest, const unsigned int *pz, SpanVector z, SpanVector x, SpanVector left, SpanVector right) {
+	SpanVector mask = spanSet(0xFFFFFFFF);
+	if (depthTest == kSpanDepthLess)
+		mask = spanLessUnsigned(spanLoad(pz), z);
+	else if (depthTest == kSpanDepthLessEqual)
+		mask = spanAndNot(mask, spanLessUnsigned(z, spanLoad(pz)));
+	if (kEnableScissor)
+		mask = spanAnd(mask, spanAndNot(spanLess(x, right), spanLess(x, left)));
+	return mask;
+}
+
+// Draw the first pixels of a span with a single color, or only in the z buffer,
+// four at a time. Returns how many were drawn; the rest is left to the scalar code.
+template <bool kDepthOnly, bool kDepthWrite, bool kEnableScissor>
+static int fillSpanFlat(byte *pixels, int bytesPerPixel, unsigned int *pz, int count, int x, unsigned int z, int dzdx,
+                        uint32 color, SpanDepthTest depthTest, const Common::Rect &clip) {
+	const SpanVector zStep = spanSet(4 * dzdx);
+	const SpanVector xStep = spanSet(4);
+	const SpanVector left = spanSet(clip.left);
+	const SpanVector right = spanSet(clip.right);
+	const SpanVector colors = spanSet(color);
+	SpanVector zv = spanRamp(z, dzdx);
+	SpanVector xv = spanRamp(x, 1);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const SpanVector mask = spanMask<kEnableScissor>(depthTest, pz + i, zv, xv, left, right);
+		if (kDepthWrite)
+			spanStore(pz + i, spanSelect(mask, zv, spanLoad(pz + i)));
+		if (!kDepthOnly) {
+			if (bytesPerPixel == 4) {
+				uint32 *p = (uint32 *)pixels + i;
+				spanStore(p, spanSelect(mask, colors, spanLoad(p)));
+			} else {
+				uint16 *p = (uint16 *)pixels + i;
+				spanStore16(p, spanSelect(mask, colors, spanLoad16(p)));
+			}
+		}
+		zv = spanAdd(zv, zStep);
+		xv = spanAdd(xv, xStep);
+	}
+	return i;
+}
+
+// Whether any pixel of a block of eight is inside the scissor rectangle and passes the depth test
+template <bool kEnableScissor>
+static bool isSpanBlockVisible(const unsigned int *pz, int x, unsigned int z, int dzdx, SpanDepthTest depthTest, const Common::Rect &clip) {
+	const SpanVector left = spanSet(clip.left);
+	const SpanVector right = spanSet(clip.right);
+	const SpanVector mask0 = spanMask<kEnableScissor>(depthTest, pz, spanRamp(z, dzdx), spanRamp(x, 1), left, right);
+	const SpanVector mask1 = spanMask<kEnableScissor>(depthTest, pz + 4, spanRamp(z + 4 * dzdx, dzdx), spanRamp(x + 4, 1), left, right);
+	return spanAny(spanOr(mask0, mask1));
+}
+
+#endif
+
 template <bool kDepthWrite, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending>
 FORCEINLINE static void putPixelFlat(FrameBuffer *buffer, int buf, unsigned int *pz, int _a,
                                      int x, int y, unsigned int &z, unsigned int &r, unsigned int &g, unsigned int &b, unsigned int &a, int &dzdx) {
@@ -268,6 +407,10 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		ndtzdx = NB_INTERP * dtzdx;
 	}
 
+#if defined(TINYGL_USE_SSE2) || defined(TINYGL_USE_NEON)
+	const SpanDepthTest spanDepthTest = getSpanDepthTest(_depthTestEnabled, _depthFunc);
+#endif
+
 	if (fz0 > 0) {
 		l1 = p0;
 		l2 = p2;
@@ -360,8 +503,12 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
+			// Scanlines outside of the scissor rectangle are only stepped over,
+			// so that drawing a triangle in horizontal bands stays cheap
+			if (kEnableScissor && y >= _clipRectangle.bottom)
+				return;
 			int x = x1;
-			{
+			if (!kEnableScissor || y >= _clipRectangle.top) {
 				if (kDrawLogic == DRAW_DEPTH_ONLY ||
 						(kDrawLogic == DRAW_FLAT && !(kInterpST || kInterpSTZ))) {
 					int pp;
@@ -381,6 +528,22 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					if (kDrawLogic == DRAW_FLAT) {
 						a = a1;
 					}
+#if defined(TINYGL_USE_SSE2) || defined(TINYGL_USE_NEON)
+					if (kInterpZ && !kAlphaTestEnabled && !kBlendingEnabled && spanDepthTest != kSpanDepthUnsupported &&
+					    (kDrawLogic == DRAW_DEPTH_ONLY || pixelbytes == 2 || pixelbytes == 4)) {
+						uint32 color = 0;
+						if (kDrawLogic == DRAW_FLAT)
+							color = pbuf.getFormat().ARGBToColor(a >> (ZB_POINT_ALPHA_BITS - 8), r >> (ZB_POINT_RED_BITS - 8), g >> (ZB_POINT_GREEN_BITS - 8), b >> (ZB_POINT_BLUE_BITS - 8));
+						const int done = fillSpanFlat<kDrawLogic == DRAW_DEPTH_ONLY, kDepthWrite, kEnableScissor>(pbuf.getRawBuffer(pp), pixelbytes,
+						                                                                                           pz, n + 1, x, z, dzdx, color, spanDepthTest, _clipRectangle);
+						buf += done;
+						pp += done;
+						pz += done;
+						z += done * dzdx;
+						n -= done;
+						x += done;
+					}
+#endif
 					while (n >= 3) {
 						if (kDrawLogic == DRAW_DEPTH_ONLY) {
 							putPixelDepth<kDepthWrite, kEnableScissor>(this, buf, pz, 0, x, y, z, dzdx);
@@ -392,7 +555,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						if (kDrawLogic == DRAW_FLAT) {
 							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 0, x, y, z, r, g, b, a, dzdx);
 							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 1, x, y, z, r, g, b, a, dzdx);
-							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 2, x, y, z, r, g, g, a, dzdx);
+							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 2, x, y, z, r, g, b, a, dzdx);
 							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 3, x, y, z, r, g, b, a, dzdx);
 						}
 						if (kInterpZ) {
@@ -536,9 +699,27 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 							fz += fndzdx;
 							zinv = (float)(1.0 / fz);
 						}
-						for (int _a = 0; _a < NB_INTERP; _a++) {
-							putPixelTextureMappingPerspective<kDepthWrite, kInterpRGB, kDrawLogic == DRAW_SMOOTH, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, texture, wrapS, wrapT,
-							                           pz, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+						bool visible = true;
+#if defined(TINYGL_USE_SSE2) || defined(TINYGL_USE_NEON)
+						// Skip the texture lookups of blocks which are hidden or scissored out
+						if (spanDepthTest != kSpanDepthUnsupported)
+							visible = isSpanBlockVisible<kEnableScissor>(pz, x, z, dzdx, spanDepthTest, _clipRectangle);
+#endif
+						if (visible) {
+							for (int _a = 0; _a < NB_INTERP; _a++) {
+								putPixelTextureMappingPerspective<kDepthWrite, kInterpRGB, kDrawLogic == DRAW_SMOOTH, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, texture, wrapS, wrapT,
+								                           pz, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+							}
+						} else {
+							z += NB_INTERP * dzdx;
+							s += NB_INTERP * dsdx;
+							t += NB_INTERP * dtdx;
+							if (kDrawLogic == DRAW_SMOOTH) {
+								a += NB_INTERP * dadx;
+								r += NB_INTERP * drdx;
+								g += NB_INTERP * dgdx;
+								b += NB_INTERP * dbdx;
+							}
 						}
 						pz += NB_INTERP;
 						buf += NB_INTERP;
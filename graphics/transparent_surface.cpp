@@ -29,6 +29,8 @@
 
 #include "common/algorithm.h"
 #include "common/endian.h"
+#include "common/lrulist.h"
+#include "common/singleton.h"
 #include "common/util.h"
 #include "common/rect.h"
 #include "common/math.h"
@@ -38,6 +40,14 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSPARENT_SURFACE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TRANSPARENT_SURFACE_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 0;//img->format.bShift;
@@ -58,6 +68,357 @@ static const int kGIndex = 1;
 static const int kRIndex = 0;
 #endif
 
+#if defined(TRANSPARENT_SURFACE_USE_SSE2) || defined(TRANSPARENT_SURFACE_USE_NEON)
+#define TRANSPARENT_SURFACE_USE_SIMD
+
+// The vector code blends four pixels at a time. The components are widened
+// to 16 bits, two pixels to a vector, and each blend mode repeats the
+// arithmetic of its scalar loop exactly.
+
+#if defined(TRANSPARENT_SURFACE_USE_SSE2)
+typedef __m128i PixelVector;
+typedef __m128i ComponentVector;
+
+// Loads four pixels, which are read backwards for a negative step
+static inline PixelVector loadPixels(const byte *src, int32 step) {
+	if (step > 0)
+		return _mm_loadu_si128((const __m128i *)src);
+	return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(src - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+static inline void storePixels(byte *dst, PixelVector pixels) {
+	_mm_storeu_si128((__m128i *)dst, pixels);
+}
+
+static inline void unpackPixels(PixelVector pixels, ComponentVector &lo, ComponentVector &hi) {
+	lo = _mm_unpacklo_epi8(pixels, _mm_setzero_si128());
+	hi = _mm_unpackhi_epi8(pixels, _mm_setzero_si128());
+}
+
+static inline PixelVector packPixels(ComponentVector lo, ComponentVector hi) {
+	return _mm_packus_epi16(lo, hi);
+}
+
+// The value for each component, the same for both pixels of a vector
+static inline ComponentVector setComponents(uint16 a, uint16 r, uint16 g, uint16 b) {
+	uint16 values[8];
+	values[kAIndex] = values[kAIndex + 4] = a;
+	values[kRIndex] = values[kRIndex + 4] = r;
+	values[kGIndex] = values[kGIndex + 4] = g;
+	values[kBIndex] = values[kBIndex + 4] = b;
+	return _mm_loadu_si128((const __m128i *)values);
+}
+
+static inline ComponentVector add(ComponentVector a, ComponentVector b) { return _mm_add_epi16(a, b); }
+static inline ComponentVector sub(ComponentVector a, ComponentVector b) { return _mm_sub_epi16(a, b); }
+static inline ComponentVector mul(ComponentVector a, ComponentVector b) { return _mm_mullo_epi16(a, b); }
+// (a * b) >> 16
+static inline ComponentVector mulHigh(ComponentVector a, ComponentVector b) { return _mm_mulhi_epu16(a, b); }
+static inline ComponentVector shift8(ComponentVector a) { return _mm_srli_epi16(a, 8); }
+
+// The alpha of each pixel in all its components
+static inline ComponentVector splatAlpha(ComponentVector a) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, kAIndex * 0x55), kAIndex * 0x55);
+}
+
+static inline ComponentVector isZero(ComponentVector a) { return _mm_cmpeq_epi16(a, _mm_setzero_si128()); }
+
+// mask ? a : b
+static inline ComponentVector select(ComponentVector mask, ComponentVector a, ComponentVector b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// The pixels with the alpha set to 255
+static inline PixelVector setOpaque(PixelVector pixels) {
+	return _mm_or_si128(pixels, _mm_set1_epi32(0xFF));
+}
+
+// The source pixels with the alpha set to 255, where the source alpha is not 0
+static inline PixelVector selectNonTransparent(PixelVector src, PixelVector dst) {
+	const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, _mm_set1_epi32(0xFF)), _mm_setzero_si128());
+	return _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, setOpaque(src)));
+}
+/**
+ * Bilinear interpolation of two pixels, from the 2x2 texels at src0 and
+ * src1, with the same arithmetic as the scalar code of rotoscaleT.
+ */
+static inline void interpolatePixels(byte *dst, const byte *src0, const byte *src1, uint pitch,
+		int ex0, int ey0, int ex1, int ey1) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i top0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src0), zero);
+	const __m128i bottom0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src0 + pitch)), zero);
+	const __m128i top1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src1), zero);
+	const __m128i bottom1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src1 + pitch)), zero);
+
+	const __m128i ex = _mm_set_epi16(ex1, ex1, ex1, ex1, ex0, ex0, ex0, ex0);
+	const __m128i ey = _mm_set_epi16(ey1, ey1, ey1, ey1, ey0, ey0, ey0, ey0);
+
+	// (d * e) >> 16 with a signed d and an unsigned e
+	const __m128i c00 = _mm_unpacklo_epi64(top0, top1), c01 = _mm_unpackhi_epi64(top0, top1);
+	const __m128i c10 = _mm_unpacklo_epi64(bottom0, bottom1), c11 = _mm_unpackhi_epi64(bottom0, bottom1);
+	__m128i d = _mm_sub_epi16(c01, c00);
+	const __m128i t1 = _mm_add_epi16(c00, _mm_add_epi16(_mm_mulhi_epi16(d, ex), _mm_and_si128(_mm_srai_epi16(ex, 15), d)));
+	d = _mm_sub_epi16(c11, c10);
+	const __m128i t2 = _mm_add_epi16(c10, _mm_add_epi16(_mm_mulhi_epi16(d, ex), _mm_and_si128(_mm_srai_epi16(ex, 15), d)));
+	d = _mm_sub_epi16(t2, t1);
+	const __m128i result = _mm_add_epi16(t1, _mm_add_epi16(_mm_mulhi_epi16(d, ey), _mm_and_si128(_mm_srai_epi16(ey, 15), d)));
+	_mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(result, result));
+}
+#elif defined(TRANSPARENT_SURFACE_USE_NEON)
+typedef uint32x4_t PixelVector;
+typedef uint16x8_t ComponentVector;
+
+static inline PixelVector loadPixels(const byte *src, int32 step) {
+	if (step > 0)
+		return vreinterpretq_u32_u8(vld1q_u8(src));
+	const uint32x4_t pixels = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(src - 12)));
+	return vcombine_u32(vget_high_u32(pixels), vget_low_u32(pixels));
+}
+
+static inline void storePixels(byte *dst, PixelVector pixels) {
+	vst1q_u8(dst, vreinterpretq_u8_u32(pixels));
+}
+
+static inline void unpackPixels(PixelVector pixels, ComponentVector &lo, ComponentVector &hi) {
+	const uint8x16_t bytes = vreinterpretq_u8_u32(pixels);
+	lo = vmovl_u8(vget_low_u8(bytes));
+	hi = vmovl_u8(vget_high_u8(bytes));
+}
+
+static inline PixelVector packPixels(ComponentVector lo, ComponentVector hi) {
+	return vreinterpretq_u32_u8(vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)));
+}
+
+static inline ComponentVector setComponents(uint16 a, uint16 r, uint16 g, uint16 b) {
+	uint16 values[8];
+	values[kAIndex] = values[kAIndex + 4] = a;
+	values[kRIndex] = values[kRIndex + 4] = r;
+	values[kGIndex] = values[kGIndex + 4] = g;
+	values[kBIndex] = values[kBIndex + 4] = b;
+	return vld1q_u16(values);
+}
+
+static inline ComponentVector add(ComponentVector a, ComponentVector b) { return vaddq_u16(a, b); }
+static inline ComponentVector sub(ComponentVector a, ComponentVector b) { return vsubq_u16(a, b); }
+static inline ComponentVector mul(ComponentVector a, ComponentVector b) { return vmulq_u16(a, b); }
+static inline ComponentVector mulHigh(ComponentVector a, ComponentVector b) {
+	return vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16),
+	                    vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16));
+}
+static inline ComponentVector shift8(ComponentVector a) { return vshrq_n_u16(a, 8); }
+
+static inline ComponentVector splatAlpha(ComponentVector a) {
+	return vcombine_u16(vdup_lane_u16(vget_low_u16(a), kAIndex), vdup_lane_u16(vget_high_u16(a), kAIndex));
+}
+
+static inline ComponentVector isZero(ComponentVector a) { return vceqq_u16(a, vdupq_n_u16(0)); }
+
+static inline ComponentVector select(ComponentVector mask, ComponentVector a, ComponentVector b) {
+	return vbslq_u16(mask, a, b);
+}
+
+static inline PixelVector setOpaque(PixelVector pixels) {
+	return vorrq_u32(pixels, vdupq_n_u32(0xFF));
+}
+
+static inline PixelVector selectNonTransparent(PixelVector src, PixelVector dst) {
+	const uint32x4_t transparent = vceqq_u32(vandq_u32(src, vdupq_n_u32(0xFF)), vdupq_n_u32(0));
+	return vbslq_u32(transparent, dst, setOpaque(src));
+}
+// (d * e) >> 16 with a signed d and an unsigned e
+static inline int16x8_t mulHighSigned(int16x8_t d, uint16x8_t e) {
+	const int32x4_t lo = vmulq_s32(vmovl_s16(vget_low_s16(d)), vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(e))));
+	const int32x4_t hi = vmulq_s32(vmovl_s16(vget_high_s16(d)), vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(e))));
+	return vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16));
+}
+
+static inline void interpolatePixels(byte *dst, const byte *src0, const byte *src1, uint pitch,
+		int ex0, int ey0, int ex1, int ey1) {
+	const int16x8_t top0 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src0)));
+	const int16x8_t bottom0 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src0 + pitch)));
+	const int16x8_t top1 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src1)));
+	const int16x8_t bottom1 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src1 + pitch)));
+
+	const uint16x8_t ex = vcombine_u16(vdup_n_u16(ex0), vdup_n_u16(ex1));
+	const uint16x8_t ey = vcombine_u16(vdup_n_u16(ey0), vdup_n_u16(ey1));
+
+	const int16x8_t c00 = vcombine_s16(vget_low_s16(top0), vget_low_s16(top1));
+	const int16x8_t c01 = vcombine_s16(vget_high_s16(top0), vget_high_s16(top1));
+	const int16x8_t c10 = vcombine_s16(vget_low_s16(bottom0), vget_low_s16(bottom1));
+	const int16x8_t c11 = vcombine_s16(vget_high_s16(bottom0), vget_high_s16(bottom1));
+	const int16x8_t t1 = vaddq_s16(c00, mulHighSigned(vsubq_s16(c01, c00), ex));
+	const int16x8_t t2 = vaddq_s16(c10, mulHighSigned(vsubq_s16(c11, c10), ex));
+	const int16x8_t result = vaddq_s16(t1, mulHighSigned(vsubq_s16(t2, t1), ey));
+	vst1_u8(dst, vqmovun_s16(result));
+}
+#endif
+
+/**
+ * Blends the first (width & ~3) pixels of each row with the kernel, and
+ * advances the pointers and the width to the remainder for the scalar code.
+ */
+template<class Kernel>
+static void blitVectors(byte *&ino, byte *&outo, uint32 &width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, const Kernel &kernel) {
+	const uint32 vectorWidth = width & ~3;
+	if (!vectorWidth)
+		return;
+
+	byte *inRow = ino;
+	byte *outRow = outo;
+	for (uint32 i = 0; i < height; i++) {
+		byte *in = inRow;
+		byte *out = outRow;
+		for (uint32 j = 0; j < vectorWidth; j += 4) {
+			storePixels(out, kernel.blend(loadPixels(in, inStep), loadPixels(out, 4)));
+			in += inStep * 4;
+			out += 16;
+		}
+		outRow += pitch;
+		inRow += inoStep;
+	}
+
+	ino += (int32)vectorWidth * inStep;
+	outo += vectorWidth * 4;
+	width -= vectorWidth;
+}
+
+struct OpaqueKernel {
+	inline PixelVector blend(PixelVector in, PixelVector) const { return setOpaque(in); }
+};
+
+struct BinaryKernel {
+	inline PixelVector blend(PixelVector in, PixelVector out) const { return selectNonTransparent(in, out); }
+};
+
+/**
+ * Base of the blend kernels, which work on the widened components. The
+ * components of the color modulation are in mod, and the variants with a
+ * shift of 16 use 256 for 255, which turns the shift into one of 8 bits.
+ */
+template<class Blend>
+struct ComponentKernel {
+	explicit ComponentKernel(uint32 color) {
+		const byte ca = (color >> kAModShift) & 0xFF;
+		const byte cr = (color >> kRModShift) & 0xFF;
+		const byte cg = (color >> kGModShift) & 0xFF;
+		const byte cb = (color >> kBModShift) & 0xFF;
+		full = setComponents(255, 255, 255, 255);
+		alphaMask = setComponents(0xFFFF, 0, 0, 0);
+		alphaMod = setComponents(ca, ca, ca, ca);
+		mod = setComponents(0, cr, cg, cb);
+		modExact = setComponents(0, cr == 255 ? 256 : cr, cg == 255 ? 256 : cg, cb == 255 ? 256 : cb);
+	}
+
+	inline PixelVector blend(PixelVector in, PixelVector out) const {
+		ComponentVector inLo, inHi, outLo, outHi;
+		unpackPixels(in, inLo, inHi);
+		unpackPixels(out, outLo, outHi);
+		const Blend &derived = static_cast<const Blend &>(*this);
+		return packPixels(derived.blendComponents(inLo, outLo), derived.blendComponents(inHi, outHi));
+	}
+
+	ComponentVector full, alphaMask, alphaMod, mod, modExact;
+};
+
+template<bool colorMod>
+struct AlphaBlendKernel : public ComponentKernel<AlphaBlendKernel<colorMod> > {
+	explicit AlphaBlendKernel(uint32 color) : ComponentKernel<AlphaBlendKernel<colorMod> >(color) {}
+
+	inline ComponentVector blendComponents(ComponentVector in, ComponentVector out) const {
+		ComponentVector alpha = splatAlpha(in), result;
+		if (colorMod) {
+			alpha = shift8(mul(alpha, this->alphaMod));
+			result = add(shift8(mul(out, sub(this->full, alpha))), mulHigh(mul(in, alpha), this->mod));
+		} else {
+			result = shift8(add(mul(in, alpha), mul(out, sub(this->full, alpha))));
+		}
+		result = select(this->alphaMask, this->full, result);
+		return select(isZero(alpha), out, result);
+	}
+};
+
+template<bool colorMod>
+struct AdditiveBlendKernel : public ComponentKernel<AdditiveBlendKernel<colorMod> > {
+	explicit AdditiveBlendKernel(uint32 color) : ComponentKernel<AdditiveBlendKernel<colorMod> >(color) {}
+
+	inline ComponentVector blendComponents(ComponentVector in, ComponentVector out) const {
+		ComponentVector alpha = splatAlpha(in), result;
+		if (colorMod) {
+			alpha = shift8(mul(alpha, this->alphaMod));
+			result = add(out, mulHigh(mul(in, alpha), this->modExact));
+		} else {
+			result = add(out, shift8(mul(in, alpha)));
+		}
+		// The sum is saturated when the pixels are packed
+		return select(this->alphaMask, out, result);
+	}
+};
+
+template<bool colorMod>
+struct SubtractiveBlendKernel : public ComponentKernel<SubtractiveBlendKernel<colorMod> > {
+	explicit SubtractiveBlendKernel(uint32 color) : ComponentKernel<SubtractiveBlendKernel<colorMod> >(color) {}
+
+	inline ComponentVector blendComponents(ComponentVector in, ComponentVector out) const {
+		const ComponentVector alpha = splatAlpha(in);
+		if (colorMod) {
+			// (in * mod) * (out * alpha) >> 24 stays exact as two shifts
+			const ComponentVector result = sub(out, shift8(mulHigh(mul(in, this->modExact), mul(out, alpha))));
+			return select(this->alphaMask, this->full, result);
+		}
+		return select(this->alphaMask, out, sub(out, mulHigh(mul(in, out), alpha)));
+	}
+};
+
+template<bool colorMod>
+struct MultiplyBlendKernel : public ComponentKernel<MultiplyBlendKernel<colorMod> > {
+	explicit MultiplyBlendKernel(uint32 color) : ComponentKernel<MultiplyBlendKernel<colorMod> >(color) {}
+
+	inline ComponentVector blendComponents(ComponentVector in, ComponentVector out) const {
+		ComponentVector alpha = splatAlpha(in);
+		if (colorMod) {
+			alpha = shift8(mul(alpha, this->alphaMod));
+			const ComponentVector result = shift8(mul(out, mulHigh(mul(in, alpha), this->modExact)));
+			return select(this->alphaMask, out, result);
+		}
+		const ComponentVector result = select(this->alphaMask, out, shift8(mul(shift8(mul(in, alpha)), out)));
+		return select(isZero(alpha), out, result);
+	}
+};
+
+/**
+ * Kernel for the premultiplied blits. The source components are scaled by
+ * the factors of premultipliedFactors(), which are 256 without color
+ * modulation, and the alpha of the scaled source is used for the blend.
+ */
+template<TSpriteBlendMode blendMode>
+struct PremultipliedBlendKernel : public ComponentKernel<PremultipliedBlendKernel<blendMode> > {
+	explicit PremultipliedBlendKernel(const uint16 *factors) : ComponentKernel<PremultipliedBlendKernel<blendMode> >(0xFFFFFFFF) {
+		factor = setComponents(factors[kAIndex], factors[kRIndex], factors[kGIndex], factors[kBIndex]);
+	}
+
+	inline ComponentVector blendComponents(ComponentVector in, ComponentVector out) const {
+		const ComponentVector src = shift8(mul(in, factor));
+		const ComponentVector alpha = splatAlpha(src);
+		ComponentVector result;
+		if (blendMode == BLEND_ADDITIVE) {
+			result = add(out, src);
+		} else if (blendMode == BLEND_SUBTRACTIVE) {
+			result = sub(out, shift8(mul(src, out)));
+		} else if (blendMode == BLEND_MULTIPLY) {
+			result = shift8(mul(src, out));
+		} else {
+			result = add(src, shift8(mul(out, sub(this->full, alpha))));
+			result = select(this->alphaMask, this->full, result);
+			return select(isZero(alpha), out, result);
+		}
+		result = select(this->alphaMask, out, result);
+		return select(isZero(alpha), out, result);
+	}
+
+	ComponentVector factor;
+};
+#endif
+
 void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
@@ -65,9 +426,9 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 
-TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL) {}
+TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL), _premultiplied(false), _transformCaching(false) {}
 
-TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL) {
+TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL), _premultiplied(false), _transformCaching(false) {
 	if (copyData) {
 		copyFrom(surf);
 	} else {
@@ -82,10 +443,18 @@ TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Sur
 	}
 }
 
+TransparentSurface::~TransparentSurface() {
+	if (_transformCaching)
+		invalidateTransformCache();
+}
+
 /**
  * Optimized version of doBlit to be used w/opaque blitting (no alpha).
  */
 void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	blitVectors(ino, outo, width, height, pitch, inStep, inoStep, OpaqueKernel());
+#endif
 
 	byte *in;
 	byte *out;
@@ -93,10 +462,20 @@ void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	for (uint32 i = 0; i < height; i++) {
 		out = outo;
 		in = ino;
-		memcpy(out, in, width * 4);
-		for (uint32 j = 0; j < width; j++) {
-			out[kAIndex] = 0xFF;
-			out += 4;
+		if (inStep == 4) {
+			memcpy(out, in, width * 4);
+			for (uint32 j = 0; j < width; j++) {
+				out[kAIndex] = 0xFF;
+				out += 4;
+			}
+		} else {
+			// Flipped horizontally
+			for (uint32 j = 0; j < width; j++) {
+				*(uint32 *)out = *(const uint32 *)in;
+				out[kAIndex] = 0xFF;
+				in += inStep;
+				out += 4;
+			}
 		}
 		outo += pitch;
 		ino += inoStep;
@@ -107,6 +486,9 @@ void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
  * Optimized version of doBlit to be used w/binary blitting (blit or no-blit, no blending).
  */
 void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep) {
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	blitVectors(ino, outo, width, height, pitch, inStep, inoStep, BinaryKernel());
+#endif
 
 	byte *in;
 	byte *out;
@@ -142,6 +524,12 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
  * @color colormod in 0xAARRGGBB format - 0xFFFFFFFF for no colormod
  */
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	if (color == 0xffffffff)
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, AlphaBlendKernel<false>(color));
+	else
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, AlphaBlendKernel<true>(color));
+#endif
 	byte *in;
 	byte *out;
 
@@ -203,6 +591,12 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
  * Optimized version of doBlit to be used with additive blended blitting
  */
 void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	if (color == 0xffffffff)
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, AdditiveBlendKernel<false>(color));
+	else
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, AdditiveBlendKernel<true>(color));
+#endif
 	byte *in;
 	byte *out;
 
@@ -270,6 +664,12 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
  * Optimized version of doBlit to be used with subtractive blended blitting
  */
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	if (color == 0xffffffff)
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, SubtractiveBlendKernel<false>(color));
+	else
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, SubtractiveBlendKernel<true>(color));
+#endif
 	byte *in;
 	byte *out;
 
@@ -305,19 +705,19 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
-					out[kBIndex] = MAX(out[kBIndex] - ((in[kBIndex] * cb  * (out[kBIndex]) * in[kAIndex]) >> 24), 0);
+					out[kBIndex] = MAX(out[kBIndex] - (int)((in[kBIndex] * cb * out[kBIndex] * (uint32)in[kAIndex]) >> 24), 0);
 				} else {
 					out[kBIndex] = MAX(out[kBIndex] - (in[kBIndex] * (out[kBIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cg != 255) {
-					out[kGIndex] = MAX(out[kGIndex] - ((in[kGIndex] * cg  * (out[kGIndex]) * in[kAIndex]) >> 24), 0);
+					out[kGIndex] = MAX(out[kGIndex] - (int)((in[kGIndex] * cg * out[kGIndex] * (uint32)in[kAIndex]) >> 24), 0);
 				} else {
 					out[kGIndex] = MAX(out[kGIndex] - (in[kGIndex] * (out[kGIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cr != 255) {
-					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * cr * (out[kRIndex]) * in[kAIndex]) >> 24), 0);
+					out[kRIndex] = MAX(out[kRIndex] - (int)((in[kRIndex] * cr * out[kRIndex] * (uint32)in[kAIndex]) >> 24), 0);
 				} else {
 					out[kRIndex] = MAX(out[kRIndex] - (in[kRIndex] * (out[kRIndex]) * in[kAIndex] >> 16), 0);
 				}
@@ -335,6 +735,12 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
  * Optimized version of doBlit to be used with multiply blended blitting
  */
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	if (color == 0xffffffff)
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, MultiplyBlendKernel<false>(color));
+	else
+		blitVectors(ino, outo, width, height, pitch, inStep, inoStep, MultiplyBlendKernel<true>(color));
+#endif
 	byte *in;
 	byte *out;
 
@@ -397,6 +803,108 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 
 }
 
+/**
+ * The factors the premultiplied components are scaled with for the color
+ * modulation, by the byte index of the components. 256 stands for 1.0.
+ */
+static void premultipliedFactors(uint32 color, uint16 *factors) {
+	uint16 ca = (color >> kAModShift) & 0xFF;
+	uint16 cr = (color >> kRModShift) & 0xFF;
+	uint16 cg = (color >> kGModShift) & 0xFF;
+	uint16 cb = (color >> kBModShift) & 0xFF;
+	ca += ca >> 7;
+	cr += cr >> 7;
+	cg += cg >> 7;
+	cb += cb >> 7;
+	factors[kAIndex] = ca;
+	factors[kRIndex] = cr * ca >> 8;
+	factors[kGIndex] = cg * ca >> 8;
+	factors[kBIndex] = cb * ca >> 8;
+}
+
+/**
+ * Version of doBlit to be used with premultiplied source pixels, for all blend modes
+ */
+template<TSpriteBlendMode blendMode>
+void doBlitPremultiplied(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	uint16 factors[4];
+	premultipliedFactors(color, factors);
+
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+	blitVectors(ino, outo, width, height, pitch, inStep, inoStep, PremultipliedBlendKernel<blendMode>(factors));
+#endif
+
+	byte *in;
+	byte *out;
+
+	for (uint32 i = 0; i < height; i++) {
+		out = outo;
+		in = ino;
+		for (uint32 j = 0; j < width; j++) {
+			byte src[4];
+			for (int c = 0; c < 4; c++)
+				src[c] = in[c] * factors[c] >> 8;
+
+			if (src[kAIndex] != 0) {
+				for (int c = 0; c < 4; c++) {
+					if (c == kAIndex)
+						continue;
+
+					if (blendMode == BLEND_ADDITIVE)
+						out[c] = MIN(out[c] + src[c], 255);
+					else if (blendMode == BLEND_SUBTRACTIVE)
+						out[c] = out[c] - (src[c] * out[c] >> 8);
+					else if (blendMode == BLEND_MULTIPLY)
+						out[c] = src[c] * out[c] >> 8;
+					else
+						out[c] = src[c] + (out[c] * (255 - src[kAIndex]) >> 8);
+				}
+				if (blendMode == BLEND_NORMAL)
+					out[kAIndex] = 255;
+			}
+
+			in += inStep;
+			out += 4;
+		}
+		outo += pitch;
+		ino += inoStep;
+	}
+}
+
+/**
+ * Picks the version of doBlit for the blend mode and the source pixels
+ */
+static void doBlit(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep,
+		uint32 color, TSpriteBlendMode blendMode, AlphaType alphaMode, bool premultiplied) {
+	if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && alphaMode == ALPHA_OPAQUE) {
+		doBlitOpaqueFast(ino, outo, width, height, pitch, inStep, inoStep);
+	} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && alphaMode == ALPHA_BINARY) {
+		doBlitBinaryFast(ino, outo, width, height, pitch, inStep, inoStep);
+	} else if (premultiplied) {
+		if (blendMode == BLEND_ADDITIVE) {
+			doBlitPremultiplied<BLEND_ADDITIVE>(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_SUBTRACTIVE) {
+			doBlitPremultiplied<BLEND_SUBTRACTIVE>(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_MULTIPLY) {
+			doBlitPremultiplied<BLEND_MULTIPLY>(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else {
+			assert(blendMode == BLEND_NORMAL);
+			doBlitPremultiplied<BLEND_NORMAL>(ino, outo, width, height, pitch, inStep, inoStep, color);
+		}
+	} else {
+		if (blendMode == BLEND_ADDITIVE) {
+			doBlitAdditiveBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_SUBTRACTIVE) {
+			doBlitSubtractiveBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_MULTIPLY) {
+			doBlitMultiplyBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else {
+			assert(blendMode == BLEND_NORMAL);
+			doBlitAlphaBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		}
+	}
+}
+
 Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, TSpriteBlendMode blendMode) {
 
 	Common::Rect retSize;
@@ -459,11 +967,21 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 
 	Graphics::Surface *img = nullptr;
 	Graphics::Surface *imgScaled = nullptr;
+	Graphics::Surface imgCached;
 	byte *savedPixels = nullptr;
+	const TransparentSurface *cached = nullptr;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
+		if (_transformCaching)
+			cached = getCachedScale(srcImage, width, height, false);
+		if (cached) {
+			// The clipping below changes img, so it works on a copy of the header
+			imgCached = *cached;
+			img = &imgCached;
+		} else {
+			// Scale the image
+			img = imgScaled = srcImage.scale(width, height);
+			savedPixels = (byte *)img->getPixels();
+		}
 	} else {
 		img = &srcImage;
 	}
@@ -514,22 +1032,7 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 		byte *ino = (byte *)img->getBasePtr(xp, yp);
 		byte *outo = (byte *)target.getBasePtr(posX, posY);
 
-		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else {
-			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else {
-				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			}
-		}
+		doBlit(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color, blendMode, _alphaMode, _premultiplied);
 
 	}
 
@@ -606,11 +1109,21 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 
 	Graphics::Surface *img = nullptr;
 	Graphics::Surface *imgScaled = nullptr;
+	Graphics::Surface imgCached;
 	byte *savedPixels = nullptr;
+	const TransparentSurface *cached = nullptr;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
+		if (_transformCaching)
+			cached = getCachedScale(srcImage, width, height, false);
+		if (cached) {
+			// The clipping below changes img, so it works on a copy of the header
+			imgCached = *cached;
+			img = &imgCached;
+		} else {
+			// Scale the image
+			img = imgScaled = srcImage.scale(width, height);
+			savedPixels = (byte *)img->getPixels();
+		}
 	} else {
 		img = &srcImage;
 	}
@@ -661,22 +1174,7 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 		byte *ino = (byte *)img->getBasePtr(xp, yp);
 		byte *outo = (byte *)target.getBasePtr(posX, posY);
 
-		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else {
-			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else {
-				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			}
-		}
+		doBlit(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color, blendMode, _alphaMode, _premultiplied);
 
 	}
 
@@ -744,6 +1242,36 @@ void TransparentSurface::setAlphaMode(AlphaType mode) {
 	_alphaMode = mode;
 }
 
+/**
+ * Multiplies the color components of all pixels with their alpha, rounded
+ * so that opaque pixels keep their colors. The blits then use the
+ * premultiplied kernels.
+ */
+void TransparentSurface::premultiplyAlpha() {
+	assert(format.bytesPerPixel == 4);
+	if (_premultiplied)
+		return;
+
+	for (int i = 0; i < h; i++) {
+		byte *pix = (byte *)getBasePtr(0, i);
+		for (int j = 0; j < w; j++) {
+			const uint a = pix[kAIndex];
+			for (int c = 0; c < 4; c++) {
+				if (c != kAIndex) {
+					const uint v = pix[c] * a + 128;
+					pix[c] = (v + (v >> 8)) >> 8;
+				}
+			}
+			pix += 4;
+		}
+	}
+	_premultiplied = true;
+}
+
+bool TransparentSurface::isPremultiplied() const {
+	return _premultiplied;
+}
+
 
 
 
@@ -794,8 +1322,183 @@ systems.
 
 struct tColorRGBA { byte r; byte g; byte b; byte a; };
 
+/**
+ * The transformation of a surface area, which identifies a cached result
+ */
+struct TransformCacheKey {
+	const TransparentSurface *owner;
+	const void *pixels;
+	int16 w, h;
+	uint16 pitch;
+	// 0 and 1 for scaling without and with filtering, 2 and 3 for rotoscaling
+	int mode;
+	uint16 newWidth, newHeight;
+	int32 angle;
+	Common::Point zoom, hotspot;
+
+	TransformCacheKey(const TransparentSurface *o, const Surface &part, int m) :
+		owner(o), pixels(part.getPixels()), w(part.w), h(part.h), pitch(part.pitch), mode(m),
+		newWidth(0), newHeight(0), angle(0) {}
+
+	bool operator==(const TransformCacheKey &other) const {
+		return owner == other.owner && pixels == other.pixels && w == other.w && h == other.h
+		    && pitch == other.pitch && mode == other.mode && newWidth == other.newWidth
+		    && newHeight == other.newHeight && angle == other.angle && zoom == other.zoom
+		    && hotspot == other.hotspot;
+	}
+};
+
+/**
+ * Least recently used cache of transformed surfaces, for the surfaces with
+ * setTransformCaching() enabled.
+ */
+class TransformCache : public Common::Singleton<TransformCache> {
+public:
+	enum {
+		kMaxEntries = 64,
+		kMaxBytes = 16 * 1024 * 1024
+	};
+
+	~TransformCache() {
+		for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i)
+			freeEntry(*i);
+	}
+
+	const TransparentSurface *find(const TransformCacheKey &key) {
+		for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->key == key)
+				return _entries.touch(i)->surface;
+		}
+		return nullptr;
+	}
+
+	// Surfaces taking more than a quarter of the cache are not kept
+	static bool fits(uint32 size) {
+		return size <= kMaxBytes / 4;
+	}
+
+	/**
+	 * Takes over the surface, unless it does not fit. Returns whether the
+	 * surface was taken over.
+	 */
+	bool insert(const TransformCacheKey &key, TransparentSurface *surface) {
+		const uint32 size = surface->pitch * surface->h;
+		if (!fits(size))
+			return false;
+
+		while (!_entries.empty() && (_entries.size() >= kMaxEntries || _bytes + size > kMaxBytes)) {
+			freeEntry(_entries.leastRecent());
+			_entries.removeLeastRecent();
+		}
+
+		Entry entry;
+		entry.key = key;
+		entry.surface = surface;
+		_entries.add(entry);
+		_bytes += size;
+		return true;
+	}
+
+	void invalidate(const TransparentSurface *owner) {
+		for (EntryList::iterator i = _entries.begin(); i != _entries.end();) {
+			if (i->key.owner == owner) {
+				freeEntry(*i);
+				i = _entries.erase(i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	TransformCache() : _bytes(0) {}
+
+	struct Entry {
+		Entry() : key(nullptr, Surface(), 0), surface(nullptr) {}
+
+		TransformCacheKey key;
+		TransparentSurface *surface;
+	};
+	typedef Common::LRUList<Entry> EntryList;
+
+	void freeEntry(Entry &entry) {
+		_bytes -= entry.surface->pitch * entry.surface->h;
+		entry.surface->free();
+		delete entry.surface;
+	}
+
+	EntryList _entries;
+	uint32 _bytes;
+};
+
+} // End of namespace Graphics
+
+namespace Common {
+DECLARE_SINGLETON(Graphics::TransformCache);
+}
+
+namespace Graphics {
+
+void TransparentSurface::setTransformCaching(bool enable) {
+	if (!enable && _transformCaching)
+		invalidateTransformCache();
+	_transformCaching = enable;
+}
+
+void TransparentSurface::invalidateTransformCache() {
+	if (TransformCache::hasInstance())
+		TransformCache::instance().invalidate(this);
+}
+
+const TransparentSurface *TransparentSurface::getCachedScale(const Surface &part, uint16 newWidth, uint16 newHeight, bool filtering) const {
+	if (!TransformCache::fits(newWidth * newHeight * 4))
+		return nullptr;
+
+	TransformCacheKey key(this, part, filtering ? 1 : 0);
+	key.newWidth = newWidth;
+	key.newHeight = newHeight;
+
+	TransformCache &cache = TransformCache::instance();
+	const TransparentSurface *cached = cache.find(key);
+	if (cached)
+		return cached;
+
+	TransparentSurface area(part, false);
+	area._premultiplied = _premultiplied;
+	TransparentSurface *target = area.scaleUncached(newWidth, newHeight, filtering);
+	cache.insert(key, target);
+	return target;
+}
+
+
 template <TFilteringMode filteringMode>
 TransparentSurface *TransparentSurface::rotoscaleT(const TransformStruct &transform) const {
+	if (!_transformCaching)
+		return rotoscaleUncached<filteringMode>(transform);
+
+	TransformCacheKey key(this, *this, filteringMode == FILTER_BILINEAR ? 3 : 2);
+	key.angle = transform._angle;
+	key.zoom = transform._zoom;
+	key.hotspot = transform._hotspot;
+
+	TransformCache &cache = TransformCache::instance();
+	const TransparentSurface *cached = cache.find(key);
+	if (!cached) {
+		TransparentSurface *target = rotoscaleUncached<filteringMode>(transform);
+		if (!cache.insert(key, target))
+			return target;
+		cached = target;
+	}
+
+	TransparentSurface *target = new TransparentSurface();
+	target->copyFrom(*cached);
+	target->_premultiplied = cached->_premultiplied;
+	return target;
+}
+
+template <TFilteringMode filteringMode>
+TransparentSurface *TransparentSurface::rotoscaleUncached(const TransformStruct &transform) const {
 
 	assert(transform._angle != 0); // This would not be ideal; rotoscale() should never be called in conditional branches where angle = 0 anyway.
 
@@ -813,6 +1516,7 @@ TransparentSurface *TransparentSurface::rotoscaleT(const TransformStruct &transf
 	int dstH = dstRect.height();
 
 	target->create((uint16)dstW, (uint16)dstH, this->format);
+	target->_premultiplied = _premultiplied;
 
 	if (transform._zoom.x == 0 || transform._zoom.y == 0) {
 		return target;
@@ -850,6 +1554,22 @@ TransparentSurface *TransparentSurface::rotoscaleT(const TransformStruct &transf
 		for (int x = 0; x < dstW; x++) {
 			int dx = (sdx >> 16);
 			int dy = (sdy >> 16);
+#ifdef TRANSPARENT_SURFACE_USE_SIMD
+			// Two pixels at a time, while both have all their texels inside
+			if (filteringMode == FILTER_BILINEAR && !flipx && !flipy && x + 1 < dstW) {
+				const int dx1 = (sdx + icosx) >> 16;
+				const int dy1 = (sdy + isiny) >> 16;
+				if ((dx > -1) && (dy > -1) && (dx < sw) && (dy < sh) && (dx1 > -1) && (dy1 > -1) && (dx1 < sw) && (dy1 < sh)) {
+					interpolatePixels((byte *)pc, (const byte *)getBasePtr(dx, dy), (const byte *)getBasePtr(dx1, dy1), pitch,
+						sdx & 0xffff, sdy & 0xffff, (sdx + icosx) & 0xffff, (sdy + isiny) & 0xffff);
+					sdx += 2 * icosx;
+					sdy += 2 * isiny;
+					pc += 2;
+					x++;
+					continue;
+				}
+			}
+#endif
 			if (flipx) {
 				dx = sw - dx;
 			}
@@ -910,10 +1630,22 @@ TransparentSurface *TransparentSurface::rotoscaleT(const TransformStruct &transf
 }
 
 TransparentSurface *TransparentSurface::scale(uint16 newWidth, uint16 newHeight, bool filtering) const {
+	const TransparentSurface *cached = _transformCaching ? getCachedScale(*this, newWidth, newHeight, filtering) : nullptr;
+	if (!cached)
+		return scaleUncached(newWidth, newHeight, filtering);
+
+	TransparentSurface *target = new TransparentSurface();
+	target->copyFrom(*cached);
+	target->_premultiplied = cached->_premultiplied;
+	return target;
+}
+
+TransparentSurface *TransparentSurface::scaleUncached(uint16 newWidth, uint16 newHeight, bool filtering) const {
 
 	TransparentSurface *target = new TransparentSurface();
 
 	target->create(newWidth, newHeight, format);
+	target->_premultiplied = _premultiplied;
 
 	if (filtering) {
 		scaleBlitBilinear((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format);
@@ -88,6 +88,7 @@ enum TFilteringMode {
 struct TransparentSurface : public Graphics::Surface {
 	TransparentSurface();
 	TransparentSurface(const Graphics::Surface &surf, bool copyData = false);
+	~TransparentSurface();
 
 	/**
 	 * Returns the pixel format all operations of TransparentSurface support.
@@ -168,6 +169,18 @@ struct TransparentSurface : public Graphics::Surface {
 
 	TransparentSurface *rotoscale(const TransformStruct &transform) const;
 
+	/**
+	 * Keeps the results of scale(), rotoscale() and the scaling blits of
+	 * this surface in a cache shared by all surfaces, which is bounded in
+	 * size and drops the least recently used results. A sprite drawn with
+	 * the same transform each frame is then only resampled once.
+	 *
+	 * The cache has no way to notice changes of the pixels, so
+	 * invalidateTransformCache() has to be called after them.
+	 */
+	void setTransformCaching(bool enable);
+	void invalidateTransformCache();
+
 	TransparentSurface *convertTo(const PixelFormat &dstFormat, const byte *palette = 0) const;
 
 	float getRatio() {
@@ -179,8 +192,32 @@ struct TransparentSurface : public Graphics::Surface {
 
 	AlphaType getAlphaMode() const;
 	void setAlphaMode(AlphaType);
+
+	/**
+	 * Stores the pixels with premultiplied alpha, which saves the blits a
+	 * multiplication per component.
+	 *
+	 * The blend modes keep their meaning, but the results can differ from
+	 * the ones of straight alpha by rounding. applyColorKey() and setAlpha()
+	 * expect straight alpha, and have to be called before this.
+	 */
+	void premultiplyAlpha();
+	bool isPremultiplied() const;
 private:
+	TransparentSurface *scaleUncached(uint16 newWidth, uint16 newHeight, bool filtering) const;
+
+	template <TFilteringMode filteringMode>
+	TransparentSurface *rotoscaleUncached(const TransformStruct &transform) const;
+
+	/**
+	 * Returns the cached result of scaling the given part of this surface,
+	 * which stays owned by the cache.
+	 */
+	const TransparentSurface *getCachedScale(const Graphics::Surface &part, uint16 newWidth, uint16 newHeight, bool filtering) const;
+
 	AlphaType _alphaMode;
+	bool _premultiplied;
+	bool _transformCaching;
 };
 
 /**
@@ -83,9 +83,19 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/textconsole.h"
+#include "common/util.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YUV_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define YUV_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -207,6 +217,384 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+
+// Fixed point versions of the coefficients of the color table. Multiplying
+// with them gives the same truncated results for all chroma values.
+enum {
+	kCrToR = 22950, // 0.419 / 0.299
+	kCrToG = 11693, // 0.299 / 0.419
+	kCbToG = 5642,  // 0.114 / 0.331
+	kCbToB = 29055  // 0.587 / 0.331
+};
+
+#if defined(YUV_USE_SSE2)
+// Eight signed 16 bit values
+typedef __m128i YUVVector;
+
+// Load eight bytes into the 16 bit lanes
+static inline YUVVector loadBytes(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+}
+
+static inline YUVVector interleaveLo16(YUVVector a, YUVVector b) { return _mm_unpacklo_epi16(a, b); }
+static inline YUVVector interleaveHi16(YUVVector a, YUVVector b) { return _mm_unpackhi_epi16(a, b); }
+static inline YUVVector interleaveLo32(YUVVector a, YUVVector b) { return _mm_unpacklo_epi32(a, b); }
+static inline YUVVector interleaveHi32(YUVVector a, YUVVector b) { return _mm_unpackhi_epi32(a, b); }
+
+// Compute a * wa + b * wb for the bilinear interpolation
+static inline YUVVector weightedSum(YUVVector a, int16 wa, YUVVector b, int16 wb) {
+	return _mm_add_epi16(_mm_mullo_epi16(a, _mm_set1_epi16(wa)), _mm_mullo_epi16(b, _mm_set1_epi16(wb)));
+}
+
+static inline YUVVector shiftRight4(YUVVector a) { return _mm_srli_epi16(a, 4); }
+
+// Multiply the chroma with a coefficient, truncating towards zero like the cast in the color table
+static inline YUVVector multiplyChroma(YUVVector c, int16 coefficient) {
+	return _mm_sub_epi16(_mm_mulhi_epi16(_mm_slli_epi16(c, 2), _mm_set1_epi16(coefficient)), _mm_srai_epi16(c, 15));
+}
+
+static inline void computeOffsets(YUVVector u, YUVVector v, YUVVector &r, YUVVector &g, YUVVector &b) {
+	const YUVVector cr = _mm_sub_epi16(v, _mm_set1_epi16(128));
+	const YUVVector cb = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	r = multiplyChroma(cr, kCrToR);
+	g = _mm_sub_epi16(_mm_setzero_si128(), _mm_add_epi16(multiplyChroma(cr, kCrToG), multiplyChroma(cb, kCbToG)));
+	b = multiplyChroma(cb, kCbToB);
+}
+
+// The pixel format and luminance scale, in the form the vector code needs them
+struct YUVVectorFormat {
+	YUVVectorFormat(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+		itu = (lookup->getScale() == YUVToRGBManager::kScaleITU);
+		minValue = _mm_set1_epi16(itu ? 16 : 0);
+		maxValue = _mm_set1_epi16(itu ? 235 : 255);
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		// Shifting by 16 or more clears the lanes
+		rShiftLo = _mm_cvtsi32_si128(format.rShift < 16 ? format.rShift : 16);
+		gShiftLo = _mm_cvtsi32_si128(format.gShift < 16 ? format.gShift : 16);
+		bShiftLo = _mm_cvtsi32_si128(format.bShift < 16 ? format.bShift : 16);
+		rShiftHi = _mm_cvtsi32_si128(format.rShift >= 16 ? format.rShift - 16 : 16);
+		gShiftHi = _mm_cvtsi32_si128(format.gShift >= 16 ? format.gShift - 16 : 16);
+		bShiftHi = _mm_cvtsi32_si128(format.bShift >= 16 ? format.bShift - 16 : 16);
+		const uint32 alpha = format.ARGBToColor(255, 0, 0, 0);
+		alphaLo = _mm_set1_epi16((int16)(alpha & 0xFFFF));
+		alphaHi = _mm_set1_epi16((int16)(alpha >> 16));
+	}
+
+	bool itu;
+	__m128i minValue, maxValue;
+	__m128i rLoss, gLoss, bLoss;
+	__m128i rShiftLo, gShiftLo, bShiftLo;
+	__m128i rShiftHi, gShiftHi, bShiftHi;
+	__m128i alphaLo, alphaHi;
+};
+
+// Add the luminance to the chroma offset of one channel, and scale it like the lookup table
+static inline __m128i computeChannel(__m128i y, __m128i offset, __m128i loss, const YUVVectorFormat &format) {
+	__m128i c = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(y, offset), format.minValue), format.maxValue);
+	if (format.itu) {
+		// Stretching [0, 219] to [0, 255] is x + x * 10774 / 65536, which is exact for all values
+		c = _mm_sub_epi16(c, format.minValue);
+		c = _mm_add_epi16(c, _mm_mulhi_epu16(c, _mm_set1_epi16(10774)));
+	}
+	return _mm_srl_epi16(c, loss);
+}
+
+template<typename PixelInt>
+static inline void storePixels(PixelInt *dst, YUVVector y, YUVVector rOffset, YUVVector gOffset, YUVVector bOffset, const YUVVectorFormat &format) {
+	const __m128i r = computeChannel(y, rOffset, format.rLoss, format);
+	const __m128i g = computeChannel(y, gOffset, format.gLoss, format);
+	const __m128i b = computeChannel(y, bOffset, format.bLoss, format);
+
+	// The pixels are put together as their lower and upper 16 bits
+	const __m128i lo = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, format.rShiftLo), _mm_sll_epi16(g, format.gShiftLo)),
+	                                _mm_or_si128(_mm_sll_epi16(b, format.bShiftLo), format.alphaLo));
+	if (sizeof(PixelInt) == 2) {
+		_mm_storeu_si128((__m128i *)dst, lo);
+	} else {
+		const __m128i hi = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, format.rShiftHi), _mm_sll_epi16(g, format.gShiftHi)),
+		                                _mm_or_si128(_mm_sll_epi16(b, format.bShiftHi), format.alphaHi));
+		_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(lo, hi));
+		_mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi16(lo, hi));
+	}
+}
+#elif defined(YUV_USE_NEON)
+// Eight signed 16 bit values
+typedef int16x8_t YUVVector;
+
+// Load eight bytes into the 16 bit lanes
+static inline YUVVector loadBytes(const byte *src) {
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src)));
+}
+
+static inline YUVVector interleaveLo16(YUVVector a, YUVVector b) { return vzipq_s16(a, b).val[0]; }
+static inline YUVVector interleaveHi16(YUVVector a, YUVVector b) { return vzipq_s16(a, b).val[1]; }
+static inline YUVVector interleaveLo32(YUVVector a, YUVVector b) { return vreinterpretq_s16_s32(vzipq_s32(vreinterpretq_s32_s16(a), vreinterpretq_s32_s16(b)).val[0]); }
+static inline YUVVector interleaveHi32(YUVVector a, YUVVector b) { return vreinterpretq_s16_s32(vzipq_s32(vreinterpretq_s32_s16(a), vreinterpretq_s32_s16(b)).val[1]); }
+
+// Compute a * wa + b * wb for the bilinear interpolation
+static inline YUVVector weightedSum(YUVVector a, int16 wa, YUVVector b, int16 wb) {
+	return vmlaq_n_s16(vmulq_n_s16(a, wa), b, wb);
+}
+
+static inline YUVVector shiftRight4(YUVVector a) { return vshrq_n_s16(a, 4); }
+
+// Multiply the chroma with a coefficient, truncating towards zero like the cast in the color table
+static inline YUVVector multiplyChroma(YUVVector c, int16 coefficient) {
+	// The doubling multiply takes the place of the shift of the SSE2 version
+	return vsubq_s16(vqdmulhq_n_s16(vshlq_n_s16(c, 1), coefficient), vshrq_n_s16(c, 15));
+}
+
+static inline void computeOffsets(YUVVector u, YUVVector v, YUVVector &r, YUVVector &g, YUVVector &b) {
+	const YUVVector cr = vsubq_s16(v, vdupq_n_s16(128));
+	const YUVVector cb = vsubq_s16(u, vdupq_n_s16(128));
+	r = multiplyChroma(cr, kCrToR);
+	g = vnegq_s16(vaddq_s16(multiplyChroma(cr, kCrToG), multiplyChroma(cb, kCbToG)));
+	b = multiplyChroma(cb, kCbToB);
+}
+
+// The pixel format and luminance scale, in the form the vector code needs them
+struct YUVVectorFormat {
+	YUVVectorFormat(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+		itu = (lookup->getScale() == YUVToRGBManager::kScaleITU);
+		minValue = vdupq_n_s16(itu ? 16 : 0);
+		maxValue = vdupq_n_s16(itu ? 235 : 255);
+		// Negative counts shift to the right
+		rLoss = vdupq_n_s16(-format.rLoss);
+		gLoss = vdupq_n_s16(-format.gLoss);
+		bLoss = vdupq_n_s16(-format.bLoss);
+		// Shifting by 16 or more clears the lanes
+		rShiftLo = vdupq_n_s16(format.rShift < 16 ? format.rShift : 16);
+		gShiftLo = vdupq_n_s16(format.gShift < 16 ? format.gShift : 16);
+		bShiftLo = vdupq_n_s16(format.bShift < 16 ? format.bShift : 16);
+		rShiftHi = vdupq_n_s16(format.rShift >= 16 ? format.rShift - 16 : 16);
+		gShiftHi = vdupq_n_s16(format.gShift >= 16 ? format.gShift - 16 : 16);
+		bShiftHi = vdupq_n_s16(format.bShift >= 16 ? format.bShift - 16 : 16);
+		const uint32 alpha = format.ARGBToColor(255, 0, 0, 0);
+		alphaLo = vdupq_n_u16((uint16)(alpha & 0xFFFF));
+		alphaHi = vdupq_n_u16((uint16)(alpha >> 16));
+	}
+
+	bool itu;
+	int16x8_t minValue, maxValue;
+	int16x8_t rLoss, gLoss, bLoss;
+	int16x8_t rShiftLo, gShiftLo, bShiftLo;
+	int16x8_t rShiftHi, gShiftHi, bShiftHi;
+	uint16x8_t alphaLo, alphaHi;
+};
+
+// Add the luminance to the chroma offset of one channel, and scale it like the lookup table
+static inline uint16x8_t computeChannel(int16x8_t y, int16x8_t offset, int16x8_t loss, const YUVVectorFormat &format) {
+	uint16x8_t c = vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(vaddq_s16(y, offset), format.minValue), format.maxValue));
+	if (format.itu) {
+		// Stretching [0, 219] to [0, 255] is x + x * 10774 / 65536, which is exact for all values
+		const uint16x4_t stretch = vdup_n_u16(10774);
+		c = vsubq_u16(c, vreinterpretq_u16_s16(format.minValue));
+		c = vaddq_u16(c, vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(c), stretch), 16), vshrn_n_u32(vmull_u16(vget_high_u16(c), stretch), 16)));
+	}
+	return vshlq_u16(c, loss);
+}
+
+template<typename PixelInt>
+static inline void storePixels(PixelInt *dst, YUVVector y, YUVVector rOffset, YUVVector gOffset, YUVVector bOffset, const YUVVectorFormat &format) {
+	const uint16x8_t r = computeChannel(y, rOffset, format.rLoss, format);
+	const uint16x8_t g = computeChannel(y, gOffset, format.gLoss, format);
+	const uint16x8_t b = computeChannel(y, bOffset, format.bLoss, format);
+
+	// The pixels are put together as their lower and upper 16 bits
+	const uint16x8_t lo = vorrq_u16(vorrq_u16(vshlq_u16(r, format.rShiftLo), vshlq_u16(g, format.gShiftLo)),
+	                                vorrq_u16(vshlq_u16(b, format.bShiftLo), format.alphaLo));
+	if (sizeof(PixelInt) == 2) {
+		vst1q_u16((uint16 *)dst, lo);
+	} else {
+		const uint16x8_t hi = vorrq_u16(vorrq_u16(vshlq_u16(r, format.rShiftHi), vshlq_u16(g, format.gShiftHi)),
+		                                vorrq_u16(vshlq_u16(b, format.bShiftHi), format.alphaHi));
+		const uint16x8x2_t pixels = vzipq_u16(lo, hi);
+		vst1q_u16((uint16 *)dst, pixels.val[0]);
+		vst1q_u16((uint16 *)(dst + 4), pixels.val[1]);
+	}
+}
+#endif
+
+/**
+ * Check whether the vector code can produce pixels of the given format. It
+ * puts together the lower and the upper 16 bits of the pixels separately,
+ * so none of the channels may cross from one half into the other.
+ */
+static bool isVectorFormat(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel == 2)
+		return true;
+
+	const uint8 shifts[3] = { format.rShift, format.gShift, format.bShift };
+	const uint8 losses[3] = { format.rLoss, format.gLoss, format.bLoss };
+	for (int i = 0; i < 3; i++) {
+		if (shifts[i] < 16 && shifts[i] + 8 - losses[i] > 16)
+			return false;
+	}
+	return true;
+}
+
+// The vector versions below compute the pixels from the pixel format directly,
+// and only use the lookup table for the pixels left over at the end of the rows
+
+template<typename PixelInt>
+void convertYUV444ToRGBSIMD(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *rgbToPix = lookup->getRGBToPix();
+	const YUVVectorFormat format(lookup);
+
+	for (int h = 0; h < yHeight; h++) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+		int w = 0;
+
+		for (; w + 8 <= yWidth; w += 8) {
+			YUVVector r, g, b;
+			computeOffsets(loadBytes(uSrc + w), loadBytes(vSrc + w), r, g, b);
+			storePixels(dst + w, loadBytes(ySrc + w), r, g, b, format);
+		}
+
+		for (; w < yWidth; w++) {
+			const uint32 *L;
+
+			int16 cr_r  = Cr_r_tab[vSrc[w]];
+			int16 crb_g = Cr_g_tab[vSrc[w]] + Cb_g_tab[uSrc[w]];
+			int16 cb_b  = Cb_b_tab[uSrc[w]];
+
+			PUT_PIXEL(ySrc[w], dst + w);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt>
+void convertYUV420ToRGBSIMD(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *rgbToPix = lookup->getRGBToPix();
+	const YUVVectorFormat format(lookup);
+
+	for (int h = 0; h < yHeight; h += 2) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+		PixelInt *dst2 = (PixelInt *)(dstPtr + dstPitch);
+		const byte *ySrc2 = ySrc + yPitch;
+		int w = 0;
+
+		// Each chroma sample covers two pixels of the two rows
+		for (; w + 16 <= yWidth; w += 16) {
+			YUVVector r, g, b;
+			computeOffsets(loadBytes(uSrc + (w >> 1)), loadBytes(vSrc + (w >> 1)), r, g, b);
+			const YUVVector rLo = interleaveLo16(r, r), gLo = interleaveLo16(g, g), bLo = interleaveLo16(b, b);
+			const YUVVector rHi = interleaveHi16(r, r), gHi = interleaveHi16(g, g), bHi = interleaveHi16(b, b);
+			storePixels(dst + w, loadBytes(ySrc + w), rLo, gLo, bLo, format);
+			storePixels(dst + w + 8, loadBytes(ySrc + w + 8), rHi, gHi, bHi, format);
+			storePixels(dst2 + w, loadBytes(ySrc2 + w), rLo, gLo, bLo, format);
+			storePixels(dst2 + w + 8, loadBytes(ySrc2 + w + 8), rHi, gHi, bHi, format);
+		}
+
+		for (; w < yWidth; w += 2) {
+			const uint32 *L;
+			const byte u = uSrc[w >> 1];
+			const byte v = vSrc[w >> 1];
+
+			int16 cr_r  = Cr_r_tab[v];
+			int16 crb_g = Cr_g_tab[v] + Cb_g_tab[u];
+			int16 cb_b  = Cb_b_tab[u];
+
+			PUT_PIXEL(ySrc[w], dst + w);
+			PUT_PIXEL(ySrc[w + 1], dst + w + 1);
+			PUT_PIXEL(ySrc2[w], dst2 + w);
+			PUT_PIXEL(ySrc2[w + 1], dst2 + w + 1);
+		}
+
+		dstPtr += dstPitch << 1;
+		ySrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt>
+void convertYUV410ToRGBSIMD(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const int16 *Cr_r_tab = colorTab;
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *rgbToPix = lookup->getRGBToPix();
+	const YUVVectorFormat format(lookup);
+
+	for (int y = 0; y < yHeight; y++) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+		const int yDiff = y & 3;
+		const byte *uRow = uSrc + (y >> 2) * uvPitch;
+		const byte *vRow = vSrc + (y >> 2) * uvPitch;
+		int w = 0;
+
+		// The same bilinear interpolation as the scalar code, split into a
+		// vertical and a horizontal step, for 8 chroma samples at a time
+		for (; w + 32 <= yWidth; w += 32) {
+			const int index = w >> 2;
+			const YUVVector u0 = weightedSum(loadBytes(uRow + index), 4 - yDiff, loadBytes(uRow + index + uvPitch), yDiff);
+			const YUVVector u1 = weightedSum(loadBytes(uRow + index + 1), 4 - yDiff, loadBytes(uRow + index + uvPitch + 1), yDiff);
+			const YUVVector v0 = weightedSum(loadBytes(vRow + index), 4 - yDiff, loadBytes(vRow + index + uvPitch), yDiff);
+			const YUVVector v1 = weightedSum(loadBytes(vRow + index + 1), 4 - yDiff, loadBytes(vRow + index + uvPitch + 1), yDiff);
+
+			YUVVector u[4], v[4];
+			for (int xDiff = 0; xDiff < 4; xDiff++) {
+				u[xDiff] = shiftRight4(weightedSum(u0, 4 - xDiff, u1, xDiff));
+				v[xDiff] = shiftRight4(weightedSum(v0, 4 - xDiff, v1, xDiff));
+			}
+
+			// Bring the four pixels of each chroma sample next to each other
+			const YUVVector uLo01 = interleaveLo16(u[0], u[1]), uLo23 = interleaveLo16(u[2], u[3]);
+			const YUVVector uHi01 = interleaveHi16(u[0], u[1]), uHi23 = interleaveHi16(u[2], u[3]);
+			const YUVVector vLo01 = interleaveLo16(v[0], v[1]), vLo23 = interleaveLo16(v[2], v[3]);
+			const YUVVector vHi01 = interleaveHi16(v[0], v[1]), vHi23 = interleaveHi16(v[2], v[3]);
+			const YUVVector uPixels[4] = { interleaveLo32(uLo01, uLo23), interleaveHi32(uLo01, uLo23), interleaveLo32(uHi01, uHi23), interleaveHi32(uHi01, uHi23) };
+			const YUVVector vPixels[4] = { interleaveLo32(vLo01, vLo23), interleaveHi32(vLo01, vLo23), interleaveLo32(vHi01, vHi23), interleaveHi32(vHi01, vHi23) };
+
+			for (int i = 0; i < 4; i++) {
+				YUVVector r, g, b;
+				computeOffsets(uPixels[i], vPixels[i], r, g, b);
+				storePixels(dst + w + i * 8, loadBytes(ySrc + w + i * 8), r, g, b, format);
+			}
+		}
+
+		for (; w < yWidth; w++) {
+			const uint32 *L;
+			const int index = w >> 2;
+			const int xDiff = w & 3;
+			const byte u = (uRow[index] * (4 - xDiff) * (4 - yDiff) + uRow[index + 1] * xDiff * (4 - yDiff) +
+			                uRow[index + uvPitch] * yDiff * (4 - xDiff) + uRow[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+			const byte v = (vRow[index] * (4 - xDiff) * (4 - yDiff) + vRow[index + 1] * xDiff * (4 - yDiff) +
+			                vRow[index + uvPitch] * yDiff * (4 - xDiff) + vRow[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+
+			int16 cr_r  = Cr_r_tab[v];
+			int16 crb_g = Cr_g_tab[v] + Cb_g_tab[u];
+			int16 cb_b  = Cb_b_tab[u];
+
+			PUT_PIXEL(ySrc[w], dst + w);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+	}
+}
+
+#endif
+
 template<typename PixelInt>
 void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
@@ -246,6 +634,16 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	if (isVectorFormat(dst->format)) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV444ToRGBSIMD<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV444ToRGBSIMD<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -302,6 +700,16 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	if (isVectorFormat(dst->format)) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV420ToRGBSIMD<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV420ToRGBSIMD<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -451,6 +859,16 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	if (isVectorFormat(dst->format)) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV410ToRGBSIMD<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV410ToRGBSIMD<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -458,4 +876,20 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
+void YUVToRGBManager::convert(Graphics::Surface *dst, const YUVFrame &frame) {
+	switch (frame.chromaShift) {
+	case 0:
+		convert444(dst, frame.scale, frame.yPlane, frame.uPlane, frame.vPlane, frame.w, frame.h, frame.yPitch, frame.uvPitch);
+		break;
+	case 1:
+		convert420(dst, frame.scale, frame.yPlane, frame.uPlane, frame.vPlane, frame.w, frame.h, frame.yPitch, frame.uvPitch);
+		break;
+	case 2:
+		convert410(dst, frame.scale, frame.yPlane, frame.uPlane, frame.vPlane, frame.w, frame.h, frame.yPitch, frame.uvPitch);
+		break;
+	default:
+		error("YUVToRGBManager::convert(): Unsupported chroma subsampling %d", frame.chromaShift);
+	}
+}
+
 } // End of namespace Graphics
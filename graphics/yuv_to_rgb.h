@@ -45,6 +45,7 @@
 namespace Graphics {
 
 class YUVToRGBLookup;
+struct YUVFrame;
 
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
@@ -121,6 +122,17 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a planar YUV frame to an RGB surface
+	 *
+	 * This picks convert444(), convert420() or convert410() from the chroma
+	 * subsampling of the frame.
+	 *
+	 * @param dst   the destination surface
+	 * @param frame the frame to convert
+	 */
+	void convert(Graphics::Surface *dst, const YUVFrame &frame);
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -132,6 +144,41 @@ private:
 	int16 _colorTab[4 * 256]; // 2048 bytes
 	bool _alphaMode;
 };
+
+/**
+ * A planar YUV frame, as handed out by video decoders which leave the
+ * conversion to RGB to the caller.
+ *
+ * The planes are owned by whoever created the frame.
+ */
+struct YUVFrame {
+	YUVFrame() : yPlane(nullptr), uPlane(nullptr), vPlane(nullptr), w(0), h(0),
+		yPitch(0), uvPitch(0), chromaShift(1), scale(YUVToRGBManager::kScaleITU) {}
+
+	const byte *yPlane; ///< The y component
+	const byte *uPlane; ///< The u component
+	const byte *vPlane; ///< The v component
+
+	int w;       ///< The width of the y plane
+	int h;       ///< The height of the y plane
+	int yPitch;  ///< The pitch of the y plane
+	int uvPitch; ///< The pitch of the u and v planes
+
+	/**
+	 * The log2 of the chroma subsampling, in both directions:
+	 * 0 for YUV444, 1 for YUV420 and 2 for YUV410
+	 */
+	int chromaShift;
+
+	/** The scale of the luminance values */
+	YUVToRGBManager::LuminanceScale scale;
+
+	/** The width of the u and v planes */
+	int getChromaWidth() const { return (w + (1 << chromaShift) - 1) >> chromaShift; }
+
+	/** The height of the u and v planes */
+	int getChromaHeight() const { return (h + (1 << chromaShift) - 1) >> chromaShift; }
+};
  /** @} */
 } // End of namespace Graphics
 
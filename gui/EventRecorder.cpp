@@ -29,11 +29,15 @@ namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
+#ifdef SDL_BACKEND
 #include "backends/timer/sdl/sdl-timer.h"
+#endif
 #include "backends/mixer/mixer.h"
 #include "common/config-manager.h"
 #include "common/md5.h"
+#include "common/profiler.h"
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/onscreendialog.h"
@@ -76,6 +80,11 @@ EventRecorder::EventRecorder() {
 	_initialized = false;
 	_needRedraw = false;
 	_fastPlayback = false;
+	_timedemo = false;
+	_timedemoFinished = false;
+	_skipPresentation = false;
+	_timedemoStart = 0;
+	_lastFrameTime = 0;
 
 	_fakeTimer = 0;
 	_savedState = false;
@@ -101,6 +110,11 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	if (_timedemo && !_timedemoFinished)
+		finishTimedemo();
+	_timedemo = false;
+	_fastPlayback = false;
+	_frameTimes.clear();
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -146,12 +160,17 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 		break;
 	case kRecorderPlayback:
 		updateSubsystems();
-		if (_nextEvent.recordedtype == Common::kRecorderEventTypeTimer) {
+		if (_timedemoFinished) {
+			// Keep the time going until the engine handles the quit event
+			_fakeTimer++;
+		} else if (_nextEvent.recordedtype == Common::kRecorderEventTypeTimer) {
 			_fakeTimer = _nextEvent.time;
 			_nextEvent = _playbackFile->getNextEvent();
 			_timerManager->handler();
 		} else {
-			if (_nextEvent.type == Common::EVENT_RETURN_TO_LAUNCHER) {
+			if (_timedemo && (_nextEvent.type == Common::EVENT_RETURN_TO_LAUNCHER || _nextEvent.type == Common::EVENT_INVALID)) {
+				finishTimedemo();
+			} else if (_nextEvent.type == Common::EVENT_RETURN_TO_LAUNCHER) {
 				error("playback:action=stopplayback");
 			} else {
 				uint32 seconds = _fakeTimer / 1000;
@@ -174,6 +193,47 @@ bool EventRecorder::processDelayMillis() {
 	return _fastPlayback;
 }
 
+bool EventRecorder::processUpdateScreen() {
+	if (!_timedemo || !_initialized || _timedemoFinished)
+		return false;
+
+	uint64 now = Common::Profiler::getMicros();
+	_frameTimes.push_back(now - _lastFrameTime);
+	_lastFrameTime = now;
+	return _skipPresentation;
+}
+
+void EventRecorder::finishTimedemo() {
+	uint64 wallTime = Common::Profiler::getMicros() - _timedemoStart;
+	_timedemoFinished = true;
+
+	Common::Array<uint32> sorted = _frameTimes;
+	Common::sort(sorted.begin(), sorted.end());
+	const uint frames = sorted.size();
+	debug("timedemo:frames=%u recorded=%u.%03us wall=%u.%03us fps=%.1f", frames, _fakeTimer / 1000, _fakeTimer % 1000,
+	      (uint32)(wallTime / 1000000), (uint32)(wallTime / 1000 % 1000), wallTime ? frames * 1000000.0 / wallTime : 0.0);
+	if (frames) {
+		debug("timedemo:frametime p50=%.3fms p90=%.3fms p99=%.3fms max=%.3fms", sorted[frames * 50 / 100] / 1000.0,
+		      sorted[frames * 90 / 100] / 1000.0, sorted[frames * 99 / 100] / 1000.0, sorted[frames - 1] / 1000.0);
+	}
+
+	Graphics::Surface screen;
+	uint8 md5[16];
+	if (grabScreenAndComputeMD5(screen, md5)) {
+		Common::String md5String;
+		for (int i = 0; i < 16; i++)
+			md5String += Common::String::format("%02x", md5[i]);
+		debug("timedemo:screen md5=%s", md5String.c_str());
+		screen.free();
+	}
+
+	// Quit once the engine polls the events again
+	_nextEvent = Common::RecorderEvent();
+	_nextEvent.recordedtype = Common::kRecorderEventTypeNormal;
+	_nextEvent.type = Common::EVENT_QUIT;
+	_nextEvent.kbdRepeat = true;
+}
+
 void EventRecorder::checkForKeyCode(const Common::Event &event) {
 	if ((event.type == Common::EVENT_KEYDOWN) && (event.kbd.flags & Common::KBD_CTRL) && (event.kbd.keycode == Common::KEYCODE_p) && (!event.kbdRepeat)) {
 		togglePause();
@@ -188,6 +248,12 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 		return false;
 	}
 
+	if (_timedemoFinished) {
+		ev = _nextEvent;
+		_nextEvent.type = Common::EVENT_INVALID;
+		return true;
+	}
+
 	switch (_nextEvent.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -293,6 +359,15 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 	if (_recordMode == kRecorderPlayback) {
 		applyPlaybackSettings();
 		_nextEvent = _playbackFile->getNextEvent();
+
+		_timedemo = ConfMan.getBool("timedemo");
+		_timedemoFinished = false;
+		if (_timedemo) {
+			_fastPlayback = true;
+			_skipPresentation = ConfMan.getBool("disable_display");
+			_frameTimes.clear();
+			_timedemoStart = _lastFrameTime = Common::Profiler::getMicros();
+		}
 	}
 	if (_recordMode == kRecorderRecord) {
 		getConfig();
@@ -420,7 +495,12 @@ void EventRecorder::registerTimerManager(DefaultTimerManager *timerManager) {
 void EventRecorder::switchTimerManagers() {
 	delete _timerManager;
 	if (_recordMode == kPassthrough) {
+#ifdef SDL_BACKEND
 		_timerManager = new SdlTimerManager();
+#else
+		// The backend fires the timers itself, as it polls the events
+		_timerManager = new DefaultTimerManager();
+#endif
 	} else {
 		_timerManager = new DefaultTimerManager();
 	}
@@ -553,6 +633,8 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_timedemo)
+		return;
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -569,6 +651,8 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_timedemo)
+		return;
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -609,10 +693,12 @@ void EventRecorder::setFileHeader() {
 	_playbackFile->getHeader().name = _name;
 }
 
+#ifdef SDL_BACKEND
 SDL_Surface *EventRecorder::getSurface(int width, int height) {
 	// Create a RGB565 surface of the requested dimensions.
 	return SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, 16, 0xF800, 0x07E0, 0x001F, 0x0000);
 }
+#endif
 
 bool EventRecorder::switchMode() {
 	const Plugin *plugin = EngineMan.findPlugin(ConfMan.get("engineid"));
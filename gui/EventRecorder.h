@@ -39,7 +39,11 @@
 #include "backends/mixer/mixer.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#ifdef SDL_BACKEND
 #include "backends/timer/sdl/sdl-timer.h"
+#else
+#include "backends/timer/default/default-timer.h"
+#endif
 #include "common/config-manager.h"
 #include "common/recorderfile.h"
 #include "backends/saves/recorder/recorder-saves.h"
@@ -80,6 +84,12 @@ public:
 	void init(Common::String recordFileName, RecordMode mode);
 	void deinit();
 	bool processDelayMillis();
+
+	/**
+	 * Called before each screen update. It measures the frame times of a
+	 * timedemo, and returns true when the frame should not be presented.
+	 */
+	bool processUpdateScreen();
 	uint32 getRandomSeed(const Common::String &name);
 	void processMillis(uint32 &millis, bool skipRecord);
 	bool processAudio(uint32 &samples, bool paused);
@@ -164,7 +174,9 @@ public:
 	Common::String generateRecordFileName(const Common::String &target);
 
 	Common::SaveFileManager *getSaveManager(Common::SaveFileManager *realSaveManager);
+#ifdef SDL_BACKEND
 	SDL_Surface *getSurface(int width, int height);
+#endif
 	void RegisterEventSource();
 
 	/** Retrieve game screenshot and compute its checksum for comparison */
@@ -227,6 +239,19 @@ private:
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
+
+	/**
+	 * Timedemo: the recording is played back as fast as possible, optionally
+	 * without presenting the frames, and the timings are reported at its end.
+	 */
+	bool _timedemo;
+	bool _timedemoFinished;
+	bool _skipPresentation;
+	uint64 _timedemoStart;
+	uint64 _lastFrameTime;
+	Common::Array<uint32> _frameTimes;
+
+	void finishTimedemo();
 };
 
 } // End of namespace GUI
@@ -24,6 +24,10 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/lrulist.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -100,6 +104,167 @@ struct WidgetDrawData {
 	void calcBackgroundOffset();
 };
 
+/**
+ * Keeps the renderings of the most recently drawn DrawData items. Drawing the
+ * same item at the same place over the same pixels again, as redrawing a
+ * dialog or hovering over its widgets does, then is a copy of the pixels
+ * instead of running all the draw steps through the vector renderer.
+ */
+class DrawDataCache {
+public:
+	/**
+	 * The colors the vector renderer is left with. The draw steps not setting
+	 * one of their colors draw with the one set before them.
+	 */
+	struct Colors {
+		Graphics::DrawStep::Color fg, bg, gradient1, gradient2, bevel;
+
+		void apply(const Graphics::DrawStep &step) {
+			if (step.bgColor.set)
+				bg = step.bgColor;
+			if (step.fgColor.set)
+				fg = step.fgColor;
+			if (step.bevelColor.set)
+				bevel = step.bevelColor;
+			if (step.gradColor1.set && step.gradColor2.set) {
+				gradient1 = step.gradColor1;
+				gradient2 = step.gradColor2;
+			}
+		}
+
+		static bool equals(const Graphics::DrawStep::Color &a, const Graphics::DrawStep::Color &b) {
+			return a.set == b.set && a.r == b.r && a.g == b.g && a.b == b.b;
+		}
+
+		bool operator==(const Colors &other) const {
+			return equals(fg, other.fg) && equals(bg, other.bg) && equals(gradient1, other.gradient1) &&
+			       equals(gradient2, other.gradient2) && equals(bevel, other.bevel);
+		}
+	};
+
+	struct Key {
+		DrawData type;
+		Common::Rect area, clip;
+		uint32 dynamic;
+		const Graphics::Surface *surface;
+		Colors colors;
+
+		bool operator==(const Key &other) const {
+			return type == other.type && area == other.area && clip == other.clip &&
+			       dynamic == other.dynamic && surface == other.surface && colors == other.colors;
+		}
+	};
+
+	enum {
+		kMaxEntries = 256,
+		kMaxBytes = 16 * 1024 * 1024
+	};
+
+	DrawDataCache() : _bytes(0) {}
+
+	~DrawDataCache() {
+		clear();
+	}
+
+	/** The colors the vector renderer currently draws with */
+	Colors colors;
+
+	// Renderings taking more than a quarter of the cache are not kept
+	static bool fits(const Common::Rect &r, const Graphics::PixelFormat &format) {
+		return 2 * r.width() * r.height() * format.bytesPerPixel <= kMaxBytes / 4;
+	}
+
+	/**
+	 * Copies the rendering of the key into r of the surface, if it was drawn
+	 * over the same pixels as r holds now. Returns whether it was copied.
+	 */
+	bool replay(const Key &key, const Common::Rect &r, Graphics::Surface &surface) {
+		for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->key == key && i->rect == r) {
+				if (!equals(*i->before, surface, r))
+					return false;
+
+				const uint rowSize = r.width() * surface.format.bytesPerPixel;
+				for (int y = 0; y < r.height(); ++y)
+					memcpy(surface.getBasePtr(r.left, r.top + y), i->after->getBasePtr(0, y), rowSize);
+
+				_entries.touch(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Keeps the rendering of the key, from r of the surface before and after
+	 * the drawing. Takes over the before surface.
+	 */
+	void insert(const Key &key, const Common::Rect &r, Graphics::Surface *before, const Graphics::Surface &surface) {
+		const uint32 size = 2 * before->pitch * before->h;
+		invalidate(key);
+		while (!_entries.empty() && (_entries.size() >= kMaxEntries || _bytes + size > kMaxBytes)) {
+			freeEntry(_entries.leastRecent());
+			_entries.removeLeastRecent();
+		}
+
+		Entry entry;
+		entry.key = key;
+		entry.rect = r;
+		entry.before = before;
+		entry.after = new Graphics::Surface();
+		entry.after->copyFrom(surface.getSubArea(r));
+		_entries.add(entry);
+		_bytes += size;
+	}
+
+	void clear() {
+		for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i)
+			freeEntry(*i);
+		_entries.clear();
+		colors = Colors();
+	}
+
+private:
+	struct Entry {
+		Key key;
+		Common::Rect rect;
+		Graphics::Surface *before;
+		Graphics::Surface *after;
+	};
+	typedef Common::LRUList<Entry> EntryList;
+
+	static bool equals(const Graphics::Surface &snapshot, const Graphics::Surface &surface, const Common::Rect &r) {
+		const uint rowSize = r.width() * surface.format.bytesPerPixel;
+		for (int y = 0; y < r.height(); ++y) {
+			if (memcmp(snapshot.getBasePtr(0, y), surface.getBasePtr(r.left, r.top + y), rowSize))
+				return false;
+		}
+		return true;
+	}
+
+	// Only the latest rendering of a key is kept
+	void invalidate(const Key &key) {
+		for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->key == key) {
+				freeEntry(*i);
+				_entries.erase(i);
+				return;
+			}
+		}
+	}
+
+	void freeEntry(Entry &entry) {
+		_bytes -= 2 * entry.before->pitch * entry.before->h;
+		entry.before->free();
+		entry.after->free();
+		delete entry.before;
+		delete entry.after;
+	}
+
+	EntryList _entries;
+	uint32 _bytes;
+};
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -193,6 +358,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_cursor(nullptr) {
 
 	_system = g_system;
+	_drawDataCache = new DrawDataCache();
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
 
@@ -245,6 +411,9 @@ ThemeEngine::~ThemeEngine() {
 	unloadTheme();
 	unloadExtraFont();
 
+	delete _drawDataCache;
+	_drawDataCache = nullptr;
+
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
 		Graphics::Surface *surf = i->_value;
@@ -466,6 +635,7 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
+	_drawDataCache->clear();
 
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
@@ -685,6 +855,8 @@ bool ThemeEngine::addBitmap(const Common::String &filename) {
 		// Maybe it is PNG?
 #ifdef USE_PNG
 		Image::PNGDecoder decoder;
+		if (_overlayFormat.bytesPerPixel == 2 || _overlayFormat.bytesPerPixel == 4)
+			decoder.setOutputPixelFormat(_overlayFormat);
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, filename);
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
@@ -745,6 +917,8 @@ bool ThemeEngine::addAlphaBitmap(const Common::String &filename) {
 		// Maybe it is PNG?
 #ifdef USE_PNG
 		Image::PNGDecoder decoder;
+		if (_overlayFormat.bytesPerPixel == 2 || _overlayFormat.bytesPerPixel == 4)
+			decoder.setOutputPixelFormat(_overlayFormat);
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, filename);
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
@@ -825,6 +999,8 @@ void ThemeEngine::unloadTheme() {
 	if (!_themeOk)
 		return;
 
+	_drawDataCache->clear();
+
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		delete _widgets[i];
 		_widgets[i] = nullptr;
@@ -923,30 +1099,154 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 	}
 
 	//
-	// Loop over all STX files, load and parse them
+	// Load all STX files. Their checksum tells whether the compiled form
+	// cached by a previous run can be used instead of parsing them.
 	//
+	Common::Array<Common::SeekableReadStream *> stxFiles;
+	Common::String checksum = SCUMMVM_THEME_VERSION_STR;
+	bool result = true;
+
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
-		if (_parser->loadStream((*i)->createReadStream()) == false) {
+		Common::SeekableReadStream *stream = (*i)->createReadStream();
+		Common::SeekableReadStream *stxFile = stream ? stream->readStream(stream->size()) : nullptr;
+		delete stream;
+
+		if (!stxFile) {
 			warning("Failed to load STX file '%s'", (*i)->getDisplayName().c_str());
-			_parser->close();
-			return false;
+			result = false;
+			break;
 		}
 
-		if (_parser->parse() == false) {
-			warning("Failed to parse STX file '%s'", (*i)->getDisplayName().c_str());
+		checksum += " " + Common::computeStreamMD5AsString(*stxFile);
+		stxFiles.push_back(stxFile);
+	}
+
+	if (result && !loadThemeCache(themeId, checksum)) {
+		Common::Array<Common::MemoryWriteStreamDynamic *> compiled;
+
+		//
+		// Parse the STX files
+		//
+		Common::ArchiveMemberList::iterator member = members.begin();
+		for (uint i = 0; i < stxFiles.size(); ++i, ++member) {
+			Common::MemoryWriteStreamDynamic *compiledFile = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+			compiled.push_back(compiledFile);
+
+			// The parser takes ownership of the stream
+			_parser->loadStream(stxFiles[i]);
+			stxFiles[i] = nullptr;
+
+			if (_parser->parseAndCompile(*compiledFile) == false) {
+				warning("Failed to parse STX file '%s'", (*member)->getDisplayName().c_str());
+				_parser->close();
+				result = false;
+				break;
+			}
+
 			_parser->close();
-			return false;
 		}
 
-		_parser->close();
+		if (result)
+			saveThemeCache(themeId, checksum, compiled);
+
+		for (uint i = 0; i < compiled.size(); ++i)
+			delete compiled[i];
 	}
 
+	for (uint i = 0; i < stxFiles.size(); ++i)
+		delete stxFiles[i];
+
+	if (!result)
+		return false;
+
 	assert(!_themeName.empty());
 	return true;
 }
 
+static const uint32 kThemeCacheMagic = MKTAG('S', 'V', 'T', 'C');
+static const uint32 kThemeCacheVersion = 1;
+
+static Common::String getThemeCacheName(const Common::String &themeId) {
+	Common::String name = ".theme-";
+	for (uint i = 0; i < themeId.size(); ++i)
+		name += Common::isAlnum(themeId[i]) ? themeId[i] : '_';
+	return name + ".cache";
+}
+
+bool ThemeEngine::loadThemeCache(const Common::String &themeId, const Common::String &checksum) {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	Common::InSaveFile *in = saveFileMan ? saveFileMan->openForLoading(getThemeCacheName(themeId)) : nullptr;
+	if (!in)
+		return false;
+
+	bool valid = in->readUint32BE() == kThemeCacheMagic && in->readUint32LE() == kThemeCacheVersion;
+	valid = valid && in->readString() == checksum;
+
+	Common::Array<Common::SeekableReadStream *> compiled;
+	if (valid) {
+		const uint32 count = in->readUint32LE();
+		for (uint32 i = 0; i < count && valid; ++i) {
+			const uint32 size = in->readUint32LE();
+			Common::SeekableReadStream *compiledFile = in->readStream(size);
+			valid = !in->eos() && !in->err() && compiledFile && compiledFile->size() == (int64)size;
+			if (compiledFile)
+				compiled.push_back(compiledFile);
+		}
+	}
+	delete in;
+
+	if (!valid) {
+		for (uint i = 0; i < compiled.size(); ++i)
+			delete compiled[i];
+		return false;
+	}
+
+	debug(6, "Loading theme %s from its cache", themeId.c_str());
+
+	bool result = true;
+	for (uint i = 0; i < compiled.size(); ++i) {
+		// The parser takes ownership of the stream
+		_parser->loadStream(compiled[i]);
+		compiled[i] = nullptr;
+
+		if (result && _parser->parseCompiled() == false) {
+			// The theme is now partially loaded, so it cannot fall back to
+			// the STX files. Remove the cache so the next attempt does.
+			warning("Failed to parse the cache of theme '%s'", themeId.c_str());
+			saveFileMan->removeSavefile(getThemeCacheName(themeId));
+			result = false;
+		}
+
+		_parser->close();
+	}
+
+	return result;
+}
+
+void ThemeEngine::saveThemeCache(const Common::String &themeId, const Common::String &checksum, const Common::Array<Common::MemoryWriteStreamDynamic *> &compiled) {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	Common::OutSaveFile *out = saveFileMan ? saveFileMan->openForSaving(getThemeCacheName(themeId), false) : nullptr;
+	if (!out)
+		return;
+
+	out->writeUint32BE(kThemeCacheMagic);
+	out->writeUint32LE(kThemeCacheVersion);
+	out->writeString(checksum);
+	out->writeByte(0);
+	out->writeUint32LE(compiled.size());
+	for (uint i = 0; i < compiled.size(); ++i) {
+		out->writeUint32LE(compiled[i]->size());
+		out->write(compiled[i]->getData(), compiled[i]->size());
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("Could not write the cache of theme '%s'", themeId.c_str());
+	delete out;
+}
+
 
 
 /**********************************************************
@@ -984,9 +1284,47 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		Graphics::Surface &surface = *_vectorRenderer->getActiveSurface();
+		Common::Rect cachedRect = extendedRect;
+		cachedRect.clip(surface.w, surface.h);
+
+		DrawDataCache::Key key;
+		key.type = type;
+		key.area = area;
+		key.clip = _clip;
+		key.dynamic = dynamic;
+		key.surface = &surface;
+		key.colors = _drawDataCache->colors;
+
 		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (_drawDataCache->replay(key, cachedRect, surface)) {
+			// The renderer is left with the colors the steps would have set
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				if (step->bgColor.set)
+					_vectorRenderer->setBgColor(step->bgColor.r, step->bgColor.g, step->bgColor.b);
+				if (step->fgColor.set)
+					_vectorRenderer->setFgColor(step->fgColor.r, step->fgColor.g, step->fgColor.b);
+				if (step->bevelColor.set)
+					_vectorRenderer->setBevelColor(step->bevelColor.r, step->bevelColor.g, step->bevelColor.b);
+				if (step->gradColor1.set && step->gradColor2.set)
+					_vectorRenderer->setGradientColors(step->gradColor1.r, step->gradColor1.g, step->gradColor1.b,
+						step->gradColor2.r, step->gradColor2.g, step->gradColor2.b);
+				_drawDataCache->colors.apply(*step);
+			}
+		} else {
+			Graphics::Surface *before = nullptr;
+			if (!cachedRect.isEmpty() && DrawDataCache::fits(cachedRect, surface.format)) {
+				before = new Graphics::Surface();
+				before->copyFrom(surface.getSubArea(cachedRect));
+			}
+
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+				_drawDataCache->colors.apply(*step);
+			}
+
+			if (before)
+				_drawDataCache->insert(key, cachedRect, before, surface);
 		}
 
 		addDirtyRect(extendedRect);
@@ -1018,6 +1356,10 @@ void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect
 		restoreBackground(dirty);
 
 	_vectorRenderer->setFgColor(_textColors[color]->r, _textColors[color]->g, _textColors[color]->b);
+	_drawDataCache->colors.fg.r = _textColors[color]->r;
+	_drawDataCache->colors.fg.g = _textColors[color]->g;
+	_drawDataCache->colors.fg.b = _textColors[color]->b;
+	_drawDataCache->colors.fg.set = true;
 #ifdef USE_FRIBIDI
 	_vectorRenderer->drawString(_texts[type]->_fontPtr, Common::convertBiDiU32String(text), area, alignH, alignV, deltax, ellipsis, dirty);
 #else
@@ -42,6 +42,10 @@
 
 class OSystem;
 
+namespace Common {
+class MemoryWriteStreamDynamic;
+}
+
 namespace Graphics {
 struct DrawStep;
 class VectorRenderer;
@@ -50,6 +54,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+class DrawDataCache;
 struct TextDrawData;
 struct TextColorData;
 class Dialog;
@@ -673,6 +678,22 @@ protected:
 	 */
 	bool loadThemeXML(const Common::String &themeId);
 
+	/**
+	 * Loads the theme from the compiled form of its STX files cached by
+	 * saveThemeCache(), if it has the given checksum.
+	 *
+	 * @param themeId Theme identifier.
+	 * @param checksum Checksum of the theme's STX files.
+	 * @returns true if the theme was loaded from the cache.
+	 */
+	bool loadThemeCache(const Common::String &themeId, const Common::String &checksum);
+
+	/**
+	 * Caches the compiled form of the theme's STX files, as written by
+	 * Common::XMLParser::parseAndCompile().
+	 */
+	void saveThemeCache(const Common::String &themeId, const Common::String &checksum, const Common::Array<Common::MemoryWriteStreamDynamic *> &compiled);
+
 	/**
 	 * Loads the default theme file (the embedded XML file found
 	 * in ThemeDefaultXML.cpp).
@@ -760,6 +781,9 @@ protected:
 	/** Backbuffer surface. Stores previous states of the screen to blit back */
 	Graphics::TransparentSurface _backBuffer;
 
+	/** Renderings of the recently drawn DrawData items, to copy instead of drawing them again */
+	DrawDataCache *_drawDataCache;
+
 	/**
 	 * Filter the submitted DrawData descriptors according to their layer attribute
 	 *
@@ -26,6 +26,7 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -37,6 +38,9 @@
 
 #include "engines/engine.h"
 
+#include "audio/mixer.h"
+#include "audio/pcmcache.h"
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -79,6 +83,12 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+	registerCmd("pcmcache",			WRAP_METHOD(Debugger, cmdPCMCache));
+	registerCmd("mixerstats",		WRAP_METHOD(Debugger, cmdMixerStats));
+	registerCmd("framestats",		WRAP_METHOD(Debugger, cmdFrameStats));
+#ifdef USE_PROFILER
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -766,6 +776,29 @@ bool Debugger::cmdDebugFlagEnable(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef USE_PROFILER
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "summary")) {
+		debugPrintf("%s", Common::Profiler::getSummary().c_str());
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		Common::Profiler::reset();
+		debugPrintf("Profiling zones cleared\n");
+	} else if (argc == 3 && !strcmp(argv[1], "trace")) {
+		Common::DumpFile out;
+		if (!out.open(argv[2], true)) {
+			debugPrintf("Could not open '%s' for writing\n", argv[2]);
+		} else if (!Common::Profiler::writeChromeTrace(out) || !out.flush()) {
+			debugPrintf("Could not write '%s'\n", argv[2]);
+		} else {
+			debugPrintf("Chrome trace written to '%s'\n", argv[2]);
+		}
+	} else {
+		debugPrintf("Usage: profile summary | reset | trace <filename>\n");
+	}
+	return true;
+}
+#endif
+
 bool Debugger::cmdExecFile(int argc, const char **argv) {
 	if (argc <= 1) {
 		debugPrintf("Expected to get the file with debug commands\n");
@@ -804,6 +837,85 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdPCMCache(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "clear")) {
+		PCMCacheMan.clear();
+		debugPrintf("PCM cache cleared\n");
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		PCMCacheMan.resetStats();
+		debugPrintf("PCM cache counters reset\n");
+	} else if (argc == 1) {
+		const Audio::PCMCache::Stats stats = PCMCacheMan.getStats();
+		debugPrintf("Sounds: %u, %u of %u bytes\n", stats.entries, stats.size, stats.budget);
+		debugPrintf("Hits: %u, misses: %u, evictions: %u\n", stats.hits, stats.misses, stats.evictions);
+	} else {
+		debugPrintf("Usage: pcmcache [clear | reset]\n");
+	}
+	return true;
+}
+
+bool Debugger::cmdFrameStats(int argc, const char **argv) {
+	Engine::FrameStats &stats = g_engine->getFrameStats();
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		stats.reset();
+		debugPrintf("Frame statistics reset\n");
+	} else if (argc == 3 && !strcmp(argv[1], "osd")) {
+		stats.setOverlay(!strcmp(argv[2], "on"));
+		debugPrintf("Frame statistics overlay %s\n", !strcmp(argv[2], "on") ? "enabled" : "disabled");
+	} else if (argc == 1) {
+		if (!stats.getFrameCount())
+			debugPrintf("This engine does not mark its frames\n");
+		else
+			debugPrintf("%s", stats.getSummary().c_str());
+	} else {
+		debugPrintf("Usage: framestats [reset | osd on|off]\n");
+	}
+	return true;
+}
+
+bool Debugger::cmdMixerStats(int argc, const char **argv) {
+	static const char *const typeNames[] = { "plain", "music", "sfx", "speech" };
+	Audio::Mixer *mixer = g_system->getMixer();
+	Audio::MixerStats stats;
+
+	if (argc == 2 && !strcmp(argv[1], "reset")) {
+		mixer->resetStats();
+		debugPrintf("Mixer counters reset\n");
+	} else if (argc == 3 && !strcmp(argv[1], "osd")) {
+		mixer->setStatsOverlay(!strcmp(argv[2], "on"));
+		debugPrintf("Mixer overlay %s\n", !strcmp(argv[2], "on") ? "enabled" : "disabled");
+	} else if (argc == 1) {
+		if (!mixer->getStats(stats)) {
+			debugPrintf("This mixer does not collect statistics\n");
+			return true;
+		}
+
+		debugPrintf("Output: %u Hz, %u frames per callback (%.1f ms)\n", stats.outputRate, stats.bufferFrames,
+		            stats.outputRate ? stats.bufferFrames * 1000.0 / stats.outputRate : 0.0);
+		debugPrintf("Callbacks: %u, average %u us, maximum %u us, %u late, %u underruns\n", stats.callbacks,
+		            stats.callbacks ? (uint32)(stats.totalCallbackMicros / stats.callbacks) : 0,
+		            stats.maxCallbackMicros, stats.lateCallbacks, stats.underruns);
+		for (int i = 0; i < Audio::MixerStats::kNumCallbackBuckets; ++i) {
+			if (Audio::MixerStats::getBucketLimit(i))
+				debugPrintf("  below %5u us: %u\n", Audio::MixerStats::getBucketLimit(i), stats.histogram[i]);
+			else
+				debugPrintf("  above %5u us: %u\n", Audio::MixerStats::getBucketLimit(i - 1), stats.histogram[i]);
+		}
+		debugPrintf("Sounds: %u\n", stats.channels.size());
+		for (uint i = 0; i < stats.channels.size(); ++i) {
+			const Audio::MixerStats::ChannelStats &channel = stats.channels[i];
+			debugPrintf("  %-6s id %6d, %5u Hz %-6s, %-6s resampler, %u us per mix, %u of %u mixes starved\n",
+			            typeNames[channel.type], channel.id, channel.rate, channel.stereo ? "stereo" : "mono",
+			            channel.resampler, channel.mixes ? (uint32)(channel.micros / channel.mixes) : 0,
+			            channel.starved, channel.mixes);
+		}
+	} else {
+		debugPrintf("Usage: mixerstats [reset | osd on|off]\n");
+	}
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
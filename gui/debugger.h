@@ -243,6 +243,12 @@ protected:
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
 	bool cmdExecFile(int argc, const char **argv);
+	bool cmdPCMCache(int argc, const char **argv);
+	bool cmdMixerStats(int argc, const char **argv);
+	bool cmdFrameStats(int argc, const char **argv);
+#ifdef USE_PROFILER
+	bool cmdProfile(int argc, const char **argv);
+#endif
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
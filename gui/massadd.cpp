@@ -20,12 +20,15 @@
  *
  */
 
+#include "engines/advancedDetector.h"
+#include "engines/detectioncache.h"
 #include "engines/metaengine.h"
 #include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/system.h"
 #include "common/taskbar.h"
+#include "common/threadpool.h"
 #include "common/translation.h"
 
 #include "gui/massadd.h"
@@ -53,6 +56,43 @@ enum {
 	kCancelCmd = 'CNCL'
 };
 
+namespace {
+
+struct ScanJob {
+	Common::FSNode dir;
+	Common::FSList files;
+	bool listed;
+	bool pirated;
+	DetectedGames candidates;
+
+	ScanJob() : listed(false), pirated(false) {}
+};
+
+/**
+ * Lists the directories of a batch and runs the thread-safe detectors on
+ * them. Each call only touches the jobs of its own range.
+ */
+struct ScanBatchProc {
+	Common::Array<ScanJob> &_jobs;
+
+	ScanBatchProc(Common::Array<ScanJob> &jobs) : _jobs(jobs) {}
+
+	void operator()(uint begin, uint end) const {
+		for (uint i = begin; i < end; ++i) {
+			ScanJob &job = _jobs[i];
+			job.listed = job.dir.getChildren(job.files, Common::FSNode::kListAll);
+			if (job.listed) {
+				// The message is shown from the GUI thread, once the batch is done
+				ADPiratedReportDeferrer deferrer;
+				job.candidates = EngineMan.detectGamesPass(job.files, true);
+				job.pirated = deferrer.foundPirated();
+			}
+		}
+	}
+};
+
+} // End of anonymous namespace
+
 
 
 MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
@@ -69,6 +109,9 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	// The dir we start our scan at
 	_scanStack.push(startDir);
 
+	// Read the detection cache now, rather than from a worker thread
+	DetectionCache::instance().load();
+
 	// Removed for now... Why would you put a title on mass add dialog called "Mass Add Dialog"?
 	// new StaticTextWidget(this, "massadddialog_caption", "Mass Add Dialog");
 
@@ -159,86 +202,106 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 	}
 }
 
+void MassAddDialog::addDetectedGames(const Common::FSNode &dir, const DetectionResults &detectionResults) {
+	if (detectionResults.foundUnknownGames()) {
+		Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
+		g_system->logMessage(LogMessageType::kInfo, report.encode().c_str());
+	}
+
+	// Just add all detected games / game variants. If we get more than one,
+	// that either means the directory contains multiple games, or the detector
+	// could not fully determine which game variant it was seeing. In either
+	// case, let the user choose which entries he wants to keep.
+	//
+	// However, we only add games which are not already in the config file.
+	DetectedGames candidates = detectionResults.listRecognizedGames();
+	for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
+		const DetectedGame &result = *cand;
+
+		Common::String path = dir.getPath();
+
+		// Remove trailing slashes
+		while (path != "/" && path.lastChar() == '/')
+			path.deleteLastChar();
+
+		// Check for existing config entries for this path/engineid/gameid/lang/platform combination
+		if (_pathToTargets.contains(path)) {
+			Common::String resultPlatformCode = Common::getPlatformCode(result.platform);
+			Common::String resultLanguageCode = Common::getLanguageCode(result.language);
+
+			bool duplicate = false;
+			const StringArray &targets = _pathToTargets[path];
+			for (StringArray::const_iterator iter = targets.begin(); iter != targets.end(); ++iter) {
+				// If the engineid, gameid, platform and language match -> skip it
+				Common::ConfigManager::Domain *dom = ConfMan.getDomain(*iter);
+				assert(dom);
+
+				if ((*dom)["engineid"] == result.engineId &&
+					(*dom)["gameid"] == result.gameId &&
+				    (*dom)["platform"] == resultPlatformCode &&
+				    (*dom)["language"] == resultLanguageCode) {
+					duplicate = true;
+					break;
+				}
+			}
+			if (duplicate) {
+				_oldGamesCount++;
+				continue;	// Skip duplicates
+			}
+		}
+		_games.push_back(result);
+
+		_list->append(result.description);
+	}
+}
+
 void MassAddDialog::handleTickle() {
 	if (_scanStack.empty())
 		return;	// We have finished scanning
 
 	uint32 t = g_system->getMillis();
 
+	// Directories are taken from the stack in batches, which are listed and
+	// run through the thread-safe detectors on the thread pool. The results
+	// are then merged in stack order, so that they do not depend on how the
+	// work was spread over the threads. Cancelling takes effect between
+	// two tickles.
+	const uint numWorkers = Common::ThreadPool::instance().getNumWorkers();
+	const uint batchSize = numWorkers ? (numWorkers + 1) * 4 : 1;
+
 	// Perform a breadth-first scan of the filesystem.
 	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
-
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
-			continue;
+		Common::Array<ScanJob> batch;
+		while (!_scanStack.empty() && batch.size() < batchSize) {
+			batch.push_back(ScanJob());
+			batch.back().dir = _scanStack.pop();
 		}
 
-		// Run the detector on the dir
-		DetectionResults detectionResults = EngineMan.detectGames(files);
-
-		if (detectionResults.foundUnknownGames()) {
-			Common::U32String report = detectionResults.generateUnknownGameReport(false, 80);
-			g_system->logMessage(LogMessageType::kInfo, report.encode().c_str());
-		}
+		Common::parallelFor(0, batch.size(), 1, ScanBatchProc(batch));
 
-		// Just add all detected games / game variants. If we get more than one,
-		// that either means the directory contains multiple games, or the detector
-		// could not fully determine which game variant it was seeing. In either
-		// case, let the user choose which entries he wants to keep.
-		//
-		// However, we only add games which are not already in the config file.
-		DetectedGames candidates = detectionResults.listRecognizedGames();
-		for (DetectedGames::const_iterator cand = candidates.begin(); cand != candidates.end(); ++cand) {
-			const DetectedGame &result = *cand;
-
-			Common::String path = dir.getPath();
-
-			// Remove trailing slashes
-			while (path != "/" && path.lastChar() == '/')
-				path.deleteLastChar();
-
-			// Check for existing config entries for this path/engineid/gameid/lang/platform combination
-			if (_pathToTargets.contains(path)) {
-				Common::String resultPlatformCode = Common::getPlatformCode(result.platform);
-				Common::String resultLanguageCode = Common::getLanguageCode(result.language);
-
-				bool duplicate = false;
-				const StringArray &targets = _pathToTargets[path];
-				for (StringArray::const_iterator iter = targets.begin(); iter != targets.end(); ++iter) {
-					// If the engineid, gameid, platform and language match -> skip it
-					Common::ConfigManager::Domain *dom = ConfMan.getDomain(*iter);
-					assert(dom);
-
-					if ((*dom)["engineid"] == result.engineId &&
-						(*dom)["gameid"] == result.gameId &&
-					    (*dom)["platform"] == resultPlatformCode &&
-					    (*dom)["language"] == resultLanguageCode) {
-						duplicate = true;
-						break;
-					}
-				}
-				if (duplicate) {
-					_oldGamesCount++;
-					continue;	// Skip duplicates
-				}
-			}
-			_games.push_back(result);
+		for (uint i = 0; i < batch.size(); ++i) {
+			ScanJob &job = batch[i];
+			if (!job.listed)
+				continue;
 
-			_list->append(result.description);
-		}
+			if (job.pirated)
+				ADPiratedReportDeferrer::showPiratedMessage();
 
+			// Run the remaining detectors on the dir
+			job.candidates.push_back(EngineMan.detectGamesPass(job.files, false));
+			addDetectedGames(job.dir, DetectionResults(job.candidates));
 
-		// Recurse into all subdirs
-		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-			if (file->isDirectory()) {
-				_scanStack.push(*file);
+			// Recurse into all subdirs
+			for (Common::FSList::const_iterator file = job.files.begin(); file != job.files.end(); ++file) {
+				if (file->isDirectory()) {
+					_scanStack.push(*file);
 
-				_dirTotal++;
+					_dirTotal++;
+				}
 			}
-		}
 
-		_dirsScanned++;
+			_dirsScanned++;
+		}
 
 #if defined(USE_TASKBAR)
 		g_system->getTaskbarManager()->setProgressValue(_dirsScanned, _dirTotal);
@@ -246,6 +309,10 @@ void MassAddDialog::handleTickle() {
 #endif
 	}
 
+	// Keep the file properties computed during the scan for the next one
+	if (_scanStack.empty())
+		DetectionCache::instance().flush();
+
 
 	// Update the dialog
 	Common::U32String buf;
@@ -51,6 +51,8 @@ public:
 	}
 
 private:
+	void addDetectedGames(const Common::FSNode &dir, const DetectionResults &detectionResults);
+
 	Common::Stack<Common::FSNode>  _scanStack;
 	DetectedGames _games;
 
@@ -33,6 +33,7 @@
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
+#include "gui/saveload.h"
 #include "gui/ThemeEval.h"
 #include "gui/widgets/edittext.h"
 
@@ -328,6 +329,32 @@ void SaveLoadChooserDialog::listSaves() {
 #endif
 }
 
+bool SaveLoadChooserDialog::findMetaInfos(const SaveStateDescriptor &listed, SaveStateDescriptor &desc) {
+	// Locked slots are being synced, and cannot be read yet
+	if (listed.getLocked()) {
+		desc = listed;
+		return true;
+	}
+
+	return SaveMetaInfoCache::instance().find(_target, listed, getSaveFileStamp(listed), desc);
+}
+
+SaveStateDescriptor SaveLoadChooserDialog::queryMetaInfos(const SaveStateDescriptor &listed) {
+	SaveStateDescriptor desc;
+	if (!findMetaInfos(listed, desc)) {
+		// Taken before reading, so a save written in between is read again
+		const uint32 stamp = getSaveFileStamp(listed);
+		desc = _metaEngine->querySaveMetaInfos(_target.c_str(), listed.getSaveSlot());
+		SaveMetaInfoCache::instance().insert(_target, listed, stamp, desc);
+	}
+	return desc;
+}
+
+uint32 SaveLoadChooserDialog::getSaveFileStamp(const SaveStateDescriptor &listed) const {
+	const Common::String fileName = _metaEngine->getSavegameFile(listed.getSaveSlot(), _target.c_str());
+	return g_system->getSavefileManager()->getSaveFileStamp(fileName);
+}
+
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 void SaveLoadChooserDialog::addChooserButtons() {
 	if (_listButton) {
@@ -465,6 +492,7 @@ void SaveLoadChooserSimple::handleCommand(CommandSender *sender, uint32 cmd, uin
 								_("Delete"), _("Cancel"));
 			if (alert.runModal() == kMessageOK) {
 				_metaEngine->removeSaveState(_target.c_str(), _saveList[selItem].getSaveSlot());
+				SaveMetaInfoCache::instance().invalidate(_target, _saveList[selItem].getSaveSlot());
 
 				setResult(-1);
 				int scrollPos = _list->getCurrentScrollPos();
@@ -571,7 +599,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = (_saveList[selItem].getLocked() ? _saveList[selItem] : _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot()));
+		SaveStateDescriptor desc = queryMetaInfos(_saveList[selItem]);
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag() ||
@@ -754,6 +782,11 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+enum {
+	// Milliseconds spent reading meta infos on each tickle
+	kMetaInfoTimeSlice = 20
+};
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::U32String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
 	_curPage(0), _newSaveContainer(nullptr), _nextFreeSaveSlot(0), _buttons() {
@@ -1009,6 +1042,22 @@ void SaveLoadChooserGrid::reflowLayout() {
 		updateSaves();
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	// Read the meta infos of the shown saves a few at a time, so that the
+	// dialog stays responsive while they come in.
+	const uint32 start = g_system->getMillis();
+	while (!_pendingSaves.empty() && g_system->getMillis() - start < kMetaInfoTimeSlice) {
+		const uint i = _pendingSaves.front();
+		_pendingSaves.remove_at(0);
+
+		SlotButton &button = _buttons[i - _curPage * _entriesPerPage];
+		updateSlotButton(button, _saveList[i].getSaveSlot(), queryMetaInfos(_saveList[i]));
+		button.container->markAsDirty();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 void SaveLoadChooserGrid::close() {
 	// Save the current page.
 	const int result = getResult();
@@ -1083,6 +1132,7 @@ void SaveLoadChooserGrid::destroyButtons() {
 }
 
 void SaveLoadChooserGrid::hideButtons() {
+	_pendingSaves.clear();
 	for (ButtonArray::iterator i = _buttons.begin(), end = _buttons.end(); i != end; ++i) {
 		i->button->setGfx(nullptr);
 		i->setVisible(false);
@@ -1091,57 +1141,19 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
+	_pendingSaves.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+		SaveStateDescriptor desc;
+		if (!findMetaInfos(_saveList[i], desc)) {
+			// Shown as listed, without a thumbnail, until handleTickle reads it
+			desc = _saveList[i];
+			_pendingSaves.push_back(i);
+		}
 
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + desc.getDescription());
-
-		Common::U32String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::U32String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::U32String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
-
-		if (_playTimeSupport) {
-			const Common::U32String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		// We also disable and description the button if slot is locked
-		if ((_saveMode && desc.getWriteProtectedFlag()) || desc.getLocked()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
-		}
-		curButton.description->setEnabled(!desc.getLocked());
+		updateSlotButton(curButton, _saveList[i].getSaveSlot(), desc);
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1158,6 +1170,53 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &curButton, int saveSlot, const SaveStateDescriptor &desc) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + desc.getDescription());
+
+	Common::U32String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::U32String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::U32String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::U32String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	// We also disable and description the button if slot is locked
+	if ((_saveMode && desc.getWriteProtectedFlag()) || desc.getLocked()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
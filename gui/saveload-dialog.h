@@ -110,6 +110,20 @@ protected:
 	*/
 	virtual void listSaves();
 
+	/**
+	 * Looks up the meta infos of a listed save without reading it, which
+	 * works for locked slots and for the saves read before.
+	 *
+	 * @return Whether the meta infos were known.
+	 */
+	bool findMetaInfos(const SaveStateDescriptor &listed, SaveStateDescriptor &desc);
+
+	/** Gets the meta infos of a listed save, reading it when they are not known. */
+	SaveStateDescriptor queryMetaInfos(const SaveStateDescriptor &listed);
+
+	/** Gets the stamp of the save file of a listed save, which changes with every write. */
+	uint32 getSaveFileStamp(const SaveStateDescriptor &listed) const;
+
 	const bool					_saveMode;
 	const MetaEngine		    *_metaEngine;
 	bool						_delSupport;
@@ -205,6 +219,8 @@ public:
 
 	void reflowLayout() override;
 
+	void handleTickle() override;
+
 	SaveLoadChooserType getType() const override { return kSaveLoadDialogGrid; }
 
 	void close() override;
@@ -249,6 +265,10 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, int saveSlot, const SaveStateDescriptor &desc);
+
+	/** The shown saves, as indices into _saveList, whose meta infos still have to be read */
+	Common::Array<uint> _pendingSaves;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -28,6 +28,10 @@
 
 #include "engines/metaengine.h"
 
+namespace Common {
+DECLARE_SINGLETON(GUI::SaveMetaInfoCache);
+}
+
 namespace GUI {
 
 SaveLoadChooser::SaveLoadChooser(const U32String &title, const U32String &buttonLabel, bool saveMode)
@@ -120,6 +124,10 @@ int SaveLoadChooser::runModalWithPluginAndTarget(const Plugin *plugin, const Str
 	// Revert to the old active domain
 	ConfMan.setActiveDomain(oldDomain);
 
+	// The selected slot is about to be saved to
+	if (_saveMode && ret >= 0)
+		SaveMetaInfoCache::instance().invalidate(target, ret);
+
 	return ret;
 }
 
@@ -128,4 +136,43 @@ const Common::U32String &SaveLoadChooser::getResultString() const {
 	return _impl->getResultString();
 }
 
+bool SaveMetaInfoCache::find(const Common::String &target, const SaveStateDescriptor &listed, uint32 stamp, SaveStateDescriptor &desc) {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (i->slot == listed.getSaveSlot() && i->target == target) {
+			// The stamp changes with every write through the save file
+			// manager, and a save written behind its back usually shows
+			// with a new description
+			if (i->stamp != stamp || i->description != listed.getDescription())
+				return false;
+
+			desc = _entries.touch(i)->desc;
+			return true;
+		}
+	}
+	return false;
+}
+
+void SaveMetaInfoCache::insert(const Common::String &target, const SaveStateDescriptor &listed, uint32 stamp, const SaveStateDescriptor &desc) {
+	invalidate(target, listed.getSaveSlot());
+	while (_entries.size() >= kMaxEntries)
+		_entries.removeLeastRecent();
+
+	Entry entry;
+	entry.target = target;
+	entry.slot = listed.getSaveSlot();
+	entry.description = listed.getDescription();
+	entry.stamp = stamp;
+	entry.desc = desc;
+	_entries.add(entry);
+}
+
+void SaveMetaInfoCache::invalidate(const Common::String &target, int slot) {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end();) {
+		if ((slot == -1 || i->slot == slot) && i->target == target)
+			i = _entries.erase(i);
+		else
+			++i;
+	}
+}
+
 } // End of namespace GUI
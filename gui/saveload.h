@@ -23,6 +23,8 @@
 #ifndef GUI_SAVELOAD_H
 #define GUI_SAVELOAD_H
 
+#include "common/lrulist.h"
+#include "common/singleton.h"
 #include "common/str.h"
 #include "engines/metaengine.h"
 
@@ -72,6 +74,56 @@ public:
 	Common::String createDefaultSaveDescription(const int slot) const;
 };
 
+/**
+ * The meta infos of the recently shown saves, including their decoded
+ * thumbnails. The save/load choosers use them instead of reading the saves
+ * again when flipping pages or when opened again.
+ */
+class SaveMetaInfoCache : public Common::Singleton<SaveMetaInfoCache> {
+public:
+	enum {
+		kMaxEntries = 128
+	};
+
+	/**
+	 * Looks up the meta infos of a save as listed by the meta engine.
+	 *
+	 * @param stamp The stamp of the save file, as returned by
+	 *              Common::SaveFileManager::getSaveFileStamp().
+	 * @return Whether the meta infos were known.
+	 */
+	bool find(const Common::String &target, const SaveStateDescriptor &listed, uint32 stamp, SaveStateDescriptor &desc);
+
+	/**
+	 * Remembers the meta infos of a save, read while its save file had the
+	 * given stamp.
+	 */
+	void insert(const Common::String &target, const SaveStateDescriptor &listed, uint32 stamp, const SaveStateDescriptor &desc);
+
+	/**
+	 * Forgets the meta infos of a slot, once the save in it is written or
+	 * removed.
+	 *
+	 * @param slot The slot, or -1 for all the slots of the target.
+	 */
+	void invalidate(const Common::String &target, int slot = -1);
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	SaveMetaInfoCache() {}
+
+	struct Entry {
+		Common::String target;
+		int slot;
+		Common::U32String description;
+		uint32 stamp;
+		SaveStateDescriptor desc;
+	};
+	typedef Common::LRUList<Entry> EntryList;
+
+	EntryList _entries;
+};
+
 } // End of namespace GUI
 
 #endif
@@ -170,6 +170,7 @@ void ListWidget::setList(const U32StringArray &list, const ColorList *colors) {
 
 	// Copy everything
 	_dataList = list;
+	_dataListLowercase.clear();
 	_list = list;
 	_filter.clear();
 	_listIndex.clear();
@@ -740,6 +741,12 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// Every word of the previous filter is part of a word of a filter which
+	// extends it, so only its matches need to be checked again. That is unless
+	// entries were appended since.
+	const bool narrowing = !_filter.empty() && filt.size() > _filter.size() &&
+	                       U32String(filt.c_str(), _filter.size()) == _filter &&
+	                       _dataListLowercase.size() == _dataList.size();
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -750,16 +757,29 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 		// Restrict the list to everything which contains all words in _filter
 		// as substrings, ignoring case.
 
+		if (_dataListLowercase.size() != _dataList.size()) {
+			_dataListLowercase.resize(_dataList.size());
+			for (uint i = 0; i < _dataList.size(); ++i) {
+				_dataListLowercase[i] = _dataList[i];
+				_dataListLowercase[i].toLowercase();
+			}
+		}
+
 		Common::U32StringTokenizer tok(_filter);
-		U32String tmp;
-		int n = 0;
+		Common::Array<int> candidates;
+		if (narrowing) {
+			candidates = _listIndex;
+		} else {
+			candidates.resize(_dataList.size());
+			for (uint i = 0; i < candidates.size(); ++i)
+				candidates[i] = i;
+		}
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (U32StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (Common::Array<int>::const_iterator i = candidates.begin(); i != candidates.end(); ++i) {
+			const U32String &tmp = _dataListLowercase[*i];
 			bool matches = true;
 			tok.reset();
 			while (!tok.empty()) {
@@ -770,8 +790,8 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 			}
 
 			if (matches) {
-				_list.push_back(*i);
-				_listIndex.push_back(n);
+				_list.push_back(_dataList[*i]);
+				_listIndex.push_back(*i);
 			}
 		}
 	}
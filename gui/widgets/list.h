@@ -59,6 +59,7 @@ public:
 protected:
 	U32StringArray	_list;
 	U32StringArray		_dataList;
+	U32StringArray		_dataListLowercase; ///< _dataList to match the filter against, filled in when first filtering
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
 	bool			_editable;
@@ -31,6 +31,14 @@
 
 #include "graphics/surface.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CINEPAK_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CINEPAK_USE_NEON
+#include <arm_neon.h>
+#endif
+
 // Code here partially based off of ffmpeg ;)
 
 namespace Image {
@@ -57,210 +65,206 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 	       ((b & 0xF0) >> 4);
 }
 
+inline byte getRGBLookupEntry(const byte *colorMap, uint16 index) {
+	return colorMap[s_defaultPaletteLookup[CLIP<int>(index, 0, 1023)]];
+}
+
 /**
- * Put a raw pixel to the destination surface
+ * VFW-style dithering of a codebook entry, for the v4 codebooks
  */
-template<typename PixelInt>
-inline void putPixelRaw(PixelInt *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = convertYUVToColor(clipTable, format, y, u, v);
+inline void ditherCodebookDetail(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
+	int uLookup = (byte)codebook.u * 2;
+	int vLookup = (byte)codebook.v * 2;
+	uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
+	uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
+
+	int yLookup1 = codebook.y[0] * 2;
+	int yLookup2 = codebook.y[1] * 2;
+	int yLookup3 = codebook.y[2] * 2;
+	int yLookup4 = codebook.y[3] * 2;
+
+	uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
+	uint32 pixelGroup2 = uv2 | s_yLookup[yLookup2 + 1];
+	uint32 pixelGroup3 = uv1 | s_yLookup[yLookup3];
+	uint32 pixelGroup4 = uv1 | s_yLookup[yLookup4];
+	uint32 pixelGroup5 = uv1 | s_yLookup[yLookup1];
+	uint32 pixelGroup6 = uv1 | s_yLookup[yLookup2];
+	uint32 pixelGroup7 = uv2 | s_yLookup[yLookup3 + 1];
+	uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
+
+	dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
+	dst[1] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
+	dst[2] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
+	dst[3] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
+	dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
+	dst[5] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
+	dst[6] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
+	dst[7] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
+	dst[8] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
+	dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
+	dst[10] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
+	dst[11] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
+	dst[12] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
+	dst[13] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
+	dst[14] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
+	dst[15] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
 }
 
 /**
- * Specialized putPixelRaw for palettized 8bpp output
+ * VFW-style dithering of a codebook entry, for the v1 codebooks
  */
-template<>
-inline void putPixelRaw(byte *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = y;
+inline void ditherCodebookSmooth(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
+	int uLookup = (byte)codebook.u * 2;
+	int vLookup = (byte)codebook.v * 2;
+	uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
+	uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
+
+	int yLookup1 = codebook.y[0] * 2;
+	int yLookup2 = codebook.y[1] * 2;
+	int yLookup3 = codebook.y[2] * 2;
+	int yLookup4 = codebook.y[3] * 2;
+
+	uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
+	uint32 pixelGroup2 = uv1 | s_yLookup[yLookup2];
+	uint32 pixelGroup3 = uv1 | s_yLookup[yLookup1];
+	uint32 pixelGroup4 = uv2 | s_yLookup[yLookup2 + 1];
+	uint32 pixelGroup5 = uv2 | s_yLookup[yLookup3 + 1];
+	uint32 pixelGroup6 = uv1 | s_yLookup[yLookup3];
+	uint32 pixelGroup7 = uv1 | s_yLookup[yLookup4];
+	uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
+
+	dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
+	dst[1] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
+	dst[2] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
+	dst[3] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
+	dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
+	dst[5] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
+	dst[6] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
+	dst[7] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
+	dst[8] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
+	dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
+	dst[10] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
+	dst[11] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
+	dst[12] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
+	dst[13] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
+	dst[14] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
+	dst[15] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
 }
 
 /**
- * The default codebook converter: raw output.
+ * Write a row of four pixels of a block
+ */
+template<typename PixelInt>
+inline void writeRow(PixelInt *dst, uint32 color1, uint32 color2, uint32 color3, uint32 color4) {
+	dst[0] = color1;
+	dst[1] = color2;
+	dst[2] = color3;
+	dst[3] = color4;
+}
+
+/**
+ * The default codebook converter: raw output, from the codebooks
+ * converted to the output format when they were loaded.
  */
 struct CodebookConverterRaw {
 	template<typename PixelInt>
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4]) {
+		const uint32 *colors = strip.v1_colors + (codebookIndex << 2);
+		writeRow(rows[0], colors[0], colors[0], colors[1], colors[1]);
+		writeRow(rows[1], colors[0], colors[0], colors[1], colors[1]);
+		writeRow(rows[2], colors[2], colors[2], colors[3], colors[3]);
+		writeRow(rows[3], colors[2], colors[2], colors[3], colors[3]);
 	}
 
 	template<typename PixelInt>
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
-
-		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
-
-		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
-
-		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4]) {
+		const uint32 *colors1 = strip.v4_colors + (codebookIndex[0] << 2);
+		const uint32 *colors2 = strip.v4_colors + (codebookIndex[1] << 2);
+		const uint32 *colors3 = strip.v4_colors + (codebookIndex[2] << 2);
+		const uint32 *colors4 = strip.v4_colors + (codebookIndex[3] << 2);
+		writeRow(rows[0], colors1[0], colors1[1], colors2[0], colors2[1]);
+		writeRow(rows[1], colors1[2], colors1[3], colors2[2], colors2[3]);
+		writeRow(rows[2], colors3[0], colors3[1], colors4[0], colors4[1]);
+		writeRow(rows[3], colors3[2], colors3[3], colors4[2], colors4[3]);
 	}
 };
 
+#if defined(CINEPAK_USE_SSE2) || defined(CINEPAK_USE_NEON)
 /**
- * Codebook converter that dithers in VFW-style
+ * 32bpp output writes whole rows of a block at once
+ */
+template<>
+inline void CodebookConverterRaw::decodeBlock1(byte codebookIndex, const CinepakStrip &strip, uint32 *(&rows)[4]) {
+	const uint32 *colors = strip.v1_colors + (codebookIndex << 2);
+#if defined(CINEPAK_USE_SSE2)
+	const __m128i c = _mm_loadu_si128((const __m128i *)colors);
+	const __m128i top = _mm_unpacklo_epi32(c, c), bottom = _mm_unpackhi_epi32(c, c);
+	_mm_storeu_si128((__m128i *)rows[0], top);
+	_mm_storeu_si128((__m128i *)rows[1], top);
+	_mm_storeu_si128((__m128i *)rows[2], bottom);
+	_mm_storeu_si128((__m128i *)rows[3], bottom);
+#else
+	const uint32x4x2_t c = vzipq_u32(vld1q_u32(colors), vld1q_u32(colors));
+	vst1q_u32(rows[0], c.val[0]);
+	vst1q_u32(rows[1], c.val[0]);
+	vst1q_u32(rows[2], c.val[1]);
+	vst1q_u32(rows[3], c.val[1]);
+#endif
+}
+
+template<>
+inline void CodebookConverterRaw::decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, uint32 *(&rows)[4]) {
+	const uint32 *colors1 = strip.v4_colors + (codebookIndex[0] << 2);
+	const uint32 *colors2 = strip.v4_colors + (codebookIndex[1] << 2);
+	const uint32 *colors3 = strip.v4_colors + (codebookIndex[2] << 2);
+	const uint32 *colors4 = strip.v4_colors + (codebookIndex[3] << 2);
+#if defined(CINEPAK_USE_SSE2)
+	const __m128i c1 = _mm_loadu_si128((const __m128i *)colors1), c2 = _mm_loadu_si128((const __m128i *)colors2);
+	const __m128i c3 = _mm_loadu_si128((const __m128i *)colors3), c4 = _mm_loadu_si128((const __m128i *)colors4);
+	_mm_storeu_si128((__m128i *)rows[0], _mm_unpacklo_epi64(c1, c2));
+	_mm_storeu_si128((__m128i *)rows[1], _mm_unpackhi_epi64(c1, c2));
+	_mm_storeu_si128((__m128i *)rows[2], _mm_unpacklo_epi64(c3, c4));
+	_mm_storeu_si128((__m128i *)rows[3], _mm_unpackhi_epi64(c3, c4));
+#else
+	const uint32x4_t c1 = vld1q_u32(colors1), c2 = vld1q_u32(colors2);
+	const uint32x4_t c3 = vld1q_u32(colors3), c4 = vld1q_u32(colors4);
+	vst1q_u32(rows[0], vcombine_u32(vget_low_u32(c1), vget_low_u32(c2)));
+	vst1q_u32(rows[1], vcombine_u32(vget_high_u32(c1), vget_high_u32(c2)));
+	vst1q_u32(rows[2], vcombine_u32(vget_low_u32(c3), vget_low_u32(c4)));
+	vst1q_u32(rows[3], vcombine_u32(vget_high_u32(c3), vget_high_u32(c4)));
+#endif
+}
+#endif
+
+/**
+ * Codebook converter that dithers in VFW-style, from the codebooks
+ * dithered when they were loaded
  */
 struct CodebookConverterDitherVFW {
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		byte blockBuffer[16];
-		ditherCodebookSmooth(codebook, blockBuffer, colorMap);
-		rows[0][0] = blockBuffer[0];
-		rows[0][1] = blockBuffer[1];
-		rows[0][2] = blockBuffer[2];
-		rows[0][3] = blockBuffer[3];
-		rows[1][0] = blockBuffer[4];
-		rows[1][1] = blockBuffer[5];
-		rows[1][2] = blockBuffer[6];
-		rows[1][3] = blockBuffer[7];
-		rows[2][0] = blockBuffer[8];
-		rows[2][1] = blockBuffer[9];
-		rows[2][2] = blockBuffer[10];
-		rows[2][3] = blockBuffer[11];
-		rows[3][0] = blockBuffer[12];
-		rows[3][1] = blockBuffer[13];
-		rows[3][2] = blockBuffer[14];
-		rows[3][3] = blockBuffer[15];
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4]) {
+		const byte *blockBuffer = strip.v1_vfw + (codebookIndex << 4);
+		WRITE_UINT32(rows[0], READ_UINT32(blockBuffer + 0));
+		WRITE_UINT32(rows[1], READ_UINT32(blockBuffer + 4));
+		WRITE_UINT32(rows[2], READ_UINT32(blockBuffer + 8));
+		WRITE_UINT32(rows[3], READ_UINT32(blockBuffer + 12));
 	}
 
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		byte blockBuffer[16];
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[0]], blockBuffer, colorMap);
-		rows[0][0] = blockBuffer[0];
-		rows[0][1] = blockBuffer[1];
-		rows[1][0] = blockBuffer[4];
-		rows[1][1] = blockBuffer[5];
-
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[1]], blockBuffer, colorMap);
-		rows[0][2] = blockBuffer[2];
-		rows[0][3] = blockBuffer[3];
-		rows[1][2] = blockBuffer[6];
-		rows[1][3] = blockBuffer[7];
-
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[2]], blockBuffer, colorMap);
-		rows[2][0] = blockBuffer[8];
-		rows[2][1] = blockBuffer[9];
-		rows[3][0] = blockBuffer[12];
-		rows[3][1] = blockBuffer[13];
-
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[3]], blockBuffer, colorMap);
-		rows[2][2] = blockBuffer[10];
-		rows[2][3] = blockBuffer[11];
-		rows[3][2] = blockBuffer[14];
-		rows[3][3] = blockBuffer[15];
-	}
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4]) {
+		const byte *blockBuffer = strip.v4_vfw + (codebookIndex[0] << 4);
+		WRITE_UINT16(rows[0] + 0, READ_UINT16(blockBuffer + 0));
+		WRITE_UINT16(rows[1] + 0, READ_UINT16(blockBuffer + 4));
 
-private:
-	static inline void ditherCodebookDetail(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
-		int uLookup = (byte)codebook.u * 2;
-		int vLookup = (byte)codebook.v * 2;
-		uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
-		uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
-
-		int yLookup1 = codebook.y[0] * 2;
-		int yLookup2 = codebook.y[1] * 2;
-		int yLookup3 = codebook.y[2] * 2;
-		int yLookup4 = codebook.y[3] * 2;
-
-		uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
-		uint32 pixelGroup2 = uv2 | s_yLookup[yLookup2 + 1];
-		uint32 pixelGroup3 = uv1 | s_yLookup[yLookup3];
-		uint32 pixelGroup4 = uv1 | s_yLookup[yLookup4];
-		uint32 pixelGroup5 = uv1 | s_yLookup[yLookup1];
-		uint32 pixelGroup6 = uv1 | s_yLookup[yLookup2];
-		uint32 pixelGroup7 = uv2 | s_yLookup[yLookup3 + 1];
-		uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
-
-		dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
-		dst[1] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
-		dst[2] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
-		dst[3] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
-		dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
-		dst[5] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
-		dst[6] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
-		dst[7] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
-		dst[8] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
-		dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
-		dst[10] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
-		dst[11] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
-		dst[12] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
-		dst[13] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
-		dst[14] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
-		dst[15] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
-	}
+		blockBuffer = strip.v4_vfw + (codebookIndex[1] << 4);
+		WRITE_UINT16(rows[0] + 2, READ_UINT16(blockBuffer + 2));
+		WRITE_UINT16(rows[1] + 2, READ_UINT16(blockBuffer + 6));
 
-	static inline void ditherCodebookSmooth(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
-		int uLookup = (byte)codebook.u * 2;
-		int vLookup = (byte)codebook.v * 2;
-		uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
-		uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
-
-		int yLookup1 = codebook.y[0] * 2;
-		int yLookup2 = codebook.y[1] * 2;
-		int yLookup3 = codebook.y[2] * 2;
-		int yLookup4 = codebook.y[3] * 2;
-
-		uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
-		uint32 pixelGroup2 = uv1 | s_yLookup[yLookup2];
-		uint32 pixelGroup3 = uv1 | s_yLookup[yLookup1];
-		uint32 pixelGroup4 = uv2 | s_yLookup[yLookup2 + 1];
-		uint32 pixelGroup5 = uv2 | s_yLookup[yLookup3 + 1];
-		uint32 pixelGroup6 = uv1 | s_yLookup[yLookup3];
-		uint32 pixelGroup7 = uv1 | s_yLookup[yLookup4];
-		uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
-
-		dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
-		dst[1] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
-		dst[2] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
-		dst[3] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
-		dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
-		dst[5] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
-		dst[6] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
-		dst[7] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
-		dst[8] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
-		dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
-		dst[10] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
-		dst[11] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
-		dst[12] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
-		dst[13] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
-		dst[14] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
-		dst[15] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
-	}
+		blockBuffer = strip.v4_vfw + (codebookIndex[2] << 4);
+		WRITE_UINT16(rows[2] + 0, READ_UINT16(blockBuffer + 8));
+		WRITE_UINT16(rows[3] + 0, READ_UINT16(blockBuffer + 12));
 
-	static inline byte getRGBLookupEntry(const byte *colorMap, uint16 index) {
-		return colorMap[s_defaultPaletteLookup[CLIP<int>(index, 0, 1023)]];
+		blockBuffer = strip.v4_vfw + (codebookIndex[3] << 4);
+		WRITE_UINT16(rows[2] + 2, READ_UINT16(blockBuffer + 10));
+		WRITE_UINT16(rows[3] + 2, READ_UINT16(blockBuffer + 14));
 	}
 };
 
@@ -268,7 +272,7 @@ private:
  * Codebook converter that dithers in QT-style
  */
 struct CodebookConverterDitherQT {
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4]) {
 		const byte *colorPtr = strip.v1_dither + (codebookIndex << 2);
 		WRITE_UINT32(rows[0], READ_UINT32(colorPtr));
 		WRITE_UINT32(rows[1], READ_UINT32(colorPtr + 1024));
@@ -276,7 +280,7 @@ struct CodebookConverterDitherQT {
 		WRITE_UINT32(rows[3], READ_UINT32(colorPtr + 3072));
 	}
 
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4]) {
 		const byte *colorPtr = strip.v4_dither + (codebookIndex[0] << 2);
 		WRITE_UINT16(rows[0] + 0, READ_UINT16(colorPtr + 0));
 		WRITE_UINT16(rows[1] + 0, READ_UINT16(colorPtr + 2));
@@ -296,7 +300,7 @@ struct CodebookConverterDitherQT {
 };
 
 template<typename PixelInt, typename CodebookConverter>
-void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *colorMap, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
+void decodeVectorsTmpl(CinepakFrame &frame, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	uint32 flag = 0, mask = 0;
 	PixelInt *iy[4];
 	int32 startPos = stream.pos();
@@ -331,14 +335,14 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *c
 
 					// Get the codebook
 					byte codebook = stream.readByte();
-					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], iy, clipTable, colorMap, frame.surface->format);
+					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], iy);
 				} else if (flag & mask) {
 					if ((stream.pos() - startPos + 4) > (int32)chunkSize)
 						return;
 
 					byte codebook[4];
 					stream.read(codebook, 4);
-					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], iy, clipTable, colorMap, frame.surface->format);
+					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], iy);
 				}
 			}
 
@@ -439,6 +443,12 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				_curFrame.strips[i].v4_codebook[j] = _curFrame.strips[i - 1].v4_codebook[j];
 			}
 
+			// Copy the converted codebooks
+			memcpy(_curFrame.strips[i].v1_colors, _curFrame.strips[i - 1].v1_colors, sizeof(_curFrame.strips[i].v1_colors));
+			memcpy(_curFrame.strips[i].v4_colors, _curFrame.strips[i - 1].v4_colors, sizeof(_curFrame.strips[i].v4_colors));
+			memcpy(_curFrame.strips[i].v1_vfw, _curFrame.strips[i - 1].v1_vfw, sizeof(_curFrame.strips[i].v1_vfw));
+			memcpy(_curFrame.strips[i].v4_vfw, _curFrame.strips[i - 1].v4_vfw, sizeof(_curFrame.strips[i].v4_vfw));
+
 			// Copy the QuickTime dither tables
 			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
 			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
@@ -512,8 +522,7 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 		codebook[i].u = 0;
 		codebook[i].v = 0;
 
-		if (_ditherType == kDitherTypeQT)
-			ditherCodebookQT(strip, codebookType, i);
+		convertCodebook(strip, codebookType, i);
 	}
 }
 
@@ -550,9 +559,32 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
-			if (_ditherType == kDitherTypeQT)
-				ditherCodebookQT(strip, codebookType, i);
+			// Convert the codebook to what the vectors are drawn with
+			convertCodebook(strip, codebookType, i);
+		}
+	}
+}
+
+void CinepakDecoder::convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	CinepakStrip &cinepakStrip = _curFrame.strips[strip];
+	const CinepakCodebook &codebook = (codebookType == 1) ? cinepakStrip.v1_codebook[codebookIndex] : cinepakStrip.v4_codebook[codebookIndex];
+
+	if (_ditherType == kDitherTypeQT) {
+		ditherCodebookQT(strip, codebookType, codebookIndex);
+	} else if (_ditherType == kDitherTypeVFW) {
+		if (codebookType == 1)
+			ditherCodebookSmooth(codebook, cinepakStrip.v1_vfw + (codebookIndex << 4), _colorMap);
+		else
+			ditherCodebookDetail(codebook, cinepakStrip.v4_vfw + (codebookIndex << 4), _colorMap);
+	} else {
+		uint32 *colors = ((codebookType == 1) ? cinepakStrip.v1_colors : cinepakStrip.v4_colors) + (codebookIndex << 2);
+
+		for (int i = 0; i < 4; i++) {
+			// Palettized 8bpp output uses the luma as is
+			if (_pixelFormat.bytesPerPixel == 1)
+				colors[i] = codebook.y[i];
+			else
+				colors[i] = convertYUVToColor(_clipTable, _pixelFormat, codebook.y[i], codebook.u, codebook.v);
 		}
 	}
 }
@@ -617,11 +649,11 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 
 void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_curFrame.surface->format.bytesPerPixel == 1) {
-		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 2) {
-		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 4) {
-		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, stream, strip, chunkID, chunkSize);
 	}
 }
 
@@ -690,9 +722,9 @@ byte CinepakDecoder::findNearestRGB(int index) const {
 
 void CinepakDecoder::ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_ditherType == kDitherTypeVFW)
-		decodeVectorsTmpl<byte, CodebookConverterDitherVFW>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterDitherVFW>(_curFrame, stream, strip, chunkID, chunkSize);
 	else
-		decodeVectorsTmpl<byte, CodebookConverterDitherQT>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterDitherQT>(_curFrame, stream, strip, chunkID, chunkSize);
 }
 
 } // End of namespace Image
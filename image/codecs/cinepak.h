@@ -46,6 +46,8 @@ struct CinepakStrip {
 	uint16 length;
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
+	uint32 v1_colors[256 * 4], v4_colors[256 * 4]; // The codebooks in the output format
+	byte v1_vfw[256 * 4 * 4], v4_vfw[256 * 4 * 4]; // The VFW dithered codebook blocks
 	byte v1_dither[256 * 4 * 4 * 4], v4_dither[256 * 4 * 4 * 4];
 };
 
@@ -98,6 +100,7 @@ private:
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 
+	void convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex);
 	byte findNearestRGB(int index) const;
 	void ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 	void ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex);
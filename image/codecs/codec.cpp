@@ -45,6 +45,7 @@
 #include "image/codecs/truemotion1.h"
 
 #include "common/endian.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 namespace Image {
@@ -73,6 +74,26 @@ inline uint16 makeQuickTimeDitherColor(byte r, byte g, byte b) {
 
 } // End of anonymous namespace
 
+uint32 *Codec::createRGB555ConversionTable(const Graphics::PixelFormat &format) {
+	const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+	uint32 *table = new uint32[0x8000];
+
+	for (uint i = 0; i < 0x8000; i++) {
+		byte r, g, b;
+		rgb555.colorToRGB(i, r, g, b);
+		table[i] = format.RGBToColor(r, g, b);
+	}
+
+	return table;
+}
+
+Graphics::PixelFormat Codec::getDefaultHighColorFormat(const Graphics::PixelFormat &fallback) {
+	Graphics::PixelFormat format = g_system->getScreenFormat();
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return fallback;
+	return format;
+}
+
 byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	byte *buf = new byte[0x10000];
 	memset(buf, 0, 0x10000);
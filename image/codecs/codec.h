@@ -115,6 +115,18 @@ public:
 	 * Create a dither table, as used by QuickTime codecs.
 	 */
 	static byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
+
+	/**
+	 * Create a table of the 32768 RGB555 colors in the given format, as used
+	 * by the RGB555 codecs decoding straight to the screen format.
+	 */
+	static uint32 *createRGB555ConversionTable(const Graphics::PixelFormat &format);
+
+	/**
+	 * Get the format the high color codecs decode to: the screen format
+	 * when it is high color, and the given format otherwise.
+	 */
+	static Graphics::PixelFormat getDefaultHighColorFormat(const Graphics::PixelFormat &fallback);
 };
 
 /**
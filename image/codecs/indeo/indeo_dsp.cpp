@@ -28,6 +28,14 @@
 
 #include "image/codecs/indeo/indeo_dsp.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INDEO_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define INDEO_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Image {
 namespace Indeo {
 
@@ -71,8 +79,137 @@ namespace Indeo {
 	d3 = COMPENSATE(t2);\
 	d4 = COMPENSATE(t3); }
 
+#if defined(INDEO_USE_SSE2) || defined(INDEO_USE_NEON)
+/**
+ * Four int32 lanes, with the operators the transform macros use, so that
+ * the vector versions of the 2D transforms run four columns or four rows
+ * at once through the very same macros as the scalar ones.
+ */
+struct IviVec {
+#if defined(INDEO_USE_SSE2)
+	__m128i v;
+	IviVec() {}
+	IviVec(__m128i x) : v(x) {}
+	static IviVec load(const int32 *src) { return _mm_loadu_si128((const __m128i *)src); }
+	static IviVec constant(int c) { return _mm_set1_epi32(c); }
+	friend IviVec operator+(IviVec a, IviVec b) { return _mm_add_epi32(a.v, b.v); }
+	friend IviVec operator-(IviVec a, IviVec b) { return _mm_sub_epi32(a.v, b.v); }
+	friend IviVec operator&(IviVec a, IviVec b) { return _mm_and_si128(a.v, b.v); }
+	friend IviVec operator<<(IviVec a, int n) { return _mm_slli_epi32(a.v, n); }
+	friend IviVec operator>>(IviVec a, int n) { return _mm_srai_epi32(a.v, n); }
+#else
+	int32x4_t v;
+	IviVec() {}
+	IviVec(int32x4_t x) : v(x) {}
+	static IviVec load(const int32 *src) { return vld1q_s32(src); }
+	static IviVec constant(int c) { return vdupq_n_s32(c); }
+	friend IviVec operator+(IviVec a, IviVec b) { return vaddq_s32(a.v, b.v); }
+	friend IviVec operator-(IviVec a, IviVec b) { return vsubq_s32(a.v, b.v); }
+	friend IviVec operator&(IviVec a, IviVec b) { return vandq_s32(a.v, b.v); }
+	friend IviVec operator<<(IviVec a, int n) { return vshlq_s32(a.v, vdupq_n_s32(n)); }
+	friend IviVec operator>>(IviVec a, int n) { return vshlq_s32(a.v, vdupq_n_s32(-n)); }
+#endif
+	friend IviVec operator+(IviVec a, int c) { return a + constant(c); }
+	friend IviVec operator-(IviVec a) { return constant(0) - a; }
+	// The macros only ever scale by powers of two
+	friend IviVec operator*(IviVec a, int c) { return a << (c == 2 ? 1 : c == 4 ? 2 : 3); }
+};
+
+/**
+ * Transpose the 4x4 block held by the rows r0..r3
+ */
+static inline void transpose4(IviVec &r0, IviVec &r1, IviVec &r2, IviVec &r3) {
+#if defined(INDEO_USE_SSE2)
+	const __m128i t0 = _mm_unpacklo_epi32(r0.v, r1.v), t1 = _mm_unpacklo_epi32(r2.v, r3.v);
+	const __m128i t2 = _mm_unpackhi_epi32(r0.v, r1.v), t3 = _mm_unpackhi_epi32(r2.v, r3.v);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+#else
+	const int32x4x2_t t01 = vtrnq_s32(r0.v, r1.v), t23 = vtrnq_s32(r2.v, r3.v);
+	r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+#endif
+}
+
+/**
+ * All ones in the lanes of the non-empty columns
+ */
+static inline IviVec columnMask(const uint8 *flags) {
+	const int32 mask[4] = { flags[0] ? -1 : 0, flags[1] ? -1 : 0, flags[2] ? -1 : 0, flags[3] ? -1 : 0 };
+	return IviVec::load(mask);
+}
+
+/**
+ * Store a row of eight pixels, truncated to 16 bits as the scalar code does
+ */
+static inline void storeRow(int16 *out, IviVec lo, IviVec hi) {
+#if defined(INDEO_USE_SSE2)
+	const __m128i l = _mm_srai_epi32(_mm_slli_epi32(lo.v, 16), 16);
+	const __m128i h = _mm_srai_epi32(_mm_slli_epi32(hi.v, 16), 16);
+	_mm_storeu_si128((__m128i *)out, _mm_packs_epi32(l, h));
+#else
+	vst1q_s16(out, vcombine_s16(vmovn_s32(lo.v), vmovn_s32(hi.v)));
+#endif
+}
+
+/**
+ * Transpose the 8x8 result of the column pass, four rows at a time, so that
+ * the row pass runs on columns as well
+ */
+static inline void transposeRows(const IviVec (&tmp)[16], int rows, IviVec (&cols)[8]) {
+	for (int h = 0; h < 2; h++) {
+		for (int j = 0; j < 4; j++)
+			cols[h * 4 + j] = tmp[(rows * 4 + j) * 2 + h];
+		transpose4(cols[h * 4 + 0], cols[h * 4 + 1], cols[h * 4 + 2], cols[h * 4 + 3]);
+	}
+}
+
+/**
+ * Transpose the results of the row pass back, and store the four rows
+ */
+static inline void storeRows(IviVec (&res)[8], int16 *out, uint32 pitch) {
+	transpose4(res[0], res[1], res[2], res[3]);
+	transpose4(res[4], res[5], res[6], res[7]);
+	for (int j = 0; j < 4; j++, out += pitch)
+		storeRow(out, res[j], res[j + 4]);
+}
+#endif
+
 void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 							 const uint8 *flags) {
+#if defined(INDEO_USE_SSE2) || defined(INDEO_USE_NEON)
+	IviVec tmp[16], s[8], d[8];
+	IviVec t0, t1, t2, t3, t4, t5, t6, t7, t8;
+
+	// apply the InvHaar8 to four columns at a time
+#define COMPENSATE(x) (x)
+	for (int h = 0; h < 2; h++) {
+		// pre-scaling
+		const int shift = !h;
+		for (int k = 0; k < 8; k++)
+			s[k] = IviVec::load(in + k * 8 + h * 4) << (k < 4 ? shift : 0);
+		INV_HAAR8(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+				  d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+				  t0, t1, t2, t3, t4, t5, t6, t7, t8);
+		const IviVec mask = columnMask(flags + h * 4);
+		for (int k = 0; k < 8; k++)
+			tmp[k * 2 + h] = d[k] & mask;
+	}
+
+	// and then to four rows at a time
+	for (int rows = 0; rows < 2; rows++) {
+		transposeRows(tmp, rows, s);
+		INV_HAAR8(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+				  d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+				  t0, t1, t2, t3, t4, t5, t6, t7, t8);
+		storeRows(d, out + rows * 4 * pitch, pitch);
+	}
+#undef  COMPENSATE
+#else
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -121,6 +258,7 @@ void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviRowHaar8(const int32 *in, int16 *out, uint32 pitch,
@@ -322,6 +460,33 @@ void IndeoDSP::ffIviDcHaar2d(const int32 *in, int16 *out, uint32 pitch,
 	d4 = COMPENSATE(t4);}
 
 void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+#if defined(INDEO_USE_SSE2) || defined(INDEO_USE_NEON)
+	IviVec tmp[16], s[8], d[8];
+	IviVec t0, t1, t2, t3, t4, t5, t6, t7, t8;
+
+#define COMPENSATE(x) (x)
+	for (int h = 0; h < 2; h++) {
+		for (int k = 0; k < 8; k++)
+			s[k] = IviVec::load(in + k * 8 + h * 4);
+		IVI_INV_SLANT8(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+					   d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+					   t0, t1, t2, t3, t4, t5, t6, t7, t8);
+		const IviVec mask = columnMask(flags + h * 4);
+		for (int k = 0; k < 8; k++)
+			tmp[k * 2 + h] = d[k] & mask;
+	}
+#undef COMPENSATE
+
+#define COMPENSATE(x) (((x) + 1)>>1)
+	for (int rows = 0; rows < 2; rows++) {
+		transposeRows(tmp, rows, s);
+		IVI_INV_SLANT8(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+					   d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+					   t0, t1, t2, t3, t4, t5, t6, t7, t8);
+		storeRows(d, out + rows * 4 * pitch, pitch);
+	}
+#undef COMPENSATE
+#else
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -356,6 +521,7 @@ void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, c
 		out += pitch;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviInverseSlant4x4(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
@@ -530,6 +696,78 @@ void IndeoDSP::ffIviPutDcPixel8x8(const int32 *in, int16 *out, uint32 pitch,
 		memset(out, 0, 8 * sizeof(out[0]));
 }
 
+#if defined(INDEO_USE_SSE2) || defined(INDEO_USE_NEON)
+#if defined(INDEO_USE_SSE2)
+typedef __m128i IviRow;
+
+static inline IviRow loadRow(const int16 *src) { return _mm_loadu_si128((const __m128i *)src); }
+
+// (a + b) >> 1, without overflowing the 16 bit lanes
+static inline IviRow avg2(IviRow a, IviRow b) {
+	return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1), _mm_srai_epi16(b, 1)),
+						 _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1)));
+}
+
+// (a + b + c + d) >> 2, summed in 32 bits
+static inline IviRow avg4(IviRow a, IviRow b, IviRow c, IviRow d) {
+	const __m128i lo = _mm_add_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16), _mm_srai_epi32(_mm_unpacklo_epi16(b, b), 16)),
+									 _mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(c, c), 16), _mm_srai_epi32(_mm_unpacklo_epi16(d, d), 16)));
+	const __m128i hi = _mm_add_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16), _mm_srai_epi32(_mm_unpackhi_epi16(b, b), 16)),
+									 _mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(c, c), 16), _mm_srai_epi32(_mm_unpackhi_epi16(d, d), 16)));
+	return _mm_packs_epi32(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+}
+
+template<bool delta>
+static inline void storeMc(int16 *buf, IviRow row) {
+	_mm_storeu_si128((__m128i *)buf, delta ? _mm_add_epi16(loadRow(buf), row) : row);
+}
+#else
+typedef int16x8_t IviRow;
+
+static inline IviRow loadRow(const int16 *src) { return vld1q_s16(src); }
+
+static inline IviRow avg2(IviRow a, IviRow b) { return vhaddq_s16(a, b); }
+
+static inline IviRow avg4(IviRow a, IviRow b, IviRow c, IviRow d) {
+	const int32x4_t lo = vaddq_s32(vaddl_s16(vget_low_s16(a), vget_low_s16(b)), vaddl_s16(vget_low_s16(c), vget_low_s16(d)));
+	const int32x4_t hi = vaddq_s32(vaddl_s16(vget_high_s16(a), vget_high_s16(b)), vaddl_s16(vget_high_s16(c), vget_high_s16(d)));
+	return vcombine_s16(vshrn_n_s32(lo, 2), vshrn_n_s32(hi, 2));
+}
+
+template<bool delta>
+static inline void storeMc(int16 *buf, IviRow row) {
+	vst1q_s16(buf, delta ? vaddq_s16(loadRow(buf), row) : row);
+}
+#endif
+
+/**
+ * 8x8 motion compensation, a whole row of the block at a time
+ */
+template<bool delta>
+static void iviMc8x8Vector(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	switch (mcType) {
+	case 0: // fullpel (no interpolation)
+		for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch)
+			storeMc<delta>(buf, loadRow(refBuf));
+		break;
+	case 1: // horizontal halfpel interpolation
+		for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch)
+			storeMc<delta>(buf, avg2(loadRow(refBuf), loadRow(refBuf + 1)));
+		break;
+	case 2: // vertical halfpel interpolation
+		for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch)
+			storeMc<delta>(buf, avg2(loadRow(refBuf), loadRow(refBuf + pitch)));
+		break;
+	case 3: // vertical and horizontal halfpel interpolation
+		for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch)
+			storeMc<delta>(buf, avg4(loadRow(refBuf), loadRow(refBuf + 1), loadRow(refBuf + pitch), loadRow(refBuf + pitch + 1)));
+		break;
+	default:
+		break;
+	}
+}
+#endif
+
 #define IVI_MC_TEMPLATE(size, suffix, OP) \
 static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 												 uint32 dpitch, \
@@ -566,8 +804,9 @@ static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 	default: \
 		break; \
 	} \
-} \
-\
+}
+
+#define IVI_MC_PUBLIC_TEMPLATE(size, suffix) \
 void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
 											 uint32 pitch, int mcType) \
 { \
@@ -595,10 +834,24 @@ void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
 #define OP_PUT(a, b)  (a) = (b)
 #define OP_ADD(a, b)  (a) += (b)
 
+#if defined(INDEO_USE_SSE2) || defined(INDEO_USE_NEON)
+static void iviMc8x8NoDelta(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	iviMc8x8Vector<false>(buf, dpitch, refBuf, pitch, mcType);
+}
+
+static void iviMc8x8Delta(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	iviMc8x8Vector<true>(buf, dpitch, refBuf, pitch, mcType);
+}
+#else
 IVI_MC_TEMPLATE(8, NoDelta, OP_PUT)
 IVI_MC_TEMPLATE(8, Delta,   OP_ADD)
+#endif
 IVI_MC_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_TEMPLATE(4, Delta,   OP_ADD)
+IVI_MC_PUBLIC_TEMPLATE(8, NoDelta)
+IVI_MC_PUBLIC_TEMPLATE(8, Delta)
+IVI_MC_PUBLIC_TEMPLATE(4, NoDelta)
+IVI_MC_PUBLIC_TEMPLATE(4, Delta)
 IVI_MC_AVG_TEMPLATE(8, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
@@ -63,7 +63,7 @@ const Graphics::Surface *MPEGDecoder::decodeFrame(Common::SeekableReadStream &st
 	return _surface;
 }
 
-bool MPEGDecoder::decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst) {
+bool MPEGDecoder::decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst, Graphics::YUVFrame *yuvDst) {
 	// Decode as much as we can out of this packet
 	uint32 size = 0xFFFFFFFF;
 	mpeg2_state_t state;
@@ -91,6 +91,19 @@ bool MPEGDecoder::decodePacket(Common::SeekableReadStream &packet, uint32 &frame
 
 				}
 
+				if (yuvDst) {
+					yuvDst->yPlane = _mpegInfo->display_fbuf->buf[0];
+					yuvDst->uPlane = _mpegInfo->display_fbuf->buf[1];
+					yuvDst->vPlane = _mpegInfo->display_fbuf->buf[2];
+					yuvDst->w = sequence->picture_width;
+					yuvDst->h = sequence->picture_height;
+					yuvDst->yPitch = sequence->width;
+					yuvDst->uvPitch = sequence->chroma_width;
+					yuvDst->chromaShift = 1;
+					yuvDst->scale = Graphics::YUVToRGBManager::kScaleITU;
+					break;
+				}
+
 				if (!dst) {
 					// If no destination is specified, use our internal storage
 					if (!_surface) {
@@ -37,6 +37,7 @@ class SeekableReadStream;
 
 namespace Graphics {
 struct Surface;
+struct YUVFrame;
 }
 
 namespace Image {
@@ -56,7 +57,9 @@ public:
 	Graphics::PixelFormat getPixelFormat() const { return _pixelFormat; }
 
 	// MPEGPSDecoder call
-	bool decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst = 0);
+	// When yuvDst is given, the planes of the decoded frame are handed out
+	// there instead of being converted. They stay valid until the next call.
+	bool decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst = 0, Graphics::YUVFrame *yuvDst = 0);
 
 private:
 	Graphics::PixelFormat _pixelFormat;
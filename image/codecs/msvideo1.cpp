@@ -28,6 +28,14 @@
 
 namespace Image {
 
+/**
+ * Convert an RGB555 color to the output format, through the table
+ * unless the output is RGB555 itself
+ */
+static inline uint32 convertColor(const uint32 *colorTable, uint16 color) {
+	return colorTable ? colorTable[color & 0x7FFF] : color;
+}
+
 #define CHECK_STREAM_PTR(n) \
   if ((stream.pos() + n) > stream.size() ) { \
 	warning ("MS Video-1: Stream out of bounds (%d >= %d) d%d", stream.pos() + n, stream.size(), n); \
@@ -35,16 +43,21 @@ namespace Image {
   }
 
 MSVideo1Decoder::MSVideo1Decoder(uint16 width, uint16 height, byte bitsPerPixel) : Codec() {
+	const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+
+	// Decode the high color videos straight to the screen format
 	_surface = new Graphics::Surface();
 	_surface->create(width, height, (bitsPerPixel == 8) ? Graphics::PixelFormat::createFormatCLUT8() :
-                                                          Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
+                                                          getDefaultHighColorFormat(rgb555));
 
 	_bitsPerPixel = bitsPerPixel;
+	_colorTable = (bitsPerPixel != 8 && _surface->format != rgb555) ? createRGB555ConversionTable(_surface->format) : nullptr;
 }
 
 MSVideo1Decoder::~MSVideo1Decoder() {
 	_surface->free();
 	delete _surface;
+	delete[] _colorTable;
 }
 
 void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
@@ -126,10 +139,12 @@ void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
     }
 }
 
+template<typename PixelInt>
 void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
     /* decoding parameters */
-    uint16 colors[8];
-    uint16 *pixels = (uint16 *)_surface->getPixels();
+    PixelInt colors[8];
+    PixelInt *pixels = (PixelInt *)_surface->getPixels();
+    const uint32 *colorTable = _colorTable;
     int32 stride = _surface->w;
 
     int32 skip_blocks = 0;
@@ -168,18 +183,15 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
                 uint16 flags = (byte_b << 8) | byte_a;
 
                 CHECK_STREAM_PTR(4);
-                colors[0] = stream.readUint16LE();
-                colors[1] = stream.readUint16LE();
+                uint16 color0 = stream.readUint16LE();
+                colors[0] = convertColor(colorTable, color0);
+                colors[1] = convertColor(colorTable, stream.readUint16LE());
 
-                if (colors[0] & 0x8000) {
+                if (color0 & 0x8000) {
                     /* 8-color encoding */
                     CHECK_STREAM_PTR(12);
-                    colors[2] = stream.readUint16LE();
-                    colors[3] = stream.readUint16LE();
-                    colors[4] = stream.readUint16LE();
-                    colors[5] = stream.readUint16LE();
-                    colors[6] = stream.readUint16LE();
-                    colors[7] = stream.readUint16LE();
+                    for (int i = 2; i < 8; i++)
+                        colors[i] = convertColor(colorTable, stream.readUint16LE());
 
                     for (int pixel_y = 0; pixel_y < 4; pixel_y++) {
                         for (int pixel_x = 0; pixel_x < 4; pixel_x++, flags >>= 1)
@@ -198,7 +210,7 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
                 }
             } else {
                 /* otherwise, it's a 1-color block */
-                colors[0] = (byte_b << 8) | byte_a;
+                colors[0] = convertColor(colorTable, (byte_b << 8) | byte_a);
 
                 for (int pixel_y = 0; pixel_y < 4; pixel_y++) {
                     for (int pixel_x = 0; pixel_x < 4; pixel_x++)
@@ -216,8 +228,10 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 const Graphics::Surface *MSVideo1Decoder::decodeFrame(Common::SeekableReadStream &stream) {
 	if (_bitsPerPixel == 8)
 		decode8(stream);
+	else if (_surface->format.bytesPerPixel == 2)
+		decode16<uint16>(stream);
 	else
-        decode16(stream);
+		decode16<uint32>(stream);
 
     return _surface;
 }
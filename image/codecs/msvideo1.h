@@ -45,7 +45,11 @@ private:
 
 	Graphics::Surface *_surface;
 
+	// The RGB555 colors in the output format, when it is not RGB555
+	uint32 *_colorTable;
+
 	void decode8(Common::SeekableReadStream &stream);
+	template<typename PixelInt>
 	void decode16(Common::SeekableReadStream &stream);
 };
 
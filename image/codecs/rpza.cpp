@@ -32,7 +32,10 @@
 namespace Image {
 
 RPZADecoder::RPZADecoder(uint16 width, uint16 height) : Codec() {
-	_format = Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0);
+	// Decode straight to the screen format, converting the colors through a table
+	const Graphics::PixelFormat rgb555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+	_format = getDefaultHighColorFormat(rgb555);
+	_colorTable = (_format != rgb555) ? createRGB555ConversionTable(_format) : nullptr;
 	_ditherPalette = 0;
 	_dirtyPalette = false;
 	_colorMap = 0;
@@ -51,6 +54,7 @@ RPZADecoder::~RPZADecoder() {
 
 	delete[] _ditherPalette;
 	delete[] _colorMap;
+	delete[] _colorTable;
 }
 
 #define ADVANCE_BLOCK() \
@@ -63,76 +67,86 @@ RPZADecoder::~RPZADecoder() {
 	if (totalBlocks < 0) \
 		error("rpza block counter just went negative (this should not happen)") \
 
+/**
+ * Output in the RGB555 format of the stream
+ */
 struct BlockDecoderRaw {
-	static inline void drawFillBlock(uint16 *blockPtr, uint16 pitch, uint16 color, const byte *colorMap) {
-		blockPtr[0] = color;
-		blockPtr[1] = color;
-		blockPtr[2] = color;
-		blockPtr[3] = color;
-		blockPtr += pitch;
-		blockPtr[0] = color;
-		blockPtr[1] = color;
-		blockPtr[2] = color;
-		blockPtr[3] = color;
-		blockPtr += pitch;
-		blockPtr[0] = color;
-		blockPtr[1] = color;
-		blockPtr[2] = color;
-		blockPtr[3] = color;
-		blockPtr += pitch;
-		blockPtr[0] = color;
-		blockPtr[1] = color;
-		blockPtr[2] = color;
-		blockPtr[3] = color;
+	template<typename PixelInt>
+	static inline void drawFillBlock(PixelInt *blockPtr, uint16 pitch, uint16 color, const byte *colorMap, const uint32 *colorTable) {
+		drawFillBlockColor<PixelInt>(blockPtr, pitch, color);
 	}
 
-	static inline void drawRawBlock(uint16 *blockPtr, uint16 pitch, const uint16 (&colors)[16], const byte *colorMap) {
-		blockPtr[0] = colors[0];
-		blockPtr[1] = colors[1];
-		blockPtr[2] = colors[2];
-		blockPtr[3] = colors[3];
-		blockPtr += pitch;
-		blockPtr[0] = colors[4];
-		blockPtr[1] = colors[5];
-		blockPtr[2] = colors[6];
-		blockPtr[3] = colors[7];
-		blockPtr += pitch;
-		blockPtr[0] = colors[8];
-		blockPtr[1] = colors[9];
-		blockPtr[2] = colors[10];
-		blockPtr[3] = colors[11];
-		blockPtr += pitch;
-		blockPtr[0] = colors[12];
-		blockPtr[1] = colors[13];
-		blockPtr[2] = colors[14];
-		blockPtr[3] = colors[15];
+	template<typename PixelInt>
+	static inline void drawRawBlock(PixelInt *blockPtr, uint16 pitch, const uint16 (&colors)[16], const byte *colorMap, const uint32 *colorTable) {
+		for (int y = 0; y < 4; y++) {
+			blockPtr[0] = colors[y * 4 + 0];
+			blockPtr[1] = colors[y * 4 + 1];
+			blockPtr[2] = colors[y * 4 + 2];
+			blockPtr[3] = colors[y * 4 + 3];
+			blockPtr += pitch;
+		}
 	}
 
-	static inline void drawBlendBlock(uint16 *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const byte *colorMap) {
-		blockPtr[0] = colors[(indexes[0] >> 6) & 0x03];
-		blockPtr[1] = colors[(indexes[0] >> 4) & 0x03];
-		blockPtr[2] = colors[(indexes[0] >> 2) & 0x03];
-		blockPtr[3] = colors[(indexes[0] >> 0) & 0x03];
-		blockPtr += pitch;
-		blockPtr[0] = colors[(indexes[1] >> 6) & 0x03];
-		blockPtr[1] = colors[(indexes[1] >> 4) & 0x03];
-		blockPtr[2] = colors[(indexes[1] >> 2) & 0x03];
-		blockPtr[3] = colors[(indexes[1] >> 0) & 0x03];
-		blockPtr += pitch;
-		blockPtr[0] = colors[(indexes[2] >> 6) & 0x03];
-		blockPtr[1] = colors[(indexes[2] >> 4) & 0x03];
-		blockPtr[2] = colors[(indexes[2] >> 2) & 0x03];
-		blockPtr[3] = colors[(indexes[2] >> 0) & 0x03];
-		blockPtr += pitch;
-		blockPtr[0] = colors[(indexes[3] >> 6) & 0x03];
-		blockPtr[1] = colors[(indexes[3] >> 4) & 0x03];
-		blockPtr[2] = colors[(indexes[3] >> 2) & 0x03];
-		blockPtr[3] = colors[(indexes[3] >> 0) & 0x03];
+	template<typename PixelInt>
+	static inline void drawBlendBlock(PixelInt *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const byte *colorMap, const uint32 *colorTable) {
+		drawBlendBlockColors(blockPtr, pitch, colors, indexes);
+	}
+
+protected:
+	template<typename PixelInt>
+	static inline void drawFillBlockColor(PixelInt *blockPtr, uint16 pitch, PixelInt color) {
+		for (int y = 0; y < 4; y++) {
+			blockPtr[0] = color;
+			blockPtr[1] = color;
+			blockPtr[2] = color;
+			blockPtr[3] = color;
+			blockPtr += pitch;
+		}
+	}
+
+	template<typename PixelInt, typename ColorInt>
+	static inline void drawBlendBlockColors(PixelInt *blockPtr, uint16 pitch, const ColorInt (&colors)[4], const byte (&indexes)[4]) {
+		for (int y = 0; y < 4; y++) {
+			blockPtr[0] = colors[(indexes[y] >> 6) & 0x03];
+			blockPtr[1] = colors[(indexes[y] >> 4) & 0x03];
+			blockPtr[2] = colors[(indexes[y] >> 2) & 0x03];
+			blockPtr[3] = colors[(indexes[y] >> 0) & 0x03];
+			blockPtr += pitch;
+		}
+	}
+};
+
+/**
+ * Output in another high color format, converting the colors of each block once
+ */
+struct BlockDecoderConvert : public BlockDecoderRaw {
+	template<typename PixelInt>
+	static inline void drawFillBlock(PixelInt *blockPtr, uint16 pitch, uint16 color, const byte *colorMap, const uint32 *colorTable) {
+		drawFillBlockColor<PixelInt>(blockPtr, pitch, colorTable[color & 0x7FFF]);
+	}
+
+	template<typename PixelInt>
+	static inline void drawRawBlock(PixelInt *blockPtr, uint16 pitch, const uint16 (&colors)[16], const byte *colorMap, const uint32 *colorTable) {
+		for (int y = 0; y < 4; y++) {
+			blockPtr[0] = colorTable[colors[y * 4 + 0] & 0x7FFF];
+			blockPtr[1] = colorTable[colors[y * 4 + 1] & 0x7FFF];
+			blockPtr[2] = colorTable[colors[y * 4 + 2] & 0x7FFF];
+			blockPtr[3] = colorTable[colors[y * 4 + 3] & 0x7FFF];
+			blockPtr += pitch;
+		}
+	}
+
+	template<typename PixelInt>
+	static inline void drawBlendBlock(PixelInt *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const byte *colorMap, const uint32 *colorTable) {
+		const uint32 converted[4] = {
+			colorTable[colors[0]], colorTable[colors[1]], colorTable[colors[2]], colorTable[colors[3]]
+		};
+		drawBlendBlockColors(blockPtr, pitch, converted, indexes);
 	}
 };
 
 struct BlockDecoderDither {
-	static inline void drawFillBlock(byte *blockPtr, uint16 pitch, uint16 color, const byte *colorMap) {
+	static inline void drawFillBlock(byte *blockPtr, uint16 pitch, uint16 color, const byte *colorMap, const uint32 *colorTable) {
 		const byte *mapOffset = colorMap + (color >> 1);
 		byte pixel1 = mapOffset[0x0000];
 		byte pixel2 = mapOffset[0x4000];
@@ -160,7 +174,7 @@ struct BlockDecoderDither {
 		blockPtr[3] = pixel2;
 	}
 
-	static inline void drawRawBlock(byte *blockPtr, uint16 pitch, const uint16 (&colors)[16], const byte *colorMap) {
+	static inline void drawRawBlock(byte *blockPtr, uint16 pitch, const uint16 (&colors)[16], const byte *colorMap, const uint32 *colorTable) {
 		blockPtr[0] = colorMap[(colors[0] >> 1) + 0x0000];
 		blockPtr[1] = colorMap[(colors[1] >> 1) + 0x4000];
 		blockPtr[2] = colorMap[(colors[2] >> 1) + 0x8000];
@@ -182,7 +196,7 @@ struct BlockDecoderDither {
 		blockPtr[3] = colorMap[(colors[15] >> 1) + 0x4000];
 	}
 
-	static inline void drawBlendBlock(byte *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const byte *colorMap) {
+	static inline void drawBlendBlock(byte *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const byte *colorMap, const uint32 *colorTable) {
 		blockPtr[0] = colorMap[(colors[(indexes[0] >> 6) & 0x03] >> 1) + 0x0000];
 		blockPtr[1] = colorMap[(colors[(indexes[0] >> 4) & 0x03] >> 1) + 0x4000];
 		blockPtr[2] = colorMap[(colors[(indexes[0] >> 2) & 0x03] >> 1) + 0x8000];
@@ -206,7 +220,7 @@ struct BlockDecoderDither {
 };
 
 template<typename PixelInt, typename BlockDecoder>
-static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt *ptr, uint16 pitch, uint16 blockWidth, uint16 blockHeight, const byte *colorMap) {
+static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt *ptr, uint16 pitch, uint16 blockWidth, uint16 blockHeight, const byte *colorMap, const uint32 *colorTable) {
 	uint16 colorA = 0, colorB = 0;
 	uint16 color4[4];
 
@@ -262,7 +276,7 @@ static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt
 			colorA = stream.readUint16BE();
 
 			while (numBlocks--) {
-				BlockDecoder::drawFillBlock(blockPtr, pitch, colorA, colorMap);
+				BlockDecoder::drawFillBlock(blockPtr, pitch, colorA, colorMap, colorTable);
 				ADVANCE_BLOCK();
 			}
 			break;
@@ -302,7 +316,7 @@ static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt
 				byte indexes[4];
 				stream.read(indexes, 4);
 
-				BlockDecoder::drawBlendBlock(blockPtr, pitch, color4, indexes, colorMap);
+				BlockDecoder::drawBlendBlock(blockPtr, pitch, color4, indexes, colorMap, colorTable);
 				ADVANCE_BLOCK();
 			}
 			break;
@@ -315,7 +329,7 @@ static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt
 			for (int i = 0; i < 15; i++)
 				colors[i + 1] = stream.readUint16BE();
 
-			BlockDecoder::drawRawBlock(blockPtr, pitch, colors, colorMap);
+			BlockDecoder::drawRawBlock(blockPtr, pitch, colors, colorMap, colorTable);
 			ADVANCE_BLOCK();
 			break;
 		}
@@ -340,9 +354,13 @@ const Graphics::Surface *RPZADecoder::decodeFrame(Common::SeekableReadStream &st
 	}
 
 	if (_colorMap)
-		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)_surface->getPixels(), _surface->pitch, _blockWidth, _blockHeight, _colorMap);
+		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)_surface->getPixels(), _surface->pitch, _blockWidth, _blockHeight, _colorMap, nullptr);
+	else if (!_colorTable)
+		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, nullptr, nullptr);
+	else if (_format.bytesPerPixel == 2)
+		decodeFrameTmpl<uint16, BlockDecoderConvert>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, nullptr, _colorTable);
 	else
-		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, _colorMap);
+		decodeFrameTmpl<uint32, BlockDecoderConvert>(stream, (uint32 *)_surface->getPixels(), _surface->pitch / 4, _blockWidth, _blockHeight, nullptr, _colorTable);
 
 	return _surface;
 }
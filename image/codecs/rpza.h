@@ -53,6 +53,7 @@ private:
 	byte *_ditherPalette;
 	bool _dirtyPalette;
 	byte *_colorMap;
+	uint32 *_colorTable;
 	uint16 _width, _height;
 	uint16 _blockWidth, _blockHeight;
 };
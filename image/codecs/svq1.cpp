@@ -37,6 +37,14 @@
 
 #include "graphics/yuv_to_rgb.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SVQ1_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SVQ1_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Image {
 
 #define SVQ1_BLOCK_SKIP     0
@@ -596,6 +604,52 @@ void SVQ1Decoder::putPixels16C(byte *block, const byte *pixels, int lineSize, in
 	putPixels8C(block + 8, pixels + 8, lineSize, h);
 }
 
+#if defined(SVQ1_USE_SSE2) || defined(SVQ1_USE_NEON)
+// The 16 pixel wide halfpel interpolations work on whole rows of the block
+
+void SVQ1Decoder::putPixels16X2C(byte *block, const byte *pixels, int lineSize, int h) {
+	for (int i = 0; i < h; i++, pixels += lineSize, block += lineSize) {
+#if defined(SVQ1_USE_SSE2)
+		_mm_storeu_si128((__m128i *)block, _mm_avg_epu8(_mm_loadu_si128((const __m128i *)pixels), _mm_loadu_si128((const __m128i *)(pixels + 1))));
+#else
+		vst1q_u8(block, vrhaddq_u8(vld1q_u8(pixels), vld1q_u8(pixels + 1)));
+#endif
+	}
+}
+
+void SVQ1Decoder::putPixels16Y2C(byte *block, const byte *pixels, int lineSize, int h) {
+	for (int i = 0; i < h; i++, pixels += lineSize, block += lineSize) {
+#if defined(SVQ1_USE_SSE2)
+		_mm_storeu_si128((__m128i *)block, _mm_avg_epu8(_mm_loadu_si128((const __m128i *)pixels), _mm_loadu_si128((const __m128i *)(pixels + lineSize))));
+#else
+		vst1q_u8(block, vrhaddq_u8(vld1q_u8(pixels), vld1q_u8(pixels + lineSize)));
+#endif
+	}
+}
+
+void SVQ1Decoder::putPixels16XY2C(byte *block, const byte *pixels, int lineSize, int h) {
+	for (int i = 0; i < h; i++, pixels += lineSize, block += lineSize) {
+#if defined(SVQ1_USE_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i a = _mm_loadu_si128((const __m128i *)pixels), b = _mm_loadu_si128((const __m128i *)(pixels + 1));
+		const __m128i c = _mm_loadu_si128((const __m128i *)(pixels + lineSize)), d = _mm_loadu_si128((const __m128i *)(pixels + lineSize + 1));
+		__m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)),
+								   _mm_add_epi16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(d, zero)));
+		__m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)),
+								   _mm_add_epi16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(d, zero)));
+		lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_set1_epi16(2)), 2);
+		hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_set1_epi16(2)), 2);
+		_mm_storeu_si128((__m128i *)block, _mm_packus_epi16(lo, hi));
+#else
+		const uint8x16_t a = vld1q_u8(pixels), b = vld1q_u8(pixels + 1);
+		const uint8x16_t c = vld1q_u8(pixels + lineSize), d = vld1q_u8(pixels + lineSize + 1);
+		const uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(a), vget_low_u8(b)), vaddl_u8(vget_low_u8(c), vget_low_u8(d)));
+		const uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(a), vget_high_u8(b)), vaddl_u8(vget_high_u8(c), vget_high_u8(d)));
+		vst1q_u8(block, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+#endif
+	}
+}
+#else
 void SVQ1Decoder::putPixels16X2C(byte *block, const byte *pixels, int lineSize, int h) {
 	putPixels8X2C(block, pixels, lineSize, h);
 	putPixels8X2C(block + 8, pixels + 8, lineSize, h);
@@ -610,6 +664,7 @@ void SVQ1Decoder::putPixels16XY2C(byte *block, const byte *pixels, int lineSize,
 	putPixels8XY2C(block, pixels, lineSize, h);
 	putPixels8XY2C(block + 8, pixels + 8, lineSize, h);
 }
+#endif
 
 bool SVQ1Decoder::svq1MotionInterBlock(Common::BitStream32BEMSB *ss, byte *current, byte *previous, int pitch,
 		Common::Point *motion, int x, int y) {
@@ -31,6 +31,7 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -48,7 +49,8 @@ namespace Image {
 JPEGDecoder::JPEGDecoder() :
 		_surface(),
 		_colorSpace(kColorSpaceRGB),
-		_requestedPixelFormat(getByteOrderRgbPixelFormat()) {
+		_requestedPixelFormat(getByteOrderRgbPixelFormat()),
+		_scaleDenominator(1) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -272,14 +274,19 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		break;
 	}
 
+	// Let libjpeg scale the image down while decoding it
+	cinfo.scale_num = 1;
+	cinfo.scale_denom = _scaleDenominator;
+
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
 	// Allocate buffers for the output data
 	switch (_colorSpace) {
 	case kColorSpaceRGB: {
+		// Formats libjpeg cannot output are converted row by row, but for 3Bpp
 		Graphics::PixelFormat outputPixelFormat;
-		if (cinfo.out_color_space == JCS_RGB) {
+		if (cinfo.out_color_space == JCS_RGB && _requestedPixelFormat.bytesPerPixel == 3) {
 			outputPixelFormat = getByteOrderRgbPixelFormat();
 		} else {
 			outputPixelFormat = _requestedPixelFormat;
@@ -296,18 +303,28 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		break;
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	if (cinfo.out_color_space == JCS_RGB && _surface.format != getByteOrderRgbPixelFormat()) {
+		// Allocate buffer for one scanline
+		JDIMENSION pitch = cinfo.output_width * 3;
+		JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+
+		// Convert each scanline to the requested pixel format
+		while (cinfo.output_scanline < cinfo.output_height) {
+			byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
 
-	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+			jpeg_read_scanlines(&cinfo, buffer, 1);
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+			Graphics::crossBlit(dst, buffer[0], _surface.pitch, pitch, cinfo.output_width, 1, _surface.format, getByteOrderRgbPixelFormat());
+		}
+	} else {
+		assert(_surface.pitch >= cinfo.output_width * _surface.format.bytesPerPixel);
 
-		memcpy(dst, buffer[0], pitch);
+		// Go through the image data scanline by scanline, straight into the surface
+		while (cinfo.output_scanline < cinfo.output_height) {
+			JSAMPROW dst = (JSAMPROW)_surface.getBasePtr(0, cinfo.output_scanline);
+
+			jpeg_read_scanlines(&cinfo, &dst, 1);
+		}
 	}
 
 	// We are done with decompressing, thus free all the data
@@ -102,10 +102,21 @@ public:
 	 */
 	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _requestedPixelFormat = format; }
 
+	/**
+	 * Request the image to be decoded at a fraction of its size, for example
+	 * for thumbnails. libjpeg scales the image down as part of the inverse DCT,
+	 * which costs less than decoding it at full size.
+	 *
+	 * @param denominator 1, 2, 4 or 8: the image is decoded at 1/denominator
+	 *                    of its size, rounded up. The decoder defaults to 1.
+	 */
+	void setScaleDenominator(uint denominator) { _scaleDenominator = denominator; }
+
 private:
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
+	uint _scaleDenominator;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
 };
@@ -31,6 +31,7 @@
 
 #include "image/png.h"
 
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -46,7 +47,8 @@ PNGDecoder::PNGDecoder() :
         _paletteColorCount(0),
         _skipSignature(false),
 		_keepTransparencyPaletted(false),
-		_transparentColor(-1) {
+		_transparentColor(-1),
+		_requestedPixelFormat(getByteOrderRgbaPixelFormat()) {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -63,6 +65,11 @@ void PNGDecoder::destroy() {
 	_palette = NULL;
 }
 
+void PNGDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
+	_requestedPixelFormat = format;
+}
+
 Graphics::PixelFormat PNGDecoder::getByteOrderRgbaPixelFormat() const {
 #ifdef SCUMM_BIG_ENDIAN
 	return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
@@ -201,7 +208,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		}
 
 		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat() : Graphics::PixelFormat::createFormatCLUT8());
+			hasRgbaPalette ? _requestedPixelFormat : Graphics::PixelFormat::createFormatCLUT8());
 		png_set_packing(pngPtr);
 
 		if (hasRgbaPalette) {
@@ -223,7 +230,8 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat());
+		// Interlaced images are only complete at the end, they are converted then
+		_outputSurface->create(width, height, interlaceType == PNG_INTERLACE_NONE ? _requestedPixelFormat : getByteOrderRgbaPixelFormat());
 		if (!_outputSurface->getPixels()) {
 			error("Could not allocate memory for output image.");
 		}
@@ -254,10 +262,21 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		for (int yp = 0; yp < height; ++yp) {
 			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
+			Graphics::crossBlitMap((byte *)_outputSurface->getBasePtr(0, yp), rowPtr, _outputSurface->pitch, width,
+				width, 1, _outputSurface->format.bytesPerPixel, rgbaPalette);
+		}
+
+		delete[] rowPtr;
+	} else if (interlaceType == PNG_INTERLACE_NONE && _outputSurface->format != getByteOrderRgbaPixelFormat()) {
+		// Convert the rows to the requested format as they come
+		png_bytep rowPtr = new byte[width * 4];
+		if (!rowPtr)
+			error("Could not allocate memory for row.");
 
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
+		for (int i = 0; i < height; i++) {
+			png_read_row(pngPtr, rowPtr, nullptr);
+			Graphics::crossBlit((byte *)_outputSurface->getBasePtr(0, i), rowPtr, _outputSurface->pitch, width * 4,
+				width, 1, _outputSurface->format, getByteOrderRgbaPixelFormat());
 		}
 
 		delete[] rowPtr;
@@ -293,6 +312,9 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Destroy libpng structures
 	png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
 
+	if (_outputSurface->format.bytesPerPixel != 1 && _outputSurface->format != _requestedPixelFormat)
+		_outputSurface->convertToInPlace(_requestedPixelFormat); // Slow path, for interlaced images
+
 	return true;
 #else
 	return false;
@@ -66,6 +66,16 @@ public:
 	int getTransparentColor() const { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the output pixel format of the images which are not kept
+	 * paletted. The rows are converted to it as they are decoded, which
+	 * saves the callers a conversion of the whole surface afterwards.
+	 *
+	 * The format has to use two or four bytes per pixel. The decoder
+	 * defaults to byte order RGBA.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format);
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat() const;
 
@@ -79,6 +89,8 @@ private:
 	bool _keepTransparencyPaletted;
 	int _transparentColor;
 
+	Graphics::PixelFormat _requestedPixelFormat;
+
 	Graphics::Surface *_outputSurface;
 };
 
@@ -29,6 +29,7 @@ endif
 ifdef DYNAMIC_MODULES
 	$(INSTALL) -d "$(DESTDIR)$(libdir)/scummvm/"
 	$(INSTALL) -c -m 644 $(PLUGINS) "$(DESTDIR)$(libdir)/scummvm/"
+	$(INSTALL) -c -m 644 $(PLUGINS_INDEX) "$(DESTDIR)$(libdir)/scummvm/"
 endif
 
 install-strip:
@@ -55,6 +56,7 @@ endif
 ifdef DYNAMIC_MODULES
 	$(INSTALL) -d "$(DESTDIR)$(libdir)/scummvm/"
 	$(INSTALL) -c -s -m 644 $(PLUGINS) "$(DESTDIR)$(libdir)/scummvm/"
+	$(INSTALL) -c -m 644 $(PLUGINS_INDEX) "$(DESTDIR)$(libdir)/scummvm/"
 endif
 
 uninstall:
@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/adpcm.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "../null_osystem.h"
+
+class ADPCMTestSuite : public CxxTest::TestSuite {
+	// Pseudo random ADPCM data, with valid step indices in the MS IMA block headers
+	static byte *createData(uint32 size, Audio::ADPCMType type, int channels, uint32 blockAlign) {
+		byte *data = (byte *)malloc(size);
+		uint32 seed = size + type * 7 + channels;
+		for (uint32 i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 16;
+		}
+
+		if (type == Audio::kADPCMMSIma) {
+			for (uint32 block = 0; block < size; block += blockAlign) {
+				for (int i = 0; i < channels; ++i) {
+					data[block + i * 4 + 2] = data[block + i * 4 + 2] % 89;
+					data[block + i * 4 + 3] = 0;
+				}
+			}
+		}
+		return data;
+	}
+
+	// Decode the stream in slices of varying multiples of the granularity, and hash the samples
+	static uint32 decode(Audio::AudioStream *stream, int granularity, uint32 &count) {
+		int16 buffer[4096];
+		uint32 hash = 2166136261u;
+		count = 0;
+		int slice = 0;
+		while (!stream->endOfData()) {
+			const int size = (1 + (slice++ * 331) % (4000 / granularity)) * granularity;
+			const int len = stream->readBuffer(buffer, size);
+			if (len <= 0)
+				break;
+			for (int i = 0; i < len; ++i)
+				hash = (hash ^ (uint16)buffer[i]) * 16777619u;
+			count += len;
+		}
+		return hash;
+	}
+
+	static void check(Audio::ADPCMType type, int channels, uint32 blockAlign, uint32 size, uint32 expectedCount, uint32 expectedHash) {
+		byte *data = createData(size, type, channels, blockAlign);
+		Audio::SeekableAudioStream *stream = Audio::makeADPCMStream(new Common::MemoryReadStream(data, size, DisposeAfterUse::YES),
+			DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+
+		uint32 count;
+		// MS IMA ADPCM streams used to need whole sets of 8 samples per channel
+		const int granularity = (type == Audio::kADPCMMSIma) ? 8 * channels : channels;
+		const uint32 hash = decode(stream, granularity, count);
+		TS_ASSERT_EQUALS(count, expectedCount);
+		TS_ASSERT_EQUALS(hash, expectedHash);
+
+		// Rewinding gives the same samples, also when reading them in slices of any size
+		TS_ASSERT(stream->rewind());
+		TS_ASSERT_EQUALS(decode(stream, channels, count), hash);
+		TS_ASSERT_EQUALS(count, expectedCount);
+
+		delete stream;
+	}
+
+public:
+	void test_oki() {
+		check(Audio::kADPCMOki, 1, 0, 5000, 10000, 2660036149u);
+	}
+
+	void test_dvi() {
+		check(Audio::kADPCMDVI, 1, 0, 5000, 10000, 3267098680u);
+		check(Audio::kADPCMDVI, 2, 0, 5000, 10000, 3363945918u);
+	}
+
+	void test_ms_ima() {
+		check(Audio::kADPCMMSIma, 1, 256, 256 * 9, 9 * 504, 259406633u);
+		check(Audio::kADPCMMSIma, 2, 512, 512 * 9, 9 * 1008, 1433199608u);
+	}
+
+	void test_ms() {
+		check(Audio::kADPCMMS, 1, 256, 256 * 9, 9 * 500, 520548280u);
+		check(Audio::kADPCMMS, 2, 512, 512 * 9, 9 * 1000, 3819900753u);
+	}
+
+	void test_apple() {
+		check(Audio::kADPCMApple, 1, 34, 34 * 40, 40 * 64, 1277541931u);
+		check(Audio::kADPCMApple, 2, 34, 34 * 2 * 40, 40 * 128, 2852061903u);
+	}
+};
@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/asf.h"
+#include "audio/decoders/flac.h"
+#include "audio/decoders/mp3.h"
+#include "audio/decoders/quicktime.h"
+#include "audio/decoders/raw.h"
+#include "audio/decoders/vorbis.h"
+#include "audio/decoders/xa.h"
+#include "common/memstream.h"
+#include "../../null_osystem.h"
+#include "helper.h"
+
+class DecoderBenchmarkSuite : public CxxTest::TestSuite {
+	// Decode the data from memory a few times, and report the fastest run
+	template<class Stream>
+	static void measure(const char *name, const byte *data, uint32 size, Stream *(*factory)(Common::SeekableReadStream *, DisposeAfterUse::Flag)) {
+		uint64 best = 0;
+		uint64 samples = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			Audio::AudioStream *stream = factory(new Common::MemoryReadStream(data, size), DisposeAfterUse::YES);
+			if (!stream) {
+				Benchmark::skip(name, "unsupported data");
+				return;
+			}
+			samples = AudioBenchmark::drain(stream);
+			delete stream;
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, samples, "samples", best);
+	}
+
+	// Decode a sample file of the data directory, if there is one
+	template<class Stream>
+	static void measureFile(const char *name, const char *fileName, Stream *(*factory)(Common::SeekableReadStream *, DisposeAfterUse::Flag)) {
+		uint32 size;
+		byte *data = AudioBenchmark::loadData(fileName, size);
+		if (!data) {
+			Benchmark::skip(name, fileName);
+			return;
+		}
+		measure(name, data, size, factory);
+		free(data);
+	}
+
+	static Audio::SeekableAudioStream *makeRaw(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+		return Audio::makeRawStream(stream, 44100, Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN, disposeAfterUse);
+	}
+
+	static Audio::RewindableAudioStream *makeXA(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+		return Audio::makeXAStream(stream, 22050, disposeAfterUse);
+	}
+
+	// The parameters of one ADPCM variant, chosen as they are found in the games
+	struct ADPCMVariant {
+		const char *name;
+		Audio::ADPCMType type;
+		int channels;
+		uint32 blockAlign;
+	};
+
+	// Random data, with the block headers made valid where the decoders check them
+	static byte *createADPCMData(uint32 size, const ADPCMVariant &variant) {
+		byte *data = Benchmark::createNoise(size, variant.type);
+
+		for (uint32 block = 0; variant.blockAlign && block < size; block += variant.blockAlign) {
+			if (variant.type == Audio::kADPCMMSIma) {
+				for (int i = 0; i < variant.channels; ++i)
+					data[block + i * 4 + 2] %= 89;
+			} else if (variant.type == Audio::kADPCMDK3) {
+				WRITE_LE_UINT16(data + block + 2, 22050);
+				data[block + 14] %= 89;
+				data[block + 15] %= 89;
+			}
+		}
+
+		if (variant.type == Audio::kADPCMXA) {
+			// The sound groups have a filter and a shift for each sound unit
+			for (uint32 group = 0; group + 128 <= size; group += 128) {
+				for (int i = 4; i < 12; ++i)
+					data[group + i] = ((data[group + i] >> 4) % 5) << 4 | (data[group + i] & 0xf) % 13;
+			}
+		}
+		return data;
+	}
+
+	static Audio::ADPCMType _adpcmType;
+	static int _adpcmChannels;
+	static uint32 _adpcmBlockAlign;
+
+	static Audio::SeekableAudioStream *makeADPCM(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+		return Audio::makeADPCMStream(stream, disposeAfterUse, stream->size(), _adpcmType, 22050, _adpcmChannels, _adpcmBlockAlign);
+	}
+
+public:
+	void test_pcm() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const uint32 size = 4 * 44100 * 10;
+		byte *data = Benchmark::createNoise(size, 1);
+		measure("decoder.raw", data, size, makeRaw);
+		free(data);
+#endif
+	}
+
+	void test_adpcm() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		static const ADPCMVariant kVariants[] = {
+			{ "decoder.adpcm.oki",   Audio::kADPCMOki,    1,    0 },
+			{ "decoder.adpcm.msima", Audio::kADPCMMSIma,  2, 2048 },
+			{ "decoder.adpcm.ms",    Audio::kADPCMMS,     2, 2048 },
+			{ "decoder.adpcm.dvi",   Audio::kADPCMDVI,    2,    0 },
+			{ "decoder.adpcm.apple", Audio::kADPCMApple,  2,   34 },
+			{ "decoder.adpcm.dk3",   Audio::kADPCMDK3,    2, 1024 },
+			{ "decoder.adpcm.xa",    Audio::kADPCMXA,     2,    0 }
+		};
+
+		// A multiple of all block sizes, and of the XA sound groups
+		const uint32 size = 2048 * 34 * 8;
+		for (int i = 0; i < ARRAYSIZE(kVariants); ++i) {
+			byte *data = createADPCMData(size, kVariants[i]);
+			_adpcmType = kVariants[i].type;
+			_adpcmChannels = kVariants[i].channels;
+			_adpcmBlockAlign = kVariants[i].blockAlign;
+			measure(kVariants[i].name, data, size, makeADPCM);
+			free(data);
+		}
+#endif
+	}
+
+	void test_psx_xa() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// 16 byte frames of a predictor and shift, flags and 14 bytes of samples
+		const uint32 frames = 40000;
+		byte *data = Benchmark::createNoise(frames * 16, 2);
+		for (uint32 i = 0; i < frames; ++i) {
+			data[i * 16] = ((data[i * 16] >> 4) % 5) << 4 | (4 + (data[i * 16] & 0xf) % 9);
+			data[i * 16 + 1] = (i == frames - 1) ? 7 : 0;
+		}
+		measure("decoder.psx_xa", data, frames * 16, makeXA);
+		free(data);
+#endif
+	}
+
+	void test_files() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifdef USE_VORBIS
+		measureFile("decoder.vorbis", "bench.ogg", Audio::makeVorbisStream);
+#else
+		Benchmark::skip("decoder.vorbis", "not built");
+#endif
+#ifdef USE_FLAC
+		measureFile("decoder.flac", "bench.flac", Audio::makeFLACStream);
+#else
+		Benchmark::skip("decoder.flac", "not built");
+#endif
+#ifdef USE_MAD
+		measureFile("decoder.mp3", "bench.mp3", Audio::makeMP3Stream);
+#else
+		Benchmark::skip("decoder.mp3", "not built");
+#endif
+		measureFile("decoder.wma", "bench.wma", Audio::makeASFStream);
+		// QuickTime files hand out nullptr when the codec is not built in
+		measureFile("decoder.aac", "bench.m4a", Audio::makeQuickTimeStream);
+		measureFile("decoder.qdm2", "bench_qdm2.mov", Audio::makeQuickTimeStream);
+#endif
+	}
+};
+
+Audio::ADPCMType DecoderBenchmarkSuite::_adpcmType = Audio::kADPCMOki;
+int DecoderBenchmarkSuite::_adpcmChannels = 1;
+uint32 DecoderBenchmarkSuite::_adpcmBlockAlign = 0;
@@ -0,0 +1,47 @@
+#ifndef TEST_AUDIO_BENCHMARK_HELPER_H
+#define TEST_AUDIO_BENCHMARK_HELPER_H
+
+#include "audio/audiostream.h"
+#include "common/fs.h"
+#include "common/stream.h"
+#include "../../benchmark.h"
+
+// Directory holding the optional sample files and ROMs, see test/module.mk
+#ifndef AUDIO_BENCHMARK_DATA
+#define AUDIO_BENCHMARK_DATA "test/audio-benchmark-data"
+#endif
+
+namespace AudioBenchmark {
+
+// Read a file of the data directory into memory, or return nullptr if it is missing
+static byte *loadData(const char *name, uint32 &size) {
+	Common::FSNode node = Common::FSNode(AUDIO_BENCHMARK_DATA).getChild(name);
+	if (!node.exists())
+		return nullptr;
+
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!stream)
+		return nullptr;
+	size = stream->size();
+	byte *data = (byte *)malloc(size);
+	size = stream->read(data, size);
+	delete stream;
+	return data;
+}
+
+// Decode the whole stream, and return the number of samples
+static uint64 drain(Audio::AudioStream *stream) {
+	int16 buffer[4096];
+	uint64 count = 0;
+	while (!stream->endOfData()) {
+		const int len = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+		if (len <= 0)
+			break;
+		count += len;
+	}
+	return count;
+}
+
+} // End of namespace AudioBenchmark
+
+#endif
@@ -0,0 +1,147 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/rate.h"
+#include "../../null_osystem.h"
+#include "helper.h"
+
+class RateConverterBenchmarkSuite : public CxxTest::TestSuite {
+	// Endless stream repeating the given samples
+	class LoopStream : public Audio::AudioStream {
+	public:
+		LoopStream(const int16 *samples, int count, int rate, bool stereo) :
+			_samples(samples), _count(count), _pos(0), _rate(rate), _stereo(stereo) {}
+
+		int readBuffer(int16 *buffer, const int numSamples) override {
+			int written = 0;
+			while (written < numSamples) {
+				const int len = MIN(numSamples - written, _count - _pos);
+				memcpy(buffer + written, _samples + _pos, len * sizeof(int16));
+				written += len;
+				_pos = (_pos + len) % _count;
+			}
+			return written;
+		}
+
+		bool isStereo() const override { return _stereo; }
+		int getRate() const override { return _rate; }
+		bool endOfData() const override { return false; }
+
+	private:
+		const int16 *_samples;
+		const int _count;
+		int _pos;
+		const int _rate;
+		const bool _stereo;
+	};
+
+	// Convert ten seconds of output in mixer sized chunks, and report the output samples per second
+	static void measure(const char *name, int inRate, int outRate, bool stereo) {
+		const int bufferFrames = 1024;
+		const int chunks = outRate * 10 / bufferFrames;
+		byte *noise = Benchmark::createNoise(96000 * 2 * sizeof(int16), inRate);
+		int16 *obuf = new int16[bufferFrames * 2];
+
+		uint64 best = 0;
+		uint64 samples = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			LoopStream stream((const int16 *)noise, 96000 * 2, inRate, stereo);
+			Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, false);
+			memset(obuf, 0, bufferFrames * 2 * sizeof(int16));
+
+			samples = 0;
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < chunks; ++i)
+				samples += converter->flow(stream, obuf, bufferFrames, 192, 160) * 2;
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+
+			delete converter;
+		}
+		Benchmark::report(name, samples, "samples", best);
+
+		delete[] obuf;
+		free(noise);
+	}
+
+	// Mix 32 channels at different rates into the same output buffer, as a busy mixer does
+	static void measureMix(const char *name) {
+		static const int kRates[] = { 8000, 11025, 22050, 44100, 48000, 32000, 88200, 16000 };
+		const int outRate = 44100;
+		const int bufferFrames = 1024;
+		const int chunks = outRate * 2 / bufferFrames;
+		byte *noise = Benchmark::createNoise(96000 * 2 * sizeof(int16), 1);
+		int16 *obuf = new int16[bufferFrames * 2];
+
+		uint64 best = 0;
+		uint64 samples = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			LoopStream *streams[32];
+			Audio::RateConverter *converters[32];
+			for (int i = 0; i < 32; ++i) {
+				const int inRate = kRates[i % ARRAYSIZE(kRates)];
+				const bool stereo = (i & 1) != 0;
+				streams[i] = new LoopStream((const int16 *)noise, 96000 * 2, inRate, stereo);
+				converters[i] = Audio::makeRateConverter(inRate, outRate, stereo, i % 4 == 3);
+			}
+
+			samples = 0;
+			const uint64 start = Common::Profiler::getMicros();
+			for (int chunk = 0; chunk < chunks; ++chunk) {
+				memset(obuf, 0, bufferFrames * 2 * sizeof(int16));
+				for (int i = 0; i < 32; ++i)
+					samples += converters[i]->flow(*streams[i], obuf, bufferFrames, 128, 128) * 2;
+			}
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+
+			for (int i = 0; i < 32; ++i) {
+				delete converters[i];
+				delete streams[i];
+			}
+		}
+		Benchmark::report(name, samples, "samples", best);
+
+		delete[] obuf;
+		free(noise);
+	}
+
+public:
+	void test_copy() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measure("rate.copy.mono", 44100, 44100, false);
+		measure("rate.copy.stereo", 44100, 44100, true);
+#endif
+	}
+
+	void test_simple() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measure("rate.simple.mono", 44100, 22050, false);
+		measure("rate.simple.stereo", 88200, 22050, true);
+#endif
+	}
+
+	void test_linear() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measure("rate.linear.mono.up", 11025, 44100, false);
+		measure("rate.linear.stereo.up", 22050, 48000, true);
+		measure("rate.linear.stereo.down", 48000, 44100, true);
+#endif
+	}
+
+	void test_mix() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measureMix("rate.mix.32channels");
+#endif
+	}
+};
@@ -0,0 +1,157 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/fmopl.h"
+#include "../../null_osystem.h"
+#include "helper.h"
+
+#ifdef USE_MT32EMU
+// Leaves out the FileStream API, as audio/softsynth/mt32.cpp does
+#define MT32EMU_FILE_STREAM_H
+#include "audio/softsynth/mt32/c_interface/cpp_interface.h"
+#endif
+
+class SynthBenchmarkSuite : public CxxTest::TestSuite {
+	typedef OPL::EmulatedOPL::RegisterWrite RegisterWrite;
+
+	// Register writes playing a tone on each of the 9 channels, then releasing them
+	static uint createNotes(RegisterWrite *writes, uint32 frames) {
+		static const byte kSlots[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+		uint count = 0;
+		for (int i = 0; i < 9; ++i) {
+			const uint32 frame = i * frames / 20;
+			const uint16 fnum = 0x200 + i * 0x20;
+			const RegisterWrite note[] = {
+				{ frame, (uint16)(0x20 + kSlots[i]), 0x21 },
+				{ frame, (uint16)(0x23 + kSlots[i]), 0x01 },
+				{ frame, (uint16)(0x40 + kSlots[i]), 0x10 },
+				{ frame, (uint16)(0x43 + kSlots[i]), 0x00 },
+				{ frame, (uint16)(0x60 + kSlots[i]), 0xf4 },
+				{ frame, (uint16)(0x63 + kSlots[i]), 0xf2 },
+				{ frame, (uint16)(0x80 + kSlots[i]), 0x45 },
+				{ frame, (uint16)(0x83 + kSlots[i]), 0x45 },
+				{ frame, (uint16)(0xc0 + i), 0x36 },
+				{ frame, (uint16)(0xa0 + i), (uint8)(fnum & 0xff) },
+				{ frame, (uint16)(0xb0 + i), (uint8)(0x30 | (fnum >> 8)) }
+			};
+			memcpy(writes + count, note, sizeof(note));
+			count += ARRAYSIZE(note);
+		}
+		for (int i = 0; i < 9; ++i) {
+			const RegisterWrite note = { frames / 2 + i * frames / 20, (uint16)(0xb0 + i), (uint8)(0x10 | ((0x200 + i * 0x20) >> 8)) };
+			writes[count++] = note;
+		}
+		return count;
+	}
+
+	static void measureOPL(const char *name, const char *driver, OPL::Config::OplType type) {
+		if (OPL::Config::parse(driver) == -1) {
+			Benchmark::skip(name, "not built");
+			return;
+		}
+
+		const uint32 frames = 44100 * 5;
+		int16 *buffer = new int16[frames * 2];
+		RegisterWrite writes[1 + 9 * 12];
+		uint count = 0;
+		if (type != OPL::Config::kOpl2) {
+			// Without the OPL3 mode the DOSBox emulator only renders mono
+			const RegisterWrite write = { 0, 0x105, 0x01 };
+			writes[count++] = write;
+		}
+		count += createNotes(writes + count, frames);
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			OPL::OPL *opl = OPL::Config::create(OPL::Config::parse(driver), type);
+			if (!opl || !opl->init()) {
+				delete opl;
+				Benchmark::skip(name, "init failed");
+				delete[] buffer;
+				return;
+			}
+
+			const uint64 start = Common::Profiler::getMicros();
+			static_cast<OPL::EmulatedOPL *>(opl)->renderBlock(buffer, frames, writes, count);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+			delete opl;
+		}
+		Benchmark::report(name, (uint64)frames * 2, "samples", best);
+
+		delete[] buffer;
+	}
+
+public:
+	void test_opl() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measureOPL("opl.mame", "mame", OPL::Config::kOpl2);
+		measureOPL("opl.db", "db", OPL::Config::kOpl3);
+		measureOPL("opl.nuked", "nuked", OPL::Config::kOpl3);
+		measureOPL("opl.nuked_fast", "nuked_fast", OPL::Config::kOpl3);
+#endif
+	}
+
+	void test_mt32() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifdef USE_MT32EMU
+		// The ROMs can not be shipped, they are taken from the data directory
+		uint32 controlSize, pcmSize;
+		byte *control = AudioBenchmark::loadData("MT32_CONTROL.ROM", controlSize);
+		byte *pcm = AudioBenchmark::loadData("MT32_PCM.ROM", pcmSize);
+		if (!control || !pcm) {
+			Benchmark::skip("mt32", "MT32_CONTROL.ROM and MT32_PCM.ROM");
+			free(control);
+			free(pcm);
+			return;
+		}
+
+		const uint32 frames = 32000 * 5;
+		const uint32 chunk = 1024;
+		int16 *buffer = new int16[chunk * 2];
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			MT32Emu::Service service;
+			service.createContext();
+			service.addROMData(control, controlSize);
+			service.addROMData(pcm, pcmSize);
+			if (service.openSynth() != MT32EMU_RC_OK) {
+				Benchmark::skip("mt32", "unknown ROMs");
+				break;
+			}
+
+			const uint64 start = Common::Profiler::getMicros();
+			for (uint32 frame = 0; frame < frames; frame += chunk) {
+				// A chord on each part every second, released after half a second
+				if (frame % 32000 < chunk) {
+					for (uint32 part = 0; part < 8; ++part)
+						service.playMsg(0x7f0090 | ((36 + part * 5 + frame / 32000) << 8) | (part + 1));
+				} else if (frame % 32000 >= 16000 && frame % 32000 < 16000 + chunk) {
+					for (uint32 part = 0; part < 8; ++part)
+						service.playMsg(0x000080 | ((36 + part * 5 + frame / 32000) << 8) | (part + 1));
+				}
+				service.renderBit16s(buffer, chunk);
+			}
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+
+			service.closeSynth();
+			if (run == Benchmark::kRuns - 1)
+				Benchmark::report("mt32", (uint64)frames * 2, "samples", best);
+		}
+
+		delete[] buffer;
+		free(control);
+		free(pcm);
+#else
+		Benchmark::skip("mt32", "not built");
+#endif
+#endif
+	}
+};
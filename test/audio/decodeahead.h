@@ -0,0 +1,104 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decodeahead.h"
+#include "audio/decoders/raw.h"
+#include "../null_osystem.h"
+
+class DecodeAheadTestSuite : public CxxTest::TestSuite {
+	static const int kFrames = 20000;
+
+	static int16 sample(int i) {
+		return (int16)(i * 7 - 30000);
+	}
+
+	// A stereo stream of kFrames frames with known samples
+	static Audio::SeekableAudioStream *makeSourceStream() {
+		int16 *samples = (int16 *)malloc(kFrames * 2 * sizeof(int16));
+		for (int i = 0; i < kFrames * 2; ++i)
+			samples[i] = sample(i);
+		return Audio::makeRawStream((byte *)samples, kFrames * 2 * sizeof(int16), 11025,
+#ifdef SCUMM_LITTLE_ENDIAN
+			Audio::FLAG_LITTLE_ENDIAN |
+#endif
+			Audio::FLAG_16BITS | Audio::FLAG_STEREO, DisposeAfterUse::YES);
+	}
+
+	// Read the stream in odd sized slices, and check the samples from the given one on
+	static bool readAndCompare(Audio::DecodeAheadStream &stream, int first, bool decodeAhead) {
+		int16 buffer[1001];
+		int pos = first;
+		int slice = 0;
+		while (!stream.endOfData()) {
+			if (decodeAhead)
+				stream.decodeAhead();
+			const int len = stream.readBuffer(buffer, 1 + (slice++ * 97) % 1000);
+			for (int i = 0; i < len; ++i) {
+				if (buffer[i] != sample(pos++))
+					return false;
+			}
+		}
+		return pos == kFrames * 2;
+	}
+
+public:
+	void test_read() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::DecodeAheadStream *stream = (Audio::DecodeAheadStream *)Audio::makeDecodeAheadStream(makeSourceStream(), 100);
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), 11025);
+		TS_ASSERT_EQUALS(stream->getLength().totalNumberOfFrames(), kFrames);
+
+		TS_ASSERT(readAndCompare(*stream, 0, true));
+		TS_ASSERT(stream->endOfData());
+
+		int16 buffer[16];
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 16), 0);
+
+		const Audio::DecodeAheadStats stats = stream->getStats();
+		TS_ASSERT(stats.reads > 0);
+		TS_ASSERT(stats.decodedSamples > 0);
+		TS_ASSERT(stats.decodedSamples <= (uint32)kFrames * 2);
+		TS_ASSERT_EQUALS(stats.seeks, 0u);
+		delete stream;
+#endif
+	}
+
+	void test_underrun() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Reading faster than the timer decodes falls back to decoding in place
+		Audio::DecodeAheadStream stream(makeSourceStream(), 0, DisposeAfterUse::YES);
+		TS_ASSERT(readAndCompare(stream, 0, false));
+		TS_ASSERT(stream.endOfData());
+#endif
+	}
+
+	void test_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::DecodeAheadStream stream(makeSourceStream(), 100, DisposeAfterUse::YES);
+		stream.decodeAhead();
+
+		int16 buffer[64];
+		TS_ASSERT_EQUALS(stream.readBuffer(buffer, 64), 64);
+
+		// Seeking drops the samples decoded ahead
+		TS_ASSERT(stream.seek(Audio::Timestamp(0, 15000, 11025)));
+		TS_ASSERT(readAndCompare(stream, 15000 * 2, true));
+
+		TS_ASSERT(stream.rewind());
+		TS_ASSERT(!stream.endOfData());
+		TS_ASSERT(readAndCompare(stream, 0, false));
+
+		TS_ASSERT_EQUALS(stream.getStats().seeks, 2u);
+#endif
+	}
+
+	void test_null() {
+		TS_ASSERT(!Audio::makeDecodeAheadStream(nullptr));
+	}
+};
@@ -0,0 +1,170 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+#include "audio/mixer_intern.h"
+#include "../null_osystem.h"
+
+class MixerTestSuite : public CxxTest::TestSuite {
+	// A mono stream of frames with the given value
+	static Audio::AudioStream *makeConstantStream(int16 value, uint frames) {
+		int16 *samples = (int16 *)malloc(frames * sizeof(int16));
+		for (uint i = 0; i < frames; ++i)
+			samples[i] = value;
+		return Audio::makeRawStream((byte *)samples, frames * sizeof(int16), 44100,
+#ifdef SCUMM_LITTLE_ENDIAN
+			Audio::FLAG_LITTLE_ENDIAN |
+#endif
+			Audio::FLAG_16BITS, DisposeAfterUse::YES);
+	}
+
+	// Mix a few frames and return the value of the first left sample
+	static int16 mix(Audio::MixerImpl &mixer) {
+		int16 buffer[64 * 2];
+		mixer.mixCallback((byte *)buffer, sizeof(buffer));
+		return buffer[0];
+	}
+
+public:
+	void test_channel_commands() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(44100);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle;
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSFXSoundType, &handle, makeConstantStream(1000, 44100), 5);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT(mixer.isSoundIDActive(5));
+		TS_ASSERT_EQUALS(mixer.getSoundID(handle), 5);
+		TS_ASSERT(mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+		TS_ASSERT(!mixer.hasActiveChannelOfType(Audio::Mixer::kMusicSoundType));
+		TS_ASSERT(!mixer.isSoundHandleActive(Audio::SoundHandle()));
+		TS_ASSERT_EQUALS(mix(mixer), 1000);
+
+		// Changes are visible right away, and applied by the next mix
+		mixer.setChannelVolume(handle, 128);
+		mixer.setChannelBalance(handle, -20);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 128);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+		TS_ASSERT_EQUALS(mix(mixer), 500);
+
+		mixer.pauseHandle(handle, true);
+		TS_ASSERT_EQUALS(mix(mixer), 0);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		mixer.pauseAll(false);
+		TS_ASSERT_EQUALS(mix(mixer), 500);
+		TS_ASSERT(mixer.getElapsedTime(handle).totalNumberOfFrames() >= 2 * 64);
+
+		// More commands than the queue holds are applied in order
+		for (int i = 0; i < 1000; ++i)
+			mixer.setChannelVolume(handle, i % 200);
+		mixer.setChannelVolume(handle, 77);
+		TS_ASSERT_EQUALS(mix(mixer), 1000 * 77 / 256);
+
+		mixer.stopHandle(handle);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.isSoundIDActive(5));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+		TS_ASSERT_EQUALS(mixer.getElapsedTime(handle).totalNumberOfFrames(), 0);
+
+		// Commands for stopped sounds are ignored, also once the slot is reused
+		mixer.setChannelVolume(handle, 10);
+		Audio::SoundHandle other;
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSFXSoundType, &other, makeConstantStream(-1000, 44100));
+		TS_ASSERT_EQUALS(mix(mixer), -1000);
+#endif
+	}
+
+	void test_finished_channels() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(44100);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle;
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSpeechSoundType, &handle, makeConstantStream(1000, 100));
+		mix(mixer);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		mix(mixer);
+		mix(mixer);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.hasActiveChannelOfType(Audio::Mixer::kSpeechSoundType));
+#endif
+	}
+
+	void test_output_bus() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Only the sum of all channels is clipped
+		Audio::MixerImpl mixer(44100);
+		mixer.setReady(true);
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSFXSoundType, nullptr, makeConstantStream(30000, 44100));
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSFXSoundType, nullptr, makeConstantStream(30000, 44100));
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSFXSoundType, nullptr, makeConstantStream(-30000, 44100));
+		TS_ASSERT_EQUALS(mix(mixer), 30000);
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSFXSoundType, nullptr, makeConstantStream(30000, 44100));
+		TS_ASSERT_EQUALS(mix(mixer), 32767);
+
+		Audio::MixerImpl floatMixer(44100, Audio::MixerImpl::kOutputFloat32);
+		floatMixer.setReady(true);
+		TS_ASSERT_EQUALS(floatMixer.getOutputFrameSize(), 8u);
+		((Audio::Mixer &)floatMixer).playStream(Audio::Mixer::kSFXSoundType, nullptr, makeConstantStream(-16384, 44100));
+		float buffer[64 * 2];
+		TS_ASSERT_EQUALS(floatMixer.mixCallback((byte *)buffer, sizeof(buffer)), 64);
+		TS_ASSERT_EQUALS(buffer[0], -0.5f);
+		TS_ASSERT_EQUALS(buffer[127], -0.5f);
+#endif
+	}
+
+	void test_stats() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(44100);
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle;
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kMusicSoundType, &handle, makeConstantStream(1000, 44100), 7);
+		Audio::QueuingAudioStream *queue = Audio::makeQueuingAudioStream(22050, true);
+		((Audio::Mixer &)mixer).playStream(Audio::Mixer::kSpeechSoundType, &handle, queue);
+		mix(mixer);
+		mix(mixer);
+		mixer.notifyUnderrun();
+
+		Audio::MixerStats stats;
+		TS_ASSERT(mixer.getStats(stats));
+		TS_ASSERT_EQUALS(stats.outputRate, 44100u);
+		TS_ASSERT_EQUALS(stats.bufferFrames, 64u);
+		TS_ASSERT_EQUALS(stats.callbacks, 2u);
+		TS_ASSERT_EQUALS(stats.underruns, 1u);
+		uint32 histogramTotal = 0;
+		for (int i = 0; i < Audio::MixerStats::kNumCallbackBuckets; ++i)
+			histogramTotal += stats.histogram[i];
+		TS_ASSERT_EQUALS(histogramTotal, 2u);
+
+		TS_ASSERT_EQUALS(stats.channels.size(), 2u);
+		TS_ASSERT_EQUALS(stats.channels[0].type, (int)Audio::Mixer::kMusicSoundType);
+		TS_ASSERT_EQUALS(stats.channels[0].id, 7);
+		TS_ASSERT_EQUALS(stats.channels[0].rate, 44100u);
+		TS_ASSERT(!stats.channels[0].stereo);
+		TS_ASSERT_EQUALS(Common::String(stats.channels[0].resampler), "copy");
+		TS_ASSERT_EQUALS(stats.channels[0].mixes, 2u);
+		TS_ASSERT_EQUALS(stats.channels[0].starved, 0u);
+
+		// The queue has no data, but has not ended either
+		TS_ASSERT(stats.channels[1].stereo);
+		TS_ASSERT_EQUALS(Common::String(stats.channels[1].resampler), "linear");
+		TS_ASSERT_EQUALS(stats.channels[1].starved, 2u);
+
+		mixer.resetStats();
+		TS_ASSERT(mixer.getStats(stats));
+		TS_ASSERT_EQUALS(stats.callbacks, 0u);
+		TS_ASSERT_EQUALS(stats.underruns, 0u);
+		TS_ASSERT_EQUALS(stats.channels[0].mixes, 0u);
+#endif
+	}
+};
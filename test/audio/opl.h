@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/fmopl.h"
+#include "../null_osystem.h"
+
+class OPLTestSuite : public CxxTest::TestSuite {
+	typedef OPL::EmulatedOPL::RegisterWrite RegisterWrite;
+
+	static OPL::EmulatedOPL *create(const char *driver) {
+		OPL::OPL *opl = OPL::Config::create(OPL::Config::parse(driver), OPL::Config::kOpl3);
+		if (opl && !opl->init()) {
+			delete opl;
+			return nullptr;
+		}
+		return static_cast<OPL::EmulatedOPL *>(opl);
+	}
+
+	// Register writes setting up a tone on the given channel, starting at the given frame
+	static uint noteOn(RegisterWrite *writes, int channel, uint32 frame, uint16 fnum) {
+		static const byte kSlots[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+		const RegisterWrite note[] = {
+			{ frame, (uint16)(0x20 + kSlots[channel]), 0x21 },
+			{ frame, (uint16)(0x23 + kSlots[channel]), 0x01 },
+			{ frame, (uint16)(0x40 + kSlots[channel]), 0x10 },
+			{ frame, (uint16)(0x43 + kSlots[channel]), 0x00 },
+			{ frame, (uint16)(0x60 + kSlots[channel]), 0xf4 },
+			{ frame, (uint16)(0x63 + kSlots[channel]), 0xf2 },
+			{ frame, (uint16)(0x80 + kSlots[channel]), 0x45 },
+			{ frame, (uint16)(0x83 + kSlots[channel]), 0x45 },
+			{ frame, (uint16)(0xc0 + channel), 0x36 },
+			{ frame, (uint16)(0xa0 + channel), (uint8)(fnum & 0xff) },
+			{ frame, (uint16)(0xb0 + channel), (uint8)(0x30 | (fnum >> 8)) }
+		};
+		memcpy(writes, note, sizeof(note));
+		return ARRAYSIZE(note);
+	}
+
+	// Enable the OPL3 mode, without which the DOSBox emulator only renders mono
+	static uint opl3Mode(RegisterWrite *writes) {
+		const RegisterWrite write = { 0, 0x105, 0x01 };
+		writes[0] = write;
+		return 1;
+	}
+
+	static uint noteOff(RegisterWrite *writes, int channel, uint32 frame, uint16 fnum) {
+		const RegisterWrite note = { frame, (uint16)(0xb0 + channel), (uint8)(0x10 | (fnum >> 8)) };
+		writes[0] = note;
+		return 1;
+	}
+
+	static int maxAmplitude(const int16 *samples, int count) {
+		int result = 0;
+		for (int i = 0; i < count; ++i)
+			result = MAX<int>(result, ABS<int>(samples[i]));
+		return result;
+	}
+
+	void checkRenderBlock(const char *driver) {
+		OPL::EmulatedOPL *opl = create(driver);
+		TS_ASSERT(opl);
+		if (!opl)
+			return;
+
+		RegisterWrite writes[16];
+		uint count = opl3Mode(writes);
+		count += noteOn(writes + count, 0, 1000, 0x244);
+		count += noteOff(writes + count, 0, 3000, 0x244);
+
+		const int frames = 4096;
+		int16 *block = new int16[frames * 2];
+		opl->renderBlock(block, frames, writes, count);
+		TS_ASSERT_EQUALS(maxAmplitude(block, 1000 * 2), 0);
+		TS_ASSERT(maxAmplitude(block + 1000 * 2, 2000 * 2) > 1000);
+
+		// Rendering in pieces, with the writes at their start, gives the same samples
+		opl->reset();
+		int16 *pieces = new int16[frames * 2];
+		for (uint i = 0; i < count; ++i)
+			writes[i].frame = 0;
+		opl->renderBlock(pieces, 1000, writes, 1);
+		opl->renderBlock(pieces + 1000 * 2, 2000, writes + 1, count - 2);
+		opl->renderBlock(pieces + 3000 * 2, frames - 3000, writes + count - 1, 1);
+		TS_ASSERT_EQUALS(memcmp(block, pieces, frames * 2 * sizeof(int16)), 0);
+
+		delete[] pieces;
+		delete[] block;
+		delete opl;
+	}
+
+public:
+	void test_render_block() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifndef DISABLE_DOSBOX_OPL
+		checkRenderBlock("db");
+#endif
+#ifndef DISABLE_NUKED_OPL
+		checkRenderBlock("nuked");
+		checkRenderBlock("nuked_fast");
+#endif
+#endif
+	}
+
+	void test_nuked_fast() {
+#if NULL_OSYSTEM_IS_AVAILABLE && !defined(DISABLE_NUKED_OPL)
+		Common::install_null_g_system();
+
+		// The fast mode only differs in the silent slots
+		RegisterWrite writes[64];
+		uint count = opl3Mode(writes);
+		for (int i = 0; i < 4; ++i)
+			count += noteOn(writes + count, i, 500 * i, 0x200 + i * 0x30);
+		count += noteOff(writes + count, 1, 4000, 0x230);
+
+		const int frames = 8192;
+		int16 *exact = new int16[frames * 2];
+		int16 *fast = new int16[frames * 2];
+
+		OPL::EmulatedOPL *opl = create("nuked");
+		opl->renderBlock(exact, frames, writes, count);
+		delete opl;
+
+		opl = create("nuked_fast");
+		opl->renderBlock(fast, frames, writes, count);
+		delete opl;
+
+		int maxDiff = 0;
+		for (int i = 0; i < frames * 2; ++i)
+			maxDiff = MAX<int>(maxDiff, ABS(exact[i] - fast[i]));
+		TS_ASSERT(maxAmplitude(exact, frames * 2) > 1000);
+		TS_ASSERT_LESS_THAN_EQUALS(maxDiff, 64);
+
+		delete[] fast;
+		delete[] exact;
+#endif
+	}
+};
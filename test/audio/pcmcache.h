@@ -0,0 +1,130 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/pcmcache.h"
+
+class PCMCacheTestSuite : public CxxTest::TestSuite {
+	// A mono stream of the given number of samples, starting with the given value
+	static Audio::SeekableAudioStream *makeSourceStream(int16 first, uint count) {
+		int16 *samples = (int16 *)malloc(count * sizeof(int16));
+		for (uint i = 0; i < count; ++i)
+			samples[i] = first + i;
+		return Audio::makeRawStream((byte *)samples, count * sizeof(int16), 22050,
+#ifdef SCUMM_LITTLE_ENDIAN
+			Audio::FLAG_LITTLE_ENDIAN |
+#endif
+			Audio::FLAG_16BITS, DisposeAfterUse::YES);
+	}
+
+	// Check that the stream holds the samples created by makeSourceStream
+	static bool compare(Audio::AudioStream *stream, int16 first, uint count) {
+		int16 buffer[256];
+		uint pos = 0;
+		while (!stream->endOfData()) {
+			const int len = stream->readBuffer(buffer, 100 + pos % 77);
+			for (int i = 0; i < len; ++i) {
+				if (buffer[i] != (int16)(first + pos++))
+					return false;
+			}
+		}
+		return pos == count;
+	}
+
+	static Audio::PCMCache::Key key(uint32 offset) {
+		return Audio::PCMCache::Key("sounds.dat", offset, MKTAG('T','E','S','T'));
+	}
+
+public:
+	void setUp() {
+		PCMCacheMan.setBudget(4 * 1024 * 1024);
+		PCMCacheMan.clear();
+		PCMCacheMan.resetStats();
+	}
+
+	void test_hit() {
+		TS_ASSERT(!PCMCacheMan.find(key(0)));
+
+		Audio::SeekableAudioStream *stream = PCMCacheMan.insert(key(0), makeSourceStream(100, 5000), DisposeAfterUse::YES);
+		TS_ASSERT(stream);
+		TS_ASSERT(!stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), 22050);
+		TS_ASSERT_EQUALS(stream->getLength().totalNumberOfFrames(), 5000);
+		TS_ASSERT(compare(stream, 100, 5000));
+		TS_ASSERT(stream->rewind());
+		TS_ASSERT(compare(stream, 100, 5000));
+		delete stream;
+
+		// Different keys do not match
+		TS_ASSERT(!PCMCacheMan.find(key(1)));
+		TS_ASSERT(!PCMCacheMan.find(Audio::PCMCache::Key("sounds.dat", 0, MKTAG('T','E','S','T'), 1)));
+		TS_ASSERT(!PCMCacheMan.find(Audio::PCMCache::Key("other.dat", 0, MKTAG('T','E','S','T'))));
+
+		stream = PCMCacheMan.find(key(0));
+		TS_ASSERT(stream);
+		TS_ASSERT(stream->seek(Audio::Timestamp(0, 1000, 22050)));
+		TS_ASSERT(compare(stream, 1100, 4000));
+
+		// Streams stay valid when their sound is dropped
+		PCMCacheMan.clear();
+		TS_ASSERT(stream->rewind());
+		TS_ASSERT(compare(stream, 100, 5000));
+		delete stream;
+
+		const Audio::PCMCache::Stats stats = PCMCacheMan.getStats();
+		TS_ASSERT_EQUALS(stats.hits, 1u);
+		TS_ASSERT_EQUALS(stats.misses, 4u);
+		TS_ASSERT_EQUALS(stats.entries, 0u);
+		TS_ASSERT_EQUALS(stats.size, 0u);
+	}
+
+	void test_eviction() {
+		// Room for 4 sounds of 7000 bytes, each under a quarter of the budget
+		PCMCacheMan.setBudget(30000);
+		for (uint i = 0; i < 4; ++i)
+			delete PCMCacheMan.insert(key(i), makeSourceStream(i, 3500), DisposeAfterUse::YES);
+
+		// Using the first sound makes the second one the least recently used
+		delete PCMCacheMan.find(key(0));
+		delete PCMCacheMan.insert(key(4), makeSourceStream(4, 3500), DisposeAfterUse::YES);
+
+		Audio::PCMCache::Stats stats = PCMCacheMan.getStats();
+		TS_ASSERT_EQUALS(stats.entries, 4u);
+		TS_ASSERT_EQUALS(stats.size, 28000u);
+		TS_ASSERT_EQUALS(stats.evictions, 1u);
+
+		Audio::SeekableAudioStream *stream = PCMCacheMan.find(key(1));
+		TS_ASSERT(!stream);
+		stream = PCMCacheMan.find(key(0));
+		TS_ASSERT(compare(stream, 0, 3500));
+		delete stream;
+		stream = PCMCacheMan.find(key(4));
+		TS_ASSERT(compare(stream, 4, 3500));
+		delete stream;
+
+		// Shrinking the budget keeps the most recently used sounds
+		PCMCacheMan.setBudget(15000);
+		stats = PCMCacheMan.getStats();
+		TS_ASSERT_EQUALS(stats.entries, 2u);
+		TS_ASSERT_EQUALS(stats.evictions, 3u);
+		stream = PCMCacheMan.find(key(0));
+		TS_ASSERT(stream);
+		delete stream;
+	}
+
+	void test_too_large() {
+		PCMCacheMan.setBudget(8000);
+
+		// The stream is handed back untouched
+		Audio::SeekableAudioStream *source = makeSourceStream(7, 5000);
+		TS_ASSERT(!PCMCacheMan.insert(key(0), source, DisposeAfterUse::YES));
+		TS_ASSERT(compare(source, 7, 5000));
+		TS_ASSERT_EQUALS(PCMCacheMan.getStats().entries, 0u);
+
+		TS_ASSERT(source->rewind());
+		Audio::SeekableAudioStream *stream = PCMCacheMan.cacheStream(key(0), source);
+		TS_ASSERT_EQUALS(stream, source);
+		delete stream;
+
+		TS_ASSERT(!PCMCacheMan.cacheStream(key(0), nullptr));
+	}
+};
@@ -0,0 +1,164 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite {
+	// Stream handing out the given samples
+	class SampleStream : public Audio::AudioStream {
+	public:
+		SampleStream(const int16 *samples, int count, int rate, bool stereo) :
+			_samples(samples), _count(count), _pos(0), _rate(rate), _stereo(stereo) {}
+
+		int readBuffer(int16 *buffer, const int numSamples) override {
+			const int len = MIN(numSamples, _count - _pos);
+			memcpy(buffer, _samples + _pos, len * sizeof(int16));
+			_pos += len;
+			return len;
+		}
+
+		bool isStereo() const override { return _stereo; }
+		int getRate() const override { return _rate; }
+		bool endOfData() const override { return _pos >= _count; }
+
+	private:
+		const int16 *_samples;
+		const int _count;
+		int _pos;
+		const int _rate;
+		const bool _stereo;
+	};
+
+	static int16 *createNoise(int count, uint32 seed) {
+		int16 *samples = new int16[count];
+		for (int i = 0; i < count; ++i) {
+			seed = seed * 1103515245 + 12345;
+			// Include the extremes to exercise the clamping
+			samples[i] = (i % 37 == 0) ? -32768 : (i % 41 == 0) ? 32767 : (int16)(seed >> 16);
+		}
+		return samples;
+	}
+
+	static void mixReference(int16 *obuf, int16 out0, int16 out1, bool reverseStereo, int volL, int volR) {
+		Audio::clampedAdd(obuf[reverseStereo    ], (out0 * volL) / Audio::Mixer::kMaxMixerVolume);
+		Audio::clampedAdd(obuf[reverseStereo ^ 1], (out1 * volR) / Audio::Mixer::kMaxMixerVolume);
+	}
+
+	// Straightforward per-frame implementation of the three converters
+	static int convertReference(const int16 *in, int inFrames, int inRate, int outRate, bool stereo, bool reverseStereo,
+	                            int16 *obuf, int outFrames, int volL, int volR) {
+		const int channels = stereo ? 2 : 1;
+		int pos = 0;
+		int out = 0;
+
+		if (inRate == outRate) {
+			for (; out < outFrames && pos < inFrames; ++out, ++pos)
+				mixReference(obuf + out * 2, in[pos * channels], in[pos * channels + channels - 1], reverseStereo, volL, volR);
+		} else if (inRate % outRate == 0) {
+			// Frames are counted as read before the output takes them
+			long opos = 1;
+			int counted = 0;
+			for (; out < outFrames; ++out) {
+				do {
+					if (counted >= inFrames)
+						return out;
+					counted++;
+					opos--;
+					if (opos >= 0)
+						pos++;
+				} while (opos >= 0);
+				const int16 *frame = in + pos * channels;
+				pos++;
+				mixReference(obuf + out * 2, frame[0], frame[channels - 1], reverseStereo, volL, volR);
+				opos += inRate / outRate;
+			}
+		} else {
+			const long one = 1 << 15;
+			long opos = one;
+			const long inc = ((long)inRate << 15) / outRate;
+			int last0 = 0, last1 = 0, cur0 = 0, cur1 = 0;
+			for (; out < outFrames; ++out) {
+				while (opos >= one) {
+					if (pos >= inFrames)
+						return out;
+					last0 = cur0;
+					last1 = cur1;
+					cur0 = in[pos * channels];
+					cur1 = in[pos * channels + channels - 1];
+					pos++;
+					opos -= one;
+				}
+				const int16 out0 = (int16)(last0 + (((cur0 - last0) * opos + (one >> 1)) >> 15));
+				const int16 out1 = (int16)(last1 + (((cur1 - last1) * opos + (one >> 1)) >> 15));
+				mixReference(obuf + out * 2, out0, out1, reverseStereo, volL, volR);
+				opos += inc;
+			}
+		}
+		return out;
+	}
+
+	void checkConverter(int inRate, int outRate, bool stereo, bool reverseStereo) {
+		const int inFrames = 3000;
+		const int outFrames = 2000;
+		const int channels = stereo ? 2 : 1;
+		int16 *in = createNoise(inFrames * channels, inRate);
+		int16 *mixed = createNoise(outFrames * 2, outRate + 1);
+		int16 *expected = new int16[outFrames * 2];
+		memcpy(expected, mixed, outFrames * 2 * sizeof(int16));
+
+		SampleStream stream(in, inFrames * channels, inRate, stereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, reverseStereo);
+
+		// Convert the data in slices of different sizes
+		int written = 0;
+		const int slices[] = { 1, 7, 300, 999, outFrames };
+		for (int i = 0; i < ARRAYSIZE(slices); ++i) {
+			const int frames = MIN(slices[i], outFrames - written);
+			written += converter->flow(stream, mixed + written * 2, frames, 200, 256);
+		}
+		const int expectedWritten = convertReference(in, inFrames, inRate, outRate, stereo, reverseStereo, expected, outFrames, 200, 256);
+
+		TS_ASSERT_EQUALS(written, expectedWritten);
+		TS_ASSERT_EQUALS(memcmp(mixed, expected, outFrames * 2 * sizeof(int16)), 0);
+
+		delete converter;
+		delete[] expected;
+		delete[] mixed;
+		delete[] in;
+	}
+
+public:
+	void test_copy() {
+		checkConverter(22050, 22050, false, false);
+		checkConverter(22050, 22050, true, false);
+		checkConverter(22050, 22050, true, true);
+	}
+
+	void test_simple() {
+		checkConverter(44100, 22050, false, false);
+		checkConverter(44100, 11025, true, false);
+		checkConverter(44100, 22050, true, true);
+	}
+
+	void test_linear() {
+		checkConverter(11025, 44100, false, false);
+		checkConverter(22050, 48000, true, false);
+		checkConverter(48000, 44100, true, true);
+		checkConverter(8000, 44100, true, false);
+	}
+
+	void test_clamped_add_buffer() {
+		Audio::st_sample_t dst[19], src[19];
+		for (int i = 0; i < 19; ++i) {
+			dst[i] = (i - 9) * 3000;
+			src[i] = (i % 2) ? 20000 : -20000;
+		}
+
+		Audio::clampedAddBuffer(dst, src, 19);
+		for (int i = 0; i < 19; ++i) {
+			const int expected = CLIP<int>((i - 9) * 3000 + ((i % 2) ? 20000 : -20000), -32768, 32767);
+			TS_ASSERT_EQUALS(dst[i], expected);
+		}
+	}
+};
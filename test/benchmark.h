@@ -0,0 +1,40 @@
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include <cxxtest/TestSuite.h>
+
+#include "common/profiler.h"
+#include "common/str.h"
+
+// Helpers shared by the benchmark suites in test/*/benchmark, see test/module.mk
+namespace Benchmark {
+
+// Each measurement is repeated, and only the fastest run is reported
+enum {
+	kRuns = 5
+};
+
+// Pseudo random bytes, the same on every run and machine. Release with free()
+inline byte *createNoise(uint32 size, uint32 seed) {
+	byte *data = (byte *)malloc(size);
+	for (uint32 i = 0; i < size; ++i) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = seed >> 16;
+	}
+	return data;
+}
+
+// Results are printed one per line as "BENCHMARK <name> <value> <unit>/s",
+// so that the output of two runs can be compared by scripts
+inline void report(const char *name, uint64 count, const char *unit, uint64 micros) {
+	const uint64 rate = count * 1000000 / MAX<uint64>(micros, 1);
+	TS_TRACE(Common::String::format("BENCHMARK %s %u %s/s", name, (uint32)MIN<uint64>(rate, 0xFFFFFFFF), unit).c_str());
+}
+
+inline void skip(const char *name, const char *reason) {
+	TS_TRACE(Common::String::format("BENCHMARK %s skipped (%s)", name, reason).c_str());
+}
+
+} // End of namespace Benchmark
+
+#endif
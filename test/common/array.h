@@ -3,6 +3,8 @@
 #include "common/array.h"
 #include "common/noncopyable.h"
 #include "common/str.h"
+#include "common/system.h"
+#include "../null_osystem.h"
 
 class ArrayTestSuite : public CxxTest::TestSuite
 {
@@ -420,8 +422,110 @@ class ArrayTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(array[1], 163);
 	}
 
+	void test_reserve_shrink() {
+		Common::Array<Common::String> array;
+		array.reserve(10);
+		TS_ASSERT_EQUALS(array.capacity(), 10U);
+
+		array.push_back("a");
+		const Common::String *first = &array[0];
+		for (int i = 1; i < 10; ++i)
+			array.push_back("b");
+		// No reallocation happened
+		TS_ASSERT_EQUALS(&array[0], first);
+		TS_ASSERT_EQUALS(array.capacity(), 10U);
+
+		array.resize(3);
+		array.shrink_to_fit();
+		TS_ASSERT_EQUALS(array.capacity(), 3U);
+		TS_ASSERT_EQUALS(array[0], "a");
+		TS_ASSERT_EQUALS(array[2], "b");
+	}
+
+#ifdef USE_CXX11
+	// Counts its copies, to check that moves are used where expected.
+	struct CopyCounter {
+		static int copies;
+		int value;
+
+		CopyCounter(int v = 0) : value(v) {}
+		CopyCounter(int a, int b) : value(a * b) {}
+		CopyCounter(const CopyCounter &other) : value(other.value) { copies++; }
+		CopyCounter(CopyCounter &&other) : value(other.value) { other.value = -1; }
+		CopyCounter &operator=(const CopyCounter &other) { value = other.value; copies++; return *this; }
+		CopyCounter &operator=(CopyCounter &&other) { value = other.value; other.value = -1; return *this; }
+	};
+
+	void test_move() {
+		Common::Array<CopyCounter> array;
+		CopyCounter::copies = 0;
+
+		for (int i = 0; i < 100; ++i)
+			array.push_back(CopyCounter(i));
+		array.emplace_back(3, 4);
+		array.emplace(array.begin() + 1, 7);
+		array.emplace(array.begin(), 2, 3);
+		array.remove_at(50);
+		array.erase(array.begin() + 10);
+		array.reserve(1000);
+		array.shrink_to_fit();
+
+		// Growing, inserting and removing only moved elements around
+		TS_ASSERT_EQUALS(CopyCounter::copies, 0);
+		TS_ASSERT_EQUALS(array.size(), 101U);
+		TS_ASSERT_EQUALS(array[0].value, 6);
+		TS_ASSERT_EQUALS(array[1].value, 0);
+		TS_ASSERT_EQUALS(array[2].value, 7);
+		TS_ASSERT_EQUALS(array[3].value, 1);
+		TS_ASSERT_EQUALS(array.back().value, 12);
+
+		// Pushing an element of the array itself while reallocating
+		Common::Array<Common::String> strings;
+		strings.push_back("first element, long enough to live on the heap");
+		strings.emplace_back(strings[0]);
+		TS_ASSERT_EQUALS(strings[1], strings[0]);
+
+		Common::String moved("another string long enough to live on the heap");
+		strings.push_back(Common::move(moved));
+		TS_ASSERT(moved.empty());
+		TS_ASSERT_EQUALS(strings[2], "another string long enough to live on the heap");
+	}
+
+	void test_benchmark_strings() {
+		// Reports how long growing arrays of heap allocated strings takes,
+		// without asserting on it as that depends too much on the host.
+		Common::Array<Common::String> source;
+		for (int i = 0; i < 1000; ++i)
+			source.push_back(Common::String::format("a string which does not fit the builtin storage %d", i));
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		const uint32 start = g_system->getMillis();
+#endif
+
+		uint32 count = 0;
+		for (int pass = 0; pass < 200; ++pass) {
+			Common::Array<Common::String> array;
+			for (uint i = 0; i < source.size(); ++i)
+				array.push_back(source[i]);
+			for (uint i = 0; i < 100; ++i)
+				array.insert_at(0, source[i]);
+			count += array.size();
+		}
+		TS_ASSERT_EQUALS(count, 200U * 1100);
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+		TS_TRACE(Common::String::format("Growing string arrays: %u ms", g_system->getMillis() - start).c_str());
+#endif
+	}
+#endif
+
 };
 
+#ifdef USE_CXX11
+int ArrayTestSuite::CopyCounter::copies = 0;
+#endif
+
 struct ListElement {
 	int value;
 	int tag;
@@ -0,0 +1,67 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fft.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class FFTBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kBits = 10,
+		kSetupTransforms = 200,
+		kTransforms = 20000
+	};
+
+	// A pseudo-random signal in [-1, 1]
+	static void fillSignal(Common::Complex *z, int count) {
+		byte *noise = Benchmark::createNoise(count * 2 * sizeof(uint16), 42);
+		const uint16 *samples = (const uint16 *)noise;
+		for (int i = 0; i < count; i++) {
+			z[i].re = (float)samples[2 * i] / 32768.0f - 1.0f;
+			z[i].im = (float)samples[2 * i + 1] / 32768.0f - 1.0f;
+		}
+		free(noise);
+	}
+
+	static void measure(const char *name, bool setup, int transforms) {
+		const int n = 1 << kBits;
+		Common::Complex *z = new Common::Complex[n];
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			fillSignal(z, n);
+			Common::FFT *shared = setup ? nullptr : new Common::FFT(kBits, 0);
+
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < transforms; i++) {
+				Common::FFT *fft = setup ? new Common::FFT(kBits, 0) : shared;
+				fft->permute(z);
+				fft->calc(z);
+				if (setup)
+					delete fft;
+				// Keep the values in range
+				for (int j = 0; j < n; j++) {
+					z[j].re /= n;
+					z[j].im /= n;
+				}
+			}
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+
+			delete shared;
+		}
+		Benchmark::report(name, transforms, "transforms", best);
+
+		delete[] z;
+	}
+
+public:
+	void test_fft() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measure("fft.1024.setup", true, kSetupTransforms);
+		measure("fft.1024", false, kTransforms);
+#endif
+	}
+};
@@ -0,0 +1,107 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class FlatHashMapBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kKeys = 50000,
+		kLookupPasses = 10
+	};
+
+	enum Mode {
+		kInsert,
+		kLookup,
+		kErase
+	};
+
+	// Keeps the compiler from optimizing the measured lookups away
+	static uint _sink;
+
+	// Resource name like keys, as the engines look up most often
+	static void createKeys(Common::Array<Common::String> &keys) {
+		uint32 seed = 42;
+		for (uint i = 0; i < kKeys; ++i) {
+			seed = seed * 1103515245 + 12345;
+			keys.push_back(Common::String::format("resource_%u.%u", (seed >> 8) & 0xFFFFFF, i));
+		}
+	}
+
+	template<class Map>
+	static void measure(const char *name, const Common::Array<Common::String> &keys, Mode mode) {
+		uint64 best = 0;
+		uint64 operations = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			Map map;
+			uint sum = 0;
+			uint64 start = Common::Profiler::getMicros();
+			for (uint i = 0; i < keys.size(); ++i)
+				map[keys[i]] = i;
+			operations = keys.size();
+
+			if (mode == kLookup) {
+				start = Common::Profiler::getMicros();
+				for (uint pass = 0; pass < kLookupPasses; ++pass) {
+					for (uint i = 0; i < keys.size(); ++i)
+						sum += map.getValOrDefault(keys[i]);
+				}
+				operations = (uint64)keys.size() * kLookupPasses;
+			} else if (mode == kErase) {
+				start = Common::Profiler::getMicros();
+				for (uint i = 0; i < keys.size(); i += 2)
+					map.erase(keys[i]);
+				operations = keys.size() / 2;
+			}
+
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+			_sink += sum;
+		}
+		Benchmark::report(name, operations, "operations", best);
+	}
+
+	typedef Common::HashMap<Common::String, uint> StringMap;
+	typedef Common::FlatHashMap<Common::String, uint> FlatStringMap;
+
+public:
+	void test_insert() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<Common::String> keys;
+		createKeys(keys);
+		measure<StringMap>("hashmap.insert", keys, kInsert);
+		measure<FlatStringMap>("flathashmap.insert", keys, kInsert);
+#endif
+	}
+
+	void test_lookup() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<Common::String> keys;
+		createKeys(keys);
+		measure<StringMap>("hashmap.lookup", keys, kLookup);
+		measure<FlatStringMap>("flathashmap.lookup", keys, kLookup);
+#endif
+	}
+
+	void test_erase() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<Common::String> keys;
+		createKeys(keys);
+		measure<StringMap>("hashmap.erase", keys, kErase);
+		measure<FlatStringMap>("flathashmap.erase", keys, kErase);
+#endif
+	}
+};
+
+uint FlatHashMapBenchmarkSuite::_sink = 0;
@@ -255,4 +255,49 @@ public:
 		tmpl_align_16<Common::MemoryReadStream, Common::BitStream16BELSB>();
 		tmpl_align_16<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
 	}
+
+private:
+	template<class MS, class BS>
+	void tmpl_get_bits_fast() {
+		byte contents[] = { 'a', 'b' };
+
+		MS ms(contents, sizeof(contents));
+
+		BS bs(ms);
+		TS_ASSERT_EQUALS(bs.getBitsFast(3), 3u);
+		TS_ASSERT_EQUALS(bs.peekBitsFast(8), 11u);
+		TS_ASSERT_EQUALS(bs.pos(), 3u);
+		bs.skipFast(8);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		TS_ASSERT_EQUALS(bs.getBitsFast(5), 2u);
+		TS_ASSERT_EQUALS(bs.pos(), 16u);
+		TS_ASSERT(!ms.eos());
+	}
+public:
+	void test_get_bits_fast() {
+		tmpl_get_bits_fast<Common::MemoryReadStream, Common::BitStream8MSB>();
+		tmpl_get_bits_fast<Common::BitStreamMemoryStream, Common::BitStreamMemory8MSB>();
+	}
+
+private:
+	template<class MS, class BS>
+	void tmpl_peek_past_end_32() {
+		byte contents[] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' };
+
+		MS ms(contents, sizeof(contents));
+
+		BS bs(ms);
+		TS_ASSERT_EQUALS(bs.peekBits(32), 0x61626364u);
+		bs.skip(40);
+		TS_ASSERT_EQUALS(bs.peekBits(32), 0x66676800u);
+		TS_ASSERT_EQUALS(bs.pos(), 40u);
+		TS_ASSERT(!bs.eos());
+		bs.skip(24);
+		TS_ASSERT(bs.eos());
+	}
+public:
+	void test_peek_past_end_32() {
+		tmpl_peek_past_end_32<Common::MemoryReadStream, Common::BitStream32BEMSB>();
+		tmpl_peek_past_end_32<Common::BitStreamMemoryStream, Common::BitStreamMemory32BEMSB>();
+	}
 };
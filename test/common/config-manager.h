@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "../null_osystem.h"
+
+class ConfigManagerTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_key_handles() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		static const Common::ConfigManager::Key kMusicVolume("music_volume");
+
+		ConfMan.registerDefault("music_volume", 192);
+		TS_ASSERT(!ConfMan.hasKey(kMusicVolume));
+		TS_ASSERT_EQUALS(ConfMan.getInt(kMusicVolume), 192);
+
+		ConfMan.set("music_volume", "100", Common::ConfigManager::kApplicationDomain);
+		TS_ASSERT(ConfMan.hasKey(kMusicVolume));
+		TS_ASSERT_EQUALS(ConfMan.getInt(kMusicVolume), 100);
+
+		// The active game domain takes precedence
+		ConfMan.addGameDomain("testgame");
+		ConfMan.set("gameid", "test", "testgame");
+		ConfMan.set("music_volume", "50", "testgame");
+		TS_ASSERT_EQUALS(ConfMan.getInt(kMusicVolume), 100);
+		ConfMan.setActiveDomain("testgame");
+		TS_ASSERT_EQUALS(ConfMan.get(kMusicVolume), "50");
+
+		// Values changed in place are seen, as are removed domains
+		ConfMan.getDomain("testgame")->getVal("music_volume") = "60";
+		TS_ASSERT_EQUALS(ConfMan.getInt(kMusicVolume), 60);
+		ConfMan.removeGameDomain("testgame");
+		TS_ASSERT_EQUALS(ConfMan.getInt(kMusicVolume), 100);
+
+		Common::ConfigManager::destroy();
+#endif
+	}
+
+	void test_flush() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Common::String filename = "configmanager-test.ini";
+		ConfMan.loadConfigFile(filename);
+
+		ConfMan.set("language", "en", Common::ConfigManager::kApplicationDomain);
+		ConfMan.addGameDomain("game1");
+		ConfMan.set("gameid", "one", "game1");
+		ConfMan.addGameDomain("game2");
+		ConfMan.set("gameid", "two", "game2");
+		ConfMan.flushToDisk();
+
+		// Only game2 changes, game1 is written from the previous flush
+		ConfMan.set("path", "/games/two", "game2");
+		ConfMan.flushToDisk();
+
+		Common::File file;
+		TS_ASSERT(file.open(Common::FSNode(filename)));
+		Common::String contents;
+		while (!file.eos())
+			contents += file.readLine() + "\n";
+		file.close();
+
+		TS_ASSERT(contents.hasPrefix("[scummvm]\nlanguage=en\n\n[game1]\ngameid=one\n\n[game2]\n"));
+		TS_ASSERT(contents.contains("\ngameid=two\n"));
+		TS_ASSERT(contents.contains("\npath=/games/two\n"));
+
+		// No temporary file is left behind
+		TS_ASSERT(!Common::FSNode(filename + ".new").exists());
+
+		Common::ConfigManager::destroy();
+#endif
+	}
+};
@@ -0,0 +1,75 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/coroutines.h"
+#include "../null_osystem.h"
+
+struct CoroutineTestState {
+	int count;
+	bool waited;
+};
+
+static void coroutineCounter(CORO_PARAM, const void *param) {
+	CoroutineTestState *state = *(CoroutineTestState * const *)param;
+
+	CORO_BEGIN_CONTEXT;
+		int i;
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	for (_ctx->i = 0; _ctx->i < 3; _ctx->i++) {
+		state->count++;
+		CORO_SLEEP(1);
+	}
+
+	CORO_END_CODE;
+}
+
+static void coroutineWaiter(CORO_PARAM, const void *param) {
+	CoroutineTestState *state = *(CoroutineTestState * const *)param;
+
+	CORO_BEGIN_CONTEXT;
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	CORO_INVOKE_ARGS(CoroScheduler.waitForSingleObject, (CORO_SUBCTX, 1, CORO_INFINITE));
+	state->waited = state->count == 3;
+
+	CORO_END_CODE;
+}
+
+class CoroutineTestSuite : public CxxTest::TestSuite {
+public:
+	void test_wait_for_process() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const uint liveContexts = Common::CoroBaseContext::getLiveCount();
+
+		CoroutineTestState state = { 0, false };
+		CoroutineTestState *statePtr = &state;
+		CoroScheduler.createProcess(1, coroutineCounter, &statePtr, sizeof(statePtr));
+		CoroScheduler.createProcess(2, coroutineWaiter, &statePtr, sizeof(statePtr));
+
+		// The counter and the waiter with its waiting subcontext
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(state.count, 1);
+		TS_ASSERT_EQUALS(Common::CoroBaseContext::getLiveCount(), liveContexts + 3);
+		TS_ASSERT_EQUALS(CoroScheduler.getLastTickAllocations(), 3U);
+
+		// Sleeping contexts are kept
+		CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(state.count, 2);
+		TS_ASSERT_EQUALS(CoroScheduler.getLastTickAllocations(), 0U);
+
+		for (int i = 0; i < 3; i++)
+			CoroScheduler.schedule();
+		TS_ASSERT_EQUALS(state.count, 3);
+		TS_ASSERT(state.waited);
+		TS_ASSERT_EQUALS(Common::CoroBaseContext::getLiveCount(), liveContexts);
+
+		Common::CoroutineScheduler::destroy();
+#endif
+	}
+};
@@ -0,0 +1,40 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/dcl.h"
+#include "common/memstream.h"
+
+static const char dclText[] = "Hello, Hello, Hello! The DCL decompressor, the DCL decompressor: aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.";
+
+class DCLTestSuite : public CxxTest::TestSuite {
+	static void checkDecompression(const byte *compressed, uint32 compressedSize) {
+		const uint32 size = sizeof(dclText) - 1;
+		byte output[sizeof(dclText)];
+		Common::MemoryReadStream stream(compressed, compressedSize);
+		TS_ASSERT(Common::decompressDCL(&stream, output, compressedSize, size));
+		TS_ASSERT_EQUALS(memcmp(output, dclText, size), 0);
+	}
+
+	public:
+	void test_binary_mode() {
+		// Literals as raw bytes, back-references overlapping their source
+		static const byte compressed[] = {
+			0x00, 0x04, 0x90, 0x94, 0x61, 0xc3, 0xe6, 0x0d, 0x0b, 0x90, 0x98, 0x4d,
+			0x08, 0x10, 0x54, 0xd0, 0x94, 0x01, 0x41, 0x64, 0x08, 0x13, 0x10, 0x64,
+			0xca, 0x8c, 0x79, 0xd3, 0x06, 0x8e, 0x9c, 0x32, 0x73, 0xe6, 0xbc, 0x91,
+			0xc3, 0x02, 0x04, 0x1d, 0xb4, 0x48, 0x5d, 0x74, 0x80, 0x08, 0x13, 0x26,
+			0x2c, 0xc4, 0x07, 0x2e, 0x01, 0xff
+		};
+		checkDecompression(compressed, sizeof(compressed));
+	}
+
+	void test_ascii_mode() {
+		// Literals through the ASCII Huffman tree
+		static const byte compressed[] = {
+			0x01, 0x04, 0x50, 0x6c, 0xd3, 0xd4, 0xf1, 0x7d, 0xcc, 0x06, 0x4a, 0xcf,
+			0xa2, 0xd8, 0x5e, 0x28, 0xe2, 0x7b, 0xba, 0xcd, 0xd0, 0xc9, 0x24, 0xcd,
+			0x56, 0x55, 0x5d, 0x5b, 0x1f, 0x25, 0x77, 0x25, 0xbb, 0xa0, 0x79, 0x27,
+			0xe4, 0x07, 0xbc, 0x80, 0x7f
+		};
+		checkDecompression(compressed, sizeof(compressed));
+	}
+};
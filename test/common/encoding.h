@@ -271,4 +271,32 @@ public:
 		result = Common::U32String((const char *) utf8_2, 11, Common::kUtf8).encode(Common::kISO8859_2);
 		TS_ASSERT_EQUALS(memcmp(result.c_str(), iso_8859_2, 8), 0);
 	}
+
+	void test_ascii_runs() {
+		// ASCII runs of all lengths around the sizes converted at once,
+		// before and after a non ASCII character
+		for (uint run = 0; run < 40; ++run) {
+			Common::String utf8;
+			for (uint i = 0; i < run; ++i)
+				utf8 += (char)('a' + i % 26);
+			utf8 += "\xC3\x96";
+			for (uint i = 0; i < run; ++i)
+				utf8 += (char)('A' + i % 26);
+
+			const Common::U32String decoded = utf8.decode(Common::kUtf8);
+			TS_ASSERT_EQUALS(decoded.size(), run * 2 + 1);
+			TS_ASSERT_EQUALS(decoded[run], (Common::u32char_type_t)0xD6);
+			if (run) {
+				TS_ASSERT_EQUALS(decoded[0], (Common::u32char_type_t)'a');
+				TS_ASSERT_EQUALS(decoded[run - 1], (Common::u32char_type_t)('a' + (run - 1) % 26));
+				TS_ASSERT_EQUALS(decoded[run * 2], (Common::u32char_type_t)('A' + (run - 1) % 26));
+			}
+			TS_ASSERT_EQUALS(decoded.encode(Common::kUtf8), utf8);
+
+			const Common::String ascii(utf8.c_str(), run);
+			const Common::U32String decodedASCII = ascii.decode(Common::kUtf8);
+			TS_ASSERT_EQUALS(decodedASCII.size(), run);
+			TS_ASSERT_EQUALS(decodedASCII.encode(Common::kISO8859_1), ascii);
+		}
+	}
 };
@@ -0,0 +1,109 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/cosinetables.h"
+#include "common/fft.h"
+#include "common/rdft.h"
+#include "../null_osystem.h"
+
+class FFTTestSuite : public CxxTest::TestSuite {
+	// A pseudo-random signal in [-1, 1]
+	static void fillSignal(float *data, int count) {
+		uint32 seed = 42;
+		for (int i = 0; i < count; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (float)(seed >> 16) / 32768.0f - 1.0f;
+		}
+	}
+
+	// The straightforward O(n^2) DFT, in double precision
+	static void referenceDFT(const Common::Complex *in, double *outRe, double *outIm, int n, int inverse) {
+		const double sign = inverse ? 1.0 : -1.0;
+		for (int k = 0; k < n; k++) {
+			outRe[k] = outIm[k] = 0.0;
+			for (int j = 0; j < n; j++) {
+				const double angle = sign * 2.0 * M_PI * (double)((j * k) % n) / n;
+				outRe[k] += in[j].re * cos(angle) - in[j].im * sin(angle);
+				outIm[k] += in[j].re * sin(angle) + in[j].im * cos(angle);
+			}
+		}
+	}
+
+public:
+	void test_fft() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		for (int bits = 2; bits <= 10; bits++) {
+			const int n = 1 << bits;
+			Common::Complex *in = new Common::Complex[n];
+			Common::Complex *z = new Common::Complex[n];
+			double *re = new double[n];
+			double *im = new double[n];
+			fillSignal(&in[0].re, 2 * n);
+
+			for (int inverse = 0; inverse <= 1; inverse++) {
+				Common::FFT fft(bits, inverse);
+				memcpy(z, in, n * sizeof(Common::Complex));
+				fft.permute(z);
+				fft.calc(z);
+
+				referenceDFT(in, re, im, n, inverse);
+				for (int k = 0; k < n; k++) {
+					TS_ASSERT_DELTA(z[k].re, re[k], 1e-4 * n);
+					TS_ASSERT_DELTA(z[k].im, im[k], 1e-4 * n);
+				}
+			}
+
+			delete[] im;
+			delete[] re;
+			delete[] z;
+			delete[] in;
+		}
+#endif
+	}
+
+	void test_rdft() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const int bits = 8;
+		const int n = 1 << bits;
+		float data[n];
+		Common::Complex in[n];
+		double re[n], im[n];
+		fillSignal(data, n);
+		for (int i = 0; i < n; i++) {
+			in[i].re = data[i];
+			in[i].im = 0.0f;
+		}
+
+		Common::RDFT rdft(bits, Common::RDFT::DFT_R2C);
+		rdft.calc(data);
+
+		// The first half of the DFT, with the real F[n/2] packed into the first value
+		referenceDFT(in, re, im, n, 0);
+		TS_ASSERT_DELTA(data[0], re[0], 1e-2);
+		TS_ASSERT_DELTA(data[1], re[n / 2], 1e-2);
+		for (int k = 1; k < n / 2; k++) {
+			TS_ASSERT_DELTA(data[2 * k], re[k], 1e-2);
+			TS_ASSERT_DELTA(data[2 * k + 1], im[k], 1e-2);
+		}
+#endif
+	}
+
+	void test_shared_tables() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Common::CosineTable *table = Common::CosineTable::getShared(64);
+		TS_ASSERT_EQUALS(Common::CosineTable::getShared(64), table);
+		const Common::CosineTable *other = Common::CosineTable::getShared(128);
+		TS_ASSERT_DIFFERS(other, table);
+		TS_ASSERT_DELTA(table->at(8), cos(M_PI / 4), 1e-6);
+
+		Common::CosineTable::releaseShared(table);
+		Common::CosineTable::releaseShared(table);
+		Common::CosineTable::releaseShared(other);
+#endif
+	}
+};
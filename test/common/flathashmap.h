@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	// Small deterministic generator, so that the tests do not depend on
+	// OSystem for random numbers.
+	static uint nextRandom(uint &seed) {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 8) & 0xFFFFFF;
+	}
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(0));
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		container.erase(2);
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(4));
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container.setVal(2, 45);
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef[1], -1);
+		TS_ASSERT_EQUALS(containerRef.getVal(2), 45);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+
+		int out = 0;
+		TS_ASSERT(containerRef.tryGetVal(2, out));
+		TS_ASSERT_EQUALS(out, 45);
+		TS_ASSERT(!containerRef.tryGetVal(3, out));
+	}
+
+	void test_collision() {
+		// All of these keys share the same home slot, so they form a single
+		// cluster which has to be shifted around on erasure.
+		Common::FlatHashMap<int, int> h;
+		h[5] = 1;
+		h[32+5] = 2;
+		h[64+5] = 3;
+		h[128+5] = 4;
+		h[6] = 5;
+		h.erase(32+5);
+		TS_ASSERT_EQUALS(h[5], 1);
+		TS_ASSERT_EQUALS(h[64+5], 3);
+		TS_ASSERT_EQUALS(h[128+5], 4);
+		TS_ASSERT_EQUALS(h[6], 5);
+		h.erase(5);
+		TS_ASSERT(!h.contains(5));
+		TS_ASSERT(!h.contains(32+5));
+		TS_ASSERT_EQUALS(h.size(), 3U);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 5; ++i)
+			container[i] = i * 10;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = container.begin(); j != container.end(); ++j) {
+			int key = j->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			TS_ASSERT_EQUALS(j->_value, key * 10);
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<Common::String, int> map1, map2;
+		map1["a"] = 1;
+		map1["b"] = 2;
+		map2 = map1;
+		map1["a"] = 3;
+		TS_ASSERT_EQUALS(map2["a"], 1);
+		TS_ASSERT_EQUALS(map2["b"], 2);
+
+		Common::FlatHashMap<Common::String, int> map3(map1);
+		TS_ASSERT_EQUALS(map3["a"], 3);
+	}
+
+	void test_against_hashmap() {
+		// Run the same random sequence of operations on both maps and
+		// check that they agree with each other.
+		Common::HashMap<uint, uint> reference;
+		Common::FlatHashMap<uint, uint> flat;
+		uint seed = 1;
+
+		for (uint i = 0; i < 20000; ++i) {
+			uint key = nextRandom(seed) % 2048;
+			if (nextRandom(seed) % 3 == 0) {
+				reference.erase(key);
+				flat.erase(key);
+			} else {
+				reference[key] = i;
+				flat[key] = i;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (Common::HashMap<uint, uint>::const_iterator i = reference.begin(); i != reference.end(); ++i) {
+			TS_ASSERT(flat.contains(i->_key));
+			TS_ASSERT_EQUALS(flat.getVal(i->_key), i->_value);
+		}
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = flat.begin(); i != flat.end(); ++i) {
+			TS_ASSERT(reference.contains(i->_key));
+			count++;
+		}
+		TS_ASSERT_EQUALS(count, reference.size());
+	}
+};
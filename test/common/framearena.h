@@ -0,0 +1,57 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/framearena.h"
+
+class FrameArenaTestSuite : public CxxTest::TestSuite {
+	struct Item {
+		int x, y;
+		Item(int x_, int y_) : x(x_), y(y_) {}
+	};
+
+	public:
+	void test_allocate() {
+		Common::FrameArena arena(64);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0U);
+
+		byte *a = (byte *)arena.allocate(3, 1);
+		uint32 *b = (uint32 *)arena.allocate(sizeof(uint32), 4);
+		TS_ASSERT_EQUALS((uintptr)b % 4, 0U);
+		TS_ASSERT(a + 3 <= (byte *)b);
+		*b = 0x12345678;
+
+		// Allocations bigger than a block get their own block
+		byte *big = (byte *)arena.allocate(200, 16);
+		TS_ASSERT_EQUALS((uintptr)big % 16, 0U);
+		memset(big, 0xAA, 200);
+		TS_ASSERT_EQUALS(*b, 0x12345678U);
+		TS_ASSERT(arena.getCapacity() >= 264U);
+	}
+
+	void test_reset() {
+		Common::FrameArena arena(64);
+		for (int i = 0; i < 10; ++i)
+			arena.allocate(32);
+		const size_t capacity = arena.getCapacity();
+		TS_ASSERT(arena.getUsed() >= 320U);
+
+		// Once reset, the same allocations fit without growing
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsed(), 0U);
+		for (int i = 0; i < 10; ++i)
+			arena.allocate(32);
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+	}
+
+	void test_objects() {
+		Common::FrameArena arena;
+		Item *item = new (arena) Item(1, 2);
+		TS_ASSERT_EQUALS(item->x, 1);
+		TS_ASSERT_EQUALS(item->y, 2);
+
+		Item *items = arena.allocArray<Item>(4);
+		TS_ASSERT_EQUALS((uintptr)items % alignof(Item), 0U);
+		for (int i = 0; i < 4; ++i)
+			new (&items[i]) Item(i, -i);
+		TS_ASSERT_EQUALS(items[3].y, -3);
+	}
+};
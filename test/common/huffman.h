@@ -2,6 +2,9 @@
 #include "common/huffman.h"
 #include "common/bitstream.h"
 #include "common/memstream.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "../null_osystem.h"
 
 /**
 * A test suite for the Huffman decoder in common/huffman.h
@@ -94,4 +97,125 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	/**
+	 * Build a complete canonical code of random lengths, with a chain of
+	 * codes long enough to go past the second-level tables.
+	 */
+	static void buildRandomCode(Common::Array<uint8> &lengths, Common::Array<uint32> &codes) {
+		lengths.clear();
+		lengths.push_back(0);
+
+		uint32 seed = 12345;
+		for (int i = 0; i < 400; i++) {
+			seed = seed * 1103515245 + 12345;
+			uint32 leaf = (seed >> 16) % lengths.size();
+			if (lengths[leaf] >= 16)
+				continue;
+			lengths[leaf]++;
+			lengths.push_back(lengths[leaf]);
+		}
+
+		// Keep splitting the last leaf
+		while (lengths.back() < 24) {
+			lengths.back()++;
+			lengths.push_back(lengths.back());
+		}
+
+		codes.resize(lengths.size());
+		uint32 code = 0;
+		uint8 prevLength = 0;
+		for (uint8 length = 1; length <= 32; length++) {
+			for (uint i = 0; i < lengths.size(); i++) {
+				if (lengths[i] != length)
+					continue;
+				code <<= length - prevLength;
+				prevLength = length;
+				codes[i] = code++;
+			}
+		}
+	}
+
+	template<class BITSTREAM>
+	void checkRandomCode() {
+		Common::Array<uint8> lengths;
+		Common::Array<uint32> codes;
+		buildRandomCode(lengths, codes);
+
+		// LSB2MSB streams expect the codes with their first bit in bit 0
+		Common::Array<uint32> streamCodes(codes);
+		if (!BITSTREAM::isMSB2LSB())
+			for (uint i = 0; i < codes.size(); i++)
+				streamCodes[i] = Common::REVERSEBITS(codes[i]) >> (32 - lengths[i]);
+
+		Common::Huffman<BITSTREAM> h(0, codes.size(), streamCodes.begin(), lengths.begin());
+
+		byte input[4096];
+		memset(input, 0, sizeof(input));
+		Common::Array<uint32> expected;
+		uint32 pos = 0;
+		for (uint n = 0; ; n++) {
+			const uint32 symbol = (n * 7) % codes.size();
+			if (pos + lengths[symbol] > sizeof(input) * 8)
+				break;
+
+			for (int bit = lengths[symbol] - 1; bit >= 0; bit--, pos++)
+				if ((codes[symbol] >> bit) & 1)
+					input[pos >> 3] |= BITSTREAM::isMSB2LSB() ? 0x80 >> (pos & 7) : 1 << (pos & 7);
+			expected.push_back(symbol);
+		}
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		BITSTREAM bs(ms);
+
+		for (uint i = 0; i < expected.size(); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+	}
+
+	void test_long_codes() {
+		checkRandomCode<Common::BitStream8MSB>();
+		checkRandomCode<Common::BitStream8LSB>();
+		checkRandomCode<Common::BitStream32BEMSB>();
+		checkRandomCode<Common::BitStream32LELSB>();
+	}
+
+	void test_benchmark() {
+		// Reports how long decoding takes, without asserting on it as that
+		// depends too much on the host.
+		Common::Array<uint8> lengths;
+		Common::Array<uint32> codes;
+		buildRandomCode(lengths, codes);
+
+		Common::Huffman<Common::BitStreamMemory32LEMSB> h(0, codes.size(), codes.begin(), lengths.begin());
+
+		// The code is complete, any data can be decoded
+		Common::Array<byte> input;
+		input.resize(1 << 16);
+		uint32 seed = 1;
+		for (uint i = 0; i < input.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			input[i] = seed >> 24;
+		}
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		const uint32 start = g_system->getMillis();
+#endif
+
+		uint32 count = 0, sum = 0;
+		for (int pass = 0; pass < 20; pass++) {
+			Common::BitStreamMemoryStream ms(input.begin(), input.size());
+			Common::BitStreamMemory32LEMSB bs(ms);
+			while (bs.pos() + 32 <= bs.size()) {
+				sum += h.getSymbol(bs);
+				count++;
+			}
+		}
+		TS_ASSERT_LESS_THAN(0U, count);
+		TS_ASSERT_LESS_THAN(0U, sum);
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+		TS_TRACE(Common::String::format("Decoding %u Huffman symbols: %u ms", count, g_system->getMillis() - start).c_str());
+#endif
+	}
 };
@@ -0,0 +1,45 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/interned-str.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_interning() {
+		Common::StringPool pool;
+		Common::InternedString a("Hello", pool), b(Common::String("Hello"), pool), c("hello", pool);
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT(a.equalsIgnoreCase(c));
+		TS_ASSERT_EQUALS(&a.str(), &b.str());
+		TS_ASSERT_EQUALS(a.str(), "Hello");
+		TS_ASSERT_EQUALS(pool.size(), 2U);
+
+		TS_ASSERT_EQUALS(a.hash(), Common::String("Hello").hash());
+		TS_ASSERT_EQUALS(a.hashIgnoreCase(), Common::hashit_lower("Hello"));
+		TS_ASSERT_EQUALS(a.hashIgnoreCase(), c.hashIgnoreCase());
+
+		// The empty string is the same in every pool
+		Common::StringPool otherPool;
+		TS_ASSERT(Common::InternedString("", pool) == Common::InternedString("", otherPool));
+		TS_ASSERT(Common::InternedString() == Common::InternedString("", pool));
+		TS_ASSERT(Common::InternedString("Hello", otherPool) != a);
+	}
+
+	void test_hashmap() {
+		Common::StringPool pool;
+		Common::HashMap<Common::InternedString, int> sensitive;
+		Common::HashMap<Common::InternedString, int, Common::InternedString_IgnoreCase_Hash, Common::InternedString_IgnoreCase_EqualTo> insensitive;
+
+		sensitive[Common::InternedString("Room", pool)] = 1;
+		sensitive[Common::InternedString("room", pool)] = 2;
+		insensitive[Common::InternedString("Room", pool)] = 1;
+		insensitive[Common::InternedString("ROOM", pool)] = 2;
+
+		TS_ASSERT_EQUALS(sensitive.size(), 2U);
+		TS_ASSERT_EQUALS(sensitive[Common::InternedString("Room", pool)], 1);
+		TS_ASSERT_EQUALS(insensitive.size(), 1U);
+		TS_ASSERT_EQUALS(insensitive[Common::InternedString("room", pool)], 2);
+		TS_ASSERT(!sensitive.contains(Common::InternedString("ROOM", pool)));
+	}
+};
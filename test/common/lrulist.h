@@ -0,0 +1,52 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/lrulist.h"
+
+class LRUListTestSuite : public CxxTest::TestSuite {
+public:
+	void test_order() {
+		Common::LRUList<int> list;
+		TS_ASSERT(list.empty());
+
+		list.add(1);
+		list.add(2);
+		list.add(3);
+		TS_ASSERT_EQUALS(list.size(), 3U);
+		TS_ASSERT_EQUALS(*list.begin(), 3);
+		TS_ASSERT_EQUALS(list.leastRecent(), 1);
+
+		// Using the least recently used entry makes 2 the next one to go
+		Common::LRUList<int>::iterator i = list.begin();
+		++i;
+		++i;
+		i = list.touch(i);
+		TS_ASSERT_EQUALS(*i, 1);
+		TS_ASSERT(i == list.begin());
+		TS_ASSERT_EQUALS(list.size(), 3U);
+		TS_ASSERT_EQUALS(list.leastRecent(), 2);
+
+		list.touch(list.begin());
+		TS_ASSERT_EQUALS(*list.begin(), 1);
+
+		list.removeLeastRecent();
+		TS_ASSERT_EQUALS(list.size(), 2U);
+		TS_ASSERT_EQUALS(list.leastRecent(), 3);
+	}
+
+	void test_erase_clear() {
+		Common::LRUList<int> list;
+		list.add(1);
+		list.add(2);
+		list.add(3);
+
+		Common::LRUList<int>::iterator i = list.begin();
+		i = list.erase(++i);
+		TS_ASSERT_EQUALS(*i, 1);
+		TS_ASSERT_EQUALS(list.size(), 2U);
+
+		list.clear();
+		TS_ASSERT(list.empty());
+		TS_ASSERT_EQUALS(list.size(), 0U);
+		TS_ASSERT(list.begin() == list.end());
+	}
+};
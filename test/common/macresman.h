@@ -0,0 +1,192 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/macresman.h"
+#include "common/memstream.h"
+
+class MacResManagerTestSuite : public CxxTest::TestSuite {
+	struct TestResource {
+		uint32 type;
+		uint16 id;
+		const char *name;
+		const char *data;
+	};
+
+	// Build a MacBinary file with an empty data fork and a resource fork
+	// holding the given resources, grouped by type in order of appearance
+	static Common::SeekableReadStream *buildMacBinary(const TestResource *resources, uint count, bool mapped) {
+		Common::Array<uint32> types;
+		for (uint i = 0; i < count; ++i) {
+			if (Common::find(types.begin(), types.end(), resources[i].type) == types.end())
+				types.push_back(resources[i].type);
+		}
+
+		Common::MemoryWriteStreamDynamic data(DisposeAfterUse::YES);
+		Common::Array<uint32> dataOffsets;
+		for (uint i = 0; i < count; ++i) {
+			dataOffsets.push_back(data.size());
+			data.writeUint32BE(strlen(resources[i].data));
+			data.writeString(resources[i].data);
+		}
+
+		Common::MemoryWriteStreamDynamic names(DisposeAfterUse::YES);
+		Common::MemoryWriteStreamDynamic refs(DisposeAfterUse::YES);
+		Common::MemoryWriteStreamDynamic typeList(DisposeAfterUse::YES);
+		const uint32 typeListSize = 2 + types.size() * 8;
+		typeList.writeUint16BE(types.size() - 1);
+		for (uint t = 0; t < types.size(); ++t) {
+			uint16 items = 0;
+			const uint32 refOffset = typeListSize + refs.size();
+			for (uint i = 0; i < count; ++i) {
+				if (resources[i].type != types[t])
+					continue;
+				refs.writeUint16BE(resources[i].id);
+				if (resources[i].name) {
+					refs.writeUint16BE(names.size());
+					names.writeByte(strlen(resources[i].name));
+					names.writeString(resources[i].name);
+				} else {
+					refs.writeUint16BE(0xFFFF);
+				}
+				refs.writeUint32BE(dataOffsets[i]);
+				refs.writeUint32BE(0);
+				items++;
+			}
+			typeList.writeUint32BE(types[t]);
+			typeList.writeUint16BE(items - 1);
+			typeList.writeUint16BE(refOffset);
+		}
+
+		const uint32 dataOffset = 16;
+		const uint32 mapOffset = dataOffset + data.size();
+		const uint32 mapLength = 30 + typeList.size() + refs.size() + names.size();
+
+		Common::MemoryWriteStreamDynamic fork(DisposeAfterUse::NO);
+		for (uint i = 0; i < MBI_INFOHDR; ++i)
+			fork.writeByte(0);
+		fork.writeUint32BE(dataOffset);
+		fork.writeUint32BE(mapOffset);
+		fork.writeUint32BE(data.size());
+		fork.writeUint32BE(mapLength);
+		fork.write(data.getData(), data.size());
+		for (uint i = 0; i < 22; ++i)
+			fork.writeByte(0);
+		fork.writeUint16BE(0);
+		fork.writeUint16BE(30);
+		fork.writeUint16BE(30 + typeList.size() + refs.size());
+		fork.writeUint16BE(types.size() - 1);
+		fork.write(typeList.getData(), typeList.size());
+		fork.write(refs.getData(), refs.size());
+		fork.write(names.getData(), names.size());
+
+		byte *file = fork.getData();
+		WRITE_BE_UINT32(file + 87, fork.size() - MBI_INFOHDR);
+
+		if (!mapped)
+			return new Common::MemoryReadStream(file, fork.size(), DisposeAfterUse::YES);
+
+		class FileMapping : public Common::MappedReadStream::Mapping {
+		public:
+			FileMapping(byte *data) : _data(data) {}
+			~FileMapping() override { free(_data); }
+		private:
+			byte *_data;
+		};
+		return new Common::MappedReadStream(Common::MappedReadStream::MappingPtr(new FileMapping(file)), file, fork.size());
+	}
+
+	static Common::String readAll(Common::SeekableReadStream *stream) {
+		Common::String result;
+		if (!stream)
+			return "<null>";
+		while (true) {
+			const byte b = stream->readByte();
+			if (stream->eos())
+				break;
+			result += (char)b;
+		}
+		delete stream;
+		return result;
+	}
+
+	static const TestResource *getResources(uint &count) {
+		static const TestResource resources[] = {
+			{ MKTAG('S', 'T', 'R', ' '), 128, "Hello", "hello world" },
+			{ MKTAG('P', 'I', 'C', 'T'), 1000, nullptr, "picture" },
+			{ MKTAG('S', 'T', 'R', ' '), 129, nullptr, "second" },
+			{ MKTAG('P', 'I', 'C', 'T'), 1001, "Splash", "splash screen" },
+			{ MKTAG('S', 'T', 'R', ' '), 130, "splash", "not the picture" }
+		};
+		count = ARRAYSIZE(resources);
+		return resources;
+	}
+
+	public:
+	void test_lookup() {
+		uint count;
+		const TestResource *resources = getResources(count);
+
+		for (int mapped = 0; mapped < 2; ++mapped) {
+			Common::MacResManager resMan;
+			TS_ASSERT(resMan.loadFromMacBinary(*buildMacBinary(resources, count, mapped)));
+
+			for (uint i = 0; i < count; ++i)
+				TS_ASSERT_EQUALS(readAll(resMan.getResource(resources[i].type, resources[i].id)), resources[i].data);
+			TS_ASSERT(!resMan.getResource(MKTAG('S', 'T', 'R', ' '), 1000));
+			TS_ASSERT(!resMan.getResource(MKTAG('s', 'n', 'd', ' '), 128));
+
+			TS_ASSERT_EQUALS(resMan.getResName(MKTAG('P', 'I', 'C', 'T'), 1001), "Splash");
+			TS_ASSERT_EQUALS(resMan.getResName(MKTAG('P', 'I', 'C', 'T'), 1000), "");
+
+			// Name lookups ignore case and take the first match in map order
+			TS_ASSERT_EQUALS(readAll(resMan.getResource("SPLASH")), "not the picture");
+			TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('P', 'I', 'C', 'T'), "splash")), "splash screen");
+			TS_ASSERT(!resMan.getResource("missing"));
+
+			TS_ASSERT_EQUALS(resMan.getResIDArray(MKTAG('S', 'T', 'R', ' ')).size(), 3U);
+			TS_ASSERT_EQUALS(resMan.getResTagArray().size(), 0U);
+
+			// Resources of mapped forks are views into the mapping
+			Common::SeekableReadStream *res = resMan.getResource(MKTAG('P', 'I', 'C', 'T'), 1000);
+			TS_ASSERT_EQUALS(dynamic_cast<Common::MappedReadStream *>(res) != nullptr, mapped != 0);
+			delete res;
+		}
+	}
+
+	void test_cache() {
+		uint count;
+		const TestResource *resources = getResources(count);
+
+		Common::MacResManager resMan;
+		TS_ASSERT(resMan.loadFromMacBinary(*buildMacBinary(resources, count, false)));
+		resMan.setResourceCacheSize(25);
+
+		Common::SeekableReadStream *first = resMan.getResource(MKTAG('S', 'T', 'R', ' '), 128);
+		TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('S', 'T', 'R', ' '), 128)), "hello world");
+		TS_ASSERT_EQUALS(resMan.getCacheStats().hits, 1U);
+		TS_ASSERT_EQUALS(resMan.getCacheStats().misses, 1U);
+		TS_ASSERT_EQUALS(resMan.getCacheStats().size, 11U);
+
+		// "picture" fits, "splash screen" evicts the least recently used entry
+		readAll(resMan.getResource(MKTAG('P', 'I', 'C', 'T'), 1000));
+		readAll(resMan.getResource(MKTAG('S', 'T', 'R', ' '), 128));
+		readAll(resMan.getResource(MKTAG('P', 'I', 'C', 'T'), 1001));
+		TS_ASSERT_EQUALS(resMan.getCacheStats().hits, 2U);
+		TS_ASSERT_EQUALS(resMan.getCacheStats().misses, 3U);
+		TS_ASSERT_EQUALS(resMan.getCacheStats().evictions, 1U);
+		TS_ASSERT_EQUALS(resMan.getCacheStats().size, 24U);
+		readAll(resMan.getResource(MKTAG('S', 'T', 'R', ' '), 128));
+		TS_ASSERT_EQUALS(resMan.getCacheStats().hits, 3U);
+		readAll(resMan.getResource(MKTAG('P', 'I', 'C', 'T'), 1000));
+		TS_ASSERT_EQUALS(resMan.getCacheStats().misses, 4U);
+
+		// Streams stay valid after their entry is evicted
+		resMan.setResourceCacheSize(0);
+		TS_ASSERT_EQUALS(resMan.getCacheStats().size, 0U);
+		TS_ASSERT_EQUALS(readAll(first), "hello world");
+
+		// Resources larger than the budget are not cached
+		resMan.setResourceCacheSize(4);
+		TS_ASSERT_EQUALS(readAll(resMan.getResource(MKTAG('S', 'T', 'R', ' '), 129)), "second");
+		TS_ASSERT_EQUALS(resMan.getCacheStats().size, 0U);
+	}
+};
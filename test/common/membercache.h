@@ -0,0 +1,59 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/membercache.h"
+
+class MemberCacheTestSuite : public CxxTest::TestSuite {
+	static byte *createData(uint32 size, byte value) {
+		byte *data = (byte *)malloc(size);
+		memset(data, value, size);
+		return data;
+	}
+
+	public:
+	void test_hits() {
+		Common::MemberCache cache(1024);
+		TS_ASSERT(!cache.createReadStream("a.dat"));
+
+		delete cache.add("a.dat", createData(100, 1), 100);
+		Common::SeekableReadStream *stream = cache.createReadStream("A.DAT");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 100);
+		TS_ASSERT_EQUALS(stream->readByte(), 1);
+		delete stream;
+
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+		TS_ASSERT_EQUALS(cache.getSize(), 100u);
+	}
+
+	void test_eviction() {
+		Common::MemberCache cache(1024);
+		delete cache.add("a", createData(400, 1), 400);
+		delete cache.add("b", createData(400, 2), 400);
+
+		// Opening a makes b the least recently used member
+		delete cache.createReadStream("a");
+		Common::SeekableReadStream *c = cache.add("c", createData(400, 3), 400);
+
+		TS_ASSERT_EQUALS(cache.getSize(), 800u);
+		Common::SeekableReadStream *a = cache.createReadStream("a");
+		TS_ASSERT(a);
+		TS_ASSERT(!cache.createReadStream("b"));
+		delete a;
+
+		// The streams stay valid once their member is dropped
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT_EQUALS(c->readByte(), 3);
+		delete c;
+	}
+
+	void test_too_big() {
+		Common::MemberCache cache(1024);
+		Common::SeekableReadStream *stream = cache.add("big", createData(2048, 4), 2048);
+		TS_ASSERT_EQUALS(stream->size(), 2048);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.createReadStream("big"));
+		delete stream;
+	}
+};
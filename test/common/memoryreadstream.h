@@ -1,6 +1,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/memstream.h"
+#include "common/substream.h"
 
 class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 	public:
@@ -104,4 +105,85 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_read_arrays() {
+		byte contents[70];
+		for (uint i = 0; i < sizeof(contents); ++i)
+			contents[i] = (byte)(i * 7 + 1);
+
+		// Both the buffer conversion and the generic path of a wrapping
+		// stream must agree with the single value readers
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::SeekableSubReadStream sub(&ms, 0, sizeof(contents));
+		Common::SeekableReadStream *streams[] = { &ms, &sub };
+
+		for (uint s = 0; s < ARRAYSIZE(streams); ++s) {
+			Common::SeekableReadStream &stream = *streams[s];
+			Common::MemoryReadStream ref(contents, sizeof(contents));
+			uint16 words[35];
+			uint32 dwords[17];
+
+			stream.seek(1);
+			ref.seek(1);
+			TS_ASSERT_EQUALS(stream.readUint16LEArray(words, 17), 17U);
+			for (uint i = 0; i < 17; ++i)
+				TS_ASSERT_EQUALS(words[i], ref.readUint16LE());
+			TS_ASSERT_EQUALS(stream.readUint16BEArray(words, 9), 9U);
+			for (uint i = 0; i < 9; ++i)
+				TS_ASSERT_EQUALS(words[i], ref.readUint16BE());
+
+			stream.seek(3);
+			ref.seek(3);
+			TS_ASSERT_EQUALS(stream.readUint32LEArray(dwords, 9), 9U);
+			for (uint i = 0; i < 9; ++i)
+				TS_ASSERT_EQUALS(dwords[i], ref.readUint32LE());
+			TS_ASSERT_EQUALS(stream.readUint32BEArray(dwords, 6), 6U);
+			for (uint i = 0; i < 6; ++i)
+				TS_ASSERT_EQUALS(dwords[i], ref.readUint32BE());
+			TS_ASSERT(!stream.eos());
+
+			// Only complete words are returned at the end of the stream
+			stream.seek(-7, SEEK_END);
+			TS_ASSERT_EQUALS(stream.readUint32BEArray(dwords, 4), 1U);
+			TS_ASSERT_EQUALS(dwords[0], READ_BE_UINT32(contents + sizeof(contents) - 7));
+			TS_ASSERT(stream.eos());
+		}
+	}
+
+	void test_mapped_views() {
+		// Mapping which records whether it has been released
+		class TestMapping : public Common::MappedReadStream::Mapping {
+		public:
+			TestMapping(bool &released) : _released(released) {}
+			~TestMapping() override { _released = true; }
+		private:
+			bool &_released;
+		};
+
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		bool released = false;
+		Common::MappedReadStream::MappingPtr mapping(new TestMapping(released));
+		Common::MappedReadStream *ms = new Common::MappedReadStream(mapping, contents, sizeof(contents));
+		mapping.reset();
+
+		ms->seek(1);
+		Common::SeekableReadStream *view = ms->readStream(3);
+		TS_ASSERT_EQUALS(ms->pos(), 4);
+		TS_ASSERT_EQUALS(view->size(), 3);
+
+		Common::SeekableReadStream *sub = Common::makeSafeSeekableSubReadStream(ms, 5, 7, DisposeAfterUse::YES);
+		TS_ASSERT(!released);
+
+		// Both streams share the memory of the (already deleted) parent
+		TS_ASSERT_EQUALS(view->readByte(), 2);
+		TS_ASSERT_EQUALS(sub->readByte(), 6);
+		TS_ASSERT_EQUALS(sub->readByte(), 7);
+		sub->readByte();
+		TS_ASSERT(sub->eos());
+
+		delete view;
+		TS_ASSERT(!released);
+		delete sub;
+		TS_ASSERT(released);
+	}
 };
@@ -0,0 +1,58 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+#include "common/str.h"
+#include "../null_osystem.h"
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_zones() {
+#if defined(USE_PROFILER) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		Common::Profiler::reset();
+
+		for (int i = 0; i < 3; ++i) {
+			PROFILE_SCOPE("test.outer");
+			PROFILE_SCOPE("test.inner");
+		}
+
+		Common::String summary = Common::Profiler::getSummary();
+		TS_ASSERT(summary.contains("test.outer"));
+		TS_ASSERT(summary.contains("test.inner"));
+
+		Common::MemoryWriteStreamDynamic trace(DisposeAfterUse::YES);
+		TS_ASSERT(Common::Profiler::writeChromeTrace(trace));
+		Common::String json((const char *)trace.getData(), trace.size());
+		TS_ASSERT(json.hasPrefix("{\"traceEvents\":["));
+		TS_ASSERT(json.contains("\"name\":\"test.inner\",\"ph\":\"X\""));
+
+		Common::Profiler::reset();
+		TS_ASSERT(!Common::Profiler::getSummary().contains("test.outer"));
+#endif
+	}
+
+	void test_counters() {
+#if defined(USE_PROFILER) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		Common::Profiler::reset();
+
+		Common::Profiler::addCounter("test.frames");
+		Common::Profiler::addCounter("test.frames", 41);
+		Common::Profiler::addCounter("test.dropped", -2);
+
+		Common::String summary = Common::Profiler::getSummary();
+		TS_ASSERT(summary.contains(Common::String::format("%-32s %12d", "test.frames", 42)));
+		TS_ASSERT(summary.contains(Common::String::format("%-32s %12d", "test.dropped", -2)));
+
+		Common::MemoryWriteStreamDynamic trace(DisposeAfterUse::YES);
+		TS_ASSERT(Common::Profiler::writeChromeTrace(trace));
+		Common::String json((const char *)trace.getData(), trace.size());
+		TS_ASSERT(json.contains("\"name\":\"test.frames\",\"ph\":\"C\""));
+		TS_ASSERT(json.contains("\"args\":{\"value\":42}"));
+
+		Common::Profiler::reset();
+		TS_ASSERT(!Common::Profiler::getSummary().contains("test.frames"));
+#endif
+	}
+};
@@ -0,0 +1,55 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/readaheadstream.h"
+#include "../null_osystem.h"
+
+class ReadAheadStreamTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_read_and_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		byte contents[100];
+		for (int i = 0; i < 100; ++i)
+			contents[i] = i;
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::ReadAheadStream *stream = Common::wrapReadAheadStream(&ms, 16, 3, DisposeAfterUse::NO);
+
+		// Nothing has been read ahead yet, so this stalls
+		TS_ASSERT_EQUALS(stream->readByte(), 0);
+		TS_ASSERT_EQUALS(stream->getStats().stalls, 1U);
+
+		stream->fillAhead();
+		TS_ASSERT_EQUALS(stream->getStats().prefetchedBytes, 48U);
+
+		// Reads across block boundaries are served from the ring
+		byte buffer[40];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+		TS_ASSERT_EQUALS(buffer[0], 1);
+		TS_ASSERT_EQUALS(buffer[39], 40);
+		TS_ASSERT_EQUALS(stream->pos(), 41);
+		TS_ASSERT_EQUALS(stream->getStats().hits, 1U);
+
+		// Forward seeks inside the ring do not discard it
+		TS_ASSERT(stream->seek(45));
+		TS_ASSERT_EQUALS(stream->readByte(), 45);
+		TS_ASSERT_EQUALS(stream->getStats().seeks, 0U);
+
+		// Backward seeks do
+		TS_ASSERT(stream->seek(-10, SEEK_END));
+		TS_ASSERT_EQUALS(stream->getStats().seeks, 1U);
+		stream->fillAhead();
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 10U);
+		TS_ASSERT_EQUALS(buffer[9], 99);
+		TS_ASSERT(stream->eos());
+
+		TS_ASSERT(stream->seek(0));
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT_EQUALS(stream->readByte(), 0);
+
+		delete stream;
+#endif
+	}
+};
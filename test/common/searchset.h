@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+class SearchSetTestSuite : public CxxTest::TestSuite
+{
+	// Minimal archive whose members contain the archive's own tag.
+	class TagArchive : public Common::Archive {
+	public:
+		TagArchive(byte tag) : _tag(tag) {}
+
+		void addFile(const Common::String &name) { _files.push_back(name); }
+
+		bool hasFile(const Common::String &name) const override {
+			for (uint i = 0; i < _files.size(); ++i) {
+				if (_files[i].equalsIgnoreCase(name))
+					return true;
+			}
+			return false;
+		}
+
+		int listMembers(Common::ArchiveMemberList &list) const override {
+			for (uint i = 0; i < _files.size(); ++i)
+				list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_files[i], this)));
+			return _files.size();
+		}
+
+		const Common::ArchiveMemberPtr getMember(const Common::String &name) const override {
+			return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+		}
+
+		Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const override {
+			if (!hasFile(name))
+				return nullptr;
+			return new Common::MemoryReadStream(&_tag, 1);
+		}
+
+	private:
+		byte _tag;
+		Common::StringArray _files;
+	};
+
+	static int readTag(const Common::SearchSet &set, const Common::String &name) {
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(name);
+		if (!stream)
+			return -1;
+		int tag = stream->readByte();
+		delete stream;
+		return tag;
+	}
+
+	public:
+	void test_member_index() {
+		Common::SearchSet set;
+		set.enableMemberIndex(true);
+
+		TagArchive *a = new TagArchive(1);
+		a->addFile("common.dat");
+		a->addFile("a.dat");
+		TagArchive *b = new TagArchive(2);
+		b->addFile("common.dat");
+		b->addFile("b.dat");
+
+		set.add("a", a, 0);
+		set.add("b", b, 0);
+
+		// Equal priority: insertion order prevails
+		TS_ASSERT_EQUALS(readTag(set, "COMMON.DAT"), 1);
+		TS_ASSERT_EQUALS(readTag(set, "b.dat"), 2);
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+
+		// Reprioritizing and adding update the already built index
+		set.setPriority("b", 5);
+		TS_ASSERT_EQUALS(readTag(set, "common.dat"), 2);
+
+		TagArchive *c = new TagArchive(3);
+		c->addFile("common.dat");
+		c->addFile("c.dat");
+		set.add("c", c, 10);
+		TS_ASSERT_EQUALS(readTag(set, "common.dat"), 3);
+		TS_ASSERT(set.hasFile("c.dat"));
+
+		// Removing hands members over to the next archive
+		set.remove("c");
+		TS_ASSERT_EQUALS(readTag(set, "common.dat"), 2);
+		set.remove("b");
+		TS_ASSERT_EQUALS(readTag(set, "common.dat"), 1);
+		TS_ASSERT(!set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+	}
+};
@@ -1,5 +1,6 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/memstream.h"
 #include "common/serializer.h"
 #include "common/stream.h"
 
@@ -108,4 +109,41 @@ public:
 	void test_read_v2_as_v2() {
 		readVersioned_v2(_inStreamV2, 2);
 	}
+
+	void test_sync_array() {
+		static const byte contents[] = {
+			0x01, 0x02, 0x03, 0x04,	// uint16, LE
+			0x05, 0x06, 0x07, 0x08,	// uint32, BE
+			0xff, 0xff, 0xfe, 0xff	// sint16, LE (available only in v1)
+		};
+
+		Common::MemoryReadStream in(contents, sizeof(contents));
+		Common::Serializer loader(&in, 0);
+		loader.setVersion(2);
+
+		uint16 u16[2];
+		uint32 u32[1];
+		int16 s16[2] = { 5, 6 };
+		loader.syncArrayLE(u16, 2);
+		loader.syncArrayBE(u32, 1);
+		loader.syncArrayLE(s16, 2, Common::Serializer::Version(1), Common::Serializer::Version(1));
+		TS_ASSERT_EQUALS(u16[0], 0x0201);
+		TS_ASSERT_EQUALS(u16[1], 0x0403);
+		TS_ASSERT_EQUALS(u32[0], 0x05060708U);
+		TS_ASSERT_EQUALS(s16[0], 5);
+		TS_ASSERT_EQUALS(loader.bytesSynced(), 8U);
+
+		// Saving writes the same bytes, and leaves the arrays alone
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		Common::Serializer saver(0, &out);
+		saver.setVersion(1);
+		s16[0] = -1;
+		s16[1] = -2;
+		saver.syncArrayLE(u16, 2);
+		saver.syncArrayBE(u32, 1);
+		saver.syncArrayLE(s16, 2, Common::Serializer::Version(1), Common::Serializer::Version(1));
+		TS_ASSERT_EQUALS(out.size(), (int32)sizeof(contents));
+		TS_ASSERT_SAME_DATA(out.getData(), contents, sizeof(contents));
+		TS_ASSERT_EQUALS(u32[0], 0x05060708U);
+	}
 };
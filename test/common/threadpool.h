@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+#include "../null_osystem.h"
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+	struct Counter {
+		Common::Mutex mutex;
+		uint value;
+	};
+
+	static void incrementTask(void *refCon) {
+		Counter *counter = (Counter *)refCon;
+		Common::StackLock lock(counter->mutex);
+		counter->value++;
+	}
+
+	public:
+	void test_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<uint> visits;
+		visits.resize(1000);
+		for (uint i = 0; i < visits.size(); ++i)
+			visits[i] = 0;
+
+		uint *data = visits.begin();
+		Common::parallelFor(0, 1000, 64, [data](uint chunkBegin, uint chunkEnd) {
+			for (uint i = chunkBegin; i < chunkEnd; ++i)
+				data[i]++;
+		});
+
+		// Every index is visited exactly once
+		for (uint i = 0; i < visits.size(); ++i)
+			TS_ASSERT_EQUALS(visits[i], 1U);
+
+		// Grains larger than the range result in a single call
+		uint calls = 0;
+		Common::parallelFor(10, 20, 100, [&calls](uint chunkBegin, uint chunkEnd) {
+			TS_ASSERT_EQUALS(chunkBegin, 10U);
+			TS_ASSERT_EQUALS(chunkEnd, 20U);
+			calls++;
+		});
+		TS_ASSERT_EQUALS(calls, 1U);
+
+		// Empty ranges result in none
+		Common::parallelFor(5, 5, 1, [&calls](uint, uint) { calls++; });
+		TS_ASSERT_EQUALS(calls, 1U);
+#endif
+	}
+
+	void test_task_group() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Counter counter;
+		counter.value = 0;
+		{
+			Common::TaskGroup group;
+			for (uint i = 0; i < 100; ++i)
+				group.run(&incrementTask, &counter);
+			group.wait();
+			TS_ASSERT(group.isDone());
+			TS_ASSERT_EQUALS(counter.value, 100U);
+
+			// Groups can be reused after waiting, and wait on destruction
+			for (uint i = 0; i < 10; ++i)
+				group.run(&incrementTask, &counter);
+		}
+		TS_ASSERT_EQUALS(counter.value, 110U);
+#endif
+	}
+};
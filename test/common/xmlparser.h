@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/xmlparser.h"
+#include "../null_osystem.h"
+
+class TestXMLParser : public Common::XMLParser {
+public:
+	Common::String _log;
+
+protected:
+	CUSTOM_XML_PARSER(TestXMLParser) {
+		XML_KEY(list)
+			XML_PROP(name, true)
+			XML_KEY(item)
+				XML_PROP(value, true)
+				XML_PROP(extra, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_list(ParserNode *node) {
+		_log += "list " + node->values["name"] + ";";
+		return true;
+	}
+
+	bool parserCallback_item(ParserNode *node) {
+		_log += "item " + node->values["value"];
+		if (node->values.contains("extra"))
+			_log += " " + node->values["extra"];
+		_log += ";";
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		_log += "close " + node->name + ";";
+		return true;
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+public:
+	void test_compiled() {
+		static const char xml[] =
+			"<?xml version = '1.0'?>\n"
+			"<!-- A comment -->\n"
+			"<list name = 'first'>\n"
+			"  <item value = '1' />\n"
+			"  <item value = \"2\" extra = 'x y' />\n"
+			"</list>\n"
+			"<list name = 'second'>\n"
+			"</list>\n";
+
+		TestXMLParser parser;
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(parser.parseAndCompile(compiled));
+		parser.close();
+
+		const Common::String expected = "close xml;list first;item 1;close item;item 2 x y;close item;close list;list second;close list;";
+		TS_ASSERT_EQUALS(parser._log, expected);
+
+		// Replaying the compiled keys runs the same callbacks
+		TestXMLParser replay;
+		TS_ASSERT(replay.loadBuffer(compiled.getData(), compiled.size()));
+		TS_ASSERT(replay.parseCompiled());
+		replay.close();
+		TS_ASSERT_EQUALS(replay._log, expected);
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Truncated data is rejected, which logs the error
+		Common::install_null_g_system();
+		TestXMLParser truncated;
+		TS_ASSERT(truncated.loadBuffer(compiled.getData(), compiled.size() / 2));
+		TS_ASSERT(!truncated.parseCompiled());
+		truncated.close();
+#endif
+	}
+};
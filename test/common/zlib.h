@@ -0,0 +1,57 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/substream.h"
+#include "common/zlib.h"
+
+class ZlibTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_deflate_read_stream() {
+#if defined(USE_ZLIB)
+		// Data large enough for several checkpoints
+		const uint32 size = 1200 * 1024;
+		byte *contents = new byte[size];
+		uint32 seed = 1;
+		for (uint32 i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			contents[i] = (i & 0x100) ? (byte)(seed >> 16) : (byte)(i / 7);
+		}
+
+		// A gzip stream is raw deflate data, between a 10 bytes header and
+		// an 8 bytes trailer
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(compressed);
+		gzip->write(contents, size);
+		gzip->finalize();
+		Common::MemoryReadStream gzipData(compressed->getData(), compressed->size(), DisposeAfterUse::YES);
+		Common::SeekableReadStream *stream = Common::wrapDeflateReadStream(
+			new Common::SeekableSubReadStream(&gzipData, 10, compressed->size() - 8), size);
+		delete gzip;
+
+		TS_ASSERT_EQUALS(stream->size(), (int32)size);
+
+		byte buffer[4096];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+		TS_ASSERT_EQUALS(memcmp(buffer, contents, sizeof(buffer)), 0);
+
+		// Forward, backward, and across the checkpoints
+		const uint32 offsets[] = { 1000000, 300000, 5, 262144, 700001, 262143, 1100000, 0 };
+		for (uint i = 0; i < ARRAYSIZE(offsets); ++i) {
+			TS_ASSERT(stream->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stream->pos(), (int32)offsets[i]);
+			TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+			TS_ASSERT_EQUALS(memcmp(buffer, contents + offsets[i], sizeof(buffer)), 0);
+		}
+
+		// The end of the data
+		TS_ASSERT(stream->seek(-100, SEEK_END));
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 100U);
+		TS_ASSERT_EQUALS(memcmp(buffer, contents + size - 100, 100), 0);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!stream->err());
+
+		delete stream;
+		delete[] contents;
+#endif
+	}
+};
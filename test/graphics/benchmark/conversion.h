@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class ConversionBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 640,
+		kHeight = 480,
+		kFrames = 20
+	};
+
+	static void measureCrossBlit(const char *name, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		byte *src = Benchmark::createNoise(kWidth * kHeight * srcFmt.bytesPerPixel, 1);
+		byte *dst = new byte[kWidth * kHeight * dstFmt.bytesPerPixel];
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kFrames; ++i)
+				Graphics::crossBlit(dst, src, kWidth * dstFmt.bytesPerPixel, kWidth * srcFmt.bytesPerPixel, kWidth, kHeight, dstFmt, srcFmt);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)kWidth * kHeight * kFrames, "pixels", best);
+
+		free(src);
+		delete[] dst;
+	}
+
+	static void measureCrossBlitMap(const char *name, const Graphics::PixelFormat &dstFmt) {
+		byte *src = Benchmark::createNoise(kWidth * kHeight, 2);
+		byte *dst = new byte[kWidth * kHeight * dstFmt.bytesPerPixel];
+		uint32 map[256];
+		for (int i = 0; i < 256; ++i)
+			map[i] = dstFmt.RGBToColor(i, 255 - i, i ^ 0x55);
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kFrames; ++i)
+				Graphics::crossBlitMap(dst, src, kWidth * dstFmt.bytesPerPixel, kWidth, kWidth, kHeight, dstFmt.bytesPerPixel, map);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)kWidth * kHeight * kFrames, "pixels", best);
+
+		free(src);
+		delete[] dst;
+	}
+
+public:
+	void test_crossBlit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat xrgb8888(4, 8, 8, 8, 0, 16, 8, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		const Graphics::PixelFormat bgra8888(4, 8, 8, 8, 8, 8, 16, 24, 0);
+		measureCrossBlit("crossblit.rgb565_to_xrgb8888", xrgb8888, rgb565);
+		measureCrossBlit("crossblit.xrgb8888_to_rgb565", rgb565, xrgb8888);
+		measureCrossBlit("crossblit.argb8888_to_bgra8888", bgra8888, argb8888);
+#endif
+	}
+
+	void test_crossBlitMap() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measureCrossBlitMap("crossblitmap.clut8_to_rgb565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		measureCrossBlitMap("crossblitmap.clut8_to_xrgb8888", Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+#endif
+	}
+};
@@ -0,0 +1,50 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class HQScalersBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 320,
+		kHeight = 200,
+		kFrames = 20
+	};
+
+	static void measure(const char *name, ScalerProc *scaler, int scale) {
+		// With a border row and column around the frame for the neighbours
+		const int srcPitch = (kWidth + 2) * 2;
+		byte *src = Benchmark::createNoise(srcPitch * (kHeight + 2), 1);
+		// Fewer distinct colors, as in game graphics
+		for (int i = 0; i < srcPitch * (kHeight + 2); i += 2)
+			src[i + 1] &= 0xC6;
+		const int dstPitch = kWidth * scale * 2;
+		byte *dst = new byte[dstPitch * kHeight * scale];
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kFrames; ++i)
+				scaler(src + srcPitch + 2, srcPitch, dst, dstPitch, kWidth, kHeight);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)kWidth * kHeight * kFrames, "pixels", best);
+
+		free(src);
+		delete[] dst;
+	}
+
+public:
+	void test_hq() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_HQ_SCALERS)
+		Common::install_null_g_system();
+
+		InitScalers(565);
+		measure("hq2x", HQ2x, 2);
+		measure("hq3x", HQ3x, 3);
+		DestroyScalers();
+#endif
+	}
+};
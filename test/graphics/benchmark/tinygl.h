@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelformat.h"
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zbuffer.h"
+#include "graphics/tinygl/zgl.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class TinyGLBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 640,
+		kHeight = 480,
+		kFrames = 20,
+		kTextureSize = 256,
+		kWallTiles = 8,
+		kActors = 6
+	};
+
+	// A wall of the room, split in tiles as the scene meshes are
+	static void drawWall(const float origin[3], const float u[3], const float v[3]) {
+		tglBegin(TGL_QUADS);
+		for (int j = 0; j < kWallTiles; ++j) {
+			for (int i = 0; i < kWallTiles; ++i) {
+				const int corners[4][2] = { { i, j }, { i + 1, j }, { i + 1, j + 1 }, { i, j + 1 } };
+				for (int k = 0; k < 4; ++k) {
+					const float s = corners[k][0] / (float)kWallTiles, t = corners[k][1] / (float)kWallTiles;
+					tglColor4f(0.5f + s / 2, 0.5f + t / 2, 1.0f - s / 2, 0.75f);
+					tglTexCoord2f(s * 2, t * 2);
+					tglVertex3f(origin[0] + u[0] * s + v[0] * t, origin[1] + u[1] * s + v[1] * t, origin[2] + u[2] * s + v[2] * t);
+				}
+			}
+		}
+		tglEnd();
+	}
+
+	static void drawBox(float size) {
+		static const float faces[6][3][3] = {
+			{ { -1, -1,  1 }, {  2,  0,  0 }, {  0,  2,  0 } },
+			{ {  1, -1, -1 }, { -2,  0,  0 }, {  0,  2,  0 } },
+			{ { -1, -1, -1 }, {  0,  0,  2 }, {  0,  2,  0 } },
+			{ {  1, -1,  1 }, {  0,  0, -2 }, {  0,  2,  0 } },
+			{ { -1,  1,  1 }, {  2,  0,  0 }, {  0,  0, -2 } },
+			{ { -1, -1, -1 }, {  2,  0,  0 }, {  0,  0,  2 } }
+		};
+		tglBegin(TGL_QUADS);
+		for (int f = 0; f < 6; ++f) {
+			const float corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+			for (int k = 0; k < 4; ++k) {
+				const float s = corners[k][0], t = corners[k][1];
+				tglColor4f(1.0f, s, t, 0.5f);
+				tglTexCoord2f(s, t);
+				tglVertex3f((faces[f][0][0] + faces[f][1][0] * s + faces[f][2][0] * t) * size,
+				            (faces[f][0][1] + faces[f][1][1] * s + faces[f][2][1] * t) * size,
+				            (faces[f][0][2] + faces[f][1][2] * s + faces[f][2][2] * t) * size);
+			}
+		}
+		tglEnd();
+	}
+
+	// A Grim like frame: the walls of a room, and a few boxes turning in front of them
+	static void drawScene(int frame) {
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+		tglRotatef((frame % 10) - 5.0f, 0, 1, 0);
+
+		const float walls[5][3][3] = {
+			{ { -4, -3, -12 }, {  8,  0,  0 }, {  0,  6,  0 } },
+			{ { -4, -3,  -2 }, {  0,  0, -10 }, {  0,  6,  0 } },
+			{ {  4, -3, -12 }, {  0,  0, 10 }, {  0,  6,  0 } },
+			{ { -4, -3,  -2 }, {  8,  0,  0 }, {  0,  0, -10 } },
+			{ { -4,  3, -12 }, {  8,  0,  0 }, {  0,  0, 10 } }
+		};
+		for (int i = 0; i < 5; ++i)
+			drawWall(walls[i][0], walls[i][1], walls[i][2]);
+
+		for (int i = 0; i < kActors; ++i) {
+			tglPushMatrix();
+			tglTranslatef((i % 3) * 2.5f - 2.5f, (i / 3) * 2.0f - 1.5f, -7.0f - (i % 2) * 2.0f);
+			tglRotatef(frame * 7.0f + i * 40.0f, 0.3f, 1, 0);
+			drawBox(0.8f);
+			tglPopMatrix();
+		}
+
+		TinyGL::tglPresentBuffer();
+	}
+
+	// Render the scene offscreen, and report the fill rate as screen pixels per second
+	static void measure(const char *name, const Graphics::PixelFormat &format, bool textured, bool blending, bool dirtyRects, TGLint minFilter = TGL_NEAREST) {
+		TinyGL::FrameBuffer *fb = new TinyGL::FrameBuffer(kWidth, kHeight, format);
+		TinyGL::glInit(fb, kTextureSize);
+		tglEnableDirtyRects(dirtyRects);
+
+		byte *noise = Benchmark::createNoise(kTextureSize * kTextureSize * 4, 1);
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, minFilter);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, TGL_NEAREST);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, kTextureSize, kTextureSize, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, noise);
+		free(noise);
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglFrustum(-0.4, 0.4, -0.3, 0.3, 1.0, 100.0);
+		tglEnable(TGL_DEPTH_TEST);
+		tglDepthFunc(TGL_LESS);
+		if (textured) {
+			tglEnable(TGL_TEXTURE_2D);
+		} else {
+			tglShadeModel(TGL_FLAT);
+		}
+		if (blending) {
+			tglEnable(TGL_BLEND);
+			tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		}
+
+		int frame = 0;
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kFrames; ++i)
+				drawScene(frame++);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)kWidth * kHeight * kFrames, "pixels", best);
+
+		tglDeleteTextures(1, &texture);
+		TinyGL::glClose();
+		delete fb;
+	}
+
+public:
+	void test_fill() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_TINYGL)
+		Common::install_null_g_system();
+
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		measure("tinygl.flat.rgb565", rgb565, false, false, false);
+		measure("tinygl.flat.argb8888", argb8888, false, false, false);
+		measure("tinygl.textured.argb8888", argb8888, true, false, false);
+		measure("tinygl.textured.blended.argb8888", argb8888, true, true, false);
+		measure("tinygl.textured.dirtyrects.argb8888", argb8888, true, false, true);
+		measure("tinygl.textured.mipmapped.argb8888", argb8888, true, false, false, TGL_NEAREST_MIPMAP_NEAREST);
+#endif
+	}
+};
@@ -0,0 +1,97 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class TransparentSurfaceBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kSpriteSize = 64,
+		kSprites = 2000
+	};
+
+	// Blit a frame worth of sprites onto a 640x480 screen, as the sprite heavy engines do
+	static void measure(const char *name, Graphics::AlphaType alphaMode, bool premultiplied, uint32 color, Graphics::TSpriteBlendMode blendMode) {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+		Graphics::TransparentSurface sprite;
+		sprite.create(kSpriteSize, kSpriteSize, format);
+		byte *noise = Benchmark::createNoise(kSpriteSize * kSpriteSize * 4, 1);
+		memcpy(sprite.getPixels(), noise, kSpriteSize * kSpriteSize * 4);
+		free(noise);
+		sprite.setAlphaMode(alphaMode);
+		if (premultiplied)
+			sprite.premultiplyAlpha();
+
+		Graphics::Surface screen;
+		screen.create(640, 480, format);
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kSprites; ++i)
+				sprite.blit(screen, (i * 37) % (640 - kSpriteSize), (i * 53) % (480 - kSpriteSize), Graphics::FLIP_NONE, nullptr, color, -1, -1, blendMode);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)kSpriteSize * kSpriteSize * kSprites, "pixels", best);
+
+		sprite.free();
+		screen.free();
+	}
+
+	// Blit the same sprite scaled up, with and without keeping the scaled version around
+	static void measureScaled(const char *name, bool caching) {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+		Graphics::TransparentSurface sprite;
+		sprite.create(kSpriteSize, kSpriteSize, format);
+		byte *noise = Benchmark::createNoise(kSpriteSize * kSpriteSize * 4, 1);
+		memcpy(sprite.getPixels(), noise, kSpriteSize * kSpriteSize * 4);
+		free(noise);
+		sprite.setTransformCaching(caching);
+
+		Graphics::Surface screen;
+		screen.create(640, 480, format);
+
+		const int scaledSize = kSpriteSize * 3 / 2;
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kSprites / 4; ++i)
+				sprite.blit(screen, (i * 37) % (640 - scaledSize), (i * 53) % (480 - scaledSize), Graphics::FLIP_NONE, nullptr, 0xFFFFFFFF, scaledSize, scaledSize);
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)scaledSize * scaledSize * (kSprites / 4), "pixels", best);
+
+		sprite.free();
+		screen.free();
+	}
+
+public:
+	void test_blit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measure("blit.opaque", Graphics::ALPHA_OPAQUE, false, 0xFFFFFFFF, Graphics::BLEND_NORMAL);
+		measure("blit.binary", Graphics::ALPHA_BINARY, false, 0xFFFFFFFF, Graphics::BLEND_NORMAL);
+		measure("blit.normal", Graphics::ALPHA_FULL, false, 0xFFFFFFFF, Graphics::BLEND_NORMAL);
+		measure("blit.normal.colormod", Graphics::ALPHA_FULL, false, 0xC080FF40, Graphics::BLEND_NORMAL);
+		measure("blit.additive", Graphics::ALPHA_FULL, false, 0xFFFFFFFF, Graphics::BLEND_ADDITIVE);
+		measure("blit.subtractive", Graphics::ALPHA_FULL, false, 0xFFFFFFFF, Graphics::BLEND_SUBTRACTIVE);
+		measure("blit.multiply", Graphics::ALPHA_FULL, false, 0xFFFFFFFF, Graphics::BLEND_MULTIPLY);
+		measure("blit.premultiplied", Graphics::ALPHA_FULL, true, 0xFFFFFFFF, Graphics::BLEND_NORMAL);
+		measure("blit.premultiplied.colormod", Graphics::ALPHA_FULL, true, 0xC080FF40, Graphics::BLEND_NORMAL);
+#endif
+	}
+
+	void test_scaledBlit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		measureScaled("blit.scaled", false);
+		measureScaled("blit.scaled.cached", true);
+#endif
+	}
+};
@@ -0,0 +1,62 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "../../null_osystem.h"
+#include "../../benchmark.h"
+
+class YUVToRGBBenchmarkSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 640,
+		kHeight = 480,
+		kFrames = 50
+	};
+
+	// Convert the same frame a few times, subsampling 0 for YUV444, 1 for YUV420 and 2 for YUV410
+	static void measure(const char *name, const Graphics::PixelFormat &format, int subsampling) {
+		byte *ySrc = Benchmark::createNoise(kWidth * kHeight, 1);
+		byte *uSrc = Benchmark::createNoise(kWidth * (kHeight + 1), 2);
+		byte *vSrc = Benchmark::createNoise(kWidth * (kHeight + 1), 3);
+
+		Graphics::Surface surface;
+		surface.create(kWidth, kHeight, format);
+
+		uint64 best = 0;
+		for (int run = 0; run < Benchmark::kRuns; ++run) {
+			const uint64 start = Common::Profiler::getMicros();
+			for (int i = 0; i < kFrames; ++i) {
+				if (subsampling == 0)
+					YUVToRGBMan.convert444(&surface, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, kWidth, kHeight, kWidth, kWidth);
+				else if (subsampling == 1)
+					YUVToRGBMan.convert420(&surface, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, kWidth, kHeight, kWidth, kWidth / 2);
+				else
+					YUVToRGBMan.convert410(&surface, Graphics::YUVToRGBManager::kScaleITU, ySrc, uSrc, vSrc, kWidth, kHeight, kWidth, kWidth / 4 + 1);
+			}
+			const uint64 time = Common::Profiler::getMicros() - start;
+			if (run == 0 || time < best)
+				best = time;
+		}
+		Benchmark::report(name, (uint64)kWidth * kHeight * kFrames, "pixels", best);
+
+		surface.free();
+		free(ySrc);
+		free(uSrc);
+		free(vSrc);
+	}
+
+public:
+	void test_convert() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		measure("yuv.convert444.rgb565", rgb565, 0);
+		measure("yuv.convert444.argb8888", argb8888, 0);
+		measure("yuv.convert420.rgb565", rgb565, 1);
+		measure("yuv.convert420.argb8888", argb8888, 1);
+		measure("yuv.convert410.rgb565", rgb565, 2);
+		measure("yuv.convert410.argb8888", argb8888, 2);
+#endif
+	}
+};
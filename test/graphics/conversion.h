@@ -0,0 +1,125 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+class ConversionTestSuite : public CxxTest::TestSuite {
+	static byte *createNoise(int size, uint32 seed) {
+		byte *data = new byte[size];
+		for (int i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 16;
+		}
+		return data;
+	}
+
+	static uint32 readPixel(const byte *p, int bytesPerPixel) {
+		if (bytesPerPixel == 1)
+			return *p;
+		if (bytesPerPixel == 2)
+			return *(const uint16 *)p;
+		return *(const uint32 *)p;
+	}
+
+	// Straightforward per-pixel version of crossBlit
+	static uint32 convertReference(uint32 color, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		byte a, r, g, b;
+		srcFmt.colorToARGB(color, a, r, g, b);
+		return dstFmt.ARGBToColor(a, r, g, b);
+	}
+
+	static void check(const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		// Not a multiple of the vector size, and with padding at the end of the rows
+		const int width = 37, height = 9;
+		const int srcPitch = width * srcFmt.bytesPerPixel + 6;
+		const int dstPitch = width * dstFmt.bytesPerPixel + 12;
+		byte *src = createNoise(srcPitch * height, srcFmt.bytesPerPixel);
+		byte *dst = createNoise(dstPitch * height, 7);
+
+		TS_ASSERT(Graphics::crossBlit(dst, src, dstPitch, srcPitch, width, height, dstFmt, srcFmt));
+
+		int mismatches = 0;
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const uint32 expected = convertReference(readPixel(src + y * srcPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel), dstFmt, srcFmt);
+				if (readPixel(dst + y * dstPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel) != expected)
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		delete[] src;
+		delete[] dst;
+	}
+
+public:
+	void test_crossBlit() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+		for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+			// The same formats are copied, with whatever the unused bits hold
+			for (int j = 0; j < ARRAYSIZE(formats); ++j) {
+				if (i != j)
+					check(formats[i], formats[j]);
+			}
+		}
+	}
+
+	void test_crossBlitInPlace() {
+		// Widening the pixels has to work backwards through the buffer
+		const Graphics::PixelFormat srcFmt(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat dstFmt(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		const int width = 43, height = 5;
+		byte *src = createNoise(width * height * 2, 3);
+		byte *buffer = new byte[width * height * 4];
+		memcpy(buffer, src, width * height * 2);
+
+		TS_ASSERT(Graphics::crossBlit(buffer, buffer, width * 4, width * 2, width, height, dstFmt, srcFmt));
+
+		int mismatches = 0;
+		for (int i = 0; i < width * height; ++i) {
+			if (((const uint32 *)buffer)[i] != convertReference(((const uint16 *)src)[i], dstFmt, srcFmt))
+				mismatches++;
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		delete[] src;
+		delete[] buffer;
+	}
+
+	void test_crossBlitMap() {
+		uint32 map[256];
+		for (int i = 0; i < 256; ++i)
+			map[i] = 0x01000000 * i + 0x10101 * (255 - i);
+
+		const int width = 29, height = 6, srcPitch = width + 3;
+		byte *src = createNoise(srcPitch * height, 5);
+		const int sizes[] = { 1, 2, 4 };
+		for (int i = 0; i < ARRAYSIZE(sizes); ++i) {
+			const int dstPitch = width * sizes[i] + 8;
+			byte *dst = new byte[dstPitch * height];
+			TS_ASSERT(Graphics::crossBlitMap(dst, src, dstPitch, srcPitch, width, height, sizes[i], map));
+
+			int mismatches = 0;
+			for (int y = 0; y < height; ++y) {
+				for (int x = 0; x < width; ++x) {
+					const uint32 mask = sizes[i] == 4 ? 0xFFFFFFFF : (1 << (sizes[i] * 8)) - 1;
+					if (readPixel(dst + y * dstPitch + x * sizes[i], sizes[i]) != (map[src[y * srcPitch + x]] & mask))
+						mismatches++;
+				}
+			}
+			TS_ASSERT_EQUALS(mismatches, 0);
+			delete[] dst;
+		}
+
+		TS_ASSERT(!Graphics::crossBlitMap(src, src, srcPitch, srcPitch, width, height, 3, map));
+		delete[] src;
+	}
+};
@@ -0,0 +1,62 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirty_rects.h"
+
+class DirtyRectListTestSuite : public CxxTest::TestSuite {
+	// Every pixel of the added rects is in one of the rects of the list
+	static bool covers(const Graphics::DirtyRectList &list, const Common::Rect &r) {
+		for (int y = r.top; y < r.bottom; ++y) {
+			for (int x = r.left; x < r.right; ++x) {
+				bool found = false;
+				for (uint i = 0; i < list.size() && !found; ++i)
+					found = list[i].contains(x, y);
+				if (!found)
+					return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	void test_farApart() {
+		// Small sprites at opposite corners stay separate
+		Graphics::DirtyRectList list;
+		list.add(Common::Rect(0, 0, 16, 16));
+		list.add(Common::Rect(600, 450, 616, 466));
+		TS_ASSERT_EQUALS(list.size(), 2U);
+		TS_ASSERT_EQUALS(list.getArea(), 2U * 16 * 16);
+	}
+
+	void test_merge() {
+		Graphics::DirtyRectList list;
+		// Overlapping and close rects are cheaper to copy together
+		list.add(Common::Rect(10, 10, 50, 50));
+		list.add(Common::Rect(30, 30, 60, 60));
+		list.add(Common::Rect(62, 10, 100, 60));
+		list.add(Common::Rect(20, 20, 30, 30));
+		list.add(Common::Rect());
+		TS_ASSERT_EQUALS(list.size(), 1U);
+		TS_ASSERT_EQUALS(list[0], Common::Rect(10, 10, 100, 60));
+
+		// A rect covering the whole list replaces it
+		list.add(Common::Rect(300, 300, 310, 310));
+		list.add(Common::Rect(0, 0, 640, 480));
+		TS_ASSERT_EQUALS(list.size(), 1U);
+		TS_ASSERT_EQUALS(list[0], Common::Rect(0, 0, 640, 480));
+
+		list.clear();
+		TS_ASSERT(list.empty());
+	}
+
+	void test_maxRects() {
+		Graphics::DirtyRectList list(0, 4);
+		Common::Rect rects[10];
+		for (int i = 0; i < 10; ++i) {
+			rects[i] = Common::Rect(i * 60, (i % 3) * 150, i * 60 + 8, (i % 3) * 150 + 8);
+			list.add(rects[i]);
+		}
+		TS_ASSERT_EQUALS(list.size(), 4U);
+		for (int i = 0; i < 10; ++i)
+			TS_ASSERT(covers(list, rects[i]));
+	}
+};
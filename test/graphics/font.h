@@ -0,0 +1,86 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/str.h"
+#include "common/ustr.h"
+#include "graphics/font.h"
+
+class FontTestSuite : public CxxTest::TestSuite {
+	// Narrow 'i's and wide everything else, counting how often it is measured
+	class CountingFont : public Graphics::Font {
+	public:
+		CountingFont(bool caching) : _caching(caching), _charWidthCalls(0) {}
+
+		virtual int getFontHeight() const { return 8; }
+		virtual int getMaxCharWidth() const { return 6; }
+		virtual int getCharWidth(uint32 chr) const {
+			++_charWidthCalls;
+			return chr == 'i' ? 2 : 6;
+		}
+		virtual void drawChar(Graphics::Surface *dst, uint32 chr, int x, int y, uint32 color) const {}
+
+		int getCharWidthCalls() const { return _charWidthCalls; }
+
+	protected:
+		virtual Graphics::FontLayoutCache *getLayoutCache() const { return _caching ? &_cache : nullptr; }
+
+	private:
+		bool _caching;
+		mutable int _charWidthCalls;
+		mutable Graphics::FontLayoutCache _cache;
+	};
+
+	template<class StringType>
+	static void checkWrap(const CountingFont &reference, const CountingFont &cached, const StringType &str, int maxWidth, uint32 mode) {
+		for (int i = 0; i < 2; ++i) {
+			Common::Array<StringType> expected, actual;
+			TS_ASSERT_EQUALS(cached.wordWrapText(str, maxWidth, actual, 0, mode), reference.wordWrapText(str, maxWidth, expected, 0, mode));
+			TS_ASSERT_EQUALS(actual.size(), expected.size());
+			for (uint j = 0; j < expected.size() && j < actual.size(); ++j)
+				TS_ASSERT_EQUALS(actual[j], expected[j]);
+		}
+	}
+
+public:
+	void test_cachedWidth() {
+		CountingFont reference(false), cached(true);
+		const Common::String str("Misty mountains");
+		const Common::U32String u32Str("Misty mountains");
+
+		TS_ASSERT_EQUALS(cached.getStringWidth(str), reference.getStringWidth(str));
+		TS_ASSERT_EQUALS(cached.getStringWidth(u32Str), reference.getStringWidth(u32Str));
+		const int calls = cached.getCharWidthCalls();
+		TS_ASSERT_EQUALS(cached.getStringWidth(str), reference.getStringWidth(str));
+		TS_ASSERT_EQUALS(cached.getStringWidth(u32Str), reference.getStringWidth(u32Str));
+		TS_ASSERT_EQUALS(cached.getCharWidthCalls(), calls);
+	}
+
+	void test_cachedWordWrap() {
+		CountingFont reference(false), cached(true);
+		const Common::String str("The quick brown fox jumps over the lazy dog.\nIt is a minimal pangram");
+		const uint32 modes[] = {
+			Graphics::kWordWrapDefault, Graphics::kWordWrapOnExplicitNewLines, Graphics::kWordWrapEvenWidthLines
+		};
+		for (int i = 0; i < ARRAYSIZE(modes); ++i) {
+			checkWrap(reference, cached, str, 60, modes[i]);
+			checkWrap(reference, cached, Common::U32String(str), 90, modes[i]);
+		}
+
+		// The second wrap of the same string comes from the cache
+		Common::Array<Common::String> lines;
+		cached.wordWrapText(str, 60, lines);
+		const int calls = cached.getCharWidthCalls();
+		lines.clear();
+		cached.wordWrapText(str, 60, lines);
+		TS_ASSERT_EQUALS(cached.getCharWidthCalls(), calls);
+
+		// Lines which are already there are kept
+		Common::Array<Common::String> expected, actual;
+		expected.push_back("first");
+		actual.push_back("first");
+		reference.wordWrapText(str, 60, expected);
+		cached.wordWrapText(str, 60, actual);
+		TS_ASSERT_EQUALS(actual.size(), expected.size());
+		TS_ASSERT_EQUALS(actual[0], "first");
+	}
+};
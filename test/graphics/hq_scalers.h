@@ -0,0 +1,63 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler.h"
+#include "graphics/scaler/intern.h"
+
+#ifdef HQX_USE_SIMD
+extern "C" uint32 *RGBtoYUV;
+#endif
+
+class HQScalersTestSuite : public CxxTest::TestSuite {
+#ifdef HQX_USE_SIMD
+	// Colors close to each other, so that all the thresholds of diffYUV() are hit
+	static void fillNoise(uint16 *pixels, int size, uint32 seed) {
+		for (int i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const uint32 base = (seed >> 16) & 3;
+			seed = seed * 1103515245 + 12345;
+			pixels[i] = (0x8410 * base + ((seed >> 16) & 0x0C63)) & 0xFFFF;
+		}
+	}
+
+	static void check(uint32 bitFormat) {
+		InitScalers(bitFormat);
+
+		// Not a multiple of the vector size, with a border for the neighbours
+		const int width = 45, height = 6, pitch = width + 7;
+		uint16 *pixels = new uint16[pitch * (height + 2)];
+		fillNoise(pixels, pitch * (height + 2), bitFormat);
+
+		int mismatches = 0;
+		uint8 patterns[width];
+		for (int y = 1; y <= height; ++y) {
+			const uint16 *row = pixels + y * pitch + 1;
+			computeHQPatterns(row, pitch, width, patterns);
+			for (int x = 0; x < width; ++x) {
+				const uint16 *p = row + x;
+				const uint16 neighbours[8] = {
+					p[-pitch - 1], p[-pitch], p[-pitch + 1], p[-1], p[1], p[pitch - 1], p[pitch], p[pitch + 1]
+				};
+				int expected = 0;
+				for (int i = 0; i < 8; ++i) {
+					if (*p != neighbours[i] && diffYUV(RGBtoYUV[*p], RGBtoYUV[neighbours[i]]))
+						expected |= 1 << i;
+				}
+				if (patterns[x] != expected)
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		delete[] pixels;
+		DestroyScalers();
+	}
+#endif
+
+public:
+	void test_patterns() {
+#ifdef HQX_USE_SIMD
+		check(565);
+		check(555);
+#endif
+	}
+};
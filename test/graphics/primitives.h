@@ -0,0 +1,158 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/primitives.h"
+#include "graphics/surface.h"
+
+class PrimitivesTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 48,
+		kHeight = 40
+	};
+
+	// Counts the times each pixel is drawn, so overlapping spans show up
+	static void plotPixel(int x, int y, int color, void *data) {
+		byte *counts = (byte *)data;
+		if (x >= 0 && x < kWidth && y >= 0 && y < kHeight)
+			counts[y * kWidth + x]++;
+	}
+
+	static void plotSpan(int x1, int x2, int y, int color, void *data) {
+		TS_ASSERT_LESS_THAN_EQUALS(x1, x2);
+		for (int x = x1; x <= x2; ++x)
+			plotPixel(x, y, color, data);
+	}
+
+	// The span versions draw the same pixels as the per-pixel ones, as many times
+	static bool coverSame(const byte *pixels, const byte *spans) {
+		return !memcmp(pixels, spans, kWidth * kHeight);
+	}
+
+	static void plotSpanSurface(int x1, int x2, int y, int color, void *data) {
+		((Graphics::Surface *)data)->hLine(x1, y, x2, color);
+	}
+
+	static bool isInside(int x, int y, void *data) {
+		const Graphics::Surface *surface = (const Graphics::Surface *)data;
+		return *(const byte *)surface->getBasePtr(x, y) == 0;
+	}
+
+	static void fillSpan(int x1, int x2, int y, int color, void *data) {
+		Graphics::Surface *surface = (Graphics::Surface *)data;
+		for (int x = x1; x <= x2; ++x) {
+			TS_ASSERT_EQUALS(*(byte *)surface->getBasePtr(x, y), 0);
+			*(byte *)surface->getBasePtr(x, y) = color;
+		}
+	}
+
+	// Straightforward recursive version of the 4-connected fill
+	static void fillReference(Graphics::Surface &surface, int x, int y, const Common::Rect &bounds, byte color) {
+		if (!bounds.contains(x, y) || *(byte *)surface.getBasePtr(x, y) != 0)
+			return;
+		*(byte *)surface.getBasePtr(x, y) = color;
+		fillReference(surface, x + 1, y, bounds, color);
+		fillReference(surface, x - 1, y, bounds, color);
+		fillReference(surface, x, y + 1, bounds, color);
+		fillReference(surface, x, y - 1, bounds, color);
+	}
+
+public:
+	void test_lineSpans() {
+		const int lines[][4] = {
+			{ 2, 3, 45, 3 }, { 45, 3, 2, 3 }, { 1, 1, 40, 10 }, { 40, 10, 1, 1 },
+			{ 5, 38, 9, 0 }, { 0, 0, 30, 30 }, { 20, 20, 20, 20 }, { 47, 0, 0, 39 }
+		};
+		for (int i = 0; i < ARRAYSIZE(lines); ++i) {
+			byte pixels[kWidth * kHeight] = { 0 }, spans[kWidth * kHeight] = { 0 };
+			Graphics::drawLine(lines[i][0], lines[i][1], lines[i][2], lines[i][3], 1, plotPixel, pixels);
+			Graphics::drawLine(lines[i][0], lines[i][1], lines[i][2], lines[i][3], 1, plotSpan, spans);
+			TS_ASSERT(coverSame(pixels, spans));
+		}
+	}
+
+	void test_shapeSpans() {
+		const int boxes[][4] = { { 3, 4, 40, 30 }, { 10, 10, 11, 30 }, { 5, 5, 40, 6 }, { 20, 20, 20, 20 } };
+		for (int i = 0; i < ARRAYSIZE(boxes); ++i) {
+			for (int filled = 0; filled < 2; ++filled) {
+				byte pixels[kWidth * kHeight] = { 0 }, spans[kWidth * kHeight] = { 0 };
+				Graphics::drawEllipse(boxes[i][0], boxes[i][1], boxes[i][2], boxes[i][3], 1, filled, plotPixel, pixels);
+				Graphics::drawEllipse(boxes[i][0], boxes[i][1], boxes[i][2], boxes[i][3], 1, filled, plotSpan, spans);
+				TS_ASSERT(coverSame(pixels, spans));
+			}
+
+			Common::Rect rect(boxes[i][0], boxes[i][1], boxes[i][2], boxes[i][3]);
+			byte pixels[kWidth * kHeight] = { 0 }, spans[kWidth * kHeight] = { 0 };
+			Graphics::drawFilledRect(rect, 1, plotPixel, pixels);
+			Graphics::drawFilledRect(rect, 1, plotSpan, spans);
+			TS_ASSERT(coverSame(pixels, spans));
+		}
+
+		int polyX[] = { 2, 40, 30, 20, 8 };
+		int polyY[] = { 3, 8, 35, 15, 30 };
+		Common::Rect bbox(2, 3, 40, 35);
+		byte pixels[kWidth * kHeight] = { 0 }, spans[kWidth * kHeight] = { 0 };
+		Graphics::drawPolygonScan(polyX, polyY, ARRAYSIZE(polyX), bbox, 1, plotPixel, pixels);
+		Graphics::drawPolygonScan(polyX, polyY, ARRAYSIZE(polyX), bbox, 1, plotSpan, spans);
+		TS_ASSERT(coverSame(pixels, spans));
+	}
+
+	void test_floodFill() {
+		Graphics::Surface surface, expected;
+		surface.create(kWidth, kHeight, Graphics::PixelFormat::createFormatCLUT8());
+
+		// Some walls with holes in them, and a pocket which is not reachable
+		Graphics::drawLine(0, 20, 40, 20, 1, plotSpanSurface, &surface);
+		Graphics::drawLine(10, 0, 10, 35, 1, plotSpanSurface, &surface);
+		Graphics::drawLine(0, 39, 47, 5, 1, plotSpanSurface, &surface);
+		*(byte *)surface.getBasePtr(10, 12) = 0;
+		Common::Rect box(25, 25, 35, 33);
+		surface.frameRect(box, 1);
+		surface.fillRect(Common::Rect(30, 8, 36, 14), 2);
+		expected.copyFrom(surface);
+
+		// The fill stays inside the bounds
+		const Common::Rect bounds(2, 1, 46, 38);
+		fillReference(expected, 5, 5, bounds, 3);
+		Graphics::floodFill(5, 5, bounds, 3, isInside, fillSpan, &surface);
+
+		int mismatches = 0;
+		for (int y = 0; y < kHeight; ++y) {
+			for (int x = 0; x < kWidth; ++x) {
+				if (*(const byte *)surface.getBasePtr(x, y) != *(const byte *)expected.getBasePtr(x, y))
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		// Nothing happens outside of the area
+		Graphics::floodFill(30, 10, bounds, 4, isInside, fillSpan, &surface);
+		Graphics::floodFill(0, 0, bounds, 4, isInside, fillSpan, &surface);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(30, 10), 2);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(0, 0), 0);
+
+		surface.free();
+		expected.free();
+	}
+
+	void test_floodFillClass() {
+		Graphics::Surface surface;
+		surface.create(kWidth, kHeight, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		surface.frameRect(Common::Rect(4, 4, 30, 30), 0x1234);
+		surface.hLine(4, 15, 29, 0x1234);
+
+		Graphics::FloodFill fill(&surface, 0, 0xffff);
+		fill.addSeed(10, 10);
+		fill.fill();
+
+		int filled = 0;
+		for (int y = 0; y < kHeight; ++y) {
+			for (int x = 0; x < kWidth; ++x) {
+				if (*(const uint16 *)surface.getBasePtr(x, y) == 0xffff)
+					filled++;
+			}
+		}
+		// The upper part of the frame, which is 24 by 10 pixels
+		TS_ASSERT_EQUALS(filled, 24 * 10);
+
+		surface.free();
+	}
+};
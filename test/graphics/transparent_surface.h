@@ -0,0 +1,244 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite {
+	static void fillNoise(Graphics::Surface &surface, uint32 seed) {
+		for (int y = 0; y < surface.h; ++y) {
+			byte *row = (byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * 4; ++x) {
+				seed = seed * 1103515245 + 12345;
+				row[x] = seed >> 16;
+			}
+		}
+	}
+
+	// Component 0 is the alpha, then blue, green and red, as in the supported pixel format
+	static uint get(uint32 pixel, int c) {
+		return (pixel >> (c * 8)) & 0xFF;
+	}
+
+	static void set(uint32 &pixel, int c, uint value) {
+		pixel = (pixel & ~(0xFF << (c * 8))) | (value << (c * 8));
+	}
+
+	// Straightforward per-pixel version of the blend modes
+	static uint32 blendReference(uint32 in, uint32 out, uint32 color, Graphics::TSpriteBlendMode blendMode) {
+		const bool colorMod = color != 0xFFFFFFFF;
+		const uint a = get(in, 0);
+		const uint ina = colorMod ? a * (color >> 24) >> 8 : a;
+
+		if (!colorMod && a == 0)
+			return out;
+		if (blendMode == Graphics::BLEND_NORMAL && ina == 0)
+			return out;
+
+		for (int c = 1; c < 4; ++c) {
+			const uint i = get(in, c), o = get(out, c), m = get(color, c - 1);
+			uint result;
+			if (blendMode == Graphics::BLEND_NORMAL) {
+				if (colorMod)
+					result = (o * (255 - ina) >> 8) + (i * ina * m >> 16);
+				else
+					result = (i * a + o * (255 - a)) >> 8;
+			} else if (blendMode == Graphics::BLEND_ADDITIVE) {
+				if (colorMod && m != 255)
+					result = MIN<uint>(o + (i * m * ina >> 16), 255);
+				else
+					result = MIN<uint>(o + (i * ina >> 8), 255);
+			} else if (blendMode == Graphics::BLEND_SUBTRACTIVE) {
+				if (colorMod && m != 255)
+					result = o - (uint32)((uint64)i * m * o * a >> 24);
+				else
+					result = o - (i * o * a >> 16);
+			} else {
+				if (colorMod && m != 255)
+					result = o * (i * m * ina >> 16) >> 8;
+				else
+					result = o * (i * ina >> 8) >> 8;
+			}
+			set(out, c, result);
+		}
+
+		if (blendMode == Graphics::BLEND_NORMAL || (blendMode == Graphics::BLEND_SUBTRACTIVE && colorMod))
+			set(out, 0, 255);
+		return out;
+	}
+
+	// Blits a sprite of a width which is not a multiple of the vector size, and checks each pixel
+	static void check(Graphics::AlphaType alphaMode, uint32 color, Graphics::TSpriteBlendMode blendMode, int flipping) {
+		const int width = 13, height = 3;
+		Graphics::TransparentSurface src;
+		src.create(width, height, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillNoise(src, 1);
+		src.setAlphaMode(alphaMode);
+		// Some fully transparent and fully opaque pixels
+		*(uint32 *)src.getBasePtr(2, 0) &= 0xFFFFFF00;
+		*(uint32 *)src.getBasePtr(7, 1) |= 0xFF;
+
+		Graphics::Surface dst, expected;
+		dst.create(width + 3, height + 2, src.format);
+		fillNoise(dst, 2);
+		expected.copyFrom(dst);
+
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const int srcX = (flipping & Graphics::FLIP_H) ? width - 1 - x : x;
+				const int srcY = (flipping & Graphics::FLIP_V) ? height - 1 - y : y;
+				const uint32 in = *(const uint32 *)src.getBasePtr(srcX, srcY);
+				uint32 &out = *(uint32 *)expected.getBasePtr(x + 1, y + 1);
+				if (color == 0xFFFFFFFF && blendMode == Graphics::BLEND_NORMAL && alphaMode == Graphics::ALPHA_OPAQUE)
+					out = in | 0xFF;
+				else if (color == 0xFFFFFFFF && blendMode == Graphics::BLEND_NORMAL && alphaMode == Graphics::ALPHA_BINARY)
+					out = (in & 0xFF) ? in | 0xFF : out;
+				else
+					out = blendReference(in, out, color, blendMode);
+			}
+		}
+
+		src.blit(dst, 1, 1, flipping, nullptr, color, -1, -1, blendMode);
+		int mismatches = 0;
+		for (int y = 0; y < dst.h; ++y) {
+			for (int x = 0; x < dst.w; ++x) {
+				if (*(const uint32 *)dst.getBasePtr(x, y) != *(const uint32 *)expected.getBasePtr(x, y))
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		src.free();
+		dst.free();
+		expected.free();
+	}
+
+	static bool equals(const Graphics::Surface &a, const Graphics::Surface &b) {
+		if (a.w != b.w || a.h != b.h)
+			return false;
+		for (int y = 0; y < a.h; ++y) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * 4))
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void test_blend() {
+		const Graphics::TSpriteBlendMode modes[] = {
+			Graphics::BLEND_NORMAL, Graphics::BLEND_ADDITIVE, Graphics::BLEND_SUBTRACTIVE, Graphics::BLEND_MULTIPLY
+		};
+		// Without color modulation, and with some components of 255
+		const uint32 colors[] = { 0xFFFFFFFF, 0xC080FF40, 0xFFFF20FF };
+		for (int i = 0; i < ARRAYSIZE(modes); ++i) {
+			for (int j = 0; j < ARRAYSIZE(colors); ++j) {
+				for (int flipping = 0; flipping < 4; ++flipping)
+					check(Graphics::ALPHA_FULL, colors[j], modes[i], flipping);
+			}
+		}
+	}
+
+	void test_fastPaths() {
+		for (int flipping = 0; flipping < 4; ++flipping) {
+			check(Graphics::ALPHA_OPAQUE, 0xFFFFFFFF, Graphics::BLEND_NORMAL, flipping);
+			check(Graphics::ALPHA_BINARY, 0xFFFFFFFF, Graphics::BLEND_NORMAL, flipping);
+		}
+	}
+
+	void test_premultiplied() {
+		const int width = 21, height = 2;
+		Graphics::TransparentSurface src;
+		src.create(width, height, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillNoise(src, 3);
+		*(uint32 *)src.getBasePtr(4, 1) |= 0xFF;
+		Graphics::Surface straight;
+		straight.copyFrom(src);
+
+		src.premultiplyAlpha();
+		TS_ASSERT(src.isPremultiplied());
+
+		Graphics::Surface dst;
+		dst.create(width, height, src.format);
+		fillNoise(dst, 4);
+		Graphics::Surface original;
+		original.copyFrom(dst);
+		src.blit(dst, 0, 0);
+
+		// The same as the straight alpha blend, but for the rounding
+		int mismatches = 0;
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const uint32 in = *(const uint32 *)straight.getBasePtr(x, y);
+				const uint32 expected = blendReference(in, *(const uint32 *)original.getBasePtr(x, y), 0xFFFFFFFF, Graphics::BLEND_NORMAL);
+				const uint32 actual = *(const uint32 *)dst.getBasePtr(x, y);
+				for (int c = 0; c < 4; ++c) {
+					if (ABS((int)get(actual, c) - (int)get(expected, c)) > 2)
+						mismatches++;
+				}
+				// The alpha is kept, and opaque pixels keep their colors
+				if (get(*(const uint32 *)src.getBasePtr(x, y), 0) != get(in, 0))
+					mismatches++;
+				if (get(in, 0) == 255 && actual != in)
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		src.free();
+		straight.free();
+		dst.free();
+		original.free();
+	}
+	void test_transformCache() {
+		Graphics::TransparentSurface src;
+		src.create(31, 17, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillNoise(src, 5);
+		const Graphics::TransformStruct transform(150, 80, 30, 4, 3);
+
+		Graphics::TransparentSurface *scaled = src.scale(45, 26, true);
+		Graphics::TransparentSurface *rotated = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
+		Graphics::Surface blitted;
+		blitted.create(64, 40, src.format);
+		fillNoise(blitted, 6);
+		Graphics::Surface background;
+		background.copyFrom(blitted);
+		src.blit(blitted, 2, 3, Graphics::FLIP_NONE, nullptr, 0xFFFFFFFF, 45, 26);
+
+		// The same results from the cache, the second time around
+		src.setTransformCaching(true);
+		for (int i = 0; i < 2; ++i) {
+			Graphics::TransparentSurface *cachedScaled = src.scale(45, 26, true);
+			Graphics::TransparentSurface *cachedRotated = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
+			Graphics::Surface cachedBlitted;
+			cachedBlitted.copyFrom(background);
+			src.blit(cachedBlitted, 2, 3, Graphics::FLIP_NONE, nullptr, 0xFFFFFFFF, 45, 26);
+			TS_ASSERT(equals(*scaled, *cachedScaled));
+			TS_ASSERT(equals(*rotated, *cachedRotated));
+			TS_ASSERT(equals(blitted, cachedBlitted));
+			cachedScaled->free();
+			cachedRotated->free();
+			cachedBlitted.free();
+			delete cachedScaled;
+			delete cachedRotated;
+		}
+
+		// Changed pixels only show up once the cache is invalidated
+		fillNoise(src, 7);
+		src.invalidateTransformCache();
+		Graphics::TransparentSurface *cachedScaled = src.scale(45, 26, true);
+		src.setTransformCaching(false);
+		Graphics::TransparentSurface *uncachedScaled = src.scale(45, 26, true);
+		TS_ASSERT(!equals(*scaled, *cachedScaled));
+		TS_ASSERT(equals(*uncachedScaled, *cachedScaled));
+
+		cachedScaled->free();
+		uncachedScaled->free();
+		scaled->free();
+		rotated->free();
+		delete cachedScaled;
+		delete uncachedScaled;
+		delete scaled;
+		delete rotated;
+		blitted.free();
+		background.free();
+		src.free();
+	}
+};
@@ -0,0 +1,163 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	// Straightforward per-pixel version of the conversion done by the lookup tables
+	static uint32 convertReference(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, byte y, byte u, byte v) {
+		const int16 cr = v - 128;
+		const int16 cb = u - 128;
+		int rgb[3] = {
+			y + (int16)((0.419 / 0.299) * cr),
+			y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb),
+			y + (int16)((0.587 / 0.331) * cb)
+		};
+		for (int i = 0; i < 3; ++i) {
+			if (scale == Graphics::YUVToRGBManager::kScaleFull)
+				rgb[i] = CLIP(rgb[i], 0, 255);
+			else
+				rgb[i] = (CLIP(rgb[i], 16, 235) - 16) * 255 / 219;
+		}
+		return format.ARGBToColor(255, rgb[0], rgb[1], rgb[2]);
+	}
+
+	static byte *createNoise(int size, uint32 seed) {
+		byte *data = new byte[size];
+		for (int i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 16;
+		}
+		return data;
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	// Subsampling of 0 for YUV444, 1 for YUV420 and 2 for YUV410
+	static void check(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int subsampling) {
+		// Not a multiple of the vector size, and with padding at the end of the rows
+		const int width = 300, height = 12;
+		const int yPitch = width + 5;
+		const int uvWidth = (width >> subsampling) + 1;
+		const int uvPitch = uvWidth + 3;
+		const int uvHeight = (height >> subsampling) + 1;
+		byte *ySrc = createNoise(yPitch * height, 1);
+		byte *uSrc = createNoise(uvPitch * uvHeight, 2);
+		byte *vSrc = createNoise(uvPitch * uvHeight, 3);
+
+		Graphics::Surface surface;
+		surface.create(width, height, format);
+		if (subsampling == 0)
+			YUVToRGBMan.convert444(&surface, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+		else if (subsampling == 1)
+			YUVToRGBMan.convert420(&surface, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+		else
+			YUVToRGBMan.convert410(&surface, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+		int mismatches = 0;
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				byte u, v;
+				if (subsampling == 2) {
+					// Bilinear interpolation of the chroma
+					const int index = (y >> 2) * uvPitch + (x >> 2);
+					const int xDiff = x & 3, yDiff = y & 3;
+					u = (uSrc[index] * (4 - xDiff) * (4 - yDiff) + uSrc[index + 1] * xDiff * (4 - yDiff) +
+					     uSrc[index + uvPitch] * yDiff * (4 - xDiff) + uSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+					v = (vSrc[index] * (4 - xDiff) * (4 - yDiff) + vSrc[index + 1] * xDiff * (4 - yDiff) +
+					     vSrc[index + uvPitch] * yDiff * (4 - xDiff) + vSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+				} else {
+					u = uSrc[(y >> subsampling) * uvPitch + (x >> subsampling)];
+					v = vSrc[(y >> subsampling) * uvPitch + (x >> subsampling)];
+				}
+				if (getPixel(surface, x, y) != convertReference(format, scale, ySrc[y * yPitch + x], u, v))
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		surface.free();
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+	void checkFormats(int subsampling) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0),
+			// A channel across the middle of the pixels
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 10, 0, 20, 0)
+		};
+		for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+			check(formats[i], Graphics::YUVToRGBManager::kScaleFull, subsampling);
+			check(formats[i], Graphics::YUVToRGBManager::kScaleITU, subsampling);
+		}
+	}
+
+	// The planar frame version has to pick the same conversion as the explicit calls
+	static void checkFrame(int chromaShift) {
+		const int width = 64, height = 16;
+		byte *ySrc = createNoise(width * height, 1);
+		byte *uSrc = createNoise(width * height, 2);
+		byte *vSrc = createNoise(width * height, 3);
+
+		Graphics::YUVFrame frame;
+		frame.yPlane = ySrc;
+		frame.uPlane = uSrc;
+		frame.vPlane = vSrc;
+		frame.w = width;
+		frame.h = height;
+		frame.yPitch = width;
+		frame.uvPitch = width;
+		frame.chromaShift = chromaShift;
+		frame.scale = Graphics::YUVToRGBManager::kScaleFull;
+		TS_ASSERT_EQUALS(frame.getChromaWidth(), width >> chromaShift);
+		TS_ASSERT_EQUALS(frame.getChromaHeight(), height >> chromaShift);
+
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		Graphics::Surface expected, actual;
+		expected.create(width, height, format);
+		actual.create(width, height, format);
+		if (chromaShift == 0)
+			YUVToRGBMan.convert444(&expected, frame.scale, ySrc, uSrc, vSrc, width, height, width, width);
+		else if (chromaShift == 1)
+			YUVToRGBMan.convert420(&expected, frame.scale, ySrc, uSrc, vSrc, width, height, width, width);
+		else
+			YUVToRGBMan.convert410(&expected, frame.scale, ySrc, uSrc, vSrc, width, height, width, width);
+		YUVToRGBMan.convert(&actual, frame);
+		TS_ASSERT_EQUALS(memcmp(expected.getPixels(), actual.getPixels(), width * height * 4), 0);
+
+		expected.free();
+		actual.free();
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+public:
+	void test_convert444() {
+		checkFormats(0);
+	}
+
+	void test_convert420() {
+		checkFormats(1);
+	}
+
+	void test_convert410() {
+		checkFormats(2);
+	}
+
+	void test_convertFrame() {
+		checkFrame(0);
+		checkFrame(1);
+		checkFrame(2);
+	}
+};
@@ -5,7 +5,7 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/math/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -27,7 +27,7 @@ TEST_LIBS += test/null_osystem.o \
 	backends/modular-backend.o
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/libcommon.a
+TEST_LIBS +=	graphics/libgraphics.a audio/libaudio.a math/libmath.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -59,6 +59,23 @@ TEST_LIBS += backends/platform/psp/memory.o \
 	backends/platform/psp/trace.o
 endif
 
+# The benchmarks are not part of the tests, use the 'audio-benchmark' target
+# to run them. Sample files and ROMs are looked for in AUDIO_BENCHMARK_DATA.
+AUDIO_BENCHMARKS := $(srcdir)/test/audio/benchmark/*.h
+AUDIO_BENCHMARK_LIBS := $(TEST_LIBS)
+AUDIO_BENCHMARK_DATA ?= test/audio-benchmark-data
+
+ifdef USE_MT32EMU
+AUDIO_BENCHMARK_LIBS += audio/softsynth/mt32/libmt32.a
+endif
+
+# The graphics benchmarks are run with the 'graphics-benchmark' target, and
+# the ones of common/ with the 'common-benchmark' target.
+GRAPHICS_BENCHMARKS := $(srcdir)/test/graphics/benchmark/*.h
+GRAPHICS_BENCHMARK_LIBS := $(TEST_LIBS)
+COMMON_BENCHMARKS := $(srcdir)/test/common/benchmark/*.h
+COMMON_BENCHMARK_LIBS := $(TEST_LIBS)
+
 # Enable this to get an X11 GUI for the error reporter.
 #TEST_FLAGS   += --gui=X11Gui
 #TEST_LDFLAGS += -L/usr/X11R6/lib -lX11
@@ -72,13 +89,40 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+audio-benchmark: test/audio-benchmark
+	./test/audio-benchmark
+test/audio-benchmark: test/audio-benchmark.cpp $(AUDIO_BENCHMARK_LIBS)
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -DAUDIO_BENCHMARK_DATA=\"$(AUDIO_BENCHMARK_DATA)\" -o $@ test/audio-benchmark.cpp $(AUDIO_BENCHMARK_LIBS) $(TEST_LDFLAGS)
+test/audio-benchmark.cpp: $(AUDIO_BENCHMARKS)
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
+
+graphics-benchmark: test/graphics-benchmark
+	./test/graphics-benchmark
+test/graphics-benchmark: test/graphics-benchmark.cpp $(GRAPHICS_BENCHMARK_LIBS)
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ test/graphics-benchmark.cpp $(GRAPHICS_BENCHMARK_LIBS) $(TEST_LDFLAGS)
+test/graphics-benchmark.cpp: $(GRAPHICS_BENCHMARKS)
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
+
+common-benchmark: test/common-benchmark
+	./test/common-benchmark
+test/common-benchmark: test/common-benchmark.cpp $(COMMON_BENCHMARK_LIBS)
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ test/common-benchmark.cpp $(COMMON_BENCHMARK_LIBS) $(TEST_LDFLAGS)
+test/common-benchmark.cpp: $(COMMON_BENCHMARKS)
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
+
 clean: clean-test
 clean-test:
 	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat
+	-$(RM) test/audio-benchmark.cpp test/audio-benchmark
+	-$(RM) test/graphics-benchmark.cpp test/graphics-benchmark
+	-$(RM) test/common-benchmark.cpp test/common-benchmark
 	-rmdir test/engine-data
 
 copy-dat:
 	$(MKDIR) test/engine-data
 	$(CP) $(srcdir)/dists/engine-data/encoding.dat test/engine-data/encoding.dat
 
-.PHONY: test clean-test copy-dat
+.PHONY: test audio-benchmark graphics-benchmark common-benchmark clean-test copy-dat
@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/algorithm.h"
+#include "common/memstream.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -70,6 +72,7 @@ namespace Video {
 #define ID_PRMI MKTAG('P','R','M','I')
 #define ID_STRN MKTAG('s','t','r','n')
 #define ID_INDX MKTAG('i','n','d','x')
+#define ID_AVIX MKTAG('A','V','I','X')
 
 // Stream Types
 enum {
@@ -121,6 +124,7 @@ void AVIDecoder::initCommon() {
 	_fileStream = 0;
 	_videoTrackCounter = _audioTrackCounter = 0;
 	_lastAddedTrack = nullptr;
+	_hasExtendedRiff = false;
 	memset(&_header, 0, sizeof(_header));
 	_transparencyTrack.track = nullptr;
 }
@@ -211,9 +215,11 @@ bool AVIDecoder::parseNextChunk() {
 	case ID_ISFT: // Metadata, safe to ignore
 	case ID_DISP: // Metadata, should be safe to ignore
 	case ID_DMLH: // OpenDML extension, contains an extra total frames field, safe to ignore
-	case ID_INDX: // OpenDML extension, contains another type of index
 		skipChunk(size);
 		break;
+	case ID_INDX: // OpenDML extension, contains another type of index
+		readSuperIndex(size);
+		break;
 	case ID_STRN: // Metadata, safe to ignore
 		readStreamName(size);
 		break;
@@ -408,6 +414,43 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 	while (_fileStream->pos() < fileSize && parseNextChunk())
 		;
 
+	// OpenDML files continue with 'AVIX' lists, each holding more of the movie
+	uint32 firstMovieListEnd = _movieListEnd;
+	if (_foundMovieList) {
+		_fileStream->seek(8 + fileSize + (fileSize & 1));
+
+		while (_fileStream->readUint32BE() == ID_RIFF && !_fileStream->eos()) {
+			uint32 riffSize = _fileStream->readUint32LE();
+			uint32 riffEnd = _fileStream->pos() + riffSize + (riffSize & 1);
+			if (_fileStream->readUint32BE() != ID_AVIX)
+				break;
+
+			while ((uint32)_fileStream->pos() + 8 < riffEnd) {
+				uint32 tag = _fileStream->readUint32BE();
+				uint32 size = _fileStream->readUint32LE();
+				uint32 next = _fileStream->pos() + size + (size & 1);
+				if (_fileStream->eos())
+					break;
+
+				if (tag == ID_LIST && _fileStream->readUint32BE() == ID_MOVI) {
+					_movieListEnd = next;
+					_hasExtendedRiff = true;
+				}
+
+				_fileStream->seek(next);
+			}
+
+			_fileStream->seek(riffEnd);
+		}
+	}
+
+	// The old index only covers the first RIFF, the OpenDML one all of them,
+	// but for the palette changes
+	if (!_superIndexOffsets.empty() && (_indexEntries.empty() || _hasExtendedRiff))
+		readOpenDMLIndex(_indexEntries.empty() ? 0 : firstMovieListEnd);
+
+	_indexEntries.buildStreamTables();
+
 	if (!_decodedHeader) {
 		warning("Failed to parse AVI header");
 		close();
@@ -466,6 +509,13 @@ void AVIDecoder::close() {
 	_movieListEnd = 0;
 
 	_indexEntries.clear();
+	_superIndexOffsets.clear();
+	_hasExtendedRiff = false;
+
+	for (uint32 i = 0; i < _recLists.size(); i++)
+		free(_recLists[i].data);
+	_recLists.clear();
+
 	memset(&_header, 0, sizeof(_header));
 
 	_videoTracks.clear();
@@ -510,14 +560,14 @@ void AVIDecoder::handleNextPacket(TrackStatus &status) {
 	if (status.track->getTrackType() == Track::kTrackTypeAudio && !shouldQueueAudio(status))
 		return;
 
-	// Seek to where we shall start searching
-	_fileStream->seek(status.chunkSearchOffset);
+	// Start searching where we left off
+	uint32 pos = status.chunkSearchOffset;
 	bool isReversed = false;
 	AVIVideoTrack *videoTrack = nullptr;
 
 	for (;;) {
 		// If there's no more to search, bail out
-		if ((uint32)_fileStream->pos() + 8 >= _movieListEnd) {
+		if (pos + 8 >= _movieListEnd) {
 			if (status.track->getTrackType() == Track::kTrackTypeVideo) {
 				// Horrible AVI video has a premature end
 				// Force the frame to be the last frame
@@ -528,33 +578,45 @@ void AVIDecoder::handleNextPacket(TrackStatus &status) {
 			break;
 		}
 
-		uint32 nextTag = _fileStream->readUint32BE();
-		uint32 size = _fileStream->readUint32LE();
+		uint32 nextTag, size;
+		readChunkHeader(pos, nextTag, size);
+		pos += 8;
 
 		if (nextTag == ID_LIST) {
-			// A list of audio/video chunks
-			if (_fileStream->readUint32BE() != ID_REC)
+			_fileStream->seek(pos);
+			uint32 listType = _fileStream->readUint32BE();
+			pos += 4;
+
+			if (listType == ID_REC) {
+				// A list of audio/video chunks
+				cacheRecList(pos, size - 4);
+			} else if (listType != ID_MOVI || !_hasExtendedRiff) {
 				error("Expected 'rec ' LIST");
+			}
 
 			continue;
-		} else if (nextTag == ID_JUNK || nextTag == ID_IDX1) {
-			skipChunk(size);
+		} else if (nextTag == ID_RIFF && _hasExtendedRiff) {
+			// An OpenDML 'AVIX' extension, its movie list follows
+			pos += 4;
+			continue;
+		} else if (nextTag == ID_JUNK || nextTag == ID_IDX1 || (nextTag >> 16) == MKTAG16('i', 'x')) {
+			pos += size + (size & 1);
 			continue;
 		}
 
 		// Only accept chunks for this stream
 		uint32 streamIndex = getStreamIndex(nextTag);
 		if (streamIndex != status.index) {
-			skipChunk(size);
+			pos += size + (size & 1);
 			continue;
 		}
 
 		Common::SeekableReadStream *chunk = 0;
 
-		if (size != 0) {
-			chunk = _fileStream->readStream(size);
-			_fileStream->skip(size & 1);
-		}
+		if (size != 0)
+			chunk = readChunk(pos, size);
+
+		pos += size + (size & 1);
 
 		if (status.track->getTrackType() == Track::kTrackTypeAudio) {
 			if (getStreamType(nextTag) != kStreamTypeAudio)
@@ -583,10 +645,92 @@ void AVIDecoder::handleNextPacket(TrackStatus &status) {
 
 	if (!isReversed) {
 		// Start us off in this position next time
-		status.chunkSearchOffset = _fileStream->pos();
+		status.chunkSearchOffset = pos;
+	}
+
+	releaseRecLists();
+}
+
+void AVIDecoder::cacheRecList(uint32 start, uint32 size) {
+	// Lists too large to be worth keeping around are read chunk by chunk
+	if (size == 0 || size > kMaxRecListSize || findCachedData(start, size))
+		return;
+
+	RecList list;
+	list.start = start;
+	list.end = start + size;
+	list.data = (byte *)malloc(size);
+	if (!list.data)
+		return;
+
+	_fileStream->seek(start);
+	if (_fileStream->read(list.data, size) != size) {
+		free(list.data);
+		return;
+	}
+
+	_recLists.push_back(list);
+}
+
+void AVIDecoder::releaseRecLists() {
+	// Drop the lists all the tracks are done with. The audio runs a few
+	// frames ahead of the video, so only a handful are ever kept.
+	uint32 minOffset = 0xFFFFFFFF;
+	for (uint32 i = 0; i < _videoTracks.size(); i++)
+		minOffset = MIN(minOffset, _videoTracks[i].chunkSearchOffset);
+	for (uint32 i = 0; i < _audioTracks.size(); i++) {
+		if (!_audioTracks[i].track->endOfTrack())
+			minOffset = MIN(minOffset, _audioTracks[i].chunkSearchOffset);
+	}
+	if (_transparencyTrack.track)
+		minOffset = MIN(minOffset, _transparencyTrack.chunkSearchOffset);
+
+	for (uint32 i = 0; i < _recLists.size();) {
+		if (_recLists[i].end <= minOffset || _recLists.size() > kMaxRecLists) {
+			free(_recLists[i].data);
+			_recLists.remove_at(i);
+		} else {
+			i++;
+		}
 	}
 }
 
+const byte *AVIDecoder::findCachedData(uint32 offset, uint32 size) const {
+	for (uint32 i = 0; i < _recLists.size(); i++) {
+		const RecList &list = _recLists[i];
+		if (offset >= list.start && offset + size <= list.end)
+			return list.data + (offset - list.start);
+	}
+
+	return nullptr;
+}
+
+void AVIDecoder::readChunkHeader(uint32 offset, uint32 &tag, uint32 &size) {
+	const byte *data = findCachedData(offset, 8);
+
+	if (data) {
+		tag = READ_BE_UINT32(data);
+		size = READ_LE_UINT32(data + 4);
+	} else {
+		_fileStream->seek(offset);
+		tag = _fileStream->readUint32BE();
+		size = _fileStream->readUint32LE();
+	}
+}
+
+Common::SeekableReadStream *AVIDecoder::readChunk(uint32 offset, uint32 size) {
+	const byte *data = findCachedData(offset, size);
+
+	if (!data) {
+		_fileStream->seek(offset);
+		return _fileStream->readStream(size);
+	}
+
+	byte *copy = (byte *)malloc(size);
+	memcpy(copy, data, size);
+	return new Common::MemoryReadStream(copy, size, DisposeAfterUse::YES);
+}
+
 bool AVIDecoder::shouldQueueAudio(TrackStatus& status) {
 	// Sanity check:
 	if (status.track->getTrackType() != Track::kTrackTypeAudio)
@@ -656,55 +800,27 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	// Reset any palette, if necessary
 	videoTrack->useInitialPalette();
 
-	int lastKeyFrame = -1;
-	int frameIndex = -1;
-	uint curFrame = 0;
-
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
-
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
-
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(index.id);
+	// Find the frame, and the keyframe to decode from, through the index
+	if (frame >= _indexEntries.getFrameCount(videoIndex)) // This shouldn't happen.
+		return false;
 
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
+	uint frameIndex = _indexEntries.getFrameEntry(videoIndex, frame);
+	uint keyFrame = _indexEntries.findKeyFrame(videoIndex, frame);
 
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+	// We need to handle any palette change before the frame since there's no
+	// flag to tell if this is a "key" palette.
+	const Common::Array<uint32> &palettes = _indexEntries.getPaletteEntries(videoIndex);
+	for (uint32 i = 0; i < palettes.size() && palettes[i] < frameIndex; i++) {
+		// Decode the palette
+		const OldIndex &index = _indexEntries[palettes[i]];
+		Common::SeekableReadStream *chunk = 0;
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
+		if (index.size != 0)
+			chunk = readChunk(index.offset + 8, index.size);
 
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
-			}
-
-			curFrame++;
-		}
+		videoTrack->loadPaletteFromChunk(chunk);
 	}
 
-	if (frameIndex < 0) // This shouldn't happen.
-		return false;
-
 	// Update all the audio tracks
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
 		AVIAudioTrack *audioTrack = (AVIAudioTrack *)_audioTracks[i].track;
@@ -715,25 +831,11 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
+		if (frame < _indexEntries.getEntryCount(_audioTracks[i].index)) {
+			uint32 j = _indexEntries.getEntry(_audioTracks[i].index, frame);
 			const OldIndex &index = _indexEntries[j];
-
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
-
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
-
-				chunksFound++;
-			}
+			audioTrack->queueSound(readChunk(index.offset + 8, index.size));
+			_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
@@ -741,25 +843,12 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	}
 
 	// Decode from keyFrame to curFrame - 1
-	for (int i = lastKeyFrame; i < frameIndex; i++) {
-		if (_indexEntries[i].id == ID_REC)
-			continue;
-
-		if (getStreamIndex(_indexEntries[i].id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(_indexEntries[i].id);
-
-		// Ignore palettes, they were already handled
-		if (streamType == kStreamTypePaletteChange)
-			continue;
-
-		// Frame, hopefully
-		_fileStream->seek(_indexEntries[i].offset + 8);
+	for (uint i = keyFrame; i < frame; i++) {
+		const OldIndex &index = _indexEntries[_indexEntries.getFrameEntry(videoIndex, i)];
 		Common::SeekableReadStream *chunk = 0;
 
-		if (_indexEntries[i].size != 0)
-			chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = readChunk(index.offset + 8, index.size);
 
 		videoTrack->decodeFrame(chunk);
 	}
@@ -864,6 +953,94 @@ void AVIDecoder::readOldIndex(uint32 size) {
 	}
 }
 
+void AVIDecoder::readSuperIndex(uint32 size) {
+	uint32 startPos = _fileStream->pos();
+
+	uint16 longsPerEntry = _fileStream->readUint16LE();
+	_fileStream->readByte(); // index sub type
+	byte indexType = _fileStream->readByte();
+	uint32 entryCount = _fileStream->readUint32LE();
+	_fileStream->readUint32BE(); // chunk id
+	_fileStream->skip(12); // reserved
+
+	// Only the index of the 'ix##' chunks is of any use, the standard
+	// indices themselves are read once all of the file is known
+	if (indexType == kIndexOfIndexes && longsPerEntry == 4) {
+		debug(7, "Super Index: %d entries", entryCount);
+
+		for (uint32 i = 0; i < entryCount && (uint32)_fileStream->pos() + 16 <= startPos + size; i++) {
+			uint32 offsetLow = _fileStream->readUint32LE();
+			uint32 offsetHigh = _fileStream->readUint32LE();
+			_fileStream->skip(8); // size and duration
+
+			if (offsetHigh != 0) {
+				warning("AVI index beyond 4GB, ignoring the rest");
+				break;
+			}
+
+			_superIndexOffsets.push_back(offsetLow);
+		}
+	}
+
+	_fileStream->seek(startPos + size + (size & 1));
+}
+
+void AVIDecoder::readOpenDMLIndex(uint32 startOffset) {
+	for (uint32 i = 0; i < _superIndexOffsets.size(); i++) {
+		_fileStream->seek(_superIndexOffsets[i]);
+
+		uint32 tag = _fileStream->readUint32BE();
+		_fileStream->readUint32LE(); // size
+		if ((tag >> 16) != MKTAG16('i', 'x')) {
+			warning("Invalid OpenDML index chunk '%s'", tag2str(tag));
+			continue;
+		}
+
+		uint16 longsPerEntry = _fileStream->readUint16LE();
+		_fileStream->readByte(); // index sub type
+		byte indexType = _fileStream->readByte();
+		uint32 entryCount = _fileStream->readUint32LE();
+		uint32 chunkId = _fileStream->readUint32BE();
+		uint32 baseLow = _fileStream->readUint32LE();
+		uint32 baseHigh = _fileStream->readUint32LE();
+		_fileStream->readUint32LE(); // reserved
+
+		if (indexType != kIndexOfChunks || longsPerEntry != 2 || baseHigh != 0)
+			continue;
+
+		debug(7, "OpenDML Index: Tag '%s', %d entries", tag2str(chunkId), entryCount);
+
+		for (uint32 j = 0; j < entryCount && !_fileStream->eos(); j++) {
+			// The offsets point to the data, past the chunk header. The top
+			// bit of the size is set on the frames which aren't keyframes.
+			uint32 offset = _fileStream->readUint32LE();
+			uint32 size = _fileStream->readUint32LE();
+
+			uint64 chunkOffset = (uint64)baseLow + offset - 8;
+			if (chunkOffset > 0xFFFFFFFF)
+				break;
+
+			// Already in the old index
+			if (chunkOffset < startOffset)
+				continue;
+
+			OldIndex indexEntry;
+			indexEntry.id = chunkId;
+			indexEntry.flags = (size & 0x80000000) ? 0 : AVIIF_INDEX;
+			indexEntry.offset = (uint32)chunkOffset;
+			indexEntry.size = size & 0x7FFFFFFF;
+			_indexEntries.push_back(indexEntry);
+		}
+	}
+
+	// Playback relies on the entries coming in the order of the file,
+	// as they do in the old index
+	struct OffsetLess {
+		bool operator()(const OldIndex &a, const OldIndex &b) const { return a.offset < b.offset; }
+	};
+	Common::sort(_indexEntries.begin(), _indexEntries.end(), OffsetLess());
+}
+
 void AVIDecoder::checkTruemotion1() {
 	// If we got here from loadStream(), we know the track is valid
 	assert(!_videoTracks.empty());
@@ -1145,15 +1322,65 @@ AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
 }
 
 AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
-	for (uint idx = 0, frameCtr = 0; idx < size(); ++idx) {
-		if ((*this)[idx].id != ID_REC &&
-				AVIDecoder::getStreamIndex((*this)[idx].id) == index) {
-			if (frameCtr++ == frameNumber)
-				return &(*this)[idx];
+	if (frameNumber >= getEntryCount(index))
+		return nullptr;
+
+	return &(*this)[_streams[index].entries[frameNumber]];
+}
+
+void AVIDecoder::IndexEntries::buildStreamTables() {
+	_streams.clear();
+
+	for (uint idx = 0; idx < size(); ++idx) {
+		const OldIndex &entry = (*this)[idx];
+		if (entry.id == ID_REC)
+			continue;
+
+		uint index = AVIDecoder::getStreamIndex(entry.id);
+		if (index >= _streams.size())
+			_streams.resize(index + 1);
+
+		StreamTables &stream = _streams[index];
+		stream.entries.push_back(idx);
+
+		if ((entry.id & 0xFFFF) == kStreamTypePaletteChange) {
+			stream.palettes.push_back(idx);
+		} else {
+			// The first frame has to be a keyframe
+			if ((entry.flags & AVIIF_INDEX) || stream.frames.empty())
+				stream.keyFrames.push_back(stream.frames.size());
+			stream.frames.push_back(idx);
 		}
 	}
+}
 
-	return nullptr;
+void AVIDecoder::IndexEntries::clear() {
+	Common::Array<OldIndex>::clear();
+	_streams.clear();
+}
+
+uint AVIDecoder::IndexEntries::getEntryCount(uint index) const {
+	return index < _streams.size() ? _streams[index].entries.size() : 0;
+}
+
+uint AVIDecoder::IndexEntries::getFrameCount(uint index) const {
+	return index < _streams.size() ? _streams[index].frames.size() : 0;
+}
+
+uint AVIDecoder::IndexEntries::findKeyFrame(uint index, uint frame) const {
+	// Binary search for the last keyframe not after the frame. The first
+	// frame always is one.
+	const Common::Array<uint32> &keyFrames = _streams[index].keyFrames;
+	uint lo = 0, hi = keyFrames.size();
+	while (hi - lo > 1) {
+		uint mid = (lo + hi) / 2;
+		if (keyFrames[mid] <= frame)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return keyFrames[lo];
 }
 
 } // End of namespace Video
@@ -157,6 +157,12 @@ protected:
 		AVIIF_INDEX = 0x10
 	};
 
+	// OpenDML index types
+	enum IndexType {
+		kIndexOfIndexes = 0x00,
+		kIndexOfChunks = 0x01
+	};
+
 	struct AVIHeader {
 		uint32 size;
 		uint32 microSecondsPerFrame;
@@ -314,13 +320,72 @@ protected:
 	class IndexEntries : public Common::Array<OldIndex> {
 	public:
 		OldIndex *find(uint index, uint frameNumber);
+
+		/**
+		 * Build the per stream tables used by the lookups below, once all
+		 * the entries have been added.
+		 */
+		void buildStreamTables();
+		void clear();
+
+		/** Number of the entries of a stream, palette changes included */
+		uint getEntryCount(uint index) const;
+		/** Position of the nth entry of a stream, palette changes included */
+		uint getEntry(uint index, uint n) const { return _streams[index].entries[n]; }
+
+		/** Number of the frames of a stream, palette changes excluded */
+		uint getFrameCount(uint index) const;
+		/** Position of the entry of the nth frame of a stream */
+		uint getFrameEntry(uint index, uint frame) const { return _streams[index].frames[frame]; }
+		/** The last keyframe of a stream at or before the given frame */
+		uint findKeyFrame(uint index, uint frame) const;
+		/** Positions of the palette changes of a stream */
+		const Common::Array<uint32> &getPaletteEntries(uint index) const { return _streams[index].palettes; }
+
+	private:
+		struct StreamTables {
+			Common::Array<uint32> entries;
+			Common::Array<uint32> frames;
+			Common::Array<uint32> keyFrames;
+			Common::Array<uint32> palettes;
+		};
+
+		Common::Array<StreamTables> _streams;
 	};
 
 	AVIHeader _header;
 
 	void readOldIndex(uint32 size);
+	void readSuperIndex(uint32 size);
+	void readOpenDMLIndex(uint32 startOffset);
 	IndexEntries _indexEntries;
 
+	// Offsets of the OpenDML standard index chunks ('ix##') of all the streams
+	Common::Array<uint32> _superIndexOffsets;
+	bool _hasExtendedRiff;
+
+	/**
+	 * A 'rec ' list of interleaved chunks read in whole, so that the chunks
+	 * of all the tracks in it come from a single read.
+	 */
+	struct RecList {
+		uint32 start, end;
+		byte *data;
+	};
+
+	enum {
+		kMaxRecListSize = 1024 * 1024,
+		kMaxRecLists = 16
+	};
+
+	Common::Array<RecList> _recLists;
+
+	void cacheRecList(uint32 start, uint32 size);
+	void releaseRecLists();
+	const byte *findCachedData(uint32 offset, uint32 size) const;
+	void readChunkHeader(uint32 offset, uint32 &tag, uint32 &size);
+	Common::SeekableReadStream *readChunk(uint32 offset, uint32 size);
+
 	Common::SeekableReadStream *_fileStream;
 	bool _decodedHeader;
 	bool _foundMovieList;
@@ -39,6 +39,8 @@
 #include "common/rdft.h"
 #include "common/dct.h"
 #include "common/system.h"
+#include "common/memstream.h"
+#include "common/threadpool.h"
 
 #include "graphics/yuv_to_rgb.h"
 #include "graphics/surface.h"
@@ -203,13 +205,20 @@ void BinkDecoder::readNextPacket() {
 	uint32 videoPacketStart = _bink->pos();
 	uint32 videoPacketEnd   = _bink->pos() + frameSize;
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
+	// The packet is read as a whole, so that the planes can be decoded from it concurrently
+	byte *data = (byte *)malloc(videoPacketEnd - videoPacketStart);
+	_bink->read(data, videoPacketEnd - videoPacketStart);
+
+	frame.data     = data;
+	frame.dataSize = videoPacketEnd - videoPacketStart;
+	frame.bits     = new Common::BitStream32LELSB(new Common::MemoryReadStream(data, frame.dataSize, DisposeAfterUse::YES), DisposeAfterUse::YES);
 
 	videoTrack->decodePacket(frame);
 
 	delete frame.bits;
 	frame.bits = 0;
+	frame.data = 0;
+	frame.dataSize = 0;
 }
 
 VideoDecoder::AudioTrack *BinkDecoder::getAudioTrack(int index) {
@@ -222,7 +231,7 @@ VideoDecoder::AudioTrack *BinkDecoder::getAudioTrack(int index) {
 	return (AudioTrack *)track;
 }
 
-BinkDecoder::VideoFrame::VideoFrame() : bits(0) {
+BinkDecoder::VideoFrame::VideoFrame() : bits(0), data(0), dataSize(0) {
 }
 
 BinkDecoder::VideoFrame::~VideoFrame() {
@@ -249,23 +258,33 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, const G
 	for (int i = 0; i < 16; i++)
 		_huffman[i] = 0;
 
-	for (int i = 0; i < kSourceMAX; i++) {
-		_bundles[i].countLength = 0;
+	_planeOffsets = kPlaneOffsetsUnchecked;
 
-		_bundles[i].huffman.index = 0;
-		for (int j = 0; j < 16; j++)
-			_bundles[i].huffman.symbols[j] = j;
+	for (int p = 0; p < kPlaneStateMAX; p++) {
+		PlaneState &plane = _planeStates[p];
 
-		_bundles[i].data     = 0;
-		_bundles[i].dataEnd  = 0;
-		_bundles[i].curDec   = 0;
-		_bundles[i].curPtr   = 0;
-	}
+		plane.bits = 0;
 
-	for (int i = 0; i < 16; i++) {
-		_colHighHuffman[i].index = 0;
-		for (int j = 0; j < 16; j++)
-			_colHighHuffman[i].symbols[j] = j;
+		for (int i = 0; i < kSourceMAX; i++) {
+			plane.bundles[i].countLength = 0;
+
+			plane.bundles[i].huffman.index = 0;
+			for (int j = 0; j < 16; j++)
+				plane.bundles[i].huffman.symbols[j] = j;
+
+			plane.bundles[i].data     = 0;
+			plane.bundles[i].dataEnd  = 0;
+			plane.bundles[i].curDec   = 0;
+			plane.bundles[i].curPtr   = 0;
+		}
+
+		for (int i = 0; i < 16; i++) {
+			plane.colHighHuffman[i].index = 0;
+			for (int j = 0; j < 16; j++)
+				plane.colHighHuffman[i].symbols[j] = j;
+		}
+
+		plane.colLastVal = 0;
 	}
 
 	// Make the surface even-sized:
@@ -292,6 +311,12 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, const G
 	_uvBlockWidth  = (width  + 15) >> 4;
 	_uvBlockHeight = (height + 15) >> 4;
 
+	_outputYUV = false;
+	_yuvFrame.w = width;
+	_yuvFrame.h = height;
+	_yuvFrame.yPitch = _yBlockWidth * 8;
+	_yuvFrame.uvPitch = _uvBlockWidth * 8;
+
 	// The planes are sized according to the number of blocks
 	_curPlanes[0] = new byte[_yBlockWidth  * 8 * _yBlockHeight  * 8]; // Y
 	_curPlanes[1] = new byte[_uvBlockWidth * 8 * _uvBlockHeight * 8]; // U, 1/4 resolution
@@ -473,29 +498,16 @@ bool BinkDecoder::BinkVideoTrack::rewind() {
 void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	assert(frame.bits);
 
-	if (_hasAlpha) {
-		if (_id == kBIKiID)
-			frame.bits->skip(32);
-
-		decodePlane(frame, 3, false);
-	}
-
-	if (_id == kBIKiID)
-		frame.bits->skip(32);
-
-	for (int i = 0; i < 3; i++) {
-		int planeIdx = ((i == 0) || !_swapPlanes) ? i : (i ^ 3);
-
-		decodePlane(frame, planeIdx, i != 0);
-
-		if (frame.bits->pos() >= frame.bits->size())
-			break;
-	}
+	if (!decodePlanesConcurrently(frame))
+		decodePlanes(frame);
 
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
-	if (_hasAlpha) {
+	if (_outputYUV) {
+		// The planes become the reference planes below, and are handed
+		// out from there
+	} else if (_hasAlpha) {
 		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
 		YUVToRGBMan.convert420Alpha(&_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
 				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
@@ -509,10 +521,143 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	for (int i = 0; i < 4; i++)
 		SWAP(_curPlanes[i], _oldPlanes[i]);
 
+	if (_outputYUV) {
+		_yuvFrame.yPlane = _oldPlanes[0];
+		_yuvFrame.uPlane = _oldPlanes[1];
+		_yuvFrame.vPlane = _oldPlanes[2];
+	}
+
 	_curFrame++;
 }
 
-void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
+BinkDecoder::BinkVideoTrack::PlaneState &BinkDecoder::BinkVideoTrack::getPlaneState(int planeIdx) {
+	if (planeIdx == 0)
+		return _planeStates[kPlaneStateLuma];
+	if (planeIdx == 3)
+		return _planeStates[kPlaneStateAlpha];
+
+	return _planeStates[kPlaneStateChroma];
+}
+
+void BinkDecoder::BinkVideoTrack::decodePlanes(VideoFrame &frame) {
+	// In BIKi packets, the alpha and luma planes start with the offset of the
+	// end of their data. Check whether they hold for the first frames.
+	bool offsetsValid = true;
+
+	for (int i = 0; i < kPlaneStateMAX; i++)
+		_planeStates[i].bits = frame.bits;
+
+	if (_hasAlpha) {
+		uint32 alphaEnd = (_id == kBIKiID) ? frame.bits->getBits(32) : 0;
+
+		decodePlane(getPlaneState(3), 3, false);
+
+		offsetsValid = offsetsValid && (frame.bits->pos() == alphaEnd * 8);
+	}
+
+	uint32 lumaEnd = (_id == kBIKiID) ? frame.bits->getBits(32) : 0;
+
+	for (int i = 0; i < 3; i++) {
+		int planeIdx = ((i == 0) || !_swapPlanes) ? i : (i ^ 3);
+
+		decodePlane(getPlaneState(planeIdx), planeIdx, i != 0);
+
+		if (i == 0)
+			offsetsValid = offsetsValid && (frame.bits->pos() == lumaEnd * 8);
+
+		if (frame.bits->pos() >= frame.bits->size())
+			break;
+	}
+
+	for (int i = 0; i < kPlaneStateMAX; i++)
+		_planeStates[i].bits = 0;
+
+	if (_id == kBIKiID && _planeOffsets == kPlaneOffsetsUnchecked)
+		_planeOffsets = offsetsValid ? kPlaneOffsetsValid : kPlaneOffsetsInvalid;
+}
+
+bool BinkDecoder::BinkVideoTrack::decodePlanesConcurrently(VideoFrame &frame) {
+	if (_planeOffsets != kPlaneOffsetsValid || !frame.data || Common::ThreadPool::instance().getNumWorkers() == 0)
+		return false;
+
+	// The alpha plane, the luma plane, and the chroma planes one after the other
+	PlaneJob jobs[3];
+	int jobCount = 0;
+	uint32 pos = 0;
+
+	for (int i = (_hasAlpha ? 0 : 1); i < 3; i++) {
+		PlaneJob &job = jobs[jobCount++];
+
+		job.track = this;
+		job.data  = frame.data;
+		job.valid = false;
+		job.planes[1] = -1;
+
+		if (i == 2) {
+			job.planes[0] = _swapPlanes ? 2 : 1;
+			job.planes[1] = _swapPlanes ? 1 : 2;
+			job.start = pos;
+			job.end   = frame.dataSize;
+			job.exact = false;
+			break;
+		}
+
+		if (pos + 4 > frame.dataSize)
+			return false;
+
+		job.planes[0] = (i == 0) ? 3 : 0;
+		job.start = pos + 4;
+		job.end   = READ_LE_UINT32(frame.data + pos);
+		job.exact = true;
+
+		if ((job.end & 3) || (job.end < job.start) || (job.end > frame.dataSize))
+			return false;
+
+		pos = job.end;
+	}
+
+	// Without chroma data, the packet ends with the luma plane
+	if (jobs[jobCount - 1].start >= jobs[jobCount - 1].end)
+		jobCount--;
+
+	Common::TaskGroup group;
+	for (int i = 1; i < jobCount; i++)
+		group.run(&decodePlaneJob, &jobs[i]);
+	decodePlaneJob(&jobs[0]);
+	group.wait();
+
+	for (int i = 0; i < jobCount; i++) {
+		if (!jobs[i].valid) {
+			// The planes only write to the current planes, so they can just be decoded again
+			warning("Bink: Unexpected plane offsets, decoding the planes serially");
+			_planeOffsets = kPlaneOffsetsInvalid;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void BinkDecoder::BinkVideoTrack::decodePlaneJob(void *refCon) {
+	PlaneJob &job = *(PlaneJob *)refCon;
+
+	Common::BitStream32LELSB bits(new Common::MemoryReadStream(job.data + job.start, job.end - job.start), DisposeAfterUse::YES);
+
+	for (int i = 0; i < 2 && job.planes[i] >= 0; i++) {
+		PlaneState &plane = job.track->getPlaneState(job.planes[i]);
+
+		plane.bits = &bits;
+		job.track->decodePlane(plane, job.planes[i], job.planes[i] == 1 || job.planes[i] == 2);
+		plane.bits = 0;
+
+		if (bits.pos() >= bits.size())
+			break;
+	}
+
+	job.valid = !job.exact || (bits.pos() == bits.size());
+}
+
+void BinkDecoder::BinkVideoTrack::decodePlane(PlaneState &plane, int planeIdx, bool isChroma) {
 	uint32 blockWidth  = isChroma ? _uvBlockWidth  : _yBlockWidth;
 	uint32 blockHeight = isChroma ? _uvBlockHeight : _yBlockHeight;
 	uint32 width       = blockWidth  * 8;
@@ -520,7 +665,7 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 	DecodeContext ctx;
 
-	ctx.video     = &video;
+	ctx.plane     = &plane;
 	ctx.planeIdx  = planeIdx;
 	ctx.destStart = _curPlanes[planeIdx];
 	ctx.destEnd   = _curPlanes[planeIdx] + width * height;
@@ -538,27 +683,27 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 	}
 
 	for (int i = 0; i < kSourceMAX; i++) {
-		_bundles[i].countLength = _bundles[i].countLengths[isChroma ? 1 : 0];
+		plane.bundles[i].countLength = plane.bundles[i].countLengths[isChroma ? 1 : 0];
 
-		readBundle(video, (Source) i);
+		readBundle(plane, (Source) i);
 	}
 
 	for (ctx.blockY = 0; ctx.blockY < blockHeight; ctx.blockY++) {
-		readBlockTypes  (video, _bundles[kSourceBlockTypes]);
-		readBlockTypes  (video, _bundles[kSourceSubBlockTypes]);
-		readColors      (video, _bundles[kSourceColors]);
-		readPatterns    (video, _bundles[kSourcePattern]);
-		readMotionValues(video, _bundles[kSourceXOff]);
-		readMotionValues(video, _bundles[kSourceYOff]);
-		readDCS         (video, _bundles[kSourceIntraDC], kDCStartBits, false);
-		readDCS         (video, _bundles[kSourceInterDC], kDCStartBits, true);
-		readRuns        (video, _bundles[kSourceRun]);
+		readBlockTypes  (plane, plane.bundles[kSourceBlockTypes]);
+		readBlockTypes  (plane, plane.bundles[kSourceSubBlockTypes]);
+		readColors      (plane, plane.bundles[kSourceColors]);
+		readPatterns    (plane, plane.bundles[kSourcePattern]);
+		readMotionValues(plane, plane.bundles[kSourceXOff]);
+		readMotionValues(plane, plane.bundles[kSourceYOff]);
+		readDCS         (plane, plane.bundles[kSourceIntraDC], kDCStartBits, false);
+		readDCS         (plane, plane.bundles[kSourceInterDC], kDCStartBits, true);
+		readRuns        (plane, plane.bundles[kSourceRun]);
 
 		ctx.dest = ctx.destStart + 8 * ctx.blockY * ctx.pitch;
 		ctx.prev = ctx.prevStart + 8 * ctx.blockY * ctx.pitch;
 
 		for (ctx.blockX = 0; ctx.blockX < blockWidth; ctx.blockX++, ctx.dest += 8, ctx.prev += 8) {
-			BlockType blockType = (BlockType) getBundleValue(kSourceBlockTypes);
+			BlockType blockType = (BlockType) getBundleValue(plane, kSourceBlockTypes);
 
 			// 16x16 block type on odd line means part of the already decoded block, so skip it
 			if ((ctx.blockY & 1) && (blockType == kBlockScaled)) {
@@ -607,28 +752,28 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 	}
 
-	if (video.bits->pos() & 0x1F) // next plane data starts at 32-bit boundary
-		video.bits->skip(32 - (video.bits->pos() & 0x1F));
+	if (plane.bits->pos() & 0x1F) // next plane data starts at 32-bit boundary
+		plane.bits->skip(32 - (plane.bits->pos() & 0x1F));
 
 }
 
-void BinkDecoder::BinkVideoTrack::readBundle(VideoFrame &video, Source source) {
+void BinkDecoder::BinkVideoTrack::readBundle(PlaneState &plane, Source source) {
 	if (source == kSourceColors) {
 		for (int i = 0; i < 16; i++)
-			readHuffman(video, _colHighHuffman[i]);
+			readHuffman(plane, plane.colHighHuffman[i]);
 
-		_colLastVal = 0;
+		plane.colLastVal = 0;
 	}
 
 	if ((source != kSourceIntraDC) && (source != kSourceInterDC))
-		readHuffman(video, _bundles[source].huffman);
+		readHuffman(plane, plane.bundles[source].huffman);
 
-	_bundles[source].curDec = _bundles[source].data;
-	_bundles[source].curPtr = _bundles[source].data;
+	plane.bundles[source].curDec = plane.bundles[source].data;
+	plane.bundles[source].curPtr = plane.bundles[source].data;
 }
 
-void BinkDecoder::BinkVideoTrack::readHuffman(VideoFrame &video, Huffman &huffman) {
-	huffman.index = video.bits->getBits(4);
+void BinkDecoder::BinkVideoTrack::readHuffman(PlaneState &plane, Huffman &huffman) {
+	huffman.index = plane.bits->getBits(4);
 
 	if (huffman.index == 0) {
 		// The first tree always gives raw nibbles
@@ -640,13 +785,13 @@ void BinkDecoder::BinkVideoTrack::readHuffman(VideoFrame &video, Huffman &huffma
 
 	byte hasSymbol[16];
 
-	if (video.bits->getBit()) {
+	if (plane.bits->getBit()) {
 		// Symbol selection
 		memset(hasSymbol, 0, 16);
 
-		uint8 length = video.bits->getBits(3);
+		uint8 length = plane.bits->getBits(3);
 		for (int i = 0; i <= length; i++) {
-			huffman.symbols[i] = video.bits->getBits(4);
+			huffman.symbols[i] = plane.bits->getBits(4);
 			hasSymbol[huffman.symbols[i]] = 1;
 		}
 
@@ -662,7 +807,7 @@ void BinkDecoder::BinkVideoTrack::readHuffman(VideoFrame &video, Huffman &huffma
 	byte tmp1[16], tmp2[16];
 	byte *in = tmp1, *out = tmp2;
 
-	uint8 depth = video.bits->getBits(2);
+	uint8 depth = plane.bits->getBits(2);
 
 	for (int i = 0; i < 16; i++)
 		in[i] = i;
@@ -671,7 +816,7 @@ void BinkDecoder::BinkVideoTrack::readHuffman(VideoFrame &video, Huffman &huffma
 		int size = 1 << i;
 
 		for (int j = 0; j < 16; j += (size << 1))
-			mergeHuffmanSymbols(video, out + j, in + j, size);
+			mergeHuffmanSymbols(plane, out + j, in + j, size);
 
 		SWAP(in, out);
 	}
@@ -679,12 +824,12 @@ void BinkDecoder::BinkVideoTrack::readHuffman(VideoFrame &video, Huffman &huffma
 	memcpy(huffman.symbols, in, 16);
 }
 
-void BinkDecoder::BinkVideoTrack::mergeHuffmanSymbols(VideoFrame &video, byte *dst, const byte *src, int size) {
+void BinkDecoder::BinkVideoTrack::mergeHuffmanSymbols(PlaneState &plane, byte *dst, const byte *src, int size) {
 	const byte *src2  = src + size;
 	int size2 = size;
 
 	do {
-		if (!video.bits->getBit()) {
+		if (!plane.bits->getBit()) {
 			*dst++ = *src++;
 			size--;
 		} else {
@@ -704,35 +849,48 @@ void BinkDecoder::BinkVideoTrack::mergeHuffmanSymbols(VideoFrame &video, byte *d
 void BinkDecoder::BinkVideoTrack::initBundles() {
 	uint32 bw     = (_surface.w + 7) >> 3;
 	uint32 bh     = (_surface.h + 7) >> 3;
-	uint32 blocks = bw * bh;
 
-	for (int i = 0; i < kSourceMAX; i++) {
-		_bundles[i].data    = new byte[blocks * 64];
-		_bundles[i].dataEnd = _bundles[i].data + blocks * 64;
+	for (int p = 0; p < kPlaneStateMAX; p++) {
+		// Without alpha, the alpha plane state is not used
+		if (p == kPlaneStateAlpha && !_hasAlpha)
+			continue;
+
+		// The chroma planes have a quarter of the blocks
+		uint32 blocks = (p == kPlaneStateChroma) ? _uvBlockWidth * _uvBlockHeight : bw * bh;
+
+		for (int i = 0; i < kSourceMAX; i++) {
+			_planeStates[p].bundles[i].data    = new byte[blocks * 64];
+			_planeStates[p].bundles[i].dataEnd = _planeStates[p].bundles[i].data + blocks * 64;
+		}
 	}
 
 	uint32 cbw[2] = { (uint32)((_surface.w + 7) >> 3), (uint32)((_surface.w  + 15) >> 4) };
 	uint32 cw [2] = { (uint32)( _surface.w          ), (uint32)( _surface.w        >> 1) };
 
 	// Calculate the lengths of an element count in bits
-	for (int i = 0; i < 2; i++) {
-		int width = MAX<uint32>(cw[i], 8);
-
-		_bundles[kSourceBlockTypes   ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceSubBlockTypes].countLengths[i] = Common::intLog2(((width + 7) >> 4) + 511) + 1;
-		_bundles[kSourceColors       ].countLengths[i] = Common::intLog2((cbw[i])     * 64  + 511) + 1;
-		_bundles[kSourceIntraDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceInterDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceXOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourceYOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
-		_bundles[kSourcePattern      ].countLengths[i] = Common::intLog2((cbw[i]      << 3) + 511) + 1;
-		_bundles[kSourceRun          ].countLengths[i] = Common::intLog2((cbw[i])     * 48  + 511) + 1;
+	for (int p = 0; p < kPlaneStateMAX; p++) {
+		Bundle *bundles = _planeStates[p].bundles;
+
+		for (int i = 0; i < 2; i++) {
+			int width = MAX<uint32>(cw[i], 8);
+
+			bundles[kSourceBlockTypes   ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+			bundles[kSourceSubBlockTypes].countLengths[i] = Common::intLog2(((width + 7) >> 4) + 511) + 1;
+			bundles[kSourceColors       ].countLengths[i] = Common::intLog2((cbw[i])     * 64  + 511) + 1;
+			bundles[kSourceIntraDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+			bundles[kSourceInterDC      ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+			bundles[kSourceXOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+			bundles[kSourceYOff         ].countLengths[i] = Common::intLog2((width       >> 3) + 511) + 1;
+			bundles[kSourcePattern      ].countLengths[i] = Common::intLog2((cbw[i]      << 3) + 511) + 1;
+			bundles[kSourceRun          ].countLengths[i] = Common::intLog2((cbw[i])     * 48  + 511) + 1;
+		}
 	}
 }
 
 void BinkDecoder::BinkVideoTrack::deinitBundles() {
-	for (int i = 0; i < kSourceMAX; i++)
-		delete[] _bundles[i].data;
+	for (int p = 0; p < kPlaneStateMAX; p++)
+		for (int i = 0; i < kSourceMAX; i++)
+			delete[] _planeStates[p].bundles[i].data;
 }
 
 void BinkDecoder::BinkVideoTrack::initHuffman() {
@@ -740,29 +898,29 @@ void BinkDecoder::BinkVideoTrack::initHuffman() {
 		_huffman[i] = new Common::Huffman<Common::BitStream32LELSB>(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
 }
 
-byte BinkDecoder::BinkVideoTrack::getHuffmanSymbol(VideoFrame &video, Huffman &huffman) {
-	return huffman.symbols[_huffman[huffman.index]->getSymbol(*video.bits)];
+byte BinkDecoder::BinkVideoTrack::getHuffmanSymbol(PlaneState &plane, Huffman &huffman) {
+	return huffman.symbols[_huffman[huffman.index]->getSymbol(*plane.bits)];
 }
 
-int32 BinkDecoder::BinkVideoTrack::getBundleValue(Source source) {
+int32 BinkDecoder::BinkVideoTrack::getBundleValue(PlaneState &plane, Source source) {
 	if ((source < kSourceXOff) || (source == kSourceRun))
-		return *_bundles[source].curPtr++;
+		return *plane.bundles[source].curPtr++;
 
 	if ((source == kSourceXOff) || (source == kSourceYOff))
-		return (int8) *_bundles[source].curPtr++;
+		return (int8) *plane.bundles[source].curPtr++;
 
-	int16 ret = *((int16 *) _bundles[source].curPtr);
+	int16 ret = *((int16 *) plane.bundles[source].curPtr);
 
-	_bundles[source].curPtr += 2;
+	plane.bundles[source].curPtr += 2;
 
 	return ret;
 }
 
-uint32 BinkDecoder::BinkVideoTrack::readBundleCount(VideoFrame &video, Bundle &bundle) {
+uint32 BinkDecoder::BinkVideoTrack::readBundleCount(PlaneState &plane, Bundle &bundle) {
 	if (!bundle.curDec || (bundle.curDec > bundle.curPtr))
 		return 0;
 
-	uint32 n = video.bits->getBits(bundle.countLength);
+	uint32 n = plane.bits->getBits(bundle.countLength);
 	if (n == 0)
 		bundle.curDec = 0;
 
@@ -786,19 +944,19 @@ void BinkDecoder::BinkVideoTrack::blockScaledSkip(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
-	const uint8 *scan = binkPatterns[ctx.video->bits->getBits(4)];
+	const uint8 *scan = binkPatterns[ctx.plane->bits->getBits(4)];
 
 	int i = 0;
 	do {
-		int run = getBundleValue(kSourceRun) + 1;
+		int run = getBundleValue(*ctx.plane, kSourceRun) + 1;
 
 		i += run;
 		if (i > 64)
 			error("Run went out of bounds");
 
-		if (ctx.video->bits->getBit()) {
+		if (ctx.plane->bits->getBit()) {
 
-			byte v = getBundleValue(kSourceColors);
+			byte v = getBundleValue(*ctx.plane, kSourceColors);
 			for (int j = 0; j < run; j++, scan++)
 				ctx.dest[ctx.coordScaledMap1[*scan]] =
 				ctx.dest[ctx.coordScaledMap2[*scan]] =
@@ -810,7 +968,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 				ctx.dest[ctx.coordScaledMap1[*scan]] =
 				ctx.dest[ctx.coordScaledMap2[*scan]] =
 				ctx.dest[ctx.coordScaledMap3[*scan]] =
-				ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(kSourceColors);
+				ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(*ctx.plane, kSourceColors);
 
 	} while (i < 63);
 
@@ -818,16 +976,16 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 		ctx.dest[ctx.coordScaledMap1[*scan]] =
 		ctx.dest[ctx.coordScaledMap2[*scan]] =
 		ctx.dest[ctx.coordScaledMap3[*scan]] =
-		ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(kSourceColors);
+		ctx.dest[ctx.coordScaledMap4[*scan]] = getBundleValue(*ctx.plane, kSourceColors);
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 	int32 block[64];
 	memset(block, 0, 64 * sizeof(int32));
 
-	block[0] = getBundleValue(kSourceIntraDC);
+	block[0] = getBundleValue(*ctx.plane, kSourceIntraDC);
 
-	readDCTCoeffs(*ctx.video, block, true);
+	readDCTCoeffs(*ctx.plane, block, true);
 
 	IDCT(block);
 
@@ -843,7 +1001,7 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledFill(DecodeContext &ctx) {
-	byte v = getBundleValue(kSourceColors);
+	byte v = getBundleValue(*ctx.plane, kSourceColors);
 
 	byte *dest = ctx.dest;
 	for (int i = 0; i < 16; i++, dest += ctx.pitch)
@@ -854,12 +1012,12 @@ void BinkDecoder::BinkVideoTrack::blockScaledPattern(DecodeContext &ctx) {
 	byte col[2];
 
 	for (int i = 0; i < 2; i++)
-		col[i] = getBundleValue(kSourceColors);
+		col[i] = getBundleValue(*ctx.plane, kSourceColors);
 
 	byte *dest1 = ctx.dest;
 	byte *dest2 = ctx.dest + ctx.pitch;
 	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
-		byte v = getBundleValue(kSourcePattern);
+		byte v = getBundleValue(*ctx.plane, kSourcePattern);
 
 		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2, v >>= 1)
 			dest1[0] = dest1[1] = dest2[0] = dest2[1] = col[v & 1];
@@ -872,17 +1030,17 @@ void BinkDecoder::BinkVideoTrack::blockScaledRaw(DecodeContext &ctx) {
 	byte *dest1 = ctx.dest;
 	byte *dest2 = ctx.dest + ctx.pitch;
 	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
-		memcpy(row, _bundles[kSourceColors].curPtr, 8);
+		memcpy(row, ctx.plane->bundles[kSourceColors].curPtr, 8);
 
 		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
 			dest1[0] = dest1[1] = dest2[0] = dest2[1] = row[i];
 
-		_bundles[kSourceColors].curPtr += 8;
+		ctx.plane->bundles[kSourceColors].curPtr += 8;
 	}
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaled(DecodeContext &ctx) {
-	BlockType blockType = (BlockType) getBundleValue(kSourceSubBlockTypes);
+	BlockType blockType = (BlockType) getBundleValue(*ctx.plane, kSourceSubBlockTypes);
 
 	switch (blockType) {
 	case kBlockRun:
@@ -910,8 +1068,8 @@ void BinkDecoder::BinkVideoTrack::blockScaled(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockMotion(DecodeContext &ctx) {
-	int8 xOff = getBundleValue(kSourceXOff);
-	int8 yOff = getBundleValue(kSourceYOff);
+	int8 xOff = getBundleValue(*ctx.plane, kSourceXOff);
+	int8 yOff = getBundleValue(*ctx.plane, kSourceYOff);
 
 	byte *dest = ctx.dest;
 	byte *prev = ctx.prev + yOff * ((int32) ctx.pitch) + xOff;
@@ -923,41 +1081,41 @@ void BinkDecoder::BinkVideoTrack::blockMotion(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockRun(DecodeContext &ctx) {
-	const uint8 *scan = binkPatterns[ctx.video->bits->getBits(4)];
+	const uint8 *scan = binkPatterns[ctx.plane->bits->getBits(4)];
 
 	int i = 0;
 	do {
-		int run = getBundleValue(kSourceRun) + 1;
+		int run = getBundleValue(*ctx.plane, kSourceRun) + 1;
 
 		i += run;
 		if (i > 64)
 			error("Run went out of bounds");
 
-		if (ctx.video->bits->getBit()) {
+		if (ctx.plane->bits->getBit()) {
 
-			byte v = getBundleValue(kSourceColors);
+			byte v = getBundleValue(*ctx.plane, kSourceColors);
 			for (int j = 0; j < run; j++)
 				ctx.dest[ctx.coordMap[*scan++]] = v;
 
 		} else
 			for (int j = 0; j < run; j++)
-				ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(kSourceColors);
+				ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(*ctx.plane, kSourceColors);
 
 	} while (i < 63);
 
 	if (i == 63)
-		ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(kSourceColors);
+		ctx.dest[ctx.coordMap[*scan++]] = getBundleValue(*ctx.plane, kSourceColors);
 }
 
 void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
 	blockMotion(ctx);
 
-	byte v = ctx.video->bits->getBits(7);
+	byte v = ctx.plane->bits->getBits(7);
 
 	int16 block[64];
 	memset(block, 0, 64 * sizeof(int16));
 
-	readResidue(*ctx.video, block, v);
+	readResidue(*ctx.plane, block, v);
 
 	byte  *dst = ctx.dest;
 	int16 *src = block;
@@ -970,15 +1128,15 @@ void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
 	int32 block[64];
 	memset(block, 0, 64 * sizeof(int32));
 
-	block[0] = getBundleValue(kSourceIntraDC);
+	block[0] = getBundleValue(*ctx.plane, kSourceIntraDC);
 
-	readDCTCoeffs(*ctx.video, block, true);
+	readDCTCoeffs(*ctx.plane, block, true);
 
 	IDCTPut(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
-	byte v = getBundleValue(kSourceColors);
+	byte v = getBundleValue(*ctx.plane, kSourceColors);
 
 	byte *dest = ctx.dest;
 	for (int i = 0; i < 8; i++, dest += ctx.pitch)
@@ -991,9 +1149,9 @@ void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
 	int32 block[64];
 	memset(block, 0, 64 * sizeof(int32));
 
-	block[0] = getBundleValue(kSourceInterDC);
+	block[0] = getBundleValue(*ctx.plane, kSourceInterDC);
 
-	readDCTCoeffs(*ctx.video, block, false);
+	readDCTCoeffs(*ctx.plane, block, false);
 
 	IDCTAdd(ctx, block);
 }
@@ -1002,11 +1160,11 @@ void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
 	byte col[2];
 
 	for (int i = 0; i < 2; i++)
-		col[i] = getBundleValue(kSourceColors);
+		col[i] = getBundleValue(*ctx.plane, kSourceColors);
 
 	byte *dest = ctx.dest;
 	for (int i = 0; i < 8; i++, dest += ctx.pitch - 8) {
-		byte v = getBundleValue(kSourcePattern);
+		byte v = getBundleValue(*ctx.plane, kSourcePattern);
 
 		for (int j = 0; j < 8; j++, v >>= 1)
 			*dest++ = col[v & 1];
@@ -1015,15 +1173,15 @@ void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
 
 void BinkDecoder::BinkVideoTrack::blockRaw(DecodeContext &ctx) {
 	byte *dest = ctx.dest;
-	byte *data = _bundles[kSourceColors].curPtr;
+	byte *data = ctx.plane->bundles[kSourceColors].curPtr;
 	for (int i = 0; i < 8; i++, dest += ctx.pitch, data += 8)
 		memcpy(dest, data, 8);
 
-	_bundles[kSourceColors].curPtr += 64;
+	ctx.plane->bundles[kSourceColors].curPtr += 64;
 }
 
-void BinkDecoder::BinkVideoTrack::readRuns(VideoFrame &video, Bundle &bundle) {
-	uint32 n = readBundleCount(video, bundle);
+void BinkDecoder::BinkVideoTrack::readRuns(PlaneState &plane, Bundle &bundle) {
+	uint32 n = readBundleCount(plane, bundle);
 	if (n == 0)
 		return;
 
@@ -1031,19 +1189,19 @@ void BinkDecoder::BinkVideoTrack::readRuns(VideoFrame &video, Bundle &bundle) {
 	if (decEnd > bundle.dataEnd)
 		error("Run value went out of bounds");
 
-	if (video.bits->getBit()) {
-		byte v = video.bits->getBits(4);
+	if (plane.bits->getBit()) {
+		byte v = plane.bits->getBits(4);
 
 		memset(bundle.curDec, v, n);
 		bundle.curDec += n;
 
 	} else
 		while (bundle.curDec < decEnd)
-			*bundle.curDec++ = getHuffmanSymbol(video, bundle.huffman);
+			*bundle.curDec++ = getHuffmanSymbol(plane, bundle.huffman);
 }
 
-void BinkDecoder::BinkVideoTrack::readMotionValues(VideoFrame &video, Bundle &bundle) {
-	uint32 n = readBundleCount(video, bundle);
+void BinkDecoder::BinkVideoTrack::readMotionValues(PlaneState &plane, Bundle &bundle) {
+	uint32 n = readBundleCount(plane, bundle);
 	if (n == 0)
 		return;
 
@@ -1051,11 +1209,11 @@ void BinkDecoder::BinkVideoTrack::readMotionValues(VideoFrame &video, Bundle &bu
 	if (decEnd > bundle.dataEnd)
 		error("Too many motion values");
 
-	if (video.bits->getBit()) {
-		byte v = video.bits->getBits(4);
+	if (plane.bits->getBit()) {
+		byte v = plane.bits->getBits(4);
 
 		if (v) {
-			int sign = -(int)video.bits->getBit();
+			int sign = -(int)plane.bits->getBit();
 			v = (v ^ sign) - sign;
 		}
 
@@ -1066,10 +1224,10 @@ void BinkDecoder::BinkVideoTrack::readMotionValues(VideoFrame &video, Bundle &bu
 	}
 
 	do {
-		byte v = getHuffmanSymbol(video, bundle.huffman);
+		byte v = getHuffmanSymbol(plane, bundle.huffman);
 
 		if (v) {
-			int sign = -(int)video.bits->getBit();
+			int sign = -(int)plane.bits->getBit();
 			v = (v ^ sign) - sign;
 		}
 
@@ -1079,8 +1237,8 @@ void BinkDecoder::BinkVideoTrack::readMotionValues(VideoFrame &video, Bundle &bu
 }
 
 const uint8 rleLens[4] = { 4, 8, 12, 32 };
-void BinkDecoder::BinkVideoTrack::readBlockTypes(VideoFrame &video, Bundle &bundle) {
-	uint32 n = readBundleCount(video, bundle);
+void BinkDecoder::BinkVideoTrack::readBlockTypes(PlaneState &plane, Bundle &bundle) {
+	uint32 n = readBundleCount(plane, bundle);
 	if (n == 0)
 		return;
 
@@ -1088,8 +1246,8 @@ void BinkDecoder::BinkVideoTrack::readBlockTypes(VideoFrame &video, Bundle &bund
 	if (decEnd > bundle.dataEnd)
 		error("Too many block type values");
 
-	if (video.bits->getBit()) {
-		byte v = video.bits->getBits(4);
+	if (plane.bits->getBit()) {
+		byte v = plane.bits->getBits(4);
 
 		memset(bundle.curDec, v, n);
 
@@ -1100,7 +1258,7 @@ void BinkDecoder::BinkVideoTrack::readBlockTypes(VideoFrame &video, Bundle &bund
 	byte last = 0;
 	do {
 
-		byte v = getHuffmanSymbol(video, bundle.huffman);
+		byte v = getHuffmanSymbol(plane, bundle.huffman);
 
 		if (v < 12) {
 			last = v;
@@ -1116,8 +1274,8 @@ void BinkDecoder::BinkVideoTrack::readBlockTypes(VideoFrame &video, Bundle &bund
 	} while (bundle.curDec < decEnd);
 }
 
-void BinkDecoder::BinkVideoTrack::readPatterns(VideoFrame &video, Bundle &bundle) {
-	uint32 n = readBundleCount(video, bundle);
+void BinkDecoder::BinkVideoTrack::readPatterns(PlaneState &plane, Bundle &bundle) {
+	uint32 n = readBundleCount(plane, bundle);
 	if (n == 0)
 		return;
 
@@ -1127,15 +1285,15 @@ void BinkDecoder::BinkVideoTrack::readPatterns(VideoFrame &video, Bundle &bundle
 
 	byte v;
 	while (bundle.curDec < decEnd) {
-		v  = getHuffmanSymbol(video, bundle.huffman);
-		v |= getHuffmanSymbol(video, bundle.huffman) << 4;
+		v  = getHuffmanSymbol(plane, bundle.huffman);
+		v |= getHuffmanSymbol(plane, bundle.huffman) << 4;
 		*bundle.curDec++ = v;
 	}
 }
 
 
-void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle) {
-	uint32 n = readBundleCount(video, bundle);
+void BinkDecoder::BinkVideoTrack::readColors(PlaneState &plane, Bundle &bundle) {
+	uint32 n = readBundleCount(plane, bundle);
 	if (n == 0)
 		return;
 
@@ -1143,12 +1301,12 @@ void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle)
 	if (decEnd > bundle.dataEnd)
 		error("Too many color values");
 
-	if (video.bits->getBit()) {
-		_colLastVal = getHuffmanSymbol(video, _colHighHuffman[_colLastVal]);
+	if (plane.bits->getBit()) {
+		plane.colLastVal = getHuffmanSymbol(plane, plane.colHighHuffman[plane.colLastVal]);
 
 		byte v;
-		v = getHuffmanSymbol(video, bundle.huffman);
-		v = (_colLastVal << 4) | v;
+		v = getHuffmanSymbol(plane, bundle.huffman);
+		v = (plane.colLastVal << 4) | v;
 
 		if (_id != kBIKiID) {
 			int sign = ((int8) v) >> 7;
@@ -1163,11 +1321,11 @@ void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle)
 	}
 
 	while (bundle.curDec < decEnd) {
-		_colLastVal = getHuffmanSymbol(video, _colHighHuffman[_colLastVal]);
+		plane.colLastVal = getHuffmanSymbol(plane, plane.colHighHuffman[plane.colLastVal]);
 
 		byte v;
-		v = getHuffmanSymbol(video, bundle.huffman);
-		v = (_colLastVal << 4) | v;
+		v = getHuffmanSymbol(plane, bundle.huffman);
+		v = (plane.colLastVal << 4) | v;
 
 		if (_id != kBIKiID) {
 			int sign = ((int8) v) >> 7;
@@ -1178,16 +1336,16 @@ void BinkDecoder::BinkVideoTrack::readColors(VideoFrame &video, Bundle &bundle)
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::readDCS(VideoFrame &video, Bundle &bundle, int startBits, bool hasSign) {
-	uint32 length = readBundleCount(video, bundle);
+void BinkDecoder::BinkVideoTrack::readDCS(PlaneState &plane, Bundle &bundle, int startBits, bool hasSign) {
+	uint32 length = readBundleCount(plane, bundle);
 	if (length == 0)
 		return;
 
 	int16 *dest = (int16 *) bundle.curDec;
 
-	int32 v = video.bits->getBits(startBits - (hasSign ? 1 : 0));
+	int32 v = plane.bits->getBits(startBits - (hasSign ? 1 : 0));
 	if (v && hasSign) {
-		int sign = -(int)video.bits->getBit();
+		int sign = -(int)plane.bits->getBit();
 		v = (v ^ sign) - sign;
 	}
 
@@ -1197,14 +1355,14 @@ void BinkDecoder::BinkVideoTrack::readDCS(VideoFrame &video, Bundle &bundle, int
 	for (uint32 i = 0; i < length; i += 8) {
 		uint32 length2 = MIN<uint32>(length - i, 8);
 
-		byte bSize = video.bits->getBits(4);
+		byte bSize = plane.bits->getBits(4);
 
 		if (bSize) {
 
 			for (uint32 j = 0; j < length2; j++) {
-				int16 v2 = video.bits->getBits(bSize);
+				int16 v2 = plane.bits->getBits(bSize);
 				if (v2) {
-					int sign = -(int)video.bits->getBit();
+					int sign = -(int)plane.bits->getBit();
 					v2 = (v2 ^ sign) - sign;
 				}
 
@@ -1224,7 +1382,7 @@ void BinkDecoder::BinkVideoTrack::readDCS(VideoFrame &video, Bundle &bundle, int
 }
 
 /** Reads 8x8 block of DCT coefficients. */
-void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int32 *block, bool isIntra) {
+void BinkDecoder::BinkVideoTrack::readDCTCoeffs(PlaneState &plane, int32 *block, bool isIntra) {
 	int coefCount = 0;
 	int coefIdx[64];
 
@@ -1239,13 +1397,13 @@ void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int32 *block,
 	coefList[listEnd] = 2;  modeList[listEnd++] = 3;
 	coefList[listEnd] = 3;  modeList[listEnd++] = 3;
 
-	int bits = video.bits->getBits(4) - 1;
+	int bits = plane.bits->getBits(4) - 1;
 	for (int mask = 1 << bits; bits >= 0; mask >>= 1, bits--) {
 		int listPos = listStart;
 
 		while (listPos < listEnd) {
 
-			if (!(modeList[listPos] | coefList[listPos]) || !video.bits->getBit()) {
+			if (!(modeList[listPos] | coefList[listPos]) || !plane.bits->getBit()) {
 				listPos++;
 				continue;
 			}
@@ -1264,17 +1422,17 @@ void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int32 *block,
 					modeList[listPos++] = 0;
 				}
 				for (int i = 0; i < 4; i++, ccoef++) {
-					if (video.bits->getBit()) {
+					if (plane.bits->getBit()) {
 						coefList[--listStart] = ccoef;
 						modeList[  listStart] = 3;
 					} else {
 						int t;
 						if (!bits) {
-							t = 1 - (video.bits->getBit() << 1);
+							t = 1 - (plane.bits->getBit() << 1);
 						} else {
-							t = video.bits->getBits(bits) | mask;
+							t = plane.bits->getBits(bits) | mask;
 
-							int sign = -(int)video.bits->getBit();
+							int sign = -(int)plane.bits->getBit();
 							t = (t ^ sign) - sign;
 						}
 						block[binkScan[ccoef]] = t;
@@ -1295,11 +1453,11 @@ void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int32 *block,
 			case 3:
 				int t;
 				if (!bits) {
-					t = 1 - (video.bits->getBit() << 1);
+					t = 1 - (plane.bits->getBit() << 1);
 				} else {
-					t = video.bits->getBits(bits) | mask;
+					t = plane.bits->getBits(bits) | mask;
 
-					int sign = -(int)video.bits->getBit();
+					int sign = -(int)plane.bits->getBit();
 					t = (t ^ sign) - sign;
 				}
 				block[binkScan[ccoef]] = t;
@@ -1314,7 +1472,7 @@ void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int32 *block,
 		}
 	}
 
-	uint8 quantIdx = video.bits->getBits(4);
+	uint8 quantIdx = plane.bits->getBits(4);
 	const int32 *quant = isIntra ? binkIntraQuant[quantIdx] : binkInterQuant[quantIdx];
 	block[0] = (block[0] * quant[0]) >> 11;
 
@@ -1326,7 +1484,7 @@ void BinkDecoder::BinkVideoTrack::readDCTCoeffs(VideoFrame &video, int32 *block,
 }
 
 /** Reads 8x8 block with residue after motion compensation. */
-void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, int masksCount) {
+void BinkDecoder::BinkVideoTrack::readResidue(PlaneState &plane, int16 *block, int masksCount) {
 	int nzCoeff[64];
 	int nzCoeffCount = 0;
 
@@ -1339,10 +1497,10 @@ void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, i
 	coefList[listEnd] = 44; modeList[listEnd++] = 0;
 	coefList[listEnd] =  0; modeList[listEnd++] = 2;
 
-	for (int mask = 1 << video.bits->getBits(3); mask; mask >>= 1) {
+	for (int mask = 1 << plane.bits->getBits(3); mask; mask >>= 1) {
 
 		for (int i = 0; i < nzCoeffCount; i++) {
-			if (!video.bits->getBit())
+			if (!plane.bits->getBit())
 				continue;
 			if (block[nzCoeff[i]] < 0)
 				block[nzCoeff[i]] -= mask;
@@ -1356,7 +1514,7 @@ void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, i
 		int listPos = listStart;
 		while (listPos < listEnd) {
 
-			if (!(coefList[listPos] | modeList[listPos]) || !video.bits->getBit()) {
+			if (!(coefList[listPos] | modeList[listPos]) || !plane.bits->getBit()) {
 				listPos++;
 				continue;
 			}
@@ -1376,13 +1534,13 @@ void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, i
 				}
 
 				for (int i = 0; i < 4; i++, ccoef++) {
-					if (video.bits->getBit()) {
+					if (plane.bits->getBit()) {
 						coefList[--listStart] = ccoef;
 						modeList[  listStart] = 3;
 					} else {
 						nzCoeff[nzCoeffCount++] = binkScan[ccoef];
 
-						int sign = -(int)video.bits->getBit();
+						int sign = -(int)plane.bits->getBit();
 						block[binkScan[ccoef]] = (mask ^ sign) - sign;
 
 						masksCount--;
@@ -1405,7 +1563,7 @@ void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, i
 				{
 					nzCoeff[nzCoeffCount++] = binkScan[ccoef];
 
-					int sign = -(int)video.bits->getBit();
+					int sign = -(int)plane.bits->getBit();
 					block[binkScan[ccoef]] = (mask ^ sign) - sign;
 
 					coefList[listPos]   = 0;
@@ -38,6 +38,7 @@
 #include "video/video_decoder.h"
 
 #include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
 
 namespace Audio {
 class AudioStream;
@@ -140,6 +141,9 @@ private:
 
 		Common::BitStream32LELSB *bits;
 
+		const byte *data; ///< The video packet, while it is being decoded.
+		uint32 dataSize;  ///< Size of the video packet.
+
 		VideoFrame();
 		~VideoFrame();
 	};
@@ -154,7 +158,10 @@ private:
 		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() override { return &_surface; }
+		const Graphics::Surface *decodeNextFrame() override { return _outputYUV ? 0 : &_surface; }
+		bool canOutputYUV() const override { return !_hasAlpha; }
+		void setOutputYUV() override { _outputYUV = true; }
+		const Graphics::YUVFrame *getYUVFrame() const override { return _outputYUV ? &_yuvFrame : 0; }
 		bool isSeekable() const  override{ return true; }
 		bool seek(const Audio::Timestamp &time) override { return true; }
 		bool rewind() override;
@@ -166,30 +173,6 @@ private:
 		Common::Rational getFrameRate() const override { return _frameRate; }
 
 	private:
-		/** A decoder state. */
-		struct DecodeContext {
-			VideoFrame *video;
-
-			uint32 planeIdx;
-
-			uint32 blockX;
-			uint32 blockY;
-
-			byte *dest;
-			byte *prev;
-
-			byte *destStart, *destEnd;
-			byte *prevStart, *prevEnd;
-
-			uint32 pitch;
-
-			int coordMap[64];
-			int coordScaledMap1[64];
-			int coordScaledMap2[64];
-			int coordScaledMap3[64];
-			int coordScaledMap4[64];
-		};
-
 		/** IDs for different data types used in Bink video codec. */
 		enum Source {
 			kSourceBlockTypes    = 0, ///< 8x8 block types.
@@ -239,6 +222,74 @@ private:
 			byte *curPtr; ///< Pointer to the data that wasn't yet read.
 		};
 
+		/**
+		 * The state of the decoding of a plane. The planes decoded concurrently
+		 * each have their own, with their own bit stream over the packet.
+		 */
+		struct PlaneState {
+			Common::BitStream32LELSB *bits; ///< The bit stream of the plane.
+
+			Bundle bundles[kSourceMAX]; ///< Bundles for decoding all data types.
+
+			/** Huffman codebooks to use for decoding high nibbles in color data types. */
+			Huffman colHighHuffman[16];
+			/** Value of the last decoded high nibble in color data types. */
+			int colLastVal;
+		};
+
+		/** A decoder state. */
+		struct DecodeContext {
+			PlaneState *plane;
+
+			uint32 planeIdx;
+
+			uint32 blockX;
+			uint32 blockY;
+
+			byte *dest;
+			byte *prev;
+
+			byte *destStart, *destEnd;
+			byte *prevStart, *prevEnd;
+
+			uint32 pitch;
+
+			int coordMap[64];
+			int coordScaledMap1[64];
+			int coordScaledMap2[64];
+			int coordScaledMap3[64];
+			int coordScaledMap4[64];
+		};
+
+		/** The plane states: the chroma planes are always decoded one after the other. */
+		enum PlaneStateIndex {
+			kPlaneStateLuma   = 0,
+			kPlaneStateChroma    ,
+			kPlaneStateAlpha     ,
+
+			kPlaneStateMAX
+		};
+
+		/** Whether the plane offsets of BIKi packets can be used to decode the planes concurrently. */
+		enum PlaneOffsets {
+			kPlaneOffsetsUnchecked,
+			kPlaneOffsetsValid,
+			kPlaneOffsetsInvalid
+		};
+
+		/** One or more planes decoded on their own, from a range of the packet. */
+		struct PlaneJob {
+			BinkVideoTrack *track;
+			const byte *data;
+
+			int planes[2]; ///< The planes to decode in turn, -1 for none.
+			uint32 start;  ///< Start of the data of the planes in the packet, in bytes.
+			uint32 end;    ///< End of the data of the planes in the packet, in bytes.
+
+			bool exact; ///< Must the planes end right at the end of their data?
+			bool valid; ///< Did they?
+		};
+
 		int _curFrame;
 		int _frameCount;
 
@@ -246,6 +297,9 @@ private:
 		int _surfaceWidth; ///< The actual surface width
 		int _surfaceHeight; ///< The actual surface height
 
+		bool _outputYUV;            ///< Leave the conversion of the frames to the caller
+		Graphics::YUVFrame _yuvFrame; ///< The last decoded frame, in the reference planes
+
 		uint32 _id; ///< The BIK FourCC.
 
 		bool _hasAlpha;   ///< Do video frames have alpha?
@@ -253,15 +307,11 @@ private:
 
 		Common::Rational _frameRate;
 
-		Bundle _bundles[kSourceMAX]; ///< Bundles for decoding all data types.
+		PlaneState _planeStates[kPlaneStateMAX]; ///< The decoding states of the planes.
+		PlaneOffsets _planeOffsets;
 
 		Common::Huffman<Common::BitStream32LELSB> *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
 
-		/** Huffman codebooks to use for decoding high nibbles in color data types. */
-		Huffman _colHighHuffman[16];
-		/** Value of the last decoded high nibble in color data types. */
-		int _colLastVal;
-
 		uint32 _yBlockWidth;   ///< Width of the Y plane in blocks
 		uint32 _yBlockHeight;  ///< Height of the Y plane in blocks
 		uint32 _uvBlockWidth;  ///< Width of the U and V planes in blocks
@@ -278,24 +328,34 @@ private:
 		/** Initialize the Huffman decoders. */
 		void initHuffman();
 
+		/** Return the decoding state of a plane. */
+		PlaneState &getPlaneState(int planeIdx);
+
+		/** Decode all the planes of a packet, one after the other. */
+		void decodePlanes(VideoFrame &frame);
+		/** Decode the planes of a BIKi packet concurrently, if their offsets can be trusted. */
+		bool decodePlanesConcurrently(VideoFrame &frame);
+		/** Decode the planes of a job, on a worker thread. */
+		static void decodePlaneJob(void *refCon);
+
 		/** Decode a plane. */
-		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
+		void decodePlane(PlaneState &plane, int planeIdx, bool isChroma);
 
 		/** Read/Initialize a bundle for decoding a plane. */
-		void readBundle(VideoFrame &video, Source source);
+		void readBundle(PlaneState &plane, Source source);
 
 		/** Read the symbols for a Huffman code. */
-		void readHuffman(VideoFrame &video, Huffman &huffman);
+		void readHuffman(PlaneState &plane, Huffman &huffman);
 		/** Merge two Huffman symbol lists. */
-		void mergeHuffmanSymbols(VideoFrame &video, byte *dst, const byte *src, int size);
+		void mergeHuffmanSymbols(PlaneState &plane, byte *dst, const byte *src, int size);
 
 		/** Read and translate a symbol out of a Huffman code. */
-		byte getHuffmanSymbol(VideoFrame &video, Huffman &huffman);
+		byte getHuffmanSymbol(PlaneState &plane, Huffman &huffman);
 
 		/** Get a direct value out of a bundle. */
-		int32 getBundleValue(Source source);
+		int32 getBundleValue(PlaneState &plane, Source source);
 		/** Read a count value out of a bundle. */
-		uint32 readBundleCount(VideoFrame &video, Bundle &bundle);
+		uint32 readBundleCount(PlaneState &plane, Bundle &bundle);
 
 		// Handle the block types
 		void blockSkip         (DecodeContext &ctx);
@@ -316,14 +376,14 @@ private:
 		void blockRaw          (DecodeContext &ctx);
 
 		// Read the bundles
-		void readRuns        (VideoFrame &video, Bundle &bundle);
-		void readMotionValues(VideoFrame &video, Bundle &bundle);
-		void readBlockTypes  (VideoFrame &video, Bundle &bundle);
-		void readPatterns    (VideoFrame &video, Bundle &bundle);
-		void readColors      (VideoFrame &video, Bundle &bundle);
-		void readDCS         (VideoFrame &video, Bundle &bundle, int startBits, bool hasSign);
-		void readDCTCoeffs   (VideoFrame &video, int32 *block, bool isIntra);
-		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
+		void readRuns        (PlaneState &plane, Bundle &bundle);
+		void readMotionValues(PlaneState &plane, Bundle &bundle);
+		void readBlockTypes  (PlaneState &plane, Bundle &bundle);
+		void readPatterns    (PlaneState &plane, Bundle &bundle);
+		void readColors      (PlaneState &plane, Bundle &bundle);
+		void readDCS         (PlaneState &plane, Bundle &bundle, int startBits, bool hasSign);
+		void readDCTCoeffs   (PlaneState &plane, int32 *block, bool isIntra);
+		void readResidue     (PlaneState &plane, int16 *block, int masksCount);
 
 		// Bink video IDCT
 		void IDCT(int32 *block);
@@ -40,6 +40,14 @@
 #include "audio/decoders/adpcm_intern.h"
 #include "common/memstream.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COKTEL_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define COKTEL_USE_NEON
+#include <arm_neon.h>
+#endif
+
 static const uint32 kVideoCodecIndeo3 = MKTAG('i','v','3','2');
 
 namespace Video {
@@ -312,6 +320,42 @@ bool CoktelDecoder::hasDirtyPalette() const {
 	return (_features & kFeaturesPalette) && _paletteDirty;
 }
 
+// Copy a match from distance bytes back in the output. When the match overlaps
+// itself, the bytes repeat, so it can be copied in ever longer runs. When the
+// output goes on for space bytes, the match is copied in whole 8 bytes words.
+static inline void copyMatch(byte *dest, uint32 distance, uint32 length, uint32 space) {
+	const byte *from = dest - distance;
+	if ((distance >= 8) && (length + 7 <= space)) {
+		for (uint32 i = 0; i < length; i += 8)
+			memcpy(dest + i, from + i, 8);
+		return;
+	}
+
+	while (length > 0) {
+		const uint32 count = MIN<uint32>(dest - from, length);
+		memcpy(dest, from, count);
+
+		dest   += count;
+		length -= count;
+	}
+}
+
+// Fill with a repeated pair of bytes
+static inline void fillPair(byte *dest, const byte *pair, int count) {
+#if defined(COKTEL_USE_SSE2)
+	const __m128i pattern = _mm_set1_epi16((int16)READ_UINT16(pair));
+	for (; count >= 16; count -= 16, dest += 16)
+		_mm_storeu_si128((__m128i *)dest, pattern);
+#elif defined(COKTEL_USE_NEON)
+	const uint8x16_t pattern = vreinterpretq_u8_u16(vdupq_n_u16(READ_UINT16(pair)));
+	for (; count >= 16; count -= 16, dest += 16)
+		vst1q_u8(dest, pattern);
+#endif
+
+	for (int i = 0; i < count; i++)
+		dest[i] = pair[i & 1];
+}
+
 uint32 CoktelDecoder::deLZ77(byte *dest, const byte *src, uint32 srcSize, uint32 destSize) {
 	uint32 frameLength = READ_LE_UINT32(src);
 	if (frameLength > destSize) {
@@ -326,7 +370,7 @@ uint32 CoktelDecoder::deLZ77(byte *dest, const byte *src, uint32 srcSize, uint32
 	src     += 4;
 	srcSize -= 4;
 
-	uint16 bufPos1;
+	uint16 windowStart;
 	bool mode;
 	if ((READ_LE_UINT16(src) == 0x1234) && (READ_LE_UINT16(src + 2) == 0x5678)) {
 		assert(srcSize >= 4);
@@ -334,15 +378,21 @@ uint32 CoktelDecoder::deLZ77(byte *dest, const byte *src, uint32 srcSize, uint32
 		src     += 4;
 		srcSize -= 4;
 
-		bufPos1 = 273;
-		mode    = 1; // 123Ch (cmp al, 12h)
+		windowStart = 273;
+		mode        = 1; // 123Ch (cmp al, 12h)
 	} else {
-		bufPos1 = 4078;
-		mode    = 0; // 275h (jnz +2)
+		windowStart = 4078;
+		mode        = 0; // 275h (jnz +2)
 	}
 
-	byte buf[4370];
-	memset(buf, 32, bufPos1);
+	// The matches address a 4096 bytes window, which starts out filled with
+	// spaces and then holds the last 4096 bytes of output. So only the
+	// matches reaching back before the start of the output need the window,
+	// the others are copied straight from the output.
+	byte window[4096];
+	memset(window, 32, sizeof(window));
+
+	byte *const destStart = dest;
 
 	uint8 chunkCount    = 1;
 	uint8 chunkBitField = 0;
@@ -353,15 +403,27 @@ uint32 CoktelDecoder::deLZ77(byte *dest, const byte *src, uint32 srcSize, uint32
 		if (chunkCount == 0) {
 			chunkCount    = 8;
 			chunkBitField = *src++;
+
+			if ((chunkBitField == 0xFF) && (frameLength >= 8)) {
+				// 8 literals in a row
+				assert(srcSize >= 8);
+
+				memcpy(dest, src, 8);
+
+				dest        += 8;
+				src         += 8;
+				frameLength -= 8;
+				srcSize     -= 8;
+				chunkCount   = 1;
+				continue;
+			}
 		}
 
 		if (chunkBitField % 2) {
 			assert(srcSize >= 1);
 
 			chunkBitField >>= 1;
-			buf[bufPos1] = *src;
 			*dest++ = *src++;
-			bufPos1 = (bufPos1 + 1) % 4096;
 			frameLength--;
 			srcSize--;
 			continue;
@@ -371,7 +433,7 @@ uint32 CoktelDecoder::deLZ77(byte *dest, const byte *src, uint32 srcSize, uint32
 		assert(srcSize >= 2);
 
 		uint16 tmp = READ_LE_UINT16(src);
-		uint16 chunkLength = ((tmp & 0xF00) >> 8) + 3;
+		uint32 chunkLength = ((tmp & 0xF00) >> 8) + 3;
 
 		src     += 2;
 		srcSize -= 2;
@@ -384,37 +446,27 @@ uint32 CoktelDecoder::deLZ77(byte *dest, const byte *src, uint32 srcSize, uint32
 			srcSize--;
 		}
 
-		uint16 bufPos2 = (tmp & 0xFF) + ((tmp >> 4) & 0x0F00);
-		if (((tmp + chunkLength) >= 4096) ||
-				((chunkLength + bufPos1) >= 4096)) {
-
-			for (int i = 0; i < chunkLength; i++, dest++) {
-				*dest = buf[bufPos2];
-				buf[bufPos1] = buf[bufPos2];
-				bufPos1 = (bufPos1 + 1) % 4096;
-				bufPos2 = (bufPos2 + 1) % 4096;
-			}
+		chunkLength = MIN(chunkLength, frameLength);
 
-		} else if (((tmp + chunkLength) < bufPos1) ||
-				((chunkLength + bufPos1) < bufPos2)) {
+		// A match of the current window position is 4096 bytes back
+		const uint16 matchPos = (tmp & 0xFF) + ((tmp >> 4) & 0x0F00);
+		const uint32 written  = dest - destStart;
 
-			memcpy(dest, buf + bufPos2, chunkLength);
-			memmove(buf + bufPos1, buf + bufPos2, chunkLength);
-
-			dest    += chunkLength;
-			bufPos1 += chunkLength;
-			bufPos2 += chunkLength;
+		uint32 distance = (windowStart + written - matchPos) & 0xFFF;
+		if (distance == 0)
+			distance = 4096;
 
+		if (distance <= written) {
+			copyMatch(dest, distance, chunkLength, frameLength);
+			dest += chunkLength;
 		} else {
-
-			for (int i = 0; i < chunkLength; i++, dest++, bufPos1++, bufPos2++) {
-				*dest = buf[bufPos2];
-				buf[bufPos1] = buf[bufPos2];
+			for (uint32 i = 0; i < chunkLength; i++, dest++) {
+				const int32 from = (int32)(dest - destStart) - (int32)distance;
+				*dest = (from >= 0) ? destStart[from] : window[(windowStart + from) & 0xFFF];
 			}
-
 		}
-		frameLength -= chunkLength;
 
+		frameLength -= chunkLength;
 	}
 
 	return realSize;
@@ -447,16 +499,13 @@ void CoktelDecoder::deRLE(byte *&destPtr, const byte *&srcPtr, int16 destLen, in
 			destPtr += copyCount;
 			destLen -= copyCount;
 		} else { // 2 bytes tmp times
-			for (int i = 0; (i < tmp) && (destLen > 0); i++) {
-				for (int j = 0; j < 2; j++) {
-					if (destLen <= 0)
-						break;
+			int16 fillCount = MAX<int16>(0, MIN<int16>(destLen, tmp * 2));
 
-					*destPtr++ = srcPtr[j];
-					destLen--;
-				}
-			}
-			srcPtr += 2;
+			fillPair(destPtr, srcPtr, fillCount);
+
+			srcPtr  += 2;
+			destPtr += fillCount;
+			destLen -= fillCount;
 		}
 		srcLen -= tmp;
 	}
@@ -483,19 +532,29 @@ void CoktelDecoder::renderBlockWhole4X(Graphics::Surface &dstSurf, const byte *s
 
 	rect.clip(dstSurf.w, dstSurf.h);
 
+	const int width = rect.width();
+
 	byte *dst = (byte *)dstSurf.getBasePtr(rect.left, rect.top);
 	for (int i = 0; i < rect.height(); i++) {
-		      byte *dstRow = dst;
-		const byte *srcRow = src;
-
-		int16 count = rect.width();
-		while (count >= 0) {
-			memset(dstRow, *srcRow, MIN<int16>(count, 4));
-
-			count  -= 4;
-			dstRow += 4;
-			srcRow += 1;
+		// Each source pixel is repeated 4 times
+		int x = 0;
+#if defined(COKTEL_USE_SSE2)
+		for (; x + 16 <= width; x += 16) {
+			__m128i pixels = _mm_cvtsi32_si128(READ_UINT32(src + x / 4));
+			pixels = _mm_unpacklo_epi8(pixels, pixels);
+			pixels = _mm_unpacklo_epi16(pixels, pixels);
+			_mm_storeu_si128((__m128i *)(dst + x), pixels);
+		}
+#elif defined(COKTEL_USE_NEON)
+		for (; x + 16 <= width; x += 16) {
+			const uint8x8_t pixels = vreinterpret_u8_u32(vdup_n_u32(READ_UINT32(src + x / 4)));
+			const uint8x8_t pairs  = vzip_u8(pixels, pixels).val[0];
+			const uint8x8x2_t quads = vzip_u8(pairs, pairs);
+			vst1q_u8(dst + x, vcombine_u8(quads.val[0], quads.val[1]));
 		}
+#endif
+		for (; x < width; x++)
+			dst[x] = src[x / 4];
 
 		src += srcRect.width() / 4;
 		dst += dstSurf.pitch;
@@ -2367,7 +2426,17 @@ bool VMDDecoder::renderFrame(Common::Rect &rect) {
 	byte  *dataPtr   = _videoBuffer[srcBuffer];
 	uint32 dataSize  = _videoBufferLen[srcBuffer] - 1;
 
+	Common::Rect      *blockRect = &fakeRect;
+	Graphics::Surface *surface   = &_surface;
+	if (_blitMode == 0) {
+		*blockRect = Common::Rect(blockRect->left  + _x, blockRect->top    + _y,
+		                          blockRect->right + _x, blockRect->bottom + _y);
+	} else {
+		surface = &_8bppSurface[2];
+	}
+
 	uint8 type = *dataPtr++;
+	bool rendered = false;
 
 	if (type & 0x80) {
 		// Frame data is compressed
@@ -2385,36 +2454,41 @@ bool VMDDecoder::renderFrame(Common::Rect &rect) {
 				return true;
 		}
 
-		srcBuffer = 1;
-		_videoBufferLen[srcBuffer] =
-			deLZ77(_videoBuffer[srcBuffer], dataPtr, dataSize, _videoBufferSize);
+		if ((type == 2) && (_blitMode > 0) && (blockRect->left == 0) && (blockRect->width() == surface->w)) {
+			// Directly uncompress onto the surface which is converted below
+			const int offset = blockRect->top * surface->pitch;
 
-		dataPtr  = _videoBuffer[srcBuffer];
-		dataSize = _videoBufferLen[srcBuffer];
-	}
+			rendered = deLZ77((byte *)surface->getPixels() + offset, dataPtr, dataSize,
+			                  surface->h * surface->pitch - offset) != 0;
+		}
 
-	Common::Rect      *blockRect = &fakeRect;
-	Graphics::Surface *surface   = &_surface;
-	if (_blitMode == 0) {
-		*blockRect = Common::Rect(blockRect->left  + _x, blockRect->top    + _y,
-		                          blockRect->right + _x, blockRect->bottom + _y);
-	} else {
-		surface = &_8bppSurface[2];
+		if (!rendered) {
+			srcBuffer = 1;
+			_videoBufferLen[srcBuffer] =
+				deLZ77(_videoBuffer[srcBuffer], dataPtr, dataSize, _videoBufferSize);
+
+			dataPtr  = _videoBuffer[srcBuffer];
+			dataSize = _videoBufferLen[srcBuffer];
+		}
 	}
 
 	// Evaluate the block type
-	if      (type == 0x01)
-		renderBlockSparse  (*surface, dataPtr, *blockRect);
-	else if (type == 0x02)
-		renderBlockWhole   (*surface, dataPtr, *blockRect);
-	else if (type == 0x03)
-		renderBlockRLE     (*surface, dataPtr, *blockRect);
-	else if (type == 0x42)
-		renderBlockWhole4X (*surface, dataPtr, *blockRect);
-	else if ((type & 0x0F) == 0x02)
-		renderBlockWhole2Y (*surface, dataPtr, *blockRect);
-	else
-		renderBlockSparse2Y(*surface, dataPtr, *blockRect);
+	if (!rendered) {
+		if      (type == 0x01)
+			renderBlockSparse  (*surface, dataPtr, *blockRect);
+		else if (type == 0x02)
+			renderBlockWhole   (*surface, dataPtr, *blockRect);
+		else if (type == 0x03)
+			renderBlockRLE     (*surface, dataPtr, *blockRect);
+		else if (type == 0x42)
+			renderBlockWhole4X (*surface, dataPtr, *blockRect);
+		else if ((type & 0x0F) == 0x02)
+			renderBlockWhole2Y (*surface, dataPtr, *blockRect);
+		else
+			renderBlockSparse2Y(*surface, dataPtr, *blockRect);
+	} else {
+		blockRect->clip(surface->w, surface->h);
+	}
 
 	if (_blitMode > 0) {
 		if      (_bytesPerPixel == 2)
@@ -2479,6 +2553,32 @@ bool VMDDecoder::getRenderRects(const Common::Rect &rect,
 	return true;
 }
 
+// Convert a row of RGB555 pixels, with black as 0
+template<typename PixelType>
+static inline void blitRow16(PixelType *dst, const byte *src, int width, const Graphics::PixelFormat &pixelFormat) {
+	for (int j = 0; j < width; j++, src += 2) {
+		uint16 data = READ_LE_UINT16(src);
+
+		byte r = ((data & 0x7C00) >> 10) << 3;
+		byte g = ((data & 0x03E0) >>  5) << 3;
+		byte b = ((data & 0x001F) >>  0) << 3;
+
+		dst[j] = ((data & 0x7FFF) == 0) ? 0 : (PixelType)pixelFormat.RGBToColor(r, g, b);
+	}
+}
+
+// Convert a row of BGR888 pixels, with black as 0
+template<typename PixelType>
+static inline void blitRow24(PixelType *dst, const byte *src, int width, const Graphics::PixelFormat &pixelFormat) {
+	for (int j = 0; j < width; j++, src += 3) {
+		byte r = src[2];
+		byte g = src[1];
+		byte b = src[0];
+
+		dst[j] = ((r | g | b) == 0) ? 0 : (PixelType)pixelFormat.RGBToColor(r, g, b);
+	}
+}
+
 void VMDDecoder::blit16(const Graphics::Surface &srcSurf, Common::Rect &rect) {
 	rect = Common::Rect(rect.left / 2, rect.top, rect.right / 2, rect.bottom);
 
@@ -2495,25 +2595,10 @@ void VMDDecoder::blit16(const Graphics::Surface &srcSurf, Common::Rect &rect) {
 	byte *dst = (byte *)_surface.getBasePtr(_x + rect.left, _y + rect.top);
 
 	for (int i = 0; i < rect.height(); i++) {
-		const byte *srcRow = src;
-		      byte *dstRow = dst;
-
-		for (int j = 0; j < rect.width(); j++, srcRow += 2, dstRow += _surface.format.bytesPerPixel) {
-			uint16 data = READ_LE_UINT16(srcRow);
-
-			byte r = ((data & 0x7C00) >> 10) << 3;
-			byte g = ((data & 0x03E0) >>  5) << 3;
-			byte b = ((data & 0x001F) >>  0) << 3;
-
-			uint32 c = pixelFormat.RGBToColor(r, g, b);
-			if ((r == 0) && (g == 0) && (b == 0))
-				c = 0;
-
-			if      (_surface.format.bytesPerPixel == 2)
-				*((uint16 *)dstRow) = (uint16) c;
-			else if (_surface.format.bytesPerPixel == 4)
-				*((uint32 *)dstRow) = (uint32) c;
-		}
+		if      (_surface.format.bytesPerPixel == 2)
+			blitRow16((uint16 *)dst, src, rect.width(), pixelFormat);
+		else if (_surface.format.bytesPerPixel == 4)
+			blitRow16((uint32 *)dst, src, rect.width(), pixelFormat);
 
 		src += srcSurf .pitch;
 		dst += _surface.pitch;
@@ -2536,23 +2621,10 @@ void VMDDecoder::blit24(const Graphics::Surface &srcSurf, Common::Rect &rect) {
 	byte *dst = (byte *)_surface.getBasePtr(_x + rect.left, _y + rect.top);
 
 	for (int i = 0; i < rect.height(); i++) {
-		const byte *srcRow = src;
-		      byte *dstRow = dst;
-
-		for (int j = 0; j < rect.width(); j++, srcRow += 3, dstRow += _surface.format.bytesPerPixel) {
-			byte r = srcRow[2];
-			byte g = srcRow[1];
-			byte b = srcRow[0];
-
-			uint32 c = pixelFormat.RGBToColor(r, g, b);
-			if ((r == 0) && (g == 0) && (b == 0))
-				c = 0;
-
-			if      (_surface.format.bytesPerPixel == 2)
-				*((uint16 *)dstRow) = (uint16) c;
-			else if (_surface.format.bytesPerPixel == 4)
-				*((uint32 *)dstRow) = (uint32) c;
-		}
+		if      (_surface.format.bytesPerPixel == 2)
+			blitRow24((uint16 *)dst, src, rect.width(), pixelFormat);
+		else if (_surface.format.bytesPerPixel == 4)
+			blitRow24((uint32 *)dst, src, rect.width(), pixelFormat);
 
 		src += srcSurf .pitch;
 		dst += _surface.pitch;
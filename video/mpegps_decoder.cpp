@@ -587,6 +587,7 @@ void MPEGPSDecoder::MPEGPSDemuxer::parseProgramStreamMap(int length) {
 
 MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format) {
 	_surface = 0;
+	_outputYUV = false;
 	_endOfTrack = false;
 	_curFrame = -1;
 	_framePts = 0xFFFFFFFF;
@@ -626,7 +627,7 @@ Graphics::PixelFormat MPEGPSDecoder::MPEGVideoTrack::getPixelFormat() const {
 }
 
 const Graphics::Surface *MPEGPSDecoder::MPEGVideoTrack::decodeNextFrame() {
-	return _surface;
+	return _outputYUV ? 0 : _surface;
 }
 
 bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packet, uint32 pts, uint32 dts) {
@@ -636,7 +637,7 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 	}
 
 	uint32 framePeriod;
-	bool foundFrame = _mpegDecoder->decodePacket(*packet, framePeriod, _surface);
+	bool foundFrame = _mpegDecoder->decodePacket(*packet, framePeriod, _surface, _outputYUV ? &_yuvFrame : 0);
 
 	if (foundFrame) {
 		_curFrame++;
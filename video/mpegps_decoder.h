@@ -26,6 +26,7 @@
 #include "common/hashmap.h"
 #include "common/queue.h"
 #include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
 #include "video/video_decoder.h"
 
 namespace Audio {
@@ -125,6 +126,12 @@ private:
 		uint32 getNextFrameStartTime() const { return _nextFrameStartTime.msecs(); }
 		const Graphics::Surface *decodeNextFrame();
 
+#ifdef USE_MPEG2
+		bool canOutputYUV() const { return true; }
+		void setOutputYUV() { _outputYUV = true; }
+		const Graphics::YUVFrame *getYUVFrame() const { return _outputYUV ? &_yuvFrame : 0; }
+#endif
+
 		bool sendPacket(Common::SeekableReadStream *packet, uint32 pts, uint32 dts);
 		StreamType getStreamType() const { return kStreamTypeVideo; }
 
@@ -137,6 +144,10 @@ private:
 		Audio::Timestamp _nextFrameStartTime;
 		Graphics::Surface *_surface;
 
+		// The planes of the last frame, when the conversion is left to the caller
+		bool _outputYUV;
+		Graphics::YUVFrame _yuvFrame;
+
 		void findDimensions(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format);
 
 #ifdef USE_MPEG2
@@ -388,16 +388,34 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 		return true;
 	}
 
-	// Now we're in the edit and need to figure out what frame we need
+	// Now we're in the edit and need to figure out what frame we need.
+	// Stepping j frames from the start of the edit puts the next frame at
+	// the edit offset plus the media time covered since the edit's media
+	// time, which only grows with j: search for the first j reaching the
+	// requested time.
 	Audio::Timestamp time = requestedTime.convertToFramerate(_parent->timeScale);
-	while (getRateAdjustedFrameTime() < (uint32)time.totalNumberOfFrames()) {
-		_curFrame++;
-		if (_durationOverride >= 0) {
-			_nextFrameStartTime += _durationOverride;
-			_durationOverride = -1;
-		} else {
-			_nextFrameStartTime += getFrameDuration();
+	uint32 targetTime = time.totalNumberOfFrames();
+	uint32 editStartFrame = _curFrame + 1;
+	uint32 editStartTime = _nextFrameStartTime;
+	uint32 editMediaTime = _parent->editList[_curEdit].mediaTime;
+	uint32 frameCount = _parent->timeToSampleFirst[_parent->timeToSampleCount];
+	uint32 low = 0, high = frameCount - MIN(editStartFrame, frameCount);
+
+	if (high > 0 && getRateAdjustedTime(editStartTime) < targetTime) {
+		low = 1;
+
+		while (low < high) {
+			uint32 mid = low + (high - low) / 2;
+
+			if (getRateAdjustedTime(editStartTime + _parent->getSampleTime(editStartFrame + mid) - editMediaTime) < targetTime)
+				low = mid + 1;
+			else
+				high = mid;
 		}
+
+		_curFrame += low;
+		_nextFrameStartTime = editStartTime + _parent->getSampleTime(editStartFrame + low) - editMediaTime;
+		_durationOverride = -1;
 	}
 
 	// Check if we went past, then adjust the frame times
@@ -614,40 +632,17 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
-
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
-
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
-
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
+	// First, we have to track down which chunk holds the sample for the frame we are looking for.
+	int32 actualChunk = _curFrame < 0 ? -1 : _parent->findSampleChunk(_curFrame);
 
 	if (actualChunk < 0)
 		error("Could not find data for frame %d", _curFrame);
 
+	descId = _parent->getChunkDescId(actualChunk);
+
 	// Next seek to that frame
 	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
-
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
-	}
+	stream->seek(_parent->getSampleOffset(_curFrame, actualChunk));
 
 	// Finally, read in the raw data for the frame
 	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
@@ -659,27 +654,15 @@ Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePac
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getFrameDuration() {
-	uint32 curFrameIndex = 0;
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		curFrameIndex += _parent->timeToSample[i].count;
-		if ((uint32)_curFrame < curFrameIndex) {
-			// Ok, now we have what duration this frame has.
-			return _parent->timeToSample[i].duration;
-		}
-	}
-
 	// This should never occur
-	error("Cannot find duration for frame %d", _curFrame);
-	return 0;
+	if (_curFrame < 0 || (uint32)_curFrame >= _parent->timeToSampleFirst[_parent->timeToSampleCount])
+		error("Cannot find duration for frame %d", _curFrame);
+
+	return _parent->getSampleDuration(_curFrame);
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
-
-	// If none found, we'll assume the requested frame is a key frame
-	return frame;
+	return _parent->findKeyframe(frame);
 }
 
 void QuickTimeDecoder::VideoTrackHandler::enterNewEditList(bool bufferFrames) {
@@ -691,32 +674,18 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditList(bool bufferFrames) {
 		return;
 
 	uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
-	uint32 frameNum = 0;
-	uint32 totalDuration = 0;
 	_durationOverride = -1;
 
 	// Track down where the mediaTime is in the media
 	// This is basically time -> frame mapping
 	// Note that this code uses first frame = 0
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		uint32 duration = _parent->timeToSample[i].count * _parent->timeToSample[i].duration;
-
-		if (totalDuration + duration >= mediaTime) {
-			uint32 frameInc = (mediaTime - totalDuration) / _parent->timeToSample[i].duration;
-			frameNum += frameInc;
-			totalDuration += frameInc * _parent->timeToSample[i].duration;
-
-			// If we didn't get to the exact media time, mark an override for
-			// the time.
-			if (totalDuration != mediaTime)
-				_durationOverride = totalDuration + _parent->timeToSample[i].duration - mediaTime;
+	uint32 frameNum = _parent->findSampleAtTime(mediaTime);
+	uint32 totalDuration = _parent->getSampleTime(frameNum);
 
-			break;
-		}
-
-		frameNum += _parent->timeToSample[i].count;
-		totalDuration += duration;
-	}
+	// If we didn't get to the exact media time, mark an override for
+	// the time.
+	if (totalDuration != mediaTime && frameNum < _parent->timeToSampleFirst[_parent->timeToSampleCount])
+		_durationOverride = totalDuration + _parent->getSampleDuration(frameNum) - mediaTime;
 
 	if (bufferFrames) {
 		// Track down the keyframe
@@ -777,8 +746,12 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime() const {
+	return getRateAdjustedTime(_nextFrameStartTime);
+}
+
+uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedTime(uint32 frameStartTime) const {
 	// Figure out what time the next frame is at taking the edit list rate into account
-	Common::Rational offsetFromEdit = Common::Rational(_nextFrameStartTime - getCurEditTimeOffset()) / _parent->editList[_curEdit].mediaRate;
+	Common::Rational offsetFromEdit = Common::Rational(frameStartTime - getCurEditTimeOffset()) / _parent->editList[_curEdit].mediaRate;
 	uint32 convertedTime = offsetFromEdit.toInt();
 
 	if ((offsetFromEdit.getNumerator() % offsetFromEdit.getDenominator()) > (offsetFromEdit.getDenominator() / 2))
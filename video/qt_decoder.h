@@ -74,6 +74,9 @@ public:
 protected:
 	Common::QuickTimeParser::SampleDesc *readSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize);
 
+	// The audio is read from the same file by decodeNextFrame()
+	bool supportsDecodeAhead() const override { return _audioTracks.empty(); }
+
 private:
 	void init();
 
@@ -170,6 +173,7 @@ private:
 		void enterNewEditList(bool bufferFrames);
 		const Graphics::Surface *bufferNextFrame();
 		uint32 getRateAdjustedFrameTime() const;
+		uint32 getRateAdjustedTime(uint32 frameStartTime) const;
 		uint32 getCurEditTimeOffset() const;
 		uint32 getCurEditTrackDuration() const;
 		bool atLastEdit() const;
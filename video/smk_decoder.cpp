@@ -30,6 +30,7 @@
 #include "common/util.h"
 #include "common/stream.h"
 #include "common/bitstream.h"
+#include "common/huffman.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -46,94 +47,84 @@ enum SmkBlockTypes {
 	SMK_BLOCK_FILL = 3
 };
 
+// Codes longer than this are rejected, as in the reference decoder
+static const int kMaxHuffmanCodeLength = 32;
+
+typedef Common::Huffman<Common::BitStreamMemory8LSB> SmackerHuffman;
+
 /*
  * class SmallHuffmanTree
  * A Huffman-tree to hold 8-bit values.
+ *
+ * The tree is only walked once, to collect the codes: they are then
+ * decoded with the lookup tables of Common::Huffman.
  */
 
 class SmallHuffmanTree {
 public:
 	SmallHuffmanTree(Common::BitStreamMemory8LSB &bs);
+	~SmallHuffmanTree();
 
-	uint16 getCode(Common::BitStreamMemory8LSB &bs);
-private:
-	enum {
-		SMK_NODE = 0x8000
-	};
-
-	uint16 decodeTree(uint32 prefix, int length);
+	uint16 getCode(Common::BitStreamMemory8LSB &bs) const {
+		return _huffman ? _huffman->getSymbol(bs) : _symbols[0];
+	}
 
-	uint16 _treeSize;
-	uint16 _tree[511];
+private:
+	void decodeTree(Common::BitStreamMemory8LSB &bs, uint32 prefix, int length);
 
-	uint16 _prefixtree[256];
-	byte _prefixlength[256];
+	uint16 _codeCount;
+	uint32 _codes[256];
+	uint8 _lengths[256];
+	uint32 _symbols[256];
 
-	Common::BitStreamMemory8LSB &_bs;
+	// Not set if the tree is a single leaf, which takes no bits
+	SmackerHuffman *_huffman;
 };
 
 SmallHuffmanTree::SmallHuffmanTree(Common::BitStreamMemory8LSB &bs)
-	: _treeSize(0), _bs(bs) {
-	uint32 bit = _bs.getBit();
+	: _codeCount(0), _huffman(0) {
+	uint32 bit = bs.getBit();
 	assert(bit);
 
-	for (uint16 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
-	decodeTree(0, 0);
+	decodeTree(bs, 0, 0);
 
-	bit = _bs.getBit();
+	bit = bs.getBit();
 	assert(!bit);
-}
-
-uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
-	if (!_bs.getBit()) { // Leaf
-		_tree[_treeSize] = _bs.getBits(8);
-
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
-				_prefixtree[prefix | i] = _treeSize;
-				_prefixlength[prefix | i] = length;
-			}
-		}
-		++_treeSize;
-
-		return 1;
-	}
-
-	uint16 t = _treeSize++;
 
-	if (length == 8) {
-		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
-	}
-
-	uint16 r1 = decodeTree(prefix, length + 1);
-
-	_tree[t] = (SMK_NODE | r1);
-
-	uint16 r2 = decodeTree(prefix | (1 << length), length + 1);
+	if (_codeCount > 1 || _lengths[0] > 0)
+		_huffman = new SmackerHuffman(0, _codeCount, _codes, _lengths, _symbols);
+}
 
-	return r1+r2+1;
+SmallHuffmanTree::~SmallHuffmanTree() {
+	delete _huffman;
 }
 
-uint16 SmallHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
-	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
-	uint16 *p = &_tree[_prefixtree[peek]];
-	bs.skip(_prefixlength[peek]);
+void SmallHuffmanTree::decodeTree(Common::BitStreamMemory8LSB &bs, uint32 prefix, int length) {
+	if (length > kMaxHuffmanCodeLength)
+		error("SmallHuffmanTree: Code too long");
 
-	while (*p & SMK_NODE) {
-		if (bs.getBit())
-			p += *p & ~SMK_NODE;
-		p++;
+	if (!bs.getBit()) { // Leaf
+		if (_codeCount == ARRAYSIZE(_codes))
+			error("SmallHuffmanTree: Too many codes");
+
+		_codes[_codeCount] = prefix;
+		_lengths[_codeCount] = length;
+		_symbols[_codeCount] = bs.getBits(8);
+		++_codeCount;
+		return;
 	}
 
-	return *p;
+	decodeTree(bs, prefix, length + 1);
+	decodeTree(bs, prefix | (1 << length), length + 1);
 }
 
 /*
  * class BigHuffmanTree
  * A Huffman-tree to hold 16-bit values.
+ *
+ * Three of the values are markers, standing for the last three values
+ * decoded. Common::Huffman decodes the leaf index, which is then looked
+ * up in the values, so that the markers can change.
  */
 
 class BigHuffmanTree {
@@ -142,41 +133,46 @@ public:
 	~BigHuffmanTree();
 
 	void reset();
-	uint32 getCode(Common::BitStreamMemory8LSB &bs);
-private:
-	enum {
-		SMK_NODE = 0x80000000
-	};
 
-	uint32 decodeTree(uint32 prefix, int length);
+	uint32 getCode(Common::BitStreamMemory8LSB &bs) {
+		uint32 v = _values[_huffman ? _huffman->getSymbol(bs) : 0];
 
-	uint32  _treeSize;
-	uint32 *_tree;
-	uint32  _last[3];
+		if (v != _values[_last[0]]) {
+			_values[_last[2]] = _values[_last[1]];
+			_values[_last[1]] = _values[_last[0]];
+			_values[_last[0]] = v;
+		}
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+		return v;
+	}
+
+private:
+	void decodeTree(uint32 prefix, int length);
+
+	Common::Array<uint32> _values;
+	uint32 _last[3];
+
+	// Not set if the tree is empty or a single leaf, which take no bits
+	SmackerHuffman *_huffman;
 
 	/* Used during construction */
 	Common::BitStreamMemory8LSB &_bs;
 	uint32 _markers[3];
 	SmallHuffmanTree *_loBytes;
 	SmallHuffmanTree *_hiBytes;
+	Common::Array<uint32> _codes;
+	Common::Array<uint8> _lengths;
 };
 
 BigHuffmanTree::BigHuffmanTree(Common::BitStreamMemory8LSB &bs, int allocSize)
-	: _bs(bs) {
+	: _huffman(0), _bs(bs) {
 	uint32 bit = _bs.getBit();
 	if (!bit) {
-		_tree = new uint32[1];
-		_tree[0] = 0;
+		_values.push_back(0);
 		_last[0] = _last[1] = _last[2] = 0;
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
-		_prefixtree[i] = _prefixlength[i] = 0;
-
 	_loBytes = new SmallHuffmanTree(_bs);
 	_hiBytes = new SmallHuffmanTree(_bs);
 
@@ -186,32 +182,39 @@ BigHuffmanTree::BigHuffmanTree(Common::BitStreamMemory8LSB &bs, int allocSize)
 
 	_last[0] = _last[1] = _last[2] = 0xffffffff;
 
-	_treeSize = 0;
-	_tree = new uint32[allocSize / 4];
+	_values.reserve(allocSize / 4);
 	decodeTree(0, 0);
 	bit = _bs.getBit();
 	assert(!bit);
 
+	if (_values.size() > 1 || _lengths[0] > 0)
+		_huffman = new SmackerHuffman(0, _values.size(), _codes.begin(), _lengths.begin());
+
 	for (uint32 i = 0; i < 3; ++i) {
 		if (_last[i] == 0xffffffff) {
-			_last[i] = _treeSize;
-			_tree[_treeSize++] = 0;
+			_last[i] = _values.size();
+			_values.push_back(0);
 		}
 	}
 
+	_codes.clear();
+	_lengths.clear();
 	delete _loBytes;
 	delete _hiBytes;
 }
 
 BigHuffmanTree::~BigHuffmanTree() {
-	delete[] _tree;
+	delete _huffman;
 }
 
 void BigHuffmanTree::reset() {
-	_tree[_last[0]] = _tree[_last[1]] = _tree[_last[2]] = 0;
+	_values[_last[0]] = _values[_last[1]] = _values[_last[2]] = 0;
 }
 
-uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
+void BigHuffmanTree::decodeTree(uint32 prefix, int length) {
+	if (length > kMaxHuffmanCodeLength)
+		error("BigHuffmanTree: Code too long");
+
 	uint32 bit = _bs.getBit();
 
 	if (!bit) { // Leaf
@@ -219,61 +222,23 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 		uint32 hi = _hiBytes->getCode(_bs);
 
 		uint32 v = (hi << 8) | lo;
-
-		_tree[_treeSize] = v;
-
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
-				_prefixtree[prefix | i] = _treeSize;
-				_prefixlength[prefix | i] = length;
-			}
-		}
+		bool isMarker = false;
 
 		for (int i = 0; i < 3; ++i) {
 			if (_markers[i] == v) {
-				_last[i] = _treeSize;
-				_tree[_treeSize] = 0;
+				_last[i] = _values.size();
+				isMarker = true;
 			}
 		}
-		++_treeSize;
-
-		return 1;
-	}
-
-	uint32 t = _treeSize++;
-
-	if (length == 8) {
-		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
-	}
-
-	uint32 r1 = decodeTree(prefix, length + 1);
-
-	_tree[t] = SMK_NODE | r1;
 
-	uint32 r2 = decodeTree(prefix | (1 << length), length + 1);
-	return r1+r2+1;
-}
-
-uint32 BigHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
-	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
-	uint32 *p = &_tree[_prefixtree[peek]];
-	bs.skip(_prefixlength[peek]);
-
-	while (*p & SMK_NODE) {
-		if (bs.getBit())
-			p += (*p) & ~SMK_NODE;
-		p++;
-	}
-
-	uint32 v = *p;
-	if (v != _tree[_last[0]]) {
-		_tree[_last[2]] = _tree[_last[1]];
-		_tree[_last[1]] = _tree[_last[0]];
-		_tree[_last[0]] = v;
+		_values.push_back(isMarker ? 0 : v);
+		_codes.push_back(prefix);
+		_lengths.push_back(length);
+		return;
 	}
 
-	return v;
+	decodeTree(prefix, length + 1);
+	decodeTree(prefix | (1 << length), length + 1);
 }
 
 SmackerDecoder::SmackerDecoder() {
@@ -573,8 +538,14 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 	uint stride = getWidth();
 	uint block = 0, blocks = bw*bh;
 
+	// The blocks of a run are decoded a row at a time, walking the output
+	// pointer along the row rather than working out each block's position
+	byte *row = (byte *)_surface->getPixels();
+	uint rowPitch = stride * 4 * doubleY;
+	uint blockX = 0;
+
 	byte *out;
-	uint type, run, j, mode;
+	uint type, run, count, n, j, mode;
 	uint32 p1, p2, clr, map;
 	byte hi, lo;
 	uint i;
@@ -583,123 +554,126 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 		type = _TypeTree->getCode(bs);
 		run = getBlockRun((type >> 2) & 0x3f);
 
-		switch (type & 3) {
-		case SMK_BLOCK_MONO:
-			while (run-- && block < blocks) {
-				clr = _MClrTree->getCode(bs);
-				map = _MMapTree->getCode(bs);
-				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				hi = clr >> 8;
-				lo = clr & 0xff;
-				for (i = 0; i < 4; i++) {
-					for (j = 0; j < doubleY; j++) {
-						out[0] = (map & 1) ? hi : lo;
-						out[1] = (map & 2) ? hi : lo;
-						out[2] = (map & 4) ? hi : lo;
-						out[3] = (map & 8) ? hi : lo;
-						out += stride;
-					}
-					map >>= 4;
-				}
-				++block;
-			}
-			break;
-		case SMK_BLOCK_FULL:
+		mode = 0;
+		if ((type & 3) == SMK_BLOCK_FULL && _signature != MKTAG('S','M','K','2')) {
 			// Smacker v2 has one mode, Smacker v4 has three
-			if (_signature == MKTAG('S','M','K','2')) {
-				mode = 0;
-			} else {
-				// 00 - mode 0
-				// 10 - mode 1
-				// 01 - mode 2
-				mode = 0;
-				if (bs.getBit()) {
-					mode = 1;
-				} else if (bs.getBit()) {
-					mode = 2;
-				}
+			// 00 - mode 0
+			// 10 - mode 1
+			// 01 - mode 2
+			if (bs.getBit()) {
+				mode = 1;
+			} else if (bs.getBit()) {
+				mode = 2;
 			}
+		} else if ((type & 3) == SMK_BLOCK_FILL) {
+			mode = type >> 8;
+		}
 
-			while (run-- && block < blocks) {
-				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				switch (mode) {
-					case 0:
-						for (i = 0; i < 4; ++i) {
-							p1 = _FullTree->getCode(bs);
-							p2 = _FullTree->getCode(bs);
-							for (j = 0; j < doubleY; ++j) {
-								out[2] = p1 & 0xff;
-								out[3] = p1 >> 8;
-								out[0] = p2 & 0xff;
-								out[1] = p2 >> 8;
-								out += stride;
-							}
+		while (run > 0 && block < blocks) {
+			count = MIN(run, bw - blockX);
+
+			switch (type & 3) {
+			case SMK_BLOCK_MONO:
+				for (n = 0; n < count; n++) {
+					clr = _MClrTree->getCode(bs);
+					map = _MMapTree->getCode(bs);
+					out = row + (blockX + n) * 4;
+					hi = clr >> 8;
+					lo = clr & 0xff;
+					for (i = 0; i < 4; i++) {
+						for (j = 0; j < doubleY; j++) {
+							out[0] = (map & 1) ? hi : lo;
+							out[1] = (map & 2) ? hi : lo;
+							out[2] = (map & 4) ? hi : lo;
+							out[3] = (map & 8) ? hi : lo;
+							out += stride;
 						}
-						break;
-					case 1:
-						p1 = _FullTree->getCode(bs);
-						out[0] = out[1] = p1 & 0xFF;
-						out[2] = out[3] = p1 >> 8;
-						out += stride;
-						out[0] = out[1] = p1 & 0xFF;
-						out[2] = out[3] = p1 >> 8;
-						out += stride;
-						p2 = _FullTree->getCode(bs);
-						out[0] = out[1] = p2 & 0xFF;
-						out[2] = out[3] = p2 >> 8;
-						out += stride;
-						out[0] = out[1] = p2 & 0xFF;
-						out[2] = out[3] = p2 >> 8;
-						out += stride;
-						break;
-					case 2:
-						for (i = 0; i < 2; i++) {
-							// We first get p2 and then p1
-							// Check ffmpeg thread "[PATCH] Smacker video decoder bug fix"
-							// http://article.gmane.org/gmane.comp.video.ffmpeg.devel/78768
-							p2 = _FullTree->getCode(bs);
-							p1 = _FullTree->getCode(bs);
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
-								out += stride;
+						map >>= 4;
+					}
+				}
+				break;
+			case SMK_BLOCK_FULL:
+				for (n = 0; n < count; n++) {
+					out = row + (blockX + n) * 4;
+					switch (mode) {
+						case 0:
+							for (i = 0; i < 4; ++i) {
+								p1 = _FullTree->getCode(bs);
+								p2 = _FullTree->getCode(bs);
+								for (j = 0; j < doubleY; ++j) {
+									out[2] = p1 & 0xff;
+									out[3] = p1 >> 8;
+									out[0] = p2 & 0xff;
+									out[1] = p2 >> 8;
+									out += stride;
+								}
 							}
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
-								out += stride;
+							break;
+						case 1:
+							p1 = _FullTree->getCode(bs);
+							out[0] = out[1] = p1 & 0xFF;
+							out[2] = out[3] = p1 >> 8;
+							out += stride;
+							out[0] = out[1] = p1 & 0xFF;
+							out[2] = out[3] = p1 >> 8;
+							out += stride;
+							p2 = _FullTree->getCode(bs);
+							out[0] = out[1] = p2 & 0xFF;
+							out[2] = out[3] = p2 >> 8;
+							out += stride;
+							out[0] = out[1] = p2 & 0xFF;
+							out[2] = out[3] = p2 >> 8;
+							out += stride;
+							break;
+						case 2:
+							for (i = 0; i < 2; i++) {
+								// We first get p2 and then p1
+								// Check ffmpeg thread "[PATCH] Smacker video decoder bug fix"
+								// http://article.gmane.org/gmane.comp.video.ffmpeg.devel/78768
+								p2 = _FullTree->getCode(bs);
+								p1 = _FullTree->getCode(bs);
+								for (j = 0; j < doubleY; ++j) {
+									out[0] = p1 & 0xff;
+									out[1] = p1 >> 8;
+									out[2] = p2 & 0xff;
+									out[3] = p2 >> 8;
+									out += stride;
+								}
+								for (j = 0; j < doubleY; ++j) {
+									out[0] = p1 & 0xff;
+									out[1] = p1 >> 8;
+									out[2] = p2 & 0xff;
+									out[3] = p2 >> 8;
+									out += stride;
+								}
 							}
-						}
-						break;
-					default:
-						break;
+							break;
+						default:
+							break;
+					}
 				}
-				++block;
-			}
-			break;
-		case SMK_BLOCK_SKIP:
-			while (run-- && block < blocks)
-				block++;
-			break;
-		case SMK_BLOCK_FILL:
-			uint32 col;
-			mode = type >> 8;
-			while (run-- && block < blocks) {
-				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				col = mode * 0x01010101;
+				break;
+			case SMK_BLOCK_SKIP:
+				break;
+			case SMK_BLOCK_FILL:
+				// The blocks of the run are next to each other, so fill them at once
+				out = row + blockX * 4;
 				for (i = 0; i < 4 * doubleY; ++i) {
-					out[0] = out[1] = out[2] = out[3] = col;
+					memset(out, mode, count * 4);
 					out += stride;
 				}
-				++block;
+				break;
+			default:
+				break;
+			}
+
+			run -= count;
+			block += count;
+			blockX += count;
+			if (blockX == bw) {
+				blockX = 0;
+				row += rowPitch;
 			}
-			break;
-		default:
-			break;
 		}
 	}
 }
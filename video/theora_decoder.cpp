@@ -47,8 +47,17 @@
 
 namespace Video {
 
+enum {
+	kMinReadSize = 4096,
+	kMaxReadSize = 65536
+};
+
 TheoraDecoder::TheoraDecoder() {
 	_fileStream = 0;
+	_syncOffset = _pageOffset = 0;
+	_readSize = kMinReadSize;
+	_readPage = false;
+	_indexEnd = 0;
 
 	_videoTrack = 0;
 	_audioTrack = 0;
@@ -66,6 +75,13 @@ bool TheoraDecoder::loadStream(Common::SeekableReadStream *stream) {
 
 	// start up Ogg stream synchronization layer
 	ogg_sync_init(&_oggSync);
+	_syncOffset = _pageOffset = 0;
+	_readSize = kMinReadSize;
+	_readPage = false;
+
+	// Nothing is indexed until the headers are parsed
+	_pageIndex.clear();
+	_indexEnd = 0xFFFFFFFF;
 
 	// init supporting Vorbis structures needed in header parsing
 	vorbis_info_init(&_vorbisInfo);
@@ -90,7 +106,7 @@ bool TheoraDecoder::loadStream(Common::SeekableReadStream *stream) {
 		if (ret == 0)
 			break; // FIXME: Shouldn't this error out?
 
-		while (ogg_sync_pageout(&_oggSync, &_oggPage) > 0) {
+		while (readPage()) {
 			ogg_stream_state test;
 
 			// is this a mandated initial header? If not, stop parsing
@@ -156,7 +172,7 @@ bool TheoraDecoder::loadStream(Common::SeekableReadStream *stream) {
 		// The header pages/packets will arrive before anything else we
 		// care about, or the stream is not obeying spec
 
-		if (ogg_sync_pageout(&_oggSync, &_oggPage) > 0) {
+		if (readPage()) {
 			queuePage(&_oggPage); // demux into the appropriate stream
 		} else {
 			ret = bufferData(); // someone needs more data
@@ -166,15 +182,22 @@ bool TheoraDecoder::loadStream(Common::SeekableReadStream *stream) {
 		}
 	}
 
+	// The pages from here on hold the frames. The ones read along with the
+	// headers may hold some too, so a seek to the first frames starts over
+	// from the headers, which the decoders skip.
+	_indexEnd = _syncOffset;
+
 	// And now we have it all. Initialize decoders next
 	if (_hasVideo) {
+		// The track keeps the setup, to reset its decoder when seeking
 		_videoTrack = new TheoraVideoTrack(getDefaultHighColorFormat(), theoraInfo, theoraSetup);
 		addTrack(_videoTrack);
+	} else {
+		th_setup_free(theoraSetup);
 	}
 
 	th_info_clear(&theoraInfo);
 	th_comment_clear(&theoraComment);
-	th_setup_free(theoraSetup);
 
 	if (_hasAudio) {
 		_audioTrack = new VorbisAudioTrack(getSoundType(), _vorbisInfo);
@@ -183,7 +206,7 @@ bool TheoraDecoder::loadStream(Common::SeekableReadStream *stream) {
 		while (!_audioTrack->hasAudio()) {
 			// Queue more data
 			bufferData();
-			while (ogg_sync_pageout(&_oggSync, &_oggPage) > 0)
+			while (readPage())
 				queuePage(&_oggPage);
 
 			queueAudio();
@@ -215,6 +238,7 @@ void TheoraDecoder::close() {
 
 	ogg_sync_clear(&_oggSync);
 	vorbis_info_clear(&_vorbisInfo);
+	_pageIndex.clear();
 
 	delete _fileStream;
 	_fileStream = 0;
@@ -224,40 +248,108 @@ void TheoraDecoder::close() {
 
 void TheoraDecoder::readNextPacket() {
 	// First, let's get our frame
-	if (_hasVideo) {
-		while (!_videoTrack->endOfTrack()) {
-			// theora is one in, one out...
-			if (ogg_stream_packetout(&_theoraOut, &_oggPacket) > 0) {
-				if (_videoTrack->decodePacket(_oggPacket))
-					break;
-			} else if (_theoraOut.e_o_s || _fileStream->eos()) {
-				// If we can't get any more frames, we're done.
-				_videoTrack->setEndOfVideo();
-			} else {
-				// Queue more data
-				bufferData();
-				while (ogg_sync_pageout(&_oggSync, &_oggPage) > 0)
-					queuePage(&_oggPage);
-			}
+	if (_hasVideo)
+		decodeFrame(true);
 
-			// Update audio if we can
-			queueAudio();
+	// Then make sure we have enough audio buffered
+	ensureAudioBufferSize();
+}
+
+bool TheoraDecoder::isSeekable() const {
+	return isVideoLoaded() && _hasVideo;
+}
+
+bool TheoraDecoder::seekIntern(const Audio::Timestamp &time) {
+	uint frame = _videoTrack->getFrameAtTime(time);
+
+	// Find the page on which the frame ends, indexing the pages up to it
+	// if they were not read yet. Past the end, go to the last frame.
+	bool found = indexUntil(frame);
+	if (!found && !_pageIndex.empty())
+		frame = _videoTrack->getGranuleFrame(_pageIndex.back().granulePos);
+
+	uint entry = 0;
+	while (entry < _pageIndex.size() && _videoTrack->getGranuleFrame(_pageIndex[entry].granulePos) < (ogg_int64_t)frame)
+		entry++;
+
+	// The keyframe of the frame is the one of its page, unless that page
+	// starts another group of frames after it
+	ogg_int64_t keyFrame = 0;
+	if (entry < _pageIndex.size() && _videoTrack->getGranuleKeyFrame(_pageIndex[entry].granulePos) <= (ogg_int64_t)frame)
+		keyFrame = _videoTrack->getGranuleKeyFrame(_pageIndex[entry].granulePos);
+	else if (entry > 0)
+		keyFrame = _videoTrack->getGranuleKeyFrame(_pageIndex[entry - 1].granulePos);
+
+	// Start reading at the last page completing a frame before the keyframe,
+	// or from the beginning when the keyframe is the first frame
+	int start = (int)entry - 1;
+	while (start >= 0 && _videoTrack->getGranuleFrame(_pageIndex[start].granulePos) >= keyFrame)
+		start--;
+
+	const uint32 offset = (start >= 0) ? _pageIndex[start].offset : 0;
+	if (!_fileStream->seek(offset))
+		return false;
+
+	ogg_sync_reset(&_oggSync);
+	_syncOffset = offset;
+	ogg_stream_reset(&_theoraOut);
+	if (_hasAudio) {
+		ogg_stream_reset(&_vorbisOut);
+		_audioTrack->restart(time);
+	}
+
+	if (start >= 0) {
+		// The frames completed on the page are before the keyframe
+		while (!readPage()) {
+			if (bufferData() == 0)
+				return false;
 		}
+		queuePage(&_oggPage);
+		while (ogg_stream_packetout(&_theoraOut, &_oggPacket) != 0)
+			;
+
+		_videoTrack->restart(_pageIndex[start].granulePos);
+	} else {
+		_videoTrack->restart(-1);
 	}
 
-	// Then make sure we have enough audio buffered
+	// Decode up to the frame, without showing any of them
+	while (_videoTrack->getCurFrame() < (int)frame - 1 && !_videoTrack->endOfTrack())
+		decodeFrame(false);
+
 	ensureAudioBufferSize();
+	return true;
 }
 
-TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &format, th_info &theoraInfo, th_setup_info *theoraSetup) {
-	_theoraDecode = th_decode_alloc(&theoraInfo, theoraSetup);
+void TheoraDecoder::decodeFrame(bool render) {
+	while (!_videoTrack->endOfTrack()) {
+		// theora is one in, one out...
+		if (ogg_stream_packetout(&_theoraOut, &_oggPacket) > 0) {
+			if (_videoTrack->decodePacket(_oggPacket, render))
+				break;
+		} else if (_theoraOut.e_o_s || _fileStream->eos()) {
+			// If we can't get any more frames, we're done.
+			_videoTrack->setEndOfVideo();
+		} else {
+			// Queue more data
+			bufferData();
+			while (readPage())
+				queuePage(&_oggPage);
+		}
 
+		// Update audio if we can
+		queueAudio();
+	}
+}
+
+TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &format, th_info &theoraInfo, th_setup_info *theoraSetup) {
 	if (theoraInfo.pixel_fmt != TH_PF_420)
 		error("Only theora YUV420 is supported");
 
-	int postProcessingMax;
-	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &postProcessingMax, sizeof(postProcessingMax));
-	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &postProcessingMax, sizeof(postProcessingMax));
+	_theoraInfo = theoraInfo;
+	_theoraSetup = theoraSetup;
+	_theoraDecode = 0;
+	createDecoder();
 
 	_surface.create(theoraInfo.frame_width, theoraInfo.frame_height, format);
 
@@ -265,6 +357,13 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &f
 	_displaySurface.init(theoraInfo.pic_width, theoraInfo.pic_height, _surface.pitch,
 	                    _surface.getBasePtr(theoraInfo.pic_x, theoraInfo.pic_y), format);
 
+	_outputYUV = false;
+	_yuvFrame.w = theoraInfo.pic_width;
+	_yuvFrame.h = theoraInfo.pic_height;
+	_pictureX = theoraInfo.pic_x;
+	_pictureY = theoraInfo.pic_y;
+	_convertPicture = !((theoraInfo.pic_x | theoraInfo.pic_y | theoraInfo.pic_width | theoraInfo.pic_height) & 1);
+
 	// Set the frame rate
 	_frameRate = Common::Rational(theoraInfo.fps_numerator, theoraInfo.fps_denominator);
 
@@ -275,37 +374,106 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &f
 
 TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
 	th_decode_free(_theoraDecode);
+	th_setup_free(_theoraSetup);
 
 	_surface.free();
 	_displaySurface.setPixels(0);
 }
 
-bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket) {
-	if (th_decode_packetin(_theoraDecode, &oggPacket, 0) == 0) {
-		_curFrame++;
-
-		// Convert YUV data to RGB data
-		th_ycbcr_buffer yuv;
-		th_decode_ycbcr_out(_theoraDecode, yuv);
-		translateYUVtoRGBA(yuv);
-
-		double time = th_granule_time(_theoraDecode, oggPacket.granulepos);
+bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket, bool render) {
+	ogg_int64_t granulePos = -1;
+	if (th_decode_packetin(_theoraDecode, &oggPacket, &granulePos) == 0) {
+		// The decoder keeps track of the frames, even on the packets which
+		// don't have their granule position, as after a seek
+		ogg_int64_t frame = th_granule_frame(_theoraDecode, granulePos);
+		if (frame >= 0)
+			_curFrame = (int)frame;
+		else
+			_curFrame++;
 
 		// We need to calculate when the next frame should be shown
 		// This is all in floating point because that's what the Ogg code gives us
-		// Ogg is a lossy container format, so it doesn't always list the time to the
-		// next frame. In such cases, we need to calculate it ourselves.
+		double time = th_granule_time(_theoraDecode, granulePos);
 		if (time == -1.0)
 			_nextFrameStartTime += _frameRate.getInverse().toDouble();
 		else
 			_nextFrameStartTime = time;
 
+		if (!render)
+			return true;
+
+		th_ycbcr_buffer yuv;
+		th_decode_ycbcr_out(_theoraDecode, yuv);
+
+		// The visible part of the planes, they stay valid until the next
+		// packet is decoded
+		_yuvFrame.yPlane = yuv[0].data + _pictureY * yuv[0].stride + _pictureX;
+		_yuvFrame.uPlane = yuv[1].data + (_pictureY >> 1) * yuv[1].stride + (_pictureX >> 1);
+		_yuvFrame.vPlane = yuv[2].data + (_pictureY >> 1) * yuv[2].stride + (_pictureX >> 1);
+		_yuvFrame.yPitch = yuv[0].stride;
+		_yuvFrame.uvPitch = yuv[1].stride;
+
+		if (_outputYUV) {
+			// Hand them out as they are
+		} else if (_convertPicture) {
+			// Convert only what is shown, straight from the planes
+			YUVToRGBMan.convert(&_displaySurface, _yuvFrame);
+		} else {
+			// Convert YUV data to RGB data
+			translateYUVtoRGBA(yuv);
+		}
+
 		return true;
 	}
 
 	return false;
 }
 
+void TheoraDecoder::TheoraVideoTrack::restart(ogg_int64_t granulePos) {
+	// A new decoder forgets where the previous one was
+	createDecoder();
+
+	if (granulePos >= 0) {
+		th_decode_ctl(_theoraDecode, TH_DECCTL_SET_GRANPOS, &granulePos, sizeof(granulePos));
+		_curFrame = (int)th_granule_frame(_theoraDecode, granulePos);
+		_nextFrameStartTime = th_granule_time(_theoraDecode, granulePos);
+	} else {
+		_curFrame = -1;
+		_nextFrameStartTime = 0.0;
+	}
+
+	_endOfVideo = false;
+}
+
+uint TheoraDecoder::TheoraVideoTrack::getFrameAtTime(const Audio::Timestamp &time) const {
+	// Try to get as accurate as possible, considering we have a fractional frame rate
+	if (time.framerate() == _frameRate)
+		return time.totalNumberOfFrames();
+
+	return (_frameRate * time.msecs() / 1000).toInt();
+}
+
+ogg_int64_t TheoraDecoder::TheoraVideoTrack::getGranuleFrame(ogg_int64_t granulePos) const {
+	return th_granule_frame(_theoraDecode, granulePos);
+}
+
+ogg_int64_t TheoraDecoder::TheoraVideoTrack::getGranuleKeyFrame(ogg_int64_t granulePos) const {
+	// The keyframe is in the upper bits, the frames since it in the lower ones
+	const int shift = _theoraInfo.keyframe_granule_shift;
+	return th_granule_frame(_theoraDecode, (granulePos >> shift) << shift);
+}
+
+void TheoraDecoder::TheoraVideoTrack::createDecoder() {
+	if (_theoraDecode)
+		th_decode_free(_theoraDecode);
+
+	_theoraDecode = th_decode_alloc(&_theoraInfo, _theoraSetup);
+
+	int postProcessingMax;
+	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &postProcessingMax, sizeof(postProcessingMax));
+	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &postProcessingMax, sizeof(postProcessingMax));
+}
+
 enum TheoraYUVBuffers {
 	kBufferY = 0,
 	kBufferU = 1,
@@ -340,6 +508,7 @@ TheoraDecoder::VorbisAudioTrack::VorbisAudioTrack(Audio::Mixer::SoundType soundT
 
 	_audioBufferFill = 0;
 	_audioBuffer = 0;
+	_skipUntil = -1;
 	_endOfAudio = false;
 }
 
@@ -354,6 +523,23 @@ Audio::AudioStream *TheoraDecoder::VorbisAudioTrack::getAudioStream() const {
 	return _audStream;
 }
 
+void TheoraDecoder::VorbisAudioTrack::restart(const Audio::Timestamp &time) {
+	// The mixer was stopped before seeking, and plays the new stream
+	// once it is done
+	const int rate = _audStream->getRate();
+	const bool stereo = _audStream->isStereo();
+	delete _audStream;
+	_audStream = Audio::makeQueuingAudioStream(rate, stereo);
+
+	free(_audioBuffer);
+	_audioBuffer = 0;
+	_audioBufferFill = 0;
+
+	vorbis_synthesis_restart(&_vorbisDSP);
+	_skipUntil = time.convertToFramerate(rate).totalNumberOfFrames();
+	_endOfAudio = false;
+}
+
 #define AUDIOFD_FRAGSIZE 10240
 
 #ifndef USE_TREMOR
@@ -372,6 +558,21 @@ bool TheoraDecoder::VorbisAudioTrack::decodeSamples() {
 	// if there's pending, decoded audio, grab it
 	int ret = vorbis_synthesis_pcmout(&_vorbisDSP, &pcm);
 
+	if (ret > 0 && _skipUntil >= 0) {
+		// After a seek, drop what comes before the new position. Until a
+		// packet tells the position, it is not known, and nothing is kept.
+		int skip = ret;
+		if (_vorbisDSP.granulepos >= 0)
+			skip = (int)CLIP<ogg_int64_t>(_skipUntil - (_vorbisDSP.granulepos - ret), 0, ret);
+
+		vorbis_synthesis_read(&_vorbisDSP, skip);
+		if (skip == ret)
+			return true;
+
+		_skipUntil = -1;
+		ret = vorbis_synthesis_pcmout(&_vorbisDSP, &pcm);
+	}
+
 	if (ret > 0) {
 		if (!_audioBuffer) {
 			_audioBuffer = (ogg_int16_t *)malloc(AUDIOFD_FRAGSIZE * sizeof(ogg_int16_t));
@@ -430,6 +631,12 @@ bool TheoraDecoder::VorbisAudioTrack::needsAudio() const {
 	return !_endOfAudio && _audStream->numQueuedStreams() < 5;
 }
 
+bool TheoraDecoder::VorbisAudioTrack::isAudioBufferFull() const {
+	// About two seconds of audio. Past that, the packets wait in the Ogg
+	// stream, rather than piling up as PCM.
+	return _audStream->numQueuedStreams() >= 32;
+}
+
 void TheoraDecoder::VorbisAudioTrack::synthesizePacket(ogg_packet &oggPacket) {
 	if (vorbis_synthesis(&_vorbisBlock, &oggPacket) == 0) // test for success
 		vorbis_synthesis_blockin(&_vorbisDSP, &_vorbisBlock);
@@ -444,14 +651,97 @@ void TheoraDecoder::queuePage(ogg_page *page) {
 }
 
 int TheoraDecoder::bufferData() {
-	char *buffer = ogg_sync_buffer(&_oggSync, 4096);
-	int bytes = _fileStream->read(buffer, 4096);
+	// When the last read did not complete a page, the pages are larger than
+	// the reads; read more at once
+	if (!_readPage && _readSize < kMaxReadSize)
+		_readSize *= 2;
+	_readPage = false;
+
+	char *buffer = ogg_sync_buffer(&_oggSync, _readSize);
+	int bytes = _fileStream->read(buffer, _readSize);
 
 	ogg_sync_wrote(&_oggSync, bytes);
 
 	return bytes;
 }
 
+bool TheoraDecoder::readPage() {
+	// As ogg_sync_pageout(), but keeping track of where the pages are
+	for (;;) {
+		int ret = ogg_sync_pageseek(&_oggSync, &_oggPage);
+
+		if (ret == 0)
+			return false;
+
+		if (ret < 0) {
+			// Skipped over something which is not a page
+			_syncOffset -= ret;
+			continue;
+		}
+
+		_pageOffset = _syncOffset;
+		_syncOffset += ret;
+		_readPage = true;
+		indexPage(&_oggPage, _pageOffset, _syncOffset);
+		return true;
+	}
+}
+
+void TheoraDecoder::indexPage(ogg_page *page, uint32 offset, uint32 end) {
+	// Only the pages following the ones already indexed are added, as the
+	// pages read again after a seek are in the index already
+	if (offset != _indexEnd)
+		return;
+	_indexEnd = end;
+
+	if (_hasVideo && ogg_page_serialno(page) == _theoraOut.serialno && ogg_page_granulepos(page) >= 0) {
+		PageEntry entry;
+		entry.offset = offset;
+		entry.granulePos = ogg_page_granulepos(page);
+		_pageIndex.push_back(entry);
+	}
+}
+
+bool TheoraDecoder::indexUntil(uint frame) {
+	if (!_pageIndex.empty() && _videoTrack->getGranuleFrame(_pageIndex.back().granulePos) >= (ogg_int64_t)frame)
+		return true;
+
+	// Scan the pages after the indexed ones, without decoding them, and
+	// come back to where the demuxer was
+	const int32 position = _fileStream->pos();
+	ogg_sync_state sync;
+	ogg_sync_init(&sync);
+	if (!_fileStream->seek(_indexEnd)) {
+		ogg_sync_clear(&sync);
+		return false;
+	}
+
+	ogg_page page;
+	uint32 offset = _indexEnd;
+	bool found = false;
+	while (!found) {
+		int ret = ogg_sync_pageseek(&sync, &page);
+
+		if (ret == 0) {
+			char *buffer = ogg_sync_buffer(&sync, kMaxReadSize);
+			int bytes = _fileStream->read(buffer, kMaxReadSize);
+			ogg_sync_wrote(&sync, bytes);
+			if (bytes == 0)
+				break;
+		} else if (ret < 0) {
+			offset -= ret;
+		} else {
+			indexPage(&page, offset, offset + ret);
+			offset += ret;
+			found = !_pageIndex.empty() && _videoTrack->getGranuleFrame(_pageIndex.back().granulePos) >= (ogg_int64_t)frame;
+		}
+	}
+
+	ogg_sync_clear(&sync);
+	_fileStream->seek(position);
+	return found;
+}
+
 bool TheoraDecoder::queueAudio() {
 	if (!_hasAudio)
 		return false;
@@ -459,7 +749,10 @@ bool TheoraDecoder::queueAudio() {
 	bool queuedAudio = false;
 
 	for (;;) {
-		if (_audioTrack->decodeSamples()) {
+		if (_audioTrack->isAudioBufferFull()) {
+			// enough is queued ahead of the mixer
+			break;
+		} else if (_audioTrack->decodeSamples()) {
 			// we queued some pending audio
 			queuedAudio = true;
 		} else if (ogg_stream_packetout(&_vorbisOut, &_oggPacket) > 0) {
@@ -481,7 +774,7 @@ void TheoraDecoder::ensureAudioBufferSize() {
 	// Force at least some audio to be buffered
 	while (_audioTrack->needsAudio()) {
 		bufferData();
-		while (ogg_sync_pageout(&_oggSync, &_oggPage) > 0)
+		while (readPage())
 			queuePage(&_oggPage);
 
 		bool queuedAudio = queueAudio();
@@ -27,10 +27,12 @@
 #ifndef VIDEO_THEORA_DECODER_H
 #define VIDEO_THEORA_DECODER_H
 
+#include "common/array.h"
 #include "common/rational.h"
 #include "video/video_decoder.h"
 #include "audio/mixer.h"
 #include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
 
 #include <theora/theoradec.h>
 
@@ -71,8 +73,11 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	bool isSeekable() const;
+
 protected:
 	void readNextPacket();
+	bool seekIntern(const Audio::Timestamp &time);
 
 private:
 	class TheoraVideoTrack : public VideoTrack {
@@ -86,11 +91,31 @@ private:
 		Graphics::PixelFormat getPixelFormat() const { return _displaySurface.format; }
 		int getCurFrame() const { return _curFrame; }
 		uint32 getNextFrameStartTime() const { return (uint32)(_nextFrameStartTime * 1000); }
-		const Graphics::Surface *decodeNextFrame() { return &_displaySurface; }
+		const Graphics::Surface *decodeNextFrame() { return _outputYUV ? 0 : &_displaySurface; }
+
+		bool canOutputYUV() const { return true; }
+		void setOutputYUV() { _outputYUV = true; }
+		const Graphics::YUVFrame *getYUVFrame() const { return _outputYUV ? &_yuvFrame : 0; }
 
-		bool decodePacket(ogg_packet &oggPacket);
+		/**
+		 * Decode a packet of the video. Frames which are not shown, while
+		 * seeking, are decoded without being converted to RGB.
+		 */
+		bool decodePacket(ogg_packet &oggPacket, bool render = true);
 		void setEndOfVideo() { _endOfVideo = true; }
 
+		/**
+		 * Start decoding again, after the frame of granulePos, or from the
+		 * first frame when granulePos is -1.
+		 */
+		void restart(ogg_int64_t granulePos);
+
+		uint getFrameAtTime(const Audio::Timestamp &time) const;
+		/** The frame a granule position ends, or -1 when it is unknown */
+		ogg_int64_t getGranuleFrame(ogg_int64_t granulePos) const;
+		/** The frame a granule position refers to as its keyframe */
+		ogg_int64_t getGranuleKeyFrame(ogg_int64_t granulePos) const;
+
 	private:
 		int _curFrame;
 		bool _endOfVideo;
@@ -100,8 +125,20 @@ private:
 		Graphics::Surface _surface;
 		Graphics::Surface _displaySurface;
 
+		// The visible part of the frame, when the conversion is left to the caller
+		bool _outputYUV;
+		Graphics::YUVFrame _yuvFrame;
+		int _pictureX, _pictureY;
+
+		// When the visible part of the frame is aligned on the chroma
+		// samples, only it is converted, straight from the decoded planes
+		bool _convertPicture;
+
+		th_info _theoraInfo;
+		th_setup_info *_theoraSetup;
 		th_dec_ctx *_theoraDecode;
 
+		void createDecoder();
 		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
 	};
 
@@ -113,9 +150,14 @@ private:
 		bool decodeSamples();
 		bool hasAudio() const;
 		bool needsAudio() const;
+		/** Is as much audio queued as there should be, ahead of the mixer? */
+		bool isAudioBufferFull() const;
 		void synthesizePacket(ogg_packet &oggPacket);
 		void setEndOfAudio() { _endOfAudio = true; }
 
+		/** Start over with an empty stream, dropping the samples before time */
+		void restart(const Audio::Timestamp &time);
+
 	protected:
 		Audio::AudioStream *getAudioStream() const;
 
@@ -129,11 +171,24 @@ private:
 		vorbis_block _vorbisBlock;
 		vorbis_dsp_state _vorbisDSP;
 
+		// The sample to start the stream at, or -1 once it was reached
+		ogg_int64_t _skipUntil;
+
 		bool _endOfAudio;
 	};
 
+	/** A page of the video stream on which a frame ends */
+	struct PageEntry {
+		uint32 offset;
+		ogg_int64_t granulePos;
+	};
+
+	void decodeFrame(bool render);
 	void queuePage(ogg_page *page);
 	int bufferData();
+	bool readPage();
+	void indexPage(ogg_page *page, uint32 offset, uint32 end);
+	bool indexUntil(uint frame);
 	bool queueAudio();
 	void ensureAudioBufferSize();
 
@@ -143,6 +198,19 @@ private:
 	ogg_page _oggPage;
 	ogg_packet _oggPacket;
 
+	// Where the next and the current page start in the file
+	uint32 _syncOffset;
+	uint32 _pageOffset;
+
+	// How much is read at once, following the size of the pages
+	uint32 _readSize;
+	bool _readPage;
+
+	// The video pages, indexed as they are read and when seeking, up to
+	// _indexEnd
+	Common::Array<PageEntry> _pageIndex;
+	uint32 _indexEnd;
+
 	ogg_stream_state _theoraOut, _vorbisOut;
 	bool _hasVideo, _hasAudio;
 
@@ -27,12 +27,27 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
+#include "common/readaheadstream.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+struct VideoDecoder::DecodedFrame {
+	Graphics::Surface surface;
+	bool hasSurface;
+	uint32 startTime;
+	int curFrame;
+	bool dirtyPalette;
+	byte palette[256 * 3];
+
+	DecodedFrame() : hasSurface(false), startTime(0), curFrame(-1), dirtyPalette(false) {}
+	~DecodedFrame() { surface.free(); }
+};
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -49,6 +64,20 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_yuvFrame = 0;
+	_outputYUV = false;
+	_readAhead = false;
+	_decodeAheadFrames = 0;
+	_decodeAheadActive = false;
+	_decodeAheadTrack = 0;
+	_decodeAheadBusy = false;
+	_decodeAheadStop = false;
+	_decodeAheadWaiting = false;
+	_decodeAheadTrackTime = 0;
+	_decodeAheadTrackEnded = false;
+	_decodeAheadFrameReady = nullptr;
+	_decodeAheadShown = 0;
+	_decodeAheadCurFrame = -1;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -57,7 +86,21 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	// Subclasses close() their tracks first, this is only in case they did not
+	stopDecodeAhead();
+
+	delete _decodeAheadShown;
+	for (uint i = 0; i < _decodeAheadFree.size(); i++)
+		delete _decodeAheadFree[i];
+
+	if (_decodeAheadFrameReady)
+		g_system->deleteSemaphore(_decodeAheadFrameReady);
+}
+
 void VideoDecoder::close() {
+	stopDecodeAhead();
+
 	if (isPlaying())
 		stop();
 
@@ -80,8 +123,20 @@ void VideoDecoder::close() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_yuvFrame = 0;
+	_outputYUV = false;
+
+	delete _decodeAheadShown;
+	_decodeAheadShown = 0;
+	for (uint i = 0; i < _decodeAheadFree.size(); i++)
+		delete _decodeAheadFree[i];
+	_decodeAheadFree.clear();
 }
 
+// Read-ahead buffers for setReadAhead(): 512KB, enough for several frames of typical FMV
+static const uint32 kReadAheadBlockSize = 64 * 1024;
+static const uint32 kReadAheadBlockCount = 8;
+
 bool VideoDecoder::loadFile(const Common::String &filename) {
 	Common::File *file = new Common::File();
 
@@ -90,6 +145,9 @@ bool VideoDecoder::loadFile(const Common::String &filename) {
 		return false;
 	}
 
+	if (_readAhead)
+		return loadStream(Common::wrapReadAheadStream(file, kReadAheadBlockSize, kReadAheadBlockCount, DisposeAfterUse::YES));
+
 	return loadStream(file);
 }
 
@@ -185,8 +243,20 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_SCOPE("video.decodeNextFrame");
+
 	_needsUpdate = false;
 	_canSetDither = false;
+	_yuvFrame = 0;
+
+	if (_decodeAheadShown) {
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadFree.push_back(_decodeAheadShown);
+		_decodeAheadShown = 0;
+	}
+
+	if (_decodeAheadActive || canDecodeAhead())
+		return decodeNextFrameAhead();
 
 	readNextPacket();
 
@@ -196,6 +266,7 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 		return 0;
 
 	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+	_yuvFrame = _nextVideoTrack->getYUVFrame();
 
 	if (_nextVideoTrack->hasDirtyPalette()) {
 		_palette = _nextVideoTrack->getPalette();
@@ -216,6 +287,14 @@ bool VideoDecoder::setReverse(bool reverse) {
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
+			// The frames decoded ahead are of the wrong direction
+			if (_decodeAheadActive) {
+				Audio::Timestamp time = ((VideoTrack *)*it)->getFrameTime(getCurFrame() + 1);
+				stopDecodeAhead();
+				if (time >= 0)
+					((VideoTrack *)*it)->seek(time);
+			}
+
 			if (!((VideoTrack *)*it)->setReverse(reverse))
 				return false;
 
@@ -233,6 +312,9 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	if (_decodeAheadActive)
+		return _decodeAheadCurFrame;
+
 	int32 frame = -1;
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
@@ -278,7 +360,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -299,8 +381,9 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool isVideo = track->getTrackType() == Track::kTrackTypeVideo;
+		bool videoEndTimeReached = _endTimeSet && isVideo && getNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = (isVideo ? endOfVideoTrack((const VideoTrack *)track) : track->endOfTrack()) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -323,6 +406,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -357,6 +442,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -526,6 +613,25 @@ bool VideoDecoder::setDitheringPalette(const byte *palette) {
 	return result;
 }
 
+bool VideoDecoder::setOutputYUV() {
+	// If a frame was already decoded, we can't set it now.
+	if (!_canSetDither)
+		return false;
+
+	bool result = false;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->canOutputYUV()) {
+			((VideoTrack *)*it)->setOutputYUV();
+			result = true;
+		}
+	}
+
+	_outputYUV = result;
+
+	return result;
+}
+
 VideoDecoder::Track::Track() {
 	_paused = false;
 }
@@ -864,7 +970,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack())
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !endOfVideoTrack((const VideoTrack *)*it))
 			return false;
 
 	return true;
@@ -875,9 +981,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack()) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !endOfVideoTrack((const VideoTrack *)*it)) {
 			VideoTrack *track = (VideoTrack *)*it;
-			uint32 time = track->getNextFrameStartTime();
+			uint32 time = getNextFrameStartTime(track);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -924,8 +1030,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = endOfVideoTrack(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -942,6 +1048,9 @@ bool VideoDecoder::hasAudio() const {
 }
 
 void VideoDecoder::eraseTrack(Track *track) {
+	if (track == _decodeAheadTrack)
+		stopDecodeAhead();
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -958,4 +1067,196 @@ void VideoDecoder::eraseTrack(Track *track) {
 	}
 }
 
+void VideoDecoder::setDecodeAhead(uint frames) {
+	Common::StackLock lock(_decodeAheadMutex);
+	_decodeAheadFrames = frames;
+}
+
+bool VideoDecoder::canDecodeAhead() const {
+	if (_decodeAheadFrames == 0 || _outputYUV || !_nextVideoTrack || _nextVideoTrack->isReversed() || !supportsDecodeAhead())
+		return false;
+
+	// The worker only follows a single video track
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && *it != _nextVideoTrack)
+			return false;
+
+	return Common::ThreadPool::instance().getNumWorkers() > 0;
+}
+
+const Graphics::Surface *VideoDecoder::decodeNextFrameAhead() {
+	if (!_decodeAheadActive) {
+		// Hand the track over to the worker: from now on, the timing
+		// comes from the frames it decoded.
+		_decodeAheadTrack = _nextVideoTrack;
+		_decodeAheadTrackTime = _decodeAheadTrack->getNextFrameStartTime();
+		_decodeAheadTrackEnded = _decodeAheadTrack->endOfTrack();
+		_decodeAheadCurFrame = _decodeAheadTrack->getCurFrame();
+		_decodeAheadStop = false;
+		_decodeAheadActive = true;
+
+		if (!_decodeAheadFrameReady)
+			_decodeAheadFrameReady = g_system->createSemaphore(0);
+	}
+
+	startDecodeAhead();
+
+	// Wait for the next frame, if the worker is still decoding it
+	DecodedFrame *frame = 0;
+	for (;;) {
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+			if (!_decodeAheadQueue.empty()) {
+				frame = _decodeAheadQueue.pop();
+				break;
+			}
+
+			if (!_decodeAheadBusy)
+				break;
+
+			_decodeAheadWaiting = true;
+		}
+
+		g_system->waitSemaphore(_decodeAheadFrameReady);
+	}
+
+	if (frame) {
+		_decodeAheadShown = frame;
+		_decodeAheadCurFrame = frame->curFrame;
+
+		if (frame->dirtyPalette) {
+			memcpy(_decodeAheadPalette, frame->palette, sizeof(_decodeAheadPalette));
+			_palette = _decodeAheadPalette;
+			_dirtyPalette = true;
+		}
+	}
+
+	// Refill the queue, or give the track back once the queue has run out
+	bool keepDecoding = canDecodeAhead();
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		if (!_decodeAheadBusy && _decodeAheadQueue.empty() && (_decodeAheadTrackEnded || !keepDecoding))
+			_decodeAheadActive = false;
+	}
+
+	if (_decodeAheadActive && keepDecoding)
+		startDecodeAhead();
+	else if (!_decodeAheadActive)
+		findNextVideoTrack();
+
+	return frame && frame->hasSurface ? &frame->surface : 0;
+}
+
+void VideoDecoder::startDecodeAhead() {
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		if (_decodeAheadBusy || _decodeAheadTrackEnded || (uint)_decodeAheadQueue.size() >= _decodeAheadFrames)
+			return;
+
+		_decodeAheadBusy = true;
+	}
+
+	_decodeAheadGroup.run(decodeAheadProc, this);
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	if (!_decodeAheadActive)
+		return;
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadStop = true;
+	}
+
+	_decodeAheadGroup.wait();
+
+	while (!_decodeAheadQueue.empty())
+		_decodeAheadFree.push_back(_decodeAheadQueue.pop());
+
+	_decodeAheadStop = false;
+	_decodeAheadActive = false;
+}
+
+void VideoDecoder::decodeAheadProc(void *refCon) {
+	((VideoDecoder *)refCon)->decodeAhead();
+}
+
+void VideoDecoder::decodeAhead() {
+	for (;;) {
+		DecodedFrame *frame;
+
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+			if (_decodeAheadStop || _decodeAheadTrackEnded || (uint)_decodeAheadQueue.size() >= _decodeAheadFrames) {
+				_decodeAheadBusy = false;
+				if (_decodeAheadWaiting) {
+					_decodeAheadWaiting = false;
+					g_system->postSemaphore(_decodeAheadFrameReady);
+				}
+				return;
+			}
+
+			if (_decodeAheadFree.empty()) {
+				frame = new DecodedFrame();
+			} else {
+				frame = _decodeAheadFree.back();
+				_decodeAheadFree.pop_back();
+			}
+
+			frame->startTime = _decodeAheadTrackTime;
+		}
+
+		readNextPacket();
+		const Graphics::Surface *surface = _decodeAheadTrack->decodeNextFrame();
+
+		// Copy the frame out, as the track decodes the next one in the same surface
+		frame->hasSurface = surface != 0;
+		if (surface) {
+			if (frame->surface.w != surface->w || frame->surface.h != surface->h || frame->surface.format != surface->format) {
+				frame->surface.free();
+				frame->surface.create(surface->w, surface->h, surface->format);
+			}
+
+			frame->surface.copyRectToSurface(surface->getPixels(), surface->pitch, 0, 0, surface->w, surface->h);
+		}
+
+		frame->curFrame = _decodeAheadTrack->getCurFrame();
+		frame->dirtyPalette = _decodeAheadTrack->hasDirtyPalette();
+		if (frame->dirtyPalette) {
+			const byte *palette = _decodeAheadTrack->getPalette();
+			if (palette)
+				memcpy(frame->palette, palette, sizeof(frame->palette));
+			else
+				frame->dirtyPalette = false;
+		}
+
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadQueue.push(frame);
+		_decodeAheadTrackTime = _decodeAheadTrack->getNextFrameStartTime();
+		_decodeAheadTrackEnded = _decodeAheadTrack->endOfTrack();
+		if (_decodeAheadWaiting) {
+			_decodeAheadWaiting = false;
+			g_system->postSemaphore(_decodeAheadFrameReady);
+		}
+	}
+}
+
+uint32 VideoDecoder::getNextFrameStartTime(const VideoTrack *track) const {
+	if (_decodeAheadActive && track == _decodeAheadTrack) {
+		Common::StackLock lock(_decodeAheadMutex);
+		return _decodeAheadQueue.empty() ? _decodeAheadTrackTime : _decodeAheadQueue.front()->startTime;
+	}
+
+	return track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::endOfVideoTrack(const VideoTrack *track) const {
+	if (_decodeAheadActive && track == _decodeAheadTrack) {
+		Common::StackLock lock(_decodeAheadMutex);
+		return _decodeAheadQueue.empty() && _decodeAheadTrackEnded;
+	}
+
+	return track->endOfTrack();
+}
+
 } // End of namespace Video
@@ -26,8 +26,10 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/queue.h"
 #include "common/rational.h"
 #include "common/str.h"
+#include "common/threadpool.h"
 #include "graphics/pixelformat.h"
 
 namespace Audio {
@@ -42,6 +44,7 @@ class SeekableReadStream;
 
 namespace Graphics {
 struct Surface;
+struct YUVFrame;
 }
 
 namespace Video {
@@ -52,7 +55,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -365,6 +368,34 @@ public:
 	 */
 	void setDefaultHighColorFormat(const Graphics::PixelFormat &format) { _defaultHighColorFormat = format; }
 
+	/**
+	 * Read files opened by loadFile() ahead in the background, so that
+	 * decoding does not block on slow storage. See Common::ReadAheadStream.
+	 *
+	 * By default, files are read on demand.
+	 *
+	 * This must be set before calling loadFile().
+	 */
+	void setReadAhead(bool readAhead) { _readAhead = readAhead; }
+
+	/**
+	 * Decode frames ahead on a worker thread, so that a frame which takes
+	 * longer than usual to decode does not delay its display. decodeNextFrame()
+	 * then returns the frames decoded in the meantime, with the timing of
+	 * their video track.
+	 *
+	 * This only applies to videos with a single video track played forwards
+	 * without YUV output, and only when worker threads are available. While
+	 * frames are decoded ahead, the decoder must only be used through the
+	 * VideoDecoder interface. Seeking, rewinding or reversing the video
+	 * discards the frames decoded ahead.
+	 *
+	 * By default, frames are decoded on demand.
+	 *
+	 * @param frames the number of frames to decode ahead, or 0 to disable it
+	 */
+	void setDecodeAhead(uint frames);
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -396,6 +427,33 @@ public:
 	 */
 	bool setDitheringPalette(const byte *palette);
 
+	/**
+	 * Tell the video to output planar YUV frames.
+	 *
+	 * For the video tracks that support it, decodeNextFrame() then skips the
+	 * conversion to RGB and returns 0, and getYUVFrame() returns the decoded
+	 * frame instead. It can be shown with OSystem::showYUVFrame() when the
+	 * backend has the OSystem::kFeatureYUVFrames feature, or be converted with
+	 * YUVToRGBManager::convert(). Tracks which can not output YUV keep
+	 * returning surfaces.
+	 *
+	 * This should be called after loadStream(), but before a decodeNextFrame()
+	 * call. This is enforced.
+	 *
+	 * @return true if at least one video track outputs YUV, false otherwise
+	 */
+	bool setOutputYUV();
+
+	/**
+	 * Get the planar YUV frame decoded by the last decodeNextFrame() call.
+	 *
+	 * The frame stays valid until the next decodeNextFrame() call.
+	 *
+	 * @return the frame, or 0 if setOutputYUV() is not in effect for the
+	 *         track the last frame was decoded from
+	 */
+	const Graphics::YUVFrame *getYUVFrame() const { return _yuvFrame; }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -645,6 +703,22 @@ protected:
 		 * Activate dithering mode with a palette
 		 */
 		virtual void setDither(const byte *palette) {}
+
+		/**
+		 * Can the video track output planar YUV frames?
+		 */
+		virtual bool canOutputYUV() const { return false; }
+
+		/**
+		 * Activate the planar YUV output, see VideoDecoder::setOutputYUV()
+		 */
+		virtual void setOutputYUV() {}
+
+		/**
+		 * Get the planar YUV frame decoded by the last decodeNextFrame() call,
+		 * or 0 when the YUV output is not active
+		 */
+		virtual const Graphics::YUVFrame *getYUVFrame() const { return 0; }
 	};
 
 	/**
@@ -936,6 +1010,14 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Return whether the frames can be decoded ahead on a worker thread
+	 * (see setDecodeAhead()). Decoders which touch the streams of their
+	 * video tracks outside of readNextPacket() and the tracks' own
+	 * decodeNextFrame() must return false.
+	 */
+	virtual bool supportsDecodeAhead() const { return true; }
+
 private:
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
@@ -953,12 +1035,47 @@ private:
 	mutable bool _dirtyPalette;
 	const byte *_palette;
 
-	// Enforcement of not being able to set dither
+	// Enforcement of not being able to set dither or the YUV output
 	bool _canSetDither;
 
+	// Frame of the last decodeNextFrame() call, with the YUV output
+	const Graphics::YUVFrame *_yuvFrame;
+	bool _outputYUV;
+
 	// Default PixelFormat settings
 	Graphics::PixelFormat _defaultHighColorFormat;
 
+	// Whether loadFile() wraps the file in a read-ahead stream
+	bool _readAhead;
+
+	// Frames decoded ahead by a worker thread, see setDecodeAhead()
+	struct DecodedFrame;
+	uint _decodeAheadFrames;
+	bool _decodeAheadActive;                         // The worker owns the track, or frames are queued
+	VideoTrack *_decodeAheadTrack;
+	Common::Mutex _decodeAheadMutex;                 // Guards the members below, while the worker is busy
+	Common::Queue<DecodedFrame *> _decodeAheadQueue;
+	Common::Array<DecodedFrame *> _decodeAheadFree;
+	bool _decodeAheadBusy;
+	bool _decodeAheadStop;
+	bool _decodeAheadWaiting;
+	uint32 _decodeAheadTrackTime;                    // Next frame start time of the track
+	bool _decodeAheadTrackEnded;
+	OSystem::SemaphoreRef _decodeAheadFrameReady;    // Posted when a frame is queued or the worker stops, if waiting
+	Common::TaskGroup _decodeAheadGroup;
+	DecodedFrame *_decodeAheadShown;                 // Frame returned by the last decodeNextFrame() call
+	int _decodeAheadCurFrame;
+	byte _decodeAheadPalette[256 * 3];
+
+	bool canDecodeAhead() const;
+	const Graphics::Surface *decodeNextFrameAhead();
+	void startDecodeAhead();
+	void stopDecodeAhead();
+	void decodeAhead();
+	static void decodeAheadProc(void *refCon);
+	uint32 getNextFrameStartTime(const VideoTrack *track) const;
+	bool endOfVideoTrack(const VideoTrack *track) const;
+
 	// Internal helper functions
 	void stopAudio();
 	void startAudio();